@@ -0,0 +1,248 @@
+// bdlb_bitstringutil.cpp                                             -*-C++-*-
+#include <bdlb_bitstringutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlb_bitstringutil_cpp,"$Id$ $CSID$")
+
+#include <bsls_platform.h>
+
+#if defined(BSLS_PLATFORM_CPU_X86_64) && defined(__BMI2__)
+#define BDLB_BITSTRINGUTIL_USE_PDEP 1
+#include <immintrin.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlb {
+
+                            // --------------------
+                            // struct BitStringUtil
+                            // --------------------
+
+// PUBLIC CLASS DATA
+const bsl::size_t BitStringUtil::k_INVALID_INDEX =
+                                                ~static_cast<bsl::size_t>(0);
+
+// PRIVATE CLASS METHODS
+int BitStringUtil::findNth1InWord(uint64_t value, int n)
+{
+    BSLS_ASSERT_SAFE(0 <= n);
+    BSLS_ASSERT_SAFE(n < BitUtil::numBitsSet(value));
+
+#if defined(BDLB_BITSTRINGUTIL_USE_PDEP)
+    // Deposit a single bit into the position of the 'n'th set bit of 'value'.
+
+    return BitUtil::numTrailingUnsetBits(static_cast<uint64_t>(
+                         _pdep_u64(static_cast<uint64_t>(1) << n, value)));
+#else
+    // Binary search: at each step, discard the low half of the remaining bits
+    // if the selected bit is not among them.
+
+    int result = 0;
+
+    for (int width = k_BITS_PER_UINT64 / 2; width > 0; width /= 2) {
+        const uint64_t lowMask  = (static_cast<uint64_t>(1) << width) - 1;
+        const int      lowCount = BitUtil::numBitsSet(value & lowMask);
+
+        if (n >= lowCount) {
+            n      -= lowCount;
+            value >>= width;
+            result += width;
+        }
+    }
+
+    return result;
+#endif
+}
+
+// CLASS METHODS
+bsl::size_t BitStringUtil::findNth1(const uint64_t *bitString,
+                                    bsl::size_t     length,
+                                    bsl::size_t     n)
+{
+    BSLS_ASSERT(bitString || 0 == length);
+
+    const bsl::size_t numWords  = length / k_BITS_PER_UINT64;
+    const int         remainder = static_cast<int>(length % k_BITS_PER_UINT64);
+
+    for (bsl::size_t i = 0; i < numWords; ++i) {
+        const bsl::size_t count = BitUtil::numBitsSet(bitString[i]);
+
+        if (n < count) {
+            const int offset = findNth1InWord(bitString[i],
+                                              static_cast<int>(n));
+            return i * k_BITS_PER_UINT64 + offset;                    // RETURN
+        }
+        n -= count;
+    }
+
+    if (remainder) {
+        const uint64_t word = bitString[numWords]
+                            & ((static_cast<uint64_t>(1) << remainder) - 1);
+
+        if (n < static_cast<bsl::size_t>(BitUtil::numBitsSet(word))) {
+            return numWords * k_BITS_PER_UINT64
+                 + findNth1InWord(word, static_cast<int>(n));         // RETURN
+        }
+    }
+
+    return k_INVALID_INDEX;
+}
+
+bsl::size_t BitStringUtil::num1(const uint64_t *bitString,
+                                bsl::size_t     index,
+                                bsl::size_t     numBits)
+{
+    BSLS_ASSERT(bitString || 0 == numBits);
+
+    if (0 == numBits) {
+        return 0;                                                     // RETURN
+    }
+
+    bsl::size_t wordIndex = index / k_BITS_PER_UINT64;
+    const int   offset    = static_cast<int>(index % k_BITS_PER_UINT64);
+
+    // Count the bits of a leading partial word.
+
+    bsl::size_t result = 0;
+
+    if (offset) {
+        if (offset + numBits <= k_BITS_PER_UINT64) {
+            const uint64_t word = bits(bitString,
+                                       index,
+                                       static_cast<int>(numBits));
+            return BitUtil::numBitsSet(word);                         // RETURN
+        }
+        result  += BitUtil::numBitsSet(bitString[wordIndex] >> offset);
+        numBits -= k_BITS_PER_UINT64 - offset;
+        ++wordIndex;
+    }
+
+    // Count whole words, using independent accumulators so that consecutive
+    // population counts can execute in parallel.
+
+    const uint64_t    *word     = bitString + wordIndex;
+    const bsl::size_t  numWords = numBits / k_BITS_PER_UINT64;
+
+    bsl::size_t sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+    bsl::size_t i    = 0;
+
+    for (; i + 4 <= numWords; i += 4) {
+        sum0 += BitUtil::numBitsSet(word[i]);
+        sum1 += BitUtil::numBitsSet(word[i + 1]);
+        sum2 += BitUtil::numBitsSet(word[i + 2]);
+        sum3 += BitUtil::numBitsSet(word[i + 3]);
+    }
+    for (; i < numWords; ++i) {
+        sum0 += BitUtil::numBitsSet(word[i]);
+    }
+
+    result += sum0 + sum1 + sum2 + sum3;
+
+    // Count the bits of a trailing partial word.
+
+    const int remainder = static_cast<int>(numBits % k_BITS_PER_UINT64);
+
+    if (remainder) {
+        result += BitUtil::numBitsSet(
+                     word[numWords]
+                     & ((static_cast<uint64_t>(1) << remainder) - 1));
+    }
+
+    return result;
+}
+
+void BitStringUtil::pack(uint64_t       *bitString,
+                         const uint64_t *values,
+                         bsl::size_t     numValues,
+                         int             width)
+{
+    BSLS_ASSERT(bitString || 0 == numValues);
+    BSLS_ASSERT(values    || 0 == numValues);
+    BSLS_ASSERT(1 <= width);
+    BSLS_ASSERT(     width <= k_BITS_PER_UINT64);
+
+    const uint64_t mask = width < k_BITS_PER_UINT64
+                          ? (static_cast<uint64_t>(1) << width) - 1
+                          : ~static_cast<uint64_t>(0);
+
+    // Accumulate bits into 'word', and store each word once it is full.
+
+    uint64_t word     = 0;
+    int      numInUse = 0;
+
+    for (bsl::size_t i = 0; i < numValues; ++i) {
+        const uint64_t value = values[i] & mask;
+
+        word     |= value << numInUse;
+        numInUse += width;
+
+        if (numInUse >= k_BITS_PER_UINT64) {
+            *bitString++ = word;
+
+            numInUse -= k_BITS_PER_UINT64;
+            word      = numInUse ? value >> (width - numInUse) : 0;
+        }
+    }
+
+    if (numInUse) {
+        *bitString = word;
+    }
+}
+
+void BitStringUtil::unpack(uint64_t       *values,
+                           const uint64_t *bitString,
+                           bsl::size_t     numValues,
+                           int             width)
+{
+    BSLS_ASSERT(values    || 0 == numValues);
+    BSLS_ASSERT(bitString || 0 == numValues);
+    BSLS_ASSERT(1 <= width);
+    BSLS_ASSERT(     width <= k_BITS_PER_UINT64);
+
+    const uint64_t mask = width < k_BITS_PER_UINT64
+                          ? (static_cast<uint64_t>(1) << width) - 1
+                          : ~static_cast<uint64_t>(0);
+
+    // Consume bits from 'word', loading the next word of 'bitString' when the
+    // bits of a value straddle a word boundary.
+
+    uint64_t word     = 0;
+    int      numAvail = 0;
+
+    for (bsl::size_t i = 0; i < numValues; ++i) {
+        if (numAvail >= width) {
+            values[i]  = word & mask;
+            word       = width < k_BITS_PER_UINT64 ? word >> width : 0;
+            numAvail  -= width;
+        }
+        else {
+            const uint64_t next = *bitString++;
+
+            values[i] = (word | (next << numAvail)) & mask;
+
+            const int used = width - numAvail;
+
+            word     = used < k_BITS_PER_UINT64 ? next >> used : 0;
+            numAvail = k_BITS_PER_UINT64 - used;
+        }
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
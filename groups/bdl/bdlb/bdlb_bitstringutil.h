@@ -0,0 +1,332 @@
+// bdlb_bitstringutil.h                                               -*-C++-*-
+#ifndef INCLUDED_BDLB_BITSTRINGUTIL
+#define INCLUDED_BDLB_BITSTRINGUTIL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide bulk operations on bit strings held in 'uint64_t' arrays.
+//
+//@CLASSES:
+//  bdlb::BitStringUtil: namespace for operations on arrays of 'uint64_t' bits
+//
+//@SEE_ALSO: bdlb_bitutil
+//
+//@DESCRIPTION: This component provides a utility 'struct',
+// 'bdlb::BitStringUtil', that serves as a namespace for a collection of
+// functions operating on *bit strings*: sequences of bits stored in arrays of
+// 'uint64_t', such as the bitmaps of a compact index or the words of a packed
+// column encoding.  Bit 'i' of a bit string is the bit at index 'i % 64' of
+// the word at index 'i / 64', so that bit 0 is the low-order bit of the first
+// word.  'BitStringUtil' supplies:
+//
+//: o 'bits' and 'assignBits', which read and write up to 64 consecutive bits
+//:   starting at any index, possibly straddling two words
+//:
+//: o 'num1', which counts the set bits in a range (population count), and
+//:   thereby computes the *rank* of an index: the number of set bits that
+//:   precede it
+//:
+//: o 'findNth1', which returns the index of the set bit having a given rank
+//:   (the *select* operation)
+//:
+//: o 'pack' and 'unpack', which convert between an array of integers and a
+//:   bit string holding the low-order 'k' bits of each integer, for any 'k' in
+//:   '[1 .. 64]'
+//
+// The caller owns the arrays, and the functions neither allocate memory nor
+// read or write any word beyond those holding the bits in the specified
+// range.
+//
+///Performance
+///-----------
+// The functions of this component operate a word at a time, and are written
+// so that the compiler can keep several words in flight at once (e.g., 'num1'
+// accumulates the population count of consecutive words in independent
+// registers).  Where the build targets a processor with the BMI2 instruction
+// set (i.e., the compiler defines '__BMI2__'), 'findNth1' locates the
+// selected bit within its word using the 'pdep' instruction; otherwise a
+// portable binary search over the halves of the word is used.  The choice is
+// made at compile time, so no run-time processor detection is performed.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Packing a Column of Small Integers
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we store a column of values, each of which is known to be less
+// than 1000, and so fits in 10 bits.  We can store 64 such values in 10
+// words, rather than in the 64 words of a 'uint64_t' array.
+//
+// First, we create the column and the storage for its packed representation:
+//..
+//  typedef bdlb::BitStringUtil::uint64_t uint64_t;
+//
+//  const int         k_WIDTH      = 10;
+//  const bsl::size_t k_NUM_VALUES = 64;
+//
+//  uint64_t column[k_NUM_VALUES];
+//  for (bsl::size_t i = 0; i < k_NUM_VALUES; ++i) {
+//      column[i] = (i * 37) % 1000;
+//  }
+//
+//  uint64_t packed[(k_NUM_VALUES * k_WIDTH + 63) / 64];
+//  assert(10 == sizeof packed / sizeof *packed);
+//..
+// Then, we pack the column:
+//..
+//  bdlb::BitStringUtil::pack(packed, column, k_NUM_VALUES, k_WIDTH);
+//..
+// Next, we read a single value directly from the packed representation:
+//..
+//  assert(column[7] == bdlb::BitStringUtil::bits(packed, 7 * k_WIDTH,
+//                                                k_WIDTH));
+//..
+// Finally, we unpack the whole column, and observe that it is unchanged:
+//..
+//  uint64_t unpacked[k_NUM_VALUES];
+//  bdlb::BitStringUtil::unpack(unpacked, packed, k_NUM_VALUES, k_WIDTH);
+//
+//  for (bsl::size_t i = 0; i < k_NUM_VALUES; ++i) {
+//      assert(column[i] == unpacked[i]);
+//  }
+//..
+//
+///Example 2: Rank and Select in a Bitmap Index
+/// - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a bitmap index records, for each of 200 rows of a table,
+// whether that row matches some predicate, and that the matching rows are
+// stored contiguously elsewhere.  The rank of a row locates its data among the
+// matching rows, and the select operation maps a position among the matching
+// rows back to a row.
+//
+// First, we create a bitmap in which every third row matches:
+//..
+//  uint64_t bitmap[4] = { 0, 0, 0, 0 };
+//  for (bsl::size_t row = 0; row < 200; row += 3) {
+//      bdlb::BitStringUtil::assignBits(bitmap, row, 1, 1);
+//  }
+//..
+// Then, we count the matching rows:
+//..
+//  assert(67 == bdlb::BitStringUtil::num1(bitmap, 0, 200));
+//..
+// Next, we compute the position of row 150 among the matching rows:
+//..
+//  assert(50 == bdlb::BitStringUtil::num1(bitmap, 0, 150));
+//..
+// Finally, we find the row that is at position 50 among the matching rows,
+// and observe that there is no row at position 67:
+//..
+//  assert(150 == bdlb::BitStringUtil::findNth1(bitmap, 200, 50));
+//  const bsl::size_t row = bdlb::BitStringUtil::findNth1(bitmap, 200, 67);
+//  assert(bdlb::BitStringUtil::k_INVALID_INDEX == row);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLB_BITUTIL
+#include <bdlb_bitutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlb {
+
+                            // ====================
+                            // struct BitStringUtil
+                            // ====================
+
+struct BitStringUtil {
+    // This utility 'struct' provides a namespace for a set of stateless
+    // functions that operate on bit strings held in arrays of 'uint64_t'.  The
+    // bit at index 'i' of a bit string is the bit at index 'i % 64' of the
+    // word at index 'i / 64'.
+
+    // PUBLIC TYPES
+    typedef BitUtil::uint64_t uint64_t;
+
+    // PUBLIC CONSTANTS
+    enum { k_BITS_PER_UINT64 = 64 };  // bits used to represent a 'uint64_t'
+
+    static const bsl::size_t k_INVALID_INDEX;
+        // Value returned by 'findNth1' when there is no such bit.
+
+  private:
+    // PRIVATE CLASS METHODS
+    static int findNth1InWord(uint64_t value, int n);
+        // Return the index of the set bit in the specified 'value' that is
+        // preceded by exactly the specified 'n' set bits of lower index.  The
+        // behavior is undefined unless '0 <= n < BitUtil::numBitsSet(value)'.
+
+  public:
+    // CLASS METHODS
+    static void assignBits(uint64_t    *bitString,
+                           bsl::size_t  index,
+                           uint64_t     srcBits,
+                           int          numBits);
+        // Assign the low-order specified 'numBits' of the specified 'srcBits'
+        // to the bits of the specified 'bitString' starting at the specified
+        // 'index'.  The other bits of 'bitString' are unchanged.  The behavior
+        // is undefined unless '0 <= numBits <= k_BITS_PER_UINT64' and
+        // 'bitString' has at least 'index + numBits' bits.
+
+    static uint64_t bits(const uint64_t *bitString,
+                         bsl::size_t     index,
+                         int             numBits);
+        // Return the specified 'numBits' bits of the specified 'bitString'
+        // starting at the specified 'index', as the low-order bits of the
+        // result; the other bits of the result are 0.  The behavior is
+        // undefined unless '0 <= numBits <= k_BITS_PER_UINT64' and
+        // 'bitString' has at least 'index + numBits' bits.
+
+    static bsl::size_t findNth1(const uint64_t *bitString,
+                                bsl::size_t     length,
+                                bsl::size_t     n);
+        // Return the index of the set bit, among the first specified 'length'
+        // bits of the specified 'bitString', that is preceded by exactly the
+        // specified 'n' set bits, and 'k_INVALID_INDEX' if there are no more
+        // than 'n' set bits among the first 'length' bits.  The behavior is
+        // undefined unless 'bitString' has at least 'length' bits.  Note that
+        // this is the "select" operation, and the inverse of the rank computed
+        // by 'num1(bitString, 0, index)'.
+
+    static bsl::size_t num1(const uint64_t *bitString,
+                            bsl::size_t     index,
+                            bsl::size_t     numBits);
+        // Return the number of set bits among the specified 'numBits' bits of
+        // the specified 'bitString' starting at the specified 'index'.  The
+        // behavior is undefined unless 'bitString' has at least
+        // 'index + numBits' bits.
+
+    static void pack(uint64_t       *bitString,
+                     const uint64_t *values,
+                     bsl::size_t     numValues,
+                     int             width);
+        // Load into the specified 'bitString' the low-order specified 'width'
+        // bits of each of the specified 'numValues' elements of the specified
+        // 'values' array, in order, so that bits '[i * width .. (i + 1) *
+        // width)' of 'bitString' hold element 'i'.  The bits of the last
+        // modified word of 'bitString' beyond those holding the elements are
+        // set to 0.  The behavior is undefined unless
+        // '1 <= width <= k_BITS_PER_UINT64', 'values' has at least
+        // 'numValues' elements, and 'bitString' has at least
+        // '(numValues * width + 63) / 64' words.
+
+    static void unpack(uint64_t       *values,
+                       const uint64_t *bitString,
+                       bsl::size_t     numValues,
+                       int             width);
+        // Load into each of the specified 'numValues' elements of the
+        // specified 'values' array the corresponding specified 'width' bits of
+        // the specified 'bitString', such that element 'i' is assigned the
+        // bits '[i * width .. (i + 1) * width)' of 'bitString'.  The behavior
+        // is undefined unless '1 <= width <= k_BITS_PER_UINT64', 'values' has
+        // at least 'numValues' elements, and 'bitString' has at least
+        // 'numValues * width' bits.  Note that this function is the inverse of
+        // 'pack'.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                            // --------------------
+                            // struct BitStringUtil
+                            // --------------------
+
+// CLASS METHODS
+inline
+void BitStringUtil::assignBits(uint64_t    *bitString,
+                               bsl::size_t  index,
+                               uint64_t     srcBits,
+                               int          numBits)
+{
+    BSLS_ASSERT_SAFE(bitString);
+    BSLS_ASSERT_SAFE(0 <= numBits);
+    BSLS_ASSERT_SAFE(     numBits <= k_BITS_PER_UINT64);
+
+    if (0 == numBits) {
+        return;                                                       // RETURN
+    }
+
+    const uint64_t mask = numBits < k_BITS_PER_UINT64
+                          ? (static_cast<uint64_t>(1) << numBits) - 1
+                          : ~static_cast<uint64_t>(0);
+
+    const bsl::size_t wordIndex = index / k_BITS_PER_UINT64;
+    const int         offset    = static_cast<int>(index % k_BITS_PER_UINT64);
+
+    srcBits &= mask;
+
+    bitString[wordIndex] = (bitString[wordIndex] & ~(mask << offset))
+                         | (srcBits << offset);
+
+    if (offset + numBits > k_BITS_PER_UINT64) {
+        const int shift = k_BITS_PER_UINT64 - offset;
+
+        uint64_t& next = bitString[wordIndex + 1];
+
+        next = (next & ~(mask >> shift)) | (srcBits >> shift);
+    }
+}
+
+inline
+BitStringUtil::uint64_t BitStringUtil::bits(const uint64_t *bitString,
+                                            bsl::size_t     index,
+                                            int             numBits)
+{
+    BSLS_ASSERT_SAFE(bitString);
+    BSLS_ASSERT_SAFE(0 <= numBits);
+    BSLS_ASSERT_SAFE(     numBits <= k_BITS_PER_UINT64);
+
+    if (0 == numBits) {
+        return 0;                                                     // RETURN
+    }
+
+    const bsl::size_t wordIndex = index / k_BITS_PER_UINT64;
+    const int         offset    = static_cast<int>(index % k_BITS_PER_UINT64);
+
+    uint64_t result = bitString[wordIndex] >> offset;
+
+    if (offset + numBits > k_BITS_PER_UINT64) {
+        result |= bitString[wordIndex + 1] << (k_BITS_PER_UINT64 - offset);
+    }
+
+    return numBits < k_BITS_PER_UINT64
+           ? result & ((static_cast<uint64_t>(1) << numBits) - 1)
+           : result;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
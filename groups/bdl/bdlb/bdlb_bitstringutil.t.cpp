@@ -0,0 +1,715 @@
+// bdlb_bitstringutil.t.cpp                                           -*-C++-*-
+#include <bdlb_bitstringutil.h>
+
+#include <bdls_testutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                TEST PLAN
+//-----------------------------------------------------------------------------
+//                                Overview
+//                                --------
+// The component under test provides static functions operating on bit strings
+// held in arrays of 'uint64_t'.  Each function is tested by comparing its
+// result, for many combinations of index, length, and bit pattern, with a
+// result computed one bit at a time.  Particular attention is paid to ranges
+// that begin or end at, or straddle, a word boundary, and to verifying that no
+// word outside of the specified range is modified.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 1] void assignBits(uint64_t *bs, size_t index, uint64_t src, int n);
+// [ 1] uint64_t bits(const uint64_t *bs, size_t index, int numBits);
+// [ 3] size_t findNth1(const uint64_t *bs, size_t length, size_t n);
+// [ 2] size_t num1(const uint64_t *bs, size_t index, size_t numBits);
+// [ 4] void pack(uint64_t *bs, const uint64_t *vals, size_t n, int w);
+// [ 4] void unpack(uint64_t *vals, const uint64_t *bs, size_t n, int w);
+//-----------------------------------------------------------------------------
+// [ 5] USAGE EXAMPLE
+// [-1] PERFORMANCE: RANK, SELECT, AND PACKING
+//-----------------------------------------------------------------------------
+
+//=============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlb::BitStringUtil Util;
+typedef Util::uint64_t      uint64_t;
+
+const int k_BITS_PER_UINT64 = Util::k_BITS_PER_UINT64;
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+uint64_t nextRandom(uint64_t *state)
+    // Advance the specified 'state' of a pseudo-random sequence, and return
+    // the next value in the sequence.
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state ^ (*state >> 29);
+}
+
+static
+void loadWords(bsl::vector<uint64_t> *words,
+               bsl::size_t            numWords,
+               int                    density,
+               uint64_t               seed)
+    // Load into the specified 'words' the specified 'numWords' pseudo-random
+    // words generated from the specified 'seed'.  If the specified 'density'
+    // is 0, each bit is set with a probability of about 1/16; if 'density' is
+    // 2, each bit is set with a probability of about 15/16; otherwise each bit
+    // is set with a probability of about 1/2.
+{
+    words->resize(numWords);
+    for (bsl::size_t i = 0; i < numWords; ++i) {
+        uint64_t word = nextRandom(&seed);
+        if (0 == density) {
+            word &= nextRandom(&seed) & nextRandom(&seed) & nextRandom(&seed);
+        }
+        else if (2 == density) {
+            word |= nextRandom(&seed) | nextRandom(&seed) | nextRandom(&seed);
+        }
+        (*words)[i] = word;
+    }
+}
+
+static
+bool bitAt(const bsl::vector<uint64_t>& words, bsl::size_t index)
+    // Return the value of the bit at the specified 'index' of the specified
+    // 'words'.
+{
+    return (words[index / k_BITS_PER_UINT64] >> (index % k_BITS_PER_UINT64))
+         & 1;
+}
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage examples provided in the component header file compile,
+        //:   link, and run as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage examples from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Packing a Column of Small Integers
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we store a column of values, each of which is known to be less
+// than 1000, and so fits in 10 bits.  We can store 64 such values in 10
+// words, rather than in the 64 words of a 'uint64_t' array.
+//
+// First, we create the column and the storage for its packed representation:
+//..
+    typedef bdlb::BitStringUtil::uint64_t uint64_t;
+
+    const int         k_WIDTH      = 10;
+    const bsl::size_t k_NUM_VALUES = 64;
+
+    uint64_t column[k_NUM_VALUES];
+    for (bsl::size_t i = 0; i < k_NUM_VALUES; ++i) {
+        column[i] = (i * 37) % 1000;
+    }
+
+    uint64_t packed[(k_NUM_VALUES * k_WIDTH + 63) / 64];
+    ASSERT(10 == sizeof packed / sizeof *packed);
+//..
+// Then, we pack the column:
+//..
+    bdlb::BitStringUtil::pack(packed, column, k_NUM_VALUES, k_WIDTH);
+//..
+// Next, we read a single value directly from the packed representation:
+//..
+    ASSERT(column[7] == bdlb::BitStringUtil::bits(packed, 7 * k_WIDTH,
+                                                  k_WIDTH));
+//..
+// Finally, we unpack the whole column, and observe that it is unchanged:
+//..
+    uint64_t unpacked[k_NUM_VALUES];
+    bdlb::BitStringUtil::unpack(unpacked, packed, k_NUM_VALUES, k_WIDTH);
+
+    for (bsl::size_t i = 0; i < k_NUM_VALUES; ++i) {
+        ASSERT(column[i] == unpacked[i]);
+    }
+//..
+//
+///Example 2: Rank and Select in a Bitmap Index
+/// - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a bitmap index records, for each of 200 rows of a table,
+// whether that row matches some predicate, and that the matching rows are
+// stored contiguously elsewhere.  The rank of a row locates its data among the
+// matching rows, and the select operation maps a position among the matching
+// rows back to a row.
+//
+// First, we create a bitmap in which every third row matches:
+//..
+    uint64_t bitmap[4] = { 0, 0, 0, 0 };
+    for (bsl::size_t row = 0; row < 200; row += 3) {
+        bdlb::BitStringUtil::assignBits(bitmap, row, 1, 1);
+    }
+//..
+// Then, we count the matching rows:
+//..
+    ASSERT(67 == bdlb::BitStringUtil::num1(bitmap, 0, 200));
+//..
+// Next, we compute the position of row 150 among the matching rows:
+//..
+    ASSERT(50 == bdlb::BitStringUtil::num1(bitmap, 0, 150));
+//..
+// Finally, we find the row that is at position 50 among the matching rows,
+// and observe that there is no row at position 67:
+//..
+    ASSERT(150 == bdlb::BitStringUtil::findNth1(bitmap, 200, 50));
+    const bsl::size_t row = bdlb::BitStringUtil::findNth1(bitmap, 200, 67);
+    ASSERT(bdlb::BitStringUtil::k_INVALID_INDEX == row);
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'pack' AND 'unpack'
+        //
+        // Concerns:
+        //: 1 'pack' stores the low-order 'width' bits of each value at the
+        //:   expected position, for every width in '[1 .. 64]', and ignores
+        //:   the other bits of each value.
+        //:
+        //: 2 'pack' sets the unused bits of the last word to 0, and writes no
+        //:   word beyond it.
+        //:
+        //: 3 'unpack' is the inverse of 'pack', and reads no word beyond those
+        //:   holding the packed values.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each width and for several numbers of values, pack
+        //:   pseudo-random values into a buffer filled with a guard pattern,
+        //:   and verify each value using 'bits', the unused bits, and the
+        //:   guard words.  (C-1..2)
+        //:
+        //: 2 Unpack the packed values from a buffer whose words past the end
+        //:   of the packed values are not initialized, and compare the result
+        //:   with the masked original values.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid widths.  (C-4)
+        //
+        // Testing:
+        //   void pack(uint64_t *bs, const uint64_t *vals, size_t n, int w);
+        //   void unpack(uint64_t *vals, const uint64_t *bs, size_t n, int w);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'pack' AND 'unpack'" << endl
+                          << "===========================" << endl;
+
+        const uint64_t GUARD = 0xdeadbeefcafef00dULL;
+
+        static const bsl::size_t NUM_VALUES[] = { 0, 1, 2, 3, 7, 64, 65, 200 };
+        const int NUM_NUM_VALUES = sizeof NUM_VALUES / sizeof *NUM_VALUES;
+
+        for (int width = 1; width <= k_BITS_PER_UINT64; ++width) {
+            const uint64_t MASK = width < k_BITS_PER_UINT64
+                                  ? (static_cast<uint64_t>(1) << width) - 1
+                                  : ~static_cast<uint64_t>(0);
+
+            for (int ti = 0; ti < NUM_NUM_VALUES; ++ti) {
+                const bsl::size_t NUM      = NUM_VALUES[ti];
+                const bsl::size_t NUM_BITS = NUM * width;
+                const bsl::size_t NUM_WORDS =
+                             (NUM_BITS + k_BITS_PER_UINT64 - 1)
+                                                           / k_BITS_PER_UINT64;
+
+                if (veryVerbose) { T_ P_(width) P(NUM) }
+
+                bsl::vector<uint64_t> values;
+                loadWords(&values, NUM, 1, width * 1000 + NUM);
+
+                bsl::vector<uint64_t> packed(NUM_WORDS + 2, GUARD);
+
+                Util::pack(packed.data(), values.data(), NUM, width);
+
+                for (bsl::size_t i = 0; i < NUM; ++i) {
+                    ASSERTV(width, NUM, i,
+                            (values[i] & MASK) == Util::bits(packed.data(),
+                                                             i * width,
+                                                             width));
+                }
+
+                const int UNUSED = static_cast<int>(
+                                 NUM_WORDS * k_BITS_PER_UINT64 - NUM_BITS);
+                if (UNUSED) {
+                    ASSERTV(width, NUM, 0 == Util::bits(packed.data(),
+                                                        NUM_BITS,
+                                                        UNUSED));
+                }
+                ASSERTV(width, NUM, GUARD == packed[NUM_WORDS]);
+                ASSERTV(width, NUM, GUARD == packed[NUM_WORDS + 1]);
+
+                // Copy into an exactly sized buffer, so that any read beyond
+                // the packed values can be detected by a memory checker.
+
+                bsl::vector<uint64_t> exact(packed.begin(),
+                                            packed.begin() + NUM_WORDS);
+                bsl::vector<uint64_t> unpacked(NUM + 1, GUARD);
+
+                Util::unpack(unpacked.data(), exact.data(), NUM, width);
+
+                for (bsl::size_t i = 0; i < NUM; ++i) {
+                    ASSERTV(width, NUM, i, (values[i] & MASK) == unpacked[i]);
+                }
+                ASSERTV(width, NUM, GUARD == unpacked[NUM]);
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            uint64_t packed[2]  = { 0, 0 };
+            uint64_t values[2]  = { 1, 2 };
+
+            ASSERT_PASS(Util::pack(packed, values, 2, 1));
+            ASSERT_PASS(Util::pack(packed, values, 2, 64));
+            ASSERT_FAIL(Util::pack(packed, values, 2, 0));
+            ASSERT_FAIL(Util::pack(packed, values, 2, 65));
+
+            ASSERT_PASS(Util::unpack(values, packed, 2, 1));
+            ASSERT_PASS(Util::unpack(values, packed, 2, 64));
+            ASSERT_FAIL(Util::unpack(values, packed, 2, 0));
+            ASSERT_FAIL(Util::unpack(values, packed, 2, 65));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'findNth1'
+        //
+        // Concerns:
+        //: 1 'findNth1' returns the index of the set bit preceded by exactly
+        //:   'n' set bits, for every 'n' less than the number of set bits.
+        //:
+        //: 2 'findNth1' ignores the bits at and beyond the specified length,
+        //:   and returns 'k_INVALID_INDEX' when there are not enough set bits.
+        //:
+        //: 3 'findNth1' is the inverse of the rank computed by 'num1'.
+        //
+        // Plan:
+        //: 1 For sparse, balanced, and dense pseudo-random bit strings, and
+        //:   for lengths around word boundaries, walk the set bits one at a
+        //:   time, and compare the result of 'findNth1' for each rank with the
+        //:   index of the bit.  (C-1, 3)
+        //:
+        //: 2 Verify that 'findNth1' returns 'k_INVALID_INDEX' for the number
+        //:   of set bits and beyond, with all bits past the length set.  (C-2)
+        //
+        // Testing:
+        //   size_t findNth1(const uint64_t *bs, size_t length, size_t n);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'findNth1'" << endl
+                          << "==================" << endl;
+
+        static const bsl::size_t LENGTHS[] = {
+            0, 1, 5, 63, 64, 65, 127, 128, 129, 500, 1024
+        };
+        const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        for (int density = 0; density < 3; ++density) {
+            for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+                const bsl::size_t LENGTH = LENGTHS[ti];
+                const bsl::size_t NUM_WORDS = LENGTH / k_BITS_PER_UINT64 + 1;
+
+                if (veryVerbose) { T_ P_(density) P(LENGTH) }
+
+                bsl::vector<uint64_t> words;
+                loadWords(&words, NUM_WORDS, density, LENGTH + 17);
+
+                // Set every bit past 'LENGTH'.
+
+                for (bsl::size_t i = LENGTH;
+                     i < NUM_WORDS * k_BITS_PER_UINT64;
+                     ++i) {
+                    words[i / k_BITS_PER_UINT64] |=
+                          static_cast<uint64_t>(1) << (i % k_BITS_PER_UINT64);
+                }
+
+                bsl::size_t rank = 0;
+                for (bsl::size_t i = 0; i < LENGTH; ++i) {
+                    if (bitAt(words, i)) {
+                        ASSERTV(density, LENGTH, rank, i,
+                                i == Util::findNth1(words.data(),
+                                                    LENGTH,
+                                                    rank));
+                        ASSERTV(density, LENGTH, rank, i,
+                                rank == Util::num1(words.data(), 0, i));
+                        ++rank;
+                    }
+                }
+
+                for (bsl::size_t n = rank; n < rank + 3; ++n) {
+                    ASSERTV(density, LENGTH, n,
+                            Util::k_INVALID_INDEX ==
+                                      Util::findNth1(words.data(), LENGTH, n));
+                }
+            }
+        }
+
+        if (verbose) cout << "\nTesting every bit of a word." << endl;
+        {
+            for (int i = 0; i < k_BITS_PER_UINT64; ++i) {
+                const uint64_t ALL  = ~static_cast<uint64_t>(0);
+                const uint64_t ONE  = static_cast<uint64_t>(1) << i;
+
+                ASSERTV(i, static_cast<bsl::size_t>(i) ==
+                                               Util::findNth1(&ALL, 64, i));
+                ASSERTV(i, static_cast<bsl::size_t>(i) ==
+                                               Util::findNth1(&ONE, 64, 0));
+                ASSERTV(i, Util::k_INVALID_INDEX ==
+                                               Util::findNth1(&ONE, i, 0));
+            }
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'num1'
+        //
+        // Concerns:
+        //: 1 'num1' returns the number of set bits in the specified range, for
+        //:   ranges that begin and end anywhere within a word, including
+        //:   ranges within a single word and ranges of whole words.
+        //:
+        //: 2 'num1' ignores the bits outside the specified range.
+        //:
+        //: 3 Ranges of every length modulo the unrolling of the word loop are
+        //:   counted correctly.
+        //
+        // Plan:
+        //: 1 For sparse, balanced, and dense pseudo-random bit strings, and
+        //:   for every combination of a set of starting indices and lengths,
+        //:   compare the result of 'num1' with a count of the bits made one
+        //:   bit at a time.  (C-1..3)
+        //
+        // Testing:
+        //   size_t num1(const uint64_t *bs, size_t index, size_t numBits);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'num1'" << endl
+                          << "==============" << endl;
+
+        const bsl::size_t NUM_WORDS = 12;
+
+        for (int density = 0; density < 3; ++density) {
+            bsl::vector<uint64_t> words;
+            loadWords(&words, NUM_WORDS, density, density + 1);
+
+            for (bsl::size_t index = 0; index < 140; ++index) {
+                bsl::size_t expected = 0;
+
+                for (bsl::size_t numBits = 0;
+                     index + numBits <= NUM_WORDS * k_BITS_PER_UINT64;
+                     ++numBits) {
+                    if (numBits) {
+                        expected += bitAt(words, index + numBits - 1);
+                    }
+
+                    ASSERTV(density, index, numBits, expected,
+                            expected == Util::num1(words.data(),
+                                                   index,
+                                                   numBits));
+                }
+            }
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // TESTING 'bits' AND 'assignBits'
+        //
+        // Concerns:
+        //: 1 'bits' returns the specified bits as the low-order bits of the
+        //:   result, for any index and for every 'numBits' in '[0 .. 64]',
+        //:   including ranges that straddle a word boundary.
+        //:
+        //: 2 'assignBits' assigns the low-order 'numBits' of the source,
+        //:   ignores its other bits, and leaves every other bit of the bit
+        //:   string unchanged.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each index in the first three words and each number of bits,
+        //:   compare the result of 'bits' with a value assembled one bit at a
+        //:   time.  (C-1)
+        //:
+        //: 2 For the same ranges, assign a pseudo-random value to a copy of a
+        //:   bit string, and verify each bit of the result.  (C-2)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid numbers of bits.  (C-3)
+        //
+        // Testing:
+        //   void assignBits(uint64_t *bs, size_t index, uint64_t src, int n);
+        //   uint64_t bits(const uint64_t *bs, size_t index, int numBits);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'bits' AND 'assignBits'" << endl
+                          << "===============================" << endl;
+
+        const bsl::size_t NUM_WORDS = 4;
+
+        bsl::vector<uint64_t> words;
+        loadWords(&words, NUM_WORDS, 1, 12345);
+
+        uint64_t seed = 1;
+
+        for (bsl::size_t index = 0; index < 3 * k_BITS_PER_UINT64; ++index) {
+            for (int numBits = 0; numBits <= k_BITS_PER_UINT64; ++numBits) {
+                if (veryVeryVerbose) { T_ P_(index) P(numBits) }
+
+                uint64_t expected = 0;
+                for (int i = 0; i < numBits; ++i) {
+                    expected |= static_cast<uint64_t>(bitAt(words, index + i))
+                                                                         << i;
+                }
+                ASSERTV(index, numBits,
+                        expected == Util::bits(words.data(), index, numBits));
+
+                const uint64_t SRC = nextRandom(&seed);
+
+                bsl::vector<uint64_t> result(words);
+                Util::assignBits(result.data(), index, SRC, numBits);
+
+                for (bsl::size_t i = 0; i < NUM_WORDS * k_BITS_PER_UINT64;
+                                                                        ++i) {
+                    const bool EXP = i >= index && i < index + numBits
+                                     ? (SRC >> (i - index)) & 1
+                                     : bitAt(words, i);
+
+                    ASSERTV(index, numBits, i, EXP == bitAt(result, i));
+                }
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            uint64_t bitString[2] = { 0, 0 };
+
+            ASSERT_SAFE_PASS(Util::bits(bitString, 0, 0));
+            ASSERT_SAFE_PASS(Util::bits(bitString, 0, 64));
+            ASSERT_SAFE_FAIL(Util::bits(bitString, 0, -1));
+            ASSERT_SAFE_FAIL(Util::bits(bitString, 0, 65));
+
+            ASSERT_SAFE_PASS(Util::assignBits(bitString, 0, 0, 0));
+            ASSERT_SAFE_PASS(Util::assignBits(bitString, 0, 0, 64));
+            ASSERT_SAFE_FAIL(Util::assignBits(bitString, 0, 0, -1));
+            ASSERT_SAFE_FAIL(Util::assignBits(bitString, 0, 0, 65));
+        }
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: RANK, SELECT, AND PACKING
+        //
+        // Concerns:
+        //: 1 Provide a benchmark of 'num1', 'findNth1', 'pack', and 'unpack'
+        //:   on a bit string of 2^16 words, compared with the same operations
+        //:   implemented one bit or one value at a time.
+        //
+        // Plan:
+        //: 1 Using 'bsls::Stopwatch', time each operation.  The results are
+        //:   meant only for comparison.
+        //
+        // Testing:
+        //   PERFORMANCE: RANK, SELECT, AND PACKING
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: RANK, SELECT, AND PACKING" << endl
+             << "======================================" << endl;
+
+        const bsl::size_t NUM_WORDS = 1 << 16;
+        const bsl::size_t NUM_BITS  = NUM_WORDS * k_BITS_PER_UINT64;
+        const int         NUM_ITERATIONS = 20;
+
+        bsl::vector<uint64_t> words;
+        loadWords(&words, NUM_WORDS, 1, 42);
+
+        bsls::Stopwatch timer;
+        bsl::size_t     sum = 0;
+
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            sum += Util::num1(words.data(), i, NUM_BITS - i);
+        }
+        timer.stop();
+        cout << "num1:               " << timer.elapsedTime() << "s" << endl;
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            for (bsl::size_t j = i; j < NUM_BITS; ++j) {
+                sum += bitAt(words, j);
+            }
+        }
+        timer.stop();
+        cout << "num1 (bitwise):     " << timer.elapsedTime() << "s" << endl;
+
+        const bsl::size_t NUM_SELECTS = 1 << 16;
+
+        timer.reset();
+        timer.start();
+        for (bsl::size_t i = 0; i < NUM_SELECTS; ++i) {
+            sum += Util::findNth1(words.data(), 64 * 64, i % 2000);
+        }
+        timer.stop();
+        cout << "findNth1:           " << timer.elapsedTime() << "s" << endl;
+
+        const int             WIDTH      = 13;
+        const bsl::size_t     NUM_VALUES = NUM_BITS / WIDTH;
+        bsl::vector<uint64_t> values(NUM_VALUES);
+        bsl::vector<uint64_t> packed(NUM_WORDS);
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            Util::unpack(values.data(), words.data(), NUM_VALUES, WIDTH);
+            Util::pack(packed.data(), values.data(), NUM_VALUES, WIDTH);
+        }
+        timer.stop();
+        cout << "unpack + pack:      " << timer.elapsedTime() << "s" << endl;
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            for (bsl::size_t j = 0; j < NUM_VALUES; ++j) {
+                values[j] = Util::bits(words.data(), j * WIDTH, WIDTH);
+            }
+            for (bsl::size_t j = 0; j < NUM_VALUES; ++j) {
+                Util::assignBits(packed.data(), j * WIDTH, values[j], WIDTH);
+            }
+        }
+        timer.stop();
+        cout << "bits + assignBits:  " << timer.elapsedTime() << "s" << endl;
+
+        if (veryVerbose) {
+            P(sum);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,298 @@
+// bdlc_bitarray.cpp                                                  -*-C++-*-
+#include <bdlc_bitarray.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlc_bitarray_cpp,"$Id$ $CSID$")
+
+#include <bslim_printer.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_ostream.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                               // --------------
+                               // class BitArray
+                               // --------------
+
+// PUBLIC CLASS DATA
+const bsl::size_t BitArray::k_INVALID_INDEX = ~static_cast<bsl::size_t>(0);
+
+// CREATORS
+BitArray::BitArray(bsl::size_t       initialLength,
+                   bool              value,
+                   bslma::Allocator *basicAllocator)
+: d_array(arraySize(initialLength),
+          value ? ~static_cast<WordType>(0) : 0,
+          basicAllocator)
+, d_length(initialLength)
+{
+    clearUnusedBits();
+}
+
+// MANIPULATORS
+BitArray& BitArray::operator=(const BitArray& rhs)
+{
+    d_array  = rhs.d_array;
+    d_length = rhs.d_length;
+
+    return *this;
+}
+
+BitArray& BitArray::operator&=(const BitArray& rhs)
+{
+    BSLS_ASSERT(d_length == rhs.d_length);
+
+    WordType       *dst = d_array.data();
+    const WordType *src = rhs.d_array.data();
+
+    for (bsl::size_t i = 0; i < d_array.size(); ++i) {
+        dst[i] &= src[i];
+    }
+
+    return *this;
+}
+
+BitArray& BitArray::operator-=(const BitArray& rhs)
+{
+    BSLS_ASSERT(d_length == rhs.d_length);
+
+    WordType       *dst = d_array.data();
+    const WordType *src = rhs.d_array.data();
+
+    for (bsl::size_t i = 0; i < d_array.size(); ++i) {
+        dst[i] &= ~src[i];
+    }
+
+    return *this;
+}
+
+BitArray& BitArray::operator|=(const BitArray& rhs)
+{
+    BSLS_ASSERT(d_length == rhs.d_length);
+
+    WordType       *dst = d_array.data();
+    const WordType *src = rhs.d_array.data();
+
+    for (bsl::size_t i = 0; i < d_array.size(); ++i) {
+        dst[i] |= src[i];
+    }
+
+    return *this;
+}
+
+BitArray& BitArray::operator^=(const BitArray& rhs)
+{
+    BSLS_ASSERT(d_length == rhs.d_length);
+
+    WordType       *dst = d_array.data();
+    const WordType *src = rhs.d_array.data();
+
+    for (bsl::size_t i = 0; i < d_array.size(); ++i) {
+        dst[i] ^= src[i];
+    }
+
+    return *this;
+}
+
+void BitArray::append(bool value)
+{
+    if (0 == d_length % k_BITS_PER_WORD) {
+        d_array.push_back(0);
+    }
+
+    ++d_length;
+
+    if (value) {
+        assign1(d_length - 1);
+    }
+}
+
+void BitArray::assignAll0()
+{
+    bsl::fill(d_array.begin(), d_array.end(), static_cast<WordType>(0));
+}
+
+void BitArray::assignAll1()
+{
+    bsl::fill(d_array.begin(), d_array.end(), ~static_cast<WordType>(0));
+    clearUnusedBits();
+}
+
+void BitArray::setLength(bsl::size_t newLength, bool value)
+{
+    const bsl::size_t oldLength = d_length;
+
+    d_array.resize(arraySize(newLength), value ? ~static_cast<WordType>(0)
+                                               : 0);
+
+    if (value && newLength > oldLength) {
+        // Set the bits of the formerly last word beyond the old length.
+
+        const bsl::size_t offset = oldLength % k_BITS_PER_WORD;
+
+        if (offset) {
+            d_array[oldLength / k_BITS_PER_WORD] |=
+                                        ~static_cast<WordType>(0) << offset;
+        }
+    }
+
+    d_length = newLength;
+    clearUnusedBits();
+}
+
+void BitArray::swap(BitArray& other)
+{
+    // 'swap' is undefined for objects with non-equal allocators.
+
+    BSLS_ASSERT(allocator() == other.allocator());
+
+    d_array.swap(other.d_array);
+    bsl::swap(d_length, other.d_length);
+}
+
+void BitArray::toggleAll()
+{
+    for (bsl::size_t i = 0; i < d_array.size(); ++i) {
+        d_array[i] = ~d_array[i];
+    }
+    clearUnusedBits();
+}
+
+// ACCESSORS
+bsl::size_t BitArray::find1AtMinIndex(bsl::size_t begin) const
+{
+    if (begin >= d_length) {
+        return k_INVALID_INDEX;                                       // RETURN
+    }
+
+    const WordType mask = ~static_cast<WordType>(0)
+                                              << (begin % k_BITS_PER_WORD);
+
+    bsl::size_t i    = begin / k_BITS_PER_WORD;
+    WordType    word = d_array[i] & mask;
+
+    while (!word) {
+        if (++i == d_array.size()) {
+            return k_INVALID_INDEX;                                   // RETURN
+        }
+        word = d_array[i];
+    }
+
+    return i * k_BITS_PER_WORD + bdlb::BitUtil::numTrailingUnsetBits(word);
+}
+
+bool BitArray::intersects(const BitArray& other) const
+{
+    const bsl::size_t  numWords = bsl::min(d_array.size(),
+                                           other.d_array.size());
+    const WordType    *lhs      = d_array.data();
+    const WordType    *rhs      = other.d_array.data();
+
+    for (bsl::size_t i = 0; i < numWords; ++i) {
+        if (lhs[i] & rhs[i]) {
+            return true;                                              // RETURN
+        }
+    }
+    return false;
+}
+
+bool BitArray::isAny0() const
+{
+    return num1() != d_length;
+}
+
+bool BitArray::isAny1() const
+{
+    for (bsl::size_t i = 0; i < d_array.size(); ++i) {
+        if (d_array[i]) {
+            return true;                                              // RETURN
+        }
+    }
+    return false;
+}
+
+bsl::size_t BitArray::num1() const
+{
+    bsl::size_t sum = 0;
+
+    for (bsl::size_t i = 0; i < d_array.size(); ++i) {
+        sum += bdlb::BitUtil::numBitsSet(d_array[i]);
+    }
+    return sum;
+}
+
+                                  // Aspects
+
+bsl::ostream& BitArray::print(bsl::ostream& stream,
+                              int           level,
+                              int           spacesPerLevel) const
+{
+    if (stream.bad()) {
+        return stream;                                                // RETURN
+    }
+
+    bslim::Printer printer(&stream, level, spacesPerLevel);
+    printer.start(true);  // 'true' -> suppress '['
+    for (bsl::size_t i = d_length; i > 0; --i) {
+        stream << ((*this)[i - 1] ? '1' : '0');
+    }
+    printer.end(true);    // 'true' -> suppress ']'
+
+    return stream;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+bdlc::BitArray bdlc::operator&(const BitArray& lhs, const BitArray& rhs)
+{
+    BitArray result(lhs);
+    result &= rhs;
+    return result;
+}
+
+bdlc::BitArray bdlc::operator-(const BitArray& lhs, const BitArray& rhs)
+{
+    BitArray result(lhs);
+    result -= rhs;
+    return result;
+}
+
+bdlc::BitArray bdlc::operator|(const BitArray& lhs, const BitArray& rhs)
+{
+    BitArray result(lhs);
+    result |= rhs;
+    return result;
+}
+
+bdlc::BitArray bdlc::operator^(const BitArray& lhs, const BitArray& rhs)
+{
+    BitArray result(lhs);
+    result ^= rhs;
+    return result;
+}
+
+bsl::ostream& bdlc::operator<<(bsl::ostream& stream, const BitArray& array)
+{
+    return array.print(stream, 0, -1);
+}
+
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
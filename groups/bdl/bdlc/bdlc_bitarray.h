@@ -0,0 +1,553 @@
+// bdlc_bitarray.h                                                    -*-C++-*-
+#ifndef INCLUDED_BDLC_BITARRAY
+#define INCLUDED_BDLC_BITARRAY
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a space-efficient, allocator-aware array of bits.
+//
+//@CLASSES:
+//  bdlc::BitArray: run-time sized, allocator-aware array of bits
+//
+//@SEE_ALSO: bslstl_bitset, bdlb_bitutil
+//
+//@DESCRIPTION: This component provides a value-semantic class,
+// 'bdlc::BitArray', that holds a sequence of bits whose length is set at run
+// time, much as 'bsl::bitset' holds a sequence of bits whose length is set at
+// compile time.  The bits are stored, 64 to a word, in memory obtained from
+// the 'bslma::Allocator' supplied at construction (or the currently installed
+// default allocator).  A bit array can grow by 'append', and can shrink or
+// grow by 'setLength'.
+//
+// The bulk operations -- 'num1', 'isAny1', 'intersects', the bitwise
+// assignment operators, and the scans for set bits -- process a whole 64-bit
+// word per step, using the population-count and count-trailing-zeros
+// operations of 'bdlb::BitUtil', which map to single instructions on
+// platforms that provide them.  The loops over the words of two arrays are
+// simple enough that an optimizing compiler may vectorize them for the target
+// instruction set.
+//
+///Finding Set Bits
+///----------------
+// 'find1AtMinIndex' returns the index of the lowest set bit at or above a
+// given index, or 'k_INVALID_INDEX' if there is none, so that the set bits of
+// an array can be visited in increasing order of index without testing each
+// bit:
+//..
+//  for (bsl::size_t i = array.find1AtMinIndex(0);
+//       bdlc::BitArray::k_INVALID_INDEX != i;
+//       i = array.find1AtMinIndex(i + 1)) {
+//      // ... bit 'i' is set ...
+//  }
+//..
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Matching Subscriptions
+///- - - - - - - - - - - - - - - - -
+// Suppose that a message publisher assigns a small integer identifier to each
+// topic, and that each client subscribes to a set of topics, which we
+// represent as a 'bdlc::BitArray' indexed by topic identifier.
+//
+// First, we create the subscriptions of two clients:
+//..
+//  bslma::TestAllocator ta;
+//
+//  const bsl::size_t NUM_TOPICS = 100000;
+//
+//  bdlc::BitArray alice(NUM_TOPICS, false, &ta);
+//  bdlc::BitArray bob(NUM_TOPICS, false, &ta);
+//
+//  alice.assign1(17);
+//  alice.assign1(4242);
+//  alice.assign1(99999);
+//
+//  bob.assign1(4242);
+//  bob.assign1(50000);
+//
+//  assert(3 == alice.num1());
+//  assert(2 == bob.num1());
+//..
+// Then, we represent the topics of a published message in another bit array,
+// and determine which clients are interested in the message:
+//..
+//  bdlc::BitArray message(NUM_TOPICS, false, &ta);
+//  message.assign1(50000);
+//  message.assign1(99999);
+//
+//  assert(true == alice.intersects(message));
+//  assert(true == bob.intersects(message));
+//
+//  message.assign0(99999);
+//
+//  assert(false == alice.intersects(message));
+//..
+// Next, we compute the topics to which both clients subscribe:
+//..
+//  bdlc::BitArray common(alice, &ta);
+//  common &= bob;
+//
+//  assert(1    == common.num1());
+//  assert(4242 == common.find1AtMinIndex(0));
+//..
+// Finally, we visit each topic to which 'alice' subscribes, in increasing
+// order:
+//..
+//  bsl::size_t topics[3];
+//  int         numTopics = 0;
+//
+//  for (bsl::size_t i = alice.find1AtMinIndex(0);
+//       bdlc::BitArray::k_INVALID_INDEX != i;
+//       i = alice.find1AtMinIndex(i + 1)) {
+//      topics[numTopics++] = i;
+//  }
+//
+//  assert(3     == numTopics);
+//  assert(17    == topics[0]);
+//  assert(4242  == topics[1]);
+//  assert(99999 == topics[2]);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLB_BITUTIL
+#include <bdlb_bitutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
+#include <bslmf_isbitwisemoveable.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOSFWD
+#include <bsl_iosfwd.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                               // ==============
+                               // class BitArray
+                               // ==============
+
+class BitArray {
+    // This class implements a value-semantic, run-time sized array of bits.
+    // The bits beyond 'length()' in the last word of the array are always 0.
+
+  public:
+    // PUBLIC TYPES
+    typedef bdlb::BitUtil::uint64_t WordType;
+        // Type of the words holding the bits of a 'BitArray'.
+
+    // PUBLIC CLASS DATA
+    static const bsl::size_t k_INVALID_INDEX;
+        // Value returned by the 'find' methods when no bit is found.
+
+    enum { k_BITS_PER_WORD = 64 };  // number of bits per word
+
+  private:
+    // DATA
+    bsl::vector<WordType> d_array;   // words, 'd_array[0]' holds bits 0..63
+    bsl::size_t           d_length;  // number of bits
+
+    // FRIENDS
+    friend bool operator==(const BitArray&, const BitArray&);
+
+    // PRIVATE CLASS METHODS
+    static bsl::size_t arraySize(bsl::size_t numBits);
+        // Return the number of words needed to hold the specified 'numBits'.
+
+    // PRIVATE MANIPULATORS
+    void clearUnusedBits();
+        // Set to 0 the bits of the last word of this array at and beyond
+        // index 'length()'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(BitArray, bslma::UsesBslmaAllocator);
+    BSLMF_NESTED_TRAIT_DECLARATION(BitArray, bslmf::IsBitwiseMoveable);
+
+    // CREATORS
+    explicit BitArray(bslma::Allocator *basicAllocator = 0);
+    explicit BitArray(bsl::size_t       initialLength,
+                      bool              value = false,
+                      bslma::Allocator *basicAllocator = 0);
+        // Create an array of the optionally specified 'initialLength' bits,
+        // each having the optionally specified 'value'.  If 'initialLength'
+        // is not specified, the array is empty.  If 'value' is not specified,
+        // each bit is 0.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    BitArray(const BitArray& original, bslma::Allocator *basicAllocator = 0);
+        // Create an array having the value of the specified 'original'
+        // array.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.
+
+    ~BitArray();
+        // Destroy this object.
+
+    // MANIPULATORS
+    BitArray& operator=(const BitArray& rhs);
+        // Assign to this array the value of the specified 'rhs' array, and
+        // return a reference providing modifiable access to this array.
+
+    BitArray& operator&=(const BitArray& rhs);
+        // Set to 0 each bit of this array whose corresponding bit in the
+        // specified 'rhs' array is 0, and return a reference providing
+        // modifiable access to this array.  The behavior is undefined unless
+        // 'length() == rhs.length()'.
+
+    BitArray& operator-=(const BitArray& rhs);
+        // Set to 0 each bit of this array whose corresponding bit in the
+        // specified 'rhs' array is 1, and return a reference providing
+        // modifiable access to this array.  The behavior is undefined unless
+        // 'length() == rhs.length()'.
+
+    BitArray& operator|=(const BitArray& rhs);
+        // Set to 1 each bit of this array whose corresponding bit in the
+        // specified 'rhs' array is 1, and return a reference providing
+        // modifiable access to this array.  The behavior is undefined unless
+        // 'length() == rhs.length()'.
+
+    BitArray& operator^=(const BitArray& rhs);
+        // Toggle each bit of this array whose corresponding bit in the
+        // specified 'rhs' array is 1, and return a reference providing
+        // modifiable access to this array.  The behavior is undefined unless
+        // 'length() == rhs.length()'.
+
+    void append(bool value);
+        // Append to this array a bit having the specified 'value'.
+
+    void assign(bsl::size_t index, bool value);
+        // Set the bit at the specified 'index' of this array to the specified
+        // 'value'.  The behavior is undefined unless 'index < length()'.
+
+    void assign0(bsl::size_t index);
+        // Set the bit at the specified 'index' of this array to 0.  The
+        // behavior is undefined unless 'index < length()'.
+
+    void assign1(bsl::size_t index);
+        // Set the bit at the specified 'index' of this array to 1.  The
+        // behavior is undefined unless 'index < length()'.
+
+    void assignAll0();
+        // Set every bit of this array to 0.
+
+    void assignAll1();
+        // Set every bit of this array to 1.
+
+    void removeAll();
+        // Remove all bits from this array, leaving its capacity unchanged.
+
+    void reserveCapacity(bsl::size_t numBits);
+        // Reserve sufficient memory for this array to hold at least the
+        // specified 'numBits' without allocating.
+
+    void setLength(bsl::size_t newLength, bool value = false);
+        // Set the number of bits in this array to the specified 'newLength'.
+        // If 'newLength > length()', each added bit has the optionally
+        // specified 'value', or is 0 if 'value' is not specified.
+
+    void swap(BitArray& other);
+        // Efficiently exchange the value of this array with that of the
+        // specified 'other' array.  The behavior is undefined unless this
+        // array and 'other' use the same allocator.
+
+    void toggle(bsl::size_t index);
+        // Toggle the bit at the specified 'index' of this array.  The
+        // behavior is undefined unless 'index < length()'.
+
+    void toggleAll();
+        // Toggle every bit of this array.
+
+    // ACCESSORS
+    bool operator[](bsl::size_t index) const;
+        // Return the value of the bit at the specified 'index' of this array.
+        // The behavior is undefined unless 'index < length()'.
+
+    bsl::size_t find1AtMinIndex(bsl::size_t begin) const;
+        // Return the lowest index, not less than the specified 'begin', of a
+        // bit of this array that is 1, or 'k_INVALID_INDEX' if there is no
+        // such bit.
+
+    bool intersects(const BitArray& other) const;
+        // Return 'true' if any bit of this array is 1 and the bit at the same
+        // index of the specified 'other' array is 1, and 'false' otherwise.
+        // Note that the arrays may have different lengths, and that no memory
+        // is allocated.
+
+    bool isAny0() const;
+        // Return 'true' if any bit of this array is 0, and 'false' otherwise.
+
+    bool isAny1() const;
+        // Return 'true' if any bit of this array is 1, and 'false' otherwise.
+
+    bsl::size_t length() const;
+        // Return the number of bits in this array.
+
+    bsl::size_t num1() const;
+        // Return the number of bits of this array that are 1.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this array to supply memory.
+
+    bsl::ostream& print(bsl::ostream& stream,
+                        int           level = 0,
+                        int           spacesPerLevel = 4) const;
+        // Write the value of this array to the specified output 'stream' in a
+        // human-readable format, and return a reference to 'stream'.
+        // Optionally specify an initial indentation 'level', whose absolute
+        // value is incremented recursively for nested objects.  If 'level' is
+        // specified, optionally specify 'spacesPerLevel', whose absolute value
+        // indicates the number of spaces per indentation level for this and
+        // all of its nested objects.  If 'level' is negative, suppress
+        // indentation of the first line.  If 'spacesPerLevel' is negative,
+        // format the entire output on one line, suppressing all but the
+        // initial indentation (as governed by 'level').  If 'stream' is not
+        // valid on entry, this operation has no effect.  Note that the bits
+        // are written as '0' and '1' characters in decreasing order of index,
+        // as 'bsl::bitset' writes its bits.
+};
+
+// FREE OPERATORS
+bool operator==(const BitArray& lhs, const BitArray& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' arrays have the same
+    // value, and 'false' otherwise.  Two arrays have the same value if they
+    // have the same length, and the bits at each index have the same value.
+
+bool operator!=(const BitArray& lhs, const BitArray& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' arrays do not have the
+    // same value, and 'false' otherwise.  Two arrays do not have the same
+    // value if they have different lengths, or the bits at some index have
+    // different values.
+
+BitArray operator&(const BitArray& lhs, const BitArray& rhs);
+BitArray operator-(const BitArray& lhs, const BitArray& rhs);
+BitArray operator|(const BitArray& lhs, const BitArray& rhs);
+BitArray operator^(const BitArray& lhs, const BitArray& rhs);
+    // Return an array, using the default allocator, whose value is the result
+    // of applying the corresponding bitwise assignment operator to a copy of
+    // the specified 'lhs' and the specified 'rhs' arrays.  The behavior is
+    // undefined unless 'lhs.length() == rhs.length()'.
+
+bsl::ostream& operator<<(bsl::ostream& stream, const BitArray& array);
+    // Write the value of the specified 'array' to the specified output
+    // 'stream' in a single-line format, and return a reference to 'stream'.
+    // If 'stream' is not valid on entry, this operation has no effect.
+
+// FREE FUNCTIONS
+void swap(BitArray& a, BitArray& b);
+    // Exchange the values of the specified 'a' and 'b' arrays.  This function
+    // provides the no-throw exception-safety guarantee if the two arrays use
+    // the same allocator, and the basic guarantee otherwise.
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                               // --------------
+                               // class BitArray
+                               // --------------
+
+// PRIVATE CLASS METHODS
+inline
+bsl::size_t BitArray::arraySize(bsl::size_t numBits)
+{
+    return (numBits + k_BITS_PER_WORD - 1) / k_BITS_PER_WORD;
+}
+
+// PRIVATE MANIPULATORS
+inline
+void BitArray::clearUnusedBits()
+{
+    const bsl::size_t offset = d_length % k_BITS_PER_WORD;
+
+    if (offset) {
+        d_array.back() &= ~(~static_cast<WordType>(0) << offset);
+    }
+}
+
+// CREATORS
+inline
+BitArray::BitArray(bslma::Allocator *basicAllocator)
+: d_array(basicAllocator)
+, d_length(0)
+{
+}
+
+inline
+BitArray::BitArray(const BitArray& original, bslma::Allocator *basicAllocator)
+: d_array(original.d_array, basicAllocator)
+, d_length(original.d_length)
+{
+}
+
+inline
+BitArray::~BitArray()
+{
+    BSLS_ASSERT_SAFE(arraySize(d_length) == d_array.size());
+}
+
+// MANIPULATORS
+inline
+void BitArray::assign(bsl::size_t index, bool value)
+{
+    BSLS_ASSERT_SAFE(index < d_length);
+
+    if (value) {
+        assign1(index);
+    }
+    else {
+        assign0(index);
+    }
+}
+
+inline
+void BitArray::assign0(bsl::size_t index)
+{
+    BSLS_ASSERT_SAFE(index < d_length);
+
+    d_array[index / k_BITS_PER_WORD] &=
+                   ~(static_cast<WordType>(1) << (index % k_BITS_PER_WORD));
+}
+
+inline
+void BitArray::assign1(bsl::size_t index)
+{
+    BSLS_ASSERT_SAFE(index < d_length);
+
+    d_array[index / k_BITS_PER_WORD] |=
+                     static_cast<WordType>(1) << (index % k_BITS_PER_WORD);
+}
+
+inline
+void BitArray::removeAll()
+{
+    d_array.clear();
+    d_length = 0;
+}
+
+inline
+void BitArray::reserveCapacity(bsl::size_t numBits)
+{
+    d_array.reserve(arraySize(numBits));
+}
+
+inline
+void BitArray::toggle(bsl::size_t index)
+{
+    BSLS_ASSERT_SAFE(index < d_length);
+
+    d_array[index / k_BITS_PER_WORD] ^=
+                     static_cast<WordType>(1) << (index % k_BITS_PER_WORD);
+}
+
+// ACCESSORS
+inline
+bool BitArray::operator[](bsl::size_t index) const
+{
+    BSLS_ASSERT_SAFE(index < d_length);
+
+    return (d_array[index / k_BITS_PER_WORD]
+                                        >> (index % k_BITS_PER_WORD)) & 1;
+}
+
+inline
+bsl::size_t BitArray::length() const
+{
+    return d_length;
+}
+
+                                  // Aspects
+
+inline
+bslma::Allocator *BitArray::allocator() const
+{
+    return d_array.get_allocator().mechanism();
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+inline
+bool bdlc::operator==(const BitArray& lhs, const BitArray& rhs)
+{
+    return lhs.d_length == rhs.d_length && lhs.d_array == rhs.d_array;
+}
+
+inline
+bool bdlc::operator!=(const BitArray& lhs, const BitArray& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+inline
+void bdlc::swap(BitArray& a, BitArray& b)
+{
+    if (a.allocator() == b.allocator()) {
+        a.swap(b);
+
+        return;                                                       // RETURN
+    }
+
+    BitArray futureA(b, a.allocator());
+    BitArray futureB(a, b.allocator());
+
+    futureA.swap(a);
+    futureB.swap(b);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
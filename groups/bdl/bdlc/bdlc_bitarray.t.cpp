@@ -0,0 +1,949 @@
+// bdlc_bitarray.t.cpp                                                -*-C++-*-
+#include <bdlc_bitarray.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_isbitwisemoveable.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test implements a value-semantic array of bits.  The
+// primary concerns are that each operation produces the same result as the
+// corresponding operation applied to each bit in turn, including for arrays
+// whose length is not a multiple of the word size, that the bits beyond the
+// length of an array never become set, and that all memory is supplied by
+// the array's allocator.  We compare each operation against a
+// 'bsl::vector<bool>' holding the same bits.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] BitArray(bslma::Allocator *basicAllocator = 0);
+// [ 2] BitArray(size_t initialLength, bool value = false, Allocator *ba = 0);
+// [ 2] BitArray(const BitArray& original, bslma::Allocator *ba = 0);
+// [ 2] ~BitArray();
+//
+// MANIPULATORS
+// [ 2] BitArray& operator=(const BitArray& rhs);
+// [ 3] BitArray& operator&=(const BitArray& rhs);
+// [ 3] BitArray& operator-=(const BitArray& rhs);
+// [ 3] BitArray& operator|=(const BitArray& rhs);
+// [ 3] BitArray& operator^=(const BitArray& rhs);
+// [ 2] void append(bool value);
+// [ 2] void assign(bsl::size_t index, bool value);
+// [ 2] void assign0(bsl::size_t index);
+// [ 2] void assign1(bsl::size_t index);
+// [ 3] void assignAll0();
+// [ 3] void assignAll1();
+// [ 2] void removeAll();
+// [ 2] void reserveCapacity(bsl::size_t numBits);
+// [ 2] void setLength(bsl::size_t newLength, bool value = false);
+// [ 2] void swap(BitArray& other);
+// [ 3] void toggle(bsl::size_t index);
+// [ 3] void toggleAll();
+//
+// ACCESSORS
+// [ 2] bool operator[](bsl::size_t index) const;
+// [ 3] bsl::size_t find1AtMinIndex(bsl::size_t begin) const;
+// [ 3] bool intersects(const BitArray& other) const;
+// [ 3] bool isAny0() const;
+// [ 3] bool isAny1() const;
+// [ 2] bsl::size_t length() const;
+// [ 3] bsl::size_t num1() const;
+// [ 2] bslma::Allocator *allocator() const;
+// [ 2] ostream& print(ostream& stream, int level = 0, int spl = 4) const;
+//
+// FREE OPERATORS
+// [ 2] bool operator==(const BitArray& lhs, const BitArray& rhs);
+// [ 2] bool operator!=(const BitArray& lhs, const BitArray& rhs);
+// [ 3] BitArray operator&(const BitArray& lhs, const BitArray& rhs);
+// [ 3] BitArray operator-(const BitArray& lhs, const BitArray& rhs);
+// [ 3] BitArray operator|(const BitArray& lhs, const BitArray& rhs);
+// [ 3] BitArray operator^(const BitArray& lhs, const BitArray& rhs);
+// [ 2] ostream& operator<<(ostream& stream, const BitArray& array);
+// [ 2] void swap(BitArray& a, BitArray& b);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] USAGE EXAMPLE
+// [-1] PERFORMANCE: INTERSECTING LARGE ARRAYS
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlc::BitArray    Obj;
+typedef bsl::vector<bool> Model;
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+bool patternBit(bsl::size_t index, unsigned int seed)
+    // Return the value of the bit at the specified 'index' of an irregular
+    // pattern of bits identified by the specified 'seed'.  A 'seed' of 0
+    // identifies a sparse pattern.
+{
+    const unsigned int hash = static_cast<unsigned int>(index) * 2654435761u
+                            + seed * 40503u;
+    return 0 == seed ? 0 == hash % 97 : (hash >> 13) & 1;
+}
+
+static
+void loadPattern(Obj         *array,
+                 Model       *model,
+                 bsl::size_t  length,
+                 unsigned int seed)
+    // Load into the specified 'array' and 'model' the specified 'length' bits
+    // of the pattern identified by the specified 'seed'.
+{
+    array->setLength(length);
+    model->assign(length, false);
+
+    for (bsl::size_t i = 0; i < length; ++i) {
+        (*model)[i] = patternBit(i, seed);
+        array->assign(i, (*model)[i]);
+    }
+}
+
+static
+bool isEqual(const Obj& array, const Model& model)
+    // Return 'true' if the specified 'array' holds the same bits as the
+    // specified 'model', and 'false' otherwise.
+{
+    if (array.length() != model.size()) {
+        return false;                                                 // RETURN
+    }
+    for (bsl::size_t i = 0; i < model.size(); ++i) {
+        if (array[i] != model[i]) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+static
+bsl::size_t modelNum1(const Model& model)
+    // Return the number of 'true' elements of the specified 'model'.
+{
+    bsl::size_t result = 0;
+    for (bsl::size_t i = 0; i < model.size(); ++i) {
+        result += model[i];
+    }
+    return result;
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Matching Subscriptions
+///- - - - - - - - - - - - - - - - -
+// Suppose that a message publisher assigns a small integer identifier to each
+// topic, and that each client subscribes to a set of topics, which we
+// represent as a 'bdlc::BitArray' indexed by topic identifier.
+//
+// First, we create the subscriptions of two clients:
+//..
+    bslma::TestAllocator ta;
+
+    const bsl::size_t NUM_TOPICS = 100000;
+
+    bdlc::BitArray alice(NUM_TOPICS, false, &ta);
+    bdlc::BitArray bob(NUM_TOPICS, false, &ta);
+
+    alice.assign1(17);
+    alice.assign1(4242);
+    alice.assign1(99999);
+
+    bob.assign1(4242);
+    bob.assign1(50000);
+
+    ASSERT(3 == alice.num1());
+    ASSERT(2 == bob.num1());
+//..
+// Then, we represent the topics of a published message in another bit array,
+// and determine which clients are interested in the message:
+//..
+    bdlc::BitArray message(NUM_TOPICS, false, &ta);
+    message.assign1(50000);
+    message.assign1(99999);
+
+    ASSERT(true == alice.intersects(message));
+    ASSERT(true == bob.intersects(message));
+
+    message.assign0(99999);
+
+    ASSERT(false == alice.intersects(message));
+//..
+// Next, we compute the topics to which both clients subscribe:
+//..
+    bdlc::BitArray common(alice, &ta);
+    common &= bob;
+
+    ASSERT(1    == common.num1());
+    ASSERT(4242 == common.find1AtMinIndex(0));
+//..
+// Finally, we visit each topic to which 'alice' subscribes, in increasing
+// order:
+//..
+    bsl::size_t topics[3];
+    int         numTopics = 0;
+
+    for (bsl::size_t i = alice.find1AtMinIndex(0);
+         bdlc::BitArray::k_INVALID_INDEX != i;
+         i = alice.find1AtMinIndex(i + 1)) {
+        topics[numTopics++] = i;
+    }
+
+    ASSERT(3     == numTopics);
+    ASSERT(17    == topics[0]);
+    ASSERT(4242  == topics[1]);
+    ASSERT(99999 == topics[2]);
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // BULK OPERATIONS
+        //
+        // Concerns:
+        //: 1 The bitwise operators, 'toggleAll', 'assignAll0', and
+        //:   'assignAll1' produce the same bits as the corresponding operation
+        //:   applied to each bit.
+        //:
+        //: 2 'num1', 'isAny0', 'isAny1', and 'intersects' are consistent with
+        //:   the bits of the array.
+        //:
+        //: 3 'find1AtMinIndex' returns each set bit in turn, from any starting
+        //:   index, and 'k_INVALID_INDEX' past the last set bit.
+        //:
+        //: 4 The bits beyond the length of an array are never set, for lengths
+        //:   around each multiple of the word size.
+        //:
+        //: 5 The free operators use the default allocator.
+        //
+        // Plan:
+        //: 1 For lengths around each word boundary, and for several pairs of
+        //:   patterns (including a sparse pattern), apply each operation to a
+        //:   'BitArray' and to a 'bsl::vector<bool>' holding the same bits,
+        //:   and compare the results.  (C-1..5)
+        //
+        // Testing:
+        //   BitArray& operator&=(const BitArray& rhs);
+        //   BitArray& operator-=(const BitArray& rhs);
+        //   BitArray& operator|=(const BitArray& rhs);
+        //   BitArray& operator^=(const BitArray& rhs);
+        //   void assignAll0();
+        //   void assignAll1();
+        //   void toggle(bsl::size_t index);
+        //   void toggleAll();
+        //   bsl::size_t find1AtMinIndex(bsl::size_t begin) const;
+        //   bool intersects(const BitArray& other) const;
+        //   bool isAny0() const;
+        //   bool isAny1() const;
+        //   bsl::size_t num1() const;
+        //   BitArray operator&(const BitArray& lhs, const BitArray& rhs);
+        //   BitArray operator-(const BitArray& lhs, const BitArray& rhs);
+        //   BitArray operator|(const BitArray& lhs, const BitArray& rhs);
+        //   BitArray operator^(const BitArray& lhs, const BitArray& rhs);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BULK OPERATIONS" << endl
+                          << "===============" << endl;
+
+        static const bsl::size_t LENGTHS[] = {
+            0, 1, 2, 31, 32, 33, 63, 64, 65, 127, 128, 129, 1000
+        };
+        const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+        for (unsigned int seedA = 0; seedA < 3; ++seedA) {
+        for (unsigned int seedB = 0; seedB < 3; ++seedB) {
+            const bsl::size_t LENGTH = LENGTHS[ti];
+
+            if (veryVerbose) {
+                T_ P_(LENGTH) P_(seedA) P(seedB)
+            }
+
+            Obj   mA(&oa);  const Obj& A = mA;
+            Obj   mB(&oa);  const Obj& B = mB;
+            Model a, b;
+
+            loadPattern(&mA, &a, LENGTH, seedA);
+            loadPattern(&mB, &b, LENGTH, seedB);
+
+            ASSERTV(LENGTH, seedA, modelNum1(a) == A.num1());
+            ASSERTV(LENGTH, seedA, (0 != modelNum1(a)) == A.isAny1());
+            ASSERTV(LENGTH, seedA, (LENGTH != modelNum1(a)) == A.isAny0());
+
+            Model andM(LENGTH), minusM(LENGTH), orM(LENGTH), xorM(LENGTH);
+            bool  intersects = false;
+            for (bsl::size_t i = 0; i < LENGTH; ++i) {
+                andM[i]   = a[i] && b[i];
+                minusM[i] = a[i] && !b[i];
+                orM[i]    = a[i] || b[i];
+                xorM[i]   = a[i] != b[i];
+
+                intersects = intersects || andM[i];
+            }
+
+            ASSERTV(LENGTH, seedA, seedB, intersects == A.intersects(B));
+            ASSERTV(LENGTH, seedA, seedB, intersects == B.intersects(A));
+
+            {
+                Obj mX(A, &oa);  const Obj& X = mX;
+                mX &= B;
+                ASSERTV(LENGTH, seedA, seedB, isEqual(X, andM));
+                ASSERTV(LENGTH, seedA, seedB, modelNum1(andM) == X.num1());
+            }
+            {
+                Obj mX(A, &oa);  const Obj& X = mX;
+                mX -= B;
+                ASSERTV(LENGTH, seedA, seedB, isEqual(X, minusM));
+                ASSERTV(LENGTH, seedA, seedB, modelNum1(minusM) == X.num1());
+            }
+            {
+                Obj mX(A, &oa);  const Obj& X = mX;
+                mX |= B;
+                ASSERTV(LENGTH, seedA, seedB, isEqual(X, orM));
+                ASSERTV(LENGTH, seedA, seedB, modelNum1(orM) == X.num1());
+            }
+            {
+                Obj mX(A, &oa);  const Obj& X = mX;
+                mX ^= B;
+                ASSERTV(LENGTH, seedA, seedB, isEqual(X, xorM));
+                ASSERTV(LENGTH, seedA, seedB, modelNum1(xorM) == X.num1());
+            }
+
+            {
+                const bsls::Types::Int64 NUM_BLOCKS =
+                                             defaultAllocator.numBlocksTotal();
+
+                ASSERTV(LENGTH, seedA, seedB, isEqual(A & B, andM));
+                ASSERTV(LENGTH, seedA, seedB, isEqual(A - B, minusM));
+                ASSERTV(LENGTH, seedA, seedB, isEqual(A | B, orM));
+                ASSERTV(LENGTH, seedA, seedB, isEqual(A ^ B, xorM));
+
+                ASSERTV(LENGTH,
+                       !LENGTH ||
+                       NUM_BLOCKS < defaultAllocator.numBlocksTotal());
+            }
+
+            // 'find1AtMinIndex' from every starting index.
+
+            bsl::size_t expected = Obj::k_INVALID_INDEX;
+            for (bsl::size_t begin = LENGTH + 2; begin > 0; --begin) {
+                const bsl::size_t BEGIN = begin - 1;
+
+                if (BEGIN < LENGTH && a[BEGIN]) {
+                    expected = BEGIN;
+                }
+                ASSERTV(LENGTH, seedA, BEGIN, expected,
+                        expected == A.find1AtMinIndex(BEGIN));
+            }
+
+            // 'toggle', 'toggleAll', 'assignAll0', and 'assignAll1'.
+
+            Obj mX(A, &oa);  const Obj& X = mX;
+            Model x(a);
+
+            mX.toggleAll();
+            for (bsl::size_t i = 0; i < LENGTH; ++i) {
+                x[i] = !x[i];
+            }
+            ASSERTV(LENGTH, seedA, isEqual(X, x));
+            ASSERTV(LENGTH, seedA, LENGTH - modelNum1(a) == X.num1());
+
+            if (LENGTH) {
+                mX.toggle(LENGTH - 1);
+                x[LENGTH - 1] = !x[LENGTH - 1];
+                ASSERTV(LENGTH, seedA, isEqual(X, x));
+            }
+
+            mX.assignAll1();
+            ASSERTV(LENGTH, LENGTH == X.num1());
+            ASSERTV(LENGTH, !X.isAny0());
+            ASSERTV(LENGTH, !LENGTH || 0 == X.find1AtMinIndex(0));
+
+            mX.setLength(LENGTH + 70);
+            ASSERTV(LENGTH, LENGTH == X.num1());
+            ASSERTV(LENGTH, Obj::k_INVALID_INDEX ==
+                                                  X.find1AtMinIndex(LENGTH));
+
+            mX.assignAll0();
+            ASSERTV(LENGTH, 0 == X.num1());
+            ASSERTV(LENGTH, !X.isAny1());
+            ASSERTV(LENGTH, Obj::k_INVALID_INDEX == X.find1AtMinIndex(0));
+        }
+        }
+        }
+
+        if (verbose) cout << "\nTesting 'intersects' of different lengths."
+                          << endl;
+        {
+            Obj mX(200, false, &oa);
+            Obj mY(100, true,  &oa);
+
+            ASSERT(!mX.intersects(mY));
+
+            mX.assign1(150);
+            ASSERT(!mX.intersects(mY));
+            ASSERT(!mY.intersects(mX));
+
+            mX.assign1(99);
+            ASSERT( mX.intersects(mY));
+            ASSERT( mY.intersects(mX));
+        }
+
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(10, false, &oa);
+            Obj mY(10, false, &oa);
+            Obj mZ(11, false, &oa);
+
+            ASSERT_PASS(mX &= mY);
+            ASSERT_FAIL(mX &= mZ);
+            ASSERT_PASS(mX |= mY);
+            ASSERT_FAIL(mX |= mZ);
+            ASSERT_PASS(mX ^= mY);
+            ASSERT_FAIL(mX ^= mZ);
+            ASSERT_PASS(mX -= mY);
+            ASSERT_FAIL(mX -= mZ);
+
+            ASSERT_SAFE_PASS(mX.toggle(9));
+            ASSERT_SAFE_FAIL(mX.toggle(10));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS, PRIMARY MANIPULATORS, AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates an array of the expected length and
+        //:   value, using the expected allocator.
+        //:
+        //: 2 'append', 'assign', 'assign0', 'assign1', and 'setLength' set
+        //:   the expected bits, across word boundaries, and the bits added by
+        //:   'setLength' have the specified value.
+        //:
+        //: 3 Copy construction, assignment, equality, and 'swap' behave as
+        //:   for a value-semantic type.
+        //:
+        //: 4 'removeAll' and 'reserveCapacity' do not change the capacity
+        //:   unexpectedly, and all memory is returned to the allocator.
+        //:
+        //: 5 'print' and 'operator<<' write the bits in decreasing order of
+        //:   index.
+        //
+        // Plan:
+        //: 1 Build arrays of several lengths using each manipulator, and
+        //:   compare them against a 'bsl::vector<bool>' model.  Use a test
+        //:   allocator to verify the source of memory.  (C-1..5)
+        //
+        // Testing:
+        //   BitArray(bslma::Allocator *basicAllocator = 0);
+        //   BitArray(size_t initialLength, bool value = false, *ba = 0);
+        //   BitArray(const BitArray& original, bslma::Allocator *ba = 0);
+        //   ~BitArray();
+        //   BitArray& operator=(const BitArray& rhs);
+        //   void append(bool value);
+        //   void assign(bsl::size_t index, bool value);
+        //   void assign0(bsl::size_t index);
+        //   void assign1(bsl::size_t index);
+        //   void removeAll();
+        //   void reserveCapacity(bsl::size_t numBits);
+        //   void setLength(bsl::size_t newLength, bool value = false);
+        //   void swap(BitArray& other);
+        //   bool operator[](bsl::size_t index) const;
+        //   bsl::size_t length() const;
+        //   bslma::Allocator *allocator() const;
+        //   ostream& print(ostream& stream, int level = 0, int spl = 4) const;
+        //   bool operator==(const BitArray& lhs, const BitArray& rhs);
+        //   bool operator!=(const BitArray& lhs, const BitArray& rhs);
+        //   ostream& operator<<(ostream& stream, const BitArray& array);
+        //   void swap(BitArray& a, BitArray& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS, PRIMARY MANIPULATORS, AND BASIC "
+                             "ACCESSORS" << endl
+                          << "=========================================="
+                             "=========" << endl;
+
+        ASSERT((bslma::UsesBslmaAllocator<Obj>::value));
+        ASSERT((bslmf::IsBitwiseMoveable<Obj>::value));
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        if (verbose) cout << "\nTesting constructors." << endl;
+        {
+            Obj mW;  const Obj& W = mW;
+            ASSERT(0 == W.length());
+            ASSERT(&defaultAllocator == W.allocator());
+
+            static const bsl::size_t LENGTHS[] = { 0, 1, 63, 64, 65, 200 };
+            const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+            for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+                const bsl::size_t LENGTH = LENGTHS[ti];
+
+                Obj mX(LENGTH, false, &oa);  const Obj& X = mX;
+                Obj mY(LENGTH, true,  &oa);  const Obj& Y = mY;
+
+                ASSERTV(LENGTH, &oa == X.allocator());
+                ASSERTV(LENGTH, LENGTH == X.length());
+                ASSERTV(LENGTH, LENGTH == Y.length());
+                ASSERTV(LENGTH, 0 == X.num1());
+                ASSERTV(LENGTH, LENGTH == Y.num1());
+                ASSERTV(LENGTH, (0 == LENGTH) == (X == Y));
+
+                for (bsl::size_t i = 0; i < LENGTH; ++i) {
+                    ASSERTV(LENGTH, i, !X[i]);
+                    ASSERTV(LENGTH, i,  Y[i]);
+                }
+
+                const Obj Z(Y, &oa);
+                ASSERTV(LENGTH, Y == Z);
+                ASSERTV(LENGTH, &oa == Z.allocator());
+            }
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\nTesting 'append' and 'assign'." << endl;
+        {
+            Obj   mX(&oa);  const Obj& X = mX;
+            Model x;
+
+            for (bsl::size_t i = 0; i < 300; ++i) {
+                const bool VALUE = patternBit(i, 1);
+
+                mX.append(VALUE);
+                x.push_back(VALUE);
+
+                ASSERTV(i, isEqual(X, x));
+            }
+
+            for (bsl::size_t i = 0; i < 300; i += 7) {
+                mX.assign(i, !x[i]);
+                x[i] = !x[i];
+                ASSERTV(i, isEqual(X, x));
+
+                mX.assign1(i);
+                x[i] = true;
+                ASSERTV(i, isEqual(X, x));
+
+                mX.assign0(i);
+                x[i] = false;
+                ASSERTV(i, isEqual(X, x));
+            }
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\nTesting 'setLength'." << endl;
+        {
+            static const bsl::size_t LENGTHS[] = {
+                0, 1, 5, 63, 64, 65, 100, 128, 129, 300, 64, 3, 0, 70
+            };
+            const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+            for (int value = 0; value < 2; ++value) {
+                Obj   mX(&oa);  const Obj& X = mX;
+                Model x;
+
+                for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+                    const bsl::size_t LENGTH = LENGTHS[ti];
+
+                    mX.setLength(LENGTH, value);
+                    x.resize(LENGTH, value);
+
+                    ASSERTV(value, LENGTH, isEqual(X, x));
+                    ASSERTV(value, LENGTH, modelNum1(x) == X.num1());
+
+                    // Flip the lowest bit, so that the array is not uniform.
+
+                    if (LENGTH) {
+                        mX.assign(0, !x[0]);
+                        x[0] = !x[0];
+                    }
+                }
+            }
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\nTesting 'removeAll' and 'reserveCapacity'."
+                          << endl;
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            mX.reserveCapacity(1000);
+            const bsls::Types::Int64 NUM_BLOCKS = oa.numBlocksTotal();
+
+            for (int i = 0; i < 1000; ++i) {
+                mX.append(i % 2);
+            }
+            ASSERT(NUM_BLOCKS == oa.numBlocksTotal());
+            ASSERT(500 == X.num1());
+
+            mX.removeAll();
+            ASSERT(0 == X.length());
+            ASSERT(0 == X.num1());
+
+            for (int i = 0; i < 1000; ++i) {
+                mX.append(true);
+            }
+            ASSERT(NUM_BLOCKS == oa.numBlocksTotal());
+            ASSERT(1000 == X.num1());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\nTesting value semantics." << endl;
+        {
+            bslma::TestAllocator za("other", veryVeryVerbose);
+
+            Obj   mX(&oa);  const Obj& X = mX;
+            Obj   mY(&oa);  const Obj& Y = mY;
+            Obj   mZ(&za);  const Obj& Z = mZ;
+            Model x, y;
+
+            loadPattern(&mX, &x, 100, 1);
+            loadPattern(&mY, &y, 70,  2);
+
+            ASSERT(X != Y);
+            ASSERT(!(X == Y));
+
+            mZ = X;
+            ASSERT(X == Z);
+            ASSERT(&za == Z.allocator());
+
+            mZ.setLength(99);
+            ASSERT(X != Z);
+
+            mX.swap(mY);
+            ASSERT(isEqual(X, y));
+            ASSERT(isEqual(Y, x));
+
+            swap(mX, mZ);
+            ASSERT(isEqual(Z, y));
+            ASSERT(99 == X.length());
+            ASSERT(&oa == X.allocator());
+            ASSERT(&za == Z.allocator());
+
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(mX.swap(mY));
+            ASSERT_FAIL(mX.swap(mZ));
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\nTesting 'print' and 'operator<<'." << endl;
+        {
+            Obj mX(&oa);
+            mX.append(true);
+            mX.append(false);
+            mX.append(false);
+            mX.append(true);
+            mX.append(true);
+
+            bsl::ostringstream out1;
+            out1 << mX;
+            ASSERTV(out1.str(), "11001" == out1.str());
+
+            bsl::ostringstream out2;
+            mX.print(out2, 1, 2);
+            ASSERTV(out2.str(), "  11001\n" == out2.str());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(10, false, &oa);  const Obj& X = mX;
+
+            ASSERT_SAFE_PASS(mX.assign1(9));
+            ASSERT_SAFE_FAIL(mX.assign1(10));
+            ASSERT_SAFE_PASS(mX.assign0(9));
+            ASSERT_SAFE_FAIL(mX.assign0(10));
+            ASSERT_SAFE_PASS(X[9]);
+            ASSERT_SAFE_FAIL(X[10]);
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an array, set and test a few bits, and combine it with
+        //:   another array.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(130, false, &ta);  const Obj& X = mX;
+
+            ASSERT(130 == X.length());
+            ASSERT(0   == X.num1());
+            ASSERT(!X.isAny1());
+
+            mX.assign1(0);
+            mX.assign1(64);
+            mX.assign1(129);
+
+            ASSERT(3 == X.num1());
+            ASSERT(X[0] && X[64] && X[129] && !X[1]);
+            ASSERT(0   == X.find1AtMinIndex(0));
+            ASSERT(64  == X.find1AtMinIndex(1));
+            ASSERT(129 == X.find1AtMinIndex(65));
+
+            Obj mY(X, &ta);  const Obj& Y = mY;
+            ASSERT(X == Y);
+
+            mY.toggleAll();
+            ASSERT(127 == Y.num1());
+            ASSERT(!X.intersects(Y));
+
+            mY |= X;
+            ASSERT(130 == Y.num1());
+
+            if (veryVerbose) {
+                P(X)
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: INTERSECTING LARGE ARRAYS
+        //
+        // Concerns:
+        //: 1 Provide a benchmark of 'intersects', '&=', and 'num1' for arrays
+        //:   of 100,000 bits, compared with the same operations applied to
+        //:   each element of a 'bsl::vector<bool>'.
+        //
+        // Plan:
+        //: 1 Using 'bsls::Stopwatch', time many repetitions of each operation
+        //:   on sparse arrays.  The results are meant only for comparison.
+        //
+        // Testing:
+        //   PERFORMANCE: INTERSECTING LARGE ARRAYS
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: INTERSECTING LARGE ARRAYS" << endl
+             << "======================================" << endl;
+
+        const bsl::size_t LENGTH         = 100000;
+        const int         NUM_ITERATIONS = 2000;
+
+        bslma::NewDeleteAllocator *alloc_p =
+                                       &bslma::NewDeleteAllocator::singleton();
+
+        Obj   mA(alloc_p), mB(alloc_p);
+        Model a, b;
+
+        loadPattern(&mA, &a, LENGTH, 0);
+        loadPattern(&mB, &b, LENGTH, 0);
+        mB.assign0(LENGTH - 1);
+        b[LENGTH - 1] = false;
+
+        bsls::Stopwatch timer;
+        bsl::size_t     sum = 0;
+
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            sum += mA.intersects(mB);
+            sum += mA.num1();
+        }
+        timer.stop();
+        cout << "intersects + num1, bdlc::BitArray:    "
+             << timer.elapsedTime() << "s" << endl;
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            bool found = false;
+            for (bsl::size_t j = 0; j < LENGTH && !found; ++j) {
+                found = a[j] && b[j];
+            }
+            sum += found;
+            sum += modelNum1(a);
+        }
+        timer.stop();
+        cout << "intersects + num1, bsl::vector<bool>: "
+             << timer.elapsedTime() << "s" << endl;
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            mA &= mB;
+        }
+        timer.stop();
+        cout << "&=,                bdlc::BitArray:    "
+             << timer.elapsedTime() << "s" << endl;
+
+        if (veryVerbose) {
+            P(sum);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,66 @@
+// bdlc_boundedqueue.cpp                                              -*-C++-*-
+#include <bdlc_boundedqueue.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlc_boundedqueue_cpp,"$Id$ $CSID$")
+
+#include <bsls_alignmentutil.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                          // ------------------------
+                          // struct BoundedQueue_Util
+                          // ------------------------
+
+// CLASS METHODS
+char *BoundedQueue_Util::alignToCacheLine(char *address)
+{
+    return address + bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                            address,
+                                                            k_CACHE_LINE_SIZE);
+}
+
+bsl::size_t BoundedQueue_Util::computeCapacity(bsl::size_t capacity)
+{
+    BSLS_ASSERT_SAFE(capacity <= maxCapacity());
+
+    bsl::size_t result = 2;
+    while (result < capacity) {
+        result *= 2;
+    }
+    return result;
+}
+
+bsl::size_t BoundedQueue_Util::computeSlotSize(bsl::size_t size)
+{
+    return (size + k_CACHE_LINE_SIZE - 1) / k_CACHE_LINE_SIZE
+                                                          * k_CACHE_LINE_SIZE;
+}
+
+bsl::size_t BoundedQueue_Util::maxCapacity()
+{
+    // Leave room for the slot array, and keep the capacity representable as a
+    // power of two.
+
+    return (~static_cast<bsl::size_t>(0) / 2 + 1) / k_CACHE_LINE_SIZE;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
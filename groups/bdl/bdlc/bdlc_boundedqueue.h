@@ -0,0 +1,764 @@
+// bdlc_boundedqueue.h                                                -*-C++-*-
+#ifndef INCLUDED_BDLC_BOUNDEDQUEUE
+#define INCLUDED_BDLC_BOUNDEDQUEUE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a lock-free bounded queue for many producers and consumers.
+//
+//@CLASSES:
+//  bdlc::BoundedQueue: lock-free bounded multi-producer/multi-consumer queue
+//
+//@SEE_ALSO: bsls_atomic, bslstl_queue
+//
+//@DESCRIPTION: This component provides a class template,
+// 'bdlc::BoundedQueue', that implements a first-in first-out queue of objects
+// of the (template parameter) 'TYPE' having a capacity fixed at construction.
+// Any number of threads may push elements onto, and pop elements from, a
+// bounded queue concurrently, and no operation ever blocks: 'tryPushBack'
+// fails if the queue is full, and 'tryPopFront' fails if the queue is empty.
+// Neither operation allocates memory (other than that allocated by the copy
+// constructor of 'TYPE').
+//
+///Algorithm
+///---------
+// The queue is a ring of slots, each holding space for one element and an
+// atomic *sequence* *number*, together with two atomic counters: the position
+// of the next element to be pushed, and the position of the next element to
+// be popped.  A slot whose sequence number equals a push position is free to
+// receive the element pushed at that position; a slot whose sequence number is
+// one greater than a pop position holds the element to be popped at that
+// position.  A thread claims a position by advancing the corresponding
+// counter with a single compare-and-swap, then constructs (or removes) the
+// element, and finally publishes the slot to the other side by storing its
+// next sequence number with release semantics.
+//
+// Producers and consumers therefore contend only on their own counter, and a
+// producer and a consumer operating on different slots never write to the
+// same cache line: each slot is padded to occupy a whole number of cache
+// lines, and the two counters are kept on separate cache lines.  The capacity
+// of the queue is rounded up to a power of two so that a position is mapped to
+// its slot with a mask rather than a division.
+//
+// Note that, because elements are published by the thread that claimed their
+// slot, a thread that is suspended between claiming and publishing a slot
+// delays the consumption of that element (and of those behind it), although
+// it does not prevent other threads from pushing into other free slots.
+//
+///Batch Operations
+///----------------
+// The overloads of 'tryPushBack' and 'tryPopFront' that take an array claim
+// as many consecutive positions as are available (up to the requested number)
+// with a single compare-and-swap, amortizing the cost of contention on the
+// counter over the whole batch.  A batch of pushed elements is published once
+// all of its elements have been constructed.
+//
+///Exception Safety
+///----------------
+// If the copy constructor of 'TYPE' throws during 'tryPushBack', the slot
+// claimed for the element is published as empty, consumers skip it, and the
+// exception is propagated; the elements held by the queue are unchanged
+// (although 'numElements' counts the empty slot until a consumer skips it).
+// If the assignment operator of 'TYPE' throws during 'tryPopFront', the
+// elements being removed by that call are destroyed (and lost), and the
+// exception is propagated.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Passing Work Between Threads
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that a thread reading requests from the network hands each request
+// to a pool of worker threads, and that a worker should never be made to wait
+// for the reader (nor the reader for a worker).
+//
+// First, we create a queue that can hold up to 100 requests (which will be
+// rounded up to 128):
+//..
+//  bdlc::BoundedQueue<int> queue(100);
+//  assert(128 == queue.capacity());
+//  assert(queue.isEmpty());
+//..
+// Then, the reader pushes requests onto the queue until it is full (in a real
+// application, the reader would retry, or shed load, when a push fails):
+//..
+//  int numPushed = 0;
+//  while (0 == queue.tryPushBack(numPushed)) {
+//      ++numPushed;
+//  }
+//  assert(128 == numPushed);
+//  assert(queue.isFull());
+//..
+// Next, a worker pops a request:
+//..
+//  int request;
+//  int rc = queue.tryPopFront(&request);
+//  assert(0 == rc);
+//  assert(0 == request);
+//..
+// Now, a worker that processes requests in batches pops up to 16 of them with
+// a single operation:
+//..
+//  int batch[16];
+//  bsl::size_t numPopped = queue.tryPopFront(batch, 16);
+//  assert(16 == numPopped);
+//  assert( 1 == batch[0]);
+//  assert(16 == batch[15]);
+//..
+// Finally, once the workers have drained the queue, further attempts to pop
+// fail:
+//..
+//  while (0 == queue.tryPopFront(&request)) {
+//  }
+//  assert(127 == request);
+//  assert(queue.isEmpty());
+//  assert(0 != queue.tryPopFront(&request));
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARDESTRUCTIONPRIMITIVES
+#include <bslalg_scalardestructionprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARPRIMITIVES
+#include <bslalg_scalarprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_OBJECTBUFFER
+#include <bsls_objectbuffer.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_NEW
+#include <bsl_new.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+template <class TYPE> class BoundedQueue;
+
+                          // ========================
+                          // struct BoundedQueue_Util
+                          // ========================
+
+struct BoundedQueue_Util {
+    // This 'struct' provides a namespace for constants and functions used in
+    // the implementation of 'BoundedQueue' that do not depend on its template
+    // parameter.
+
+    // PUBLIC TYPES
+    enum {
+        k_CACHE_LINE_SIZE = 64  // assumed size (and alignment) of a cache
+                                // line, in bytes
+    };
+
+    // CLASS METHODS
+    static bsl::size_t computeCapacity(bsl::size_t capacity);
+        // Return the least power of two that is at least 2 and at least the
+        // specified 'capacity'.  The behavior is undefined unless
+        // 'capacity <= maxCapacity()'.
+
+    static bsl::size_t computeSlotSize(bsl::size_t size);
+        // Return the least multiple of 'k_CACHE_LINE_SIZE' that is at least
+        // the specified 'size'.
+
+    static char *alignToCacheLine(char *address);
+        // Return the least address that is at least the specified 'address'
+        // and is aligned on a 'k_CACHE_LINE_SIZE' boundary.
+
+    static bsl::size_t maxCapacity();
+        // Return the maximum capacity that may be requested of a
+        // 'BoundedQueue'.
+};
+
+                          // ========================
+                          // struct BoundedQueue_Slot
+                          // ========================
+
+template <class TYPE>
+struct BoundedQueue_Slot {
+    // This 'struct' provides the storage for one element of a 'BoundedQueue'
+    // together with the sequence number that indicates whether the slot is
+    // free or holds an element, and for which position.
+
+    // PUBLIC DATA
+    bsls::AtomicInt64       d_sequence;  // position for which this slot is
+                                         // ready (see 'BoundedQueue')
+
+    bool                    d_hasValue;  // 'true' if 'd_value' holds an
+                                         // object
+
+    bsls::ObjectBuffer<TYPE> d_value;    // storage for the element
+};
+
+                       // ===============================
+                       // class BoundedQueue_ReleaseGuard
+                       // ===============================
+
+template <class TYPE>
+class BoundedQueue_ReleaseGuard {
+    // This class implements a guard that, on destruction, publishes a range of
+    // consecutive slots claimed by a push or pop operation on a
+    // 'BoundedQueue', so that the queue remains consistent even if the copy
+    // constructor or assignment operator of 'TYPE' throws.
+
+    // DATA
+    BoundedQueue<TYPE> *d_queue_p;   // queue whose slots are guarded
+    bsls::Types::Int64  d_begin;     // first guarded position
+    bsls::Types::Int64  d_end;       // one past the last guarded position
+    bool                d_isPop;     // 'true' if guarding a pop
+
+  private:
+    // NOT IMPLEMENTED
+    BoundedQueue_ReleaseGuard(const BoundedQueue_ReleaseGuard&);
+    BoundedQueue_ReleaseGuard& operator=(const BoundedQueue_ReleaseGuard&);
+
+  public:
+    // CREATORS
+    BoundedQueue_ReleaseGuard(BoundedQueue<TYPE> *queue,
+                              bsls::Types::Int64  begin,
+                              bsls::Types::Int64  end,
+                              bool                isPop);
+        // Create a guard that publishes the slots of the specified 'queue' for
+        // the positions in the range '[begin, end)' when it is destroyed.  If
+        // the specified 'isPop' is 'true', each slot is published to
+        // producers, and any element it holds is destroyed; otherwise each
+        // slot is published to consumers.
+
+    ~BoundedQueue_ReleaseGuard();
+        // Publish the guarded slots and destroy this object.
+};
+
+                             // ==================
+                             // class BoundedQueue
+                             // ==================
+
+template <class TYPE>
+class BoundedQueue {
+    // This class template implements a lock-free, fixed-capacity, first-in
+    // first-out queue of objects of the (template parameter) 'TYPE' that
+    // supports any number of concurrent producers and consumers.  'TYPE' must
+    // be copy-constructible and copy-assignable.  All manipulators and
+    // accessors of this class are thread-safe.
+
+    // PRIVATE TYPES
+    typedef BoundedQueue_Slot<TYPE> Slot;
+    typedef bsls::Types::Int64      Int64;
+
+    // DATA
+    bsls::AtomicInt64   d_pushIndex;       // position of the next push
+
+    char                d_pushPad[BoundedQueue_Util::k_CACHE_LINE_SIZE
+                                  - sizeof(bsls::AtomicInt64)];
+                                           // separates 'd_pushIndex' from
+                                           // 'd_popIndex'
+
+    bsls::AtomicInt64   d_popIndex;        // position of the next pop
+
+    char                d_popPad[BoundedQueue_Util::k_CACHE_LINE_SIZE
+                                 - sizeof(bsls::AtomicInt64)];
+                                           // separates 'd_popIndex' from the
+                                           // read-only members below
+
+    char               *d_buffer_p;        // memory holding the slots (owned)
+
+    char               *d_slots_p;         // first slot, aligned on a cache
+                                           // line boundary
+
+    bsl::size_t         d_slotSize;        // distance between slots
+
+    bsl::size_t         d_capacity;        // number of slots
+
+    Int64               d_mask;            // 'd_capacity - 1'
+
+    bslma::Allocator   *d_allocator_p;     // memory allocator (held, not
+                                           // owned)
+
+    // FRIENDS
+    friend class BoundedQueue_ReleaseGuard<TYPE>;
+
+  private:
+    // NOT IMPLEMENTED
+    BoundedQueue(const BoundedQueue&);
+    BoundedQueue& operator=(const BoundedQueue&);
+
+    // PRIVATE MANIPULATORS
+    bsl::size_t claim(Int64 *position, bsl::size_t maxCount, bool isPop);
+        // Claim up to the specified 'maxCount' consecutive positions for
+        // pushing if the specified 'isPop' is 'false', and for popping
+        // otherwise; load the first claimed position into the specified
+        // 'position' and return the number of positions claimed.  Return 0,
+        // with no effect on 'position', if no position is available (i.e., the
+        // queue is full, or empty, respectively).  The behavior is undefined
+        // unless '0 < maxCount'.
+
+    void release(Int64 position, bool isPop);
+        // Publish the slot for the specified 'position' to consumers if the
+        // specified 'isPop' is 'false', and to producers (destroying the
+        // element it holds, if any) otherwise.
+
+    Slot& slot(Int64 position);
+        // Return a reference providing modifiable access to the slot for the
+        // specified 'position'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(BoundedQueue, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit BoundedQueue(bsl::size_t       capacity,
+                          bslma::Allocator *basicAllocator = 0);
+        // Create an empty queue able to hold at least the specified 'capacity'
+        // elements.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The capacity of the queue is the least power of
+        // two (and at least 2) that is not less than 'capacity'.  The
+        // behavior is undefined unless
+        // '0 < capacity <= BoundedQueue_Util::maxCapacity()'.
+
+    ~BoundedQueue();
+        // Destroy this object and any elements it holds.  The behavior is
+        // undefined unless no other thread is accessing this queue.
+
+    // MANIPULATORS
+    int tryPushBack(const TYPE& value);
+        // Append to the back of this queue a copy of the specified 'value' if
+        // the queue is not full.  Return 0 on success, and a non-zero value
+        // (with no effect) if the queue is full.
+
+    bsl::size_t tryPushBack(const TYPE *values, bsl::size_t numValues);
+        // Append to the back of this queue, in order, copies of as many of
+        // the leading elements of the specified 'values' array of the
+        // specified 'numValues' length as there is room for, and return the
+        // number of elements appended.  The appended elements are claimed
+        // with a single atomic operation and occupy consecutive positions in
+        // the queue.  The behavior is undefined unless 'values' refers to at
+        // least 'numValues' elements.
+
+    int tryPopFront(TYPE *value);
+        // Remove the element at the front of this queue, if any, and assign it
+        // to the specified 'value'.  Return 0 on success, and a non-zero value
+        // (with no effect) if the queue is empty.
+
+    bsl::size_t tryPopFront(TYPE *values, bsl::size_t maxNumValues);
+        // Remove up to the specified 'maxNumValues' elements from the front of
+        // this queue, assign them, in order, to the leading elements of the
+        // specified 'values' array, and return the number of elements removed.
+        // The removed elements are claimed with a single atomic operation.
+        // The behavior is undefined unless 'values' refers to at least
+        // 'maxNumValues' elements.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this queue to supply memory.
+
+    bsl::size_t capacity() const;
+        // Return the maximum number of elements this queue can hold.
+
+    bool isEmpty() const;
+        // Return 'true' if this queue held no elements at some point during
+        // this call, and 'false' otherwise.  Note that the returned value may
+        // be out of date by the time it is examined.
+
+    bool isFull() const;
+        // Return 'true' if this queue held 'capacity()' elements at some point
+        // during this call, and 'false' otherwise.  Note that the returned
+        // value may be out of date by the time it is examined.
+
+    bsl::size_t numElements() const;
+        // Return the number of elements in this queue.  Note that, if other
+        // threads are modifying the queue, the returned value is an
+        // approximation, and may be out of date by the time it is examined.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                       // -------------------------------
+                       // class BoundedQueue_ReleaseGuard
+                       // -------------------------------
+
+// CREATORS
+template <class TYPE>
+inline
+BoundedQueue_ReleaseGuard<TYPE>::BoundedQueue_ReleaseGuard(
+                                                 BoundedQueue<TYPE> *queue,
+                                                 bsls::Types::Int64  begin,
+                                                 bsls::Types::Int64  end,
+                                                 bool                isPop)
+: d_queue_p(queue)
+, d_begin(begin)
+, d_end(end)
+, d_isPop(isPop)
+{
+}
+
+template <class TYPE>
+inline
+BoundedQueue_ReleaseGuard<TYPE>::~BoundedQueue_ReleaseGuard()
+{
+    for (bsls::Types::Int64 position = d_begin; position < d_end; ++position) {
+        d_queue_p->release(position, d_isPop);
+    }
+}
+
+                             // ------------------
+                             // class BoundedQueue
+                             // ------------------
+
+// PRIVATE MANIPULATORS
+template <class TYPE>
+bsl::size_t BoundedQueue<TYPE>::claim(Int64       *position,
+                                      bsl::size_t  maxCount,
+                                      bool         isPop)
+{
+    BSLS_ASSERT_SAFE(position);
+    BSLS_ASSERT_SAFE(0 < maxCount);
+
+    // A slot is ready to be pushed into at position 'p' when its sequence
+    // number is 'p', and ready to be popped from when it is 'p + 1'.
+
+    bsls::AtomicInt64& index  = isPop ? d_popIndex : d_pushIndex;
+    const Int64        offset = isPop ? 1 : 0;
+
+    Int64 begin = index.loadRelaxed();
+
+    for (;;) {
+        const Int64 diff = slot(begin).d_sequence.loadAcquire()
+                                                            - (begin + offset);
+
+        if (diff < 0) {
+            // The slot has not yet been released by the other side: the queue
+            // is full (for a push) or empty (for a pop).
+
+            return 0;                                                 // RETURN
+        }
+
+        if (diff > 0) {
+            // Another thread has claimed 'begin' since we read 'index'.
+
+            begin = index.loadRelaxed();
+            continue;
+        }
+
+        // Extend the claim over the ready slots that follow.  A slot that is
+        // ready for its position remains so until that position is claimed,
+        // so a successful compare-and-swap below claims them all.
+
+        bsl::size_t count = 1;
+        while (count < maxCount
+            && slot(begin + count).d_sequence.loadAcquire()
+                           == begin + static_cast<Int64>(count) + offset) {
+            ++count;
+        }
+
+        const Int64 previous = index.testAndSwapAcqRel(begin, begin + count);
+        if (previous == begin) {
+            *position = begin;
+            return count;                                             // RETURN
+        }
+        begin = previous;
+    }
+}
+
+template <class TYPE>
+inline
+void BoundedQueue<TYPE>::release(Int64 position, bool isPop)
+{
+    Slot& s = slot(position);
+
+    if (isPop) {
+        if (s.d_hasValue) {
+            s.d_hasValue = false;
+            bslalg::ScalarDestructionPrimitives::destroy(
+                                                        &s.d_value.object());
+        }
+        s.d_sequence.storeRelease(position + d_mask + 1);
+    }
+    else {
+        s.d_sequence.storeRelease(position + 1);
+    }
+}
+
+template <class TYPE>
+inline
+typename BoundedQueue<TYPE>::Slot& BoundedQueue<TYPE>::slot(Int64 position)
+{
+    return *reinterpret_cast<Slot *>(
+                 d_slots_p + static_cast<bsl::size_t>(position & d_mask)
+                                                                * d_slotSize);
+}
+
+// CREATORS
+template <class TYPE>
+BoundedQueue<TYPE>::BoundedQueue(bsl::size_t       capacity,
+                                 bslma::Allocator *basicAllocator)
+: d_pushIndex(0)
+, d_popIndex(0)
+, d_buffer_p(0)
+, d_slots_p(0)
+, d_slotSize(BoundedQueue_Util::computeSlotSize(sizeof(Slot)))
+, d_capacity(BoundedQueue_Util::computeCapacity(capacity))
+, d_mask(static_cast<Int64>(d_capacity) - 1)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < capacity);
+    BSLS_ASSERT(capacity <= BoundedQueue_Util::maxCapacity());
+
+    // Over-allocate so that the first slot can be aligned on a cache line
+    // boundary.
+
+    d_buffer_p = static_cast<char *>(d_allocator_p->allocate(
+                                    d_capacity * d_slotSize
+                                  + BoundedQueue_Util::k_CACHE_LINE_SIZE - 1));
+    d_slots_p  = BoundedQueue_Util::alignToCacheLine(d_buffer_p);
+
+    for (bsl::size_t i = 0; i < d_capacity; ++i) {
+        Slot *s = new (d_slots_p + i * d_slotSize) Slot;
+        s->d_sequence.storeRelaxed(static_cast<Int64>(i));
+        s->d_hasValue = false;
+    }
+}
+
+template <class TYPE>
+BoundedQueue<TYPE>::~BoundedQueue()
+{
+    for (bsl::size_t i = 0; i < d_capacity; ++i) {
+        Slot& s = slot(static_cast<Int64>(i));
+        if (s.d_hasValue) {
+            bslalg::ScalarDestructionPrimitives::destroy(
+                                                        &s.d_value.object());
+        }
+    }
+    d_allocator_p->deallocate(d_buffer_p);
+}
+
+// MANIPULATORS
+template <class TYPE>
+int BoundedQueue<TYPE>::tryPushBack(const TYPE& value)
+{
+    Int64 position;
+    if (0 == claim(&position, 1, false)) {
+        return -1;                                                    // RETURN
+    }
+
+    BoundedQueue_ReleaseGuard<TYPE> guard(this,
+                                          position,
+                                          position + 1,
+                                          false);
+
+    Slot& s = slot(position);
+    bslalg::ScalarPrimitives::copyConstruct(&s.d_value.object(),
+                                            value,
+                                            d_allocator_p);
+    s.d_hasValue = true;
+
+    return 0;
+}
+
+template <class TYPE>
+bsl::size_t BoundedQueue<TYPE>::tryPushBack(const TYPE  *values,
+                                            bsl::size_t  numValues)
+{
+    BSLS_ASSERT(values || 0 == numValues);
+
+    if (0 == numValues) {
+        return 0;                                                     // RETURN
+    }
+
+    Int64             position;
+    const bsl::size_t count = claim(&position, numValues, false);
+
+    if (0 == count) {
+        return 0;                                                     // RETURN
+    }
+
+    BoundedQueue_ReleaseGuard<TYPE> guard(this,
+                                          position,
+                                          position + count,
+                                          false);
+
+    for (bsl::size_t i = 0; i < count; ++i) {
+        Slot& s = slot(position + static_cast<Int64>(i));
+        bslalg::ScalarPrimitives::copyConstruct(&s.d_value.object(),
+                                                values[i],
+                                                d_allocator_p);
+        s.d_hasValue = true;
+    }
+
+    return count;
+}
+
+template <class TYPE>
+int BoundedQueue<TYPE>::tryPopFront(TYPE *value)
+{
+    BSLS_ASSERT(value);
+
+    // A slot may have been published without an element if a copy constructor
+    // threw while pushing into it; such slots are released and skipped.
+
+    for (;;) {
+        Int64 position;
+        if (0 == claim(&position, 1, true)) {
+            return -1;                                                // RETURN
+        }
+
+        BoundedQueue_ReleaseGuard<TYPE> guard(this,
+                                              position,
+                                              position + 1,
+                                              true);
+
+        Slot& s = slot(position);
+        if (s.d_hasValue) {
+            *value = s.d_value.object();
+            return 0;                                                 // RETURN
+        }
+    }
+}
+
+template <class TYPE>
+bsl::size_t BoundedQueue<TYPE>::tryPopFront(TYPE        *values,
+                                            bsl::size_t  maxNumValues)
+{
+    BSLS_ASSERT(values || 0 == maxNumValues);
+
+    if (0 == maxNumValues) {
+        return 0;                                                     // RETURN
+    }
+
+    for (;;) {
+        Int64             position;
+        const bsl::size_t count = claim(&position, maxNumValues, true);
+
+        if (0 == count) {
+            return 0;                                                 // RETURN
+        }
+
+        BoundedQueue_ReleaseGuard<TYPE> guard(this,
+                                              position,
+                                              position + count,
+                                              true);
+
+        bsl::size_t numPopped = 0;
+        for (bsl::size_t i = 0; i < count; ++i) {
+            Slot& s = slot(position + static_cast<Int64>(i));
+            if (s.d_hasValue) {
+                values[numPopped++] = s.d_value.object();
+            }
+        }
+
+        if (0 < numPopped) {
+            return numPopped;                                         // RETURN
+        }
+    }
+}
+
+// ACCESSORS
+template <class TYPE>
+inline
+bslma::Allocator *BoundedQueue<TYPE>::allocator() const
+{
+    return d_allocator_p;
+}
+
+template <class TYPE>
+inline
+bsl::size_t BoundedQueue<TYPE>::capacity() const
+{
+    return d_capacity;
+}
+
+template <class TYPE>
+inline
+bool BoundedQueue<TYPE>::isEmpty() const
+{
+    return 0 == numElements();
+}
+
+template <class TYPE>
+inline
+bool BoundedQueue<TYPE>::isFull() const
+{
+    return d_capacity == numElements();
+}
+
+template <class TYPE>
+inline
+bsl::size_t BoundedQueue<TYPE>::numElements() const
+{
+    // Read the pop index first so that, absent concurrent pops, the result
+    // cannot be negative.
+
+    const Int64 popIndex  = d_popIndex.loadAcquire();
+    const Int64 pushIndex = d_pushIndex.loadAcquire();
+    const Int64 length    = pushIndex - popIndex;
+
+    if (length < 0) {
+        return 0;                                                     // RETURN
+    }
+    if (length > static_cast<Int64>(d_capacity)) {
+        return d_capacity;                                            // RETURN
+    }
+    return static_cast<bsl::size_t>(length);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1304 @@
+// bdlc_boundedqueue.t.cpp                                            -*-C++-*-
+#include <bdlc_boundedqueue.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test provides a lock-free, fixed-capacity queue that
+// may be used concurrently by any number of producers and consumers.  The
+// primary concerns are that elements are removed in the order in which they
+// were added, that the queue correctly reports that it is full or empty as
+// positions wrap around its ring of slots, that batch operations claim
+// consecutive elements, that elements are copied with the queue's allocator
+// and destroyed when removed, that the queue remains consistent when element
+// operations throw, and that no element is lost or duplicated when the queue
+// is used from many threads at once.  We use 'bslma::TestAllocator' to verify
+// the memory behavior and exception neutrality, and 'pthread' (or the Windows
+// thread API) to exercise the queue from multiple threads.
+//-----------------------------------------------------------------------------
+// BoundedQueue_Util
+// [ 2] bsl::size_t computeCapacity(bsl::size_t capacity);
+// [ 2] bsl::size_t computeSlotSize(bsl::size_t size);
+// [ 2] char *alignToCacheLine(char *address);
+// [ 2] bsl::size_t maxCapacity();
+//
+// BoundedQueue
+// [ 2] explicit BoundedQueue(bsl::size_t capacity, Allocator *ba = 0);
+// [ 3] ~BoundedQueue();
+// [ 3] int tryPushBack(const TYPE& value);
+// [ 4] bsl::size_t tryPushBack(const TYPE *values, bsl::size_t numValues);
+// [ 3] int tryPopFront(TYPE *value);
+// [ 4] bsl::size_t tryPopFront(TYPE *values, bsl::size_t maxNumValues);
+// [ 2] bslma::Allocator *allocator() const;
+// [ 2] bsl::size_t capacity() const;
+// [ 3] bool isEmpty() const;
+// [ 3] bool isFull() const;
+// [ 3] bsl::size_t numElements() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] EXCEPTION SAFETY
+// [ 6] CONCURRENT PUSHING AND POPPING
+// [ 7] USAGE EXAMPLE
+// [-1] PERFORMANCE: THROUGHPUT
+// [-2] PERFORMANCE: LATENCY
+//=============================================================================
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlc::BoundedQueue<int>         Obj;
+typedef bdlc::BoundedQueue<bsl::string> StringObj;
+typedef bdlc::BoundedQueue_Util         Util;
+typedef bsls::Types::Int64              Int64;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+// A string long enough to require memory from an allocator.
+
+static const char LONG_STRING[] = "This string is too long to be stored in the"
+                                  " footprint of a 'bsl::string'.";
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+void yieldThread()
+    // Offer the processor to another thread.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+namespace TestCase6 {
+
+enum {
+    k_NUM_PRODUCERS    = 4,
+    k_NUM_CONSUMERS    = 4,
+    k_NUM_PER_PRODUCER = 20000,
+    k_NUM_VALUES       = k_NUM_PRODUCERS * k_NUM_PER_PRODUCER,
+    k_BATCH_SIZE       = 8
+};
+
+bsls::AtomicInt s_numPopped[k_NUM_VALUES];  // times each value was popped
+
+struct ProducerInfo {
+    Obj *d_queue_p;      // queue shared by all threads
+    int  d_producerId;   // index of this producer
+};
+
+struct ConsumerInfo {
+    Obj             *d_queue_p;        // queue shared by all threads
+    bsls::AtomicInt *d_numRemaining_p; // values not yet popped by any thread
+    int              d_consumerId;     // index of this consumer
+    bool             d_isOrdered;      // values from each producer seen in
+                                       // order
+};
+
+extern "C" void *producerFunction(void *arg)
+    // Push the values of the producer described by the specified 'arg' onto
+    // its queue, in increasing order, alternating between single and batch
+    // pushes, and retrying while the queue is full.
+{
+    ProducerInfo& info = *static_cast<ProducerInfo *>(arg);
+
+    const int begin = info.d_producerId * k_NUM_PER_PRODUCER;
+    const int end   = begin + k_NUM_PER_PRODUCER;
+
+    int values[k_BATCH_SIZE];
+    int next = begin;
+    while (next < end) {
+        if (next % 2) {
+            if (0 == info.d_queue_p->tryPushBack(next)) {
+                ++next;
+                continue;
+            }
+        }
+        else {
+            int n = 0;
+            while (n < k_BATCH_SIZE && next + n < end) {
+                values[n] = next + n;
+                ++n;
+            }
+            const bsl::size_t numPushed = info.d_queue_p->tryPushBack(
+                                                  values,
+                                                  static_cast<bsl::size_t>(n));
+            if (numPushed) {
+                next += static_cast<int>(numPushed);
+                continue;
+            }
+        }
+        yieldThread();
+    }
+    return 0;
+}
+
+extern "C" void *consumerFunction(void *arg)
+    // Pop values from the queue of the consumer described by the specified
+    // 'arg' until all values have been popped, alternating between single and
+    // batch pops, and record whether the values from each producer were
+    // popped in increasing order.
+{
+    ConsumerInfo& info = *static_cast<ConsumerInfo *>(arg);
+
+    int last[k_NUM_PRODUCERS];
+    for (int i = 0; i < k_NUM_PRODUCERS; ++i) {
+        last[i] = -1;
+    }
+
+    int         values[k_BATCH_SIZE];
+    bsl::size_t numPopped = 0;
+    int         iteration = 0;
+
+    while (0 < info.d_numRemaining_p->loadRelaxed()) {
+        if (++iteration % 2) {
+            numPopped = 0 == info.d_queue_p->tryPopFront(values) ? 1 : 0;
+        }
+        else {
+            numPopped = info.d_queue_p->tryPopFront(values, k_BATCH_SIZE);
+        }
+
+        if (0 == numPopped) {
+            yieldThread();
+            continue;
+        }
+
+        for (bsl::size_t i = 0; i < numPopped; ++i) {
+            const int value    = values[i];
+            const int producer = value / k_NUM_PER_PRODUCER;
+
+            if (value <= last[producer]) {
+                info.d_isOrdered = false;
+            }
+            last[producer] = value;
+            ++s_numPopped[value];
+        }
+        info.d_numRemaining_p->addRelaxed(-static_cast<int>(numPopped));
+    }
+    return 0;
+}
+
+}  // close namespace TestCase6
+
+namespace BenchmarkCase {
+
+struct ThreadInfo {
+    Obj             *d_queue_p;      // queue shared by all threads
+    int              d_numValues;    // number of values to push, or pop
+    int              d_batchSize;    // 1 for single operations
+    bsls::AtomicInt *d_numReady_p;   // threads ready to start
+    bsls::AtomicInt *d_start_p;      // non-zero once all threads are ready
+    Int64            d_sum;          // sum of the values popped
+};
+
+static
+void waitForStart(ThreadInfo *info)
+    // Mark the thread described by the specified 'info' ready, and wait for
+    // the benchmark to start.
+{
+    info->d_numReady_p->add(1);
+    while (0 == info->d_start_p->load()) {
+        yieldThread();
+    }
+}
+
+extern "C" void *benchmarkProducer(void *arg)
+    // Push the number of values specified by 'arg' onto its queue.
+{
+    ThreadInfo& info = *static_cast<ThreadInfo *>(arg);
+
+    bsl::vector<int> values(info.d_batchSize, 1);
+
+    waitForStart(&info);
+
+    int remaining = info.d_numValues;
+    while (0 < remaining) {
+        const bsl::size_t n = static_cast<bsl::size_t>(
+                                          remaining < info.d_batchSize
+                                          ? remaining
+                                          : info.d_batchSize);
+        const bsl::size_t numPushed = 1 == n
+                                 ? (0 == info.d_queue_p->tryPushBack(1))
+                                 : info.d_queue_p->tryPushBack(&values[0], n);
+        if (0 == numPushed) {
+            yieldThread();
+        }
+        remaining -= static_cast<int>(numPushed);
+    }
+    return 0;
+}
+
+extern "C" void *benchmarkConsumer(void *arg)
+    // Pop the number of values specified by 'arg' from its queue.
+{
+    ThreadInfo& info = *static_cast<ThreadInfo *>(arg);
+
+    bsl::vector<int> values(info.d_batchSize, 0);
+
+    waitForStart(&info);
+
+    int remaining = info.d_numValues;
+    while (0 < remaining) {
+        const bsl::size_t n = static_cast<bsl::size_t>(
+                                          remaining < info.d_batchSize
+                                          ? remaining
+                                          : info.d_batchSize);
+        const bsl::size_t numPopped =
+                               1 == n
+                               ? (0 == info.d_queue_p->tryPopFront(&values[0]))
+                               : info.d_queue_p->tryPopFront(&values[0], n);
+        if (0 == numPopped) {
+            yieldThread();
+        }
+        for (bsl::size_t i = 0; i < numPopped; ++i) {
+            info.d_sum += values[i];
+        }
+        remaining -= static_cast<int>(numPopped);
+    }
+    return 0;
+}
+
+struct PingPongInfo {
+    Obj *d_requests_p;      // queue of requests
+    Obj *d_responses_p;     // queue of responses
+    int  d_numRoundTrips;   // number of requests to answer
+};
+
+extern "C" void *echoFunction(void *arg)
+    // Pop each request from the request queue described by the specified
+    // 'arg' and push it onto the response queue.
+{
+    PingPongInfo& info = *static_cast<PingPongInfo *>(arg);
+
+    for (int i = 0; i < info.d_numRoundTrips; ++i) {
+        int value;
+        while (0 != info.d_requests_p->tryPopFront(&value)) {
+            yieldThread();
+        }
+        while (0 != info.d_responses_p->tryPushBack(value)) {
+            yieldThread();
+        }
+    }
+    return 0;
+}
+
+}  // close namespace BenchmarkCase
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Passing Work Between Threads
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that a thread reading requests from the network hands each request
+// to a pool of worker threads, and that a worker should never be made to wait
+// for the reader (nor the reader for a worker).
+//
+// First, we create a queue that can hold up to 100 requests (which will be
+// rounded up to 128):
+//..
+    bdlc::BoundedQueue<int> queue(100);
+    ASSERT(128 == queue.capacity());
+    ASSERT(queue.isEmpty());
+//..
+// Then, the reader pushes requests onto the queue until it is full (in a real
+// application, the reader would retry, or shed load, when a push fails):
+//..
+    int numPushed = 0;
+    while (0 == queue.tryPushBack(numPushed)) {
+        ++numPushed;
+    }
+    ASSERT(128 == numPushed);
+    ASSERT(queue.isFull());
+//..
+// Next, a worker pops a request:
+//..
+    int request;
+    int rc = queue.tryPopFront(&request);
+    ASSERT(0 == rc);
+    ASSERT(0 == request);
+//..
+// Now, a worker that processes requests in batches pops up to 16 of them with
+// a single operation:
+//..
+    int batch[16];
+    bsl::size_t numPopped = queue.tryPopFront(batch, 16);
+    ASSERT(16 == numPopped);
+    ASSERT( 1 == batch[0]);
+    ASSERT(16 == batch[15]);
+//..
+// Finally, once the workers have drained the queue, further attempts to pop
+// fail:
+//..
+    while (0 == queue.tryPopFront(&request)) {
+    }
+    ASSERT(127 == request);
+    ASSERT(queue.isEmpty());
+    ASSERT(0 != queue.tryPopFront(&request));
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENT PUSHING AND POPPING
+        //
+        // Concerns:
+        //: 1 Any number of threads may push onto, and pop from, a queue
+        //:   concurrently.
+        //:
+        //: 2 Every value pushed is popped exactly once.
+        //:
+        //: 3 A consumer pops the values pushed by any one producer in the
+        //:   order in which they were pushed.
+        //:
+        //: 4 Single and batch operations may be mixed.
+        //
+        // Plan:
+        //: 1 Create a queue with a small capacity, so that it is frequently
+        //:   full and empty and its positions wrap many times.  Start 4
+        //:   producer threads, each pushing a distinct range of values in
+        //:   increasing order, and 4 consumer threads, each popping until all
+        //:   values have been popped; each thread alternates between single
+        //:   and batch operations.  (C-1, 4)
+        //:
+        //: 2 Verify that each value was popped exactly once, and that each
+        //:   consumer saw the values of each producer in increasing order.
+        //:   (C-2..3)
+        //
+        // Testing:
+        //   CONCURRENT PUSHING AND POPPING
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT PUSHING AND POPPING" << endl
+                          << "==============================" << endl;
+
+        using namespace TestCase6;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(16, &ta);
+
+            bsls::AtomicInt numRemaining(k_NUM_VALUES);
+
+            ProducerInfo producers[k_NUM_PRODUCERS];
+            ConsumerInfo consumers[k_NUM_CONSUMERS];
+            ThreadId     producerIds[k_NUM_PRODUCERS];
+            ThreadId     consumerIds[k_NUM_CONSUMERS];
+
+            for (int i = 0; i < k_NUM_CONSUMERS; ++i) {
+                consumers[i].d_queue_p        = &mX;
+                consumers[i].d_numRemaining_p = &numRemaining;
+                consumers[i].d_consumerId     = i;
+                consumers[i].d_isOrdered      = true;
+                consumerIds[i] = createThread(&consumerFunction,
+                                              &consumers[i]);
+            }
+            for (int i = 0; i < k_NUM_PRODUCERS; ++i) {
+                producers[i].d_queue_p    = &mX;
+                producers[i].d_producerId = i;
+                producerIds[i] = createThread(&producerFunction,
+                                              &producers[i]);
+            }
+
+            for (int i = 0; i < k_NUM_PRODUCERS; ++i) {
+                joinThread(producerIds[i]);
+            }
+            for (int i = 0; i < k_NUM_CONSUMERS; ++i) {
+                joinThread(consumerIds[i]);
+                ASSERTV(i, consumers[i].d_isOrdered);
+            }
+
+            ASSERT(0 == numRemaining);
+            ASSERT(mX.isEmpty());
+
+            for (int i = 0; i < k_NUM_VALUES; ++i) {
+                ASSERTV(i, s_numPopped[i], 1 == s_numPopped[i]);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // EXCEPTION SAFETY
+        //
+        // Concerns:
+        //: 1 If the copy constructor of an element throws during a push, the
+        //:   exception is propagated and no element is added.
+        //:
+        //: 2 A slot abandoned by a failed push is skipped by consumers, and
+        //:   the queue remains usable.
+        //:
+        //: 3 If the assignment of an element throws during a pop, the
+        //:   exception is propagated and the element is destroyed.
+        //:
+        //: 4 No memory is leaked.
+        //
+        // Plan:
+        //: 1 Using the 'BSLMA_TESTALLOCATOR_EXCEPTION_TEST_*' macros, push a
+        //:   string requiring memory onto a queue of strings, so that the
+        //:   copy constructor throws on each attempt but the last.  Verify
+        //:   that exactly one copy of the string is then popped, and that the
+        //:   queue is then empty.  (C-1..2, 4)
+        //:
+        //: 2 Repeat P-1 for single and batch pops into strings using a test
+        //:   allocator, so that the assignment throws.  (C-3..4)
+        //
+        // Testing:
+        //   EXCEPTION SAFETY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EXCEPTION SAFETY" << endl
+                          << "================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        bslma::TestAllocator sa("scratch", veryVeryVerbose);
+
+        const bsl::string VALUE(LONG_STRING, &sa);
+
+        if (verbose) cout << "\tThrowing copy constructor." << endl;
+        {
+            StringObj mX(4, &ta);  const StringObj& X = mX;
+
+            int numAttempts = 0;
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                ++numAttempts;
+                ASSERT(0 == mX.tryPushBack(VALUE));
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            ASSERT(1 < numAttempts);
+
+            // Abandoned slots count as elements until they are skipped.
+
+            ASSERT(X.numElements() == static_cast<bsl::size_t>(numAttempts));
+
+            bsl::string value(&sa);
+            ASSERT(0     == mX.tryPopFront(&value));
+            ASSERT(VALUE == value);
+            ASSERT(0     != mX.tryPopFront(&value));
+            ASSERT(X.isEmpty());
+
+            // The queue remains usable.
+
+            for (int i = 0; i < 10; ++i) {
+                ASSERT(0     == mX.tryPushBack(VALUE));
+                ASSERT(0     == mX.tryPopFront(&value));
+                ASSERT(VALUE == value);
+            }
+            ASSERT(1 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tThrowing assignment." << endl;
+        {
+            StringObj mX(4, &sa);  const StringObj& X = mX;
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                ASSERT(0 == mX.tryPushBack(VALUE));
+
+                bsl::string value(&ta);
+                ASSERT(0     == mX.tryPopFront(&value));
+                ASSERT(VALUE == value);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERT(X.isEmpty());
+
+            const bsl::string VALUES[] = { bsl::string(VALUE, &sa),
+                                           bsl::string(VALUE, &sa),
+                                           bsl::string(VALUE, &sa) };
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                bsl::vector<bsl::string> values(3, &ta);
+
+                ASSERT(3 == mX.tryPushBack(VALUES, 3));
+                ASSERT(3 == mX.tryPopFront(&values[0], 3));
+                ASSERT(VALUE == values[2]);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERT(X.isEmpty());
+
+            // 'VALUE', 'VALUES', and the slots of 'mX'.
+
+            ASSERT(5 == sa.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(1 == sa.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // BATCH OPERATIONS
+        //
+        // Concerns:
+        //: 1 A batch push appends as many leading elements of the array as
+        //:   there is room for, in order, and returns their number.
+        //:
+        //: 2 A batch pop removes up to the requested number of elements, in
+        //:   order, and returns their number.
+        //:
+        //: 3 Batches may straddle the end of the ring of slots.
+        //:
+        //: 4 Batch and single operations may be mixed, and empty batches have
+        //:   no effect.
+        //:
+        //: 5 A batch push into a full queue pushes nothing, and leaves the
+        //:   queue and its elements unchanged.
+        //
+        // Plan:
+        //: 1 For each of a sequence of batch sizes, push and pop batches of
+        //:   increasing values through a queue of capacity 8, such that the
+        //:   positions wrap many times, and verify the counts and values
+        //:   returned.  (C-1..3)
+        //:
+        //: 2 Fill a queue with a batch larger than its capacity, and verify
+        //:   that only 'capacity()' elements are pushed; then drain it with a
+        //:   mix of single and batch pops.  (C-1..2, 4)
+        //:
+        //: 3 Fill a queue of strings, push batches into it, and verify that
+        //:   none is pushed, that no memory is allocated, and that the
+        //:   elements popped are those pushed before the queue was full.
+        //:   (C-5)
+        //
+        // Testing:
+        //   bsl::size_t tryPushBack(const TYPE *values, size_t numValues);
+        //   bsl::size_t tryPopFront(TYPE *values, bsl::size_t maxNumValues);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BATCH OPERATIONS" << endl
+                          << "================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        int values[32];
+        int results[32];
+
+        for (int batchSize = 1; batchSize <= 8; ++batchSize) {
+            Obj mX(8, &ta);  const Obj& X = mX;
+
+            int next     = 0;
+            int expected = 0;
+
+            for (int round = 0; round < 50; ++round) {
+                for (int i = 0; i < batchSize; ++i) {
+                    values[i] = next + i;
+                }
+                const bsl::size_t numPushed = mX.tryPushBack(values,
+                                                             batchSize);
+                ASSERTV(batchSize, round, numPushed,
+                        static_cast<int>(numPushed) == batchSize);
+                next += static_cast<int>(numPushed);
+
+                const bsl::size_t numPopped = mX.tryPopFront(results, 8);
+                ASSERTV(batchSize, round, numPopped,
+                        numPushed == numPopped);
+                for (bsl::size_t i = 0; i < numPopped; ++i) {
+                    ASSERTV(batchSize, round, i, results[i],
+                            expected == results[i]);
+                    ++expected;
+                }
+            }
+            ASSERT(X.isEmpty());
+            ASSERT(0 == mX.tryPushBack(values, 0));
+            ASSERT(0 == mX.tryPopFront(results, 0));
+            ASSERT(0 == mX.tryPopFront(results, 8));
+        }
+
+        {
+            Obj mX(8, &ta);  const Obj& X = mX;
+
+            for (int i = 0; i < 32; ++i) {
+                values[i] = i;
+            }
+
+            ASSERT(3 == mX.tryPushBack(values, 3));
+            ASSERT(0 == mX.tryPopFront(results));
+            ASSERT(0 == results[0]);
+
+            ASSERT(6 == mX.tryPushBack(values + 3, 29));
+            ASSERT(X.isFull());
+            ASSERT(0 == mX.tryPushBack(values + 9, 23));
+            ASSERT(0 != mX.tryPushBack(99));
+
+            ASSERT(2 == mX.tryPopFront(results, 2));
+            ASSERT(1 == results[0]);
+            ASSERT(2 == results[1]);
+            ASSERT(0 == mX.tryPopFront(results));
+            ASSERT(3 == results[0]);
+            ASSERT(5 == mX.tryPopFront(results, 32));
+            for (int i = 0; i < 5; ++i) {
+                ASSERTV(i, results[i], 4 + i == results[i]);
+            }
+            ASSERT(X.isEmpty());
+        }
+
+        if (verbose) cout << "\tBatch push into a full queue." << endl;
+        {
+            StringObj mX(4, &ta);  const StringObj& X = mX;
+
+            const bsl::string LONG(100, 'x');
+
+            for (int i = 0; i < 4; ++i) {
+                ASSERTV(i, 0 == mX.tryPushBack(LONG + char('a' + i)));
+            }
+            ASSERT(X.isFull());
+
+            const bsl::string BATCH[] = { "one", "two", LONG };
+
+            for (int attempt = 0; attempt < 3; ++attempt) {
+                const Int64 NUM_BYTES = ta.numBytesInUse();
+
+                ASSERTV(attempt, 0 == mX.tryPushBack(BATCH, 3));
+                ASSERTV(attempt, 0 == mX.tryPushBack(BATCH, 1));
+                ASSERTV(attempt, NUM_BYTES == ta.numBytesInUse());
+                ASSERTV(attempt, X.isFull());
+                ASSERTV(attempt, 4 == X.numElements());
+            }
+
+            bsl::string results[4];
+            ASSERT(4 == mX.tryPopFront(results, 4));
+            for (int i = 0; i < 4; ++i) {
+                ASSERTV(i, results[i], LONG + char('a' + i) == results[i]);
+            }
+            ASSERT(X.isEmpty());
+
+            ASSERT(3 == mX.tryPushBack(BATCH, 3));
+            ASSERT(3 == mX.tryPopFront(results, 4));
+            ASSERT("one" == results[0]);
+            ASSERT(LONG  == results[2]);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // SINGLE-ELEMENT PUSH AND POP
+        //
+        // Concerns:
+        //: 1 Elements are popped in the order in which they were pushed.
+        //:
+        //: 2 'tryPushBack' fails, with no effect, when the queue is full, and
+        //:   'tryPopFront' fails, with no effect, when it is empty.
+        //:
+        //: 3 The accessors report the number of elements, and whether the
+        //:   queue is empty or full, as positions wrap around the ring.
+        //:
+        //: 4 Elements are copied using the queue's allocator, and the
+        //:   elements remaining when the queue is destroyed are destroyed.
+        //
+        // Plan:
+        //: 1 For several capacities, repeatedly fill a queue and drain it,
+        //:   checking the values popped and the accessors after every
+        //:   operation; then interleave single pushes and pops so that the
+        //:   positions wrap many times.  (C-1..3)
+        //:
+        //: 2 Push strings requiring memory onto a queue of strings, and
+        //:   verify that their memory is supplied by the queue's allocator
+        //:   and released when the strings are popped, or when the queue is
+        //:   destroyed.  (C-4)
+        //
+        // Testing:
+        //   ~BoundedQueue();
+        //   int tryPushBack(const TYPE& value);
+        //   int tryPopFront(TYPE *value);
+        //   bool isEmpty() const;
+        //   bool isFull() const;
+        //   bsl::size_t numElements() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SINGLE-ELEMENT PUSH AND POP" << endl
+                          << "===========================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        if (verbose) cout << "\tFill and drain." << endl;
+
+        const bsl::size_t CAPACITIES[] = { 2, 4, 8, 64 };
+        const int         NUM_CAPACITIES = sizeof CAPACITIES
+                                         / sizeof *CAPACITIES;
+
+        for (int ti = 0; ti < NUM_CAPACITIES; ++ti) {
+            const bsl::size_t CAPACITY = CAPACITIES[ti];
+
+            Obj mX(CAPACITY, &ta);  const Obj& X = mX;
+
+            int next = 0;
+            for (int round = 0; round < 5; ++round) {
+                const int first = next;
+
+                for (bsl::size_t i = 0; i < CAPACITY; ++i) {
+                    ASSERTV(CAPACITY, i, X.numElements() == i);
+                    ASSERTV(CAPACITY, i, !X.isFull());
+                    ASSERTV(CAPACITY, i, 0 == mX.tryPushBack(next++));
+                    ASSERTV(CAPACITY, i, !X.isEmpty());
+                }
+                ASSERTV(CAPACITY, X.isFull());
+                ASSERTV(CAPACITY, CAPACITY == X.numElements());
+                ASSERTV(CAPACITY, 0 != mX.tryPushBack(-1));
+                ASSERTV(CAPACITY, CAPACITY == X.numElements());
+
+                for (bsl::size_t i = 0; i < CAPACITY; ++i) {
+                    int value = -1;
+                    ASSERTV(CAPACITY, i, 0 == mX.tryPopFront(&value));
+                    ASSERTV(CAPACITY, i, value,
+                            first + static_cast<int>(i) == value);
+                    ASSERTV(CAPACITY, i,
+                            X.numElements() == CAPACITY - i - 1);
+                }
+                ASSERTV(CAPACITY, X.isEmpty());
+
+                int value = -1;
+                ASSERTV(CAPACITY, 0 != mX.tryPopFront(&value));
+                ASSERTV(CAPACITY, -1 == value);
+            }
+        }
+
+        if (verbose) cout << "\tInterleaved operations." << endl;
+        {
+            Obj mX(4, &ta);  const Obj& X = mX;
+
+            int next     = 0;
+            int expected = 0;
+            for (int i = 0; i < 1000; ++i) {
+                // Keep between one and three elements in the queue.
+
+                ASSERTV(i, 0 == mX.tryPushBack(next++));
+                if (i % 3 != 2 && 1 < X.numElements()) {
+                    int value;
+                    ASSERTV(i, 0 == mX.tryPopFront(&value));
+                    ASSERTV(i, value, expected == value);
+                    ++expected;
+                }
+                if (3 == X.numElements()) {
+                    int value;
+                    ASSERTV(i, 0 == mX.tryPopFront(&value));
+                    ASSERTV(i, value, expected == value);
+                    ++expected;
+                }
+            }
+            ASSERT(static_cast<bsl::size_t>(next - expected)
+                                                           == X.numElements());
+        }
+
+        if (verbose) cout << "\tAllocator propagation." << endl;
+        {
+            bslma::TestAllocator sa("scratch", veryVeryVerbose);
+
+            const bsl::string VALUE(LONG_STRING, &sa);
+
+            StringObj mX(4, &ta);
+
+            ASSERT(1 == ta.numBlocksInUse());
+
+            ASSERT(0 == mX.tryPushBack(VALUE));
+            ASSERT(0 == mX.tryPushBack(VALUE));
+            ASSERT(3 == ta.numBlocksInUse());
+
+            bsl::string value(&sa);
+            ASSERT(0     == mX.tryPopFront(&value));
+            ASSERT(VALUE == value);
+            ASSERT(2 == ta.numBlocksInUse());
+
+            // The queue is destroyed holding one element.
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CONSTRUCTOR AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 The capacity is the least power of two, and at least 2, not less
+        //:   than the requested capacity.
+        //:
+        //: 2 Slots are cache-line sized and aligned.
+        //:
+        //: 3 The allocator supplied at construction (or the default allocator)
+        //:   supplies all memory, in a single block.
+        //:
+        //: 4 A new queue is empty.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Verify the values returned by the 'BoundedQueue_Util' functions
+        //:   for a table of inputs.  (C-1..2)
+        //:
+        //: 2 Create queues of a variety of capacities, with and without an
+        //:   allocator, and verify the accessors and the memory allocated.
+        //:   (C-1, 3..4)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a zero capacity.  (C-5)
+        //
+        // Testing:
+        //   bsl::size_t computeCapacity(bsl::size_t capacity);
+        //   bsl::size_t computeSlotSize(bsl::size_t size);
+        //   char *alignToCacheLine(char *address);
+        //   bsl::size_t maxCapacity();
+        //   explicit BoundedQueue(bsl::size_t capacity, Allocator *ba = 0);
+        //   bslma::Allocator *allocator() const;
+        //   bsl::size_t capacity() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONSTRUCTOR AND BASIC ACCESSORS" << endl
+                          << "===============================" << endl;
+
+        if (verbose) cout << "\tTesting 'BoundedQueue_Util'." << endl;
+        {
+            static const struct {
+                int         d_line;
+                bsl::size_t d_capacity;
+                bsl::size_t d_expected;
+            } DATA[] = {
+                //LINE  CAPACITY  EXPECTED
+                //----  --------  --------
+                { L_,          1,        2 },
+                { L_,          2,        2 },
+                { L_,          3,        4 },
+                { L_,          4,        4 },
+                { L_,          5,        8 },
+                { L_,        100,      128 },
+                { L_,       1024,     1024 },
+                { L_,       1025,     2048 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int         LINE     = DATA[ti].d_line;
+                const bsl::size_t CAPACITY = DATA[ti].d_capacity;
+                const bsl::size_t EXPECTED = DATA[ti].d_expected;
+
+                ASSERTV(LINE, EXPECTED == Util::computeCapacity(CAPACITY));
+            }
+
+            ASSERT( 64 == Util::computeSlotSize(1));
+            ASSERT( 64 == Util::computeSlotSize(64));
+            ASSERT(128 == Util::computeSlotSize(65));
+            ASSERT(192 == Util::computeSlotSize(129));
+
+            ASSERT(0 < Util::maxCapacity());
+            ASSERT(Util::maxCapacity() == Util::computeCapacity(
+                                                         Util::maxCapacity()));
+
+            char buffer[256];
+            for (int i = 0; i < 64; ++i) {
+                char *aligned = Util::alignToCacheLine(buffer + i);
+                ASSERTV(i, aligned >= buffer + i);
+                ASSERTV(i, aligned <  buffer + i + 64);
+                ASSERTV(i, 0 == reinterpret_cast<bsls::Types::UintPtr>(
+                                                               aligned) % 64);
+            }
+        }
+
+        if (verbose) cout << "\tTesting constructor." << endl;
+        {
+            bslma::TestAllocator ta("object", veryVeryVerbose);
+
+            for (bsl::size_t capacity = 1; capacity <= 130; ++capacity) {
+                Obj mX(capacity, &ta);  const Obj& X = mX;
+
+                ASSERTV(capacity, Util::computeCapacity(capacity)
+                                                            == X.capacity());
+                ASSERTV(capacity, &ta == X.allocator());
+                ASSERTV(capacity, 1 == ta.numBlocksInUse());
+                ASSERTV(capacity,
+                        static_cast<Int64>(X.capacity() * 64)
+                                                       <= ta.numBytesInUse());
+                ASSERTV(capacity, X.isEmpty());
+                ASSERTV(capacity, !X.isFull());
+                ASSERTV(capacity, 0 == X.numElements());
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+
+            {
+                Obj mX(10);  const Obj& X = mX;
+
+                ASSERT(16 == X.capacity());
+                ASSERT(&defaultAllocator == X.allocator());
+                ASSERT(1 == defaultAllocator.numBlocksInUse());
+            }
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bslma::TestAllocator ta("object", veryVeryVerbose);
+
+            ASSERT_FAIL(Obj(0, &ta));
+            ASSERT_PASS(Obj(1, &ta));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Push and pop a few elements, singly and in batches.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(4, &ta);  const Obj& X = mX;
+
+            ASSERT(4 == X.capacity());
+            ASSERT(X.isEmpty());
+
+            ASSERT(0 == mX.tryPushBack(1));
+            ASSERT(0 == mX.tryPushBack(2));
+            ASSERT(2 == X.numElements());
+
+            int value;
+            ASSERT(0 == mX.tryPopFront(&value));
+            ASSERT(1 == value);
+
+            const int VALUES[] = { 3, 4, 5, 6 };
+            ASSERT(3 == mX.tryPushBack(VALUES, 4));
+            ASSERT(X.isFull());
+
+            int values[4];
+            ASSERT(4 == mX.tryPopFront(values, 4));
+            ASSERT(2 == values[0]);
+            ASSERT(5 == values[3]);
+            ASSERT(X.isEmpty());
+            ASSERT(0 != mX.tryPopFront(&value));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: THROUGHPUT
+        //
+        // Concerns:
+        //: 1 The throughput of the queue scales reasonably with the number of
+        //:   producers and consumers, and batching improves it.
+        //
+        // Plan:
+        //: 1 For 1, 2, and 4 producer/consumer pairs, and for single
+        //:   operations and batches of 16, pass a (specified on the command
+        //:   line, default 1000000) number of values through a queue of
+        //:   capacity 1024, and report the elapsed time and the number of
+        //:   values transferred per second.
+        //
+        // Testing:
+        //   PERFORMANCE: THROUGHPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: THROUGHPUT" << endl
+                          << "=======================" << endl;
+
+        using namespace BenchmarkCase;
+
+        const int NUM_VALUES = argc > 2 ? atoi(argv[2]) : 1000000;
+
+        bslma::Allocator *alloc = &bslma::NewDeleteAllocator::singleton();
+
+        const int NUM_PAIRS[]   = { 1, 2, 4 };
+        const int BATCH_SIZES[] = { 1, 16 };
+
+        for (int pi = 0; pi < 3; ++pi) {
+            for (int bi = 0; bi < 2; ++bi) {
+                const int NUM_THREADS = 2 * NUM_PAIRS[pi];
+                const int PER_THREAD  = NUM_VALUES / NUM_PAIRS[pi];
+
+                Obj mX(1024, alloc);
+
+                bsls::AtomicInt numReady(0);
+                bsls::AtomicInt start(0);
+
+                bsl::vector<ThreadInfo> infos(NUM_THREADS, alloc);
+                bsl::vector<ThreadId>   ids(NUM_THREADS, alloc);
+
+                for (int i = 0; i < NUM_THREADS; ++i) {
+                    infos[i].d_queue_p    = &mX;
+                    infos[i].d_numValues  = PER_THREAD;
+                    infos[i].d_batchSize  = BATCH_SIZES[bi];
+                    infos[i].d_numReady_p = &numReady;
+                    infos[i].d_start_p    = &start;
+                    infos[i].d_sum        = 0;
+                    ids[i] = createThread(i % 2 ? &benchmarkConsumer
+                                                : &benchmarkProducer,
+                                          &infos[i]);
+                }
+                while (numReady < NUM_THREADS) {
+                    yieldThread();
+                }
+
+                bsls::Stopwatch timer;
+                timer.start();
+                start = 1;
+                for (int i = 0; i < NUM_THREADS; ++i) {
+                    joinThread(ids[i]);
+                }
+                timer.stop();
+
+                Int64 sum = 0;
+                for (int i = 1; i < NUM_THREADS; i += 2) {
+                    sum += infos[i].d_sum;
+                }
+                ASSERTV(sum, PER_THREAD * NUM_PAIRS[pi] == sum);
+
+                const double elapsed = timer.elapsedTime();
+                cout << NUM_PAIRS[pi] << "x" << NUM_PAIRS[pi]
+                     << ", batch " << BATCH_SIZES[bi] << ": "
+                     << elapsed << "s, "
+                     << (elapsed > 0 ? PER_THREAD * NUM_PAIRS[pi] / elapsed
+                                     : 0)
+                     << " values/s" << endl;
+            }
+        }
+      } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: LATENCY
+        //
+        // Concerns:
+        //: 1 The time taken for a value to pass from one thread to another
+        //:   through the queue is small.
+        //
+        // Plan:
+        //: 1 Pass a value back and forth between two threads through a pair
+        //:   of queues a (specified on the command line, default 100000)
+        //:   number of times, and report the mean round-trip time.
+        //
+        // Testing:
+        //   PERFORMANCE: LATENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: LATENCY" << endl
+                          << "====================" << endl;
+
+        using namespace BenchmarkCase;
+
+        const int NUM_ROUND_TRIPS = argc > 2 ? atoi(argv[2]) : 100000;
+
+        bslma::Allocator *alloc = &bslma::NewDeleteAllocator::singleton();
+
+        Obj requests(64, alloc);
+        Obj responses(64, alloc);
+
+        PingPongInfo info = { &requests, &responses, NUM_ROUND_TRIPS };
+
+        bsls::Stopwatch timer;
+        timer.start();
+
+        ThreadId id = createThread(&echoFunction, &info);
+        for (int i = 0; i < NUM_ROUND_TRIPS; ++i) {
+            while (0 != requests.tryPushBack(i)) {
+                yieldThread();
+            }
+            int value;
+            while (0 != responses.tryPopFront(&value)) {
+                yieldThread();
+            }
+            ASSERTV(i, value, i == value);
+        }
+        joinThread(id);
+
+        timer.stop();
+
+        cout << "mean round trip: "
+             << timer.elapsedTime() * 1e9 / NUM_ROUND_TRIPS << "ns" << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,583 @@
+// bdlc_daryheap.h                                                    -*-C++-*-
+#ifndef INCLUDED_BDLC_DARYHEAP
+#define INCLUDED_BDLC_DARYHEAP
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a priority queue implemented as a d-ary heap.
+//
+//@CLASSES:
+//  bdlc::DaryHeap: highest-priority-first queue stored as a d-ary heap
+//
+//@SEE_ALSO: bslstl_priorityqueue, bdlc_indexedheap, bdlc_pairingheap
+//
+//@DESCRIPTION: This component provides a class template, 'bdlc::DaryHeap',
+// that implements a highest-priority-first queue of objects of the (template
+// parameter) 'VALUE', ordered by the (template parameter) 'COMPARATOR', in the
+// manner of 'bsl::priority_queue': 'top' returns an element that no other
+// element compares greater than (so that, with the default 'bsl::less'
+// comparator, 'top' is the largest element).  The elements are stored in a
+// 'bsl::vector' as a *d-ary* heap, in which each node has up to the (template
+// parameter) 't_ARITY' children, rather than the two of the binary heap used
+// by 'bsl::priority_queue'.
+//
+///Choosing the Arity
+///------------------
+// A d-ary heap holding 'N' elements has a height of 'log_d(N)', so 'push'
+// performs fewer comparisons and moves as the arity grows, while 'pop'
+// compares each node on its path with all of its 'd' children.  Because the
+// children of a node are adjacent in memory, for small element types the 'd'
+// children typically share one or two cache lines, and a 4-ary heap (the
+// default) performs fewer cache misses than a binary heap on all but small
+// queues, at the cost of a few additional comparisons per 'pop'.  Larger
+// arities favor workloads dominated by 'push' (or by bulk construction).
+//
+///Bulk Construction
+///-----------------
+// The constructor and 'insert' method that take a range of elements build the
+// heap bottom-up in linear time, rather than pushing each element in turn
+// (which takes 'O(N log N)' time).
+//
+///Memory Allocation
+///-----------------
+// The 'bslma::Allocator' supplied at construction (or the default allocator)
+// supplies memory to the vector holding the elements, and to each element, if
+// 'VALUE' uses 'bslma' allocators.  Elements are moved within the heap using
+// 'swap', so no temporary element is created by 'push' or 'pop'.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Merging Sorted Runs
+/// - - - - - - - - - - - - - - -
+// Suppose that we need to merge several sorted runs of integers into a single
+// sorted sequence.  We keep the next element of each run in a priority queue,
+// ordered so that the smallest element is at the top.
+//
+// First, we define the runs, and an element type that refers to its run:
+//..
+//  const int RUN0[] = { 1, 4, 9 };
+//  const int RUN1[] = { 2, 3, 10, 11 };
+//  const int RUN2[] = { 5 };
+//
+//  const int *RUNS[]     = { RUN0, RUN1, RUN2 };
+//  const int  LENGTHS[]  = { 3, 4, 1 };
+//
+//  struct Entry {
+//      int d_value;
+//      int d_run;
+//      int d_index;
+//
+//      bool operator>(const Entry& rhs) const
+//      {
+//          return d_value > rhs.d_value;
+//      }
+//  };
+//..
+// Then, we create a 4-ary heap ordered by 'bsl::greater', and build it from
+// the first element of each run:
+//..
+//  Entry first[3];
+//  for (int i = 0; i < 3; ++i) {
+//      first[i].d_value = RUNS[i][0];
+//      first[i].d_run   = i;
+//      first[i].d_index = 0;
+//  }
+//
+//  bdlc::DaryHeap<Entry, 4, bsl::greater<Entry> > heap(first, first + 3);
+//  assert(3 == heap.size());
+//  assert(1 == heap.top().d_value);
+//..
+// Now, we repeatedly take the smallest element, and replace it with the next
+// element of its run:
+//..
+//  bsl::vector<int> merged;
+//  while (!heap.empty()) {
+//      Entry entry = heap.top();
+//      heap.pop();
+//      merged.push_back(entry.d_value);
+//
+//      if (++entry.d_index < LENGTHS[entry.d_run]) {
+//          entry.d_value = RUNS[entry.d_run][entry.d_index];
+//          heap.push(entry);
+//      }
+//  }
+//..
+// Finally, we observe that the runs were merged in order:
+//..
+//  const int EXPECTED[] = { 1, 2, 3, 4, 5, 9, 10, 11 };
+//  assert(8 == merged.size());
+//  assert(bsl::equal(merged.begin(), merged.end(), EXPECTED));
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SWAPUTIL
+#include <bslalg_swaputil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ASSERT
+#include <bslmf_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_FUNCTIONAL
+#include <bsl_functional.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                              // ==============
+                              // class DaryHeap
+                              // ==============
+
+template <class VALUE,
+          int   t_ARITY    = 4,
+          class COMPARATOR = bsl::less<VALUE> >
+class DaryHeap {
+    // This class template implements a highest-priority-first queue of
+    // objects of the (template parameter) 'VALUE', ordered by the (template
+    // parameter) 'COMPARATOR', and stored as a heap in which each node has up
+    // to the (template parameter) 't_ARITY' children.  'VALUE' must be
+    // copy-constructible and swappable, and 'COMPARATOR' must induce a strict
+    // weak ordering on 'VALUE'.
+
+    BSLMF_ASSERT(2 <= t_ARITY);
+
+    // DATA
+    bsl::vector<VALUE> d_values;      // elements, in heap order
+
+    COMPARATOR         d_comparator;  // orders the elements
+
+    // PRIVATE MANIPULATORS
+    void makeHeap();
+        // Arrange the elements of this heap into heap order.
+
+    void siftDown(bsl::size_t index);
+        // Restore the heap order of the subtree rooted at the specified
+        // 'index', assuming that its child subtrees are in heap order.
+
+    bsl::size_t siftDownToLeaf(bsl::size_t index);
+        // Move the element at the specified 'index' down to a leaf, swapping
+        // it at each level with its highest child, and return its new index.
+        // Note that this does not restore the heap order unless followed by
+        // 'siftUp' from the returned index.
+
+    void siftUp(bsl::size_t index);
+        // Restore the heap order of this heap, assuming that it is violated at
+        // most by the element at the specified 'index' and its ancestors.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(DaryHeap, bslma::UsesBslmaAllocator);
+
+    // PUBLIC TYPES
+    typedef VALUE        value_type;
+    typedef const VALUE& const_reference;
+    typedef bsl::size_t  size_type;
+    typedef COMPARATOR   value_compare;
+
+    // CREATORS
+    explicit DaryHeap(bslma::Allocator *basicAllocator = 0);
+    explicit DaryHeap(const COMPARATOR&  comparator,
+                      bslma::Allocator  *basicAllocator = 0);
+        // Create an empty heap.  Optionally specify a 'comparator' used to
+        // order the elements; if 'comparator' is not specified, a
+        // default-constructed 'COMPARATOR' is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    template <class INPUT_ITERATOR>
+    DaryHeap(INPUT_ITERATOR     first,
+             INPUT_ITERATOR     last,
+             const COMPARATOR&  comparator     = COMPARATOR(),
+             bslma::Allocator  *basicAllocator = 0);
+        // Create a heap holding copies of the elements in the range specified
+        // by '[first, last)', built in time linear in the number of elements.
+        // Optionally specify a 'comparator' used to order the elements; if
+        // 'comparator' is not specified, a default-constructed 'COMPARATOR' is
+        // used.  Optionally specify a 'basicAllocator' used to supply memory.
+        // If 'basicAllocator' is 0, the currently installed default allocator
+        // is used.
+
+    DaryHeap(const DaryHeap& original, bslma::Allocator *basicAllocator = 0);
+        // Create a heap having the same elements and comparator as the
+        // specified 'original' heap.  Optionally specify a 'basicAllocator'
+        // used to supply memory.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.
+
+    // ~DaryHeap() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    DaryHeap& operator=(const DaryHeap& rhs);
+        // Assign to this object the elements and comparator of the specified
+        // 'rhs' heap, and return a reference providing modifiable access to
+        // this object.
+
+    void clear();
+        // Remove all elements from this heap.
+
+    template <class INPUT_ITERATOR>
+    void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // Insert copies of the elements in the range specified by
+        // '[first, last)' into this heap.  If the number of inserted elements
+        // is at least the number of elements already held, the heap is
+        // rebuilt in time linear in its new size; otherwise each element is
+        // pushed in turn.
+
+    void pop();
+        // Remove the element at the top of this heap.  The behavior is
+        // undefined if this heap is empty.
+
+    void push(const VALUE& value);
+        // Insert a copy of the specified 'value' into this heap.
+
+    void reserve(size_type numElements);
+        // Reserve memory for at least the specified 'numElements' elements, so
+        // that pushing elements until that number is reached does not
+        // allocate memory for the heap itself.
+
+    void swap(DaryHeap& other);
+        // Exchange the elements and comparator of this heap with those of the
+        // specified 'other' heap.  The behavior is undefined unless both
+        // heaps use the same allocator.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this heap to supply memory.
+
+    bool empty() const;
+        // Return 'true' if this heap holds no elements, and 'false' otherwise.
+
+    size_type size() const;
+        // Return the number of elements in this heap.
+
+    const VALUE& top() const;
+        // Return a reference providing non-modifiable access to an element of
+        // this heap that no other element compares greater than.  The behavior
+        // is undefined if this heap is empty.
+
+    value_compare value_comp() const;
+        // Return the comparator used to order the elements of this heap.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                              // --------------
+                              // class DaryHeap
+                              // --------------
+
+// PRIVATE MANIPULATORS
+template <class VALUE, int t_ARITY, class COMPARATOR>
+void DaryHeap<VALUE, t_ARITY, COMPARATOR>::makeHeap()
+{
+    const bsl::size_t size = d_values.size();
+    if (size < 2) {
+        return;                                                       // RETURN
+    }
+
+    // Sift down each internal node, from the last to the root.
+
+    for (bsl::size_t index = (size - 2) / t_ARITY + 1; 0 < index--;) {
+        siftDown(index);
+    }
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+void DaryHeap<VALUE, t_ARITY, COMPARATOR>::siftDown(bsl::size_t index)
+{
+    VALUE             *values = d_values.data();
+    const bsl::size_t  size   = d_values.size();
+
+    for (;;) {
+        const bsl::size_t firstChild = index * t_ARITY + 1;
+        if (firstChild >= size) {
+            return;                                                   // RETURN
+        }
+
+        const bsl::size_t endChild = size - firstChild > t_ARITY
+                                   ? firstChild + t_ARITY
+                                   : size;
+
+        bsl::size_t best = firstChild;
+        for (bsl::size_t child = firstChild + 1; child < endChild; ++child) {
+            if (d_comparator(values[best], values[child])) {
+                best = child;
+            }
+        }
+
+        if (!d_comparator(values[index], values[best])) {
+            return;                                                   // RETURN
+        }
+
+        bslalg::SwapUtil::swap(values + index, values + best);
+        index = best;
+    }
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+bsl::size_t DaryHeap<VALUE, t_ARITY, COMPARATOR>::siftDownToLeaf(
+                                                            bsl::size_t index)
+{
+    VALUE             *values = d_values.data();
+    const bsl::size_t  size   = d_values.size();
+
+    for (;;) {
+        const bsl::size_t firstChild = index * t_ARITY + 1;
+        if (firstChild >= size) {
+            return index;                                             // RETURN
+        }
+
+        const bsl::size_t endChild = size - firstChild > t_ARITY
+                                   ? firstChild + t_ARITY
+                                   : size;
+
+        bsl::size_t best = firstChild;
+        for (bsl::size_t child = firstChild + 1; child < endChild; ++child) {
+            if (d_comparator(values[best], values[child])) {
+                best = child;
+            }
+        }
+
+        bslalg::SwapUtil::swap(values + index, values + best);
+        index = best;
+    }
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+void DaryHeap<VALUE, t_ARITY, COMPARATOR>::siftUp(bsl::size_t index)
+{
+    VALUE *values = d_values.data();
+
+    while (0 < index) {
+        const bsl::size_t parent = (index - 1) / t_ARITY;
+
+        if (!d_comparator(values[parent], values[index])) {
+            return;                                                   // RETURN
+        }
+
+        bslalg::SwapUtil::swap(values + parent, values + index);
+        index = parent;
+    }
+}
+
+// CREATORS
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+DaryHeap<VALUE, t_ARITY, COMPARATOR>::DaryHeap(
+                                              bslma::Allocator *basicAllocator)
+: d_values(basicAllocator)
+, d_comparator()
+{
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+DaryHeap<VALUE, t_ARITY, COMPARATOR>::DaryHeap(
+                                          const COMPARATOR&  comparator,
+                                          bslma::Allocator  *basicAllocator)
+: d_values(basicAllocator)
+, d_comparator(comparator)
+{
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+template <class INPUT_ITERATOR>
+DaryHeap<VALUE, t_ARITY, COMPARATOR>::DaryHeap(
+                                          INPUT_ITERATOR     first,
+                                          INPUT_ITERATOR     last,
+                                          const COMPARATOR&  comparator,
+                                          bslma::Allocator  *basicAllocator)
+: d_values(first, last, basicAllocator)
+, d_comparator(comparator)
+{
+    makeHeap();
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+DaryHeap<VALUE, t_ARITY, COMPARATOR>::DaryHeap(
+                                            const DaryHeap&   original,
+                                            bslma::Allocator *basicAllocator)
+: d_values(original.d_values, basicAllocator)
+, d_comparator(original.d_comparator)
+{
+}
+
+// MANIPULATORS
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+DaryHeap<VALUE, t_ARITY, COMPARATOR>&
+DaryHeap<VALUE, t_ARITY, COMPARATOR>::operator=(const DaryHeap& rhs)
+{
+    d_values     = rhs.d_values;
+    d_comparator = rhs.d_comparator;
+    return *this;
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+void DaryHeap<VALUE, t_ARITY, COMPARATOR>::clear()
+{
+    d_values.clear();
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+template <class INPUT_ITERATOR>
+void DaryHeap<VALUE, t_ARITY, COMPARATOR>::insert(INPUT_ITERATOR first,
+                                                  INPUT_ITERATOR last)
+{
+    const bsl::size_t oldSize = d_values.size();
+
+    d_values.insert(d_values.end(), first, last);
+
+    const bsl::size_t numInserted = d_values.size() - oldSize;
+
+    if (numInserted >= oldSize) {
+        makeHeap();
+    }
+    else {
+        for (bsl::size_t i = oldSize; i < d_values.size(); ++i) {
+            siftUp(i);
+        }
+    }
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+void DaryHeap<VALUE, t_ARITY, COMPARATOR>::pop()
+{
+    BSLS_ASSERT_SAFE(!d_values.empty());
+
+    if (1 < d_values.size()) {
+        bslalg::SwapUtil::swap(&d_values.front(), &d_values.back());
+        d_values.pop_back();
+
+        // The element moved to the root came from a leaf, and so most likely
+        // belongs near the bottom: sifting it to a leaf without comparing it
+        // on the way down, and then back up, saves comparisons.
+
+        siftUp(siftDownToLeaf(0));
+    }
+    else {
+        d_values.pop_back();
+    }
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+void DaryHeap<VALUE, t_ARITY, COMPARATOR>::push(const VALUE& value)
+{
+    d_values.push_back(value);
+    siftUp(d_values.size() - 1);
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+void DaryHeap<VALUE, t_ARITY, COMPARATOR>::reserve(size_type numElements)
+{
+    d_values.reserve(numElements);
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+void DaryHeap<VALUE, t_ARITY, COMPARATOR>::swap(DaryHeap& other)
+{
+    BSLS_ASSERT_SAFE(allocator() == other.allocator());
+
+    d_values.swap(other.d_values);
+    bslalg::SwapUtil::swap(&d_comparator, &other.d_comparator);
+}
+
+// ACCESSORS
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+bslma::Allocator *DaryHeap<VALUE, t_ARITY, COMPARATOR>::allocator() const
+{
+    return d_values.get_allocator().mechanism();
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+bool DaryHeap<VALUE, t_ARITY, COMPARATOR>::empty() const
+{
+    return d_values.empty();
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+typename DaryHeap<VALUE, t_ARITY, COMPARATOR>::size_type
+DaryHeap<VALUE, t_ARITY, COMPARATOR>::size() const
+{
+    return d_values.size();
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+const VALUE& DaryHeap<VALUE, t_ARITY, COMPARATOR>::top() const
+{
+    BSLS_ASSERT_SAFE(!d_values.empty());
+
+    return d_values.front();
+}
+
+template <class VALUE, int t_ARITY, class COMPARATOR>
+inline
+typename DaryHeap<VALUE, t_ARITY, COMPARATOR>::value_compare
+DaryHeap<VALUE, t_ARITY, COMPARATOR>::value_comp() const
+{
+    return d_comparator;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,779 @@
+// bdlc_daryheap.t.cpp                                                -*-C++-*-
+#include <bdlc_daryheap.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_queue.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a priority queue stored as a d-ary heap.  The
+// primary concern is that, for every supported arity and comparator, elements
+// are removed from the heap in the order defined by the comparator, however
+// they were inserted (one at a time, or in bulk).  We verify this by
+// comparing the sequence of popped elements with a sorted copy of the input.
+// We also verify that the allocator is propagated to the elements, and that
+// the bulk construction does not allocate more than once.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit DaryHeap(bslma::Allocator *basicAllocator = 0);
+// [ 2] explicit DaryHeap(const COMPARATOR& comparator, Allocator *ba);
+// [ 3] DaryHeap(INPUT_ITERATOR first, INPUT_ITERATOR last, ...);
+// [ 4] DaryHeap(const DaryHeap& original, Allocator *ba = 0);
+//
+// MANIPULATORS
+// [ 4] DaryHeap& operator=(const DaryHeap& rhs);
+// [ 4] void clear();
+// [ 3] void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+// [ 2] void pop();
+// [ 2] void push(const VALUE& value);
+// [ 4] void reserve(size_type numElements);
+// [ 4] void swap(DaryHeap& other);
+//
+// ACCESSORS
+// [ 4] bslma::Allocator *allocator() const;
+// [ 2] bool empty() const;
+// [ 2] size_type size() const;
+// [ 2] const VALUE& top() const;
+// [ 2] value_compare value_comp() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+// [-1] PERFORMANCE: COMPARISON WITH 'bsl::priority_queue'
+//=============================================================================
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlc::DaryHeap<int> Obj;
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+// ============================================================================
+//                     GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static unsigned int nextRandom(unsigned int *state)
+    // Return the next value of the linear congruential sequence whose state
+    // is held by the specified 'state'.
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 8) & 0xffffff;
+}
+
+static void generateValues(bsl::vector<int> *result,
+                           int               numValues,
+                           int               range,
+                           unsigned int      seed)
+    // Load into the specified 'result' the specified 'numValues' pseudo-random
+    // values in the range '[0, range)' generated from the specified 'seed'.
+{
+    result->clear();
+    for (int i = 0; i < numValues; ++i) {
+        result->push_back(static_cast<int>(nextRandom(&seed) % range));
+    }
+}
+
+template <class HEAP>
+static bool drainMatches(HEAP *heap, bsl::vector<int> expected)
+    // Pop all elements of the specified 'heap', and return 'true' if they
+    // were removed in the order of the specified 'expected' elements sorted
+    // by the comparator of 'heap' from highest to lowest, and 'false'
+    // otherwise.
+{
+    bsl::sort(expected.begin(), expected.end(), heap->value_comp());
+    bsl::reverse(expected.begin(), expected.end());
+
+    if (heap->size() != expected.size()) {
+        return false;                                                 // RETURN
+    }
+
+    for (bsl::size_t i = 0; i < expected.size(); ++i) {
+        if (heap->top() != expected[i]) {
+            return false;                                             // RETURN
+        }
+        heap->pop();
+    }
+    return heap->empty();
+}
+
+template <int t_ARITY, class COMPARATOR>
+static void testPushPop(int line)
+    // Push pseudo-random values of various counts into a heap of the
+    // (template parameter) 't_ARITY' ordered by the (template parameter)
+    // 'COMPARATOR', interleaving pops, and verify that the elements are
+    // removed in order.  Report failures using the specified 'line'.
+{
+    typedef bdlc::DaryHeap<int, t_ARITY, COMPARATOR> Heap;
+
+    const int COUNTS[]   = { 0, 1, 2, 3, t_ARITY, t_ARITY + 1, 17, 100, 1000 };
+    const int NUM_COUNTS = static_cast<int>(sizeof COUNTS / sizeof *COUNTS);
+
+    bslma::TestAllocator ta("object", veryVeryVerbose);
+
+    for (int ci = 0; ci < NUM_COUNTS; ++ci) {
+        const int COUNT = COUNTS[ci];
+
+        bsl::vector<int> values;
+        generateValues(&values, COUNT, COUNT / 2 + 1, ci + 1);
+
+        Heap mX(&ta);  const Heap& X = mX;
+        ASSERTV(line, COUNT, X.empty());
+        ASSERTV(line, COUNT, 0 == X.size());
+
+        for (int i = 0; i < COUNT; ++i) {
+            mX.push(values[i]);
+
+            ASSERTV(line, COUNT, i, i + 1 == static_cast<int>(X.size()));
+            ASSERTV(line, COUNT, i,
+                    *bsl::max_element(values.begin(),
+                                      values.begin() + i + 1,
+                                      X.value_comp()) == X.top());
+        }
+        ASSERTV(line, COUNT, drainMatches(&mX, values));
+
+        // Interleave pushes and pops, checking against a reference.
+
+        bsl::vector<int> reference;
+        for (int i = 0; i < COUNT; ++i) {
+            mX.push(values[i]);
+            reference.push_back(values[i]);
+
+            if (i % 3 == 2) {
+                bsl::vector<int>::iterator it =
+                               bsl::max_element(reference.begin(),
+                                                reference.end(),
+                                                X.value_comp());
+                ASSERTV(line, COUNT, i, *it == X.top());
+                reference.erase(it);
+                mX.pop();
+            }
+        }
+        ASSERTV(line, COUNT, drainMatches(&mX, reference));
+    }
+}
+
+template <int t_ARITY>
+static void testBulkBuild(int line)
+    // Build heaps of the (template parameter) 't_ARITY' from ranges of
+    // pseudo-random values of various lengths, using the range constructor
+    // and both branches of 'insert', and verify that the elements are removed
+    // in order.  Report failures using the specified 'line'.
+{
+    typedef bdlc::DaryHeap<int, t_ARITY> Heap;
+
+    const int COUNTS[]   = { 0, 1, 2, 3, t_ARITY, t_ARITY + 1, 17, 100, 1000 };
+    const int NUM_COUNTS = static_cast<int>(sizeof COUNTS / sizeof *COUNTS);
+
+    bslma::TestAllocator ta("object", veryVeryVerbose);
+
+    for (int ci = 0; ci < NUM_COUNTS; ++ci) {
+        const int COUNT = COUNTS[ci];
+
+        bsl::vector<int> values;
+        generateValues(&values, COUNT, 1000, ci + 7);
+
+        {
+            const bsls::Types::Int64 NUM_ALLOCS = ta.numAllocations();
+
+            Heap mX(values.begin(), values.end(), bsl::less<int>(), &ta);
+
+            ASSERTV(line, COUNT, COUNT == static_cast<int>(mX.size()));
+            ASSERTV(line, COUNT,
+                    ta.numAllocations() - NUM_ALLOCS <= 1);
+            ASSERTV(line, COUNT, drainMatches(&mX, values));
+        }
+
+        // Split the values between a 'push'-built prefix and an 'insert'-ed
+        // suffix, so that both 'insert' strategies are exercised.
+
+        for (int split = 0; split <= COUNT; split += COUNT / 4 + 1) {
+            Heap mX(&ta);
+            for (int i = 0; i < split; ++i) {
+                mX.push(values[i]);
+            }
+            mX.insert(values.begin() + split, values.end());
+
+            ASSERTV(line, COUNT, split,
+                    COUNT == static_cast<int>(mX.size()));
+            ASSERTV(line, COUNT, split, drainMatches(&mX, values));
+        }
+    }
+}
+
+// ============================================================================
+//                            USAGE EXAMPLE TYPES
+// ----------------------------------------------------------------------------
+
+namespace UsageExample {
+
+struct Entry {
+    int d_value;
+    int d_run;
+    int d_index;
+
+    bool operator>(const Entry& rhs) const
+    {
+        return d_value > rhs.d_value;
+    }
+};
+
+}  // close namespace UsageExample
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        using UsageExample::Entry;
+
+///Example 1: Merging Sorted Runs
+/// - - - - - - - - - - - - - - -
+// Suppose that we need to merge several sorted runs of integers into a single
+// sorted sequence.  We keep the next element of each run in a priority queue,
+// ordered so that the smallest element is at the top.
+//
+// First, we define the runs, and an element type that refers to its run:
+//..
+    const int RUN0[] = { 1, 4, 9 };
+    const int RUN1[] = { 2, 3, 10, 11 };
+    const int RUN2[] = { 5 };
+
+    const int *RUNS[]     = { RUN0, RUN1, RUN2 };
+    const int  LENGTHS[]  = { 3, 4, 1 };
+//..
+// Then, we create a 4-ary heap ordered by 'bsl::greater', and build it from
+// the first element of each run:
+//..
+    Entry first[3];
+    for (int i = 0; i < 3; ++i) {
+        first[i].d_value = RUNS[i][0];
+        first[i].d_run   = i;
+        first[i].d_index = 0;
+    }
+
+    bdlc::DaryHeap<Entry, 4, bsl::greater<Entry> > heap(first, first + 3);
+    ASSERT(3 == heap.size());
+    ASSERT(1 == heap.top().d_value);
+//..
+// Now, we repeatedly take the smallest element, and replace it with the next
+// element of its run:
+//..
+    bsl::vector<int> merged;
+    while (!heap.empty()) {
+        Entry entry = heap.top();
+        heap.pop();
+        merged.push_back(entry.d_value);
+
+        if (++entry.d_index < LENGTHS[entry.d_run]) {
+            entry.d_value = RUNS[entry.d_run][entry.d_index];
+            heap.push(entry);
+        }
+    }
+//..
+// Finally, we observe that the runs were merged in order:
+//..
+    const int EXPECTED[] = { 1, 2, 3, 4, 5, 9, 10, 11 };
+    ASSERT(8 == merged.size());
+    ASSERT(bsl::equal(merged.begin(), merged.end(), EXPECTED));
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // COPY, ASSIGNMENT, SWAP, AND ALLOCATOR
+        //
+        // Concerns:
+        //: 1 A copy has the same elements as the original, and uses the
+        //:   supplied (or default) allocator.
+        //:
+        //: 2 Assignment gives the target the elements of the source, without
+        //:   changing its allocator, and leaves the source unchanged.
+        //:
+        //: 3 'swap' exchanges the elements of two heaps.
+        //:
+        //: 4 'clear' removes all elements.
+        //:
+        //: 5 'reserve' allows subsequent pushes to proceed without allocating.
+        //:
+        //: 6 The allocator is passed to elements that use 'bslma' allocators.
+        //:
+        //: 7 No memory is leaked.
+        //
+        // Plan:
+        //: 1 Create heaps of 'bsl::string' using test allocators, and verify
+        //:   the allocators used by the heaps and their elements after each
+        //:   operation.  (C-1..7)
+        //
+        // Testing:
+        //   DaryHeap(const DaryHeap& original, Allocator *ba = 0);
+        //   DaryHeap& operator=(const DaryHeap& rhs);
+        //   void clear();
+        //   void reserve(size_type numElements);
+        //   void swap(DaryHeap& other);
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "COPY, ASSIGNMENT, SWAP, AND ALLOCATOR" << endl
+                          << "=====================================" << endl;
+
+        typedef bdlc::DaryHeap<bsl::string> StringHeap;
+
+        const char *WORDS[] = {
+            "pear", "apple", "a string long enough to allocate memory",
+            "fig", "banana", "cherry", "another long string that allocates"
+        };
+        const int NUM_WORDS = static_cast<int>(sizeof WORDS / sizeof *WORDS);
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        bslma::TestAllocator oa("other",  veryVeryVerbose);
+
+        {
+            StringHeap mX(&ta);  const StringHeap& X = mX;
+            ASSERT(&ta == X.allocator());
+
+            for (int i = 0; i < NUM_WORDS; ++i) {
+                mX.push(WORDS[i]);
+            }
+            ASSERT(&ta == X.top().get_allocator().mechanism());
+
+            if (verbose) cout << "\tTesting copy constructor." << endl;
+            {
+                StringHeap mY(X, &oa);  const StringHeap& Y = mY;
+
+                ASSERT(&oa == Y.allocator());
+                ASSERT(&oa == Y.top().get_allocator().mechanism());
+                ASSERT(X.size() == Y.size());
+                ASSERT(X.top()  == Y.top());
+
+                StringHeap mZ(X);  const StringHeap& Z = mZ;
+                ASSERT(&defaultAllocator == Z.allocator());
+                ASSERT(X.size() == Z.size());
+            }
+
+            if (verbose) cout << "\tTesting assignment." << endl;
+            {
+                StringHeap mY(&oa);  const StringHeap& Y = mY;
+                mY.push("zzz");
+
+                mY = X;
+
+                ASSERT(&oa == Y.allocator());
+                ASSERT(X.size() == Y.size());
+
+                bsl::vector<bsl::string> fromX, fromY;
+                StringHeap mXX(X, &ta);
+                while (!mXX.empty()) {
+                    fromX.push_back(mXX.top());
+                    mXX.pop();
+                }
+                while (!mY.empty()) {
+                    ASSERT(&oa == Y.top().get_allocator().mechanism());
+                    fromY.push_back(Y.top());
+                    mY.pop();
+                }
+                ASSERT(fromX == fromY);
+                ASSERT(NUM_WORDS == static_cast<int>(X.size()));
+
+                mY = Y;  // self-assignment
+                ASSERT(Y.empty());
+            }
+
+            if (verbose) cout << "\tTesting swap." << endl;
+            {
+                StringHeap mY(&ta);  const StringHeap& Y = mY;
+                mY.push("only");
+
+                mX.swap(mY);
+
+                ASSERT(1         == X.size());
+                ASSERT("only"    == X.top());
+                ASSERT(NUM_WORDS == static_cast<int>(Y.size()));
+                ASSERT("pear"    == Y.top());
+
+                mX.swap(mY);
+                ASSERT(NUM_WORDS == static_cast<int>(X.size()));
+
+                bsls::AssertTestHandlerGuard hG;
+
+                StringHeap mZ(&oa);
+                ASSERT_SAFE_FAIL(mX.swap(mZ));
+            }
+
+            if (verbose) cout << "\tTesting clear." << endl;
+
+            mX.clear();
+            ASSERT(X.empty());
+            ASSERT(0 == X.size());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting reserve." << endl;
+        {
+            Obj mX(&ta);
+
+            mX.reserve(100);
+            const bsls::Types::Int64 NUM_ALLOCS = ta.numAllocations();
+
+            for (int i = 0; i < 100; ++i) {
+                mX.push(i);
+            }
+            ASSERT(NUM_ALLOCS == ta.numAllocations());
+            ASSERT(99 == mX.top());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // BULK CONSTRUCTION
+        //
+        // Concerns:
+        //: 1 A heap built from a range, for any number of elements and any
+        //:   arity, removes its elements in order.
+        //:
+        //: 2 The range constructor allocates memory at most once.
+        //:
+        //: 3 'insert' yields a correctly ordered heap whether it rebuilds the
+        //:   heap or pushes the inserted elements one at a time.
+        //
+        // Plan:
+        //: 1 For several arities, build heaps from pseudo-random ranges of
+        //:   various lengths with the range constructor, and with 'insert'
+        //:   applied to heaps of various sizes, and compare the popped
+        //:   elements with a sorted reference.  (C-1..3)
+        //
+        // Testing:
+        //   DaryHeap(INPUT_ITERATOR first, INPUT_ITERATOR last, ...);
+        //   void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BULK CONSTRUCTION" << endl
+                          << "=================" << endl;
+
+        testBulkBuild<2>(L_);
+        testBulkBuild<3>(L_);
+        testBulkBuild<4>(L_);
+        testBulkBuild<8>(L_);
+        testBulkBuild<16>(L_);
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 'top' always returns an element that no other element compares
+        //:   greater than, for any arity and comparator.
+        //:
+        //: 2 'pop' removes the top element, and 'size' and 'empty' reflect
+        //:   the number of elements.
+        //:
+        //: 3 The comparator supplied at construction is used.
+        //:
+        //: 4 'top' and 'pop' assert that the heap is not empty.
+        //
+        // Plan:
+        //: 1 For several arities and both 'bsl::less' and 'bsl::greater',
+        //:   push pseudo-random values, checking 'top' after each push, and
+        //:   interleave pushes and pops, comparing with a reference.
+        //:   (C-1..3)
+        //:
+        //: 2 Verify that defensive checks are triggered on an empty heap.
+        //:   (C-4)
+        //
+        // Testing:
+        //   explicit DaryHeap(bslma::Allocator *basicAllocator = 0);
+        //   explicit DaryHeap(const COMPARATOR& comparator, Allocator *ba);
+        //   void pop();
+        //   void push(const VALUE& value);
+        //   bool empty() const;
+        //   size_type size() const;
+        //   const VALUE& top() const;
+        //   value_compare value_comp() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                         << endl
+                         << "PRIMARY MANIPULATORS AND BASIC ACCESSORS" << endl
+                         << "========================================" << endl;
+
+        testPushPop<2,  bsl::less<int> >(L_);
+        testPushPop<3,  bsl::less<int> >(L_);
+        testPushPop<4,  bsl::less<int> >(L_);
+        testPushPop<8,  bsl::less<int> >(L_);
+        testPushPop<2,  bsl::greater<int> >(L_);
+        testPushPop<4,  bsl::greater<int> >(L_);
+        testPushPop<16, bsl::greater<int> >(L_);
+
+        if (verbose) cout << "\tTesting comparator constructor." << endl;
+        {
+            const bsl::greater<int> COMPARATOR;
+
+            bdlc::DaryHeap<int, 4, bsl::greater<int> > mX(COMPARATOR);
+            mX.push(3);
+            mX.push(1);
+            mX.push(2);
+            ASSERT(1 == mX.top());
+        }
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT_SAFE_FAIL(X.top());
+            ASSERT_SAFE_FAIL(mX.pop());
+
+            mX.push(1);
+
+            ASSERT_SAFE_PASS(X.top());
+            ASSERT_SAFE_PASS(mX.pop());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Push and pop a few elements.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+            ASSERT(X.empty());
+
+            mX.push(5);
+            mX.push(9);
+            mX.push(1);
+            mX.push(7);
+
+            ASSERT(4 == X.size());
+            ASSERT(9 == X.top());
+
+            mX.pop();
+            ASSERT(7 == X.top());
+            mX.pop();
+            ASSERT(5 == X.top());
+            mX.pop();
+            ASSERT(1 == X.top());
+            mX.pop();
+            ASSERT(X.empty());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COMPARISON WITH 'bsl::priority_queue'
+        //
+        // Concerns:
+        //: 1 A 4-ary heap is not slower than the binary heap of
+        //:   'bsl::priority_queue' for large queues.
+        //
+        // Plan:
+        //: 1 Time a sequence of pushes, a sequence of interleaved pushes and
+        //:   pops, and a sequence of pops, for 'bsl::priority_queue' and for
+        //:   'DaryHeap' of several arities, and report the elapsed times.
+        //:   Optionally specify the number of elements as the second argument.
+        //
+        // Testing:
+        //   PERFORMANCE: COMPARISON WITH 'bsl::priority_queue'
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: COMPARISON WITH 'bsl::priority_queue'" << endl
+             << "==================================================" << endl;
+
+        const int NUM_ELEMENTS = argc > 2 ? atoi(argv[2]) : 1000000;
+
+        bsl::vector<int> values;
+        generateValues(&values, NUM_ELEMENTS, 0x7fffffff, 12345);
+
+        long long checksum = 0;
+
+#define BENCHMARK(NAME, HEAP)                                                 \
+        {                                                                     \
+            HEAP heap;                                                        \
+            bsls::Stopwatch timer;                                            \
+            timer.start();                                                    \
+            for (int i = 0; i < NUM_ELEMENTS; ++i) {                          \
+                heap.push(values[i]);                                         \
+            }                                                                 \
+            for (int i = 0; i < NUM_ELEMENTS; ++i) {                          \
+                checksum += heap.top();                                       \
+                heap.pop();                                                   \
+                heap.push(values[i] ^ 0x5555);                                \
+            }                                                                 \
+            while (!heap.empty()) {                                           \
+                checksum += heap.top();                                       \
+                heap.pop();                                                   \
+            }                                                                 \
+            timer.stop();                                                     \
+            cout << NAME << ": " << timer.elapsedTime() << "s" << endl;       \
+        }
+
+        typedef bdlc::DaryHeap<int, 2> BinaryHeap;
+        typedef bdlc::DaryHeap<int, 4> QuaternaryHeap;
+        typedef bdlc::DaryHeap<int, 8> OctonaryHeap;
+
+        BENCHMARK("bsl::priority_queue", bsl::priority_queue<int>);
+        BENCHMARK("DaryHeap<int, 2>   ", BinaryHeap);
+        BENCHMARK("DaryHeap<int, 4>   ", QuaternaryHeap);
+        BENCHMARK("DaryHeap<int, 8>   ", OctonaryHeap);
+
+#undef BENCHMARK
+
+        if (veryVerbose) {
+            P(checksum);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,600 @@
+// bdlc_indexedheap.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLC_INDEXEDHEAP
+#define INCLUDED_BDLC_INDEXEDHEAP
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a priority queue whose elements can be updated or erased.
+//
+//@CLASSES:
+//  bdlc::IndexedHeap: priority queue addressable through element handles
+//
+//@SEE_ALSO: bdlc_daryheap, bdlc_pairingheap, bslstl_priorityqueue
+//
+//@DESCRIPTION: This component provides a class template, 'bdlc::IndexedHeap',
+// that implements a highest-priority-first queue of objects of the (template
+// parameter) 'VALUE', ordered by the (template parameter) 'COMPARATOR' in the
+// manner of 'bsl::priority_queue', and that returns, for each element pushed,
+// an integer *handle* through which the element can later be accessed,
+// changed ('update'), or removed ('erase') in logarithmic time, without
+// rebuilding the heap.  This makes an indexed heap suitable for schedulers and
+// order books, whose entries are frequently rescheduled or cancelled.
+//
+// A handle remains valid until its element is removed (by 'erase', 'pop', or
+// 'clear'), after which it may be returned again by a later 'push'.  Handles
+// are small non-negative integers, so a client can use them to index its own
+// arrays.
+//
+///Implementation Notes
+///--------------------
+// The heap itself is a 4-ary heap of handles, and the elements are stored in
+// a separate array indexed by handle, together with the position of each
+// handle in the heap.  Moving an element within the heap therefore moves only
+// its handle, and elements are never copied once pushed (except by 'update').
+// The element of a removed handle is not destroyed until the handle is reused
+// (when the element is assigned the new value), or the heap is cleared or
+// destroyed.
+//
+// Memory for the handle arrays is reserved by 'push', so that 'erase' and
+// 'pop' never allocate memory and never throw.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Rescheduling Timers
+/// - - - - - - - - - - - - - - -
+// Suppose that we maintain a set of timers, each of which has a deadline, and
+// that timers are frequently rescheduled or cancelled before they expire.
+//
+// First, we create a heap of deadlines ordered so that the earliest deadline
+// is at the top:
+//..
+//  typedef bdlc::IndexedHeap<int, bsl::greater<int> > TimerHeap;
+//
+//  TimerHeap timers;
+//..
+// Then, we schedule three timers, retaining their handles:
+//..
+//  TimerHeap::Handle a = timers.push(30);
+//  TimerHeap::Handle b = timers.push(10);
+//  TimerHeap::Handle c = timers.push(20);
+//
+//  assert(10 == timers.top());
+//  assert(b  == timers.topHandle());
+//..
+// Next, we postpone timer 'b', and bring timer 'a' forward:
+//..
+//  timers.update(b, 40);
+//  timers.update(a, 5);
+//
+//  assert(5 == timers.top());
+//  assert(a == timers.topHandle());
+//..
+// Now, we cancel timer 'a':
+//..
+//  timers.erase(a);
+//
+//  assert(!timers.contains(a));
+//  assert(2  == timers.size());
+//  assert(20 == timers.top());
+//..
+// Finally, we expire the remaining timers in order of their deadlines:
+//..
+//  assert(c == timers.topHandle());
+//  timers.pop();
+//  assert(40 == timers.top());
+//  assert(b  == timers.topHandle());
+//  timers.pop();
+//  assert(timers.empty());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_FUNCTIONAL
+#include <bsl_functional.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                             // =================
+                             // class IndexedHeap
+                             // =================
+
+template <class VALUE, class COMPARATOR = bsl::less<VALUE> >
+class IndexedHeap {
+    // This class template implements a highest-priority-first queue of
+    // objects of the (template parameter) 'VALUE', ordered by the (template
+    // parameter) 'COMPARATOR', whose elements are addressed through handles
+    // that allow them to be updated or erased in logarithmic time.  'VALUE'
+    // must be copy-constructible and copy-assignable, and 'COMPARATOR' must
+    // induce a strict weak ordering on 'VALUE'.
+
+  public:
+    // PUBLIC TYPES
+    typedef int          Handle;      // identifies an element of the heap
+
+    typedef VALUE        value_type;
+    typedef const VALUE& const_reference;
+    typedef bsl::size_t  size_type;
+    typedef COMPARATOR   value_compare;
+
+  private:
+    // PRIVATE TYPES
+    enum {
+        k_ARITY = 4  // number of children of each node of the heap
+    };
+
+    // DATA
+    bsl::vector<Handle> d_heap;         // handles, in heap order
+
+    bsl::vector<int>    d_positions;    // position in 'd_heap' of each
+                                        // handle, or -1 if it is not in use
+
+    bsl::vector<VALUE>  d_values;       // element of each handle
+
+    bsl::vector<Handle> d_freeHandles;  // handles not in use
+
+    COMPARATOR          d_comparator;   // orders the elements
+
+    // PRIVATE MANIPULATORS
+    void place(int position, Handle handle);
+        // Store the specified 'handle' at the specified 'position' in the
+        // heap, and record that position.
+
+    void removeAt(int position);
+        // Remove the handle at the specified 'position' from the heap,
+        // restoring the heap order.  Note that the handle is not freed.
+
+    void siftDown(int position);
+        // Restore the heap order of the subtree rooted at the specified
+        // 'position', assuming that its child subtrees are in heap order.
+
+    void siftUp(int position);
+        // Restore the heap order of this heap, assuming that it is violated at
+        // most by the handle at the specified 'position' and its ancestors.
+
+    // PRIVATE ACCESSORS
+    bool isBelow(Handle lhs, Handle rhs) const;
+        // Return 'true' if the element of the specified 'lhs' handle compares
+        // less than the element of the specified 'rhs' handle (i.e., belongs
+        // below it in the heap), and 'false' otherwise.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(IndexedHeap, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit IndexedHeap(bslma::Allocator *basicAllocator = 0);
+    explicit IndexedHeap(const COMPARATOR&  comparator,
+                         bslma::Allocator  *basicAllocator = 0);
+        // Create an empty heap.  Optionally specify a 'comparator' used to
+        // order the elements; if 'comparator' is not specified, a
+        // default-constructed 'COMPARATOR' is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    IndexedHeap(const IndexedHeap&  original,
+                bslma::Allocator   *basicAllocator = 0);
+        // Create a heap having the same elements, handles, and comparator as
+        // the specified 'original' heap.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    // ~IndexedHeap() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    IndexedHeap& operator=(const IndexedHeap& rhs);
+        // Assign to this object the elements, handles, and comparator of the
+        // specified 'rhs' heap, and return a reference providing modifiable
+        // access to this object.
+
+    void clear();
+        // Remove all elements from this heap, invalidating all handles.
+
+    void erase(Handle handle);
+        // Remove the element having the specified 'handle' from this heap.
+        // The behavior is undefined unless 'contains(handle)'.
+
+    void pop();
+        // Remove the element at the top of this heap.  The behavior is
+        // undefined if this heap is empty.
+
+    Handle push(const VALUE& value);
+        // Insert a copy of the specified 'value' into this heap, and return
+        // the handle of the new element.
+
+    void reserve(size_type numElements);
+        // Reserve memory for at least the specified 'numElements' elements, so
+        // that pushing elements until that number is reached does not
+        // allocate memory for the heap itself.
+
+    void update(Handle handle, const VALUE& value);
+        // Assign the specified 'value' to the element having the specified
+        // 'handle', and restore the heap order.  The behavior is undefined
+        // unless 'contains(handle)'.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this heap to supply memory.
+
+    bool contains(Handle handle) const;
+        // Return 'true' if the specified 'handle' identifies an element of
+        // this heap, and 'false' otherwise.
+
+    bool empty() const;
+        // Return 'true' if this heap holds no elements, and 'false' otherwise.
+
+    size_type size() const;
+        // Return the number of elements in this heap.
+
+    const VALUE& top() const;
+        // Return a reference providing non-modifiable access to an element of
+        // this heap that no other element compares greater than.  The behavior
+        // is undefined if this heap is empty.
+
+    Handle topHandle() const;
+        // Return the handle of the element returned by 'top'.  The behavior is
+        // undefined if this heap is empty.
+
+    const VALUE& value(Handle handle) const;
+        // Return a reference providing non-modifiable access to the element
+        // having the specified 'handle'.  The behavior is undefined unless
+        // 'contains(handle)'.
+
+    value_compare value_comp() const;
+        // Return the comparator used to order the elements of this heap.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                             // -----------------
+                             // class IndexedHeap
+                             // -----------------
+
+// PRIVATE MANIPULATORS
+template <class VALUE, class COMPARATOR>
+inline
+void IndexedHeap<VALUE, COMPARATOR>::place(int position, Handle handle)
+{
+    d_heap[position]    = handle;
+    d_positions[handle] = position;
+}
+
+template <class VALUE, class COMPARATOR>
+void IndexedHeap<VALUE, COMPARATOR>::removeAt(int position)
+{
+    const Handle last = d_heap.back();
+    d_heap.pop_back();
+
+    if (position < static_cast<int>(d_heap.size())) {
+        // Move the last handle into the vacated position, from which it may
+        // need to move either up or down.
+
+        place(position, last);
+        siftUp(position);
+        siftDown(d_positions[last]);
+    }
+}
+
+template <class VALUE, class COMPARATOR>
+void IndexedHeap<VALUE, COMPARATOR>::siftDown(int position)
+{
+    const int    size   = static_cast<int>(d_heap.size());
+    const Handle handle = d_heap[position];
+
+    for (;;) {
+        const int firstChild = position * k_ARITY + 1;
+        if (firstChild >= size) {
+            break;
+        }
+
+        const int endChild = size - firstChild > k_ARITY
+                           ? firstChild + k_ARITY
+                           : size;
+
+        int best = firstChild;
+        for (int child = firstChild + 1; child < endChild; ++child) {
+            if (isBelow(d_heap[best], d_heap[child])) {
+                best = child;
+            }
+        }
+
+        if (!isBelow(handle, d_heap[best])) {
+            break;
+        }
+
+        place(position, d_heap[best]);
+        position = best;
+    }
+    place(position, handle);
+}
+
+template <class VALUE, class COMPARATOR>
+void IndexedHeap<VALUE, COMPARATOR>::siftUp(int position)
+{
+    const Handle handle = d_heap[position];
+
+    while (0 < position) {
+        const int parent = (position - 1) / k_ARITY;
+
+        if (!isBelow(d_heap[parent], handle)) {
+            break;
+        }
+
+        place(position, d_heap[parent]);
+        position = parent;
+    }
+    place(position, handle);
+}
+
+// PRIVATE ACCESSORS
+template <class VALUE, class COMPARATOR>
+inline
+bool IndexedHeap<VALUE, COMPARATOR>::isBelow(Handle lhs, Handle rhs) const
+{
+    return d_comparator(d_values[lhs], d_values[rhs]);
+}
+
+// CREATORS
+template <class VALUE, class COMPARATOR>
+inline
+IndexedHeap<VALUE, COMPARATOR>::IndexedHeap(bslma::Allocator *basicAllocator)
+: d_heap(basicAllocator)
+, d_positions(basicAllocator)
+, d_values(basicAllocator)
+, d_freeHandles(basicAllocator)
+, d_comparator()
+{
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+IndexedHeap<VALUE, COMPARATOR>::IndexedHeap(
+                                          const COMPARATOR&  comparator,
+                                          bslma::Allocator  *basicAllocator)
+: d_heap(basicAllocator)
+, d_positions(basicAllocator)
+, d_values(basicAllocator)
+, d_freeHandles(basicAllocator)
+, d_comparator(comparator)
+{
+}
+
+template <class VALUE, class COMPARATOR>
+IndexedHeap<VALUE, COMPARATOR>::IndexedHeap(
+                                         const IndexedHeap&  original,
+                                         bslma::Allocator   *basicAllocator)
+: d_heap(original.d_heap, basicAllocator)
+, d_positions(original.d_positions, basicAllocator)
+, d_values(original.d_values, basicAllocator)
+, d_freeHandles(basicAllocator)
+, d_comparator(original.d_comparator)
+{
+    // Preserve the guarantee that 'erase' does not allocate.
+
+    d_freeHandles.reserve(d_values.size());
+    d_freeHandles = original.d_freeHandles;
+}
+
+// MANIPULATORS
+template <class VALUE, class COMPARATOR>
+IndexedHeap<VALUE, COMPARATOR>&
+IndexedHeap<VALUE, COMPARATOR>::operator=(const IndexedHeap& rhs)
+{
+    if (this != &rhs) {
+        IndexedHeap copy(rhs, allocator());
+
+        d_heap.swap(copy.d_heap);
+        d_positions.swap(copy.d_positions);
+        d_values.swap(copy.d_values);
+        d_freeHandles.swap(copy.d_freeHandles);
+        d_comparator = rhs.d_comparator;
+    }
+    return *this;
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+void IndexedHeap<VALUE, COMPARATOR>::clear()
+{
+    d_heap.clear();
+    d_positions.clear();
+    d_values.clear();
+    d_freeHandles.clear();
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+void IndexedHeap<VALUE, COMPARATOR>::erase(Handle handle)
+{
+    BSLS_ASSERT_SAFE(contains(handle));
+
+    removeAt(d_positions[handle]);
+    d_positions[handle] = -1;
+    d_freeHandles.push_back(handle);  // capacity reserved by 'push'
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+void IndexedHeap<VALUE, COMPARATOR>::pop()
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    erase(d_heap.front());
+}
+
+template <class VALUE, class COMPARATOR>
+typename IndexedHeap<VALUE, COMPARATOR>::Handle
+IndexedHeap<VALUE, COMPARATOR>::push(const VALUE& value)
+{
+    // Reserve all memory before modifying any state, so that an exception
+    // leaves the heap unchanged, and so that 'erase' need not allocate.
+
+    d_heap.reserve(d_heap.size() + 1);
+
+    Handle handle;
+    if (d_freeHandles.empty()) {
+        handle = static_cast<Handle>(d_values.size());
+
+        d_positions.reserve(d_values.size() + 1);
+        d_freeHandles.reserve(d_values.size() + 1);
+        d_values.push_back(value);
+        d_positions.push_back(-1);
+    }
+    else {
+        handle = d_freeHandles.back();
+
+        d_values[handle] = value;
+        d_freeHandles.pop_back();
+    }
+
+    d_heap.push_back(handle);
+    d_positions[handle] = static_cast<int>(d_heap.size()) - 1;
+    siftUp(d_positions[handle]);
+
+    return handle;
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+void IndexedHeap<VALUE, COMPARATOR>::reserve(size_type numElements)
+{
+    d_heap.reserve(numElements);
+    d_positions.reserve(numElements);
+    d_values.reserve(numElements);
+    d_freeHandles.reserve(numElements);
+}
+
+template <class VALUE, class COMPARATOR>
+void IndexedHeap<VALUE, COMPARATOR>::update(Handle handle, const VALUE& value)
+{
+    BSLS_ASSERT_SAFE(contains(handle));
+
+    d_values[handle] = value;
+
+    siftUp(d_positions[handle]);
+    siftDown(d_positions[handle]);
+}
+
+// ACCESSORS
+template <class VALUE, class COMPARATOR>
+inline
+bslma::Allocator *IndexedHeap<VALUE, COMPARATOR>::allocator() const
+{
+    return d_heap.get_allocator().mechanism();
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+bool IndexedHeap<VALUE, COMPARATOR>::contains(Handle handle) const
+{
+    return 0 <= handle
+        && handle < static_cast<Handle>(d_positions.size())
+        && 0 <= d_positions[handle];
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+bool IndexedHeap<VALUE, COMPARATOR>::empty() const
+{
+    return d_heap.empty();
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+typename IndexedHeap<VALUE, COMPARATOR>::size_type
+IndexedHeap<VALUE, COMPARATOR>::size() const
+{
+    return d_heap.size();
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+const VALUE& IndexedHeap<VALUE, COMPARATOR>::top() const
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    return d_values[d_heap.front()];
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+typename IndexedHeap<VALUE, COMPARATOR>::Handle
+IndexedHeap<VALUE, COMPARATOR>::topHandle() const
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    return d_heap.front();
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+const VALUE& IndexedHeap<VALUE, COMPARATOR>::value(Handle handle) const
+{
+    BSLS_ASSERT_SAFE(contains(handle));
+
+    return d_values[handle];
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+typename IndexedHeap<VALUE, COMPARATOR>::value_compare
+IndexedHeap<VALUE, COMPARATOR>::value_comp() const
+{
+    return d_comparator;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
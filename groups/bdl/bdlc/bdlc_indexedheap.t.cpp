@@ -0,0 +1,801 @@
+// bdlc_indexedheap.t.cpp                                             -*-C++-*-
+#include <bdlc_indexedheap.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a priority queue whose elements are addressed
+// through handles.  The primary concerns are that the top of the heap is
+// always an element that no other element compares greater than, through any
+// sequence of pushes, pops, updates, and erasures; that handles identify the
+// same element until it is removed; and that 'erase' and 'pop' never allocate
+// memory.  We verify the heap against a simple reference model driven by a
+// pseudo-random sequence of operations.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit IndexedHeap(bslma::Allocator *basicAllocator = 0);
+// [ 2] explicit IndexedHeap(const COMPARATOR& comparator, Allocator *ba);
+// [ 4] IndexedHeap(const IndexedHeap& original, Allocator *ba = 0);
+//
+// MANIPULATORS
+// [ 4] IndexedHeap& operator=(const IndexedHeap& rhs);
+// [ 4] void clear();
+// [ 3] void erase(Handle handle);
+// [ 2] void pop();
+// [ 2] Handle push(const VALUE& value);
+// [ 4] void reserve(size_type numElements);
+// [ 3] void update(Handle handle, const VALUE& value);
+//
+// ACCESSORS
+// [ 4] bslma::Allocator *allocator() const;
+// [ 2] bool contains(Handle handle) const;
+// [ 2] bool empty() const;
+// [ 2] size_type size() const;
+// [ 2] const VALUE& top() const;
+// [ 2] Handle topHandle() const;
+// [ 2] const VALUE& value(Handle handle) const;
+// [ 2] value_compare value_comp() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+//=============================================================================
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlc::IndexedHeap<int> Obj;
+typedef Obj::Handle            Handle;
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+// ============================================================================
+//                     GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static unsigned int nextRandom(unsigned int *state)
+    // Return the next value of the linear congruential sequence whose state
+    // is held by the specified 'state'.
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 8) & 0xffffff;
+}
+
+                              // ===============
+                              // class Reference
+                              // ===============
+
+template <class COMPARATOR>
+class Reference {
+    // This class provides a trivially correct model of an indexed heap of
+    // 'int' values: the value of each live handle is kept in an array, and
+    // the top is found by linear search.
+
+    // DATA
+    bsl::vector<int>  d_values;  // value of each handle
+    bsl::vector<bool> d_live;    // whether each handle is in use
+    COMPARATOR        d_comparator;
+
+  public:
+    // MANIPULATORS
+    void erase(Handle handle)
+        // Remove the specified 'handle'.
+    {
+        d_live[handle] = false;
+    }
+
+    void set(Handle handle, int value)
+        // Make the specified 'handle' live with the specified 'value'.
+    {
+        if (handle >= static_cast<Handle>(d_values.size())) {
+            d_values.resize(handle + 1);
+            d_live.resize(handle + 1);
+        }
+        d_values[handle] = value;
+        d_live[handle]   = true;
+    }
+
+    // ACCESSORS
+    Handle anyLive(unsigned int random) const
+        // Return a live handle chosen using the specified 'random' number, or
+        // -1 if there is none.
+    {
+        const int n = static_cast<int>(d_live.size());
+        for (int i = 0; i < n; ++i) {
+            const int handle = static_cast<int>((random + i) % n);
+            if (d_live[handle]) {
+                return handle;                                        // RETURN
+            }
+        }
+        return -1;
+    }
+
+    bool isLive(Handle handle) const
+        // Return 'true' if the specified 'handle' is live.
+    {
+        return handle < static_cast<Handle>(d_live.size()) && d_live[handle];
+    }
+
+    int size() const
+        // Return the number of live handles.
+    {
+        return static_cast<int>(bsl::count(d_live.begin(), d_live.end(),
+                                           true));
+    }
+
+    int topValue() const
+        // Return the highest live value.  The behavior is undefined unless
+        // there is a live handle.
+    {
+        int result = 0;
+        bool found = false;
+        for (bsl::size_t i = 0; i < d_values.size(); ++i) {
+            if (d_live[i] && (!found || d_comparator(result, d_values[i]))) {
+                result = d_values[i];
+                found  = true;
+            }
+        }
+        return result;
+    }
+
+    int value(Handle handle) const
+        // Return the value of the specified 'handle'.
+    {
+        return d_values[handle];
+    }
+};
+
+template <class COMPARATOR>
+static void testRandomOperations(int line, int numOperations, int range)
+    // Apply the specified 'numOperations' pseudo-random pushes, pops,
+    // updates, and erasures, with values in '[0, range)', to an indexed heap
+    // ordered by the (template parameter) 'COMPARATOR' and to a reference
+    // model, verifying their agreement after each operation.  Report failures
+    // using the specified 'line'.
+{
+    typedef bdlc::IndexedHeap<int, COMPARATOR> Heap;
+
+    bslma::TestAllocator ta("object", veryVeryVerbose);
+
+    Heap                  mX(&ta);  const Heap& X = mX;
+    Reference<COMPARATOR> reference;
+    unsigned int          state = line;
+
+    for (int i = 0; i < numOperations; ++i) {
+        const unsigned int op    = nextRandom(&state) % 8;
+        const int          value = nextRandom(&state) % range;
+        const Handle       any   = reference.anyLive(nextRandom(&state));
+
+        const bsls::Types::Int64 NUM_ALLOCS = ta.numAllocations();
+
+        if (op < 3 || -1 == any) {
+            const Handle handle = mX.push(value);
+
+            ASSERTV(line, i, handle, !reference.isLive(handle));
+            reference.set(handle, value);
+        }
+        else if (op < 5) {
+            mX.update(any, value);
+            reference.set(any, value);
+
+            ASSERTV(line, i, NUM_ALLOCS == ta.numAllocations());
+        }
+        else if (op < 7) {
+            mX.erase(any);
+            reference.erase(any);
+
+            ASSERTV(line, i, !X.contains(any));
+            ASSERTV(line, i, NUM_ALLOCS == ta.numAllocations());
+        }
+        else {
+            const Handle top = X.topHandle();
+
+            ASSERTV(line, i, reference.isLive(top));
+            mX.pop();
+            reference.erase(top);
+
+            ASSERTV(line, i, !X.contains(top));
+            ASSERTV(line, i, NUM_ALLOCS == ta.numAllocations());
+        }
+
+        ASSERTV(line, i, reference.size() == static_cast<int>(X.size()));
+        if (!X.empty()) {
+            ASSERTV(line, i, reference.topValue() == X.top());
+            ASSERTV(line, i, X.top() == X.value(X.topHandle()));
+        }
+
+        if (veryVeryVerbose) {
+            P_(i) P_(op) P(X.size())
+        }
+    }
+
+    // Verify every live handle, then drain the heap in order.
+
+    const Handle any = reference.anyLive(0);
+    if (-1 != any) {
+        ASSERTV(line, reference.value(any) == X.value(any));
+    }
+
+    while (!X.empty()) {
+        ASSERTV(line, reference.topValue() == X.top());
+        reference.erase(X.topHandle());
+        mX.pop();
+    }
+    ASSERTV(line, 0 == reference.size());
+}
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Rescheduling Timers
+/// - - - - - - - - - - - - - - -
+// Suppose that we maintain a set of timers, each of which has a deadline, and
+// that timers are frequently rescheduled or cancelled before they expire.
+//
+// First, we create a heap of deadlines ordered so that the earliest deadline
+// is at the top:
+//..
+    typedef bdlc::IndexedHeap<int, bsl::greater<int> > TimerHeap;
+
+    TimerHeap timers;
+//..
+// Then, we schedule three timers, retaining their handles:
+//..
+    TimerHeap::Handle a = timers.push(30);
+    TimerHeap::Handle b = timers.push(10);
+    TimerHeap::Handle c = timers.push(20);
+
+    ASSERT(10 == timers.top());
+    ASSERT(b  == timers.topHandle());
+//..
+// Next, we postpone timer 'b', and bring timer 'a' forward:
+//..
+    timers.update(b, 40);
+    timers.update(a, 5);
+
+    ASSERT(5 == timers.top());
+    ASSERT(a == timers.topHandle());
+//..
+// Now, we cancel timer 'a':
+//..
+    timers.erase(a);
+
+    ASSERT(!timers.contains(a));
+    ASSERT(2  == timers.size());
+    ASSERT(20 == timers.top());
+//..
+// Finally, we expire the remaining timers in order of their deadlines:
+//..
+    ASSERT(c == timers.topHandle());
+    timers.pop();
+    ASSERT(40 == timers.top());
+    ASSERT(b  == timers.topHandle());
+    timers.pop();
+    ASSERT(timers.empty());
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // COPY, ASSIGNMENT, CLEAR, AND ALLOCATOR
+        //
+        // Concerns:
+        //: 1 A copy has the same elements under the same handles as the
+        //:   original, and uses the supplied (or default) allocator.
+        //:
+        //: 2 Assignment gives the target the elements and handles of the
+        //:   source, without changing its allocator.
+        //:
+        //: 3 Erasing from a copy does not allocate memory.
+        //:
+        //: 4 'clear' removes all elements and invalidates all handles.
+        //:
+        //: 5 'reserve' allows subsequent pushes to proceed without allocating.
+        //:
+        //: 6 The allocator is passed to elements that use 'bslma' allocators.
+        //:
+        //: 7 No memory is leaked.
+        //
+        // Plan:
+        //: 1 Create heaps of 'bsl::string' using test allocators, copy and
+        //:   assign them, and verify the elements, handles, and allocators.
+        //:   (C-1..7)
+        //
+        // Testing:
+        //   IndexedHeap(const IndexedHeap& original, Allocator *ba = 0);
+        //   IndexedHeap& operator=(const IndexedHeap& rhs);
+        //   void clear();
+        //   void reserve(size_type numElements);
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "COPY, ASSIGNMENT, CLEAR, AND ALLOCATOR" << endl
+                          << "======================================" << endl;
+
+        typedef bdlc::IndexedHeap<bsl::string> StringHeap;
+
+        const char *WORDS[] = {
+            "pear", "apple", "a string long enough to allocate memory",
+            "fig", "banana", "cherry", "another long string that allocates"
+        };
+        const int NUM_WORDS = static_cast<int>(sizeof WORDS / sizeof *WORDS);
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        bslma::TestAllocator oa("other",  veryVeryVerbose);
+
+        {
+            StringHeap mX(&ta);  const StringHeap& X = mX;
+            ASSERT(&ta == X.allocator());
+
+            StringHeap::Handle handles[NUM_WORDS];
+            for (int i = 0; i < NUM_WORDS; ++i) {
+                handles[i] = mX.push(WORDS[i]);
+            }
+            mX.erase(handles[1]);
+
+            ASSERT(&ta == X.top().get_allocator().mechanism());
+
+            if (verbose) cout << "\tTesting copy constructor." << endl;
+            {
+                StringHeap mY(X, &oa);  const StringHeap& Y = mY;
+
+                ASSERT(&oa == Y.allocator());
+                ASSERT(&oa == Y.top().get_allocator().mechanism());
+                ASSERT(X.size() == Y.size());
+                ASSERT(!Y.contains(handles[1]));
+
+                for (int i = 0; i < NUM_WORDS; ++i) {
+                    if (1 != i) {
+                        ASSERTV(i, WORDS[i] == Y.value(handles[i]));
+                    }
+                }
+
+                const bsls::Types::Int64 NUM_ALLOCS = oa.numAllocations();
+                mY.erase(handles[0]);
+                mY.erase(handles[2]);
+                ASSERT(NUM_ALLOCS == oa.numAllocations());
+
+                StringHeap mZ(X);  const StringHeap& Z = mZ;
+                ASSERT(&defaultAllocator == Z.allocator());
+                ASSERT(X.size() == Z.size());
+            }
+
+            if (verbose) cout << "\tTesting assignment." << endl;
+            {
+                StringHeap mY(&oa);  const StringHeap& Y = mY;
+                mY.push("zzz");
+
+                mY = X;
+
+                ASSERT(&oa == Y.allocator());
+                ASSERT(X.size()      == Y.size());
+                ASSERT(X.topHandle() == Y.topHandle());
+                ASSERT(X.top()       == Y.top());
+
+                mY = Y;  // self-assignment
+                ASSERT(X.size() == Y.size());
+            }
+
+            if (verbose) cout << "\tTesting clear." << endl;
+
+            mX.clear();
+            ASSERT(X.empty());
+            ASSERT(0 == X.size());
+            for (int i = 0; i < NUM_WORDS; ++i) {
+                ASSERTV(i, !X.contains(handles[i]));
+            }
+
+            ASSERT(0 == mX.push("again"));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting reserve." << endl;
+        {
+            Obj mX(&ta);
+
+            mX.reserve(100);
+            const bsls::Types::Int64 NUM_ALLOCS = ta.numAllocations();
+
+            for (int i = 0; i < 100; ++i) {
+                mX.push(i);
+            }
+            ASSERT(NUM_ALLOCS == ta.numAllocations());
+            ASSERT(99 == mX.top());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'update' AND 'erase'
+        //
+        // Concerns:
+        //: 1 'update' moves an element up or down as needed, so that 'top'
+        //:   remains correct.
+        //:
+        //: 2 'erase' removes exactly the identified element, wherever it is
+        //:   in the heap, and the handle is no longer contained.
+        //:
+        //: 3 The handles of erased elements are reused by later pushes, and
+        //:   the handles of other elements remain valid.
+        //:
+        //: 4 Neither 'update' (of an 'int'), 'erase', nor 'pop' allocates.
+        //:
+        //: 5 'update' and 'erase' assert that the handle is contained.
+        //
+        // Plan:
+        //: 1 Apply long pseudo-random sequences of pushes, pops, updates, and
+        //:   erasures to heaps ordered by 'bsl::less' and 'bsl::greater', and
+        //:   compare them with a reference model after each operation.
+        //:   (C-1..4)
+        //:
+        //: 2 Verify that defensive checks are triggered for invalid handles.
+        //:   (C-5)
+        //
+        // Testing:
+        //   void erase(Handle handle);
+        //   void update(Handle handle, const VALUE& value);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'update' AND 'erase'" << endl
+                          << "====================" << endl;
+
+        testRandomOperations<bsl::less<int> >(L_, 5000, 100);
+        testRandomOperations<bsl::less<int> >(L_, 5000, 100000);
+        testRandomOperations<bsl::greater<int> >(L_, 5000, 10);
+        testRandomOperations<bsl::greater<int> >(L_, 5000, 100000);
+
+        if (verbose) cout << "\tTesting handle reuse." << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+
+            const Handle H0 = mX.push(0);
+            const Handle H1 = mX.push(1);
+            const Handle H2 = mX.push(2);
+
+            mX.erase(H1);
+            ASSERT(H1 == mX.push(7));
+            ASSERT(7  == X.value(H1));
+            ASSERT(0  == X.value(H0));
+            ASSERT(2  == X.value(H2));
+            ASSERT(H1 == X.topHandle());
+        }
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX;
+
+            ASSERT_SAFE_FAIL(mX.update(0, 1));
+            ASSERT_SAFE_FAIL(mX.erase(0));
+
+            const Handle H = mX.push(1);
+
+            ASSERT_SAFE_FAIL(mX.update(H + 1, 1));
+            ASSERT_SAFE_FAIL(mX.erase(-1));
+            ASSERT_SAFE_PASS(mX.update(H, 2));
+            ASSERT_SAFE_PASS(mX.erase(H));
+            ASSERT_SAFE_FAIL(mX.erase(H));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 'push' returns a handle through which the pushed element can be
+        //:   accessed, and which is distinct from all other live handles.
+        //:
+        //: 2 'top' always returns an element that no other element compares
+        //:   greater than, and 'topHandle' its handle.
+        //:
+        //: 3 'pop' removes the top element, invalidating its handle.
+        //:
+        //: 4 The comparator supplied at construction is used.
+        //:
+        //: 5 'top', 'topHandle', 'pop', and 'value' assert their
+        //:   preconditions.
+        //
+        // Plan:
+        //: 1 Push pseudo-random values, checking 'top', 'topHandle', 'value',
+        //:   and 'contains' after each push, then pop all elements, checking
+        //:   that they are removed in order.  (C-1..4)
+        //:
+        //: 2 Verify that defensive checks are triggered on an empty heap.
+        //:   (C-5)
+        //
+        // Testing:
+        //   explicit IndexedHeap(bslma::Allocator *basicAllocator = 0);
+        //   explicit IndexedHeap(const COMPARATOR& comparator, Allocator *ba);
+        //   void pop();
+        //   Handle push(const VALUE& value);
+        //   bool contains(Handle handle) const;
+        //   bool empty() const;
+        //   size_type size() const;
+        //   const VALUE& top() const;
+        //   Handle topHandle() const;
+        //   const VALUE& value(Handle handle) const;
+        //   value_compare value_comp() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                         << endl
+                         << "PRIMARY MANIPULATORS AND BASIC ACCESSORS" << endl
+                         << "========================================" << endl;
+
+        const int COUNTS[]   = { 1, 2, 3, 4, 5, 17, 100, 1000 };
+        const int NUM_COUNTS = static_cast<int>(sizeof COUNTS
+                                                / sizeof *COUNTS);
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        for (int ci = 0; ci < NUM_COUNTS; ++ci) {
+            const int    COUNT = COUNTS[ci];
+            unsigned int state = ci;
+
+            Obj mX(&ta);  const Obj& X = mX;
+            ASSERTV(COUNT, X.empty());
+            ASSERTV(COUNT, !X.contains(0));
+
+            bsl::vector<int>    values;
+            bsl::vector<Handle> handles;
+            for (int i = 0; i < COUNT; ++i) {
+                const int value = nextRandom(&state) % (COUNT + 1);
+
+                const Handle handle = mX.push(value);
+                values.push_back(value);
+                handles.push_back(handle);
+
+                ASSERTV(COUNT, i, X.contains(handle));
+                ASSERTV(COUNT, i, value == X.value(handle));
+                ASSERTV(COUNT, i, i + 1 == static_cast<int>(X.size()));
+                ASSERTV(COUNT, i,
+                        *bsl::max_element(values.begin(), values.end())
+                                                                  == X.top());
+                ASSERTV(COUNT, i, X.top() == X.value(X.topHandle()));
+            }
+
+            bsl::vector<Handle> sortedHandles(handles);
+            bsl::sort(sortedHandles.begin(), sortedHandles.end());
+            ASSERTV(COUNT, sortedHandles.end() ==
+                           bsl::adjacent_find(sortedHandles.begin(),
+                                              sortedHandles.end()));
+
+            bsl::sort(values.begin(), values.end());
+            for (int i = COUNT - 1; 0 <= i; --i) {
+                const Handle handle = X.topHandle();
+
+                ASSERTV(COUNT, i, values[i] == X.top());
+                mX.pop();
+                ASSERTV(COUNT, i, !X.contains(handle));
+            }
+            ASSERTV(COUNT, X.empty());
+        }
+
+        if (verbose) cout << "\tTesting comparator constructor." << endl;
+        {
+            const bsl::greater<int> COMPARATOR;
+
+            bdlc::IndexedHeap<int, bsl::greater<int> > mX(COMPARATOR);
+            mX.push(3);
+            mX.push(1);
+            mX.push(2);
+            ASSERT(1 == mX.top());
+            ASSERT(1 == mX.topHandle());
+        }
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT_SAFE_FAIL(X.top());
+            ASSERT_SAFE_FAIL(X.topHandle());
+            ASSERT_SAFE_FAIL(X.value(0));
+            ASSERT_SAFE_FAIL(mX.pop());
+
+            mX.push(1);
+
+            ASSERT_SAFE_PASS(X.top());
+            ASSERT_SAFE_PASS(X.topHandle());
+            ASSERT_SAFE_PASS(X.value(0));
+            ASSERT_SAFE_PASS(mX.pop());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Push, update, erase, and pop a few elements.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+            ASSERT(X.empty());
+
+            const Handle H5 = mX.push(5);
+            const Handle H9 = mX.push(9);
+            const Handle H1 = mX.push(1);
+            const Handle H7 = mX.push(7);
+
+            ASSERT(4  == X.size());
+            ASSERT(9  == X.top());
+            ASSERT(H9 == X.topHandle());
+
+            mX.update(H1, 10);
+            ASSERT(10 == X.top());
+            ASSERT(H1 == X.topHandle());
+
+            mX.update(H1, 0);
+            ASSERT(9  == X.top());
+
+            mX.erase(H9);
+            ASSERT(!X.contains(H9));
+            ASSERT(7  == X.top());
+            ASSERT(H7 == X.topHandle());
+
+            mX.pop();
+            ASSERT(5  == X.top());
+            ASSERT(H5 == X.topHandle());
+            mX.pop();
+            ASSERT(0  == X.top());
+            mX.pop();
+            ASSERT(X.empty());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
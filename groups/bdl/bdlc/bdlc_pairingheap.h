@@ -0,0 +1,609 @@
+// bdlc_pairingheap.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLC_PAIRINGHEAP
+#define INCLUDED_BDLC_PAIRINGHEAP
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a priority queue that supports constant-time merging.
+//
+//@CLASSES:
+//  bdlc::PairingHeap: highest-priority-first queue stored as a pairing heap
+//
+//@SEE_ALSO: bdlc_daryheap, bdlc_indexedheap, bslstl_priorityqueue
+//
+//@DESCRIPTION: This component provides a class template, 'bdlc::PairingHeap',
+// that implements a highest-priority-first queue of objects of the (template
+// parameter) 'VALUE', ordered by the (template parameter) 'COMPARATOR' in the
+// manner of 'bsl::priority_queue', and stored as a *pairing* *heap*: a
+// heap-ordered tree of individually allocated nodes, each of which may have
+// any number of children.
+//
+// 'push' and 'merge' link the root of one tree below the root of another, and
+// so run in constant time; in particular, merging two pairing heaps does not
+// copy or move any element.  'pop' removes the root and combines its children
+// by a "two-pass" pairing, which runs in 'O(log N)' amortized time.  A pairing
+// heap is therefore preferable to an array-based heap (such as
+// 'bdlc::DaryHeap') when queues are frequently merged, for example when the
+// work queue of one thread is handed to another, but typically performs worse
+// otherwise, because its nodes are not adjacent in memory.
+//
+///Memory Allocation
+///-----------------
+// Each element is held in a node allocated from the 'bslma::Allocator'
+// supplied at construction (or the default allocator), which is also passed to
+// the element if 'VALUE' uses 'bslma' allocators.  Because 'merge' transfers
+// the nodes of one heap to another, the two heaps must use the same allocator.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Combining Work Queues
+/// - - - - - - - - - - - - - - - -
+// Suppose that two workers each maintain a queue of task priorities, and that
+// one of them is retiring and hands its remaining tasks to the other.
+//
+// First, we create the two queues, using the same allocator, and populate
+// them:
+//..
+//  bslma::Allocator *allocator = bslma::Default::defaultAllocator();
+//
+//  bdlc::PairingHeap<int> mine(allocator);
+//  bdlc::PairingHeap<int> theirs(allocator);
+//
+//  mine.push(3);
+//  mine.push(7);
+//  theirs.push(5);
+//  theirs.push(9);
+//  theirs.push(1);
+//
+//  assert(7 == mine.top());
+//  assert(9 == theirs.top());
+//..
+// Then, we take over the other worker's tasks, in constant time:
+//..
+//  mine.merge(&theirs);
+//
+//  assert(theirs.empty());
+//  assert(5 == mine.size());
+//..
+// Finally, we process the combined tasks, highest priority first:
+//..
+//  const int EXPECTED[] = { 9, 7, 5, 3, 1 };
+//  for (int i = 0; i < 5; ++i) {
+//      assert(EXPECTED[i] == mine.top());
+//      mine.pop();
+//  }
+//  assert(mine.empty());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARDESTRUCTIONPRIMITIVES
+#include <bslalg_scalardestructionprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARPRIMITIVES
+#include <bslalg_scalarprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEALLOCATORPROCTOR
+#include <bslma_deallocatorproctor.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_OBJECTBUFFER
+#include <bsls_objectbuffer.h>
+#endif
+
+#ifndef INCLUDED_BSL_ALGORITHM
+#include <bsl_algorithm.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_FUNCTIONAL
+#include <bsl_functional.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                           // =======================
+                           // struct PairingHeap_Node
+                           // =======================
+
+template <class VALUE>
+struct PairingHeap_Node {
+    // This component-private 'struct' provides a node of a pairing heap.  The
+    // children of a node form a singly-linked list, of which 'd_child_p' is
+    // the head.
+
+    // DATA
+    bsls::ObjectBuffer<VALUE>  d_value;      // element held by this node
+
+    PairingHeap_Node          *d_child_p;    // first child, or 0
+
+    PairingHeap_Node          *d_sibling_p;  // next sibling, or 0
+};
+
+                             // =================
+                             // class PairingHeap
+                             // =================
+
+template <class VALUE, class COMPARATOR = bsl::less<VALUE> >
+class PairingHeap {
+    // This class template implements a highest-priority-first queue of
+    // objects of the (template parameter) 'VALUE', ordered by the (template
+    // parameter) 'COMPARATOR', and stored as a pairing heap, so that two
+    // queues can be merged in constant time.  'VALUE' must be
+    // copy-constructible, and 'COMPARATOR' must induce a strict weak ordering
+    // on 'VALUE' and must not throw.
+
+    // PRIVATE TYPES
+    typedef PairingHeap_Node<VALUE> Node;
+
+    // DATA
+    Node             *d_root_p;       // root of the tree, or 0 if empty
+
+    bsl::size_t       d_numElements;  // number of elements
+
+    COMPARATOR        d_comparator;   // orders the elements
+
+    bslma::Allocator *d_allocator_p;  // memory allocator (held, not owned)
+
+    // PRIVATE MANIPULATORS
+    Node *createNode(const VALUE& value);
+        // Return the address of a newly allocated node holding a copy of the
+        // specified 'value', and having no children or siblings.
+
+    void destroyNode(Node *node);
+        // Destroy the element of the specified 'node', and deallocate 'node'.
+
+    void destroyTree(Node *root);
+        // Destroy and deallocate the specified 'root' node, its siblings, and
+        // all of their descendants.
+
+    Node *link(Node *lhs, Node *rhs);
+        // Make whichever of the specified 'lhs' and 'rhs' root nodes holds the
+        // element that compares lower the first child of the other, and return
+        // the resulting root.  The behavior is undefined unless neither node
+        // has a sibling.
+
+    Node *mergePairs(Node *first);
+        // Combine the trees in the sibling list whose head is the specified
+        // 'first' node into a single tree by two-pass pairing, and return its
+        // root, or 0 if 'first' is 0.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(PairingHeap, bslma::UsesBslmaAllocator);
+
+    // PUBLIC TYPES
+    typedef VALUE        value_type;
+    typedef const VALUE& const_reference;
+    typedef bsl::size_t  size_type;
+    typedef COMPARATOR   value_compare;
+
+    // CREATORS
+    explicit PairingHeap(bslma::Allocator *basicAllocator = 0);
+    explicit PairingHeap(const COMPARATOR&  comparator,
+                         bslma::Allocator  *basicAllocator = 0);
+        // Create an empty heap.  Optionally specify a 'comparator' used to
+        // order the elements; if 'comparator' is not specified, a
+        // default-constructed 'COMPARATOR' is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    PairingHeap(const PairingHeap&  original,
+                bslma::Allocator   *basicAllocator = 0);
+        // Create a heap having the same elements and comparator as the
+        // specified 'original' heap.  Optionally specify a 'basicAllocator'
+        // used to supply memory.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.
+
+    ~PairingHeap();
+        // Destroy this object.
+
+    // MANIPULATORS
+    PairingHeap& operator=(const PairingHeap& rhs);
+        // Assign to this object the elements and comparator of the specified
+        // 'rhs' heap, and return a reference providing modifiable access to
+        // this object.
+
+    void clear();
+        // Remove all elements from this heap.
+
+    void merge(PairingHeap *other);
+        // Move all elements of the specified 'other' heap into this heap,
+        // leaving 'other' empty, in constant time.  The behavior is undefined
+        // unless 'other' uses the same allocator as this heap, and
+        // 'this != other'.
+
+    void pop();
+        // Remove the element at the top of this heap.  The behavior is
+        // undefined if this heap is empty.
+
+    void push(const VALUE& value);
+        // Insert a copy of the specified 'value' into this heap.
+
+    void swap(PairingHeap& other);
+        // Exchange the elements and comparator of this heap with those of the
+        // specified 'other' heap.  This method provides the no-throw
+        // exception-safety guarantee.  The behavior is undefined unless
+        // 'other' uses the same allocator as this heap.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this heap to supply memory.
+
+    bool empty() const;
+        // Return 'true' if this heap holds no elements, and 'false' otherwise.
+
+    size_type size() const;
+        // Return the number of elements in this heap.
+
+    const VALUE& top() const;
+        // Return a reference providing non-modifiable access to an element of
+        // this heap that no other element compares greater than.  The behavior
+        // is undefined if this heap is empty.
+
+    value_compare value_comp() const;
+        // Return the comparator used to order the elements of this heap.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                             // -----------------
+                             // class PairingHeap
+                             // -----------------
+
+// PRIVATE MANIPULATORS
+template <class VALUE, class COMPARATOR>
+typename PairingHeap<VALUE, COMPARATOR>::Node *
+PairingHeap<VALUE, COMPARATOR>::createNode(const VALUE& value)
+{
+    Node *node = static_cast<Node *>(d_allocator_p->allocate(sizeof(Node)));
+
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(node, d_allocator_p);
+
+    bslalg::ScalarPrimitives::copyConstruct(&node->d_value.object(),
+                                            value,
+                                            d_allocator_p);
+    proctor.release();
+
+    node->d_child_p   = 0;
+    node->d_sibling_p = 0;
+    return node;
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+void PairingHeap<VALUE, COMPARATOR>::destroyNode(Node *node)
+{
+    bslalg::ScalarDestructionPrimitives::destroy(&node->d_value.object());
+    d_allocator_p->deallocate(node);
+}
+
+template <class VALUE, class COMPARATOR>
+void PairingHeap<VALUE, COMPARATOR>::destroyTree(Node *root)
+{
+    // Destroy the nodes in a list, splicing the children of each node onto
+    // the front of the list before destroying it, so that no recursion (and
+    // no additional memory) is needed.
+
+    Node *list = root;
+    while (list) {
+        Node *node = list;
+        list = node->d_sibling_p;
+
+        if (node->d_child_p) {
+            Node *last = node->d_child_p;
+            while (last->d_sibling_p) {
+                last = last->d_sibling_p;
+            }
+            last->d_sibling_p = list;
+            list              = node->d_child_p;
+        }
+        destroyNode(node);
+    }
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+typename PairingHeap<VALUE, COMPARATOR>::Node *
+PairingHeap<VALUE, COMPARATOR>::link(Node *lhs, Node *rhs)
+{
+    BSLS_ASSERT_SAFE(lhs && !lhs->d_sibling_p);
+    BSLS_ASSERT_SAFE(rhs && !rhs->d_sibling_p);
+
+    if (d_comparator(lhs->d_value.object(), rhs->d_value.object())) {
+        lhs->d_sibling_p = rhs->d_child_p;
+        rhs->d_child_p   = lhs;
+        return rhs;                                                   // RETURN
+    }
+
+    rhs->d_sibling_p = lhs->d_child_p;
+    lhs->d_child_p   = rhs;
+    return lhs;
+}
+
+template <class VALUE, class COMPARATOR>
+typename PairingHeap<VALUE, COMPARATOR>::Node *
+PairingHeap<VALUE, COMPARATOR>::mergePairs(Node *first)
+{
+    if (!first) {
+        return 0;                                                     // RETURN
+    }
+
+    // First pass: link the trees in pairs, from left to right, collecting the
+    // results in a list, in reverse order.
+
+    Node *pairs = 0;
+    while (first) {
+        Node *lhs = first;
+        Node *rhs = lhs->d_sibling_p;
+
+        if (!rhs) {
+            lhs->d_sibling_p = pairs;
+            pairs            = lhs;
+            break;
+        }
+
+        first            = rhs->d_sibling_p;
+        lhs->d_sibling_p = 0;
+        rhs->d_sibling_p = 0;
+
+        Node *pair = link(lhs, rhs);
+        pair->d_sibling_p = pairs;
+        pairs             = pair;
+    }
+
+    // Second pass: link the results into one tree, from right to left.
+
+    Node *result = pairs;
+    pairs = pairs->d_sibling_p;
+    result->d_sibling_p = 0;
+
+    while (pairs) {
+        Node *next = pairs->d_sibling_p;
+        pairs->d_sibling_p = 0;
+        result = link(result, pairs);
+        pairs  = next;
+    }
+    return result;
+}
+
+// CREATORS
+template <class VALUE, class COMPARATOR>
+inline
+PairingHeap<VALUE, COMPARATOR>::PairingHeap(bslma::Allocator *basicAllocator)
+: d_root_p(0)
+, d_numElements(0)
+, d_comparator()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+PairingHeap<VALUE, COMPARATOR>::PairingHeap(
+                                          const COMPARATOR&  comparator,
+                                          bslma::Allocator  *basicAllocator)
+: d_root_p(0)
+, d_numElements(0)
+, d_comparator(comparator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class VALUE, class COMPARATOR>
+PairingHeap<VALUE, COMPARATOR>::PairingHeap(
+                                         const PairingHeap&  original,
+                                         bslma::Allocator   *basicAllocator)
+: d_root_p(0)
+, d_numElements(0)
+, d_comparator(original.d_comparator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    // Push every element of 'original' into a temporary heap, which releases
+    // the elements already copied if an exception is thrown.  The pending
+    // subtrees of the traversal are kept on an explicit stack, so that deep
+    // trees do not exhaust the program stack.
+
+    PairingHeap copy(original.d_comparator, d_allocator_p);
+
+    bsl::vector<const Node *> pending(d_allocator_p);
+    if (original.d_root_p) {
+        pending.push_back(original.d_root_p);
+    }
+
+    while (!pending.empty()) {
+        const Node *node = pending.back();
+        pending.pop_back();
+
+        copy.push(node->d_value.object());
+
+        if (node->d_sibling_p) {
+            pending.push_back(node->d_sibling_p);
+        }
+        if (node->d_child_p) {
+            pending.push_back(node->d_child_p);
+        }
+    }
+    swap(copy);
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+PairingHeap<VALUE, COMPARATOR>::~PairingHeap()
+{
+    destroyTree(d_root_p);
+}
+
+// MANIPULATORS
+template <class VALUE, class COMPARATOR>
+PairingHeap<VALUE, COMPARATOR>&
+PairingHeap<VALUE, COMPARATOR>::operator=(const PairingHeap& rhs)
+{
+    if (this != &rhs) {
+        PairingHeap copy(rhs, d_allocator_p);
+        swap(copy);
+    }
+    return *this;
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+void PairingHeap<VALUE, COMPARATOR>::clear()
+{
+    destroyTree(d_root_p);
+    d_root_p      = 0;
+    d_numElements = 0;
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+void PairingHeap<VALUE, COMPARATOR>::merge(PairingHeap *other)
+{
+    BSLS_ASSERT_SAFE(other);
+    BSLS_ASSERT_SAFE(this != other);
+    BSLS_ASSERT_SAFE(d_allocator_p == other->d_allocator_p);
+
+    if (!other->d_root_p) {
+        return;                                                       // RETURN
+    }
+
+    d_root_p = d_root_p ? link(d_root_p, other->d_root_p) : other->d_root_p;
+    d_numElements += other->d_numElements;
+
+    other->d_root_p      = 0;
+    other->d_numElements = 0;
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+void PairingHeap<VALUE, COMPARATOR>::pop()
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    Node *root = d_root_p;
+    d_root_p = mergePairs(root->d_child_p);
+    --d_numElements;
+
+    destroyNode(root);
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+void PairingHeap<VALUE, COMPARATOR>::push(const VALUE& value)
+{
+    Node *node = createNode(value);
+
+    d_root_p = d_root_p ? link(d_root_p, node) : node;
+    ++d_numElements;
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+void PairingHeap<VALUE, COMPARATOR>::swap(PairingHeap& other)
+{
+    BSLS_ASSERT_SAFE(d_allocator_p == other.d_allocator_p);
+
+    bsl::swap(d_root_p,      other.d_root_p);
+    bsl::swap(d_numElements, other.d_numElements);
+    bsl::swap(d_comparator,  other.d_comparator);
+}
+
+// ACCESSORS
+template <class VALUE, class COMPARATOR>
+inline
+bslma::Allocator *PairingHeap<VALUE, COMPARATOR>::allocator() const
+{
+    return d_allocator_p;
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+bool PairingHeap<VALUE, COMPARATOR>::empty() const
+{
+    return 0 == d_root_p;
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+typename PairingHeap<VALUE, COMPARATOR>::size_type
+PairingHeap<VALUE, COMPARATOR>::size() const
+{
+    return d_numElements;
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+const VALUE& PairingHeap<VALUE, COMPARATOR>::top() const
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    return d_root_p->d_value.object();
+}
+
+template <class VALUE, class COMPARATOR>
+inline
+typename PairingHeap<VALUE, COMPARATOR>::value_compare
+PairingHeap<VALUE, COMPARATOR>::value_comp() const
+{
+    return d_comparator;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
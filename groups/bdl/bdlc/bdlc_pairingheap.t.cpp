@@ -0,0 +1,753 @@
+// bdlc_pairingheap.t.cpp                                             -*-C++-*-
+#include <bdlc_pairingheap.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a priority queue stored as a pairing heap.  The
+// primary concerns are that elements are removed in the order defined by the
+// comparator, however the heap was formed (by pushes, or by merging heaps);
+// that 'merge' neither allocates nor copies elements; and that no operation
+// (in particular destruction and copying) recurses on the depth of the tree,
+// which may be linear in the number of elements.  We verify the order against
+// a sorted copy of the input, and use 'bslma::TestAllocator' to verify memory
+// use.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit PairingHeap(bslma::Allocator *basicAllocator = 0);
+// [ 2] explicit PairingHeap(const COMPARATOR& comparator, Allocator *ba);
+// [ 4] PairingHeap(const PairingHeap& original, Allocator *ba = 0);
+// [ 2] ~PairingHeap();
+//
+// MANIPULATORS
+// [ 4] PairingHeap& operator=(const PairingHeap& rhs);
+// [ 4] void clear();
+// [ 3] void merge(PairingHeap *other);
+// [ 2] void pop();
+// [ 2] void push(const VALUE& value);
+// [ 4] void swap(PairingHeap& other);
+//
+// ACCESSORS
+// [ 4] bslma::Allocator *allocator() const;
+// [ 2] bool empty() const;
+// [ 2] size_type size() const;
+// [ 2] const VALUE& top() const;
+// [ 2] value_compare value_comp() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+//=============================================================================
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlc::PairingHeap<int> Obj;
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+// ============================================================================
+//                     GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static unsigned int nextRandom(unsigned int *state)
+    // Return the next value of the linear congruential sequence whose state
+    // is held by the specified 'state'.
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 8) & 0xffffff;
+}
+
+static void generateValues(bsl::vector<int> *result,
+                           int               numValues,
+                           int               range,
+                           unsigned int      seed)
+    // Load into the specified 'result' the specified 'numValues' pseudo-random
+    // values in the range '[0, range)' generated from the specified 'seed'.
+{
+    result->clear();
+    for (int i = 0; i < numValues; ++i) {
+        result->push_back(static_cast<int>(nextRandom(&seed) % range));
+    }
+}
+
+template <class HEAP>
+static bool drainMatches(HEAP *heap, bsl::vector<int> expected)
+    // Pop all elements of the specified 'heap', and return 'true' if they
+    // were removed in the order of the specified 'expected' elements sorted
+    // by the comparator of 'heap' from highest to lowest, and 'false'
+    // otherwise.
+{
+    bsl::sort(expected.begin(), expected.end(), heap->value_comp());
+    bsl::reverse(expected.begin(), expected.end());
+
+    if (heap->size() != expected.size()) {
+        return false;                                                 // RETURN
+    }
+
+    for (bsl::size_t i = 0; i < expected.size(); ++i) {
+        if (heap->top() != expected[i]) {
+            return false;                                             // RETURN
+        }
+        heap->pop();
+    }
+    return heap->empty();
+}
+
+template <class COMPARATOR>
+static void testPushPop(int line)
+    // Push pseudo-random values of various counts into a heap ordered by the
+    // (template parameter) 'COMPARATOR', interleaving pops, and verify that
+    // the elements are removed in order.  Report failures using the specified
+    // 'line'.
+{
+    typedef bdlc::PairingHeap<int, COMPARATOR> Heap;
+
+    const int COUNTS[]   = { 0, 1, 2, 3, 4, 5, 17, 100, 1000 };
+    const int NUM_COUNTS = static_cast<int>(sizeof COUNTS / sizeof *COUNTS);
+
+    bslma::TestAllocator ta("object", veryVeryVerbose);
+
+    for (int ci = 0; ci < NUM_COUNTS; ++ci) {
+        const int COUNT = COUNTS[ci];
+
+        bsl::vector<int> values;
+        generateValues(&values, COUNT, COUNT / 2 + 1, ci + 1);
+
+        Heap mX(&ta);  const Heap& X = mX;
+        ASSERTV(line, COUNT, X.empty());
+        ASSERTV(line, COUNT, 0 == X.size());
+
+        for (int i = 0; i < COUNT; ++i) {
+            mX.push(values[i]);
+
+            ASSERTV(line, COUNT, i, i + 1 == static_cast<int>(X.size()));
+            ASSERTV(line, COUNT, i,
+                    *bsl::max_element(values.begin(),
+                                      values.begin() + i + 1,
+                                      X.value_comp()) == X.top());
+        }
+        ASSERTV(line, COUNT, COUNT == ta.numBlocksInUse());
+        ASSERTV(line, COUNT, drainMatches(&mX, values));
+        ASSERTV(line, COUNT, 0 == ta.numBlocksInUse());
+
+        // Interleave pushes and pops, checking against a reference.
+
+        bsl::vector<int> reference;
+        for (int i = 0; i < COUNT; ++i) {
+            mX.push(values[i]);
+            reference.push_back(values[i]);
+
+            if (i % 3 == 2) {
+                bsl::vector<int>::iterator it =
+                               bsl::max_element(reference.begin(),
+                                                reference.end(),
+                                                X.value_comp());
+                ASSERTV(line, COUNT, i, *it == X.top());
+                reference.erase(it);
+                mX.pop();
+            }
+        }
+        ASSERTV(line, COUNT, drainMatches(&mX, reference));
+    }
+}
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Combining Work Queues
+/// - - - - - - - - - - - - - - - -
+// Suppose that two workers each maintain a queue of task priorities, and that
+// one of them is retiring and hands its remaining tasks to the other.
+//
+// First, we create the two queues, using the same allocator, and populate
+// them:
+//..
+    bslma::Allocator *allocator = bslma::Default::defaultAllocator();
+
+    bdlc::PairingHeap<int> mine(allocator);
+    bdlc::PairingHeap<int> theirs(allocator);
+
+    mine.push(3);
+    mine.push(7);
+    theirs.push(5);
+    theirs.push(9);
+    theirs.push(1);
+
+    ASSERT(7 == mine.top());
+    ASSERT(9 == theirs.top());
+//..
+// Then, we take over the other worker's tasks, in constant time:
+//..
+    mine.merge(&theirs);
+
+    ASSERT(theirs.empty());
+    ASSERT(5 == mine.size());
+//..
+// Finally, we process the combined tasks, highest priority first:
+//..
+    const int EXPECTED[] = { 9, 7, 5, 3, 1 };
+    for (int i = 0; i < 5; ++i) {
+        ASSERT(EXPECTED[i] == mine.top());
+        mine.pop();
+    }
+    ASSERT(mine.empty());
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // COPY, ASSIGNMENT, SWAP, AND ALLOCATOR
+        //
+        // Concerns:
+        //: 1 A copy has the same elements as the original, and uses the
+        //:   supplied (or default) allocator.
+        //:
+        //: 2 Assignment gives the target the elements of the source, without
+        //:   changing its allocator, and leaves the source unchanged.
+        //:
+        //: 3 'swap' exchanges the elements of two heaps.
+        //:
+        //: 4 'clear' removes all elements, and releases their memory.
+        //:
+        //: 5 The allocator is passed to elements that use 'bslma' allocators.
+        //:
+        //: 6 Copying, clearing, and destroying a heap whose tree is as deep
+        //:   as it has elements does not exhaust the program stack.
+        //:
+        //: 7 No memory is leaked.
+        //
+        // Plan:
+        //: 1 Create heaps of 'bsl::string' using test allocators, and verify
+        //:   the allocators used by the heaps and their elements after each
+        //:   operation.  (C-1..5, 7)
+        //:
+        //: 2 Push a long ascending sequence into a heap ordered by
+        //:   'bsl::less', which produces a single path, then copy, clear, and
+        //:   destroy it.  (C-6..7)
+        //
+        // Testing:
+        //   PairingHeap(const PairingHeap& original, Allocator *ba = 0);
+        //   PairingHeap& operator=(const PairingHeap& rhs);
+        //   void clear();
+        //   void swap(PairingHeap& other);
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "COPY, ASSIGNMENT, SWAP, AND ALLOCATOR" << endl
+                          << "=====================================" << endl;
+
+        typedef bdlc::PairingHeap<bsl::string> StringHeap;
+
+        const char *WORDS[] = {
+            "pear", "apple", "a string long enough to allocate memory",
+            "fig", "banana", "cherry", "another long string that allocates"
+        };
+        const int NUM_WORDS = static_cast<int>(sizeof WORDS / sizeof *WORDS);
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        bslma::TestAllocator oa("other",  veryVeryVerbose);
+
+        {
+            StringHeap mX(&ta);  const StringHeap& X = mX;
+            ASSERT(&ta == X.allocator());
+
+            for (int i = 0; i < NUM_WORDS; ++i) {
+                mX.push(WORDS[i]);
+            }
+            ASSERT(&ta == X.top().get_allocator().mechanism());
+
+            bsl::vector<bsl::string> sorted(WORDS, WORDS + NUM_WORDS);
+            bsl::sort(sorted.begin(), sorted.end());
+            bsl::reverse(sorted.begin(), sorted.end());
+
+            if (verbose) cout << "\tTesting copy constructor." << endl;
+            {
+                StringHeap mY(X, &oa);  const StringHeap& Y = mY;
+
+                ASSERT(&oa == Y.allocator());
+                ASSERT(X.size() == Y.size());
+
+                for (int i = 0; i < NUM_WORDS; ++i) {
+                    ASSERTV(i, sorted[i] == Y.top());
+                    ASSERTV(i, &oa == Y.top().get_allocator().mechanism());
+                    mY.pop();
+                }
+                ASSERT(Y.empty());
+                ASSERT(NUM_WORDS == static_cast<int>(X.size()));
+
+                StringHeap mZ(X);  const StringHeap& Z = mZ;
+                ASSERT(&defaultAllocator == Z.allocator());
+                ASSERT(X.size() == Z.size());
+            }
+            ASSERT(0 == oa.numBlocksInUse());
+
+            if (verbose) cout << "\tTesting assignment." << endl;
+            {
+                StringHeap mY(&oa);  const StringHeap& Y = mY;
+                mY.push("zzz");
+
+                mY = X;
+
+                ASSERT(&oa == Y.allocator());
+                ASSERT(X.size() == Y.size());
+                for (int i = 0; i < NUM_WORDS; ++i) {
+                    ASSERTV(i, sorted[i] == Y.top());
+                    mY.pop();
+                }
+
+                mY.push("only");
+                mY = Y;  // self-assignment
+                ASSERT(1      == Y.size());
+                ASSERT("only" == Y.top());
+            }
+            ASSERT(0 == oa.numBlocksInUse());
+
+            if (verbose) cout << "\tTesting swap." << endl;
+            {
+                StringHeap mY(&ta);  const StringHeap& Y = mY;
+                mY.push("only");
+
+                mX.swap(mY);
+
+                ASSERT(1         == X.size());
+                ASSERT("only"    == X.top());
+                ASSERT(NUM_WORDS == static_cast<int>(Y.size()));
+                ASSERT("pear"    == Y.top());
+
+                mX.swap(mY);
+                ASSERT(NUM_WORDS == static_cast<int>(X.size()));
+
+                bsls::AssertTestHandlerGuard hG;
+
+                StringHeap mZ(&oa);
+                ASSERT_SAFE_FAIL(mX.swap(mZ));
+            }
+
+            if (verbose) cout << "\tTesting clear." << endl;
+
+            mX.clear();
+            ASSERT(X.empty());
+            ASSERT(0 == X.size());
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting deep trees." << endl;
+        {
+            const int NUM_ELEMENTS = 200000;
+
+            Obj mX(&ta);  const Obj& X = mX;
+            for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                mX.push(i);
+            }
+            ASSERT(NUM_ELEMENTS - 1 == X.top());
+
+            Obj mY(X, &oa);  const Obj& Y = mY;
+            ASSERT(NUM_ELEMENTS == static_cast<int>(Y.size()));
+            ASSERT(NUM_ELEMENTS - 1 == Y.top());
+
+            mX.clear();
+            ASSERT(0 == ta.numBlocksInUse());
+
+            mX.push(0);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'merge'
+        //
+        // Concerns:
+        //: 1 Merging two heaps of any sizes (including empty heaps) yields a
+        //:   heap holding the elements of both, removed in order.
+        //:
+        //: 2 The merged-from heap is left empty, and is usable.
+        //:
+        //: 3 'merge' does not allocate or deallocate memory.
+        //:
+        //: 4 'merge' asserts that the heaps share an allocator, and are
+        //:   distinct.
+        //
+        // Plan:
+        //: 1 For each pair of sizes from a set, merge two heaps of
+        //:   pseudo-random values, and compare the popped elements with a
+        //:   sorted reference.  (C-1..3)
+        //:
+        //: 2 Repeatedly merge a sequence of small heaps into one.  (C-1, 3)
+        //:
+        //: 3 Verify that defensive checks are triggered for invalid
+        //:   arguments.  (C-4)
+        //
+        // Testing:
+        //   void merge(PairingHeap *other);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'merge'" << endl
+                          << "=======" << endl;
+
+        const int COUNTS[]   = { 0, 1, 2, 3, 10, 100 };
+        const int NUM_COUNTS = static_cast<int>(sizeof COUNTS
+                                                / sizeof *COUNTS);
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        for (int i = 0; i < NUM_COUNTS; ++i) {
+            for (int j = 0; j < NUM_COUNTS; ++j) {
+                bsl::vector<int> values1, values2;
+                generateValues(&values1, COUNTS[i], 50, i * 7 + j);
+                generateValues(&values2, COUNTS[j], 50, j * 13 + i + 1);
+
+                Obj mX(&ta);  const Obj& X = mX;
+                Obj mY(&ta);  const Obj& Y = mY;
+                for (int k = 0; k < COUNTS[i]; ++k) {
+                    mX.push(values1[k]);
+                }
+                for (int k = 0; k < COUNTS[j]; ++k) {
+                    mY.push(values2[k]);
+                }
+
+                const bsls::Types::Int64 NUM_ALLOCS   = ta.numAllocations();
+                const bsls::Types::Int64 NUM_DEALLOCS =
+                                                      ta.numDeallocations();
+
+                mX.merge(&mY);
+
+                ASSERTV(i, j, NUM_ALLOCS   == ta.numAllocations());
+                ASSERTV(i, j, NUM_DEALLOCS == ta.numDeallocations());
+                ASSERTV(i, j, Y.empty());
+                ASSERTV(i, j, 0 == Y.size());
+                ASSERTV(i, j,
+                        COUNTS[i] + COUNTS[j] == static_cast<int>(X.size()));
+
+                values1.insert(values1.end(), values2.begin(), values2.end());
+                ASSERTV(i, j, drainMatches(&mX, values1));
+
+                mY.push(42);
+                ASSERTV(i, j, 42 == Y.top());
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting repeated merges." << endl;
+        {
+            Obj              mX(&ta);
+            bsl::vector<int> all;
+            unsigned int     state = 3;
+
+            for (int i = 0; i < 100; ++i) {
+                Obj mY(&ta);
+
+                const int count = nextRandom(&state) % 10;
+                for (int k = 0; k < count; ++k) {
+                    const int value = nextRandom(&state) % 1000;
+                    mY.push(value);
+                    all.push_back(value);
+                }
+                mX.merge(&mY);
+
+                if (i % 10 == 9 && !mX.empty()) {
+                    bsl::vector<int>::iterator it =
+                                          bsl::max_element(all.begin(),
+                                                           all.end());
+                    ASSERTV(i, *it == mX.top());
+                    all.erase(it);
+                    mX.pop();
+                }
+            }
+            ASSERT(drainMatches(&mX, all));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            bslma::TestAllocator oa("other", veryVeryVerbose);
+
+            Obj mX(&ta);
+            Obj mY(&ta);
+            Obj mZ(&oa);
+
+            ASSERT_SAFE_FAIL(mX.merge(0));
+            ASSERT_SAFE_FAIL(mX.merge(&mX));
+            ASSERT_SAFE_FAIL(mX.merge(&mZ));
+            ASSERT_SAFE_PASS(mX.merge(&mY));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 'top' always returns an element that no other element compares
+        //:   greater than.
+        //:
+        //: 2 'pop' removes the top element and releases its memory, and
+        //:   'size' and 'empty' reflect the number of elements.
+        //:
+        //: 3 Each element occupies one block of the supplied allocator, and
+        //:   the destructor releases all memory.
+        //:
+        //: 4 The comparator supplied at construction is used.
+        //:
+        //: 5 'top' and 'pop' assert that the heap is not empty.
+        //
+        // Plan:
+        //: 1 For both 'bsl::less' and 'bsl::greater', push pseudo-random
+        //:   values, checking 'top' after each push, and interleave pushes
+        //:   and pops, comparing with a reference.  (C-1..4)
+        //:
+        //: 2 Verify that defensive checks are triggered on an empty heap.
+        //:   (C-5)
+        //
+        // Testing:
+        //   explicit PairingHeap(bslma::Allocator *basicAllocator = 0);
+        //   explicit PairingHeap(const COMPARATOR& comparator, Allocator *ba);
+        //   ~PairingHeap();
+        //   void pop();
+        //   void push(const VALUE& value);
+        //   bool empty() const;
+        //   size_type size() const;
+        //   const VALUE& top() const;
+        //   value_compare value_comp() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                         << endl
+                         << "PRIMARY MANIPULATORS AND BASIC ACCESSORS" << endl
+                         << "========================================" << endl;
+
+        testPushPop<bsl::less<int> >(L_);
+        testPushPop<bsl::greater<int> >(L_);
+
+        if (verbose) cout << "\tTesting comparator constructor." << endl;
+        {
+            const bsl::greater<int> COMPARATOR;
+
+            bdlc::PairingHeap<int, bsl::greater<int> > mX(COMPARATOR);
+            mX.push(3);
+            mX.push(1);
+            mX.push(2);
+            ASSERT(1 == mX.top());
+        }
+
+        if (verbose) cout << "\tTesting destructor." << endl;
+        {
+            bslma::TestAllocator ta("object", veryVeryVerbose);
+            {
+                Obj mX(&ta);
+                for (int i = 0; i < 100; ++i) {
+                    mX.push(i % 7);
+                }
+                mX.pop();
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT_SAFE_FAIL(X.top());
+            ASSERT_SAFE_FAIL(mX.pop());
+
+            mX.push(1);
+
+            ASSERT_SAFE_PASS(X.top());
+            ASSERT_SAFE_PASS(mX.pop());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Push, merge, and pop a few elements.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+            Obj mY(&ta);  const Obj& Y = mY;
+            ASSERT(X.empty());
+
+            mX.push(5);
+            mX.push(1);
+            mY.push(9);
+            mY.push(7);
+
+            ASSERT(2 == X.size());
+            ASSERT(5 == X.top());
+            ASSERT(9 == Y.top());
+
+            mX.merge(&mY);
+            ASSERT(Y.empty());
+            ASSERT(4 == X.size());
+
+            ASSERT(9 == X.top());
+            mX.pop();
+            ASSERT(7 == X.top());
+            mX.pop();
+            ASSERT(5 == X.top());
+            mX.pop();
+            ASSERT(1 == X.top());
+            mX.pop();
+            ASSERT(X.empty());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1651 @@
+// bdlc_smallvector.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLC_SMALLVECTOR
+#define INCLUDED_BDLC_SMALLVECTOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide vectors that store a bounded number of elements in place.
+//
+//@CLASSES:
+//  bdlc::SmallVector: vector with in-place storage that spills to an allocator
+//  bdlc::InplaceVector: fixed-capacity vector that never allocates
+//
+//@SEE_ALSO: bslstl_vector, bslalg_arrayprimitives
+//
+//@DESCRIPTION: This component provides two class templates,
+// 'bdlc::SmallVector' and 'bdlc::InplaceVector', that model a contiguous
+// sequence of elements of the (template parameter) 'TYPE' in a manner similar
+// to 'bsl::vector', but that provide storage for up to the (template
+// parameter) 't_CAPACITY' elements within the footprint of the object itself.
+//
+// A 'bdlc::SmallVector' stores its first 't_CAPACITY' elements in place.
+// When an operation would grow the vector beyond its current capacity, the
+// elements are moved to a block of memory obtained from the 'bslma::Allocator'
+// supplied at construction (or the currently installed default allocator),
+// and subsequent growth proceeds geometrically, as it does for 'bsl::vector'.
+// Consequently, a small vector whose length never exceeds 't_CAPACITY' never
+// allocates memory itself.
+//
+// A 'bdlc::InplaceVector' has a fixed capacity of 't_CAPACITY' elements and
+// never allocates memory itself; the behavior is undefined if an operation
+// would grow an in-place vector beyond its capacity.
+//
+// In both cases the allocator supplied at construction is passed to each
+// element whose 'TYPE' uses 'bslma' allocators.  All element construction,
+// destruction, and relocation is delegated to 'bslalg::ArrayPrimitives', so
+// that element types having the 'bslmf::IsBitwiseMoveable' or
+// 'bsl::is_trivially_copyable' traits are relocated with 'memcpy'.
+//
+///Memory Footprint
+///----------------
+// The in-place storage is part of the object, so 'sizeof(SmallVector<T, N>)'
+// and 'sizeof(InplaceVector<T, N>)' are both at least 'N * sizeof(T)'.  These
+// types are therefore appropriate only for small values of 't_CAPACITY', and
+// are most beneficial when the length of most vectors in an application is
+// known not to exceed a small bound.
+//
+// Note that, because a 'SmallVector' may refer to its own in-place storage,
+// 'SmallVector' is *not* bitwise-moveable.  An 'InplaceVector' is
+// bitwise-moveable if and only if 'TYPE' is bitwise-moveable.
+//
+///Exception Safety
+///----------------
+// The exception-safety guarantees of the manipulators of these types are the
+// same as those of the corresponding manipulators of 'bsl::vector', and derive
+// from the contracts of the 'bslalg::ArrayPrimitives' functions they use.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Collecting a Small Number of Fields per Message
+/// - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we are decoding messages, each of which carries a list of
+// field identifiers.  Most messages carry fewer than eight fields, but an
+// occasional message carries many more.
+//
+// First, we define a function that collects the identifiers of the fields
+// present in a message into a 'bdlc::SmallVector' having in-place capacity for
+// eight elements:
+//..
+//  typedef bdlc::SmallVector<int, 8> FieldIds;
+//
+//  void collectFieldIds(FieldIds *result, const int *fields, int numFields)
+//      // Load into the specified 'result' the non-negative field identifiers
+//      // in the specified 'fields' array of the specified 'numFields' length.
+//  {
+//      for (int i = 0; i < numFields; ++i) {
+//          if (0 <= fields[i]) {
+//              result->push_back(fields[i]);
+//          }
+//      }
+//  }
+//..
+// Then, we create a test allocator, and a small vector that uses it:
+//..
+//  bslma::TestAllocator ta;
+//
+//  FieldIds ids(&ta);
+//  assert(8 == ids.capacity());
+//..
+// Next, we collect the fields of a typical message, and observe that no memory
+// was allocated:
+//..
+//  const int SMALL[] = { 3, -1, 7, 12, 5 };
+//  collectFieldIds(&ids, SMALL, 5);
+//
+//  assert(4 == ids.size());
+//  assert(0 == ta.numBlocksTotal());
+//..
+// Now, we collect the fields of an unusually large message, and observe that
+// the vector spilled into memory supplied by the allocator:
+//..
+//  int large[32];
+//  for (int i = 0; i < 32; ++i) {
+//      large[i] = i;
+//  }
+//  ids.clear();
+//  collectFieldIds(&ids, large, 32);
+//
+//  assert(32 == ids.size());
+//  assert(1  == ta.numBlocksInUse());
+//..
+// Finally, we use a 'bdlc::InplaceVector' when the number of elements is known
+// never to exceed a fixed bound:
+//..
+//  bdlc::InplaceVector<int, 4> quad(&ta);
+//  quad.push_back(1);
+//  quad.push_back(2);
+//
+//  assert(2 == quad.size());
+//  assert(4 == quad.capacity());
+//  assert(1 == ta.numBlocksInUse());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_ARRAYDESTRUCTIONPRIMITIVES
+#include <bslalg_arraydestructionprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_ARRAYPRIMITIVES
+#include <bslalg_arrayprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_RANGECOMPARE
+#include <bslalg_rangecompare.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARDESTRUCTIONPRIMITIVES
+#include <bslalg_scalardestructionprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARPRIMITIVES
+#include <bslalg_scalarprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEALLOCATORPROCTOR
+#include <bslma_deallocatorproctor.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ASSERT
+#include <bslmf_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
+#include <bslmf_isbitwisemoveable.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNEDBUFFER
+#include <bsls_alignedbuffer.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTFROMTYPE
+#include <bsls_alignmentfromtype.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STDEXCEPTUTIL
+#include <bslstl_stdexceptutil.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                          // =======================
+                          // struct SmallVector_Util
+                          // =======================
+
+struct SmallVector_Util {
+    // This 'struct' provides a namespace for functions used in the
+    // implementation of 'SmallVector' that do not depend on its template
+    // parameters.
+
+    // CLASS METHODS
+    static bsl::size_t computeNewCapacity(bsl::size_t newLength,
+                                          bsl::size_t capacity,
+                                          bsl::size_t maxSize);
+        // Return a capacity at least the specified 'newLength' and at least
+        // the minimum of twice the specified 'capacity' and the specified
+        // 'maxSize'.  The behavior is undefined unless 'capacity < newLength'
+        // and 'newLength <= maxSize'.  Note that the returned value is always
+        // at most 'maxSize'.
+};
+
+                           // =======================
+                           // class InplaceVector_Imp
+                           // =======================
+
+template <class TYPE, int t_CAPACITY>
+class InplaceVector_Imp {
+    // This class provides suitably aligned, uninitialized storage for
+    // 't_CAPACITY' objects of the (template parameter) 'TYPE'.
+
+    // DATA
+    bsls::AlignedBuffer<t_CAPACITY * sizeof(TYPE),
+                        bsls::AlignmentFromType<TYPE>::VALUE> d_buffer;
+
+  public:
+    // MANIPULATORS
+    TYPE *data();
+        // Return the address of the first element of the storage.
+
+    // ACCESSORS
+    const TYPE *data() const;
+        // Return the address of the first element of the storage.
+};
+
+                            // ===================
+                            // class InplaceVector
+                            // ===================
+
+template <class TYPE, int t_CAPACITY>
+class InplaceVector {
+    // This class template provides a value-semantic sequence of up to
+    // 't_CAPACITY' objects of the (template parameter) 'TYPE', stored
+    // contiguously within the footprint of this object.  An in-place vector
+    // never allocates memory; the allocator supplied at construction is used
+    // only to supply memory to the elements, if 'TYPE' uses 'bslma'
+    // allocators.
+
+    BSLMF_ASSERT(0 < t_CAPACITY);
+
+    // DATA
+    InplaceVector_Imp<TYPE, t_CAPACITY>  d_storage;      // element storage
+
+    bsl::size_t                          d_length;       // number of
+                                                         // elements
+
+    bslma::Allocator                    *d_allocator_p;  // allocator for
+                                                         // elements (held, not
+                                                         // owned)
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(InplaceVector, bslma::UsesBslmaAllocator);
+    BSLMF_NESTED_TRAIT_DECLARATION_IF(InplaceVector,
+                                      bslmf::IsBitwiseMoveable,
+                                      bslmf::IsBitwiseMoveable<TYPE>::value);
+
+    // PUBLIC TYPES
+    typedef TYPE                value_type;
+    typedef TYPE&               reference;
+    typedef const TYPE&         const_reference;
+    typedef TYPE               *iterator;
+    typedef const TYPE         *const_iterator;
+    typedef bsl::size_t         size_type;
+    typedef bsl::ptrdiff_t      difference_type;
+
+    // CREATORS
+    explicit InplaceVector(bslma::Allocator *basicAllocator = 0);
+        // Create an empty in-place vector.  Optionally specify a
+        // 'basicAllocator' used to supply memory to the elements.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    InplaceVector(size_type         numElements,
+                  const TYPE&       value,
+                  bslma::Allocator *basicAllocator = 0);
+        // Create an in-place vector having the specified 'numElements' copies
+        // of the specified 'value'.  Optionally specify a 'basicAllocator'
+        // used to supply memory to the elements.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless 'numElements <= t_CAPACITY'.
+
+    InplaceVector(const InplaceVector&  original,
+                  bslma::Allocator     *basicAllocator = 0);
+        // Create an in-place vector having the same value as the specified
+        // 'original' object.  Optionally specify a 'basicAllocator' used to
+        // supply memory to the elements.  If 'basicAllocator' is 0, the
+        // currently installed default allocator is used.
+
+    ~InplaceVector();
+        // Destroy this object.
+
+    // MANIPULATORS
+    InplaceVector& operator=(const InplaceVector& rhs);
+        // Assign to this object the value of the specified 'rhs' object, and
+        // return a reference providing modifiable access to this object.
+
+    reference operator[](size_type position);
+        // Return a reference providing modifiable access to the element at
+        // the specified 'position' in this vector.  The behavior is undefined
+        // unless 'position < size()'.
+
+    iterator begin();
+        // Return an iterator providing modifiable access to the first element
+        // in this vector, or the past-the-end iterator if this vector is
+        // empty.
+
+    iterator end();
+        // Return the past-the-end iterator providing modifiable access to this
+        // vector.
+
+    reference front();
+        // Return a reference providing modifiable access to the first element
+        // in this vector.  The behavior is undefined unless this vector is not
+        // empty.
+
+    reference back();
+        // Return a reference providing modifiable access to the last element
+        // in this vector.  The behavior is undefined unless this vector is not
+        // empty.
+
+    TYPE *data();
+        // Return the address of the first element of this vector.
+
+    void clear();
+        // Destroy all the elements of this vector, leaving it empty.
+
+    iterator erase(const_iterator position);
+        // Remove from this vector the element at the specified 'position',
+        // and return an iterator providing modifiable access to the element
+        // immediately following the removed element, or 'end()' if the
+        // removed element was the last.  The behavior is undefined unless
+        // 'position' is a valid, dereferenceable iterator into this vector.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove from this vector the elements starting at the specified
+        // 'first' position up to, but not including, the specified 'last'
+        // position, and return an iterator providing modifiable access to the
+        // element at 'last' before the removal.  The behavior is undefined
+        // unless '[first .. last)' is a valid range within this vector.
+
+    iterator insert(const_iterator position, const TYPE& value);
+        // Insert a copy of the specified 'value' into this vector at the
+        // specified 'position', and return an iterator to the inserted
+        // element.  The behavior is undefined unless 'position' is in the
+        // range '[begin() .. end()]' and 'size() < t_CAPACITY'.
+
+    void insert(const_iterator    position,
+                size_type         numElements,
+                const TYPE&       value);
+        // Insert the specified 'numElements' copies of the specified 'value'
+        // into this vector at the specified 'position'.  The behavior is
+        // undefined unless 'position' is in the range '[begin() .. end()]'
+        // and 'size() + numElements <= t_CAPACITY'.
+
+    void pop_back();
+        // Destroy the last element of this vector.  The behavior is undefined
+        // unless this vector is not empty.
+
+    void push_back(const TYPE& value);
+        // Append a copy of the specified 'value' to this vector.  The
+        // behavior is undefined unless 'size() < t_CAPACITY'.
+
+    void resize(size_type newLength);
+    void resize(size_type newLength, const TYPE& value);
+        // Change the length of this vector to the specified 'newLength',
+        // either erasing elements at the end if 'newLength < size()', or
+        // appending the appropriate number of default-constructed elements
+        // (or copies of the optionally specified 'value') if
+        // 'size() < newLength'.  The behavior is undefined unless
+        // 'newLength <= t_CAPACITY'.
+
+    // ACCESSORS
+    const_reference operator[](size_type position) const;
+        // Return a reference providing non-modifiable access to the element at
+        // the specified 'position' in this vector.  The behavior is undefined
+        // unless 'position < size()'.
+
+    const_iterator begin() const;
+        // Return an iterator providing non-modifiable access to the first
+        // element in this vector, or the past-the-end iterator if this vector
+        // is empty.
+
+    const_iterator end() const;
+        // Return the past-the-end iterator providing non-modifiable access to
+        // this vector.
+
+    const_reference front() const;
+        // Return a reference providing non-modifiable access to the first
+        // element in this vector.  The behavior is undefined unless this
+        // vector is not empty.
+
+    const_reference back() const;
+        // Return a reference providing non-modifiable access to the last
+        // element in this vector.  The behavior is undefined unless this
+        // vector is not empty.
+
+    const TYPE *data() const;
+        // Return the address of the first element of this vector.
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this vector to supply memory to its
+        // elements.
+
+    size_type capacity() const;
+        // Return 't_CAPACITY'.
+
+    bool empty() const;
+        // Return 'true' if this vector has no elements, and 'false' otherwise.
+
+    bool full() const;
+        // Return 'true' if the length of this vector is 't_CAPACITY', and
+        // 'false' otherwise.
+
+    size_type max_size() const;
+        // Return 't_CAPACITY'.
+
+    size_type size() const;
+        // Return the number of elements in this vector.
+};
+
+// FREE OPERATORS
+template <class TYPE, int t_CAPACITY>
+bool operator==(const InplaceVector<TYPE, t_CAPACITY>& lhs,
+                const InplaceVector<TYPE, t_CAPACITY>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'InplaceVector' objects have the same
+    // value if they have the same length, and each element in 'lhs' compares
+    // equal to the corresponding element in 'rhs'.
+
+template <class TYPE, int t_CAPACITY>
+bool operator!=(const InplaceVector<TYPE, t_CAPACITY>& lhs,
+                const InplaceVector<TYPE, t_CAPACITY>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'InplaceVector' objects do not
+    // have the same value if they do not have the same length, or some
+    // element in 'lhs' does not compare equal to the corresponding element in
+    // 'rhs'.
+
+                             // =================
+                             // class SmallVector
+                             // =================
+
+template <class TYPE, int t_CAPACITY>
+class SmallVector {
+    // This class template provides a value-semantic, dynamically-sized
+    // sequence of objects of the (template parameter) 'TYPE', stored
+    // contiguously.  The first 't_CAPACITY' elements are stored within the
+    // footprint of this object; when the vector grows beyond that capacity,
+    // its elements are moved to memory supplied by the allocator held by this
+    // object.
+
+    BSLMF_ASSERT(0 < t_CAPACITY);
+
+    // DATA
+    TYPE                                *d_data_p;       // address of first
+                                                         // element (either
+                                                         // 'd_storage' or
+                                                         // allocated)
+
+    bsl::size_t                          d_length;       // number of
+                                                         // elements
+
+    bsl::size_t                          d_capacity;     // capacity of the
+                                                         // block at 'd_data_p'
+
+    InplaceVector_Imp<TYPE, t_CAPACITY>  d_storage;      // in-place storage
+
+    bslma::Allocator                    *d_allocator_p;  // allocator (held,
+                                                         // not owned)
+
+    // PRIVATE MANIPULATORS
+    TYPE *privateAllocate(bsl::size_t numElements);
+        // Return the address of a newly-allocated block of memory suitable
+        // for 'numElements' objects of 'TYPE'.
+
+    void privateDeallocate();
+        // Return the block at 'd_data_p' to the allocator, unless it is the
+        // in-place storage of this object.
+
+    void privateGrow(bsl::size_t newLength);
+        // Move the elements of this vector to a newly allocated block having
+        // a capacity of at least the specified 'newLength'.  The behavior is
+        // undefined unless 'capacity() < newLength'.
+
+    // PRIVATE ACCESSORS
+    bool isInplace() const;
+        // Return 'true' if the elements of this vector reside in its in-place
+        // storage, and 'false' otherwise.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(SmallVector, bslma::UsesBslmaAllocator);
+
+    // PUBLIC TYPES
+    typedef TYPE                value_type;
+    typedef TYPE&               reference;
+    typedef const TYPE&         const_reference;
+    typedef TYPE               *iterator;
+    typedef const TYPE         *const_iterator;
+    typedef bsl::size_t         size_type;
+    typedef bsl::ptrdiff_t      difference_type;
+
+    // CREATORS
+    explicit SmallVector(bslma::Allocator *basicAllocator = 0);
+        // Create an empty small vector having a capacity of 't_CAPACITY'.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    SmallVector(size_type         numElements,
+                const TYPE&       value,
+                bslma::Allocator *basicAllocator = 0);
+        // Create a small vector having the specified 'numElements' copies of
+        // the specified 'value'.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    SmallVector(const SmallVector&  original,
+                bslma::Allocator   *basicAllocator = 0);
+        // Create a small vector having the same value as the specified
+        // 'original' object.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    ~SmallVector();
+        // Destroy this object.
+
+    // MANIPULATORS
+    SmallVector& operator=(const SmallVector& rhs);
+        // Assign to this object the value of the specified 'rhs' object, and
+        // return a reference providing modifiable access to this object.
+
+    reference operator[](size_type position);
+        // Return a reference providing modifiable access to the element at
+        // the specified 'position' in this vector.  The behavior is undefined
+        // unless 'position < size()'.
+
+    iterator begin();
+        // Return an iterator providing modifiable access to the first element
+        // in this vector, or the past-the-end iterator if this vector is
+        // empty.
+
+    iterator end();
+        // Return the past-the-end iterator providing modifiable access to this
+        // vector.
+
+    reference front();
+        // Return a reference providing modifiable access to the first element
+        // in this vector.  The behavior is undefined unless this vector is not
+        // empty.
+
+    reference back();
+        // Return a reference providing modifiable access to the last element
+        // in this vector.  The behavior is undefined unless this vector is not
+        // empty.
+
+    TYPE *data();
+        // Return the address of the first element of this vector.
+
+    void clear();
+        // Destroy all the elements of this vector, leaving it empty.  Note
+        // that the capacity of this vector is not affected.
+
+    iterator erase(const_iterator position);
+        // Remove from this vector the element at the specified 'position',
+        // and return an iterator providing modifiable access to the element
+        // immediately following the removed element, or 'end()' if the
+        // removed element was the last.  The behavior is undefined unless
+        // 'position' is a valid, dereferenceable iterator into this vector.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove from this vector the elements starting at the specified
+        // 'first' position up to, but not including, the specified 'last'
+        // position, and return an iterator providing modifiable access to the
+        // element at 'last' before the removal.  The behavior is undefined
+        // unless '[first .. last)' is a valid range within this vector.
+
+    iterator insert(const_iterator position, const TYPE& value);
+        // Insert a copy of the specified 'value' into this vector at the
+        // specified 'position', and return an iterator to the inserted
+        // element.  Throw 'bsl::length_error' if the resulting length would
+        // exceed 'max_size()'.  The behavior is undefined unless 'position'
+        // is in the range '[begin() .. end()]'.
+
+    void insert(const_iterator    position,
+                size_type         numElements,
+                const TYPE&       value);
+        // Insert the specified 'numElements' copies of the specified 'value'
+        // into this vector at the specified 'position'.  Throw
+        // 'bsl::length_error' if the resulting length would exceed
+        // 'max_size()'.  The behavior is undefined unless 'position' is in
+        // the range '[begin() .. end()]'.
+
+    void pop_back();
+        // Destroy the last element of this vector.  The behavior is undefined
+        // unless this vector is not empty.
+
+    void push_back(const TYPE& value);
+        // Append a copy of the specified 'value' to this vector.  Throw
+        // 'bsl::length_error' if 'size() == max_size()'.
+
+    void reserve(size_type newCapacity);
+        // Change the capacity of this vector to at least the specified
+        // 'newCapacity'.  Throw 'bsl::length_error' if
+        // 'newCapacity > max_size()'.  Note that the capacity of this vector
+        // is never less than 't_CAPACITY'.
+
+    void resize(size_type newLength);
+    void resize(size_type newLength, const TYPE& value);
+        // Change the length of this vector to the specified 'newLength',
+        // either erasing elements at the end if 'newLength < size()', or
+        // appending the appropriate number of default-constructed elements
+        // (or copies of the optionally specified 'value') if
+        // 'size() < newLength'.  Throw 'bsl::length_error' if
+        // 'newLength > max_size()'.
+
+    void shrink_to_fit();
+        // Reduce the capacity of this vector to the larger of its length and
+        // 't_CAPACITY', moving the elements back to the in-place storage if
+        // they fit.
+
+    // ACCESSORS
+    const_reference operator[](size_type position) const;
+        // Return a reference providing non-modifiable access to the element at
+        // the specified 'position' in this vector.  The behavior is undefined
+        // unless 'position < size()'.
+
+    const_iterator begin() const;
+        // Return an iterator providing non-modifiable access to the first
+        // element in this vector, or the past-the-end iterator if this vector
+        // is empty.
+
+    const_iterator end() const;
+        // Return the past-the-end iterator providing non-modifiable access to
+        // this vector.
+
+    const_reference front() const;
+        // Return a reference providing non-modifiable access to the first
+        // element in this vector.  The behavior is undefined unless this
+        // vector is not empty.
+
+    const_reference back() const;
+        // Return a reference providing non-modifiable access to the last
+        // element in this vector.  The behavior is undefined unless this
+        // vector is not empty.
+
+    const TYPE *data() const;
+        // Return the address of the first element of this vector.
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this vector to supply memory.
+
+    size_type capacity() const;
+        // Return the number of elements this vector can hold without
+        // allocating memory.  Note that the returned value is never less than
+        // 't_CAPACITY'.
+
+    bool empty() const;
+        // Return 'true' if this vector has no elements, and 'false' otherwise.
+
+    size_type max_size() const;
+        // Return the theoretical maximum number of elements this vector can
+        // hold.
+
+    size_type size() const;
+        // Return the number of elements in this vector.
+};
+
+// FREE OPERATORS
+template <class TYPE, int t_CAPACITY>
+bool operator==(const SmallVector<TYPE, t_CAPACITY>& lhs,
+                const SmallVector<TYPE, t_CAPACITY>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'SmallVector' objects have the same
+    // value if they have the same length, and each element in 'lhs' compares
+    // equal to the corresponding element in 'rhs'.
+
+template <class TYPE, int t_CAPACITY>
+bool operator!=(const SmallVector<TYPE, t_CAPACITY>& lhs,
+                const SmallVector<TYPE, t_CAPACITY>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'SmallVector' objects do not
+    // have the same value if they do not have the same length, or some
+    // element in 'lhs' does not compare equal to the corresponding element in
+    // 'rhs'.
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                           // -----------------------
+                           // class InplaceVector_Imp
+                           // -----------------------
+
+// MANIPULATORS
+template <class TYPE, int t_CAPACITY>
+inline
+TYPE *InplaceVector_Imp<TYPE, t_CAPACITY>::data()
+{
+    return reinterpret_cast<TYPE *>(d_buffer.buffer());
+}
+
+// ACCESSORS
+template <class TYPE, int t_CAPACITY>
+inline
+const TYPE *InplaceVector_Imp<TYPE, t_CAPACITY>::data() const
+{
+    return reinterpret_cast<const TYPE *>(d_buffer.buffer());
+}
+
+                            // -------------------
+                            // class InplaceVector
+                            // -------------------
+
+// CREATORS
+template <class TYPE, int t_CAPACITY>
+inline
+InplaceVector<TYPE, t_CAPACITY>::InplaceVector(
+                                              bslma::Allocator *basicAllocator)
+: d_length(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class TYPE, int t_CAPACITY>
+InplaceVector<TYPE, t_CAPACITY>::InplaceVector(
+                                            size_type         numElements,
+                                            const TYPE&       value,
+                                            bslma::Allocator *basicAllocator)
+: d_length(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT_SAFE(numElements <= static_cast<size_type>(t_CAPACITY));
+
+    bslalg::ArrayPrimitives::uninitializedFillN(d_storage.data(),
+                                                numElements,
+                                                value,
+                                                d_allocator_p);
+    d_length = numElements;
+}
+
+template <class TYPE, int t_CAPACITY>
+InplaceVector<TYPE, t_CAPACITY>::InplaceVector(
+                                          const InplaceVector&  original,
+                                          bslma::Allocator     *basicAllocator)
+: d_length(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    bslalg::ArrayPrimitives::copyConstruct(d_storage.data(),
+                                           original.begin(),
+                                           original.end(),
+                                           d_allocator_p);
+    d_length = original.d_length;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+InplaceVector<TYPE, t_CAPACITY>::~InplaceVector()
+{
+    BSLS_ASSERT(d_length <= static_cast<size_type>(t_CAPACITY));
+
+    bslalg::ArrayDestructionPrimitives::destroy(begin(), end());
+}
+
+// MANIPULATORS
+template <class TYPE, int t_CAPACITY>
+InplaceVector<TYPE, t_CAPACITY>&
+InplaceVector<TYPE, t_CAPACITY>::operator=(const InplaceVector& rhs)
+{
+    if (this != &rhs) {
+        clear();
+        bslalg::ArrayPrimitives::copyConstruct(d_storage.data(),
+                                               rhs.begin(),
+                                               rhs.end(),
+                                               d_allocator_p);
+        d_length = rhs.d_length;
+    }
+    return *this;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::reference
+InplaceVector<TYPE, t_CAPACITY>::operator[](size_type position)
+{
+    BSLS_ASSERT_SAFE(position < d_length);
+
+    return d_storage.data()[position];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::iterator
+InplaceVector<TYPE, t_CAPACITY>::begin()
+{
+    return d_storage.data();
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::iterator
+InplaceVector<TYPE, t_CAPACITY>::end()
+{
+    return d_storage.data() + d_length;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::reference
+InplaceVector<TYPE, t_CAPACITY>::front()
+{
+    BSLS_ASSERT_SAFE(0 < d_length);
+
+    return d_storage.data()[0];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::reference
+InplaceVector<TYPE, t_CAPACITY>::back()
+{
+    BSLS_ASSERT_SAFE(0 < d_length);
+
+    return d_storage.data()[d_length - 1];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+TYPE *InplaceVector<TYPE, t_CAPACITY>::data()
+{
+    return d_storage.data();
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+void InplaceVector<TYPE, t_CAPACITY>::clear()
+{
+    bslalg::ArrayDestructionPrimitives::destroy(begin(), end());
+    d_length = 0;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::iterator
+InplaceVector<TYPE, t_CAPACITY>::erase(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(begin() <= position);
+    BSLS_ASSERT_SAFE(position < end());
+
+    return erase(position, position + 1);
+}
+
+template <class TYPE, int t_CAPACITY>
+typename InplaceVector<TYPE, t_CAPACITY>::iterator
+InplaceVector<TYPE, t_CAPACITY>::erase(const_iterator first,
+                                       const_iterator last)
+{
+    BSLS_ASSERT_SAFE(begin() <= first);
+    BSLS_ASSERT_SAFE(first   <= last);
+    BSLS_ASSERT_SAFE(last    <= end());
+
+    iterator        from = const_cast<iterator>(first);
+    const size_type n    = last - first;
+
+    bslalg::ArrayPrimitives::erase(from,
+                                   const_cast<iterator>(last),
+                                   end(),
+                                   d_allocator_p);
+    d_length -= n;
+    return from;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::iterator
+InplaceVector<TYPE, t_CAPACITY>::insert(const_iterator position,
+                                        const TYPE&    value)
+{
+    const size_type index = position - begin();
+    insert(position, 1, value);
+    return begin() + index;
+}
+
+template <class TYPE, int t_CAPACITY>
+void InplaceVector<TYPE, t_CAPACITY>::insert(const_iterator position,
+                                             size_type      numElements,
+                                             const TYPE&    value)
+{
+    BSLS_ASSERT_SAFE(begin() <= position);
+    BSLS_ASSERT_SAFE(position <= end());
+    BSLS_ASSERT_SAFE(numElements <= t_CAPACITY - d_length);
+
+    bslalg::ArrayPrimitives::insert(const_cast<iterator>(position),
+                                    end(),
+                                    value,
+                                    numElements,
+                                    d_allocator_p);
+    d_length += numElements;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+void InplaceVector<TYPE, t_CAPACITY>::pop_back()
+{
+    BSLS_ASSERT_SAFE(0 < d_length);
+
+    bslalg::ScalarDestructionPrimitives::destroy(d_storage.data()
+                                                 + --d_length);
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+void InplaceVector<TYPE, t_CAPACITY>::push_back(const TYPE& value)
+{
+    BSLS_ASSERT_SAFE(d_length < static_cast<size_type>(t_CAPACITY));
+
+    bslalg::ScalarPrimitives::copyConstruct(d_storage.data() + d_length,
+                                            value,
+                                            d_allocator_p);
+    ++d_length;
+}
+
+template <class TYPE, int t_CAPACITY>
+void InplaceVector<TYPE, t_CAPACITY>::resize(size_type newLength)
+{
+    BSLS_ASSERT_SAFE(newLength <= static_cast<size_type>(t_CAPACITY));
+
+    if (newLength <= d_length) {
+        bslalg::ArrayDestructionPrimitives::destroy(begin() + newLength,
+                                                    end());
+    }
+    else {
+        bslalg::ArrayPrimitives::defaultConstruct(end(),
+                                                  newLength - d_length,
+                                                  d_allocator_p);
+    }
+    d_length = newLength;
+}
+
+template <class TYPE, int t_CAPACITY>
+void InplaceVector<TYPE, t_CAPACITY>::resize(size_type   newLength,
+                                             const TYPE& value)
+{
+    BSLS_ASSERT_SAFE(newLength <= static_cast<size_type>(t_CAPACITY));
+
+    if (newLength <= d_length) {
+        bslalg::ArrayDestructionPrimitives::destroy(begin() + newLength,
+                                                    end());
+        d_length = newLength;
+    }
+    else {
+        insert(end(), newLength - d_length, value);
+    }
+}
+
+// ACCESSORS
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::const_reference
+InplaceVector<TYPE, t_CAPACITY>::operator[](size_type position) const
+{
+    BSLS_ASSERT_SAFE(position < d_length);
+
+    return d_storage.data()[position];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::const_iterator
+InplaceVector<TYPE, t_CAPACITY>::begin() const
+{
+    return d_storage.data();
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::const_iterator
+InplaceVector<TYPE, t_CAPACITY>::end() const
+{
+    return d_storage.data() + d_length;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::const_reference
+InplaceVector<TYPE, t_CAPACITY>::front() const
+{
+    BSLS_ASSERT_SAFE(0 < d_length);
+
+    return d_storage.data()[0];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::const_reference
+InplaceVector<TYPE, t_CAPACITY>::back() const
+{
+    BSLS_ASSERT_SAFE(0 < d_length);
+
+    return d_storage.data()[d_length - 1];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+const TYPE *InplaceVector<TYPE, t_CAPACITY>::data() const
+{
+    return d_storage.data();
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+bslma::Allocator *InplaceVector<TYPE, t_CAPACITY>::allocator() const
+{
+    return d_allocator_p;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::size_type
+InplaceVector<TYPE, t_CAPACITY>::capacity() const
+{
+    return t_CAPACITY;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+bool InplaceVector<TYPE, t_CAPACITY>::empty() const
+{
+    return 0 == d_length;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+bool InplaceVector<TYPE, t_CAPACITY>::full() const
+{
+    return static_cast<size_type>(t_CAPACITY) == d_length;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::size_type
+InplaceVector<TYPE, t_CAPACITY>::max_size() const
+{
+    return t_CAPACITY;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename InplaceVector<TYPE, t_CAPACITY>::size_type
+InplaceVector<TYPE, t_CAPACITY>::size() const
+{
+    return d_length;
+}
+
+// FREE OPERATORS
+template <class TYPE, int t_CAPACITY>
+inline
+bool operator==(const InplaceVector<TYPE, t_CAPACITY>& lhs,
+                const InplaceVector<TYPE, t_CAPACITY>& rhs)
+{
+    return bslalg::RangeCompare::equal(lhs.begin(),
+                                       lhs.end(),
+                                       lhs.size(),
+                                       rhs.begin(),
+                                       rhs.end(),
+                                       rhs.size());
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+bool operator!=(const InplaceVector<TYPE, t_CAPACITY>& lhs,
+                const InplaceVector<TYPE, t_CAPACITY>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+                             // -----------------
+                             // class SmallVector
+                             // -----------------
+
+// PRIVATE MANIPULATORS
+template <class TYPE, int t_CAPACITY>
+inline
+TYPE *SmallVector<TYPE, t_CAPACITY>::privateAllocate(bsl::size_t numElements)
+{
+    return static_cast<TYPE *>(
+                          d_allocator_p->allocate(numElements * sizeof(TYPE)));
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+void SmallVector<TYPE, t_CAPACITY>::privateDeallocate()
+{
+    if (!isInplace()) {
+        d_allocator_p->deallocate(d_data_p);
+    }
+}
+
+template <class TYPE, int t_CAPACITY>
+void SmallVector<TYPE, t_CAPACITY>::privateGrow(bsl::size_t newLength)
+{
+    BSLS_ASSERT_SAFE(d_capacity < newLength);
+
+    const bsl::size_t newCapacity = SmallVector_Util::computeNewCapacity(
+                                                                   newLength,
+                                                                   d_capacity,
+                                                                   max_size());
+
+    TYPE *newData = privateAllocate(newCapacity);
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(newData,
+                                                        d_allocator_p);
+
+    bslalg::ArrayPrimitives::destructiveMove(newData,
+                                             d_data_p,
+                                             d_data_p + d_length,
+                                             d_allocator_p);
+    proctor.release();
+
+    privateDeallocate();
+    d_data_p   = newData;
+    d_capacity = newCapacity;
+}
+
+// PRIVATE ACCESSORS
+template <class TYPE, int t_CAPACITY>
+inline
+bool SmallVector<TYPE, t_CAPACITY>::isInplace() const
+{
+    return d_data_p == d_storage.data();
+}
+
+// CREATORS
+template <class TYPE, int t_CAPACITY>
+inline
+SmallVector<TYPE, t_CAPACITY>::SmallVector(bslma::Allocator *basicAllocator)
+: d_length(0)
+, d_capacity(t_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    d_data_p = d_storage.data();
+}
+
+template <class TYPE, int t_CAPACITY>
+SmallVector<TYPE, t_CAPACITY>::SmallVector(size_type         numElements,
+                                           const TYPE&       value,
+                                           bslma::Allocator *basicAllocator)
+: d_length(0)
+, d_capacity(t_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    d_data_p = d_storage.data();
+    insert(begin(), numElements, value);
+}
+
+template <class TYPE, int t_CAPACITY>
+SmallVector<TYPE, t_CAPACITY>::SmallVector(
+                                            const SmallVector&  original,
+                                            bslma::Allocator   *basicAllocator)
+: d_length(0)
+, d_capacity(t_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    d_data_p = d_storage.data();
+    if (original.d_length > d_capacity) {
+        d_data_p   = privateAllocate(original.d_length);
+        d_capacity = original.d_length;
+    }
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(
+                                         isInplace() ? 0 : d_data_p,
+                                         d_allocator_p);
+
+    bslalg::ArrayPrimitives::copyConstruct(d_data_p,
+                                           original.begin(),
+                                           original.end(),
+                                           d_allocator_p);
+    proctor.release();
+    d_length = original.d_length;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+SmallVector<TYPE, t_CAPACITY>::~SmallVector()
+{
+    BSLS_ASSERT(d_length <= d_capacity);
+
+    bslalg::ArrayDestructionPrimitives::destroy(begin(), end());
+    privateDeallocate();
+}
+
+// MANIPULATORS
+template <class TYPE, int t_CAPACITY>
+SmallVector<TYPE, t_CAPACITY>&
+SmallVector<TYPE, t_CAPACITY>::operator=(const SmallVector& rhs)
+{
+    if (this != &rhs) {
+        clear();
+        if (rhs.d_length > d_capacity) {
+            privateGrow(rhs.d_length);
+        }
+        bslalg::ArrayPrimitives::copyConstruct(d_data_p,
+                                               rhs.begin(),
+                                               rhs.end(),
+                                               d_allocator_p);
+        d_length = rhs.d_length;
+    }
+    return *this;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::reference
+SmallVector<TYPE, t_CAPACITY>::operator[](size_type position)
+{
+    BSLS_ASSERT_SAFE(position < d_length);
+
+    return d_data_p[position];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::iterator
+SmallVector<TYPE, t_CAPACITY>::begin()
+{
+    return d_data_p;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::iterator
+SmallVector<TYPE, t_CAPACITY>::end()
+{
+    return d_data_p + d_length;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::reference
+SmallVector<TYPE, t_CAPACITY>::front()
+{
+    BSLS_ASSERT_SAFE(0 < d_length);
+
+    return d_data_p[0];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::reference
+SmallVector<TYPE, t_CAPACITY>::back()
+{
+    BSLS_ASSERT_SAFE(0 < d_length);
+
+    return d_data_p[d_length - 1];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+TYPE *SmallVector<TYPE, t_CAPACITY>::data()
+{
+    return d_data_p;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+void SmallVector<TYPE, t_CAPACITY>::clear()
+{
+    bslalg::ArrayDestructionPrimitives::destroy(begin(), end());
+    d_length = 0;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::iterator
+SmallVector<TYPE, t_CAPACITY>::erase(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(begin() <= position);
+    BSLS_ASSERT_SAFE(position < end());
+
+    return erase(position, position + 1);
+}
+
+template <class TYPE, int t_CAPACITY>
+typename SmallVector<TYPE, t_CAPACITY>::iterator
+SmallVector<TYPE, t_CAPACITY>::erase(const_iterator first, const_iterator last)
+{
+    BSLS_ASSERT_SAFE(begin() <= first);
+    BSLS_ASSERT_SAFE(first   <= last);
+    BSLS_ASSERT_SAFE(last    <= end());
+
+    iterator        from = const_cast<iterator>(first);
+    const size_type n    = last - first;
+
+    bslalg::ArrayPrimitives::erase(from,
+                                   const_cast<iterator>(last),
+                                   end(),
+                                   d_allocator_p);
+    d_length -= n;
+    return from;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::iterator
+SmallVector<TYPE, t_CAPACITY>::insert(const_iterator position,
+                                      const TYPE&    value)
+{
+    const size_type index = position - begin();
+    insert(position, 1, value);
+    return begin() + index;
+}
+
+template <class TYPE, int t_CAPACITY>
+void SmallVector<TYPE, t_CAPACITY>::insert(const_iterator position,
+                                           size_type      numElements,
+                                           const TYPE&    value)
+{
+    BSLS_ASSERT_SAFE(begin() <= position);
+    BSLS_ASSERT_SAFE(position <= end());
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                    numElements > max_size() - d_length)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwLengthError(
+                    "SmallVector<...>::insert(pos,n,v): vector too long");
+    }
+
+    iterator        pos       = const_cast<iterator>(position);
+    const size_type newLength = d_length + numElements;
+
+    if (newLength <= d_capacity) {
+        bslalg::ArrayPrimitives::insert(pos,
+                                        end(),
+                                        value,
+                                        numElements,
+                                        d_allocator_p);
+        d_length = newLength;
+        return;                                                       // RETURN
+    }
+
+    // Move the elements to a new block, inserting the new elements in the
+    // process, so that 'value' remains valid even if it refers to an element
+    // of this vector.
+
+    const bsl::size_t newCapacity = SmallVector_Util::computeNewCapacity(
+                                                                   newLength,
+                                                                   d_capacity,
+                                                                   max_size());
+
+    TYPE *newData = privateAllocate(newCapacity);
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(newData,
+                                                        d_allocator_p);
+
+    TYPE *oldEnd = end();
+    bslalg::ArrayPrimitives::destructiveMoveAndInsert(newData,
+                                                      &oldEnd,
+                                                      d_data_p,
+                                                      pos,
+                                                      oldEnd,
+                                                      value,
+                                                      numElements,
+                                                      d_allocator_p);
+    proctor.release();
+
+    privateDeallocate();
+    d_data_p   = newData;
+    d_length   = newLength;
+    d_capacity = newCapacity;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+void SmallVector<TYPE, t_CAPACITY>::pop_back()
+{
+    BSLS_ASSERT_SAFE(0 < d_length);
+
+    bslalg::ScalarDestructionPrimitives::destroy(d_data_p + --d_length);
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+void SmallVector<TYPE, t_CAPACITY>::push_back(const TYPE& value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(d_length < d_capacity)) {
+        bslalg::ScalarPrimitives::copyConstruct(d_data_p + d_length,
+                                                value,
+                                                d_allocator_p);
+        ++d_length;
+    }
+    else {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        insert(end(), 1, value);
+    }
+}
+
+template <class TYPE, int t_CAPACITY>
+void SmallVector<TYPE, t_CAPACITY>::reserve(size_type newCapacity)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(newCapacity > max_size())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwLengthError(
+                    "SmallVector<...>::reserve(newCapacity): vector too long");
+    }
+
+    if (newCapacity > d_capacity) {
+        TYPE *newData = privateAllocate(newCapacity);
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(newData,
+                                                            d_allocator_p);
+
+        bslalg::ArrayPrimitives::destructiveMove(newData,
+                                                 begin(),
+                                                 end(),
+                                                 d_allocator_p);
+        proctor.release();
+
+        privateDeallocate();
+        d_data_p   = newData;
+        d_capacity = newCapacity;
+    }
+}
+
+template <class TYPE, int t_CAPACITY>
+void SmallVector<TYPE, t_CAPACITY>::resize(size_type newLength)
+{
+    if (newLength <= d_length) {
+        bslalg::ArrayDestructionPrimitives::destroy(begin() + newLength,
+                                                    end());
+    }
+    else {
+        if (newLength > d_capacity) {
+            if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(newLength > max_size())) {
+                BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+                bslstl::StdExceptUtil::throwLengthError(
+                          "SmallVector<...>::resize(n): vector too long");
+            }
+            privateGrow(newLength);
+        }
+        bslalg::ArrayPrimitives::defaultConstruct(end(),
+                                                  newLength - d_length,
+                                                  d_allocator_p);
+    }
+    d_length = newLength;
+}
+
+template <class TYPE, int t_CAPACITY>
+void SmallVector<TYPE, t_CAPACITY>::resize(size_type   newLength,
+                                           const TYPE& value)
+{
+    if (newLength <= d_length) {
+        bslalg::ArrayDestructionPrimitives::destroy(begin() + newLength,
+                                                    end());
+        d_length = newLength;
+    }
+    else {
+        insert(end(), newLength - d_length, value);
+    }
+}
+
+template <class TYPE, int t_CAPACITY>
+void SmallVector<TYPE, t_CAPACITY>::shrink_to_fit()
+{
+    if (isInplace() || d_length == d_capacity) {
+        return;                                                       // RETURN
+    }
+
+    TYPE        *newData;
+    bsl::size_t  newCapacity;
+
+    if (d_length <= static_cast<size_type>(t_CAPACITY)) {
+        newData     = d_storage.data();
+        newCapacity = t_CAPACITY;
+        bslalg::ArrayPrimitives::destructiveMove(newData,
+                                                 begin(),
+                                                 end(),
+                                                 d_allocator_p);
+    }
+    else {
+        newData     = privateAllocate(d_length);
+        newCapacity = d_length;
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(newData,
+                                                            d_allocator_p);
+
+        bslalg::ArrayPrimitives::destructiveMove(newData,
+                                                 begin(),
+                                                 end(),
+                                                 d_allocator_p);
+        proctor.release();
+    }
+
+    privateDeallocate();
+    d_data_p   = newData;
+    d_capacity = newCapacity;
+}
+
+// ACCESSORS
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::const_reference
+SmallVector<TYPE, t_CAPACITY>::operator[](size_type position) const
+{
+    BSLS_ASSERT_SAFE(position < d_length);
+
+    return d_data_p[position];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::const_iterator
+SmallVector<TYPE, t_CAPACITY>::begin() const
+{
+    return d_data_p;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::const_iterator
+SmallVector<TYPE, t_CAPACITY>::end() const
+{
+    return d_data_p + d_length;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::const_reference
+SmallVector<TYPE, t_CAPACITY>::front() const
+{
+    BSLS_ASSERT_SAFE(0 < d_length);
+
+    return d_data_p[0];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::const_reference
+SmallVector<TYPE, t_CAPACITY>::back() const
+{
+    BSLS_ASSERT_SAFE(0 < d_length);
+
+    return d_data_p[d_length - 1];
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+const TYPE *SmallVector<TYPE, t_CAPACITY>::data() const
+{
+    return d_data_p;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+bslma::Allocator *SmallVector<TYPE, t_CAPACITY>::allocator() const
+{
+    return d_allocator_p;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::size_type
+SmallVector<TYPE, t_CAPACITY>::capacity() const
+{
+    return d_capacity;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+bool SmallVector<TYPE, t_CAPACITY>::empty() const
+{
+    return 0 == d_length;
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::size_type
+SmallVector<TYPE, t_CAPACITY>::max_size() const
+{
+    return ~static_cast<size_type>(0) / sizeof(TYPE);
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+typename SmallVector<TYPE, t_CAPACITY>::size_type
+SmallVector<TYPE, t_CAPACITY>::size() const
+{
+    return d_length;
+}
+
+// FREE OPERATORS
+template <class TYPE, int t_CAPACITY>
+inline
+bool operator==(const SmallVector<TYPE, t_CAPACITY>& lhs,
+                const SmallVector<TYPE, t_CAPACITY>& rhs)
+{
+    return bslalg::RangeCompare::equal(lhs.begin(),
+                                       lhs.end(),
+                                       lhs.size(),
+                                       rhs.begin(),
+                                       rhs.end(),
+                                       rhs.size());
+}
+
+template <class TYPE, int t_CAPACITY>
+inline
+bool operator!=(const SmallVector<TYPE, t_CAPACITY>& lhs,
+                const SmallVector<TYPE, t_CAPACITY>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1072 @@
+// bdlc_smallvector.t.cpp                                             -*-C++-*-
+#include <bdlc_smallvector.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_isbitwisemoveable.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test provides two vector-like class templates whose
+// element storage is (at least initially) embedded in the object.  The primary
+// concerns are that elements are correctly constructed, relocated, and
+// destroyed through 'bslalg::ArrayPrimitives', that 'SmallVector' allocates
+// memory only when its length exceeds its in-place capacity, and that
+// 'InplaceVector' never allocates.  We use 'bslma::TestAllocator' to verify
+// the memory behavior, an element type that records its own address to verify
+// that non-bitwise-moveable types are never relocated with 'memcpy', and
+// 'bsl::string' to verify that the allocator is propagated to the elements.
+//-----------------------------------------------------------------------------
+// SmallVector
+// [ 2] SmallVector(bslma::Allocator *ba = 0);
+// [ 6] SmallVector(size_type n, const TYPE& v, bslma::Allocator *ba = 0);
+// [ 3] SmallVector(const SmallVector& o, bslma::Allocator *ba = 0);
+// [ 2] ~SmallVector();
+// [ 4] SmallVector& operator=(const SmallVector& rhs);
+// [ 2] void push_back(const TYPE& value);
+// [ 2] void pop_back();
+// [ 2] void clear();
+// [ 5] iterator insert(const_iterator position, const TYPE& value);
+// [ 5] void insert(const_iterator position, size_type n, const TYPE& v);
+// [ 5] iterator erase(const_iterator position);
+// [ 5] iterator erase(const_iterator first, const_iterator last);
+// [ 6] void reserve(size_type newCapacity);
+// [ 6] void resize(size_type newLength);
+// [ 6] void resize(size_type newLength, const TYPE& value);
+// [ 6] void shrink_to_fit();
+// [ 2] size_type size() const;
+// [ 2] size_type capacity() const;
+// [ 2] bslma::Allocator *allocator() const;
+// [ 3] bool operator==(const SmallVector& lhs, const SmallVector& rhs);
+// [ 3] bool operator!=(const SmallVector& lhs, const SmallVector& rhs);
+//
+// InplaceVector
+// [ 7] InplaceVector(bslma::Allocator *ba = 0);
+// [ 7] InplaceVector(size_type n, const TYPE& v, bslma::Allocator *ba = 0);
+// [ 7] InplaceVector(const InplaceVector& o, bslma::Allocator *ba = 0);
+// [ 7] InplaceVector& operator=(const InplaceVector& rhs);
+// [ 7] void push_back(const TYPE& value);
+// [ 7] iterator insert(const_iterator position, const TYPE& value);
+// [ 7] iterator erase(const_iterator position);
+// [ 7] void resize(size_type newLength);
+// [ 7] bool full() const;
+// [ 7] bool operator==(const InplaceVector& l, const InplaceVector& r);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE: 'SmallVector' VS. 'bsl::vector'
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+                              // ===============
+                              // class SelfAware
+                              // ===============
+
+class SelfAware {
+    // This class holds an integer value and the address at which it was
+    // constructed, so that a test can detect whether an object has been
+    // relocated without invoking its copy constructor.  This class is
+    // deliberately *not* bitwise-moveable.
+
+    // DATA
+    int        d_value;
+    SelfAware *d_self_p;
+
+  public:
+    // CLASS DATA
+    static int s_numLive;   // number of objects currently in existence
+
+    // CREATORS
+    SelfAware()
+    : d_value(0)
+    , d_self_p(this)
+    {
+        ++s_numLive;
+    }
+
+    SelfAware(int value)                                            // IMPLICIT
+    : d_value(value)
+    , d_self_p(this)
+    {
+        ++s_numLive;
+    }
+
+    SelfAware(const SelfAware& original)
+    : d_value(original.d_value)
+    , d_self_p(this)
+    {
+        ++s_numLive;
+    }
+
+    ~SelfAware()
+    {
+        ASSERT(this == d_self_p);
+        --s_numLive;
+    }
+
+    // MANIPULATORS
+    SelfAware& operator=(const SelfAware& rhs)
+    {
+        d_value = rhs.d_value;
+        return *this;
+    }
+
+    // ACCESSORS
+    bool isInPlace() const
+    {
+        return this == d_self_p;
+    }
+
+    int value() const
+    {
+        return d_value;
+    }
+};
+
+int SelfAware::s_numLive = 0;
+
+bool operator==(const SelfAware& lhs, const SelfAware& rhs)
+{
+    return lhs.value() == rhs.value();
+}
+
+template <class VECTOR>
+bool verifyInPlace(const VECTOR& vector)
+    // Return 'true' if every element of the specified 'vector' resides at the
+    // address at which it was constructed, and 'false' otherwise.
+{
+    for (typename VECTOR::const_iterator it = vector.begin();
+         it != vector.end();
+         ++it) {
+        if (!it->isInPlace()) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Collecting a Small Number of Fields per Message
+/// - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we are decoding messages, each of which carries a list of
+// field identifiers.  Most messages carry fewer than eight fields, but an
+// occasional message carries many more.
+//
+// First, we define a function that collects the identifiers of the fields
+// present in a message into a 'bdlc::SmallVector' having in-place capacity for
+// eight elements:
+//..
+    typedef bdlc::SmallVector<int, 8> FieldIds;
+
+    void collectFieldIds(FieldIds *result, const int *fields, int numFields)
+        // Load into the specified 'result' the non-negative field identifiers
+        // in the specified 'fields' array of the specified 'numFields' length.
+    {
+        for (int i = 0; i < numFields; ++i) {
+            if (0 <= fields[i]) {
+                result->push_back(fields[i]);
+            }
+        }
+    }
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we create a test allocator, and a small vector that uses it:
+//..
+    bslma::TestAllocator ta;
+
+    FieldIds ids(&ta);
+    ASSERT(8 == ids.capacity());
+//..
+// Next, we collect the fields of a typical message, and observe that no memory
+// was allocated:
+//..
+    const int SMALL[] = { 3, -1, 7, 12, 5 };
+    collectFieldIds(&ids, SMALL, 5);
+
+    ASSERT(4 == ids.size());
+    ASSERT(0 == ta.numBlocksTotal());
+//..
+// Now, we collect the fields of an unusually large message, and observe that
+// the vector spilled into memory supplied by the allocator:
+//..
+    int large[32];
+    for (int i = 0; i < 32; ++i) {
+        large[i] = i;
+    }
+    ids.clear();
+    collectFieldIds(&ids, large, 32);
+
+    ASSERT(32 == ids.size());
+    ASSERT(1  == ta.numBlocksInUse());
+//..
+// Finally, we use a 'bdlc::InplaceVector' when the number of elements is known
+// never to exceed a fixed bound:
+//..
+    bdlc::InplaceVector<int, 4> quad(&ta);
+    quad.push_back(1);
+    quad.push_back(2);
+
+    ASSERT(2 == quad.size());
+    ASSERT(4 == quad.capacity());
+    ASSERT(1 == ta.numBlocksInUse());
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // INPLACEVECTOR
+        //
+        // Concerns:
+        //: 1 An 'InplaceVector' never allocates memory itself.
+        //:
+        //: 2 The allocator supplied at construction is passed to elements that
+        //:   use 'bslma' allocators.
+        //:
+        //: 3 Elements are constructed, copied, and destroyed exactly once, and
+        //:   non-bitwise-moveable elements are never relocated bitwise.
+        //:
+        //: 4 'InplaceVector' is bitwise-moveable if and only if 'TYPE' is.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Exercise the manipulators with 'int', 'bsl::string', and
+        //:   'SelfAware' elements, verifying values, allocations, and the
+        //:   number of live elements.  (C-1..3)
+        //:
+        //: 2 Verify the nested traits.  (C-4)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for overflow and empty-vector access.  (C-5)
+        //
+        // Testing:
+        //   InplaceVector(bslma::Allocator *ba = 0);
+        //   InplaceVector(size_type n, const TYPE& v, bslma::Allocator *ba);
+        //   InplaceVector(const InplaceVector& o, bslma::Allocator *ba = 0);
+        //   InplaceVector& operator=(const InplaceVector& rhs);
+        //   void push_back(const TYPE& value);
+        //   iterator insert(const_iterator position, const TYPE& value);
+        //   iterator erase(const_iterator position);
+        //   void resize(size_type newLength);
+        //   bool full() const;
+        //   bool operator==(const InplaceVector& l, const InplaceVector& r);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INPLACEVECTOR" << endl
+                          << "=============" << endl;
+
+        ASSERT(( bslmf::IsBitwiseMoveable<bdlc::InplaceVector<int, 4> >::value));
+        ASSERT((!bslmf::IsBitwiseMoveable<
+                                bdlc::InplaceVector<SelfAware, 4> >::value));
+        ASSERT((bslma::UsesBslmaAllocator<
+                                bdlc::InplaceVector<int, 4> >::value));
+
+        {
+            typedef bdlc::InplaceVector<int, 4> Obj;
+
+            bslma::TestAllocator oa("object", veryVeryVerbose);
+
+            Obj mX(&oa);  const Obj& X = mX;
+            ASSERT(0 == X.size());
+            ASSERT(4 == X.capacity());
+            ASSERT(X.empty());
+
+            mX.push_back(1);
+            mX.push_back(3);
+            mX.insert(X.begin() + 1, 2);
+            mX.insert(X.end(), 4);
+            ASSERT(X.full());
+            for (int i = 0; i < 4; ++i) {
+                LOOP_ASSERT(i, i + 1 == X[i]);
+            }
+
+            Obj mY(X, &oa);  const Obj& Y = mY;
+            ASSERT(X == Y);
+
+            mY.erase(Y.begin());
+            ASSERT(3 == Y.size());
+            ASSERT(2 == Y.front());
+            ASSERT(4 == Y.back());
+            ASSERT(X != Y);
+
+            mY = X;
+            ASSERT(X == Y);
+
+            mY.resize(2);
+            ASSERT(2 == Y.size());
+            mY.resize(4, 9);
+            ASSERT(9 == Y[3]);
+
+            const Obj Z(3, 7, &oa);
+            ASSERT(3 == Z.size());
+            ASSERT(7 == Z[2]);
+
+            ASSERT(0 == oa.numBlocksTotal());
+            ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+            if (verbose) cout << "\tNegative testing." << endl;
+            {
+                bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+                ASSERT_SAFE_FAIL(mX.push_back(5));
+                mX.pop_back();
+                ASSERT_SAFE_PASS(mX.push_back(5));
+
+                Obj mE(&oa);
+                ASSERT_SAFE_FAIL(mE.pop_back());
+                ASSERT_SAFE_FAIL(mE.front());
+                ASSERT_SAFE_FAIL(mE[0]);
+                ASSERT_SAFE_FAIL(mE.resize(5));
+                ASSERT_SAFE_PASS(mE.resize(4));
+            }
+        }
+
+        {
+            typedef bdlc::InplaceVector<bsl::string, 3> Obj;
+
+            bslma::TestAllocator oa("object", veryVeryVerbose);
+
+            const char *LONG = "a string long enough to require an allocation";
+
+            Obj mX(&oa);  const Obj& X = mX;
+            mX.push_back(LONG);
+            mX.push_back("b");
+            ASSERT(&oa == X[0].get_allocator().mechanism());
+            ASSERT(1 == oa.numBlocksInUse());
+
+            Obj mY(X, &oa);  const Obj& Y = mY;
+            ASSERT(X == Y);
+            ASSERT(2 == oa.numBlocksInUse());
+
+            mY.erase(Y.begin());
+            ASSERT(1 == oa.numBlocksInUse());
+            ASSERT("b" == Y[0]);
+        }
+
+        {
+            typedef bdlc::InplaceVector<SelfAware, 5> Obj;
+
+            {
+                Obj mX;  const Obj& X = mX;
+                for (int i = 0; i < 4; ++i) {
+                    mX.push_back(i);
+                }
+                mX.insert(X.begin(), 10);
+                ASSERT(5 == SelfAware::s_numLive);
+                ASSERT(verifyInPlace(X));
+
+                mX.erase(X.begin() + 1, X.begin() + 3);
+                ASSERT(3 == SelfAware::s_numLive);
+                ASSERT(verifyInPlace(X));
+                ASSERT(10 == X[0].value());
+                ASSERT( 2 == X[1].value());
+                ASSERT( 3 == X[2].value());
+            }
+            ASSERT(0 == SelfAware::s_numLive);
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // RESERVE, RESIZE, AND SHRINK_TO_FIT
+        //
+        // Concerns:
+        //: 1 'reserve' allocates exactly once when the requested capacity
+        //:   exceeds the current capacity, and not at all otherwise.
+        //:
+        //: 2 'resize' default-constructs (or copies the optionally specified
+        //:   value into) new elements, and destroys removed elements.
+        //:
+        //: 3 'shrink_to_fit' returns the elements to the in-place storage when
+        //:   they fit, releasing the allocated block.
+        //:
+        //: 4 The value constructor allocates only if the length exceeds the
+        //:   in-place capacity.
+        //
+        // Plan:
+        //: 1 Exercise each method with 'int' and 'SelfAware' elements and
+        //:   check the resulting values, capacity, and allocations.  (C-1..4)
+        //
+        // Testing:
+        //   SmallVector(size_type n, const TYPE& v, bslma::Allocator *ba);
+        //   void reserve(size_type newCapacity);
+        //   void resize(size_type newLength);
+        //   void resize(size_type newLength, const TYPE& value);
+        //   void shrink_to_fit();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RESERVE, RESIZE, AND SHRINK_TO_FIT" << endl
+                          << "==================================" << endl;
+
+        {
+            typedef bdlc::SmallVector<int, 4> Obj;
+
+            bslma::TestAllocator oa("object", veryVeryVerbose);
+
+            const Obj A(3, 5, &oa);
+            ASSERT(3 == A.size());
+            ASSERT(0 == oa.numBlocksTotal());
+
+            const Obj B(6, 5, &oa);
+            ASSERT(6 == B.size());
+            ASSERT(1 == oa.numBlocksInUse());
+
+            Obj mX(&oa);  const Obj& X = mX;
+            mX.reserve(2);
+            ASSERT(4 == X.capacity());
+            ASSERT(1 == oa.numBlocksTotal());
+
+            mX.resize(3);
+            ASSERT(3 == X.size());
+            ASSERT(0 == X[2]);
+
+            mX.reserve(100);
+            ASSERT(100 == X.capacity());
+            ASSERT(2 == oa.numBlocksInUse());
+            ASSERT(0 == X[0]);
+
+            mX.resize(50, 7);
+            ASSERT(50 == X.size());
+            ASSERT(7 == X[49]);
+            ASSERT(2 == oa.numBlocksInUse());
+
+            mX.shrink_to_fit();
+            ASSERT(50 == X.capacity());
+            ASSERT(2  == oa.numBlocksInUse());
+
+            mX.resize(2);
+            mX.shrink_to_fit();
+            ASSERT(4 == X.capacity());
+            ASSERT(1 == oa.numBlocksInUse());
+            ASSERT(2 == X.size());
+            ASSERT(0 == X[1]);
+        }
+        ASSERT(0 == SelfAware::s_numLive);
+        {
+            typedef bdlc::SmallVector<SelfAware, 2> Obj;
+
+            Obj mX;  const Obj& X = mX;
+            mX.resize(5, 3);
+            ASSERT(5 == SelfAware::s_numLive);
+            ASSERT(verifyInPlace(X));
+
+            mX.resize(1);
+            ASSERT(1 == SelfAware::s_numLive);
+            mX.shrink_to_fit();
+            ASSERT(2 == X.capacity());
+            ASSERT(verifyInPlace(X));
+            ASSERT(3 == X[0].value());
+        }
+        ASSERT(0 == SelfAware::s_numLive);
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // INSERT AND ERASE
+        //
+        // Concerns:
+        //: 1 Elements are inserted and erased at the specified position,
+        //:   whether or not the operation causes the vector to spill.
+        //:
+        //: 2 Inserting a value that refers to an element of the vector itself
+        //:   inserts the correct value, including when the vector grows.
+        //:
+        //: 3 The returned iterators refer to the expected elements.
+        //
+        // Plan:
+        //: 1 For every length up to and beyond the in-place capacity, and for
+        //:   every position, insert into a copy of a reference vector and
+        //:   compare against a 'bsl::vector' modified in the same way.
+        //:   (C-1,3)
+        //:
+        //: 2 Repeat P-1 inserting an element of the vector itself.  (C-2)
+        //:
+        //: 3 Erase single elements and ranges, comparing with 'bsl::vector'.
+        //:   (C-1,3)
+        //
+        // Testing:
+        //   iterator insert(const_iterator position, const TYPE& value);
+        //   void insert(const_iterator position, size_type n, const TYPE& v);
+        //   iterator erase(const_iterator position);
+        //   iterator erase(const_iterator first, const_iterator last);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INSERT AND ERASE" << endl
+                          << "================" << endl;
+
+        typedef bdlc::SmallVector<int, 4> Obj;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        for (int len = 0; len <= 6; ++len) {
+            for (int pos = 0; pos <= len; ++pos) {
+                for (int n = 1; n <= 3; ++n) {
+                    Obj         mX(&oa);  const Obj& X = mX;
+                    vector<int> exp;
+                    for (int i = 0; i < len; ++i) {
+                        mX.push_back(i);
+                        exp.push_back(i);
+                    }
+
+                    mX.insert(X.begin() + pos, n, -1);
+                    exp.insert(exp.begin() + pos, n, -1);
+                    LOOP3_ASSERT(len, pos, n, exp.size() == X.size());
+                    for (int i = 0; i < static_cast<int>(exp.size()); ++i) {
+                        LOOP4_ASSERT(len, pos, n, i, exp[i] == X[i]);
+                    }
+
+                    if (0 < len) {
+                        const int alias = X[0];
+                        Obj::iterator it = mX.insert(X.begin() + pos, X[0]);
+                        exp.insert(exp.begin() + pos, alias);
+                        LOOP2_ASSERT(len, pos, alias == *it);
+                        LOOP2_ASSERT(len, pos, X.begin() + pos == it);
+                        for (int i = 0; i < static_cast<int>(exp.size());
+                                                                         ++i) {
+                            LOOP3_ASSERT(len, pos, i, exp[i] == X[i]);
+                        }
+                    }
+
+                    Obj::iterator it = mX.erase(X.begin() + pos);
+                    exp.erase(exp.begin() + pos);
+                    LOOP2_ASSERT(len, pos, X.begin() + pos == it);
+                    LOOP2_ASSERT(len, pos, exp.size() == X.size());
+
+                    it = mX.erase(X.begin(), X.begin() + pos);
+                    exp.erase(exp.begin(), exp.begin() + pos);
+                    LOOP2_ASSERT(len, pos, X.begin() == it);
+                    LOOP2_ASSERT(len, pos, exp.size() == X.size());
+                    for (int i = 0; i < static_cast<int>(exp.size()); ++i) {
+                        LOOP3_ASSERT(len, pos, i, exp[i] == X[i]);
+                    }
+                }
+            }
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\tNon-bitwise-moveable elements." << endl;
+        {
+            typedef bdlc::SmallVector<SelfAware, 3> Obj;
+
+            Obj mX(&oa);  const Obj& X = mX;
+            for (int i = 0; i < 3; ++i) {
+                mX.insert(X.begin(), i);
+                ASSERT(verifyInPlace(X));
+            }
+            mX.insert(X.begin() + 1, 2, X[2]);
+            ASSERT(5 == X.size());
+            ASSERT(5 == SelfAware::s_numLive);
+            ASSERT(verifyInPlace(X));
+            ASSERT(2 == X[0].value());
+            ASSERT(0 == X[1].value());
+            ASSERT(0 == X[2].value());
+            ASSERT(1 == X[3].value());
+            ASSERT(0 == X[4].value());
+
+            mX.erase(X.begin(), X.end());
+            ASSERT(0 == SelfAware::s_numLive);
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // COPY-ASSIGNMENT OPERATOR
+        //
+        // Concerns:
+        //: 1 The assigned object has the value of the source, for all
+        //:   combinations of in-place and spilled source and destination.
+        //:
+        //: 2 The allocator of the assigned object is unchanged.
+        //:
+        //: 3 Self-assignment has no effect.
+        //
+        // Plan:
+        //: 1 For a set of lengths on either side of the in-place capacity,
+        //:   assign every source to every destination and verify the value
+        //:   and allocator.  (C-1,2)
+        //:
+        //: 2 Assign each object to itself.  (C-3)
+        //
+        // Testing:
+        //   SmallVector& operator=(const SmallVector& rhs);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "COPY-ASSIGNMENT OPERATOR" << endl
+                          << "========================" << endl;
+
+        typedef bdlc::SmallVector<bsl::string, 2> Obj;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+        bslma::TestAllocator za("other",  veryVeryVerbose);
+
+        const int LENGTHS[] = { 0, 1, 2, 3, 5 };
+        const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        for (int i = 0; i < NUM_LENGTHS; ++i) {
+            Obj mZ(&za);  const Obj& Z = mZ;
+            for (int k = 0; k < LENGTHS[i]; ++k) {
+                mZ.push_back(bsl::string(40, static_cast<char>('a' + k)));
+            }
+            for (int j = 0; j < NUM_LENGTHS; ++j) {
+                Obj mX(&oa);  const Obj& X = mX;
+                for (int k = 0; k < LENGTHS[j]; ++k) {
+                    mX.push_back("x");
+                }
+
+                Obj *mR = &(mX = Z);
+                LOOP2_ASSERT(i, j, mR == &X);
+                LOOP2_ASSERT(i, j, Z == X);
+                LOOP2_ASSERT(i, j, &oa == X.allocator());
+                for (int k = 0; k < LENGTHS[i]; ++k) {
+                    LOOP3_ASSERT(i, j, k,
+                                 &oa == X[k].get_allocator().mechanism());
+                }
+
+                mX = X;
+                LOOP2_ASSERT(i, j, Z == X);
+            }
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // COPY CONSTRUCTOR AND EQUALITY OPERATORS
+        //
+        // Concerns:
+        //: 1 The new object has the same value as the original, whether the
+        //:   original is in place or spilled.
+        //:
+        //: 2 The new object uses the allocator supplied at construction, and
+        //:   allocates only if the length exceeds the in-place capacity.
+        //:
+        //: 3 'operator==' and 'operator!=' compare length and elements.
+        //:
+        //: 4 The copy constructor is exception neutral.
+        //
+        // Plan:
+        //: 1 Copy vectors of various lengths and verify value, allocator, and
+        //:   allocation count.  (C-1..3)
+        //:
+        //: 2 Use 'BSLMA_TESTALLOCATOR_EXCEPTION_TEST' macros to inject
+        //:   allocation failures while copying.  (C-4)
+        //
+        // Testing:
+        //   SmallVector(const SmallVector& o, bslma::Allocator *ba = 0);
+        //   bool operator==(const SmallVector& lhs, const SmallVector& rhs);
+        //   bool operator!=(const SmallVector& lhs, const SmallVector& rhs);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "COPY CONSTRUCTOR AND EQUALITY OPERATORS" << endl
+                          << "=======================================" << endl;
+
+        typedef bdlc::SmallVector<bsl::string, 3> Obj;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+        bslma::TestAllocator za("other",  veryVeryVerbose);
+
+        for (int len = 0; len <= 6; ++len) {
+            Obj mZ(&za);  const Obj& Z = mZ;
+            for (int k = 0; k < len; ++k) {
+                mZ.push_back(bsl::string(k + 30, 'z'));
+            }
+
+            const bsls::Types::Int64 B = oa.numBlocksTotal();
+            {
+                const Obj X(Z, &oa);
+                LOOP_ASSERT(len, Z == X);
+                LOOP_ASSERT(len, !(Z != X));
+                LOOP_ASSERT(len, &oa == X.allocator());
+                LOOP_ASSERT(len, len + (len > 3)
+                                               == oa.numBlocksTotal() - B);
+
+                Obj mY(Z, &oa);  const Obj& Y = mY;
+                if (0 < len) {
+                    mY.back() = "different";
+                    LOOP_ASSERT(len, !(Z == Y));
+                    LOOP_ASSERT(len, Z != Y);
+                }
+                mY.push_back("longer");
+                LOOP_ASSERT(len, Z != Y);
+            }
+            LOOP_ASSERT(len, 0 == oa.numBlocksInUse());
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(oa) {
+                const Obj X(Z, &oa);
+                LOOP_ASSERT(len, Z == X);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            LOOP_ASSERT(len, 0 == oa.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PRIMARY MANIPULATORS
+        //
+        // Concerns:
+        //: 1 A default-constructed vector is empty, has a capacity of
+        //:   't_CAPACITY', and uses the supplied (or default) allocator.
+        //:
+        //: 2 'push_back' appends elements without allocating until the length
+        //:   exceeds 't_CAPACITY', and then allocates exactly one block per
+        //:   growth.
+        //:
+        //: 3 Non-bitwise-moveable elements are relocated by their copy
+        //:   constructor, and every element is destroyed exactly once.
+        //:
+        //: 4 'clear' and 'pop_back' destroy elements, and the destructor
+        //:   releases any allocated memory.
+        //:
+        //: 5 'push_back' is exception neutral.
+        //
+        // Plan:
+        //: 1 Append elements one at a time to vectors of 'int' and
+        //:   'SelfAware', checking value, capacity, allocations, and the
+        //:   number of live elements after each step.  (C-1..4)
+        //:
+        //: 2 Use 'BSLMA_TESTALLOCATOR_EXCEPTION_TEST' macros to inject
+        //:   allocation failures while appending 'bsl::string' elements.
+        //:   (C-5)
+        //
+        // Testing:
+        //   SmallVector(bslma::Allocator *ba = 0);
+        //   ~SmallVector();
+        //   void push_back(const TYPE& value);
+        //   void pop_back();
+        //   void clear();
+        //   size_type size() const;
+        //   size_type capacity() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PRIMARY MANIPULATORS" << endl
+                          << "====================" << endl;
+
+        {
+            typedef bdlc::SmallVector<int, 4> Obj;
+
+            Obj mD;
+            ASSERT(&defaultAllocator == mD.allocator());
+
+            bslma::TestAllocator oa("object", veryVeryVerbose);
+            {
+                Obj mX(&oa);  const Obj& X = mX;
+                ASSERT(&oa == X.allocator());
+                ASSERT(0 == X.size());
+                ASSERT(4 == X.capacity());
+
+                for (int i = 0; i < 20; ++i) {
+                    mX.push_back(i);
+                    LOOP_ASSERT(i, i + 1 == static_cast<int>(X.size()));
+                    LOOP_ASSERT(i, i == X.back());
+                    LOOP_ASSERT(i, 0 == X.front());
+                    const int expBlocks = i < 4 ? 0 : i < 8 ? 1 : i < 16 ? 2
+                                                                         : 3;
+                    LOOP_ASSERT(i, expBlocks == oa.numBlocksTotal());
+                }
+                ASSERT(1 == oa.numBlocksInUse());
+
+                mX.pop_back();
+                ASSERT(19 == X.size());
+                mX.clear();
+                ASSERT(0  == X.size());
+                ASSERT(32 == X.capacity());
+                ASSERT(1  == oa.numBlocksInUse());
+            }
+            ASSERT(0 == oa.numBlocksInUse());
+        }
+
+        {
+            typedef bdlc::SmallVector<SelfAware, 2> Obj;
+
+            {
+                Obj mX;  const Obj& X = mX;
+                for (int i = 0; i < 9; ++i) {
+                    mX.push_back(i);
+                    LOOP_ASSERT(i, i + 1 == SelfAware::s_numLive);
+                    LOOP_ASSERT(i, verifyInPlace(X));
+                }
+                for (int i = 0; i < 9; ++i) {
+                    LOOP_ASSERT(i, i == X[i].value());
+                }
+                mX.pop_back();
+                ASSERT(8 == SelfAware::s_numLive);
+            }
+            ASSERT(0 == SelfAware::s_numLive);
+        }
+
+        {
+            typedef bdlc::SmallVector<bsl::string, 2> Obj;
+
+            bslma::TestAllocator oa("object", veryVeryVerbose);
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(oa) {
+                Obj mX(&oa);  const Obj& X = mX;
+                for (int i = 0; i < 5; ++i) {
+                    mX.push_back(bsl::string(40, static_cast<char>('a' + i)));
+                }
+                ASSERT(5 == X.size());
+                ASSERT(bsl::string(40, 'e') == X[4]);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERT(0 == oa.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a small vector, append elements past its in-place
+        //:   capacity, copy it, and compare.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        bdlc::SmallVector<int, 2> mX(&oa);
+        mX.push_back(1);
+        mX.push_back(2);
+        ASSERT(0 == oa.numBlocksTotal());
+        mX.push_back(3);
+        ASSERT(1 == oa.numBlocksInUse());
+
+        bdlc::SmallVector<int, 2> mY(mX, &oa);
+        ASSERT(mX == mY);
+        mY.pop_back();
+        ASSERT(mX != mY);
+
+        bdlc::InplaceVector<int, 2> mZ(&oa);
+        mZ.push_back(1);
+        mZ.push_back(2);
+        ASSERT(2 == mZ.size());
+        ASSERT(2 == oa.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'SmallVector' VS. 'bsl::vector'
+        //
+        // Concerns:
+        //: 1 Building short vectors with 'SmallVector' is faster than with
+        //:   'bsl::vector', which allocates on the first insertion.
+        //
+        // Plan:
+        //: 1 Repeatedly build and destroy vectors of a short length (specified
+        //:   on the command line, default 6) with each type, and report the
+        //:   elapsed time.
+        //
+        // Testing:
+        //   PERFORMANCE: 'SmallVector' VS. 'bsl::vector'
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: 'SmallVector' VS. 'bsl::vector'"
+                          << endl
+                          << "============================================"
+                          << endl;
+
+        const int LENGTH         = argc > 2 ? atoi(argv[2]) : 6;
+        const int NUM_ITERATIONS = 2000000;
+
+        bslma::Allocator *alloc = bslma::NewDeleteAllocator::allocator(0);
+
+        bsls::Stopwatch timer;
+        int             sum = 0;
+
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            bsl::vector<int> v(alloc);
+            for (int j = 0; j < LENGTH; ++j) {
+                v.push_back(j);
+            }
+            sum += v.back();
+        }
+        timer.stop();
+        cout << "bsl::vector<int>:          " << timer.elapsedTime() << "s"
+             << endl;
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            bdlc::SmallVector<int, 8> v(alloc);
+            for (int j = 0; j < LENGTH; ++j) {
+                v.push_back(j);
+            }
+            sum += v.back();
+        }
+        timer.stop();
+        cout << "bdlc::SmallVector<int, 8>: " << timer.elapsedTime() << "s"
+             << endl;
+
+        if (veryVerbose) {
+            P(sum);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
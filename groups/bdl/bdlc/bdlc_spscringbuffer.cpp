@@ -0,0 +1,67 @@
+// bdlc_spscringbuffer.cpp                                            -*-C++-*-
+#include <bdlc_spscringbuffer.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlc_spscringbuffer_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                            // --------------------
+                            // class SpscRingBuffer
+                            // --------------------
+
+// PRIVATE CLASS DATA
+const bsls::Types::Uint64 SpscRingBuffer::k_PADDING =
+                                          ~static_cast<bsls::Types::Uint64>(0);
+
+// CREATORS
+SpscRingBuffer::SpscRingBuffer(bsl::size_t       capacity,
+                               bslma::Allocator *basicAllocator)
+: d_writeIndex(0)
+, d_cachedReadIndex(0)
+, d_reservedIndex(-1)
+, d_reservedSize(0)
+, d_readIndex(0)
+, d_cachedWriteIndex(0)
+, d_peekEndIndex(-1)
+, d_buffer_p(0)
+, d_capacity(k_MIN_CAPACITY)
+, d_mask(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < capacity);
+    BSLS_ASSERT(capacity <= ~static_cast<bsl::size_t>(0) / 2 + 1);
+
+    while (d_capacity < capacity) {
+        d_capacity *= 2;
+    }
+    d_mask     = static_cast<Int64>(d_capacity) - 1;
+    d_buffer_p = static_cast<char *>(d_allocator_p->allocate(d_capacity));
+}
+
+SpscRingBuffer::~SpscRingBuffer()
+{
+    d_allocator_p->deallocate(d_buffer_p);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,511 @@
+// bdlc_spscringbuffer.h                                              -*-C++-*-
+#ifndef INCLUDED_BDLC_SPSCRINGBUFFER
+#define INCLUDED_BDLC_SPSCRINGBUFFER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a single-producer/single-consumer ring of byte messages.
+//
+//@CLASSES:
+//  bdlc::SpscRingBuffer: lock-free ring of variable-length messages
+//
+//@SEE_ALSO: bdlc_boundedqueue, bslx_marshallingutil
+//
+//@DESCRIPTION: This component provides a mechanism, 'bdlc::SpscRingBuffer',
+// that passes variable-length messages of bytes from one producer thread to
+// one consumer thread without copying them: the producer *reserves* a
+// contiguous range of bytes in the ring, encodes a message directly into it,
+// and *commits* the message; the consumer *peeks* at the next message in
+// place, decodes it, and *releases* it.  No operation blocks, and no operation
+// allocates memory.
+//
+// The ring is a power-of-two sized block of memory, obtained at construction
+// from the 'bslma::Allocator' supplied (or the default allocator), together
+// with two monotonically increasing byte positions: the *write* position,
+// advanced only by the producer, and the *read* position, advanced only by the
+// consumer.  A commit stores the write position with release semantics, and a
+// release stores the read position with release semantics, so each side sees
+// the bytes written by the other before it sees the position that covers
+// them.
+//
+///Cached Positions
+///----------------
+// Each side keeps a private copy of the other side's position, and reads the
+// shared position (with acquire semantics) only when its copy indicates that
+// the ring is full (for the producer) or empty (for the consumer).  In the
+// steady state, therefore, the producer and the consumer each write only to
+// their own cache line, and read the other's only once per "lap" of the space
+// known to be available.  The producer's and consumer's state are kept on
+// separate cache lines.
+//
+///Message Framing
+///---------------
+// Each committed message is stored as an 8-byte header holding its length,
+// followed by its bytes, padded to a multiple of 8 bytes; every message is
+// therefore 8-byte aligned in the ring.  A reservation that would not fit
+// between the write position and the end of the memory block is placed at the
+// start of the block instead, and the unused bytes at the end are marked, so
+// that the consumer skips them.  Consequently, a reservation may require up to
+// twice its size in free space; 'maxReservation' returns the largest
+// reservation that is guaranteed to succeed once the consumer has released
+// every message.
+//
+///Thread Safety
+///-------------
+// 'reserve' and 'commit' may be called only by the single producer thread,
+// and 'peek' and 'release' only by the single consumer thread; the producer
+// and the consumer may run concurrently.  The accessors may be called from
+// either thread, but their results are approximate while the other thread is
+// active.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Encoding Messages in Place
+///- - - - - - - - - - - - - - - - - - -
+// Suppose that one stage of a feed handler decodes quotes from the network,
+// and passes them to the next stage, running in another thread, in a compact
+// binary form.
+//
+// First, we create a ring of (at least) 4096 bytes:
+//..
+//  bdlc::SpscRingBuffer ring(4096);
+//  assert(4096 == ring.capacity());
+//..
+// Then, the producer reserves space for the largest quote it may encode (a
+// 2-byte symbol length, up to 32 bytes of symbol, an 8-byte price, and a
+// 4-byte quantity), and encodes a quote directly into the ring using
+// 'bslx::MarshallingUtil':
+//..
+//  const char        *symbol    = "IBM";
+//  const int          symbolLen = 3;
+//  const bsl::size_t  MAX_QUOTE = 2 + 32 + 8 + 4;
+//
+//  char *out = ring.reserve(MAX_QUOTE);
+//  assert(out);
+//
+//  char *p = out;
+//  bslx::MarshallingUtil::putInt16(p, symbolLen);  p += 2;
+//  bsl::memcpy(p, symbol, symbolLen);              p += symbolLen;
+//  bslx::MarshallingUtil::putInt64(p, 12345);      p += 8;
+//  bslx::MarshallingUtil::putInt32(p, 100);        p += 4;
+//..
+// Next, the producer commits only the bytes it used:
+//..
+//  ring.commit(p - out);
+//  assert(!ring.isEmpty());
+//..
+// Now, the consumer peeks at the message, and decodes it where it lies:
+//..
+//  bsl::size_t  length;
+//  const char  *in = ring.peek(&length);
+//  assert(in);
+//  assert(2 + 3 + 8 + 4 == length);
+//
+//  short              len;
+//  bsls::Types::Int64 price;
+//  int                quantity;
+//
+//  bslx::MarshallingUtil::getInt16(&len, in);
+//  assert(3 == len);
+//  assert(0 == bsl::memcmp(in + 2, "IBM", 3));
+//  bslx::MarshallingUtil::getInt64(&price, in + 2 + len);
+//  bslx::MarshallingUtil::getInt32(&quantity, in + 2 + len + 8);
+//  assert(12345 == price);
+//  assert(100   == quantity);
+//..
+// Finally, the consumer releases the message, making its space available to
+// the producer:
+//..
+//  ring.release();
+//  assert(ring.isEmpty());
+//  assert(0 == ring.peek(&length));
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                            // ====================
+                            // class SpscRingBuffer
+                            // ====================
+
+class SpscRingBuffer {
+    // This class implements a lock-free ring of variable-length byte messages
+    // passed from a single producer thread to a single consumer thread, which
+    // encode and decode each message in place.  See the component-level
+    // documentation for the thread-safety guarantees.
+
+    // PRIVATE TYPES
+    typedef bsls::Types::Int64  Int64;
+    typedef bsls::Types::Uint64 Uint64;
+
+    enum {
+        k_CACHE_LINE_SIZE = 64,  // assumed size of a cache line, in bytes
+
+        k_HEADER_SIZE     = 8,   // size of a message header, and alignment
+                                 // of each message, in bytes
+
+        k_MIN_CAPACITY    = 64   // minimum capacity of a ring, in bytes
+    };
+
+    static const Uint64 k_PADDING;  // header marking unused bytes at the end
+                                    // of the memory block
+
+    // DATA
+
+    // Producer state.
+
+    bsls::AtomicInt64  d_writeIndex;       // position after the last
+                                           // committed message
+
+    Int64              d_cachedReadIndex;  // producer's copy of
+                                           // 'd_readIndex'
+
+    Int64              d_reservedIndex;    // position of the header of the
+                                           // reserved message, or -1
+
+    bsl::size_t        d_reservedSize;     // size of the reservation
+
+    char               d_producerPad[k_CACHE_LINE_SIZE
+                                     - sizeof(bsls::AtomicInt64)
+                                     - 2 * sizeof(Int64)
+                                     - sizeof(bsl::size_t)];
+                                           // separates the producer's state
+                                           // from the consumer's
+
+    // Consumer state.
+
+    bsls::AtomicInt64  d_readIndex;        // position of the header of the
+                                           // next message to consume
+
+    Int64              d_cachedWriteIndex; // consumer's copy of
+                                           // 'd_writeIndex'
+
+    Int64              d_peekEndIndex;     // position after the peeked
+                                           // message, or -1
+
+    char               d_consumerPad[k_CACHE_LINE_SIZE
+                                     - sizeof(bsls::AtomicInt64)
+                                     - 2 * sizeof(Int64)];
+                                           // separates the consumer's state
+                                           // from the read-only state below
+
+    // Shared, read-only state.
+
+    char              *d_buffer_p;         // memory block (owned)
+
+    bsl::size_t        d_capacity;         // size of 'd_buffer_p'
+
+    Int64              d_mask;             // 'd_capacity - 1'
+
+    bslma::Allocator  *d_allocator_p;      // memory allocator (held, not
+                                           // owned)
+
+  private:
+    // NOT IMPLEMENTED
+    SpscRingBuffer(const SpscRingBuffer&);
+    SpscRingBuffer& operator=(const SpscRingBuffer&);
+
+    // PRIVATE CLASS METHODS
+    static bsl::size_t alignedSize(bsl::size_t numBytes);
+        // Return the least multiple of 'k_HEADER_SIZE' that is at least the
+        // specified 'numBytes'.
+
+    // PRIVATE ACCESSORS
+    Uint64 *header(Int64 position) const;
+        // Return the address of the message header at the specified
+        // 'position'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(SpscRingBuffer, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit SpscRingBuffer(bsl::size_t       capacity,
+                            bslma::Allocator *basicAllocator = 0);
+        // Create an empty ring of at least the specified 'capacity' bytes.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The capacity of the ring is the least power of two (and at
+        // least 64) that is not less than 'capacity'.  The behavior is
+        // undefined unless '0 < capacity' and 'capacity' is at most half the
+        // largest value of 'bsl::size_t'.
+
+    ~SpscRingBuffer();
+        // Destroy this object.  The behavior is undefined unless neither the
+        // producer nor the consumer is accessing this ring.
+
+    // MANIPULATORS
+
+    // Producer manipulators.
+
+    char *reserve(bsl::size_t numBytes);
+        // Reserve a contiguous range of the specified 'numBytes' bytes in
+        // which to encode the next message, and return its address, or return
+        // 0 (with no effect) if the ring has insufficient free space.  The
+        // returned address is aligned on an 8-byte boundary, and remains
+        // valid until the next call to 'commit' or 'reserve'.  A call to
+        // 'reserve' replaces any reservation not yet committed.  The behavior
+        // is undefined unless 'numBytes <= maxReservation()', and this method
+        // is called by the producer thread.
+
+    void commit(bsl::size_t numBytes);
+        // Publish, as the next message, the first specified 'numBytes' bytes
+        // of the current reservation, making it available to the consumer;
+        // the remainder of the reservation is discarded.  The behavior is
+        // undefined unless there is a current reservation of at least
+        // 'numBytes' bytes, and this method is called by the producer thread.
+
+    // Consumer manipulators.
+
+    const char *peek(bsl::size_t *numBytes);
+        // Return the address of the next message, and load its length, in
+        // bytes, into the specified 'numBytes'; return 0, with no effect on
+        // 'numBytes', if the ring holds no committed message.  The returned
+        // address is aligned on an 8-byte boundary, and remains valid until
+        // the next call to 'release'.  Repeated calls to 'peek' without an
+        // intervening 'release' return the same message.  The behavior is
+        // undefined unless this method is called by the consumer thread.
+
+    void release();
+        // Remove the message returned by the most recent call to 'peek',
+        // making its space available to the producer.  The behavior is
+        // undefined unless 'peek' has returned a message that has not yet
+        // been released, and this method is called by the consumer thread.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this ring to supply memory.
+
+    bsl::size_t capacity() const;
+        // Return the size, in bytes, of the memory block of this ring.
+
+    bool isEmpty() const;
+        // Return 'true' if this ring holds no committed message that has not
+        // been released, and 'false' otherwise.  Note that the returned value
+        // may be out of date by the time it is examined.
+
+    bsl::size_t maxReservation() const;
+        // Return the largest number of bytes that may be reserved, which is
+        // guaranteed to succeed once every committed message is released.
+
+    bsl::size_t numBytesInUse() const;
+        // Return the number of bytes of this ring occupied by committed
+        // messages (including their headers and padding) that have not been
+        // released.  Note that the returned value may be out of date by the
+        // time it is examined.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                            // --------------------
+                            // class SpscRingBuffer
+                            // --------------------
+
+// PRIVATE CLASS METHODS
+inline
+bsl::size_t SpscRingBuffer::alignedSize(bsl::size_t numBytes)
+{
+    return (numBytes + k_HEADER_SIZE - 1)
+                                & ~static_cast<bsl::size_t>(k_HEADER_SIZE - 1);
+}
+
+// PRIVATE ACCESSORS
+inline
+bsls::Types::Uint64 *SpscRingBuffer::header(Int64 position) const
+{
+    return reinterpret_cast<Uint64 *>(
+                     d_buffer_p + static_cast<bsl::size_t>(position & d_mask));
+}
+
+// MANIPULATORS
+inline
+char *SpscRingBuffer::reserve(bsl::size_t numBytes)
+{
+    BSLS_ASSERT_SAFE(numBytes <= maxReservation());
+
+    const Int64       write      = d_writeIndex.loadRelaxed();
+    const bsl::size_t offset     = static_cast<bsl::size_t>(write & d_mask);
+    const bsl::size_t contiguous = d_capacity - offset;
+    const bsl::size_t recordSize = k_HEADER_SIZE + alignedSize(numBytes);
+
+    // A record that does not fit before the end of the memory block is placed
+    // at its start, and the bytes skipped are also required.
+
+    const bsl::size_t required = recordSize <= contiguous
+                               ? recordSize
+                               : contiguous + recordSize;
+
+    if (static_cast<bsl::size_t>(write - d_cachedReadIndex) + required
+                                                                > d_capacity) {
+        d_cachedReadIndex = d_readIndex.loadAcquire();
+
+        if (static_cast<bsl::size_t>(write - d_cachedReadIndex) + required
+                                                                > d_capacity) {
+            return 0;                                                 // RETURN
+        }
+    }
+
+    Int64 record = write;
+    if (recordSize > contiguous) {
+        // Mark the end of the block as unused.  The marker is published along
+        // with the message.
+
+        *header(write) = k_PADDING;
+        record        += static_cast<Int64>(contiguous);
+    }
+
+    d_reservedIndex = record;
+    d_reservedSize  = numBytes;
+
+    return reinterpret_cast<char *>(header(record)) + k_HEADER_SIZE;
+}
+
+inline
+void SpscRingBuffer::commit(bsl::size_t numBytes)
+{
+    BSLS_ASSERT_SAFE(0 <= d_reservedIndex);
+    BSLS_ASSERT_SAFE(numBytes <= d_reservedSize);
+
+    *header(d_reservedIndex) = numBytes;
+
+    d_writeIndex.storeRelease(d_reservedIndex
+                            + k_HEADER_SIZE
+                            + static_cast<Int64>(alignedSize(numBytes)));
+    d_reservedIndex = -1;
+}
+
+inline
+const char *SpscRingBuffer::peek(bsl::size_t *numBytes)
+{
+    BSLS_ASSERT_SAFE(numBytes);
+
+    Int64 read = d_readIndex.loadRelaxed();
+
+    if (read == d_cachedWriteIndex) {
+        d_cachedWriteIndex = d_writeIndex.loadAcquire();
+
+        if (read == d_cachedWriteIndex) {
+            return 0;                                                 // RETURN
+        }
+    }
+
+    Uint64 length = *header(read);
+    if (k_PADDING == length) {
+        // Skip to the start of the memory block, where the message committed
+        // with the marker lies.
+
+        read   += static_cast<Int64>(d_capacity)
+                - static_cast<Int64>(read & d_mask);
+        length  = *header(read);
+    }
+
+    *numBytes      = static_cast<bsl::size_t>(length);
+    d_peekEndIndex = read
+                   + k_HEADER_SIZE
+                   + static_cast<Int64>(alignedSize(*numBytes));
+
+    return reinterpret_cast<const char *>(header(read)) + k_HEADER_SIZE;
+}
+
+inline
+void SpscRingBuffer::release()
+{
+    BSLS_ASSERT_SAFE(0 <= d_peekEndIndex);
+
+    d_readIndex.storeRelease(d_peekEndIndex);
+    d_peekEndIndex = -1;
+}
+
+// ACCESSORS
+inline
+bslma::Allocator *SpscRingBuffer::allocator() const
+{
+    return d_allocator_p;
+}
+
+inline
+bsl::size_t SpscRingBuffer::capacity() const
+{
+    return d_capacity;
+}
+
+inline
+bool SpscRingBuffer::isEmpty() const
+{
+    return d_readIndex.loadAcquire() == d_writeIndex.loadAcquire();
+}
+
+inline
+bsl::size_t SpscRingBuffer::maxReservation() const
+{
+    return d_capacity / 2 - k_HEADER_SIZE;
+}
+
+inline
+bsl::size_t SpscRingBuffer::numBytesInUse() const
+{
+    const Int64 read  = d_readIndex.loadAcquire();
+    const Int64 write = d_writeIndex.loadAcquire();
+
+    return write > read ? static_cast<bsl::size_t>(write - read) : 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,947 @@
+// bdlc_spscringbuffer.t.cpp                                          -*-C++-*-
+#include <bdlc_spscringbuffer.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslx_marshallingutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test provides a ring of variable-length messages passed
+// from one producer thread to one consumer thread, which encode and decode
+// them in place.  The primary concerns are that messages are consumed in the
+// order, and with the lengths and contents, with which they were committed;
+// that a reservation that does not fit before the end of the memory block is
+// placed at its start and the skipped bytes are hidden from the consumer; that
+// the ring correctly reports that it is full or empty; and that the ring may
+// be used concurrently by a producer and a consumer.  We use
+// 'bslma::TestAllocator' to verify the memory behavior, and 'pthread' (or the
+// Windows thread API) to exercise the ring from two threads.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit SpscRingBuffer(bsl::size_t capacity, Allocator *ba = 0);
+// [ 2] ~SpscRingBuffer();
+//
+// MANIPULATORS
+// [ 3] char *reserve(bsl::size_t numBytes);
+// [ 3] void commit(bsl::size_t numBytes);
+// [ 3] const char *peek(bsl::size_t *numBytes);
+// [ 3] void release();
+//
+// ACCESSORS
+// [ 2] bslma::Allocator *allocator() const;
+// [ 2] bsl::size_t capacity() const;
+// [ 3] bool isEmpty() const;
+// [ 2] bsl::size_t maxReservation() const;
+// [ 3] bsl::size_t numBytesInUse() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] CONCURRENT PRODUCER AND CONSUMER
+// [ 5] USAGE EXAMPLE
+// [-1] PERFORMANCE: THROUGHPUT
+//=============================================================================
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlc::SpscRingBuffer Obj;
+typedef bsls::Types::UintPtr UintPtr;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+void yieldThread()
+    // Offer the processor to another thread.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+static
+bsl::size_t messageLength(int sequence, bsl::size_t maxLength)
+    // Return a length, less than or equal to the specified 'maxLength', for
+    // the message having the specified 'sequence' number, such that
+    // consecutive messages have varied lengths.
+{
+    return static_cast<bsl::size_t>(sequence) * 7919 % (maxLength + 1);
+}
+
+static
+void fillMessage(char *message, bsl::size_t length, int sequence)
+    // Fill the specified 'message' of the specified 'length' with bytes
+    // determined by the specified 'sequence' number.
+{
+    for (bsl::size_t i = 0; i < length; ++i) {
+        message[i] = static_cast<char>(sequence + i);
+    }
+}
+
+static
+bool checkMessage(const char *message, bsl::size_t length, int sequence)
+    // Return 'true' if the specified 'message' of the specified 'length' has
+    // the contents loaded by 'fillMessage' for the specified 'sequence'
+    // number, and 'false' otherwise.
+{
+    for (bsl::size_t i = 0; i < length; ++i) {
+        if (message[i] != static_cast<char>(sequence + i)) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+namespace TestCase4 {
+
+enum { k_NUM_MESSAGES = 200000 };
+
+struct ThreadInfo {
+    Obj  *d_ring_p;      // ring shared by the producer and the consumer
+    bool  d_isValid;     // all messages were consumed as committed
+};
+
+extern "C" void *producerFunction(void *arg)
+    // Commit 'k_NUM_MESSAGES' messages of varied lengths and contents to the
+    // ring described by the specified 'arg', retrying while it is full.
+{
+    ThreadInfo&       info = *static_cast<ThreadInfo *>(arg);
+    Obj&              ring = *info.d_ring_p;
+    const bsl::size_t MAX  = ring.maxReservation();
+
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        const bsl::size_t length = messageLength(i, MAX);
+
+        char *message;
+        while (0 == (message = ring.reserve(length))) {
+            yieldThread();
+        }
+        fillMessage(message, length, i);
+        ring.commit(length);
+    }
+    return 0;
+}
+
+extern "C" void *consumerFunction(void *arg)
+    // Consume 'k_NUM_MESSAGES' messages from the ring described by the
+    // specified 'arg', verifying the length and contents of each.
+{
+    ThreadInfo&       info = *static_cast<ThreadInfo *>(arg);
+    Obj&              ring = *info.d_ring_p;
+    const bsl::size_t MAX  = ring.maxReservation();
+
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        bsl::size_t  length;
+        const char  *message;
+        while (0 == (message = ring.peek(&length))) {
+            yieldThread();
+        }
+        if (length != messageLength(i, MAX)
+         || !checkMessage(message, length, i)) {
+            info.d_isValid = false;
+        }
+        ring.release();
+    }
+    return 0;
+}
+
+}  // close namespace TestCase4
+
+namespace BenchmarkCase {
+
+struct ThreadInfo {
+    Obj         *d_ring_p;         // ring shared by both threads
+    int          d_numMessages;    // number of messages to pass
+    bsl::size_t  d_messageLength;  // length of each message
+    long         d_sum;            // checksum computed by the consumer
+};
+
+extern "C" void *benchmarkProducer(void *arg)
+    // Commit the number of messages specified by 'arg'.
+{
+    ThreadInfo& info = *static_cast<ThreadInfo *>(arg);
+
+    for (int i = 0; i < info.d_numMessages; ++i) {
+        char *message;
+        while (0 == (message = info.d_ring_p->reserve(info.d_messageLength))) {
+            yieldThread();
+        }
+        bsl::memset(message, 1, info.d_messageLength);
+        info.d_ring_p->commit(info.d_messageLength);
+    }
+    return 0;
+}
+
+extern "C" void *benchmarkConsumer(void *arg)
+    // Consume the number of messages specified by 'arg'.
+{
+    ThreadInfo& info = *static_cast<ThreadInfo *>(arg);
+
+    for (int i = 0; i < info.d_numMessages; ++i) {
+        bsl::size_t  length;
+        const char  *message;
+        while (0 == (message = info.d_ring_p->peek(&length))) {
+            yieldThread();
+        }
+        info.d_sum += message[0] + message[length - 1];
+        info.d_ring_p->release();
+    }
+    return 0;
+}
+
+}  // close namespace BenchmarkCase
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Encoding Messages in Place
+///- - - - - - - - - - - - - - - - - - -
+// Suppose that one stage of a feed handler decodes quotes from the network,
+// and passes them to the next stage, running in another thread, in a compact
+// binary form.
+//
+// First, we create a ring of (at least) 4096 bytes:
+//..
+    bdlc::SpscRingBuffer ring(4096);
+    ASSERT(4096 == ring.capacity());
+//..
+// Then, the producer reserves space for the largest quote it may encode (a
+// 2-byte symbol length, up to 32 bytes of symbol, an 8-byte price, and a
+// 4-byte quantity), and encodes a quote directly into the ring using
+// 'bslx::MarshallingUtil':
+//..
+    const char        *symbol    = "IBM";
+    const int          symbolLen = 3;
+    const bsl::size_t  MAX_QUOTE = 2 + 32 + 8 + 4;
+
+    char *out = ring.reserve(MAX_QUOTE);
+    ASSERT(out);
+
+    char *p = out;
+    bslx::MarshallingUtil::putInt16(p, symbolLen);  p += 2;
+    bsl::memcpy(p, symbol, symbolLen);              p += symbolLen;
+    bslx::MarshallingUtil::putInt64(p, 12345);      p += 8;
+    bslx::MarshallingUtil::putInt32(p, 100);        p += 4;
+//..
+// Next, the producer commits only the bytes it used:
+//..
+    ring.commit(p - out);
+    ASSERT(!ring.isEmpty());
+//..
+// Now, the consumer peeks at the message, and decodes it where it lies:
+//..
+    bsl::size_t  length;
+    const char  *in = ring.peek(&length);
+    ASSERT(in);
+    ASSERT(2 + 3 + 8 + 4 == length);
+
+    short              len;
+    bsls::Types::Int64 price;
+    int                quantity;
+
+    bslx::MarshallingUtil::getInt16(&len, in);
+    ASSERT(3 == len);
+    ASSERT(0 == bsl::memcmp(in + 2, "IBM", 3));
+    bslx::MarshallingUtil::getInt64(&price, in + 2 + len);
+    bslx::MarshallingUtil::getInt32(&quantity, in + 2 + len + 8);
+    ASSERT(12345 == price);
+    ASSERT(100   == quantity);
+//..
+// Finally, the consumer releases the message, making its space available to
+// the producer:
+//..
+    ring.release();
+    ASSERT(ring.isEmpty());
+    ASSERT(0 == ring.peek(&length));
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CONCURRENT PRODUCER AND CONSUMER
+        //
+        // Concerns:
+        //: 1 A producer and a consumer may use a ring concurrently.
+        //:
+        //: 2 The consumer sees each message, in order, with the length and
+        //:   contents with which it was committed, including messages placed
+        //:   at the start of the memory block.
+        //
+        // Plan:
+        //: 1 Create a small ring, so that it is frequently full and empty and
+        //:   wraps many times.  Start a producer thread that commits many
+        //:   messages of varied lengths, each filled with a pattern determined
+        //:   by its sequence number, and a consumer thread that verifies the
+        //:   length and pattern of each message.  (C-1..2)
+        //
+        // Testing:
+        //   CONCURRENT PRODUCER AND CONSUMER
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT PRODUCER AND CONSUMER" << endl
+                          << "================================" << endl;
+
+        using namespace TestCase4;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(256, &ta);  const Obj& X = mX;
+
+            ThreadInfo info = { &mX, true };
+
+            ThreadId consumer = createThread(&consumerFunction, &info);
+            ThreadId producer = createThread(&producerFunction, &info);
+
+            joinThread(producer);
+            joinThread(consumer);
+
+            ASSERT(info.d_isValid);
+            ASSERT(X.isEmpty());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // RESERVE, COMMIT, PEEK, AND RELEASE
+        //
+        // Concerns:
+        //: 1 Messages are consumed in the order in which they were committed,
+        //:   with the committed lengths and contents.
+        //:
+        //: 2 Only the committed prefix of a reservation is published, and a
+        //:   reservation may be replaced before it is committed.
+        //:
+        //: 3 'reserve' returns 0 when there is insufficient free space, and
+        //:   succeeds once enough space is released.
+        //:
+        //: 4 A reservation that does not fit before the end of the memory
+        //:   block is placed at its start, and the consumer skips the unused
+        //:   bytes.
+        //:
+        //: 5 Reserved and peeked addresses are 8-byte aligned.
+        //:
+        //: 6 'peek' returns the same message until it is released, and 0 when
+        //:   the ring is empty.
+        //:
+        //: 7 'isEmpty' and 'numBytesInUse' reflect the committed messages that
+        //:   have not been released.
+        //:
+        //: 8 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Commit and consume single messages of every length up to
+        //:   'maxReservation()' in a small ring, so that messages are placed
+        //:   at every offset, and verify the lengths, contents, alignment,
+        //:   and accessors.  (C-1, 4..7)
+        //:
+        //: 2 Reserve more bytes than are committed, and replace a
+        //:   reservation, and verify the messages consumed.  (C-2)
+        //:
+        //: 3 Fill a ring until 'reserve' fails, and verify that releasing a
+        //:   message allows a reservation to succeed.  (C-3)
+        //:
+        //: 4 Commit a message that does not fit before the end of the memory
+        //:   block, and verify its address and the space it uses.  (C-4)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-8)
+        //
+        // Testing:
+        //   char *reserve(bsl::size_t numBytes);
+        //   void commit(bsl::size_t numBytes);
+        //   const char *peek(bsl::size_t *numBytes);
+        //   void release();
+        //   bool isEmpty() const;
+        //   bsl::size_t numBytesInUse() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RESERVE, COMMIT, PEEK, AND RELEASE" << endl
+                          << "==================================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        if (verbose) cout << "\tSingle messages of every length." << endl;
+        {
+            Obj mX(128, &ta);  const Obj& X = mX;
+
+            const bsl::size_t MAX = X.maxReservation();
+            ASSERT(56 == MAX);
+
+            int sequence = 0;
+            for (int round = 0; round < 10; ++round) {
+                for (bsl::size_t length = 0; length <= MAX; ++length) {
+                    char *message = mX.reserve(length);
+                    ASSERTV(round, length, message);
+                    ASSERTV(round, length,
+                            0 == reinterpret_cast<UintPtr>(message) % 8);
+
+                    fillMessage(message, length, sequence);
+                    mX.commit(length);
+
+                    ASSERTV(round, length, !X.isEmpty());
+                    ASSERTV(round, length, X.numBytesInUse() >= 8 + length);
+                    ASSERTV(round, length, X.numBytesInUse() <= X.capacity());
+
+                    bsl::size_t  numBytes = 999;
+                    const char  *peeked   = mX.peek(&numBytes);
+                    ASSERTV(round, length, message == peeked);
+                    ASSERTV(round, length, numBytes, length == numBytes);
+                    ASSERTV(round, length,
+                            checkMessage(peeked, numBytes, sequence));
+
+                    numBytes = 999;
+                    ASSERTV(round, length, peeked == mX.peek(&numBytes));
+                    ASSERTV(round, length, length == numBytes);
+
+                    mX.release();
+                    ASSERTV(round, length, X.isEmpty());
+                    ASSERTV(round, length, 0 == X.numBytesInUse());
+
+                    numBytes = 999;
+                    ASSERTV(round, length, 0 == mX.peek(&numBytes));
+                    ASSERTV(round, length, 999 == numBytes);
+
+                    ++sequence;
+                }
+            }
+        }
+
+        if (verbose) cout << "\tPartial commits and replacement." << endl;
+        {
+            Obj mX(128, &ta);  const Obj& X = mX;
+
+            char *message = mX.reserve(40);
+            ASSERT(message);
+            bsl::memcpy(message, "abc", 3);
+            mX.commit(3);
+            ASSERT(16 == X.numBytesInUse());
+
+            message = mX.reserve(40);
+            ASSERT(message);
+            message = mX.reserve(8);
+            ASSERT(message);
+            bsl::memcpy(message, "defghijk", 8);
+            mX.commit(8);
+            ASSERT(32 == X.numBytesInUse());
+
+            bsl::size_t  numBytes;
+            const char  *peeked = mX.peek(&numBytes);
+            ASSERT(3 == numBytes);
+            ASSERT(0 == bsl::memcmp(peeked, "abc", 3));
+            mX.release();
+
+            peeked = mX.peek(&numBytes);
+            ASSERT(8 == numBytes);
+            ASSERT(0 == bsl::memcmp(peeked, "defghijk", 8));
+            mX.release();
+            ASSERT(X.isEmpty());
+        }
+
+        if (verbose) cout << "\tFull ring." << endl;
+        {
+            Obj mX(128, &ta);  const Obj& X = mX;
+
+            // Each 24-byte message occupies 32 bytes.
+
+            for (int i = 0; i < 4; ++i) {
+                char *message = mX.reserve(24);
+                ASSERTV(i, message);
+                fillMessage(message, 24, i);
+                mX.commit(24);
+            }
+            ASSERT(128 == X.numBytesInUse());
+            ASSERT(0   == mX.reserve(0));
+            ASSERT(0   == mX.reserve(24));
+
+            bsl::size_t  numBytes;
+            const char  *peeked = mX.peek(&numBytes);
+            ASSERT(checkMessage(peeked, numBytes, 0));
+            mX.release();
+            ASSERT(96 == X.numBytesInUse());
+
+            // The ring wraps exactly at the end of the memory block.
+
+            char *message = mX.reserve(24);
+            ASSERT(message == peeked);
+            fillMessage(message, 24, 4);
+            mX.commit(24);
+            ASSERT(0 == mX.reserve(0));
+
+            for (int i = 1; i <= 4; ++i) {
+                peeked = mX.peek(&numBytes);
+                ASSERTV(i, peeked);
+                ASSERTV(i, 24 == numBytes);
+                ASSERTV(i, checkMessage(peeked, numBytes, i));
+                mX.release();
+            }
+            ASSERT(X.isEmpty());
+        }
+
+        if (verbose) cout << "\tSkipping the end of the block." << endl;
+        {
+            Obj mX(128, &ta);  const Obj& X = mX;
+
+            // Advance the positions to offset 96.
+
+            for (int i = 0; i < 3; ++i) {
+                ASSERTV(i, mX.reserve(24));
+                mX.commit(24);
+
+                bsl::size_t numBytes;
+                ASSERTV(i, mX.peek(&numBytes));
+                mX.release();
+            }
+
+            // A 40-byte message (48 bytes with its header) does not fit in the
+            // remaining 32 bytes, so it is placed at the start of the block,
+            // using 80 bytes of free space in all.
+
+            char *first = mX.reserve(0);
+            ASSERT(first);
+
+            char *message = mX.reserve(40);
+            ASSERT(message);
+            ASSERT(message == first - 96);
+            fillMessage(message, 40, 7);
+            mX.commit(40);
+            ASSERT(80 == X.numBytesInUse());
+
+            // A further 48 bytes are free.
+
+            ASSERT(0 != mX.reserve(40));
+            ASSERT(0 == mX.reserve(41));
+            mX.commit(0);
+            ASSERT(88 == X.numBytesInUse());
+
+            bsl::size_t  numBytes;
+            const char  *peeked = mX.peek(&numBytes);
+            ASSERT(message == peeked);
+            ASSERT(40      == numBytes);
+            ASSERT(checkMessage(peeked, numBytes, 7));
+            mX.release();
+            ASSERT(8 == X.numBytesInUse());
+
+            peeked = mX.peek(&numBytes);
+            ASSERT(peeked);
+            ASSERT(0 == numBytes);
+            mX.release();
+            ASSERT(X.isEmpty());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(128, &ta);
+
+            ASSERT_SAFE_FAIL(mX.reserve(57));
+            ASSERT_SAFE_FAIL(mX.commit(0));
+
+            ASSERT_SAFE_PASS(mX.reserve(56));
+            ASSERT_SAFE_FAIL(mX.commit(57));
+            ASSERT_SAFE_PASS(mX.commit(56));
+
+            bsl::size_t numBytes;
+            ASSERT_SAFE_FAIL(mX.release());
+            ASSERT_SAFE_FAIL(mX.peek(0));
+            ASSERT_SAFE_PASS(mX.peek(&numBytes));
+            ASSERT_SAFE_PASS(mX.release());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CONSTRUCTOR AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 The capacity is the least power of two, and at least 64, not
+        //:   less than the requested capacity.
+        //:
+        //: 2 The allocator supplied at construction (or the default allocator)
+        //:   supplies a single block of 'capacity()' bytes, which is released
+        //:   on destruction.
+        //:
+        //: 3 'maxReservation' is half the capacity, less the size of a
+        //:   header.
+        //:
+        //: 4 A new ring is empty.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create rings of a variety of capacities, with and without an
+        //:   allocator, and verify the accessors and the memory allocated.
+        //:   (C-1..4)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a zero capacity.  (C-5)
+        //
+        // Testing:
+        //   explicit SpscRingBuffer(bsl::size_t capacity, Allocator *ba = 0);
+        //   ~SpscRingBuffer();
+        //   bslma::Allocator *allocator() const;
+        //   bsl::size_t capacity() const;
+        //   bsl::size_t maxReservation() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONSTRUCTOR AND BASIC ACCESSORS" << endl
+                          << "===============================" << endl;
+
+        static const struct {
+            int         d_line;
+            bsl::size_t d_capacity;
+            bsl::size_t d_expected;
+        } DATA[] = {
+            //LINE  CAPACITY  EXPECTED
+            //----  --------  --------
+            { L_,          1,       64 },
+            { L_,         63,       64 },
+            { L_,         64,       64 },
+            { L_,         65,      128 },
+            { L_,       1000,     1024 },
+            { L_,       4096,     4096 },
+            { L_,       4097,     8192 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE     = DATA[ti].d_line;
+            const bsl::size_t CAPACITY = DATA[ti].d_capacity;
+            const bsl::size_t EXPECTED = DATA[ti].d_expected;
+
+            {
+                Obj mX(CAPACITY, &ta);  const Obj& X = mX;
+
+                ASSERTV(LINE, EXPECTED == X.capacity());
+                ASSERTV(LINE, EXPECTED / 2 - 8 == X.maxReservation());
+                ASSERTV(LINE, &ta == X.allocator());
+                ASSERTV(LINE, 1 == ta.numBlocksInUse());
+                ASSERTV(LINE, static_cast<bsls::Types::Int64>(EXPECTED)
+                                                      == ta.numBytesInUse());
+                ASSERTV(LINE, X.isEmpty());
+                ASSERTV(LINE, 0 == X.numBytesInUse());
+            }
+            ASSERTV(LINE, 0 == ta.numBlocksInUse());
+        }
+
+        {
+            Obj mX(100);  const Obj& X = mX;
+
+            ASSERT(128 == X.capacity());
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(1 == defaultAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_FAIL(Obj(0, &ta));
+            ASSERT_PASS(Obj(1, &ta));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Commit and consume a few messages.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(256, &ta);  const Obj& X = mX;
+
+            ASSERT(256 == X.capacity());
+            ASSERT(X.isEmpty());
+
+            char *message = mX.reserve(5);
+            ASSERT(message);
+            bsl::memcpy(message, "hello", 5);
+            mX.commit(5);
+
+            message = mX.reserve(5);
+            ASSERT(message);
+            bsl::memcpy(message, "world", 5);
+            mX.commit(5);
+
+            ASSERT(!X.isEmpty());
+
+            bsl::size_t  numBytes;
+            const char  *peeked = mX.peek(&numBytes);
+            ASSERT(peeked);
+            ASSERT(5 == numBytes);
+            ASSERT(0 == bsl::memcmp(peeked, "hello", 5));
+            mX.release();
+
+            peeked = mX.peek(&numBytes);
+            ASSERT(peeked);
+            ASSERT(5 == numBytes);
+            ASSERT(0 == bsl::memcmp(peeked, "world", 5));
+            mX.release();
+
+            ASSERT(X.isEmpty());
+            ASSERT(0 == mX.peek(&numBytes));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: THROUGHPUT
+        //
+        // Concerns:
+        //: 1 Messages pass from the producer to the consumer at a high rate.
+        //
+        // Plan:
+        //: 1 For several message lengths, pass a (specified on the command
+        //:   line, default 1000000) number of messages from a producer thread
+        //:   to a consumer thread through a 64KB ring, and report the elapsed
+        //:   time and the number of messages and bytes transferred per
+        //:   second.
+        //
+        // Testing:
+        //   PERFORMANCE: THROUGHPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: THROUGHPUT" << endl
+                          << "=======================" << endl;
+
+        using namespace BenchmarkCase;
+
+        const int NUM_MESSAGES = argc > 2 ? atoi(argv[2]) : 1000000;
+
+        bslma::Allocator *alloc = &bslma::NewDeleteAllocator::singleton();
+
+        const bsl::size_t LENGTHS[]   = { 16, 64, 256, 1024 };
+        const int         NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        for (int li = 0; li < NUM_LENGTHS; ++li) {
+            Obj mX(64 * 1024, alloc);
+
+            ThreadInfo info = { &mX, NUM_MESSAGES, LENGTHS[li], 0 };
+
+            bsls::Stopwatch timer;
+            timer.start();
+
+            ThreadId consumer = createThread(&benchmarkConsumer, &info);
+            ThreadId producer = createThread(&benchmarkProducer, &info);
+
+            joinThread(producer);
+            joinThread(consumer);
+
+            timer.stop();
+
+            ASSERTV(info.d_sum, 2L * NUM_MESSAGES == info.d_sum);
+
+            const double elapsed = timer.elapsedTime();
+            const double rate    = elapsed > 0 ? NUM_MESSAGES / elapsed : 0;
+
+            cout << LENGTHS[li] << "-byte messages: " << elapsed << "s, "
+                 << rate << " messages/s, "
+                 << rate * LENGTHS[li] / (1024 * 1024) << " MB/s" << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
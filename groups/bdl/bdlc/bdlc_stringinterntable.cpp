@@ -0,0 +1,142 @@
+// bdlc_stringinterntable.cpp                                         -*-C++-*-
+#include <bdlc_stringinterntable.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlc_stringinterntable_cpp,"$Id$ $CSID$")
+
+#include <bsls_alignmentfromtype.h>
+
+#include <bsl_ostream.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                            // --------------------
+                            // class InternedString
+                            // --------------------
+
+// FREE OPERATORS
+bsl::ostream& operator<<(bsl::ostream& stream, const InternedString& string)
+{
+    return stream.write(string.data(),
+                        static_cast<native_std::streamsize>(string.length()));
+}
+
+                          // -----------------------
+                          // class StringInternTable
+                          // -----------------------
+
+// PRIVATE ACCESSORS
+InternedString StringInternTable::findRaw(
+                                      const StringInternTable_Rep& key) const
+{
+    bslalg::BidirectionalLink *link = d_table.find(&key);
+
+    return link ? InternedString(static_cast<Node *>(link)->value())
+                : InternedString();
+}
+
+// CREATORS
+StringInternTable::StringInternTable(bslma::Allocator *basicAllocator)
+: d_lock()
+, d_arena(basicAllocator)
+, d_table(StringInternTable_Hasher(),
+          StringInternTable_Comparator(),
+          0,
+          1.0f,
+          basicAllocator)
+{
+}
+
+StringInternTable::~StringInternTable()
+{
+}
+
+// MANIPULATORS
+InternedString StringInternTable::intern(const bslstl::StringRef& string)
+{
+    StringInternTable_Rep key;
+    key.d_hash   = bslh::Hash<>()(string);
+    key.d_length = string.length();
+    key.d_data_p = string.data();
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    InternedString result = findRaw(key);
+    if (!result.isNull()) {
+        return result;                                                // RETURN
+    }
+
+    // Allocate the representation and the characters in a single block whose
+    // size is a multiple of the alignment of 'StringInternTable_Rep', so that
+    // the (naturally aligning) arena aligns the representation suitably.  If
+    // the insertion below throws, the block is reclaimed when this table is
+    // destroyed.
+
+    enum { k_REP_ALIGNMENT =
+                      bsls::AlignmentFromType<StringInternTable_Rep>::VALUE };
+
+    const bsl::size_t size = (sizeof(StringInternTable_Rep) + key.d_length + 1
+                                                        + k_REP_ALIGNMENT - 1)
+                           & ~static_cast<bsl::size_t>(k_REP_ALIGNMENT - 1);
+
+    StringInternTable_Rep *rep = static_cast<StringInternTable_Rep *>(
+                                                      d_arena.allocate(size));
+
+    char *data = reinterpret_cast<char *>(rep + 1);
+    if (key.d_length) {
+        bsl::memcpy(data, key.d_data_p, key.d_length);
+    }
+    data[key.d_length] = '\0';
+
+    rep->d_hash   = key.d_hash;
+    rep->d_length = key.d_length;
+    rep->d_data_p = data;
+
+    bool isInserted;
+    d_table.insertIfMissing(&isInserted,
+                            static_cast<const StringInternTable_Rep *>(rep));
+
+    BSLS_ASSERT(isInserted);
+
+    return InternedString(rep);
+}
+
+// ACCESSORS
+InternedString StringInternTable::find(const bslstl::StringRef& string) const
+{
+    StringInternTable_Rep key;
+    key.d_hash   = bslh::Hash<>()(string);
+    key.d_length = string.length();
+    key.d_data_p = string.data();
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    return findRaw(key);
+}
+
+bsl::size_t StringInternTable::numStrings() const
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_table.size();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,596 @@
+// bdlc_stringinterntable.h                                          -*-C++-*-
+#ifndef INCLUDED_BDLC_STRINGINTERNTABLE
+#define INCLUDED_BDLC_STRINGINTERNTABLE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a thread-safe table of interned, immutable strings.
+//
+//@CLASSES:
+//  bdlc::StringInternTable: thread-safe table of unique, immutable strings
+//  bdlc::InternedString: handle to a string in a 'bdlc::StringInternTable'
+//  bdlc::InternedStringHash: hash functor returning the precomputed hash
+//
+//@SEE_ALSO: bslstl_hashtable, bslh_hash, bdlma_sequentialallocator
+//
+//@DESCRIPTION: This component provides a mechanism,
+// 'bdlc::StringInternTable', that stores a single immutable copy of each
+// distinct string supplied to its 'intern' method, and a value-semantic
+// handle, 'bdlc::InternedString', that refers to such a copy.
+//
+// An application that holds the same string values in many objects (e.g.,
+// identifiers repeated across millions of records) can store a single pointer
+// sized 'bdlc::InternedString' in each object instead of a 'bsl::string'.
+// Because equal strings interned in the same table share a single copy:
+//
+//: o Two handles obtained from the same table are equal if and only if they
+//:   refer to the same copy, so 'operator==' compares a single pointer,
+//:   independent of the length of the string.
+//:
+//: o The hash of each string is computed (using 'bslh::Hash<>') once, when the
+//:   string is first interned, and is available from the handle thereafter.
+//:   'bdlc::InternedStringHash' returns that value, so that it may be used as
+//:   the hash functor of an unordered container keyed by 'InternedString'.
+//
+// The characters of each string are stored, null-terminated, in memory
+// obtained from a 'bdlma::SequentialAllocator' owned by the table, and are
+// released only when the table is destroyed.  A handle, and the
+// 'bslstl::StringRef' it returns, remain valid for the lifetime of the table
+// from which the handle was obtained.  The behavior of comparing handles
+// obtained from different tables is undefined.
+//
+// A default-constructed 'bdlc::InternedString' is *null*: it refers to no
+// string, compares equal only to another null handle, and provides an empty
+// 'bslstl::StringRef'.  Note that a null handle is distinct from a handle to
+// an interned empty string.
+//
+///Thread Safety
+///-------------
+// 'bdlc::StringInternTable' is *fully thread-safe*, meaning that all
+// non-creator operations on a given object can be safely invoked
+// simultaneously from multiple threads.  'bdlc::InternedString' is
+// *const* *thread-safe*; since a handle refers to immutable data, handles
+// referring to the same string can be used simultaneously from multiple
+// threads without synchronization.
+//
+// Note that, as 'bslmt' is not available at this level, the table is guarded
+// by a 'bsls::BslLock'.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Interning Identifiers Repeated Across Many Records
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we load a large number of trade records, each of which refers to a
+// venue and an account by name, and the same few names occur in many records.
+//
+// First, we define the record, storing each name as a
+// 'bdlc::InternedString':
+//..
+//  struct TradeRecord {
+//      bdlc::InternedString d_venue;
+//      bdlc::InternedString d_account;
+//      double               d_quantity;
+//  };
+//..
+// Then, we create a table to intern the names:
+//..
+//  bdlc::StringInternTable table;
+//..
+// Next, we load some records, interning the names as they are parsed:
+//..
+//  const char *VENUES[]   = { "XNYS", "XNAS", "BATS" };
+//  const char *ACCOUNTS[] = { "ACCOUNT-000000000000000000000001",
+//                             "ACCOUNT-000000000000000000000002" };
+//
+//  bsl::vector<TradeRecord> records;
+//  for (int i = 0; i < 1000; ++i) {
+//      TradeRecord record;
+//      record.d_venue    = table.intern(VENUES[i % 3]);
+//      record.d_account  = table.intern(ACCOUNTS[i % 2]);
+//      record.d_quantity = i;
+//      records.push_back(record);
+//  }
+//..
+// Now, we observe that only 5 strings are stored, and that records having the
+// same venue refer to the same copy of its name:
+//..
+//  assert(5 == table.numStrings());
+//
+//  assert(records[0].d_venue == records[3].d_venue);
+//  assert(records[0].d_venue.data() == records[3].d_venue.data());
+//  assert(records[0].d_venue != records[1].d_venue);
+//  assert("XNYS" == records[0].d_venue.stringRef());
+//..
+// Finally, we find the records for a venue, looking it up once and then
+// comparing handles rather than characters:
+//..
+//  const bdlc::InternedString venue = table.find("XNAS");
+//  assert(!venue.isNull());
+//
+//  int count = 0;
+//  for (bsl::size_t i = 0; i < records.size(); ++i) {
+//      if (venue == records[i].d_venue) {
+//          ++count;
+//      }
+//  }
+//  assert(333 == count);
+//
+//  assert(table.find("XLON").isNull());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_SEQUENTIALALLOCATOR
+#include <bdlma_sequentialallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_BIDIRECTIONALNODE
+#include <bslalg_bidirectionalnode.h>
+#endif
+
+#ifndef INCLUDED_BSLH_HASH
+#include <bslh_hash.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
+#include <bslmf_isbitwisemoveable.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_HASHTABLE
+#include <bslstl_hashtable.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STRINGREF
+#include <bslstl_stringref.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTRING
+#include <bsl_cstring.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOSFWD
+#include <bsl_iosfwd.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+class StringInternTable;
+
+                        // ============================
+                        // struct StringInternTable_Rep
+                        // ============================
+
+struct StringInternTable_Rep {
+    // This component-private 'struct' describes a string interned in a
+    // 'StringInternTable'.  The characters of an interned string are stored,
+    // null-terminated, immediately following this 'struct' in the same block
+    // of memory.
+
+    // DATA
+    bsl::size_t  d_hash;    // hash of the string, computed by 'bslh::Hash<>'
+    bsl::size_t  d_length;  // number of characters, excluding the terminator
+    const char  *d_data_p;  // address of the (null-terminated) characters
+};
+
+                    // ==================================
+                    // struct StringInternTable_KeyConfig
+                    // ==================================
+
+struct StringInternTable_KeyConfig {
+    // This component-private 'struct' provides the 'KEY_CONFIG' of the
+    // 'bslstl::HashTable' used by 'StringInternTable', whose elements are
+    // (also) their keys.
+
+    // TYPES
+    typedef const StringInternTable_Rep *KeyType;
+    typedef const StringInternTable_Rep *ValueType;
+
+    // CLASS METHODS
+    static const KeyType& extractKey(const ValueType& value);
+        // Return a reference providing non-modifiable access to the specified
+        // 'value'.
+};
+
+                    // ===============================
+                    // struct StringInternTable_Hasher
+                    // ===============================
+
+struct StringInternTable_Hasher {
+    // This component-private 'struct' provides the hash functor of the
+    // 'bslstl::HashTable' used by 'StringInternTable'.
+
+    // ACCESSORS
+    bsl::size_t operator()(const StringInternTable_Rep *rep) const;
+        // Return the precomputed hash of the string described by the
+        // specified 'rep'.
+};
+
+                  // ===================================
+                  // struct StringInternTable_Comparator
+                  // ===================================
+
+struct StringInternTable_Comparator {
+    // This component-private 'struct' provides the equality comparator of the
+    // 'bslstl::HashTable' used by 'StringInternTable'.
+
+    // ACCESSORS
+    bool operator()(const StringInternTable_Rep *lhs,
+                    const StringInternTable_Rep *rhs) const;
+        // Return 'true' if the strings described by the specified 'lhs' and
+        // 'rhs' have the same value, and 'false' otherwise.
+};
+
+                            // ====================
+                            // class InternedString
+                            // ====================
+
+class InternedString {
+    // This value-semantic class provides a handle to an immutable string
+    // interned in a 'StringInternTable', or no string (a *null* handle).  Two
+    // handles obtained from the same table have the same value if and only if
+    // they refer to strings having the same value.
+
+    // DATA
+    const StringInternTable_Rep *d_rep_p;  // interned string, or 0 if null
+
+    // FRIENDS
+    friend class StringInternTable;
+    friend bool operator==(const InternedString&, const InternedString&);
+    friend bool operator!=(const InternedString&, const InternedString&);
+
+  private:
+    // PRIVATE CREATORS
+    explicit InternedString(const StringInternTable_Rep *rep);
+        // Create a handle to the interned string described by the specified
+        // 'rep'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(InternedString, bslmf::IsBitwiseMoveable);
+
+    // CREATORS
+    InternedString();
+        // Create a null handle.
+
+    //! InternedString(const InternedString& original) = default;
+        // Create a handle to the same string as the specified 'original'.
+
+    //! ~InternedString() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    //! InternedString& operator=(const InternedString& rhs) = default;
+        // Make this handle refer to the same string as the specified 'rhs',
+        // and return a reference providing modifiable access to this object.
+
+    // ACCESSORS
+    bool isNull() const;
+        // Return 'true' if this handle refers to no string, and 'false'
+        // otherwise.
+
+    const char *data() const;
+        // Return the address of the null-terminated characters of the string
+        // referred to by this handle, or 0 if this handle is null.
+
+    bsl::size_t length() const;
+        // Return the number of characters (excluding the null terminator) in
+        // the string referred to by this handle, or 0 if this handle is null.
+
+    bsl::size_t hash() const;
+        // Return the hash of the string referred to by this handle, as
+        // computed by 'bslh::Hash<>' when the string was interned.  The
+        // behavior is undefined if this handle is null.
+
+    bslstl::StringRef stringRef() const;
+        // Return a reference to the string referred to by this handle, or an
+        // empty reference if this handle is null.
+};
+
+// FREE OPERATORS
+bool operator==(const InternedString& lhs, const InternedString& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' handles have the same
+    // value, and 'false' otherwise.  Two handles have the same value if they
+    // refer to the same interned string, or are both null.  The behavior is
+    // undefined unless 'lhs' and 'rhs' are null or were obtained from the same
+    // 'StringInternTable'.
+
+bool operator!=(const InternedString& lhs, const InternedString& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' handles do not have the
+    // same value, and 'false' otherwise.  Two handles do not have the same
+    // value if they refer to different interned strings, or only one of them
+    // is null.  The behavior is undefined unless 'lhs' and 'rhs' are null or
+    // were obtained from the same 'StringInternTable'.
+
+bsl::ostream& operator<<(bsl::ostream& stream, const InternedString& string);
+    // Write the characters of the string referred to by the specified 'string'
+    // handle (nothing if it is null) to the specified output 'stream', and
+    // return a reference to 'stream'.
+
+// FREE FUNCTIONS
+template <class HASHALG>
+void hashAppend(HASHALG& hashAlg, const InternedString& string);
+    // Pass the precomputed hash of the specified 'string' handle (or 0 if it
+    // is null) to the specified 'hashAlg'.
+
+                         // =========================
+                         // struct InternedStringHash
+                         // =========================
+
+struct InternedStringHash {
+    // This 'struct' provides a hash functor that returns the precomputed hash
+    // of an 'InternedString', for use by unordered containers keyed by
+    // 'InternedString'.
+
+    // ACCESSORS
+    bsl::size_t operator()(const InternedString& string) const;
+        // Return the precomputed hash of the specified 'string' handle, or 0
+        // if it is null.
+};
+
+                          // =======================
+                          // class StringInternTable
+                          // =======================
+
+class StringInternTable {
+    // This class implements a thread-safe table of unique, immutable strings,
+    // handing out an 'InternedString' handle for each.  Equal strings interned
+    // in the same table share a single copy.
+
+    // PRIVATE TYPES
+    typedef bslstl::HashTable<StringInternTable_KeyConfig,
+                              StringInternTable_Hasher,
+                              StringInternTable_Comparator> Table;
+
+    typedef bslalg::BidirectionalNode<const StringInternTable_Rep *> Node;
+
+    // DATA
+    mutable bsls::BslLock      d_lock;   // guards the data members below
+
+    bdlma::SequentialAllocator d_arena;  // supplies the interned strings
+
+    Table                      d_table;  // set of interned strings
+
+  private:
+    // NOT IMPLEMENTED
+    StringInternTable(const StringInternTable&);
+    StringInternTable& operator=(const StringInternTable&);
+
+    // PRIVATE ACCESSORS
+    InternedString findRaw(const StringInternTable_Rep& key) const;
+        // Return a handle to the string in this table having the same value
+        // as that described by the specified 'key', or a null handle if there
+        // is no such string.  The behavior is undefined unless 'd_lock' is
+        // held by the calling thread.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(StringInternTable,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    StringInternTable(bslma::Allocator *basicAllocator = 0);
+        // Create an empty string intern table.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    ~StringInternTable();
+        // Destroy this table, releasing the memory of all interned strings.
+        // The behavior is undefined if any handle obtained from this table is
+        // used after this table is destroyed.
+
+    // MANIPULATORS
+    InternedString intern(const bslstl::StringRef& string);
+        // Return a handle to the string in this table having the same value
+        // as the specified 'string', first adding a copy of 'string' to this
+        // table if there is no such string.  This method is thread-safe.
+
+    // ACCESSORS
+    InternedString find(const bslstl::StringRef& string) const;
+        // Return a handle to the string in this table having the same value
+        // as the specified 'string', or a null handle if there is no such
+        // string.  This method is thread-safe.
+
+    bsl::size_t numStrings() const;
+        // Return the number of (distinct) strings in this table.  This method
+        // is thread-safe.
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this table to supply memory.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                    // ----------------------------------
+                    // struct StringInternTable_KeyConfig
+                    // ----------------------------------
+
+// CLASS METHODS
+inline
+const StringInternTable_KeyConfig::KeyType&
+StringInternTable_KeyConfig::extractKey(const ValueType& value)
+{
+    return value;
+}
+
+                    // -------------------------------
+                    // struct StringInternTable_Hasher
+                    // -------------------------------
+
+// ACCESSORS
+inline
+bsl::size_t
+StringInternTable_Hasher::operator()(const StringInternTable_Rep *rep) const
+{
+    return rep->d_hash;
+}
+
+                  // -----------------------------------
+                  // struct StringInternTable_Comparator
+                  // -----------------------------------
+
+// ACCESSORS
+inline
+bool StringInternTable_Comparator::operator()(
+                                       const StringInternTable_Rep *lhs,
+                                       const StringInternTable_Rep *rhs) const
+{
+    return lhs->d_hash   == rhs->d_hash
+        && lhs->d_length == rhs->d_length
+        && 0 == bsl::memcmp(lhs->d_data_p, rhs->d_data_p, lhs->d_length);
+}
+
+                            // --------------------
+                            // class InternedString
+                            // --------------------
+
+// PRIVATE CREATORS
+inline
+InternedString::InternedString(const StringInternTable_Rep *rep)
+: d_rep_p(rep)
+{
+}
+
+// CREATORS
+inline
+InternedString::InternedString()
+: d_rep_p(0)
+{
+}
+
+// ACCESSORS
+inline
+bool InternedString::isNull() const
+{
+    return 0 == d_rep_p;
+}
+
+inline
+const char *InternedString::data() const
+{
+    return d_rep_p ? d_rep_p->d_data_p : 0;
+}
+
+inline
+bsl::size_t InternedString::length() const
+{
+    return d_rep_p ? d_rep_p->d_length : 0;
+}
+
+inline
+bsl::size_t InternedString::hash() const
+{
+    BSLS_ASSERT_SAFE(d_rep_p);
+
+    return d_rep_p->d_hash;
+}
+
+inline
+bslstl::StringRef InternedString::stringRef() const
+{
+    return d_rep_p
+           ? bslstl::StringRef(d_rep_p->d_data_p,
+                               static_cast<int>(d_rep_p->d_length))
+           : bslstl::StringRef();
+}
+
+                         // -------------------------
+                         // struct InternedStringHash
+                         // -------------------------
+
+// ACCESSORS
+inline
+bsl::size_t
+InternedStringHash::operator()(const InternedString& string) const
+{
+    return string.isNull() ? 0 : string.hash();
+}
+
+                          // -----------------------
+                          // class StringInternTable
+                          // -----------------------
+
+// ACCESSORS
+inline
+bslma::Allocator *StringInternTable::allocator() const
+{
+    return d_table.allocator().mechanism();
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+inline
+bool bdlc::operator==(const InternedString& lhs, const InternedString& rhs)
+{
+    return lhs.d_rep_p == rhs.d_rep_p;
+}
+
+inline
+bool bdlc::operator!=(const InternedString& lhs, const InternedString& rhs)
+{
+    return lhs.d_rep_p != rhs.d_rep_p;
+}
+
+// FREE FUNCTIONS
+template <class HASHALG>
+inline
+void bdlc::hashAppend(HASHALG& hashAlg, const InternedString& string)
+{
+    using ::BloombergLP::bslh::hashAppend;
+    hashAppend(hashAlg, InternedStringHash()(string));
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
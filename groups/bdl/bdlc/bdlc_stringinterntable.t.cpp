@@ -0,0 +1,919 @@
+// bdlc_stringinterntable.t.cpp                                       -*-C++-*-
+#include <bdlc_stringinterntable.h>
+
+#include <bdls_testutil.h>
+
+#include <bslh_hash.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_isbitwisemoveable.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_unordered_map.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test provides a mechanism that stores a single copy of
+// each distinct string interned in it, and a handle to such a copy.  The
+// primary concerns are that interning equal strings yields equal handles
+// (referring to the same characters) and interning distinct strings yields
+// distinct handles, that the characters and precomputed hash are preserved,
+// that handles remain valid as the table grows, that all memory is supplied
+// by the table's allocator, and that the table may be used concurrently from
+// multiple threads.  We use 'bslma::TestAllocator' to verify the memory
+// behavior and exception neutrality, and 'pthread' (or the Windows thread
+// API) to exercise the table from multiple threads.
+//-----------------------------------------------------------------------------
+// InternedString
+// [ 2] InternedString();
+// [ 2] bool isNull() const;
+// [ 2] const char *data() const;
+// [ 2] bsl::size_t length() const;
+// [ 2] bsl::size_t hash() const;
+// [ 2] bslstl::StringRef stringRef() const;
+// [ 2] bool operator==(const InternedString&, const InternedString&);
+// [ 2] bool operator!=(const InternedString&, const InternedString&);
+// [ 2] ostream& operator<<(ostream&, const InternedString&);
+// [ 2] void hashAppend(HASHALG& hashAlg, const InternedString& string);
+// [ 2] bsl::size_t InternedStringHash::operator()(const InternedString&);
+//
+// StringInternTable
+// [ 3] StringInternTable(bslma::Allocator *basicAllocator = 0);
+// [ 3] ~StringInternTable();
+// [ 3] InternedString intern(const bslstl::StringRef& string);
+// [ 3] InternedString find(const bslstl::StringRef& string) const;
+// [ 3] bsl::size_t numStrings() const;
+// [ 3] bslma::Allocator *allocator() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] EXCEPTION NEUTRALITY
+// [ 5] CONCURRENT INTERNING
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: 'InternedString' VS. 'bsl::string' KEYS
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlc::StringInternTable  Obj;
+typedef bdlc::InternedString     Handle;
+typedef bdlc::InternedStringHash HandleHash;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+bsl::string makeKey(int i)
+    // Return a distinct string, of a length typical of an identifier, for the
+    // specified 'i'.
+{
+    char buffer[64];
+    bsl::sprintf(buffer, "IDENTIFIER-%024d", i);
+    return bsl::string(buffer);
+}
+
+namespace TestCase5 {
+
+enum {
+    k_NUM_THREADS = 4,
+    k_NUM_KEYS    = 2000
+};
+
+struct ThreadInfo {
+    Obj    *d_obj_p;                  // table shared by all threads
+    int     d_threadIndex;            // index of this thread
+    Handle  d_handles[k_NUM_KEYS];    // handles obtained by this thread
+};
+
+extern "C" void *threadFunction(void *arg)
+    // Intern each of 'k_NUM_KEYS' keys in the table referred to by the
+    // specified 'arg', starting at a thread-specific offset, and record the
+    // resulting handles.
+{
+    ThreadInfo& info = *static_cast<ThreadInfo *>(arg);
+
+    const int offset = info.d_threadIndex * (k_NUM_KEYS / k_NUM_THREADS);
+
+    for (int i = 0; i < k_NUM_KEYS; ++i) {
+        const int k = (i + offset) % k_NUM_KEYS;
+        info.d_handles[k] = info.d_obj_p->intern(makeKey(k));
+    }
+    return 0;
+}
+
+}  // close namespace TestCase5
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Interning Identifiers Repeated Across Many Records
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we load a large number of trade records, each of which refers to a
+// venue and an account by name, and the same few names occur in many records.
+//
+// First, we define the record, storing each name as a
+// 'bdlc::InternedString':
+//..
+    struct TradeRecord {
+        bdlc::InternedString d_venue;
+        bdlc::InternedString d_account;
+        double               d_quantity;
+    };
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we create a table to intern the names:
+//..
+    bdlc::StringInternTable table;
+//..
+// Next, we load some records, interning the names as they are parsed:
+//..
+    const char *VENUES[]   = { "XNYS", "XNAS", "BATS" };
+    const char *ACCOUNTS[] = { "ACCOUNT-000000000000000000000001",
+                               "ACCOUNT-000000000000000000000002" };
+
+    bsl::vector<TradeRecord> records;
+    for (int i = 0; i < 1000; ++i) {
+        TradeRecord record;
+        record.d_venue    = table.intern(VENUES[i % 3]);
+        record.d_account  = table.intern(ACCOUNTS[i % 2]);
+        record.d_quantity = i;
+        records.push_back(record);
+    }
+//..
+// Now, we observe that only 5 strings are stored, and that records having the
+// same venue refer to the same copy of its name:
+//..
+    ASSERT(5 == table.numStrings());
+
+    ASSERT(records[0].d_venue == records[3].d_venue);
+    ASSERT(records[0].d_venue.data() == records[3].d_venue.data());
+    ASSERT(records[0].d_venue != records[1].d_venue);
+    ASSERT("XNYS" == records[0].d_venue.stringRef());
+//..
+// Finally, we find the records for a venue, looking it up once and then
+// comparing handles rather than characters:
+//..
+    const bdlc::InternedString venue = table.find("XNAS");
+    ASSERT(!venue.isNull());
+
+    int count = 0;
+    for (bsl::size_t i = 0; i < records.size(); ++i) {
+        if (venue == records[i].d_venue) {
+            ++count;
+        }
+    }
+    ASSERT(333 == count);
+
+    ASSERT(table.find("XLON").isNull());
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCURRENT INTERNING
+        //
+        // Concerns:
+        //: 1 Strings may be interned in a table concurrently from multiple
+        //:   threads.
+        //:
+        //: 2 Every thread obtains the same handle for a given string, and
+        //:   exactly one copy of each string is stored.
+        //
+        // Plan:
+        //: 1 Create several threads that each intern the same set of strings,
+        //:   starting at different offsets so that the threads contend for
+        //:   both new and existing strings.  Verify that all threads obtained
+        //:   identical handles having the expected values, and that the table
+        //:   holds one copy of each string.  (C-1..2)
+        //
+        // Testing:
+        //   CONCURRENT INTERNING
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT INTERNING" << endl
+                          << "====================" << endl;
+
+        using namespace TestCase5;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        for (int iteration = 0; iteration < 10; ++iteration) {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ThreadInfo info[k_NUM_THREADS];
+            ThreadId   ids[k_NUM_THREADS];
+
+            for (int t = 0; t < k_NUM_THREADS; ++t) {
+                info[t].d_obj_p       = &mX;
+                info[t].d_threadIndex = t;
+                ids[t] = createThread(&threadFunction, &info[t]);
+            }
+            for (int t = 0; t < k_NUM_THREADS; ++t) {
+                joinThread(ids[t]);
+            }
+
+            ASSERTV(iteration, X.numStrings(),
+                    k_NUM_KEYS == X.numStrings());
+
+            for (int k = 0; k < k_NUM_KEYS; ++k) {
+                const Handle& H = info[0].d_handles[k];
+
+                ASSERTV(iteration, k, makeKey(k) == H.stringRef());
+                ASSERTV(iteration, k, H == X.find(makeKey(k)));
+
+                for (int t = 1; t < k_NUM_THREADS; ++t) {
+                    ASSERTV(iteration, k, t, H == info[t].d_handles[k]);
+                }
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // EXCEPTION NEUTRALITY
+        //
+        // Concerns:
+        //: 1 If an allocation fails while interning a string, the exception
+        //:   propagates to the caller and the table is unchanged.
+        //:
+        //: 2 Handles obtained before the exception remain valid.
+        //:
+        //: 3 No memory is leaked.
+        //
+        // Plan:
+        //: 1 Intern a number of strings, large enough to force the table to
+        //:   rehash, within the 'BSLMA_TESTALLOCATOR_EXCEPTION_TEST_*' macros.
+        //:   On each iteration, verify that the table holds exactly the
+        //:   strings interned before the exception, and that the
+        //:   previously obtained handles are unchanged.  (C-1..2)
+        //:
+        //: 2 Verify that all memory is returned to the allocator.  (C-3)
+        //
+        // Testing:
+        //   EXCEPTION NEUTRALITY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EXCEPTION NEUTRALITY" << endl
+                          << "====================" << endl;
+
+        const int NUM_KEYS = 100;
+
+        bsl::vector<bsl::string> keys;
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            keys.push_back(makeKey(i));
+        }
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            Handle handles[NUM_KEYS];
+
+            for (int i = 0; i < NUM_KEYS; ++i) {
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                    ASSERTV(i, X.numStrings(), i == (int)X.numStrings());
+                    ASSERTV(i, X.find(keys[i]).isNull());
+
+                    handles[i] = mX.intern(keys[i]);
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+                ASSERTV(i, i + 1 == (int)X.numStrings());
+
+                for (int j = 0; j <= i; ++j) {
+                    ASSERTV(i, j, keys[j] == handles[j].stringRef());
+                    ASSERTV(i, j, handles[j] == X.find(keys[j]));
+                }
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // INTERN AND FIND
+        //
+        // Concerns:
+        //: 1 Interning a string not in the table adds a null-terminated copy
+        //:   of it, and returns a handle to the copy having the hash computed
+        //:   by 'bslh::Hash<>'.
+        //:
+        //: 2 Interning a string already in the table returns the same handle,
+        //:   and does not allocate memory.
+        //:
+        //: 3 Strings that differ only in their length, or that contain null
+        //:   characters, are distinct.  The empty string may be interned.
+        //:
+        //: 4 'find' returns the handle to an interned string, or a null handle
+        //:   if the string has not been interned, and does not allocate.
+        //:
+        //: 5 Handles, and the characters they refer to, remain valid as the
+        //:   table grows.
+        //:
+        //: 6 All memory is supplied by the allocator passed at construction,
+        //:   and is released when the table is destroyed.
+        //
+        // Plan:
+        //: 1 Using a table-driven technique, intern a set of strings including
+        //:   the empty string, prefixes of each other, and strings containing
+        //:   null characters, and verify the returned handles.  (C-1, 3)
+        //:
+        //: 2 Intern each string again and verify that the same handle is
+        //:   returned, and no memory is allocated.  Verify 'find' for interned
+        //:   and non-interned strings.  (C-2, 4)
+        //:
+        //: 3 Intern a large number of strings, forcing the table to rehash
+        //:   several times, then verify the handles obtained at the start.
+        //:   (C-5)
+        //:
+        //: 4 Use a test allocator to verify the source of memory, and that no
+        //:   memory is leaked.  (C-6)
+        //
+        // Testing:
+        //   StringInternTable(bslma::Allocator *basicAllocator = 0);
+        //   ~StringInternTable();
+        //   InternedString intern(const bslstl::StringRef& string);
+        //   InternedString find(const bslstl::StringRef& string) const;
+        //   bsl::size_t numStrings() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INTERN AND FIND" << endl
+                          << "===============" << endl;
+
+        static const struct {
+            int         d_line;     // source line number
+            const char *d_data_p;   // string characters
+            int         d_length;   // number of characters
+        } DATA[] = {
+            //LINE  DATA               LENGTH
+            //----  -----------------  ------
+            { L_,   "",                     0 },
+            { L_,   "a",                    1 },
+            { L_,   "ab",                   2 },
+            { L_,   "abc",                  3 },
+            { L_,   "b",                    1 },
+            { L_,   "\0",                   1 },
+            { L_,   "\0\0",                 2 },
+            { L_,   "a\0",                  2 },
+            { L_,   "a\0b",                 3 },
+            { L_,   "abcdefghijklmnopq",   17 },
+            { L_,   "abcdefghijklmnopr",   17 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        bslma::TestAllocator da("default", veryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        if (verbose) cout << "\tDefault and supplied allocators." << endl;
+        {
+            Obj mX;
+            ASSERT(&da == mX.allocator());
+
+            Obj mY(&sa);
+            ASSERT(&sa == mY.allocator());
+        }
+        ASSERT(0 == da.numBlocksInUse());
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+        ASSERT(0 == sa.numBlocksTotal());
+
+        if (verbose) cout << "\tInterning distinct strings." << endl;
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            ASSERT(0 == X.numStrings());
+
+            Handle handles[NUM_DATA];
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int                LINE = DATA[ti].d_line;
+                const bslstl::StringRef  STRING(DATA[ti].d_data_p,
+                                                DATA[ti].d_length);
+
+                ASSERTV(LINE, X.find(STRING).isNull());
+
+                handles[ti] = mX.intern(STRING);
+
+                const Handle& H = handles[ti];
+
+                ASSERTV(LINE, !H.isNull());
+                ASSERTV(LINE, STRING == H.stringRef());
+                ASSERTV(LINE, STRING.data() != H.data());
+                ASSERTV(LINE, STRING.length() == H.length());
+                ASSERTV(LINE, '\0' == H.data()[H.length()]);
+                ASSERTV(LINE, bslh::Hash<>()(STRING) == H.hash());
+                ASSERTV(LINE, ti + 1 == (int)X.numStrings());
+
+                for (int tj = 0; tj < ti; ++tj) {
+                    ASSERTV(LINE, tj, handles[tj] != H);
+                }
+            }
+
+            if (verbose) cout << "\tInterning existing strings." << endl;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int                LINE = DATA[ti].d_line;
+                const bsl::string        COPY(DATA[ti].d_data_p,
+                                              DATA[ti].d_length);
+
+                const bsls::Types::Int64 NUM_BLOCKS = sa.numBlocksTotal();
+
+                const Handle H = mX.intern(COPY);
+
+                ASSERTV(LINE, NUM_BLOCKS == sa.numBlocksTotal());
+                ASSERTV(LINE, handles[ti] == H);
+                ASSERTV(LINE, handles[ti].data() == H.data());
+                ASSERTV(LINE, handles[ti] == X.find(COPY));
+                ASSERTV(LINE, NUM_DATA == (int)X.numStrings());
+            }
+
+            ASSERT(X.find("abcd").isNull());
+            ASSERT(X.find("c").isNull());
+            ASSERT(X.find(bslstl::StringRef("a\0c", 3)).isNull());
+
+            if (verbose) cout << "\tInterning many strings." << endl;
+
+            const int NUM_KEYS = 5000;
+
+            for (int i = 0; i < NUM_KEYS; ++i) {
+                const Handle H = mX.intern(makeKey(i));
+                ASSERTV(i, makeKey(i) == H.stringRef());
+            }
+            ASSERT(NUM_DATA + NUM_KEYS == (int)X.numStrings());
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int                LINE = DATA[ti].d_line;
+                const bslstl::StringRef  STRING(DATA[ti].d_data_p,
+                                                DATA[ti].d_length);
+
+                ASSERTV(LINE, STRING == handles[ti].stringRef());
+                ASSERTV(LINE, handles[ti] == X.find(STRING));
+            }
+            for (int i = 0; i < NUM_KEYS; ++i) {
+                const Handle H = X.find(makeKey(i));
+                ASSERTV(i, !H.isNull());
+                ASSERTV(i, H == mX.intern(makeKey(i)));
+            }
+
+            ASSERT(0 <  sa.numBlocksInUse());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // INTERNEDSTRING
+        //
+        // Concerns:
+        //: 1 A default-constructed handle is null, has an empty 'stringRef',
+        //:   and compares equal only to another null handle.
+        //:
+        //: 2 Copies of a handle compare equal to it, and handles to distinct
+        //:   strings compare unequal.
+        //:
+        //: 3 'operator<<' writes the characters of the string.
+        //:
+        //: 4 'hashAppend' and 'InternedStringHash' are based on the
+        //:   precomputed hash, so that 'bslh::Hash<>' and 'InternedStringHash'
+        //:   are usable as hash functors of unordered containers.
+        //:
+        //: 5 'InternedString' is bitwise moveable and does not use an
+        //:   allocator; 'StringInternTable' uses an allocator.
+        //
+        // Plan:
+        //: 1 Verify the accessors and operators of null handles, and of
+        //:   handles obtained from a table.  (C-1..3)
+        //:
+        //: 2 Verify the hash values, and use handles as keys of a
+        //:   'bsl::unordered_map'.  (C-4)
+        //:
+        //: 3 Verify the traits.  (C-5)
+        //
+        // Testing:
+        //   InternedString();
+        //   bool isNull() const;
+        //   const char *data() const;
+        //   bsl::size_t length() const;
+        //   bsl::size_t hash() const;
+        //   bslstl::StringRef stringRef() const;
+        //   bool operator==(const InternedString&, const InternedString&);
+        //   bool operator!=(const InternedString&, const InternedString&);
+        //   ostream& operator<<(ostream&, const InternedString&);
+        //   void hashAppend(HASHALG& hashAlg, const InternedString& string);
+        //   bsl::size_t InternedStringHash::operator()(const InternedString&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INTERNEDSTRING" << endl
+                          << "==============" << endl;
+
+        if (verbose) cout << "\tTraits." << endl;
+
+        ASSERT( bslmf::IsBitwiseMoveable<Handle>::value);
+        ASSERT(!bslma::UsesBslmaAllocator<Handle>::value);
+        ASSERT( bslma::UsesBslmaAllocator<Obj>::value);
+
+        if (verbose) cout << "\tNull handles." << endl;
+        {
+            const Handle N;
+
+            ASSERT(N.isNull());
+            ASSERT(0 == N.data());
+            ASSERT(0 == N.length());
+            ASSERT(N.stringRef().isEmpty());
+            ASSERT(0 == HandleHash()(N));
+
+            const Handle M(N);
+            ASSERT(  N == M);
+            ASSERT(!(N != M));
+
+            bsl::ostringstream oss;
+            oss << N;
+            ASSERT("" == oss.str());
+        }
+
+        if (verbose) cout << "\tHandles to interned strings." << endl;
+        {
+            bslma::TestAllocator ta("object", veryVeryVerbose);
+
+            Obj mX(&ta);
+
+            const Handle N;
+            const Handle A = mX.intern("alpha");
+            const Handle B = mX.intern("beta");
+            const Handle E = mX.intern("");
+
+            ASSERT(!A.isNull());
+            ASSERT(!E.isNull());
+            ASSERT(0 == bsl::strcmp("alpha", A.data()));
+            ASSERT(5 == A.length());
+            ASSERT(0 == E.length());
+            ASSERT(0 != E.data());
+
+            ASSERT(A == A);  ASSERT(!(A != A));
+            ASSERT(A != B);  ASSERT(!(A == B));
+            ASSERT(A != N);  ASSERT(!(A == N));
+            ASSERT(E != N);  ASSERT(!(E == N));
+
+            Handle mC;  const Handle& C = mC;
+            mC = B;
+            ASSERT(B == C);
+            ASSERT(B.data() == C.data());
+
+            bsl::ostringstream oss;
+            oss << A << ':' << B;
+            ASSERT("alpha:beta" == oss.str());
+
+            if (verbose) cout << "\tHashing." << endl;
+
+            ASSERT(bslh::Hash<>()(bslstl::StringRef("alpha")) == A.hash());
+            ASSERT(A.hash() == HandleHash()(A));
+
+            bslh::Hash<> hasher;
+            ASSERT(hasher(A) == hasher(mX.intern("alpha")));
+            ASSERT(hasher(A) == hasher(A.hash()));
+
+            bsl::unordered_map<Handle, int, HandleHash> map(&ta);
+            map[A] = 1;
+            map[B] = 2;
+            map[mX.intern("alpha")] += 10;
+
+            ASSERT(2  == map.size());
+            ASSERT(11 == map[A]);
+            ASSERT(2  == map[C]);
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Intern a few strings, and verify the handles and the table.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(0 == X.numStrings());
+            ASSERT(X.find("hello").isNull());
+
+            const Handle H1 = mX.intern("hello");
+            const Handle H2 = mX.intern("world");
+            const Handle H3 = mX.intern(bsl::string("hello"));
+
+            ASSERT(2 == X.numStrings());
+            ASSERT(H1 == H3);
+            ASSERT(H1 != H2);
+            ASSERT("hello" == H1.stringRef());
+            ASSERT("world" == H2.stringRef());
+            ASSERT(H1 == X.find("hello"));
+            ASSERT(H2 == X.find("world"));
+
+            if (veryVerbose) {
+                P_(H1) P(H2)
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'InternedString' VS. 'bsl::string' KEYS
+        //
+        // Concerns:
+        //: 1 Looking up, and comparing, interned handles is faster than doing
+        //:   so with 'bsl::string' keys of the same value.
+        //
+        // Plan:
+        //: 1 Build unordered maps keyed by 'bsl::string' and by
+        //:   'InternedString' having the same (specified on the command line,
+        //:   default 10000) number of identifier-like keys, and report the
+        //:   time taken to look up every key many times.
+        //:
+        //: 2 Report the time taken to compare each key with every other key.
+        //
+        // Testing:
+        //   PERFORMANCE: 'InternedString' VS. 'bsl::string' KEYS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: 'InternedString' VS. 'bsl::string'"
+                          << " KEYS" << endl
+                          << "==============================================="
+                          << "=====" << endl;
+
+        const int NUM_KEYS   = argc > 2 ? atoi(argv[2]) : 10000;
+        const int NUM_PASSES = 100;
+
+        bslma::Allocator *alloc = &bslma::NewDeleteAllocator::singleton();
+
+        Obj table(alloc);
+
+        bsl::vector<bsl::string> strings(alloc);
+        bsl::vector<Handle>      handles(alloc);
+
+        bsl::unordered_map<bsl::string, int>     stringMap(alloc);
+        bsl::unordered_map<Handle, int, HandleHash> handleMap(alloc);
+
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            strings.push_back(makeKey(i));
+            handles.push_back(table.intern(strings.back()));
+            stringMap[strings.back()] = i;
+            handleMap[handles.back()] = i;
+        }
+
+        bsls::Stopwatch timer;
+        long            sum = 0;
+
+        timer.start();
+        for (int pass = 0; pass < NUM_PASSES; ++pass) {
+            for (int i = 0; i < NUM_KEYS; ++i) {
+                sum += stringMap.find(strings[i])->second;
+            }
+        }
+        timer.stop();
+        cout << "lookup, bsl::string keys:          " << timer.elapsedTime()
+             << "s" << endl;
+
+        timer.reset();
+        timer.start();
+        for (int pass = 0; pass < NUM_PASSES; ++pass) {
+            for (int i = 0; i < NUM_KEYS; ++i) {
+                sum += handleMap.find(handles[i])->second;
+            }
+        }
+        timer.stop();
+        cout << "lookup, bdlc::InternedString keys: " << timer.elapsedTime()
+             << "s" << endl;
+
+        const int NUM_COMPARED = NUM_KEYS < 2000 ? NUM_KEYS : 2000;
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_COMPARED; ++i) {
+            for (int j = 0; j < NUM_COMPARED; ++j) {
+                sum += strings[i] == strings[j];
+            }
+        }
+        timer.stop();
+        cout << "compare, bsl::string:              " << timer.elapsedTime()
+             << "s" << endl;
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_COMPARED; ++i) {
+            for (int j = 0; j < NUM_COMPARED; ++j) {
+                sum += handles[i] == handles[j];
+            }
+        }
+        timer.stop();
+        cout << "compare, bdlc::InternedString:     " << timer.elapsedTime()
+             << "s" << endl;
+
+        if (veryVerbose) {
+            P(sum);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
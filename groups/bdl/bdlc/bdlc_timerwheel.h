@@ -0,0 +1,763 @@
+// bdlc_timerwheel.h                                                  -*-C++-*-
+#ifndef INCLUDED_BDLC_TIMERWHEEL
+#define INCLUDED_BDLC_TIMERWHEEL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a hierarchical timing wheel for large numbers of timeouts.
+//
+//@CLASSES:
+//  bdlc::TimerWheel: set of timers expired in batches by advancing a clock
+//
+//@SEE_ALSO: bdlc_indexedheap, bdlma_pool
+//
+//@DESCRIPTION: This component provides a class template, 'bdlc::TimerWheel',
+// that holds a set of timers, each having a deadline and an associated value
+// of the (template parameter) 'VALUE' (for example, a session identifier).
+// Timers are scheduled, rescheduled, and cancelled in constant time, through
+// the handle returned when the timer is scheduled, and are expired in batches
+// by advancing the clock of the wheel: 'advance' appends to a vector the
+// values of all timers whose deadlines have been reached.
+//
+// A timer wheel is preferable to a priority queue or an ordered map (whose
+// operations take 'O(log N)' time) for workloads, such as session heartbeats
+// and order expiries, in which most timers are cancelled or rescheduled
+// before they expire, and timers need only expire with a bounded resolution.
+//
+///Time and Resolution
+///-------------------
+// Deadlines are supplied either as a 'bsls::TimeInterval', or as a number of
+// nanoseconds on the same scale (for example, the values returned by
+// 'bsls::TimeUtil::getTimer'); the same scale must be used for all deadlines
+// and for the clock of a wheel, and neither may be negative.  The clock of a
+// new wheel is 0, and only moves forward.
+//
+// Time is measured in *ticks* of the resolution supplied at construction.  A
+// deadline is rounded up to a whole tick, and the clock is rounded down, so
+// that a timer never expires before its deadline, and expires at most one tick
+// after it (assuming that the clock is advanced at least once per tick).
+// Timers expire in the order of the ticks of their deadlines; the order in
+// which timers having the same tick expire is unspecified.  A timer scheduled
+// with a deadline that has already been reached expires on the next call to
+// 'advance'.
+//
+///Implementation Notes
+///--------------------
+// Timers are held in 11 levels of 64 slots, each slot holding a
+// doubly-linked list of timers.  Level 'L' covers deadlines that agree with
+// the current tick in all but the lowest '6 * (L + 1)' bits, and a timer is
+// placed in the slot of its level selected by the 6 bits of its deadline at
+// that level.  Advancing the clock expires the timers in the slots of level 0
+// that it passes, and redistributes ("cascades") the timers of a slot of a
+// higher level to lower levels when the clock enters that slot.  A bit mask of
+// the occupied slots of each level allows 'advance' to skip over empty slots,
+// so that advancing the clock over a long idle period takes time proportional
+// to the number of occupied slots passed, rather than to the number of ticks.
+//
+// Each timer is held in a node of fixed size obtained from a 'bdlma::Pool',
+// so that scheduling and cancelling timers does not (after the pool has grown
+// to the number of pending timers) allocate or release memory.
+//
+///Thread Safety
+///-------------
+// 'bdlc::TimerWheel' is *not* thread-safe: a single wheel must not be used
+// concurrently by more than one thread.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Expiring Idle Sessions
+///- - - - - - - - - - - - - - - - -
+// Suppose that a server disconnects sessions that have been idle for 30
+// seconds, and that every message received on a session postpones its expiry.
+//
+// First, we create a wheel with a resolution of 10 milliseconds, whose values
+// are session identifiers:
+//..
+//  typedef bdlc::TimerWheel<int> Wheel;
+//
+//  Wheel wheel(bsls::TimeInterval(0.01));
+//
+//  const bsls::TimeInterval IDLE_TIMEOUT(30, 0);
+//..
+// Then, at time 100 seconds, we open three sessions, retaining the handle of
+// the timer of each:
+//..
+//  bsls::TimeInterval now(100, 0);
+//
+//  Wheel::Handle handles[3];
+//  for (int session = 0; session < 3; ++session) {
+//      handles[session] = wheel.schedule(now + IDLE_TIMEOUT, session);
+//  }
+//  assert(3 == wheel.numTimers());
+//..
+// Next, 20 seconds later, session 1 receives a message, postponing its
+// expiry, and session 2 is closed by its client:
+//..
+//  now += bsls::TimeInterval(20, 0);
+//  bsl::vector<int> expired;
+//  assert(0 == wheel.advance(now, &expired));
+//
+//  wheel.reschedule(handles[1], now + IDLE_TIMEOUT);
+//  wheel.cancel(handles[2]);
+//..
+// Now, 15 seconds later, only session 0 has been idle for 30 seconds:
+//..
+//  now += bsls::TimeInterval(15, 0);
+//  assert(1 == wheel.advance(now, &expired));
+//  assert(0 == expired[0]);
+//..
+// Finally, after a further 15 seconds, session 1 expires as well:
+//..
+//  expired.clear();
+//  now += bsls::TimeInterval(15, 0);
+//  assert(1 == wheel.advance(now, &expired));
+//  assert(1 == expired[0]);
+//  assert(wheel.isEmpty());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLB_BITUTIL
+#include <bdlb_bitutil.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_POOL
+#include <bdlma_pool.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARDESTRUCTIONPRIMITIVES
+#include <bslalg_scalardestructionprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARPRIMITIVES
+#include <bslalg_scalarprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEALLOCATORPROCTOR
+#include <bslma_deallocatorproctor.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_OBJECTBUFFER
+#include <bsls_objectbuffer.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TIMEINTERVAL
+#include <bsls_timeinterval.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                           // ======================
+                           // struct TimerWheel_Node
+                           // ======================
+
+template <class VALUE>
+struct TimerWheel_Node {
+    // This component-private 'struct' provides a timer of a timer wheel, held
+    // in the doubly-linked list of a slot.
+
+    // DATA
+    TimerWheel_Node           *d_next_p;  // next timer in the slot, or 0
+
+    TimerWheel_Node           *d_prev_p;  // previous timer in the slot, or 0
+
+    bsls::Types::Int64         d_tick;    // deadline, in ticks
+
+    int                        d_slot;    // index of the slot holding this
+                                          // timer
+
+    bsls::ObjectBuffer<VALUE>  d_value;   // value of this timer
+};
+
+                              // ================
+                              // class TimerWheel
+                              // ================
+
+template <class VALUE>
+class TimerWheel {
+    // This class template implements a set of timers, each having a deadline
+    // and a value of the (template parameter) 'VALUE', organized as a
+    // hierarchical timing wheel, so that timers are scheduled, rescheduled,
+    // and cancelled in constant time, and expired in batches by advancing the
+    // clock of the wheel.  'VALUE' must be copy-constructible.
+
+  public:
+    // PUBLIC TYPES
+    typedef TimerWheel_Node<VALUE> *Handle;
+        // Identifies a pending timer.  A handle is valid from the time it is
+        // returned by 'schedule' until the timer expires or is cancelled.
+
+  private:
+    // PRIVATE TYPES
+    typedef TimerWheel_Node<VALUE>  Node;
+    typedef bsls::Types::Int64      Int64;
+    typedef bdlb::BitUtil::uint64_t uint64_t;
+
+    enum {
+        k_SLOT_BITS       = 6,                  // bits selecting a slot
+
+        k_SLOTS_PER_LEVEL = 1 << k_SLOT_BITS,   // slots in each level
+
+        k_NUM_LEVELS      = 11,                 // levels needed to cover all
+                                                // non-negative 'Int64' ticks
+
+        k_NUM_SLOTS       = k_NUM_LEVELS * k_SLOTS_PER_LEVEL,
+
+        k_DUE_SLOT        = k_NUM_SLOTS         // index of the list of timers
+                                                // that have reached their
+                                                // deadlines
+    };
+
+    // DATA
+    Node             *d_slots[k_NUM_SLOTS + 1];  // head of the list of each
+                                                 // slot, followed by that of
+                                                 // the due timers
+
+    Node             *d_dueTail_p;               // last due timer, or 0
+
+    uint64_t          d_occupied[k_NUM_LEVELS];  // bit 'i' of element 'L' is
+                                                 // set if slot 'i' of level
+                                                 // 'L' is not empty
+
+    Int64             d_now;                     // current tick
+
+    Int64             d_resolution;              // nanoseconds per tick
+
+    bsl::size_t       d_numTimers;               // number of pending timers
+
+    bdlma::Pool       d_pool;                    // supplies nodes
+
+    bslma::Allocator *d_allocator_p;             // memory allocator (held,
+                                                 // not owned)
+
+    // NOT IMPLEMENTED
+    TimerWheel(const TimerWheel&);
+    TimerWheel& operator=(const TimerWheel&);
+
+    // PRIVATE MANIPULATORS
+    Node *createNode(Int64 tick, const VALUE& value);
+        // Return the address of a new timer having the specified 'tick' and
+        // holding a copy of the specified 'value'.  The timer is not linked
+        // into any slot.
+
+    void destroyNode(Node *node);
+        // Destroy the value of the specified 'node', and return 'node' to the
+        // pool.
+
+    void destroyAll();
+        // Destroy all pending timers.
+
+    void link(Node *node);
+        // Insert the specified 'node' into the slot selected by its deadline
+        // relative to the current tick, or append it to the due timers if
+        // its deadline has been reached.
+
+    void unlink(Node *node);
+        // Remove the specified 'node' from its slot.
+
+    // PRIVATE ACCESSORS
+    Int64 toTick(Int64 nanoseconds) const;
+        // Return the tick of the deadline specified as 'nanoseconds', rounded
+        // up.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(TimerWheel, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit TimerWheel(const bsls::TimeInterval&  resolution,
+                        bslma::Allocator          *basicAllocator = 0);
+        // Create an empty timer wheel whose clock is 0, and that measures
+        // time in ticks of the specified 'resolution'.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless 'resolution' is positive.
+
+    ~TimerWheel();
+        // Destroy this object, destroying the values of all pending timers.
+
+    // MANIPULATORS
+    int advance(const bsls::TimeInterval&  now,
+                bsl::vector<VALUE>        *expired);
+    int advanceNanoseconds(bsls::Types::Int64  now,
+                           bsl::vector<VALUE> *expired);
+        // Advance the clock of this wheel to the specified 'now' (rounded down
+        // to a tick), append to the specified 'expired' vector the values of
+        // all timers whose deadlines have been reached, in the order of their
+        // deadlines, remove those timers, and return the number of values
+        // appended.  If 'now' precedes the current clock, the clock is not
+        // changed.  If an exception is thrown while appending to 'expired',
+        // the timers whose values were not appended remain pending, and are
+        // expired by the next call to 'advance'.  The behavior is undefined
+        // unless '0 <= now'.
+
+    void cancel(Handle handle);
+        // Remove the timer identified by the specified 'handle' without
+        // expiring it.  The behavior is undefined unless 'handle' identifies
+        // a pending timer of this wheel.
+
+    void clear();
+        // Remove all pending timers without expiring them.  Note that the
+        // clock is not changed.
+
+    void reschedule(Handle handle, const bsls::TimeInterval& deadline);
+    void rescheduleNanoseconds(Handle handle, bsls::Types::Int64 deadline);
+        // Change the deadline of the timer identified by the specified
+        // 'handle' to the specified 'deadline'.  The handle remains valid.
+        // The behavior is undefined unless 'handle' identifies a pending timer
+        // of this wheel, and '0 <= deadline'.
+
+    void reserveCapacity(int numTimers);
+        // Reserve memory for at least the specified 'numTimers' additional
+        // timers, so that scheduling them does not allocate memory (except
+        // for the values of the timers).
+
+    Handle schedule(const bsls::TimeInterval& deadline, const VALUE& value);
+    Handle scheduleNanoseconds(bsls::Types::Int64  deadline,
+                               const VALUE&        value);
+        // Add a timer having the specified 'deadline' and 'value' to this
+        // wheel, and return its handle.  The behavior is undefined unless
+        // '0 <= deadline'.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this wheel to supply memory.
+
+    bsls::TimeInterval currentTime() const;
+        // Return the clock of this wheel, which is a whole number of ticks.
+
+    bool isEmpty() const;
+        // Return 'true' if this wheel has no pending timers, and 'false'
+        // otherwise.
+
+    bsl::size_t numTimers() const;
+        // Return the number of pending timers of this wheel.
+
+    bsls::TimeInterval resolution() const;
+        // Return the duration of a tick of this wheel.
+
+    const VALUE& value(Handle handle) const;
+        // Return a reference providing non-modifiable access to the value of
+        // the timer identified by the specified 'handle'.  The behavior is
+        // undefined unless 'handle' identifies a pending timer of this wheel.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                              // ----------------
+                              // class TimerWheel
+                              // ----------------
+
+// PRIVATE MANIPULATORS
+template <class VALUE>
+typename TimerWheel<VALUE>::Node *
+TimerWheel<VALUE>::createNode(Int64 tick, const VALUE& value)
+{
+    Node *node = static_cast<Node *>(d_pool.allocate());
+
+    bslma::DeallocatorProctor<bdlma::Pool> proctor(node, &d_pool);
+
+    bslalg::ScalarPrimitives::copyConstruct(&node->d_value.object(),
+                                            value,
+                                            d_allocator_p);
+    proctor.release();
+
+    node->d_tick = tick;
+    return node;
+}
+
+template <class VALUE>
+inline
+void TimerWheel<VALUE>::destroyNode(Node *node)
+{
+    bslalg::ScalarDestructionPrimitives::destroy(&node->d_value.object());
+    d_pool.deallocate(node);
+}
+
+template <class VALUE>
+void TimerWheel<VALUE>::destroyAll()
+{
+    for (int slot = 0; slot <= k_DUE_SLOT; ++slot) {
+        Node *node = d_slots[slot];
+        while (node) {
+            Node *next = node->d_next_p;
+            bslalg::ScalarDestructionPrimitives::destroy(
+                                                      &node->d_value.object());
+            node = next;
+        }
+        d_slots[slot] = 0;
+    }
+    for (int level = 0; level < k_NUM_LEVELS; ++level) {
+        d_occupied[level] = 0;
+    }
+    d_dueTail_p = 0;
+    d_numTimers = 0;
+
+    d_pool.release();
+}
+
+template <class VALUE>
+void TimerWheel<VALUE>::link(Node *node)
+{
+    if (node->d_tick <= d_now) {
+        // Append to the due timers, so that they expire in order.
+
+        node->d_slot   = k_DUE_SLOT;
+        node->d_next_p = 0;
+        node->d_prev_p = d_dueTail_p;
+        if (d_dueTail_p) {
+            d_dueTail_p->d_next_p = node;
+        }
+        else {
+            d_slots[k_DUE_SLOT] = node;
+        }
+        d_dueTail_p = node;
+        return;                                                       // RETURN
+    }
+
+    // The level is that of the highest group of 'k_SLOT_BITS' bits in which
+    // the deadline differs from the current tick.
+
+    const uint64_t diff  = static_cast<uint64_t>(node->d_tick ^ d_now);
+    const int      level = (63 - bdlb::BitUtil::numLeadingUnsetBits(diff))
+                         / k_SLOT_BITS;
+    const int      index = static_cast<int>(
+                                      (node->d_tick >> (level * k_SLOT_BITS))
+                                    & (k_SLOTS_PER_LEVEL - 1));
+    const int      slot  = level * k_SLOTS_PER_LEVEL + index;
+
+    d_occupied[level] |= static_cast<uint64_t>(1) << index;
+
+    node->d_slot   = slot;
+    node->d_prev_p = 0;
+    node->d_next_p = d_slots[slot];
+    if (node->d_next_p) {
+        node->d_next_p->d_prev_p = node;
+    }
+    d_slots[slot] = node;
+}
+
+template <class VALUE>
+void TimerWheel<VALUE>::unlink(Node *node)
+{
+    const int slot = node->d_slot;
+
+    if (node->d_prev_p) {
+        node->d_prev_p->d_next_p = node->d_next_p;
+    }
+    else {
+        d_slots[slot] = node->d_next_p;
+    }
+
+    if (node->d_next_p) {
+        node->d_next_p->d_prev_p = node->d_prev_p;
+    }
+    else if (k_DUE_SLOT == slot) {
+        d_dueTail_p = node->d_prev_p;
+    }
+
+    if (!d_slots[slot] && k_DUE_SLOT != slot) {
+        d_occupied[slot / k_SLOTS_PER_LEVEL] &=
+                ~(static_cast<uint64_t>(1) << (slot % k_SLOTS_PER_LEVEL));
+    }
+}
+
+// PRIVATE ACCESSORS
+template <class VALUE>
+inline
+typename TimerWheel<VALUE>::Int64
+TimerWheel<VALUE>::toTick(Int64 nanoseconds) const
+{
+    BSLS_ASSERT_SAFE(0 <= nanoseconds);
+
+    return nanoseconds / d_resolution + (0 != nanoseconds % d_resolution);
+}
+
+// CREATORS
+template <class VALUE>
+TimerWheel<VALUE>::TimerWheel(const bsls::TimeInterval&  resolution,
+                              bslma::Allocator          *basicAllocator)
+: d_dueTail_p(0)
+, d_now(0)
+, d_resolution(resolution.totalNanoseconds())
+, d_numTimers(0)
+, d_pool(static_cast<int>(sizeof(Node)), basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < d_resolution);
+
+    for (int slot = 0; slot <= k_DUE_SLOT; ++slot) {
+        d_slots[slot] = 0;
+    }
+    for (int level = 0; level < k_NUM_LEVELS; ++level) {
+        d_occupied[level] = 0;
+    }
+}
+
+template <class VALUE>
+inline
+TimerWheel<VALUE>::~TimerWheel()
+{
+    destroyAll();
+}
+
+// MANIPULATORS
+template <class VALUE>
+inline
+int TimerWheel<VALUE>::advance(const bsls::TimeInterval&  now,
+                               bsl::vector<VALUE>        *expired)
+{
+    return advanceNanoseconds(now.totalNanoseconds(), expired);
+}
+
+template <class VALUE>
+int TimerWheel<VALUE>::advanceNanoseconds(bsls::Types::Int64  now,
+                                          bsl::vector<VALUE> *expired)
+{
+    BSLS_ASSERT(0 <= now);
+    BSLS_ASSERT(expired);
+
+    const Int64 target = now / d_resolution;
+
+    // Move the clock from one occupied slot to the next, moving the timers
+    // that reach their deadlines to the due list, and cascading the timers of
+    // higher levels.  The lowest occupied slot of the lowest occupied level
+    // is always the next slot that the clock enters.
+
+    while (d_now < target) {
+        int level = 0;
+        while (level < k_NUM_LEVELS && !d_occupied[level]) {
+            ++level;
+        }
+        if (k_NUM_LEVELS == level) {
+            d_now = target;
+            break;
+        }
+
+        const int index = bdlb::BitUtil::numTrailingUnsetBits(
+                                                           d_occupied[level]);
+        const int shift = level * k_SLOT_BITS;
+
+        // The tick at which the clock enters the slot keeps the bits of the
+        // current tick above the level.
+
+        const Int64 prefix = shift + k_SLOT_BITS < 63
+                           ? (d_now >> (shift + k_SLOT_BITS))
+                                                   << (shift + k_SLOT_BITS)
+                           : 0;
+        const Int64 tick   = prefix | (static_cast<Int64>(index) << shift);
+
+        if (tick > target) {
+            d_now = target;
+            break;
+        }
+        d_now = tick;
+
+        const int slot = level * k_SLOTS_PER_LEVEL + index;
+        Node     *node = d_slots[slot];
+
+        d_slots[slot]      = 0;
+        d_occupied[level] &= ~(static_cast<uint64_t>(1) << index);
+
+        while (node) {
+            Node *next = node->d_next_p;
+            link(node);
+            node = next;
+        }
+    }
+
+    // Append the values of the due timers, removing each only once its value
+    // has been appended.
+
+    int numExpired = 0;
+    while (d_slots[k_DUE_SLOT]) {
+        Node *node = d_slots[k_DUE_SLOT];
+
+        expired->push_back(node->d_value.object());
+
+        unlink(node);
+        destroyNode(node);
+        --d_numTimers;
+        ++numExpired;
+    }
+    return numExpired;
+}
+
+template <class VALUE>
+inline
+void TimerWheel<VALUE>::cancel(Handle handle)
+{
+    BSLS_ASSERT_SAFE(handle);
+
+    unlink(handle);
+    destroyNode(handle);
+    --d_numTimers;
+}
+
+template <class VALUE>
+inline
+void TimerWheel<VALUE>::clear()
+{
+    destroyAll();
+}
+
+template <class VALUE>
+inline
+void TimerWheel<VALUE>::reschedule(Handle                    handle,
+                                   const bsls::TimeInterval& deadline)
+{
+    rescheduleNanoseconds(handle, deadline.totalNanoseconds());
+}
+
+template <class VALUE>
+inline
+void TimerWheel<VALUE>::rescheduleNanoseconds(Handle             handle,
+                                              bsls::Types::Int64 deadline)
+{
+    BSLS_ASSERT_SAFE(handle);
+
+    unlink(handle);
+    handle->d_tick = toTick(deadline);
+    link(handle);
+}
+
+template <class VALUE>
+inline
+void TimerWheel<VALUE>::reserveCapacity(int numTimers)
+{
+    d_pool.reserveCapacity(numTimers);
+}
+
+template <class VALUE>
+inline
+typename TimerWheel<VALUE>::Handle
+TimerWheel<VALUE>::schedule(const bsls::TimeInterval& deadline,
+                            const VALUE&              value)
+{
+    return scheduleNanoseconds(deadline.totalNanoseconds(), value);
+}
+
+template <class VALUE>
+inline
+typename TimerWheel<VALUE>::Handle
+TimerWheel<VALUE>::scheduleNanoseconds(bsls::Types::Int64  deadline,
+                                       const VALUE&        value)
+{
+    Node *node = createNode(toTick(deadline), value);
+
+    link(node);
+    ++d_numTimers;
+    return node;
+}
+
+// ACCESSORS
+template <class VALUE>
+inline
+bslma::Allocator *TimerWheel<VALUE>::allocator() const
+{
+    return d_allocator_p;
+}
+
+template <class VALUE>
+inline
+bsls::TimeInterval TimerWheel<VALUE>::currentTime() const
+{
+    bsls::TimeInterval result;
+    result.setTotalNanoseconds(d_now * d_resolution);
+    return result;
+}
+
+template <class VALUE>
+inline
+bool TimerWheel<VALUE>::isEmpty() const
+{
+    return 0 == d_numTimers;
+}
+
+template <class VALUE>
+inline
+bsl::size_t TimerWheel<VALUE>::numTimers() const
+{
+    return d_numTimers;
+}
+
+template <class VALUE>
+inline
+bsls::TimeInterval TimerWheel<VALUE>::resolution() const
+{
+    bsls::TimeInterval result;
+    result.setTotalNanoseconds(d_resolution);
+    return result;
+}
+
+template <class VALUE>
+inline
+const VALUE& TimerWheel<VALUE>::value(Handle handle) const
+{
+    BSLS_ASSERT_SAFE(handle);
+
+    return handle->d_value.object();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1004 @@
+// bdlc_timerwheel.t.cpp                                              -*-C++-*-
+#include <bdlc_timerwheel.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_map.h>
+#include <bsl_queue.h>
+#include <bsl_string.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a hierarchical timing wheel.  The primary
+// concerns are that advancing the clock expires exactly the timers whose
+// deadlines (rounded up to a tick) have been reached, in the order of their
+// ticks, never early, whatever the distances between the deadlines and the
+// clock, and however far the clock is advanced at once; that cancelled and
+// rescheduled timers are handled correctly; and that nodes are obtained from
+// the pool and values are destroyed.  We verify the expirations against a
+// reference model driven by pseudo-random operations spanning all levels of
+// the wheel.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] TimerWheel(const TimeInterval& resolution, Allocator *ba);
+// [ 2] ~TimerWheel();
+//
+// MANIPULATORS
+// [ 3] int advance(const TimeInterval& now, bsl::vector<VALUE> *expired);
+// [ 4] int advanceNanoseconds(Int64 now, bsl::vector<VALUE> *expired);
+// [ 2] void cancel(Handle handle);
+// [ 2] void clear();
+// [ 3] void reschedule(Handle handle, const TimeInterval& deadline);
+// [ 4] void rescheduleNanoseconds(Handle handle, Int64 deadline);
+// [ 2] void reserveCapacity(int numTimers);
+// [ 2] Handle schedule(const TimeInterval& deadline, const VALUE& value);
+// [ 4] Handle scheduleNanoseconds(Int64 deadline, const VALUE& value);
+//
+// ACCESSORS
+// [ 2] bslma::Allocator *allocator() const;
+// [ 4] bsls::TimeInterval currentTime() const;
+// [ 2] bool isEmpty() const;
+// [ 2] bsl::size_t numTimers() const;
+// [ 4] bsls::TimeInterval resolution() const;
+// [ 2] const VALUE& value(Handle handle) const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] EXCEPTION SAFETY OF 'advance'
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: COMPARISON WITH HEAP AND MAP
+//=============================================================================
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlc::TimerWheel<int> Obj;
+typedef Obj::Handle           Handle;
+typedef bsls::Types::Int64    Int64;
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+// ============================================================================
+//                     GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static Int64 nextRandom(bsls::Types::Uint64 *state)
+    // Return the next value of the 64-bit linear congruential sequence whose
+    // state is held by the specified 'state'.  The result is a non-negative
+    // 62-bit value.
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<Int64>(*state >> 2);
+}
+
+static Int64 randomDistance(bsls::Types::Uint64 *state, int maxBits)
+    // Return a pseudo-random, non-negative distance, in ticks, of fewer than
+    // the specified 'maxBits' bits, whose magnitude is spread over the
+    // corresponding levels of a timer wheel, using the specified 'state'.
+{
+    const int bits = static_cast<int>(nextRandom(state) % maxBits);
+    return nextRandom(state) & ((static_cast<Int64>(1) << bits) - 1);
+}
+
+static void testRandomOperations(int   line,
+                                 Int64 resolution,
+                                 int   maxBits,
+                                 int   numRounds)
+    // Apply the specified 'numRounds' rounds of pseudo-random schedules,
+    // reschedules, and cancellations to a wheel having the specified
+    // 'resolution' (in nanoseconds), each followed by an advance of the clock
+    // of pseudo-random length, and verify the expired timers against a
+    // reference model.  Distances between deadlines and the clock have fewer
+    // than the specified 'maxBits' bits.  Report failures using the specified
+    // 'line'.  The behavior is undefined unless the clock cannot overflow,
+    // i.e., 'numRounds * resolution << maxBits' is representable.
+{
+    bslma::TestAllocator ta("object", veryVeryVerbose);
+
+    Obj mX(bsls::TimeInterval(0, static_cast<int>(resolution)), &ta);
+    const Obj& X = mX;
+
+    bsl::vector<Handle> handles;    // indexed by timer id
+    bsl::vector<Int64>  deadlines;  // deadline tick of each timer, or -1
+    int                 numPending = 0;
+    Int64               nowTick    = 1000;
+
+    bsls::Types::Uint64 state = line;
+
+    for (int round = 0; round < numRounds; ++round) {
+        // Schedule some timers, with deadlines at all levels (and some in the
+        // past), and reschedule or cancel some pending ones.
+
+        const int numSchedules = static_cast<int>(nextRandom(&state) % 20);
+        for (int i = 0; i < numSchedules; ++i) {
+            const int   id       = static_cast<int>(handles.size());
+            const Int64 distance = randomDistance(&state, maxBits);
+            const Int64 deadline = nextRandom(&state) % 8
+                                 ? (nowTick + distance) * resolution
+                                   - static_cast<Int64>(
+                                            nextRandom(&state) % resolution)
+                                 : nowTick * resolution - distance % 1000;
+
+            handles.push_back(mX.scheduleNanoseconds(deadline, id));
+            deadlines.push_back(deadline / resolution
+                                + (0 != deadline % resolution));
+            ++numPending;
+        }
+
+        const int numChanges = static_cast<int>(nextRandom(&state) % 10);
+        for (int i = 0; i < numChanges && !handles.empty(); ++i) {
+            const int id = static_cast<int>(nextRandom(&state)
+                                            % handles.size());
+            if (deadlines[id] < 0) {
+                continue;
+            }
+            ASSERTV(line, round, id, id == X.value(handles[id]));
+
+            if (nextRandom(&state) % 2) {
+                mX.cancel(handles[id]);
+                deadlines[id] = -1;
+                --numPending;
+            }
+            else {
+                const Int64 distance = randomDistance(&state, maxBits);
+                const Int64 deadline = (nowTick + distance) * resolution;
+                mX.rescheduleNanoseconds(handles[id], deadline);
+                deadlines[id] = deadline / resolution;
+            }
+        }
+        ASSERTV(line, round, numPending == static_cast<int>(X.numTimers()));
+
+        // Advance the clock, sometimes by a tick, sometimes far.
+
+        const Int64 step = nextRandom(&state) % 4
+                         ? static_cast<Int64>(nextRandom(&state) % 100)
+                         : randomDistance(&state, maxBits);
+        nowTick += step;
+
+        bsl::vector<int> expired;
+        const int numExpired = mX.advanceNanoseconds(
+                         nowTick * resolution
+                                  + static_cast<Int64>(nextRandom(&state)
+                                                       % resolution),
+                         &expired);
+
+        ASSERTV(line, round, numExpired == static_cast<int>(expired.size()));
+
+        Int64 lastTick = -1;
+        for (bsl::size_t i = 0; i < expired.size(); ++i) {
+            const int id = expired[i];
+
+            ASSERTV(line, round, id, 0 <= deadlines[id]);
+            ASSERTV(line, round, id, deadlines[id] <= nowTick);
+
+            // Past-due timers (scheduled behind the clock) may expire before
+            // later ticks, but never after them.
+
+            const Int64 tick = bsl::max(deadlines[id],
+                                        nowTick - step);
+            ASSERTV(line, round, id, lastTick <= tick);
+            lastTick = tick;
+
+            deadlines[id] = -1;
+            --numPending;
+        }
+
+        for (bsl::size_t id = 0; id < deadlines.size(); ++id) {
+            ASSERTV(line, round, id, deadlines[id] > nowTick
+                                     || deadlines[id] < 0);
+        }
+        ASSERTV(line, round, numPending == static_cast<int>(X.numTimers()));
+
+        if (veryVeryVerbose) {
+            P_(round) P_(nowTick) P_(numExpired) P(X.numTimers())
+        }
+    }
+}
+
+                            // =================
+                            // struct Benchmarks
+                            // =================
+
+struct Benchmarks {
+    // This 'struct' provides a namespace for implementations of a common
+    // workload, in which each of a number of sessions holds one timeout that
+    // is usually rescheduled, and occasionally expires, using a timer wheel
+    // and the alternatives that it replaces.
+
+    typedef bsl::pair<Int64, int> Entry;  // deadline and session
+
+    enum {
+        k_TIMEOUT = 30000,  // ticks before a session expires
+        k_STEP    = 1       // ticks between operations
+    };
+
+    static Int64 runHeap(int numSessions, int numOperations);
+        // Run the workload using a 'bsl::priority_queue' with lazy removal of
+        // rescheduled timeouts, and return a checksum.
+
+    static Int64 runMap(int numSessions, int numOperations);
+        // Run the workload using a 'bsl::multimap', erasing rescheduled
+        // timeouts, and return a checksum.
+
+    static Int64 runWheel(int numSessions, int numOperations);
+        // Run the workload using a 'bdlc::TimerWheel', and return a checksum.
+};
+
+Int64 Benchmarks::runHeap(int numSessions, int numOperations)
+{
+    bsl::priority_queue<Entry, bsl::vector<Entry>, bsl::greater<Entry> > heap;
+    bsl::vector<Int64> current(numSessions);
+
+    bsls::Types::Uint64 state    = 1;
+    Int64               now      = 0;
+    Int64               checksum = 0;
+
+    for (int s = 0; s < numSessions; ++s) {
+        current[s] = now + k_TIMEOUT + s % 1000;
+        heap.push(Entry(current[s], s));
+    }
+
+    for (int i = 0; i < numOperations; ++i) {
+        now += k_STEP;
+
+        const int s = static_cast<int>(nextRandom(&state) % numSessions);
+        current[s] = now + k_TIMEOUT;
+        heap.push(Entry(current[s], s));
+
+        while (!heap.empty() && heap.top().first <= now) {
+            const Entry entry = heap.top();
+            heap.pop();
+            if (current[entry.second] == entry.first) {
+                checksum += entry.second;
+                current[entry.second] = now + k_TIMEOUT;
+                heap.push(Entry(current[entry.second], entry.second));
+            }
+        }
+    }
+    return checksum;
+}
+
+Int64 Benchmarks::runMap(int numSessions, int numOperations)
+{
+    typedef bsl::multimap<Int64, int> Map;
+
+    Map                     map;
+    bsl::vector<Map::iterator> current(numSessions);
+
+    bsls::Types::Uint64 state    = 1;
+    Int64               now      = 0;
+    Int64               checksum = 0;
+
+    for (int s = 0; s < numSessions; ++s) {
+        current[s] = map.insert(Map::value_type(now + k_TIMEOUT + s % 1000,
+                                                s));
+    }
+
+    for (int i = 0; i < numOperations; ++i) {
+        now += k_STEP;
+
+        const int s = static_cast<int>(nextRandom(&state) % numSessions);
+        map.erase(current[s]);
+        current[s] = map.insert(Map::value_type(now + k_TIMEOUT, s));
+
+        while (!map.empty() && map.begin()->first <= now) {
+            const int session = map.begin()->second;
+            map.erase(map.begin());
+            checksum += session;
+            current[session] = map.insert(Map::value_type(now + k_TIMEOUT,
+                                                          session));
+        }
+    }
+    return checksum;
+}
+
+Int64 Benchmarks::runWheel(int numSessions, int numOperations)
+{
+    Obj                 wheel(bsls::TimeInterval(0, 1));
+    bsl::vector<Handle> current(numSessions);
+    bsl::vector<int>    expired;
+
+    bsls::Types::Uint64 state    = 1;
+    Int64               now      = 0;
+    Int64               checksum = 0;
+
+    for (int s = 0; s < numSessions; ++s) {
+        current[s] = wheel.scheduleNanoseconds(now + k_TIMEOUT + s % 1000, s);
+    }
+
+    for (int i = 0; i < numOperations; ++i) {
+        now += k_STEP;
+
+        const int s = static_cast<int>(nextRandom(&state) % numSessions);
+        wheel.rescheduleNanoseconds(current[s], now + k_TIMEOUT);
+
+        expired.clear();
+        wheel.advanceNanoseconds(now, &expired);
+        for (bsl::size_t j = 0; j < expired.size(); ++j) {
+            const int session = expired[j];
+            checksum += session;
+            current[session] = wheel.scheduleNanoseconds(now + k_TIMEOUT,
+                                                         session);
+        }
+    }
+    return checksum;
+}
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Expiring Idle Sessions
+///- - - - - - - - - - - - - - - - -
+// Suppose that a server disconnects sessions that have been idle for 30
+// seconds, and that every message received on a session postpones its expiry.
+//
+// First, we create a wheel with a resolution of 10 milliseconds, whose values
+// are session identifiers:
+//..
+    typedef bdlc::TimerWheel<int> Wheel;
+
+    Wheel wheel(bsls::TimeInterval(0.01));
+
+    const bsls::TimeInterval IDLE_TIMEOUT(30, 0);
+//..
+// Then, at time 100 seconds, we open three sessions, retaining the handle of
+// the timer of each:
+//..
+    bsls::TimeInterval now(100, 0);
+
+    Wheel::Handle handles[3];
+    for (int session = 0; session < 3; ++session) {
+        handles[session] = wheel.schedule(now + IDLE_TIMEOUT, session);
+    }
+    ASSERT(3 == wheel.numTimers());
+//..
+// Next, 20 seconds later, session 1 receives a message, postponing its
+// expiry, and session 2 is closed by its client:
+//..
+    now += bsls::TimeInterval(20, 0);
+    bsl::vector<int> expired;
+    ASSERT(0 == wheel.advance(now, &expired));
+
+    wheel.reschedule(handles[1], now + IDLE_TIMEOUT);
+    wheel.cancel(handles[2]);
+//..
+// Now, 15 seconds later, only session 0 has been idle for 30 seconds:
+//..
+    now += bsls::TimeInterval(15, 0);
+    ASSERT(1 == wheel.advance(now, &expired));
+    ASSERT(0 == expired[0]);
+//..
+// Finally, after a further 15 seconds, session 1 expires as well:
+//..
+    expired.clear();
+    now += bsls::TimeInterval(15, 0);
+    ASSERT(1 == wheel.advance(now, &expired));
+    ASSERT(1 == expired[0]);
+    ASSERT(wheel.isEmpty());
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // EXCEPTION SAFETY OF 'advance'
+        //
+        // Concerns:
+        //: 1 If appending to the vector of expired values throws, the timers
+        //:   whose values were not appended remain pending, and are expired
+        //:   by the next call to 'advance'.
+        //:
+        //: 2 No memory is leaked.
+        //
+        // Plan:
+        //: 1 Expire a number of timers into a vector whose allocator is
+        //:   limited to fail after each possible number of allocations, and
+        //:   verify that every timer is expired exactly once in total.
+        //:   (C-1..2)
+        //
+        // Testing:
+        //   EXCEPTION SAFETY OF 'advance'
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EXCEPTION SAFETY OF 'advance'" << endl
+                          << "=============================" << endl;
+
+#ifdef BDE_BUILD_TARGET_EXC
+        const int NUM_TIMERS = 20;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        bslma::TestAllocator va("vector", veryVeryVerbose);
+
+        // Appending 'NUM_TIMERS' values to an empty vector allocates at least
+        // six times.
+
+        for (int limit = 0; limit < 6; ++limit) {
+            Obj mX(bsls::TimeInterval(0, 1000), &ta);
+
+            for (int i = 0; i < NUM_TIMERS; ++i) {
+                mX.scheduleNanoseconds(1000 * (i + 1), i);
+            }
+
+            bsl::vector<int> expired(&va);
+            va.setAllocationLimit(limit);
+
+            bool caught = false;
+            try {
+                mX.advanceNanoseconds(1000 * NUM_TIMERS, &expired);
+            }
+            catch (const bslma::TestAllocatorException&) {
+                caught = true;
+            }
+            va.setAllocationLimit(-1);
+
+            ASSERTV(limit, caught);
+            ASSERTV(limit, NUM_TIMERS == static_cast<int>(expired.size()
+                                                          + mX.numTimers()));
+
+            mX.advanceNanoseconds(1000 * NUM_TIMERS, &expired);
+
+            ASSERTV(limit, mX.isEmpty());
+            ASSERTV(limit, NUM_TIMERS == static_cast<int>(expired.size()));
+            for (int i = 0; i < NUM_TIMERS; ++i) {
+                ASSERTV(limit, i, i == expired[i]);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == va.numBlocksInUse());
+#endif
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // NANOSECONDS, RESOLUTION, AND THE CLOCK
+        //
+        // Concerns:
+        //: 1 Deadlines are rounded up to a tick, and the clock down, so that
+        //:   no timer expires before its deadline, and every timer expires
+        //:   when the clock reaches its tick.
+        //:
+        //: 2 The nanosecond and 'bsls::TimeInterval' methods are equivalent.
+        //:
+        //: 3 The clock starts at 0, reflects the last advance (rounded down),
+        //:   and does not move backwards.
+        //:
+        //: 4 A timer scheduled or rescheduled with a deadline that has been
+        //:   reached expires on the next advance, even without moving the
+        //:   clock.
+        //:
+        //: 5 Deadlines far in the future, including those at the top level
+        //:   of the wheel, are handled.
+        //
+        // Plan:
+        //: 1 Schedule timers with deadlines on and between tick boundaries,
+        //:   and advance the clock to times just before and after them.
+        //:   (C-1..2)
+        //:
+        //: 2 Verify 'currentTime' after advances forwards and backwards.
+        //:   (C-3)
+        //:
+        //: 3 Schedule and reschedule timers behind the clock.  (C-4)
+        //:
+        //: 4 Schedule timers near the largest representable time, and advance
+        //:   the clock to them.  (C-5)
+        //
+        // Testing:
+        //   int advanceNanoseconds(Int64 now, bsl::vector<VALUE> *expired);
+        //   void rescheduleNanoseconds(Handle handle, Int64 deadline);
+        //   Handle scheduleNanoseconds(Int64 deadline, const VALUE& value);
+        //   bsls::TimeInterval currentTime() const;
+        //   bsls::TimeInterval resolution() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "NANOSECONDS, RESOLUTION, AND THE CLOCK" << endl
+                          << "======================================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        const Int64 RES = 1000;  // nanoseconds per tick
+
+        if (verbose) cout << "\tTesting rounding." << endl;
+        {
+            Obj mX(bsls::TimeInterval(0, RES), &ta);  const Obj& X = mX;
+
+            ASSERT(bsls::TimeInterval(0, RES) == X.resolution());
+            ASSERT(bsls::TimeInterval()       == X.currentTime());
+
+            mX.scheduleNanoseconds(5 * RES,     0);  // on a tick
+            mX.scheduleNanoseconds(5 * RES + 1, 1);  // just after a tick
+            mX.schedule(bsls::TimeInterval(0, 7 * RES - 1), 2);
+
+            bsl::vector<int> expired;
+
+            ASSERT(0 == mX.advanceNanoseconds(5 * RES - 1, &expired));
+            ASSERT(bsls::TimeInterval(0, 4 * RES) == X.currentTime());
+
+            ASSERT(1 == mX.advanceNanoseconds(5 * RES, &expired));
+            ASSERT(0 == expired.back());
+
+            ASSERT(0 == mX.advanceNanoseconds(6 * RES - 1, &expired));
+            ASSERT(1 == mX.advance(bsls::TimeInterval(0, 6 * RES), &expired));
+            ASSERT(1 == expired.back());
+
+            ASSERT(1 == mX.advanceNanoseconds(7 * RES + RES / 2, &expired));
+            ASSERT(2 == expired.back());
+            ASSERT(bsls::TimeInterval(0, 7 * RES) == X.currentTime());
+
+            if (verbose) cout << "\tTesting a backward advance." << endl;
+
+            ASSERT(0 == mX.advanceNanoseconds(RES, &expired));
+            ASSERT(bsls::TimeInterval(0, 7 * RES) == X.currentTime());
+
+            if (verbose) cout << "\tTesting past deadlines." << endl;
+
+            mX.scheduleNanoseconds(3 * RES, 3);
+            const Handle H = mX.scheduleNanoseconds(100 * RES, 4);
+            mX.rescheduleNanoseconds(H, 0);
+            ASSERT(2 == X.numTimers());
+
+            expired.clear();
+            ASSERT(2 == mX.advanceNanoseconds(7 * RES, &expired));
+            ASSERT(3 == expired[0]);
+            ASSERT(4 == expired[1]);
+            ASSERT(X.isEmpty());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting distant deadlines." << endl;
+        {
+            const Int64 MAX = ~static_cast<bsls::Types::Uint64>(0) >> 1;
+
+            Obj mX(bsls::TimeInterval(0, 1), &ta);  const Obj& X = mX;
+
+            mX.scheduleNanoseconds(MAX,            0);
+            mX.scheduleNanoseconds(MAX - 1,        1);
+            mX.scheduleNanoseconds(MAX / 2,        2);
+            mX.scheduleNanoseconds(1,              3);
+            mX.scheduleNanoseconds(Int64(1) << 40, 4);
+
+            bsl::vector<int> expired;
+            ASSERT(2 == mX.advanceNanoseconds(Int64(1) << 40, &expired));
+            ASSERT(3 == expired[0]);
+            ASSERT(4 == expired[1]);
+
+            ASSERT(1 == mX.advanceNanoseconds(MAX - 2, &expired));
+            ASSERT(2 == expired[2]);
+
+            ASSERT(1 == mX.advanceNanoseconds(MAX - 1, &expired));
+            ASSERT(1 == expired[3]);
+
+            ASSERT(1 == mX.advanceNanoseconds(MAX, &expired));
+            ASSERT(0 == expired[4]);
+            ASSERT(X.isEmpty());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'advance' AND 'reschedule'
+        //
+        // Concerns:
+        //: 1 'advance' expires exactly the pending timers whose ticks have
+        //:   been reached, in the order of their ticks.
+        //:
+        //: 2 Timers at every level are cascaded correctly, whether the clock
+        //:   is advanced by a tick or by a long period.
+        //:
+        //: 3 A rescheduled timer expires at its new deadline only, and a
+        //:   cancelled timer never expires.
+        //:
+        //: 4 Timers expire in the order of their deadlines when the clock is
+        //:   advanced one tick at a time.
+        //
+        // Plan:
+        //: 1 For several resolutions, apply pseudo-random operations, with
+        //:   deadlines and advances spanning all levels, and compare with a
+        //:   reference model.  (C-1..3)
+        //:
+        //: 2 Schedule timers at consecutive ticks in a pseudo-random order,
+        //:   and advance the clock one tick at a time.  (C-4)
+        //
+        // Testing:
+        //   int advance(const TimeInterval& now, bsl::vector<VALUE> *expired);
+        //   void reschedule(Handle handle, const TimeInterval& deadline);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'advance' AND 'reschedule'" << endl
+                          << "==========================" << endl;
+
+        testRandomOperations(L_,       1, 40, 3000);
+        testRandomOperations(L_,    1000, 36, 3000);
+        testRandomOperations(L_, 1000000, 28, 3000);
+
+        if (verbose) cout << "\tTesting tick-by-tick expiry." << endl;
+        {
+            const int NUM_TIMERS = 5000;
+
+            bslma::TestAllocator ta("object", veryVeryVerbose);
+
+            Obj mX(bsls::TimeInterval(0, 1000), &ta);  const Obj& X = mX;
+
+            bsl::vector<int> order;
+            for (int i = 0; i < NUM_TIMERS; ++i) {
+                order.push_back(i);
+            }
+            bsls::Types::Uint64 state = 7;
+            for (int i = NUM_TIMERS - 1; 0 < i; --i) {
+                bsl::swap(order[i], order[nextRandom(&state) % (i + 1)]);
+            }
+
+            // Schedule timer 'i' at second 'i + 1', through a handle that is
+            // first given a different deadline.
+
+            for (int i = 0; i < NUM_TIMERS; ++i) {
+                const Handle H = mX.schedule(bsls::TimeInterval(1, 0),
+                                             order[i]);
+                mX.reschedule(H, bsls::TimeInterval(order[i] + 1, 0));
+            }
+
+            bsl::vector<int> expired;
+            for (int s = 0; s <= NUM_TIMERS; ++s) {
+                mX.advance(bsls::TimeInterval(s, 0), &expired);
+                ASSERTV(s, s == static_cast<int>(expired.size()));
+            }
+            for (int i = 0; i < NUM_TIMERS; ++i) {
+                ASSERTV(i, i == expired[i]);
+            }
+            ASSERT(X.isEmpty());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 'schedule' returns a handle identifying the timer and its value,
+        //:   and 'numTimers' and 'isEmpty' reflect the pending timers.
+        //:
+        //: 2 'cancel' removes a timer, and destroys its value.
+        //:
+        //: 3 'clear' and the destructor destroy the values of all pending
+        //:   timers, and release all memory.
+        //:
+        //: 4 Values are given the allocator of the wheel, and nodes are
+        //:   obtained from its pool, so that cancelling and rescheduling
+        //:   timers does not allocate memory.
+        //:
+        //: 5 'reserveCapacity' allows timers to be scheduled without
+        //:   allocating.
+        //:
+        //: 6 The constructor asserts that the resolution is positive.
+        //
+        // Plan:
+        //: 1 Schedule, cancel, and clear timers having 'bsl::string' values,
+        //:   and verify the values and the memory use.  (C-1..5)
+        //:
+        //: 2 Verify that defensive checks are triggered for a non-positive
+        //:   resolution.  (C-6)
+        //
+        // Testing:
+        //   TimerWheel(const TimeInterval& resolution, Allocator *ba);
+        //   ~TimerWheel();
+        //   void cancel(Handle handle);
+        //   void clear();
+        //   void reserveCapacity(int numTimers);
+        //   Handle schedule(const TimeInterval& deadline, const VALUE& value);
+        //   bslma::Allocator *allocator() const;
+        //   bool isEmpty() const;
+        //   bsl::size_t numTimers() const;
+        //   const VALUE& value(Handle handle) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                         << endl
+                         << "PRIMARY MANIPULATORS AND BASIC ACCESSORS" << endl
+                         << "========================================" << endl;
+
+        typedef bdlc::TimerWheel<bsl::string> StringWheel;
+
+        const char *LONG = "a string long enough to allocate memory";
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        {
+            StringWheel mX(bsls::TimeInterval(0.001), &ta);
+            const StringWheel& X = mX;
+
+            ASSERT(&ta == X.allocator());
+            ASSERT(X.isEmpty());
+            ASSERT(0 == X.numTimers());
+
+            StringWheel::Handle handles[10];
+            for (int i = 0; i < 10; ++i) {
+                handles[i] = mX.schedule(bsls::TimeInterval(i + 1, 0), LONG);
+
+                ASSERTV(i, !X.isEmpty());
+                ASSERTV(i, i + 1 == static_cast<int>(X.numTimers()));
+                ASSERTV(i, LONG == X.value(handles[i]));
+                ASSERTV(i, &ta == X.value(handles[i]).allocator());
+            }
+
+            const bsls::Types::Int64 BLOCKS = ta.numBlocksInUse();
+
+            mX.cancel(handles[3]);
+            ASSERT(9 == X.numTimers());
+            ASSERT(BLOCKS - 1 == ta.numBlocksInUse());  // the string only
+
+            const bsls::Types::Int64 NUM_ALLOCS = ta.numAllocations();
+            mX.reschedule(handles[4], bsls::TimeInterval(100, 0));
+            mX.cancel(handles[5]);
+            handles[5] = mX.schedule(bsls::TimeInterval(50, 0), "short");
+            ASSERT(NUM_ALLOCS == ta.numAllocations());
+
+            mX.clear();
+            ASSERT(X.isEmpty());
+            ASSERT(0 == X.numTimers());
+            ASSERT(0 == ta.numBlocksInUse());
+
+            mX.schedule(bsls::TimeInterval(1, 0), LONG);
+            ASSERT(1 == X.numTimers());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting 'reserveCapacity'." << endl;
+        {
+            Obj mX(bsls::TimeInterval(0.001), &ta);
+
+            mX.reserveCapacity(100);
+            const bsls::Types::Int64 NUM_ALLOCS = ta.numAllocations();
+
+            for (int i = 0; i < 100; ++i) {
+                mX.schedule(bsls::TimeInterval(i, 0), i);
+            }
+            ASSERT(NUM_ALLOCS == ta.numAllocations());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_FAIL(Obj(bsls::TimeInterval()));
+            ASSERT_FAIL(Obj(bsls::TimeInterval(-1, 0)));
+            ASSERT_PASS(Obj(bsls::TimeInterval(0, 1)));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Schedule, cancel, and expire a few timers.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(bsls::TimeInterval(0.001), &ta);  const Obj& X = mX;
+            ASSERT(X.isEmpty());
+
+            mX.schedule(bsls::TimeInterval(3, 0), 3);
+            mX.schedule(bsls::TimeInterval(1, 0), 1);
+            const Handle H = mX.schedule(bsls::TimeInterval(2, 0), 2);
+            mX.schedule(bsls::TimeInterval(3600, 0), 4);
+
+            ASSERT(4 == X.numTimers());
+
+            mX.cancel(H);
+            ASSERT(3 == X.numTimers());
+
+            bsl::vector<int> expired;
+            ASSERT(0 == mX.advance(bsls::TimeInterval(0.5), &expired));
+            ASSERT(2 == mX.advance(bsls::TimeInterval(5, 0), &expired));
+            ASSERT(1 == expired[0]);
+            ASSERT(3 == expired[1]);
+
+            ASSERT(1 == mX.advance(bsls::TimeInterval(7200, 0), &expired));
+            ASSERT(4 == expired[2]);
+            ASSERT(X.isEmpty());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COMPARISON WITH HEAP AND MAP
+        //
+        // Concerns:
+        //: 1 A timer wheel outperforms a priority queue and an ordered map
+        //:   for a workload dominated by rescheduling.
+        //
+        // Plan:
+        //: 1 Run a workload in which each of a number of sessions holds a
+        //:   timeout that is rescheduled at random, advancing the clock by one
+        //:   tick per operation, using each implementation, and report the
+        //:   elapsed times.  Optionally specify the number of sessions and of
+        //:   operations as the second and third arguments.
+        //
+        // Testing:
+        //   PERFORMANCE: COMPARISON WITH HEAP AND MAP
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: COMPARISON WITH HEAP AND MAP" << endl
+             << "=========================================" << endl;
+
+        const int NUM_SESSIONS   = argc > 2 ? atoi(argv[2]) : 100000;
+        const int NUM_OPERATIONS = argc > 3 ? atoi(argv[3]) : 10000000;
+
+        P_(NUM_SESSIONS) P(NUM_OPERATIONS)
+
+        Int64 checksums[3];
+
+        bsls::Stopwatch timer;
+
+        timer.start();
+        checksums[0] = Benchmarks::runHeap(NUM_SESSIONS, NUM_OPERATIONS);
+        timer.stop();
+        cout << "bsl::priority_queue: " << timer.elapsedTime() << "s" << endl;
+
+        timer.reset();
+        timer.start();
+        checksums[1] = Benchmarks::runMap(NUM_SESSIONS, NUM_OPERATIONS);
+        timer.stop();
+        cout << "bsl::multimap:       " << timer.elapsedTime() << "s" << endl;
+
+        timer.reset();
+        timer.start();
+        checksums[2] = Benchmarks::runWheel(NUM_SESSIONS, NUM_OPERATIONS);
+        timer.stop();
+        cout << "bdlc::TimerWheel:    " << timer.elapsedTime() << "s" << endl;
+
+        ASSERTV(checksums[0], checksums[1], checksums[0] == checksums[1]);
+        ASSERTV(checksums[0], checksums[2], checksums[0] == checksums[2]);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
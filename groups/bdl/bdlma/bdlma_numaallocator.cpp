@@ -0,0 +1,379 @@
+// bdlma_numaallocator.cpp                                            -*-C++-*-
+#include <bdlma_numaallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_numaallocator_cpp,"$Id$ $CSID$")
+
+#include <bdlma_multipool.h>                    // for testing only
+#include <bdlma_sequentialallocator.h>          // for testing only
+
+#include <bslmf_assert.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_exceptionutil.h>      // 'BSLS_THROW'
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstddef.h>             // 'bsl::size_t'
+#include <bsl_new.h>                 // 'bsl::bad_alloc'
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+#include <windows.h>   // 'GetSystemInfo', 'VirtualAlloc', 'VirtualFree'
+
+#else
+
+#include <sys/mman.h>  // 'mmap', 'munmap'
+#include <unistd.h>    // 'sysconf', 'syscall'
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+#include <sys/syscall.h>  // 'SYS_getcpu', 'SYS_get_mempolicy', 'SYS_mbind'
+#endif
+
+#endif
+
+namespace BloombergLP {
+
+namespace {
+
+// Define the offset (in bytes) from the start of the pages of a block to the
+// address returned to the user, at which the size of the block is stashed.
+
+const bslma::Allocator::size_type OFFSET =
+                                       bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+BSLMF_ASSERT(sizeof(bslma::Allocator::size_type) <= OFFSET);
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+// The following values are those of '<numaif.h>', which is provided by the
+// optional 'libnuma' package, and is therefore not included.
+
+enum {
+    k_MPOL_PREFERRED      = 1,    // policy: prefer the node in the mask
+
+    k_MPOL_F_NODE         = 1,    // 'get_mempolicy': return a node
+    k_MPOL_F_ADDR         = 2,    // 'get_mempolicy': of the page at an address
+    k_MPOL_F_MEMS_ALLOWED = 4,    // 'get_mempolicy': return allowed nodes
+
+    k_MAX_NUM_NODES       = 1024  // largest number of nodes supported by Linux
+};
+
+const int k_BITS_PER_LONG = static_cast<int>(sizeof(unsigned long) * 8);
+
+#endif
+
+// HELPER FUNCTIONS
+
+int getSystemPageSize()
+    // Return the size (in bytes) of a system memory page.
+{
+    static bsls::AtomicInt pageSize(0);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == pageSize.loadRelaxed())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        pageSize = static_cast<int>(info.dwPageSize);
+
+#else
+
+        pageSize = static_cast<int>(sysconf(_SC_PAGESIZE));
+
+#endif
+    }
+
+    return pageSize.loadRelaxed();
+}
+
+void *systemAlloc(bsl::size_t size)
+    // Allocate a page-aligned block of memory of the specified 'size' (in
+    // bytes), and return the address of the allocated block, or 0 if the
+    // memory cannot be allocated.  The behavior is undefined unless
+    // 'size > 0'.
+{
+    BSLS_ASSERT(size > 0);
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    return VirtualAlloc(0, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+                                                                      // RETURN
+
+#else
+
+    void *address =  mmap(0,
+                          size,
+                          PROT_READ | PROT_WRITE,
+                          MAP_ANON | MAP_PRIVATE,
+                          -1,
+                          0);
+
+    if (MAP_FAILED == address) {
+        return 0;                                                     // RETURN
+    }
+
+    return address;                                                   // RETURN
+
+#endif
+}
+
+void systemFree(void *address, bsl::size_t size)
+    // Return the memory block at the specified 'address' having the specified
+    // 'size' (in bytes) back to the system.  The behavior is undefined unless
+    // 'address' was returned by 'systemAlloc' for 'size' bytes and has not
+    // already been freed.
+{
+    BSLS_ASSERT(address);
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    VirtualFree(address, 0, MEM_RELEASE);
+    (void) size;
+
+#else
+
+    // On some of our platforms, 'munmap' takes a 'char*' argument, while on
+    // others it takes a 'void*'.  Casting to 'char*', which will work in both
+    // cases.
+
+    munmap(static_cast<char*>(address), size);
+
+#endif
+}
+
+int systemBind(void *address, bsl::size_t size, int node)
+    // Bind the pages of the specified 'size' (in bytes) at the specified
+    // 'address' to the specified 'node', with the "preferred" policy.  Return
+    // 0 on success, and a non-zero value otherwise.  The behavior is undefined
+    // unless 'address' was returned by 'systemAlloc' for 'size' bytes, and
+    // '0 <= node'.
+{
+    BSLS_ASSERT(address);
+    BSLS_ASSERT(0 <= node);
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+    if (k_MAX_NUM_NODES <= node) {
+        return -1;                                                    // RETURN
+    }
+
+    unsigned long mask[k_MAX_NUM_NODES / k_BITS_PER_LONG] = { 0 };
+    mask[node / k_BITS_PER_LONG] = 1UL << (node % k_BITS_PER_LONG);
+
+    // Note that the kernel ignores the last bit of the mask.
+
+    return static_cast<int>(syscall(SYS_mbind,
+                                    address,
+                                    size,
+                                    static_cast<int>(k_MPOL_PREFERRED),
+                                    mask,
+                                    static_cast<unsigned long>(
+                                                         k_MAX_NUM_NODES + 1),
+                                    0U));                             // RETURN
+
+#else
+
+    (void) size;
+    (void) node;
+
+    return -1;                                                        // RETURN
+
+#endif
+}
+
+void systemTouch(void *address, bsl::size_t size, int pageSize)
+    // Write to each page of the specified 'size' (in bytes) at the specified
+    // 'address', having the specified 'pageSize', so that the system places
+    // the pages on the node of the calling thread.  The behavior is undefined
+    // unless 'address' was returned by 'systemAlloc' for 'size' bytes.
+{
+    BSLS_ASSERT(address);
+
+    volatile char *page = static_cast<char *>(address);
+
+    for (bsl::size_t offset = 0; offset < size; offset += pageSize) {
+        page[offset] = 0;
+    }
+}
+
+}  // close unnamed namespace
+
+namespace bdlma {
+
+                           // -------------------
+                           // class NumaAllocator
+                           // -------------------
+
+// CLASS METHODS
+int NumaAllocator::currentNode()
+{
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+    unsigned int cpu;
+    unsigned int node;
+
+    if (0 != syscall(SYS_getcpu, &cpu, &node, 0)) {
+        return -1;                                                    // RETURN
+    }
+    return static_cast<int>(node);                                    // RETURN
+
+#else
+
+    return 0;                                                         // RETURN
+
+#endif
+}
+
+int NumaAllocator::nodeOfAddress(const void *address)
+{
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+    int node = -1;
+
+    if (0 != syscall(SYS_get_mempolicy,
+                     &node,
+                     0,
+                     0UL,
+                     address,
+                     static_cast<unsigned long>(k_MPOL_F_NODE
+                                                | k_MPOL_F_ADDR))) {
+        return -1;                                                    // RETURN
+    }
+    return node;                                                      // RETURN
+
+#else
+
+    (void) address;
+
+    return -1;                                                        // RETURN
+
+#endif
+}
+
+int NumaAllocator::numNodes()
+{
+    static bsls::AtomicInt numNodes(0);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == numNodes.loadRelaxed())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        int count = 1;
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+        unsigned long mask[k_MAX_NUM_NODES / k_BITS_PER_LONG] = { 0 };
+
+        if (0 == syscall(SYS_get_mempolicy,
+                         0,
+                         mask,
+                         static_cast<unsigned long>(k_MAX_NUM_NODES + 1),
+                         0,
+                         static_cast<unsigned long>(k_MPOL_F_MEMS_ALLOWED))) {
+            count = 0;
+            for (int i = 0; i < k_MAX_NUM_NODES; ++i) {
+                const unsigned long bit = 1UL << (i % k_BITS_PER_LONG);
+
+                if (mask[i / k_BITS_PER_LONG] & bit) {
+                    ++count;
+                }
+            }
+            if (0 == count) {
+                count = 1;
+            }
+        }
+
+#endif
+
+        numNodes = count;
+    }
+
+    return numNodes.loadRelaxed();
+}
+
+// CREATORS
+NumaAllocator::NumaAllocator(int node)
+: d_node(node)
+{
+    BSLS_ASSERT(k_LOCAL_NODE <= node);
+}
+
+NumaAllocator::~NumaAllocator()
+{
+}
+
+// MANIPULATORS
+void *NumaAllocator::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    const int       pageSize  = getSystemPageSize();
+    const size_type totalSize = (size + OFFSET + pageSize - 1)
+                              / pageSize * pageSize;
+
+    void *firstPage = systemAlloc(totalSize);
+
+    if (!firstPage) {
+#ifdef BDE_BUILD_TARGET_EXC
+        BSLS_THROW(bsl::bad_alloc());
+#else
+        return 0;                                                     // RETURN
+#endif
+    }
+
+    // Memory placed on the node of the calling thread needs no binding on a
+    // single-node machine.  Otherwise, bind the pages to the node, or, if that
+    // fails, place them on the node of the calling thread by touching them.
+
+    if (k_LOCAL_NODE != d_node || 1 < numNodes()) {
+        const int node = k_LOCAL_NODE == d_node ? currentNode() : d_node;
+
+        if (node < 0 || 0 != systemBind(firstPage, totalSize, node)) {
+            systemTouch(firstPage, totalSize, pageSize);
+        }
+    }
+
+    // Save 'totalSize' - we'll need it for 'systemFree' in 'deallocate'.
+
+    *static_cast<size_type *>(firstPage) = totalSize;
+
+    return static_cast<char *>(firstPage) + OFFSET;
+}
+
+void NumaAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return;                                                       // RETURN
+    }
+
+    void *firstPage = static_cast<char *>(address) - OFFSET;
+
+    systemFree(firstPage, *static_cast<size_type *>(firstPage));
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
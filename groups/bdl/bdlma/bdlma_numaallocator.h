@@ -0,0 +1,285 @@
+// bdlma_numaallocator.h                                              -*-C++-*-
+#ifndef INCLUDED_BDLMA_NUMAALLOCATOR
+#define INCLUDED_BDLMA_NUMAALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator placing its memory on a chosen NUMA node.
+//
+//@CLASSES:
+//  bdlma::NumaAllocator: allocator of memory pages placed on a NUMA node
+//
+//@SEE_ALSO: bdlma_guardingallocator, bdlma_multipool,
+//           bdlma_sequentialallocator
+//
+//@DESCRIPTION: This component provides a concrete allocation mechanism,
+// 'bdlma::NumaAllocator', that implements the 'bslma::Allocator' protocol and
+// places each block of memory returned by the 'allocate' method on a chosen
+// node of a NUMA (non-uniform memory access) machine, i.e., in the memory
+// attached to one of its processor sockets:
+//..
+//   ,--------------------.
+//  ( bdlma::NumaAllocator )
+//   `--------------------'
+//             |         ctor/dtor
+//             |         currentNode
+//             |         nodeOfAddress
+//             |         numNodes
+//             |         node
+//             V
+//     ,----------------.
+//    ( bslma::Allocator )
+//     `----------------'
+//                       allocate
+//                       deallocate
+//..
+// By default, the operating system places a page of memory on the node of the
+// thread that first writes to it ("first touch").  A block obtained from
+// 'bslma::NewDeleteAllocator', or a buffer of a 'bdlma::SequentialAllocator',
+// therefore lands on the node of whichever thread happens to touch it first,
+// which may not be the node of the threads that later use it, resulting in
+// the slower access of remote memory.
+//
+// Like a 'bdlma::GuardingAllocator', a 'bdlma::NumaAllocator' obtains memory
+// directly from the operating system, in multiples of the system page size;
+// a 'bslma::Allocator *' cannot be supplied upon construction.  It is,
+// therefore, intended to be used as the underlying allocator of an allocator
+// or pool that obtains memory in large chunks, such as a 'bdlma::Multipool' or
+// a 'bdlma::SequentialAllocator', rather than directly by objects.
+//
+///Node Placement
+///--------------
+// The node on which memory is placed is specified at construction, either as
+// the index of a node, or as 'k_LOCAL_NODE', indicating the node of the
+// thread calling 'allocate' at the time of the call (as reported by the
+// 'currentNode' class method).  On Linux, the pages of each block are bound to
+// the node with the 'mbind' system call, using the "preferred" policy, so
+// that, if the node runs out of memory, pages are placed on another node
+// rather than the allocation failing.  The binding is effective whichever
+// thread first touches the pages.
+//
+// If binding is not possible (e.g., the system call is not permitted, or the
+// node does not exist), the pages of the block are touched by the calling
+// thread before the block is returned, so that they are placed, by the
+// operating system's first-touch policy, on the node of the calling thread.
+//
+///Single-Node Machines and Other Platforms
+///----------------------------------------
+// On a machine having a single node (as reported by the 'numNodes' class
+// method), a 'bdlma::NumaAllocator' that places memory on the node of the
+// calling thread makes no system call other than obtaining and releasing
+// pages, and touches no page.  On platforms other than Linux, the machine is
+// treated as having a single node, numbered 0, and 'nodeOfAddress' returns
+// -1.
+//
+///Thread Safety
+///-------------
+// The 'bdlma::NumaAllocator' class is fully thread-safe (see
+// 'bsldoc_glossary').
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Placing the Arena of a Worker Thread on its Node
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that each thread of a server processes batches of values, using a
+// 'bdlma::SequentialAllocator' as an arena for the temporary data of a batch.
+// The buffers of the arena are obtained from the default allocator, so they
+// may have been placed on another node by the thread that touched them first.
+// To make sure that the thread processing a batch accesses local memory, we
+// supply a 'bdlma::NumaAllocator' placing memory on the node of the calling
+// thread as the underlying allocator of the arena.
+//
+// First, we define a function that processes a batch of values:
+//..
+//  int sumOfSquares(const int *values, int numValues)
+//      // Return the sum of the squares of the specified 'numValues' values
+//      // starting at the specified 'values'.
+//  {
+//      bdlma::NumaAllocator       nodeAllocator;  // node of this thread
+//      bdlma::SequentialAllocator arena(&nodeAllocator);
+//
+//      int *squares = static_cast<int *>(
+//                                arena.allocate(numValues * sizeof *squares));
+//
+//      for (int i = 0; i < numValues; ++i) {
+//          squares[i] = values[i] * values[i];
+//      }
+//
+//      int sum = 0;
+//      for (int i = 0; i < numValues; ++i) {
+//          sum += squares[i];
+//      }
+//      return sum;
+//  }
+//..
+// Then, we process a batch:
+//..
+//  const int VALUES[]   = { 1, 2, 3, 4 };
+//  const int NUM_VALUES = sizeof VALUES / sizeof *VALUES;
+//
+//  assert(30 == sumOfSquares(VALUES, NUM_VALUES));
+//..
+//
+///Example 2: Pooling Memory on a Given Node
+///- - - - - - - - - - - - - - - - - - - - -
+// Suppose that the threads of a server are pinned to the nodes of the
+// machine, and that the objects used by the threads of a node are allocated
+// from a 'bdlma::Multipool' created for that node.
+//
+// First, we determine the number of nodes of the machine:
+//..
+//  const int numNodes = bdlma::NumaAllocator::numNodes();
+//  assert(1 <= numNodes);
+//..
+// Then, we create the allocator and the pool of node 0:
+//..
+//  bdlma::NumaAllocator nodeAllocator(0);
+//  assert(0 == nodeAllocator.node());
+//
+//  bdlma::Multipool     pool(&nodeAllocator);
+//..
+// Finally, we observe that the blocks dispensed by the pool lie on that node
+// (provided that the platform can report where a page lies, and that the
+// node has memory available):
+//..
+//  void *block = pool.allocate(64);
+//
+//  const int node = bdlma::NumaAllocator::nodeOfAddress(block);
+//  assert(0 == node || -1 == node);
+//
+//  pool.deallocate(block);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                           // ===================
+                           // class NumaAllocator
+                           // ===================
+
+class NumaAllocator : public bslma::Allocator {
+    // This class defines a concrete thread-safe allocator mechanism that
+    // implements the 'bslma::Allocator' protocol, and places the pages of each
+    // block of memory returned by the 'allocate' method on a NUMA node
+    // specified at construction, or on the node of the calling thread.  Note
+    // that, unlike many other allocators, an allocator cannot be (optionally)
+    // supplied at construction; instead, a system facility is used that
+    // allocates blocks of memory in multiples of the system page size.
+
+  public:
+    // TYPES
+    enum {
+        k_LOCAL_NODE = -1  // place memory on the node of the calling thread
+    };
+
+  private:
+    // DATA
+    int d_node;  // node on which memory is placed, or 'k_LOCAL_NODE'
+
+  private:
+    // NOT IMPLEMENTED
+    NumaAllocator(const NumaAllocator&);
+    NumaAllocator& operator=(const NumaAllocator&);
+
+  public:
+    // CLASS METHODS
+    static int currentNode();
+        // Return the node of the processor on which the calling thread runs,
+        // or -1 if it cannot be determined.  Note that the thread may be
+        // moved to another node by the time the value returned is used,
+        // unless its affinity restricts it to the processors of one node.
+
+    static int nodeOfAddress(const void *address);
+        // Return the node on which the page of memory at the specified
+        // 'address' lies, or -1 if it cannot be determined.  The behavior is
+        // undefined unless 'address' refers to memory that is mapped in the
+        // address space of the calling process.  Note that, on Linux, a page
+        // that was never touched is placed when this method is called.
+
+    static int numNodes();
+        // Return the number of nodes on which the calling process may place
+        // memory.  Note that 1 is returned on a machine that is not a NUMA
+        // machine, and on platforms where NUMA placement is not supported.
+
+    // CREATORS
+    explicit
+    NumaAllocator(int node = k_LOCAL_NODE);
+        // Create an allocator placing memory on the specified 'node'.  If
+        // 'node' is not specified, or is 'k_LOCAL_NODE', memory is placed on
+        // the node of the thread calling 'allocate'.  The behavior is
+        // undefined unless 'k_LOCAL_NODE <= node'.
+
+    virtual ~NumaAllocator();
+        // Destroy this allocator object.  Note that destroying this allocator
+        // has no effect on any outstanding allocated memory.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly-allocated maximally-aligned block of memory of the
+        // specified 'size' (in bytes), placed on the node indicated at
+        // construction (see {Node Placement}).  If 'size' is 0, no memory is
+        // allocated and 0 is returned.  Note that a multiple of the
+        // platform's memory page size is allocated for *every* call to this
+        // method.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' back to this
+        // allocator.  If 'address' is 0, this method has no effect.  The
+        // behavior is undefined unless 'address' was returned by 'allocate'
+        // and has not already been deallocated.
+
+    // ACCESSORS
+    int node() const;
+        // Return the node on which this allocator places memory, or
+        // 'k_LOCAL_NODE' if it places memory on the node of the thread
+        // calling 'allocate'.
+};
+
+// ============================================================================
+//                         INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                           // -------------------
+                           // class NumaAllocator
+                           // -------------------
+
+// ACCESSORS
+inline
+int NumaAllocator::node() const
+{
+    return d_node;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1056 @@
+// bdlma_numaallocator.t.cpp                                          -*-C++-*-
+#include <bdlma_numaallocator.h>
+
+#include <bdlma_multipool.h>
+#include <bdlma_sequentialallocator.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_platform.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/mman.h>   // 'mincore'
+#include <unistd.h>     // 'sysconf', 'syscall'
+#endif
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+#include <sys/syscall.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is an allocator that obtains pages of memory from
+// the operating system and places them on a NUMA node chosen at construction,
+// or on the node of the calling thread.  The primary concerns are that the
+// blocks returned are maximally aligned, writable, and released back to the
+// system; that, on Linux, the pages of a block carry the "preferred" policy
+// for the chosen node; that a node that cannot be bound to degrades to
+// touching the pages from the calling thread; that, on a single-node
+// machine, memory placed on the local node is left to the default policy;
+// and that the allocator composes with 'bdlma::Multipool' and
+// 'bdlma::SequentialAllocator' as their underlying allocator, including when
+// used concurrently by several threads.  On Linux, the placement of pages is
+// observed directly using the 'get_mempolicy' and 'mincore' system calls.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] static int currentNode();
+// [ 2] static int nodeOfAddress(const void *address);
+// [ 2] static int numNodes();
+//
+// CREATORS
+// [ 3] explicit NumaAllocator(int node = k_LOCAL_NODE);
+// [ 3] virtual ~NumaAllocator();
+//
+// MANIPULATORS
+// [ 4] virtual void *allocate(size_type size);
+// [ 4] virtual void deallocate(void *address);
+//
+// ACCESSORS
+// [ 3] int node() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] CONCERN: Pages of a block are bound to the specified node.
+// [ 4] CONCERN: Pages are touched if the node cannot be bound to.
+// [ 5] CONCERN: Serves as the underlying allocator of pools.
+// [ 5] CONCERN: May be used concurrently by several threads.
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: MEMORY LOCALITY
+//=============================================================================
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlma::NumaAllocator Obj;
+typedef bsls::Types::UintPtr UintPtr;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+const int MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+// The following values are those of '<numaif.h>'.
+
+enum {
+    MPOL_DEFAULT_MODE   = 0,
+    MPOL_PREFERRED_MODE = 1,
+    MPOL_F_ADDR_FLAG    = 2
+};
+
+#endif
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+int pageSize()
+    // Return the size (in bytes) of a system memory page.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<int>(info.dwPageSize);
+#else
+    return static_cast<int>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+static
+int policyOfAddress(const void *address)
+    // Return the memory policy mode of the page at the specified 'address',
+    // or -1 if it cannot be determined.
+{
+    int mode = -1;
+
+    if (0 != syscall(SYS_get_mempolicy,
+                     &mode,
+                     0,
+                     0UL,
+                     address,
+                     static_cast<unsigned long>(MPOL_F_ADDR_FLAG))) {
+        return -1;                                                    // RETURN
+    }
+    return mode;
+}
+
+static
+bool isResident(const void *address)
+    // Return 'true' if the page at the specified 'address' is resident in
+    // memory (i.e., has been touched), and 'false' otherwise.
+{
+    const int  size = pageSize();
+    void      *page = reinterpret_cast<void *>(
+                        reinterpret_cast<UintPtr>(address) / size * size);
+
+    unsigned char status = 0;
+
+    if (0 != mincore(page, size, &status)) {
+        return false;                                                 // RETURN
+    }
+    return status & 1;
+}
+
+#endif
+
+                        // =====================
+                        // struct PoolThreadArgs
+                        // =====================
+
+struct PoolThreadArgs {
+    // This 'struct' holds the arguments of a thread allocating from a
+    // 'bdlma::Multipool' created upon a shared allocator.
+
+    bslma::Allocator *d_allocator_p;  // shared underlying allocator
+    int               d_index;        // index of the thread
+    int               d_numRounds;    // number of rounds
+    bsls::AtomicInt  *d_numErrors_p;  // number of corrupted blocks
+};
+
+extern "C" void *poolThread(void *arg)
+    // Run, with the specified 'arg' referring to a 'PoolThreadArgs', a number
+    // of rounds in which a batch of blocks is allocated from a
+    // 'bdlma::Multipool', filled with a pattern specific to this thread,
+    // verified, and deallocated, then release the pool.
+{
+    PoolThreadArgs *args = static_cast<PoolThreadArgs *>(arg);
+
+    enum { BATCH_SIZE = 32 };
+
+    bdlma::Multipool pool(args->d_allocator_p);
+
+    for (int round = 0; round < args->d_numRounds; ++round) {
+        char        *batch[BATCH_SIZE];
+        const char   c = static_cast<char>('A' + (args->d_index + round) % 26);
+
+        for (int i = 0; i < BATCH_SIZE; ++i) {
+            const int size = 1 + (round * BATCH_SIZE + i) * 7919 % 2000;
+
+            batch[i] = static_cast<char *>(pool.allocate(size));
+            bsl::memset(batch[i], c, size);
+        }
+        for (int i = 0; i < BATCH_SIZE; ++i) {
+            const int size = 1 + (round * BATCH_SIZE + i) * 7919 % 2000;
+
+            for (int j = 0; j < size; ++j) {
+                if (c != batch[i][j]) {
+                    args->d_numErrors_p->addRelaxed(1);
+                    break;
+                }
+            }
+            pool.deallocate(batch[i]);
+        }
+        if (0 == round % 8) {
+            pool.release();
+        }
+    }
+    return 0;
+}
+
+static
+void initializeChain(bsl::size_t *chain, bsl::size_t length)
+    // Load into the specified 'chain' of the specified 'length' a random
+    // cyclic permutation of the indices '[0 .. length)', such that following
+    // 'chain[i]' from any index visits every element once.
+{
+    for (bsl::size_t i = 0; i < length; ++i) {
+        chain[i] = i;
+    }
+
+    // Sattolo's algorithm, using a simple linear congruential generator.
+
+    bsls::Types::Uint64 seed = 12345;
+
+    for (bsl::size_t i = length - 1; i > 0; --i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        const bsl::size_t j = static_cast<bsl::size_t>((seed >> 33) % i);
+        const bsl::size_t t = chain[i];
+
+        chain[i] = chain[j];
+        chain[j] = t;
+    }
+}
+
+static
+double chaseChain(const bsl::size_t *chain,
+                  bsl::size_t        numSteps,
+                  bsl::size_t       *result)
+    // Follow the specified 'chain' for the specified 'numSteps' steps starting
+    // at index 0, load the index reached into the specified 'result', and
+    // return the time taken (in seconds).
+{
+    bsls::Stopwatch timer;
+    timer.start();
+
+    bsl::size_t index = 0;
+    for (bsl::size_t i = 0; i < numSteps; ++i) {
+        index = chain[index];
+    }
+
+    timer.stop();
+    *result = index;
+    return timer.elapsedTime();
+}
+
+static
+double sumChain(const bsl::size_t *chain,
+                bsl::size_t        length,
+                bsl::size_t       *result)
+    // Sum the specified 'length' elements of the specified 'chain'
+    // sequentially, load the sum into the specified 'result', and return the
+    // time taken (in seconds).
+{
+    bsls::Stopwatch timer;
+    timer.start();
+
+    bsl::size_t sum = 0;
+    for (bsl::size_t i = 0; i < length; ++i) {
+        sum += chain[i];
+    }
+
+    timer.stop();
+    *result = sum;
+    return timer.elapsedTime();
+}
+
+// ============================================================================
+//                                USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Placing the Arena of a Worker Thread on its Node
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that each thread of a server processes batches of values, using a
+// 'bdlma::SequentialAllocator' as an arena for the temporary data of a batch.
+// The buffers of the arena are obtained from the default allocator, so they
+// may have been placed on another node by the thread that touched them first.
+// To make sure that the thread processing a batch accesses local memory, we
+// supply a 'bdlma::NumaAllocator' placing memory on the node of the calling
+// thread as the underlying allocator of the arena.
+//
+// First, we define a function that processes a batch of values:
+//..
+    int sumOfSquares(const int *values, int numValues)
+        // Return the sum of the squares of the specified 'numValues' values
+        // starting at the specified 'values'.
+    {
+        bdlma::NumaAllocator       nodeAllocator;  // node of this thread
+        bdlma::SequentialAllocator arena(&nodeAllocator);
+
+        int *squares = static_cast<int *>(
+                                  arena.allocate(numValues * sizeof *squares));
+
+        for (int i = 0; i < numValues; ++i) {
+            squares[i] = values[i] * values[i];
+        }
+
+        int sum = 0;
+        for (int i = 0; i < numValues; ++i) {
+            sum += squares[i];
+        }
+        return sum;
+    }
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we process a batch:
+//..
+    const int VALUES[]   = { 1, 2, 3, 4 };
+    const int NUM_VALUES = sizeof VALUES / sizeof *VALUES;
+
+    ASSERT(30 == sumOfSquares(VALUES, NUM_VALUES));
+//..
+//
+///Example 2: Pooling Memory on a Given Node
+///- - - - - - - - - - - - - - - - - - - - -
+// Suppose that the threads of a server are pinned to the nodes of the
+// machine, and that the objects used by the threads of a node are allocated
+// from a 'bdlma::Multipool' created for that node.
+//
+// First, we determine the number of nodes of the machine:
+//..
+    const int numNodes = bdlma::NumaAllocator::numNodes();
+    ASSERT(1 <= numNodes);
+//..
+// Then, we create the allocator and the pool of node 0:
+//..
+    bdlma::NumaAllocator nodeAllocator(0);
+    ASSERT(0 == nodeAllocator.node());
+
+    bdlma::Multipool     pool(&nodeAllocator);
+//..
+// Finally, we observe that the blocks dispensed by the pool lie on that node
+// (provided that the platform can report where a page lies, and that the
+// node has memory available):
+//..
+    void *block = pool.allocate(64);
+
+    const int node = bdlma::NumaAllocator::nodeOfAddress(block);
+    ASSERT(0 == node || -1 == node);
+
+    pool.deallocate(block);
+//..
+
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // COMPOSITION WITH POOLS AND CONCURRENCY
+        //
+        // Concerns:
+        //: 1 A 'bdlma::NumaAllocator' may be supplied as the underlying
+        //:   allocator of a 'bdlma::Multipool' and of a
+        //:   'bdlma::SequentialAllocator', and all memory they obtain from it
+        //:   is returned when they are released or destroyed.
+        //:
+        //: 2 The blocks dispensed by the pools are placed on the node of the
+        //:   allocator (on Linux).
+        //:
+        //: 3 A 'bdlma::NumaAllocator' may be used concurrently by several
+        //:   threads.
+        //
+        // Plan:
+        //: 1 Interpose a 'bslma::TestAllocator' between each pool and a
+        //:   'bdlma::NumaAllocator' to observe the memory obtained, allocate
+        //:   from the pools, verify the placement of the blocks, and verify
+        //:   that no memory remains in use once the pools are released and
+        //:   destroyed.  (C-1..2)
+        //:
+        //: 2 Create several threads, each using a 'bdlma::Multipool' upon a
+        //:   shared 'bdlma::NumaAllocator' (through a 'bslma::TestAllocator'),
+        //:   filling and verifying the blocks it allocates.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: Serves as the underlying allocator of pools.
+        //   CONCERN: May be used concurrently by several threads.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "COMPOSITION WITH POOLS AND CONCURRENCY" << endl
+                          << "======================================" << endl;
+
+        if (verbose) cout << "\nWith 'bdlma::Multipool'." << endl;
+
+        for (int node = Obj::k_LOCAL_NODE; node <= 0; ++node) {
+            Obj                  mX(node);
+            bslma::TestAllocator ta("numa", veryVeryVerbose, &mX);
+            {
+                bdlma::Multipool pool(&ta);
+
+                const bsls::Types::Int64 NUM_INTERNAL = ta.numBlocksInUse();
+
+                char *blocks[100];
+                for (int i = 0; i < 100; ++i) {
+                    const int size = 1 + i * 97 % 5000;
+
+                    blocks[i] = static_cast<char *>(pool.allocate(size));
+                    bsl::memset(blocks[i], i, size);
+
+                    ASSERTV(node, i,
+                            0 == reinterpret_cast<UintPtr>(blocks[i])
+                                                                 % MAX_ALIGN);
+                }
+                ASSERTV(node, NUM_INTERNAL < ta.numBlocksInUse());
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+                if (0 == node) {
+                    ASSERT(MPOL_PREFERRED_MODE == policyOfAddress(blocks[0]));
+                    ASSERTV(Obj::nodeOfAddress(blocks[99]),
+                            0 == Obj::nodeOfAddress(blocks[99]));
+                }
+#endif
+
+                for (int i = 0; i < 100; ++i) {
+                    const int size = 1 + i * 97 % 5000;
+
+                    ASSERTV(node, i, i == blocks[i][0]);
+                    ASSERTV(node, i, i == blocks[i][size - 1]);
+                    pool.deallocate(blocks[i]);
+                }
+
+                pool.release();
+                ASSERTV(node, NUM_INTERNAL == ta.numBlocksInUse());
+
+                pool.deallocate(pool.allocate(8));
+            }
+            ASSERTV(node, 0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nWith 'bdlma::SequentialAllocator'." << endl;
+
+        for (int node = Obj::k_LOCAL_NODE; node <= 0; ++node) {
+            Obj                  mX(node);
+            bslma::TestAllocator ta("numa", veryVeryVerbose, &mX);
+            {
+                bdlma::SequentialAllocator arena(&ta);
+
+                for (int i = 0; i < 1000; ++i) {
+                    const int  size  = 1 + i * 131 % 3000;
+                    char      *block = static_cast<char *>(
+                                                        arena.allocate(size));
+
+                    bsl::memset(block, 'x', size);
+                }
+                ASSERTV(node, 0 < ta.numBlocksInUse());
+
+                arena.release();
+                ASSERTV(node, 0 == ta.numBlocksInUse());
+
+                arena.allocate(100000);
+                ASSERTV(node, 1 <= ta.numBlocksInUse());
+            }
+            ASSERTV(node, 0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nConcurrent use." << endl;
+        {
+            enum { NUM_THREADS = 4, NUM_ROUNDS = 200 };
+
+            Obj                  mX;
+            bslma::TestAllocator ta("numa", veryVeryVerbose, &mX);
+            bsls::AtomicInt      numErrors(0);
+
+            PoolThreadArgs args[NUM_THREADS];
+            ThreadId       ids[NUM_THREADS];
+
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                args[i].d_allocator_p = &ta;
+                args[i].d_index       = i;
+                args[i].d_numRounds   = NUM_ROUNDS;
+                args[i].d_numErrors_p = &numErrors;
+
+                ids[i] = createThread(&poolThread, &args[i]);
+            }
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+            }
+
+            ASSERTV(numErrors, 0 == numErrors);
+            ASSERTV(0 < ta.numBlocksTotal());
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 'allocate' returns a maximally-aligned block of (at least) the
+        //:   requested size, which may be written to in its entirety.
+        //:
+        //: 2 'allocate(0)' returns 0, and 'deallocate(0)' has no effect.
+        //:
+        //: 3 On Linux, the pages of a block allocated for a specified node
+        //:   carry the "preferred" policy, and lie on that node.
+        //:
+        //: 4 On Linux, the pages of a block allocated for a node that cannot
+        //:   be bound to carry the default policy, and have been touched.
+        //:
+        //: 5 On a single-node machine, the pages of a block allocated for the
+        //:   local node carry the default policy, and have not been touched.
+        //:
+        //: 6 No memory is obtained from the default allocator.
+        //
+        // Plan:
+        //: 1 Using a table of sizes around multiples of the page size,
+        //:   allocate blocks for the local node and for node 0, verify their
+        //:   alignment, write to every byte, and deallocate them.  (C-1)
+        //:
+        //: 2 Verify 'allocate(0)' and 'deallocate(0)'.  (C-2)
+        //:
+        //: 3 On Linux, observe the policy of the pages of each block with
+        //:   'get_mempolicy', and whether they were touched with 'mincore'.
+        //:   (C-3..5)
+        //:
+        //: 4 Verify that the default allocator is not used.  (C-6)
+        //
+        // Testing:
+        //   virtual void *allocate(size_type size);
+        //   virtual void deallocate(void *address);
+        //   CONCERN: Pages of a block are bound to the specified node.
+        //   CONCERN: Pages are touched if the node cannot be bound to.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'allocate' AND 'deallocate'" << endl
+                          << "===========================" << endl;
+
+        const int PAGE = pageSize();
+
+        if (verbose) cout << "\nZero-sized requests." << endl;
+        {
+            Obj mX;
+
+            ASSERT(0 == mX.allocate(0));
+            mX.deallocate(0);
+        }
+
+        if (verbose) cout << "\nBlocks of various sizes." << endl;
+
+        const int DATA[] = { 1, 2, 7, 8, 15, 16, 100, 1000,
+                             PAGE - 2 * MAX_ALIGN, PAGE - MAX_ALIGN,
+                             PAGE - MAX_ALIGN + 1, PAGE, PAGE + 1,
+                             3 * PAGE, 10 * PAGE + 17, 1 << 20 };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int node = Obj::k_LOCAL_NODE; node <= 0; ++node) {
+            Obj mX(node);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int SIZE = DATA[ti];
+
+                if (veryVerbose) { T_ P_(node) P(SIZE) }
+
+                char *p = static_cast<char *>(mX.allocate(SIZE));
+
+                ASSERTV(node, SIZE, p);
+                ASSERTV(node, SIZE,
+                        0 == reinterpret_cast<UintPtr>(p) % MAX_ALIGN);
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+                if (0 == node) {
+                    ASSERTV(SIZE, policyOfAddress(p),
+                            MPOL_PREFERRED_MODE == policyOfAddress(p));
+                    ASSERTV(SIZE, policyOfAddress(p + SIZE - 1),
+                            MPOL_PREFERRED_MODE ==
+                                              policyOfAddress(p + SIZE - 1));
+                }
+                else if (1 == Obj::numNodes()) {
+                    ASSERTV(SIZE, policyOfAddress(p),
+                            MPOL_DEFAULT_MODE == policyOfAddress(p));
+                    if (PAGE <= SIZE) {
+                        ASSERTV(SIZE, !isResident(p + SIZE - 1));
+                    }
+                }
+#endif
+
+                bsl::memset(p, 0xa5, SIZE);
+                ASSERTV(node, SIZE, static_cast<char>(0xa5) == p[SIZE - 1]);
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+                if (0 == node) {
+                    ASSERTV(SIZE, Obj::nodeOfAddress(p + SIZE - 1),
+                            0 == Obj::nodeOfAddress(p + SIZE - 1));
+                }
+#endif
+
+                mX.deallocate(p);
+            }
+        }
+
+        if (verbose) cout << "\nNodes that cannot be bound to." << endl;
+        {
+            const int NODES[] = { 1000, 1023, 1024, 5000 };
+            const int NUM_NODES = sizeof NODES / sizeof *NODES;
+
+            for (int ni = 0; ni < NUM_NODES; ++ni) {
+                const int NODE = NODES[ni];
+
+                if (NODE < Obj::numNodes()) {
+                    continue;
+                }
+
+                Obj mX(NODE);
+
+                char *p = static_cast<char *>(mX.allocate(3 * PAGE));
+
+                ASSERTV(NODE, p);
+                ASSERTV(NODE, 0 == reinterpret_cast<UintPtr>(p) % MAX_ALIGN);
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+                ASSERTV(NODE, policyOfAddress(p),
+                        MPOL_DEFAULT_MODE == policyOfAddress(p));
+                ASSERTV(NODE, isResident(p));
+                ASSERTV(NODE, isResident(p + 3 * PAGE - 1));
+#endif
+
+                bsl::memset(p, 'z', 3 * PAGE);
+                mX.deallocate(p);
+            }
+        }
+
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONSTRUCTOR AND 'node'
+        //
+        // Concerns:
+        //: 1 A default-constructed allocator places memory on the local node.
+        //:
+        //: 2 An allocator constructed for a node reports that node, whether
+        //:   or not it exists.
+        //:
+        //: 3 Construction and destruction use no memory.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Construct allocators for 'k_LOCAL_NODE' and for several nodes,
+        //:   and verify 'node'.  (C-1..2)
+        //:
+        //: 2 Verify that the default allocator is not used.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid node values (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-4)
+        //
+        // Testing:
+        //   explicit NumaAllocator(int node = k_LOCAL_NODE);
+        //   virtual ~NumaAllocator();
+        //   int node() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONSTRUCTOR AND 'node'" << endl
+                          << "======================" << endl;
+
+        {
+            const Obj X;
+
+            ASSERT(Obj::k_LOCAL_NODE == X.node());
+            ASSERT(-1                == X.node());
+        }
+
+        const int NODES[] = { Obj::k_LOCAL_NODE, 0, 1, 3, 63, 64, 1023, 5000 };
+        const int NUM_NODES = sizeof NODES / sizeof *NODES;
+
+        for (int ni = 0; ni < NUM_NODES; ++ni) {
+            const int NODE = NODES[ni];
+
+            const Obj X(NODE);
+
+            ASSERTV(NODE, X.node(), NODE == X.node());
+        }
+
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(Obj(-1));
+            ASSERT_PASS(Obj(0));
+            ASSERT_FAIL(Obj(-2));
+            ASSERT_FAIL(Obj(-100));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CLASS METHODS
+        //
+        // Concerns:
+        //: 1 'numNodes' returns a positive value, which does not change.
+        //:
+        //: 2 'currentNode' returns a node that is less than 1024, and, on
+        //:   platforms other than Linux, 0.
+        //:
+        //: 3 'nodeOfAddress' returns the node of a page that was touched,
+        //:   and, on platforms other than Linux, -1.
+        //
+        // Plan:
+        //: 1 Call 'numNodes' repeatedly and compare the values.  (C-1)
+        //:
+        //: 2 Call 'currentNode', and 'nodeOfAddress' for the address of a
+        //:   local variable, and verify the values against the number of
+        //:   nodes.  (C-2..3)
+        //
+        // Testing:
+        //   static int currentNode();
+        //   static int nodeOfAddress(const void *address);
+        //   static int numNodes();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CLASS METHODS" << endl
+                          << "=============" << endl;
+
+        const int NUM_NODES = Obj::numNodes();
+
+        if (verbose) { P(NUM_NODES) }
+
+        ASSERTV(NUM_NODES, 1 <= NUM_NODES);
+        ASSERTV(NUM_NODES, NUM_NODES <= 1024);
+
+        for (int i = 0; i < 10; ++i) {
+            ASSERTV(i, NUM_NODES == Obj::numNodes());
+        }
+
+        const int CURRENT = Obj::currentNode();
+
+        if (verbose) { P(CURRENT) }
+
+        ASSERTV(CURRENT, -1 <= CURRENT);
+        ASSERTV(CURRENT, CURRENT < 1024);
+
+        int       local = 0;
+        const int NODE  = Obj::nodeOfAddress(&local);
+
+        if (verbose) { P(NODE) }
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+        ASSERTV(CURRENT, 0 <= CURRENT);
+        ASSERTV(NODE, 0 <= NODE);
+        ASSERTV(NODE, NODE < 1024);
+
+        if (1 == NUM_NODES) {
+            ASSERTV(CURRENT, NODE, CURRENT == NODE);
+        }
+#else
+        ASSERTV(CURRENT, 0 == CURRENT);
+        ASSERTV(NODE, -1 == NODE);
+        ASSERTV(NUM_NODES, 1 == NUM_NODES);
+#endif
+
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks of several sizes, placed on the
+        //:   local node and on node 0, directly and through a pool.
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(Obj::k_LOCAL_NODE == X.node());
+
+            char *p = static_cast<char *>(mX.allocate(13));
+            bsl::strcpy(p, "hello, world");
+
+            char *q = static_cast<char *>(mX.allocate(100000));
+            bsl::memset(q, 'q', 100000);
+
+            ASSERT(0 == bsl::strcmp(p, "hello, world"));
+
+            mX.deallocate(p);
+            mX.deallocate(q);
+        }
+        {
+            Obj mX(0);  const Obj& X = mX;
+
+            ASSERT(0 == X.node());
+
+            bdlma::Multipool pool(&mX);
+
+            char *p = static_cast<char *>(pool.allocate(24));
+            bsl::strcpy(p, "hello, world");
+            pool.deallocate(p);
+        }
+
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: MEMORY LOCALITY
+        //
+        // Concerns:
+        //: 1 Memory placed on the node of the calling thread is accessed
+        //:   faster than memory placed on another node.
+        //
+        // Plan:
+        //: 1 For each node of the machine, and for memory obtained from
+        //:   'bslma::NewDeleteAllocator', allocate a buffer (of a size that
+        //:   may be specified on the command line, in megabytes, default 64),
+        //:   initialize it with a random cyclic chain of indices, and time a
+        //:   number of steps following the chain, and a sequential pass over
+        //:   the buffer.  Report the times along with the node on which the
+        //:   buffer lies.
+        //:   On a multi-node machine, the thread of this test may be pinned
+        //:   to a node, e.g., using 'numactl --cpunodebind'.
+        //
+        // Testing:
+        //   PERFORMANCE: MEMORY LOCALITY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: MEMORY LOCALITY" << endl
+                          << "============================" << endl;
+
+        const int         ARG_MB    = argc > 2 ? atoi(argv[2]) : 0;
+        const int         SIZE_MB   = 0 < ARG_MB ? ARG_MB : 64;
+        const bsl::size_t LENGTH    = static_cast<bsl::size_t>(SIZE_MB)
+                                    * 1024 * 1024 / sizeof(bsl::size_t);
+        const bsl::size_t NUM_STEPS = 10 * 1000 * 1000;
+
+        const int NUM_NODES = Obj::numNodes();
+
+        cout << "nodes: " << NUM_NODES
+             << ", current node: " << Obj::currentNode()
+             << ", buffer: " << SIZE_MB << "MB" << endl;
+        cout << "allocator       placed on  chase      sequential" << endl;
+
+        bsl::size_t checksum = 0;
+
+        for (int ni = -1; ni < NUM_NODES; ++ni) {
+            Obj               numa(ni < 0 ? Obj::k_LOCAL_NODE : ni);
+            bslma::Allocator *alloc = &numa;
+
+            if (ni < 0) {
+                alloc = &bslma::NewDeleteAllocator::singleton();
+            }
+
+            bsl::size_t *chain = static_cast<bsl::size_t *>(
+                                alloc->allocate(LENGTH * sizeof(bsl::size_t)));
+
+            initializeChain(chain, LENGTH);
+
+            bsl::size_t result;
+            const double chase      = chaseChain(chain, NUM_STEPS, &result);
+            checksum += result;
+            const double sequential = sumChain(chain, LENGTH, &result);
+            checksum += result;
+
+            if (ni < 0) {
+                cout << "new/delete\t";
+            }
+            else {
+                cout << "numa node " << ni << "\t";
+            }
+            cout << Obj::nodeOfAddress(chain + LENGTH / 2) << "\t   "
+                 << chase << "s\t" << sequential << "s" << endl;
+
+            alloc->deallocate(chain);
+        }
+
+        if (veryVerbose) { P(checksum) }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,495 @@
+// bdlma_threadarenaallocator.cpp                                     -*-C++-*-
+#include <bdlma_threadarenaallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_threadarenaallocator_cpp,"$Id$ $CSID$")
+
+#include <bdlma_pool.h>
+
+#include <bslma_autodestructor.h>
+#include <bslma_deallocatorproctor.h>
+#include <bslma_default.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_atomicoperations.h>
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+
+#include <bsl_new.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+namespace {
+
+// TYPES
+enum {
+    k_DEFAULT_NUM_POOLS = 10,  // default number of pools
+
+    k_MIN_BLOCK_SIZE    =  8   // minimum block size (in bytes)
+};
+
+struct Link {
+    // This 'struct' implements a link data structure that stores the address
+    // of the next link, and is used to implement the list of the blocks
+    // deallocated by threads other than the owner of a heap.  A link is
+    // stored in the first bytes of the block following its header.
+
+    Link *d_next_p;  // pointer to next link
+};
+
+struct BlockInfo {
+    // This 'struct' holds the information about a block needed to deallocate
+    // it.
+
+    ThreadArenaAllocator_Heap *d_heap_p;   // owning heap, or 0 if the block
+                                           // is not pooled
+
+    int                        d_poolIdx;  // index of the pool in the owning
+                                           // heap
+};
+
+struct Header {
+    // Stores the information needed to deallocate a block, and ensures that
+    // the memory following it is maximally aligned.
+
+    union {
+        BlockInfo                           d_info;   // block information
+        bsls::AlignmentUtil::MaxAlignedType d_dummy;  // force max. alignment
+    } d_header;
+};
+
+struct ThreadCache {
+    // This 'struct' holds the heap of the calling thread in the allocator it
+    // most recently used.  Allocators are identified by a number that is
+    // never reused, so that a cache that refers to a destroyed allocator is
+    // never consulted.
+
+    bsls::Types::Int64         d_allocatorId;  // identifier of the allocator
+                                               // whose heap is cached, or 0
+
+    ThreadArenaAllocator_Heap *d_heap_p;       // cached heap
+};
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+__declspec(thread) ThreadCache s_cache = { 0, 0 };
+#else
+__thread ThreadCache s_cache = { 0, 0 };
+#endif
+    // heap of the current thread in the allocator it most recently used; the
+    // address of this object also identifies the current thread among the
+    // running threads
+
+static bsls::AtomicOperations::AtomicTypes::Int64 s_lastId = { 0 };
+    // identifier of the most recently created allocator
+
+}  // close unnamed namespace
+
+                      // ===============================
+                      // class ThreadArenaAllocator_Heap
+                      // ===============================
+
+class ThreadArenaAllocator_Heap {
+    // This class holds the pools from which a single thread allocates memory
+    // using a 'ThreadArenaAllocator', and the list of the blocks of those
+    // pools that were deallocated by other threads.  Except for
+    // 'deallocateRemote', which may be called by any thread, the manipulators
+    // of this class may be called only by the owning thread.
+
+    // DATA
+    bsls::AtomicPointer<Link>  d_remoteBlocks;  // blocks deallocated by other
+                                                // threads, not yet returned
+                                                // to their pools
+
+    const void                *d_owner_p;       // identity of the owning
+                                                // thread
+
+    ThreadArenaAllocator_Heap *d_next_p;        // next heap of the allocator
+
+    Pool                      *d_pools_p;       // array of pools (owned)
+
+    int                        d_numPools;      // number of pools
+
+    bslma::Allocator          *d_allocator_p;   // memory allocator (held, not
+                                                // owned)
+
+  private:
+    // PRIVATE MANIPULATORS
+    void reclaimRemoteBlocks();
+        // Return the blocks deallocated by other threads to their pools.
+
+  private:
+    // NOT IMPLEMENTED
+    ThreadArenaAllocator_Heap(const ThreadArenaAllocator_Heap&);
+    ThreadArenaAllocator_Heap& operator=(const ThreadArenaAllocator_Heap&);
+
+  public:
+    // CREATORS
+    ThreadArenaAllocator_Heap(const void       *owner,
+                              int               numPools,
+                              bslma::Allocator *basicAllocator);
+        // Create a heap owned by the thread identified by the specified
+        // 'owner', having the specified 'numPools' pools, and using the
+        // specified 'basicAllocator' to supply memory.
+
+    ~ThreadArenaAllocator_Heap();
+        // Destroy this heap, releasing the memory of its pools back to the
+        // underlying allocator.
+
+    // MANIPULATORS
+    void *allocate(int poolIdx);
+        // Return the address of the memory following the header of a block
+        // allocated from the pool having the specified 'poolIdx'.
+
+    void deallocateLocal(Header *header);
+        // Return the block having the specified 'header' to its pool.  The
+        // behavior is undefined unless the block was allocated from this
+        // heap.
+
+    void deallocateRemote(Header *header);
+        // Push the block having the specified 'header' onto the list of the
+        // blocks of this heap deallocated by other threads.  The behavior is
+        // undefined unless the block was allocated from this heap.  Note
+        // that this method may be called by any thread.
+
+    void setNext(ThreadArenaAllocator_Heap *next);
+        // Set the heap following this heap in the list of the heaps of an
+        // allocator to the specified 'next'.
+
+    // ACCESSORS
+    ThreadArenaAllocator_Heap *next() const;
+        // Return the heap following this heap in the list of the heaps of an
+        // allocator.
+
+    const void *owner() const;
+        // Return the identity of the thread owning this heap.
+};
+
+                      // -------------------------------
+                      // class ThreadArenaAllocator_Heap
+                      // -------------------------------
+
+// PRIVATE MANIPULATORS
+void ThreadArenaAllocator_Heap::reclaimRemoteBlocks()
+{
+    Link *link = d_remoteBlocks.swapAcqRel(0);
+
+    while (link) {
+        Link   *next   = link->d_next_p;
+        Header *header = reinterpret_cast<Header *>(link) - 1;
+
+        d_pools_p[header->d_header.d_info.d_poolIdx].deallocate(header);
+        link = next;
+    }
+}
+
+// CREATORS
+ThreadArenaAllocator_Heap::ThreadArenaAllocator_Heap(
+                                              const void       *owner,
+                                              int               numPools,
+                                              bslma::Allocator *basicAllocator)
+: d_remoteBlocks(0)
+, d_owner_p(owner)
+, d_next_p(0)
+, d_numPools(numPools)
+, d_allocator_p(basicAllocator)
+{
+    d_pools_p = static_cast<Pool *>(
+                      d_allocator_p->allocate(d_numPools * sizeof *d_pools_p));
+
+    bslma::DeallocatorProctor<bslma::Allocator> autoPoolsDeallocator(
+                                                                d_pools_p,
+                                                                d_allocator_p);
+    bslma::AutoDestructor<Pool> autoDtor(d_pools_p, 0);
+
+    int blockSize = k_MIN_BLOCK_SIZE;
+
+    for (int i = 0; i < d_numPools; ++i, ++autoDtor) {
+        new (d_pools_p + i) Pool(blockSize + static_cast<int>(sizeof(Header)),
+                                 d_allocator_p);
+        blockSize *= 2;
+    }
+
+    autoDtor.release();
+    autoPoolsDeallocator.release();
+}
+
+ThreadArenaAllocator_Heap::~ThreadArenaAllocator_Heap()
+{
+    for (int i = 0; i < d_numPools; ++i) {
+        d_pools_p[i].~Pool();
+    }
+    d_allocator_p->deallocate(d_pools_p);
+}
+
+// MANIPULATORS
+inline
+void *ThreadArenaAllocator_Heap::allocate(int poolIdx)
+{
+    BSLS_ASSERT_SAFE(0       <= poolIdx);
+    BSLS_ASSERT_SAFE(poolIdx <  d_numPools);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_remoteBlocks.loadRelaxed())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        reclaimRemoteBlocks();
+    }
+
+    Header *header = static_cast<Header *>(d_pools_p[poolIdx].allocate());
+
+    header->d_header.d_info.d_heap_p  = this;
+    header->d_header.d_info.d_poolIdx = poolIdx;
+    return header + 1;
+}
+
+inline
+void ThreadArenaAllocator_Heap::deallocateLocal(Header *header)
+{
+    BSLS_ASSERT_SAFE(header);
+    BSLS_ASSERT_SAFE(this == header->d_header.d_info.d_heap_p);
+
+    d_pools_p[header->d_header.d_info.d_poolIdx].deallocate(header);
+}
+
+void ThreadArenaAllocator_Heap::deallocateRemote(Header *header)
+{
+    BSLS_ASSERT_SAFE(header);
+    BSLS_ASSERT_SAFE(this == header->d_header.d_info.d_heap_p);
+
+    // Only the owning thread removes links, and it always removes the whole
+    // list, so that pushing a link is not subject to the ABA problem.
+
+    Link *link = reinterpret_cast<Link *>(header + 1);
+    Link *head = d_remoteBlocks.loadRelaxed();
+
+    for (;;) {
+        link->d_next_p = head;
+
+        Link *previous = d_remoteBlocks.testAndSwapAcqRel(head, link);
+        if (previous == head) {
+            break;
+        }
+        head = previous;
+    }
+}
+
+inline
+void ThreadArenaAllocator_Heap::setNext(ThreadArenaAllocator_Heap *next)
+{
+    d_next_p = next;
+}
+
+// ACCESSORS
+inline
+ThreadArenaAllocator_Heap *ThreadArenaAllocator_Heap::next() const
+{
+    return d_next_p;
+}
+
+inline
+const void *ThreadArenaAllocator_Heap::owner() const
+{
+    return d_owner_p;
+}
+
+namespace {
+
+inline
+int findPool(int size)
+    // Return the index of the pool managing memory blocks of the smallest size
+    // not less than the specified 'size' (in bytes).  The behavior is
+    // undefined unless '0 <= size' and 'size' is not larger than the largest
+    // pooled block size.
+{
+    BSLS_ASSERT_SAFE(0 <= size);
+
+    int accumulator = ((size + k_MIN_BLOCK_SIZE - 1) >> 3) * 2 - 1;
+
+    accumulator |= accumulator >> 16;
+    accumulator |= accumulator >>  8;
+    accumulator |= accumulator >>  4;
+    accumulator |= accumulator >>  2;
+    accumulator |= accumulator >>  1;
+
+    unsigned input = accumulator;
+
+#if defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+    return __builtin_popcount(input) - 1;
+#else
+    input -= (input >> 1) & 0x55555555;
+
+    {
+        const int mask = 0x33333333;
+        input = ((input >> 2) & mask) + (input & mask);
+    }
+
+    input = ((input >>  4) + input) & 0x0f0f0f0f;
+    input =  (input >>  8) + input;
+    input =  (input >> 16) + input;
+
+    return (input & 0x000000ff) - 1;
+#endif
+}
+
+}  // close unnamed namespace
+
+                        // --------------------------
+                        // class ThreadArenaAllocator
+                        // --------------------------
+
+// PRIVATE MANIPULATORS
+ThreadArenaAllocator_Heap *ThreadArenaAllocator::localHeap()
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(d_id == s_cache.d_allocatorId)) {
+        return s_cache.d_heap_p;                                      // RETURN
+    }
+
+    const void *self = &s_cache;
+
+    ThreadArenaAllocator_Heap *heap = d_heaps.loadAcquire();
+    while (heap && self != heap->owner()) {
+        heap = heap->next();
+    }
+
+    if (!heap) {
+        // Only the calling thread creates a heap that it owns, so no other
+        // thread can insert one concurrently.
+
+        heap = static_cast<ThreadArenaAllocator_Heap *>(
+                                      d_allocator_p->allocate(sizeof *heap));
+
+        bslma::DeallocatorProctor<bslma::Allocator> autoHeapDeallocator(
+                                                                heap,
+                                                                d_allocator_p);
+        new (heap) ThreadArenaAllocator_Heap(self, d_numPools, d_allocator_p);
+        autoHeapDeallocator.release();
+
+        ThreadArenaAllocator_Heap *head = d_heaps.loadRelaxed();
+        for (;;) {
+            heap->setNext(head);
+
+            ThreadArenaAllocator_Heap *previous =
+                                        d_heaps.testAndSwapAcqRel(head, heap);
+            if (previous == head) {
+                break;
+            }
+            head = previous;
+        }
+    }
+
+    s_cache.d_allocatorId = d_id;
+    s_cache.d_heap_p      = heap;
+
+    return heap;
+}
+
+// CREATORS
+ThreadArenaAllocator::ThreadArenaAllocator(bslma::Allocator *basicAllocator)
+: d_id(bsls::AtomicOperations::addInt64NvRelaxed(&s_lastId, 1))
+, d_numPools(k_DEFAULT_NUM_POOLS)
+, d_maxBlockSize(static_cast<size_type>(k_MIN_BLOCK_SIZE)
+                 << (k_DEFAULT_NUM_POOLS - 1))
+, d_heaps(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+ThreadArenaAllocator::ThreadArenaAllocator(int               numPools,
+                                           bslma::Allocator *basicAllocator)
+: d_id(bsls::AtomicOperations::addInt64NvRelaxed(&s_lastId, 1))
+, d_numPools(numPools)
+, d_maxBlockSize(static_cast<size_type>(k_MIN_BLOCK_SIZE)
+                 << (numPools - 1))
+, d_heaps(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numPools);
+}
+
+ThreadArenaAllocator::~ThreadArenaAllocator()
+{
+    ThreadArenaAllocator_Heap *heap = d_heaps.loadAcquire();
+
+    while (heap) {
+        ThreadArenaAllocator_Heap *next = heap->next();
+
+        heap->~ThreadArenaAllocator_Heap();
+        d_allocator_p->deallocate(heap);
+        heap = next;
+    }
+}
+
+// MANIPULATORS
+void *ThreadArenaAllocator::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        return 0;                                                     // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(size <= d_maxBlockSize)) {
+        return localHeap()->allocate(findPool(static_cast<int>(size)));
+                                                                      // RETURN
+    }
+
+    // The requested size is large and will not be pooled.
+
+    Header *header = static_cast<Header *>(
+                               d_allocator_p->allocate(size + sizeof(Header)));
+
+    header->d_header.d_info.d_heap_p  = 0;
+    header->d_header.d_info.d_poolIdx = -1;
+    return header + 1;
+}
+
+void ThreadArenaAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        return;                                                       // RETURN
+    }
+
+    Header *header = static_cast<Header *>(address) - 1;
+
+    ThreadArenaAllocator_Heap *heap = header->d_header.d_info.d_heap_p;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == heap)) {
+        d_allocator_p->deallocate(header);
+    }
+    else if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(&s_cache == heap->owner())) {
+        heap->deallocateLocal(header);
+    }
+    else {
+        heap->deallocateRemote(header);
+    }
+}
+
+// ACCESSORS
+int ThreadArenaAllocator::numHeaps() const
+{
+    int numHeaps = 0;
+
+    for (const ThreadArenaAllocator_Heap *heap = d_heaps.loadAcquire();
+         heap;
+         heap = heap->next()) {
+        ++numHeaps;
+    }
+    return numHeaps;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,271 @@
+// bdlma_threadarenaallocator.h                                       -*-C++-*-
+#ifndef INCLUDED_BDLMA_THREADARENAALLOCATOR
+#define INCLUDED_BDLMA_THREADARENAALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a thread-safe allocator pooling memory in per-thread heaps.
+//
+//@CLASSES:
+//  bdlma::ThreadArenaAllocator: allocator with a pool heap for each thread
+//
+//@SEE_ALSO: bdlma_pool, bdlma_multipoolallocator
+//
+//@DESCRIPTION: This component provides a thread-safe allocator,
+// 'bdlma::ThreadArenaAllocator', that implements the 'bslma::Allocator'
+// protocol, and that dispenses memory from a separate heap for each thread
+// that uses it, so that threads allocating and deallocating memory
+// concurrently do not contend on a lock:
+//..
+//   ,---------------------------.
+//  ( bdlma::ThreadArenaAllocator )
+//   `---------------------------'
+//                 |         ctor/dtor
+//                 |         maxPooledBlockSize
+//                 |         numHeaps
+//                 |         numPools
+//                 V
+//         ,----------------.
+//        ( bslma::Allocator )
+//         `----------------'
+//                           allocate
+//                           deallocate
+//..
+// A heap is created the first time a thread allocates memory from a
+// 'bdlma::ThreadArenaAllocator'.  Like a 'bdlma::MultipoolAllocator', each
+// heap maintains a configurable number of 'bdlma::Pool' objects, each
+// dispensing maximally-aligned memory blocks of a unique size, with each
+// successive pool managing memory blocks of a size twice that of the previous
+// pool (starting at 8 bytes).  An allocation request is served by the pool
+// managing memory blocks of the smallest size not less than the requested
+// size in the heap of the calling thread, which only that thread manipulates.
+// A request larger than the largest pooled block size
+// ('maxPooledBlockSize') is passed through to the underlying allocator.
+//
+///Deallocation by Another Thread
+///------------------------------
+// Each block records the heap from which it was allocated.  A block
+// deallocated by the thread that allocated it is returned directly to the
+// pool from which it was obtained.  A block deallocated by any other thread
+// (e.g., a message produced by one thread and consumed by another) is pushed,
+// without locking, onto a list of "remote" blocks held by the heap that owns
+// it, and is returned to its pool by the owning thread the next time it
+// allocates memory.  Thread safety is therefore obtained at the cost of a
+// single atomic operation for a cross-thread deallocation, and of a single
+// (relaxed) atomic load for an allocation.
+//
+///Lifetime of Heaps
+///-----------------
+// A heap is never destroyed before the allocator.  The memory dispensed by
+// the heap of a thread that has exited remains pooled by that heap, and is
+// reused only if a thread subsequently created happens to be identified
+// (internally) by the operating system as the exited thread.  A
+// 'bdlma::ThreadArenaAllocator' is therefore intended for use by a bounded
+// set of long-lived threads (e.g., the threads of a thread pool), rather than
+// by a stream of short-lived threads.
+//
+// The destructor of a 'bdlma::ThreadArenaAllocator' releases all memory that
+// was pooled by its heaps, whether or not it is currently allocated, back to
+// the underlying allocator.  Blocks larger than 'maxPooledBlockSize' are not
+// tracked by the allocator, and must be deallocated before it is destroyed.
+//
+///Thread Safety
+///-------------
+// The 'allocate' and 'deallocate' methods of a 'bdlma::ThreadArenaAllocator'
+// may be called concurrently by any number of threads.  The underlying
+// allocator supplied at construction must be thread-safe (e.g.,
+// 'bslma::NewDeleteAllocator' or 'bslma::MallocFreeAllocator'), since each
+// heap obtains memory from it independently.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sharing an Allocator Among the Threads of a Pipeline
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that the stages of a pipeline run on different threads, and that
+// messages allocated by one stage are deallocated by the next one.  A
+// 'bdlma::MultipoolAllocator' cannot be shared by the stages without a lock,
+// whereas a 'bdlma::ThreadArenaAllocator' can.
+//
+// First, we create a 'bdlma::ThreadArenaAllocator' pooling blocks of up to 64
+// bytes:
+//..
+//  bdlma::ThreadArenaAllocator allocator(4);
+//  assert(64 == allocator.maxPooledBlockSize());
+//  assert( 0 == allocator.numHeaps());
+//..
+// Then, the first stage allocates a message, which creates the heap of its
+// thread:
+//..
+//  char *message = static_cast<char *>(allocator.allocate(48));
+//  bsl::strcpy(message, "NEW ORDER IBM 100@150");
+//
+//  assert(1 == allocator.numHeaps());
+//..
+// Finally, the second stage deallocates the message when it has processed it.
+// Had it run on another thread, the block would have been handed back to the
+// heap of the first thread, to be reused by its next allocation:
+//..
+//  allocator.deallocate(message);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+class ThreadArenaAllocator_Heap;
+
+                        // ==========================
+                        // class ThreadArenaAllocator
+                        // ==========================
+
+class ThreadArenaAllocator : public bslma::Allocator {
+    // This class implements the 'bslma::Allocator' protocol to provide a
+    // thread-safe allocator that dispenses memory blocks from 'bdlma::Pool'
+    // objects held in a heap specific to the calling thread.  Blocks
+    // deallocated by a thread other than the one that allocated them are
+    // returned, without locking, to the heap of the allocating thread.
+
+    // DATA
+    const bsls::Types::Int64  d_id;         // unique identifier of this
+                                            // allocator, used to key the heap
+                                            // cached by each thread
+
+    const int                 d_numPools;   // number of pools in each heap
+
+    const size_type           d_maxBlockSize;
+                                            // largest pooled block size
+
+    bsls::AtomicPointer<ThreadArenaAllocator_Heap>
+                              d_heaps;      // list of heaps (owned)
+
+    bslma::Allocator         *d_allocator_p;
+                                            // memory allocator (held, not
+                                            // owned)
+
+  private:
+    // PRIVATE MANIPULATORS
+    ThreadArenaAllocator_Heap *localHeap();
+        // Return the address of the heap of the calling thread, creating it if
+        // the calling thread has never allocated memory from this allocator.
+
+  private:
+    // NOT IMPLEMENTED
+    ThreadArenaAllocator(const ThreadArenaAllocator&);
+    ThreadArenaAllocator& operator=(const ThreadArenaAllocator&);
+
+  public:
+    // CREATORS
+    explicit
+    ThreadArenaAllocator(bslma::Allocator *basicAllocator = 0);
+    explicit
+    ThreadArenaAllocator(int numPools, bslma::Allocator *basicAllocator = 0);
+        // Create a thread-arena allocator.  Optionally specify 'numPools',
+        // indicating the number of internal pools of each heap.  If
+        // 'numPools' is not specified, an implementation-defined number of
+        // pools is used.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless
+        // '1 <= numPools' and the underlying allocator is thread-safe.
+
+    virtual ~ThreadArenaAllocator();
+        // Destroy this allocator, releasing all memory pooled by its heaps
+        // back to the underlying allocator.  The behavior is undefined unless
+        // every block larger than 'maxPooledBlockSize()' obtained from this
+        // allocator has been deallocated, and no other thread is using this
+        // allocator.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return the address of a contiguous block of maximally-aligned memory
+        // of (at least) the specified 'size' (in bytes).  If 'size' is 0, no
+        // memory is allocated and 0 is returned.  If
+        // 'size > maxPooledBlockSize()', the memory is obtained directly from
+        // the underlying allocator; otherwise, it is dispensed by the heap of
+        // the calling thread.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' back to this
+        // allocator.  If 'address' is 0, this function has no effect.  If the
+        // block was allocated by another thread, it is handed back to the
+        // heap of that thread.  The behavior is undefined unless 'address'
+        // was allocated using this allocator object and has not already been
+        // deallocated.
+
+    // ACCESSORS
+    size_type maxPooledBlockSize() const;
+        // Return the maximum size of a memory block that is pooled by the
+        // heaps of this allocator.  Requests for larger blocks are passed
+        // through to the underlying allocator.
+
+    int numHeaps() const;
+        // Return the number of heaps of this allocator, i.e., the number of
+        // threads that have allocated memory from it.  Note that the value
+        // returned may be out of date by the time it is used if other threads
+        // are using this allocator.
+
+    int numPools() const;
+        // Return the number of pools of each heap of this allocator.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                        // --------------------------
+                        // class ThreadArenaAllocator
+                        // --------------------------
+
+// ACCESSORS
+inline
+ThreadArenaAllocator::size_type
+ThreadArenaAllocator::maxPooledBlockSize() const
+{
+    return d_maxBlockSize;
+}
+
+inline
+int ThreadArenaAllocator::numPools() const
+{
+    return d_numPools;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
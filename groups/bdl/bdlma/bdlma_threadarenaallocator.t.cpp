@@ -0,0 +1,1207 @@
+// bdlma_threadarenaallocator.t.cpp                                   -*-C++-*-
+#include <bdlma_threadarenaallocator.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_objectbuffer.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_new.h>
+#include <bsl_set.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a thread-safe allocator that dispenses memory
+// from 'bdlma::Pool' objects held in a heap for each thread using it, and that
+// hands blocks deallocated by another thread back to the heap that owns them.
+// The primary concerns are that blocks of each size are served by the
+// appropriate pool (or passed through to the underlying allocator), are
+// maximally aligned, and are reused once deallocated, whether by the thread
+// that allocated them or by another one; that each thread obtains its own
+// heap; that a thread using several allocators (including an allocator
+// created at the address of a destroyed one) uses the right heap of each; that
+// concurrent use by several threads does not corrupt memory; and that the
+// destructor releases all pooled memory.  We use 'bslma::TestAllocator' to
+// verify the memory behavior, and 'pthread' (or the Windows thread API) to
+// exercise the allocator from several threads.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit ThreadArenaAllocator(Allocator *ba = 0);
+// [ 2] explicit ThreadArenaAllocator(int numPools, Allocator *ba = 0);
+// [ 3] virtual ~ThreadArenaAllocator();
+//
+// MANIPULATORS
+// [ 3] virtual void *allocate(size_type size);
+// [ 3] virtual void deallocate(void *address);
+//
+// ACCESSORS
+// [ 2] size_type maxPooledBlockSize() const;
+// [ 4] int numHeaps() const;
+// [ 2] int numPools() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] CONCERN: Each thread allocates from its own heap.
+// [ 4] CONCERN: Blocks deallocated by another thread are reused.
+// [ 5] CONCERN: A thread may use several allocators.
+// [ 6] CONCERN: The allocator may be used concurrently by several threads
+// [ 7] USAGE EXAMPLE
+// [-1] PERFORMANCE: COMPARISON WITH 'bslma::NewDeleteAllocator'
+//=============================================================================
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlma::ThreadArenaAllocator Obj;
+typedef bsls::Types::UintPtr        UintPtr;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+const int MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+void yieldThread()
+    // Offer the processor to another thread.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+static
+bsl::size_t blockSize(int sequence, bsl::size_t maxSize)
+    // Return a size, between 1 and the specified 'maxSize', for the block
+    // having the specified 'sequence' number.
+{
+    return 1 + static_cast<bsl::size_t>(sequence) * 7919 % maxSize;
+}
+
+class Barrier {
+    // This class implements a spinning barrier at which a fixed number of
+    // threads wait for each other.
+
+    // DATA
+    bsls::AtomicInt d_numArrived;   // number of threads waiting
+    bsls::AtomicInt d_generation;   // number of times the barrier opened
+    const int       d_numThreads;   // number of threads
+
+  public:
+    // CREATORS
+    explicit
+    Barrier(int numThreads)
+        // Create a barrier for the specified 'numThreads' threads.
+    : d_numArrived(0)
+    , d_generation(0)
+    , d_numThreads(numThreads)
+    {
+    }
+
+    // MANIPULATORS
+    void wait()
+        // Wait until the number of threads specified at construction have
+        // called this method.
+    {
+        const int generation = d_generation.loadAcquire();
+
+        if (d_numThreads == d_numArrived.addAcqRel(1)) {
+            d_numArrived.storeRelaxed(0);
+            d_generation.storeRelease(generation + 1);
+            return;                                                   // RETURN
+        }
+
+        while (generation == d_generation.loadAcquire()) {
+            yieldThread();
+        }
+    }
+};
+
+                        // ==========================
+                        // struct ExchangeTestContext
+                        // ==========================
+
+struct ExchangeTestContext {
+    // This 'struct' holds the data shared by the threads of a test in which,
+    // at each round, every thread allocates a batch of blocks, and then
+    // deallocates the batch allocated by the next thread.
+
+    bslma::Allocator  *d_allocator_p;   // allocator under test
+    int                d_numThreads;    // number of threads
+    int                d_numRounds;     // number of rounds
+    int                d_batchSize;     // number of blocks in a batch
+    bsl::size_t        d_maxSize;       // maximum size of a block
+    bool               d_checkContents; // whether to fill and verify blocks
+    char            ***d_batches_p;     // batch of each thread
+    Barrier           *d_barrier_p;     // barrier separating the phases
+    bsls::AtomicInt    d_numErrors;     // number of corrupted blocks
+};
+
+struct ExchangeThreadArgs {
+    // This 'struct' holds the arguments of a thread of an exchange test.
+
+    ExchangeTestContext *d_context_p;  // shared data
+    int                  d_index;      // index of the thread
+};
+
+extern "C" void *exchangeThread(void *arg)
+    // Run, with the specified 'arg' referring to an 'ExchangeThreadArgs', the
+    // rounds of an exchange test: allocate a batch of blocks, filled with a
+    // pattern specific to this thread and the round, wait for the other
+    // threads, then verify and deallocate the batch of the next thread, and
+    // wait for the other threads again.
+{
+    ExchangeThreadArgs  *args    = static_cast<ExchangeThreadArgs *>(arg);
+    ExchangeTestContext *context = args->d_context_p;
+
+    const int index = args->d_index;
+    const int next  = (index + 1) % context->d_numThreads;
+
+    char **batch     = context->d_batches_p[index];
+    char **nextBatch = context->d_batches_p[next];
+
+    for (int round = 0; round < context->d_numRounds; ++round) {
+        for (int i = 0; i < context->d_batchSize; ++i) {
+            const bsl::size_t size = blockSize(
+                                              round * context->d_batchSize + i,
+                                              context->d_maxSize);
+
+            batch[i] = static_cast<char *>(
+                                      context->d_allocator_p->allocate(size));
+            if (context->d_checkContents) {
+                bsl::memset(batch[i], 'A' + (index + round) % 26, size);
+            }
+        }
+
+        context->d_barrier_p->wait();
+
+        for (int i = 0; i < context->d_batchSize; ++i) {
+            if (context->d_checkContents) {
+                const bsl::size_t size = blockSize(
+                                              round * context->d_batchSize + i,
+                                              context->d_maxSize);
+                const char        c    = static_cast<char>(
+                                                 'A' + (next + round) % 26);
+
+                for (bsl::size_t j = 0; j < size; ++j) {
+                    if (c != nextBatch[i][j]) {
+                        context->d_numErrors.addRelaxed(1);
+                        break;
+                    }
+                }
+            }
+            context->d_allocator_p->deallocate(nextBatch[i]);
+        }
+
+        context->d_barrier_p->wait();
+    }
+    return 0;
+}
+
+static
+void runExchangeTest(bslma::Allocator *allocator,
+                     int               numThreads,
+                     int               numRounds,
+                     int               batchSize,
+                     bsl::size_t       maxSize,
+                     bool              checkContents,
+                     int              *numErrors)
+    // Run an exchange test of the specified 'numRounds' rounds with the
+    // specified 'numThreads' threads, each allocating at each round, from the
+    // specified 'allocator', the specified 'batchSize' blocks of at most the
+    // specified 'maxSize' bytes, and deallocating the batch of the next
+    // thread.  If the specified 'checkContents' is 'true', fill each block
+    // with a pattern, and verify it before deallocating the block.  Load into
+    // the specified 'numErrors' the number of corrupted blocks.
+{
+    bslma::Allocator *sa = &bslma::NewDeleteAllocator::singleton();
+
+    Barrier barrier(numThreads);
+
+    ExchangeTestContext context;
+    context.d_allocator_p   = allocator;
+    context.d_numThreads    = numThreads;
+    context.d_numRounds     = numRounds;
+    context.d_batchSize     = batchSize;
+    context.d_maxSize       = maxSize;
+    context.d_checkContents = checkContents;
+    context.d_barrier_p     = &barrier;
+    context.d_batches_p     = static_cast<char ***>(
+                                   sa->allocate(numThreads * sizeof(char **)));
+
+    ExchangeThreadArgs *args = static_cast<ExchangeThreadArgs *>(
+                        sa->allocate(numThreads * sizeof(ExchangeThreadArgs)));
+    ThreadId           *ids  = static_cast<ThreadId *>(
+                                  sa->allocate(numThreads * sizeof(ThreadId)));
+
+    for (int i = 0; i < numThreads; ++i) {
+        context.d_batches_p[i] = static_cast<char **>(
+                                     sa->allocate(batchSize * sizeof(char *)));
+        args[i].d_context_p = &context;
+        args[i].d_index     = i;
+    }
+
+    for (int i = 0; i < numThreads; ++i) {
+        ids[i] = createThread(&exchangeThread, &args[i]);
+    }
+    for (int i = 0; i < numThreads; ++i) {
+        joinThread(ids[i]);
+    }
+
+    *numErrors = context.d_numErrors;
+
+    for (int i = 0; i < numThreads; ++i) {
+        sa->deallocate(context.d_batches_p[i]);
+    }
+    sa->deallocate(ids);
+    sa->deallocate(args);
+    sa->deallocate(context.d_batches_p);
+}
+
+                         // =========================
+                         // struct AllocateThreadArgs
+                         // =========================
+
+struct AllocateThreadArgs {
+    // This 'struct' holds the arguments of a thread allocating a block.
+
+    bslma::Allocator *d_allocator_p;  // allocator of the block
+    Barrier          *d_barrier_p;    // barrier at which the threads wait
+    void             *d_block_p;      // allocated block
+};
+
+extern "C" void *allocateThread(void *arg)
+    // Allocate a block of 8 bytes from the allocator of the
+    // 'AllocateThreadArgs' referred to by the specified 'arg', load its
+    // address into that object, and wait at its barrier, so that the threads
+    // allocating blocks all run at the same time.
+{
+    AllocateThreadArgs *args = static_cast<AllocateThreadArgs *>(arg);
+
+    args->d_block_p = args->d_allocator_p->allocate(8);
+    args->d_barrier_p->wait();
+    return 0;
+}
+
+                        // ===========================
+                        // struct DeallocateThreadArgs
+                        // ===========================
+
+struct DeallocateThreadArgs {
+    // This 'struct' holds the arguments of a thread deallocating blocks.
+
+    bslma::Allocator  *d_allocator_p;  // allocator of the blocks
+    void             **d_blocks_p;     // blocks to deallocate
+    int                d_numBlocks;    // number of blocks
+};
+
+extern "C" void *deallocateThread(void *arg)
+    // Deallocate the blocks described by the 'DeallocateThreadArgs' referred
+    // to by the specified 'arg'.
+{
+    DeallocateThreadArgs *args = static_cast<DeallocateThreadArgs *>(arg);
+
+    for (int i = 0; i < args->d_numBlocks; ++i) {
+        args->d_allocator_p->deallocate(args->d_blocks_p[i]);
+    }
+    return 0;
+}
+
+                        // ============================
+                        // struct LocalBenchmarkContext
+                        // ============================
+
+struct LocalBenchmarkContext {
+    // This 'struct' holds the parameters of a thread of a benchmark in which
+    // every thread deallocates the blocks it allocated.
+
+    bslma::Allocator *d_allocator_p;  // allocator under test
+    int               d_numRounds;    // number of rounds
+    int               d_batchSize;    // number of blocks in a batch
+    bsl::size_t       d_maxSize;      // maximum size of a block
+};
+
+extern "C" void *localBenchmarkThread(void *arg)
+    // Run, with the specified 'arg' referring to a 'LocalBenchmarkContext',
+    // the rounds of a benchmark, each allocating a batch of blocks and then
+    // deallocating them.
+{
+    LocalBenchmarkContext *context = static_cast<LocalBenchmarkContext *>(arg);
+
+    char *batch[256];
+    BSLS_ASSERT(context->d_batchSize <= 256);
+
+    for (int round = 0; round < context->d_numRounds; ++round) {
+        for (int i = 0; i < context->d_batchSize; ++i) {
+            batch[i] = static_cast<char *>(context->d_allocator_p->allocate(
+                                    blockSize(round + i, context->d_maxSize)));
+            batch[i][0] = 0;
+        }
+        for (int i = 0; i < context->d_batchSize; ++i) {
+            context->d_allocator_p->deallocate(batch[i]);
+        }
+    }
+    return 0;
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+//=============================================================================
+//                                MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sharing an Allocator Among the Threads of a Pipeline
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that the stages of a pipeline run on different threads, and that
+// messages allocated by one stage are deallocated by the next one.  A
+// 'bdlma::MultipoolAllocator' cannot be shared by the stages without a lock,
+// whereas a 'bdlma::ThreadArenaAllocator' can.
+//
+// First, we create a 'bdlma::ThreadArenaAllocator' pooling blocks of up to 64
+// bytes:
+//..
+    bdlma::ThreadArenaAllocator allocator(4);
+    ASSERT(64 == allocator.maxPooledBlockSize());
+    ASSERT( 0 == allocator.numHeaps());
+//..
+// Then, the first stage allocates a message, which creates the heap of its
+// thread:
+//..
+    char *message = static_cast<char *>(allocator.allocate(48));
+    bsl::strcpy(message, "NEW ORDER IBM 100@150");
+
+    ASSERT(1 == allocator.numHeaps());
+//..
+// Finally, the second stage deallocates the message when it has processed it.
+// Had it run on another thread, the block would have been handed back to the
+// heap of the first thread, to be reused by its next allocation:
+//..
+    allocator.deallocate(message);
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENT USE BY SEVERAL THREADS
+        //
+        // Concerns:
+        //: 1 Several threads may concurrently allocate blocks and deallocate
+        //:   blocks allocated by other threads without corrupting memory.
+        //:
+        //: 2 Each thread using the allocator obtains a heap.
+        //:
+        //: 3 All memory is released to the underlying allocator on
+        //:   destruction, including blocks handed back to heaps.
+        //
+        // Plan:
+        //: 1 For several numbers of threads, run rounds in which each thread
+        //:   allocates a batch of blocks of varied sizes (some exceeding the
+        //:   maximum pooled block size), filled with a pattern, and then
+        //:   verifies and deallocates the batch of the next thread.  Verify
+        //:   that no block was corrupted, and that the number of heaps is the
+        //:   number of threads.  (C-1..2)
+        //:
+        //: 2 Verify that no memory remains in use once the allocator is
+        //:   destroyed.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: The allocator may be used concurrently by several threads
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT USE BY SEVERAL THREADS" << endl
+                          << "=================================" << endl;
+
+        const int NUM_THREADS[] = { 2, 3, 4, 8 };
+        const int NUM_DATA      = sizeof NUM_THREADS / sizeof *NUM_THREADS;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int NT = NUM_THREADS[ti];
+
+            if (veryVerbose) { T_ P(NT) }
+
+            bslma::TestAllocator sa("supplied", veryVeryVerbose);
+            {
+                Obj mX(6, &sa);  const Obj& X = mX;
+
+                int numErrors = -1;
+                runExchangeTest(&mX, NT, 100, 64, 300, true, &numErrors);
+
+                ASSERTV(NT, numErrors, 0  == numErrors);
+                ASSERTV(NT, X.numHeaps(), NT == X.numHeaps());
+            }
+            ASSERTV(NT, sa.numBlocksInUse(), 0 == sa.numBlocksInUse());
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // USE OF SEVERAL ALLOCATORS BY A THREAD
+        //
+        // Concerns:
+        //: 1 A thread alternately using several allocators allocates from its
+        //:   heap in each of them, and creates only one heap in each.
+        //:
+        //: 2 A thread allocating from an allocator created at the address of
+        //:   a destroyed allocator (from which it allocated) does not use the
+        //:   heap of the destroyed allocator.
+        //
+        // Plan:
+        //: 1 Alternately allocate blocks from two allocators using distinct
+        //:   underlying allocators.  Verify that each underlying allocator
+        //:   supplies memory only to its allocator, that each allocator has a
+        //:   single heap, and that deallocated blocks are reused.  (C-1)
+        //:
+        //: 2 Repeatedly create, in the same storage, an allocator, and
+        //:   allocate a block from it.  Verify that the underlying allocator
+        //:   of each allocator supplied its memory.  (C-2)
+        //
+        // Testing:
+        //   CONCERN: A thread may use several allocators.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USE OF SEVERAL ALLOCATORS BY A THREAD" << endl
+                          << "=====================================" << endl;
+
+        if (verbose) cout << "\nAlternating between two allocators." << endl;
+        {
+            bslma::TestAllocator sa1("supplied1", veryVeryVerbose);
+            bslma::TestAllocator sa2("supplied2", veryVeryVerbose);
+
+            Obj mX1(&sa1);  const Obj& X1 = mX1;
+            Obj mX2(&sa2);  const Obj& X2 = mX2;
+
+            void *p1 = mX1.allocate(16);
+            void *p2 = mX2.allocate(16);
+
+            const bsls::Types::Int64 N1 = sa1.numBlocksTotal();
+            const bsls::Types::Int64 N2 = sa2.numBlocksTotal();
+
+            ASSERT(0 < N1);
+            ASSERT(0 < N2);
+
+            for (int i = 0; i < 10; ++i) {
+                mX1.deallocate(p1);
+                mX2.deallocate(p2);
+
+                ASSERTV(i, p1 == mX1.allocate(16));
+                ASSERTV(i, p2 == mX2.allocate(16));
+            }
+
+            ASSERT(N1 == sa1.numBlocksTotal());
+            ASSERT(N2 == sa2.numBlocksTotal());
+
+            ASSERT(1 == X1.numHeaps());
+            ASSERT(1 == X2.numHeaps());
+
+            mX1.deallocate(p1);
+            mX2.deallocate(p2);
+        }
+
+        if (verbose) cout << "\nRecreating an allocator in place." << endl;
+        {
+            bsls::ObjectBuffer<Obj> buffer;
+
+            for (int i = 0; i < 4; ++i) {
+                bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+                Obj *mX = new (buffer.buffer()) Obj(&sa);
+
+                ASSERTV(i, 0 == mX->numHeaps());
+
+                void *p = mX->allocate(32);
+                ASSERTV(i, p);
+                ASSERTV(i, 0 < sa.numBlocksInUse());
+                ASSERTV(i, 1 == mX->numHeaps());
+
+                mX->deallocate(p);
+                mX->~Obj();
+
+                ASSERTV(i, 0 == sa.numBlocksInUse());
+            }
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // HEAPS AND DEALLOCATION BY ANOTHER THREAD
+        //
+        // Concerns:
+        //: 1 A heap is created for each thread the first time it allocates
+        //:   memory, and only then.
+        //:
+        //: 2 Blocks allocated by different threads are distinct.
+        //:
+        //: 3 A block deallocated by another thread is reused by the thread
+        //:   that allocated it, without obtaining memory from the underlying
+        //:   allocator.
+        //:
+        //: 4 A thread that only deallocates memory does not create a heap.
+        //
+        // Plan:
+        //: 1 Allocate a block from the main thread and from each of several
+        //:   threads running at the same time, and verify that the blocks are
+        //:   distinct and that the number of heaps is incremented by each
+        //:   thread.  (C-1..2)
+        //:
+        //: 2 Allocate a number of blocks from the main thread, deallocate them
+        //:   from another thread, and verify that the main thread obtains the
+        //:   same blocks when it allocates the same number of blocks again,
+        //:   that no memory was obtained from the underlying allocator, and
+        //:   that the number of heaps is unchanged.  (C-3..4)
+        //
+        // Testing:
+        //   int numHeaps() const;
+        //   CONCERN: Each thread allocates from its own heap.
+        //   CONCERN: Blocks deallocated by another thread are reused.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "HEAPS AND DEALLOCATION BY ANOTHER THREAD" << endl
+                          << "========================================"
+                          << endl;
+
+        if (verbose) cout << "\nA heap for each thread." << endl;
+        {
+            bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+            Obj mX(&sa);  const Obj& X = mX;
+
+            ASSERT(0 == X.numHeaps());
+
+            void *p = mX.allocate(8);
+            ASSERT(1 == X.numHeaps());
+
+            enum { NUM_THREADS = 4 };
+
+            bsl::set<void *> blocks;
+            blocks.insert(p);
+
+            Barrier            barrier(NUM_THREADS);
+            AllocateThreadArgs args[NUM_THREADS];
+            ThreadId           ids[NUM_THREADS];
+
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                args[i].d_allocator_p = &mX;
+                args[i].d_barrier_p   = &barrier;
+                args[i].d_block_p     = 0;
+
+                ids[i] = createThread(&allocateThread, &args[i]);
+            }
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+            }
+
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                void *q = args[i].d_block_p;
+
+                ASSERTV(i, q);
+                ASSERTV(i, blocks.insert(q).second);
+            }
+            ASSERTV(X.numHeaps(), NUM_THREADS + 1 == X.numHeaps());
+
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                mX.deallocate(args[i].d_block_p);
+            }
+            ASSERTV(X.numHeaps(), NUM_THREADS + 1 == X.numHeaps());
+
+            mX.deallocate(p);
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\nDeallocation by another thread." << endl;
+        {
+            enum { NUM_BLOCKS = 100 };
+
+            bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+            Obj mX(&sa);  const Obj& X = mX;
+
+            void *blocks[NUM_BLOCKS];
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate(blockSize(i, 64));
+            }
+
+            const bsls::Types::Int64 NUM_TOTAL = sa.numBlocksTotal();
+
+            ASSERT(1 == X.numHeaps());
+
+            DeallocateThreadArgs args = { &mX, blocks, NUM_BLOCKS };
+
+            joinThread(createThread(&deallocateThread, &args));
+
+            ASSERT(1 == X.numHeaps());
+
+            bsl::set<void *> allocated(blocks, blocks + NUM_BLOCKS);
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate(blockSize(i, 64));
+                ASSERTV(i, 1 == allocated.erase(blocks[i]));
+            }
+            ASSERT(allocated.empty());
+
+            ASSERTV(NUM_TOTAL, sa.numBlocksTotal(),
+                    NUM_TOTAL == sa.numBlocksTotal());
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // ALLOCATE, DEALLOCATE, AND DESTRUCTOR
+        //
+        // Concerns:
+        //: 1 'allocate' returns 0 for a request of 0 bytes, and a maximally
+        //:   aligned block, which may be written in its entirety, otherwise.
+        //:
+        //: 2 Blocks no larger than 'maxPooledBlockSize' are pooled, so that
+        //:   a deallocated block is reused by a request served by the same
+        //:   pool.
+        //:
+        //: 3 Larger blocks are obtained from, and returned to, the underlying
+        //:   allocator.
+        //:
+        //: 4 'deallocate' has no effect if its argument is 0.
+        //:
+        //: 5 The destructor releases all pooled memory to the underlying
+        //:   allocator, whether or not it is allocated.
+        //:
+        //: 6 No memory is obtained from the default allocator.
+        //
+        // Plan:
+        //: 1 For each size from 0 to somewhat more than 'maxPooledBlockSize',
+        //:   allocate a block, verify its alignment, write it, deallocate it,
+        //:   and verify that a request of the same size class returns the same
+        //:   block, and that a larger request is served by the underlying
+        //:   allocator.  (C-1..4)
+        //:
+        //: 2 Allocate a number of blocks, destroy the allocator, and verify
+        //:   that no memory remains in use.  (C-5)
+        //:
+        //: 3 Verify that the default allocator was not used.  (C-6)
+        //
+        // Testing:
+        //   virtual ~ThreadArenaAllocator();
+        //   virtual void *allocate(size_type size);
+        //   virtual void deallocate(void *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ALLOCATE, DEALLOCATE, AND DESTRUCTOR" << endl
+                          << "====================================" << endl;
+
+        if (verbose) cout << "\nPooled and unpooled blocks." << endl;
+        {
+            bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+            Obj mX(5, &sa);  const Obj& X = mX;
+
+            const int MAX = static_cast<int>(X.maxPooledBlockSize());
+            ASSERT(128 == MAX);
+
+            ASSERT(0 == mX.allocate(0));
+            ASSERT(0 == sa.numBlocksTotal());
+
+            mX.deallocate(0);
+
+            for (int size = 1; size <= MAX + 64; ++size) {
+                const bsls::Types::Int64 NUM_IN_USE = sa.numBlocksInUse();
+
+                char *p = static_cast<char *>(mX.allocate(size));
+
+                ASSERTV(size, p);
+                ASSERTV(size, 0 == reinterpret_cast<UintPtr>(p) % MAX_ALIGN);
+
+                bsl::memset(p, 'x', size);
+
+                if (size <= MAX) {
+                    // The same block is reused by the smallest size of its
+                    // class.
+
+                    int classSize = 8;
+                    while (classSize < size) {
+                        classSize *= 2;
+                    }
+                    const int minSize = 8 == classSize ? 1 : classSize / 2 + 1;
+
+                    mX.deallocate(p);
+                    ASSERTV(size, p == mX.allocate(minSize));
+                    mX.deallocate(p);
+                }
+                else {
+                    ASSERTV(size, NUM_IN_USE + 1 == sa.numBlocksInUse());
+                    ASSERTV(size, static_cast<bsls::Types::size_type>(size)
+                                               <= sa.lastAllocatedNumBytes());
+
+                    mX.deallocate(p);
+                    ASSERTV(size, NUM_IN_USE == sa.numBlocksInUse());
+                }
+            }
+        }
+
+        if (verbose) cout << "\nDestructor." << endl;
+        {
+            bslma::TestAllocator sa("supplied", veryVeryVerbose);
+            {
+                Obj mX(&sa);  const Obj& X = mX;
+
+                const int MAX = static_cast<int>(X.maxPooledBlockSize());
+
+                for (int i = 0; i < 1000; ++i) {
+                    char *p = static_cast<char *>(mX.allocate(
+                                                          blockSize(i, MAX)));
+                    *p = 'x';
+                    if (i % 3) {
+                        mX.deallocate(p);
+                    }
+                }
+                ASSERT(0 < sa.numBlocksInUse());
+            }
+            ASSERT(0 == sa.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CONSTRUCTORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 An allocator is created with the specified number of pools, or
+        //:   an implementation-defined number (10) if it is not specified,
+        //:   and the largest pooled block size is 8 times 2 to the power of
+        //:   the number of pools minus 1.
+        //:
+        //: 2 No memory is allocated, from any allocator, on construction.
+        //:
+        //: 3 The underlying allocator is the specified allocator, or the
+        //:   default allocator if none is specified.
+        //:
+        //: 4 A newly created allocator has no heap.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create allocators with and without specifying the number of
+        //:   pools and the underlying allocator, and verify the values of the
+        //:   accessors and that no memory was allocated.  (C-1..2, 4)
+        //:
+        //: 2 Allocate a block, and verify which allocator supplied the memory.
+        //:   (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid numbers of pools (using the
+        //:   'BSLS_ASSERTTEST_*' macros).  (C-5)
+        //
+        // Testing:
+        //   explicit ThreadArenaAllocator(Allocator *ba = 0);
+        //   explicit ThreadArenaAllocator(int numPools, Allocator *ba = 0);
+        //   size_type maxPooledBlockSize() const;
+        //   int numPools() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONSTRUCTORS AND BASIC ACCESSORS" << endl
+                          << "================================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        if (verbose) cout << "\nDefault number of pools." << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(10   == X.numPools());
+            ASSERT(4096 == X.maxPooledBlockSize());
+            ASSERT(0    == X.numHeaps());
+            ASSERT(0    == defaultAllocator.numBlocksTotal());
+
+            mX.deallocate(mX.allocate(1));
+            ASSERT(0    <  defaultAllocator.numBlocksTotal());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            ASSERT(10   == X.numPools());
+            ASSERT(4096 == X.maxPooledBlockSize());
+            ASSERT(0    == X.numHeaps());
+            ASSERT(0    == sa.numBlocksTotal());
+
+            mX.deallocate(mX.allocate(1));
+            ASSERT(0    <  sa.numBlocksTotal());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "\nSpecified number of pools." << endl;
+
+        for (int numPools = 1; numPools <= 16; ++numPools) {
+            const bsls::Types::Int64 NUM_DEFAULT =
+                                             defaultAllocator.numBlocksTotal();
+            const bsls::Types::Int64 NUM_SUPPLIED = sa.numBlocksTotal();
+            {
+                const Obj X(numPools);
+
+                ASSERTV(numPools, numPools == X.numPools());
+                ASSERTV(numPools, X.maxPooledBlockSize(),
+                        (8u << (numPools - 1)) == X.maxPooledBlockSize());
+                ASSERTV(numPools, 0 == X.numHeaps());
+            }
+            {
+                const Obj X(numPools, &sa);
+
+                ASSERTV(numPools, numPools == X.numPools());
+                ASSERTV(numPools, X.maxPooledBlockSize(),
+                        (8u << (numPools - 1)) == X.maxPooledBlockSize());
+                ASSERTV(numPools, 0 == X.numHeaps());
+            }
+            ASSERTV(numPools,
+                    NUM_DEFAULT == defaultAllocator.numBlocksTotal());
+            ASSERTV(numPools, NUM_SUPPLIED == sa.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(Obj(1, &sa));
+            ASSERT_FAIL(Obj(0, &sa));
+            ASSERT_FAIL(Obj(-1, &sa));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks of several sizes, from this thread
+        //:   and from another one.
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            ASSERT(0 == X.numHeaps());
+
+            char *p = static_cast<char *>(mX.allocate(13));
+            bsl::strcpy(p, "hello, world");
+            ASSERT(1 == X.numHeaps());
+
+            char *q = static_cast<char *>(mX.allocate(10000));
+            bsl::memset(q, 'q', 10000);
+
+            mX.deallocate(p);
+            ASSERT(p == mX.allocate(16));
+
+            mX.deallocate(q);
+            mX.deallocate(p);
+
+            int numErrors = -1;
+            runExchangeTest(&mX, 2, 10, 16, 100, true, &numErrors);
+            ASSERT(0 == numErrors);
+            ASSERT(3 == X.numHeaps());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COMPARISON WITH 'bslma::NewDeleteAllocator'
+        //
+        // Concerns:
+        //: 1 Allocating and deallocating memory using a
+        //:   'bdlma::ThreadArenaAllocator' from several threads is faster
+        //:   than using the 'bslma::NewDeleteAllocator' it is built upon,
+        //:   both when threads deallocate the blocks they allocated and when
+        //:   they deallocate blocks allocated by another thread.
+        //
+        // Plan:
+        //: 1 For several numbers of threads (the largest of which may be
+        //:   specified on the command line, default 4), time a number (which
+        //:   may be specified on the command line, default 10000) of rounds
+        //:   in which every thread allocates 64 blocks of up to 256 bytes and
+        //:   then deallocates them, using a 'bslma::NewDeleteAllocator' and
+        //:   a 'bdlma::ThreadArenaAllocator', and report the times.
+        //:
+        //: 2 Repeat P-1 with each thread deallocating, at each round, the
+        //:   blocks allocated by the next thread.
+        //
+        // Testing:
+        //   PERFORMANCE: COMPARISON WITH 'bslma::NewDeleteAllocator'
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: COMPARISON WITH NEW/DELETE" << endl
+                          << "=======================================" << endl;
+
+        const int MAX_THREADS = argc > 2 ? atoi(argv[2]) : 4;
+        const int NUM_ROUNDS  = argc > 3 ? atoi(argv[3]) : 10000;
+
+        enum { BATCH_SIZE = 64, MAX_SIZE = 256 };
+
+        bslma::NewDeleteAllocator& nda =
+                                       bslma::NewDeleteAllocator::singleton();
+
+        cout << "threads  pattern     new/delete  thread arena" << endl;
+
+        for (int numThreads = 1; numThreads <= MAX_THREADS; numThreads *= 2) {
+            double elapsed[2];
+
+            for (int ai = 0; ai < 2; ++ai) {
+                Obj               arena(&nda);
+                bslma::Allocator *alloc = ai ? static_cast<bslma::Allocator *>(
+                                                                       &arena)
+                                             : &nda;
+
+                LocalBenchmarkContext context = { alloc,
+                                                  NUM_ROUNDS,
+                                                  BATCH_SIZE,
+                                                  MAX_SIZE };
+
+                ThreadId ids[64];
+                ASSERT(numThreads <= 64);
+
+                bsls::Stopwatch timer;
+                timer.start();
+
+                for (int i = 0; i < numThreads; ++i) {
+                    ids[i] = createThread(&localBenchmarkThread, &context);
+                }
+                for (int i = 0; i < numThreads; ++i) {
+                    joinThread(ids[i]);
+                }
+
+                timer.stop();
+                elapsed[ai] = timer.elapsedTime();
+            }
+
+            cout << numThreads << "\tlocal\t    " << elapsed[0] << "s\t"
+                 << elapsed[1] << "s" << endl;
+
+            if (numThreads < 2) {
+                continue;
+            }
+
+            for (int ai = 0; ai < 2; ++ai) {
+                Obj               arena(&nda);
+                bslma::Allocator *alloc = ai ? static_cast<bslma::Allocator *>(
+                                                                       &arena)
+                                             : &nda;
+
+                bsls::Stopwatch timer;
+                timer.start();
+
+                int numErrors = -1;
+                runExchangeTest(alloc,
+                                numThreads,
+                                NUM_ROUNDS,
+                                BATCH_SIZE,
+                                MAX_SIZE,
+                                false,
+                                &numErrors);
+
+                timer.stop();
+                elapsed[ai] = timer.elapsedTime();
+
+                ASSERT(0 == numErrors);
+            }
+
+            cout << numThreads << "\tremote\t    " << elapsed[0] << "s\t"
+                 << elapsed[1] << "s" << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,171 @@
+// bdlsb_chunkedoutstreambuf.cpp                                      -*-C++-*-
+#include <bdlsb_chunkedoutstreambuf.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlsb_chunkedoutstreambuf_cpp,"$Id$ $CSID$")
+
+#include <bsls_alignment.h>
+#include <bsls_blockgrowth.h>
+#include <bsls_types.h>
+
+#include <bsl_cstring.h>
+
+namespace BloombergLP {
+namespace bdlsb {
+
+                         // -------------------------
+                         // class ChunkedOutStreamBuf
+                         // -------------------------
+
+// PRIVATE MANIPULATORS
+void ChunkedOutStreamBuf::grow(const char_type *source, bsl::size_t numChars)
+{
+    const bsl::size_t available = epptr() - pptr();
+
+    BSLS_ASSERT(available < numChars);
+
+    // Reserve space for the new segment and obtain the new chunk before
+    // modifying the put area, so that this object is unchanged if either step
+    // throws.  (A chunk obtained from the arena but not used is reclaimed by
+    // 'reset' or the destructor.)
+
+    d_segments.reserve(d_segments.size() + 1);
+
+    bsls::Types::size_type size = numChars - available;
+    char *chunk = static_cast<char *>(d_arena.allocateAndExpand(&size));
+
+    if (available) {
+        bsl::memcpy(pptr(), source, available);
+        pbump(static_cast<int>(available));
+    }
+
+    if (pbase() != pptr()) {
+        d_segments.push_back(bslstl::StringRef(pbase(), pptr()));
+        d_length += pptr() - pbase();
+    }
+
+    setp(chunk, chunk + size);
+
+    bsl::memcpy(chunk, source + available, numChars - available);
+    pbump(static_cast<int>(numChars - available));
+}
+
+// PROTECTED MANIPULATORS
+ChunkedOutStreamBuf::int_type
+ChunkedOutStreamBuf::overflow(int_type character)
+{
+    if (traits_type::eq_int_type(traits_type::eof(), character)) {
+        return traits_type::not_eof(character);                       // RETURN
+    }
+
+    const char_type value = traits_type::to_char_type(character);
+
+    if (pptr() == epptr()) {
+        grow(&value, 1);
+    }
+    else {
+        *pptr() = value;
+        pbump(1);
+    }
+
+    return character;
+}
+
+ChunkedOutStreamBuf::pos_type
+ChunkedOutStreamBuf::seekoff(off_type                offset,
+                             bsl::ios_base::seekdir  whence,
+                             bsl::ios_base::openmode modeBitMask)
+{
+    if (0 != offset
+     || bsl::ios_base::cur != whence
+     || !(modeBitMask & bsl::ios_base::out)) {
+        return pos_type(-1);                                          // RETURN
+    }
+
+    return pos_type(static_cast<off_type>(length()));
+}
+
+bsl::streamsize ChunkedOutStreamBuf::xsputn(const char_type *source,
+                                            bsl::streamsize  numChars)
+{
+    BSLS_ASSERT(0 <= numChars);
+    BSLS_ASSERT(source || 0 == numChars);
+
+    if (epptr() - pptr() < numChars) {
+        grow(source, static_cast<bsl::size_t>(numChars));
+    }
+    else if (0 < numChars) {
+        bsl::memcpy(pptr(), source, static_cast<bsl::size_t>(numChars));
+        pbump(static_cast<int>(numChars));
+    }
+
+    return numChars;
+}
+
+// CREATORS
+ChunkedOutStreamBuf::ChunkedOutStreamBuf(bslma::Allocator *basicAllocator)
+: d_arena(bsls::BlockGrowth::BSLS_GEOMETRIC,
+          bsls::Alignment::BSLS_BYTEALIGNED,
+          basicAllocator)
+, d_segments(basicAllocator)
+, d_length(0)
+{
+}
+
+ChunkedOutStreamBuf::ChunkedOutStreamBuf(int               initialChunkSize,
+                                         int               maxChunkSize,
+                                         bslma::Allocator *basicAllocator)
+: d_arena(initialChunkSize,
+          maxChunkSize,
+          bsls::Alignment::BSLS_BYTEALIGNED,
+          basicAllocator)
+, d_segments(basicAllocator)
+, d_length(0)
+{
+}
+
+ChunkedOutStreamBuf::~ChunkedOutStreamBuf()
+{
+}
+
+// MANIPULATORS
+void ChunkedOutStreamBuf::reset()
+{
+    setp(0, 0);
+    bsl::vector<bslstl::StringRef>(allocator()).swap(d_segments);
+    d_length = 0;
+    d_arena.release();
+}
+
+// ACCESSORS
+bsl::string ChunkedOutStreamBuf::str() const
+{
+    bsl::string result;
+    result.reserve(length());
+
+    for (bsl::size_t i = 0; i < d_segments.size(); ++i) {
+        result.append(d_segments[i].data(), d_segments[i].length());
+    }
+    result.append(pbase(), pptr());
+
+    return result;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
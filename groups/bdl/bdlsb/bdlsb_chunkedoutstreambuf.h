@@ -0,0 +1,383 @@
+// bdlsb_chunkedoutstreambuf.h                                        -*-C++-*-
+#ifndef INCLUDED_BDLSB_CHUNKEDOUTSTREAMBUF
+#define INCLUDED_BDLSB_CHUNKEDOUTSTREAMBUF
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an output 'streambuf' writing to a chain of memory chunks.
+//
+//@CLASSES:
+//  bdlsb::ChunkedOutStreamBuf: output 'streambuf' over arena-backed chunks
+//
+//@SEE_ALSO: bdlma_sequentialallocator, bslstl_stringbuf
+//
+//@DESCRIPTION: This component provides a mechanism,
+// 'bdlsb::ChunkedOutStreamBuf', that implements the output portion of the
+// 'bsl::basic_streambuf' protocol by appending characters to a chain of
+// memory chunks obtained from a 'bdlma::SequentialAllocator'.  Unlike
+// 'bsl::stringbuf', whose output is kept in a single contiguous string that
+// is reallocated (and its contents copied) every time it grows, a
+// 'bdlsb::ChunkedOutStreamBuf' never moves characters once they are written:
+// when the current chunk is full, a new (geometrically larger) chunk is
+// obtained and writing continues there.
+//
+// The characters written are exposed as a sequence of contiguous *segments*,
+// accessible via 'numSegments' and 'segment' without copying or allocating,
+// which is well suited to scatter-gather output (e.g., 'writev' on POSIX
+// platforms).  A single contiguous copy of the output is produced only on
+// demand, by 'str'.
+//
+// All chunk memory is released at once by 'reset', or when the stream buffer
+// is destroyed; the allocator supplied at construction is used to supply the
+// memory for the internal buffers of the 'bdlma::SequentialAllocator' and the
+// list of segments.
+//
+///Chunk Sizes
+///-----------
+// The first chunk has an implementation-defined size, and is allocated when
+// the first character is written, unless an 'initialChunkSize' is supplied at
+// construction, in which case the first chunk has (at least) that size and is
+// allocated by the constructor.  Each subsequent chunk is (at least) twice as
+// large as the previous one, up to the optional 'maxChunkSize'.  A single
+// write of a sequence of characters larger than the available space is split
+// between the current chunk and a new chunk large enough to hold the
+// remainder, regardless of 'maxChunkSize'.
+//
+///Seeking
+///-------
+// Only the current output position can be queried (e.g., via
+// 'bsl::ostream::tellp'), returning 'length()'; all other seek requests fail.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Building a Large Report
+/// - - - - - - - - - - - - - - - - -
+// Suppose we must format a large report whose final size is not known in
+// advance.  Formatting it into a 'bsl::ostringstream' would repeatedly
+// reallocate and copy the partially formatted report; instead, we format it
+// into a 'bdlsb::ChunkedOutStreamBuf'.
+//
+// First, we create the stream buffer and an output stream that writes to it:
+//..
+//  bslma::Allocator *allocator = bslma::Default::defaultAllocator();
+//
+//  bdlsb::ChunkedOutStreamBuf buffer(allocator);
+//  bsl::ostream               stream(&buffer);
+//..
+// Then, we format the report:
+//..
+//  for (int i = 0; i < 1000; ++i) {
+//      stream << "line " << i << ": " << i * i << '\n';
+//  }
+//  stream.flush();
+//..
+// Next, we observe that the report has been written into several segments:
+//..
+//  assert(1 < buffer.numSegments());
+//  assert(buffer.length() == static_cast<bsl::size_t>(stream.tellp()));
+//..
+// Now, we verify that the segments, taken in order, hold the report:
+//..
+//  bsl::size_t total = 0;
+//  for (int i = 0; i < buffer.numSegments(); ++i) {
+//      total += buffer.segment(i).length();
+//  }
+//  assert(buffer.length() == total);
+//..
+// Finally, if a single contiguous copy of the report is required, we obtain
+// one with 'str':
+//..
+//  const bsl::string report = buffer.str();
+//  assert(buffer.length() == report.length());
+//  assert(0 == report.compare(0, 9, "line 0: 0"));
+//..
+//
+///Example 2: Scatter-Gather Output
+/// - - - - - - - - - - - - - - - -
+// Suppose we want to send the output of a 'bdlsb::ChunkedOutStreamBuf' to a
+// file descriptor without first copying it into a contiguous buffer.  On POSIX
+// platforms, 'writev' accepts an array of 'struct iovec' (from
+// '<sys/uio.h>'), each describing one contiguous range of memory.  We can
+// fill such an array directly from the segments of the stream buffer.
+//
+// For the purposes of this example, we define a structure having the same
+// members as 'struct iovec':
+//..
+//  struct IoVec {
+//      void        *iov_base;  // address of the segment
+//      bsl::size_t  iov_len;   // length of the segment
+//  };
+//..
+// Then, we write some output to a stream buffer:
+//..
+//  bdlsb::ChunkedOutStreamBuf buffer(16, 64);
+//  bsl::ostream               stream(&buffer);
+//
+//  for (int i = 0; i < 100; ++i) {
+//      stream << i << ',';
+//  }
+//  stream.flush();
+//..
+// Next, we describe each segment with an 'IoVec':
+//..
+//  bsl::vector<IoVec> iov(buffer.numSegments());
+//  for (int i = 0; i < buffer.numSegments(); ++i) {
+//      const bslstl::StringRef segment = buffer.segment(i);
+//
+//      iov[i].iov_base = const_cast<char *>(segment.data());
+//      iov[i].iov_len  = segment.length();
+//  }
+//..
+// Finally, on a POSIX platform, we would pass 'iov' to 'writev' (e.g.,
+// '::writev(fd, (struct iovec *)&iov[0], iov.size())'); here, we simply
+// verify that gathering the vectors reproduces the output:
+//..
+//  bsl::string gathered;
+//  for (bsl::size_t i = 0; i < iov.size(); ++i) {
+//      gathered.append(static_cast<const char *>(iov[i].iov_base),
+//                      iov[i].iov_len);
+//  }
+//  assert(buffer.str() == gathered);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_SEQUENTIALALLOCATOR
+#include <bdlma_sequentialallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STRINGREF
+#include <bslstl_stringref.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOS
+#include <bsl_ios.h>
+#endif
+
+#ifndef INCLUDED_BSL_STREAMBUF
+#include <bsl_streambuf.h>
+#endif
+
+#ifndef INCLUDED_BSL_STRING
+#include <bsl_string.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlsb {
+
+                         // =========================
+                         // class ChunkedOutStreamBuf
+                         // =========================
+
+class ChunkedOutStreamBuf : public bsl::streambuf {
+    // This class implements the output functionality of the
+    // 'bsl::basic_streambuf' protocol, writing characters to a chain of
+    // memory chunks that are never moved once written, and exposing the
+    // characters written as a sequence of contiguous segments.
+
+  public:
+    // TYPES
+    typedef bsl::streambuf::char_type   char_type;
+    typedef bsl::streambuf::int_type    int_type;
+    typedef bsl::streambuf::pos_type    pos_type;
+    typedef bsl::streambuf::off_type    off_type;
+    typedef bsl::streambuf::traits_type traits_type;
+
+  private:
+    // DATA
+    bdlma::SequentialAllocator     d_arena;     // supplies the chunks
+
+    bsl::vector<bslstl::StringRef> d_segments;  // completed segments, in
+                                                // order, excluding the
+                                                // current put area
+
+    bsl::size_t                    d_length;    // total length of
+                                                // 'd_segments'
+
+  private:
+    // NOT IMPLEMENTED
+    ChunkedOutStreamBuf(const ChunkedOutStreamBuf&);
+    ChunkedOutStreamBuf& operator=(const ChunkedOutStreamBuf&);
+
+    // PRIVATE MANIPULATORS
+    void grow(const char_type *source, bsl::size_t numChars);
+        // Append the specified 'numChars' characters from the specified
+        // 'source' to this stream buffer by filling the current put area,
+        // appending it to the list of completed segments, and copying the
+        // remaining characters to a newly obtained chunk that becomes the put
+        // area.  If an exception is thrown, this object is unchanged.  The
+        // behavior is undefined unless 'epptr() - pptr() < numChars'.
+
+  protected:
+    // PROTECTED MANIPULATORS
+    virtual int_type overflow(int_type character = traits_type::eof());
+        // Append the specified 'character' to this stream buffer, obtaining a
+        // new chunk if the current one is full.  Return 'character', or
+        // 'traits_type::not_eof(character)' with no other effect if
+        // 'character' is 'traits_type::eof()'.
+
+    virtual pos_type seekoff(
+                       off_type                offset,
+                       bsl::ios_base::seekdir  whence,
+                       bsl::ios_base::openmode modeBitMask = bsl::ios_base::in
+                                                         | bsl::ios_base::out);
+        // Return the current output position (i.e., 'length()') if the
+        // specified 'offset' is 0, the specified 'whence' is
+        // 'bsl::ios_base::cur', and the optionally specified 'modeBitMask'
+        // includes 'bsl::ios_base::out'; otherwise return 'pos_type(-1)'.
+        // This method has no effect.
+
+    virtual bsl::streamsize xsputn(const char_type *source,
+                                   bsl::streamsize  numChars);
+        // Append the specified 'numChars' characters from the specified
+        // 'source' to this stream buffer, obtaining a new chunk if the
+        // current one is too small, and return 'numChars'.  The behavior is
+        // undefined unless '0 <= numChars'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(ChunkedOutStreamBuf,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    ChunkedOutStreamBuf(bslma::Allocator *basicAllocator = 0);
+        // Create an empty stream buffer.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    ChunkedOutStreamBuf(int               initialChunkSize,
+                        int               maxChunkSize,
+                        bslma::Allocator *basicAllocator = 0);
+        // Create an empty stream buffer whose chunks grow geometrically from
+        // (at least) the specified 'initialChunkSize' (in bytes) to at most
+        // the specified 'maxChunkSize', except as needed to hold a single
+        // write, and allocate its first chunk.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '0 < initialChunkSize' and
+        // 'initialChunkSize <= maxChunkSize'.
+
+    virtual ~ChunkedOutStreamBuf();
+        // Destroy this stream buffer, releasing all of its chunks.
+
+    // MANIPULATORS
+    void reset();
+        // Discard all characters written to this stream buffer and release
+        // all memory allocated by it.
+
+    // ACCESSORS
+    bsl::size_t length() const;
+        // Return the number of characters written to this stream buffer.
+
+    int numSegments() const;
+        // Return the number of contiguous segments that, taken in order, hold
+        // the characters written to this stream buffer.  Note that no segment
+        // is empty, so this method returns 0 if and only if 'length()' is 0.
+
+    bslstl::StringRef segment(int index) const;
+        // Return a reference to the segment at the specified 'index'.  The
+        // returned reference remains valid until this stream buffer is
+        // 'reset' or destroyed, but the segment at 'numSegments() - 1' may be
+        // extended by subsequent output (which is not reflected in the
+        // returned reference).  The behavior is undefined unless
+        // '0 <= index < numSegments()'.
+
+    bsl::string str() const;
+        // Return a string, using the currently installed default allocator
+        // to supply memory, holding a copy of the characters written to this
+        // stream buffer.
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this stream buffer to supply memory.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                         // -------------------------
+                         // class ChunkedOutStreamBuf
+                         // -------------------------
+
+// ACCESSORS
+inline
+bsl::size_t ChunkedOutStreamBuf::length() const
+{
+    return d_length + (pptr() - pbase());
+}
+
+inline
+int ChunkedOutStreamBuf::numSegments() const
+{
+    return static_cast<int>(d_segments.size()) + (pptr() != pbase());
+}
+
+inline
+bslstl::StringRef ChunkedOutStreamBuf::segment(int index) const
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < numSegments());
+
+    return static_cast<bsl::size_t>(index) < d_segments.size()
+           ? d_segments[index]
+           : bslstl::StringRef(pbase(), pptr());
+}
+
+inline
+bslma::Allocator *ChunkedOutStreamBuf::allocator() const
+{
+    return d_segments.get_allocator().mechanism();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
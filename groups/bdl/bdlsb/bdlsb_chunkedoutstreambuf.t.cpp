@@ -0,0 +1,786 @@
+// bdlsb_chunkedoutstreambuf.t.cpp                                    -*-C++-*-
+#include <bdlsb_chunkedoutstreambuf.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_ostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is an output stream buffer that writes to a chain
+// of chunks obtained from a 'bdlma::SequentialAllocator'.  The primary
+// concerns are that every character written, whether through 'sputc'
+// ('overflow') or 'sputn' ('xsputn'), appears exactly once and in order in
+// the sequence of segments, that characters are never moved once written,
+// that no segment is empty, and that all memory comes from the allocator
+// supplied at construction.  We verify the output against a 'bsl::string'
+// built in parallel.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] ChunkedOutStreamBuf(bslma::Allocator *basicAllocator = 0);
+// [ 2] ChunkedOutStreamBuf(int initial, int max, Allocator *ba = 0);
+// [ 2] ~ChunkedOutStreamBuf();
+//
+// MANIPULATORS
+// [ 2] int_type overflow(int_type character);
+// [ 3] streamsize xsputn(const char_type *source, streamsize numChars);
+// [ 4] pos_type seekoff(off_type, seekdir, openmode);
+// [ 5] void reset();
+//
+// ACCESSORS
+// [ 2] bsl::size_t length() const;
+// [ 2] int numSegments() const;
+// [ 2] bslstl::StringRef segment(int index) const;
+// [ 3] bsl::string str() const;
+// [ 2] bslma::Allocator *allocator() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: 'ChunkedOutStreamBuf' VS. 'bsl::ostringstream'
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlsb::ChunkedOutStreamBuf Obj;
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static bool checkSegments(const Obj& object, const bsl::string& expected)
+    // Return 'true' if the segments of the specified 'object', taken in
+    // order, hold the specified 'expected' characters, and none of them is
+    // empty; return 'false' otherwise.
+{
+    if (object.length() != expected.length()) {
+        return false;                                                 // RETURN
+    }
+
+    bsl::size_t offset = 0;
+    for (int i = 0; i < object.numSegments(); ++i) {
+        const bslstl::StringRef segment = object.segment(i);
+
+        if (0 == segment.length()
+         || 0 != expected.compare(offset,
+                                  segment.length(),
+                                  segment.data(),
+                                  segment.length())) {
+            return false;                                             // RETURN
+        }
+        offset += segment.length();
+    }
+
+    return offset == expected.length();
+}
+
+//=============================================================================
+//                               USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Example 2: Scatter-Gather Output
+/// - - - - - - - - - - - - - - - -
+// Suppose we want to send the output of a 'bdlsb::ChunkedOutStreamBuf' to a
+// file descriptor without first copying it into a contiguous buffer.  On POSIX
+// platforms, 'writev' accepts an array of 'struct iovec' (from
+// '<sys/uio.h>'), each describing one contiguous range of memory.  We can
+// fill such an array directly from the segments of the stream buffer.
+//
+// For the purposes of this example, we define a structure having the same
+// members as 'struct iovec':
+//..
+    struct IoVec {
+        void        *iov_base;  // address of the segment
+        bsl::size_t  iov_len;   // length of the segment
+    };
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage examples provided in the component header file
+        //:   compile, link, and run as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage examples from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Building a Large Report
+/// - - - - - - - - - - - - - - - - -
+// Suppose we must format a large report whose final size is not known in
+// advance.  Formatting it into a 'bsl::ostringstream' would repeatedly
+// reallocate and copy the partially formatted report; instead, we format it
+// into a 'bdlsb::ChunkedOutStreamBuf'.
+//
+// First, we create the stream buffer and an output stream that writes to it:
+//..
+    {
+    bslma::Allocator *allocator = bslma::Default::defaultAllocator();
+
+    bdlsb::ChunkedOutStreamBuf buffer(allocator);
+    bsl::ostream               stream(&buffer);
+//..
+// Then, we format the report:
+//..
+    for (int i = 0; i < 1000; ++i) {
+        stream << "line " << i << ": " << i * i << '\n';
+    }
+    stream.flush();
+//..
+// Next, we observe that the report has been written into several segments:
+//..
+    ASSERT(1 < buffer.numSegments());
+    ASSERT(buffer.length() == static_cast<bsl::size_t>(stream.tellp()));
+//..
+// Now, we verify that the segments, taken in order, hold the report:
+//..
+    bsl::size_t total = 0;
+    for (int i = 0; i < buffer.numSegments(); ++i) {
+        total += buffer.segment(i).length();
+    }
+    ASSERT(buffer.length() == total);
+//..
+// Finally, if a single contiguous copy of the report is required, we obtain
+// one with 'str':
+//..
+    const bsl::string report = buffer.str();
+    ASSERT(buffer.length() == report.length());
+    ASSERT(0 == report.compare(0, 9, "line 0: 0"));
+    }
+//..
+//
+// Then, we write some output to a stream buffer:
+//..
+    {
+    bdlsb::ChunkedOutStreamBuf buffer(16, 64);
+    bsl::ostream               stream(&buffer);
+
+    for (int i = 0; i < 100; ++i) {
+        stream << i << ',';
+    }
+    stream.flush();
+//..
+// Next, we describe each segment with an 'IoVec':
+//..
+    bsl::vector<IoVec> iov(buffer.numSegments());
+    for (int i = 0; i < buffer.numSegments(); ++i) {
+        const bslstl::StringRef segment = buffer.segment(i);
+
+        iov[i].iov_base = const_cast<char *>(segment.data());
+        iov[i].iov_len  = segment.length();
+    }
+//..
+// Finally, on a POSIX platform, we would pass 'iov' to 'writev' (e.g.,
+// '::writev(fd, (struct iovec *)&iov[0], iov.size())'); here, we simply
+// verify that gathering the vectors reproduces the output:
+//..
+    bsl::string gathered;
+    for (bsl::size_t i = 0; i < iov.size(); ++i) {
+        gathered.append(static_cast<const char *>(iov[i].iov_base),
+                        iov[i].iov_len);
+    }
+    ASSERT(buffer.str() == gathered);
+    }
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // RESET
+        //
+        // Concerns:
+        //: 1 'reset' discards all output, after which the object is
+        //:   equivalent to a newly constructed one.
+        //:
+        //: 2 'reset' returns all chunk memory to the allocator.
+        //:
+        //: 3 The object can be written to again after 'reset'.
+        //
+        // Plan:
+        //: 1 Write output spanning several chunks, 'reset' the object, and
+        //:   verify its accessors and the allocator's blocks in use.  Write
+        //:   to it again, and verify the output.  (C-1..3)
+        //
+        // Testing:
+        //   void reset();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RESET" << endl
+                          << "=====" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+        {
+            Obj mX(8, 32, &oa);  const Obj& X = mX;
+
+            const bsl::string PAYLOAD(100, 'x');
+            mX.sputn(PAYLOAD.data(), PAYLOAD.length());
+            mX.sputn(PAYLOAD.data(), PAYLOAD.length());
+            ASSERT(200 == X.length());
+            ASSERT(2   <= X.numSegments());
+
+            mX.reset();
+            ASSERT(0 == X.length());
+            ASSERT(0 == X.numSegments());
+            ASSERT(X.str().empty());
+
+            bsl::string expected;
+            for (int i = 0; i < 50; ++i) {
+                mX.sputc(static_cast<char>('a' + i % 26));
+                expected += static_cast<char>('a' + i % 26);
+            }
+            ASSERT(checkSegments(X, expected));
+            ASSERT(expected == X.str());
+
+            mX.reset();
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // STREAM INTEGRATION AND 'seekoff'
+        //
+        // Concerns:
+        //: 1 A 'bsl::ostream' can format values into the object, and the
+        //:   output matches that of a 'bsl::ostringstream'.
+        //:
+        //: 2 'tellp' (i.e., 'seekoff(0, cur, out)') returns 'length()'.
+        //:
+        //: 3 All other seek requests fail, and have no effect.
+        //
+        // Plan:
+        //: 1 Format the same sequence of values into a stream over the object
+        //:   and into a 'bsl::ostringstream', checking 'tellp' after each, and
+        //:   compare the results.  (C-1..2)
+        //:
+        //: 2 Invoke 'pubseekoff' and 'pubseekpos' with various arguments, and
+        //:   verify that each returns 'pos_type(-1)' and that the output is
+        //:   unchanged.  (C-3)
+        //
+        // Testing:
+        //   pos_type seekoff(off_type, seekdir, openmode);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "STREAM INTEGRATION AND 'seekoff'" << endl
+                          << "================================" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+        {
+            Obj                mX(4, 64, &oa);  const Obj& X = mX;
+            bsl::ostream       stream(&mX);
+            bsl::ostringstream expected(&oa);
+
+            for (int i = 0; i < 500; ++i) {
+                stream   << i << ' ' << i * 0.25 << ' ' << "abc" << '\n';
+                expected << i << ' ' << i * 0.25 << ' ' << "abc" << '\n';
+
+                ASSERTV(i, expected.tellp() == stream.tellp());
+            }
+            ASSERT(stream.good());
+            ASSERT(expected.str() == X.str());
+            ASSERT(checkSegments(X, expected.str()));
+
+            typedef bsl::ios_base IOS;
+
+            const Obj::pos_type FAIL(-1);
+            const bsl::size_t   LENGTH = X.length();
+
+            ASSERT(LENGTH == static_cast<bsl::size_t>(
+                                 mX.pubseekoff(0, IOS::cur, IOS::out)));
+            ASSERT(FAIL   == mX.pubseekoff(0,  IOS::cur, IOS::in));
+            ASSERT(FAIL   == mX.pubseekoff(1,  IOS::cur, IOS::out));
+            ASSERT(FAIL   == mX.pubseekoff(-1, IOS::cur, IOS::out));
+            ASSERT(FAIL   == mX.pubseekoff(0,  IOS::beg, IOS::out));
+            ASSERT(FAIL   == mX.pubseekoff(0,  IOS::end, IOS::out));
+            ASSERT(FAIL   == mX.pubseekpos(0, IOS::out));
+            ASSERT(LENGTH == X.length());
+            ASSERT(expected.str() == X.str());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'xsputn' AND 'str'
+        //
+        // Concerns:
+        //: 1 'sputn' appends the characters supplied, and returns their
+        //:   number.
+        //:
+        //: 2 A write larger than the space remaining in the current chunk is
+        //:   split between that chunk and a new one, even if the write is
+        //:   larger than the maximum chunk size.
+        //:
+        //: 3 Characters are never moved once written.
+        //:
+        //: 4 A write of zero characters has no effect.
+        //:
+        //: 5 'str' returns a copy of all of the output.
+        //:
+        //: 6 The object is exception-neutral, and unchanged if allocation
+        //:   fails.
+        //
+        // Plan:
+        //: 1 For a table of chunk sizes and write lengths, write a sequence of
+        //:   strings, in parallel appending them to a 'bsl::string', and
+        //:   verify the segments and 'str' after each write.  Record the
+        //:   address of the first segment, and verify it is unchanged.
+        //:   (C-1..5)
+        //:
+        //: 2 Perform the writes in the presence of injected exceptions, and
+        //:   verify the output after each exception.  (C-6)
+        //
+        // Testing:
+        //   streamsize xsputn(const char_type *source, streamsize numChars);
+        //   bsl::string str() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'xsputn' AND 'str'" << endl
+                          << "==================" << endl;
+
+        static const struct {
+            int d_line;     // source line number
+            int d_initial;  // initial chunk size
+            int d_max;      // maximum chunk size
+            int d_write;    // length of each write
+        } DATA[] = {
+            //LINE  INITIAL  MAX   WRITE
+            //----  -------  ----  -----
+            { L_,         1,    1,     1 },
+            { L_,         1,    1,     7 },
+            { L_,         1,    8,     3 },
+            { L_,         4,   16,     0 },
+            { L_,         4,   16,     5 },
+            { L_,         4,   16,    17 },
+            { L_,        16,   16,   100 },
+            { L_,        16, 1024,    13 },
+            { L_,       256, 4096,  1000 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE    = DATA[ti].d_line;
+            const int INITIAL = DATA[ti].d_initial;
+            const int MAX     = DATA[ti].d_max;
+            const int WRITE   = DATA[ti].d_write;
+
+            if (veryVerbose) { P_(LINE) P_(INITIAL) P_(MAX) P(WRITE) }
+
+            bslma::TestAllocator oa("object", veryVeryVerbose);
+            {
+                Obj mX(INITIAL, MAX, &oa);  const Obj& X = mX;
+
+                bsl::string expected;
+                const char *first = 0;
+
+                for (int i = 0; i < 20; ++i) {
+                    const bsl::string PIECE(WRITE, static_cast<char>('A' + i));
+
+                    BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(oa) {
+                        ASSERTV(LINE, i, checkSegments(X, expected));
+
+                        ASSERTV(LINE, i, WRITE == mX.sputn(PIECE.data(),
+                                                           PIECE.length()));
+                    } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+                    expected += PIECE;
+
+                    ASSERTV(LINE, i, checkSegments(X, expected));
+                    ASSERTV(LINE, i, expected == X.str());
+
+                    if (0 == first && 0 < X.numSegments()) {
+                        first = X.segment(0).data();
+                    }
+                    ASSERTV(LINE, i, 0 == first
+                                  || first == X.segment(0).data());
+                }
+                if (WRITE > MAX) {
+                    ASSERTV(LINE, 20 >= X.numSegments());
+                }
+            }
+            ASSERTV(LINE, 0 == oa.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS, 'overflow', AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 A newly created object is empty, and has no segments.
+        //:
+        //: 2 The allocator supplied at construction (or the default allocator
+        //:   if none is supplied) is used to supply memory, and no memory is
+        //:   allocated until a character is written unless an initial chunk
+        //:   size is supplied.
+        //:
+        //: 3 'sputc' appends the supplied character, obtaining a new chunk
+        //:   when the current one is full, and returns the character.
+        //:
+        //: 4 'overflow(eof)' has no effect and does not return 'eof'.
+        //:
+        //: 5 Chunks grow geometrically up to the maximum chunk size.
+        //:
+        //: 6 All memory is released when the object is destroyed.
+        //:
+        //: 7 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create objects with and without an allocator, and verify the
+        //:   accessors and the allocators' blocks in use.  (C-1..2)
+        //:
+        //: 2 Write characters one at a time with 'sputc', verifying the
+        //:   return value, 'length', and segments after each, and the sizes
+        //:   of the segments at the end.  (C-3, 5)
+        //:
+        //: 3 Invoke 'pubsync', and 'sputc' with a character whose value is
+        //:   the same as 'eof' when sign-extended.  (C-4)
+        //:
+        //: 4 Destroy the object and verify the allocator.  (C-6)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid segment indices (using the
+        //:   'BSLS_ASSERTTEST_*' macros).  (C-7)
+        //
+        // Testing:
+        //   ChunkedOutStreamBuf(bslma::Allocator *basicAllocator = 0);
+        //   ChunkedOutStreamBuf(int initial, int max, Allocator *ba = 0);
+        //   ~ChunkedOutStreamBuf();
+        //   int_type overflow(int_type character);
+        //   bsl::size_t length() const;
+        //   int numSegments() const;
+        //   bslstl::StringRef segment(int index) const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS, 'overflow', AND ACCESSORS" << endl
+                          << "===================================" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        if (verbose) cout << "\tDefault construction." << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(0 == X.length());
+            ASSERT(0 == X.numSegments());
+            ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+            mX.sputc('a');
+            ASSERT(1 == X.length());
+            ASSERT(0 <  defaultAllocator.numBlocksInUse());
+
+            Obj mY(&oa);  const Obj& Y = mY;
+            ASSERT(&oa == Y.allocator());
+            ASSERT(0   == Y.numSegments());
+            ASSERT(0   == oa.numBlocksTotal());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\tWriting with 'sputc'." << endl;
+        {
+            const int INITIAL = 4;
+            const int MAX     = 64;
+
+            Obj mX(INITIAL, MAX, &oa);  const Obj& X = mX;
+            ASSERT(&oa == X.allocator());
+            ASSERT(0   == X.numSegments());
+            ASSERT(1   == oa.numBlocksTotal());
+
+            mX.sputc('x');
+            mX.reset();
+            ASSERT(0   == oa.numBlocksInUse());
+
+            bsl::string expected;
+            for (int i = 0; i < 1000; ++i) {
+                const char C = static_cast<char>('0' + i % 10);
+
+                ASSERTV(i, C == mX.sputc(C));
+                expected += C;
+
+                ASSERTV(i, static_cast<bsl::size_t>(i + 1) == X.length());
+                ASSERTV(i, C == X.segment(X.numSegments() - 1).data()[
+                                   X.segment(X.numSegments() - 1).length()
+                                                                       - 1]);
+            }
+            ASSERT(checkSegments(X, expected));
+
+            // Every segment but the last fills its chunk, so the sizes of
+            // the segments show the growth of the chunks.
+
+            ASSERT(INITIAL <= X.segment(0).length());
+            for (int i = 1; i < X.numSegments() - 1; ++i) {
+                const int PREV = static_cast<int>(X.segment(i - 1).length());
+                const int CURR = static_cast<int>(X.segment(i).length());
+
+                ASSERTV(i, PREV, CURR, CURR >= PREV);
+                ASSERTV(i, PREV, CURR, CURR <= 2 * MAX);
+            }
+            ASSERT(X.numSegments() < 1000 / MAX + 8);
+
+            if (verbose) cout << "\tWriting 'eof'." << endl;
+
+            const bsl::size_t LENGTH = X.length();
+            ASSERT(0 == mX.pubsync());
+            ASSERT(LENGTH == X.length());
+
+            ASSERT(static_cast<char>(-1) ==
+                               Obj::traits_type::to_char_type(mX.sputc(-1)));
+            ASSERT(LENGTH + 1 == X.length());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(&oa);  const Obj& X = mX;
+            ASSERT_SAFE_FAIL(X.segment(0));
+
+            mX.sputc('a');
+            ASSERT_SAFE_PASS(X.segment(0));
+            ASSERT_SAFE_FAIL(X.segment(1));
+            ASSERT_SAFE_FAIL(X.segment(-1));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Write to an object through a 'bsl::ostream', and verify its
+        //:   segments and contents.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+        {
+            Obj          mX(2, 8, &oa);  const Obj& X = mX;
+            bsl::ostream stream(&mX);
+
+            ASSERT(0 == X.length());
+            ASSERT(0 == X.numSegments());
+
+            stream << "Hello, " << "world!" << 12345;
+            stream.flush();
+
+            ASSERT(18 == X.length());
+            ASSERT(1  <  X.numSegments());
+            ASSERT("Hello, world!12345" == X.str());
+            ASSERT(checkSegments(X, "Hello, world!12345"));
+
+            mX.reset();
+            ASSERT(0 == X.length());
+            ASSERT(0 == oa.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'ChunkedOutStreamBuf' VS. 'bsl::ostringstream'
+        //
+        // Concerns:
+        //: 1 Formatting a large amount of output into a 'ChunkedOutStreamBuf'
+        //:   is faster than formatting it into a 'bsl::ostringstream', which
+        //:   copies its output every time it grows.
+        //
+        // Plan:
+        //: 1 Repeatedly format a number of lines (specified on the command
+        //:   line, default 100000) into each, and report the elapsed time.
+        //
+        // Testing:
+        //   PERFORMANCE: 'ChunkedOutStreamBuf' VS. 'bsl::ostringstream'
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: 'ChunkedOutStreamBuf' VS. "
+                          << "'bsl::ostringstream'" << endl
+                          << "======================================="
+                          << "====================" << endl;
+
+        const int NUM_LINES      = argc > 2 ? atoi(argv[2]) : 100000;
+        const int NUM_ITERATIONS = 10;
+
+        bslma::Allocator *alloc = &bslma::NewDeleteAllocator::singleton();
+        bslma::DefaultAllocatorGuard newDeleteGuard(alloc);
+
+        bsls::Stopwatch timer;
+        bsl::size_t     total = 0;
+
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            bsl::ostringstream stream(alloc);
+            for (int j = 0; j < NUM_LINES; ++j) {
+                stream << "line " << j << ": " << j * 0.5 << '\n';
+            }
+            total += static_cast<bsl::size_t>(stream.tellp());
+        }
+        timer.stop();
+        cout << "bsl::ostringstream:         " << timer.elapsedTime() << "s"
+             << endl;
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            bdlsb::ChunkedOutStreamBuf buffer(alloc);
+            bsl::ostream               stream(&buffer);
+            for (int j = 0; j < NUM_LINES; ++j) {
+                stream << "line " << j << ": " << j * 0.5 << '\n';
+            }
+            total += buffer.length();
+        }
+        timer.stop();
+        cout << "bdlsb::ChunkedOutStreamBuf: " << timer.elapsedTime() << "s"
+             << endl;
+
+        if (veryVerbose) {
+            P(total);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
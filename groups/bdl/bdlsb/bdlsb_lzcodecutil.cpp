@@ -0,0 +1,363 @@
+// bdlsb_lzcodecutil.cpp                                              -*-C++-*-
+#include <bdlsb_lzcodecutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlsb_lzcodecutil_cpp,"$Id$ $CSID$")
+
+#include <bslmf_assert.h>
+
+#include <bsls_assert.h>
+#include <bsls_types.h>
+
+#include <bsl_cstring.h>
+
+namespace BloombergLP {
+
+namespace {
+
+enum {
+    k_MIN_MATCH     = 4,      // length of the shortest match
+
+    k_LAST_LITERALS = 5,      // number of bytes at the end of a block that
+                              // are always literals
+
+    k_MF_LIMIT      = 12,     // a match must start at least this many bytes
+                              // before the end of a block
+
+    k_MAX_OFFSET    = 65535,  // greatest distance back to a match
+
+    k_HASH_LOG      = 12,     // log2 of 'k_HASH_TABLE_SIZE'
+
+    k_SKIP_TRIGGER  = 6,      // log2 of the number of failed probes after
+                              // which the search step increases
+
+    k_RUN_MASK      = 15      // value of a token field that is extended by
+                              // the bytes that follow
+};
+
+inline
+unsigned int load32(const char *address)
+    // Return the 4 bytes at the specified 'address', in host byte order.
+{
+    unsigned int result;
+    bsl::memcpy(&result, address, sizeof result);
+    return result;
+}
+
+inline
+bsls::Types::Uint64 load64(const char *address)
+    // Return the 8 bytes at the specified 'address', in host byte order.
+{
+    bsls::Types::Uint64 result;
+    bsl::memcpy(&result, address, sizeof result);
+    return result;
+}
+
+inline
+int hashOf(unsigned int sequence)
+    // Return the hash table index for the specified 4-byte 'sequence'.
+{
+    return static_cast<int>((sequence * 2654435761U) >> (32 - k_HASH_LOG));
+}
+
+inline
+char *putLengthExtension(char *output, bsl::size_t length)
+    // Write to the specified 'output' the extension bytes of a token field
+    // whose value is the specified 'length', and return the address one past
+    // the last byte written.  The behavior is undefined unless
+    // 'k_RUN_MASK <= length'.
+{
+    length -= k_RUN_MASK;
+    while (length >= 255) {
+        *output++ = static_cast<char>(255);
+        length   -= 255;
+    }
+    *output++ = static_cast<char>(length);
+    return output;
+}
+
+inline
+int getLengthExtension(bsl::size_t          *length,
+                       const unsigned char **input,
+                       const unsigned char  *inputEnd,
+                       bsl::size_t           limit)
+    // Add to the specified 'length' the extension bytes of a token field
+    // read from the specified '*input', which is advanced past them, and
+    // which must not reach the specified 'inputEnd'.  Return 0 on success,
+    // and a non-zero value if the input ends before the last extension byte,
+    // or if 'length' would exceed the specified 'limit'.
+{
+    unsigned int byte;
+    do {
+        if (*input == inputEnd) {
+            return -1;                                                // RETURN
+        }
+        byte     = *(*input)++;
+        *length += byte;
+        if (*length > limit) {
+            return -2;                                                // RETURN
+        }
+    } while (255 == byte);
+
+    return 0;
+}
+
+}  // close unnamed namespace
+
+namespace bdlsb {
+
+BSLMF_ASSERT(LzCodecUtil::k_HASH_TABLE_SIZE == 1 << k_HASH_LOG);
+
+                            // ------------------
+                            // struct LzCodecUtil
+                            // ------------------
+
+// CLASS METHODS
+bsl::size_t LzCodecUtil::compress(char        *output,
+                                  const char  *input,
+                                  bsl::size_t  numBytes,
+                                  int         *hashTable)
+{
+    BSLS_ASSERT(output);
+    BSLS_ASSERT(input || 0 == numBytes);
+    BSLS_ASSERT(hashTable);
+    BSLS_ASSERT(numBytes <= static_cast<bsl::size_t>(k_MAX_INPUT_SIZE));
+
+    char        *out    = output;
+    bsl::size_t  anchor = 0;  // start of the literals not yet written
+
+    if (numBytes > k_MF_LIMIT) {
+        const bsl::size_t matchLimit = numBytes - k_LAST_LITERALS;
+        const bsl::size_t startLimit = numBytes - k_MF_LIMIT;
+
+        for (int i = 0; i < k_HASH_TABLE_SIZE; ++i) {
+            hashTable[i] = -1;
+        }
+
+        bsl::size_t position = 0;
+        bool        done     = false;
+
+        while (!done) {
+            // Probe successive positions, faster and faster as probes fail,
+            // for a 4-byte sequence seen before (within the maximum offset).
+
+            bsl::size_t  match    = 0;
+            unsigned int attempts = 1 << k_SKIP_TRIGGER;
+
+            for (;;) {
+                if (position > startLimit) {
+                    done = true;
+                    break;
+                }
+
+                const unsigned int sequence  = load32(input + position);
+                const int          hash      = hashOf(sequence);
+                const int          candidate = hashTable[hash];
+
+                hashTable[hash] = static_cast<int>(position);
+
+                if (0 <= candidate
+                 && position - candidate <= k_MAX_OFFSET
+                 && load32(input + candidate) == sequence) {
+                    match = candidate;
+                    break;
+                }
+
+                position += attempts++ >> k_SKIP_TRIGGER;
+            }
+
+            if (done) {
+                break;
+            }
+
+            // Extend the match backwards over the pending literals.
+
+            while (position > anchor
+                && match    > 0
+                && input[position - 1] == input[match - 1]) {
+                --position;
+                --match;
+            }
+
+            // Write the token, the literals, and the offset.
+
+            const bsl::size_t numLiterals = position - anchor;
+            char             *token       = out++;
+
+            if (numLiterals >= k_RUN_MASK) {
+                *token = static_cast<char>(k_RUN_MASK << 4);
+                out    = putLengthExtension(out, numLiterals);
+            }
+            else {
+                *token = static_cast<char>(numLiterals << 4);
+            }
+            bsl::memcpy(out, input + anchor, numLiterals);
+            out += numLiterals;
+
+            const bsl::size_t offset = position - match;
+            *out++ = static_cast<char>(offset & 0xff);
+            *out++ = static_cast<char>(offset >> 8);
+
+            // Extend the match forwards, a word at a time while possible, up
+            // to the start of the trailing literals.
+
+            bsl::size_t end = position + k_MIN_MATCH;
+            match += k_MIN_MATCH;
+
+            while (end + 8 <= matchLimit
+                && load64(input + end) == load64(input + match)) {
+                end   += 8;
+                match += 8;
+            }
+            while (end < matchLimit && input[end] == input[match]) {
+                ++end;
+                ++match;
+            }
+
+            const bsl::size_t matchLength = end - position - k_MIN_MATCH;
+
+            if (matchLength >= k_RUN_MASK) {
+                *token = static_cast<char>(*token | k_RUN_MASK);
+                out    = putLengthExtension(out, matchLength);
+            }
+            else {
+                *token = static_cast<char>(*token | matchLength);
+            }
+
+            position = end;
+            anchor   = end;
+
+            if (position > startLimit) {
+                break;
+            }
+
+            // Record a position inside the match, which improves the ratio on
+            // repetitive data at little cost.
+
+            hashTable[hashOf(load32(input + position - 2))] =
+                                               static_cast<int>(position - 2);
+        }
+    }
+
+    // Write the final, literals-only, sequence.
+
+    const bsl::size_t numLiterals = numBytes - anchor;
+
+    if (numLiterals >= k_RUN_MASK) {
+        *out++ = static_cast<char>(k_RUN_MASK << 4);
+        out    = putLengthExtension(out, numLiterals);
+    }
+    else {
+        *out++ = static_cast<char>(numLiterals << 4);
+    }
+    if (numLiterals) {
+        bsl::memcpy(out, input + anchor, numLiterals);
+        out += numLiterals;
+    }
+
+    BSLS_ASSERT(static_cast<bsl::size_t>(out - output) <=
+                                                      compressBound(numBytes));
+
+    return out - output;
+}
+
+int LzCodecUtil::decompress(bsl::size_t *numBytesDecoded,
+                            char        *output,
+                            bsl::size_t  capacity,
+                            const char  *input,
+                            bsl::size_t  numBytes)
+{
+    BSLS_ASSERT(numBytesDecoded);
+    BSLS_ASSERT(output || 0 == capacity);
+    BSLS_ASSERT(input  || 0 == numBytes);
+
+    const unsigned char *in     = reinterpret_cast<const unsigned char *>(
+                                                                       input);
+    const unsigned char *inEnd  = in + numBytes;
+    char                *out    = output;
+    char                *outEnd = output + capacity;
+
+    for (;;) {
+        if (in == inEnd) {
+            return -1;                                                // RETURN
+        }
+
+        const unsigned int token = *in++;
+
+        // Copy the literals.
+
+        bsl::size_t length = token >> 4;
+        if (k_RUN_MASK == length
+         && 0 != getLengthExtension(&length, &in, inEnd, capacity)) {
+            return -2;                                                // RETURN
+        }
+        if (length > static_cast<bsl::size_t>(inEnd  - in)
+         || length > static_cast<bsl::size_t>(outEnd - out)) {
+            return -3;                                                // RETURN
+        }
+        if (length) {
+            bsl::memcpy(out, in, length);
+            out += length;
+            in  += length;
+        }
+
+        if (in == inEnd) {
+            break;  // The last sequence has no match.
+        }
+
+        // Copy the match, which may overlap the bytes it produces.
+
+        if (inEnd - in < 2) {
+            return -4;                                                // RETURN
+        }
+        const bsl::size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+
+        if (0 == offset || offset > static_cast<bsl::size_t>(out - output)) {
+            return -5;                                                // RETURN
+        }
+
+        length = token & k_RUN_MASK;
+        if (k_RUN_MASK == length
+         && 0 != getLengthExtension(&length, &in, inEnd, capacity)) {
+            return -2;                                                // RETURN
+        }
+        length += k_MIN_MATCH;
+        if (length > static_cast<bsl::size_t>(outEnd - out)) {
+            return -3;                                                // RETURN
+        }
+
+        const char *from = out - offset;
+        if (offset >= length) {
+            bsl::memcpy(out, from, length);
+            out += length;
+        }
+        else {
+            for (const char *end = out + length; out != end; ) {
+                *out++ = *from++;
+            }
+        }
+    }
+
+    *numBytesDecoded = out - output;
+    return 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,205 @@
+// bdlsb_lzcodecutil.h                                                -*-C++-*-
+#ifndef INCLUDED_BDLSB_LZCODECUTIL
+#define INCLUDED_BDLSB_LZCODECUTIL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a fast LZ77-family block compressor and decompressor.
+//
+//@CLASSES:
+//  bdlsb::LzCodecUtil: namespace for LZ block compression functions
+//
+//@SEE_ALSO: bdlsb_lzcompressingoutstreambuf, bdlsb_lzdecompressinginstreambuf
+//
+//@DESCRIPTION: This component provides a 'struct', 'bdlsb::LzCodecUtil', that
+// serves as a namespace for functions that compress a block of bytes, and
+// decompress the result, using a byte-oriented LZ77 scheme that favors speed
+// over compression ratio.  The compressor finds matches using a single-entry
+// hash table of the positions of 4-byte sequences (so it does no searching
+// beyond one probe per position), and the decompressor consists of little
+// more than copy loops, so both run at memory-bandwidth-like rates on typical
+// data; the ratio achieved on repetitive data (such as many records of the
+// same BDEX-encoded type) is typically between 2:1 and 5:1.
+//
+// Each block is compressed independently (i.e., no history is shared between
+// blocks), so that any block can be decompressed on its own.  The functions
+// allocate no memory: the compressor uses a caller-supplied hash table of
+// 'k_HASH_TABLE_SIZE' 'int' values as scratch, so that a caller compressing
+// many blocks can reuse one table.
+//
+///Compressed Format
+///-----------------
+// The compressed form of a block is a sequence of *sequences*, each consisting
+// of a run of literal bytes followed by a back-reference (*match*) to bytes
+// already decompressed, and is compatible with the LZ4 block format:
+//..
+//  +-------+------------------+----------+--------+--------------------+
+//  | token | literal length   | literals | offset | match length       |
+//  | 1 B   | 0-n B (optional) | L B      | 2 B LE | 0-n B (optional)   |
+//  +-------+------------------+----------+--------+--------------------+
+//..
+// The high four bits of the token hold the literal length 'L', and the low
+// four bits hold the match length minus 4; a value of 15 in either field is
+// extended by the bytes that follow, each of which is added to it, until a
+// byte other than 255.  The offset is the little-endian distance (from 1 to
+// 65535) back from the current output position to the start of the match,
+// and a match may overlap its own output.  The last sequence of a block has
+// literals only, and ends the block; the last 5 bytes of a block are always
+// literals.
+//
+// 'decompress' validates its input fully: it never reads beyond the end of
+// the input, never writes beyond the supplied capacity, and never refers
+// before the start of the output, and reports malformed input by its return
+// value.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Compressing and Decompressing a Block
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have a block of highly repetitive text:
+//..
+//  bsl::string text;
+//  for (int i = 0; i < 100; ++i) {
+//      text += "IBM 142.10 100;";
+//  }
+//..
+// First, we obtain a hash table and an output buffer of sufficient size, and
+// compress the text:
+//..
+//  int               hashTable[bdlsb::LzCodecUtil::k_HASH_TABLE_SIZE];
+//  bsl::vector<char> compressed(
+//                        bdlsb::LzCodecUtil::compressBound(text.length()));
+//
+//  const bsl::size_t compressedLength = bdlsb::LzCodecUtil::compress(
+//                                                         compressed.data(),
+//                                                         text.data(),
+//                                                         text.length(),
+//                                                         hashTable);
+//  assert(compressedLength < text.length() / 10);
+//..
+// Then, we decompress it, supplying the original length as the capacity:
+//..
+//  bsl::vector<char> decompressed(text.length());
+//  bsl::size_t       decompressedLength;
+//
+//  int rc = bdlsb::LzCodecUtil::decompress(&decompressedLength,
+//                                          decompressed.data(),
+//                                          decompressed.size(),
+//                                          compressed.data(),
+//                                          compressedLength);
+//  assert(0 == rc);
+//  assert(text.length() == decompressedLength);
+//  assert(0 == bsl::memcmp(text.data(), decompressed.data(), text.length()));
+//..
+// Finally, we observe that truncated input is detected:
+//..
+//  rc = bdlsb::LzCodecUtil::decompress(&decompressedLength,
+//                                      decompressed.data(),
+//                                      decompressed.size(),
+//                                      compressed.data(),
+//                                      compressedLength - 1);
+//  assert(0 != rc);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlsb {
+
+                            // ==================
+                            // struct LzCodecUtil
+                            // ==================
+
+struct LzCodecUtil {
+    // This 'struct' provides a namespace for functions that compress and
+    // decompress independent blocks of bytes in the format described in
+    // {Compressed Format}.
+
+    // CONSTANTS
+    enum {
+        k_HASH_TABLE_SIZE = 1 << 12,     // number of 'int' values in the
+                                         // scratch table used by 'compress'
+
+        k_MAX_INPUT_SIZE  = 0x7e000000   // maximum number of bytes in a
+                                         // block passed to 'compress'
+    };
+
+    // CLASS METHODS
+    static bsl::size_t compress(char        *output,
+                                const char  *input,
+                                bsl::size_t  numBytes,
+                                int         *hashTable);
+        // Compress the specified 'numBytes' bytes at the specified 'input'
+        // into the specified 'output', using the specified 'hashTable' of
+        // 'k_HASH_TABLE_SIZE' elements as scratch, and return the number of
+        // bytes written to 'output'.  The behavior is undefined unless
+        // 'output' has room for at least 'compressBound(numBytes)' bytes,
+        // 'numBytes <= k_MAX_INPUT_SIZE', and 'output' and 'input' do not
+        // overlap.  Note that the contents of 'hashTable' on entry are
+        // ignored.
+
+    static bsl::size_t compressBound(bsl::size_t numBytes);
+        // Return the maximum number of bytes that 'compress' writes when
+        // compressing a block of the specified 'numBytes' bytes.
+
+    static int decompress(bsl::size_t *numBytesDecoded,
+                          char        *output,
+                          bsl::size_t  capacity,
+                          const char  *input,
+                          bsl::size_t  numBytes);
+        // Decompress the block of the specified 'numBytes' bytes at the
+        // specified 'input', which was produced by 'compress', into the
+        // specified 'output' having the specified 'capacity', and load into
+        // the specified 'numBytesDecoded' the number of bytes written.
+        // Return 0 on success, and a non-zero value (with the contents of
+        // 'output' and 'numBytesDecoded' unspecified) if the input is
+        // malformed or would decompress to more than 'capacity' bytes.  The
+        // behavior is undefined unless 'output' and 'input' do not overlap.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                            // ------------------
+                            // struct LzCodecUtil
+                            // ------------------
+
+// CLASS METHODS
+inline
+bsl::size_t LzCodecUtil::compressBound(bsl::size_t numBytes)
+{
+    return numBytes + numBytes / 255 + 16;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,815 @@
+// bdlsb_lzcodecutil.t.cpp                                            -*-C++-*-
+#include <bdlsb_lzcodecutil.h>
+
+#include <bdls_testutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a pair of pure functions.  The primary concern
+// is that 'decompress' inverts 'compress' for every input, which we verify on
+// inputs built to exercise each path of the compressor: blocks too short to
+// hold a match, literal runs and matches whose lengths need extension bytes,
+// overlapping matches, matches at the maximum offset, and incompressible
+// data.  The second concern is that 'decompress' rejects every malformed
+// input without reading or writing out of bounds, which we verify with
+// truncated, corrupted, and random inputs (under a memory checker, where
+// available).
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] bsl::size_t compress(char *, const char *, bsl::size_t, int *);
+// [ 2] bsl::size_t compressBound(bsl::size_t numBytes);
+// [ 3] int decompress(size_t *, char *, size_t, const char *, size_t);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] USAGE EXAMPLE
+// [-1] PERFORMANCE: COMPRESSION RATIO AND THROUGHPUT
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlsb::LzCodecUtil Util;
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static unsigned int nextRandom(unsigned int *state)
+    // Advance the specified linear congruential generator 'state' and return
+    // its next 15-bit pseudo-random value.
+{
+    *state = *state * 1103515245 + 12345;
+    return (*state >> 16) & 0x7fff;
+}
+
+static bsl::string makeTicks(int numTicks)
+    // Return a string holding the specified 'numTicks' fixed-width records
+    // resembling BDEX-encoded market data ticks: a symbol, a slowly varying
+    // price, and a size.
+{
+    static const char *const SYMBOLS[] = { "IBM", "AAPL", "MSFT", "GOOG" };
+
+    bsl::string  result;
+    unsigned int state = 1;
+    int          price = 14210;
+
+    for (int i = 0; i < numTicks; ++i) {
+        const char *symbol = SYMBOLS[nextRandom(&state) % 4];
+        price += static_cast<int>(nextRandom(&state) % 5) - 2;
+        const int size = 100 * static_cast<int>(1 + nextRandom(&state) % 8);
+
+        result.push_back(static_cast<char>(bsl::strlen(symbol)));
+        result.append(symbol);
+        result.push_back(0);
+        result.push_back(0);
+        result.push_back(static_cast<char>(price >> 8));
+        result.push_back(static_cast<char>(price));
+        result.push_back(0);
+        result.push_back(static_cast<char>(size >> 8));
+        result.push_back(static_cast<char>(size));
+    }
+    return result;
+}
+
+static bool roundTrip(const bsl::string& input, bsl::size_t *compressedSize)
+    // Compress and decompress the specified 'input', load into the specified
+    // 'compressedSize' the size of the compressed form, and return 'true' if
+    // the result equals 'input' and the compressed form fits the bound.
+{
+    int               hashTable[Util::k_HASH_TABLE_SIZE];
+    bsl::vector<char> compressed(Util::compressBound(input.length()) + 1,
+                                 '\xa5');
+
+    *compressedSize = Util::compress(compressed.data(),
+                                     input.data(),
+                                     input.length(),
+                                     hashTable);
+
+    if (*compressedSize > Util::compressBound(input.length())
+     || '\xa5' != compressed.back()) {
+        return false;                                                 // RETURN
+    }
+
+    bsl::vector<char> output(input.length() + 1);
+    bsl::size_t       numDecoded;
+
+    if (0 != Util::decompress(&numDecoded,
+                              output.data(),
+                              output.size(),
+                              compressed.data(),
+                              *compressedSize)) {
+        return false;                                                 // RETURN
+    }
+
+    return numDecoded == input.length()
+        && 0 == bsl::memcmp(output.data(), input.data(), numDecoded);
+}
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file
+        //:   compiles, links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Compressing and Decompressing a Block
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have a block of highly repetitive text:
+//..
+    bsl::string text;
+    for (int i = 0; i < 100; ++i) {
+        text += "IBM 142.10 100;";
+    }
+//..
+// First, we obtain a hash table and an output buffer of sufficient size, and
+// compress the text:
+//..
+    int               hashTable[bdlsb::LzCodecUtil::k_HASH_TABLE_SIZE];
+    bsl::vector<char> compressed(
+                          bdlsb::LzCodecUtil::compressBound(text.length()));
+
+    const bsl::size_t compressedLength = bdlsb::LzCodecUtil::compress(
+                                                           compressed.data(),
+                                                           text.data(),
+                                                           text.length(),
+                                                           hashTable);
+    ASSERT(compressedLength < text.length() / 10);
+//..
+// Then, we decompress it, supplying the original length as the capacity:
+//..
+    bsl::vector<char> decompressed(text.length());
+    bsl::size_t       decompressedLength;
+
+    int rc = bdlsb::LzCodecUtil::decompress(&decompressedLength,
+                                            decompressed.data(),
+                                            decompressed.size(),
+                                            compressed.data(),
+                                            compressedLength);
+    ASSERT(0 == rc);
+    ASSERT(text.length() == decompressedLength);
+    ASSERT(0 == bsl::memcmp(text.data(), decompressed.data(), text.length()));
+//..
+// Finally, we observe that truncated input is detected:
+//..
+    rc = bdlsb::LzCodecUtil::decompress(&decompressedLength,
+                                        decompressed.data(),
+                                        decompressed.size(),
+                                        compressed.data(),
+                                        compressedLength - 1);
+    ASSERT(0 != rc);
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // MALFORMED INPUT
+        //
+        // Concerns:
+        //: 1 'decompress' reports input that is truncated within a sequence,
+        //:   and never reports more bytes than were encoded.
+        //:
+        //: 2 'decompress' reports output that would exceed the capacity.
+        //:
+        //: 3 'decompress' reports a zero offset and an offset before the
+        //:   start of the output.
+        //:
+        //: 4 'decompress' reports empty input.
+        //:
+        //: 5 'decompress' neither reads nor writes out of bounds for any
+        //:   input.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Decompress every prefix of a compressed block, and verify that
+        //:   it fails or decodes a proper prefix of the original.  (C-1)
+        //:
+        //: 2 Decompress a block with every capacity less than its length.
+        //:   (C-2)
+        //:
+        //: 3 Decompress hand-crafted blocks.  (C-3..4)
+        //:
+        //: 4 Decompress blocks with random bytes changed, and blocks of
+        //:   random bytes, into exactly-sized heap buffers.  (C-5)
+        //:
+        //: 5 Verify that defensive checks are triggered for invalid
+        //:   arguments.  (C-6)
+        //
+        // Testing:
+        //   int decompress(size_t *, char *, size_t, const char *, size_t);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MALFORMED INPUT" << endl
+                          << "===============" << endl;
+
+        const bsl::string ORIGINAL = makeTicks(200)
+                                   + bsl::string(300, 'z')
+                                   + makeTicks(3);
+
+        int               hashTable[Util::k_HASH_TABLE_SIZE];
+        bsl::vector<char> compressed(Util::compressBound(ORIGINAL.length()));
+        compressed.resize(Util::compress(compressed.data(),
+                                         ORIGINAL.data(),
+                                         ORIGINAL.length(),
+                                         hashTable));
+
+        if (verbose) cout << "\nTruncated input." << endl;
+        {
+            for (bsl::size_t n = 0; n < compressed.size(); ++n) {
+                bsl::vector<char> input(compressed.begin(),
+                                        compressed.begin() + n);
+                bsl::vector<char> output(ORIGINAL.length());
+                bsl::size_t       numDecoded = 0;
+
+                const int rc = Util::decompress(&numDecoded,
+                                                output.data(),
+                                                output.size(),
+                                                input.data(),
+                                                input.size());
+                if (0 == rc) {
+                    ASSERTV(n, numDecoded < ORIGINAL.length());
+                    ASSERTV(n, 0 == bsl::memcmp(output.data(),
+                                                ORIGINAL.data(),
+                                                numDecoded));
+                }
+            }
+        }
+
+        if (verbose) cout << "\nInsufficient capacity." << endl;
+        {
+            for (bsl::size_t capacity = 0;
+                 capacity < ORIGINAL.length();
+                 capacity += 1 + capacity / 16) {
+                bsl::vector<char> output(capacity + 1);
+                bsl::size_t       numDecoded;
+
+                ASSERTV(capacity, 0 != Util::decompress(&numDecoded,
+                                                        output.data(),
+                                                        capacity,
+                                                        compressed.data(),
+                                                        compressed.size()));
+            }
+        }
+
+        if (verbose) cout << "\nHand-crafted blocks." << endl;
+        {
+            static const struct {
+                int         d_line;      // source line number
+                const char *d_input_p;   // compressed block
+                int         d_length;    // length of 'd_input_p'
+                int         d_expected;  // decoded length, or -1 if invalid
+            } DATA[] = {
+                //LINE  INPUT                               LEN  EXP
+                //----  ----------------------------------  ---  ---
+                { L_,   "",                                   0,  -1 },
+                { L_,   "\x00",                               1,   0 },
+                { L_,   "\x10" "a",                           2,   1 },
+                { L_,   "\x20" "a",                           2,  -1 },
+                { L_,   "\x10" "a\x01\x00",                   4,  -1 },
+                { L_,   "\x10" "a\x01\x00\x00",               5,   5 },
+                { L_,   "\x10" "a\x00\x00\x00",               5,  -1 },
+                { L_,   "\x10" "a\x02\x00\x00",               5,  -1 },
+                { L_,   "\x10" "a\x01",                       3,  -1 },
+                { L_,   "\xf0",                               1,  -1 },
+                { L_,   "\xf0\x00" "abcdefghijklmno",        17,  15 },
+                { L_,   "\xf0\xff",                           2,  -1 },
+                { L_,   "\x1f" "a\x01\x00\x01\x00",           6,  21 },
+                { L_,   "\x1f" "a\x01\x00\xff",               5,  -1 },
+                { L_,   "\x10" "a\x01\x00\x10" "b",           6,   6 },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int   LINE     = DATA[ti].d_line;
+                const char *INPUT    = DATA[ti].d_input_p;
+                const int   LENGTH   = DATA[ti].d_length;
+                const int   EXPECTED = DATA[ti].d_expected;
+
+                char        output[64];
+                bsl::size_t numDecoded = 0;
+
+                const int rc = Util::decompress(&numDecoded,
+                                                output,
+                                                sizeof output,
+                                                INPUT,
+                                                LENGTH);
+
+                if (veryVerbose) { T_ P_(LINE) P_(rc) P(numDecoded) }
+
+                ASSERTV(LINE, rc, (0 <= EXPECTED) == (0 == rc));
+                if (0 <= EXPECTED && 0 == rc) {
+                    ASSERTV(LINE, numDecoded,
+                            static_cast<bsl::size_t>(EXPECTED) == numDecoded);
+                }
+            }
+        }
+
+        if (verbose) cout << "\nCorrupted and random input." << endl;
+        {
+            unsigned int state = 7;
+
+            for (int i = 0; i < 2000; ++i) {
+                bsl::vector<char> input(compressed);
+                const int         numChanges = 1 + nextRandom(&state) % 4;
+
+                for (int j = 0; j < numChanges; ++j) {
+                    const bsl::size_t index = (nextRandom(&state) << 15
+                                             | nextRandom(&state))
+                                            % input.size();
+                    input[index] = static_cast<char>(nextRandom(&state));
+                }
+
+                const bsl::size_t capacity = nextRandom(&state) % 2
+                                           ? ORIGINAL.length()
+                                           : nextRandom(&state) % 64;
+
+                // Use exactly-sized heap buffers so that a memory checker
+                // detects any access out of bounds.
+
+                char *in  = new char[input.size()];
+                char *out = new char[capacity ? capacity : 1];
+                bsl::memcpy(in, input.data(), input.size());
+
+                bsl::size_t numDecoded;
+                const int   rc = Util::decompress(&numDecoded,
+                                                  out,
+                                                  capacity,
+                                                  in,
+                                                  input.size());
+                if (0 == rc) {
+                    ASSERTV(i, numDecoded <= capacity);
+                }
+
+                delete [] out;
+                delete [] in;
+            }
+
+            for (int i = 0; i < 2000; ++i) {
+                const bsl::size_t length = 1 + nextRandom(&state) % 40;
+
+                char *in = new char[length];
+                for (bsl::size_t j = 0; j < length; ++j) {
+                    in[j] = static_cast<char>(nextRandom(&state) & 0xff);
+                }
+
+                char        out[256];
+                bsl::size_t numDecoded;
+                const int   rc = Util::decompress(&numDecoded,
+                                                  out,
+                                                  sizeof out,
+                                                  in,
+                                                  length);
+                if (0 == rc) {
+                    ASSERTV(i, numDecoded <= sizeof out);
+                }
+
+                delete [] in;
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            char        output[8];
+            bsl::size_t n;
+
+            ASSERT_FAIL(Util::decompress(0, output, 8, "\x00", 1));
+            ASSERT_FAIL(Util::decompress(&n, 0, 8, "\x00", 1));
+            ASSERT_FAIL(Util::decompress(&n, output, 8, 0, 1));
+            ASSERT_PASS(Util::decompress(&n, 0, 0, "\x00", 1));
+            ASSERT_PASS(Util::decompress(&n, output, 8, 0, 0));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // 'compress' AND 'compressBound'
+        //
+        // Concerns:
+        //: 1 'decompress' reproduces the input of 'compress' exactly.
+        //:
+        //: 2 'compress' writes no more than 'compressBound' bytes, even for
+        //:   incompressible input.
+        //:
+        //: 3 Blocks too short to hold a match, and the last 12 bytes of a
+        //:   block, are handled correctly.
+        //:
+        //: 4 Literal runs and matches whose lengths need one or more
+        //:   extension bytes (including lengths of exactly 15 and 15 + 255)
+        //:   are encoded correctly.
+        //:
+        //: 5 Matches that overlap their own output, and matches at the
+        //:   maximum offset, are encoded correctly; matches beyond the
+        //:   maximum offset are not used.
+        //:
+        //: 6 Repetitive data is compressed.
+        //:
+        //: 7 The initial contents of the hash table are ignored.
+        //:
+        //: 8 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Round-trip inputs of every length up to 300 of constant,
+        //:   periodic, and random bytes.  (C-1..4)
+        //:
+        //: 2 Round-trip inputs built with matches at distances around 65535,
+        //:   and long random inputs.  (C-1..2, 5)
+        //:
+        //: 3 Verify the compressed sizes of constant and periodic inputs.
+        //:   (C-6)
+        //:
+        //: 4 Compress with hash tables of different initial contents, and
+        //:   compare the outputs.  (C-7)
+        //:
+        //: 5 Verify that defensive checks are triggered for invalid
+        //:   arguments.  (C-8)
+        //
+        // Testing:
+        //   bsl::size_t compress(char *, const char *, bsl::size_t, int *);
+        //   bsl::size_t compressBound(bsl::size_t numBytes);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'compress' AND 'compressBound'" << endl
+                          << "==============================" << endl;
+
+        ASSERT(16  == Util::compressBound(0));
+        ASSERT(272 == Util::compressBound(255));
+
+        if (verbose) cout << "\nShort inputs of every length." << endl;
+
+        unsigned int state = 3;
+
+        for (int length = 0; length <= 300; ++length) {
+            bsl::string constant(length, 'c');
+            bsl::string periodic;
+            bsl::string random;
+            for (int i = 0; i < length; ++i) {
+                periodic.push_back(static_cast<char>('a' + i % 7));
+                random.push_back(static_cast<char>(nextRandom(&state)));
+            }
+
+            bsl::size_t size;
+            ASSERTV(length, roundTrip(constant, &size));
+            ASSERTV(length, roundTrip(periodic, &size));
+            ASSERTV(length, roundTrip(random,   &size));
+        }
+
+        if (verbose) cout << "\nMaximum offset and long inputs." << endl;
+        {
+            // Place a 16-byte pattern at the start of the block, and again
+            // (or, for reference, a different pattern) at 'distance' bytes
+            // from the start, separated by a run that compresses to a single
+            // match, so that the second occurrence is found by a single
+            // probe.  The repeated pattern is a match if it is in range.
+
+            bsl::string pattern;
+            bsl::string other;
+            for (int i = 0; i < 16; ++i) {
+                pattern.push_back(static_cast<char>(nextRandom(&state)));
+                other.push_back(static_cast<char>(nextRandom(&state)));
+            }
+
+            for (int distance = 65530; distance <= 65540; ++distance) {
+                const bsl::string filler(distance - 16, 'x');
+                const bsl::string tail(20, 'e');
+
+                const bsl::string input = pattern + filler + pattern + tail;
+                const bsl::string reference =
+                                             pattern + filler + other + tail;
+
+                bsl::size_t size;
+                bsl::size_t referenceSize;
+                ASSERTV(distance, roundTrip(input,     &size));
+                ASSERTV(distance, roundTrip(reference, &referenceSize));
+
+                if (veryVerbose) { T_ P_(distance) P_(size) P(referenceSize) }
+
+                ASSERTV(distance, size, referenceSize,
+                        (distance <= 65535) == (size + 8 < referenceSize));
+            }
+
+            bsl::string random;
+            for (int i = 0; i < 300000; ++i) {
+                random.push_back(static_cast<char>(nextRandom(&state)));
+            }
+            bsl::size_t size;
+            ASSERT(roundTrip(random, &size));
+            ASSERT(size > random.length());
+
+            bsl::string ticks = makeTicks(20000);
+            ASSERT(roundTrip(ticks, &size));
+            if (veryVerbose) { P_(ticks.length()) P(size) }
+        }
+
+        if (verbose) cout << "\nCompression of repetitive data." << endl;
+        {
+            bsl::size_t size;
+
+            ASSERT(roundTrip(bsl::string(100000, 'x'), &size));
+            ASSERTV(size, size < 500);
+
+            bsl::string periodic;
+            for (int i = 0; i < 100000; ++i) {
+                periodic.push_back(static_cast<char>('a' + i % 13));
+            }
+            ASSERT(roundTrip(periodic, &size));
+            ASSERTV(size, size < 500);
+        }
+
+        if (verbose) cout << "\nInitial contents of the hash table." << endl;
+        {
+            const bsl::string input = makeTicks(500);
+
+            int               tableA[Util::k_HASH_TABLE_SIZE];
+            int               tableB[Util::k_HASH_TABLE_SIZE];
+            bsl::vector<char> outputA(Util::compressBound(input.length()));
+            bsl::vector<char> outputB(Util::compressBound(input.length()));
+
+            bsl::memset(tableA, 0,    sizeof tableA);
+            bsl::memset(tableB, 0x7f, sizeof tableB);
+
+            const bsl::size_t sizeA = Util::compress(outputA.data(),
+                                                     input.data(),
+                                                     input.length(),
+                                                     tableA);
+            const bsl::size_t sizeB = Util::compress(outputB.data(),
+                                                     input.data(),
+                                                     input.length(),
+                                                     tableB);
+            ASSERT(sizeA == sizeB);
+            ASSERT(0 == bsl::memcmp(outputA.data(), outputB.data(), sizeA));
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            int  table[Util::k_HASH_TABLE_SIZE];
+            char output[32];
+
+            ASSERT_FAIL(Util::compress(0, "abc", 3, table));
+            ASSERT_FAIL(Util::compress(output, 0, 3, table));
+            ASSERT_FAIL(Util::compress(output, "abc", 3, 0));
+            ASSERT_PASS(Util::compress(output, 0, 0, table));
+            ASSERT_PASS(Util::compress(output, "abc", 3, table));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The functions are sufficiently functional to enable
+        //:   comprehensive testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Compress a short repetitive string, verify the encoding, and
+        //:   decompress it.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        const char INPUT[] = "abcdabcdabcdabcdabcdabcd";   // 24 bytes
+
+        int  table[Util::k_HASH_TABLE_SIZE];
+        char compressed[64];
+
+        const bsl::size_t size = Util::compress(compressed,
+                                                INPUT,
+                                                sizeof INPUT - 1,
+                                                table);
+
+        // "abcd", then a match of 15 bytes at offset 4, then the last 5 bytes
+        // as literals.
+
+        ASSERTV(size, 1 + 4 + 2 + 1 + 5 == size);
+        ASSERT(0 == bsl::memcmp(compressed,
+                                "\x4b" "abcd\x04\x00" "\x50" "dabcd", 13));
+
+        char        output[24];
+        bsl::size_t numDecoded;
+        ASSERT(0 == Util::decompress(&numDecoded,
+                                     output,
+                                     sizeof output,
+                                     compressed,
+                                     size));
+        ASSERT(sizeof INPUT - 1 == numDecoded);
+        ASSERT(0 == bsl::memcmp(output, INPUT, numDecoded));
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COMPRESSION RATIO AND THROUGHPUT
+        //
+        // Concerns:
+        //: 1 The codec compresses tick-like data, in 64KB blocks, at a useful
+        //:   ratio and high throughput.
+        //
+        // Plan:
+        //: 1 Compress and decompress 64MB of tick-like records in 64KB
+        //:   blocks, and report the ratio and the throughput of each
+        //:   direction.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: COMPRESSION RATIO AND THROUGHPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: COMPRESSION RATIO AND THROUGHPUT"
+                          << endl
+                          << "============================================="
+                          << endl;
+
+        const bsl::size_t BLOCK_SIZE = 64 * 1024;
+        const int         NUM_PASSES = 16;
+        const bsl::string input      = makeTicks(4 * 1024 * 1024 / 13);
+        const bsl::size_t numBlocks  = input.length() / BLOCK_SIZE;
+
+        int               table[Util::k_HASH_TABLE_SIZE];
+        bsl::vector<char> compressed(numBlocks
+                                         * Util::compressBound(BLOCK_SIZE));
+        bsl::vector<bsl::size_t> sizes(numBlocks);
+        bsl::vector<char>        output(BLOCK_SIZE);
+
+        bsls::Stopwatch timer;
+        timer.start();
+        for (int pass = 0; pass < NUM_PASSES; ++pass) {
+            for (bsl::size_t i = 0; i < numBlocks; ++i) {
+                sizes[i] = Util::compress(
+                               compressed.data()
+                                         + i * Util::compressBound(BLOCK_SIZE),
+                               input.data() + i * BLOCK_SIZE,
+                               BLOCK_SIZE,
+                               table);
+            }
+        }
+        timer.stop();
+        const double compressTime = timer.elapsedTime();
+
+        timer.reset();
+        timer.start();
+        for (int pass = 0; pass < NUM_PASSES; ++pass) {
+            for (bsl::size_t i = 0; i < numBlocks; ++i) {
+                bsl::size_t numDecoded;
+                Util::decompress(&numDecoded,
+                                 output.data(),
+                                 output.size(),
+                                 compressed.data()
+                                         + i * Util::compressBound(BLOCK_SIZE),
+                                 sizes[i]);
+            }
+        }
+        timer.stop();
+        const double decompressTime = timer.elapsedTime();
+
+        bsl::size_t totalCompressed = 0;
+        for (bsl::size_t i = 0; i < numBlocks; ++i) {
+            totalCompressed += sizes[i];
+        }
+
+        const double megabytes = static_cast<double>(NUM_PASSES * numBlocks
+                                                     * BLOCK_SIZE)
+                               / (1024 * 1024);
+
+        cout << "ratio: "
+             << static_cast<double>(numBlocks * BLOCK_SIZE) / totalCompressed
+             << ", compress: "   << megabytes / compressTime   << " MB/s"
+             << ", decompress: " << megabytes / decompressTime << " MB/s"
+             << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,257 @@
+// bdlsb_lzcompressingoutstreambuf.cpp                                -*-C++-*-
+#include <bdlsb_lzcompressingoutstreambuf.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlsb_lzcompressingoutstreambuf_cpp,"$Id$ $CSID$")
+
+#include <bdlsb_lzcodecutil.h>
+
+#include <bslma_default.h>
+
+#include <bsl_cstring.h>
+
+namespace BloombergLP {
+
+namespace {
+
+const unsigned int k_STORED_FLAG = 0x80000000U;  // set in the stored length
+                                                 // of an uncompressed frame
+
+inline
+void putUint32(char *buffer, unsigned int value)
+    // Write the specified 'value' to the 4 bytes at the specified 'buffer' in
+    // network byte order.
+{
+    buffer[0] = static_cast<char>(value >> 24);
+    buffer[1] = static_cast<char>(value >> 16);
+    buffer[2] = static_cast<char>(value >>  8);
+    buffer[3] = static_cast<char>(value);
+}
+
+}  // close unnamed namespace
+
+namespace bdlsb {
+
+                      // -------------------------------
+                      // class LzCompressingOutStreamBuf
+                      // -------------------------------
+
+// PRIVATE MANIPULATORS
+int LzCompressingOutStreamBuf::writeBlock()
+{
+    if (!d_isValid) {
+        return -1;                                                    // RETURN
+    }
+
+    const bsl::size_t numChars = pptr() - pbase();
+    if (0 == numChars) {
+        return 0;                                                     // RETURN
+    }
+
+    // Record the block before writing it, so that a failure to allocate
+    // leaves this object unchanged.
+
+    d_blockOffsets.reserve(d_blockOffsets.size() + 1);
+    d_blockPositions.reserve(d_blockPositions.size() + 1);
+
+    char *const       payload        = d_frame_p + k_FRAME_HEADER_SIZE;
+    const bsl::size_t compressedSize = LzCodecUtil::compress(payload,
+                                                             pbase(),
+                                                             numChars,
+                                                             d_hashTable_p);
+
+    putUint32(d_frame_p, static_cast<unsigned int>(numChars));
+
+    bsl::streamsize frameSize;
+    bool            success;
+
+    if (compressedSize < numChars) {
+        putUint32(d_frame_p + 4, static_cast<unsigned int>(compressedSize));
+
+        frameSize = k_FRAME_HEADER_SIZE + compressedSize;
+        success   = frameSize == d_target_p->sputn(d_frame_p, frameSize);
+    }
+    else {
+        // Store the block itself, writing it directly from the put area.
+
+        putUint32(d_frame_p + 4,
+                  static_cast<unsigned int>(numChars) | k_STORED_FLAG);
+
+        frameSize = k_FRAME_HEADER_SIZE + numChars;
+        success   = k_FRAME_HEADER_SIZE ==
+                                d_target_p->sputn(d_frame_p,
+                                                  k_FRAME_HEADER_SIZE)
+                 && static_cast<bsl::streamsize>(numChars) ==
+                                d_target_p->sputn(pbase(), numChars);
+    }
+
+    if (!success) {
+        d_isValid = false;
+        setp(0, 0);
+        return -1;                                                    // RETURN
+    }
+
+    d_blockOffsets.push_back(d_compressedLength);
+    d_blockPositions.push_back(d_blocksLength);
+    d_compressedLength += frameSize;
+    d_blocksLength     += numChars;
+
+    setp(pbase(), epptr());
+    return 0;
+}
+
+// PROTECTED MANIPULATORS
+LzCompressingOutStreamBuf::int_type
+LzCompressingOutStreamBuf::overflow(int_type character)
+{
+    if (traits_type::eq_int_type(traits_type::eof(), character)) {
+        return traits_type::not_eof(character);                       // RETURN
+    }
+
+    if (0 != writeBlock()) {
+        return traits_type::eof();                                    // RETURN
+    }
+
+    *pptr() = traits_type::to_char_type(character);
+    pbump(1);
+
+    return character;
+}
+
+LzCompressingOutStreamBuf::pos_type
+LzCompressingOutStreamBuf::seekoff(off_type                offset,
+                                   bsl::ios_base::seekdir  whence,
+                                   bsl::ios_base::openmode modeBitMask)
+{
+    if (0 != offset
+     || bsl::ios_base::cur != whence
+     || !(modeBitMask & bsl::ios_base::out)) {
+        return pos_type(-1);                                          // RETURN
+    }
+
+    return pos_type(static_cast<off_type>(length()));
+}
+
+int LzCompressingOutStreamBuf::sync()
+{
+    if (0 != writeBlock()) {
+        return -1;                                                    // RETURN
+    }
+
+    return 0 == d_target_p->pubsync() ? 0 : -1;
+}
+
+bsl::streamsize LzCompressingOutStreamBuf::xsputn(const char_type *source,
+                                                  bsl::streamsize  numChars)
+{
+    BSLS_ASSERT(0 <= numChars);
+    BSLS_ASSERT(source || 0 == numChars);
+
+    bsl::streamsize numWritten = 0;
+
+    while (numWritten < numChars) {
+        if (pptr() == epptr() && 0 != writeBlock()) {
+            break;
+        }
+
+        bsl::streamsize n = epptr() - pptr();
+        if (n > numChars - numWritten) {
+            n = numChars - numWritten;
+        }
+
+        bsl::memcpy(pptr(), source + numWritten, static_cast<bsl::size_t>(n));
+        pbump(static_cast<int>(n));
+        numWritten += n;
+    }
+
+    return numWritten;
+}
+
+// CREATORS
+LzCompressingOutStreamBuf::LzCompressingOutStreamBuf(
+                                              bsl::streambuf   *target,
+                                              bslma::Allocator *basicAllocator)
+: d_target_p(target)
+, d_blockSize(k_DEFAULT_BLOCK_SIZE)
+, d_buffer_p(0)
+, d_hashTable_p(0)
+, d_frame_p(0)
+, d_blockOffsets(basicAllocator)
+, d_blockPositions(basicAllocator)
+, d_compressedLength(0)
+, d_blocksLength(0)
+, d_isValid(true)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(target);
+
+    const bsl::size_t tableSize = LzCodecUtil::k_HASH_TABLE_SIZE * sizeof(int);
+
+    d_buffer_p = static_cast<char *>(d_allocator_p->allocate(
+                             tableSize
+                           + d_blockSize
+                           + k_FRAME_HEADER_SIZE
+                           + LzCodecUtil::compressBound(d_blockSize)));
+
+    d_hashTable_p = reinterpret_cast<int *>(d_buffer_p);
+    setp(d_buffer_p + tableSize, d_buffer_p + tableSize + d_blockSize);
+    d_frame_p     = epptr();
+}
+
+LzCompressingOutStreamBuf::LzCompressingOutStreamBuf(
+                                              bsl::streambuf   *target,
+                                              int               blockSize,
+                                              bslma::Allocator *basicAllocator)
+: d_target_p(target)
+, d_blockSize(blockSize)
+, d_buffer_p(0)
+, d_hashTable_p(0)
+, d_frame_p(0)
+, d_blockOffsets(basicAllocator)
+, d_blockPositions(basicAllocator)
+, d_compressedLength(0)
+, d_blocksLength(0)
+, d_isValid(true)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(target);
+    BSLS_ASSERT(0 < blockSize);
+    BSLS_ASSERT(blockSize <= k_MAX_BLOCK_SIZE);
+
+    const bsl::size_t tableSize = LzCodecUtil::k_HASH_TABLE_SIZE * sizeof(int);
+
+    d_buffer_p = static_cast<char *>(d_allocator_p->allocate(
+                             tableSize
+                           + d_blockSize
+                           + k_FRAME_HEADER_SIZE
+                           + LzCodecUtil::compressBound(d_blockSize)));
+
+    d_hashTable_p = reinterpret_cast<int *>(d_buffer_p);
+    setp(d_buffer_p + tableSize, d_buffer_p + tableSize + d_blockSize);
+    d_frame_p     = epptr();
+}
+
+LzCompressingOutStreamBuf::~LzCompressingOutStreamBuf()
+{
+    sync();
+    d_allocator_p->deallocate(d_buffer_p);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,431 @@
+// bdlsb_lzcompressingoutstreambuf.h                                  -*-C++-*-
+#ifndef INCLUDED_BDLSB_LZCOMPRESSINGOUTSTREAMBUF
+#define INCLUDED_BDLSB_LZCOMPRESSINGOUTSTREAMBUF
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an output 'streambuf' that compresses into framed blocks.
+//
+//@CLASSES:
+//  bdlsb::LzCompressingOutStreamBuf: block-compressing output 'streambuf'
+//
+//@SEE_ALSO: bdlsb_lzdecompressinginstreambuf, bdlsb_lzcodecutil,
+//           bslx_streambufoutstream
+//
+//@DESCRIPTION: This component provides a mechanism,
+// 'bdlsb::LzCompressingOutStreamBuf', that implements the output portion of
+// the 'bsl::basic_streambuf' protocol by collecting the characters written to
+// it into fixed-size *blocks*, compressing each full block with
+// 'bdlsb::LzCodecUtil', and writing the result, as a *frame*, to a *target*
+// 'bsl::streambuf' supplied at construction.  Its counterpart,
+// 'bdlsb::LzDecompressingInStreamBuf', reads the frames back.
+//
+// Since a 'bdlsb::LzCompressingOutStreamBuf' is a 'bsl::streambuf', it can be
+// used with any stream that writes to one; in particular, a
+// 'bslx::StreambufOutStream' over a 'bdlsb::LzCompressingOutStreamBuf' over a
+// file stream buffer externalizes BDEX-encoded values to a compressed file,
+// trading CPU time (at a rate of hundreds of megabytes per second) for a
+// reduction in I/O.
+//
+// Each block is compressed independently, so the frames written can be read
+// starting from any frame.  The offset of the frame of each block (relative
+// to the first character written to the target by this object), and the
+// position of its first uncompressed character, are recorded, and are
+// available via 'blockOffset' and 'blockPosition', so that the caller can
+// store an index of the output and later resume decompression at any block
+// (see 'bdlsb::LzDecompressingInStreamBuf::seekToBlock').
+//
+// All of the memory the stream buffer uses, namely the buffer holding the
+// block being filled, the buffer holding the frame being written, and the
+// scratch table used by the compressor, is obtained from the allocator
+// supplied at construction in a single allocation by the constructor, and is
+// reused for every block.  The only other memory used is that of the
+// recorded block offsets, which grows with the number of blocks written.
+//
+///Frame Format
+///------------
+// The compressed stream is a sequence of frames, one per block and in the
+// order in which the blocks were written, each consisting of the following,
+// where each 'Uint32' is in network byte order:
+//..
+//  +------------------+------------------+--------------------------------+
+//  | raw length       | stored length    | payload                        |
+//  | (Uint32)         | (Uint32)         | (stored length & 0x7fffffff B) |
+//  +------------------+------------------+--------------------------------+
+//..
+// The raw length is the number of (uncompressed) characters in the block,
+// from 1 to the block size.  If the high bit of the stored length is clear,
+// the payload is the block compressed in the format of 'bdlsb::LzCodecUtil';
+// if the high bit is set, the payload is the block itself, which is stored
+// this way whenever compression does not make it smaller (e.g., for data that
+// is already compressed).  The stream has no header and no trailer; the end
+// of the stream is the end of its last frame.
+//
+///Blocks and Flushing
+///-------------------
+// A block is compressed and written when it is full, when 'pubsync' is called
+// (e.g., by 'flush' on a stream using this stream buffer), and when this
+// object is destroyed.  'pubsync' also calls 'pubsync' on the target.  Note
+// that each 'pubsync' with characters pending ends a block early, so that
+// frequent flushing reduces the compression ratio.
+//
+// If the target fails to accept all of the characters of a frame, this object
+// becomes *invalid*: all subsequent output fails, and 'pubsync' returns -1.
+//
+///Seeking
+///-------
+// Only the current output position can be queried (e.g., via
+// 'bsl::ostream::tellp'), returning 'length()'; all other seek requests fail.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Compressing BDEX-Encoded Records
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we archive a large number of market data ticks, each having a
+// symbol, a price (in hundredths) and a size, encoded using BDEX, and that we
+// want to compress the archive as it is written.
+//
+// First, we create the stream buffer to which the compressed archive is
+// written (a 'bsl::stringbuf', for the purposes of this example, but
+// typically a file stream buffer), a compressing stream buffer that writes to
+// it, and a 'bslx::StreambufOutStream' that writes to the compressing stream
+// buffer:
+//..
+//  bsl::stringbuf archive;
+//
+//  bdlsb::LzCompressingOutStreamBuf compressor(&archive, 4096);
+//  bslx::StreambufOutStream         out(&compressor, 20160101);
+//..
+// Then, we write the ticks, and flush the stream to write the last block:
+//..
+//  const char *const SYMBOLS[] = { "IBM", "AAPL", "MSFT", "GOOG" };
+//
+//  for (int i = 0; i < 10000; ++i) {
+//      out.putString(bsl::string(SYMBOLS[i % 4]));
+//      out.putInt32(14210 + i % 7);
+//      out.putInt32(100 * (1 + i % 3));
+//  }
+//  out.flush();
+//  assert(out);
+//..
+// Now, we observe that the ticks were written in several blocks, and
+// compressed:
+//..
+//  assert(10 < compressor.numBlocks());
+//  assert(compressor.compressedLength() < compressor.length() / 2);
+//
+//  const bsls::Types::Int64 archiveLength = archive.str().size();
+//  assert(compressor.compressedLength() == archiveLength);
+//..
+// Finally, we record the offset and position of a block in the middle of the
+// archive, so that reading can later resume there (see
+// {'bdlsb_lzdecompressinginstreambuf'|Example 2}):
+//..
+//  const bsls::Types::Int64 offset   = compressor.blockOffset(5);
+//  const bsls::Types::Int64 position = compressor.blockPosition(5);
+//
+//  assert(5 * 4096 == position);
+//  assert(0        <  offset);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOS
+#include <bsl_ios.h>
+#endif
+
+#ifndef INCLUDED_BSL_STREAMBUF
+#include <bsl_streambuf.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlsb {
+
+                      // ===============================
+                      // class LzCompressingOutStreamBuf
+                      // ===============================
+
+class LzCompressingOutStreamBuf : public bsl::streambuf {
+    // This class implements the output functionality of the
+    // 'bsl::basic_streambuf' protocol, compressing the characters written to
+    // it in blocks, and writing each compressed block as a frame (see {Frame
+    // Format}) to a target stream buffer.
+
+  public:
+    // TYPES
+    typedef bsl::streambuf::char_type   char_type;
+    typedef bsl::streambuf::int_type    int_type;
+    typedef bsl::streambuf::pos_type    pos_type;
+    typedef bsl::streambuf::off_type    off_type;
+    typedef bsl::streambuf::traits_type traits_type;
+
+    // CONSTANTS
+    enum {
+        k_DEFAULT_BLOCK_SIZE = 64 * 1024,        // block size used unless
+                                                 // one is specified
+
+        k_MAX_BLOCK_SIZE     = 4 * 1024 * 1024,  // largest block size
+
+        k_FRAME_HEADER_SIZE  = 8                 // bytes preceding the
+                                                 // payload of a frame
+    };
+
+  private:
+    // DATA
+    bsl::streambuf                  *d_target_p;          // destination of
+                                                          // the frames (held,
+                                                          // not owned)
+
+    int                              d_blockSize;         // characters per
+                                                          // full block
+
+    char                            *d_buffer_p;          // single allocation
+                                                          // holding the
+                                                          // buffers below
+                                                          // (owned)
+
+    int                             *d_hashTable_p;       // compressor
+                                                          // scratch table
+
+    char                            *d_frame_p;           // frame being
+                                                          // written
+
+    bsl::vector<bsls::Types::Int64>  d_blockOffsets;      // target offset of
+                                                          // each frame written
+
+    bsl::vector<bsls::Types::Int64>  d_blockPositions;    // position of the
+                                                          // first character of
+                                                          // each block written
+
+    bsls::Types::Int64               d_compressedLength;  // characters written
+                                                          // to the target
+
+    bsls::Types::Int64               d_blocksLength;      // characters in the
+                                                          // blocks written
+
+    bool                             d_isValid;           // 'false' once the
+                                                          // target has failed
+
+    bslma::Allocator                *d_allocator_p;       // memory allocator
+                                                          // (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    LzCompressingOutStreamBuf(const LzCompressingOutStreamBuf&);
+    LzCompressingOutStreamBuf& operator=(const LzCompressingOutStreamBuf&);
+
+    // PRIVATE MANIPULATORS
+    int writeBlock();
+        // Compress the characters in the put area, if any, write them as a
+        // frame to the target, and empty the put area.  Return 0 on success,
+        // and a non-zero value (with this object invalid) if this object is
+        // invalid or the target does not accept the whole frame.
+
+  protected:
+    // PROTECTED MANIPULATORS
+    virtual int_type overflow(int_type character = traits_type::eof());
+        // Write the current block, which is full, and append the specified
+        // 'character' to the next block.  Return 'character' on success, and
+        // 'traits_type::eof()' if this object is, or becomes, invalid.  If
+        // 'character' is 'traits_type::eof()', return
+        // 'traits_type::not_eof(character)' with no other effect.
+
+    virtual pos_type seekoff(
+                       off_type                offset,
+                       bsl::ios_base::seekdir  whence,
+                       bsl::ios_base::openmode modeBitMask = bsl::ios_base::in
+                                                         | bsl::ios_base::out);
+        // Return the current output position (i.e., 'length()') if the
+        // specified 'offset' is 0, the specified 'whence' is
+        // 'bsl::ios_base::cur', and the optionally specified 'modeBitMask'
+        // includes 'bsl::ios_base::out'; otherwise return 'pos_type(-1)'.
+        // This method has no effect.
+
+    virtual int sync();
+        // Write the current block, if it holds any characters, and call
+        // 'pubsync' on the target.  Return 0 on success, and -1 if this
+        // object is, or becomes, invalid, or if the target's 'pubsync'
+        // fails.
+
+    virtual bsl::streamsize xsputn(const char_type *source,
+                                   bsl::streamsize  numChars);
+        // Append the specified 'numChars' characters from the specified
+        // 'source' to this stream buffer, writing each block that becomes
+        // full, and return the number of characters appended, which is less
+        // than 'numChars' only if this object is, or becomes, invalid.  The
+        // behavior is undefined unless '0 <= numChars'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(LzCompressingOutStreamBuf,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    LzCompressingOutStreamBuf(bsl::streambuf   *target,
+                              bslma::Allocator *basicAllocator = 0);
+    LzCompressingOutStreamBuf(bsl::streambuf   *target,
+                              int               blockSize,
+                              bslma::Allocator *basicAllocator = 0);
+        // Create a stream buffer that writes compressed frames to the
+        // specified 'target'.  Optionally specify a 'blockSize' (in
+        // characters) of the blocks into which the output is divided; if
+        // 'blockSize' is not specified, 'k_DEFAULT_BLOCK_SIZE' is used.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless 'target' remains valid for
+        // the lifetime of this object, and
+        // '0 < blockSize <= k_MAX_BLOCK_SIZE'.
+
+    virtual ~LzCompressingOutStreamBuf();
+        // Write the current block, if it holds any characters, call
+        // 'pubsync' on the target, and destroy this stream buffer.
+
+    // ACCESSORS
+    bsls::Types::Int64 blockOffset(int index) const;
+        // Return the offset, in the target, of the frame of the block at the
+        // specified 'index', relative to the first character written to the
+        // target by this object.  The behavior is undefined unless
+        // '0 <= index < numBlocks()'.
+
+    bsls::Types::Int64 blockPosition(int index) const;
+        // Return the position, in the (uncompressed) output, of the first
+        // character of the block at the specified 'index'.  The behavior is
+        // undefined unless '0 <= index < numBlocks()'.
+
+    int blockSize() const;
+        // Return the number of characters in a full block.
+
+    bsls::Types::Int64 compressedLength() const;
+        // Return the number of characters written to the target by this
+        // object.
+
+    bool isValid() const;
+        // Return 'true' if this object is valid, and 'false' if it has
+        // failed to write a frame to the target.
+
+    bsls::Types::Int64 length() const;
+        // Return the number of characters written to this stream buffer,
+        // including those in the current (not yet written) block.
+
+    int numBlocks() const;
+        // Return the number of blocks written to the target.
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this stream buffer to supply memory.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                      // -------------------------------
+                      // class LzCompressingOutStreamBuf
+                      // -------------------------------
+
+// ACCESSORS
+inline
+bsls::Types::Int64 LzCompressingOutStreamBuf::blockOffset(int index) const
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < numBlocks());
+
+    return d_blockOffsets[index];
+}
+
+inline
+bsls::Types::Int64 LzCompressingOutStreamBuf::blockPosition(int index) const
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < numBlocks());
+
+    return d_blockPositions[index];
+}
+
+inline
+int LzCompressingOutStreamBuf::blockSize() const
+{
+    return d_blockSize;
+}
+
+inline
+bsls::Types::Int64 LzCompressingOutStreamBuf::compressedLength() const
+{
+    return d_compressedLength;
+}
+
+inline
+bool LzCompressingOutStreamBuf::isValid() const
+{
+    return d_isValid;
+}
+
+inline
+bsls::Types::Int64 LzCompressingOutStreamBuf::length() const
+{
+    return d_blocksLength + (pptr() - pbase());
+}
+
+inline
+int LzCompressingOutStreamBuf::numBlocks() const
+{
+    return static_cast<int>(d_blockOffsets.size());
+}
+
+inline
+bslma::Allocator *LzCompressingOutStreamBuf::allocator() const
+{
+    return d_allocator_p;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1070 @@
+// bdlsb_lzcompressingoutstreambuf.t.cpp                              -*-C++-*-
+#include <bdlsb_lzcompressingoutstreambuf.h>
+
+#include <bdlsb_lzcodecutil.h>
+
+#include <bdls_testutil.h>
+
+#include <bslx_streambufoutstream.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_ostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is an output stream buffer that compresses its
+// output in blocks and writes each block as a frame to a target stream
+// buffer.  The primary concerns are that the frames written, decoded
+// independently, reproduce every character written (through 'sputc' or
+// 'sputn') exactly once and in order, that blocks are written exactly when
+// they become full, when 'pubsync' is called, and on destruction, that the
+// recorded block offsets and positions describe the frames, and that a
+// target that fails is reported.  We verify the frames with an independent
+// parser built on 'bdlsb::LzCodecUtil'.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] LzCompressingOutStreamBuf(streambuf *, Allocator *ba = 0);
+// [ 2] LzCompressingOutStreamBuf(streambuf *, int, Allocator *ba = 0);
+// [ 2] ~LzCompressingOutStreamBuf();
+//
+// MANIPULATORS
+// [ 3] int_type overflow(int_type character);
+// [ 3] streamsize xsputn(const char_type *source, streamsize numChars);
+// [ 4] int sync();
+// [ 4] pos_type seekoff(off_type, seekdir, openmode);
+//
+// ACCESSORS
+// [ 3] bsls::Types::Int64 blockOffset(int index) const;
+// [ 3] bsls::Types::Int64 blockPosition(int index) const;
+// [ 2] int blockSize() const;
+// [ 3] bsls::Types::Int64 compressedLength() const;
+// [ 5] bool isValid() const;
+// [ 3] bsls::Types::Int64 length() const;
+// [ 3] int numBlocks() const;
+// [ 2] bslma::Allocator *allocator() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] FAILING TARGET
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: COMPRESSED VS. UNCOMPRESSED OUTPUT
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlsb::LzCompressingOutStreamBuf Obj;
+typedef bsls::Types::Int64               Int64;
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static unsigned int nextRandom(unsigned int *state)
+    // Advance the specified linear congruential generator 'state' and return
+    // its next 15-bit pseudo-random value.
+{
+    *state = *state * 1103515245 + 12345;
+    return (*state >> 16) & 0x7fff;
+}
+
+static unsigned int getUint32(const char *buffer)
+    // Return the value of the 4 bytes at the specified 'buffer' in network
+    // byte order.
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(
+                                                                      buffer);
+
+    return static_cast<unsigned int>(bytes[0]) << 24
+         | static_cast<unsigned int>(bytes[1]) << 16
+         | static_cast<unsigned int>(bytes[2]) <<  8
+         | static_cast<unsigned int>(bytes[3]);
+}
+
+struct Frame {
+    // This 'struct' describes one frame of a compressed stream.
+
+    Int64 d_offset;      // offset of the frame in the stream
+    int   d_rawLength;   // number of characters in the block
+    bool  d_isStored;    // 'true' if the block is stored uncompressed
+    int   d_payloadSize; // number of characters in the payload
+};
+
+static int parseFrames(bsl::string        *output,
+                       bsl::vector<Frame> *frames,
+                       const bsl::string&  stream)
+    // Load into the specified 'output' the concatenation of the blocks held
+    // in the frames of the specified compressed 'stream', and append to the
+    // specified 'frames' a description of each frame.  Return 0 on success,
+    // and a non-zero value if 'stream' is not a well-formed sequence of
+    // frames.
+{
+    output->clear();
+
+    bsl::size_t offset = 0;
+    while (offset < stream.length()) {
+        if (stream.length() - offset < Obj::k_FRAME_HEADER_SIZE) {
+            return -1;                                                // RETURN
+        }
+
+        Frame frame;
+        frame.d_offset      = offset;
+        frame.d_rawLength   = getUint32(stream.data() + offset);
+        const unsigned int stored = getUint32(stream.data() + offset + 4);
+        frame.d_isStored    = stored >> 31;
+        frame.d_payloadSize = stored & 0x7fffffff;
+        frames->push_back(frame);
+
+        offset += Obj::k_FRAME_HEADER_SIZE;
+        if (stream.length() - offset <
+                               static_cast<bsl::size_t>(frame.d_payloadSize)) {
+            return -2;                                                // RETURN
+        }
+
+        if (frame.d_isStored) {
+            if (frame.d_rawLength != frame.d_payloadSize) {
+                return -3;                                            // RETURN
+            }
+            output->append(stream, offset, frame.d_payloadSize);
+        }
+        else {
+            bsl::vector<char> block(frame.d_rawLength + 1);
+            bsl::size_t       numDecoded;
+            if (0 != bdlsb::LzCodecUtil::decompress(&numDecoded,
+                                                    block.data(),
+                                                    block.size(),
+                                                    stream.data() + offset,
+                                                    frame.d_payloadSize)
+             || static_cast<bsl::size_t>(frame.d_rawLength) != numDecoded) {
+                return -4;                                            // RETURN
+            }
+            output->append(block.data(), numDecoded);
+        }
+        offset += frame.d_payloadSize;
+    }
+
+    return 0;
+}
+
+static bsl::string makeText(int length, unsigned int seed)
+    // Return a string of the specified 'length' of compressible text made of
+    // words chosen using the specified 'seed'.
+{
+    static const char *const WORDS[] = {
+        "IBM ", "142.10 ", "100;", "AAPL ", "98.35 ", "200;", "\n"
+    };
+
+    bsl::string result;
+    while (result.length() < static_cast<bsl::size_t>(length)) {
+        result.append(WORDS[nextRandom(&seed) % 7]);
+    }
+    result.resize(length);
+    return result;
+}
+
+                          // ======================
+                          // class LimitedStreamBuf
+                          // ======================
+
+class LimitedStreamBuf : public bsl::streambuf {
+    // This class implements an output stream buffer that accepts a limited
+    // number of characters, appending them to a string, and counts the calls
+    // to 'sync'.
+
+    // DATA
+    bsl::string d_output;    // characters accepted
+    Int64       d_limit;     // maximum number of characters accepted
+    int         d_numSyncs;  // number of calls to 'sync'
+
+  protected:
+    // PROTECTED MANIPULATORS
+    virtual int_type overflow(int_type character)
+        // Append the specified 'character' unless the limit is reached, and
+        // return 'character', or 'traits_type::eof()' if the limit is
+        // reached.
+    {
+        if (traits_type::eq_int_type(traits_type::eof(), character)) {
+            return traits_type::not_eof(character);                   // RETURN
+        }
+        if (static_cast<Int64>(d_output.length()) >= d_limit) {
+            return traits_type::eof();                                // RETURN
+        }
+        d_output.push_back(traits_type::to_char_type(character));
+        return character;
+    }
+
+    virtual bsl::streamsize xsputn(const char_type *source,
+                                   bsl::streamsize  numChars)
+        // Append as many of the specified 'numChars' characters from the
+        // specified 'source' as the limit allows, and return the number
+        // appended.
+    {
+        Int64 n = d_limit - static_cast<Int64>(d_output.length());
+        if (n > numChars) {
+            n = numChars;
+        }
+        d_output.append(source, static_cast<bsl::size_t>(n));
+        return n;
+    }
+
+    virtual int sync()
+        // Count this call, and return 0.
+    {
+        ++d_numSyncs;
+        return 0;
+    }
+
+  public:
+    // CREATORS
+    explicit LimitedStreamBuf(Int64 limit)
+        // Create a stream buffer that accepts at most the specified 'limit'
+        // characters.
+    : d_limit(limit)
+    , d_numSyncs(0)
+    {
+    }
+
+    // ACCESSORS
+    int numSyncs() const
+        // Return the number of calls to 'sync'.
+    {
+        return d_numSyncs;
+    }
+
+    const bsl::string& output() const
+        // Return a reference providing non-modifiable access to the
+        // characters accepted.
+    {
+        return d_output;
+    }
+};
+
+                          // ======================
+                          // class CountingStreamBuf
+                          // ======================
+
+class CountingStreamBuf : public bsl::streambuf {
+    // This class implements an output stream buffer that discards its output
+    // and counts the characters written.
+
+    // DATA
+    Int64 d_length;  // number of characters written
+
+  protected:
+    // PROTECTED MANIPULATORS
+    virtual int_type overflow(int_type character)
+        // Count the specified 'character', and return it.
+    {
+        ++d_length;
+        return traits_type::not_eof(character);
+    }
+
+    virtual bsl::streamsize xsputn(const char_type *, bsl::streamsize n)
+        // Count the specified 'n' characters, and return 'n'.
+    {
+        d_length += n;
+        return n;
+    }
+
+  public:
+    // CREATORS
+    CountingStreamBuf()
+        // Create a stream buffer that has counted no characters.
+    : d_length(0)
+    {
+    }
+
+    // ACCESSORS
+    Int64 length() const
+        // Return the number of characters written.
+    {
+        return d_length;
+    }
+};
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file
+        //:   compiles, links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Compressing BDEX-Encoded Records
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we archive a large number of market data ticks, each having a
+// symbol, a price (in hundredths) and a size, encoded using BDEX, and that we
+// want to compress the archive as it is written.
+//
+// First, we create the stream buffer to which the compressed archive is
+// written (a 'bsl::stringbuf', for the purposes of this example, but
+// typically a file stream buffer), a compressing stream buffer that writes to
+// it, and a 'bslx::StreambufOutStream' that writes to the compressing stream
+// buffer:
+//..
+    bsl::stringbuf archive;
+
+    bdlsb::LzCompressingOutStreamBuf compressor(&archive, 4096);
+    bslx::StreambufOutStream         out(&compressor, 20160101);
+//..
+// Then, we write the ticks, and flush the stream to write the last block:
+//..
+    const char *const SYMBOLS[] = { "IBM", "AAPL", "MSFT", "GOOG" };
+
+    for (int i = 0; i < 10000; ++i) {
+        out.putString(bsl::string(SYMBOLS[i % 4]));
+        out.putInt32(14210 + i % 7);
+        out.putInt32(100 * (1 + i % 3));
+    }
+    out.flush();
+    ASSERT(out);
+//..
+// Now, we observe that the ticks were written in several blocks, and
+// compressed:
+//..
+    ASSERT(10 < compressor.numBlocks());
+    ASSERT(compressor.compressedLength() < compressor.length() / 2);
+
+    const bsls::Types::Int64 archiveLength = archive.str().size();
+    ASSERT(compressor.compressedLength() == archiveLength);
+//..
+// Finally, we record the offset and position of a block in the middle of the
+// archive, so that reading can later resume there (see
+// {'bdlsb_lzdecompressinginstreambuf'|Example 2}):
+//..
+    const bsls::Types::Int64 offset   = compressor.blockOffset(5);
+    const bsls::Types::Int64 position = compressor.blockPosition(5);
+
+    ASSERT(5 * 4096 == position);
+    ASSERT(0        <  offset);
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // FAILING TARGET
+        //
+        // Concerns:
+        //: 1 An object whose target does not accept a whole frame becomes
+        //:   invalid, and the frames written before remain intact.
+        //:
+        //: 2 Once invalid, 'sputc' and 'sputn' write nothing, 'pubsync'
+        //:   returns -1, and no further frames are written.
+        //:
+        //: 3 The destructor of an invalid object writes nothing.
+        //
+        // Plan:
+        //: 1 For a range of target limits, write compressible and
+        //:   incompressible output through an object whose target accepts
+        //:   only that many characters, and verify the validity of the
+        //:   object, the values returned, and the frames written.  (C-1..3)
+        //
+        // Testing:
+        //   FAILING TARGET
+        //   bool isValid() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "FAILING TARGET" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        unsigned int state = 5;
+        bsl::string  random;
+        for (int i = 0; i < 3000; ++i) {
+            random.push_back(static_cast<char>(nextRandom(&state)));
+        }
+        const bsl::string TEXT = makeText(3000, 1);
+
+        for (int ti = 0; ti < 2; ++ti) {
+            const bsl::string& INPUT = ti ? random : TEXT;
+
+            for (Int64 limit = 0; limit < 3200; limit += 7) {
+                LimitedStreamBuf target(limit);
+                {
+                    Obj mX(&target, 1000, &oa);  const Obj& X = mX;
+
+                    const bsl::streamsize n = mX.sputn(INPUT.data(),
+                                                       INPUT.length());
+                    const int rc = mX.pubsync();
+
+                    if (veryVerbose) {
+                        T_ P_(ti) P_(limit) P_(n) P(rc)
+                    }
+
+                    const bool complete = X.compressedLength() ==
+                                     static_cast<Int64>(target.output().size())
+                                       && 3 == X.numBlocks();
+
+                    ASSERTV(ti, limit, complete == X.isValid());
+                    ASSERTV(ti, limit, X.isValid() == (0 == rc));
+                    ASSERTV(ti, limit, !X.isValid() || 3000 == n);
+                    ASSERTV(ti, limit, n >= 1000 * X.numBlocks());
+                    ASSERTV(ti, limit,
+                            X.isValid() == (1 == target.numSyncs()));
+
+                    // The frames written before the failure are intact.
+
+                    bsl::string        decoded;
+                    bsl::vector<Frame> frames;
+                    const bsl::string  intact(target.output(),
+                                              0,
+                                              X.compressedLength());
+                    ASSERTV(ti, limit, 0 == parseFrames(&decoded,
+                                                        &frames,
+                                                        intact));
+                    ASSERTV(ti, limit, X.numBlocks() ==
+                                             static_cast<int>(frames.size()));
+                    ASSERTV(ti, limit, INPUT.compare(0,
+                                                     decoded.length(),
+                                                     decoded) == 0);
+
+                    if (!X.isValid()) {
+                        const bsl::size_t size = target.output().size();
+
+                        ASSERTV(ti, limit,
+                                Obj::traits_type::eof() == mX.sputc('a'));
+                        ASSERTV(ti, limit, 0 == mX.sputn("abc", 3));
+                        ASSERTV(ti, limit, -1 == mX.pubsync());
+                        ASSERTV(ti, limit, size == target.output().size());
+                        ASSERTV(ti, limit, 0 == target.numSyncs());
+                    }
+                }
+                ASSERTV(ti, limit, 0 == oa.numBlocksInUse());
+            }
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'sync' AND 'seekoff'
+        //
+        // Concerns:
+        //: 1 'pubsync' writes the current block, if it is not empty, as a
+        //:   frame, and calls 'pubsync' on the target.
+        //:
+        //: 2 'pubsync' with no characters pending writes no frame.
+        //:
+        //: 3 Output after 'pubsync' begins a new block.
+        //:
+        //: 4 The destructor writes the current block and calls 'pubsync' on
+        //:   the target.
+        //:
+        //: 5 'seekoff' reports the output position for a query of the
+        //:   current output position, and fails for all other requests.
+        //
+        // Plan:
+        //: 1 Write and flush, through an 'bsl::ostream', output of various
+        //:   lengths, and verify the frames written and the number of calls
+        //:   to the target's 'pubsync'.  (C-1..4)
+        //:
+        //: 2 Call 'pubseekoff' with each combination of offset, direction,
+        //:   and mode.  (C-5)
+        //
+        // Testing:
+        //   int sync();
+        //   pos_type seekoff(off_type, seekdir, openmode);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'sync' AND 'seekoff'" << endl
+                          << "====================" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        if (verbose) cout << "\nTesting 'sync'." << endl;
+        {
+            LimitedStreamBuf target(1 << 30);
+            {
+                Obj          mX(&target, 64, &oa);  const Obj& X = mX;
+                bsl::ostream stream(&mX);
+
+                ASSERT(0 == mX.pubsync());
+                ASSERT(0 == X.numBlocks());
+                ASSERT(1 == target.numSyncs());
+
+                stream << "hello" << flush;
+                ASSERT(1 == X.numBlocks());
+                ASSERT(0 == X.blockPosition(0));
+                ASSERT(2 == target.numSyncs());
+
+                stream << flush;
+                ASSERT(1 == X.numBlocks());
+                ASSERT(3 == target.numSyncs());
+
+                stream << bsl::string(100, 'a') << flush;
+                ASSERT(3 == X.numBlocks());
+                ASSERT(5  == X.blockPosition(1));
+                ASSERT(69 == X.blockPosition(2));
+                ASSERT(105 == X.length());
+
+                stream << "world";
+                ASSERT(3 == X.numBlocks());
+                ASSERT(4 == target.numSyncs());
+            }
+            ASSERT(5 == target.numSyncs());
+
+            bsl::string        decoded;
+            bsl::vector<Frame> frames;
+            ASSERT(0 == parseFrames(&decoded, &frames, target.output()));
+            ASSERT(4 == frames.size());
+            ASSERT("hello" + bsl::string(100, 'a') + "world" == decoded);
+            ASSERT(5  == frames[0].d_rawLength);
+            ASSERT(64 == frames[1].d_rawLength);
+            ASSERT(36 == frames[2].d_rawLength);
+            ASSERT(5  == frames[3].d_rawLength);
+        }
+
+        if (verbose) cout << "\nTesting 'seekoff'." << endl;
+        {
+            typedef bsl::ios_base IOS;
+
+            bsl::stringbuf target;
+            Obj            mX(&target, 16, &oa);
+
+            ASSERT(0 == mX.pubseekoff(0, IOS::cur, IOS::out));
+            mX.sputn("abcdefghijklmnopqrstuvwxyz", 26);
+            ASSERT(26 == mX.pubseekoff(0, IOS::cur, IOS::out));
+            ASSERT(26 == mX.pubseekoff(0, IOS::cur, IOS::in | IOS::out));
+            ASSERT(-1 == mX.pubseekoff(0, IOS::cur, IOS::in));
+            ASSERT(-1 == mX.pubseekoff(1, IOS::cur, IOS::out));
+            ASSERT(-1 == mX.pubseekoff(0, IOS::beg, IOS::out));
+            ASSERT(-1 == mX.pubseekoff(0, IOS::end, IOS::out));
+            ASSERT(-1 == mX.pubseekpos(0, IOS::out));
+            ASSERT(26 == mX.pubseekoff(0, IOS::cur, IOS::out));
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'overflow' AND 'xsputn'
+        //
+        // Concerns:
+        //: 1 Every character written, by 'sputc' or 'sputn', appears exactly
+        //:   once and in order in the decoded frames.
+        //:
+        //: 2 A block is written exactly when it becomes full (and another
+        //:   character is written), and holds 'blockSize()' characters.
+        //:
+        //: 3 A block that does not compress is stored uncompressed.
+        //:
+        //: 4 'blockOffset', 'blockPosition', 'numBlocks',
+        //:   'compressedLength', and 'length' describe the frames written.
+        //:
+        //: 5 'sputn' of any length, including lengths spanning several
+        //:   blocks, returns the number of characters written.
+        //:
+        //: 6 No memory is allocated other than for the block offsets.
+        //:
+        //: 7 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For a set of block sizes, write compressible and incompressible
+        //:   output of various lengths in pieces of pseudo-random lengths,
+        //:   through 'sputc' and 'sputn', and verify the frames written and
+        //:   the values of the accessors.  (C-1..6)
+        //:
+        //: 2 Verify that defensive checks are triggered for invalid
+        //:   arguments.  (C-7)
+        //
+        // Testing:
+        //   int_type overflow(int_type character);
+        //   streamsize xsputn(const char_type *source, streamsize numChars);
+        //   bsls::Types::Int64 blockOffset(int index) const;
+        //   bsls::Types::Int64 blockPosition(int index) const;
+        //   bsls::Types::Int64 compressedLength() const;
+        //   bsls::Types::Int64 length() const;
+        //   int numBlocks() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'overflow' AND 'xsputn'" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        static const int BLOCK_SIZES[] = { 1, 2, 13, 64, 1000, 65536 };
+        const int NUM_BLOCK_SIZES = static_cast<int>(sizeof BLOCK_SIZES
+                                                     / sizeof *BLOCK_SIZES);
+
+        static const int LENGTHS[] = { 0, 1, 12, 13, 14, 999, 1000, 1001,
+                                       5000, 200000 };
+        const int NUM_LENGTHS = static_cast<int>(sizeof LENGTHS
+                                                 / sizeof *LENGTHS);
+
+        unsigned int state = 9;
+
+        for (int bi = 0; bi < NUM_BLOCK_SIZES; ++bi) {
+            const int BLOCK_SIZE = BLOCK_SIZES[bi];
+
+            for (int li = 0; li < NUM_LENGTHS; ++li) {
+                const int LENGTH = LENGTHS[li];
+
+                if (BLOCK_SIZE < 13 && LENGTH > 5000) {
+                    continue;
+                }
+
+                for (int ti = 0; ti < 2; ++ti) {
+                    bsl::string input;
+                    if (ti) {
+                        for (int i = 0; i < LENGTH; ++i) {
+                            input.push_back(
+                                        static_cast<char>(nextRandom(&state)));
+                        }
+                    }
+                    else {
+                        input = makeText(LENGTH, LENGTH);
+                    }
+
+                    if (veryVerbose) { T_ P_(BLOCK_SIZE) P_(LENGTH) P(ti) }
+
+                    bsl::stringbuf target;
+                    {
+                        Obj mX(&target, BLOCK_SIZE, &oa);  const Obj& X = mX;
+
+                        ASSERT(1 == oa.numBlocksInUse());
+
+                        int written = 0;
+                        while (written < LENGTH) {
+                            int n = nextRandom(&state) % 3 == 0
+                                  ? 1
+                                  : 1 + nextRandom(&state) % (2 * BLOCK_SIZE);
+                            if (n > LENGTH - written) {
+                                n = LENGTH - written;
+                            }
+                            if (1 == n) {
+                                ASSERT(Obj::traits_type::to_int_type(
+                                                              input[written])
+                                            == mX.sputc(input[written]));
+                            }
+                            else {
+                                ASSERT(n == mX.sputn(input.data() + written,
+                                                     n));
+                            }
+                            written += n;
+
+                            ASSERTV(BLOCK_SIZE, written, X.length(),
+                                    written == X.length());
+                            ASSERTV(BLOCK_SIZE, written, X.numBlocks(),
+                                 (written - 1) / BLOCK_SIZE == X.numBlocks());
+                        }
+
+                        const int numBlocks = X.numBlocks();
+
+                        bsl::string        decoded;
+                        bsl::vector<Frame> frames;
+                        ASSERT(0 == parseFrames(&decoded,
+                                                &frames,
+                                                target.str()));
+                        ASSERT(numBlocks == static_cast<int>(frames.size()));
+                        ASSERT(X.compressedLength() ==
+                                      static_cast<Int64>(target.str().size()));
+                        ASSERT(0 == input.compare(0,
+                                                  decoded.length(),
+                                                  decoded));
+
+                        for (int i = 0; i < numBlocks; ++i) {
+                            ASSERTV(i, frames[i].d_offset ==
+                                                           X.blockOffset(i));
+                            ASSERTV(i, static_cast<Int64>(i) * BLOCK_SIZE ==
+                                                          X.blockPosition(i));
+                            ASSERTV(i, BLOCK_SIZE == frames[i].d_rawLength);
+                            if (ti && BLOCK_SIZE > 16) {
+                                ASSERTV(i, frames[i].d_isStored);
+                            }
+                            if (!ti && BLOCK_SIZE > 64) {
+                                ASSERTV(i, !frames[i].d_isStored);
+                            }
+                        }
+                    }
+
+                    // The destructor writes the rest.
+
+                    bsl::string        decoded;
+                    bsl::vector<Frame> frames;
+                    ASSERT(0 == parseFrames(&decoded, &frames, target.str()));
+                    ASSERT(input == decoded);
+                    ASSERT(0 == oa.numBlocksInUse());
+                }
+            }
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            bsl::stringbuf target;
+            Obj            mX(&target, &oa);  const Obj& X = mX;
+
+            mX.sputn("abc", 3);
+            ASSERT_FAIL(mX.sputn(0, 3));
+            ASSERT_PASS(mX.sputn(0, 0));
+
+            ASSERT_SAFE_FAIL(X.blockOffset(0));
+            ASSERT_SAFE_FAIL(X.blockPosition(0));
+            mX.pubsync();
+            ASSERT_SAFE_PASS(X.blockOffset(0));
+            ASSERT_SAFE_PASS(X.blockPosition(0));
+            ASSERT_SAFE_FAIL(X.blockOffset(-1));
+            ASSERT_SAFE_FAIL(X.blockPosition(1));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A newly constructed object has the specified (or default) block
+        //:   size, has written nothing, and is valid.
+        //:
+        //: 2 The constructor obtains all of the buffers of the object in a
+        //:   single allocation from the specified allocator (or the default
+        //:   allocator), and the destructor releases it.
+        //:
+        //: 3 The destructor of an object to which nothing was written writes
+        //:   nothing to the target.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Construct objects with each constructor, with and without an
+        //:   allocator, and verify the accessors and the allocations.
+        //:   (C-1..3)
+        //:
+        //: 2 Verify that defensive checks are triggered for invalid
+        //:   arguments.  (C-4)
+        //
+        // Testing:
+        //   LzCompressingOutStreamBuf(streambuf *, Allocator *ba = 0);
+        //   LzCompressingOutStreamBuf(streambuf *, int, Allocator *ba = 0);
+        //   ~LzCompressingOutStreamBuf();
+        //   int blockSize() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND BASIC ACCESSORS" << endl
+                          << "============================" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        ASSERT(bslma::UsesBslmaAllocator<Obj>::value);
+
+        {
+            bsl::stringbuf target;
+            {
+                Obj mX(&target);  const Obj& X = mX;
+
+                ASSERT(Obj::k_DEFAULT_BLOCK_SIZE == X.blockSize());
+                ASSERT(&defaultAllocator == X.allocator());
+                ASSERT(1 == defaultAllocator.numBlocksInUse());
+                ASSERT(0 == X.numBlocks());
+                ASSERT(0 == X.length());
+                ASSERT(0 == X.compressedLength());
+                ASSERT(X.isValid());
+            }
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+            ASSERT(target.str().empty());
+        }
+        {
+            bsl::stringbuf target;
+            {
+                Obj mX(&target, &oa);  const Obj& X = mX;
+
+                ASSERT(Obj::k_DEFAULT_BLOCK_SIZE == X.blockSize());
+                ASSERT(&oa == X.allocator());
+                ASSERT(1 == oa.numBlocksInUse());
+            }
+            ASSERT(0 == oa.numBlocksInUse());
+        }
+        {
+            static const int BLOCK_SIZES[] = {
+                1, 2, 100, 4096, Obj::k_MAX_BLOCK_SIZE
+            };
+            const int NUM_BLOCK_SIZES = static_cast<int>(sizeof BLOCK_SIZES
+                                                       / sizeof *BLOCK_SIZES);
+
+            for (int i = 0; i < NUM_BLOCK_SIZES; ++i) {
+                bsl::stringbuf target;
+                {
+                    Obj mX(&target, BLOCK_SIZES[i], &oa);  const Obj& X = mX;
+
+                    ASSERTV(i, BLOCK_SIZES[i] == X.blockSize());
+                    ASSERTV(i, &oa == X.allocator());
+                    ASSERTV(i, 1 == oa.numBlocksInUse());
+                    ASSERTV(i, 0 == X.numBlocks());
+                    ASSERTV(i, X.isValid());
+                }
+                ASSERTV(i, 0 == oa.numBlocksInUse());
+            }
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            bsl::stringbuf target;
+
+            ASSERT_FAIL(Obj(0, &oa));
+            ASSERT_PASS(Obj(&target, &oa));
+            ASSERT_FAIL(Obj(0, 16, &oa));
+            ASSERT_FAIL(Obj(&target, 0, &oa));
+            ASSERT_FAIL(Obj(&target, Obj::k_MAX_BLOCK_SIZE + 1, &oa));
+            ASSERT_PASS(Obj(&target, 1, &oa));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Write repetitive text through an 'bsl::ostream', flush it, and
+        //:   verify the frame written.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        bsl::stringbuf target;
+        {
+            Obj          mX(&target, &oa);  const Obj& X = mX;
+            bsl::ostream stream(&mX);
+
+            for (int i = 0; i < 100; ++i) {
+                stream << "IBM 142.10 100;";
+            }
+            ASSERT(0    == X.numBlocks());
+            ASSERT(1500 == X.length());
+
+            stream.flush();
+            ASSERT(stream);
+            ASSERT(1 == X.numBlocks());
+            ASSERT(0 == X.blockOffset(0));
+            ASSERT(0 == X.blockPosition(0));
+            ASSERT(X.compressedLength() < 100);
+
+            const bsl::string output = target.str();
+            ASSERT(X.compressedLength() == static_cast<Int64>(output.size()));
+            ASSERT(0 == bsl::memcmp(output.data(), "\0\0\x05\xdc", 4));
+            ASSERT(0 == (output[4] & 0x80));
+
+            bsl::string        decoded;
+            bsl::vector<Frame> frames;
+            ASSERT(0 == parseFrames(&decoded, &frames, output));
+            ASSERT(1 == frames.size());
+            ASSERT(1500 == decoded.length());
+            ASSERT(0 == decoded.compare(0, 15, "IBM 142.10 100;"));
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COMPRESSED VS. UNCOMPRESSED OUTPUT
+        //
+        // Concerns:
+        //: 1 Externalizing BDEX-encoded ticks through a compressing stream
+        //:   buffer substantially reduces the number of characters written,
+        //:   at an acceptable cost in time.
+        //
+        // Plan:
+        //: 1 Externalize a large number of ticks with a
+        //:   'bslx::StreambufOutStream', directly to a counting stream
+        //:   buffer and through an object using the default block size, and
+        //:   report the number of characters written and the elapsed times.
+        //:   (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: COMPRESSED VS. UNCOMPRESSED OUTPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: COMPRESSED VS. UNCOMPRESSED OUTPUT"
+                          << endl
+                          << "==============================================="
+                          << endl;
+
+        const int NUM_TICKS = argc > 2 ? atoi(argv[2]) : 5000000;
+
+        static const char *const SYMBOLS[] = { "IBM", "AAPL", "MSFT", "GOOG" };
+
+        bslma::Allocator& newDeleteAllocator =
+                                        bslma::NewDeleteAllocator::singleton();
+
+        for (int compressed = 0; compressed < 2; ++compressed) {
+            CountingStreamBuf counter;
+            Obj               compressor(&counter, &newDeleteAllocator);
+            bsl::streambuf   *sb = compressed
+                                 ? static_cast<bsl::streambuf *>(&compressor)
+                                 : &counter;
+
+            bsls::Stopwatch timer;
+            timer.start();
+            {
+                bslx::StreambufOutStream out(sb, 20160101);
+                unsigned int             state = 1;
+                int                      price = 14210;
+
+                for (int i = 0; i < NUM_TICKS; ++i) {
+                    price += static_cast<int>(nextRandom(&state) % 5) - 2;
+                    out.putString(bsl::string(SYMBOLS[i % 4]));
+                    out.putInt32(price);
+                    out.putInt32(100 * (1 + nextRandom(&state) % 8));
+                }
+                out.flush();
+            }
+            timer.stop();
+
+            cout << (compressed ? "compressed:   " : "uncompressed: ")
+                 << counter.length() << " bytes in "
+                 << timer.elapsedTime() << "s" << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,229 @@
+// bdlsb_lzdecompressinginstreambuf.cpp                               -*-C++-*-
+#include <bdlsb_lzdecompressinginstreambuf.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlsb_lzdecompressinginstreambuf_cpp,"$Id$ $CSID$")
+
+#include <bdlsb_lzcodecutil.h>
+#include <bdlsb_lzcompressingoutstreambuf.h>
+
+#include <bslma_default.h>
+
+#include <bsls_assert.h>
+
+namespace BloombergLP {
+
+namespace {
+
+enum {
+    k_FRAME_HEADER_SIZE = bdlsb::LzCompressingOutStreamBuf::k_FRAME_HEADER_SIZE
+};
+
+const unsigned int k_STORED_FLAG = 0x80000000U;  // set in the stored length
+                                                 // of an uncompressed frame
+
+inline
+unsigned int getUint32(const char *buffer)
+    // Return the value of the 4 bytes at the specified 'buffer' in network
+    // byte order.
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(
+                                                                      buffer);
+
+    return static_cast<unsigned int>(bytes[0]) << 24
+         | static_cast<unsigned int>(bytes[1]) << 16
+         | static_cast<unsigned int>(bytes[2]) <<  8
+         | static_cast<unsigned int>(bytes[3]);
+}
+
+bsl::streamsize readFully(bsl::streambuf  *source,
+                          char            *buffer,
+                          bsl::streamsize  numChars)
+    // Read into the specified 'buffer' the specified 'numChars' characters
+    // from the specified 'source', calling 'sgetn' until 'numChars' are read
+    // or 'sgetn' returns 0, and return the number of characters read.
+{
+    bsl::streamsize numRead = 0;
+    while (numRead < numChars) {
+        const bsl::streamsize n = source->sgetn(buffer + numRead,
+                                                numChars - numRead);
+        if (0 >= n) {
+            break;
+        }
+        numRead += n;
+    }
+    return numRead;
+}
+
+}  // close unnamed namespace
+
+namespace bdlsb {
+
+                      // --------------------------------
+                      // class LzDecompressingInStreamBuf
+                      // --------------------------------
+
+// PRIVATE MANIPULATORS
+void LzDecompressingInStreamBuf::initialize()
+{
+    // The block buffer is followed by the frame buffer, which is large enough
+    // for the header and the payload of the largest compressed block.
+
+    d_buffer_p = static_cast<char *>(d_allocator_p->allocate(
+                             d_maxBlockSize
+                           + k_FRAME_HEADER_SIZE
+                           + LzCodecUtil::compressBound(d_maxBlockSize)));
+    d_frame_p  = d_buffer_p + d_maxBlockSize;
+
+    setg(d_buffer_p, d_buffer_p, d_buffer_p);
+
+    d_origin = d_source_p->pubseekoff(0,
+                                      bsl::ios_base::cur,
+                                      bsl::ios_base::in);
+}
+
+int LzDecompressingInStreamBuf::readBlock()
+{
+    setg(d_buffer_p, d_buffer_p, d_buffer_p);
+
+    const bsl::streamsize numRead = readFully(d_source_p,
+                                              d_frame_p,
+                                              k_FRAME_HEADER_SIZE);
+    if (0 == numRead) {
+        return 1;                                                     // RETURN
+    }
+
+    const unsigned int rawLength    = getUint32(d_frame_p);
+    const unsigned int storedLength = getUint32(d_frame_p + 4);
+    const bool         isStored     = storedLength & k_STORED_FLAG;
+    const bsl::size_t  payloadSize  = storedLength & ~k_STORED_FLAG;
+
+    const bool isConsistent = isStored
+                            ? rawLength == payloadSize
+                            : 0 < payloadSize
+                           && payloadSize <= LzCodecUtil::compressBound(
+                                                                   rawLength);
+
+    if (k_FRAME_HEADER_SIZE != numRead
+     || 0 == rawLength
+     || static_cast<unsigned int>(d_maxBlockSize) < rawLength
+     || !isConsistent) {
+        d_isValid = false;
+        return -1;                                                    // RETURN
+    }
+
+    char *const payload = isStored ? d_buffer_p
+                                   : d_frame_p + k_FRAME_HEADER_SIZE;
+
+    if (static_cast<bsl::streamsize>(payloadSize) !=
+                                readFully(d_source_p, payload, payloadSize)) {
+        d_isValid = false;
+        return -2;                                                    // RETURN
+    }
+
+    if (!isStored) {
+        bsl::size_t numDecoded;
+        if (0 != LzCodecUtil::decompress(&numDecoded,
+                                         d_buffer_p,
+                                         rawLength,
+                                         payload,
+                                         payloadSize)
+         || rawLength != numDecoded) {
+            d_isValid = false;
+            return -3;                                                // RETURN
+        }
+    }
+
+    setg(d_buffer_p, d_buffer_p, d_buffer_p + rawLength);
+    return 0;
+}
+
+// PROTECTED MANIPULATORS
+LzDecompressingInStreamBuf::int_type LzDecompressingInStreamBuf::underflow()
+{
+    if (gptr() == egptr() && (!d_isValid || 0 != readBlock())) {
+        return traits_type::eof();                                    // RETURN
+    }
+
+    return traits_type::to_int_type(*gptr());
+}
+
+// CREATORS
+LzDecompressingInStreamBuf::LzDecompressingInStreamBuf(
+                                              bsl::streambuf   *source,
+                                              bslma::Allocator *basicAllocator)
+: d_source_p(source)
+, d_maxBlockSize(k_DEFAULT_MAX_BLOCK_SIZE)
+, d_buffer_p(0)
+, d_frame_p(0)
+, d_origin(-1)
+, d_isValid(true)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(source);
+
+    initialize();
+}
+
+LzDecompressingInStreamBuf::LzDecompressingInStreamBuf(
+                                              bsl::streambuf   *source,
+                                              int               maxBlockSize,
+                                              bslma::Allocator *basicAllocator)
+: d_source_p(source)
+, d_maxBlockSize(maxBlockSize)
+, d_buffer_p(0)
+, d_frame_p(0)
+, d_origin(-1)
+, d_isValid(true)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(source);
+    BSLS_ASSERT(0 < maxBlockSize);
+    BSLS_ASSERT(maxBlockSize <= k_MAX_BLOCK_SIZE);
+
+    initialize();
+}
+
+LzDecompressingInStreamBuf::~LzDecompressingInStreamBuf()
+{
+    d_allocator_p->deallocate(d_buffer_p);
+}
+
+// MANIPULATORS
+int LzDecompressingInStreamBuf::seekToBlock(bsls::Types::Int64 offset)
+{
+    BSLS_ASSERT(0 <= offset);
+
+    if (pos_type(-1) == d_origin) {
+        return -1;                                                    // RETURN
+    }
+
+    const pos_type target = d_origin + static_cast<off_type>(offset);
+
+    if (target != d_source_p->pubseekpos(target, bsl::ios_base::in)) {
+        return -2;                                                    // RETURN
+    }
+
+    setg(d_buffer_p, d_buffer_p, d_buffer_p);
+    d_isValid = true;
+    return 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
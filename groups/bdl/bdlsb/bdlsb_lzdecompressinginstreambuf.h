@@ -0,0 +1,361 @@
+// bdlsb_lzdecompressinginstreambuf.h                                 -*-C++-*-
+#ifndef INCLUDED_BDLSB_LZDECOMPRESSINGINSTREAMBUF
+#define INCLUDED_BDLSB_LZDECOMPRESSINGINSTREAMBUF
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an input 'streambuf' that decompresses framed blocks.
+//
+//@CLASSES:
+//  bdlsb::LzDecompressingInStreamBuf: block-decompressing input 'streambuf'
+//
+//@SEE_ALSO: bdlsb_lzcompressingoutstreambuf, bdlsb_lzcodecutil,
+//           bslx_streambufinstream
+//
+//@DESCRIPTION: This component provides a mechanism,
+// 'bdlsb::LzDecompressingInStreamBuf', that implements the input portion of
+// the 'bsl::basic_streambuf' protocol by reading frames (see
+// {'bdlsb_lzcompressingoutstreambuf'|Frame Format}), as written by
+// 'bdlsb::LzCompressingOutStreamBuf', from a *source* 'bsl::streambuf'
+// supplied at construction, and supplying the characters of each block in
+// turn.  In particular, a 'bslx::StreambufInStream' over a
+// 'bdlsb::LzDecompressingInStreamBuf' unexternalizes BDEX-encoded values
+// from a compressed stream.
+//
+// The source is read with 'sgetn', which is called again after a short read
+// until the frame is complete or 'sgetn' returns 0 (i.e., the source is
+// exhausted).  The end of the source at a frame boundary is the end of the
+// decompressed input.  A frame that is incomplete, malformed, or that holds a block larger
+// than the *maximum* *block* *size* supplied at construction (which must be at
+// least the block size used to write the stream) makes this object *invalid*:
+// the characters of the blocks that precede the frame remain available, but
+// no further characters are supplied.  Note that the frame format has no
+// checksum, so corruption is detected only where it makes a frame
+// inconsistent.
+//
+// All of the memory the stream buffer uses, namely the buffer holding the
+// current block and the buffer holding the frame being read, is obtained from
+// the allocator supplied at construction in a single allocation by the
+// constructor, and is reused for every block.
+//
+///Random Access
+///-------------
+// Since each block is compressed independently, decompression can begin at
+// any frame.  'seekToBlock' positions the source at a specified offset,
+// relative to the position of the source when this object was created, which
+// must be the offset of a frame (e.g., as obtained from
+// 'bdlsb::LzCompressingOutStreamBuf::blockOffset' when the stream was
+// written), discards the current block, and makes this object valid; the next
+// character supplied is the first character of the block in that frame.
+// 'seekToBlock' fails if the source does not support seeking.  All other seek
+// requests on this object fail.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Reading Compressed BDEX-Encoded Records
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we have an archive of market data ticks, written as shown in
+// {'bdlsb_lzcompressingoutstreambuf'|Example 1}:
+//..
+//  bsl::stringbuf archive;
+//
+//  const char *const SYMBOLS[] = { "IBM", "AAPL", "MSFT", "GOOG" };
+//
+//  bsls::Types::Int64 offset;
+//  {
+//      bdlsb::LzCompressingOutStreamBuf compressor(&archive, 4096);
+//      bslx::StreambufOutStream         out(&compressor, 20160101);
+//
+//      for (int i = 0; i < 10000; ++i) {
+//          out.putString(bsl::string(SYMBOLS[i % 4]));
+//          out.putInt32(14210 + i % 7);
+//          out.putInt32(100 * (1 + i % 3));
+//      }
+//      out.flush();
+//      assert(out);
+//
+//      offset = compressor.blockOffset(5);
+//  }
+//..
+// First, we create a decompressing stream buffer that reads from the archive,
+// and a 'bslx::StreambufInStream' that reads from it:
+//..
+//  bdlsb::LzDecompressingInStreamBuf decompressor(&archive, 4096);
+//  bslx::StreambufInStream           in(&decompressor);
+//..
+// Then, we read the ticks back, verifying their values:
+//..
+//  for (int i = 0; i < 10000; ++i) {
+//      bsl::string symbol;
+//      int         price;
+//      int         size;
+//
+//      in.getString(symbol);
+//      in.getInt32(price);
+//      in.getInt32(size);
+//
+//      assert(in);
+//      assert(SYMBOLS[i % 4]    == symbol);
+//      assert(14210 + i % 7     == price);
+//      assert(100 * (1 + i % 3) == size);
+//  }
+//..
+// Finally, we observe that the input is exhausted, and that the archive was
+// well-formed:
+//..
+//  char c;
+//  in.getInt8(c);
+//  assert(!in);
+//  assert(decompressor.isValid());
+//..
+//
+///Example 2: Resuming at a Recorded Block
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that, in the previous example, we want to resume reading the
+// archive at the block whose offset was recorded when it was written.  Note
+// that, since the ticks were written without regard to block boundaries, a
+// tick may span two blocks; a writer that needs to resume reading at a tick
+// flushes the stream after the tick that fills each block (see
+// {'bdlsb_lzcompressingoutstreambuf'|Blocks and Flushing}), or also records
+// the position of the first tick in each block.  Here, we verify only that
+// decompression resumes at the recorded block.
+//
+// First, we rewind the archive, and create a decompressing stream buffer that
+// reads from it:
+//..
+//  archive.pubseekpos(0);
+//
+//  bdlsb::LzDecompressingInStreamBuf reader(&archive, 4096);
+//
+//  int rc = reader.seekToBlock(0);
+//  assert(0 == rc);
+//..
+// Then, we verify that the first block begins with the first tick (a string
+// of length 3 holding "IBM"):
+//..
+//  assert(3   == reader.sbumpc());
+//  assert('I' == reader.sbumpc());
+//..
+// Next, we move to the recorded block, and read a whole block of
+// decompressed characters from it:
+//..
+//  rc = reader.seekToBlock(offset);
+//  assert(0 == rc);
+//
+//  char block[4096];
+//  assert(4096 == reader.sgetn(block, 4096));
+//  assert(reader.isValid());
+//..
+// Finally, we observe that an offset that does not refer to a frame is
+// detected when the frame is read:
+//..
+//  rc = reader.seekToBlock(offset + 1);
+//  assert(0 == rc);
+//  assert(bsl::streambuf::traits_type::eof() == reader.sgetc());
+//  assert(!reader.isValid());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOS
+#include <bsl_ios.h>
+#endif
+
+#ifndef INCLUDED_BSL_STREAMBUF
+#include <bsl_streambuf.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlsb {
+
+                      // ================================
+                      // class LzDecompressingInStreamBuf
+                      // ================================
+
+class LzDecompressingInStreamBuf : public bsl::streambuf {
+    // This class implements the input functionality of the
+    // 'bsl::basic_streambuf' protocol, reading compressed frames (see
+    // {'bdlsb_lzcompressingoutstreambuf'|Frame Format}) from a source stream
+    // buffer and supplying the characters of the blocks they hold.
+
+  public:
+    // TYPES
+    typedef bsl::streambuf::char_type   char_type;
+    typedef bsl::streambuf::int_type    int_type;
+    typedef bsl::streambuf::pos_type    pos_type;
+    typedef bsl::streambuf::off_type    off_type;
+    typedef bsl::streambuf::traits_type traits_type;
+
+    // CONSTANTS
+    enum {
+        k_DEFAULT_MAX_BLOCK_SIZE = 64 * 1024,       // maximum block size used
+                                                    // unless one is specified
+
+        k_MAX_BLOCK_SIZE         = 4 * 1024 * 1024  // largest maximum block
+                                                    // size
+    };
+
+  private:
+    // DATA
+    bsl::streambuf   *d_source_p;      // source of the frames (held, not
+                                       // owned)
+
+    int               d_maxBlockSize;  // largest block accepted
+
+    char             *d_buffer_p;      // single allocation holding the
+                                       // current block and the frame being
+                                       // read (owned)
+
+    char             *d_frame_p;       // frame being read
+
+    pos_type          d_origin;        // position of the source at
+                                       // construction, or -1 if unknown
+
+    bool              d_isValid;       // 'false' once a malformed frame has
+                                       // been read
+
+    bslma::Allocator *d_allocator_p;   // memory allocator (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    LzDecompressingInStreamBuf(const LzDecompressingInStreamBuf&);
+    LzDecompressingInStreamBuf& operator=(const LzDecompressingInStreamBuf&);
+
+    // PRIVATE MANIPULATORS
+    void initialize();
+        // Allocate the buffers of this object and record the position of the
+        // source.
+
+    int readBlock();
+        // Read the next frame from the source and make its block the get
+        // area.  Return 0 on success, a positive value (with the get area
+        // empty) if the source is exhausted at a frame boundary, and a
+        // negative value (with the get area empty and this object invalid) if
+        // the frame is incomplete or malformed.
+
+  protected:
+    // PROTECTED MANIPULATORS
+    virtual int_type underflow();
+        // Read the next frame from the source if the get area is exhausted,
+        // and return the next character, which is not consumed.  Return
+        // 'traits_type::eof()' if the source is exhausted at a frame
+        // boundary, or if this object is, or becomes, invalid.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(LzDecompressingInStreamBuf,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    LzDecompressingInStreamBuf(bsl::streambuf   *source,
+                               bslma::Allocator *basicAllocator = 0);
+    LzDecompressingInStreamBuf(bsl::streambuf   *source,
+                               int               maxBlockSize,
+                               bslma::Allocator *basicAllocator = 0);
+        // Create a stream buffer that reads compressed frames from the
+        // specified 'source', starting at its current position.  Optionally
+        // specify a 'maxBlockSize' (in characters) of the largest block
+        // accepted; if 'maxBlockSize' is not specified,
+        // 'k_DEFAULT_MAX_BLOCK_SIZE' is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless 'source' remains valid for the lifetime of this
+        // object, and '0 < maxBlockSize <= k_MAX_BLOCK_SIZE'.
+
+    virtual ~LzDecompressingInStreamBuf();
+        // Destroy this stream buffer.
+
+    // MANIPULATORS
+    int seekToBlock(bsls::Types::Int64 offset);
+        // Position the source at the specified 'offset' relative to its
+        // position when this object was created, discard the characters
+        // remaining in the current block, and make this object valid.
+        // Return 0 on success, and a non-zero value (with this object
+        // unchanged) if the source does not support seeking to that offset.
+        // The behavior is undefined unless '0 <= offset'.  Note that if
+        // 'offset' is not the offset of a frame, the failure is detected (and
+        // this object becomes invalid) when the frame is read.
+
+    // ACCESSORS
+    bool isValid() const;
+        // Return 'true' if this object is valid, and 'false' if it has read
+        // an incomplete or malformed frame.
+
+    int maxBlockSize() const;
+        // Return the number of characters in the largest block accepted.
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this stream buffer to supply memory.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                      // --------------------------------
+                      // class LzDecompressingInStreamBuf
+                      // --------------------------------
+
+// ACCESSORS
+inline
+bool LzDecompressingInStreamBuf::isValid() const
+{
+    return d_isValid;
+}
+
+inline
+int LzDecompressingInStreamBuf::maxBlockSize() const
+{
+    return d_maxBlockSize;
+}
+
+inline
+bslma::Allocator *LzDecompressingInStreamBuf::allocator() const
+{
+    return d_allocator_p;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1095 @@
+// bdlsb_lzdecompressinginstreambuf.t.cpp                             -*-C++-*-
+#include <bdlsb_lzdecompressinginstreambuf.h>
+
+#include <bdlsb_lzcompressingoutstreambuf.h>
+
+#include <bdls_testutil.h>
+
+#include <bslx_streambufinstream.h>
+#include <bslx_streambufoutstream.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_istream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is an input stream buffer that reads compressed
+// frames from a source stream buffer and supplies the characters of the
+// blocks they hold.  The primary concerns are that the characters of a
+// stream written by 'bdlsb::LzCompressingOutStreamBuf' are supplied exactly
+// once and in order, through 'sgetc', 'sbumpc', and 'sgetn', that the end of
+// the source at a frame boundary ends the input cleanly, that an incomplete
+// or malformed frame is detected without reading or writing out of bounds,
+// and that 'seekToBlock' resumes decompression at a recorded frame.  We
+// produce the compressed streams with 'bdlsb::LzCompressingOutStreamBuf'.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] LzDecompressingInStreamBuf(streambuf *, Allocator *ba = 0);
+// [ 2] LzDecompressingInStreamBuf(streambuf *, int, Allocator *ba = 0);
+// [ 2] ~LzDecompressingInStreamBuf();
+//
+// MANIPULATORS
+// [ 3] int_type underflow();
+// [ 5] int seekToBlock(bsls::Types::Int64 offset);
+//
+// ACCESSORS
+// [ 4] bool isValid() const;
+// [ 2] int maxBlockSize() const;
+// [ 2] bslma::Allocator *allocator() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] MALFORMED INPUT
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: DECOMPRESSED VS. UNCOMPRESSED INPUT
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlsb::LzDecompressingInStreamBuf Obj;
+typedef bdlsb::LzCompressingOutStreamBuf  Writer;
+typedef bsls::Types::Int64                Int64;
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static unsigned int nextRandom(unsigned int *state)
+    // Advance the specified linear congruential generator 'state' and return
+    // its next 15-bit pseudo-random value.
+{
+    *state = *state * 1103515245 + 12345;
+    return (*state >> 16) & 0x7fff;
+}
+
+static bsl::string makeInput(int length, bool compressible, unsigned int seed)
+    // Return a string of the specified 'length' of characters generated from
+    // the specified 'seed', which is compressible text if the specified
+    // 'compressible' is 'true', and pseudo-random bytes otherwise.
+{
+    static const char *const WORDS[] = {
+        "IBM ", "142.10 ", "100;", "AAPL ", "98.35 ", "200;", "\n"
+    };
+
+    bsl::string result;
+    if (compressible) {
+        while (result.length() < static_cast<bsl::size_t>(length)) {
+            result.append(WORDS[nextRandom(&seed) % 7]);
+        }
+        result.resize(length);
+    }
+    else {
+        for (int i = 0; i < length; ++i) {
+            result.push_back(static_cast<char>(nextRandom(&seed)));
+        }
+    }
+    return result;
+}
+
+static bsl::string compress(const bsl::string&  input,
+                            int                 blockSize,
+                            bsl::vector<Int64> *offsets = 0)
+    // Return the compressed form of the specified 'input' written in blocks
+    // of the specified 'blockSize'.  Optionally specify 'offsets' to which
+    // the offset of each frame is loaded.
+{
+    bsl::stringbuf target;
+    {
+        Writer writer(&target, blockSize);
+        writer.sputn(input.data(), input.length());
+        writer.pubsync();
+
+        if (offsets) {
+            offsets->clear();
+            for (int i = 0; i < writer.numBlocks(); ++i) {
+                offsets->push_back(writer.blockOffset(i));
+            }
+        }
+    }
+    return target.str();
+}
+
+                          // ======================
+                          // class ArrayStreamBuf
+                          // ======================
+
+class ArrayStreamBuf : public bsl::streambuf {
+    // This class implements an input stream buffer over a caller-supplied
+    // array that supplies at most a specified number of characters per call
+    // to 'xsgetn', and that does not support seeking.
+
+    // DATA
+    int d_maxChunk;  // largest number of characters supplied per call
+
+  protected:
+    // PROTECTED MANIPULATORS
+    virtual bsl::streamsize xsgetn(char_type *buffer, bsl::streamsize n)
+        // Copy to the specified 'buffer' the next of at most the specified
+        // 'n' characters (and at most the maximum chunk size), and return
+        // the number copied.
+    {
+        bsl::streamsize available = egptr() - gptr();
+        if (available > n) {
+            available = n;
+        }
+        if (available > d_maxChunk) {
+            available = d_maxChunk;
+        }
+        bsl::memcpy(buffer, gptr(), static_cast<bsl::size_t>(available));
+        gbump(static_cast<int>(available));
+        return available;
+    }
+
+  public:
+    // CREATORS
+    ArrayStreamBuf(const char *data, bsl::size_t length, int maxChunk)
+        // Create a stream buffer supplying the specified 'length' characters
+        // at the specified 'data', at most the specified 'maxChunk' at a
+        // time.
+    : d_maxChunk(maxChunk)
+    {
+        char *begin = const_cast<char *>(data);
+        setg(begin, begin, begin + length);
+    }
+};
+
+static int decompressAll(bsl::string *output,
+                         Obj         *object,
+                         unsigned int seed)
+    // Append to the specified 'output' all the characters supplied by the
+    // specified 'object', read using a mixture of 'sgetc', 'sbumpc', and
+    // 'sgetn' chosen using the specified 'seed', and return the number of
+    // characters read.
+{
+    int numRead = 0;
+    for (;;) {
+        const unsigned int choice = nextRandom(&seed) % 4;
+
+        if (0 == choice) {
+            const Obj::int_type c = object->sgetc();
+            if (Obj::traits_type::eof() == c) {
+                break;
+            }
+            ASSERT(c == object->sbumpc());
+            output->push_back(Obj::traits_type::to_char_type(c));
+            ++numRead;
+        }
+        else {
+            char                  buffer[3000];
+            const bsl::streamsize n = 1 + nextRandom(&seed) % sizeof buffer;
+            const bsl::streamsize m = object->sgetn(buffer, n);
+            output->append(buffer, static_cast<bsl::size_t>(m));
+            numRead += static_cast<int>(m);
+            if (m < n) {
+                break;
+            }
+        }
+    }
+    return numRead;
+}
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage examples provided in the component header file
+        //:   compile, link, and run as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage examples from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Reading Compressed BDEX-Encoded Records
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we have an archive of market data ticks, written as shown in
+// {'bdlsb_lzcompressingoutstreambuf'|Example 1}:
+//..
+    bsl::stringbuf archive;
+
+    const char *const SYMBOLS[] = { "IBM", "AAPL", "MSFT", "GOOG" };
+
+    bsls::Types::Int64 offset;
+    {
+        bdlsb::LzCompressingOutStreamBuf compressor(&archive, 4096);
+        bslx::StreambufOutStream         out(&compressor, 20160101);
+
+        for (int i = 0; i < 10000; ++i) {
+            out.putString(bsl::string(SYMBOLS[i % 4]));
+            out.putInt32(14210 + i % 7);
+            out.putInt32(100 * (1 + i % 3));
+        }
+        out.flush();
+        ASSERT(out);
+
+        offset = compressor.blockOffset(5);
+    }
+//..
+// First, we create a decompressing stream buffer that reads from the archive,
+// and a 'bslx::StreambufInStream' that reads from it:
+//..
+    bdlsb::LzDecompressingInStreamBuf decompressor(&archive, 4096);
+    bslx::StreambufInStream           in(&decompressor);
+//..
+// Then, we read the ticks back, verifying their values:
+//..
+    for (int i = 0; i < 10000; ++i) {
+        bsl::string symbol;
+        int         price;
+        int         size;
+
+        in.getString(symbol);
+        in.getInt32(price);
+        in.getInt32(size);
+
+        ASSERT(in);
+        ASSERT(SYMBOLS[i % 4]    == symbol);
+        ASSERT(14210 + i % 7     == price);
+        ASSERT(100 * (1 + i % 3) == size);
+    }
+//..
+// Finally, we observe that the input is exhausted, and that the archive was
+// well-formed:
+//..
+    char c;
+    in.getInt8(c);
+    ASSERT(!in);
+    ASSERT(decompressor.isValid());
+//..
+//
+///Example 2: Resuming at a Recorded Block
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that, in the previous example, we want to resume reading the
+// archive at the block whose offset was recorded when it was written.  Note
+// that, since the ticks were written without regard to block boundaries, a
+// tick may span two blocks; a writer that needs to resume reading at a tick
+// flushes the stream after the tick that fills each block (see
+// {'bdlsb_lzcompressingoutstreambuf'|Blocks and Flushing}), or also records
+// the position of the first tick in each block.  Here, we verify only that
+// decompression resumes at the recorded block.
+//
+// First, we rewind the archive, and create a decompressing stream buffer that
+// reads from it:
+//..
+    archive.pubseekpos(0);
+
+    bdlsb::LzDecompressingInStreamBuf reader(&archive, 4096);
+
+    int rc = reader.seekToBlock(0);
+    ASSERT(0 == rc);
+//..
+// Then, we verify that the first block begins with the first tick (a string
+// of length 3 holding "IBM"):
+//..
+    ASSERT(3   == reader.sbumpc());
+    ASSERT('I' == reader.sbumpc());
+//..
+// Next, we move to the recorded block, and read a whole block of
+// decompressed characters from it:
+//..
+    rc = reader.seekToBlock(offset);
+    ASSERT(0 == rc);
+
+    char block[4096];
+    ASSERT(4096 == reader.sgetn(block, 4096));
+    ASSERT(reader.isValid());
+//..
+// Finally, we observe that an offset that does not refer to a frame is
+// detected when the frame is read:
+//..
+    rc = reader.seekToBlock(offset + 1);
+    ASSERT(0 == rc);
+    ASSERT(bsl::streambuf::traits_type::eof() == reader.sgetc());
+    ASSERT(!reader.isValid());
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'seekToBlock'
+        //
+        // Concerns:
+        //: 1 After 'seekToBlock' with the offset of a frame, the next
+        //:   character supplied is the first character of its block, and the
+        //:   following characters are those of the rest of the stream.
+        //:
+        //: 2 'seekToBlock' discards the rest of the current block, and makes
+        //:   an invalid object valid.
+        //:
+        //: 3 Offsets are relative to the position of the source when the
+        //:   object was created.
+        //:
+        //: 4 'seekToBlock' fails, with no effect, if the source does not
+        //:   support seeking.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Compress a stream preceded by a prefix, position the source
+        //:   after the prefix, and seek to each frame in a pseudo-random
+        //:   order, verifying the characters supplied.  (C-1..3)
+        //:
+        //: 2 Call 'seekToBlock' on an object whose source does not support
+        //:   seeking.  (C-4)
+        //:
+        //: 3 Verify that defensive checks are triggered for invalid
+        //:   arguments.  (C-5)
+        //
+        // Testing:
+        //   int seekToBlock(bsls::Types::Int64 offset);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'seekToBlock'" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        const int          BLOCK_SIZE = 500;
+        const bsl::string  INPUT      = makeInput(10000, true, 3);
+        bsl::vector<Int64> offsets;
+        const bsl::string  PREFIX("prefix");
+        const bsl::string  STREAM     = PREFIX + compress(INPUT,
+                                                          BLOCK_SIZE,
+                                                          &offsets);
+        const int          NUM_BLOCKS = static_cast<int>(offsets.size());
+
+        ASSERT(20 == NUM_BLOCKS);
+
+        {
+            bsl::stringbuf source(STREAM);
+            source.pubseekpos(PREFIX.length(), bsl::ios_base::in);
+
+            Obj mX(&source, BLOCK_SIZE, &oa);  const Obj& X = mX;
+
+            unsigned int state = 11;
+            for (int i = 0; i < 3 * NUM_BLOCKS; ++i) {
+                const int block = nextRandom(&state) % NUM_BLOCKS;
+
+                ASSERTV(i, 0 == mX.seekToBlock(offsets[block]));
+                ASSERTV(i, X.isValid());
+
+                const int n = nextRandom(&state) % 1200;
+                bsl::vector<char> buffer(n + 1);
+                const bsl::streamsize numRead = mX.sgetn(buffer.data(), n);
+                const int expected = bsl::min(n,
+                                              10000 - block * BLOCK_SIZE);
+
+                ASSERTV(i, block, n, numRead, expected == numRead);
+                ASSERTV(i, block, 0 == INPUT.compare(block * BLOCK_SIZE,
+                                                     numRead,
+                                                     buffer.data(),
+                                                     numRead));
+
+                // A seek to a position other than a frame makes the object
+                // invalid when the frame is read, and a seek to a frame makes
+                // it valid again.
+
+                if (0 == i % 7) {
+                    ASSERTV(i, 0 == mX.seekToBlock(offsets[block] + 3));
+                    ASSERTV(i, X.isValid());
+                    ASSERTV(i, Obj::traits_type::eof() == mX.sgetc());
+                    ASSERTV(i, !X.isValid());
+                }
+            }
+
+            // Seeking to the end of the stream ends the input cleanly.
+
+            ASSERT(0 == mX.seekToBlock(STREAM.length() - PREFIX.length()));
+            ASSERT(Obj::traits_type::eof() == mX.sgetc());
+            ASSERT(X.isValid());
+        }
+
+        if (verbose) cout << "\nSource not supporting seeking." << endl;
+        {
+            ArrayStreamBuf source(STREAM.data() + PREFIX.length(),
+                                  STREAM.length() - PREFIX.length(),
+                                  1 << 30);
+
+            Obj mX(&source, BLOCK_SIZE, &oa);  const Obj& X = mX;
+
+            ASSERT(INPUT[0] == mX.sbumpc());
+            ASSERT(0 != mX.seekToBlock(offsets[3]));
+            ASSERT(INPUT[1] == mX.sbumpc());
+            ASSERT(X.isValid());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            bsl::stringbuf source(STREAM);
+            Obj            mX(&source, BLOCK_SIZE, &oa);
+
+            ASSERT_FAIL(mX.seekToBlock(-1));
+            ASSERT_PASS(mX.seekToBlock(0));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // MALFORMED INPUT
+        //
+        // Concerns:
+        //: 1 A source that ends within a frame makes the object invalid,
+        //:   after the characters of the preceding blocks have been supplied.
+        //:
+        //: 2 A frame whose block exceeds the maximum block size, whose
+        //:   lengths are inconsistent, or whose payload does not decompress
+        //:   to the raw length, makes the object invalid.
+        //:
+        //: 3 An invalid object supplies no further characters.
+        //:
+        //: 4 No input, however corrupt, causes a read or write out of
+        //:   bounds.
+        //
+        // Plan:
+        //: 1 Decompress every prefix of a compressed stream, and verify the
+        //:   characters supplied and the validity of the object.  (C-1, 3)
+        //:
+        //: 2 Decompress hand-crafted frames.  (C-2)
+        //:
+        //: 3 Decompress streams with pseudo-randomly corrupted bytes, and
+        //:   verify that the characters supplied are a prefix of the
+        //:   original unless corruption within a payload goes undetected.
+        //:   (C-4)
+        //
+        // Testing:
+        //   MALFORMED INPUT
+        //   bool isValid() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MALFORMED INPUT" << endl
+                          << "===============" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        const int          BLOCK_SIZE = 100;
+        bsl::vector<Int64> offsets;
+        const bsl::string  INPUT  = makeInput(300, true, 4)
+                                  + makeInput(200, false, 5);
+        const bsl::string  STREAM = compress(INPUT, BLOCK_SIZE, &offsets);
+
+        ASSERT(5 == offsets.size());
+
+        if (verbose) cout << "\nTruncated streams." << endl;
+        {
+            for (bsl::size_t length = 0; length <= STREAM.length(); ++length) {
+                bsl::stringbuf source(STREAM.substr(0, length));
+                Obj            mX(&source, BLOCK_SIZE, &oa);
+                const Obj&     X = mX;
+
+                bsl::string output;
+                decompressAll(&output, &mX, static_cast<unsigned int>(length));
+
+                int numFrames = 0;
+                while (numFrames < 5
+                    && offsets[numFrames] < static_cast<Int64>(length)) {
+                    ++numFrames;
+                }
+                const bool atBoundary = length == STREAM.length()
+                                     || (numFrames < 5
+                                      && offsets[numFrames] ==
+                                                  static_cast<Int64>(length));
+                const int complete = atBoundary ? numFrames : numFrames - 1;
+
+                ASSERTV(length, atBoundary == X.isValid());
+                ASSERTV(length, output.length(),
+                        static_cast<bsl::size_t>(complete * BLOCK_SIZE) ==
+                                                             output.length());
+                ASSERTV(length, 0 == INPUT.compare(0,
+                                                   output.length(),
+                                                   output));
+                ASSERTV(length, Obj::traits_type::eof() == mX.sgetc());
+            }
+        }
+
+        if (verbose) cout << "\nHand-crafted frames." << endl;
+        {
+            static const struct {
+                int         d_line;      // source line number
+                const char *d_stream_p;  // compressed stream
+                int         d_length;    // length of 'd_stream_p'
+                int         d_expected;  // number of characters supplied
+                bool        d_isValid;   // expected validity at the end
+            } DATA[] = {
+                //LINE  STREAM                                LEN  EXP  VALID
+                //----  ------------------------------------  ---  ---  -----
+                { L_,   "",                                     0,   0,  1 },
+                { L_,   "\0\0\0\1" "\x80\0\0\1" "a",            9,   1,  1 },
+                { L_,   "\0\0\0\1" "\0\0\0\2" "\x10" "a",      10,   1,  1 },
+                { L_,   "\0\0\0\1" "\x80\0\0\1" "a" "\0",      10,   1,  0 },
+                { L_,   "\0\0\0\0" "\x80\0\0\0",                8,   0,  0 },
+                { L_,   "\0\0\0\2" "\x80\0\0\1" "a",            9,   0,  0 },
+                { L_,   "\0\0\0\1" "\0\0\0\0",                  8,   0,  0 },
+                { L_,   "\0\0\0\1" "\0\0\0\x20" "\x10" "a",    10,   0,  0 },
+                { L_,   "\0\0\0\2" "\0\0\0\2" "\x10" "a",      10,   0,  0 },
+                { L_,   "\0\0\0\1" "\0\0\0\2" "\x20" "a",      10,   0,  0 },
+                { L_,   "\0\0\0\x41" "\x80\0\0\x41" "a",        9,   0,  0 },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int         LINE     = DATA[ti].d_line;
+                const char       *STREAM   = DATA[ti].d_stream_p;
+                const int         LENGTH   = DATA[ti].d_length;
+                const bsl::size_t EXPECTED = DATA[ti].d_expected;
+                const bool        IS_VALID = DATA[ti].d_isValid;
+
+                bsl::stringbuf source(bsl::string(STREAM, LENGTH));
+                Obj            mX(&source, 64, &oa);  const Obj& X = mX;
+
+                bsl::string output;
+                decompressAll(&output, &mX, ti);
+
+                if (veryVerbose) { T_ P_(LINE) P(output.length()) }
+
+                ASSERTV(LINE, output.length(), EXPECTED == output.length());
+                ASSERTV(LINE, IS_VALID == X.isValid());
+            }
+        }
+
+        if (verbose) cout << "\nCorrupted streams." << endl;
+        {
+            unsigned int state = 17;
+
+            for (int i = 0; i < 3000; ++i) {
+                bsl::string stream(STREAM);
+                const int   numChanges = 1 + nextRandom(&state) % 3;
+                int         firstChange = static_cast<int>(stream.length());
+
+                for (int j = 0; j < numChanges; ++j) {
+                    const int index = nextRandom(&state) % stream.length();
+                    stream[index] = static_cast<char>(nextRandom(&state));
+                    firstChange = bsl::min(firstChange, index);
+                }
+
+                // Supply the stream from an exactly-sized heap buffer, a few
+                // characters at a time, so that a memory checker detects any
+                // read out of bounds.
+
+                char *data = new char[stream.length()];
+                bsl::memcpy(data, stream.data(), stream.length());
+                {
+                    ArrayStreamBuf source(data,
+                                          stream.length(),
+                                          1 + nextRandom(&state) % 50);
+                    Obj            mX(&source, BLOCK_SIZE, &oa);
+
+                    bsl::string output;
+                    decompressAll(&output, &mX, i);
+
+                    // The blocks of the frames that precede the first change
+                    // are supplied intact.
+
+                    int numIntact = 0;
+                    while (numIntact < 4
+                        && offsets[numIntact + 1] <= firstChange) {
+                        ++numIntact;
+                    }
+                    ASSERTV(i, output.length() >=
+                             static_cast<bsl::size_t>(numIntact * BLOCK_SIZE));
+                    ASSERTV(i, 0 == INPUT.compare(0,
+                                                  numIntact * BLOCK_SIZE,
+                                                  output,
+                                                  0,
+                                                  numIntact * BLOCK_SIZE));
+                    ASSERTV(i, output.length() <= 10 * INPUT.length());
+                }
+                delete [] data;
+            }
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'underflow'
+        //
+        // Concerns:
+        //: 1 Every character of a stream written by
+        //:   'bdlsb::LzCompressingOutStreamBuf' is supplied exactly once and
+        //:   in order, through any mixture of 'sgetc', 'sbumpc', and 'sgetn'.
+        //:
+        //: 2 Compressed and stored blocks, blocks shorter than the block
+        //:   size (written by 'pubsync'), and blocks of the maximum block
+        //:   size are supported.
+        //:
+        //: 3 The end of the source at a frame boundary ends the input, and
+        //:   leaves the object valid.
+        //:
+        //: 4 A source that supplies fewer characters than requested per call
+        //:   is supported.
+        //:
+        //: 5 No memory is allocated after construction.
+        //
+        // Plan:
+        //: 1 For a set of block sizes, compress compressible and
+        //:   incompressible inputs of various lengths, flushing at
+        //:   pseudo-random points, and decompress them with a pseudo-random
+        //:   mixture of reads, from sources that supply all or only some of
+        //:   the characters requested.  (C-1..5)
+        //
+        // Testing:
+        //   int_type underflow();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'underflow'" << endl
+                          << "===========" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        static const int BLOCK_SIZES[] = { 1, 7, 64, 1000, 65536 };
+        const int NUM_BLOCK_SIZES = static_cast<int>(sizeof BLOCK_SIZES
+                                                     / sizeof *BLOCK_SIZES);
+
+        static const int LENGTHS[] = { 0, 1, 6, 7, 8, 1000, 1001, 70000 };
+        const int NUM_LENGTHS = static_cast<int>(sizeof LENGTHS
+                                                 / sizeof *LENGTHS);
+
+        unsigned int state = 13;
+
+        for (int bi = 0; bi < NUM_BLOCK_SIZES; ++bi) {
+            const int BLOCK_SIZE = BLOCK_SIZES[bi];
+
+            for (int li = 0; li < NUM_LENGTHS; ++li) {
+                const int LENGTH = LENGTHS[li];
+
+                for (int ti = 0; ti < 4; ++ti) {
+                    const bsl::string INPUT = makeInput(LENGTH, ti & 1, li);
+
+                    // Write the stream, flushing at pseudo-random points if
+                    // 'ti & 2'.
+
+                    bsl::stringbuf target;
+                    {
+                        Writer writer(&target, BLOCK_SIZE);
+
+                        int written = 0;
+                        while (written < LENGTH) {
+                            int n = 1 + nextRandom(&state) % (3 * BLOCK_SIZE);
+                            if (n > LENGTH - written) {
+                                n = LENGTH - written;
+                            }
+                            writer.sputn(INPUT.data() + written, n);
+                            written += n;
+                            if (ti & 2) {
+                                writer.pubsync();
+                            }
+                        }
+                    }
+                    const bsl::string STREAM = target.str();
+
+                    if (veryVerbose) {
+                        T_ P_(BLOCK_SIZE) P_(LENGTH) P_(ti) P(STREAM.length())
+                    }
+
+                    for (int si = 0; si < 2; ++si) {
+                        ArrayStreamBuf source(STREAM.data(),
+                                              STREAM.length(),
+                                              si ? 3 : 1 << 30);
+
+                        Obj mX(&source, BLOCK_SIZE, &oa);  const Obj& X = mX;
+
+                        const Int64 numAllocations = oa.numAllocations();
+
+                        bsl::string output;
+                        decompressAll(&output, &mX, li * 4 + ti);
+
+                        ASSERTV(BLOCK_SIZE, LENGTH, ti, si, INPUT == output);
+                        ASSERTV(BLOCK_SIZE, LENGTH, ti, si, X.isValid());
+                        ASSERTV(BLOCK_SIZE, LENGTH, ti, si,
+                                Obj::traits_type::eof() == mX.sgetc());
+                        ASSERTV(BLOCK_SIZE, LENGTH, ti, si,
+                                numAllocations == oa.numAllocations());
+                    }
+                }
+            }
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\nMaximum block size." << endl;
+        {
+            const bsl::string INPUT  = makeInput(Obj::k_MAX_BLOCK_SIZE + 10,
+                                                 true,
+                                                 1);
+            const bsl::string STREAM = compress(INPUT, Obj::k_MAX_BLOCK_SIZE);
+
+            bsl::stringbuf source(STREAM);
+            Obj            mX(&source, Obj::k_MAX_BLOCK_SIZE, &oa);
+
+            bsl::string output;
+            decompressAll(&output, &mX, 1);
+            ASSERT(INPUT == output);
+            ASSERT(mX.isValid());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A newly constructed object has the specified (or default)
+        //:   maximum block size, and is valid.
+        //:
+        //: 2 The constructor obtains all of the buffers of the object in a
+        //:   single allocation from the specified allocator (or the default
+        //:   allocator), and the destructor releases it.
+        //:
+        //: 3 The constructor reads nothing from the source.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Construct objects with each constructor, with and without an
+        //:   allocator, and verify the accessors, the allocations, and the
+        //:   position of the source.  (C-1..3)
+        //:
+        //: 2 Verify that defensive checks are triggered for invalid
+        //:   arguments.  (C-4)
+        //
+        // Testing:
+        //   LzDecompressingInStreamBuf(streambuf *, Allocator *ba = 0);
+        //   LzDecompressingInStreamBuf(streambuf *, int, Allocator *ba = 0);
+        //   ~LzDecompressingInStreamBuf();
+        //   int maxBlockSize() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND BASIC ACCESSORS" << endl
+                          << "============================" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        ASSERT(bslma::UsesBslmaAllocator<Obj>::value);
+
+        const char DATA[] = "0123456789";
+
+        {
+            ArrayStreamBuf source(DATA, 10, 100);
+            {
+                Obj mX(&source);  const Obj& X = mX;
+
+                ASSERT(Obj::k_DEFAULT_MAX_BLOCK_SIZE == X.maxBlockSize());
+                ASSERT(&defaultAllocator == X.allocator());
+                ASSERT(1 == defaultAllocator.numBlocksInUse());
+                ASSERT(X.isValid());
+            }
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+            ASSERT(10 == source.in_avail());
+        }
+        {
+            ArrayStreamBuf source(DATA, 10, 100);
+            {
+                Obj mX(&source, &oa);  const Obj& X = mX;
+
+                ASSERT(Obj::k_DEFAULT_MAX_BLOCK_SIZE == X.maxBlockSize());
+                ASSERT(&oa == X.allocator());
+                ASSERT(1 == oa.numBlocksInUse());
+            }
+            ASSERT(0 == oa.numBlocksInUse());
+        }
+        {
+            static const int SIZES[] = { 1, 2, 100, 4096,
+                                         Obj::k_MAX_BLOCK_SIZE };
+            const int NUM_SIZES = static_cast<int>(sizeof SIZES
+                                                   / sizeof *SIZES);
+
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                ArrayStreamBuf source(DATA, 10, 100);
+                {
+                    Obj mX(&source, SIZES[i], &oa);  const Obj& X = mX;
+
+                    ASSERTV(i, SIZES[i] == X.maxBlockSize());
+                    ASSERTV(i, &oa == X.allocator());
+                    ASSERTV(i, 1 == oa.numBlocksInUse());
+                    ASSERTV(i, X.isValid());
+                }
+                ASSERTV(i, 0 == oa.numBlocksInUse());
+                ASSERTV(i, 10 == source.in_avail());
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            ArrayStreamBuf source(DATA, 10, 100);
+
+            ASSERT_FAIL(Obj(0, &oa));
+            ASSERT_PASS(Obj(&source, &oa));
+            ASSERT_FAIL(Obj(0, 16, &oa));
+            ASSERT_FAIL(Obj(&source, 0, &oa));
+            ASSERT_FAIL(Obj(&source, Obj::k_MAX_BLOCK_SIZE + 1, &oa));
+            ASSERT_PASS(Obj(&source, 1, &oa));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Compress repetitive text, and read it back through an
+        //:   'bsl::istream'.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        bsl::string text;
+        for (int i = 0; i < 100; ++i) {
+            text += "IBM 142.10 100\n";
+        }
+
+        bsl::stringbuf source(compress(text, 256));
+        ASSERT(source.str().length() < text.length() / 2);
+        {
+            Obj          mX(&source, 256, &oa);  const Obj& X = mX;
+            bsl::istream stream(&mX);
+
+            int         numLines = 0;
+            bsl::string line;
+            while (bsl::getline(stream, line)) {
+                ASSERTV(numLines, "IBM 142.10 100" == line);
+                ++numLines;
+            }
+            ASSERT(100 == numLines);
+            ASSERT(X.isValid());
+            ASSERT(1 == oa.numBlocksInUse());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: DECOMPRESSED VS. UNCOMPRESSED INPUT
+        //
+        // Concerns:
+        //: 1 Unexternalizing BDEX-encoded ticks through a decompressing
+        //:   stream buffer costs little more than reading them uncompressed.
+        //
+        // Plan:
+        //: 1 Externalize a large number of ticks with a
+        //:   'bslx::StreambufOutStream', uncompressed and compressed, and
+        //:   report the time to unexternalize them with a
+        //:   'bslx::StreambufInStream' directly and through an object.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: DECOMPRESSED VS. UNCOMPRESSED INPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: DECOMPRESSED VS. UNCOMPRESSED INPUT"
+                          << endl
+                          << "================================================"
+                          << endl;
+
+        const int NUM_TICKS = argc > 2 ? atoi(argv[2]) : 5000000;
+
+        static const char *const SYMBOLS[] = { "IBM", "AAPL", "MSFT", "GOOG" };
+
+        bslma::Allocator& newDeleteAllocator =
+                                        bslma::NewDeleteAllocator::singleton();
+        bslma::DefaultAllocatorGuard newDeleteGuard(&newDeleteAllocator);
+
+        bsl::stringbuf plain;
+        bsl::stringbuf compressed;
+        {
+            Writer                   writer(&compressed);
+            bslx::StreambufOutStream plainOut(&plain, 20160101);
+            bslx::StreambufOutStream compressedOut(&writer, 20160101);
+            unsigned int             state = 1;
+            int                      price = 14210;
+
+            for (int i = 0; i < NUM_TICKS; ++i) {
+                price += static_cast<int>(nextRandom(&state) % 5) - 2;
+                const int size = 100 * (1 + nextRandom(&state) % 8);
+
+                plainOut.putString(bsl::string(SYMBOLS[i % 4]));
+                plainOut.putInt32(price);
+                plainOut.putInt32(size);
+                compressedOut.putString(bsl::string(SYMBOLS[i % 4]));
+                compressedOut.putInt32(price);
+                compressedOut.putInt32(size);
+            }
+            compressedOut.flush();
+        }
+
+        cout << "uncompressed: " << plain.str().length() << " bytes, "
+             << "compressed: "   << compressed.str().length() << " bytes"
+             << endl;
+
+        for (int decompress = 0; decompress < 2; ++decompress) {
+            Obj             reader(decompress ? &compressed : &plain);
+            bsl::streambuf *sb = decompress
+                               ? static_cast<bsl::streambuf *>(&reader)
+                               : &plain;
+
+            bsls::Stopwatch timer;
+            timer.start();
+
+            bslx::StreambufInStream in(sb);
+            bsl::string             symbol;
+            int                     price;
+            int                     size;
+            Int64                   total = 0;
+
+            for (int i = 0; i < NUM_TICKS; ++i) {
+                in.getString(symbol);
+                in.getInt32(price);
+                in.getInt32(size);
+                total += size;
+            }
+            timer.stop();
+
+            ASSERT(in);
+            cout << (decompress ? "decompressed: " : "uncompressed: ")
+                 << timer.elapsedTime() << "s (" << total << ")" << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
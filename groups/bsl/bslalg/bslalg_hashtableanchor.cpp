@@ -9,12 +9,108 @@ BSLS_IDENT("$Id$ $CSID$")
 #include <bslalg_bidirectionalnode.h>         // for testing only
 #include <bslalg_hashtablebucket.h>           // for testing only
 
+#include <climits>                            // 'CHAR_BIT'
+
 namespace BloombergLP
 {
 
 namespace bslalg
 {
 
+                        // -----------------------------
+                        // class bslalg::HashTableAnchor
+                        // -----------------------------
+
+// PRIVATE MANIPULATORS
+void HashTableAnchor::computeBucketIndexParameters()
+{
+    typedef native_std::size_t size_t;
+
+    static const int k_NUM_BITS = static_cast<int>(sizeof(size_t) * CHAR_BIT);
+
+    const size_t size = d_bucketArraySize;
+
+    if (size < 2) {
+        // Every hash code is reduced to index 0 by multiplying by 0.
+
+        d_bucketIndexMultiplier = 0;
+        d_bucketIndexShift      = 0;
+        d_bucketIndexByDivision = false;
+        return;                                                       // RETURN
+    }
+
+    int log2Size = 0;
+    while (1 < (size >> log2Size)) {
+        ++log2Size;
+    }
+
+    if (e_MIXED_POWER_OF_TWO == d_bucketIndexPolicy) {
+        BSLS_ASSERT_SAFE(0 == (size & (size - 1)));
+
+        // Fibonacci hashing: the index is the high-order 'log2Size' bits of
+        // the product of the hash code and '2^k_NUM_BITS / phi', rounded to an
+        // odd integer.
+
+        d_bucketIndexMultiplier = 8 == sizeof(size_t)
+                                ? static_cast<size_t>(0x9E3779B97F4A7C15ULL)
+                                : static_cast<size_t>(0x9E3779B9UL);
+        d_bucketIndexShift      = k_NUM_BITS - log2Size;
+        d_bucketIndexByDivision = false;
+        return;                                                       // RETURN
+    }
+
+    // The quotient 'q' of a hash code 'h' and 'size' is computed as:
+    //..
+    //  m = multiplyHigh(h, d_bucketIndexMultiplier);
+    //  q = (((h - m) >> 1) + m) >> d_bucketIndexShift;
+    //..
+    // (see 'HashTableImpUtil::computeBucketIndex').  For a power of two, this
+    // is 'h >> log2Size' if the multiplier is 0.  Otherwise, the multiplier is
+    // '2^(k_NUM_BITS + 1 + log2Size) / size', rounded up, less
+    // '2^k_NUM_BITS', which fits in 'size_t' as
+    // '2^log2Size < size < 2^(log2Size + 1)'.
+
+    d_bucketIndexByDivision = true;
+
+    if (0 == (size & (size - 1))) {
+        d_bucketIndexMultiplier = 0;
+        d_bucketIndexShift      = log2Size - 1;
+        return;                                                       // RETURN
+    }
+
+    // Compute 'quotient' and 'remainder' of '2^(k_NUM_BITS + log2Size)' and
+    // 'size' by long division, one bit at a time.  The high-order word of the
+    // dividend, '2^log2Size', is less than 'size', as is 'remainder' at every
+    // step.
+
+    size_t quotient  = 0;
+    size_t remainder = static_cast<size_t>(1) << log2Size;
+
+    for (int i = 0; i < k_NUM_BITS; ++i) {
+        const bool carry = 0 != (remainder >> (k_NUM_BITS - 1));
+
+        remainder <<= 1;
+        quotient  <<= 1;
+        if (carry || remainder >= size) {
+            remainder -= size;
+            quotient  |= 1;
+        }
+    }
+
+    // Double the quotient, rounding up.  The doubled quotient exceeds
+    // '2^k_NUM_BITS', which is discarded by the (modular) arithmetic below.
+
+    const size_t twiceRemainder = remainder + remainder;
+
+    quotient += quotient;
+    if (twiceRemainder >= size || twiceRemainder < remainder) {
+        ++quotient;
+    }
+
+    d_bucketIndexMultiplier = quotient + 1;
+    d_bucketIndexShift      = log2Size;
+}
+
 }  // close namespace BloombergLP::bslalg
 }  // close namespace BloombergLP
 
@@ -53,6 +53,32 @@ BSLS_IDENT("$Id: $")
 //: o 'bucketArraySize': the number of (contiguous) buckets in the array of
 //:   buckets at 'bucketArrayAddress'
 //
+///Bucket Index Policy
+///-------------------
+// In addition to its attributes, a 'bslalg::HashTableAnchor' holds a
+// 'BucketIndexPolicy' describing how the hash code of an element is reduced to
+// the index of the bucket holding that element (see
+// 'bslalg::HashTableImpUtil::computeBucketIndex'):
+//
+//: o 'e_MODULO' (the default): the index is the hash code modulo
+//:   'bucketArraySize'.  This policy is appropriate for any hash function, and
+//:   disperses even weak hash codes well when 'bucketArraySize' is prime.
+//:
+//: o 'e_MIXED_POWER_OF_TWO': the index is the high-order bits of the product
+//:   of the hash code and a fixed, odd constant (derived from the golden
+//:   ratio).  The multiplication mixes the bits of weak hash codes (e.g., the
+//:   identity hash of an integer) before they are reduced.  'bucketArraySize'
+//:   must be a power of two.
+//
+// An anchor also caches, whenever its 'bucketArraySize' or policy changes, the
+// parameters of a multiply-and-shift reduction for its current bucket array
+// size.  For the 'e_MODULO' policy, these are a (rounded) fixed-point
+// reciprocal of 'bucketArraySize' (see "Division by Invariant Integers using
+// Multiplication", Granlund and Montgomery, 1994), so that the modulo can be
+// computed without a (comparatively slow) hardware division instruction.
+// Neither the policy nor the cached parameters contribute to the value of an
+// anchor.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -521,6 +547,41 @@ class HashTableAnchor {
                                                   // elements in the hash-table
                                                   // (held, not owned)
 
+    native_std::size_t   d_bucketIndexMultiplier; // precomputed multiplier
+                                                  // reducing a hash code to a
+                                                  // bucket index
+
+    int                  d_bucketIndexShift;      // precomputed shift reducing
+                                                  // a hash code to a bucket
+                                                  // index
+
+    bool                 d_bucketIndexByDivision; // 'true' if the multiplier
+                                                  // and shift compute a
+                                                  // quotient, and 'false' if
+                                                  // they compute the index
+
+    int                  d_bucketIndexPolicy;     // 'BucketIndexPolicy'
+
+  public:
+    // TYPES
+    enum BucketIndexPolicy {
+        // Enumerate the ways in which the hash code of an element is reduced
+        // to the index of the bucket holding it.
+
+        e_MODULO,              // 'hashCode % bucketArraySize()'
+
+        e_MIXED_POWER_OF_TWO   // high-order bits of 'hashCode' times an odd
+                               // constant; 'bucketArraySize()' must be a power
+                               // of two
+    };
+
+  private:
+    // PRIVATE MANIPULATORS
+    void computeBucketIndexParameters();
+        // Load into the cached bucket index parameters of this object the
+        // values implementing its bucket index policy for its bucket array
+        // size.
+
   public:
     // TRAITS
     BSLMF_NESTED_TRAIT_DECLARATION(HashTableAnchor,
@@ -532,10 +593,11 @@ class HashTableAnchor {
                     BidirectionalLink  *listRootAddress);
         // Create a 'bslalg::HashTableAnchor' object having the specified
         // 'bucketArrayAddress', 'bucketArraySize', and 'listRootAddress'
-        // attributes.  The behavior is undefined unless 'bucketArrayAddress'
-        // refers to a contiguous sequence of valid 'bslalg::HashTableBucket'
-        // objects of at least 'bucketArraySize' or unless both
-        // 'bucketArrayAddress' and 'bucketArraySize' are 0.
+        // attributes, and the 'e_MODULO' bucket index policy.  The behavior
+        // is undefined unless 'bucketArrayAddress' refers to a contiguous
+        // sequence of valid 'bslalg::HashTableBucket' objects of at least
+        // 'bucketArraySize' or unless both 'bucketArrayAddress' and
+        // 'bucketArraySize' are 0.
 
     HashTableAnchor(const HashTableAnchor& original);
         // Create a 'bslalg::HashTableAnchor' object having the same value
@@ -556,7 +618,16 @@ class HashTableAnchor {
         // 'bucketArraySize' values.  The behavior is undefined unless
         // 'bucketArrayAddress' refers to a contiguous sequence of valid
         // 'bslalg::HashTableBucket' objects of at least 'bucketArraySize', or
-        // unless both 'bucketArrayAddress' and 'bucketArraySize' are 0.
+        // unless both 'bucketArrayAddress' and 'bucketArraySize' are 0, and
+        // unless 'bucketArraySize' is 0 or a power of two if the bucket index
+        // policy of this object is 'e_MIXED_POWER_OF_TWO'.
+
+    void setBucketIndexPolicy(BucketIndexPolicy value);
+        // Set the bucket index policy of this object to the specified 'value'.
+        // The behavior is undefined unless 'bucketArraySize()' is 0 or a power
+        // of two if 'value' is 'e_MIXED_POWER_OF_TWO'.  Note that the policy
+        // should be set only when this object holds no elements, as the
+        // elements may otherwise be in the wrong buckets.
 
     void setListRootAddress(BidirectionalLink *value);
         // Set the 'listRootAddress' attribute of this object to the
@@ -579,6 +650,23 @@ class HashTableAnchor {
 
     BidirectionalLink *listRootAddress() const;
         // Return the value 'listRootAddress' attribute of this object.
+
+    BucketIndexPolicy bucketIndexPolicy() const;
+        // Return the bucket index policy of this object.
+
+    bool bucketIndexByDivision() const;
+        // Return 'true' if the cached bucket index parameters of this object
+        // compute the quotient of a hash code and 'bucketArraySize()', and
+        // 'false' if they compute the bucket index directly.  See
+        // 'bslalg::HashTableImpUtil::computeBucketIndex'.
+
+    native_std::size_t bucketIndexMultiplier() const;
+        // Return the cached multiplier used to reduce a hash code to a bucket
+        // index for the current bucket index policy and 'bucketArraySize()'.
+
+    int bucketIndexShift() const;
+        // Return the cached shift used to reduce a hash code to a bucket index
+        // for the current bucket index policy and 'bucketArraySize()'.
 };
 
 // FREE OPERATORS
@@ -619,10 +707,18 @@ HashTableAnchor::HashTableAnchor(bslalg::HashTableBucket   *bucketArrayAddress,
 : d_bucketArrayAddress_p(bucketArrayAddress)
 , d_bucketArraySize(bucketArraySize)
 , d_listRootAddress_p(listRootAddress)
+, d_bucketIndexMultiplier(0)
+, d_bucketIndexShift(0)
+, d_bucketIndexByDivision(false)
+, d_bucketIndexPolicy(e_MODULO)
 {
     BSLS_ASSERT_SAFE(   (!bucketArrayAddress && !bucketArraySize)
                      || (bucketArrayAddress && 0 < bucketArraySize));
     BSLS_ASSERT_SAFE(!listRootAddress || !(listRootAddress->previousLink()));
+
+    if (1 < bucketArraySize) {
+        computeBucketIndexParameters();
+    }
 }
 
 inline
@@ -630,6 +726,10 @@ HashTableAnchor::HashTableAnchor(const HashTableAnchor& original)
 : d_bucketArrayAddress_p(original.d_bucketArrayAddress_p)
 , d_bucketArraySize(original.d_bucketArraySize)
 , d_listRootAddress_p(original.d_listRootAddress_p)
+, d_bucketIndexMultiplier(original.d_bucketIndexMultiplier)
+, d_bucketIndexShift(original.d_bucketIndexShift)
+, d_bucketIndexByDivision(original.d_bucketIndexByDivision)
+, d_bucketIndexPolicy(original.d_bucketIndexPolicy)
 {
 }
 
@@ -637,9 +737,13 @@ HashTableAnchor::HashTableAnchor(const HashTableAnchor& original)
 inline
 HashTableAnchor& HashTableAnchor::operator=(const HashTableAnchor& rhs)
 {
-    d_bucketArrayAddress_p = rhs.d_bucketArrayAddress_p;
-    d_bucketArraySize      = rhs.d_bucketArraySize;
-    d_listRootAddress_p    = rhs.d_listRootAddress_p;
+    d_bucketArrayAddress_p  = rhs.d_bucketArrayAddress_p;
+    d_bucketArraySize       = rhs.d_bucketArraySize;
+    d_listRootAddress_p     = rhs.d_listRootAddress_p;
+    d_bucketIndexMultiplier = rhs.d_bucketIndexMultiplier;
+    d_bucketIndexShift      = rhs.d_bucketIndexShift;
+    d_bucketIndexByDivision = rhs.d_bucketIndexByDivision;
+    d_bucketIndexPolicy     = rhs.d_bucketIndexPolicy;
     return *this;
 }
 
@@ -650,9 +754,24 @@ void HashTableAnchor::setBucketArrayAddressAndSize(
 {
     BSLS_ASSERT_SAFE(( bucketArrayAddress && 0 < bucketArraySize)
                   || (!bucketArrayAddress &&    !bucketArraySize));
+    BSLS_ASSERT_SAFE(e_MIXED_POWER_OF_TWO != d_bucketIndexPolicy
+                  || 0 == (bucketArraySize & (bucketArraySize - 1)));
 
     d_bucketArrayAddress_p = bucketArrayAddress;
     d_bucketArraySize      = bucketArraySize;
+
+    computeBucketIndexParameters();
+}
+
+inline
+void HashTableAnchor::setBucketIndexPolicy(BucketIndexPolicy value)
+{
+    BSLS_ASSERT_SAFE(e_MIXED_POWER_OF_TWO != value
+                  || 0 == (d_bucketArraySize & (d_bucketArraySize - 1)));
+
+    d_bucketIndexPolicy = value;
+
+    computeBucketIndexParameters();
 }
 
 inline
@@ -690,6 +809,30 @@ HashTableBucket *HashTableAnchor::bucketArrayAddress() const
     return d_bucketArrayAddress_p;
 }
 
+inline
+HashTableAnchor::BucketIndexPolicy HashTableAnchor::bucketIndexPolicy() const
+{
+    return static_cast<BucketIndexPolicy>(d_bucketIndexPolicy);
+}
+
+inline
+bool HashTableAnchor::bucketIndexByDivision() const
+{
+    return d_bucketIndexByDivision;
+}
+
+inline
+native_std::size_t HashTableAnchor::bucketIndexMultiplier() const
+{
+    return d_bucketIndexMultiplier;
+}
+
+inline
+int HashTableAnchor::bucketIndexShift() const
+{
+    return d_bucketIndexShift;
+}
+
 }  // close namespace bslalg
 
 // FREE OPERATORS
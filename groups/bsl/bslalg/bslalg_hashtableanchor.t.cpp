@@ -92,12 +92,17 @@ using namespace BloombergLP;
 // [ 9] operator=(const HashTableAnchor& rhs);
 // [ 2] setBucketArrayAndSize(HashTableBucket *, size_t);
 // [ 2] setListRootAddress(BidirectionalLink *);
+// [11] setBucketIndexPolicy(BucketIndexPolicy);
 // [ 8] void swap(HashTableAnchor& other);
 //
 // ACCESSORS
 // [ 4] const HashTableBucket *bucketArrayAddress() const;
 // [ 4] size_t bucketArraySize() const;
 // [ 4] BidirectionalLink *listRootAddress() const;
+// [11] BucketIndexPolicy bucketIndexPolicy() const;
+// [11] bool bucketIndexByDivision() const;
+// [11] size_t bucketIndexMultiplier() const;
+// [11] int bucketIndexShift() const;
 //
 // FREE OPERATORS
 // [ 6] bool operator==(const HashTableAnchor& lhs, rhs);
@@ -107,7 +112,7 @@ using namespace BloombergLP;
 // [ 8] void swap(HashTableAnchor& a, b);
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [11] USAGE EXAMPLE
+// [12] USAGE EXAMPLE
 // [ *] CONCERN: This test driver is reusable w/other, similar components.
 // [ *] CONCERN: In no case does memory come from the global allocator.
 // [ 3] CONCERN: All creator/manipulator ptr./ref. parameters are 'const'.
@@ -569,7 +574,7 @@ int main(int argc, char *argv[])
     bslma::Default::setDefaultAllocator(&defaultAllocator);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 11: {
+      case 12: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -657,6 +662,210 @@ int main(int argc, char *argv[])
 
         ta.deallocate(pc);
       } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // BUCKET INDEX POLICY
+        //   Ensure that the bucket index policy can be set and observed, and
+        //   that the cached bucket index parameters track the policy and the
+        //   bucket array size.
+        //
+        // Concerns:
+        //: 1 The policy of an anchor created by the value constructor is
+        //:   'e_MODULO'.
+        //:
+        //: 2 'setBucketIndexPolicy' sets the policy, and the policy is
+        //:   unaffected by 'setBucketArrayAddressAndSize'.
+        //:
+        //: 3 The cached parameters are recomputed whenever the policy or the
+        //:   bucket array size changes, and reflect both.
+        //:
+        //: 4 The copy constructor and copy-assignment operator copy the policy
+        //:   and the cached parameters.
+        //:
+        //: 5 The policy does not contribute to the value of an anchor.
+        //:
+        //: 6 Setting a policy requiring a power-of-two number of buckets on an
+        //:   anchor having another number of buckets, or vice versa, is
+        //:   detected in appropriate build modes.
+        //
+        // Plan:
+        //: 1 Create an anchor with the value constructor and verify its
+        //:   policy.  (C-1)
+        //:
+        //: 2 For a set of bucket array sizes, set the size and each policy,
+        //:   in either order, and verify the policy and the cached
+        //:   parameters using the basic accessors.  (C-2..3)
+        //:
+        //: 3 Copy-construct and copy-assign anchors having each policy, and
+        //:   verify the policy and parameters of the copies, and that anchors
+        //:   differing only in policy compare equal.  (C-4..5)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid combinations of policy and size (using the
+        //:   'BSLS_ASSERTTEST_*' macros).  (C-6)
+        //
+        // Testing:
+        //   setBucketIndexPolicy(BucketIndexPolicy);
+        //   BucketIndexPolicy bucketIndexPolicy() const;
+        //   bool bucketIndexByDivision() const;
+        //   size_t bucketIndexMultiplier() const;
+        //   int bucketIndexShift() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("BUCKET INDEX POLICY\n"
+                            "===================\n");
+
+        typedef bslalg::HashTableAnchor Obj;
+
+        const int NUM_BITS = static_cast<int>(sizeof(size_t) * 8);
+
+        bslalg::HashTableBucket buckets[2];
+
+        if (verbose) printf("\nTesting the default policy.\n");
+        {
+            const Obj X(buckets, 2, 0);
+            ASSERT(Obj::e_MODULO == X.bucketIndexPolicy());
+
+            const Obj Y(0, 0, 0);
+            ASSERT(Obj::e_MODULO == Y.bucketIndexPolicy());
+        }
+
+        if (verbose) printf("\nTesting manipulators and accessors.\n");
+        {
+            static const struct {
+                int    d_line;       // source line number
+                size_t d_size;       // bucket array size
+                bool   d_division;   // expected 'e_MODULO' division flag
+                int    d_shift;      // expected 'e_MODULO' shift
+            } DATA[] = {
+                //LINE  SIZE  DIVISION  SHIFT
+                //----  ----  --------  -----
+                { L_,      0,    false,     0 },
+                { L_,      1,    false,     0 },
+                { L_,      2,     true,     0 },
+                { L_,      3,     true,     1 },
+                { L_,      4,     true,     1 },
+                { L_,      5,     true,     2 },
+                { L_,     13,     true,     3 },
+                { L_,     16,     true,     3 },
+                { L_,   1024,     true,     9 },
+                { L_,   1049,     true,    10 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int    LINE     = DATA[ti].d_line;
+                const size_t SIZE     = DATA[ti].d_size;
+                const bool   DIVISION = DATA[ti].d_division;
+                const int    SHIFT    = DATA[ti].d_shift;
+
+                const bool IS_POWER_OF_TWO = 0 == (SIZE & (SIZE - 1));
+
+                bslalg::HashTableBucket *const ADDRESS = SIZE ? buckets : 0;
+
+                if (veryVerbose) { T_ P_(LINE) P(SIZE) }
+
+                Obj mX(0, 0, 0);  const Obj& X = mX;
+
+                mX.setBucketArrayAddressAndSize(ADDRESS, SIZE);
+
+                ASSERTV(LINE, Obj::e_MODULO == X.bucketIndexPolicy());
+                ASSERTV(LINE, DIVISION == X.bucketIndexByDivision());
+                ASSERTV(LINE, SHIFT    == X.bucketIndexShift());
+
+                if (!IS_POWER_OF_TWO) {
+                    continue;
+                }
+
+                // Set the policy before, and after, the size.
+
+                Obj mY(0, 0, 0);  const Obj& Y = mY;
+
+                mY.setBucketIndexPolicy(Obj::e_MIXED_POWER_OF_TWO);
+                mX.setBucketIndexPolicy(Obj::e_MIXED_POWER_OF_TWO);
+
+                mY.setBucketArrayAddressAndSize(ADDRESS, SIZE);
+
+                int log2Size = 0;
+                while ((static_cast<size_t>(1) << log2Size) < SIZE) {
+                    ++log2Size;
+                }
+
+                const size_t EXP_MULTIPLIER = X.bucketIndexMultiplier();
+                const int    EXP_SHIFT      = SIZE < 2
+                                            ? 0
+                                            : NUM_BITS - log2Size;
+
+                ASSERTV(LINE, Obj::e_MIXED_POWER_OF_TWO ==
+                                                       X.bucketIndexPolicy());
+                ASSERTV(LINE, Obj::e_MIXED_POWER_OF_TWO ==
+                                                       Y.bucketIndexPolicy());
+                ASSERTV(LINE, !X.bucketIndexByDivision());
+                ASSERTV(LINE, !Y.bucketIndexByDivision());
+                ASSERTV(LINE, EXP_SHIFT      == X.bucketIndexShift());
+                ASSERTV(LINE, EXP_SHIFT      == Y.bucketIndexShift());
+                ASSERTV(LINE, EXP_MULTIPLIER == Y.bucketIndexMultiplier());
+                ASSERTV(LINE, SIZE < 2 ? 0 == EXP_MULTIPLIER
+                                       : 1 == (EXP_MULTIPLIER & 1));
+
+                mX.setBucketIndexPolicy(Obj::e_MODULO);
+
+                ASSERTV(LINE, Obj::e_MODULO == X.bucketIndexPolicy());
+                ASSERTV(LINE, DIVISION == X.bucketIndexByDivision());
+                ASSERTV(LINE, SHIFT    == X.bucketIndexShift());
+            }
+        }
+
+        if (verbose) printf("\nTesting copying and value.\n");
+        {
+            Obj mX(buckets, 2, 0);  const Obj& X = mX;
+            mX.setBucketIndexPolicy(Obj::e_MIXED_POWER_OF_TWO);
+
+            const Obj Y(buckets, 2, 0);
+
+            ASSERT(X == Y);
+            ASSERT(!(X != Y));
+
+            const Obj Z(X);
+            ASSERT(Obj::e_MIXED_POWER_OF_TWO == Z.bucketIndexPolicy());
+            ASSERT(X.bucketIndexMultiplier() == Z.bucketIndexMultiplier());
+            ASSERT(X.bucketIndexShift()      == Z.bucketIndexShift());
+            ASSERT(X.bucketIndexByDivision() == Z.bucketIndexByDivision());
+
+            Obj mW(Y);  const Obj& W = mW;
+            mW = X;
+            ASSERT(Obj::e_MIXED_POWER_OF_TWO == W.bucketIndexPolicy());
+            ASSERT(X.bucketIndexMultiplier() == W.bucketIndexMultiplier());
+            ASSERT(X.bucketIndexShift()      == W.bucketIndexShift());
+
+            mW = Y;
+            ASSERT(Obj::e_MODULO == W.bucketIndexPolicy());
+            ASSERT(Y.bucketIndexMultiplier() == W.bucketIndexMultiplier());
+            ASSERT(Y.bucketIndexShift()      == W.bucketIndexShift());
+            ASSERT(Y.bucketIndexByDivision() == W.bucketIndexByDivision());
+        }
+
+        if (verbose) printf("\nNegative Testing.\n");
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bslalg::HashTableBucket threeBuckets[3];
+
+            Obj mX(threeBuckets, 3, 0);
+
+            ASSERT_SAFE_FAIL(mX.setBucketIndexPolicy(
+                                                 Obj::e_MIXED_POWER_OF_TWO));
+            ASSERT_SAFE_PASS(mX.setBucketIndexPolicy(Obj::e_MODULO));
+
+            mX.setBucketArrayAddressAndSize(threeBuckets, 2);
+            ASSERT_SAFE_PASS(mX.setBucketIndexPolicy(
+                                                 Obj::e_MIXED_POWER_OF_TWO));
+
+            ASSERT_SAFE_FAIL(mX.setBucketArrayAddressAndSize(threeBuckets, 3));
+            ASSERT_SAFE_PASS(mX.setBucketArrayAddressAndSize(threeBuckets, 1));
+        }
+      } break;
       case 10: {
         // --------------------------------------------------------------------
         // BSLX STREAMING
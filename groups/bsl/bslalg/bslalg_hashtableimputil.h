@@ -66,13 +66,27 @@ BSLS_IDENT("$Id: $")
 // hash-table implementation must adjust the returned hash function so that it
 // falls in the valid range of bucket indices (typically either using an
 // integer division or modulo operation) -- we refer to this as the *adjusted*
-// *hash* *value*.  Note that currently 'HashTableImpUtil' adjusts the value
+// *hash* *value*.  Note that, by default, 'HashTableImpUtil' adjusts the value
 // returned by a supplied hash function using 'operator%' (modulo), which
 // is more resilient to pathological behaviors when used in conjunction with a
 // hash function that may produce contiguous hash values (with the 'div' method
 // lower order bits do not participate to the final adjusted value); however,
 // the means of adjustment may change in the future.
 //
+// The adjustment applied to the hash values of the elements of a hash table is
+// determined by the bucket index policy of its 'HashTableAnchor' (see
+// {'bslalg_hashtableanchor'|Bucket Index Policy}).  For the (default)
+// 'e_MODULO' policy, 'computeBucketIndex(hashCode, anchor)' returns
+// 'hashCode % anchor.bucketArraySize()', but computes it by multiplying by a
+// reciprocal of 'bucketArraySize' cached in the anchor, rather than by
+// executing a hardware division instruction, which typically has a latency
+// several times that of a multiplication.  For the 'e_MIXED_POWER_OF_TWO'
+// policy, 'computeBucketIndex(hashCode, anchor)' returns the high-order bits
+// of the product of 'hashCode' and an odd constant, which is cheaper still,
+// and which disperses hash values that differ only in their high-order bits
+// (e.g., the identity hash of an integer, or of an address) across the
+// buckets.
+//
 ///Well-Formed 'HashTableAnchor' Objects
 ///--------------------------------------
 // Many of the algorithms defined in this component operate on
@@ -93,8 +107,8 @@ BSLS_IDENT("$Id: $")
 //:
 //: 3 For each bucket, the range of nodes '[ bucket.first(), bucket.last() ]'
 //:   contains all nodes in the hash table for which
-//:   'computeBucketIndex(HASHER(extractKey(link)' is the index of the bucket,
-//:   and no other nodes.
+//:   'computeBucketIndex(HASHER(extractKey(link)), anchor)' is the index of
+//:   the bucket, and no other nodes.
 //
 ///'KEY_CONFIG' Template Parameter
 ///-------------------------------
@@ -546,11 +560,19 @@ BSLS_IDENT("$Id: $")
 #include <bsls_platform.h>
 #endif
 
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
 #ifndef INCLUDED_CSTDDEF
 #include <cstddef>
 #define INCLUDED_CSTDDEF
 #endif
 
+#if defined(BSLS_PLATFORM_CPU_X86_64) && defined(BSLS_PLATFORM_CMP_MSVC)
+#include <intrin.h>     // '__umulh'
+#endif
+
 namespace BloombergLP {
 namespace bslalg {
 
@@ -602,6 +624,11 @@ struct HashTableImpUtil {
     typedef native_std::size_t size_t;
 
     // PRIVATE CLASS METHODS
+    static native_std::size_t multiplyHigh(native_std::size_t lhs,
+                                           native_std::size_t rhs);
+        // Return the high-order half of the (double width) product of the
+        // specified 'lhs' and 'rhs'.
+
     static HashTableBucket *findBucketForHashCode(
                                               const HashTableAnchor& anchor,
                                               native_std::size_t     hashCode);
@@ -678,20 +705,34 @@ struct HashTableImpUtil {
                                                 native_std::size_t numBuckets);
         // Return the index of the bucket referring to the elements whose
         // adjusted hash codes are the same as the adjusted value of the
-        // specified 'hashCode', where 'hashCode' (and the
-        // hash-codes of the elements) are adjusted for the specified
-        // 'numBuckets'.  The behavior is undefined if 'numBuckets' is 0.
+        // specified 'hashCode', where 'hashCode' (and the hash-codes of the
+        // elements) are adjusted for the specified 'numBuckets' using the
+        // 'e_MODULO' bucket index policy (i.e., return
+        // 'hashCode % numBuckets').  The behavior is undefined if 'numBuckets'
+        // is 0.
+
+    static native_std::size_t computeBucketIndex(
+                                        native_std::size_t     hashCode,
+                                        const HashTableAnchor& anchor);
+        // Return the index of the bucket in the specified 'anchor' referring
+        // to the elements whose adjusted hash codes are the same as the
+        // adjusted value of the specified 'hashCode', where 'hashCode' (and
+        // the hash-codes of the elements) are adjusted according to the bucket
+        // index policy of 'anchor'.  The behavior is undefined if
+        // 'anchor.bucketArraySize()' is 0.  Note that, for the 'e_MODULO'
+        // policy, this function returns the same value as
+        // 'computeBucketIndex(hashCode, anchor.bucketArraySize())', but is
+        // typically faster.
 
     static void insertAtFrontOfBucket(HashTableAnchor    *anchor,
                                       BidirectionalLink  *link,
                                       native_std::size_t  hashCode);
         // Insert the specified 'link', having the specified (non-adjusted)
         // 'hashCode',  into the the specified 'anchor', at the front of the
-        // bucket with index
-        // 'computeBucketIndex(hashCode, anchor->bucketArraySize())'.  The
+        // bucket with index 'computeBucketIndex(hashCode, *anchor)'.  The
         // behavior is undefined unless 'anchor' is well-formed (see
-        // 'isWellFormed') for some combination of 'KEY_CONFIG' and
-        // 'HASHER' such that 'link' refers to a node of type
+        // 'isWellFormed') for some combination of 'KEY_CONFIG' and 'HASHER'
+        // such that 'link' refers to a node of type
         // 'BidirectionalNode<KEY_CONFIG::ValueType>' and
         // 'HASHER(extractKey<KEY_CONFIG>(link))' returns 'hashCode'.
 
@@ -700,9 +741,9 @@ struct HashTableImpUtil {
                                      native_std::size_t  hashCode);
         // Insert the specified 'link', having the specified (non-adjusted)
         // 'hashCode', into the the specified 'anchor', into the bucket with
-        // index 'computeBucketIndex(hashCode, anchor->bucketArraySize())',
-        // after the last node in the bucket.  The behavior is undefined unless
-        // 'anchor' is well-formed (see 'isWellFormed') for some combination of
+        // index 'computeBucketIndex(hashCode, *anchor)', after the last node
+        // in the bucket.  The behavior is undefined unless 'anchor' is
+        // well-formed (see 'isWellFormed') for some combination of
         // 'KEY_CONFIG' and 'HASHER' such that 'link' refers to a node of type
         // 'BidirectionalNode<KEY_CONFIG::ValueType>' and
         // 'HASHER(extractKey<KEY_CONFIG>(link))' returns 'hashCode'.
@@ -715,8 +756,8 @@ struct HashTableImpUtil {
         // 'hashCode', into the specified 'anchor' immediately before the
         // specified 'position' in the bi-directional linked list of 'anchor'.
         // The behavior is undefined unless position is in the bucket having
-        // index 'computeBucketIndex(hashCode, anchor->bucketArraySize())' and
-        // 'anchor' is well-formed (see 'isWellFormed') for some combination of
+        // index 'computeBucketIndex(hashCode, *anchor)' and 'anchor' is
+        // well-formed (see 'isWellFormed') for some combination of
         // 'KEY_CONFIG' and 'HASHER' such that 'link' refers to a node of type
         // 'BidirectionalNode<KEY_CONFIG::ValueType>' and
         // 'HASHER(extractKey<KEY_CONFIG>(link))' returns 'hashCode'.
@@ -775,6 +816,31 @@ struct HashTableImpUtil {
         // whose nodes are each of type
         // 'BidirectionalNode<KEY_CONFIG::ValueType>', the previous address of
         // the first node and the next address of the last node are 0.
+
+    template <class KEY_CONFIG, class HASHER>
+    static void rehashBucket(HashTableAnchor *newAnchor,
+                             HashTableBucket *bucket,
+                             const HASHER&    hasher);
+        // Index the elements in the specified 'bucket' of some (other) hash
+        // table into the buckets of the specified 'newAnchor', using the
+        // specified 'hasher' to determine the (non-adjusted) hash code for
+        // each element, reordering the elements within the range of 'bucket'
+        // so that the elements of each bucket of 'newAnchor' are contiguous,
+        // and update the last element of 'bucket' accordingly.  The elements
+        // of 'bucket' remain a contiguous range of the list holding them (so
+        // that the hash table holding 'bucket' remains well-formed), and the
+        // relative order of elements indexed into the same bucket of
+        // 'newAnchor' is preserved.  The list root address of 'newAnchor' is
+        // neither used nor changed.  If 'hasher' throws an exception, 'bucket'
+        // refers to the same elements, in an unspecified order, and the
+        // buckets of 'newAnchor' are in a valid, but unspecified, state.  The
+        // behavior is undefined unless 'newAnchor' has one or more buckets,
+        // and each bucket of 'newAnchor' into which an element of 'bucket' is
+        // indexed is initially empty.  Note that this function can be used to
+        // index the elements of a hash table into a new bucket array one
+        // bucket at a time if each bucket of the new array holds elements of
+        // at most one bucket of the original array (e.g., for the
+        // 'e_MIXED_POWER_OF_TWO' policy, if the new array is larger).
 };
 
 // ===========================================================================
@@ -786,6 +852,38 @@ struct HashTableImpUtil {
                         //-----------------------
 
 // PRIVATE CLASS METHODS
+inline
+native_std::size_t HashTableImpUtil::multiplyHigh(native_std::size_t lhs,
+                                                  native_std::size_t rhs)
+{
+#if defined(BSLS_PLATFORM_CPU_64_BIT)
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 Uint128;
+
+    return static_cast<size_t>((static_cast<Uint128>(lhs) * rhs) >> 64);
+#elif defined(BSLS_PLATFORM_CMP_MSVC) && defined(BSLS_PLATFORM_CPU_X86_64)
+    return __umulh(lhs, rhs);
+#else
+    const size_t lhsLow  = lhs & 0xFFFFFFFFu;
+    const size_t lhsHigh = lhs >> 32;
+    const size_t rhsLow  = rhs & 0xFFFFFFFFu;
+    const size_t rhsHigh = rhs >> 32;
+
+    const size_t lowLow   = lhsLow  * rhsLow;
+    const size_t lowHigh  = lhsLow  * rhsHigh;
+    const size_t highLow  = lhsHigh * rhsLow;
+    const size_t middle   = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFu)
+                                           + (highLow & 0xFFFFFFFFu);
+
+    return lhsHigh * rhsHigh + (lowHigh >> 32) + (highLow >> 32)
+                                               + (middle >> 32);
+#endif
+#else
+    return static_cast<size_t>(
+                       (static_cast<bsls::Types::Uint64>(lhs) * rhs) >> 32);
+#endif
+}
+
 inline
 HashTableBucket *HashTableImpUtil::findBucketForHashCode(
                                                const HashTableAnchor& anchor,
@@ -795,8 +893,8 @@ HashTableBucket *HashTableImpUtil::findBucketForHashCode(
     BSLS_ASSERT_SAFE(anchor.bucketArraySize());
 
     native_std::size_t bucketId = HashTableImpUtil::computeBucketIndex(
-                                                     hashCode,
-                                                     anchor.bucketArraySize());
+                                                                     hashCode,
+                                                                     anchor);
     return &(anchor.bucketArrayAddress()[bucketId]);
 }
 
@@ -810,6 +908,30 @@ native_std::size_t HashTableImpUtil::computeBucketIndex(
     return hashCode % numBuckets;
 }
 
+inline
+native_std::size_t HashTableImpUtil::computeBucketIndex(
+                                         native_std::size_t     hashCode,
+                                         const HashTableAnchor& anchor)
+{
+    BSLS_ASSERT_SAFE(0 != anchor.bucketArraySize());
+
+    const size_t multiplier = anchor.bucketIndexMultiplier();
+    const int    shift      = anchor.bucketIndexShift();
+
+    if (anchor.bucketIndexByDivision()) {
+        // Compute the quotient of 'hashCode' and 'bucketArraySize' (see
+        // 'HashTableAnchor::computeBucketIndexParameters'), and return the
+        // remainder.
+
+        const size_t high     = multiplyHigh(hashCode, multiplier);
+        const size_t quotient = (((hashCode - high) >> 1) + high) >> shift;
+
+        return hashCode - quotient * anchor.bucketArraySize();        // RETURN
+    }
+
+    return (hashCode * multiplier) >> shift;
+}
+
 inline
 bool HashTableImpUtil::bucketContainsLink(const HashTableBucket&   bucket,
                                           BidirectionalLink       *linkAddress)
@@ -957,6 +1079,57 @@ void HashTableImpUtil::rehash(HashTableAnchor   *newAnchor,
     }
 }
 
+template <class KEY_CONFIG, class HASHER>
+void HashTableImpUtil::rehashBucket(HashTableAnchor *newAnchor,
+                                    HashTableBucket *bucket,
+                                    const HASHER&    hasher)
+{
+    BSLS_ASSERT_SAFE(newAnchor);
+    BSLS_ASSERT_SAFE(0 != newAnchor->bucketArraySize());
+    BSLS_ASSERT_SAFE(bucket);
+
+    BidirectionalLink *cursor = bucket->first();
+    if (!cursor) {
+        return;                                                       // RETURN
+    }
+
+    // Visit each element of 'bucket' in order.  Every element preceding
+    // 'cursor' has been indexed, and the elements of each bucket of
+    // 'newAnchor' form a contiguous range of those elements, the last of
+    // which is 'last'.  An element is moved only to a position before
+    // 'cursor', so that 'bucket->last()' remains the last element of 'bucket'
+    // until it is visited (in case 'hasher' throws).
+
+    BidirectionalLink *const end  = bucket->last()->nextLink();
+    BidirectionalLink       *last = 0;
+
+    do {
+        BidirectionalLink *next   = cursor->nextLink();
+        HashTableBucket   *target = findBucketForHashCode(
+                                       *newAnchor,
+                                       hasher(extractKey<KEY_CONFIG>(cursor)));
+
+        if (!target->first()) {
+            target->setFirstAndLast(cursor, cursor);
+            last = cursor;
+        }
+        else if (target->last() == cursor->previousLink()) {
+            target->setLast(cursor);
+            last = cursor;
+        }
+        else {
+            BidirectionalLinkListUtil::unlink(cursor);
+            BidirectionalLinkListUtil::insertLinkAfterTarget(cursor,
+                                                             target->last());
+            target->setLast(cursor);
+        }
+
+        cursor = next;
+    } while (end != cursor);
+
+    bucket->setLast(last);
+}
+
 template <class KEY_CONFIG, class HASHER>
 bool HashTableImpUtil::isWellFormed(const HashTableAnchor&  anchor,
                                     const HASHER&           hasher,
@@ -994,7 +1167,7 @@ bool HashTableImpUtil::isWellFormed(const HashTableAnchor&  anchor,
     }
 
     size_t hash = hasher(extractKey<KEY_CONFIG>(root));
-    size_t bucketIdx = computeBucketIndex(hash, size);
+    size_t bucketIdx = computeBucketIndex(hash, anchor);
     if (array[bucketIdx].first() != root) {
         return false;                                                 // RETURN
     }
@@ -1009,7 +1182,7 @@ bool HashTableImpUtil::isWellFormed(const HashTableAnchor&  anchor,
         }
 
         hash      = hasher(extractKey<KEY_CONFIG>(cursor));
-        bucketIdx = computeBucketIndex(hash, size);
+        bucketIdx = computeBucketIndex(hash, anchor);
 
         if (bucketIdx != prevBucketIdx) {
             // New bucket
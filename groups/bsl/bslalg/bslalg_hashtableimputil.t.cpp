@@ -45,6 +45,7 @@ using namespace BloombergLP::bslalg;
 // ----------------------------------------------------------------------------
 // [  ] ...
 // ----------------------------------------------------------------------------
+// [11] rehashBucket(HashTableAnchor *a, Bucket *b, const HASHER& h);
 // [10] remove(HashTableAnchor *a, BidirectionalLink *l, size_t  h);
 // [10] bucketContainsLink(const Bucket& b, BidirectionalLink *l);
 // [ 9] find(const HashTableAnchor& a, KeyType& key, comparator, size_t h);
@@ -56,6 +57,7 @@ using namespace BloombergLP::bslalg;
 // [ 3] const KeyType& extractKey(const BidirectionalLink *link);
 // [ 3] typename ValueType& extractValue(BidirectionalLink *link);
 // [ 2] computeBucketIndex(size_t hashCode, size_t numBuckets);
+// [ 2] computeBucketIndex(size_t hashCode, const HashTableAnchor& a);
 // [ 1] BREATHING TEST
 // [  ] USAGE EXAMPLE
 
@@ -668,7 +670,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:
-      case 12: {
+      case 13: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -749,7 +751,7 @@ int main(int argc, char *argv[])
         ASSERT(0 == hs.count("chomp"));
 //..
       } break;
-      case 11: {
+      case 12: {
         // --------------------------------------------------------------------
         // ATTEMPTED USAGE EXAMPLE
         //
@@ -940,6 +942,152 @@ int main(int argc, char *argv[])
 
         IntNodeUtil::disposeList(anchor.listRootAddress(), &da);
       } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // TESTING 'rehashBucket'
+        //
+        // Concerns:
+        //: 1 'rehashBucket' indexes every element of a bucket into the
+        //:   buckets of a new anchor having twice as many buckets, each of
+        //:   which holds a contiguous range of elements.
+        //:
+        //: 2 The original bucket holds the same elements after the call, and
+        //:   the original anchor remains well-formed.
+        //:
+        //: 3 'rehashBucket' has no effect on an empty bucket.
+        //
+        // Plan:
+        //: 1 Populate a two-bucket anchor with interleaved elements whose
+        //:   hash codes map them to different buckets of a four-bucket
+        //:   anchor, call 'rehashBucket' for each bucket, and verify the
+        //:   contents of the buckets of both anchors after each call.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   rehashBucket(HashTableAnchor *a, Bucket *b, const HASHER& h);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("TESTING 'rehashBucket'\n"
+                            "======================\n");
+
+        bslma::TestAllocator da("defaultAllocator", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard defaultGuard(&da);
+
+        bslma::TestAllocator oa("objectAllocator", veryVeryVeryVerbose);
+
+        typedef BidirectionalNode<int> IntNode;
+        typedef TestSetKeyPolicy<int>  TestPolicy;
+        typedef NodeUtil<int>          IntNodeUtil;
+
+#define CREATE(octal) IntNode *node ## octal = IntNodeUtil::create(octal, &oa)
+
+        CREATE(000);
+        CREATE(010);
+        CREATE(002);
+        CREATE(012);
+        CREATE(020);
+        CREATE(022);
+
+        CREATE(001);
+        CREATE(011);
+
+#undef CREATE
+
+        Bucket buckets[2];
+        memset(buckets, 0, sizeof(buckets));
+
+        Bucket newBuckets[4];
+        memset(newBuckets, 0, sizeof(newBuckets));
+
+        Anchor anchor(buckets, 2, 0);
+        Anchor newAnchor(newBuckets, 4, 0);
+        Mod8Hasher hasher;
+
+        Obj::insertAtBackOfBucket(&anchor, node000, 0);
+        Obj::insertAtBackOfBucket(&anchor, node010, 0);
+        Obj::insertAtBackOfBucket(&anchor, node002, 2);
+        Obj::insertAtBackOfBucket(&anchor, node012, 2);
+        Obj::insertAtBackOfBucket(&anchor, node020, 0);
+        Obj::insertAtBackOfBucket(&anchor, node022, 2);
+
+        Obj::insertAtBackOfBucket(&anchor, node001, 1);
+        Obj::insertAtBackOfBucket(&anchor, node011, 1);
+
+        ASSERT(6 == buckets[0].countElements());
+        ASSERT(2 == buckets[1].countElements());
+        ASSERT((Obj::isWellFormed<TestPolicy>(anchor, hasher)));
+
+        Obj::rehashBucket<TestPolicy>(&newAnchor, &buckets[0], hasher);
+
+        ASSERT((Obj::isWellFormed<TestPolicy>(anchor, hasher)));
+        ASSERT(8 == countElements(anchor.listRootAddress()));
+
+        {
+            Link *matches[] = { node000, node010, node020,
+                                node002, node012, node022 };
+            ASSERT(buckets[0].countElements() == ARRAY_LENGTH(matches));
+            ASSERT(listMatches(buckets[0].first(), buckets[0].last(),
+                               matches, matches + ARRAY_LENGTH(matches)));
+        }
+
+        {
+            Link *matches[] = { node000, node010, node020 };
+            ASSERT(newBuckets[0].countElements() == ARRAY_LENGTH(matches));
+            ASSERT(listMatches(newBuckets[0].first(), newBuckets[0].last(),
+                               matches, matches + ARRAY_LENGTH(matches)));
+        }
+
+        {
+            Link *matches[] = { node002, node012, node022 };
+            ASSERT(newBuckets[2].countElements() == ARRAY_LENGTH(matches));
+            ASSERT(listMatches(newBuckets[2].first(), newBuckets[2].last(),
+                               matches, matches + ARRAY_LENGTH(matches)));
+        }
+
+        ASSERT(0 == newBuckets[1].countElements());
+        ASSERT(0 == newBuckets[3].countElements());
+
+        Obj::rehashBucket<TestPolicy>(&newAnchor, &buckets[1], hasher);
+
+        ASSERT((Obj::isWellFormed<TestPolicy>(anchor, hasher)));
+        ASSERT(2 == buckets[1].countElements());
+
+        {
+            Link *matches[] = { node001, node011 };
+            ASSERT(newBuckets[1].countElements() == ARRAY_LENGTH(matches));
+            ASSERT(listMatches(newBuckets[1].first(), newBuckets[1].last(),
+                               matches, matches + ARRAY_LENGTH(matches)));
+        }
+
+        ASSERT(0 == newBuckets[3].countElements());
+
+        newAnchor.setListRootAddress(anchor.listRootAddress());
+        ASSERT((Obj::isWellFormed<TestPolicy>(newAnchor, hasher)));
+
+        // An empty bucket is unaffected.
+
+        Bucket emptyBucket;
+        emptyBucket.reset();
+
+        Obj::rehashBucket<TestPolicy>(&newAnchor, &emptyBucket, hasher);
+        ASSERT(0 == emptyBucket.first());
+        ASSERT((Obj::isWellFormed<TestPolicy>(newAnchor, hasher)));
+
+#define DELETE(octal) oa.deallocate(node ## octal)
+
+        DELETE(000);
+        DELETE(010);
+        DELETE(002);
+        DELETE(012);
+        DELETE(020);
+        DELETE(022);
+
+        DELETE(001);
+        DELETE(011);
+
+#undef DELETE
+
+      } break;
       case 10: {
         // --------------------------------------------------------------------
         // TESTING 'remove' and 'bucketContainsLink'
@@ -2218,6 +2366,38 @@ int main(int argc, char *argv[])
       case 2: {
         // --------------------------------------------------------------------
         // TESTING ComputeBucketIndex
+        //
+        // Concerns:
+        //: 1 'computeBucketIndex(h, n)' returns 'h % n'.
+        //:
+        //: 2 For an anchor having the 'e_MODULO' policy,
+        //:   'computeBucketIndex(h, anchor)' returns
+        //:   'h % anchor.bucketArraySize()', for every bucket array size
+        //:   (prime, power of two, or otherwise) and every hash code,
+        //:   including the extreme values of 'size_t'.
+        //:
+        //: 3 For an anchor having the 'e_MIXED_POWER_OF_TWO' policy,
+        //:   'computeBucketIndex(h, anchor)' returns an index less than
+        //:   'anchor.bucketArraySize()', and consecutive hash codes are
+        //:   dispersed across the buckets.
+        //
+        // Plan:
+        //: 1 Compare the results of 'computeBucketIndex(h, n)' with a table of
+        //:   expected results.  (C-1)
+        //:
+        //: 2 For a set of bucket array sizes, including every prime used by
+        //:   'bslstl::HashTable', every power of two, and the extreme values
+        //:   of 'size_t', compare 'computeBucketIndex(h, anchor)' with
+        //:   'h % n' for a set of extreme and pseudo-random hash codes.  (C-2)
+        //:
+        //: 3 For every power of two 'n' up to 2^16, compute the bucket index
+        //:   of 'n' consecutive hash codes using the 'e_MIXED_POWER_OF_TWO'
+        //:   policy, and verify that each index is in range and that at least
+        //:   half the buckets are used.  (C-3)
+        //
+        // Testing:
+        //   computeBucketIndex(size_t hashCode, size_t numBuckets);
+        //   computeBucketIndex(size_t hashCode, const HashTableAnchor& a);
         // --------------------------------------------------------------------
 
         if (verbose) printf("TESTING ComputeBucketIndex\n"
@@ -2248,6 +2428,105 @@ int main(int argc, char *argv[])
             const size_t RESULT = Obj::computeBucketIndex(HASH_CODE,
                                                           NUM_BUCKETS);
             ASSERTV(LINE, RESULT, EXPECTED == RESULT);
+
+            Bucket bucket;
+            const HashTableAnchor ANCHOR(&bucket, NUM_BUCKETS, 0);
+
+            ASSERTV(LINE, EXPECTED == Obj::computeBucketIndex(HASH_CODE,
+                                                              ANCHOR));
+        }
+
+        if (verbose) printf("\nTesting the 'e_MODULO' policy of an anchor.\n");
+        {
+            const size_t MAX      = ~static_cast<size_t>(0);
+            const int    NUM_BITS = static_cast<int>(sizeof(size_t)
+                                                                  * CHAR_BIT);
+
+            const size_t SIZES[] = { 1, 2, 3, 5, 6, 7, 10, 11, 12, 13, 29, 61,
+                127, 257, 521, 1049, 2099, 4201, 8419, 16843, 33703, 67409,
+                134837, 269513, 539039, 1078081, 2156171, 5312353, 10624709,
+                21249443, 42498893, 84997793, 169995589, 339991181, 679982363,
+                1359964751, 2719929503u, 4294967295u, 641, 6700417,
+                MAX, MAX - 1, MAX / 2, MAX / 2 + 2, MAX / 3, MAX / 7 * 3 };
+            const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+            Bucket bucket;
+            HashTableAnchor anchor(0, 0, 0);
+
+            for (int ti = 0; ti < NUM_SIZES + NUM_BITS; ++ti) {
+                const size_t NUM_BUCKETS = ti < NUM_SIZES
+                                         ? SIZES[ti]
+                                         : static_cast<size_t>(1)
+                                                        << (ti - NUM_SIZES);
+
+                if (veryVerbose) { T_ P(NUM_BUCKETS) }
+
+                anchor.setBucketArrayAddressAndSize(&bucket, NUM_BUCKETS);
+
+                const size_t HASH_CODES[] = { 0, 1, 2, NUM_BUCKETS - 1,
+                    NUM_BUCKETS, NUM_BUCKETS + 1, NUM_BUCKETS * 2 - 1,
+                    MAX, MAX - 1, MAX / 2, MAX / 2 + 1, MAX - NUM_BUCKETS,
+                    MAX - MAX % NUM_BUCKETS, MAX - MAX % NUM_BUCKETS - 1 };
+                const int NUM_HASH_CODES = sizeof HASH_CODES
+                                         / sizeof *HASH_CODES;
+
+                for (int tj = 0; tj < NUM_HASH_CODES; ++tj) {
+                    const size_t HASH_CODE = HASH_CODES[tj];
+
+                    ASSERTV(NUM_BUCKETS, HASH_CODE,
+                            HASH_CODE % NUM_BUCKETS ==
+                                 Obj::computeBucketIndex(HASH_CODE, anchor));
+                }
+
+                size_t hashCode = NUM_BUCKETS;
+                for (int tj = 0; tj < 1000; ++tj) {
+                    // Use the 64-bit LCG of Knuth (truncated on 32-bit
+                    // platforms) to generate pseudo-random hash codes.
+
+                    hashCode = hashCode
+                             * static_cast<size_t>(6364136223846793005ULL)
+                             + static_cast<size_t>(1442695040888963407ULL);
+
+                    ASSERTV(NUM_BUCKETS, hashCode,
+                            hashCode % NUM_BUCKETS ==
+                                  Obj::computeBucketIndex(hashCode, anchor));
+                }
+            }
+        }
+
+        if (verbose) printf("\nTesting the 'e_MIXED_POWER_OF_TWO' policy.\n");
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+            const size_t MAX_NUM_BUCKETS = 1 << 16;
+
+            unsigned char *counts = static_cast<unsigned char *>(
+                                              oa.allocate(MAX_NUM_BUCKETS));
+
+            Bucket bucket;
+            HashTableAnchor anchor(0, 0, 0);
+            anchor.setBucketIndexPolicy(HashTableAnchor::e_MIXED_POWER_OF_TWO);
+
+            for (size_t numBuckets = 1; numBuckets <= MAX_NUM_BUCKETS;
+                                                             numBuckets *= 2) {
+                anchor.setBucketArrayAddressAndSize(&bucket, numBuckets);
+
+                memset(counts, 0, numBuckets);
+
+                size_t numUsed = 0;
+                for (size_t hashCode = 0; hashCode < numBuckets; ++hashCode) {
+                    const size_t INDEX = Obj::computeBucketIndex(hashCode,
+                                                                 anchor);
+                    ASSERTV(numBuckets, hashCode, INDEX, INDEX < numBuckets);
+
+                    if (INDEX < numBuckets && 0 == counts[INDEX]++) {
+                        ++numUsed;
+                    }
+                }
+                ASSERTV(numBuckets, numUsed, numBuckets <= 2 * numUsed);
+            }
+
+            oa.deallocate(counts);
         }
       } break;
       case 1: {
@@ -0,0 +1,353 @@
+// bslim_printbuffer.cpp                                              -*-C++-*-
+#include <bslim_printbuffer.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+
+#include <bsls_atomicoperations.h>
+
+#include <bsl_locale.h>
+
+#include <stdio.h>     // 'snprintf' [NOT '<cstdio>', which does not include
+                       // 'snprintf']
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#define snprintf _snprintf
+#endif
+
+namespace BloombergLP {
+namespace {
+
+typedef bsls::AtomicOperations AtomicOps;
+
+const int k_INITIAL_CAPACITY = 256;  // capacity of the first allocation of a
+                                     // growable buffer
+
+static AtomicOps::AtomicTypes::Int s_streamIndex = { -1 };
+    // index of the stream word holding the address of its 'PrintBuffer', or
+    // -1 if no 'PrintBuffer' has been created
+
+static const char k_DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+    // decimal representations of 0 to 99, two digits each
+
+static
+char *formatUnsigned(char *end, bsls::Types::Uint64 value)
+    // Write the decimal representation of the specified 'value' to the
+    // characters ending immediately before the specified 'end', and return
+    // the address of the first character written.  The behavior is undefined
+    // unless at least 20 characters precede 'end'.
+{
+    while (100 <= value) {
+        const int pair = static_cast<int>(value % 100) * 2;
+        value /= 100;
+        *--end = k_DIGIT_PAIRS[pair + 1];
+        *--end = k_DIGIT_PAIRS[pair];
+    }
+
+    if (10 <= value) {
+        const int pair = static_cast<int>(value) * 2;
+        *--end = k_DIGIT_PAIRS[pair + 1];
+        *--end = k_DIGIT_PAIRS[pair];
+    }
+    else {
+        *--end = static_cast<char>('0' + value);
+    }
+    return end;
+}
+
+static
+bool isNumberCharacter(char character)
+    // Return 'true' if the specified 'character' is one that the "%g"
+    // conversion of 'printf' writes irrespective of the global locale (i.e., a
+    // digit, a sign, or a letter of an exponent, "inf", or "nan"), and 'false'
+    // otherwise.  Note that the test does not use '<ctype.h>', whose
+    // classification depends on the global locale.
+{
+    return ('0' <= character && character <= '9')
+        || ('a' <= character && character <= 'z')
+        || ('A' <= character && character <= 'Z')
+        || '-' == character
+        || '+' == character;
+}
+
+static
+int normalizeRadix(char *buffer, int length)
+    // Replace, in the specified 'buffer' of the specified 'length' holding the
+    // output of the "%g" conversion of 'printf', the radix character of the
+    // global locale (which may be other than '.', and may comprise several
+    // bytes) by '.', and return the resulting length.
+{
+    for (int i = 0; i < length; ++i) {
+        if (isNumberCharacter(buffer[i])) {
+            continue;
+        }
+
+        int end = i + 1;
+        while (end < length && !isNumberCharacter(buffer[end])) {
+            ++end;
+        }
+
+        buffer[i] = '.';
+
+        const int removed = end - i - 1;
+        for (int j = end; j < length; ++j) {
+            buffer[j - removed] = buffer[j];
+        }
+        return length - removed;                                      // RETURN
+    }
+    return length;
+}
+
+}  // close unnamed namespace
+
+namespace bslim {
+
+                             // -----------------
+                             // class PrintBuffer
+                             // -----------------
+
+// PRIVATE CLASS METHODS
+int PrintBuffer::streamIndex()
+{
+    int index = AtomicOps::getIntAcquire(&s_streamIndex);
+
+    if (index < 0) {
+        // Two threads may each obtain an index; one of them is not used.
+
+        index = bsl::ios_base::xalloc();
+
+        const int previous = AtomicOps::testAndSwapIntAcqRel(&s_streamIndex,
+                                                             -1,
+                                                             index);
+        if (0 <= previous) {
+            index = previous;
+        }
+    }
+    return index;
+}
+
+// PRIVATE MANIPULATORS
+void PrintBuffer::appendRaw(const char *data, bsl::streamsize length)
+{
+    const bsl::streamsize available = epptr() - pptr();
+
+    if (available < length) {
+        if (d_allocator_p) {
+            const bsl::streamsize needed = (pptr() - pbase()) + length;
+            bsl::streamsize       newCapacity = capacity() * 2;
+
+            if (newCapacity < k_INITIAL_CAPACITY) {
+                newCapacity = k_INITIAL_CAPACITY;
+            }
+            if (newCapacity < needed) {
+                newCapacity = needed;
+            }
+            reserve(static_cast<int>(newCapacity));
+        }
+        else {
+            length        = available;
+            d_isTruncated = true;
+            d_stream.setstate(bsl::ios_base::badbit);
+        }
+    }
+
+    if (0 < length) {
+        bsl::memcpy(pptr(), data, static_cast<bsl::size_t>(length));
+        pbump(static_cast<int>(length));
+    }
+}
+
+void PrintBuffer::initialize()
+{
+    d_stream.pword(streamIndex()) = this;
+    d_stream.imbue(bsl::locale::classic());
+}
+
+// PROTECTED MANIPULATORS
+PrintBuffer::int_type PrintBuffer::overflow(int_type character)
+{
+    if (traits_type::eq_int_type(traits_type::eof(), character)) {
+        return traits_type::not_eof(character);                       // RETURN
+    }
+
+    if (pptr() == epptr() && !d_allocator_p) {
+        d_isTruncated = true;
+        return traits_type::eof();                                    // RETURN
+    }
+
+    const char_type value = traits_type::to_char_type(character);
+    appendRaw(&value, 1);
+
+    return character;
+}
+
+bsl::streamsize PrintBuffer::xsputn(const char_type *source,
+                                    bsl::streamsize  numChars)
+{
+    BSLS_ASSERT(0 <= numChars);
+    BSLS_ASSERT(source || 0 == numChars);
+
+    if (epptr() - pptr() < numChars && !d_allocator_p) {
+        // Let the stream set its own state.
+
+        const bsl::streamsize available = epptr() - pptr();
+
+        bsl::memcpy(pptr(), source, static_cast<bsl::size_t>(available));
+        pbump(static_cast<int>(available));
+        d_isTruncated = true;
+        return available;                                             // RETURN
+    }
+
+    appendRaw(source, numChars);
+    return numChars;
+}
+
+// CLASS METHODS
+PrintBuffer *PrintBuffer::fromStream(bsl::ostream& stream)
+{
+    const int index = AtomicOps::getIntAcquire(&s_streamIndex);
+
+    if (index < 0) {
+        return 0;                                                     // RETURN
+    }
+
+    // The word is copied by 'copyfmt', so verify that 'stream' writes to the
+    // buffer whose address it holds.
+
+    PrintBuffer *buffer = static_cast<PrintBuffer *>(stream.pword(index));
+
+    return buffer && static_cast<bsl::streambuf *>(buffer) == stream.rdbuf()
+           ? buffer
+           : 0;
+}
+
+// CREATORS
+PrintBuffer::PrintBuffer(bslma::Allocator *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_isTruncated(false)
+, d_stream(this)
+{
+    initialize();
+}
+
+PrintBuffer::PrintBuffer(char *buffer, int capacity)
+: d_allocator_p(0)
+, d_isTruncated(false)
+, d_stream(this)
+{
+    BSLS_ASSERT(buffer || 0 == capacity);
+    BSLS_ASSERT(0 <= capacity);
+
+    setp(buffer, buffer + capacity);
+    initialize();
+}
+
+PrintBuffer::~PrintBuffer()
+{
+    if (d_allocator_p && pbase()) {
+        d_allocator_p->deallocate(pbase());
+    }
+}
+
+// MANIPULATORS
+void PrintBuffer::appendFloatingPoint(double value, int precision)
+{
+    BSLS_ASSERT(0 <= precision);
+    BSLS_ASSERT(precision <= k_MAX_PRECISION);
+
+    char buffer[k_MAX_PRECISION + 32];
+
+    const int length = snprintf(buffer,
+                                sizeof buffer,
+                                "%.*g",
+                                precision,
+                                value);
+
+    // 'snprintf' writes the radix character of the global locale, whereas the
+    // stream, having the "C" locale, writes '.'.
+
+    append(buffer, normalizeRadix(buffer, length));
+}
+
+void PrintBuffer::appendInteger(bsls::Types::Int64 value)
+{
+    char  buffer[24];
+    char *end   = buffer + sizeof buffer;
+    char *begin = formatUnsigned(end,
+                                 value < 0
+                                 ? 0 - static_cast<bsls::Types::Uint64>(value)
+                                 : static_cast<bsls::Types::Uint64>(value));
+    if (value < 0) {
+        *--begin = '-';
+    }
+
+    append(begin, static_cast<int>(end - begin));
+}
+
+void PrintBuffer::appendUnsigned(bsls::Types::Uint64 value)
+{
+    char  buffer[24];
+    char *end   = buffer + sizeof buffer;
+    char *begin = formatUnsigned(end, value);
+
+    append(begin, static_cast<int>(end - begin));
+}
+
+void PrintBuffer::reserve(int capacity)
+{
+    BSLS_ASSERT(0 <= capacity);
+
+    if (!d_allocator_p || capacity <= this->capacity()) {
+        return;                                                       // RETURN
+    }
+
+    const int length = this->length();
+
+    char *newBuffer = static_cast<char *>(d_allocator_p->allocate(capacity));
+    if (pbase()) {
+        bsl::memcpy(newBuffer, pbase(), length);
+        d_allocator_p->deallocate(pbase());
+    }
+
+    setp(newBuffer, newBuffer + capacity);
+    pbump(length);
+}
+
+void PrintBuffer::reset()
+{
+    setp(pbase(), epptr());
+    d_isTruncated = false;
+    d_stream.clear();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
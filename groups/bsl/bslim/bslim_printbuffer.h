@@ -0,0 +1,480 @@
+// bslim_printbuffer.h                                                -*-C++-*-
+#ifndef INCLUDED_BSLIM_PRINTBUFFER
+#define INCLUDED_BSLIM_PRINTBUFFER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a character buffer, with a stream, for fast 'print' output.
+//
+//@CLASSES:
+//  bslim::PrintBuffer: fixed or growable output buffer with its own stream
+//
+//@SEE_ALSO: bslim_printer
+//
+//@DESCRIPTION: This component provides a mechanism, 'bslim::PrintBuffer',
+// that implements the output portion of the 'bsl::basic_streambuf' protocol
+// over a contiguous character buffer, and that owns a 'bsl::ostream' writing
+// to that buffer.  The buffer is either *fixed*, supplied (with its capacity)
+// at construction, in which case no memory is ever allocated and output that
+// does not fit is discarded, or *growable*, obtained from an allocator, and
+// enlarged geometrically as needed; a growable buffer that is 'reset' and
+// reused does not allocate once it has reached the size of its largest
+// output.
+//
+// The stream returned by 'stream' may be passed to any standard BDE 'print'
+// method, or to any 'operator<<', unchanged.  In addition, 'bslim::Printer'
+// recognizes the stream of a 'bslim::PrintBuffer' (see 'fromStream'), and then
+// writes its punctuation, indentation, and the values of fundamental types
+// directly to the buffer (using the 'append' methods), bypassing the
+// construction of a 'bsl::ostream::sentry', and the locale facets and virtual
+// functions used by formatted stream output.  Every type whose 'print' method
+// is implemented with 'bslim::Printer', and every standard container printed
+// with 'bslim::Printer', therefore benefits from a 'bslim::PrintBuffer'
+// without modification.
+//
+///Formatting
+///----------
+// The 'append' methods produce exactly the characters that the stream would
+// produce with its default format flags ('bsl::ios_base::dec' and
+// 'bsl::ios_base::skipws'), a width of 0, and the "C" locale.  The stream of
+// a 'bslim::PrintBuffer' is created with the "C" locale (regardless of the
+// global locale) and the default format flags; 'hasDefaultFormat' indicates
+// whether a client has since changed the flags or the width, in which case
+// 'bslim::Printer' formats values through the stream instead.  The behavior
+// is undefined if a locale other than the "C" locale is imbued in the stream.
+//
+///Fixed Buffers and Truncation
+///----------------------------
+// When output does not fit in a fixed buffer, as many characters as fit are
+// written, the rest are discarded, 'isTruncated' returns 'true', and
+// 'bsl::ios_base::badbit' is set on the stream, so that subsequent output,
+// through the stream, has no effect (standard BDE 'print' methods return
+// immediately when 'stream.bad()').
+//
+///Usage
+///-----
+// This section illustrates the intended use of this component.
+//
+///Example 1: Printing into a Fixed Buffer
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that a diagnostics endpoint formats the state of a service object
+// for each request, and that the formatted text is small and bounded.  We
+// can format it into a buffer on the stack, without any allocation.
+//
+// First, we define a type having a standard 'print' method:
+//..
+//  struct Quote {
+//      // This 'struct' holds a price quote.
+//
+//      // DATA
+//      const char *d_ticker;  // ticker symbol
+//      double      d_price;   // price
+//      int         d_size;    // number of shares
+//
+//      // ACCESSORS
+//      bsl::ostream& print(bsl::ostream& stream,
+//                          int           level = 0,
+//                          int           spacesPerLevel = 4) const
+//          // Write this quote to the specified 'stream' on a single line.
+//          // Ignore 'level' and 'spacesPerLevel' (for brevity).
+//      {
+//          (void)level;
+//          (void)spacesPerLevel;
+//
+//          return stream << "[ ticker = \"" << d_ticker
+//                        << "\" price = " << d_price
+//                        << " size = " << d_size << " ]";
+//      }
+//  };
+//..
+// Then, we create a 'bslim::PrintBuffer' over an array on the stack:
+//..
+//  char               storage[128];
+//  bslim::PrintBuffer buffer(storage, sizeof storage);
+//..
+// Next, we print a quote to the stream of the buffer:
+//..
+//  Quote quote = { "IBM", 107.25, 200 };
+//  quote.print(buffer.stream(), 0, -1);
+//..
+// Now, we examine the characters written:
+//..
+//  const char EXPECTED[] = "[ ticker = \"IBM\" price = 107.25 size = 200 ]";
+//
+//  assert(sizeof EXPECTED - 1 == buffer.length());
+//  assert(0 == bsl::memcmp(EXPECTED, buffer.data(), buffer.length()));
+//  assert(!buffer.isTruncated());
+//..
+// Finally, we observe that output that does not fit in a fixed buffer is
+// discarded:
+//..
+//  char               tiny[16];
+//  bslim::PrintBuffer tinyBuffer(tiny, sizeof tiny);
+//
+//  quote.print(tinyBuffer.stream(), 0, -1);
+//
+//  assert(16 == tinyBuffer.length());
+//  assert(tinyBuffer.isTruncated());
+//  assert(tinyBuffer.stream().bad());
+//..
+//
+///Example 2: Appending Numbers to a Reused Growable Buffer
+/// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we format many records, one at a time, as comma-separated
+// values.  A growable buffer that is reset before each record allocates only
+// until it has reached the size of the longest record, and the 'append'
+// methods format numbers without the overhead of formatted stream output.
+//
+// First, we create a growable buffer:
+//..
+//  bslim::PrintBuffer buffer;
+//  assert(buffer.isGrowable());
+//..
+// Then, we format each record, appending its fields to the buffer:
+//..
+//  for (int i = 0; i < 3; ++i) {
+//      buffer.reset();
+//
+//      buffer.append("IBM,");
+//      buffer.appendInteger(-100 * i);
+//      buffer.append(',');
+//      buffer.appendFloatingPoint(100.5 + i, 6);
+//..
+// Finally, we verify each record:
+//..
+//      char expected[32];
+//      int  length = sprintf(expected, "IBM,%d,%g", -100 * i, 100.5 + i);
+//
+//      assert(length == buffer.length());
+//      assert(0 == bsl::memcmp(expected, buffer.data(), length));
+//  }
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTRING
+#include <bsl_cstring.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOS
+#include <bsl_ios.h>
+#endif
+
+#ifndef INCLUDED_BSL_OSTREAM
+#include <bsl_ostream.h>
+#endif
+
+#ifndef INCLUDED_BSL_STREAMBUF
+#include <bsl_streambuf.h>
+#endif
+
+namespace BloombergLP {
+
+namespace bslma { class Allocator; }
+
+namespace bslim {
+
+                             // =================
+                             // class PrintBuffer
+                             // =================
+
+class PrintBuffer : public bsl::streambuf {
+    // This class implements the output functionality of the
+    // 'bsl::basic_streambuf' protocol over a fixed or growable contiguous
+    // buffer, provides a stream writing to that buffer, and provides methods
+    // that append characters and formatted numbers to the buffer directly.
+
+  public:
+    // TYPES
+    typedef bsl::streambuf::char_type   char_type;
+    typedef bsl::streambuf::int_type    int_type;
+    typedef bsl::streambuf::pos_type    pos_type;
+    typedef bsl::streambuf::off_type    off_type;
+    typedef bsl::streambuf::traits_type traits_type;
+
+    enum {
+        k_MAX_PRECISION = 50  // largest precision for 'appendFloatingPoint'
+    };
+
+  private:
+    // DATA
+    bslma::Allocator *d_allocator_p;  // memory allocator (held, not owned),
+                                      // or 0 if the buffer is fixed
+
+    bool              d_isTruncated;  // 'true' if output was discarded
+
+    bsl::ostream      d_stream;       // stream writing to this object
+
+  private:
+    // NOT IMPLEMENTED
+    PrintBuffer(const PrintBuffer&);
+    PrintBuffer& operator=(const PrintBuffer&);
+
+    // PRIVATE CLASS METHODS
+    static int streamIndex();
+        // Return the index, obtained from 'bsl::ios_base::xalloc', of the
+        // word in which the stream of each 'PrintBuffer' holds the address of
+        // its 'PrintBuffer'.
+
+    // PRIVATE MANIPULATORS
+    void appendRaw(const char *data, bsl::streamsize length);
+        // Append the specified 'length' characters at the specified 'data',
+        // growing the buffer if it is growable and too small, and otherwise
+        // appending as many characters as fit, and, if some do not, setting
+        // the truncation flag and 'bsl::ios_base::badbit' on the stream.
+
+    void initialize();
+        // Record the address of this object in its stream, and imbue the
+        // stream with the "C" locale.
+
+  protected:
+    // PROTECTED MANIPULATORS
+    virtual int_type overflow(int_type character = traits_type::eof());
+        // Append the specified 'character' to this buffer, growing it if it is
+        // growable.  Return 'character' on success, 'traits_type::eof()' if
+        // the buffer is fixed and full, and 'traits_type::not_eof(character)'
+        // with no other effect if 'character' is 'traits_type::eof()'.
+
+    virtual bsl::streamsize xsputn(const char_type *source,
+                                   bsl::streamsize  numChars);
+        // Append the specified 'numChars' characters from the specified
+        // 'source' to this buffer, growing it if it is growable, and return
+        // the number of characters appended.  The behavior is undefined
+        // unless '0 <= numChars'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(PrintBuffer, bslma::UsesBslmaAllocator);
+
+    // CLASS METHODS
+    static PrintBuffer *fromStream(bsl::ostream& stream);
+        // Return the address of the 'PrintBuffer' whose stream is the
+        // specified 'stream', or 0 if 'stream' is not the stream of a
+        // 'PrintBuffer'.
+
+    // CREATORS
+    explicit
+    PrintBuffer(bslma::Allocator *basicAllocator = 0);
+        // Create an empty, growable buffer.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  Note that no
+        // memory is allocated until the first character is written.
+
+    PrintBuffer(char *buffer, int capacity);
+        // Create an empty buffer that writes to the specified 'buffer' of the
+        // specified 'capacity', and never allocates memory.  The behavior is
+        // undefined unless '0 <= capacity', and 'buffer' has at least
+        // 'capacity' bytes and remains valid for the lifetime of this object.
+
+    virtual ~PrintBuffer();
+        // Destroy this object, releasing the memory of a growable buffer.
+
+    // MANIPULATORS
+    void append(char character);
+        // Append the specified 'character' to this buffer.
+
+    void append(const char *string);
+        // Append the characters of the specified null-terminated 'string'
+        // (without the null) to this buffer.
+
+    void append(const char *data, int length);
+        // Append the specified 'length' characters at the specified 'data' to
+        // this buffer.  The behavior is undefined unless '0 <= length'.
+
+    void appendFloatingPoint(double value, int precision);
+        // Append the representation of the specified 'value' having the
+        // specified 'precision' to this buffer, as 'stream() << value' does
+        // with the default format flags and 'precision' (i.e., as by the
+        // "%.*g" conversion of 'printf' in the "C" locale, whatever the
+        // global locale).  The behavior is undefined unless
+        // '0 <= precision <= k_MAX_PRECISION'.
+
+    void appendInteger(bsls::Types::Int64 value);
+        // Append the decimal representation of the specified 'value' to this
+        // buffer, as 'stream() << value' does with the default format.
+
+    void appendUnsigned(bsls::Types::Uint64 value);
+        // Append the decimal representation of the specified 'value' to this
+        // buffer, as 'stream() << value' does with the default format.
+
+    void reserve(int capacity);
+        // Make the capacity of this buffer at least the specified 'capacity'.
+        // This method has no effect if the buffer is fixed.  The behavior is
+        // undefined unless '0 <= capacity'.
+
+    void reset();
+        // Discard the characters written to this buffer, and reset the state
+        // of the stream to 'good', keeping the memory of a growable buffer.
+
+    bsl::ostream& stream();
+        // Return a reference providing modifiable access to the stream
+        // writing to this buffer.
+
+    // ACCESSORS
+    int capacity() const;
+        // Return the number of characters that this buffer can hold without
+        // growing (or, if it is fixed, without discarding output).
+
+    const char *data() const;
+        // Return the address of the first character written to this buffer.
+        // The characters are not null-terminated.  The returned address is
+        // invalidated by writing to a growable buffer.
+
+    bool hasDefaultFormat() const;
+        // Return 'true' if the stream of this buffer has the default format
+        // flags ('bsl::ios_base::dec' and 'bsl::ios_base::skipws') and a
+        // width of 0, and 'false' otherwise.  Note that, when this method
+        // returns 'true', the 'append' methods produce the same characters as
+        // formatted output to the stream.
+
+    bool isGrowable() const;
+        // Return 'true' if this buffer grows as needed, and 'false' if it is
+        // fixed.
+
+    bool isTruncated() const;
+        // Return 'true' if output to this buffer was discarded because it is
+        // fixed and was full, and 'false' otherwise.
+
+    int length() const;
+        // Return the number of characters written to this buffer.
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this buffer to supply memory, or 0 if
+        // the buffer is fixed.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                             // -----------------
+                             // class PrintBuffer
+                             // -----------------
+
+// MANIPULATORS
+inline
+void PrintBuffer::append(char character)
+{
+    if (pptr() != epptr()) {
+        *pptr() = character;
+        pbump(1);
+    }
+    else {
+        appendRaw(&character, 1);
+    }
+}
+
+inline
+void PrintBuffer::append(const char *string)
+{
+    BSLS_ASSERT_SAFE(string);
+
+    append(string, static_cast<int>(bsl::strlen(string)));
+}
+
+inline
+void PrintBuffer::append(const char *data, int length)
+{
+    BSLS_ASSERT_SAFE(data || 0 == length);
+    BSLS_ASSERT_SAFE(0 <= length);
+
+    if (epptr() - pptr() >= length) {
+        bsl::memcpy(pptr(), data, length);
+        pbump(length);
+    }
+    else {
+        appendRaw(data, length);
+    }
+}
+
+inline
+bsl::ostream& PrintBuffer::stream()
+{
+    return d_stream;
+}
+
+// ACCESSORS
+inline
+int PrintBuffer::capacity() const
+{
+    return static_cast<int>(epptr() - pbase());
+}
+
+inline
+const char *PrintBuffer::data() const
+{
+    return pbase();
+}
+
+inline
+bool PrintBuffer::hasDefaultFormat() const
+{
+    return (bsl::ios_base::dec | bsl::ios_base::skipws) == d_stream.flags()
+        && 0 == d_stream.width();
+}
+
+inline
+bool PrintBuffer::isGrowable() const
+{
+    return 0 != d_allocator_p;
+}
+
+inline
+bool PrintBuffer::isTruncated() const
+{
+    return d_isTruncated;
+}
+
+inline
+int PrintBuffer::length() const
+{
+    return static_cast<int>(pptr() - pbase());
+}
+
+inline
+bslma::Allocator *PrintBuffer::allocator() const
+{
+    return d_allocator_p;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1046 @@
+// bslim_printbuffer.t.cpp                                            -*-C++-*-
+
+#include <bslim_printbuffer.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_cstring.h>
+#include <bsl_iomanip.h>
+#include <bsl_iostream.h>
+#include <bsl_limits.h>
+#include <bsl_locale.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+#include <locale.h>    // 'setlocale'
+#include <stdio.h>     // 'sprintf'
+#include <stdlib.h>    // 'atoi'
+
+using namespace BloombergLP;
+using namespace bsl;
+using namespace bslim;
+
+//=============================================================================
+//                                 TEST PLAN
+//-----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// The component under test implements a stream buffer having a fixed or a
+// growable buffer, a stream writing to it, and methods that append characters
+// and numbers directly.  We verify that a growable buffer obtains its memory
+// from the intended allocator and reuses it after 'reset', that a fixed
+// buffer discards what does not fit and reports it, whether written through
+// the stream or the 'append' methods, and that the 'append' methods produce
+// exactly the characters produced by formatted output to a standard stream
+// with the default format.  Finally, we verify that 'fromStream' identifies
+// the stream of a 'PrintBuffer', and only that stream.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 6] static PrintBuffer *fromStream(bsl::ostream& stream);
+//
+// CREATORS
+// [ 2] explicit PrintBuffer(bslma::Allocator *basicAllocator = 0);
+// [ 3] PrintBuffer(char *buffer, int capacity);
+// [ 2] ~PrintBuffer();
+//
+// MANIPULATORS
+// [ 2] void append(char character);
+// [ 2] void append(const char *string);
+// [ 2] void append(const char *data, int length);
+// [ 5] void appendFloatingPoint(double value, int precision);
+// [ 4] void appendInteger(bsls::Types::Int64 value);
+// [ 4] void appendUnsigned(bsls::Types::Uint64 value);
+// [ 2] void reserve(int capacity);
+// [ 2] void reset();
+// [ 2] bsl::ostream& stream();
+//
+// ACCESSORS
+// [ 2] int capacity() const;
+// [ 2] const char *data() const;
+// [ 6] bool hasDefaultFormat() const;
+// [ 2] bool isGrowable() const;
+// [ 3] bool isTruncated() const;
+// [ 2] int length() const;
+// [ 2] bslma::Allocator *allocator() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] USAGE EXAMPLE
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        bsl::cout << "Error " << __FILE__ << "(" << i << "): " << s
+                  << "    (failed)" << bsl::endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+#define ASSERT(X) { aSsErT(!(X), #X, __LINE__); }
+
+//=============================================================================
+//                  STANDARD BDE LOOP-ASSERT TEST MACROS
+//-----------------------------------------------------------------------------
+
+#define LOOP_ASSERT(I,X) { \
+    if (!(X)) { bsl::cout << #I << ": " << I << "\n"; \
+                aSsErT(1, #X, __LINE__); }}
+
+#define LOOP2_ASSERT(I,J,X) { \
+    if (!(X)) { bsl::cout << #I << ": " << I << "\t"  \
+                          << #J << ": " << J << "\n"; \
+                aSsErT(1, #X, __LINE__); } }
+
+#define LOOP3_ASSERT(I,J,K,X) { \
+   if (!(X)) { bsl::cout << #I << ": " << I << "\t" \
+                         << #J << ": " << J << "\t" \
+                         << #K << ": " << K << "\n";\
+               aSsErT(1, #X, __LINE__); } }
+
+//=============================================================================
+//                  SEMI-STANDARD TEST OUTPUT MACROS
+//-----------------------------------------------------------------------------
+
+#define P(X) bsl::cout << #X " = " << (X) << bsl::endl;
+                                              // Print identifier and value.
+#define Q(X) bsl::cout << "<| " #X " |>" << bsl::endl;
+                                              // Quote identifier literally.
+#define P_(X) bsl::cout << #X " = " << (X) << ", " << bsl::flush;
+                                              // P(X) without '\n'
+#define L_ __LINE__                           // current Line number
+#define NL "\n"
+#define T_ cout << '\t' << flush;
+
+//=============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+//-----------------------------------------------------------------------------
+
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef PrintBuffer         Obj;
+typedef bsls::Types::Int64  Int64;
+typedef bsls::Types::Uint64 Uint64;
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static
+bsl::string contents(const Obj& object)
+    // Return the characters written to the specified 'object'.
+{
+    return bsl::string(object.data(), object.length());
+}
+
+static
+const char *setCommaRadixNumericLocale()
+    // Set the 'LC_NUMERIC' category of the global locale to one of a set of
+    // locales whose radix character is ',', and return its name, or return 0
+    // (leaving the global locale unchanged) if none is available.
+{
+    static const char *const NAMES[] = {
+        "de_DE.UTF-8",
+        "de_DE.utf8",
+        "de_DE",
+        "fr_FR.UTF-8",
+        "fr_FR.utf8",
+        "fr_FR",
+        "German_Germany.1252",
+    };
+    const int NUM_NAMES = static_cast<int>(sizeof NAMES / sizeof *NAMES);
+
+    for (int i = 0; i < NUM_NAMES; ++i) {
+        if (setlocale(LC_NUMERIC, NAMES[i])) {
+            return NAMES[i];                                          // RETURN
+        }
+    }
+    return 0;
+}
+
+//=============================================================================
+//                              USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates the intended use of this component.
+//
+///Example 1: Printing into a Fixed Buffer
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that a diagnostics endpoint formats the state of a service object
+// for each request, and that the formatted text is small and bounded.  We
+// can format it into a buffer on the stack, without any allocation.
+//
+// First, we define a type having a standard 'print' method:
+//..
+struct Quote {
+    // This 'struct' holds a price quote.
+
+    // DATA
+    const char *d_ticker;  // ticker symbol
+    double      d_price;   // price
+    int         d_size;    // number of shares
+
+    // ACCESSORS
+    bsl::ostream& print(bsl::ostream& stream,
+                        int           level = 0,
+                        int           spacesPerLevel = 4) const
+        // Write this quote to the specified 'stream' on a single line.
+        // Ignore 'level' and 'spacesPerLevel' (for brevity).
+    {
+        (void)level;
+        (void)spacesPerLevel;
+
+        return stream << "[ ticker = \"" << d_ticker
+                      << "\" price = " << d_price
+                      << " size = " << d_size << " ]";
+    }
+};
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int             verbose = argc > 2;
+    int         veryVerbose = argc > 3;
+
+    bsl::cout << "TEST " << __FILE__ << " CASE " << test << bsl::endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVerbose);
+    bslma::Default::setDefaultAllocatorRaw(&defaultAllocator);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "USAGE EXAMPLE" << endl
+                                  << "=============" << endl;
+
+        {
+// Then, we create a 'bslim::PrintBuffer' over an array on the stack:
+//..
+    char               storage[128];
+    bslim::PrintBuffer buffer(storage, sizeof storage);
+//..
+// Next, we print a quote to the stream of the buffer:
+//..
+    Quote quote = { "IBM", 107.25, 200 };
+    quote.print(buffer.stream(), 0, -1);
+//..
+// Now, we examine the characters written:
+//..
+    const char EXPECTED[] = "[ ticker = \"IBM\" price = 107.25 size = 200 ]";
+
+    ASSERT(sizeof EXPECTED - 1 == buffer.length());
+    ASSERT(0 == bsl::memcmp(EXPECTED, buffer.data(), buffer.length()));
+    ASSERT(!buffer.isTruncated());
+//..
+// Finally, we observe that output that does not fit in a fixed buffer is
+// discarded:
+//..
+    char               tiny[16];
+    bslim::PrintBuffer tinyBuffer(tiny, sizeof tiny);
+
+    quote.print(tinyBuffer.stream(), 0, -1);
+
+    ASSERT(16 == tinyBuffer.length());
+    ASSERT(tinyBuffer.isTruncated());
+    ASSERT(tinyBuffer.stream().bad());
+//..
+        }
+
+        {
+//
+///Example 2: Appending Numbers to a Reused Growable Buffer
+/// - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we format many records, one at a time, as comma-separated
+// values.  A growable buffer that is reset before each record allocates only
+// until it has reached the size of the longest record, and the 'append'
+// methods format numbers without the overhead of formatted stream output.
+//
+// First, we create a growable buffer:
+//..
+    bslim::PrintBuffer buffer;
+    ASSERT(buffer.isGrowable());
+//..
+// Then, we format each record, appending its fields to the buffer:
+//..
+    for (int i = 0; i < 3; ++i) {
+        buffer.reset();
+
+        buffer.append("IBM,");
+        buffer.appendInteger(-100 * i);
+        buffer.append(',');
+        buffer.appendFloatingPoint(100.5 + i, 6);
+//..
+// Finally, we verify each record:
+//..
+        char expected[32];
+        int  length = sprintf(expected, "IBM,%d,%g", -100 * i, 100.5 + i);
+
+        ASSERT(length == buffer.length());
+        ASSERT(0 == bsl::memcmp(expected, buffer.data(), length));
+    }
+//..
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // 'fromStream' AND 'hasDefaultFormat'
+        //
+        // Concerns:
+        //: 1 'fromStream' returns the address of the object whose stream is
+        //:   passed.
+        //:
+        //: 2 'fromStream' returns 0 for a stream that is not the stream of a
+        //:   'PrintBuffer', including a stream whose format (and hence
+        //:   extensible words) was copied, with 'copyfmt', from the stream of
+        //:   a 'PrintBuffer', unless it writes to that 'PrintBuffer'.
+        //:
+        //: 3 'hasDefaultFormat' is 'true' for a new object, and 'false' once
+        //:   the format flags or the width of its stream are changed.
+        //:
+        //: 4 The width of the stream is reset by formatted output, after
+        //:   which 'hasDefaultFormat' is 'true' again.
+        //:
+        //: 5 The stream of an object uses the "C" locale.
+        //
+        // Plan:
+        //: 1 Call 'fromStream' with the streams of several objects, with a
+        //:   string stream, and with streams whose format was copied from
+        //:   that of an object.  (C-1..2)
+        //:
+        //: 2 Change the format flags and the width of the stream of an object
+        //:   and check 'hasDefaultFormat' after each change.  (C-3..4)
+        //:
+        //: 3 Compare the locale of the stream with the "C" locale.  (C-5)
+        //
+        // Testing:
+        //   static PrintBuffer *fromStream(bsl::ostream& stream);
+        //   bool hasDefaultFormat() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'fromStream' AND 'hasDefaultFormat'"
+                          << endl << "===================================="
+                          << endl;
+
+        if (verbose) cout << "\nTesting 'fromStream'." << endl;
+        {
+            char       storage[16];
+            Obj        mX(storage, sizeof storage);
+            Obj        mY;
+            const Obj& X = mX;
+            const Obj& Y = mY;
+
+            ASSERT(&X == Obj::fromStream(mX.stream()));
+            ASSERT(&Y == Obj::fromStream(mY.stream()));
+
+            ostringstream other;
+            ASSERT(0 == Obj::fromStream(other));
+
+            other.copyfmt(mX.stream());
+            ASSERT(0 == Obj::fromStream(other));
+
+            ostream sameTarget(&mX);
+            ASSERT(0 == Obj::fromStream(sameTarget));
+
+            sameTarget.copyfmt(mX.stream());
+            ASSERT(&X == Obj::fromStream(sameTarget));
+        }
+
+        if (verbose) cout << "\nTesting 'hasDefaultFormat'." << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(X.hasDefaultFormat());
+
+            mX.stream() << hex;
+            ASSERT(!X.hasDefaultFormat());
+
+            mX.stream() << dec;
+            ASSERT(X.hasDefaultFormat());
+
+            mX.stream() << showpos;
+            ASSERT(!X.hasDefaultFormat());
+
+            mX.stream() << noshowpos;
+            ASSERT(X.hasDefaultFormat());
+
+            mX.stream() << setw(5);
+            ASSERT(!X.hasDefaultFormat());
+
+            mX.stream() << 7;
+            ASSERT(X.hasDefaultFormat());
+            LOOP_ASSERT(contents(X), "    7" == contents(X));
+
+            mX.stream().precision(3);
+            ASSERT(X.hasDefaultFormat());
+        }
+
+        if (verbose) cout << "\nTesting the locale." << endl;
+        {
+            Obj mX;
+
+            ASSERT(bsl::locale::classic() == mX.stream().getloc());
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'appendFloatingPoint'
+        //
+        // Concerns:
+        //: 1 'appendFloatingPoint' appends the characters that formatted
+        //:   output of the same value to a stream, with the default format
+        //:   flags and the same precision, produces.
+        //:
+        //: 2 Every precision from 0 to 'k_MAX_PRECISION' is supported.
+        //:
+        //: 3 The radix character is '.', as written by the stream (having the
+        //:   "C" locale), whatever the global locale.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, for a set of values having
+        //:   various magnitudes and signs, and for a set of precisions,
+        //:   compare the output of 'appendFloatingPoint' with that of an
+        //:   'ostringstream'.  (C-1..2)
+        //:
+        //: 2 Set the 'LC_NUMERIC' category of the global locale to a locale
+        //:   whose radix character is ',' (if one is available), repeat P-1,
+        //:   and restore the global locale.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid precisions.  (C-4)
+        //
+        // Testing:
+        //   void appendFloatingPoint(double value, int precision);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'appendFloatingPoint'" << endl
+                                  << "=====================" << endl;
+
+        static const double VALUES[] = {
+            0.0,
+            -0.0,
+            1.0,
+            -1.0,
+            0.1,
+            0.5,
+            1.0 / 3,
+            -2.0 / 3,
+            107.25,
+            123456789.0,
+            1e21,
+            -1e-5,
+            1.5e-300,
+            1.7976931348623157e308,
+            numeric_limits<double>::min(),
+            numeric_limits<double>::epsilon(),
+            static_cast<double>(numeric_limits<float>::max()),
+        };
+        const int NUM_VALUES = static_cast<int>(sizeof VALUES
+                                                / sizeof *VALUES);
+
+        static const int PRECISIONS[] = {
+            0, 1, 2, 6, 9, 15, 17, 25, Obj::k_MAX_PRECISION
+        };
+        const int NUM_PRECISIONS = static_cast<int>(sizeof PRECISIONS
+                                                    / sizeof *PRECISIONS);
+
+        Obj mX;  const Obj& X = mX;
+
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            const double VALUE = VALUES[i];
+
+            for (int j = 0; j < NUM_PRECISIONS; ++j) {
+                const int PRECISION = PRECISIONS[j];
+
+                ostringstream expected;
+                expected.imbue(locale::classic());
+                expected.precision(PRECISION);
+                expected << VALUE;
+
+                mX.reset();
+                mX.appendFloatingPoint(VALUE, PRECISION);
+
+                if (veryVerbose) {
+                    T_ P_(PRECISION) P_(expected.str()) P(contents(X))
+                }
+                LOOP3_ASSERT(i,
+                             PRECISION,
+                             contents(X),
+                             expected.str() == contents(X));
+            }
+        }
+
+        if (verbose) cout << "\nWith a ',' radix in the global locale."
+                          << endl;
+        {
+            const string SAVED(setlocale(LC_NUMERIC, 0));
+
+            const char *NAME = setCommaRadixNumericLocale();
+
+            if (verbose) {
+                cout << "\tlocale: " << (NAME ? NAME : "(none available)")
+                     << endl;
+            }
+
+            if (NAME) {
+                char native[32];
+                sprintf(native, "%g", 1.5);
+                LOOP2_ASSERT(NAME, native, 0 == strcmp("1,5", native));
+
+                mX.reset();
+                mX.appendFloatingPoint(1.5, 6);
+                LOOP2_ASSERT(NAME, contents(X), "1.5" == contents(X));
+
+                for (int i = 0; i < NUM_VALUES; ++i) {
+                    const double VALUE = VALUES[i];
+
+                    for (int j = 0; j < NUM_PRECISIONS; ++j) {
+                        const int PRECISION = PRECISIONS[j];
+
+                        ostringstream expected;
+                        expected.imbue(locale::classic());
+                        expected.precision(PRECISION);
+                        expected << VALUE;
+
+                        mX.reset();
+                        mX.appendFloatingPoint(VALUE, PRECISION);
+
+                        LOOP3_ASSERT(i,
+                                     PRECISION,
+                                     contents(X),
+                                     expected.str() == contents(X));
+                    }
+                }
+
+                setlocale(LC_NUMERIC, SAVED.c_str());
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(mX.appendFloatingPoint(1.0, 0));
+            ASSERT_FAIL(mX.appendFloatingPoint(1.0, -1));
+            ASSERT_PASS(mX.appendFloatingPoint(1.0, Obj::k_MAX_PRECISION));
+            ASSERT_FAIL(mX.appendFloatingPoint(1.0,
+                                               Obj::k_MAX_PRECISION + 1));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'appendInteger' AND 'appendUnsigned'
+        //
+        // Concerns:
+        //: 1 'appendInteger' and 'appendUnsigned' append the characters that
+        //:   formatted output of the same value to a stream with the default
+        //:   format produces.
+        //:
+        //: 2 Values having every number of digits, and the extreme values of
+        //:   each type, are formatted correctly.
+        //
+        // Plan:
+        //: 1 For every power of 10, and the values adjacent to it, that can
+        //:   be represented, and for the extreme values of each type, compare
+        //:   the output of each method with that of an 'ostringstream'.
+        //:   (C-1..2)
+        //
+        // Testing:
+        //   void appendInteger(bsls::Types::Int64 value);
+        //   void appendUnsigned(bsls::Types::Uint64 value);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'appendInteger' AND 'appendUnsigned'"
+                          << endl << "===================================="
+                          << endl;
+
+        Obj mX;  const Obj& X = mX;
+
+        if (verbose) cout << "\nTesting 'appendInteger'." << endl;
+        {
+            const Int64 MIN = numeric_limits<Int64>::min();
+            const Int64 MAX = numeric_limits<Int64>::max();
+
+            vector<Int64> values;
+            values.push_back(0);
+            values.push_back(MIN);
+            values.push_back(MIN + 1);
+            values.push_back(MAX);
+            values.push_back(MAX - 1);
+            values.push_back(numeric_limits<int>::min());
+            values.push_back(numeric_limits<int>::max());
+
+            for (Int64 power = 1; power <= MAX / 10; power *= 10) {
+                values.push_back(power - 1);
+                values.push_back(power);
+                values.push_back(power + 1);
+                values.push_back(-power);
+                values.push_back(1 - power);
+            }
+
+            for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+                const Int64 VALUE = values[i];
+
+                ostringstream expected;
+                expected << VALUE;
+
+                mX.reset();
+                mX.appendInteger(VALUE);
+
+                if (veryVerbose) { T_ P_(VALUE) P(contents(X)) }
+                LOOP2_ASSERT(VALUE,
+                             contents(X),
+                             expected.str() == contents(X));
+            }
+        }
+
+        if (verbose) cout << "\nTesting 'appendUnsigned'." << endl;
+        {
+            const Uint64 MAX = numeric_limits<Uint64>::max();
+
+            vector<Uint64> values;
+            values.push_back(0);
+            values.push_back(MAX);
+            values.push_back(MAX - 1);
+            values.push_back(numeric_limits<unsigned int>::max());
+
+            for (Uint64 power = 1; power <= MAX / 10; power *= 10) {
+                values.push_back(power - 1);
+                values.push_back(power);
+                values.push_back(power + 1);
+            }
+
+            for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+                const Uint64 VALUE = values[i];
+
+                ostringstream expected;
+                expected << VALUE;
+
+                mX.reset();
+                mX.appendUnsigned(VALUE);
+
+                if (veryVerbose) { T_ P_(VALUE) P(contents(X)) }
+                LOOP2_ASSERT(VALUE,
+                             contents(X),
+                             expected.str() == contents(X));
+            }
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // FIXED BUFFER
+        //
+        // Concerns:
+        //: 1 A fixed buffer writes to the supplied memory, and never
+        //:   allocates.
+        //:
+        //: 2 Output that fits is written unchanged, whether through the
+        //:   stream or the 'append' methods, and the object is not truncated.
+        //:
+        //: 3 Output that does not fit is written in part, up to the capacity,
+        //:   after which 'isTruncated' is 'true' and the stream is bad, and
+        //:   further output has no effect.
+        //:
+        //: 4 'reset' discards the output, clears the truncation flag, and
+        //:   makes the stream good.
+        //:
+        //: 5 A buffer having a capacity of 0 is supported.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each capacity from 0 to 12, write a string of 8 characters
+        //:   and a number, first through the stream and then through the
+        //:   'append' methods, and verify the contents of the buffer, the
+        //:   truncation flag, and the state of the stream.  (C-1..3, 5)
+        //:
+        //: 2 Reset the object after each write, and verify its state.  (C-4)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-6)
+        //
+        // Testing:
+        //   PrintBuffer(char *buffer, int capacity);
+        //   bool isTruncated() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "FIXED BUFFER" << endl
+                                  << "============" << endl;
+
+        const bsl::string FULL("abcdefgh123");
+
+        for (int capacity = 0; capacity <= 12; ++capacity) {
+            char storage[16];
+            memset(storage, '#', sizeof storage);
+
+            Obj mX(storage, capacity);  const Obj& X = mX;
+
+            ASSERT(!X.isGrowable());
+            ASSERT(0 == X.allocator());
+            ASSERT(storage == X.data());
+            ASSERT(capacity == X.capacity());
+
+            const int  LENGTH    = capacity < 11 ? capacity : 11;
+            const bool TRUNCATED = capacity < 11;
+
+            for (int pass = 0; pass < 2; ++pass) {
+                if (0 == pass) {
+                    mX.stream() << "abcdefgh" << 123;
+                }
+                else {
+                    mX.append("abcdef");
+                    mX.append("ghX", 2);
+                    mX.appendInteger(1);
+                    mX.append('2');
+                    mX.appendUnsigned(3);
+                }
+
+                if (veryVerbose) { T_ P_(capacity) P_(pass) P(contents(X)) }
+
+                LOOP2_ASSERT(capacity, pass, LENGTH == X.length());
+                LOOP2_ASSERT(capacity, pass, FULL.substr(0, LENGTH)
+                                                             == contents(X));
+                LOOP2_ASSERT(capacity, pass, TRUNCATED == X.isTruncated());
+                LOOP2_ASSERT(capacity, pass,
+                             TRUNCATED == mX.stream().bad());
+                LOOP2_ASSERT(capacity, pass, '#' == storage[capacity]);
+
+                if (TRUNCATED) {
+                    // Output after truncation has no effect.
+
+                    mX.stream() << "xyz";
+                    mX.append('x');
+                    LOOP2_ASSERT(capacity, pass, LENGTH == X.length());
+                }
+
+                mX.reset();
+
+                LOOP2_ASSERT(capacity, pass, 0 == X.length());
+                LOOP2_ASSERT(capacity, pass, !X.isTruncated());
+                LOOP2_ASSERT(capacity, pass, mX.stream().good());
+                LOOP2_ASSERT(capacity, pass, capacity == X.capacity());
+            }
+        }
+
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            char storage[4];
+
+            ASSERT_PASS(Obj(storage, 4));
+            ASSERT_PASS(Obj(0, 0));
+            ASSERT_FAIL(Obj(0, 4));
+            ASSERT_FAIL(Obj(storage, -1));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // GROWABLE BUFFER
+        //
+        // Concerns:
+        //: 1 A growable buffer obtains its memory from the allocator supplied
+        //:   at construction, or from the default allocator if none is.
+        //:
+        //: 2 No memory is allocated until the first character is written.
+        //:
+        //: 3 The buffer grows as needed, keeping the characters written, and
+        //:   is never truncated.
+        //:
+        //: 4 'reserve' grows the buffer to at least the requested capacity,
+        //:   and has no effect if the capacity is already sufficient.
+        //:
+        //: 5 'reset' discards the output and keeps the memory, so that
+        //:   writing the same output again does not allocate.
+        //:
+        //: 6 The destructor releases the memory.
+        //:
+        //: 7 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create objects with and without an allocator, and verify where
+        //:   their memory comes from.  (C-1..2)
+        //:
+        //: 2 Write output of increasing length, through the stream and the
+        //:   'append' methods, checking the contents and capacity.  (C-3)
+        //:
+        //: 3 Call 'reserve' with smaller and larger capacities.  (C-4)
+        //:
+        //: 4 Reset the object and write the same output again, verifying that
+        //:   no memory is allocated.  (C-5)
+        //:
+        //: 5 Verify that no memory is in use once each object is destroyed.
+        //:   (C-6)
+        //:
+        //: 6 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-7)
+        //
+        // Testing:
+        //   explicit PrintBuffer(bslma::Allocator *basicAllocator = 0);
+        //   ~PrintBuffer();
+        //   void append(char character);
+        //   void append(const char *string);
+        //   void append(const char *data, int length);
+        //   void reserve(int capacity);
+        //   void reset();
+        //   bsl::ostream& stream();
+        //   int capacity() const;
+        //   const char *data() const;
+        //   bool isGrowable() const;
+        //   int length() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "GROWABLE BUFFER" << endl
+                                  << "===============" << endl;
+
+        if (verbose) cout << "\nTesting the allocator." << endl;
+        {
+            bslma::TestAllocator da("default2", veryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(X.isGrowable());
+            ASSERT(&da == X.allocator());
+            ASSERT(0 == X.capacity());
+            ASSERT(0 == X.length());
+            ASSERT(0 == da.numBlocksTotal());
+
+            mX.append('a');
+
+            ASSERT(1 == da.numBlocksTotal());
+            ASSERT(1 == X.length());
+            ASSERT('a' == *X.data());
+
+            bslma::TestAllocator oa("object", veryVerbose);
+            {
+                Obj mY(&oa);  const Obj& Y = mY;
+
+                ASSERT(&oa == Y.allocator());
+
+                mY.stream() << 'b';
+
+                ASSERT(1 == oa.numBlocksInUse());
+                ASSERT(1 == da.numBlocksTotal());
+                ASSERT("b" == contents(Y));
+            }
+            ASSERT(0 == oa.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+        if (verbose) cout << "\nTesting growth and 'reset'." << endl;
+        {
+            bslma::TestAllocator oa("object", veryVerbose);
+
+            {
+                Obj mX(&oa);  const Obj& X = mX;
+
+                bsl::string expected;
+
+                for (int i = 0; i < 2000; ++i) {
+                    char digits[16];
+                    sprintf(digits, "%d", i);
+
+                    if (i % 2) {
+                        mX.stream() << i << ',';
+                    }
+                    else {
+                        mX.append(digits);
+                        mX.append(",.", 1);
+                    }
+                    expected += digits;
+                    expected += ',';
+
+                    LOOP_ASSERT(i, X.length() <= X.capacity());
+                }
+
+                ASSERT(expected == contents(X));
+                ASSERT(!X.isTruncated());
+                ASSERT(mX.stream().good());
+                ASSERT(1 == oa.numBlocksInUse());
+
+                const int   CAPACITY = X.capacity();
+                const Int64 TOTAL    = oa.numBlocksTotal();
+
+                mX.reset();
+
+                ASSERT(0 == X.length());
+                ASSERT(CAPACITY == X.capacity());
+
+                for (int i = 0; i < 2000; ++i) {
+                    mX.stream() << i << ',';
+                }
+
+                ASSERT(expected == contents(X));
+                ASSERT(TOTAL == oa.numBlocksTotal());
+
+                mX.reserve(CAPACITY / 2);
+                ASSERT(CAPACITY == X.capacity());
+                ASSERT(TOTAL == oa.numBlocksTotal());
+
+                mX.reserve(CAPACITY * 3);
+                ASSERT(CAPACITY * 3 == X.capacity());
+                ASSERT(expected == contents(X));
+                ASSERT(1 == oa.numBlocksInUse());
+            }
+            ASSERT(0 == oa.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting 'reserve' on an empty object." << endl;
+        {
+            bslma::TestAllocator oa("object", veryVerbose);
+
+            Obj mX(&oa);  const Obj& X = mX;
+
+            mX.reserve(0);
+            ASSERT(0 == oa.numBlocksTotal());
+
+            mX.reserve(10);
+            ASSERT(10 == X.capacity());
+            ASSERT(0 == X.length());
+            ASSERT(1 == oa.numBlocksTotal());
+
+            mX.append("0123456789");
+            ASSERT(1 == oa.numBlocksTotal());
+
+            mX.append('a');
+            ASSERT(2 == oa.numBlocksTotal());
+            ASSERT("0123456789a" == contents(X));
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bslma::TestAllocator oa("object", veryVerbose);
+
+            Obj mX(&oa);
+
+            ASSERT_PASS(mX.reserve(0));
+            ASSERT_FAIL(mX.reserve(-1));
+
+            ASSERT_SAFE_PASS(mX.append("a"));
+            ASSERT_SAFE_FAIL(mX.append(static_cast<const char *>(0)));
+            ASSERT_SAFE_PASS(mX.append(0, 0));
+            ASSERT_SAFE_FAIL(mX.append(0, 1));
+            ASSERT_SAFE_FAIL(mX.append("a", -1));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to support comprehensive
+        //:   testing.
+        //
+        // Plan: Create a fixed and a growable object, write to each through
+        // the stream and the 'append' methods, and verify the characters
+        // written.
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        bslma::TestAllocator oa("object", veryVerbose);
+
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            mX.stream() << "x = " << 12 << ' ' << 1.5;
+            mX.append(", y = ");
+            mX.appendInteger(-34);
+
+            LOOP_ASSERT(contents(X), "x = 12 1.5, y = -34" == contents(X));
+            ASSERT(!X.isTruncated());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        {
+            char storage[8];
+            Obj  mX(storage, sizeof storage);  const Obj& X = mX;
+
+            mX.appendUnsigned(1234);
+            mX.stream() << 5678 << 9;
+
+            LOOP_ASSERT(contents(X), "12345678" == contents(X));
+            ASSERT(X.isTruncated());
+        }
+      } break;
+      default: {
+        bsl::cerr << "WARNING: CASE `" << test << "' NOT FOUND." << bsl::endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        bsl::cerr << "Error, non-zero test status = " << testStatus << "."
+                  << bsl::endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
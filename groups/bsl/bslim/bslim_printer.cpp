@@ -15,9 +15,13 @@ namespace BloombergLP {
 namespace {
 
 static
-void putSpaces(bsl::ostream& stream, int numSpaces)
+void putSpaces(bsl::ostream&       stream,
+               bslim::PrintBuffer *buffer,
+               int                 numSpaces)
     // Efficiently insert the specified 'numSpaces' spaces into the specified
-    // 'stream'.  This function has no effect on 'stream' if 'numSpaces < 0'.
+    // 'stream', or directly into the specified 'buffer' of 'stream' if
+    // 'buffer' is not 0.  This function has no effect on 'stream' if
+    // 'numSpaces < 0'.
 {
     // Algorithm: Write spaces in chunks.  The chunk size is large enough so
     // that most times only a single call to the 'write' method is needed.
@@ -27,12 +31,22 @@ void putSpaces(bsl::ostream& stream, int numSpaces)
            const int  k_SPACES_SIZE = sizeof(k_SPACES) - 1;
 
     while (k_SPACES_SIZE < numSpaces) {
-        stream.write(k_SPACES, k_SPACES_SIZE);
+        if (buffer) {
+            buffer->append(k_SPACES, k_SPACES_SIZE);
+        }
+        else {
+            stream.write(k_SPACES, k_SPACES_SIZE);
+        }
         numSpaces -= k_SPACES_SIZE;
     }
 
     if (0 < numSpaces) {
-        stream.write(k_SPACES, numSpaces);
+        if (buffer) {
+            buffer->append(k_SPACES, numSpaces);
+        }
+        else {
+            stream.write(k_SPACES, numSpaces);
+        }
     }
 }
 
@@ -80,29 +94,76 @@ namespace bslim {
                         // -------------
 
 // PRIVATE ACCESSORS
+void Printer::printChar(char character) const
+{
+    if (d_buffer_p && 0 == d_stream_p->width()) {
+        d_buffer_p->append(character);
+    }
+    else {
+        *d_stream_p << character;
+    }
+}
+
 void Printer::printEndIndentation() const
 {
-    putSpaces(*d_stream_p, d_spacesPerLevel < 0
-                           ? 1
-                           : d_spacesPerLevel * d_level);
+    putSpaces(*d_stream_p,
+              d_buffer_p,
+              d_spacesPerLevel < 0 ? 1 : d_spacesPerLevel * d_level);
 }
 
 void Printer::printIndentation() const
 {
-    putSpaces(*d_stream_p, d_spacesPerLevel < 0
-                           ? 1
-                           : d_spacesPerLevel * d_levelPlusOne);
+    putSpaces(*d_stream_p,
+              d_buffer_p,
+              d_spacesPerLevel < 0 ? 1 : d_spacesPerLevel * d_levelPlusOne);
 }
+
+void Printer::printName(const char *name) const
+{
+    if (d_buffer_p && 0 == d_stream_p->width()) {
+        d_buffer_p->append(name);
+        d_buffer_p->append(" = ", 3);
+    }
+    else {
+        *d_stream_p << name << " = ";
+    }
+}
+
 // CREATORS
 Printer::Printer(bsl::ostream *stream, int level, int spacesPerLevel)
 : d_stream_p(stream)
 , d_spacesPerLevel(spacesPerLevel)
+, d_buffer_p(0)
 {
     BSLS_ASSERT(stream);
 
     d_suppressInitialIndentFlag = level < 0;
     d_level                     = level < 0 ? -level : level;
     d_levelPlusOne              = d_level + 1;
+
+    // Output to a stream that is not good has no effect, so write to the
+    // buffer directly only if the stream is good.
+
+    if (stream->good()) {
+        d_buffer_p = PrintBuffer::fromStream(*stream);
+    }
+}
+
+Printer::Printer(PrintBuffer *buffer, int level, int spacesPerLevel)
+: d_stream_p(0)
+, d_spacesPerLevel(spacesPerLevel)
+, d_buffer_p(0)
+{
+    BSLS_ASSERT(buffer);
+
+    d_stream_p                  = &buffer->stream();
+    d_suppressInitialIndentFlag = level < 0;
+    d_level                     = level < 0 ? -level : level;
+    d_levelPlusOne              = d_level + 1;
+
+    if (d_stream_p->good()) {
+        d_buffer_p = buffer;
+    }
 }
 
 Printer::~Printer()
@@ -119,11 +180,11 @@ void Printer::end(bool suppressBracket) const
 {
     if (!suppressBracket) {
         printEndIndentation();
-        *d_stream_p << ']';
+        printChar(']');
     }
 
     if (d_spacesPerLevel >= 0) {
-        *d_stream_p << '\n';
+        printChar('\n');
     }
 }
 
@@ -132,7 +193,7 @@ void Printer::printHexAddr(const void *address, const char *name) const
     printIndentation();
 
     if (name != NULL) {
-        *d_stream_p << name << " = ";
+        printName(name);
     }
 
     Printer_Helper::print(*d_stream_p,
@@ -152,13 +213,13 @@ void Printer::start(bool suppressBracket) const
         const int absSpacesPerLevel = d_spacesPerLevel < 0
                                       ? -d_spacesPerLevel
                                       :  d_spacesPerLevel;
-        putSpaces(*d_stream_p, absSpacesPerLevel * d_level);
+        putSpaces(*d_stream_p, d_buffer_p, absSpacesPerLevel * d_level);
     }
 
     if (!suppressBracket) {
-        *d_stream_p << '[';
+        printChar('[');
         if (d_spacesPerLevel >= 0) {
-            *d_stream_p << '\n';
+            printChar('\n');
         }
     }
 }
@@ -172,6 +233,90 @@ bool Printer::suppressInitialIndentFlag() const
                         // struct Printer_Helper
                         // ---------------------
 
+                      // Fast paths for 'PrintBuffer'
+
+bool Printer_Helper::appendFundamental(PrintBuffer *buffer, short data)
+{
+    buffer->appendInteger(data);
+    return true;
+}
+
+bool Printer_Helper::appendFundamental(PrintBuffer    *buffer,
+                                       unsigned short  data)
+{
+    buffer->appendUnsigned(data);
+    return true;
+}
+
+bool Printer_Helper::appendFundamental(PrintBuffer *buffer, int data)
+{
+    buffer->appendInteger(data);
+    return true;
+}
+
+bool Printer_Helper::appendFundamental(PrintBuffer *buffer, unsigned int data)
+{
+    buffer->appendUnsigned(data);
+    return true;
+}
+
+bool Printer_Helper::appendFundamental(PrintBuffer *buffer, long data)
+{
+    buffer->appendInteger(data);
+    return true;
+}
+
+bool Printer_Helper::appendFundamental(PrintBuffer   *buffer,
+                                       unsigned long  data)
+{
+    buffer->appendUnsigned(data);
+    return true;
+}
+
+bool Printer_Helper::appendFundamental(PrintBuffer        *buffer,
+                                       bsls::Types::Int64  data)
+{
+    buffer->appendInteger(data);
+    return true;
+}
+
+bool Printer_Helper::appendFundamental(PrintBuffer         *buffer,
+                                       bsls::Types::Uint64  data)
+{
+    buffer->appendUnsigned(data);
+    return true;
+}
+
+bool Printer_Helper::appendFundamental(PrintBuffer *buffer, float data)
+{
+    return appendFundamental(buffer, static_cast<double>(data));
+}
+
+bool Printer_Helper::appendFundamental(PrintBuffer *buffer, double data)
+{
+    const bsl::streamsize precision = buffer->stream().precision();
+
+    if (precision < 0 || PrintBuffer::k_MAX_PRECISION < precision) {
+        return false;                                                 // RETURN
+    }
+
+    buffer->appendFloatingPoint(data, static_cast<int>(precision));
+    return true;
+}
+
+PrintBuffer *Printer_Helper::fastBuffer(bsl::ostream& stream)
+{
+    if (!stream.good()) {
+        return 0;                                                     // RETURN
+    }
+
+    PrintBuffer *buffer = PrintBuffer::fromStream(stream);
+
+    return buffer && buffer->hasDefaultFormat() ? buffer : 0;
+}
+
+                      // Fundamental types
+
 // CLASS METHODS
 void Printer_Helper::printRaw(bsl::ostream&                  stream,
                               char                           data,
@@ -179,6 +324,14 @@ void Printer_Helper::printRaw(bsl::ostream&                  stream,
                               int                            spacesPerLevel,
                               bslmf::SelectTraitCase<bsl::is_fundamental>)
 {
+    PrintBuffer *buffer = fastBuffer(stream);
+
+    if (buffer && bsl::isprint(static_cast<unsigned char>(data))) {
+        const char quoted[] = { '\'', data, '\'', '\n' };
+        buffer->append(quoted, spacesPerLevel >= 0 ? 4 : 3);
+        return;                                                       // RETURN
+    }
+
 #define HANDLE_CONTROL_CHAR(value) case value: stream << #value; break;
     if (bsl::isprint(static_cast<unsigned char>(data))) {
         // print within quotes
@@ -215,6 +368,16 @@ void Printer_Helper::printRaw(bsl::ostream&                  stream,
                               int                            spacesPerLevel,
                               bslmf::SelectTraitCase<bsl::is_fundamental>)
 {
+    PrintBuffer *buffer = fastBuffer(stream);
+
+    if (buffer) {
+        buffer->append(data ? "true" : "false");
+        if (spacesPerLevel >= 0) {
+            buffer->append('\n');
+        }
+        return;                                                       // RETURN
+    }
+
     {
         FormatGuard guard(&stream);
         stream << bsl::boolalpha
@@ -232,6 +395,23 @@ void Printer_Helper::printRaw(bsl::ostream&              stream,
                               int                        spacesPerLevel,
                               bslmf::SelectTraitCase<bsl::is_pointer>)
 {
+    PrintBuffer *buffer = fastBuffer(stream);
+
+    if (buffer) {
+        if (0 == data) {
+            buffer->append("NULL", 4);
+        }
+        else {
+            buffer->append('"');
+            buffer->append(data);
+            buffer->append('"');
+        }
+        if (spacesPerLevel >= 0) {
+            buffer->append('\n');
+        }
+        return;                                                       // RETURN
+    }
+
     if (0 == data) {
         stream << "NULL";
     }
@@ -274,6 +454,18 @@ void Printer_Helper::printRaw(bsl::ostream&              stream,
     // 'bslalg::HasStlIterators' type trait due to only having defined a
     // 'const_iterator' interface.
 
+    PrintBuffer *buffer = fastBuffer(stream);
+
+    if (buffer) {
+        buffer->append('"');
+        buffer->append(data.data(), static_cast<int>(data.length()));
+        buffer->append('"');
+        if (spacesPerLevel >= 0) {
+            buffer->append('\n');
+        }
+        return;                                                       // RETURN
+    }
+
     stream << '"' << data << '"';
     if (spacesPerLevel >= 0) {
         stream << '\n';
@@ -75,6 +75,25 @@ BSLS_IDENT("$Id: $")
 // before any of the other methods, and 'end' should be called after all the
 // other methods have been called.
 //
+///Printing to a 'bslim::PrintBuffer'
+///-----------------------------------
+// Formatted output to a 'bsl::ostream' constructs a sentry object, and uses
+// locale facets and virtual functions, for each value and each piece of
+// punctuation, which dominates the cost of printing large structures.  A
+// 'Printer' may instead be given a 'bslim::PrintBuffer', or the stream of a
+// 'bslim::PrintBuffer' (which a 'Printer' recognizes), in which case the
+// 'Printer' (and each 'Printer' created, for nested values, with the same
+// stream) writes indentation, brackets, attribute names, strings, 'bool' and
+// printable 'char' values, and the values of arithmetic types (other than
+// 'long double' and the character types) directly to the buffer, producing
+// the same characters as the stream would.  Nested values of types having a
+// standard 'print' method receive the stream of the buffer, so that every
+// type whose 'print' method is implemented with 'Printer' (e.g., the
+// vocabulary types of 'bdlt', and the standard containers printed by
+// 'Printer') is printed through the fast path without modification.  The
+// fast path is not taken while the stream has a non-zero width, or (for
+// values) format flags other than the default ones.
+//
 ///Usage
 ///-----
 // In the following examples, we examine the implementation of the 'print'
@@ -522,6 +541,10 @@ BSLS_IDENT("$Id: $")
 #include <bslscm_version.h>
 #endif
 
+#ifndef INCLUDED_BSLIM_PRINTBUFFER
+#include <bslim_printbuffer.h>
+#endif
+
 #ifndef INCLUDED_BSLALG_TYPETRAITHASSTLITERATORS
 #include <bslalg_typetraithasstliterators.h>
 #endif
@@ -592,8 +615,17 @@ class Printer {
     int           d_spacesPerLevel;            // spaces per level used in
                                                // formatting
 
+    PrintBuffer  *d_buffer_p;                  // buffer of 'd_stream_p' (held,
+                                               // not owned), or 0 if
+                                               // 'd_stream_p' is not the
+                                               // stream of a 'PrintBuffer'
+
   private:
     // PRIVATE ACCESSORS
+    void printChar(char character) const;
+        // Print the specified 'character' to the output stream supplied at
+        // construction.
+
     void printEndIndentation() const;
         // Print to the output stream supplied at construction
         // 'absLevel() * spacesPerLevel()' blank spaces if
@@ -604,6 +636,10 @@ class Printer {
         // '(absLevel() + 1) * spacesPerLevel()' blank spaces if
         // 'spacesPerLevel() >= 0', and print a single blank space otherwise.
 
+    void printName(const char *name) const;
+        // Print to the output stream supplied at construction the specified
+        // 'name' followed by " = ".
+
   private:
     // NOT IMPLEMENTED
     Printer& operator=(const Printer&);
@@ -614,7 +650,16 @@ class Printer {
         // Create a 'Printer' object that will print to the specified 'stream'
         // in a format dictated by the values of the specified 'level' and
         // 'spacesPerLevel', as per the contract of the standard BDE 'print'
-        // method.  The behavior is undefined unless 'stream' is valid.
+        // method.  The behavior is undefined unless 'stream' is valid.  Note
+        // that, if 'stream' is the stream of a 'PrintBuffer', this 'Printer'
+        // writes to the buffer directly where it can.
+
+    Printer(PrintBuffer *buffer, int level, int spacesPerLevel);
+        // Create a 'Printer' object that will print to the stream of the
+        // specified 'buffer', writing to 'buffer' directly where it can, in a
+        // format dictated by the values of the specified 'level' and
+        // 'spacesPerLevel', as per the contract of the standard BDE 'print'
+        // method.  The behavior is undefined unless 'buffer' is valid.
 
     ~Printer();
         // Destroy this 'Printer' object.
@@ -837,6 +882,32 @@ struct Printer_Helper {
         // '*' to access the objects.  Individual objects are printed with
         // 'printValue'.
 
+                      // Fast paths for 'PrintBuffer'
+
+    static bool appendFundamental(PrintBuffer *buffer, short data);
+    static bool appendFundamental(PrintBuffer *buffer, unsigned short data);
+    static bool appendFundamental(PrintBuffer *buffer, int data);
+    static bool appendFundamental(PrintBuffer *buffer, unsigned int data);
+    static bool appendFundamental(PrintBuffer *buffer, long data);
+    static bool appendFundamental(PrintBuffer *buffer, unsigned long data);
+    static bool appendFundamental(PrintBuffer         *buffer,
+                                  bsls::Types::Int64   data);
+    static bool appendFundamental(PrintBuffer         *buffer,
+                                  bsls::Types::Uint64  data);
+    static bool appendFundamental(PrintBuffer *buffer, float data);
+    static bool appendFundamental(PrintBuffer *buffer, double data);
+    template <class TYPE>
+    static bool appendFundamental(PrintBuffer *buffer, const TYPE& data);
+        // Append the specified 'data' to the specified 'buffer' and return
+        // 'true' if the (deduced) 'TYPE' of 'data' has a fast path, and
+        // return 'false' with no effect otherwise.  The behavior is undefined
+        // unless 'buffer->hasDefaultFormat()'.
+
+    static PrintBuffer *fastBuffer(bsl::ostream& stream);
+        // Return the address of the 'PrintBuffer' of the specified 'stream'
+        // if 'stream' is the stream of a 'PrintBuffer' that has the default
+        // format, and 0 otherwise.
+
                       // Fundamental types
 
     static void printRaw(
@@ -968,7 +1039,7 @@ void Printer::printAttribute(const char *name, const TYPE& data) const
 
     printIndentation();
 
-    *d_stream_p << name << " = ";
+    printName(name);
 
     Printer_Helper::print(*d_stream_p,
                           data,
@@ -985,7 +1056,7 @@ void Printer::printAttribute(const char      *name,
 
     printIndentation();
 
-    *d_stream_p << name << " = ";
+    printName(name);
 
     Printer_Helper::print(*d_stream_p,
                           begin,
@@ -1002,7 +1073,7 @@ void Printer::printForeign(const TYPE&           data,
     printIndentation();
 
     if (name) {
-        *d_stream_p << name << " = ";
+        printName(name);
     }
 
     printFunctionObject(*d_stream_p,
@@ -1017,7 +1088,7 @@ void Printer::printOrNull(const TYPE& address, const char *name) const
     printIndentation();
 
     if (name) {
-        *d_stream_p << name << " = ";
+        printName(name);
     }
 
     if (0 == address) {
@@ -1042,7 +1113,7 @@ void Printer::printOrNull<const void *>(const void *const&  address,
     printIndentation();
 
     if (name) {
-        *d_stream_p << name << " = ";
+        printName(name);
     }
     const void *temp = address;
 
@@ -1113,6 +1184,13 @@ void Printer_Helper::print(bsl::ostream&   stream,
 
                       // Fundamental types
 
+template <class TYPE>
+inline
+bool Printer_Helper::appendFundamental(PrintBuffer *, const TYPE&)
+{
+    return false;
+}
+
 template <class TYPE>
 inline
 void Printer_Helper::printRaw(
@@ -1122,6 +1200,15 @@ void Printer_Helper::printRaw(
                          int                            spacesPerLevel,
                          bslmf::SelectTraitCase<bsl::is_fundamental>)
 {
+    PrintBuffer *buffer = fastBuffer(stream);
+
+    if (buffer && appendFundamental(buffer, data)) {
+        if (spacesPerLevel >= 0) {
+            buffer->append('\n');
+        }
+        return;                                                       // RETURN
+    }
+
     stream << data;
     if (spacesPerLevel >= 0) {
         stream << '\n';
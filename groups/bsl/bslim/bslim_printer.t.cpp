@@ -2,8 +2,12 @@
 
 #include <bslim_printer.h>
 
+#include <bslim_printbuffer.h>
+
 #include <bslma_testallocator.h>
 #include <bsls_platform.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
 
 #include <bsl_cstdio.h>
 #include <bsl_iomanip.h>
@@ -47,6 +51,7 @@ using namespace bslim;
 //-----------------------------------------------------------------------------
 // CREATORS
 // [ 2] Printer(bsl::ostream *stream, int level, int spacesPerLevel);
+// [22] Printer(PrintBuffer *buffer, int level, int spacesPerLevel);
 //
 // ACCESSORS
 // [ 2] absLevel() const;
@@ -76,6 +81,8 @@ using namespace bslim;
 // [19] USAGE EXAMPLE 2
 // [20] USAGE EXAMPLE 3
 // [21] USAGE EXAMPLE 4
+// [22] CONCERN: output to a 'PrintBuffer' is the same as to a stream
+// [-1] PERFORMANCE: output to a 'PrintBuffer' and to a stream
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -231,6 +238,63 @@ void testFunctionAddress(int)
 {
 }
 
+static
+void printSample(const Obj& printer)
+    // Print, using the specified 'printer', a sample of values of each type
+    // for which 'Printer' writes directly to a 'PrintBuffer', and of types
+    // (and names) for which it does not.
+{
+    static const int INTS[] = { 1, -2, 3 };
+
+    const TestEnumWithStreaming::Enum ENUM = TestEnumWithStreaming::VALUE_B;
+
+    bsl::vector<int>           values(INTS, INTS + 3);
+    bsl::map<int, bsl::string> names;
+    names[1]  = "one";
+    names[-2] = "minus two";
+
+    const char *const NULL_STRING = 0;
+    const int  *const NULL_INT    = 0;
+    const int  *const ADDRESS     = INTS;
+
+    printer.start();
+    printer.printAttribute("short", static_cast<short>(-32768));
+    printer.printAttribute("ushort", static_cast<unsigned short>(65535));
+    printer.printAttribute("int", -2147483647 - 1);
+    printer.printAttribute("uint", 4294967295U);
+    printer.printAttribute("long", -123456789L);
+    printer.printAttribute("ulong", 123456789UL);
+    printer.printAttribute("Int64", static_cast<bsls::Types::Int64>(
+                                                    -9223372036854775807LL));
+    printer.printAttribute("Uint64", static_cast<bsls::Types::Uint64>(
+                                                    18446744073709551615ULL));
+    printer.printAttribute("float", 1.25f);
+    printer.printAttribute("double", 1.0 / 3);
+    printer.printAttribute("large", 1.5e300);
+    printer.printAttribute("true", true);
+    printer.printAttribute("false", false);
+    printer.printAttribute("char", 'x');
+    printer.printAttribute("newline", '\n');
+    printer.printAttribute("byte", static_cast<char>(0x7f));
+    printer.printAttribute("signed char", static_cast<signed char>('y'));
+    printer.printAttribute("string", "text");
+    printer.printAttribute("null", NULL_STRING);
+    printer.printAttribute("bsl::string", bsl::string("more text"));
+    printer.printAttribute("StringRef", bslstl::StringRef("ref"));
+    printer.printAttribute("vector", values);
+    printer.printAttribute("map", names);
+    printer.printAttribute("pair", bsl::pair<int, char>(7, 'z'));
+    printer.printAttribute("enum", ENUM);
+    printer.printAttribute("HasPrint", HasPrint(17));
+    printer.printOrNull(NULL_INT, "null address");
+    printer.printOrNull(ADDRESS, "address");
+    printer.printHexAddr(ADDRESS, "hex address");
+    printer.printValue(42);
+    printer.printValue(2.5);
+    printer.printForeign(NoPrint(5), &NoPrintUtil::print, "foreign");
+    printer.end();
+}
+
 //=============================================================================
 //                              USAGE EXAMPLE
 //-----------------------------------------------------------------------------
@@ -596,6 +660,202 @@ int main(int argc, char *argv[])
 
     bsl::cout << "TEST " << __FILE__ << " CASE " << test << bsl::endl;
     switch (test) { case 0:  // Zero is always the leading case.
+      case 22: {
+        // --------------------------------------------------------------------
+        // OUTPUT TO A 'PrintBuffer'
+        //   'Printer' writes punctuation, indentation, names, and values of
+        //   fundamental types, strings, and string references directly to
+        //   the buffer of a 'bslim::PrintBuffer' whose stream it prints to.
+        //
+        // Concerns:
+        //: 1 The output to the stream of a 'PrintBuffer' is the same as the
+        //:   output to an 'ostringstream', for every type, and for every
+        //:   value of 'level' and 'spacesPerLevel'.
+        //:
+        //: 2 A 'Printer' created with the address of a 'PrintBuffer' writes
+        //:   the same output as one created with the address of its stream.
+        //:
+        //: 3 Format flags, precision, and width set on the stream are
+        //:   respected as they are for an 'ostringstream'.
+        //:
+        //: 4 Output that does not fit in a fixed 'PrintBuffer' is truncated,
+        //:   and the output that fits is a prefix of the complete output.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, for several values of 'level'
+        //:   and 'spacesPerLevel', print a sample of values of many types to
+        //:   an 'ostringstream', to the stream of a growable 'PrintBuffer', to
+        //:   a 'PrintBuffer' through the 'Printer' constructor taking its
+        //:   address, and to the stream of a fixed 'PrintBuffer', and
+        //:   compare the outputs.  (C-1..2)
+        //:
+        //: 2 Repeat P-1 with streams having 'hex', 'showpos', and a modified
+        //:   precision.  (C-3)
+        //:
+        //: 3 Repeat the test of case 17 with the stream of a 'PrintBuffer'.
+        //:   (C-3)
+        //:
+        //: 4 Print the sample to fixed buffers of each length smaller than
+        //:   the complete output.  (C-4)
+        //
+        // Testing:
+        //   Printer(PrintBuffer *buffer, int level, int spacesPerLevel);
+        //   CONCERN: output to a 'PrintBuffer' is the same as to a stream
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "OUTPUT TO A 'PrintBuffer'" << endl
+                          << "=========================" << endl;
+
+        static const struct {
+            int d_line;
+            int d_level;
+            int d_spacesPerLevel;
+        } DATA[] = {
+            //LINE  LEVEL  SPL
+            //----  -----  ---
+            { L_,      0,   4 },
+            { L_,      0,  -1 },
+            { L_,      0,   0 },
+            { L_,      1,   2 },
+            { L_,      3,   4 },
+            { L_,     -1,   4 },
+            { L_,     -2,  -3 },
+            { L_,      2,  -2 },
+            { L_,     -3,  -1 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        enum { k_PLAIN, k_HEX, k_SHOWPOS, k_PRECISION, k_NUM_FORMATS };
+
+        bslma::TestAllocator ta("buffer", veryVeryVerbose);
+
+        if (verbose) cout << "\nComparing with 'ostringstream'." << endl;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE  = DATA[ti].d_line;
+            const int LEVEL = DATA[ti].d_level;
+            const int SPL   = DATA[ti].d_spacesPerLevel;
+
+            for (int format = 0; format < k_NUM_FORMATS; ++format) {
+                bsl::ostringstream expected;
+                PrintBuffer        growable(&ta);
+                PrintBuffer        direct(&ta);
+                char               storage[4096];
+                PrintBuffer        fixed(storage, sizeof storage);
+
+                bsl::ostream *STREAMS[] = {
+                    &expected,
+                    &growable.stream(),
+                    &direct.stream(),
+                    &fixed.stream()
+                };
+
+                for (int i = 0; i < 4; ++i) {
+                    switch (format) {
+                      case k_HEX: {
+                        *STREAMS[i] << bsl::hex;
+                      } break;
+                      case k_SHOWPOS: {
+                        *STREAMS[i] << bsl::showpos;
+                      } break;
+                      case k_PRECISION: {
+                        STREAMS[i]->precision(3);
+                      } break;
+                    }
+                }
+
+                printSample(Obj(&expected, LEVEL, SPL));
+                printSample(Obj(&growable.stream(), LEVEL, SPL));
+                printSample(Obj(&direct, LEVEL, SPL));
+                printSample(Obj(&fixed.stream(), LEVEL, SPL));
+
+                const bsl::string EXPECTED = expected.str();
+                const bsl::string GROWABLE(growable.data(),
+                                           growable.length());
+                const bsl::string DIRECT(direct.data(), direct.length());
+                const bsl::string FIXED(fixed.data(), fixed.length());
+
+                if (veryVerbose) {
+                    P_(LINE) P_(format) P(EXPECTED)
+                }
+
+                LOOP3_ASSERT(LINE, format, GROWABLE, EXPECTED == GROWABLE);
+                LOOP3_ASSERT(LINE, format, DIRECT,   EXPECTED == DIRECT);
+                LOOP3_ASSERT(LINE, format, FIXED,    EXPECTED == FIXED);
+                LOOP2_ASSERT(LINE, format, !fixed.isTruncated());
+            }
+        }
+
+        if (verbose) cout << "\nTesting with 'setw'." << endl;
+        {
+            static const struct {
+                int         d_line;
+                const char *d_text;
+                int         d_setw;     // negative values = left-justified
+                const char *d_expected;
+            } DATA[] = {
+                { L_, "FOO",  0, "FOO"     },
+                { L_, "FOO",  3, "FOO"     },
+                { L_, "FOO",  4, " FOO"    },
+                { L_, "FOO",  7, "    FOO" },
+                { L_, "FOO", -4, "FOO "    },
+                { L_, "FOO", -7, "FOO    " },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int i = 0; i < NUM_DATA; ++i) {
+                const int   LINE     = DATA[i].d_line;
+                const char *INPUT    = DATA[i].d_text;
+                const int   SETW     = DATA[i].d_setw;
+                const char *EXPECTED = DATA[i].d_expected;
+
+                PrintBuffer   buffer(&ta);
+                bsl::ostream& stream = buffer.stream();
+
+                if (SETW < 0) {
+                    stream << bsl::setiosflags(ios::left) << bsl::setw(-SETW);
+                }
+                else {
+                    stream << bsl::setw(SETW);
+                }
+
+                Obj printer(&stream, 0, -1);
+                printer.start(true);
+                stream << INPUT;
+                printer.end(true);
+
+                const bsl::string ACTUAL(buffer.data(), buffer.length());
+
+                LOOP3_ASSERT(LINE, SETW, ACTUAL, EXPECTED == ACTUAL);
+            }
+        }
+
+        if (verbose) cout << "\nTesting truncation." << endl;
+        {
+            bsl::ostringstream expected;
+            printSample(Obj(&expected, 1, 4));
+
+            const bsl::string EXPECTED = expected.str();
+            const int         LENGTH   = static_cast<int>(EXPECTED.length());
+
+            for (int capacity = 0; capacity < LENGTH; ++capacity) {
+                bsl::vector<char> storage(capacity + 1, '#');
+                PrintBuffer       fixed(&storage[0], capacity);
+
+                printSample(Obj(&fixed.stream(), 1, 4));
+
+                LOOP_ASSERT(capacity, capacity == fixed.length());
+                LOOP_ASSERT(capacity, fixed.isTruncated());
+                LOOP_ASSERT(capacity, fixed.stream().bad());
+                LOOP_ASSERT(capacity, '#' == storage[capacity]);
+                LOOP_ASSERT(capacity, 0 == bsl::memcmp(EXPECTED.data(),
+                                                      fixed.data(),
+                                                      capacity));
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
       case 21: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE 4
@@ -2490,6 +2750,76 @@ int main(int argc, char *argv[])
         LOOP2_ASSERT(EXPECTED, ACTUAL, EXPECTED == ACTUAL);
 
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: OUTPUT TO A 'PrintBuffer' AND TO A STREAM
+        //
+        // Concerns:
+        //: 1 Printing to a 'PrintBuffer' is faster than printing to an
+        //:   'ostringstream'.
+        //
+        // Plan:
+        //: 1 Print a container of attribute-rich values repeatedly, on one
+        //:   line and on multiple lines, to a reused 'ostringstream' and to a
+        //:   reused 'PrintBuffer', and report the elapsed times.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: output to a 'PrintBuffer' and to a stream
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                  << "PERFORMANCE: OUTPUT TO A 'PrintBuffer' AND TO A STREAM"
+                  << endl
+                  << "======================================================"
+                  << endl;
+
+        const int NUM_ITERATIONS = argc > 2 ? atoi(argv[2]) : 1000;
+
+        bsl::vector<bsl::pair<int, double> > values;
+        for (int i = 0; i < 1000; ++i) {
+            values.push_back(bsl::pair<int, double>(i * 7919, i / 8.0));
+        }
+
+        const int SPLS[] = { -1, 4 };
+
+        for (int s = 0; s < 2; ++s) {
+            const int SPL = SPLS[s];
+
+            bsl::ostringstream stream;
+            PrintBuffer        buffer;
+            bsls::Stopwatch    timer;
+
+            timer.start();
+            for (int i = 0; i < NUM_ITERATIONS; ++i) {
+                stream.str("");
+                Obj printer(&stream, 0, SPL);
+                printer.printValue(values);
+            }
+            timer.stop();
+
+            const double STREAM_TIME = timer.elapsedTime();
+
+            timer.reset();
+            timer.start();
+            for (int i = 0; i < NUM_ITERATIONS; ++i) {
+                buffer.reset();
+                Obj printer(&buffer, 0, SPL);
+                printer.printValue(values);
+            }
+            timer.stop();
+
+            const double BUFFER_TIME = timer.elapsedTime();
+
+            ASSERT(stream.str() == bsl::string(buffer.data(),
+                                               buffer.length()));
+
+            cout << "spacesPerLevel = " << SPL
+                 << ": ostringstream " << STREAM_TIME
+                 << "s, PrintBuffer " << BUFFER_TIME
+                 << "s (" << buffer.length() << " characters, "
+                 << NUM_ITERATIONS << " iterations)" << endl;
+        }
+      } break;
       default: {
         bsl::cerr << "WARNING: CASE `" << test << "' NOT FOUND." << bsl::endl;
         testStatus = -1;
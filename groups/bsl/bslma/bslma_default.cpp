@@ -6,6 +6,7 @@ BSLS_IDENT("$Id$ $CSID$")
 
 #include <bslma_allocator.h>            // for testing only
 #include <bsls_assert.h>
+#include <bsls_platform.h>
 
 namespace BloombergLP {
 
@@ -13,6 +14,17 @@ namespace bslma {
 
 class Allocator;
 
+namespace {
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+__declspec(thread) Allocator *s_threadAllocator_p = 0;
+#else
+__thread Allocator *s_threadAllocator_p = 0;
+#endif
+    // default allocator of the current thread, or 0 if it has none
+
+}  // close unnamed namespace
+
                                // --------------
                                // struct Default
                                // --------------
@@ -24,6 +36,10 @@ class Allocator;
 bsls::AtomicOperations::AtomicTypes::Pointer Default::s_allocator = {0};
 bsls::AtomicOperations::AtomicTypes::Int     Default::s_locked    = {0};
 
+                        // *** thread default allocator ***
+
+bsls::AtomicOperations::AtomicTypes::Int Default::s_numThreadAllocators = {0};
+
                         // *** global allocator ***
 
 bsls::AtomicOperations::AtomicTypes::Pointer Default::s_globalAllocator = {0};
@@ -51,6 +67,28 @@ void Default::setDefaultAllocatorRaw(Allocator *basicAllocator)
     bsls::AtomicOperations::setPtrRelease(&s_allocator, basicAllocator);
 }
 
+                        // *** thread default allocator ***
+
+Allocator *Default::setThreadDefaultAllocator(Allocator *basicAllocator)
+{
+    Allocator *previous = s_threadAllocator_p;
+
+    if (!previous && basicAllocator) {
+        bsls::AtomicOperations::addIntRelaxed(&s_numThreadAllocators, 1);
+    }
+    else if (previous && !basicAllocator) {
+        bsls::AtomicOperations::addIntRelaxed(&s_numThreadAllocators, -1);
+    }
+
+    s_threadAllocator_p = basicAllocator;
+    return previous;
+}
+
+Allocator *Default::threadDefaultAllocator()
+{
+    return s_threadAllocator_p;
+}
+
                         // *** global allocator ***
 
 Allocator *Default::setGlobalAllocator(Allocator *basicAllocator)
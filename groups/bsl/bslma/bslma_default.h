@@ -34,8 +34,9 @@ BSLS_IDENT("$Id: $")
 //  &bslma::NewDeleteAllocator::singleton()
 //..
 // Methods are provided to retrieve and set the two allocators independently.
-// The following two subsections supply further details, in turn, on the
-// methods that pertain to the default and global allocators.
+// The following three subsections supply further details, in turn, on the
+// methods that pertain to the default allocator, to the default allocator of
+// a thread, and to the global allocator.
 //
 ///Default Allocator
 ///-----------------
@@ -79,6 +80,27 @@ BSLS_IDENT("$Id: $")
 // libraries that are on the link line.  *AVOID* file-scope static objects that
 // require runtime initialization, *especially* those that take an allocator.
 //
+///Thread Default Allocator
+///-------------------------
+// A thread may install a default allocator of its own, which supersedes the
+// process-wide default allocator for that thread only, by calling
+// 'bslma::Default::setThreadDefaultAllocator' (or, preferably, by creating a
+// 'bslma::ThreadDefaultAllocatorGuard', which restores the previous thread
+// default allocator when it is destroyed).  While a thread has a default
+// allocator, 'bslma::Default::defaultAllocator', and
+// 'bslma::Default::allocator' with no argument or an explicit 0, return that
+// allocator when called by that thread.  A thread may, for example, route all
+// memory allocated by default while it handles a request to an arena that is
+// released, in a single operation, once the request is handled, without
+// passing an allocator through every function that it calls.  The side-effect
+// of locking the process-wide default allocator is unaffected.
+//
+// The default allocator of a thread is held in thread-local storage, and is
+// consulted only while some thread in the process has one; otherwise, the
+// cost of the lookup is a single (relaxed) atomic load.  The
+// 'threadDefaultAllocator' method returns the default allocator of the
+// calling thread, or 0 if it has none.
+//
 ///Global Allocator
 ///----------------
 // The interface pertaining to the global allocator is comparatively much
@@ -669,6 +691,9 @@ struct Default {
     static bsls::AtomicOperations::AtomicTypes::Int     s_locked;
                                                   // lock to disable non-Raw
                                                   // 'set' of default allocator
+    static bsls::AtomicOperations::AtomicTypes::Int     s_numThreadAllocators;
+                                                  // number of threads having
+                                                  // a thread default allocator
     static bsls::AtomicOperations::AtomicTypes::Pointer s_globalAllocator;
                                                   // the global allocator
 
@@ -710,10 +735,11 @@ struct Default {
         // disabled by this method.
 
     static Allocator *defaultAllocator();
-        // Return the address of the default allocator and disable all
-        // subsequent calls to the 'setDefaultAllocator' method.  Note that
-        // prior to the first call to 'setDefaultAllocator' or
-        // 'setDefaultAllocatorRaw' methods, the address of the default
+        // Return the address of the default allocator of the calling thread,
+        // if it has one, and of the process-wide default allocator otherwise,
+        // and disable all subsequent calls to the 'setDefaultAllocator'
+        // method.  Note that prior to the first call to 'setDefaultAllocator'
+        // or 'setDefaultAllocatorRaw' methods, the address of the default
         // allocator is that of the 'NewDeleteAllocator' singleton.  Also note
         // that subsequent calls to 'setDefaultAllocatorRaw' method are *not*
         // disabled by this method.
@@ -724,6 +750,25 @@ struct Default {
         // optionally-specified 'basicAllocator' is 0; return 'basicAllocator'
         // otherwise.
 
+                        // *** thread default allocator ***
+
+    static Allocator *setThreadDefaultAllocator(Allocator *basicAllocator);
+        // Set the address of the default allocator of the calling thread to
+        // the specified 'basicAllocator', or, if 'basicAllocator' is 0, remove
+        // the default allocator of the calling thread, so that it uses the
+        // process-wide default allocator.  Return the address of the default
+        // allocator of the calling thread in effect immediately before calling
+        // this method, or 0 if it had none.  The behavior is undefined unless
+        // 'basicAllocator' is 0 or is the address of an allocator that
+        // remains valid until the default allocator of the calling thread is
+        // next set, and, before the calling thread exits, its default
+        // allocator is removed.  Note that 'ThreadDefaultAllocatorGuard'
+        // provides a scoped means of calling this method.
+
+    static Allocator *threadDefaultAllocator();
+        // Return the address of the default allocator of the calling thread,
+        // or 0 if it has none.
+
                         // *** global allocator ***
 
     static Allocator *globalAllocator(Allocator *basicAllocator = 0);
@@ -779,6 +824,16 @@ Allocator *Default::defaultAllocator()
         bsls::AtomicOperations::setIntRelaxed(&s_locked, 1);
     }
 
+    // A thread that has a default allocator has itself incremented
+    // 's_numThreadAllocators', so a relaxed load suffices.
+
+    if (bsls::AtomicOperations::getIntRelaxed(&s_numThreadAllocators)) {
+        Allocator *threadAllocator = threadDefaultAllocator();
+        if (threadAllocator) {
+            return threadAllocator;                                   // RETURN
+        }
+    }
+
     return static_cast<Allocator *>(const_cast<void *>(
                          bsls::AtomicOperations::getPtrRelaxed(&s_allocator)));
 }
@@ -9,6 +9,7 @@
 #include <bsls_assert.h>
 #include <bsls_asserttest.h>
 #include <bsls_bsltestutil.h>
+#include <bsls_stopwatch.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -45,12 +46,15 @@ using namespace BloombergLP;
 // [ 4] bslma::Allocator *allocator(*ba = 0);
 // [ 9] bslma::Allocator *globalAllocator(*ba = 0);
 // [ 9] bslma::Allocator *setGlobalAllocator(*ba);
+// [13] bslma::Allocator *setThreadDefaultAllocator(*ba);
+// [13] bslma::Allocator *threadDefaultAllocator();
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 2] BOOTSTRAP TEST
 // [10] USAGE EXAMPLE 1
 // [11] USAGE EXAMPLE 2
 // [12] USAGE EXAMPLE 3
+// [-1] PERFORMANCE: 'defaultAllocator'
 
 //=============================================================================
 //                  STANDARD BDE ASSERT TEST MACRO
@@ -507,6 +511,81 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 13: {
+        // --------------------------------------------------------------------
+        // TESTING THREAD DEFAULT ALLOCATOR
+        //
+        // Concerns:
+        //: 1 Initially, the calling thread has no default allocator, and
+        //:   'defaultAllocator' returns the process-wide default allocator.
+        //:
+        //: 2 'setThreadDefaultAllocator' installs the default allocator of the
+        //:   calling thread, which 'threadDefaultAllocator',
+        //:   'defaultAllocator', and 'allocator' with argument 0 then return,
+        //:   and returns the previous default allocator of the thread (or 0).
+        //:
+        //: 3 'setThreadDefaultAllocator' with 0 removes the default allocator
+        //:   of the thread, so that the process-wide default allocator is used
+        //:   again.
+        //:
+        //: 4 The process-wide default allocator may be set, and is locked by
+        //:   'defaultAllocator', as usual while the thread has a default
+        //:   allocator.
+        //
+        // Plan:
+        //: 1 Set, replace, and remove the default allocator of the thread,
+        //:   verifying the return values and the results of the accessors
+        //:   after each call.  (C-1..3)
+        //:
+        //: 2 While the thread has a default allocator, set the process-wide
+        //:   default allocator before and after it is locked.  (C-4)
+        //
+        // Testing:
+        //   bslma::Allocator *setThreadDefaultAllocator(*ba);
+        //   bslma::Allocator *threadDefaultAllocator();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING THREAD DEFAULT ALLOCATOR"
+                            "\n================================\n");
+
+        ASSERT(0 == Obj::threadDefaultAllocator());
+
+        ASSERT(0 == Obj::setThreadDefaultAllocator(U));
+        ASSERT(U == Obj::threadDefaultAllocator());
+
+        ASSERT(0 == Obj::setDefaultAllocator(V));  // not yet locked
+
+        ASSERT(U == Obj::defaultAllocator());      // locks default
+        ASSERT(U == Obj::allocator());
+        ASSERT(U == Obj::allocator(0));
+        ASSERT(V == Obj::allocator(V));
+
+        ASSERT(0 != Obj::setDefaultAllocator(NDA));
+
+        ASSERT(U == Obj::setThreadDefaultAllocator(V));
+        ASSERT(V == Obj::threadDefaultAllocator());
+        ASSERT(V == Obj::defaultAllocator());
+
+        ASSERT(V == Obj::setThreadDefaultAllocator(U));
+        ASSERT(U == Obj::defaultAllocator());
+
+        ASSERT(U == Obj::setThreadDefaultAllocator(0));
+        ASSERT(0 == Obj::threadDefaultAllocator());
+        ASSERT(V == Obj::defaultAllocator());
+        ASSERT(V == Obj::allocator());
+
+        ASSERT(0 == Obj::setThreadDefaultAllocator(0));
+        ASSERT(0 == Obj::threadDefaultAllocator());
+        ASSERT(V == Obj::defaultAllocator());
+
+        Obj::setDefaultAllocatorRaw(NDA);
+        ASSERT(NDA == Obj::defaultAllocator());
+
+        ASSERT(  0 == Obj::setThreadDefaultAllocator(U));
+        ASSERT(  U == Obj::defaultAllocator());
+        ASSERT(  U == Obj::setThreadDefaultAllocator(0));
+        ASSERT(NDA == Obj::defaultAllocator());
+      } break;
       case 12: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE 3
@@ -1144,6 +1223,55 @@ int main(int argc, char *argv[])
         ASSERT(  V == Obj::globalAllocator(V));
 
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'defaultAllocator'
+        //
+        // Concerns:
+        //: 1 The cost of 'defaultAllocator' is small while no thread has a
+        //:   default allocator, and remains small while the calling thread
+        //:   has one.
+        //
+        // Plan:
+        //: 1 Time a large number of calls to 'defaultAllocator' while no
+        //:   thread has a default allocator, and while the calling thread has
+        //:   one, and report the time per call.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: 'defaultAllocator'
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nPERFORMANCE: 'defaultAllocator'"
+                            "\n===============================\n");
+
+        const int NUM_CALLS = argc > 2 ? atoi(argv[2]) : 100 * 1000 * 1000;
+
+        Obj::setDefaultAllocatorRaw(U);
+
+        for (int mode = 0; mode < 2; ++mode) {
+            bslma::Allocator *const EXPECTED = mode ? V : U;
+
+            Obj::setThreadDefaultAllocator(mode ? V : 0);
+
+            bslma::Allocator * volatile result = 0;
+
+            bsls::Stopwatch timer;
+            timer.start();
+            for (int i = 0; i < NUM_CALLS; ++i) {
+                result = Obj::defaultAllocator();
+            }
+            timer.stop();
+
+            ASSERT(EXPECTED == result);
+
+            printf("%s: %.2f ns per call\n",
+                   mode ? "thread default allocator"
+                        : "no thread default allocator",
+                   timer.elapsedTime() * 1e9 / NUM_CALLS);
+        }
+
+        Obj::setThreadDefaultAllocator(0);
+      } break;
       default: {
         fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
         testStatus = -1;
@@ -15,9 +15,10 @@ BSLS_IDENT("$Id: $")
 //@SEE_ALSO: bslma_newdeleteallocator, bslma_allocator
 //
 //@DESCRIPTION: This component provides an allocator,
-// 'bslma::MallocFreeAllocator', that implements the 'bslma::Allocator'
-// protocol and supplies memory using the system-supplied (native)
-// 'std::malloc' and 'std::free' operators.
+// 'bslma::MallocFreeAllocator', that implements the
+// 'bslma::ReallocatingAllocator' protocol and supplies memory using the
+// system-supplied (native) 'std::malloc', 'std::realloc', and 'std::free'
+// operators.
 //..
 //   ,--------------------------.
 //  ( bslma::MallocFreeAllocator )
@@ -25,6 +26,11 @@ BSLS_IDENT("$Id: $")
 //                |         ctor/dtor
 //                |         singleton
 //                V
+//   ,----------------------------.
+//  ( bslma::ReallocatingAllocator )
+//   `----------------------------'
+//                |         reallocate
+//                V
 //        ,----------------.
 //       ( bslma::Allocator )
 //        `----------------'
@@ -114,12 +120,12 @@ BSLS_IDENT("$Id: $")
 #include <bslscm_version.h>
 #endif
 
-#ifndef INCLUDED_BSLMA_ALLOCATOR
-#include <bslma_allocator.h>
+#ifndef INCLUDED_BSLMA_REALLOCATINGALLOCATOR
+#include <bslma_reallocatingallocator.h>
 #endif
 
 #ifndef INCLUDED_CSTDLIB
-#include <cstdlib>  // 'std::malloc', 'std::free'
+#include <cstdlib>  // 'std::malloc', 'std::realloc', 'std::free'
 #define INCLUDED_CSTDLIB
 #endif
 
@@ -131,7 +137,7 @@ namespace bslma {
                         // class MallocFreeAllocator
                         // =========================
 
-class MallocFreeAllocator : public Allocator {
+class MallocFreeAllocator : public ReallocatingAllocator {
     // This class provides direct access to the system-supplied (native) global
     // 'std::malloc' and 'std::free'.  A 'static' method is provided for
     // obtaining a unique, process wide object of this class, which is valid
@@ -184,6 +190,26 @@ class MallocFreeAllocator : public Allocator {
         // 'std::free' is *not* called when 'address' is 0 (in order to avoid
         // having to acquire a lock, and potential contention in multi-treaded
         // programs).
+
+    virtual void *reallocate(void      *address,
+                             size_type  oldSize,
+                             size_type  newSize);
+        // Return the address of a block of memory of (at least) the specified
+        // 'newSize' (in bytes) whose first 'min(oldSize, newSize)' bytes have
+        // the same values as the corresponding bytes of the block at the
+        // specified 'address' having the specified 'oldSize', as if by
+        // 'std::realloc'.  If 'address' is 0, this method has the same effect
+        // as 'allocate(newSize)'; otherwise, if 'newSize' is 0, this method
+        // has the same effect as 'deallocate(address)' and returns 0.  If this
+        // allocator cannot return the requested number of bytes, then it will
+        // throw a 'std::bad_alloc' exception in an exception-enabled build, or
+        // else will abort the program in a non-exception build; in either
+        // case, the block at 'address' is unaffected.  The behavior is
+        // undefined unless 'address' is 0 or was allocated using this
+        // allocator object and has not already been deallocated.  Note that
+        // 'std::realloc' may extend the block in place, or (for large blocks
+        // on some platforms) move it by remapping its pages, in which case
+        // the contents of the block are not copied.
 };
 
 // ============================================================================
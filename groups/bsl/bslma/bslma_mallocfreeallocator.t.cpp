@@ -3,6 +3,7 @@
 #include <bslma_mallocfreeallocator.h>
 
 #include <bslma_allocator.h>       // for testing only
+#include <bslma_reallocatingallocator.h>  // for testing only
 
 #include <bsls_bsltestutil.h>
 
@@ -34,9 +35,10 @@ using namespace BloombergLP;
 // [ 2] void *allocate(size_type size)   // allocate 0
 // [ 2] void deallocate((void *address)  // deallocate 0
 // [ 3] static bslma::MallocFreeAllocator& singleton()
+// [ 4] void *reallocate(void *address, size_type oldSize, size_type newSize)
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 4] USAGE EXAMPLE
+// [ 5] USAGE EXAMPLE
 
 //=============================================================================
 //                  STANDARD BDE ASSERT TEST MACRO
@@ -253,7 +255,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:
-      case 4: {
+      case 5: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -322,6 +324,113 @@ int main(int argc, char *argv[])
         ASSERT(0 == globalDeleteCalledLastArg);
 
       } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // REALLOCATE TEST
+        //
+        // Concerns:
+        //: 1 A 'bslma::MallocFreeAllocator' is usable through the
+        //:   'bslma::ReallocatingAllocator' protocol.
+        //:
+        //: 2 'reallocate' of a null address allocates a block of the requested
+        //:   size, and 'reallocate' to size 0 frees the block and returns 0.
+        //:
+        //: 3 'reallocate' preserves the contents of the block up to the
+        //:   smaller of the old and new sizes, both when growing and when
+        //:   shrinking.
+        //:
+        //: 4 Neither global 'new' nor global 'delete' are invoked.
+        //
+        // Plan:
+        //: 1 Obtain a 'bslma::ReallocatingAllocator' reference to a
+        //:   'bslma::MallocFreeAllocator', and verify that a 'dynamic_cast'
+        //:   from the 'bslma::Allocator' base succeeds.  (C-1)
+        //:
+        //: 2 Starting from a null address, repeatedly grow a block of bytes
+        //:   using 'reallocate', filling the newly obtained bytes with a
+        //:   known pattern and verifying the previously written bytes after
+        //:   each call.  Then shrink the block in the same manner, and finally
+        //:   'reallocate' it to size 0.  (C-2..3)
+        //:
+        //: 3 Enable the global 'new' and 'delete' counters throughout, and
+        //:   verify that they are not incremented.  (C-4)
+        //
+        // Testing:
+        //   void *reallocate(void *address, size_type, size_type newSize)
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nREALLOCATE TEST"
+                            "\n===============\n");
+
+        bslma::MallocFreeAllocator    mX;
+        bslma::ReallocatingAllocator& alloc = mX;
+        bslma::Allocator&             base  = mX;
+
+        ASSERT(&alloc == dynamic_cast<bslma::ReallocatingAllocator *>(&base));
+
+        globalNewCalledCountIsEnabled    = 1;
+        globalDeleteCalledCountIsEnabled = 1;
+
+        if (verbose) printf("\nTesting growth from a null address\n");
+
+        unsigned char *block = 0;
+        size_t         size  = 0;
+
+        static const size_t SIZES[] = {
+            1, 2, 7, 16, 100, 4096, 65536, 1 << 20, 4 << 20
+        };
+        const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            const size_t NEW_SIZE = SIZES[ti];
+
+            if (veryVerbose) { T_ P(NEW_SIZE) }
+
+            block = static_cast<unsigned char *>(
+                                      alloc.reallocate(block, size, NEW_SIZE));
+            ASSERTV(ti, 0 != block);
+
+            for (size_t i = 0; i < size; ++i) {
+                if ((unsigned char)(i * 7 + 3) != block[i]) {
+                    ASSERTV(ti, i, 0);
+                    break;
+                }
+            }
+            for (size_t i = size; i < NEW_SIZE; ++i) {
+                block[i] = (unsigned char)(i * 7 + 3);
+            }
+            size = NEW_SIZE;
+        }
+
+        if (verbose) printf("\nTesting shrinkage\n");
+
+        for (int ti = NUM_SIZES - 1; ti >= 0; --ti) {
+            const size_t NEW_SIZE = SIZES[ti];
+
+            block = static_cast<unsigned char *>(
+                                      alloc.reallocate(block, size, NEW_SIZE));
+            ASSERTV(ti, 0 != block);
+
+            for (size_t i = 0; i < NEW_SIZE; ++i) {
+                if ((unsigned char)(i * 7 + 3) != block[i]) {
+                    ASSERTV(ti, i, 0);
+                    break;
+                }
+            }
+            size = NEW_SIZE;
+        }
+
+        if (verbose) printf("\nTesting reallocation to size 0\n");
+
+        ASSERT(0 == alloc.reallocate(block, size, 0));
+        ASSERT(0 == alloc.reallocate(0, 0, 0));
+
+        globalNewCalledCountIsEnabled    = 0;
+        globalDeleteCalledCountIsEnabled = 0;
+
+        ASSERT(0 == globalNewCalledCount);
+        ASSERT(0 == globalDeleteCalledCount);
+      } break;
       case 3: {
         // --------------------------------------------------------------------
         // SINGLETON TEST
@@ -0,0 +1,187 @@
+// bslma_reallocatingallocator.h                                      -*-C++-*-
+#ifndef INCLUDED_BSLMA_REALLOCATINGALLOCATOR
+#define INCLUDED_BSLMA_REALLOCATINGALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a protocol for allocators that can resize a memory block.
+//
+//@CLASSES:
+//  bslma::ReallocatingAllocator: protocol for allocators with 'reallocate'
+//
+//@SEE_ALSO: bslma_allocator, bslma_mallocfreeallocator
+//
+//@DESCRIPTION: This component extends the 'bslma::Allocator' protocol to
+// allocators that can change the size of a previously allocated block of
+// memory, preserving its contents, in the manner of 'std::realloc'.
+//..
+//   ,----------------------------.
+//  ( bslma::ReallocatingAllocator )
+//   `----------------------------'
+//                 |        reallocate
+//                 |
+//                 v
+//         ,----------------.
+//        ( bslma::Allocator )
+//         `----------------'
+//                          allocate
+//                          deallocate
+//..
+// An implementation of 'reallocate' may be able to extend a block in place
+// (e.g., if the memory immediately following the block is free), or to move a
+// large block by remapping its pages rather than copying its contents (e.g.,
+// 'mremap' on Linux).  In either case, a client that would otherwise allocate
+// a new block, copy the contents of the old block into it, and deallocate the
+// old block avoids touching every byte of the block.
+//
+// Note that 'reallocate' relocates the contents of a block *bitwise*.  It is
+// therefore appropriate only for blocks holding objects that are
+// bitwise-moveable (see 'bslmf_isbitwisemoveable').  Containers such as
+// 'bsl::vector' use 'reallocate', when the allocator they were supplied
+// implements this protocol, only for elements having that trait.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Growing a Buffer of Bitwise-Moveable Values
+/// - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have a function that appends a value to a buffer of 'double'
+// values, growing the buffer geometrically.  If the allocator supplied to the
+// function implements the 'bslma::ReallocatingAllocator' protocol, we can use
+// it to grow the buffer without explicitly copying its contents.
+//
+// First, we define the function, using 'dynamic_cast' to discover whether the
+// supplied allocator supports 'reallocate':
+//..
+//  void append(double           **buffer,
+//              int               *length,
+//              int               *capacity,
+//              double             value,
+//              bslma::Allocator  *allocator)
+//      // Append the specified 'value' to the specified 'buffer' having the
+//      // specified 'length' and 'capacity', growing 'buffer' using the
+//      // specified 'allocator' if necessary.
+//  {
+//      if (*length == *capacity) {
+//          const int newCapacity = *capacity ? 2 * *capacity : 4;
+//
+//          bslma::ReallocatingAllocator *reallocator =
+//                     dynamic_cast<bslma::ReallocatingAllocator *>(allocator);
+//          if (reallocator) {
+//              *buffer = static_cast<double *>(reallocator->reallocate(
+//                                              *buffer,
+//                                              *capacity * sizeof(double),
+//                                              newCapacity * sizeof(double)));
+//          }
+//          else {
+//              double *newBuffer = static_cast<double *>(
+//                          allocator->allocate(newCapacity * sizeof(double)));
+//              if (*length) {
+//                  memcpy(newBuffer, *buffer, *length * sizeof(double));
+//              }
+//              allocator->deallocate(*buffer);
+//              *buffer = newBuffer;
+//          }
+//          *capacity = newCapacity;
+//      }
+//      (*buffer)[(*length)++] = value;
+//  }
+//..
+// Then, we use the function with 'bslma::MallocFreeAllocator', which
+// implements the 'bslma::ReallocatingAllocator' protocol using 'std::realloc':
+//..
+//  bslma::Allocator *allocator = &bslma::MallocFreeAllocator::singleton();
+//
+//  double *buffer   = 0;
+//  int     length   = 0;
+//  int     capacity = 0;
+//
+//  for (int i = 0; i < 100; ++i) {
+//      append(&buffer, &length, &capacity, i * 0.5, allocator);
+//  }
+//..
+// Finally, we verify the contents of the buffer, and release it:
+//..
+//  assert(100 == length);
+//  for (int i = 0; i < 100; ++i) {
+//      assert(i * 0.5 == buffer[i]);
+//  }
+//  allocator->deallocate(buffer);
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+namespace BloombergLP {
+
+namespace bslma {
+
+                        // ===========================
+                        // class ReallocatingAllocator
+                        // ===========================
+
+class ReallocatingAllocator : public Allocator {
+    // This protocol class extends 'bslma::Allocator' for allocators with the
+    // ability to change the size of a previously allocated memory block while
+    // preserving its contents.
+
+  public:
+    // CREATORS
+    virtual ~ReallocatingAllocator();
+        // Destroy this allocator.  Note that the behavior of destroying an
+        // allocator while memory is allocated from it is not specified.
+        // (Unless you *know* that it is valid to do so, don't!)
+
+    // MANIPULATORS
+    virtual void *reallocate(void      *address,
+                             size_type  oldSize,
+                             size_type  newSize) = 0;
+        // Return the address of a block of memory of (at least) the specified
+        // 'newSize' (in bytes) whose first 'min(oldSize, newSize)' bytes have
+        // the same values as the corresponding bytes of the block at the
+        // specified 'address' having the specified 'oldSize'.  If the
+        // returned address differs from 'address', the block at 'address' is
+        // returned to this allocator.  If 'address' is 0, this method has the
+        // same effect as 'allocate(newSize)'; otherwise, if 'newSize' is 0,
+        // this method has the same effect as 'deallocate(address)' and returns
+        // 0.  If this allocator cannot return the requested number of bytes,
+        // then it will throw a 'std::bad_alloc' exception in an
+        // exception-enabled build, or else will abort the program in a
+        // non-exception build; in either case, the block at 'address' is
+        // unaffected.  The behavior is undefined unless 'address' is 0 or was
+        // allocated using this allocator object and has not already been
+        // deallocated, and 'oldSize' is the size most recently requested for
+        // that block.  Note that the contents of the block are relocated
+        // *bitwise*.
+};
+
+}  // close package namespace
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,305 @@
+// bslma_reallocatingallocator.t.cpp                                  -*-C++-*-
+
+#include <bslma_reallocatingallocator.h>
+
+#include <bslma_allocator.h>
+#include <bslma_mallocfreeallocator.h>   // for testing only
+
+#include <bsls_bsltestutil.h>
+#include <bsls_protocoltest.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test defines a protocol class the purpose of which is to
+// *extend* 'bslma::Allocator' for allocators with the ability to resize a
+// previously allocated memory block while preserving its contents.
+//
+// Global Concerns:
+//: o The test driver is robust w.r.t. reuse in other, similar components.
+//: o It is possible to create a concrete implementation of the protocol.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 1] virtual ~ReallocatingAllocator();
+//
+// MANIPULATORS
+// [ 1] virtual void *reallocate(void *, size_type, size_type) = 0;
+//-----------------------------------------------------------------------------
+// [ 2] USAGE EXAMPLE
+
+//=============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(bool b, const char *s, int i) {
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+//=============================================================================
+//                      GLOBAL CLASSES/TYPEDEFS FOR TESTING
+//-----------------------------------------------------------------------------
+
+namespace {
+
+typedef bslma::ReallocatingAllocator ProtocolClass;
+
+struct ProtocolClassTestImp : bsls::ProtocolTestImp<ProtocolClass> {
+    // 'bslma::Allocator' protocol
+    void *allocate(size_type)                    { return markDone(); }
+    void deallocate(void *)                      {        markDone(); }
+
+    // 'bslma::ReallocatingAllocator' protocol
+    void *reallocate(void *, size_type, size_type)
+                                                 { return markDone(); }
+};
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Growing a Buffer of Bitwise-Moveable Values
+/// - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have a function that appends a value to a buffer of 'double'
+// values, growing the buffer geometrically.  If the allocator supplied to the
+// function implements the 'bslma::ReallocatingAllocator' protocol, we can use
+// it to grow the buffer without explicitly copying its contents.
+//
+// First, we define the function, using 'dynamic_cast' to discover whether the
+// supplied allocator supports 'reallocate':
+//..
+    void append(double           **buffer,
+                int               *length,
+                int               *capacity,
+                double             value,
+                bslma::Allocator  *allocator)
+        // Append the specified 'value' to the specified 'buffer' having the
+        // specified 'length' and 'capacity', growing 'buffer' using the
+        // specified 'allocator' if necessary.
+    {
+        if (*length == *capacity) {
+            const int newCapacity = *capacity ? 2 * *capacity : 4;
+
+            bslma::ReallocatingAllocator *reallocator =
+                       dynamic_cast<bslma::ReallocatingAllocator *>(allocator);
+            if (reallocator) {
+                *buffer = static_cast<double *>(reallocator->reallocate(
+                                                *buffer,
+                                                *capacity * sizeof(double),
+                                                newCapacity * sizeof(double)));
+            }
+            else {
+                double *newBuffer = static_cast<double *>(
+                            allocator->allocate(newCapacity * sizeof(double)));
+                if (*length) {
+                    memcpy(newBuffer, *buffer, *length * sizeof(double));
+                }
+                allocator->deallocate(*buffer);
+                *buffer = newBuffer;
+            }
+            *capacity = newCapacity;
+        }
+        (*buffer)[(*length)++] = value;
+    }
+//..
+
+//=============================================================================
+//                                MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVerbose;
+    (void)veryVeryVeryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:
+      case 2: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we use the function with 'bslma::MallocFreeAllocator', which
+// implements the 'bslma::ReallocatingAllocator' protocol using 'std::realloc':
+//..
+    bslma::Allocator *allocator = &bslma::MallocFreeAllocator::singleton();
+
+    double *buffer   = 0;
+    int     length   = 0;
+    int     capacity = 0;
+
+    for (int i = 0; i < 100; ++i) {
+        append(&buffer, &length, &capacity, i * 0.5, allocator);
+    }
+//..
+// Finally, we verify the contents of the buffer, and release it:
+//..
+    ASSERT(100 == length);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT(i * 0.5 == buffer[i]);
+    }
+    allocator->deallocate(buffer);
+//..
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // PROTOCOL TEST:
+        //   Ensure this class is a properly defined protocol.
+        //
+        // Concerns:
+        //: 1 The protocol is abstract: no objects of it can be created.
+        //:
+        //: 2 The protocol has no data members.
+        //:
+        //: 3 The protocol has a virtual destructor.
+        //:
+        //: 4 All methods of the protocol are pure virtual.
+        //:
+        //: 5 All methods of the protocol are publicly accessible.
+        //
+        // Plan:
+        //: 1 Define a concrete derived implementation, 'ProtocolClassTestImp',
+        //:   of the protocol.
+        //:
+        //: 2 Create an object of the 'bsls::ProtocolTest' class template
+        //:   parameterized by 'ProtocolClassTestImp', and use it to verify
+        //:   that:
+        //:
+        //:   1 The protocol is abstract. (C-1)
+        //:
+        //:   2 The protocol has no data members. (C-2)
+        //:
+        //:   3 The protocol has a virtual destructor. (C-3)
+        //:
+        //: 3 Use the 'BSLS_PROTOCOLTEST_ASSERT' macro to verify that
+        //:   non-creator methods of the protocol are:
+        //:
+        //:   1 virtual, (C-4)
+        //:
+        //:   2 publicly accessible. (C-5)
+        //
+        // Testing:
+        //   virtual ~ReallocatingAllocator();
+        //   virtual void *reallocate(void *, size_type, size_type) = 0;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nPROTOCOL TEST"
+                            "\n=============\n");
+
+        if (verbose) printf("\nCreate a test object.\n");
+
+        bsls::ProtocolTest<ProtocolClassTestImp> testObj(veryVerbose);
+
+        if (verbose) printf("\nVerify that the protocol is abstract.\n");
+
+        ASSERT(testObj.testAbstract());
+
+        if (verbose) printf("\nVerify that there are no data members.\n");
+
+        ASSERT(testObj.testNoDataMembers());
+
+        if (verbose) printf("\nVerify that the destructor is virtual.\n");
+
+        ASSERT(testObj.testVirtualDestructor());
+
+        if (verbose) printf("\nVerify that methods are public and virtual.\n");
+
+        // 'bslma::Allocator' protocol
+        BSLS_PROTOCOLTEST_ASSERT(testObj, allocate(0));
+        BSLS_PROTOCOLTEST_ASSERT(testObj, deallocate(0));
+
+        // 'bslma::ReallocatingAllocator' protocol
+        BSLS_PROTOCOLTEST_ASSERT(testObj, reallocate(0, 0, 0));
+
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -472,7 +472,7 @@ TestAllocator::~TestAllocator()
 // MANIPULATORS
 void *TestAllocator::allocate(size_type size)
 {
-    bsls::BslLockGuard guard(&d_lock);
+    bsls::BslAdaptiveLockGuard guard(&d_lock);
 
     bsls::Types::Int64 allocationIndex = d_numAllocations.addRelaxed(1) - 1;
 
@@ -566,7 +566,7 @@ void *TestAllocator::allocate(size_type size)
 
 void TestAllocator::deallocate(void *address)
 {
-    bsls::BslLockGuard guard(&d_lock);
+    bsls::BslAdaptiveLockGuard guard(&d_lock);
 
     d_numDeallocations.addRelaxed(1);
     d_lastDeallocatedAddress_p.storeRelaxed(reinterpret_cast<int *>(address));
@@ -714,7 +714,7 @@ void TestAllocator::deallocate(void *address)
 // ACCESSORS
 void TestAllocator::print() const
 {
-    bsls::BslLockGuard guard(&d_lock);
+    bsls::BslAdaptiveLockGuard guard(&d_lock);
 
     if (d_name_p) {
         std::printf("\n"
@@ -754,7 +754,7 @@ int TestAllocator::status() const
 {
     enum { BSLMA_MEMORY_LEAK = -1, BSLMA_SUCCESS = 0 };
 
-    bsls::BslLockGuard guard(&d_lock);
+    bsls::BslAdaptiveLockGuard guard(&d_lock);
 
     const bsls::Types::Int64 numErrors = numMismatches() + numBoundsErrors();
 
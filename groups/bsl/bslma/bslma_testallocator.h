@@ -296,8 +296,8 @@ BSLS_IDENT("$Id: $")
 #include <bsls_atomic.h>
 #endif
 
-#ifndef INCLUDED_BSLS_BSLLOCK
-#include <bsls_bsllock.h>
+#ifndef INCLUDED_BSLS_BSLADAPTIVELOCK
+#include <bsls_bsladaptivelock.h>
 #endif
 
 #ifndef INCLUDED_BSLS_TYPES
@@ -430,10 +430,13 @@ class TestAllocator : public Allocator {
     TestAllocator_List
                *d_list_p;                // list of allocated memory (owned)
 
-    mutable bsls::BslLock
+    mutable bsls::BslAdaptiveLock
                 d_lock;                  // ensure mutual exclusion in
                                          // 'allocate', 'deallocate', 'print',
-                                         // and 'status'
+                                         // and 'status' (spins briefly before
+                                         // blocking, as the critical sections
+                                         // of 'allocate' and 'deallocate' are
+                                         // short)
 
     Allocator  *d_allocator_p;           // memory allocator (held, not owned)
 
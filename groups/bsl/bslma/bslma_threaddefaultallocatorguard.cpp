@@ -0,0 +1,48 @@
+// bslma_threaddefaultallocatorguard.cpp                              -*-C++-*-
+#include <bslma_threaddefaultallocatorguard.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bslma_default.h>
+#include <bslma_testallocator.h>           // for testing only
+#include <bsls_assert.h>
+
+namespace BloombergLP {
+
+namespace bslma {
+
+                     // ---------------------------------
+                     // class ThreadDefaultAllocatorGuard
+                     // ---------------------------------
+
+// CREATORS
+ThreadDefaultAllocatorGuard::ThreadDefaultAllocatorGuard(Allocator *temporary)
+: d_original_p(Default::setThreadDefaultAllocator(temporary))
+{
+}
+
+ThreadDefaultAllocatorGuard::~ThreadDefaultAllocatorGuard()
+{
+    Default::setThreadDefaultAllocator(d_original_p);
+}
+
+}  // close package namespace
+
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
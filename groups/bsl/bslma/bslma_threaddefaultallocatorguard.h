@@ -0,0 +1,209 @@
+// bslma_threaddefaultallocatorguard.h                                -*-C++-*-
+#ifndef INCLUDED_BSLMA_THREADDEFAULTALLOCATORGUARD
+#define INCLUDED_BSLMA_THREADDEFAULTALLOCATORGUARD
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a scoped guard to change the default allocator of a thread.
+//
+//@CLASSES:
+//  bslma::ThreadDefaultAllocatorGuard: thread default-allocator scoped guard
+//
+//@SEE_ALSO: bslma_default, bslma_defaultallocatorguard
+//
+//@DESCRIPTION: This component provides an object,
+// 'bslma::ThreadDefaultAllocatorGuard', that serves as a "scoped guard" to
+// install a default allocator for the calling thread only.  Unlike
+// 'bslma::DefaultAllocatorGuard', which replaces the process-wide default
+// allocator and is intended for testing only, this guard affects no other
+// thread, and may be used in production code, e.g., to route the memory
+// allocated by default while a thread handles a request to an arena local to
+// that request.
+//
+// The guard object takes as its constructor argument the address of an object
+// of a class derived from 'bslma::Allocator', or 0.  The default allocator of
+// the calling thread at the time of guard construction (if any) is held by
+// the guard, and the constructor-argument allocator is installed as the
+// default allocator of the calling thread (via a call to
+// 'bslma::Default::setThreadDefaultAllocator').  While the guard exists,
+// 'bslma::Default::defaultAllocator', and 'bslma::Default::allocator' with no
+// argument or an explicit 0, return that allocator when called by that thread
+// (or, if the argument was 0, the process-wide default allocator).  Upon
+// destruction of the guard object, its held allocator is restored as the
+// default allocator of the thread.  Guards may therefore be nested, but must
+// be destroyed in the reverse order of their construction, by the thread that
+// created them.
+//
+// Note that an object that obtains its allocator by default while a guard
+// exists keeps using that allocator after the guard is destroyed, so it must
+// not outlive the allocator.
+//
+///Usage
+///-----
+// This section illustrates the intended use of this component.
+//
+///Example 1: Routing the Allocations of a Request to an Arena
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a server handles each request on a thread of a pool, and that
+// the code handling a request creates many short-lived objects using the
+// default allocator.  Rather than passing an allocator to every function
+// called while handling a request, we install, for the handling thread only,
+// an arena from which all of those objects obtain their memory.
+//
+// First, we define a simple class that allocates memory using the default
+// allocator unless an allocator is supplied:
+//..
+//  class my_Message {
+//      // This class holds a copy of a null-terminated text.
+//
+//      // DATA
+//      char             *d_text_p;       // text (owned)
+//      bslma::Allocator *d_allocator_p;  // allocator (held, not owned)
+//
+//      // NOT IMPLEMENTED
+//      my_Message(const my_Message&);
+//      my_Message& operator=(const my_Message&);
+//
+//    public:
+//      // CREATORS
+//      explicit
+//      my_Message(const char *text, bslma::Allocator *basicAllocator = 0)
+//          // Create a message holding a copy of the specified 'text'.
+//          // Optionally specify a 'basicAllocator' used to supply memory.
+//          // If 'basicAllocator' is 0, the currently installed default
+//          // allocator is used.
+//      : d_allocator_p(bslma::Default::allocator(basicAllocator))
+//      {
+//          const size_t size = strlen(text) + 1;
+//
+//          d_text_p = static_cast<char *>(d_allocator_p->allocate(size));
+//          memcpy(d_text_p, text, size);
+//      }
+//
+//      ~my_Message()
+//          // Destroy this message.
+//      {
+//          d_allocator_p->deallocate(d_text_p);
+//      }
+//
+//      // ACCESSORS
+//      const char *text() const
+//          // Return the text of this message.
+//      {
+//          return d_text_p;
+//      }
+//  };
+//..
+// Then, we define a function that handles a request, and that, like most of
+// the code a request passes through, takes no allocator:
+//..
+//  int handleRequest(const char *request)
+//      // Handle the specified 'request', and return the length of the reply.
+//  {
+//      my_Message message(request);
+//
+//      return static_cast<int>(strlen(message.text()));
+//  }
+//..
+// Next, we create the arena of a request.  (In production code, it would
+// typically be a 'bdlma::SequentialAllocator' releasing all of its memory at
+// once when destroyed; here we use a 'bslma::TestAllocator' so that we can
+// observe the allocations.)
+//..
+//  bslma::TestAllocator requestArena;
+//..
+// Now, we handle the request with a guard installing the arena as the
+// default allocator of the handling thread:
+//..
+//  {
+//      bslma::ThreadDefaultAllocatorGuard guard(&requestArena);
+//
+//      assert(&requestArena == bslma::Default::defaultAllocator());
+//      assert(&requestArena == bslma::Default::threadDefaultAllocator());
+//
+//      assert(14 == handleRequest("GET /quote/IBM"));
+//  }
+//..
+// Finally, we observe that the memory of the request was obtained from the
+// arena, and that, once the guard is destroyed, the thread uses the
+// process-wide default allocator again:
+//..
+//  assert(1 == requestArena.numBlocksTotal());
+//  assert(0 == requestArena.numBlocksInUse());
+//
+//  assert(0             == bslma::Default::threadDefaultAllocator());
+//  assert(&requestArena != bslma::Default::defaultAllocator());
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+namespace BloombergLP {
+
+namespace bslma {
+
+class Allocator;
+
+                     // =================================
+                     // class ThreadDefaultAllocatorGuard
+                     // =================================
+
+class ThreadDefaultAllocatorGuard {
+    // Upon construction, an object of this class saves the default allocator
+    // of the calling thread, if any, and installs the user-specified
+    // allocator as the default allocator of the calling thread.  On
+    // destruction, the original default allocator of the thread is restored.
+
+    Allocator *d_original_p;  // original default allocator of the thread (to
+                              // be restored at destruction), or 0 if none
+
+    // NOT IMPLEMENTED
+    ThreadDefaultAllocatorGuard(const ThreadDefaultAllocatorGuard&);
+    ThreadDefaultAllocatorGuard& operator=(
+                                          const ThreadDefaultAllocatorGuard&);
+
+  public:
+    // CREATORS
+    explicit
+    ThreadDefaultAllocatorGuard(Allocator *temporary);
+        // Create a scoped guard that installs the specified 'temporary'
+        // allocator as the default allocator of the calling thread, or, if
+        // 'temporary' is 0, that makes the calling thread use the
+        // process-wide default allocator.  The behavior is undefined unless
+        // 'temporary' is 0 or remains valid for the lifetime of this guard.
+        // Note that the default allocator of the thread is automatically
+        // restored to the original allocator on destruction.
+
+    ~ThreadDefaultAllocatorGuard();
+        // Restore the default allocator of the calling thread that was in
+        // place when this scoped guard was created and destroy this guard.
+        // The behavior is undefined unless this guard is destroyed by the
+        // thread that created it, and every guard created by that thread
+        // after this guard has been destroyed.
+};
+
+}  // close package namespace
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
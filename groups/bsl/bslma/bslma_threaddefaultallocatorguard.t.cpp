@@ -0,0 +1,530 @@
+// bslma_threaddefaultallocatorguard.t.cpp                            -*-C++-*-
+
+#include <bslma_threaddefaultallocatorguard.h>
+
+#include <bslma_allocator.h>               // for testing only
+#include <bslma_default.h>                 // for testing only
+#include <bslma_defaultallocatorguard.h>   // for testing only
+#include <bslma_newdeleteallocator.h>      // for testing only
+#include <bslma_testallocator.h>           // for testing only
+
+#include <bsls_bsltestutil.h>
+#include <bsls_platform.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test "guards" the default allocator of the calling
+// thread, which is to say that an instance of this object installs a new
+// default allocator for the calling thread (from the constructor argument) on
+// construction, and restores the original default allocator of the thread on
+// destruction.  We verify that guards nest, that a guard created with 0
+// restores the process-wide default allocator for its scope, that the
+// process-wide default allocator is neither used nor changed while a guard
+// exists, and that a guard affects only the thread that created it.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] bslma::ThreadDefaultAllocatorGuard(bslma::Allocator *temporary);
+// [ 2] ~bslma::ThreadDefaultAllocatorGuard();
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CONCERN: a guard affects only the calling thread
+// [ 4] USAGE EXAMPLE
+//=============================================================================
+
+//=============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(bool b, const char *s, int i) {
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+typedef bslma::ThreadDefaultAllocatorGuard Obj;
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+namespace {
+
+struct ThreadArgs {
+    // This 'struct' holds the arguments of 'threadFunction'.
+
+    bslma::Allocator *d_processDefault_p;  // expected process-wide default
+    int               d_numIterations;     // number of guards to create
+    int               d_numErrors;         // number of mismatches found
+};
+
+void checkThreadDefault(ThreadArgs *args)
+    // Create and destroy, the specified number of times, nested guards
+    // installing allocators local to the calling thread, and count, in the
+    // specified 'args', the occasions on which the default allocator is not
+    // the expected allocator.
+{
+    bslma::TestAllocator outer;
+    bslma::TestAllocator inner;
+
+    for (int i = 0; i < args->d_numIterations; ++i) {
+        if (args->d_processDefault_p != bslma::Default::defaultAllocator()) {
+            ++args->d_numErrors;
+        }
+
+        Obj outerGuard(&outer);
+
+        if (&outer != bslma::Default::defaultAllocator()) {
+            ++args->d_numErrors;
+        }
+
+        {
+            Obj innerGuard(&inner);
+
+            if (&inner != bslma::Default::allocator()) {
+                ++args->d_numErrors;
+            }
+        }
+
+        if (&outer != bslma::Default::allocator(0)) {
+            ++args->d_numErrors;
+        }
+    }
+
+    if (0 != bslma::Default::threadDefaultAllocator()) {
+        ++args->d_numErrors;
+    }
+}
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+DWORD WINAPI threadFunction(LPVOID args)
+#else
+extern "C" void *threadFunction(void *args)
+#endif
+    // Call 'checkThreadDefault' with the specified 'args'.
+{
+    checkThreadDefault(static_cast<ThreadArgs *>(args));
+    return 0;
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                              USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates the intended use of this component.
+//
+///Example 1: Routing the Allocations of a Request to an Arena
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a server handles each request on a thread of a pool, and that
+// the code handling a request creates many short-lived objects using the
+// default allocator.  Rather than passing an allocator to every function
+// called while handling a request, we install, for the handling thread only,
+// an arena from which all of those objects obtain their memory.
+//
+// First, we define a simple class that allocates memory using the default
+// allocator unless an allocator is supplied:
+//..
+class my_Message {
+    // This class holds a copy of a null-terminated text.
+
+    // DATA
+    char             *d_text_p;       // text (owned)
+    bslma::Allocator *d_allocator_p;  // allocator (held, not owned)
+
+    // NOT IMPLEMENTED
+    my_Message(const my_Message&);
+    my_Message& operator=(const my_Message&);
+
+  public:
+    // CREATORS
+    explicit
+    my_Message(const char *text, bslma::Allocator *basicAllocator = 0)
+        // Create a message holding a copy of the specified 'text'.
+        // Optionally specify a 'basicAllocator' used to supply memory.
+        // If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.
+    : d_allocator_p(bslma::Default::allocator(basicAllocator))
+    {
+        const size_t size = strlen(text) + 1;
+
+        d_text_p = static_cast<char *>(d_allocator_p->allocate(size));
+        memcpy(d_text_p, text, size);
+    }
+
+    ~my_Message()
+        // Destroy this message.
+    {
+        d_allocator_p->deallocate(d_text_p);
+    }
+
+    // ACCESSORS
+    const char *text() const
+        // Return the text of this message.
+    {
+        return d_text_p;
+    }
+};
+//..
+// Then, we define a function that handles a request, and that, like most of
+// the code a request passes through, takes no allocator:
+//..
+int handleRequest(const char *request)
+    // Handle the specified 'request', and return the length of the reply.
+{
+    my_Message message(request);
+
+    return static_cast<int>(strlen(message.text()));
+}
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Next, we create the arena of a request.  (In production code, it would
+// typically be a 'bdlma::SequentialAllocator' releasing all of its memory at
+// once when destroyed; here we use a 'bslma::TestAllocator' so that we can
+// observe the allocations.)
+//..
+    bslma::TestAllocator requestArena;
+//..
+// Now, we handle the request with a guard installing the arena as the
+// default allocator of the handling thread:
+//..
+    {
+        bslma::ThreadDefaultAllocatorGuard guard(&requestArena);
+
+        ASSERT(&requestArena == bslma::Default::defaultAllocator());
+        ASSERT(&requestArena == bslma::Default::threadDefaultAllocator());
+
+        ASSERT(14 == handleRequest("GET /quote/IBM"));
+    }
+//..
+// Finally, we observe that the memory of the request was obtained from the
+// arena, and that, once the guard is destroyed, the thread uses the
+// process-wide default allocator again:
+//..
+    ASSERT(1 == requestArena.numBlocksTotal());
+    ASSERT(0 == requestArena.numBlocksInUse());
+
+    ASSERT(0             == bslma::Default::threadDefaultAllocator());
+    ASSERT(&requestArena != bslma::Default::defaultAllocator());
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONCERN: A GUARD AFFECTS ONLY THE CALLING THREAD
+        //
+        // Concerns:
+        //: 1 A guard changes the default allocator of the thread that
+        //:   created it, and of no other thread.
+        //:
+        //: 2 Threads creating and destroying guards concurrently do not
+        //:   interfere with one another, or with a thread having no guard.
+        //
+        // Plan:
+        //: 1 Start several threads, each of which repeatedly creates nested
+        //:   guards installing allocators of its own and verifies the default
+        //:   allocator before, while, and after each guard exists.  (C-1..2)
+        //:
+        //: 2 Meanwhile, verify repeatedly that the default allocator of the
+        //:   main thread is the process-wide default allocator.  (C-1..2)
+        //
+        // Testing:
+        //   CONCERN: a guard affects only the calling thread
+        // --------------------------------------------------------------------
+
+        if (verbose) {
+            printf("\nCONCERN: A GUARD AFFECTS ONLY THE CALLING THREAD"
+                   "\n================================================\n");
+        }
+
+        enum { k_NUM_THREADS = 4, k_NUM_ITERATIONS = 20000 };
+
+        bslma::TestAllocator         da("default", veryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        ThreadArgs args[k_NUM_THREADS];
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+        HANDLE threads[k_NUM_THREADS];
+#else
+        pthread_t threads[k_NUM_THREADS];
+#endif
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            args[i].d_processDefault_p = &da;
+            args[i].d_numIterations    = k_NUM_ITERATIONS;
+            args[i].d_numErrors        = 0;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+            threads[i] = CreateThread(0, 0, &threadFunction, &args[i], 0, 0);
+            ASSERT(0 != threads[i]);
+#else
+            const int rc = pthread_create(&threads[i],
+                                          0,
+                                          &threadFunction,
+                                          &args[i]);
+            ASSERT(0 == rc);
+#endif
+        }
+
+        int numErrors = 0;
+        for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+            if (&da != bslma::Default::defaultAllocator()) {
+                ++numErrors;
+            }
+        }
+        ASSERTV(numErrors, 0 == numErrors);
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+            WaitForSingleObject(threads[i], INFINITE);
+            CloseHandle(threads[i]);
+#else
+            pthread_join(threads[i], 0);
+#endif
+            ASSERTV(i, args[i].d_numErrors, 0 == args[i].d_numErrors);
+        }
+
+        ASSERT(0   == bslma::Default::threadDefaultAllocator());
+        ASSERT(&da == bslma::Default::defaultAllocator());
+        ASSERT(0   == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CTOR AND DTOR
+        //
+        // Concerns:
+        //: 1 The constructor installs the specified allocator as the default
+        //:   allocator of the calling thread, which 'defaultAllocator' and
+        //:   'allocator' with argument 0 then return.
+        //:
+        //: 2 'allocator' with a non-zero argument still returns its argument.
+        //:
+        //: 3 The destructor restores the default allocator of the thread in
+        //:   effect when the guard was created, so that guards nest.
+        //:
+        //: 4 A guard created with 0 makes the thread use the process-wide
+        //:   default allocator for its lifetime.
+        //:
+        //: 5 The process-wide default allocator is not changed by a guard,
+        //:   and a change to it, while a guard exists, takes effect for the
+        //:   thread once no guard installs an allocator.
+        //:
+        //: 6 Memory obtained by default while a guard exists comes from the
+        //:   installed allocator.
+        //
+        // Plan:
+        //: 1 Create nested guards with distinct test allocators, and with 0,
+        //:   and verify the default allocator, the thread default allocator,
+        //:   and the process-wide default allocator at each level.  (C-1..5)
+        //:
+        //: 2 Allocate by default at each level, and verify which allocator
+        //:   supplied the memory.  (C-6)
+        //
+        // Testing:
+        //   bslma::ThreadDefaultAllocatorGuard(bslma::Allocator *temporary);
+        //   ~bslma::ThreadDefaultAllocatorGuard();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCTOR AND DTOR"
+                            "\n=============\n");
+
+        bslma::TestAllocator da("default", veryVerbose);
+        bslma::TestAllocator da2("default2", veryVerbose);
+        bslma::TestAllocator ta1("thread1", veryVerbose);
+        bslma::TestAllocator ta2("thread2", veryVerbose);
+        bslma::TestAllocator oa("object", veryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        ASSERT(0   == bslma::Default::threadDefaultAllocator());
+        ASSERT(&da == bslma::Default::defaultAllocator());
+        {
+            Obj guard1(&ta1);
+
+            ASSERT(&ta1 == bslma::Default::threadDefaultAllocator());
+            ASSERT(&ta1 == bslma::Default::defaultAllocator());
+            ASSERT(&ta1 == bslma::Default::allocator());
+            ASSERT(&ta1 == bslma::Default::allocator(0));
+            ASSERT(&oa  == bslma::Default::allocator(&oa));
+
+            void *memory = bslma::Default::allocator()->allocate(1);
+            bslma::Default::allocator()->deallocate(memory);
+            ASSERT(1 == ta1.numBlocksTotal());
+            ASSERT(0 == da.numBlocksTotal());
+            {
+                Obj guard2(&ta2);
+
+                ASSERT(&ta2 == bslma::Default::threadDefaultAllocator());
+                ASSERT(&ta2 == bslma::Default::defaultAllocator());
+
+                void *memory = bslma::Default::allocator()->allocate(1);
+            bslma::Default::allocator()->deallocate(memory);
+                ASSERT(1 == ta2.numBlocksTotal());
+                ASSERT(1 == ta1.numBlocksTotal());
+                {
+                    Obj guard3(0);
+
+                    ASSERT(0   == bslma::Default::threadDefaultAllocator());
+                    ASSERT(&da == bslma::Default::defaultAllocator());
+
+                    bslma::Default::setDefaultAllocatorRaw(&da2);
+                    ASSERT(&da2 == bslma::Default::defaultAllocator());
+                    bslma::Default::setDefaultAllocatorRaw(&da);
+
+                    void *memory = bslma::Default::allocator()->allocate(1);
+            bslma::Default::allocator()->deallocate(memory);
+                    ASSERT(1 == da.numBlocksTotal());
+                    ASSERT(1 == ta2.numBlocksTotal());
+                }
+                ASSERT(&ta2 == bslma::Default::threadDefaultAllocator());
+                ASSERT(&ta2 == bslma::Default::defaultAllocator());
+
+                bslma::Default::setDefaultAllocatorRaw(&da2);
+                ASSERT(&ta2 == bslma::Default::defaultAllocator());
+            }
+            ASSERT(&ta1 == bslma::Default::threadDefaultAllocator());
+            ASSERT(&ta1 == bslma::Default::defaultAllocator());
+        }
+        ASSERT(0    == bslma::Default::threadDefaultAllocator());
+        ASSERT(&da2 == bslma::Default::defaultAllocator());
+
+        bslma::Default::setDefaultAllocatorRaw(&da);
+        ASSERT(&da == bslma::Default::defaultAllocator());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a guard, and verify the default allocator within and
+        //:   after its scope.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        bslma::NewDeleteAllocator *na =
+                                       &bslma::NewDeleteAllocator::singleton();
+        ASSERT(na == bslma::Default::defaultAllocator());
+
+        {
+            bslma::TestAllocator testAllocator(veryVerbose);
+            Obj guard(&testAllocator);
+            ASSERT(&testAllocator == bslma::Default::defaultAllocator());
+        }
+        ASSERT(na == bslma::Default::defaultAllocator());
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,322 @@
+// bsls_assertthrottle.cpp                                            -*-C++-*-
+#include <bsls_assertthrottle.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_atomicoperations.h>
+#include <bsls_bsltestutil.h>      // for testing only
+#include <bsls_log.h>
+#include <bsls_timeutil.h>
+
+#include <string.h> // 'memset', 'strcmp'
+
+namespace BloombergLP {
+namespace bsls {
+namespace {
+
+typedef AtomicOperations AtomicOps;
+
+enum SiteState {
+    // Enumerate the states of an entry of the site table.
+
+    e_EMPTY,    // the entry holds no site
+    e_CLAIMED,  // a thread is storing a site in the entry
+    e_READY     // the entry holds a site
+};
+
+const Types::Int64 k_NO_INTERVAL = -(1LL << 62);
+    // start of the interval of a site that has reported no failure
+
+struct Site {
+    // This 'struct' holds the identity and the counters of an assertion site.
+    // An object of this type is usable when all of its members are 0 (and
+    // 'd_intervalStart' is 'k_NO_INTERVAL').
+
+    AtomicOps::AtomicTypes::Int    d_state;          // 'SiteState' value
+    const char                    *d_file_p;         // file name
+    int                            d_line;           // line number
+    AtomicOps::AtomicTypes::Int64  d_numFailures;    // failures
+    AtomicOps::AtomicTypes::Int64  d_numReported;    // reported failures
+    AtomicOps::AtomicTypes::Int64  d_numPending;     // failures suppressed
+                                                     // since the last report
+    AtomicOps::AtomicTypes::Int64  d_intervalStart;  // start of the interval
+    AtomicOps::AtomicTypes::Int    d_numInInterval;  // reports in interval
+};
+
+const char k_OVERFLOW_FILE[] = "(other)";  // file name of 's_overflowSite'
+
+// STATIC DATA
+Site s_sites[AssertThrottle::k_MAX_NUM_SITES];
+    // table of assertion sites, indexed by hash value (with linear probing)
+
+Site s_overflowSite = { { e_READY }, k_OVERFLOW_FILE, 0,
+                        { 0 }, { 0 }, { 0 }, { k_NO_INTERVAL }, { 0 } };
+    // site shared by failures at sites that could not be added to 's_sites'
+
+AtomicOps::AtomicTypes::Pointer s_reportHandler =
+                       {reinterpret_cast<void *>(&AssertThrottle::logFailure)};
+    // current report handler
+
+AtomicOps::AtomicTypes::Int     s_maxReportsPerInterval = { 1 };
+    // reports allowed per site in each interval
+
+AtomicOps::AtomicTypes::Int64   s_interval = { 1000 * 1000 * 1000 };
+    // length of an interval, in nanoseconds
+
+unsigned int hashSite(const char *file, int line)
+    // Return a hash value for the assertion site at the specified 'file' and
+    // 'line' (FNV-1a over the characters of 'file', combined with 'line').
+{
+    unsigned int hash = 2166136261U;
+    for (; *file; ++file) {
+        hash ^= static_cast<unsigned char>(*file);
+        hash *= 16777619U;
+    }
+    hash ^= static_cast<unsigned int>(line);
+    hash *= 16777619U;
+    return hash ^ (hash >> 16);
+}
+
+Site *findSite(const char *file, int line)
+    // Return the site at the specified 'file' and 'line', adding it to the
+    // table if it is not there, or the overflow site if the table is full.
+{
+    const unsigned int mask = AssertThrottle::k_MAX_NUM_SITES - 1;
+    const unsigned int hash = hashSite(file, line);
+
+    for (unsigned int i = 0; i <= mask; ++i) {
+        Site *site  = &s_sites[(hash + i) & mask];
+        int   state = AtomicOps::getIntAcquire(&site->d_state);
+
+        if (e_EMPTY == state) {
+            state = AtomicOps::testAndSwapIntAcqRel(&site->d_state,
+                                                    e_EMPTY,
+                                                    e_CLAIMED);
+            if (e_EMPTY == state) {
+                site->d_file_p = file;
+                site->d_line   = line;
+                AtomicOps::setInt64Relaxed(&site->d_intervalStart,
+                                           k_NO_INTERVAL);
+                AtomicOps::setIntRelease(&site->d_state, e_READY);
+                return site;                                          // RETURN
+            }
+        }
+
+        // Another thread may be storing a site in this entry; the window is
+        // a few instructions long.
+
+        while (e_CLAIMED == state) {
+            state = AtomicOps::getIntAcquire(&site->d_state);
+        }
+
+        if (line == site->d_line && 0 == strcmp(file, site->d_file_p)) {
+            return site;                                              // RETURN
+        }
+    }
+
+    return &s_overflowSite;
+}
+
+bool tryReport(Site *site)
+    // Return 'true' if the specified 'site' may report a failure now, and
+    // 'false' otherwise, counting the report in the current interval of
+    // 'site', beginning a new interval if the current one has ended.
+{
+    const Types::Int64 now      = TimeUtil::getTimer();
+    const Types::Int64 start    = AtomicOps::getInt64Acquire(
+                                                       &site->d_intervalStart);
+    const Types::Int64 interval = AtomicOps::getInt64Relaxed(&s_interval);
+
+    if (now - start >= interval
+     && start == AtomicOps::testAndSwapInt64AcqRel(&site->d_intervalStart,
+                                                   start,
+                                                   now)) {
+        AtomicOps::setIntRelease(&site->d_numInInterval, 0);
+    }
+
+    return AtomicOps::addIntNvAcqRel(&site->d_numInInterval, 1)
+                       <= AtomicOps::getIntRelaxed(&s_maxReportsPerInterval);
+}
+
+bool isReady(const Site& site)
+    // Return 'true' if the specified 'site' identifies an assertion site
+    // that has failed, and 'false' otherwise.
+{
+    return &site == &s_overflowSite
+         ? 0 != AtomicOps::getInt64Relaxed(&site.d_numFailures)
+         : e_READY == AtomicOps::getIntAcquire(&site.d_state);
+}
+
+Types::Int64 sumCounter(AtomicOps::AtomicTypes::Int64 Site::*counter)
+    // Return the sum of the specified 'counter' over all sites.
+{
+    Types::Int64 sum = AtomicOps::getInt64Relaxed(&(s_overflowSite.*counter));
+
+    for (int i = 0; i < AssertThrottle::k_MAX_NUM_SITES; ++i) {
+        if (isReady(s_sites[i])) {
+            sum += AtomicOps::getInt64Relaxed(&(s_sites[i].*counter));
+        }
+    }
+    return sum;
+}
+
+}  // close unnamed namespace
+
+                           // ---------------------
+                           // struct AssertThrottle
+                           // ---------------------
+
+// CLASS METHODS
+void AssertThrottle::failureHandler(const char *text,
+                                    const char *file,
+                                    int         line)
+{
+    Site *site = findSite(file, line);
+
+    AtomicOps::addInt64(&site->d_numFailures, 1);
+
+    if (!tryReport(site)) {
+        AtomicOps::addInt64(&site->d_numPending, 1);
+        return;                                                       // RETURN
+    }
+
+    AtomicOps::addInt64(&site->d_numReported, 1);
+
+    const Types::Int64 numPending = AtomicOps::swapInt64(&site->d_numPending,
+                                                         0);
+    if (numPending) {
+        Log::logFormattedMessage(site->d_file_p,
+                                 site->d_line,
+                                 "%lld assertion failures suppressed",
+                                 static_cast<long long>(numPending));
+    }
+
+    reportHandler()(text, file, line);
+}
+
+void AssertThrottle::logFailure(const char *text, const char *file, int line)
+{
+    Log::logFormattedMessage(file, line, "Assertion failed: %s", text);
+}
+
+void AssertThrottle::setReportHandler(Assert::Handler handler)
+{
+    BSLS_ASSERT(handler);
+
+    AtomicOps::setPtrRelease(&s_reportHandler,
+                             reinterpret_cast<void *>(handler));
+}
+
+void AssertThrottle::setRateLimit(int          maxReportsPerInterval,
+                                  Types::Int64 interval)
+{
+    BSLS_ASSERT(0 <= maxReportsPerInterval);
+    BSLS_ASSERT(0 <  interval);
+
+    AtomicOps::setIntRelaxed(&s_maxReportsPerInterval, maxReportsPerInterval);
+    AtomicOps::setInt64Relaxed(&s_interval, interval);
+}
+
+void AssertThrottle::reset()
+{
+    memset(s_sites, 0, sizeof s_sites);
+
+    AtomicOps::setInt64(&s_overflowSite.d_numFailures,   0);
+    AtomicOps::setInt64(&s_overflowSite.d_numReported,   0);
+    AtomicOps::setInt64(&s_overflowSite.d_numPending,    0);
+    AtomicOps::setInt64(&s_overflowSite.d_intervalStart, k_NO_INTERVAL);
+    AtomicOps::setInt(&s_overflowSite.d_numInInterval,   0);
+}
+
+Types::Int64 AssertThrottle::interval()
+{
+    return AtomicOps::getInt64Relaxed(&s_interval);
+}
+
+int AssertThrottle::maxReportsPerInterval()
+{
+    return AtomicOps::getIntRelaxed(&s_maxReportsPerInterval);
+}
+
+Assert::Handler AssertThrottle::reportHandler()
+{
+    return reinterpret_cast<Assert::Handler>(
+                                          AtomicOps::getPtr(&s_reportHandler));
+}
+
+                        // Monitoring
+
+Types::Int64 AssertThrottle::numFailures()
+{
+    return sumCounter(&Site::d_numFailures);
+}
+
+Types::Int64 AssertThrottle::numReported()
+{
+    return sumCounter(&Site::d_numReported);
+}
+
+Types::Int64 AssertThrottle::numSuppressed()
+{
+    // Read the reports first, so that a concurrent failure cannot make the
+    // result negative.
+
+    const Types::Int64 reported = numReported();
+    return numFailures() - reported;
+}
+
+int AssertThrottle::numSites()
+{
+    int count = isReady(s_overflowSite);
+
+    for (int i = 0; i < k_MAX_NUM_SITES; ++i) {
+        count += isReady(s_sites[i]);
+    }
+    return count;
+}
+
+void AssertThrottle::getSiteStatistics(SiteStatistics *result, int index)
+{
+    BSLS_ASSERT(result);
+    BSLS_ASSERT(0 <= index);
+
+    const Site *site = 0;
+
+    for (int i = 0; i < k_MAX_NUM_SITES; ++i) {
+        if (isReady(s_sites[i]) && 0 == index--) {
+            site = &s_sites[i];
+            break;
+        }
+    }
+
+    if (!site) {
+        BSLS_ASSERT(0 == index && isReady(s_overflowSite));
+
+        site = &s_overflowSite;
+    }
+
+    result->d_file_p      = site->d_file_p;
+    result->d_line        = site->d_line;
+    result->d_numReported = AtomicOps::getInt64Relaxed(&site->d_numReported);
+    result->d_numFailures = AtomicOps::getInt64Relaxed(&site->d_numFailures);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,244 @@
+// bsls_assertthrottle.h                                              -*-C++-*-
+#ifndef INCLUDED_BSLS_ASSERTTHROTTLE
+#define INCLUDED_BSLS_ASSERTTHROTTLE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an assertion-failure handler that limits reports per site.
+//
+//@CLASSES:
+//  bsls::AssertThrottle: namespace for a rate-limiting failure handler
+//
+//@SEE_ALSO: bsls_assert, bsls_log
+//
+//@DESCRIPTION: This component provides a namespace, 'bsls::AssertThrottle',
+// for an assertion-failure handler, 'bsls::AssertThrottle::failureHandler',
+// that may be installed with 'bsls::Assert::setFailureHandler' in a process
+// that is to *continue* after an assertion fails -- e.g., a canary of a
+// production service built with 'BSLS_ASSERT_SAFE' enabled.  Such a process
+// would typically install a handler that logs the failure and returns; but
+// a failed assertion on a frequently executed path then logs on every call,
+// and the process spends its time writing the same message.
+// 'bsls::AssertThrottle::failureHandler' instead passes a failure to a
+// *report* *handler* (by default, 'bsls::AssertThrottle::logFailure', which
+// writes the failure to 'bsls::Log' and returns) only if the assertion site
+// at which it occurred has not exceeded its rate limit, and counts the
+// failures that it does not report.
+//
+///Assertion Sites and Rate Limiting
+///---------------------------------
+// An assertion site is identified by the file name and line number of the
+// failed assertion (file names are compared by value).  The failure handler
+// records each site in a table of 'k_MAX_NUM_SITES' entries, which is
+// searched and extended without locks; once the table is full, failures at
+// sites not in the table share a single additional entry, whose file name is
+// "(other)" and whose line number is 0.
+//
+// Each site may report at most 'maxReportsPerInterval' failures in each
+// interval of 'interval' nanoseconds, an interval beginning with the first
+// failure after the previous interval has ended.  By default, one failure per
+// second is reported.  The first failure reported after some have been
+// suppressed is preceded by a message, written to 'bsls::Log', that gives the
+// number of failures suppressed at that site.  Because the counters of a
+// site are updated without locks, when several threads fail at the same site
+// as an interval ends, slightly more failures than the limit may be reported
+// in the new interval.
+//
+///Monitoring
+///----------
+// The number of failures, reports, and suppressed reports, in total and for
+// each site, are available through 'numFailures', 'numReported',
+// 'numSuppressed', 'numSites', and 'getSiteStatistics', so that a monitoring
+// thread may publish them, without waiting for the failure handler.
+//
+///Thread Safety
+///-------------
+// 'failureHandler', 'logFailure', and the accessors are thread-safe.  The
+// setters may be called at any time, and take effect for subsequent failures.
+// 'reset' must not be called while a thread may be in 'failureHandler'.
+//
+// Note that a failure handler that returns may not be installed in a build
+// that defines 'BSLS_ASSERT_ENABLE_NORETURN_FOR_INVOKE_HANDLER'.
+//
+///Usage
+///-----
+// This section illustrates the intended use of this component.
+//
+///Example 1: Surviving a Frequently Failing Assertion
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service is built with safe assertions enabled, and run, with
+// a small share of the production load, to detect defects that only
+// production data would reveal.  Such a canary must stay up, and keep its
+// throughput, when an assertion fails on a hot path.
+//
+// First, we define a function that validates its argument with an assertion
+// that, because of a defect elsewhere, fails for every odd argument:
+//..
+//  int halve(int value)
+//      // Return half of the specified 'value'.  The behavior is undefined
+//      // unless 'value' is even.
+//  {
+//      if (value % 2) {
+//          bsls::Assert::invokeHandler("0 == value % 2", "halve.cpp", 10);
+//      }
+//      return value / 2;
+//  }
+//..
+// Then, we install the throttling failure handler, allowing each site to
+// report two failures per minute:
+//..
+//  bsls::Assert::setFailureHandler(&bsls::AssertThrottle::failureHandler);
+//
+//  bsls::AssertThrottle::setRateLimit(2, 60LL * 1000 * 1000 * 1000);
+//..
+// Next, we call the function, which fails for half of its calls:
+//..
+//  int sum = 0;
+//  for (int i = 0; i < 1000; ++i) {
+//      sum += halve(i);
+//  }
+//  assert(249500 == sum);
+//..
+// Now, we observe that only two of the 500 failures were reported (and
+// written to 'bsls::Log'):
+//..
+//  assert(500 == bsls::AssertThrottle::numFailures());
+//  assert(  2 == bsls::AssertThrottle::numReported());
+//  assert(498 == bsls::AssertThrottle::numSuppressed());
+//..
+// Finally, a monitoring thread might publish the counters of each site:
+//..
+//  assert(1 == bsls::AssertThrottle::numSites());
+//
+//  bsls::AssertThrottle::SiteStatistics site;
+//  bsls::AssertThrottle::getSiteStatistics(&site, 0);
+//
+//  assert(0   == strcmp("halve.cpp", site.d_file_p));
+//  assert(10  == site.d_line);
+//  assert(500 == site.d_numFailures);
+//  assert(2   == site.d_numReported);
+//..
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+                           // =====================
+                           // struct AssertThrottle
+                           // =====================
+
+struct AssertThrottle {
+    // This 'struct' provides a namespace for an assertion-failure handler
+    // that reports failures at each assertion site at a limited rate, and for
+    // the functions that configure and monitor it.
+
+    // TYPES
+    enum {
+        k_MAX_NUM_SITES = 256   // number of sites tracked individually
+    };
+
+    struct SiteStatistics {
+        // This 'struct' holds the counters of an assertion site.
+
+        const char   *d_file_p;       // file name of the site
+        int           d_line;         // line number of the site
+        Types::Int64  d_numFailures;  // failures at the site
+        Types::Int64  d_numReported;  // failures passed to the report handler
+    };
+
+    // CLASS METHODS
+    static void failureHandler(const char *text, const char *file, int line);
+        // Count a failure of the assertion having the specified 'text' at the
+        // specified 'file' and 'line', and, unless the site 'file' and 'line'
+        // has reached its rate limit, invoke the current report handler with
+        // 'text', 'file', and 'line'.  This function returns if the report
+        // handler returns.  The behavior is undefined unless 'file' remains
+        // valid until 'reset' is called, or the program ends (as '__FILE__'
+        // does).  Note that this function is intended to be installed with
+        // 'bsls::Assert::setFailureHandler'.
+
+    static void logFailure(const char *text, const char *file, int line);
+        // Write a message reporting the failure of the assertion having the
+        // specified 'text' at the specified 'file' and 'line' to the currently
+        // installed 'bsls::Log' handler, and return.  Note that this function
+        // is the default report handler.
+
+    static void setReportHandler(Assert::Handler handler);
+        // Install the specified 'handler' as the report handler, to which
+        // 'failureHandler' passes the failures that it reports.
+
+    static void setRateLimit(int maxReportsPerInterval, Types::Int64 interval);
+        // Allow each assertion site to report at most the specified
+        // 'maxReportsPerInterval' failures in each interval of the specified
+        // 'interval' nanoseconds.  The behavior is undefined unless
+        // '0 <= maxReportsPerInterval' and '0 < interval'.
+
+    static void reset();
+        // Forget all assertion sites, and set all counters to 0.  The
+        // configuration is unaffected.  The behavior is undefined if a thread
+        // may be in a call to 'failureHandler'.
+
+    static Types::Int64 interval();
+        // Return the length, in nanoseconds, of the interval within which
+        // each site may report at most 'maxReportsPerInterval' failures.
+
+    static int maxReportsPerInterval();
+        // Return the number of failures that each site may report in each
+        // interval.
+
+    static Assert::Handler reportHandler();
+        // Return the address of the current report handler.
+
+                        // Monitoring
+
+    static Types::Int64 numFailures();
+        // Return the number of failures counted by 'failureHandler'.
+
+    static Types::Int64 numReported();
+        // Return the number of failures passed to the report handler.
+
+    static Types::Int64 numSuppressed();
+        // Return the number of failures not passed to the report handler.
+
+    static int numSites();
+        // Return the number of assertion sites, including the site shared by
+        // failures at sites that could not be added to the table, if any
+        // such failure occurred.
+
+    static void getSiteStatistics(SiteStatistics *result, int index);
+        // Load into the specified 'result' the counters of the assertion site
+        // having the specified 'index'.  The behavior is undefined unless
+        // '0 <= index < numSites()'.  Note that the index of a site may change
+        // when a site is added.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,968 @@
+// bsls_assertthrottle.t.cpp                                          -*-C++-*-
+#include <bsls_assertthrottle.h>
+
+#include <bsls_atomic.h>         // for testing only
+#include <bsls_bsltestutil.h>    // for testing only
+#include <bsls_log.h>            // for testing only
+#include <bsls_stopwatch.h>      // for testing only
+#include <bsls_timeutil.h>       // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a namespace for an assertion-failure handler
+// that forwards failures to a report handler at a limited rate per assertion
+// site, and counts them.  We install a recording report handler, and first
+// verify that sites are identified by the value of their file name and their
+// line number, and that failures at sites beyond the capacity of the table
+// share the overflow site.  We then verify the rate limit: that at most the
+// configured number of failures is reported in an interval, that a new
+// interval begins once the previous one has ended, and that the number of
+// suppressed failures is written to 'bsls::Log' before the next report.
+// Finally, we verify that the counters are exact when several threads fail
+// concurrently at several sites.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 1] void failureHandler(const char *text, const char *file, int line);
+// [ 3] void logFailure(const char *text, const char *file, int line);
+// [ 3] void setReportHandler(Assert::Handler handler);
+// [ 3] void setRateLimit(int maxReportsPerInterval, Types::Int64);
+// [ 2] void reset();
+// [ 3] Types::Int64 interval();
+// [ 3] int maxReportsPerInterval();
+// [ 3] Assert::Handler reportHandler();
+// [ 1] Types::Int64 numFailures();
+// [ 1] Types::Int64 numReported();
+// [ 1] Types::Int64 numSuppressed();
+// [ 2] int numSites();
+// [ 2] void getSiteStatistics(SiteStatistics *result, int index);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 2] CONCERN: Sites are identified by file name value and line number.
+// [ 2] CONCERN: Failures at sites beyond the table share one site.
+// [ 4] CONCERN: Counters are exact when threads fail concurrently.
+// [ 5] USAGE EXAMPLE
+// [-1] PERFORMANCE: COST OF A SUPPRESSED FAILURE
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bsls::AssertThrottle Obj;
+typedef Obj::SiteStatistics  Stats;
+typedef bsls::Types::Int64   Int64;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+const Int64 k_MILLISECOND = 1000 * 1000;                  // in nanoseconds
+const Int64 k_HOUR        = 3600LL * 1000 * k_MILLISECOND;
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+void waitFor(Int64 duration)
+    // Return after the specified 'duration' nanoseconds have elapsed.
+{
+    const Int64 end = bsls::TimeUtil::getTimer() + duration;
+    while (bsls::TimeUtil::getTimer() < end) {
+    }
+}
+
+static bsls::AtomicInt  g_numReports;       // calls to 'recordingHandler'
+static const char      *g_reportText = 0;   // last arguments passed to
+static const char      *g_reportFile = 0;   // 'recordingHandler'
+static int              g_reportLine = 0;
+
+static
+void recordingHandler(const char *text, const char *file, int line)
+    // Record the specified 'text', 'file', and 'line', and count the call.
+{
+    g_reportText = text;
+    g_reportFile = file;
+    g_reportLine = line;
+    ++g_numReports;
+}
+
+static int  g_numLogged = 0;                // calls to 'logHandler'
+static char g_loggedMessage[256];           // last message passed to
+static char g_loggedFile[256];              // 'logHandler', and its file
+static int  g_loggedLine = 0;               // and line
+
+static
+void logHandler(const char *file, int line, const char *message)
+    // Record the specified 'file', 'line', and 'message', and count the call.
+{
+    strncpy(g_loggedMessage, message, sizeof g_loggedMessage - 1);
+    strncpy(g_loggedFile,    file,    sizeof g_loggedFile    - 1);
+    g_loggedLine = line;
+    ++g_numLogged;
+}
+
+static FILE *g_handlerFile = 0;             // file of 'fileHandler'
+
+static
+void fileHandler(const char *file, int line, const char *message)
+    // Write the specified 'file', 'line', and 'message' to 'g_handlerFile',
+    // as 'bsls::Log::stderrMessageHandler' writes them to 'stderr'.
+{
+    fprintf(g_handlerFile, "%s:%d %s\n", file, line, message);
+    fflush(g_handlerFile);
+}
+
+static
+void countingHandler(const char *, const char *, int)
+    // Count the call.
+{
+    ++g_numReports;
+}
+
+static
+void resetAll()
+    // Reset 'bsls::AssertThrottle', install 'recordingHandler' as its report
+    // handler with a limit of one report per hour, and clear the records of
+    // 'recordingHandler' and 'logHandler'.
+{
+    Obj::reset();
+    Obj::setReportHandler(&recordingHandler);
+    Obj::setRateLimit(1, k_HOUR);
+
+    g_numReports = 0;
+    g_reportText = 0;
+    g_reportFile = 0;
+    g_reportLine = 0;
+
+    g_numLogged  = 0;
+    g_loggedMessage[0] = 0;
+    g_loggedFile[0]    = 0;
+    g_loggedLine = 0;
+}
+
+                                // ------
+                                // case 4
+                                // ------
+
+enum { k_MAX_THREADS = 16 };
+
+static const char *const FILES[] = { "a.cpp", "b.cpp", "c.cpp", "d.cpp" };
+enum { k_NUM_FILES = sizeof FILES / sizeof *FILES };
+
+struct FailerInfo {
+    int             d_numThreads;   // number of threads
+    int             d_numLines;     // lines per file
+    int             d_numFailures;  // failures per site per thread
+    bsls::AtomicInt d_go;           // set to start all threads at once
+};
+
+extern "C" void *failerFunction(void *arg)
+    // Wait until the 'd_go' member of the specified 'arg', which must be the
+    // address of a 'FailerInfo' object, is set, and then fail 'd_numFailures'
+    // times at each of 'd_numLines' lines of each of 'FILES'.
+{
+    FailerInfo *info = static_cast<FailerInfo *>(arg);
+
+    while (0 == info->d_go) {
+    }
+
+    for (int i = 0; i < info->d_numFailures; ++i) {
+        for (int f = 0; f < k_NUM_FILES; ++f) {
+            for (int line = 1; line <= info->d_numLines; ++line) {
+                Obj::failureHandler("failer", FILES[f], line);
+            }
+        }
+    }
+    return arg;
+}
+
+static
+void runFailerThreads(int numThreads, int numLines, int numFailures)
+    // Run 'failerFunction' in the specified 'numThreads' threads, failing
+    // the specified 'numFailures' times at each of the specified 'numLines'
+    // lines of each of 'FILES'.  The behavior is undefined unless
+    // '0 < numThreads <= k_MAX_THREADS'.
+{
+    FailerInfo info;
+    info.d_numThreads  = numThreads;
+    info.d_numLines    = numLines;
+    info.d_numFailures = numFailures;
+    info.d_go          = 0;
+
+    ThreadId ids[k_MAX_THREADS];
+    for (int i = 0; i < numThreads; ++i) {
+        ids[i] = createThread(&failerFunction, &info);
+    }
+    info.d_go = 1;
+    for (int i = 0; i < numThreads; ++i) {
+        joinThread(ids[i]);
+    }
+}
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates the intended use of this component.
+//
+///Example 1: Surviving a Frequently Failing Assertion
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service is built with safe assertions enabled, and run, with
+// a small share of the production load, to detect defects that only
+// production data would reveal.  Such a canary must stay up, and keep its
+// throughput, when an assertion fails on a hot path.
+//
+// First, we define a function that validates its argument with an assertion
+// that, because of a defect elsewhere, fails for every odd argument:
+//..
+int halve(int value)
+    // Return half of the specified 'value'.  The behavior is undefined
+    // unless 'value' is even.
+{
+    if (value % 2) {
+        bsls::Assert::invokeHandler("0 == value % 2", "halve.cpp", 10);
+    }
+    return value / 2;
+}
+//..
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    // Keep the messages of the default report handler out of the output.
+
+    bsls::Log::setLogMessageHandler(&logHandler);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we install the throttling failure handler, allowing each site to
+// report two failures per minute:
+//..
+    bsls::Assert::setFailureHandler(&bsls::AssertThrottle::failureHandler);
+
+    bsls::AssertThrottle::setRateLimit(2, 60LL * 1000 * 1000 * 1000);
+//..
+// Next, we call the function, which fails for half of its calls:
+//..
+    int sum = 0;
+    for (int i = 0; i < 1000; ++i) {
+        sum += halve(i);
+    }
+    ASSERT(249500 == sum);
+//..
+// Now, we observe that only two of the 500 failures were reported (and
+// written to 'bsls::Log'):
+//..
+    ASSERT(500 == bsls::AssertThrottle::numFailures());
+    ASSERT(  2 == bsls::AssertThrottle::numReported());
+    ASSERT(498 == bsls::AssertThrottle::numSuppressed());
+//..
+// Finally, a monitoring thread might publish the counters of each site:
+//..
+    ASSERT(1 == bsls::AssertThrottle::numSites());
+
+    bsls::AssertThrottle::SiteStatistics site;
+    bsls::AssertThrottle::getSiteStatistics(&site, 0);
+
+    ASSERT(0   == strcmp("halve.cpp", site.d_file_p));
+    ASSERT(10  == site.d_line);
+    ASSERT(500 == site.d_numFailures);
+    ASSERT(2   == site.d_numReported);
+//..
+
+        bsls::Assert::setFailureHandler(&bsls::Assert::failAbort);
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CONCURRENT FAILURES
+        //
+        // Concerns:
+        //: 1 When several threads fail concurrently, at sites new and old,
+        //:   each site is added to the table once, and no failure is lost.
+        //:
+        //: 2 Each failure is either reported or suppressed, and, with a limit
+        //:   that allows every report, every failure is reported.
+        //:
+        //: 3 With a limit of one report per interval, each site reports at
+        //:   least one, and at most one per thread, of the failures in the
+        //:   first interval.
+        //
+        // Plan:
+        //: 1 For several thread counts, fail concurrently at a number of
+        //:   sites, a number of times, from each thread, and verify the
+        //:   number of sites, and the counters of each site and in total.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   CONCERN: Counters are exact when threads fail concurrently.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCONCURRENT FAILURES"
+                            "\n===================\n");
+
+        const int NUM_LINES    = 8;
+        const int NUM_FAILURES = 1000;
+        const int NUM_SITES    = NUM_LINES * k_NUM_FILES;
+
+        for (int numThreads = 1; numThreads <= k_MAX_THREADS; numThreads *= 2)
+        {
+            for (int limited = 0; limited < 2; ++limited) {
+                if (veryVerbose) { T_ P_(numThreads) P(limited) }
+
+                resetAll();
+                Obj::setReportHandler(&countingHandler);
+                if (!limited) {
+                    Obj::setRateLimit(numThreads * NUM_FAILURES, k_HOUR);
+                }
+
+                runFailerThreads(numThreads, NUM_LINES, NUM_FAILURES);
+
+                const Int64 EXP = numThreads * NUM_FAILURES;
+
+                ASSERTV(numThreads, NUM_SITES == Obj::numSites());
+                ASSERTV(numThreads, EXP * NUM_SITES == Obj::numFailures());
+                ASSERTV(numThreads, g_numReports == Obj::numReported());
+                ASSERTV(numThreads, Obj::numFailures() ==
+                                   Obj::numReported() + Obj::numSuppressed());
+
+                for (int i = 0; i < NUM_SITES; ++i) {
+                    Stats stats;
+                    Obj::getSiteStatistics(&stats, i);
+
+                    ASSERTV(numThreads, i, EXP == stats.d_numFailures);
+                    ASSERTV(numThreads, i, 1 <= stats.d_line);
+                    ASSERTV(numThreads, i, NUM_LINES >= stats.d_line);
+
+                    if (limited) {
+                        ASSERTV(numThreads, i, stats.d_numReported,
+                                1 <= stats.d_numReported);
+                        ASSERTV(numThreads, i, stats.d_numReported,
+                                numThreads >= stats.d_numReported);
+                    }
+                    else {
+                        ASSERTV(numThreads, i, stats.d_numReported,
+                                EXP == stats.d_numReported);
+                    }
+                }
+            }
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // RATE LIMITING
+        //
+        // Concerns:
+        //: 1 By default, the report handler is 'logFailure', and each site may
+        //:   report one failure per second.
+        //:
+        //: 2 The setters change the configuration that the accessors return.
+        //:
+        //: 3 A site reports at most 'maxReportsPerInterval' failures in an
+        //:   interval, and a limit of 0 suppresses every failure.
+        //:
+        //: 4 Once an interval has ended, the next failure begins a new
+        //:   interval, and is reported, after a message giving the number of
+        //:   failures suppressed at the site is written to 'bsls::Log'.
+        //:
+        //: 5 The rate limit of a site is independent of other sites.
+        //:
+        //: 6 'logFailure' writes the failure to 'bsls::Log', and returns.
+        //
+        // Plan:
+        //: 1 Verify the initial configuration.  (C-1)
+        //:
+        //: 2 Set the configuration, and verify the accessors.  (C-2)
+        //:
+        //: 3 Fail repeatedly at two sites, with several limits, and verify
+        //:   the reports and the counters.  (C-3, 5)
+        //:
+        //: 4 With a short interval, fail repeatedly, wait until the interval
+        //:   has ended, fail again, and verify the report, the message
+        //:   written to 'bsls::Log', and the counters.  (C-4)
+        //:
+        //: 5 Call 'logFailure', and verify the message written to
+        //:   'bsls::Log'.  (C-6)
+        //
+        // Testing:
+        //   void logFailure(const char *text, const char *file, int line);
+        //   void setReportHandler(Assert::Handler handler);
+        //   void setRateLimit(int maxReportsPerInterval, Types::Int64);
+        //   Types::Int64 interval();
+        //   int maxReportsPerInterval();
+        //   Assert::Handler reportHandler();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nRATE LIMITING"
+                            "\n=============\n");
+
+        if (verbose) printf("\tDefault configuration.\n");
+        {
+            ASSERT(&Obj::logFailure      == Obj::reportHandler());
+            ASSERT(1                     == Obj::maxReportsPerInterval());
+            ASSERT(1000 * k_MILLISECOND  == Obj::interval());
+        }
+
+        if (verbose) printf("\tSetters and accessors.\n");
+        {
+            Obj::setReportHandler(&recordingHandler);
+            ASSERT(&recordingHandler == Obj::reportHandler());
+
+            Obj::setRateLimit(0, 1);
+            ASSERT(0 == Obj::maxReportsPerInterval());
+            ASSERT(1 == Obj::interval());
+
+            Obj::setRateLimit(7, k_HOUR);
+            ASSERT(7      == Obj::maxReportsPerInterval());
+            ASSERT(k_HOUR == Obj::interval());
+
+            Obj::reset();
+            ASSERT(&recordingHandler == Obj::reportHandler());
+            ASSERT(7                 == Obj::maxReportsPerInterval());
+            ASSERT(k_HOUR            == Obj::interval());
+        }
+
+        if (verbose) printf("\tLimits within an interval.\n");
+        {
+            static const int LIMITS[] = { 0, 1, 2, 5, 100 };
+            const int NUM_LIMITS = sizeof LIMITS / sizeof *LIMITS;
+
+            const int NUM_FAILURES = 20;
+
+            for (int ti = 0; ti < NUM_LIMITS; ++ti) {
+                const int LIMIT = LIMITS[ti];
+                const int EXP   = LIMIT < NUM_FAILURES ? LIMIT : NUM_FAILURES;
+
+                if (veryVerbose) { T_ P(LIMIT) }
+
+                resetAll();
+                Obj::setRateLimit(LIMIT, k_HOUR);
+
+                for (int i = 0; i < NUM_FAILURES; ++i) {
+                    Obj::failureHandler("first", "file.cpp", 1);
+                    Obj::failureHandler("second", "file.cpp", 2);
+                }
+
+                ASSERTV(LIMIT, 2 * EXP == g_numReports);
+                ASSERTV(LIMIT, 2 * NUM_FAILURES == Obj::numFailures());
+                ASSERTV(LIMIT, 2 * EXP == Obj::numReported());
+                ASSERTV(LIMIT, 2 * (NUM_FAILURES - EXP) ==
+                                                        Obj::numSuppressed());
+                ASSERTV(LIMIT, 0 == g_numLogged);
+
+                for (int i = 0; i < 2; ++i) {
+                    Stats stats;
+                    Obj::getSiteStatistics(&stats, i);
+
+                    ASSERTV(LIMIT, i, NUM_FAILURES == stats.d_numFailures);
+                    ASSERTV(LIMIT, i, EXP          == stats.d_numReported);
+                }
+
+                if (EXP) {
+                    ASSERTV(LIMIT, 0 == strcmp("second",   g_reportText));
+                    ASSERTV(LIMIT, 0 == strcmp("file.cpp", g_reportFile));
+                    ASSERTV(LIMIT, 2 == g_reportLine);
+                }
+            }
+        }
+
+        if (verbose) printf("\tA new interval.\n");
+        {
+            const Int64 INTERVAL = 50 * k_MILLISECOND;
+
+            resetAll();
+            Obj::setRateLimit(2, INTERVAL);
+
+            for (int i = 0; i < 10; ++i) {
+                Obj::failureHandler("text", "file.cpp", 3);
+            }
+
+            // Failures at another site do not affect this one.
+
+            Obj::failureHandler("other", "other.cpp", 4);
+
+            ASSERTV(g_numReports, 3 == g_numReports);
+            ASSERT(0 == g_numLogged);
+
+            waitFor(INTERVAL);
+
+            Obj::failureHandler("text", "file.cpp", 3);
+
+            ASSERTV(g_numReports, 4 == g_numReports);
+            ASSERT(0 == strcmp("text", g_reportText));
+            ASSERT(3 == g_reportLine);
+
+            ASSERTV(g_numLogged, 1 == g_numLogged);
+            ASSERTV(g_loggedMessage,
+                    0 == strcmp("8 assertion failures suppressed",
+                                g_loggedMessage));
+            ASSERT(0 == strcmp("file.cpp", g_loggedFile));
+            ASSERT(3 == g_loggedLine);
+
+            ASSERT(12 == Obj::numFailures());
+            ASSERT( 4 == Obj::numReported());
+            ASSERT( 8 == Obj::numSuppressed());
+
+            // The count of suppressed failures is written only once.
+
+            Obj::failureHandler("text", "file.cpp", 3);
+
+            ASSERTV(g_numReports, 5 == g_numReports);
+            ASSERTV(g_numLogged,  1 == g_numLogged);
+        }
+
+        if (verbose) printf("\t'logFailure'.\n");
+        {
+            resetAll();
+
+            Obj::logFailure("0 < x", "log.cpp", 42);
+
+            ASSERTV(g_numLogged, 1 == g_numLogged);
+            ASSERTV(g_loggedMessage,
+                    0 == strcmp("Assertion failed: 0 < x", g_loggedMessage));
+            ASSERT(0  == strcmp("log.cpp", g_loggedFile));
+            ASSERT(42 == g_loggedLine);
+
+            Obj::setReportHandler(&Obj::logFailure);
+
+            Obj::failureHandler("0 < y", "log.cpp", 43);
+
+            ASSERTV(g_numLogged, 2 == g_numLogged);
+            ASSERTV(g_loggedMessage,
+                    0 == strcmp("Assertion failed: 0 < y", g_loggedMessage));
+            ASSERT(43 == g_loggedLine);
+            ASSERT(1  == Obj::numReported());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // ASSERTION SITES
+        //
+        // Concerns:
+        //: 1 Failures with equal file names (at different addresses) and
+        //:   equal line numbers are counted at the same site.
+        //:
+        //: 2 Failures with different file names or line numbers are counted
+        //:   at different sites.
+        //:
+        //: 3 Once the table is full, failures at new sites are counted at a
+        //:   single overflow site, whose file name is "(other)" and whose
+        //:   line number is 0, while failures at sites in the table are still
+        //:   counted at their sites.
+        //:
+        //: 4 'getSiteStatistics' visits each site once, with the overflow
+        //:   site last.
+        //:
+        //: 5 'reset' forgets all sites, including the overflow site.
+        //
+        // Plan:
+        //: 1 Fail at sites that differ in file name address, file name
+        //:   value, and line number, and verify the sites and their counters.
+        //:   (C-1..2, 4)
+        //:
+        //: 2 Fail at more sites than the table holds, and verify the sites
+        //:   and their counters.  (C-3..4)
+        //:
+        //: 3 Call 'reset', and verify that no site remains.  (C-5)
+        //
+        // Testing:
+        //   void reset();
+        //   int numSites();
+        //   void getSiteStatistics(SiteStatistics *result, int index);
+        //   CONCERN: Sites are identified by file name value and line number.
+        //   CONCERN: Failures at sites beyond the table share one site.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nASSERTION SITES"
+                            "\n===============\n");
+
+        if (verbose) printf("\tFile name value and line number.\n");
+        {
+            resetAll();
+            Obj::setRateLimit(0, k_HOUR);
+
+            char fileA[] = "site.cpp";
+            char fileB[] = "site.cpp";
+
+            Obj::failureHandler("a", fileA,      1);
+            Obj::failureHandler("b", fileB,      1);
+            Obj::failureHandler("c", "site.cpp", 1);
+            Obj::failureHandler("d", "site.cpp", 2);
+            Obj::failureHandler("e", "site.cpp", 2);
+            Obj::failureHandler("f", "site.h",   2);
+
+            ASSERTV(Obj::numSites(), 3 == Obj::numSites());
+            ASSERT(6 == Obj::numFailures());
+
+            int found[3] = { 0, 0, 0 };
+            for (int i = 0; i < Obj::numSites(); ++i) {
+                Stats stats;
+                Obj::getSiteStatistics(&stats, i);
+
+                ASSERTV(i, 0 == stats.d_numReported);
+
+                if (0 == strcmp("site.cpp", stats.d_file_p)
+                 && 1 == stats.d_line) {
+                    ASSERTV(i, 3 == stats.d_numFailures);
+                    ++found[0];
+                }
+                else if (0 == strcmp("site.cpp", stats.d_file_p)
+                      && 2 == stats.d_line) {
+                    ASSERTV(i, 2 == stats.d_numFailures);
+                    ++found[1];
+                }
+                else if (0 == strcmp("site.h", stats.d_file_p)
+                      && 2 == stats.d_line) {
+                    ASSERTV(i, 1 == stats.d_numFailures);
+                    ++found[2];
+                }
+            }
+            ASSERT(1 == found[0]);
+            ASSERT(1 == found[1]);
+            ASSERT(1 == found[2]);
+        }
+
+        if (verbose) printf("\tOverflow site.\n");
+        {
+            resetAll();
+            Obj::setRateLimit(1, k_HOUR);
+
+            const int MAX = Obj::k_MAX_NUM_SITES;
+
+            for (int line = 1; line <= MAX; ++line) {
+                Obj::failureHandler("table", "table.cpp", line);
+            }
+            ASSERTV(Obj::numSites(), MAX == Obj::numSites());
+            ASSERT(MAX == g_numReports);
+
+            // Failures at new sites share the overflow site, and its rate
+            // limit.
+
+            Obj::failureHandler("new", "new.cpp", 1);
+            Obj::failureHandler("new", "new.cpp", 2);
+            Obj::failureHandler("new", "new.h",   1);
+
+            ASSERTV(Obj::numSites(), MAX + 1 == Obj::numSites());
+            ASSERT(MAX + 1 == g_numReports);
+            ASSERT(0 == strcmp("new.cpp", g_reportFile));
+            ASSERT(1 == g_reportLine);
+
+            // Failures at sites in the table are still counted there.
+
+            Obj::failureHandler("table", "table.cpp", 5);
+
+            ASSERTV(Obj::numSites(), MAX + 1 == Obj::numSites());
+
+            int found[MAX + 1] = { 0 };
+            for (int i = 0; i < MAX; ++i) {
+                Stats stats;
+                Obj::getSiteStatistics(&stats, i);
+
+                ASSERTV(i, 0 == strcmp("table.cpp", stats.d_file_p));
+                ASSERTV(i, stats.d_line, 1 <= stats.d_line);
+                ASSERTV(i, stats.d_line, MAX >= stats.d_line);
+                ASSERTV(i, 1 == stats.d_numReported);
+                ASSERTV(i, (5 == stats.d_line ? 2 : 1) ==
+                                                         stats.d_numFailures);
+                ++found[stats.d_line];
+            }
+            for (int line = 1; line <= MAX; ++line) {
+                ASSERTV(line, 1 == found[line]);
+            }
+
+            Stats stats;
+            Obj::getSiteStatistics(&stats, MAX);
+
+            ASSERT(0 == strcmp("(other)", stats.d_file_p));
+            ASSERT(0 == stats.d_line);
+            ASSERT(3 == stats.d_numFailures);
+            ASSERT(1 == stats.d_numReported);
+
+            ASSERT(MAX + 4 == Obj::numFailures());
+            ASSERT(MAX + 1 == Obj::numReported());
+            ASSERT(3       == Obj::numSuppressed());
+        }
+
+        if (verbose) printf("\t'reset'.\n");
+        {
+            Obj::reset();
+
+            ASSERT(0 == Obj::numSites());
+            ASSERT(0 == Obj::numFailures());
+            ASSERT(0 == Obj::numReported());
+            ASSERT(0 == Obj::numSuppressed());
+
+            Obj::failureHandler("again", "new.cpp", 1);
+
+            ASSERT(1 == Obj::numSites());
+
+            Stats stats;
+            Obj::getSiteStatistics(&stats, 0);
+
+            ASSERT(0 == strcmp("new.cpp", stats.d_file_p));
+            ASSERT(1 == stats.d_line);
+            ASSERT(1 == stats.d_numFailures);
+            ASSERT(1 == stats.d_numReported);
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Install a recording report handler, fail repeatedly at one
+        //:   site, and verify the report and the counters.  Install the
+        //:   failure handler in 'bsls::Assert', and repeat.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   void failureHandler(const char *text, const char *file, int line);
+        //   Types::Int64 numFailures();
+        //   Types::Int64 numReported();
+        //   Types::Int64 numSuppressed();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        ASSERT(0 == Obj::numSites());
+        ASSERT(0 == Obj::numFailures());
+        ASSERT(0 == Obj::numReported());
+        ASSERT(0 == Obj::numSuppressed());
+
+        resetAll();
+
+        for (int i = 0; i < 5; ++i) {
+            Obj::failureHandler("0 < x", "breathing.cpp", 17);
+        }
+
+        ASSERT(1 == g_numReports);
+        ASSERT(0 == strcmp("0 < x", g_reportText));
+        ASSERT(0 == strcmp("breathing.cpp", g_reportFile));
+        ASSERT(17 == g_reportLine);
+
+        ASSERT(1 == Obj::numSites());
+        ASSERT(5 == Obj::numFailures());
+        ASSERT(1 == Obj::numReported());
+        ASSERT(4 == Obj::numSuppressed());
+
+        bsls::Assert::setFailureHandler(&Obj::failureHandler);
+
+        for (int i = 0; i < 5; ++i) {
+            bsls::Assert::invokeHandler("0 < y", "breathing.cpp", 18);
+        }
+
+        bsls::Assert::setFailureHandler(&bsls::Assert::failAbort);
+
+        ASSERT(2 == g_numReports);
+        ASSERT(0 == strcmp("0 < y", g_reportText));
+        ASSERT(18 == g_reportLine);
+
+        ASSERT(2  == Obj::numSites());
+        ASSERT(10 == Obj::numFailures());
+        ASSERT(2  == Obj::numReported());
+        ASSERT(8  == Obj::numSuppressed());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COST OF A SUPPRESSED FAILURE
+        //
+        // Concerns:
+        //: 1 A suppressed failure costs much less than writing the failure to
+        //:   a log file.
+        //
+        // Plan:
+        //: 1 Fail a number of times at a few sites, from one and from several
+        //:   threads, reporting every failure, and then suppressing all but
+        //:   the first at each site, with 'logFailure' writing through
+        //:   'bsls::Log' to '/dev/null' (or a temporary file), and report the
+        //:   elapsed times.
+        //
+        // Testing:
+        //   PERFORMANCE: COST OF A SUPPRESSED FAILURE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nPERFORMANCE: COST OF A SUPPRESSED FAILURE"
+                            "\n=========================================\n");
+
+        const int NUM_FAILURES = 100000;
+
+        FILE *file = fopen("/dev/null", "w");
+        if (!file) {
+            file = tmpfile();
+        }
+        ASSERT(file);
+
+        g_handlerFile = file;
+        bsls::Log::setLogMessageHandler(&fileHandler);
+
+        for (int numThreads = 1; numThreads <= 4; numThreads *= 4) {
+            bsls::Stopwatch timer;
+
+            Obj::reset();
+            Obj::setReportHandler(&Obj::logFailure);
+            Obj::setRateLimit(numThreads * NUM_FAILURES, k_HOUR);
+
+            timer.start();
+            runFailerThreads(numThreads, 1, NUM_FAILURES / k_NUM_FILES);
+            timer.stop();
+
+            const double reportTime = timer.elapsedTime();
+
+            Obj::reset();
+            Obj::setRateLimit(1, k_HOUR);
+
+            timer.reset();
+            timer.start();
+            runFailerThreads(numThreads, 1, NUM_FAILURES / k_NUM_FILES);
+            timer.stop();
+
+            const double suppressTime = timer.elapsedTime();
+
+            printf("threads %d, failures %d: reported %6.3fs,"
+                   " suppressed %6.3fs\n",
+                   numThreads, NUM_FAILURES, reportTime, suppressTime);
+        }
+
+        bsls::Log::setLogMessageHandler(&logHandler);
+        fclose(file);
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
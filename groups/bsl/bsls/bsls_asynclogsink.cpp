@@ -0,0 +1,1373 @@
+// bsls_asynclogsink.cpp                                              -*-C++-*-
+#include <bsls_asynclogsink.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_assert.h>
+#include <bsls_bsltestutil.h>      // for testing only
+
+#include <stddef.h> // 'ptrdiff_t', 'size_t'
+#include <stdlib.h> // 'malloc', 'free'
+#include <string.h> // 'memcpy', 'strlen'
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h> // 'CreateThread', 'FlsAlloc', 'Sleep', 'SwitchToThread'
+#else
+#include <sched.h>   // 'sched_yield'
+#include <time.h>    // 'nanosleep'
+#endif
+
+#if defined(BSLS_PLATFORM_CMP_MSVC) && !defined(va_copy)
+#define va_copy(dest, src) (dest = src)
+// See 'bsls_log.cpp': on Windows, 'va_list' is a simple pointer.
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+namespace {
+
+enum {
+    k_CACHE_LINE_SIZE  = 64,   // assumed size of a cache line, in bytes
+
+    k_MAX_FILE_LENGTH  = 100,  // greatest number of characters of a file
+                               // name stored in a record
+
+    k_MAX_LINE_LENGTH  = 1024, // greatest length of a line written to the
+                               // file, including the newline
+
+    k_MAX_SPEC_LENGTH  = 32,   // greatest length of a conversion
+                               // specification replayed from a record
+
+    k_MAX_NUM_STARS    = 2     // greatest number of '*' in a conversion
+};
+
+struct Record {
+    // This 'struct' defines the layout of a log record in a ring.  'd_data'
+    // holds the null-terminated file name, followed either by the
+    // null-terminated message (if 'd_format_p' is 0), or by the arguments
+    // captured for 'd_format_p' (see 'captureArguments').
+
+    const char *d_format_p;  // format of the captured arguments, or 0
+    int         d_line;      // line number
+    char        d_data[AsyncLogSink::k_RECORD_SIZE
+                       - sizeof(const char *)
+                       - sizeof(int)];
+                             // file name, and message or arguments
+};
+
+struct ConversionSpec {
+    // This 'struct' describes a conversion specification of a 'printf'-style
+    // format string.
+
+    // TYPES
+    enum LengthModifier {
+        e_NONE,
+        e_CHAR,         // 'hh'
+        e_SHORT,        // 'h'
+        e_LONG,         // 'l'
+        e_LONG_LONG,    // 'll'
+        e_SIZE,         // 'z'
+        e_PTRDIFF,      // 't'
+        e_LONG_DOUBLE,  // 'L'
+        e_UNSUPPORTED   // any other
+    };
+
+    // DATA
+    const char     *d_lengthBegin_p;  // first character of the length
+                                      // modifier, if any
+
+    int             d_numStars;       // number of '*' width and precision
+                                      // arguments
+
+    int             d_precision;      // precision given by digits, or -1
+
+    bool            d_isPrecisionStar;
+                                      // 'true' if the precision is given by
+                                      // a '*' argument
+
+    LengthModifier  d_lengthModifier; // length modifier
+
+    char            d_specifier;      // conversion specifier, or 0 if the
+                                      // format ends before it
+};
+
+bool isDigit(char character)
+    // Return 'true' if the specified 'character' is a decimal digit, and
+    // 'false' otherwise.
+{
+    return '0' <= character && character <= '9';
+}
+
+const char *parseConversion(ConversionSpec *result, const char *percent)
+    // Load into the specified 'result' the description of the conversion
+    // specification that begins with the '%' at the specified 'percent', and
+    // return the address one past the end of that specification.
+{
+    const char *p = percent + 1;
+
+    while ('-' == *p || '+' == *p || ' ' == *p || '#' == *p || '0' == *p) {
+        ++p;
+    }
+
+    result->d_numStars        = 0;
+    result->d_precision       = -1;
+    result->d_isPrecisionStar = false;
+
+    if ('*' == *p) {
+        ++result->d_numStars;
+        ++p;
+    }
+    else {
+        while (isDigit(*p)) {
+            ++p;
+        }
+    }
+
+    if ('.' == *p) {
+        ++p;
+        if ('*' == *p) {
+            ++result->d_numStars;
+            result->d_isPrecisionStar = true;
+            ++p;
+        }
+        else {
+            result->d_precision = 0;
+            while (isDigit(*p)) {
+                result->d_precision = result->d_precision * 10 + (*p - '0');
+                ++p;
+            }
+        }
+    }
+
+    result->d_lengthBegin_p = p;
+
+    switch (*p) {
+      case 'h': {
+        ++p;
+        if ('h' == *p) {
+            ++p;
+            result->d_lengthModifier = ConversionSpec::e_CHAR;
+        }
+        else {
+            result->d_lengthModifier = ConversionSpec::e_SHORT;
+        }
+      } break;
+      case 'l': {
+        ++p;
+        if ('l' == *p) {
+            ++p;
+            result->d_lengthModifier = ConversionSpec::e_LONG_LONG;
+        }
+        else {
+            result->d_lengthModifier = ConversionSpec::e_LONG;
+        }
+      } break;
+      case 'z': {
+        ++p;
+        result->d_lengthModifier = ConversionSpec::e_SIZE;
+      } break;
+      case 't': {
+        ++p;
+        result->d_lengthModifier = ConversionSpec::e_PTRDIFF;
+      } break;
+      case 'L': {
+        ++p;
+        result->d_lengthModifier = ConversionSpec::e_LONG_DOUBLE;
+      } break;
+      case 'j':
+      case 'q':
+      case 'I': {
+        ++p;
+        result->d_lengthModifier = ConversionSpec::e_UNSUPPORTED;
+      } break;
+      default: {
+        result->d_lengthModifier = ConversionSpec::e_NONE;
+      } break;
+    }
+
+    result->d_specifier = *p;
+
+    return *p ? p + 1 : p;
+}
+
+template <class TYPE>
+bool putValue(char **position, const char *end, const TYPE& value)
+    // Copy the specified 'value' to the specified '*position', and advance
+    // '*position' past it, if it fits before the specified 'end'.  Return
+    // 'true' if 'value' was copied, and 'false' otherwise.
+{
+    if (static_cast<size_t>(end - *position) < sizeof value) {
+        return false;                                                 // RETURN
+    }
+    memcpy(*position, &value, sizeof value);
+    *position += sizeof value;
+    return true;
+}
+
+template <class TYPE>
+void getValue(TYPE *value, const char **position)
+    // Load into the specified 'value' the value at the specified
+    // '*position', stored by 'putValue', and advance '*position' past it.
+{
+    memcpy(value, *position, sizeof *value);
+    *position += sizeof *value;
+}
+
+int captureArguments(char        *buffer,
+                     int          size,
+                     const char  *format,
+                     va_list     *arguments)
+    // Store in the specified 'buffer' of the specified 'size' the values of
+    // the specified 'arguments' converted by the specified 'format', and
+    // return the number of bytes stored, or a negative value if 'format' has
+    // a conversion that cannot be captured, or the values do not fit in
+    // 'buffer'.  Integers are stored as 'long long' or 'unsigned long long',
+    // having been converted to the type given by their length modifier;
+    // floating-point values as 'double' or 'long double'; pointers as
+    // 'const void *'; and strings as their null-terminated characters (no
+    // more than the precision, if one is given), truncated to fit.
+{
+    char       *position = buffer;
+    const char *end      = buffer + size;
+
+    for (const char *p = format; *p; ) {
+        if ('%' != *p) {
+            ++p;
+            continue;
+        }
+        if ('%' == p[1]) {
+            p += 2;
+            continue;
+        }
+
+        ConversionSpec spec;
+        p = parseConversion(&spec, p);
+
+        int precision = spec.d_precision;
+
+        for (int i = 0; i < spec.d_numStars; ++i) {
+            precision = va_arg(*arguments, int);
+            if (!putValue(&position, end, precision)) {
+                return -1;                                            // RETURN
+            }
+        }
+        if (!spec.d_isPrecisionStar) {
+            precision = spec.d_precision;
+        }
+
+        bool success;
+
+        switch (spec.d_specifier) {
+          case 'd':
+          case 'i': {
+            long long value;
+            switch (spec.d_lengthModifier) {
+              case ConversionSpec::e_NONE: {
+                value = va_arg(*arguments, int);
+              } break;
+              case ConversionSpec::e_CHAR: {
+                value = static_cast<signed char>(va_arg(*arguments, int));
+              } break;
+              case ConversionSpec::e_SHORT: {
+                value = static_cast<short>(va_arg(*arguments, int));
+              } break;
+              case ConversionSpec::e_LONG: {
+                value = va_arg(*arguments, long);
+              } break;
+              case ConversionSpec::e_LONG_LONG: {
+                value = va_arg(*arguments, long long);
+              } break;
+              case ConversionSpec::e_SIZE:
+              case ConversionSpec::e_PTRDIFF: {
+                value = va_arg(*arguments, ptrdiff_t);
+              } break;
+              default: {
+                return -1;                                            // RETURN
+              }
+            }
+            success = putValue(&position, end, value);
+          } break;
+          case 'o':
+          case 'u':
+          case 'x':
+          case 'X': {
+            unsigned long long value;
+            switch (spec.d_lengthModifier) {
+              case ConversionSpec::e_NONE: {
+                value = va_arg(*arguments, unsigned int);
+              } break;
+              case ConversionSpec::e_CHAR: {
+                value = static_cast<unsigned char>(
+                                          va_arg(*arguments, unsigned int));
+              } break;
+              case ConversionSpec::e_SHORT: {
+                value = static_cast<unsigned short>(
+                                          va_arg(*arguments, unsigned int));
+              } break;
+              case ConversionSpec::e_LONG: {
+                value = va_arg(*arguments, unsigned long);
+              } break;
+              case ConversionSpec::e_LONG_LONG: {
+                value = va_arg(*arguments, unsigned long long);
+              } break;
+              case ConversionSpec::e_SIZE:
+              case ConversionSpec::e_PTRDIFF: {
+                value = va_arg(*arguments, size_t);
+              } break;
+              default: {
+                return -1;                                            // RETURN
+              }
+            }
+            success = putValue(&position, end, value);
+          } break;
+          case 'c': {
+            if (ConversionSpec::e_NONE != spec.d_lengthModifier) {
+                return -1;                                            // RETURN
+            }
+            success = putValue(&position, end, va_arg(*arguments, int));
+          } break;
+          case 'e':
+          case 'E':
+          case 'f':
+          case 'F':
+          case 'g':
+          case 'G':
+          case 'a':
+          case 'A': {
+            if (ConversionSpec::e_LONG_DOUBLE == spec.d_lengthModifier) {
+                success = putValue(&position,
+                                   end,
+                                   va_arg(*arguments, long double));
+            }
+            else if (ConversionSpec::e_NONE == spec.d_lengthModifier
+                  || ConversionSpec::e_LONG == spec.d_lengthModifier) {
+                success = putValue(&position,
+                                   end,
+                                   va_arg(*arguments, double));
+            }
+            else {
+                return -1;                                            // RETURN
+            }
+          } break;
+          case 'p': {
+            success = putValue(&position,
+                               end,
+                               va_arg(*arguments, const void *));
+          } break;
+          case 's': {
+            if (ConversionSpec::e_NONE != spec.d_lengthModifier
+             || position == end) {
+                return -1;                                            // RETURN
+            }
+
+            const char *string = va_arg(*arguments, const char *);
+            if (!string) {
+                string = "(null)";
+            }
+
+            // Copy no more characters than the precision, and leave room
+            // for the null.
+
+            const char *limit = end - 1;
+            if (0 <= precision && precision < limit - position) {
+                limit = position + precision;
+            }
+
+            while (position != limit && *string) {
+                *position++ = *string++;
+            }
+            *position++ = 0;
+            success = true;
+          } break;
+          default: {
+            return -1;                                                // RETURN
+          }
+        }
+
+        if (!success) {
+            return -1;                                                // RETURN
+        }
+    }
+
+    return static_cast<int>(position - buffer);
+}
+
+template <class TYPE>
+int formatValue(char       *buffer,
+                int         size,
+                const char *spec,
+                const int  *stars,
+                int         numStars,
+                TYPE        value)
+    // Format the specified 'value' into the specified 'buffer' of the
+    // specified 'size' according to the specified 'spec', supplying the
+    // specified 'numStars' elements of the specified 'stars' as the width and
+    // precision arguments of 'spec', and return the result of 'snprintf'.
+{
+    switch (numStars) {
+      case 0: {
+        return snprintf(buffer, size, spec, value);                   // RETURN
+      }
+      case 1: {
+        return snprintf(buffer, size, spec, stars[0], value);         // RETURN
+      }
+      default: {
+        return snprintf(buffer, size, spec, stars[0], stars[1], value);
+                                                                      // RETURN
+      }
+    }
+}
+
+int formatArguments(char       *buffer,
+                    int         size,
+                    const char *format,
+                    const char *arguments)
+    // Write into the specified 'buffer' of the specified 'size' the message
+    // that results from applying the specified 'format' to the specified
+    // 'arguments', captured by 'captureArguments', truncating the message to
+    // 'size - 1' characters, and return the number of characters written,
+    // not including the terminating null.  The behavior is undefined unless
+    // '0 < size'.
+{
+    char       *position = buffer;
+    char *const end      = buffer + size - 1;  // last character is the null
+
+    for (const char *p = format; *p && position != end; ) {
+        if ('%' != *p) {
+            *position++ = *p++;
+            continue;
+        }
+        if ('%' == p[1]) {
+            *position++ = '%';
+            p += 2;
+            continue;
+        }
+
+        // Rebuild the specification, replacing its length modifier by the one
+        // matching the type in which the argument was stored.
+
+        const char     *percent = p;
+        ConversionSpec  conversion;
+        p = parseConversion(&conversion, p);
+
+        const int prefixLength = static_cast<int>(conversion.d_lengthBegin_p
+                                                - percent);
+        if (prefixLength > k_MAX_SPEC_LENGTH - 4) {
+            break;
+        }
+
+        char spec[k_MAX_SPEC_LENGTH];
+        memcpy(spec, percent, prefixLength);
+        char *specEnd = spec + prefixLength;
+
+        int stars[k_MAX_NUM_STARS];
+        for (int i = 0; i < conversion.d_numStars; ++i) {
+            getValue(&stars[i], &arguments);
+        }
+
+        const int available = static_cast<int>(end - position) + 1;
+        int       numChars;
+
+        switch (conversion.d_specifier) {
+          case 'd':
+          case 'i': {
+            long long value;
+            getValue(&value, &arguments);
+            *specEnd++ = 'l';
+            *specEnd++ = 'l';
+            *specEnd++ = conversion.d_specifier;
+            *specEnd   = 0;
+            numChars = formatValue(position,
+                                   available,
+                                   spec,
+                                   stars,
+                                   conversion.d_numStars,
+                                   value);
+          } break;
+          case 'o':
+          case 'u':
+          case 'x':
+          case 'X': {
+            unsigned long long value;
+            getValue(&value, &arguments);
+            *specEnd++ = 'l';
+            *specEnd++ = 'l';
+            *specEnd++ = conversion.d_specifier;
+            *specEnd   = 0;
+            numChars = formatValue(position,
+                                   available,
+                                   spec,
+                                   stars,
+                                   conversion.d_numStars,
+                                   value);
+          } break;
+          case 'c': {
+            int value;
+            getValue(&value, &arguments);
+            *specEnd++ = 'c';
+            *specEnd   = 0;
+            numChars = formatValue(position,
+                                   available,
+                                   spec,
+                                   stars,
+                                   conversion.d_numStars,
+                                   value);
+          } break;
+          case 'p': {
+            const void *value;
+            getValue(&value, &arguments);
+            *specEnd++ = 'p';
+            *specEnd   = 0;
+            numChars = formatValue(position,
+                                   available,
+                                   spec,
+                                   stars,
+                                   conversion.d_numStars,
+                                   value);
+          } break;
+          case 's': {
+            const char *value = arguments;
+            arguments += strlen(arguments) + 1;
+            *specEnd++ = 's';
+            *specEnd   = 0;
+            numChars = formatValue(position,
+                                   available,
+                                   spec,
+                                   stars,
+                                   conversion.d_numStars,
+                                   value);
+          } break;
+          default: {
+            // A floating-point conversion ('captureArguments' accepts no
+            // other).
+
+            if (ConversionSpec::e_LONG_DOUBLE == conversion.d_lengthModifier) {
+                long double value;
+                getValue(&value, &arguments);
+                *specEnd++ = 'L';
+                *specEnd++ = conversion.d_specifier;
+                *specEnd   = 0;
+                numChars = formatValue(position,
+                                       available,
+                                       spec,
+                                       stars,
+                                       conversion.d_numStars,
+                                       value);
+            }
+            else {
+                double value;
+                getValue(&value, &arguments);
+                *specEnd++ = conversion.d_specifier;
+                *specEnd   = 0;
+                numChars = formatValue(position,
+                                       available,
+                                       spec,
+                                       stars,
+                                       conversion.d_numStars,
+                                       value);
+            }
+          } break;
+        }
+
+        if (numChars < 0 || numChars >= available) {
+            // The message is truncated ('snprintf' on some platforms returns
+            // a negative value in that case).
+
+            position = end;
+            break;
+        }
+        position += numChars;
+    }
+
+    *position = 0;
+    return static_cast<int>(position - buffer);
+}
+
+char *copyFileName(char *buffer, const char *file)
+    // Copy into the specified 'buffer' the specified 'file' name, shortened
+    // to its last 'k_MAX_FILE_LENGTH' characters, followed by a null, and
+    // return the address one past the null.
+{
+    size_t length = strlen(file);
+    if (length > k_MAX_FILE_LENGTH) {
+        file   += length - k_MAX_FILE_LENGTH;
+        length  = k_MAX_FILE_LENGTH;
+    }
+    memcpy(buffer, file, length);
+    buffer[length] = 0;
+    return buffer + length + 1;
+}
+
+int formatRecord(char *buffer, const Record& record)
+    // Write into the specified 'buffer', having 'k_MAX_LINE_LENGTH'
+    // characters, the line written to the file for the specified 'record',
+    // and return its length.
+{
+    const char *file = record.d_data;
+    const char *rest = file + strlen(file) + 1;
+
+    // The file name is short enough that the prefix always fits.
+
+    int length = snprintf(buffer,
+                          k_MAX_LINE_LENGTH,
+                          "%s:%d ",
+                          file,
+                          record.d_line);
+
+    // Leave room for the null, which the newline replaces.
+
+    if (record.d_format_p) {
+        length += formatArguments(buffer + length,
+                                  k_MAX_LINE_LENGTH - length - 1,
+                                  record.d_format_p,
+                                  rest);
+    }
+    else {
+        const size_t restLength = strlen(rest);
+        memcpy(buffer + length, rest, restLength);
+        length += static_cast<int>(restLength);
+    }
+
+    buffer[length++] = '\n';
+    return length;
+}
+
+void yieldProcessor()
+    // Yield the processor to other threads.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+void sleepBriefly()
+    // Suspend the calling thread for about a millisecond.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    Sleep(1);
+#else
+    timespec interval = { 0, 1000 * 1000 };
+    nanosleep(&interval, 0);
+#endif
+}
+
+}  // close unnamed namespace
+
+                          // ========================
+                          // struct AsyncLogSink_Ring
+                          // ========================
+
+struct AsyncLogSink_Ring {
+    // This 'struct' is a ring of log records written by the one thread that
+    // owns it, and read by the thread that drains the sink.  The producer
+    // and consumer indices are on separate cache lines.  The records follow
+    // the 'struct' in the same block of memory.
+
+    // Shared, rarely modified state.
+
+    AsyncLogSink_Ring                  *d_next_p;    // next ring of the sink
+                                                     // (immutable once the
+                                                     // ring is in the list)
+
+    AtomicOperations::AtomicTypes::Int  d_isOwned;   // 1 if a thread owns the
+                                                     // ring
+
+    char                                d_sharedPad[k_CACHE_LINE_SIZE
+                                                    - sizeof(void *)
+                                                    - sizeof(int)];
+
+    // Producer state.
+
+    AtomicOperations::AtomicTypes::Int64 d_writeIndex;
+                                                     // index after the last
+                                                     // committed record
+
+    Types::Int64                        d_cachedReadIndex;
+                                                     // producer's copy of
+                                                     // 'd_readIndex'
+
+    char                                d_producerPad[k_CACHE_LINE_SIZE
+                                                      - 2 * sizeof(
+                                                               Types::Int64)];
+
+    // Consumer state.
+
+    AtomicOperations::AtomicTypes::Int64 d_readIndex;
+                                                     // index of the next
+                                                     // record to write
+
+    char                                d_consumerPad[k_CACHE_LINE_SIZE
+                                                      - sizeof(Types::Int64)];
+
+    Record                              d_records[1];
+                                                     // first of the records
+};
+
+namespace {
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+VOID WINAPI releaseRing(PVOID ring)
+#else
+extern "C" void releaseRing(void *ring)
+#endif
+    // Make the specified 'ring', owned by a thread that is exiting, available
+    // for adoption by another thread.
+{
+    if (ring) {
+        AtomicOperations::setIntRelease(
+                         &static_cast<AsyncLogSink_Ring *>(ring)->d_isOwned,
+                         0);
+    }
+}
+
+struct Publisher {
+    // This 'struct' holds the state by which one thread announces that it is
+    // in a call to a class method of 'AsyncLogSink' that may use the started
+    // sink.  Only the thread owning a publisher writes to it, and each
+    // publisher is on a cache line of its own, so that logging threads do not
+    // contend.  Publishers are never freed: the publisher of an exited thread
+    // is adopted by the next thread needing one.
+
+    Publisher                           *d_next_p;    // next publisher
+                                                      // (immutable once the
+                                                      // publisher is in the
+                                                      // list)
+
+    AtomicOperations::AtomicTypes::Int   d_isOwned;   // 1 if a thread owns
+                                                      // the publisher
+
+    AtomicOperations::AtomicTypes::Int64 d_numCalls;  // number of calls
+                                                      // entered and exited;
+                                                      // odd while the owner
+                                                      // is in a call
+};
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef DWORD         PublisherKey;
+#else
+typedef pthread_key_t PublisherKey;
+#endif
+
+enum {
+    k_KEY_ABSENT   = 0,  // 's_publisherKey' is not yet created
+    k_KEY_CREATING = 1,  // 's_publisherKey' is being created
+    k_KEY_CREATED  = 2   // 's_publisherKey' may be used
+};
+
+AtomicOperations::AtomicTypes::Pointer s_publishers_p = { 0 };
+    // list of all publishers
+
+AtomicOperations::AtomicTypes::Int     s_publisherKeyState = { k_KEY_ABSENT };
+    // state of 's_publisherKey'
+
+PublisherKey                           s_publisherKey;
+    // key of the publisher of the calling thread
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+VOID WINAPI releasePublisher(PVOID publisher)
+#else
+extern "C" void releasePublisher(void *publisher)
+#endif
+    // Make the specified 'publisher', owned by a thread that is exiting,
+    // available for adoption by another thread.
+{
+    if (publisher) {
+        AtomicOperations::setIntRelease(
+                               &static_cast<Publisher *>(publisher)->d_isOwned,
+                               0);
+    }
+}
+
+void createPublisherKey()
+    // Create 's_publisherKey' unless it was already created.
+{
+    const int state = AtomicOperations::testAndSwapIntAcqRel(
+                                                         &s_publisherKeyState,
+                                                         k_KEY_ABSENT,
+                                                         k_KEY_CREATING);
+    if (k_KEY_ABSENT != state) {
+        while (k_KEY_CREATED != AtomicOperations::getIntAcquire(
+                                                      &s_publisherKeyState)) {
+            yieldProcessor();
+        }
+        return;                                                       // RETURN
+    }
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    s_publisherKey = FlsAlloc(&releasePublisher);
+    BSLS_ASSERT_OPT(FLS_OUT_OF_INDEXES != s_publisherKey);
+#else
+    const int status = pthread_key_create(&s_publisherKey, &releasePublisher);
+    BSLS_ASSERT_OPT(0 == status);
+    (void)status;
+#endif
+
+    AtomicOperations::setIntRelease(&s_publisherKeyState, k_KEY_CREATED);
+}
+
+Publisher *acquirePublisher()
+    // Return the publisher of the calling thread, adopting or creating it if
+    // the thread has none, or 0 if 's_publisherKey' was never created or no
+    // publisher can be obtained.
+{
+    const int state = AtomicOperations::getIntAcquire(&s_publisherKeyState);
+    if (k_KEY_CREATED != state) {
+        return 0;                                                     // RETURN
+    }
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    Publisher *publisher = static_cast<Publisher *>(
+                                                 FlsGetValue(s_publisherKey));
+#else
+    Publisher *publisher = static_cast<Publisher *>(
+                                         pthread_getspecific(s_publisherKey));
+#endif
+
+    if (publisher) {
+        return publisher;                                             // RETURN
+    }
+
+    // Adopt a publisher released by an exited thread, if there is one.
+
+    void *head = AtomicOperations::getPtrAcquire(&s_publishers_p);
+
+    for (publisher = static_cast<Publisher *>(head);
+         publisher;
+         publisher = publisher->d_next_p) {
+        if (0 == AtomicOperations::testAndSwapIntAcqRel(
+                                                        &publisher->d_isOwned,
+                                                        0,
+                                                        1)) {
+            break;
+        }
+    }
+
+    if (!publisher) {
+        // Allocate two cache lines, and place the publisher at the start of
+        // the cache line that lies entirely within them.
+
+        char *memory = static_cast<char *>(malloc(2 * k_CACHE_LINE_SIZE));
+        if (!memory) {
+            return 0;                                                 // RETURN
+        }
+
+        const size_t misalignment = reinterpret_cast<size_t>(memory)
+                                  % k_CACHE_LINE_SIZE;
+
+        publisher = reinterpret_cast<Publisher *>(
+                            memory + (misalignment
+                                      ? k_CACHE_LINE_SIZE - misalignment
+                                      : 0));
+
+        AtomicOperations::initInt(&publisher->d_isOwned, 1);
+        AtomicOperations::initInt64(&publisher->d_numCalls, 0);
+
+        for (;;) {
+            publisher->d_next_p = static_cast<Publisher *>(head);
+
+            void *previous = AtomicOperations::testAndSwapPtr(&s_publishers_p,
+                                                              head,
+                                                              publisher);
+            if (previous == head) {
+                break;
+            }
+            head = previous;
+        }
+    }
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    const bool isSet = FlsSetValue(s_publisherKey, publisher);
+#else
+    const bool isSet = 0 == pthread_setspecific(s_publisherKey, publisher);
+#endif
+
+    if (!isSet) {
+        releasePublisher(publisher);
+        return 0;                                                     // RETURN
+    }
+
+    return publisher;
+}
+
+Publisher *beginCall()
+    // Announce that the calling thread may use the started sink until the
+    // matching call to 'endCall', and return its publisher, or return 0,
+    // with no effect, if the calling thread has no publisher, in which case
+    // it must not use the started sink.
+{
+    Publisher *publisher = acquirePublisher();
+
+    if (publisher) {
+        // The store must precede, in the single total order of sequentially
+        // consistent operations, the subsequent load of the address of the
+        // started sink, which 'stop' resets before reading 'd_numCalls'.
+
+        const Types::Int64 numCalls = AtomicOperations::getInt64Relaxed(
+                                                      &publisher->d_numCalls);
+        AtomicOperations::setInt64(&publisher->d_numCalls, numCalls + 1);
+    }
+    return publisher;
+}
+
+void endCall(Publisher *publisher)
+    // Announce that the calling thread, owning the specified 'publisher'
+    // (which may be 0), no longer uses the started sink.
+{
+    if (publisher) {
+        const Types::Int64 numCalls = AtomicOperations::getInt64Relaxed(
+                                                      &publisher->d_numCalls);
+        AtomicOperations::setInt64Release(&publisher->d_numCalls,
+                                          numCalls + 1);
+    }
+}
+
+void waitForPublishers()
+    // Wait until no thread remains in a call that began before this call.
+{
+    // The load must follow, in the single total order of sequentially
+    // consistent operations, the reset of the address of the started sink,
+    // so that every publisher that may have loaded that address is visited.
+
+    void *head = AtomicOperations::getPtr(&s_publishers_p);
+
+    for (Publisher *publisher = static_cast<Publisher *>(head);
+         publisher;
+         publisher = publisher->d_next_p) {
+        const Types::Int64 numCalls = AtomicOperations::getInt64(
+                                                      &publisher->d_numCalls);
+
+        if (numCalls & 1) {
+            while (numCalls == AtomicOperations::getInt64Acquire(
+                                                     &publisher->d_numCalls)) {
+                yieldProcessor();
+            }
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+                            // ------------------
+                            // class AsyncLogSink
+                            // ------------------
+
+// CLASS DATA
+AtomicOperations::AtomicTypes::Pointer AsyncLogSink::s_startedSink_p = { 0 };
+
+// PRIVATE CLASS METHODS
+void AsyncLogSink::commitRecord(Ring *ring)
+{
+    const Types::Int64 writeIndex = AtomicOperations::getInt64Relaxed(
+                                                         &ring->d_writeIndex);
+
+    AtomicOperations::setInt64Release(&ring->d_writeIndex, writeIndex + 1);
+}
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+DWORD WINAPI AsyncLogSink::threadFunction(LPVOID sink)
+#else
+void *AsyncLogSink::threadFunction(void *sink)
+#endif
+{
+    AsyncLogSink *object = static_cast<AsyncLogSink *>(sink);
+
+    while (!object->d_isStopping.loadAcquire()) {
+        if (0 == object->drain()) {
+            sleepBriefly();
+        }
+    }
+
+    return 0;
+}
+
+// PRIVATE MANIPULATORS
+AsyncLogSink::Ring *AsyncLogSink::acquireRing()
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    Ring *ring = static_cast<Ring *>(FlsGetValue(d_ringKey));
+#else
+    Ring *ring = static_cast<Ring *>(pthread_getspecific(d_ringKey));
+#endif
+
+    if (ring) {
+        return ring;                                                  // RETURN
+    }
+
+    // Adopt a ring released by an exited thread, if there is one.
+
+    for (ring = d_rings_p.loadAcquire(); ring; ring = ring->d_next_p) {
+        if (0 == AtomicOperations::testAndSwapIntAcqRel(&ring->d_isOwned,
+                                                        0,
+                                                        1)) {
+            break;
+        }
+    }
+
+    if (!ring) {
+        ring = static_cast<Ring *>(malloc(sizeof(Ring)
+                                        + (d_capacity - 1) * sizeof(Record)));
+        if (!ring) {
+            return 0;                                                 // RETURN
+        }
+
+        AtomicOperations::initInt(&ring->d_isOwned, 1);
+        AtomicOperations::initInt64(&ring->d_writeIndex, 0);
+        AtomicOperations::initInt64(&ring->d_readIndex, 0);
+        ring->d_cachedReadIndex = 0;
+
+        Ring *head = d_rings_p.loadRelaxed();
+        for (;;) {
+            ring->d_next_p = head;
+
+            Ring *previous = d_rings_p.testAndSwap(head, ring);
+            if (previous == head) {
+                break;
+            }
+            head = previous;
+        }
+    }
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    const bool isSet = FlsSetValue(d_ringKey, ring);
+#else
+    const bool isSet = 0 == pthread_setspecific(d_ringKey, ring);
+#endif
+
+    if (!isSet) {
+        releaseRing(ring);
+        return 0;                                                     // RETURN
+    }
+
+    return ring;
+}
+
+void AsyncLogSink::publishFormattedImp(const char *file,
+                                       int         line,
+                                       const char *format,
+                                       va_list     arguments)
+{
+    BSLS_ASSERT_SAFE(file);
+    BSLS_ASSERT_SAFE(0 <= line);
+    BSLS_ASSERT_SAFE(format);
+
+    Ring   *ring;
+    Record *record = static_cast<Record *>(reserveRecord(&ring));
+    if (!record) {
+        return;                                                       // RETURN
+    }
+
+    record->d_line = line;
+
+    char      *data = copyFileName(record->d_data, file);
+    const int  size = static_cast<int>(record->d_data
+                                     + sizeof record->d_data
+                                     - data);
+
+    va_list copy;
+    va_copy(copy, arguments);
+    const int status = captureArguments(data, size, format, &copy);
+    va_end(copy);
+
+    if (0 <= status) {
+        record->d_format_p = format;
+    }
+    else {
+        // Format the message now, in the space that the arguments would have
+        // occupied.
+
+        record->d_format_p = 0;
+        vsnprintf(data, size, format, arguments);
+        data[size - 1] = 0;
+    }
+
+    commitRecord(ring);
+}
+
+void *AsyncLogSink::reserveRecord(Ring **ring)
+{
+    Ring *const myRing = acquireRing();
+    if (!myRing) {
+        d_numDropped.addRelaxed(1);
+        return 0;                                                     // RETURN
+    }
+
+    const Types::Int64 writeIndex = AtomicOperations::getInt64Relaxed(
+                                                       &myRing->d_writeIndex);
+
+    while (writeIndex - myRing->d_cachedReadIndex >= d_capacity) {
+        myRing->d_cachedReadIndex = AtomicOperations::getInt64Acquire(
+                                                        &myRing->d_readIndex);
+
+        if (writeIndex - myRing->d_cachedReadIndex < d_capacity) {
+            break;
+        }
+
+        if (e_DROP == d_overflowPolicy || !d_isStarted.loadRelaxed()) {
+            d_numDropped.addRelaxed(1);
+            return 0;                                                 // RETURN
+        }
+
+        yieldProcessor();
+    }
+
+    *ring = myRing;
+    return &myRing->d_records[writeIndex & (d_capacity - 1)];
+}
+
+// CLASS METHODS
+void AsyncLogSink::logFormattedMessage(const char *file,
+                                       int         line,
+                                       const char *format,
+                                       ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+
+    Publisher    *publisher = beginCall();
+    AsyncLogSink *sink      = publisher
+                            ? static_cast<AsyncLogSink *>(
+                                    AtomicOperations::getPtr(&s_startedSink_p))
+                            : 0;
+    if (sink) {
+        sink->publishFormattedImp(file, line, format, arguments);
+    }
+
+    endCall(publisher);
+
+    if (!sink) {
+        char buffer[k_MAX_LINE_LENGTH];
+        vsnprintf(buffer, sizeof buffer, format, arguments);
+        buffer[sizeof buffer - 1] = 0;
+
+        Log::logMessage(file, line, buffer);
+    }
+
+    va_end(arguments);
+}
+
+void AsyncLogSink::logMessageHandler(const char *file,
+                                     int         line,
+                                     const char *message)
+{
+    Publisher    *publisher = beginCall();
+    AsyncLogSink *sink      = publisher
+                            ? static_cast<AsyncLogSink *>(
+                                    AtomicOperations::getPtr(&s_startedSink_p))
+                            : 0;
+    if (sink) {
+        sink->publish(file, line, message);
+    }
+
+    endCall(publisher);
+
+    if (!sink) {
+        Log::platformDefaultMessageHandler(file, line, message);
+    }
+}
+
+// CREATORS
+AsyncLogSink::AsyncLogSink(FILE           *file,
+                           int             capacity,
+                           OverflowPolicy  overflowPolicy)
+: d_file_p(file)
+, d_capacity(capacity)
+, d_overflowPolicy(overflowPolicy)
+, d_rings_p(0)
+, d_numDropped(0)
+, d_numWritten(0)
+, d_isStarted(0)
+, d_isStopping(0)
+, d_previousHandler(0)
+{
+    BSLS_ASSERT(file);
+    BSLS_ASSERT(0 < capacity);
+    BSLS_ASSERT(0 == (capacity & (capacity - 1)));
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    d_ringKey = FlsAlloc(&releaseRing);
+    BSLS_ASSERT_OPT(FLS_OUT_OF_INDEXES != d_ringKey);
+#else
+    const int status = pthread_key_create(&d_ringKey, &releaseRing);
+    BSLS_ASSERT_OPT(0 == status);
+#endif
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+    stop();
+    drain();
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    FlsFree(d_ringKey);
+#else
+    pthread_key_delete(d_ringKey);
+#endif
+
+    Ring *ring = d_rings_p.loadAcquire();
+    while (ring) {
+        Ring *next = ring->d_next_p;
+        free(ring);
+        ring = next;
+    }
+}
+
+// MANIPULATORS
+int AsyncLogSink::drain()
+{
+    char line[k_MAX_LINE_LENGTH];
+    int  numWritten = 0;
+
+    for (Ring *ring = d_rings_p.loadAcquire(); ring; ring = ring->d_next_p) {
+        Types::Int64       readIndex  = AtomicOperations::getInt64Relaxed(
+                                                           &ring->d_readIndex);
+        const Types::Int64 writeIndex = AtomicOperations::getInt64Acquire(
+                                                          &ring->d_writeIndex);
+
+        while (readIndex != writeIndex) {
+            const int length = formatRecord(
+                             line,
+                             ring->d_records[readIndex & (d_capacity - 1)]);
+
+            // Release the record before writing the line, so that a thread
+            // blocked on a full ring does not wait for the file.
+
+            ++readIndex;
+            AtomicOperations::setInt64Release(&ring->d_readIndex, readIndex);
+
+            fwrite(line, 1, length, d_file_p);
+            ++numWritten;
+        }
+    }
+
+    if (numWritten) {
+        fflush(d_file_p);
+        d_numWritten.addRelaxed(numWritten);
+    }
+
+    return numWritten;
+}
+
+void AsyncLogSink::publish(const char *file, int line, const char *message)
+{
+    BSLS_ASSERT_SAFE(file);
+    BSLS_ASSERT_SAFE(0 <= line);
+    BSLS_ASSERT_SAFE(message);
+
+    Ring   *ring;
+    Record *record = static_cast<Record *>(reserveRecord(&ring));
+    if (!record) {
+        return;                                                       // RETURN
+    }
+
+    record->d_format_p = 0;
+    record->d_line     = line;
+
+    char *const data = copyFileName(record->d_data, file);
+    char *const end  = record->d_data + sizeof record->d_data - 1;
+
+    char *position = data;
+    while (position != end && *message) {
+        *position++ = *message++;
+    }
+    *position = 0;
+
+    commitRecord(ring);
+}
+
+void AsyncLogSink::publishFormatted(const char *file,
+                                    int         line,
+                                    const char *format,
+                                    ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    publishFormattedImp(file, line, format, arguments);
+    va_end(arguments);
+}
+
+int AsyncLogSink::start()
+{
+    BSLS_ASSERT(!isStarted());
+
+    d_isStopping.storeRelaxed(0);
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    d_thread = CreateThread(0, 0, &threadFunction, this, 0, 0);
+    if (0 == d_thread) {
+        return -1;                                                    // RETURN
+    }
+#else
+    if (0 != pthread_create(&d_thread, 0, &threadFunction, this)) {
+        return -1;                                                    // RETURN
+    }
+#endif
+
+    d_isStarted = 1;
+
+    // The key must exist before the address of this sink is published, since
+    // a thread using the started sink must first announce it (see
+    // 'beginCall').
+
+    createPublisherKey();
+
+    void *previous = AtomicOperations::testAndSwapPtr(&s_startedSink_p,
+                                                      0,
+                                                      this);
+    BSLS_ASSERT(0 == previous);
+    (void)previous;
+
+    d_previousHandler = Log::logMessageHandler();
+    Log::setLogMessageHandler(&logMessageHandler);
+
+    return 0;
+}
+
+void AsyncLogSink::stop()
+{
+    if (!isStarted()) {
+        return;                                                       // RETURN
+    }
+
+    Log::setLogMessageHandler(d_previousHandler);
+    AtomicOperations::setPtr(&s_startedSink_p, 0);
+
+    // Wait for the threads that may have loaded the address of this sink to
+    // finish publishing to it.
+
+    waitForPublishers();
+
+    d_isStopping = 1;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(d_thread, INFINITE);
+    CloseHandle(d_thread);
+#else
+    pthread_join(d_thread, 0);
+#endif
+
+    d_isStarted = 0;
+
+    drain();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
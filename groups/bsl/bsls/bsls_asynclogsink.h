@@ -0,0 +1,513 @@
+// bsls_asynclogsink.h                                                -*-C++-*-
+#ifndef INCLUDED_BSLS_ASYNCLOGSINK
+#define INCLUDED_BSLS_ASYNCLOGSINK
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an asynchronous, lock-free destination for 'bsls::Log'.
+//
+//@CLASSES:
+//  bsls::AsyncLogSink: buffers log records per thread, writes them to a file
+//
+//@MACROS:
+//  BSLS_ASYNCLOGSINK_LOG: log a 'printf'-style message, formatting it later
+//
+//@SEE_ALSO: bsls_log
+//
+//@DESCRIPTION: This component provides a mechanism, 'bsls::AsyncLogSink',
+// that removes the cost of writing low-level log messages from the threads
+// that log them.  The log message handlers supplied by 'bsls_log' (e.g.,
+// 'bsls::Log::platformDefaultMessageHandler') write each message to 'stderr'
+// in the logging thread, and flush the stream; when 'stderr' is a slow
+// device, a pipe that is not being read, or a terminal, a single message may
+// suspend the logging thread for milliseconds.  When a 'bsls::AsyncLogSink'
+// is started, the logging thread instead copies each message into a buffer
+// owned by that thread, and a background thread created by the sink later
+// writes the buffered messages to the 'FILE' supplied at construction.
+//
+///Buffering
+///---------
+// Each thread that logs through a sink is given its own ring buffer of
+// fixed-size records, so that logging threads never contend with one another,
+// and never acquire a lock: a record is published to the background thread
+// with a single release store.  Each record holds up to 'k_RECORD_SIZE'
+// bytes, including the file name and the message; longer messages are
+// truncated, and file names longer than 100 characters are shortened to
+// their last 100 characters.  The number of records in each ring is supplied
+// at construction ('k_DEFAULT_CAPACITY' by default).  A ring is allocated the
+// first time a thread logs, and, when that thread exits, is made available
+// for reuse by the next thread to log, so that the memory used by a sink is
+// proportional to the greatest number of threads that log concurrently.
+// Rings are returned to the system when the sink is destroyed.
+//
+// The background thread visits each ring in turn, writes the records it
+// finds, and, when it finds no records, sleeps for about a millisecond.
+// Records logged by one thread are written in the order in which they were
+// logged; records logged by different threads are not ordered with respect
+// to one another.  Each record is written in the format used by
+// 'bsls::Log::stderrMessageHandler' (the file name, a ':', the line number, a
+// space, and the message, followed by a newline).
+//
+///Overflow Policy
+///---------------
+// A thread that logs faster than the background thread can write may find
+// its ring full.  What happens then is decided by the 'OverflowPolicy'
+// supplied at construction:
+//
+//: 'e_DROP':  The record is discarded, and counted by 'numDropped'.  A
+//:            logging thread never waits.  This is the default.
+//:
+//: 'e_BLOCK': The logging thread yields the processor until the background
+//:            thread has written a record from the ring.  No record is lost,
+//:            but a logging thread may wait for the file.
+//
+// Note that the background thread exists only while the sink is started;
+// records that find a ring full while it is not are always dropped.
+//
+///Lazy Formatting
+///---------------
+// The log message handler of a sink, 'logMessageHandler', receives messages
+// that 'bsls::Log' has already formatted, and copies them.  A message logged
+// with the 'BSLS_ASYNCLOGSINK_LOG' macro (or the 'logFormattedMessage' class
+// method), on the other hand, is not formatted by the logging thread: only the
+// address of the format string, and the values of the arguments (including
+// a copy of the characters of each '%s' argument), are stored in the record,
+// and the message is formatted by the background thread.  The format string
+// of such a message must therefore remain valid until the sink has written
+// it; a string literal is always suitable.  A message whose format string
+// uses a conversion that this component does not capture ('%n', '%j', and
+// the wide-character conversions '%lc', '%ls', '%C', and '%S'), or whose
+// arguments do not fit in a record, is formatted by the logging thread
+// instead.  When no sink is started, 'BSLS_ASYNCLOGSINK_LOG' formats its
+// message immediately and passes it to the currently installed
+// 'bsls::Log' handler.
+//
+///Installation
+///------------
+// At most one sink may be started at any time.  'start' creates the
+// background thread, and installs 'bsls::AsyncLogSink::logMessageHandler' as
+// the log message handler of 'bsls::Log', remembering the handler that it
+// replaces.  'stop' restores that handler, waits for the logging threads
+// that are inside the handler to return, writes all buffered records, and
+// joins the background thread.  A message logged through
+// 'logMessageHandler' while no sink is started is passed to
+// 'bsls::Log::platformDefaultMessageHandler'.
+//
+// A sink may also be used without a background thread: 'publish' and
+// 'publishFormatted' buffer a record in the ring of the calling thread, and
+// 'drain' writes the buffered records from the calling thread.
+//
+///Thread Safety
+///-------------
+// 'publish', 'publishFormatted', and the class methods are thread-safe.
+// 'drain' may be called only while the sink is not started, and by one
+// thread at a time.  'start' and 'stop' may not be called concurrently with
+// each other, or with 'drain'.
+//
+///Usage
+///-----
+// This section illustrates the intended use of this component.
+//
+///Example 1: Moving Low-Level Logging Off Latency-Sensitive Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that an application processes requests on threads whose latency
+// matters, and that low-level library code occasionally logs warnings on
+// those threads through 'bsls::Log'.  We want those warnings written to a
+// file, by some other thread.
+//
+// First, we open the file, and create a sink that writes to it:
+//..
+//  FILE *file = tmpfile();
+//  assert(file);
+//
+//  bsls::AsyncLogSink sink(file);
+//..
+// Then, we start the sink, which installs its handler in 'bsls::Log':
+//..
+//  int rc = sink.start();
+//  assert(0 == rc);
+//  assert(&bsls::AsyncLogSink::logMessageHandler ==
+//                                           bsls::Log::logMessageHandler());
+//..
+// Next, we log two messages.  The first is formatted by 'bsls::Log' in the
+// calling thread; the second, logged with 'BSLS_ASYNCLOGSINK_LOG', is
+// formatted by the background thread of the sink:
+//..
+//  BSLS_LOG("Slow allocation: %d bytes", 4096);
+//  BSLS_ASYNCLOGSINK_LOG("Queue %s is %d%% full", "requests", 90);
+//..
+// Then, we stop the sink, which writes the messages, and restores the
+// previous handler:
+//..
+//  sink.stop();
+//  assert(&bsls::AsyncLogSink::logMessageHandler !=
+//                                           bsls::Log::logMessageHandler());
+//
+//  assert(2 == sink.numWritten());
+//  assert(0 == sink.numDropped());
+//..
+// Finally, we read back the file, and observe that it contains both messages:
+//..
+//  rewind(file);
+//
+//  char line[128];
+//  assert(fgets(line, sizeof line, file));
+//  assert(strstr(line, "Slow allocation: 4096 bytes\n"));
+//  assert(fgets(line, sizeof line, file));
+//  assert(strstr(line, "Queue requests is 90% full\n"));
+//
+//  fclose(file);
+//..
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_LOG
+#include <bsls_log.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_STDARG_H
+#include <stdarg.h>
+#define INCLUDED_STDARG_H
+#endif
+
+#ifndef INCLUDED_STDIO_H
+#include <stdio.h>
+#define INCLUDED_STDIO_H
+#endif
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+#ifndef INCLUDED_WINDOWS
+#include <windows.h>
+#define INCLUDED_WINDOWS
+#endif
+
+#else
+
+#ifndef INCLUDED_PTHREAD
+#include <pthread.h>
+#define INCLUDED_PTHREAD
+#endif
+
+#endif
+
+                      // ===========================
+                      // BSLS_ASYNCLOGSINK_LOG Macro
+                      // ===========================
+
+#define BSLS_ASYNCLOGSINK_LOG(...)                                            \
+    (BloombergLP::bsls::AsyncLogSink::logFormattedMessage(__FILE__,           \
+                                                          __LINE__,           \
+                                                          __VA_ARGS__))
+    // Write, to the started 'bsls::AsyncLogSink', a record of the message
+    // that results from applying the 'printf'-style formatting rules to the
+    // specified '...', using the first parameter as the format string and any
+    // further parameters as the substitutions, deferring the formatting to
+    // the background thread of the sink where possible.  If no sink is
+    // started, format the message immediately, and write it to the currently
+    // installed 'bsls::Log' handler.  The file name and line number of the
+    // point of expansion of the macro are used as the file name and line
+    // number of the record.  The behavior is undefined unless the first
+    // parameter of '...' is a valid 'printf'-style format string that remains
+    // valid until the message is written, and all substitutions needed by
+    // the format string are in the subsequent elements of '...'.
+
+namespace BloombergLP {
+namespace bsls {
+
+struct AsyncLogSink_Ring;  // ring of records owned by one thread (defined in
+                           // the '.cpp' file)
+
+                            // ==================
+                            // class AsyncLogSink
+                            // ==================
+
+class AsyncLogSink {
+    // This mechanism buffers log records in a lock-free ring per logging
+    // thread, and writes them, from a background thread or from 'drain', to
+    // the 'FILE' supplied at construction.  See the component-level
+    // documentation for details.
+
+  public:
+    // TYPES
+    enum OverflowPolicy {
+        // Enumerate the actions taken when a record finds the ring of the
+        // logging thread full.
+
+        e_DROP,   // discard the record
+        e_BLOCK   // wait for the background thread to make room
+    };
+
+    enum {
+        k_RECORD_SIZE      = 256,   // size of a record, in bytes
+
+        k_DEFAULT_CAPACITY = 1024   // default number of records per thread
+    };
+
+  private:
+    // PRIVATE TYPES
+    typedef AsyncLogSink_Ring Ring;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    typedef HANDLE        ThreadHandle;
+    typedef DWORD         ThreadKey;
+#else
+    typedef pthread_t     ThreadHandle;
+    typedef pthread_key_t ThreadKey;
+#endif
+
+    // CLASS DATA
+    static AtomicOperations::AtomicTypes::Pointer s_startedSink_p;
+                                            // sink that is started, or 0
+
+    // DATA
+    FILE                   *d_file_p;           // destination (held, not
+                                                // owned)
+
+    int                     d_capacity;         // records per ring
+
+    OverflowPolicy          d_overflowPolicy;   // action on a full ring
+
+    AtomicPointer<Ring>     d_rings_p;          // list of all rings (owned)
+
+    ThreadKey               d_ringKey;          // key of the ring of the
+                                                // calling thread
+
+    AtomicInt64             d_numDropped;       // records discarded
+
+    AtomicInt64             d_numWritten;       // records written
+
+    AtomicInt               d_isStarted;        // 1 while the background
+                                                // thread runs
+
+    AtomicInt               d_isStopping;       // 1 when the background
+                                                // thread must exit
+
+    ThreadHandle            d_thread;           // background thread
+
+    Log::LogMessageHandler  d_previousHandler;  // handler replaced by 'start'
+
+  private:
+    // NOT IMPLEMENTED
+    AsyncLogSink(const AsyncLogSink&);             // = delete
+    AsyncLogSink& operator=(const AsyncLogSink&);  // = delete
+
+    // PRIVATE CLASS METHODS
+    static void commitRecord(Ring *ring);
+        // Make the record most recently reserved in the specified 'ring'
+        // available to 'drain'.
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    static DWORD WINAPI threadFunction(LPVOID sink);
+#else
+    static void *threadFunction(void *sink);
+#endif
+        // Write the records of the specified 'sink', which is started, until
+        // it is stopped.
+
+    // PRIVATE MANIPULATORS
+    Ring *acquireRing();
+        // Return the ring of the calling thread, allocating one, or adopting
+        // one that was released by an exited thread, if the calling thread
+        // has none.  Return 0 if memory for a new ring cannot be obtained.
+
+    void publishFormattedImp(const char *file,
+                             int         line,
+                             const char *format,
+                             va_list     arguments);
+        // Store into the ring of the calling thread a record of the message
+        // created by calling 'vsprintf' on the specified 'format' with the
+        // specified 'arguments', logged at the specified 'file' and 'line'.
+        // See 'publishFormatted'.
+
+    void *reserveRecord(Ring **ring);
+        // Return the address of the next record in the ring of the calling
+        // thread, and load the address of that ring into the specified
+        // 'ring', applying the overflow policy of this sink if the ring is
+        // full; return 0, and count the record as dropped, if the record is
+        // to be discarded.  The record must be committed with 'commitRecord'
+        // before any other record is reserved by the calling thread.
+
+  public:
+    // CLASS METHODS
+    static void logFormattedMessage(const char *file,
+                                    int         line,
+                                    const char *format,
+                                    ...);
+        // Publish, to the started sink, a record of the message created by
+        // calling 'sprintf' on the specified 'format' with the specified
+        // variadic arguments, logged at the specified 'file' and 'line',
+        // deferring the formatting to the background thread of the sink
+        // where possible.  If no sink is started, format the message, and
+        // write it, with 'file' and 'line', to the currently installed
+        // 'bsls::Log' handler.  The behavior is undefined unless '0 <= line',
+        // and 'format' is a valid 'sprintf' format specification for the
+        // supplied variadic arguments that remains valid until the record is
+        // written.
+
+    static void logMessageHandler(const char *file,
+                                  int         line,
+                                  const char *message);
+        // Publish, to the started sink, a record of the specified 'message'
+        // logged at the specified 'file' and 'line'.  If no sink is started,
+        // pass 'file', 'line', and 'message' to
+        // 'bsls::Log::platformDefaultMessageHandler'.  The behavior is
+        // undefined unless '0 <= line'.  Note that this function has the
+        // signature of 'bsls::Log::LogMessageHandler', and is installed by
+        // 'start'.
+
+    // CREATORS
+    explicit AsyncLogSink(FILE           *file,
+                          int             capacity = k_DEFAULT_CAPACITY,
+                          OverflowPolicy  overflowPolicy = e_DROP);
+        // Create a sink, not started, that writes records to the specified
+        // 'file'.  Optionally specify 'capacity', the number of records that
+        // the ring of each logging thread can hold; if 'capacity' is not
+        // specified, 'k_DEFAULT_CAPACITY' is used.  Optionally specify an
+        // 'overflowPolicy' applied when a ring is full; if 'overflowPolicy'
+        // is not specified, 'e_DROP' is used.  The behavior is undefined
+        // unless 'file' is open for writing, and 'capacity' is a positive
+        // power of 2.
+
+    ~AsyncLogSink();
+        // Stop this sink if it is started, write any records it holds, and
+        // destroy it.  The behavior is undefined if a thread is in a call to
+        // 'publish' or 'publishFormatted' of this object.
+
+    // MANIPULATORS
+    int drain();
+        // Write to the file of this sink all records published to it that
+        // have not yet been written, flush the file if any record was
+        // written, and return the number of records written.  The behavior
+        // is undefined if this sink is started.
+
+    void publish(const char *file, int line, const char *message);
+        // Copy into the ring of the calling thread a record of the specified
+        // 'message' logged at the specified 'file' and 'line', applying the
+        // overflow policy of this sink if the ring is full.  Copy no more of
+        // 'file' and 'message' than fits in a record.  The behavior is
+        // undefined unless '0 <= line'.
+
+    void publishFormatted(const char *file,
+                          int         line,
+                          const char *format,
+                          ...);
+        // Store into the ring of the calling thread a record of the message
+        // created by calling 'sprintf' on the specified 'format' with the
+        // specified variadic arguments, logged at the specified 'file' and
+        // 'line', applying the overflow policy of this sink if the ring is
+        // full.  Store 'format' and the arguments, rather than the message,
+        // unless the conversions of 'format' cannot be captured, or the
+        // arguments do not fit in a record.  The behavior is undefined unless
+        // '0 <= line', and 'format' is a valid 'sprintf' format specification
+        // for the supplied variadic arguments that remains valid until the
+        // record is written.
+
+    int start();
+        // Create the background thread of this sink, and install
+        // 'logMessageHandler' as the log message handler of 'bsls::Log'.
+        // Return 0 on success, and a non-zero value, with no effect, if the
+        // thread cannot be created.  The behavior is undefined if this or
+        // any other sink is started.
+
+    void stop();
+        // Restore the log message handler that 'start' replaced, write all
+        // records buffered by this sink, and join its background thread.
+        // This method has no effect if this sink is not started.
+
+    // ACCESSORS
+    int capacity() const;
+        // Return the number of records that the ring of each thread can hold.
+
+    bool isStarted() const;
+        // Return 'true' if this sink is started, and 'false' otherwise.
+
+    Types::Int64 numDropped() const;
+        // Return the number of records that this sink discarded because the
+        // ring of the logging thread was full.
+
+    Types::Int64 numWritten() const;
+        // Return the number of records that this sink has written to its
+        // file.  The value returned is exact only if this sink is not
+        // started.
+
+    OverflowPolicy overflowPolicy() const;
+        // Return the policy applied when the ring of a logging thread is full.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                            // ------------------
+                            // class AsyncLogSink
+                            // ------------------
+
+// ACCESSORS
+inline
+int AsyncLogSink::capacity() const
+{
+    return d_capacity;
+}
+
+inline
+bool AsyncLogSink::isStarted() const
+{
+    return d_isStarted.loadRelaxed();
+}
+
+inline
+Types::Int64 AsyncLogSink::numDropped() const
+{
+    return d_numDropped.loadRelaxed();
+}
+
+inline
+Types::Int64 AsyncLogSink::numWritten() const
+{
+    return d_numWritten.loadRelaxed();
+}
+
+inline
+AsyncLogSink::OverflowPolicy AsyncLogSink::overflowPolicy() const
+{
+    return d_overflowPolicy;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1267 @@
+// bsls_asynclogsink.t.cpp                                            -*-C++-*-
+#include <bsls_asynclogsink.h>
+
+#include <bsls_atomic.h>         // for testing only
+#include <bsls_bsltestutil.h>    // for testing only
+#include <bsls_log.h>            // for testing only
+#include <bsls_stopwatch.h>      // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a mechanism that buffers log records in a ring
+// per thread, and writes them to a file from a background thread, or from
+// 'drain'.  We first test, without a background thread, that 'publish' and
+// 'drain' write each record in the expected format, truncating long messages
+// and shortening long file names.  We then verify that 'publishFormatted'
+// produces the message that 'snprintf' produces for a variety of
+// conversions, that it defers the formatting where it can (by changing the
+// format string after publishing), and that it formats immediately where it
+// cannot.  Next, we verify both overflow policies, and the reuse of the rings
+// of exited threads.  Finally, we verify that 'start' and 'stop' install and
+// restore the handler of 'bsls::Log', and that records published by several
+// threads while the sink is started are all written.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 5] void logFormattedMessage(const char *, int, const char *, ...);
+// [ 5] void logMessageHandler(const char *, int, const char *);
+//
+// CREATORS
+// [ 1] AsyncLogSink(FILE *, int = k_DEFAULT_CAPACITY, OverflowPolicy = DROP);
+// [ 1] ~AsyncLogSink();
+//
+// MANIPULATORS
+// [ 2] int drain();
+// [ 2] void publish(const char *file, int line, const char *message);
+// [ 3] void publishFormatted(const char *, int, const char *, ...);
+// [ 5] int start();
+// [ 5] void stop();
+//
+// ACCESSORS
+// [ 1] int capacity() const;
+// [ 5] bool isStarted() const;
+// [ 4] Types::Int64 numDropped() const;
+// [ 2] Types::Int64 numWritten() const;
+// [ 1] OverflowPolicy overflowPolicy() const;
+//
+// MACROS
+// [ 5] BSLS_ASYNCLOGSINK_LOG(...)
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] CONCERN: A full ring drops or blocks according to the policy.
+// [ 4] CONCERN: The ring of an exited thread is reused.
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: LATENCY OF LOGGING
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bsls::AsyncLogSink Obj;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+enum { k_BUFFER_SIZE = 1 << 20 };
+
+static char g_contents[k_BUFFER_SIZE];  // contents of the file last read
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+const char *readFile(FILE *file)
+    // Return the contents of the specified 'file', which is left positioned
+    // at its end.  Note that the returned string is overwritten by the next
+    // call.
+{
+    fflush(file);
+    rewind(file);
+
+    size_t length = fread(g_contents, 1, sizeof g_contents - 1, file);
+    g_contents[length] = 0;
+
+    fseek(file, 0, SEEK_END);
+    return g_contents;
+}
+
+static
+int countLines(const char *string)
+    // Return the number of newlines in the specified 'string'.
+{
+    int count = 0;
+    for (; *string; ++string) {
+        count += '\n' == *string;
+    }
+    return count;
+}
+
+static
+const char *skipLines(const char *string, int numLines)
+    // Return the address of the character following the specified
+    // 'numLines'th newline in the specified 'string', or of the terminating
+    // null if 'string' has fewer newlines.
+{
+    for (; *string && numLines; ++string) {
+        numLines -= '\n' == *string;
+    }
+    return string;
+}
+
+static
+const char *lastLine(FILE *file)
+    // Return the last line of the specified 'file', without its newline, or
+    // an empty string if 'file' is empty.  Note that the returned string is
+    // overwritten by the next call.
+{
+    char  *contents = const_cast<char *>(readFile(file));
+    size_t length   = strlen(contents);
+
+    if (0 == length) {
+        return contents;                                              // RETURN
+    }
+    contents[--length] = 0;
+
+    char *newline = strrchr(contents, '\n');
+    return newline ? newline + 1 : contents;
+}
+
+                                // -----------
+                                // cases 5, -1
+                                // -----------
+
+static const char *g_recordedMessage = 0;  // last message passed to
+                                           // 'recordingHandler'
+
+static bsls::AtomicInt g_numRecorded;      // calls to 'recordingHandler'
+
+static char g_recordedBuffer[1024];
+
+static FILE *g_handlerFile = 0;            // file of 'fileHandler'
+
+static
+void recordingHandler(const char *, int, const char *message)
+    // Record the specified 'message'.
+{
+    strncpy(g_recordedBuffer, message, sizeof g_recordedBuffer - 1);
+    g_recordedMessage = g_recordedBuffer;
+    ++g_numRecorded;
+}
+
+static
+void fileHandler(const char *file, int line, const char *message)
+    // Write the specified 'file', 'line', and 'message' to 'g_handlerFile',
+    // as 'bsls::Log::stderrMessageHandler' writes them to 'stderr'.
+{
+    fprintf(g_handlerFile, "%s:%d %s\n", file, line, message);
+    fflush(g_handlerFile);
+}
+
+                                // --------------
+                                // cases 4, 5, -1
+                                // --------------
+
+enum { k_MAX_THREADS = 16 };
+
+struct LoggerInfo {
+    Obj             *d_sink_p;          // sink to publish to, or 0 to log
+                                        // through 'bsls::Log'
+    int              d_numThreads;      // number of threads
+    int              d_numRecords;      // records per thread
+    bsls::AtomicInt  d_go;              // set to start all threads at once
+    bsls::AtomicInt  d_nextId;          // source of thread ids
+    bsls::AtomicInt  d_numDone;         // threads that have logged
+};
+
+extern "C" void *loggerFunction(void *arg)
+    // Wait until the 'd_go' member of the specified 'arg', which must be the
+    // address of a 'LoggerInfo' object, is set, and then log 'd_numRecords'
+    // records, each having the id of the thread as its line number, and the
+    // sequence number of the record within the thread as its message; then
+    // wait for the other threads to finish logging, so that no thread exits
+    // (releasing its ring) while another logs.
+{
+    LoggerInfo *info = static_cast<LoggerInfo *>(arg);
+    const int   id   = info->d_nextId++;
+
+    while (0 == info->d_go) {
+    }
+
+    for (int i = 0; i < info->d_numRecords; ++i) {
+        char message[16];
+        sprintf(message, "%d", i);
+
+        if (info->d_sink_p) {
+            info->d_sink_p->publish("logger.cpp", id, message);
+        }
+        else {
+            bsls::Log::logMessage("logger.cpp", id, message);
+        }
+    }
+
+    ++info->d_numDone;
+    while (info->d_numThreads != info->d_numDone) {
+    }
+
+    return arg;
+}
+
+static
+void runLoggerThreads(Obj *sink, int numThreads, int numRecords)
+    // Log the specified 'numRecords' records in each of the specified
+    // 'numThreads' threads, to the specified 'sink', or through 'bsls::Log'
+    // if 'sink' is 0.  The behavior is undefined unless
+    // '0 < numThreads <= k_MAX_THREADS'.
+{
+    LoggerInfo info;
+    info.d_sink_p     = sink;
+    info.d_numThreads = numThreads;
+    info.d_numRecords = numRecords;
+    info.d_go         = 0;
+    info.d_nextId     = 0;
+    info.d_numDone    = 0;
+
+    ThreadId ids[k_MAX_THREADS];
+    for (int i = 0; i < numThreads; ++i) {
+        ids[i] = createThread(&loggerFunction, &info);
+    }
+    info.d_go = 1;
+    for (int i = 0; i < numThreads; ++i) {
+        joinThread(ids[i]);
+    }
+}
+
+static
+bool verifyLoggerOutput(const char *contents, int numThreads, int numRecords)
+    // Return 'true' if the specified 'contents' hold exactly the records
+    // logged by 'runLoggerThreads' for the specified 'numThreads' and
+    // 'numRecords', with the records of each thread in order, and 'false'
+    // otherwise.
+{
+    int next[k_MAX_THREADS] = { 0 };
+
+    for (const char *p = contents; *p; ) {
+        int id;
+        int sequence;
+        if (2 != sscanf(p, "logger.cpp:%d %d", &id, &sequence)
+         || id < 0
+         || id >= numThreads
+         || sequence != next[id]) {
+            return false;                                             // RETURN
+        }
+        ++next[id];
+
+        p = strchr(p, '\n');
+        if (!p) {
+            return false;                                             // RETURN
+        }
+        ++p;
+    }
+
+    for (int i = 0; i < numThreads; ++i) {
+        if (numRecords != next[i]) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+static bsls::AtomicInt g_numCounted;       // calls to 'countingHandler'
+
+static
+void countingHandler(const char *, int, const char *)
+    // Count the call.
+{
+    ++g_numCounted;
+}
+
+struct StopInfo {
+    bsls::AtomicInt d_isDone;     // set to make the threads exit
+    bsls::AtomicInt d_numLogged;  // messages logged by all threads
+};
+
+extern "C" void *logUntilDoneFunction(void *arg)
+    // Log through 'bsls::Log', and count in the 'd_numLogged' member of the
+    // specified 'arg', which must be the address of a 'StopInfo' object,
+    // messages until its 'd_isDone' member is set.
+{
+    StopInfo *info = static_cast<StopInfo *>(arg);
+
+    while (0 == info->d_isDone) {
+        bsls::Log::logMessage("stop.cpp", 1, "message");
+        ++info->d_numLogged;
+    }
+    return arg;
+}
+
+extern "C" void *publishOnceFunction(void *arg)
+    // Publish one record to the sink at the specified 'arg'.
+{
+    static_cast<Obj *>(arg)->publish("exited.cpp", 1, "from exited thread");
+    return arg;
+}
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+///Usage
+///-----
+// This section illustrates the intended use of this component.
+//
+///Example 1: Moving Low-Level Logging Off Latency-Sensitive Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that an application processes requests on threads whose latency
+// matters, and that low-level library code occasionally logs warnings on
+// those threads through 'bsls::Log'.  We want those warnings written to a
+// file, by some other thread.
+//
+// First, we open the file, and create a sink that writes to it:
+//..
+    FILE *file = tmpfile();
+    ASSERT(file);
+
+    bsls::AsyncLogSink sink(file);
+//..
+// Then, we start the sink, which installs its handler in 'bsls::Log':
+//..
+    int rc = sink.start();
+    ASSERT(0 == rc);
+    ASSERT(&bsls::AsyncLogSink::logMessageHandler ==
+                                             bsls::Log::logMessageHandler());
+//..
+// Next, we log two messages.  The first is formatted by 'bsls::Log' in the
+// calling thread; the second, logged with 'BSLS_ASYNCLOGSINK_LOG', is
+// formatted by the background thread of the sink:
+//..
+    BSLS_LOG("Slow allocation: %d bytes", 4096);
+    BSLS_ASYNCLOGSINK_LOG("Queue %s is %d%% full", "requests", 90);
+//..
+// Then, we stop the sink, which writes the messages, and restores the
+// previous handler:
+//..
+    sink.stop();
+    ASSERT(&bsls::AsyncLogSink::logMessageHandler !=
+                                             bsls::Log::logMessageHandler());
+
+    ASSERT(2 == sink.numWritten());
+    ASSERT(0 == sink.numDropped());
+//..
+// Finally, we read back the file, and observe that it contains both messages:
+//..
+    rewind(file);
+
+    char line[128];
+    ASSERT(fgets(line, sizeof line, file));
+    ASSERT(strstr(line, "Slow allocation: 4096 bytes\n"));
+    ASSERT(fgets(line, sizeof line, file));
+    ASSERT(strstr(line, "Queue requests is 90% full\n"));
+
+    fclose(file);
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'start' AND 'stop'
+        //
+        // Concerns:
+        //: 1 'start' installs 'logMessageHandler' in 'bsls::Log', and 'stop'
+        //:   restores the handler that 'start' replaced.
+        //:
+        //: 2 While a sink is started, 'logMessageHandler' and
+        //:   'logFormattedMessage' publish to it; while none is,
+        //:   'logFormattedMessage' formats its message and passes it to the
+        //:   installed 'bsls::Log' handler.
+        //:
+        //: 3 'stop' writes every record published before it returns, and
+        //:   'isStarted' reflects the state of the sink.
+        //:
+        //: 4 Records logged through 'bsls::Log' by several threads while the
+        //:   sink is started are all written, in order for each thread.
+        //:
+        //: 5 A sink can be restarted, and the destructor stops a started sink.
+        //:
+        //: 6 A sink can be stopped and destroyed while threads are logging
+        //:   through 'bsls::Log', and every message is written by the sink,
+        //:   or passed to the restored handler or (for at most one call per
+        //:   thread) to 'bsls::Log::platformDefaultMessageHandler'.
+        //
+        // Plan:
+        //: 1 Install a recording handler, start a sink, and verify the
+        //:   installed handler.  Log through 'BSLS_LOG', 'BSLS_LOG_SIMPLE',
+        //:   and 'BSLS_ASYNCLOGSINK_LOG', stop the sink, and verify the
+        //:   file, and that the recording handler is installed again and has
+        //:   received nothing.  (C-1..3)
+        //:
+        //: 2 With no sink started, log with 'BSLS_ASYNCLOGSINK_LOG', and
+        //:   verify that the recording handler receives the formatted
+        //:   message.  (C-2)
+        //:
+        //: 3 Start the sink, log from several threads through 'bsls::Log',
+        //:   stop it, and verify the output with 'verifyLoggerOutput'.
+        //:   (C-4..5)
+        //:
+        //: 4 Start a sink, publish a record, and let the sink go out of
+        //:   scope; verify the file and the installed handler.  (C-5)
+        //:
+        //: 5 Install a counting handler, start a sink, and create several
+        //:   threads logging through 'bsls::Log' until told to stop.  While
+        //:   they log, stop and destroy the sink, then stop the threads, and
+        //:   verify that the number of messages logged exceeds the sum of the
+        //:   number written by the sink and the number counted by at most
+        //:   the number of threads.  Repeat a number of times.  (C-6)
+        //
+        // Testing:
+        //   void logFormattedMessage(const char *, int, const char *, ...);
+        //   void logMessageHandler(const char *, int, const char *);
+        //   int start();
+        //   void stop();
+        //   bool isStarted() const;
+        //   BSLS_ASYNCLOGSINK_LOG(...)
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'start' AND 'stop'"
+                            "\n==================\n");
+
+        bsls::Log::setLogMessageHandler(&recordingHandler);
+
+        FILE *file = tmpfile();
+        ASSERT(file);
+
+        {
+            Obj mX(file);  const Obj& X = mX;
+
+            ASSERT(!X.isStarted());
+
+            ASSERT(0 == mX.start());
+            ASSERT( X.isStarted());
+            ASSERT(&Obj::logMessageHandler == bsls::Log::logMessageHandler());
+
+            BSLS_LOG("formatted %d", 1);
+            BSLS_LOG_SIMPLE("simple");
+            BSLS_ASYNCLOGSINK_LOG("lazy %s %d", "two", 3);
+
+            mX.stop();
+            ASSERT(!X.isStarted());
+            ASSERT(&recordingHandler == bsls::Log::logMessageHandler());
+            ASSERT(0 == g_numRecorded);
+
+            const char *contents = readFile(file);
+            if (veryVerbose) printf("%s", contents);
+
+            ASSERT(3 == X.numWritten());
+            ASSERT(3 == countLines(contents));
+            ASSERT(strstr(contents, " formatted 1\n"));
+            ASSERT(strstr(contents, " simple\n"));
+            ASSERT(strstr(contents, " lazy two 3\n"));
+            ASSERT(strstr(contents, "bsls_asynclogsink.t.cpp:"));
+
+            if (verbose) printf("\tWith no sink started.\n");
+
+            BSLS_ASYNCLOGSINK_LOG("eager %s %d", "four", 5);
+            ASSERT(1 == g_numRecorded);
+            ASSERTV(g_recordedMessage,
+                    0 == strcmp("eager four 5", g_recordedMessage));
+            ASSERT(3 == countLines(readFile(file)));
+
+            if (verbose) printf("\tRestarting, with several threads.\n");
+
+            const int NUM_THREADS = 4;
+            const int NUM_RECORDS = 2000;
+
+            Obj mY(file, 64, Obj::e_BLOCK);  const Obj& Y = mY;
+
+            ASSERT(0 == mY.start());
+            runLoggerThreads(0, NUM_THREADS, NUM_RECORDS);
+            mY.stop();
+
+            ASSERT(NUM_THREADS * NUM_RECORDS == Y.numWritten());
+            ASSERT(0 == Y.numDropped());
+
+            ASSERT(0 == mY.start());
+            mY.stop();
+            ASSERT(0 == mY.drain());
+
+            contents = readFile(file);
+            ASSERT(verifyLoggerOutput(skipLines(contents, 3),
+                                      NUM_THREADS,
+                                      NUM_RECORDS));
+            ASSERT(&recordingHandler == bsls::Log::logMessageHandler());
+            ASSERT(1 == g_numRecorded);
+        }
+
+        if (verbose) printf("\tThe destructor stops the sink.\n");
+        {
+            rewind(file);
+
+            FILE *other = tmpfile();
+            ASSERT(other);
+            {
+                Obj mX(other);
+
+                ASSERT(0 == mX.start());
+                BSLS_LOG_SIMPLE("last");
+            }
+            ASSERT(&recordingHandler == bsls::Log::logMessageHandler());
+            ASSERT(0 == strcmp("last", strchr(lastLine(other), ' ') + 1));
+            fclose(other);
+        }
+
+        if (verbose) printf("\tStopping while threads are logging.\n");
+        {
+            const int NUM_THREADS    = 4;
+            const int NUM_ITERATIONS = 20;
+
+            bsls::Log::setLogMessageHandler(&countingHandler);
+
+            FILE *other = tmpfile();
+            ASSERT(other);
+
+            for (int i = 0; i < NUM_ITERATIONS; ++i) {
+                StopInfo info;
+                info.d_isDone    = 0;
+                info.d_numLogged = 0;
+
+                g_numCounted = 0;
+
+                ThreadId           ids[NUM_THREADS];
+                bsls::Types::Int64 numWritten = 0;
+                {
+                    Obj mX(other, 64, Obj::e_BLOCK);  const Obj& X = mX;
+
+                    ASSERT(0 == mX.start());
+
+                    for (int j = 0; j < NUM_THREADS; ++j) {
+                        ids[j] = createThread(&logUntilDoneFunction, &info);
+                    }
+
+                    while (info.d_numLogged < 100) {
+                    }
+
+                    mX.stop();
+                    numWritten = X.numWritten();
+                    ASSERTV(i, X.numDropped(), 0 == X.numDropped());
+
+                    // Destroy the sink while the threads log to the restored
+                    // handler.
+
+                    while (0 == g_numCounted) {
+                    }
+                }
+
+                info.d_isDone = 1;
+                for (int j = 0; j < NUM_THREADS; ++j) {
+                    joinThread(ids[j]);
+                }
+
+                const bsls::Types::Int64 NUM_LOGGED  = info.d_numLogged;
+                const bsls::Types::Int64 NUM_COUNTED = g_numCounted;
+
+                // A thread that called 'logMessageHandler' just as the sink
+                // was stopped passes its message to
+                // 'bsls::Log::platformDefaultMessageHandler' instead; at most
+                // one call per thread straddles the restoration.
+
+                const bsls::Types::Int64 NUM_MISSED = NUM_LOGGED
+                                                    - numWritten
+                                                    - NUM_COUNTED;
+
+                ASSERTV(i, NUM_LOGGED, numWritten, NUM_COUNTED,
+                        0 <= NUM_MISSED && NUM_MISSED <= NUM_THREADS);
+            }
+
+            fclose(other);
+        }
+
+        fclose(file);
+        bsls::Log::setLogMessageHandler(
+                                   &bsls::Log::platformDefaultMessageHandler);
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // OVERFLOW POLICIES AND RING REUSE
+        //
+        // Concerns:
+        //: 1 With 'e_DROP', a record that finds the ring of its thread full
+        //:   is discarded and counted, and the records already in the ring
+        //:   are kept.
+        //:
+        //: 2 With 'e_BLOCK', a record that finds the ring full while the sink
+        //:   is not started is discarded (there is no thread to wait for).
+        //:
+        //: 3 With 'e_BLOCK', while the sink is started, no record is lost,
+        //:   however small the ring.
+        //:
+        //: 4 Each thread has its own ring.
+        //:
+        //: 5 The ring of an exited thread is adopted by the next thread to
+        //:   publish, after its records are written.
+        //
+        // Plan:
+        //: 1 For each policy, publish 'capacity + 5' records without
+        //:   draining, and verify 'numDropped', and the records written by
+        //:   'drain'.  (C-1..2)
+        //:
+        //: 2 Publish from several threads to a sink having rings of 4
+        //:   records, with 'e_DROP', and with no drain; verify that each
+        //:   thread kept 4 records.  (C-4)
+        //:
+        //: 3 Start a sink having rings of 2 records with 'e_BLOCK', publish
+        //:   many records from several threads, and verify, after 'stop',
+        //:   that all are written.  (C-3)
+        //:
+        //: 4 In a sink having rings of one record, publish a record from a
+        //:   thread that then exits, and then from another thread, with
+        //:   'e_DROP'.  Verify that the second record is dropped before
+        //:   'drain' (the adopted ring is full), and written after.  (C-5)
+        //
+        // Testing:
+        //   Types::Int64 numDropped() const;
+        //   CONCERN: A full ring drops or blocks according to the policy.
+        //   CONCERN: The ring of an exited thread is reused.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nOVERFLOW POLICIES AND RING REUSE"
+                            "\n================================\n");
+
+        if (verbose) printf("\tFull ring, not started.\n");
+        {
+            const Obj::OverflowPolicy POLICIES[] = { Obj::e_DROP,
+                                                     Obj::e_BLOCK };
+
+            for (int ti = 0; ti < 2; ++ti) {
+                FILE *file = tmpfile();
+                ASSERT(file);
+
+                Obj mX(file, 16, POLICIES[ti]);  const Obj& X = mX;
+
+                for (int i = 0; i < 16 + 5; ++i) {
+                    char message[16];
+                    sprintf(message, "%d", i);
+                    mX.publish("logger.cpp", 0, message);
+                }
+                ASSERTV(ti, 5 == X.numDropped());
+
+                ASSERTV(ti, 16 == mX.drain());
+                ASSERTV(ti, verifyLoggerOutput(readFile(file), 1, 16));
+
+                mX.publish("logger.cpp", 0, "16");
+                ASSERTV(ti, 1 == mX.drain());
+                ASSERTV(ti, verifyLoggerOutput(readFile(file), 1, 17));
+                ASSERTV(ti, 5 == X.numDropped());
+
+                fclose(file);
+            }
+        }
+
+        if (verbose) printf("\tOne ring per thread.\n");
+        {
+            FILE *file = tmpfile();
+            ASSERT(file);
+
+            Obj mX(file, 4);  const Obj& X = mX;
+
+            runLoggerThreads(&mX, 8, 10);
+            ASSERT(8 * 6 == X.numDropped());
+
+            ASSERT(8 * 4 == mX.drain());
+            ASSERT(verifyLoggerOutput(readFile(file), 8, 4));
+
+            fclose(file);
+        }
+
+        if (verbose) printf("\tBlocking, started.\n");
+        {
+            FILE *file = tmpfile();
+            ASSERT(file);
+
+            Obj mX(file, 2, Obj::e_BLOCK);  const Obj& X = mX;
+
+            ASSERT(0 == mX.start());
+            runLoggerThreads(&mX, 8, 1000);
+            mX.stop();
+
+            ASSERT(0        == X.numDropped());
+            ASSERT(8 * 1000 == X.numWritten());
+            ASSERT(verifyLoggerOutput(readFile(file), 8, 1000));
+
+            fclose(file);
+        }
+
+        if (verbose) printf("\tRing reuse.\n");
+        {
+            FILE *file = tmpfile();
+            ASSERT(file);
+
+            Obj mX(file, 1);  const Obj& X = mX;
+
+            joinThread(createThread(&publishOnceFunction, &mX));
+            ASSERT(0 == X.numDropped());
+
+            joinThread(createThread(&publishOnceFunction, &mX));
+            ASSERT(1 == X.numDropped());
+
+            ASSERT(1 == mX.drain());
+
+            joinThread(createThread(&publishOnceFunction, &mX));
+            ASSERT(1 == X.numDropped());
+            ASSERT(1 == mX.drain());
+
+            ASSERT(2 == countLines(readFile(file)));
+
+            fclose(file);
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'publishFormatted'
+        //
+        // Concerns:
+        //: 1 The message written is the one that 'snprintf' produces, for
+        //:   every kind of conversion, length modifier, flag, width, and
+        //:   precision, including those given by '*'.
+        //:
+        //: 2 Where the arguments can be captured, the formatting is deferred
+        //:   to 'drain', and the characters of '%s' arguments are copied.
+        //:
+        //: 3 Where they cannot (an unsupported conversion, or too many
+        //:   arguments for a record), the message is formatted immediately,
+        //:   and truncated to fit in the record.
+        //:
+        //: 4 A formatted message is truncated to the greatest line length.
+        //
+        // Plan:
+        //: 1 Using the 'TEST_FORMAT' macro, publish a message and format the
+        //:   same arguments with 'snprintf', and compare the line written by
+        //:   'drain' with the expected one, for a set of formats covering
+        //:   concern 1.  (C-1)
+        //:
+        //: 2 Publish with a format string in a modifiable buffer, and a '%s'
+        //:   argument in another; change both before 'drain'.  Verify that
+        //:   the new format and the old argument are used.  (C-2)
+        //:
+        //: 3 Repeat with a format having a '%jd' conversion, and with one
+        //:   having 40 '%d' conversions, and verify that the original format
+        //:   is used, and the message truncated.  (C-3)
+        //:
+        //: 4 Publish a message whose '%s' argument formats to more than the
+        //:   line length, with a width, and verify the truncation.  (C-4)
+        //
+        // Testing:
+        //   void publishFormatted(const char *, int, const char *, ...);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'publishFormatted'"
+                            "\n==================\n");
+
+        FILE *file = tmpfile();
+        ASSERT(file);
+
+        Obj mX(file);
+
+#define TEST_FORMAT(...)                                                      \
+        do {                                                                  \
+            char expected[512];                                               \
+            snprintf(expected, sizeof expected, __VA_ARGS__);                 \
+            mX.publishFormatted("f.cpp", L_, __VA_ARGS__);                    \
+            ASSERT(1 == mX.drain());                                          \
+            const char *actual = strchr(lastLine(file), ' ') + 1;             \
+            if (veryVerbose) { P_(expected) P(actual) }                       \
+            ASSERTV(L_, expected, actual, 0 == strcmp(expected, actual));     \
+        } while (0)
+
+        if (verbose) printf("\tConversions.\n");
+        {
+            TEST_FORMAT("no conversions");
+            TEST_FORMAT("100%% %%d");
+            TEST_FORMAT("%d %i %d", 0, -17, 2147483647);
+            TEST_FORMAT("%+5d|%-5d|%05d|% d", 42, 42, 42, 42);
+            TEST_FORMAT("%hhd %hhu %hd %hu", 300, 300, 70000, 70000);
+            TEST_FORMAT("%ld %lu", -123456789L, 123456789UL);
+            TEST_FORMAT("%lld %llu", -1234567890123LL, 1234567890123ULL);
+            TEST_FORMAT("%zu %zd %td",
+                        sizeof(double),
+                        (size_t)7,
+                        (ptrdiff_t)-9);
+            TEST_FORMAT("%o %#o %x %#X", 8u, 8u, 255u, 255u);
+            TEST_FORMAT("%c%c%c", 'a', 'b', 'c');
+            TEST_FORMAT("%f %.2f %e %G %a", 3.5, 2.675, -1e10, 1e-7, 1.0);
+            TEST_FORMAT("%10.3f|%-10.3lf|", 3.14159, 2.71828);
+            TEST_FORMAT("%Lf %.3Le", 1.5L, 12345.678L);
+            TEST_FORMAT("%*d|%-*d|%.*d|%*.*d|", 6, 1, 6, 2, 4, 3, 8, 5, 4);
+            TEST_FORMAT("%.*f %*s", 3, 1.0 / 3, 8, "pad");
+            TEST_FORMAT("%s|%10s|%-10s|%.3s|%.*s", "x", "right", "left",
+                        "truncated", 2, "star");
+            TEST_FORMAT("%p %p", (void *)0x1234, (void *)&mX);
+            TEST_FORMAT("%s:%d (%s) %5.1f%%", "queue", 17, "full", 99.5);
+        }
+
+        if (verbose) printf("\tNull '%%s' argument.\n");
+        {
+            // 'snprintf' has undefined behavior for a null '%s' argument, so
+            // the expected value is given literally.
+
+            const char *NULL_STRING = 0;
+
+            mX.publishFormatted("f.cpp", L_, "[%s]", NULL_STRING);
+            ASSERT(1 == mX.drain());
+            const char *actual = strchr(lastLine(file), ' ') + 1;
+            ASSERTV(actual, 0 == strcmp("[(null)]", actual));
+        }
+
+        if (verbose) printf("\tDeferred formatting.\n");
+        {
+            char format[32];
+            char argument[32];
+
+            strcpy(format,   "[%s]");
+            strcpy(argument, "first");
+
+            mX.publishFormatted("f.cpp", L_, format, argument);
+
+            strcpy(format,   "<%s>");
+            strcpy(argument, "second");
+
+            ASSERT(1 == mX.drain());
+            const char *actual = strchr(lastLine(file), ' ') + 1;
+            ASSERTV(actual, 0 == strcmp("<first>", actual));
+        }
+
+        if (verbose) printf("\tImmediate formatting.\n");
+        {
+            char format[32];
+
+            strcpy(format, "[%jd]");
+            mX.publishFormatted("f.cpp", L_, format, (long long)7);
+            strcpy(format, "<%jd>");
+
+            ASSERT(1 == mX.drain());
+            const char *actual = strchr(lastLine(file), ' ') + 1;
+            ASSERTV(actual, 0 == strcmp("[7]", actual));
+
+            // Forty 'int' arguments, each stored in 8 bytes, do not fit in a
+            // record; the message is formatted, and truncated to the record.
+
+            char longFormat[256] = "";
+            for (int i = 0; i < 40; ++i) {
+                strcat(longFormat, "%d ");
+            }
+            mX.publishFormatted("f.cpp", L_, longFormat,
+                                100000, 100001, 100002, 100003, 100004,
+                                100005, 100006, 100007, 100008, 100009,
+                                100010, 100011, 100012, 100013, 100014,
+                                100015, 100016, 100017, 100018, 100019,
+                                100020, 100021, 100022, 100023, 100024,
+                                100025, 100026, 100027, 100028, 100029,
+                                100030, 100031, 100032, 100033, 100034,
+                                100035, 100036, 100037, 100038, 100039);
+            strcpy(longFormat, "changed");
+
+            ASSERT(1 == mX.drain());
+            actual = strchr(lastLine(file), ' ') + 1;
+            if (veryVerbose) P(actual);
+            ASSERT(0 == strncmp("100000 100001 100002 ", actual, 21));
+            ASSERT(strlen(actual) < Obj::k_RECORD_SIZE);
+            ASSERT(strlen(actual) > Obj::k_RECORD_SIZE / 2);
+        }
+
+        if (verbose) printf("\tTruncation to the line length.\n");
+        {
+            mX.publishFormatted("f.cpp", 1, "%2000s|", "wide");
+
+            ASSERT(1 == mX.drain());
+            const char *line = lastLine(file);
+            ASSERTV(strlen(line), strlen(line) < 1024);
+            ASSERTV(strlen(line), strlen(line) > 1000);
+            ASSERT(0 == strncmp("f.cpp:1     ", line, 12));
+        }
+
+#undef TEST_FORMAT
+
+        fclose(file);
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // 'publish' AND 'drain'
+        //
+        // Concerns:
+        //: 1 'drain' writes each record published, in the format of
+        //:   'bsls::Log::stderrMessageHandler', in the order published, and
+        //:   returns the number of records written; 'numWritten' counts them.
+        //:
+        //: 2 'drain' returns 0, and writes nothing, when no record is
+        //:   buffered.
+        //:
+        //: 3 A message longer than a record is truncated, and a file name
+        //:   longer than 100 characters is shortened to its last 100.
+        //:
+        //: 4 The ring is reused after it wraps around.
+        //
+        // Plan:
+        //: 1 Publish records, drain, and compare the file with the expected
+        //:   text.  (C-1..2)
+        //:
+        //: 2 Publish a 1000-character message with a 150-character file
+        //:   name, and verify the line written.  (C-3)
+        //:
+        //: 3 Publish and drain, one record at a time, 10 times the capacity
+        //:   of a small ring.  (C-4)
+        //
+        // Testing:
+        //   int drain();
+        //   void publish(const char *file, int line, const char *message);
+        //   Types::Int64 numWritten() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'publish' AND 'drain'"
+                            "\n=====================\n");
+
+        if (verbose) printf("\tBasic behavior.\n");
+        {
+            FILE *file = tmpfile();
+            ASSERT(file);
+
+            Obj mX(file);  const Obj& X = mX;
+
+            ASSERT(0 == mX.drain());
+            ASSERT(0 == X.numWritten());
+            ASSERT(0 == strcmp("", readFile(file)));
+
+            mX.publish("a.cpp", 1, "one");
+            mX.publish("b.cpp", 22, "");
+            mX.publish("c.cpp", 333, "three words here");
+
+            ASSERT(3 == mX.drain());
+            ASSERT(0 == mX.drain());
+            ASSERT(3 == X.numWritten());
+            ASSERT(0 == strcmp("a.cpp:1 one\n"
+                               "b.cpp:22 \n"
+                               "c.cpp:333 three words here\n",
+                               readFile(file)));
+
+            fclose(file);
+        }
+
+        if (verbose) printf("\tTruncation.\n");
+        {
+            FILE *file = tmpfile();
+            ASSERT(file);
+
+            Obj mX(file);
+
+            char fileName[151];
+            for (int i = 0; i < 150; ++i) {
+                fileName[i] = static_cast<char>('a' + i % 26);
+            }
+            fileName[150] = 0;
+
+            char message[1001];
+            memset(message, 'm', 1000);
+            message[1000] = 0;
+
+            mX.publish(fileName, 7, message);
+            ASSERT(1 == mX.drain());
+
+            const char *line = lastLine(file);
+            if (veryVerbose) P(line);
+
+            ASSERT(0 == strncmp(line, fileName + 50, 100));
+            ASSERT(0 == strncmp(line + 100, ":7 mmm", 6));
+
+            const size_t messageLength = strlen(line + 103);
+            ASSERTV(messageLength, messageLength < Obj::k_RECORD_SIZE - 100);
+            ASSERTV(messageLength,
+                    messageLength + 101 + 2 * sizeof(int) + sizeof(void *)
+                                                       >= Obj::k_RECORD_SIZE);
+
+            fclose(file);
+        }
+
+        if (verbose) printf("\tWrap around.\n");
+        {
+            FILE *file = tmpfile();
+            ASSERT(file);
+
+            Obj mX(file, 4);  const Obj& X = mX;
+
+            for (int i = 0; i < 40; ++i) {
+                char message[16];
+                sprintf(message, "%d", i);
+                mX.publish("logger.cpp", 0, message);
+                if (i % 3 == 2) {
+                    ASSERTV(i, 3 == mX.drain());
+                }
+            }
+            mX.drain();
+
+            ASSERT(40 == X.numWritten());
+            ASSERT( 0 == X.numDropped());
+            ASSERT(verifyLoggerOutput(readFile(file), 1, 40));
+
+            fclose(file);
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create sinks with default and explicit arguments, and verify the
+        //:   accessors.  Publish a record, drain it, and verify the file.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   AsyncLogSink(FILE *, int = k_DEFAULT_CAPACITY, OverflowPolicy);
+        //   ~AsyncLogSink();
+        //   int capacity() const;
+        //   OverflowPolicy overflowPolicy() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        FILE *file = tmpfile();
+        ASSERT(file);
+
+        {
+            Obj mX(file);  const Obj& X = mX;
+
+            ASSERT(Obj::k_DEFAULT_CAPACITY == X.capacity());
+            ASSERT(Obj::e_DROP             == X.overflowPolicy());
+            ASSERT(!X.isStarted());
+            ASSERT(0 == X.numDropped());
+            ASSERT(0 == X.numWritten());
+
+            mX.publish("file.cpp", 12, "hello");
+            mX.publishFormatted("file.cpp", 13, "%s %d", "world", 42);
+
+            ASSERT(2 == mX.drain());
+            ASSERT(2 == X.numWritten());
+            ASSERT(0 == strcmp("file.cpp:12 hello\n"
+                               "file.cpp:13 world 42\n",
+                               readFile(file)));
+        }
+        {
+            Obj mX(file, 8, Obj::e_BLOCK);  const Obj& X = mX;
+
+            ASSERT(8            == X.capacity());
+            ASSERT(Obj::e_BLOCK == X.overflowPolicy());
+
+            mX.publish("file.cpp", 14, "destructor");
+        }
+        ASSERT(0 == strcmp("file.cpp:12 hello\n"
+                           "file.cpp:13 world 42\n"
+                           "file.cpp:14 destructor\n",
+                           readFile(file)));
+
+        fclose(file);
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: LATENCY OF LOGGING
+        //
+        // Concerns:
+        //: 1 Logging through a started sink costs the logging thread much
+        //:   less than writing to a file with 'fprintf' and 'fflush'.
+        //
+        // Plan:
+        //: 1 Log a number of messages through 'bsls::Log', from one and from
+        //:   several threads, with a handler that writes to a file and with a
+        //:   started sink that writes to the same file, and report the
+        //:   elapsed times.
+        //
+        // Testing:
+        //   PERFORMANCE: LATENCY OF LOGGING
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nPERFORMANCE: LATENCY OF LOGGING"
+                            "\n===============================\n");
+
+        const int NUM_RECORDS = 100000;
+
+        FILE *file = fopen("/dev/null", "w");
+        if (!file) {
+            file = tmpfile();
+        }
+        ASSERT(file);
+
+        for (int numThreads = 1; numThreads <= 4; numThreads *= 4) {
+            bsls::Stopwatch timer;
+
+            g_handlerFile = file;
+            bsls::Log::setLogMessageHandler(&fileHandler);
+
+            timer.start();
+            runLoggerThreads(0, numThreads, NUM_RECORDS);
+            timer.stop();
+
+            const double syncTime = timer.elapsedTime();
+
+            Obj mX(file, 1 << 14, Obj::e_BLOCK);
+            ASSERT(0 == mX.start());
+
+            timer.reset();
+            timer.start();
+            runLoggerThreads(0, numThreads, NUM_RECORDS);
+            timer.stop();
+
+            const double asyncTime = timer.elapsedTime();
+
+            mX.stop();
+
+            printf("threads %d, records %d: synchronous %6.3fs,"
+                   " asynchronous %6.3fs (dropped %lld)\n",
+                   numThreads, NUM_RECORDS, syncTime, asyncTime,
+                   mX.numDropped());
+        }
+
+        bsls::Log::setLogMessageHandler(
+                                   &bsls::Log::platformDefaultMessageHandler);
+        fclose(file);
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -10,20 +10,34 @@ BSLS_IDENT("$Id: $")
 //@PURPOSE: Provide types with atomic operations.
 //
 //@CLASSES:
+//  bsls::AtomicBool: atomic boolean type
 //  bsls::AtomicInt: atomic 32-bit integer type
 //  bsls::AtomicInt64: atomic 64-bit integer types
+//  bsls::AtomicUint: atomic 32-bit unsigned integer type
+//  bsls::AtomicUint64: atomic 64-bit unsigned integer type
+//  bsls::AtomicUint128: atomic 128-bit unsigned integer type (some platforms)
 //  bsls::AtomicPointer: parameterized atomic pointer type
 //
 //@SEE_ALSO: bsls_atomicoperations
 //
 //@DESCRIPTION: This component provides classes with atomic operations for
-// 'int', 'Int64', and pointer types.  These classes are based on atomic
-// operations supplied by the 'bsls_atomicoperations' component.  The
-// 'bsls::AtomicInt' and 'bsls::AtomicInt64' classes represent the
-// corresponding atomic integer types, and provide overloaded operators and
-// functions for common arithmetic operations.  The 'bsls::AtomicPointer' class
-// represents the atomic pointer type, and provides atomic operations to
-// manipulate and dereference a pointer.
+// 'bool', 'int', 'unsigned int', 'Int64', 'Uint64', and pointer types.  These
+// classes are based on atomic operations supplied by the
+// 'bsls_atomicoperations' component.  The 'bsls::AtomicInt',
+// 'bsls::AtomicInt64', 'bsls::AtomicUint', and 'bsls::AtomicUint64' classes
+// represent the corresponding atomic integer types, and provide overloaded
+// operators and functions for common arithmetic and bitwise operations.  The
+// 'bsls::AtomicBool' class represents the atomic boolean type.  The
+// 'bsls::AtomicPointer' class represents the atomic pointer type, and provides
+// atomic operations to manipulate and dereference a pointer.
+//
+// On platforms where 'BSLS_ATOMICOPERATIONS_HAS_UINT128' is defined, this
+// component also provides 'bsls::AtomicUint128', a 128-bit value supporting an
+// atomic compare-and-swap of both its 64-bit halves.  Pairing a pointer with a
+// counter that is incremented on each update, in a single
+// 'bsls::AtomicUint128', allows lock-free data structures to detect that a
+// pointer was changed and then restored by another thread (the "ABA problem")
+// between a load and a subsequent compare-and-swap.
 //
 ///Memory Order and Consistency Guarantees of Atomic Operations
 ///------------------------------------------------------------
@@ -749,6 +763,34 @@ class AtomicInt {
         // resulting value, providing the acquire/release memory ordering
         // guarantee.
 
+    int fetchAnd(int value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value.
+
+    int fetchAndRelaxed(int value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value,
+        // providing the relaxed memory ordering guarantee.
+
+    int fetchAndAcqRel(int value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
+
+    int fetchOr(int value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value.
+
+    int fetchOrRelaxed(int value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value,
+        // providing the relaxed memory ordering guarantee.
+
+    int fetchOrAcqRel(int value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
+
     void storeRelaxed(int value);
         // Atomically assign the specified 'value' to this object, providing
         // the relaxed memory ordering guarantee.
@@ -874,6 +916,34 @@ class AtomicInt64 {
         // resulting value, providing the acquire/release memory ordering
         // guarantee.
 
+    Types::Int64 fetchAnd(Types::Int64 value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value.
+
+    Types::Int64 fetchAndRelaxed(Types::Int64 value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value,
+        // providing the relaxed memory ordering guarantee.
+
+    Types::Int64 fetchAndAcqRel(Types::Int64 value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
+
+    Types::Int64 fetchOr(Types::Int64 value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value.
+
+    Types::Int64 fetchOrRelaxed(Types::Int64 value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value,
+        // providing the relaxed memory ordering guarantee.
+
+    Types::Int64 fetchOrAcqRel(Types::Int64 value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
+
     void storeRelaxed(Types::Int64 value);
         // Atomically assign the specified 'value' to this object, providing
         // the relaxed memory ordering guarantee.
@@ -926,90 +996,141 @@ class AtomicInt64 {
         // memory ordering guarantee.
 };
 
-                             // ===================
-                             // class AtomicPointer
-                             // ===================
+                              // ================
+                              // class AtomicUint
+                              // ================
 
-template <class TYPE>
-class AtomicPointer {
-    // This class implements an atomic pointer to a parameterized 'TYPE', which
-    // supports common pointer operations in a way that is guaranteed to be
-    // atomic.  Operations on objects of this class provide the sequential
-    // consistency memory ordering guarantee unless explicitly qualified with
-    // a less strict consistency guarantee suffix (i.e., Acquire, Release,
-    // AcqRel or Relaxed).
+class AtomicUint {
+    // This class implements an atomic unsigned integer, which supports common
+    // integer operations in a way that is guaranteed to be atomic.  Operations
+    // on objects of this class provide the sequential consistency memory
+    // ordering guarantee unless explicitly qualified with a less strict
+    // consistency guarantee suffix (i.e., Acquire, Release, AcqRel or
+    // Relaxed).  Arithmetic on objects of this class wraps modulo 2^N, where N
+    // is the number of bits in 'unsigned int'.
 
     // DATA
-    AtomicOperations::AtomicTypes::Pointer d_value;
-
-    typedef char AtomicPointer_PointerSizeCheck[
-        sizeof(TYPE *) == sizeof(void *) ? 1 : -1];
-        // Static assert that a 'TYPE*' pointer is binary compatible with a
-        // 'void*' pointer.  The implementation of 'AtomicPointer' uses
-        // 'reinterpret_cast' to convert between 'TYPE*' and 'void*' because
-        // function pointers are not implicitly convertible to 'void*', and
-        // this assert makes sure that such a cast is safe.  Note that
-        // 'bslmf_Assert' can't be used here because of package dependency
-        // rules.
-
-    template <typename TYPE1>
-    struct RemoveConst              { typedef TYPE1 Type; };
-    template <typename TYPE1>
-    struct RemoveConst<TYPE1 const> { typedef TYPE1 Type; };
-
-    typedef typename RemoveConst<TYPE>::Type NcType;
+    AtomicOperations::AtomicTypes::Int d_value;
 
   private:
     // NOT IMPLEMENTED
-    AtomicPointer(const AtomicPointer<TYPE>&);                  // = delete
-    AtomicPointer<TYPE>& operator=(const AtomicPointer<TYPE>&); // = delete
-        // Note that the copy constructor and the copy-assignment operator
-        // are not implemented because they cannot be done atomically.
+    AtomicUint(const AtomicUint&);              // = delete
+    AtomicUint& operator=(const AtomicUint&);   // = delete
+        // Note that the copy constructor and the copy-assignment operator are
+        // not implemented because they cannot be done atomically.
 
   public:
     // CREATORS
-    AtomicPointer();
-        // Create an atomic pointer object having the default value NULL.
+    AtomicUint();
+        // Create an atomic unsigned integer object having the default value 0.
 
-    AtomicPointer(TYPE *value);
-        // Create an atomic pointer object having the specified 'value'.
+    AtomicUint(unsigned int value);
+        // Create an atomic unsigned integer object having the specified
+        // 'value'.
 
-    //! ~AtomicPointer() = default;
-        // Destroy this atomic pointer.
+    //! ~AtomicUint() = default;
+        // Destroy this atomic unsigned integer object.
 
     // MANIPULATORS
-    AtomicPointer<TYPE>& operator=(TYPE *value);
+    AtomicUint& operator=(unsigned int value);
         // Atomically assign the specified 'value' to this object, and return a
         // modifiable reference to 'this' object.
 
-    void storeRelaxed(TYPE *value);
+    unsigned int operator+=(unsigned int value);
+        // Atomically add the specified 'value' to this object, and return the
+        // resulting value.
+
+    unsigned int operator-=(unsigned int value);
+        // Atomically subtract the specified 'value' from this object, and
+        // return the resulting value.
+
+    unsigned int operator++();
+        // Atomically increment the value of this object by 1 and return the
+        // resulting value.
+
+    unsigned int operator++(int);
+        // Atomically increment the value of this object by 1 and return the
+        // value prior to being incremented.
+
+    unsigned int operator--();
+        // Atomically decrement the value of this object by 1 and return the
+        // resulting value.
+
+    unsigned int operator--(int);
+        // Atomically decrement the value of this object by 1 and return the
+        // value prior to being decremented.
+
+    unsigned int add(unsigned int value);
+        // Atomically add the specified 'value' to this object and return the
+        // resulting value.
+
+    unsigned int addRelaxed(unsigned int value);
+        // Atomically add the specified 'value' to this object and return the
+        // resulting value, providing the relaxed memory ordering guarantee.
+
+    unsigned int addAcqRel(unsigned int value);
+        // Atomically add the specified 'value' to this object and return the
+        // resulting value, providing the acquire/release memory ordering
+        // guarantee.
+
+    unsigned int fetchAnd(unsigned int value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value.
+
+    unsigned int fetchAndRelaxed(unsigned int value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value,
+        // providing the relaxed memory ordering guarantee.
+
+    unsigned int fetchAndAcqRel(unsigned int value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
+
+    unsigned int fetchOr(unsigned int value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value.
+
+    unsigned int fetchOrRelaxed(unsigned int value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value,
+        // providing the relaxed memory ordering guarantee.
+
+    unsigned int fetchOrAcqRel(unsigned int value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
+
+    void storeRelaxed(unsigned int value);
         // Atomically assign the specified 'value' to this object, providing
         // the relaxed memory ordering guarantee.
 
-    void storeRelease(TYPE *value);
+    void storeRelease(unsigned int value);
         // Atomically assign the specified 'value' to this object, providing
         // the release memory ordering guarantee.
 
-    TYPE *swap(TYPE *swapValue);
+    unsigned int swap(unsigned int swapValue);
         // Atomically set the value of this object to the specified 'swapValue'
         // and return its previous value.
 
-    TYPE *swapAcqRel(TYPE *swapValue);
+    unsigned int swapAcqRel(unsigned int swapValue);
         // Atomically set the value of this object to the specified 'swapValue'
         // and return its previous value, providing the acquire/release memory
         // ordering guarantee.
 
-    TYPE *testAndSwap(const TYPE *compareValue, TYPE *swapValue);
-        // Compare the value of this object to the specified 'compareValue'.
-        // If they are equal, set the value of this atomic integer to the
+    unsigned int testAndSwap(unsigned int compareValue,
+                             unsigned int swapValue);
+        // Compare the value of this object to the specified 'compareValue'. If
+        // they are equal, set the value of this atomic integer to the
         // specified 'swapValue', otherwise leave this value unchanged.  Return
         // the previous value of this atomic integer, whether or not the swap
         // occurred.  Note that the entire test-and-swap operation is performed
         // atomically.
 
-    TYPE *testAndSwapAcqRel(const TYPE *compareValue, TYPE *swapValue);
-        // Compare the value of this object to the specified 'compareValue'.
-        // If they are equal, set the value of this atomic integer to the
+    unsigned int testAndSwapAcqRel(unsigned int compareValue,
+                                   unsigned int swapValue);
+        // Compare the value of this object to the specified 'compareValue'. If
+        // they are equal, set the value of this atomic integer to the
         // specified 'swapValue', otherwise leave this value unchanged.  Return
         // the previous value of this atomic integer, whether or not the swap
         // occurred.  Note that the entire test-and-swap operation is performed
@@ -1017,329 +1138,1416 @@ class AtomicPointer {
         // guarantee.
 
     // ACCESSORS
-    TYPE& operator*() const;
-        // Return a reference to the value currently pointed to by this object.
-        // The behavior is undefined if this pointer has a value of 0.
-
-    TYPE *operator->() const;
-        // Return the current value of this object.
-
-    operator TYPE*() const;
+    operator unsigned int() const;
         // Return the current value of this object.
 
-    TYPE *load() const;
+    unsigned int load() const;
         // Return the current value of this object.
 
-    TYPE *loadRelaxed() const;
+    unsigned int loadRelaxed() const;
         // Return the current value of this object, providing the relaxed
         // memory ordering guarantee.
 
-    TYPE *loadAcquire() const;
+    unsigned int loadAcquire() const;
         // Return the current value of this object, providing the acquire
         // memory ordering guarantee.
 };
 
-}  // close package namespace
+                             // ==================
+                             // class AtomicUint64
+                             // ==================
 
-namespace bsls {
+class AtomicUint64 {
+    // This class implements an atomic unsigned 64-bit integer, which supports
+    // common integer operations in a way that is guaranteed to be atomic.
+    // Operations on objects of this class provide the sequential consistency
+    // memory ordering guarantee unless explicitly qualified with a less strict
+    // consistency guarantee suffix (i.e., Acquire, Release, AcqRel or
+    // Relaxed).  Arithmetic on objects of this class wraps modulo 2^N, where N
+    // is the number of bits in 'Types::Uint64'.
 
-// ===========================================================================
-//                        INLINE FUNCTION DEFINITIONS
-// ===========================================================================
+    // DATA
+    AtomicOperations::AtomicTypes::Int64 d_value;
 
-                               // ---------------
-                               // class AtomicInt
-                               // ---------------
+  private:
+    // NOT IMPLEMENTED
+    AtomicUint64(const AtomicUint64&);              // = delete
+    AtomicUint64& operator=(const AtomicUint64&);   // = delete
+        // Note that the copy constructor and the copy-assignment operator are
+        // not implemented because they cannot be done atomically.
 
-// CREATORS
-inline
-AtomicInt::AtomicInt()
-{
-    AtomicOperations_Imp::initInt(&d_value, 0);
-}
+  public:
+    // CREATORS
+    AtomicUint64();
+        // Create an atomic unsigned 64-bit integer object having the default
+        // value 0.
 
-inline
-AtomicInt::AtomicInt(int value)
-{
-    AtomicOperations_Imp::initInt(&d_value, value);
-}
+    AtomicUint64(Types::Uint64 value);
+        // Create an atomic unsigned 64-bit integer object having the specified
+        // 'value'.
 
-// MANIPULATORS
-inline
-AtomicInt& AtomicInt::operator=(int value)
-{
-    AtomicOperations_Imp::setInt(&d_value, value);
-    return *this;
-}
+    //! ~AtomicUint64() = default;
+        // Destroy this atomic unsigned 64-bit integer object.
 
-inline
-int AtomicInt::operator+=(int value)
-{
-    return AtomicOperations_Imp::addIntNv(&d_value, value);
-}
+    // MANIPULATORS
+    AtomicUint64& operator=(Types::Uint64 value);
+        // Atomically assign the specified 'value' to this object, and return a
+        // modifiable reference to 'this' object.
 
-inline
-int AtomicInt::operator-=(int value)
-{
-    return AtomicOperations_Imp::addIntNv(&d_value, -value);
-}
+    Types::Uint64 operator+=(Types::Uint64 value);
+        // Atomically add the specified 'value' to this object, and return the
+        // resulting value.
 
-inline
-int AtomicInt::operator++()
-{
-    return AtomicOperations_Imp::incrementIntNv(&d_value);
-}
+    Types::Uint64 operator-=(Types::Uint64 value);
+        // Atomically subtract the specified 'value' from this object, and
+        // return the resulting value.
 
-inline
-int AtomicInt::operator++(int)
-{
-    return AtomicOperations_Imp::incrementIntNv(&d_value) - 1;
-}
+    Types::Uint64 operator++();
+        // Atomically increment the value of this object by 1 and return the
+        // resulting value.
 
-inline
-int AtomicInt::operator--()
-{
-    return AtomicOperations_Imp::decrementIntNv(&d_value);
-}
+    Types::Uint64 operator++(int);
+        // Atomically increment the value of this object by 1 and return the
+        // value prior to being incremented.
 
-inline
-int AtomicInt::operator--(int)
-{
-    return AtomicOperations_Imp::decrementIntNv(&d_value) + 1;
-}
+    Types::Uint64 operator--();
+        // Atomically decrement the value of this object by 1 and return the
+        // resulting value.
 
-inline
-int AtomicInt::add(int value)
-{
-    return AtomicOperations_Imp::addIntNv(&d_value, value);
-}
+    Types::Uint64 operator--(int);
+        // Atomically decrement the value of this object by 1 and return the
+        // value prior to being decremented.
 
-inline
-int AtomicInt::addRelaxed(int value)
-{
-    return AtomicOperations_Imp::addIntNvRelaxed(&d_value, value);
-}
+    Types::Uint64 add(Types::Uint64 value);
+        // Atomically add the specified 'value' to this object and return the
+        // resulting value.
 
-inline
-int AtomicInt::addAcqRel(int value)
-{
-    return AtomicOperations_Imp::addIntNvAcqRel(&d_value, value);
-}
+    Types::Uint64 addRelaxed(Types::Uint64 value);
+        // Atomically add the specified 'value' to this object and return the
+        // resulting value, providing the relaxed memory ordering guarantee.
 
-inline
-void AtomicInt::storeRelaxed(int value)
-{
-    AtomicOperations_Imp::setIntRelaxed(&d_value, value);
-}
+    Types::Uint64 addAcqRel(Types::Uint64 value);
+        // Atomically add the specified 'value' to this object and return the
+        // resulting value, providing the acquire/release memory ordering
+        // guarantee.
 
-inline
-void AtomicInt::storeRelease(int value)
-{
-    AtomicOperations_Imp::setIntRelease(&d_value, value);
-}
+    Types::Uint64 fetchAnd(Types::Uint64 value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value.
 
-inline
-int AtomicInt::swap(int swapValue)
-{
-    return AtomicOperations_Imp::swapInt(&d_value, swapValue);
-}
+    Types::Uint64 fetchAndRelaxed(Types::Uint64 value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value,
+        // providing the relaxed memory ordering guarantee.
 
-inline
-int AtomicInt::swapAcqRel(int swapValue)
-{
-    return AtomicOperations_Imp::swapIntAcqRel(&d_value, swapValue);
-}
+    Types::Uint64 fetchAndAcqRel(Types::Uint64 value);
+        // Atomically set the value of this object to the bitwise AND of its
+        // value and the specified 'value', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
 
-inline
-int AtomicInt::testAndSwap(int compareValue, int swapValue)
-{
-    return AtomicOperations_Imp::testAndSwapInt(&d_value,
-                                                     compareValue,
-                                                     swapValue);
-}
+    Types::Uint64 fetchOr(Types::Uint64 value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value.
 
-inline
-int AtomicInt::testAndSwapAcqRel(int compareValue, int swapValue)
-{
-    return AtomicOperations_Imp::testAndSwapIntAcqRel(&d_value,
-                                                      compareValue,
-                                                      swapValue);
-}
+    Types::Uint64 fetchOrRelaxed(Types::Uint64 value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value,
+        // providing the relaxed memory ordering guarantee.
 
-// ACCESSORS
+    Types::Uint64 fetchOrAcqRel(Types::Uint64 value);
+        // Atomically set the value of this object to the bitwise OR of its
+        // value and the specified 'value', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
 
-inline
-AtomicInt::operator int() const
-{
-    return AtomicOperations_Imp::getInt(&d_value);
-}
+    void storeRelaxed(Types::Uint64 value);
+        // Atomically assign the specified 'value' to this object, providing
+        // the relaxed memory ordering guarantee.
 
-inline
-int AtomicInt::load() const
+    void storeRelease(Types::Uint64 value);
+        // Atomically assign the specified 'value' to this object, providing
+        // the release memory ordering guarantee.
+
+    Types::Uint64 swap(Types::Uint64 swapValue);
+        // Atomically set the value of this object to the specified 'swapValue'
+        // and return its previous value.
+
+    Types::Uint64 swapAcqRel(Types::Uint64 swapValue);
+        // Atomically set the value of this object to the specified 'swapValue'
+        // and return its previous value, providing the acquire/release memory
+        // ordering guarantee.
+
+    Types::Uint64 testAndSwap(Types::Uint64 compareValue,
+                              Types::Uint64 swapValue);
+        // Compare the value of this object to the specified 'compareValue'. If
+        // they are equal, set the value of this atomic integer to the
+        // specified 'swapValue', otherwise leave this value unchanged.  Return
+        // the previous value of this atomic integer, whether or not the swap
+        // occurred.  Note that the entire test-and-swap operation is performed
+        // atomically.
+
+    Types::Uint64 testAndSwapAcqRel(Types::Uint64 compareValue,
+                                    Types::Uint64 swapValue);
+        // Compare the value of this object to the specified 'compareValue'. If
+        // they are equal, set the value of this atomic integer to the
+        // specified 'swapValue', otherwise leave this value unchanged.  Return
+        // the previous value of this atomic integer, whether or not the swap
+        // occurred.  Note that the entire test-and-swap operation is performed
+        // atomically and it provides the acquire/release memory ordering
+        // guarantee.
+
+    // ACCESSORS
+    operator Types::Uint64() const;
+        // Return the current value of this object.
+
+    Types::Uint64 load() const;
+        // Return the current value of this object.
+
+    Types::Uint64 loadRelaxed() const;
+        // Return the current value of this object, providing the relaxed
+        // memory ordering guarantee.
+
+    Types::Uint64 loadAcquire() const;
+        // Return the current value of this object, providing the acquire
+        // memory ordering guarantee.
+};
+
+                              // ================
+                              // class AtomicBool
+                              // ================
+
+class AtomicBool {
+    // This class implements an atomic boolean, which supports common boolean
+    // operations in a way that is guaranteed to be atomic.  Operations on
+    // objects of this class provide the sequential consistency memory ordering
+    // guarantee unless explicitly qualified with a less strict consistency
+    // guarantee suffix (i.e., Acquire, Release, AcqRel or Relaxed).
+
+    // DATA
+    AtomicOperations::AtomicTypes::Int d_value;  // 0 for 'false', 1 for
+                                                 // 'true'
+
+  private:
+    // NOT IMPLEMENTED
+    AtomicBool(const AtomicBool&);              // = delete
+    AtomicBool& operator=(const AtomicBool&);   // = delete
+        // Note that the copy constructor and the copy-assignment operator
+        // are not implemented because they cannot be done atomically.
+
+  public:
+    // CREATORS
+    AtomicBool();
+        // Create an atomic boolean object having the default value 'false'.
+
+    AtomicBool(bool value);
+        // Create an atomic boolean object having the specified 'value'.
+
+    //! ~AtomicBool() = default;
+        // Destroy this atomic boolean object.
+
+    // MANIPULATORS
+    AtomicBool& operator=(bool value);
+        // Atomically assign the specified 'value' to this object, and return a
+        // modifiable reference to 'this' object.
+
+    void storeRelaxed(bool value);
+        // Atomically assign the specified 'value' to this object, providing
+        // the relaxed memory ordering guarantee.
+
+    void storeRelease(bool value);
+        // Atomically assign the specified 'value' to this object, providing
+        // the release memory ordering guarantee.
+
+    bool swap(bool swapValue);
+        // Atomically set the value of this object to the specified 'swapValue'
+        // and return its previous value.
+
+    bool swapAcqRel(bool swapValue);
+        // Atomically set the value of this object to the specified 'swapValue'
+        // and return its previous value, providing the acquire/release memory
+        // ordering guarantee.
+
+    bool testAndSwap(bool compareValue, bool swapValue);
+        // Compare the value of this object to the specified 'compareValue'.
+        // If they are equal, set the value of this atomic boolean to the
+        // specified 'swapValue', otherwise leave this value unchanged.  Return
+        // the previous value of this atomic boolean, whether or not the swap
+        // occurred.  Note that the entire test-and-swap operation is performed
+        // atomically.
+
+    bool testAndSwapAcqRel(bool compareValue, bool swapValue);
+        // Compare the value of this object to the specified 'compareValue'.
+        // If they are equal, set the value of this atomic boolean to the
+        // specified 'swapValue', otherwise leave this value unchanged.  Return
+        // the previous value of this atomic boolean, whether or not the swap
+        // occurred.  Note that the entire test-and-swap operation is performed
+        // atomically and it provides the acquire/release memory ordering
+        // guarantee.
+
+    // ACCESSORS
+    operator bool() const;
+        // Return the current value of this object.
+
+    bool load() const;
+        // Return the current value of this object.
+
+    bool loadRelaxed() const;
+        // Return the current value of this object, providing the relaxed
+        // memory ordering guarantee.
+
+    bool loadAcquire() const;
+        // Return the current value of this object, providing the acquire
+        // memory ordering guarantee.
+};
+
+#if defined(BSLS_ATOMICOPERATIONS_HAS_UINT128)
+
+                             // ===================
+                             // class AtomicUint128
+                             // ===================
+
+class AtomicUint128 {
+    // This class implements an atomic 128-bit unsigned integer, represented
+    // as a pair of 64-bit halves, that can be loaded, stored, and
+    // conditionally replaced (compare-and-swap) in a way that is guaranteed to
+    // be atomic.  Operations on objects of this class provide the sequential
+    // consistency memory ordering guarantee.  This class is typically used to
+    // hold a pointer together with a modification counter, so that a
+    // compare-and-swap fails if the pointer has been changed and then
+    // restored by another thread (the "ABA problem").  Note that this class is
+    // defined only if 'BSLS_ATOMICOPERATIONS_HAS_UINT128' is defined.
+
+    // DATA
+    AtomicOperations::AtomicTypes::Uint128 d_value;
+
+  private:
+    // NOT IMPLEMENTED
+    AtomicUint128(const AtomicUint128&);              // = delete
+    AtomicUint128& operator=(const AtomicUint128&);   // = delete
+        // Note that the copy constructor and the copy-assignment operator
+        // are not implemented because they cannot be done atomically.
+
+  public:
+    // CREATORS
+    AtomicUint128();
+        // Create an atomic 128-bit unsigned integer object having the default
+        // value 0.
+
+    AtomicUint128(Types::Uint64 low, Types::Uint64 high);
+        // Create an atomic 128-bit unsigned integer object whose low and high
+        // 64 bits have the specified 'low' and 'high' values respectively.
+
+    //! ~AtomicUint128() = default;
+        // Destroy this atomic 128-bit unsigned integer object.
+
+    // MANIPULATORS
+    void store(Types::Uint64 low, Types::Uint64 high);
+        // Atomically set the low and high 64 bits of this object to the
+        // specified 'low' and 'high' values respectively.
+
+    bool testAndSwap(Types::Uint64 *compareLow,
+                     Types::Uint64 *compareHigh,
+                     Types::Uint64  swapLow,
+                     Types::Uint64  swapHigh);
+        // Compare the value of this object to the value whose low and high 64
+        // bits are held by the specified 'compareLow' and 'compareHigh'.  If
+        // they are equal, set the low and high 64 bits of this object to the
+        // specified 'swapLow' and 'swapHigh' respectively, otherwise leave
+        // this value unchanged.  Load the previous low and high 64 bits of
+        // this object into 'compareLow' and 'compareHigh', whether or not the
+        // swap occurred, and return 'true' if the swap occurred, and 'false'
+        // otherwise.  Note that the entire test-and-swap operation is
+        // performed atomically.
+
+    // ACCESSORS
+    void load(Types::Uint64 *low, Types::Uint64 *high) const;
+        // Load the low and high 64 bits of the current value of this object
+        // into the specified 'low' and 'high' respectively.
+};
+
+#endif
+
+                             // ===================
+                             // class AtomicPointer
+                             // ===================
+
+template <class TYPE>
+class AtomicPointer {
+    // This class implements an atomic pointer to a parameterized 'TYPE', which
+    // supports common pointer operations in a way that is guaranteed to be
+    // atomic.  Operations on objects of this class provide the sequential
+    // consistency memory ordering guarantee unless explicitly qualified with
+    // a less strict consistency guarantee suffix (i.e., Acquire, Release,
+    // AcqRel or Relaxed).
+
+    // DATA
+    AtomicOperations::AtomicTypes::Pointer d_value;
+
+    typedef char AtomicPointer_PointerSizeCheck[
+        sizeof(TYPE *) == sizeof(void *) ? 1 : -1];
+        // Static assert that a 'TYPE*' pointer is binary compatible with a
+        // 'void*' pointer.  The implementation of 'AtomicPointer' uses
+        // 'reinterpret_cast' to convert between 'TYPE*' and 'void*' because
+        // function pointers are not implicitly convertible to 'void*', and
+        // this assert makes sure that such a cast is safe.  Note that
+        // 'bslmf_Assert' can't be used here because of package dependency
+        // rules.
+
+    template <typename TYPE1>
+    struct RemoveConst              { typedef TYPE1 Type; };
+    template <typename TYPE1>
+    struct RemoveConst<TYPE1 const> { typedef TYPE1 Type; };
+
+    typedef typename RemoveConst<TYPE>::Type NcType;
+
+  private:
+    // NOT IMPLEMENTED
+    AtomicPointer(const AtomicPointer<TYPE>&);                  // = delete
+    AtomicPointer<TYPE>& operator=(const AtomicPointer<TYPE>&); // = delete
+        // Note that the copy constructor and the copy-assignment operator
+        // are not implemented because they cannot be done atomically.
+
+  public:
+    // CREATORS
+    AtomicPointer();
+        // Create an atomic pointer object having the default value NULL.
+
+    AtomicPointer(TYPE *value);
+        // Create an atomic pointer object having the specified 'value'.
+
+    //! ~AtomicPointer() = default;
+        // Destroy this atomic pointer.
+
+    // MANIPULATORS
+    AtomicPointer<TYPE>& operator=(TYPE *value);
+        // Atomically assign the specified 'value' to this object, and return a
+        // modifiable reference to 'this' object.
+
+    void storeRelaxed(TYPE *value);
+        // Atomically assign the specified 'value' to this object, providing
+        // the relaxed memory ordering guarantee.
+
+    void storeRelease(TYPE *value);
+        // Atomically assign the specified 'value' to this object, providing
+        // the release memory ordering guarantee.
+
+    TYPE *swap(TYPE *swapValue);
+        // Atomically set the value of this object to the specified 'swapValue'
+        // and return its previous value.
+
+    TYPE *swapAcqRel(TYPE *swapValue);
+        // Atomically set the value of this object to the specified 'swapValue'
+        // and return its previous value, providing the acquire/release memory
+        // ordering guarantee.
+
+    TYPE *testAndSwap(const TYPE *compareValue, TYPE *swapValue);
+        // Compare the value of this object to the specified 'compareValue'.
+        // If they are equal, set the value of this atomic integer to the
+        // specified 'swapValue', otherwise leave this value unchanged.  Return
+        // the previous value of this atomic integer, whether or not the swap
+        // occurred.  Note that the entire test-and-swap operation is performed
+        // atomically.
+
+    TYPE *testAndSwapAcqRel(const TYPE *compareValue, TYPE *swapValue);
+        // Compare the value of this object to the specified 'compareValue'.
+        // If they are equal, set the value of this atomic integer to the
+        // specified 'swapValue', otherwise leave this value unchanged.  Return
+        // the previous value of this atomic integer, whether or not the swap
+        // occurred.  Note that the entire test-and-swap operation is performed
+        // atomically and it provides the acquire/release memory ordering
+        // guarantee.
+
+    // ACCESSORS
+    TYPE& operator*() const;
+        // Return a reference to the value currently pointed to by this object.
+        // The behavior is undefined if this pointer has a value of 0.
+
+    TYPE *operator->() const;
+        // Return the current value of this object.
+
+    operator TYPE*() const;
+        // Return the current value of this object.
+
+    TYPE *load() const;
+        // Return the current value of this object.
+
+    TYPE *loadRelaxed() const;
+        // Return the current value of this object, providing the relaxed
+        // memory ordering guarantee.
+
+    TYPE *loadAcquire() const;
+        // Return the current value of this object, providing the acquire
+        // memory ordering guarantee.
+};
+
+}  // close package namespace
+
+namespace bsls {
+
+// ===========================================================================
+//                        INLINE FUNCTION DEFINITIONS
+// ===========================================================================
+
+                               // ---------------
+                               // class AtomicInt
+                               // ---------------
+
+// CREATORS
+inline
+AtomicInt::AtomicInt()
+{
+    AtomicOperations_Imp::initInt(&d_value, 0);
+}
+
+inline
+AtomicInt::AtomicInt(int value)
+{
+    AtomicOperations_Imp::initInt(&d_value, value);
+}
+
+// MANIPULATORS
+inline
+AtomicInt& AtomicInt::operator=(int value)
+{
+    AtomicOperations_Imp::setInt(&d_value, value);
+    return *this;
+}
+
+inline
+int AtomicInt::operator+=(int value)
+{
+    return AtomicOperations_Imp::addIntNv(&d_value, value);
+}
+
+inline
+int AtomicInt::operator-=(int value)
+{
+    return AtomicOperations_Imp::addIntNv(&d_value, -value);
+}
+
+inline
+int AtomicInt::operator++()
+{
+    return AtomicOperations_Imp::incrementIntNv(&d_value);
+}
+
+inline
+int AtomicInt::operator++(int)
+{
+    return AtomicOperations_Imp::incrementIntNv(&d_value) - 1;
+}
+
+inline
+int AtomicInt::operator--()
+{
+    return AtomicOperations_Imp::decrementIntNv(&d_value);
+}
+
+inline
+int AtomicInt::operator--(int)
+{
+    return AtomicOperations_Imp::decrementIntNv(&d_value) + 1;
+}
+
+inline
+int AtomicInt::add(int value)
+{
+    return AtomicOperations_Imp::addIntNv(&d_value, value);
+}
+
+inline
+int AtomicInt::addRelaxed(int value)
+{
+    return AtomicOperations_Imp::addIntNvRelaxed(&d_value, value);
+}
+
+inline
+int AtomicInt::addAcqRel(int value)
+{
+    return AtomicOperations_Imp::addIntNvAcqRel(&d_value, value);
+}
+
+inline
+int AtomicInt::fetchAnd(int value)
+{
+    return AtomicOperations_Imp::fetchAndInt(&d_value, value);
+}
+
+inline
+int AtomicInt::fetchAndRelaxed(int value)
+{
+    return AtomicOperations_Imp::fetchAndIntRelaxed(&d_value, value);
+}
+
+inline
+int AtomicInt::fetchAndAcqRel(int value)
+{
+    return AtomicOperations_Imp::fetchAndIntAcqRel(&d_value, value);
+}
+
+inline
+int AtomicInt::fetchOr(int value)
+{
+    return AtomicOperations_Imp::fetchOrInt(&d_value, value);
+}
+
+inline
+int AtomicInt::fetchOrRelaxed(int value)
+{
+    return AtomicOperations_Imp::fetchOrIntRelaxed(&d_value, value);
+}
+
+inline
+int AtomicInt::fetchOrAcqRel(int value)
+{
+    return AtomicOperations_Imp::fetchOrIntAcqRel(&d_value, value);
+}
+
+inline
+void AtomicInt::storeRelaxed(int value)
+{
+    AtomicOperations_Imp::setIntRelaxed(&d_value, value);
+}
+
+inline
+void AtomicInt::storeRelease(int value)
+{
+    AtomicOperations_Imp::setIntRelease(&d_value, value);
+}
+
+inline
+int AtomicInt::swap(int swapValue)
+{
+    return AtomicOperations_Imp::swapInt(&d_value, swapValue);
+}
+
+inline
+int AtomicInt::swapAcqRel(int swapValue)
+{
+    return AtomicOperations_Imp::swapIntAcqRel(&d_value, swapValue);
+}
+
+inline
+int AtomicInt::testAndSwap(int compareValue, int swapValue)
+{
+    return AtomicOperations_Imp::testAndSwapInt(&d_value,
+                                                     compareValue,
+                                                     swapValue);
+}
+
+inline
+int AtomicInt::testAndSwapAcqRel(int compareValue, int swapValue)
+{
+    return AtomicOperations_Imp::testAndSwapIntAcqRel(&d_value,
+                                                      compareValue,
+                                                      swapValue);
+}
+
+// ACCESSORS
+
+inline
+AtomicInt::operator int() const
+{
+    return AtomicOperations_Imp::getInt(&d_value);
+}
+
+inline
+int AtomicInt::load() const
+{
+    return this->operator int();
+}
+
+inline
+int AtomicInt::loadRelaxed() const
+{
+    return AtomicOperations_Imp::getIntRelaxed(&d_value);
+}
+
+inline
+int AtomicInt::loadAcquire() const
+{
+    return AtomicOperations_Imp::getIntAcquire(&d_value);
+}
+
+                              // -----------------
+                              // class AtomicInt64
+                              // -----------------
+
+// CREATORS
+inline
+AtomicInt64::AtomicInt64()
+{
+    AtomicOperations_Imp::initInt64(&d_value, 0);
+}
+
+inline
+AtomicInt64::AtomicInt64(Types::Int64 value)
+{
+    AtomicOperations_Imp::initInt64(&d_value, value);
+}
+
+// MANIPULATORS
+inline
+AtomicInt64& AtomicInt64::operator=(Types::Int64 value)
+{
+    AtomicOperations_Imp::setInt64(&d_value, value);
+    return *this;
+}
+
+inline
+Types::Int64 AtomicInt64::operator+=(Types::Int64 value)
+{
+    return AtomicOperations_Imp::addInt64Nv(&d_value, value);
+}
+
+inline
+Types::Int64 AtomicInt64::operator-=(Types::Int64 value)
+{
+    return AtomicOperations_Imp::addInt64Nv(&d_value, -value);
+}
+
+inline
+Types::Int64 AtomicInt64::operator++()
+{
+    return AtomicOperations_Imp::incrementInt64Nv(&d_value);
+}
+
+inline
+Types::Int64 AtomicInt64::operator++(int)
+{
+    return AtomicOperations_Imp::incrementInt64Nv(&d_value) - 1;
+}
+
+inline
+Types::Int64 AtomicInt64::operator--()
+{
+    return AtomicOperations_Imp::decrementInt64Nv(&d_value);
+}
+
+inline
+Types::Int64 AtomicInt64::operator--(int)
+{
+    return AtomicOperations_Imp::decrementInt64Nv(&d_value) + 1;
+}
+
+inline
+Types::Int64 AtomicInt64::add(Types::Int64 value)
+{
+    return AtomicOperations_Imp::addInt64Nv(&d_value, value);
+}
+
+inline
+Types::Int64 AtomicInt64::addRelaxed(Types::Int64 value)
+{
+    return AtomicOperations_Imp::addInt64NvRelaxed(&d_value, value);
+}
+
+inline
+Types::Int64 AtomicInt64::addAcqRel(Types::Int64 value)
+{
+    return AtomicOperations_Imp::addInt64NvAcqRel(&d_value, value);
+}
+
+inline
+Types::Int64 AtomicInt64::fetchAnd(Types::Int64 value)
+{
+    return AtomicOperations_Imp::fetchAndInt64(&d_value, value);
+}
+
+inline
+Types::Int64 AtomicInt64::fetchAndRelaxed(Types::Int64 value)
+{
+    return AtomicOperations_Imp::fetchAndInt64Relaxed(&d_value, value);
+}
+
+inline
+Types::Int64 AtomicInt64::fetchAndAcqRel(Types::Int64 value)
+{
+    return AtomicOperations_Imp::fetchAndInt64AcqRel(&d_value, value);
+}
+
+inline
+Types::Int64 AtomicInt64::fetchOr(Types::Int64 value)
+{
+    return AtomicOperations_Imp::fetchOrInt64(&d_value, value);
+}
+
+inline
+Types::Int64 AtomicInt64::fetchOrRelaxed(Types::Int64 value)
+{
+    return AtomicOperations_Imp::fetchOrInt64Relaxed(&d_value, value);
+}
+
+inline
+Types::Int64 AtomicInt64::fetchOrAcqRel(Types::Int64 value)
+{
+    return AtomicOperations_Imp::fetchOrInt64AcqRel(&d_value, value);
+}
+
+inline
+void AtomicInt64::storeRelaxed(Types::Int64 value)
+{
+    AtomicOperations_Imp::setInt64Relaxed(&d_value, value);
+}
+
+inline
+void AtomicInt64::storeRelease(Types::Int64 value)
+{
+    AtomicOperations_Imp::setInt64Release(&d_value, value);
+}
+
+inline
+Types::Int64 AtomicInt64::swap(Types::Int64 swapValue)
+{
+    return AtomicOperations_Imp::swapInt64(&d_value, swapValue);
+}
+
+inline
+Types::Int64 AtomicInt64::swapAcqRel(Types::Int64 swapValue)
+{
+    return AtomicOperations_Imp::swapInt64AcqRel(&d_value, swapValue);
+}
+
+inline
+Types::Int64
+AtomicInt64::testAndSwap(Types::Int64 compareValue,
+                              Types::Int64 swapValue)
+{
+    return AtomicOperations_Imp::testAndSwapInt64(&d_value,
+                                                       compareValue,
+                                                       swapValue);
+}
+
+inline
+Types::Int64
+AtomicInt64::testAndSwapAcqRel(Types::Int64 compareValue,
+                                    Types::Int64 swapValue)
+{
+    return AtomicOperations_Imp::testAndSwapInt64AcqRel(&d_value,
+                                                        compareValue,
+                                                        swapValue);
+}
+
+// ACCESSORS
+inline
+AtomicInt64::operator Types::Int64() const
+{
+    return AtomicOperations_Imp::getInt64(&d_value);
+}
+
+inline
+Types::Int64 AtomicInt64::load() const
+{
+    return this->operator Types::Int64();
+}
+
+inline
+Types::Int64 AtomicInt64::loadRelaxed() const
+{
+    return AtomicOperations_Imp::getInt64Relaxed(&d_value);
+}
+
+inline
+Types::Int64 AtomicInt64::loadAcquire() const
+{
+    return AtomicOperations_Imp::getInt64Acquire(&d_value);
+}
+
+                              // ----------------
+                              // class AtomicUint
+                              // ----------------
+
+// CREATORS
+inline
+AtomicUint::AtomicUint()
+{
+    AtomicOperations_Imp::initInt(&d_value, 0);
+}
+
+inline
+AtomicUint::AtomicUint(unsigned int value)
+{
+    AtomicOperations_Imp::initInt(&d_value, static_cast<int>(value));
+}
+
+// MANIPULATORS
+inline
+AtomicUint& AtomicUint::operator=(unsigned int value)
+{
+    AtomicOperations_Imp::setInt(&d_value, static_cast<int>(value));
+    return *this;
+}
+
+inline
+unsigned int AtomicUint::operator+=(unsigned int value)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::addIntNv(&d_value,
+                                       static_cast<int>(value)));
+}
+
+inline
+unsigned int AtomicUint::operator-=(unsigned int value)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::addIntNv(&d_value,
+                                       static_cast<int>(0 - value)));
+}
+
+inline
+unsigned int AtomicUint::operator++()
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::incrementIntNv(&d_value));
+}
+
+inline
+unsigned int AtomicUint::operator++(int)
 {
-    return this->operator int();
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::incrementIntNv(&d_value)) - 1;
 }
 
 inline
-int AtomicInt::loadRelaxed() const
+unsigned int AtomicUint::operator--()
 {
-    return AtomicOperations_Imp::getIntRelaxed(&d_value);
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::decrementIntNv(&d_value));
 }
 
 inline
-int AtomicInt::loadAcquire() const
+unsigned int AtomicUint::operator--(int)
 {
-    return AtomicOperations_Imp::getIntAcquire(&d_value);
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::decrementIntNv(&d_value)) + 1;
 }
 
-                              // -----------------
-                              // class AtomicInt64
-                              // -----------------
+inline
+unsigned int AtomicUint::add(unsigned int value)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::addIntNv(&d_value,
+                                       static_cast<int>(value)));
+}
+
+inline
+unsigned int AtomicUint::addRelaxed(unsigned int value)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::addIntNvRelaxed(&d_value,
+                                              static_cast<int>(value)));
+}
+
+inline
+unsigned int AtomicUint::addAcqRel(unsigned int value)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::addIntNvAcqRel(&d_value,
+                                             static_cast<int>(value)));
+}
+
+inline
+unsigned int AtomicUint::fetchAnd(unsigned int value)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::fetchAndInt(&d_value,
+                                          static_cast<int>(value)));
+}
+
+inline
+unsigned int AtomicUint::fetchAndRelaxed(unsigned int value)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::fetchAndIntRelaxed(&d_value,
+                                                 static_cast<int>(value)));
+}
+
+inline
+unsigned int AtomicUint::fetchAndAcqRel(unsigned int value)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::fetchAndIntAcqRel(&d_value,
+                                                static_cast<int>(value)));
+}
+
+inline
+unsigned int AtomicUint::fetchOr(unsigned int value)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::fetchOrInt(&d_value,
+                                         static_cast<int>(value)));
+}
+
+inline
+unsigned int AtomicUint::fetchOrRelaxed(unsigned int value)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::fetchOrIntRelaxed(&d_value,
+                                                static_cast<int>(value)));
+}
+
+inline
+unsigned int AtomicUint::fetchOrAcqRel(unsigned int value)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::fetchOrIntAcqRel(&d_value,
+                                               static_cast<int>(value)));
+}
+
+inline
+void AtomicUint::storeRelaxed(unsigned int value)
+{
+    AtomicOperations_Imp::setIntRelaxed(&d_value, static_cast<int>(value));
+}
+
+inline
+void AtomicUint::storeRelease(unsigned int value)
+{
+    AtomicOperations_Imp::setIntRelease(&d_value, static_cast<int>(value));
+}
+
+inline
+unsigned int AtomicUint::swap(unsigned int swapValue)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::swapInt(&d_value,
+                                      static_cast<int>(swapValue)));
+}
+
+inline
+unsigned int AtomicUint::swapAcqRel(unsigned int swapValue)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::swapIntAcqRel(&d_value,
+                                            static_cast<int>(swapValue)));
+}
+
+inline
+unsigned int AtomicUint::testAndSwap(unsigned int compareValue,
+                                     unsigned int swapValue)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::testAndSwapInt(&d_value,
+                                             static_cast<int>(compareValue),
+                                             static_cast<int>(swapValue)));
+}
+
+inline
+unsigned int AtomicUint::testAndSwapAcqRel(unsigned int compareValue,
+                                           unsigned int swapValue)
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::testAndSwapIntAcqRel(
+                                             &d_value,
+                                             static_cast<int>(compareValue),
+                                             static_cast<int>(swapValue)));
+}
+
+// ACCESSORS
+inline
+AtomicUint::operator unsigned int() const
+{
+    return static_cast<unsigned int>(AtomicOperations_Imp::getInt(&d_value));
+}
+
+inline
+unsigned int AtomicUint::load() const
+{
+    return this->operator unsigned int();
+}
+
+inline
+unsigned int AtomicUint::loadRelaxed() const
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::getIntRelaxed(&d_value));
+}
+
+inline
+unsigned int AtomicUint::loadAcquire() const
+{
+    return static_cast<unsigned int>(
+        AtomicOperations_Imp::getIntAcquire(&d_value));
+}
+
+                             // ------------------
+                             // class AtomicUint64
+                             // ------------------
 
 // CREATORS
 inline
-AtomicInt64::AtomicInt64()
+AtomicUint64::AtomicUint64()
 {
     AtomicOperations_Imp::initInt64(&d_value, 0);
 }
 
 inline
-AtomicInt64::AtomicInt64(Types::Int64 value)
+AtomicUint64::AtomicUint64(Types::Uint64 value)
 {
-    AtomicOperations_Imp::initInt64(&d_value, value);
+    AtomicOperations_Imp::initInt64(&d_value,
+                                    static_cast<Types::Int64>(value));
 }
 
 // MANIPULATORS
 inline
-AtomicInt64& AtomicInt64::operator=(Types::Int64 value)
+AtomicUint64& AtomicUint64::operator=(Types::Uint64 value)
 {
-    AtomicOperations_Imp::setInt64(&d_value, value);
+    AtomicOperations_Imp::setInt64(&d_value, static_cast<Types::Int64>(value));
     return *this;
 }
 
 inline
-Types::Int64 AtomicInt64::operator+=(Types::Int64 value)
+Types::Uint64 AtomicUint64::operator+=(Types::Uint64 value)
 {
-    return AtomicOperations_Imp::addInt64Nv(&d_value, value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::addInt64Nv(&d_value,
+                                         static_cast<Types::Int64>(value)));
 }
 
 inline
-Types::Int64 AtomicInt64::operator-=(Types::Int64 value)
+Types::Uint64 AtomicUint64::operator-=(Types::Uint64 value)
 {
-    return AtomicOperations_Imp::addInt64Nv(&d_value, -value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::addInt64Nv(
+                                       &d_value,
+                                       static_cast<Types::Int64>(0 - value)));
 }
 
 inline
-Types::Int64 AtomicInt64::operator++()
+Types::Uint64 AtomicUint64::operator++()
 {
-    return AtomicOperations_Imp::incrementInt64Nv(&d_value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::incrementInt64Nv(&d_value));
 }
 
 inline
-Types::Int64 AtomicInt64::operator++(int)
+Types::Uint64 AtomicUint64::operator++(int)
 {
-    return AtomicOperations_Imp::incrementInt64Nv(&d_value) - 1;
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::incrementInt64Nv(&d_value)) - 1;
 }
 
 inline
-Types::Int64 AtomicInt64::operator--()
+Types::Uint64 AtomicUint64::operator--()
 {
-    return AtomicOperations_Imp::decrementInt64Nv(&d_value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::decrementInt64Nv(&d_value));
 }
 
 inline
-Types::Int64 AtomicInt64::operator--(int)
+Types::Uint64 AtomicUint64::operator--(int)
 {
-    return AtomicOperations_Imp::decrementInt64Nv(&d_value) + 1;
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::decrementInt64Nv(&d_value)) + 1;
 }
 
 inline
-Types::Int64 AtomicInt64::add(Types::Int64 value)
+Types::Uint64 AtomicUint64::add(Types::Uint64 value)
 {
-    return AtomicOperations_Imp::addInt64Nv(&d_value, value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::addInt64Nv(&d_value,
+                                         static_cast<Types::Int64>(value)));
 }
 
 inline
-Types::Int64 AtomicInt64::addRelaxed(Types::Int64 value)
+Types::Uint64 AtomicUint64::addRelaxed(Types::Uint64 value)
 {
-    return AtomicOperations_Imp::addInt64NvRelaxed(&d_value, value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::addInt64NvRelaxed(
+                                           &d_value,
+                                           static_cast<Types::Int64>(value)));
 }
 
 inline
-Types::Int64 AtomicInt64::addAcqRel(Types::Int64 value)
+Types::Uint64 AtomicUint64::addAcqRel(Types::Uint64 value)
 {
-    return AtomicOperations_Imp::addInt64NvAcqRel(&d_value, value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::addInt64NvAcqRel(
+                                           &d_value,
+                                           static_cast<Types::Int64>(value)));
 }
 
 inline
-void AtomicInt64::storeRelaxed(Types::Int64 value)
+Types::Uint64 AtomicUint64::fetchAnd(Types::Uint64 value)
 {
-    AtomicOperations_Imp::setInt64Relaxed(&d_value, value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::fetchAndInt64(&d_value,
+                                            static_cast<Types::Int64>(value)));
 }
 
 inline
-void AtomicInt64::storeRelease(Types::Int64 value)
+Types::Uint64 AtomicUint64::fetchAndRelaxed(Types::Uint64 value)
 {
-    AtomicOperations_Imp::setInt64Release(&d_value, value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::fetchAndInt64Relaxed(
+                                           &d_value,
+                                           static_cast<Types::Int64>(value)));
 }
 
 inline
-Types::Int64 AtomicInt64::swap(Types::Int64 swapValue)
+Types::Uint64 AtomicUint64::fetchAndAcqRel(Types::Uint64 value)
 {
-    return AtomicOperations_Imp::swapInt64(&d_value, swapValue);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::fetchAndInt64AcqRel(
+                                           &d_value,
+                                           static_cast<Types::Int64>(value)));
 }
 
 inline
-Types::Int64 AtomicInt64::swapAcqRel(Types::Int64 swapValue)
+Types::Uint64 AtomicUint64::fetchOr(Types::Uint64 value)
 {
-    return AtomicOperations_Imp::swapInt64AcqRel(&d_value, swapValue);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::fetchOrInt64(&d_value,
+                                           static_cast<Types::Int64>(value)));
 }
 
 inline
-Types::Int64
-AtomicInt64::testAndSwap(Types::Int64 compareValue,
-                              Types::Int64 swapValue)
+Types::Uint64 AtomicUint64::fetchOrRelaxed(Types::Uint64 value)
 {
-    return AtomicOperations_Imp::testAndSwapInt64(&d_value,
-                                                       compareValue,
-                                                       swapValue);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::fetchOrInt64Relaxed(
+                                           &d_value,
+                                           static_cast<Types::Int64>(value)));
 }
 
 inline
-Types::Int64
-AtomicInt64::testAndSwapAcqRel(Types::Int64 compareValue,
-                                    Types::Int64 swapValue)
+Types::Uint64 AtomicUint64::fetchOrAcqRel(Types::Uint64 value)
 {
-    return AtomicOperations_Imp::testAndSwapInt64AcqRel(&d_value,
-                                                        compareValue,
-                                                        swapValue);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::fetchOrInt64AcqRel(
+                                           &d_value,
+                                           static_cast<Types::Int64>(value)));
+}
+
+inline
+void AtomicUint64::storeRelaxed(Types::Uint64 value)
+{
+    AtomicOperations_Imp::setInt64Relaxed(&d_value,
+                                          static_cast<Types::Int64>(value));
+}
+
+inline
+void AtomicUint64::storeRelease(Types::Uint64 value)
+{
+    AtomicOperations_Imp::setInt64Release(&d_value,
+                                          static_cast<Types::Int64>(value));
+}
+
+inline
+Types::Uint64 AtomicUint64::swap(Types::Uint64 swapValue)
+{
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::swapInt64(&d_value,
+                                        static_cast<Types::Int64>(swapValue)));
+}
+
+inline
+Types::Uint64 AtomicUint64::swapAcqRel(Types::Uint64 swapValue)
+{
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::swapInt64AcqRel(
+                                       &d_value,
+                                       static_cast<Types::Int64>(swapValue)));
+}
+
+inline
+Types::Uint64 AtomicUint64::testAndSwap(Types::Uint64 compareValue,
+                                        Types::Uint64 swapValue)
+{
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::testAndSwapInt64(
+                                    &d_value,
+                                    static_cast<Types::Int64>(compareValue),
+                                    static_cast<Types::Int64>(swapValue)));
+}
+
+inline
+Types::Uint64 AtomicUint64::testAndSwapAcqRel(Types::Uint64 compareValue,
+                                              Types::Uint64 swapValue)
+{
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::testAndSwapInt64AcqRel(
+                                    &d_value,
+                                    static_cast<Types::Int64>(compareValue),
+                                    static_cast<Types::Int64>(swapValue)));
 }
 
 // ACCESSORS
 inline
-AtomicInt64::operator Types::Int64() const
+AtomicUint64::operator Types::Uint64() const
 {
-    return AtomicOperations_Imp::getInt64(&d_value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::getInt64(&d_value));
 }
 
 inline
-Types::Int64 AtomicInt64::load() const
+Types::Uint64 AtomicUint64::load() const
 {
-    return this->operator Types::Int64();
+    return this->operator Types::Uint64();
 }
 
 inline
-Types::Int64 AtomicInt64::loadRelaxed() const
+Types::Uint64 AtomicUint64::loadRelaxed() const
 {
-    return AtomicOperations_Imp::getInt64Relaxed(&d_value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::getInt64Relaxed(&d_value));
 }
 
 inline
-Types::Int64 AtomicInt64::loadAcquire() const
+Types::Uint64 AtomicUint64::loadAcquire() const
 {
-    return AtomicOperations_Imp::getInt64Acquire(&d_value);
+    return static_cast<Types::Uint64>(
+        AtomicOperations_Imp::getInt64Acquire(&d_value));
+}
+
+                              // ----------------
+                              // class AtomicBool
+                              // ----------------
+
+// CREATORS
+inline
+AtomicBool::AtomicBool()
+{
+    AtomicOperations_Imp::initInt(&d_value, 0);
+}
+
+inline
+AtomicBool::AtomicBool(bool value)
+{
+    AtomicOperations_Imp::initInt(&d_value, value);
+}
+
+// MANIPULATORS
+inline
+AtomicBool& AtomicBool::operator=(bool value)
+{
+    AtomicOperations_Imp::setInt(&d_value, value);
+    return *this;
+}
+
+inline
+void AtomicBool::storeRelaxed(bool value)
+{
+    AtomicOperations_Imp::setIntRelaxed(&d_value, value);
+}
+
+inline
+void AtomicBool::storeRelease(bool value)
+{
+    AtomicOperations_Imp::setIntRelease(&d_value, value);
 }
 
+inline
+bool AtomicBool::swap(bool swapValue)
+{
+    return 0 != AtomicOperations_Imp::swapInt(&d_value, swapValue);
+}
+
+inline
+bool AtomicBool::swapAcqRel(bool swapValue)
+{
+    return 0 != AtomicOperations_Imp::swapIntAcqRel(&d_value, swapValue);
+}
+
+inline
+bool AtomicBool::testAndSwap(bool compareValue, bool swapValue)
+{
+    return 0 != AtomicOperations_Imp::testAndSwapInt(&d_value,
+                                                     compareValue,
+                                                     swapValue);
+}
+
+inline
+bool AtomicBool::testAndSwapAcqRel(bool compareValue, bool swapValue)
+{
+    return 0 != AtomicOperations_Imp::testAndSwapIntAcqRel(&d_value,
+                                                           compareValue,
+                                                           swapValue);
+}
+
+// ACCESSORS
+inline
+AtomicBool::operator bool() const
+{
+    return 0 != AtomicOperations_Imp::getInt(&d_value);
+}
+
+inline
+bool AtomicBool::load() const
+{
+    return this->operator bool();
+}
+
+inline
+bool AtomicBool::loadRelaxed() const
+{
+    return 0 != AtomicOperations_Imp::getIntRelaxed(&d_value);
+}
+
+inline
+bool AtomicBool::loadAcquire() const
+{
+    return 0 != AtomicOperations_Imp::getIntAcquire(&d_value);
+}
+
+#if defined(BSLS_ATOMICOPERATIONS_HAS_UINT128)
+
+                             // -------------------
+                             // class AtomicUint128
+                             // -------------------
+
+// CREATORS
+inline
+AtomicUint128::AtomicUint128()
+{
+    AtomicOperations_Imp::initUint128(&d_value, 0, 0);
+}
+
+inline
+AtomicUint128::AtomicUint128(Types::Uint64 low, Types::Uint64 high)
+{
+    AtomicOperations_Imp::initUint128(&d_value, low, high);
+}
+
+// MANIPULATORS
+inline
+void AtomicUint128::store(Types::Uint64 low, Types::Uint64 high)
+{
+    // Each failed attempt loads the current value, against which the next
+    // attempt compares.
+
+    Types::Uint64 currentLow  = 0;
+    Types::Uint64 currentHigh = 0;
+
+    while (!AtomicOperations_Imp::testAndSwapUint128(&d_value,
+                                                     &currentLow,
+                                                     &currentHigh,
+                                                     low,
+                                                     high)) {
+    }
+}
+
+inline
+bool AtomicUint128::testAndSwap(Types::Uint64 *compareLow,
+                                Types::Uint64 *compareHigh,
+                                Types::Uint64  swapLow,
+                                Types::Uint64  swapHigh)
+{
+    return AtomicOperations_Imp::testAndSwapUint128(&d_value,
+                                                    compareLow,
+                                                    compareHigh,
+                                                    swapLow,
+                                                    swapHigh);
+}
+
+// ACCESSORS
+inline
+void AtomicUint128::load(Types::Uint64 *low, Types::Uint64 *high) const
+{
+    AtomicOperations_Imp::getUint128(&d_value, low, high);
+}
+
+#endif
+
                              // -------------------
                              // class AtomicPointer
                              // -------------------
@@ -89,9 +89,46 @@ using namespace std;
 // [ 3] T* operator->() const;
 // [ 2] operator T*() const;
 //
+// bsls::AtomicBool
+// ----------------
+// [ 9] bsls::AtomicBool(bool value);
+// [ 9] bsls::AtomicBool& operator= (bool value);
+// [ 9] bool swap(bool swapValue);
+// [ 9] bool testAndSwap(bool compareValue, bool swapValue);
+// [ 9] operator bool() const;
+//
+// bsls::AtomicUint, bsls::AtomicUint64
+// ------------------------------------
+// [ 9] bsls::AtomicUint(unsigned int value);
+// [ 9] unsigned int add(unsigned int value);
+// [ 9] unsigned int operator ++();
+// [ 9] unsigned int operator --();
+// [ 9] unsigned int swap(unsigned int swapValue);
+// [ 9] unsigned int testAndSwap(unsigned int compareValue, ...
+// [ 9] bsls::AtomicUint64(bsls::Types::Uint64 value);
+// [ 9] bsls::Types::Uint64 add(bsls::Types::Uint64 value);
+// [ 9] bsls::Types::Uint64 testAndSwap(bsls::Types::Uint64 compareValue, ...
+//
+// Bitwise Operations
+// ------------------
+// [ 9] TYPE fetchAnd(TYPE value);
+// [ 9] TYPE fetchAndRelaxed(TYPE value);
+// [ 9] TYPE fetchAndAcqRel(TYPE value);
+// [ 9] TYPE fetchOr(TYPE value);
+// [ 9] TYPE fetchOrRelaxed(TYPE value);
+// [ 9] TYPE fetchOrAcqRel(TYPE value);
+//
+// bsls::AtomicUint128
+// -------------------
+// [10] bsls::AtomicUint128();
+// [10] bsls::AtomicUint128(Uint64 low, Uint64 high);
+// [10] void store(Uint64 low, Uint64 high);
+// [10] bool testAndSwap(Uint64 *cmpLow, Uint64 *cmpHigh, Uint64, Uint64);
+// [10] void load(Uint64 *low, Uint64 *high) const;
+//
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 8] USAGE EXAMPLE
+// [11] USAGE EXAMPLE
 //-----------------------------------------------------------------------------
 
 //=============================================================================
@@ -590,6 +627,111 @@ void testCaseSharedPtr(int iterations)
     joinThread(thrWriter);
 }
 
+template <class ATOMIC_INT, class TYPE>
+void testBitwiseOperations()
+    // Verify that the 'fetchAnd' and 'fetchOr' methods (and their
+    // 'Relaxed' and 'AcqRel' variants) of the specified 'ATOMIC_INT' type,
+    // whose value type is the specified 'TYPE', set the value of the object
+    // to the bitwise combination of its value and the operand, and return the
+    // value of the object prior to the operation.
+{
+    const TYPE ALL_BITS = static_cast<TYPE>(~static_cast<TYPE>(0));
+    const TYPE HIGH_BIT = static_cast<TYPE>(
+                            static_cast<TYPE>(1) << (sizeof(TYPE) * 8 - 1));
+
+    const TYPE VALUES[] = { 0, 1, 0x5a, static_cast<TYPE>(0x5a5a5a5a),
+                            HIGH_BIT, ALL_BITS };
+    const int NUM_VALUES = sizeof VALUES / sizeof *VALUES;
+
+    for (int i = 0; i < NUM_VALUES; ++i) {
+        for (int j = 0; j < NUM_VALUES; ++j) {
+            const TYPE X = VALUES[i];
+            const TYPE Y = VALUES[j];
+
+            {
+                ATOMIC_INT mX(X);
+                LOOP2_ASSERT(i, j, X == mX.fetchAnd(Y));
+                LOOP2_ASSERT(i, j, static_cast<TYPE>(X & Y) == mX);
+            }
+            {
+                ATOMIC_INT mX(X);
+                LOOP2_ASSERT(i, j, X == mX.fetchAndRelaxed(Y));
+                LOOP2_ASSERT(i, j, static_cast<TYPE>(X & Y) == mX);
+            }
+            {
+                ATOMIC_INT mX(X);
+                LOOP2_ASSERT(i, j, X == mX.fetchAndAcqRel(Y));
+                LOOP2_ASSERT(i, j, static_cast<TYPE>(X & Y) == mX);
+            }
+            {
+                ATOMIC_INT mX(X);
+                LOOP2_ASSERT(i, j, X == mX.fetchOr(Y));
+                LOOP2_ASSERT(i, j, static_cast<TYPE>(X | Y) == mX);
+            }
+            {
+                ATOMIC_INT mX(X);
+                LOOP2_ASSERT(i, j, X == mX.fetchOrRelaxed(Y));
+                LOOP2_ASSERT(i, j, static_cast<TYPE>(X | Y) == mX);
+            }
+            {
+                ATOMIC_INT mX(X);
+                LOOP2_ASSERT(i, j, X == mX.fetchOrAcqRel(Y));
+                LOOP2_ASSERT(i, j, static_cast<TYPE>(X | Y) == mX);
+            }
+        }
+    }
+}
+
+struct FetchOrThreadParam
+{
+    bsls::AtomicUint64 *d_flags_p;       // flags shared by all threads
+    int                 d_firstBit;      // first bit set by this thread
+    int                 d_numBits;       // number of bits set by this thread
+    int                 d_numFailures;   // number of times a bit set by this
+                                         // thread was found already set
+};
+
+void *testFetchOrThreadFunc(void *arg)
+{
+    FetchOrThreadParam *param = reinterpret_cast<FetchOrThreadParam *>(arg);
+
+    for (int i = 0; i < param->d_numBits; ++i) {
+        const bsls::Types::Uint64 bit =
+                static_cast<bsls::Types::Uint64>(1) << (param->d_firstBit + i);
+
+        if (param->d_flags_p->fetchOr(bit) & bit) {
+            ++param->d_numFailures;
+        }
+    }
+    return 0;
+}
+
+#if defined(BSLS_ATOMICOPERATIONS_HAS_UINT128)
+struct Uint128ThreadParam
+{
+    bsls::AtomicUint128 *d_value_p;     // value shared by all threads
+    int                  d_iterations;  // number of increments to perform
+};
+
+void *testUint128ThreadFunc(void *arg)
+    // Increment both halves of the shared value by one, the specified number
+    // of times, using a compare-and-swap loop.  The halves remain equal if
+    // and only if every compare-and-swap is atomic.
+{
+    Uint128ThreadParam *param = reinterpret_cast<Uint128ThreadParam *>(arg);
+
+    for (int i = 0; i < param->d_iterations; ++i) {
+        bsls::Types::Uint64 low, high;
+        param->d_value_p->load(&low, &high);
+
+        while (!param->d_value_p->testAndSwap(&low, &high, low + 1, high + 1))
+        {
+        }
+    }
+    return 0;
+}
+#endif
+
 }  // close unnamed namespace
 
 //=============================================================================
@@ -1123,7 +1265,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
-      case 9: {
+      case 11: {
         // TESTING USAGE Examples
         //
         // Plan:
@@ -1136,6 +1278,304 @@ int main(int argc, char *argv[])
             my_CountedHandle<double> handle(NULL);
         }
       } break;
+      case 10: {
+        // --------------------------------------------------------------------
+        // TESTING 'bsls::AtomicUint128'
+        //
+        // Concerns:
+        //: 1 Both halves of the value are set on construction and by 'store'.
+        //:
+        //: 2 'testAndSwap' replaces the value if and only if both halves
+        //:   match, and always loads the initial value.
+        //:
+        //: 3 'testAndSwap' updates both halves in a single atomic step.
+        //
+        // Plan:
+        //: 1 Construct objects, store, load, and compare-and-swap values that
+        //:   match in neither, either, or both halves.  (C-1..2)
+        //:
+        //: 2 In several threads, repeatedly increment both halves of a shared
+        //:   object with a compare-and-swap loop, and verify that the halves
+        //:   are equal, and have the expected value, when the threads are
+        //:   done.  (C-3)
+        //
+        // Testing:
+        //   bsls::AtomicUint128();
+        //   bsls::AtomicUint128(Uint64 low, Uint64 high);
+        //   void store(Uint64 low, Uint64 high);
+        //   bool testAndSwap(Uint64 *cmpLow, Uint64 *cmpHigh, Uint64, Uint64);
+        //   void load(Uint64 *low, Uint64 *high) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTesting 'bsls::AtomicUint128'"
+                          << "\n=============================" << endl;
+
+#if defined(BSLS_ATOMICOPERATIONS_HAS_UINT128)
+        typedef bsls::Types::Uint64 Uint64;
+
+        const Uint64 A = 0x0123456789abcdefULL;
+        const Uint64 B = 0xfedcba9876543210ULL;
+
+        {
+            bsls::AtomicUint128 mX;  const bsls::AtomicUint128& X = mX;
+            Uint64 low = 1, high = 1;
+            X.load(&low, &high);
+            ASSERT(0 == low);
+            ASSERT(0 == high);
+
+            mX.store(A, B);
+            X.load(&low, &high);
+            ASSERT(A == low);
+            ASSERT(B == high);
+        }
+        {
+            bsls::AtomicUint128 mX(A, B);  const bsls::AtomicUint128& X = mX;
+
+            // Neither half matches.
+
+            Uint64 low = 0, high = 0;
+            ASSERT(false == mX.testAndSwap(&low, &high, 1, 2));
+            ASSERT(A == low);
+            ASSERT(B == high);
+
+            // Only one half matches.
+
+            low = A;  high = 0;
+            ASSERT(false == mX.testAndSwap(&low, &high, 1, 2));
+            ASSERT(A == low);
+            ASSERT(B == high);
+
+            low = 0;  high = B;
+            ASSERT(false == mX.testAndSwap(&low, &high, 1, 2));
+            ASSERT(A == low);
+            ASSERT(B == high);
+
+            // Both halves match.
+
+            ASSERT(true == mX.testAndSwap(&low, &high, B, A));
+            ASSERT(A == low);
+            ASSERT(B == high);
+
+            X.load(&low, &high);
+            ASSERT(B == low);
+            ASSERT(A == high);
+        }
+
+        if (verbose) cout << "\tTesting concurrent compare-and-swap" << endl;
+        {
+            enum { k_NUM_THREADS = 4, k_NUM_ITERATIONS = 100000 };
+
+            bsls::AtomicUint128 mX(0, 0xffffffffULL);
+
+            Uint128ThreadParam param = { &mX, k_NUM_ITERATIONS };
+            thread_t           threads[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                threads[i] = createThread(&testUint128ThreadFunc, &param);
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                joinThread(threads[i]);
+            }
+
+            Uint64 low, high;
+            mX.load(&low, &high);
+            ASSERT(k_NUM_THREADS * k_NUM_ITERATIONS == low);
+            ASSERT(k_NUM_THREADS * k_NUM_ITERATIONS + 0xffffffffULL == high);
+        }
+#else
+        if (verbose) cout << "\tNot supported on this platform." << endl;
+#endif
+      } break;
+      case 9: {
+        // --------------------------------------------------------------------
+        // TESTING 'AtomicBool', UNSIGNED TYPES, AND BITWISE OPERATIONS
+        //
+        // Concerns:
+        //: 1 'bsls::AtomicBool' holds, swaps, and compare-and-swaps 'true'
+        //:   and 'false'.
+        //:
+        //: 2 Arithmetic on 'bsls::AtomicUint' and 'bsls::AtomicUint64' wraps
+        //:   modulo 2^N, and values having the high bit set are preserved.
+        //:
+        //: 3 'fetchAnd' and 'fetchOr', in all memory orders, set the value to
+        //:   the bitwise combination of the value and the operand, and return
+        //:   the previous value, for all four integer types.
+        //:
+        //: 4 'fetchOr' is atomic: when several threads set disjoint bits of
+        //:   the same object, each bit is observed to be clear by exactly the
+        //:   thread that sets it.
+        //
+        // Plan:
+        //: 1 Exercise each 'bsls::AtomicBool' manipulator and accessor.  (C-1)
+        //:
+        //: 2 Add, subtract, increment, and decrement values near the limits
+        //:   of the unsigned types, and verify the results.  (C-2)
+        //:
+        //: 3 For the cross product of a set of values, apply each bitwise
+        //:   operation and verify the returned and resulting values.  (C-3)
+        //:
+        //: 4 Set disjoint ranges of bits in a shared 'bsls::AtomicUint64'
+        //:   from several threads, verifying that no thread finds one of its
+        //:   bits already set and that all bits are set when the threads are
+        //:   done.  (C-4)
+        //
+        // Testing:
+        //   bsls::AtomicBool(bool value);
+        //   bsls::AtomicBool& operator= (bool value);
+        //   bool swap(bool swapValue);
+        //   bool testAndSwap(bool compareValue, bool swapValue);
+        //   operator bool() const;
+        //   bsls::AtomicUint(unsigned int value);
+        //   unsigned int add(unsigned int value);
+        //   unsigned int operator ++();
+        //   unsigned int operator --();
+        //   unsigned int swap(unsigned int swapValue);
+        //   unsigned int testAndSwap(unsigned int compareValue, ...
+        //   bsls::AtomicUint64(bsls::Types::Uint64 value);
+        //   bsls::Types::Uint64 add(bsls::Types::Uint64 value);
+        //   bsls::Types::Uint64 testAndSwap(bsls::Types::Uint64 ...
+        //   TYPE fetchAnd(TYPE value);
+        //   TYPE fetchAndRelaxed(TYPE value);
+        //   TYPE fetchAndAcqRel(TYPE value);
+        //   TYPE fetchOr(TYPE value);
+        //   TYPE fetchOrRelaxed(TYPE value);
+        //   TYPE fetchOrAcqRel(TYPE value);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTesting 'AtomicBool', unsigned types, and "
+                          << "bitwise operations"
+                          << "\n=========================================="
+                          << "==================" << endl;
+
+        if (verbose) cout << "\tTesting 'bsls::AtomicBool'" << endl;
+        {
+            bsls::AtomicBool mX;  const bsls::AtomicBool& X = mX;
+            ASSERT(false == X);
+            ASSERT(false == X.load());
+
+            mX = true;
+            ASSERT(true == X);
+            ASSERT(true == X.loadRelaxed());
+            ASSERT(true == X.loadAcquire());
+
+            ASSERT(true  == mX.swap(false));
+            ASSERT(false == mX.swapAcqRel(true));
+            ASSERT(true  == X);
+
+            ASSERT(true  == mX.testAndSwap(false, false));
+            ASSERT(true  == X);
+            ASSERT(true  == mX.testAndSwap(true, false));
+            ASSERT(false == X);
+            ASSERT(false == mX.testAndSwapAcqRel(false, true));
+            ASSERT(true  == X);
+
+            mX.storeRelaxed(false);
+            ASSERT(false == X);
+            mX.storeRelease(true);
+            ASSERT(true  == X);
+
+            bsls::AtomicBool mY(true);
+            ASSERT(true == mY);
+        }
+
+        if (verbose) cout << "\tTesting 'bsls::AtomicUint'" << endl;
+        {
+            const unsigned int MAX = ~0u;
+
+            bsls::AtomicUint mX;  const bsls::AtomicUint& X = mX;
+            ASSERT(0 == X);
+
+            ASSERT(MAX == --mX);
+            ASSERT(MAX == X.load());
+            ASSERT(0   == ++mX);
+            ASSERT(0   == mX++);
+            ASSERT(1   == mX--);
+            ASSERT(MAX == (mX -= 1));
+            ASSERT(4   == (mX += 5));
+            ASSERT(MAX == mX.add(MAX - 4));
+            ASSERT(0   == mX.addRelaxed(1));
+            ASSERT(MAX == mX.addAcqRel(MAX));
+
+            ASSERT(MAX     == mX.swap(0x80000000u));
+            ASSERT(0x80000000u == mX.swapAcqRel(7));
+            ASSERT(7       == mX.testAndSwap(8, 9));
+            ASSERT(7       == mX.testAndSwap(7, MAX));
+            ASSERT(MAX     == mX.testAndSwapAcqRel(MAX, 3));
+            ASSERT(3       == X.loadRelaxed());
+
+            mX.storeRelaxed(MAX);
+            ASSERT(MAX == X.loadAcquire());
+            mX.storeRelease(0x80000001u);
+            ASSERT(0x80000001u == X);
+        }
+
+        if (verbose) cout << "\tTesting 'bsls::AtomicUint64'" << endl;
+        {
+            typedef bsls::Types::Uint64 Uint64;
+
+            const Uint64 MAX  = ~static_cast<Uint64>(0);
+            const Uint64 HIGH = static_cast<Uint64>(1) << 63;
+
+            bsls::AtomicUint64 mX;  const bsls::AtomicUint64& X = mX;
+            ASSERT(0 == X);
+
+            ASSERT(MAX == --mX);
+            ASSERT(MAX == X.load());
+            ASSERT(0   == ++mX);
+            ASSERT(0   == mX++);
+            ASSERT(1   == mX--);
+            ASSERT(MAX == (mX -= 1));
+            ASSERT(4   == (mX += 5));
+            ASSERT(MAX == mX.add(MAX - 4));
+            ASSERT(0   == mX.addRelaxed(1));
+            ASSERT(MAX == mX.addAcqRel(MAX));
+
+            ASSERT(MAX  == mX.swap(HIGH));
+            ASSERT(HIGH == mX.swapAcqRel(7));
+            ASSERT(7    == mX.testAndSwap(8, 9));
+            ASSERT(7    == mX.testAndSwap(7, MAX));
+            ASSERT(MAX  == mX.testAndSwapAcqRel(MAX, 3));
+            ASSERT(3    == X.loadRelaxed());
+
+            mX.storeRelaxed(MAX);
+            ASSERT(MAX == X.loadAcquire());
+            mX.storeRelease(HIGH + 1);
+            ASSERT(HIGH + 1 == X);
+
+            bsls::AtomicUint64 mY(HIGH);
+            ASSERT(HIGH == mY);
+        }
+
+        if (verbose) cout << "\tTesting bitwise operations" << endl;
+
+        testBitwiseOperations<bsls::AtomicInt, int>();
+        testBitwiseOperations<bsls::AtomicInt64, bsls::Types::Int64>();
+        testBitwiseOperations<bsls::AtomicUint, unsigned int>();
+        testBitwiseOperations<bsls::AtomicUint64, bsls::Types::Uint64>();
+
+        if (verbose) cout << "\tTesting concurrent 'fetchOr'" << endl;
+        {
+            enum { k_NUM_THREADS = 4, k_BITS_PER_THREAD = 16 };
+
+            bsls::AtomicUint64 flags;
+            FetchOrThreadParam params[k_NUM_THREADS];
+            thread_t           threads[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                params[i].d_flags_p     = &flags;
+                params[i].d_firstBit    = i * k_BITS_PER_THREAD;
+                params[i].d_numBits     = k_BITS_PER_THREAD;
+                params[i].d_numFailures = 0;
+
+                threads[i] = createThread(&testFetchOrThreadFunc, &params[i]);
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                joinThread(threads[i]);
+                LOOP_ASSERT(i, 0 == params[i].d_numFailures);
+            }
+            ASSERT(~static_cast<bsls::Types::Uint64>(0) == flags);
+        }
+      } break;
       case 8: {
         // --------------------------------------------------------------------
         // TESTING MEMORY ORDERING OF ATOMIC OPERATIONS USED IN SHARED POINTER
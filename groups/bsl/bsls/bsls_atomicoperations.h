@@ -191,12 +191,31 @@ BSLS_IDENT("$Id: $")
 // to determine the resulting value of an operation than to simply perform the
 // operation.
 //
+// 'bsls::AtomicOperations' functions whose names begin with "fetch" (e.g.,
+// 'fetchOrInt', 'fetchAndInt64') combine the value of an atomic integer with
+// an operand using a bitwise operation, and return the *previous* value of the
+// atomic integer.  They allow a thread to set or clear a group of flags held
+// in an atomic integer, and to determine the state of those flags before the
+// operation, in a single atomic step.
+//
 ///Atomic Pointer Operations
 ///-------------------------
 // The atomic pointer operations provide thread-safe access to pointer values
 // without the use of higher level synchronization mechanisms.  They are
 // commonly used to create fast thread safe singly-linked lists.
 //
+///Double-Width Atomic Operations
+///------------------------------
+// On platforms where the macro 'BSLS_ATOMICOPERATIONS_HAS_UINT128' is defined
+// (currently, x86_64 with GCC or clang), 'bsls::AtomicOperations' also
+// provides a compare-and-swap operation on a 128-bit atomic value,
+// 'AtomicTypes::Uint128', manipulated as a pair of 64-bit halves.  A 128-bit
+// compare-and-swap can atomically replace a pointer together with a
+// modification counter stored alongside it, which is the usual way to avoid
+// the ABA problem in lock-free stacks and queues.  Note that on x86_64 this
+// operation uses the 'cmpxchg16b' instruction, which is not supported by some
+// of the earliest x86_64 processors.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -761,7 +780,9 @@ struct AtomicOperations {
     // 'AtomicOperations' provides a namespace for a suite of atomic
     // operations on the following types as defined by the 'AtomicTypes'
     // typedef: integer - 'AtomicTypes::Int', 64bit integer -
-    // 'AtomicTypes::Int64', pointer - 'AtomicTypes::Pointer'.
+    // 'AtomicTypes::Int64', pointer - 'AtomicTypes::Pointer', and, if
+    // 'BSLS_ATOMICOPERATIONS_HAS_UINT128' is defined, 128bit unsigned integer
+    // - 'AtomicTypes::Uint128'.
 
     // TYPES
     typedef AtomicOperations_Imp   Imp;
@@ -891,6 +912,44 @@ struct AtomicOperations {
         // Atomically decrement the value of the specified 'atomicInt' by 1,
         // providing the acquire/release memory ordering guarantee.
 
+    static int fetchAndInt(AtomicTypes::Int *atomicInt,
+                           int               value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // AND of its value and the specified 'value', and return its previous
+        // value, providing the sequential consistency memory ordering
+        // guarantee.
+
+    static int fetchAndIntAcqRel(AtomicTypes::Int *atomicInt,
+                                 int               value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // AND of its value and the specified 'value', and return its previous
+        // value, providing the acquire/release memory ordering guarantee.
+
+    static int fetchAndIntRelaxed(AtomicTypes::Int *atomicInt,
+                                  int               value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // AND of its value and the specified 'value', and return its previous
+        // value, without providing any memory ordering guarantees.
+
+    static int fetchOrInt(AtomicTypes::Int *atomicInt,
+                          int               value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // OR of its value and the specified 'value', and return its previous
+        // value, providing the sequential consistency memory ordering
+        // guarantee.
+
+    static int fetchOrIntAcqRel(AtomicTypes::Int *atomicInt,
+                                int               value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // OR of its value and the specified 'value', and return its previous
+        // value, providing the acquire/release memory ordering guarantee.
+
+    static int fetchOrIntRelaxed(AtomicTypes::Int *atomicInt,
+                                 int               value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // OR of its value and the specified 'value', and return its previous
+        // value, without providing any memory ordering guarantees.
+
         // *** atomic functions for Int64 ***
 
     static void initInt64(AtomicTypes::Int64 *atomicInt,
@@ -1028,6 +1087,80 @@ struct AtomicOperations {
         // resulting value, providing the acquire/release memory ordering
         // guarantee.
 
+    static Types::Int64 fetchAndInt64(AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64        value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // AND of its value and the specified 'value', and return its previous
+        // value, providing the sequential consistency memory ordering
+        // guarantee.
+
+    static Types::Int64 fetchAndInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64        value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // AND of its value and the specified 'value', and return its previous
+        // value, providing the acquire/release memory ordering guarantee.
+
+    static Types::Int64 fetchAndInt64Relaxed(AtomicTypes::Int64 *atomicInt,
+                                             Types::Int64        value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // AND of its value and the specified 'value', and return its previous
+        // value, without providing any memory ordering guarantees.
+
+    static Types::Int64 fetchOrInt64(AtomicTypes::Int64 *atomicInt,
+                                     Types::Int64        value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // OR of its value and the specified 'value', and return its previous
+        // value, providing the sequential consistency memory ordering
+        // guarantee.
+
+    static Types::Int64 fetchOrInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                           Types::Int64        value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // OR of its value and the specified 'value', and return its previous
+        // value, providing the acquire/release memory ordering guarantee.
+
+    static Types::Int64 fetchOrInt64Relaxed(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64        value);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // OR of its value and the specified 'value', and return its previous
+        // value, without providing any memory ordering guarantees.
+
+#if defined(BSLS_ATOMICOPERATIONS_HAS_UINT128)
+        // *** atomic functions for Uint128 ***
+
+    static void initUint128(AtomicTypes::Uint128 *atomicUint,
+                            Types::Uint64         low = 0,
+                            Types::Uint64         high = 0);
+        // Initialize the specified 'atomicUint' and set its low and high 64
+        // bits to the optionally specified 'low' and 'high' respectively.  If
+        // 'low' or 'high' is not specified, the respective half is set to 0.
+
+    static void getUint128(AtomicTypes::Uint128 const *atomicUint,
+                           Types::Uint64              *low,
+                           Types::Uint64              *high);
+        // Atomically retrieve the value of the specified 'atomicUint', and
+        // load its low and high 64 bits into the specified 'low' and 'high'
+        // respectively, providing the sequential consistency memory ordering
+        // guarantee.  Note that on some platforms this operation is
+        // implemented with a write that stores the value already held by
+        // 'atomicUint', and so requires that 'atomicUint' be writable.
+
+    static bool testAndSwapUint128(AtomicTypes::Uint128 *atomicUint,
+                                   Types::Uint64        *compareLow,
+                                   Types::Uint64        *compareHigh,
+                                   Types::Uint64         swapLow,
+                                   Types::Uint64         swapHigh);
+        // Conditionally set the low and high 64 bits of the specified
+        // 'atomicUint' to the specified 'swapLow' and 'swapHigh' respectively
+        // if and only if the value of 'atomicUint' equals the value having the
+        // low and high 64 bits held by the specified 'compareLow' and
+        // 'compareHigh'; load the initial low and high 64 bits of 'atomicUint'
+        // into 'compareLow' and 'compareHigh', and return 'true' if the value
+        // of 'atomicUint' was set, and 'false' otherwise, providing the
+        // sequential consistency memory ordering guarantee.  The whole
+        // operation is performed atomically.
+#endif
+
         // *** atomic functions for pointer ***
 
     static void initPointer(AtomicTypes::Pointer *atomicPtr,
@@ -1256,6 +1389,48 @@ void AtomicOperations::decrementIntAcqRel(AtomicTypes::Int *atomicInt)
     Imp::decrementIntAcqRel(atomicInt);
 }
 
+inline
+int AtomicOperations::fetchAndInt(AtomicTypes::Int *atomicInt,
+                                  int               value)
+{
+    return Imp::fetchAndInt(atomicInt, value);
+}
+
+inline
+int AtomicOperations::fetchAndIntAcqRel(AtomicTypes::Int *atomicInt,
+                                        int               value)
+{
+    return Imp::fetchAndIntAcqRel(atomicInt, value);
+}
+
+inline
+int AtomicOperations::fetchAndIntRelaxed(AtomicTypes::Int *atomicInt,
+                                         int               value)
+{
+    return Imp::fetchAndIntRelaxed(atomicInt, value);
+}
+
+inline
+int AtomicOperations::fetchOrInt(AtomicTypes::Int *atomicInt,
+                                 int               value)
+{
+    return Imp::fetchOrInt(atomicInt, value);
+}
+
+inline
+int AtomicOperations::fetchOrIntAcqRel(AtomicTypes::Int *atomicInt,
+                                       int               value)
+{
+    return Imp::fetchOrIntAcqRel(atomicInt, value);
+}
+
+inline
+int AtomicOperations::fetchOrIntRelaxed(AtomicTypes::Int *atomicInt,
+                                        int               value)
+{
+    return Imp::fetchOrIntRelaxed(atomicInt, value);
+}
+
 inline
 void AtomicOperations::initInt64(AtomicTypes::Int64 *atomicInt,
                                  Types::Int64        initialValue)
@@ -1431,6 +1606,84 @@ Types::Int64
     return Imp::decrementInt64NvAcqRel(atomicInt);
 }
 
+inline
+Types::Int64 AtomicOperations::fetchAndInt64(AtomicTypes::Int64 *atomicInt,
+                                             Types::Int64        value)
+{
+    return Imp::fetchAndInt64(atomicInt, value);
+}
+
+inline
+Types::Int64 AtomicOperations::fetchAndInt64AcqRel(
+                                                 AtomicTypes::Int64 *atomicInt,
+                                                 Types::Int64        value)
+{
+    return Imp::fetchAndInt64AcqRel(atomicInt, value);
+}
+
+inline
+Types::Int64 AtomicOperations::fetchAndInt64Relaxed(
+                                                 AtomicTypes::Int64 *atomicInt,
+                                                 Types::Int64        value)
+{
+    return Imp::fetchAndInt64Relaxed(atomicInt, value);
+}
+
+inline
+Types::Int64 AtomicOperations::fetchOrInt64(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64        value)
+{
+    return Imp::fetchOrInt64(atomicInt, value);
+}
+
+inline
+Types::Int64 AtomicOperations::fetchOrInt64AcqRel(
+                                                 AtomicTypes::Int64 *atomicInt,
+                                                 Types::Int64        value)
+{
+    return Imp::fetchOrInt64AcqRel(atomicInt, value);
+}
+
+inline
+Types::Int64 AtomicOperations::fetchOrInt64Relaxed(
+                                                 AtomicTypes::Int64 *atomicInt,
+                                                 Types::Int64        value)
+{
+    return Imp::fetchOrInt64Relaxed(atomicInt, value);
+}
+
+#if defined(BSLS_ATOMICOPERATIONS_HAS_UINT128)
+inline
+void AtomicOperations::initUint128(AtomicTypes::Uint128 *atomicUint,
+                                   Types::Uint64         low,
+                                   Types::Uint64         high)
+{
+    Imp::initUint128(atomicUint, low, high);
+}
+
+inline
+void AtomicOperations::getUint128(AtomicTypes::Uint128 const *atomicUint,
+                                  Types::Uint64              *low,
+                                  Types::Uint64              *high)
+{
+    Imp::getUint128(atomicUint, low, high);
+}
+
+inline
+bool AtomicOperations::testAndSwapUint128(AtomicTypes::Uint128 *atomicUint,
+                                          Types::Uint64        *compareLow,
+                                          Types::Uint64        *compareHigh,
+                                          Types::Uint64         swapLow,
+                                          Types::Uint64         swapHigh)
+{
+    return Imp::testAndSwapUint128(atomicUint,
+                                   compareLow,
+                                   compareHigh,
+                                   swapLow,
+                                   swapHigh);
+}
+#endif
+
 inline
 void AtomicOperations::initPointer(AtomicTypes::Pointer *atomicPtr,
                                    void                 *initialValue)
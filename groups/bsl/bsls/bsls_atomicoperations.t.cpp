@@ -59,6 +59,12 @@ using namespace std;
 // [4 ] swapPtr(Pointer *aPointer, void *value);
 // [4 ] testAndSwapPtr(Pointer *, void *, void *);
 //-----------------------------------------------------------------------------
+// [13] fetchAndInt(Int *, int);
+// [13] fetchOrInt(Int *, int);
+// [13] fetchAndInt64(Int64 *, bsls::Types::Int64);
+// [13] fetchOrInt64(Int64 *, bsls::Types::Int64);
+// [13] getUint128(const Uint128 *, Uint64 *, Uint64 *);
+// [13] testAndSwapUint128(Uint128 *, Uint64 *, Uint64 *, Uint64, Uint64);
 // [1 ] Breathing test
 // [7 ] Usage examples
 //-----------------------------------------------------------------------------
@@ -1620,6 +1626,172 @@ int main(int argc, char *argv[]) {
 #endif
 
     switch (test) { case 0:
+      case 13: {
+        // --------------------------------------------------------------------
+        // TESTING BITWISE AND 128-BIT OPERATIONS
+        //
+        // Concerns:
+        //: 1 The 'fetchAnd' and 'fetchOr' operations, in all memory orders,
+        //:   set the value to the bitwise combination of the value and the
+        //:   operand, and return the previous value.
+        //:
+        //: 2 'testAndSwapUint128' sets the value if and only if both halves
+        //:   match, loads the initial value, and reports whether the value
+        //:   was set; 'getUint128' loads the value without modifying it.
+        //
+        // Plan:
+        //: 1 For the cross product of a table of values, apply each bitwise
+        //:   operation to 'Int' and 'Int64' objects and verify the returned
+        //:   and resulting values.  (C-1)
+        //:
+        //: 2 Initialize a 'Uint128' object, and compare-and-swap it with
+        //:   values matching in neither, either, or both halves.  (C-2)
+        //
+        // Testing:
+        //   fetchAndInt(Int *, int);
+        //   fetchOrInt(Int *, int);
+        //   fetchAndInt64(Int64 *, bsls::Types::Int64);
+        //   fetchOrInt64(Int64 *, bsls::Types::Int64);
+        //   getUint128(const Uint128 *, Uint64 *, Uint64 *);
+        //   testAndSwapUint128(Uint128 *, Uint64 *, Uint64 *, Uint64, Uint64);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTesting Bitwise and 128-bit Operations"
+                          << "\n======================================"
+                          << endl;
+
+        if (verbose) cout << "\nTesting 'Int' Bitwise Operations" << endl;
+        {
+            static const int VALUES[] = {
+                0, 1, -1, 0x5a5a5a5a, 0x7fffffff, static_cast<int>(0x80000000)
+            };
+            const int NUM_VALUES = sizeof VALUES / sizeof *VALUES;
+
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                for (int j = 0; j < NUM_VALUES; ++j) {
+                    const int X = VALUES[i];
+                    const int Y = VALUES[j];
+
+                    Types::Int mX;
+
+                    Obj::initInt(&mX, X);
+                    LOOP2_ASSERT(i, j, X == Obj::fetchAndInt(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X & Y) == Obj::getInt(&mX));
+
+                    Obj::initInt(&mX, X);
+                    LOOP2_ASSERT(i, j, X == Obj::fetchAndIntAcqRel(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X & Y) == Obj::getInt(&mX));
+
+                    Obj::initInt(&mX, X);
+                    LOOP2_ASSERT(i, j, X == Obj::fetchAndIntRelaxed(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X & Y) == Obj::getInt(&mX));
+
+                    Obj::initInt(&mX, X);
+                    LOOP2_ASSERT(i, j, X == Obj::fetchOrInt(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X | Y) == Obj::getInt(&mX));
+
+                    Obj::initInt(&mX, X);
+                    LOOP2_ASSERT(i, j, X == Obj::fetchOrIntAcqRel(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X | Y) == Obj::getInt(&mX));
+
+                    Obj::initInt(&mX, X);
+                    LOOP2_ASSERT(i, j, X == Obj::fetchOrIntRelaxed(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X | Y) == Obj::getInt(&mX));
+                }
+            }
+        }
+
+        if (verbose) cout << "\nTesting 'Int64' Bitwise Operations" << endl;
+        {
+            typedef bsls::Types::Int64 Int64;
+
+            static const Int64 VALUES[] = {
+                0, 1, -1, 0x5a5a5a5a5a5a5a5aLL, 0x7fffffffffffffffLL,
+                static_cast<Int64>(0x8000000000000000ULL)
+            };
+            const int NUM_VALUES = sizeof VALUES / sizeof *VALUES;
+
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                for (int j = 0; j < NUM_VALUES; ++j) {
+                    const Int64 X = VALUES[i];
+                    const Int64 Y = VALUES[j];
+
+                    Types::Int64 mX;
+
+                    Obj::initInt64(&mX, X);
+                    LOOP2_ASSERT(i, j, X == Obj::fetchAndInt64(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X & Y) == Obj::getInt64(&mX));
+
+                    Obj::initInt64(&mX, X);
+                    LOOP2_ASSERT(i, j, X == Obj::fetchAndInt64AcqRel(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X & Y) == Obj::getInt64(&mX));
+
+                    Obj::initInt64(&mX, X);
+                    LOOP2_ASSERT(i, j,
+                                 X == Obj::fetchAndInt64Relaxed(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X & Y) == Obj::getInt64(&mX));
+
+                    Obj::initInt64(&mX, X);
+                    LOOP2_ASSERT(i, j, X == Obj::fetchOrInt64(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X | Y) == Obj::getInt64(&mX));
+
+                    Obj::initInt64(&mX, X);
+                    LOOP2_ASSERT(i, j, X == Obj::fetchOrInt64AcqRel(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X | Y) == Obj::getInt64(&mX));
+
+                    Obj::initInt64(&mX, X);
+                    LOOP2_ASSERT(i, j, X == Obj::fetchOrInt64Relaxed(&mX, Y));
+                    LOOP2_ASSERT(i, j, (X | Y) == Obj::getInt64(&mX));
+                }
+            }
+        }
+
+#if defined(BSLS_ATOMICOPERATIONS_HAS_UINT128)
+        if (verbose) cout << "\nTesting 'Uint128' Operations" << endl;
+        {
+            typedef bsls::Types::Uint64 Uint64;
+
+            const Uint64 A = 0x0123456789abcdefULL;
+            const Uint64 B = 0xfedcba9876543210ULL;
+
+            Types::Uint128 mX;
+            Obj::initUint128(&mX, A, B);
+
+            Uint64 low = 0, high = 0;
+            Obj::getUint128(&mX, &low, &high);
+            ASSERT(A == low);
+            ASSERT(B == high);
+
+            low = 0;  high = 0;
+            ASSERT(false == Obj::testAndSwapUint128(&mX, &low, &high, 1, 2));
+            ASSERT(A == low);
+            ASSERT(B == high);
+
+            low = A;  high = A;
+            ASSERT(false == Obj::testAndSwapUint128(&mX, &low, &high, 1, 2));
+            ASSERT(A == low);
+            ASSERT(B == high);
+
+            low = B;  high = B;
+            ASSERT(false == Obj::testAndSwapUint128(&mX, &low, &high, 1, 2));
+            ASSERT(A == low);
+            ASSERT(B == high);
+
+            ASSERT(true  == Obj::testAndSwapUint128(&mX, &low, &high, 1, 2));
+            ASSERT(A == low);
+            ASSERT(B == high);
+
+            Obj::getUint128(&mX, &low, &high);
+            ASSERT(1 == low);
+            ASSERT(2 == high);
+
+            Obj::initUint128(&mX);
+            Obj::getUint128(&mX, &low, &high);
+            ASSERT(0 == low);
+            ASSERT(0 == high);
+        }
+#endif
+      } break;
       case 12: {
         // --------------------------------------------------------------------
         // TESTING GET/SET ACQUIRE/RELEASE MANIPULATORS:
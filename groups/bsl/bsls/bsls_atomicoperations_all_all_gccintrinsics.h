@@ -31,6 +31,12 @@ BSLS_IDENT("$Id: $")
 
 #if defined(BSLS_PLATFORM_CMP_GNU) && BSLS_PLATFORM_CMP_VERSION >= 40700
 
+#if defined(BSLS_PLATFORM_CPU_X86_64)
+#define BSLS_ATOMICOPERATIONS_HAS_UINT128 1
+    // This platform provides the 128-bit atomic operations ('getUint128',
+    // 'testAndSwapUint128', etc.).
+#endif
+
 namespace BloombergLP {
 
 namespace bsls {
@@ -59,6 +65,14 @@ struct Atomic_TypeTraits<AtomicOperations_ALL_ALL_GCCIntrinsics>
     {
           void * d_value;
     };
+
+#if defined(BSLS_ATOMICOPERATIONS_HAS_UINT128)
+    struct __attribute__((__aligned__(16))) Uint128
+    {
+          Types::Uint64 d_low;
+          Types::Uint64 d_high;
+    };
+#endif
 };
 
                // =============================================
@@ -112,6 +126,18 @@ struct AtomicOperations_ALL_ALL_GCCIntrinsics
 
     static int addIntNvRelaxed(AtomicTypes::Int *atomicInt, int value);
 
+    static int fetchAndInt(AtomicTypes::Int *atomicInt, int value);
+
+    static int fetchAndIntAcqRel(AtomicTypes::Int *atomicInt, int value);
+
+    static int fetchAndIntRelaxed(AtomicTypes::Int *atomicInt, int value);
+
+    static int fetchOrInt(AtomicTypes::Int *atomicInt, int value);
+
+    static int fetchOrIntAcqRel(AtomicTypes::Int *atomicInt, int value);
+
+    static int fetchOrIntRelaxed(AtomicTypes::Int *atomicInt, int value);
+
         // *** atomic functions for Int64 ***
 
     static void initInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 value);
@@ -153,6 +179,42 @@ struct AtomicOperations_ALL_ALL_GCCIntrinsics
 
     static Types::Int64 addInt64NvRelaxed(AtomicTypes::Int64 *atomicInt,
                                           Types::Int64        value);
+
+    static Types::Int64 fetchAndInt64(AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64        value);
+
+    static Types::Int64 fetchAndInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64        value);
+
+    static Types::Int64 fetchAndInt64Relaxed(AtomicTypes::Int64 *atomicInt,
+                                             Types::Int64        value);
+
+    static Types::Int64 fetchOrInt64(AtomicTypes::Int64 *atomicInt,
+                                     Types::Int64        value);
+
+    static Types::Int64 fetchOrInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                           Types::Int64        value);
+
+    static Types::Int64 fetchOrInt64Relaxed(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64        value);
+
+#if defined(BSLS_ATOMICOPERATIONS_HAS_UINT128)
+        // *** atomic functions for Uint128 ***
+
+    static void initUint128(AtomicTypes::Uint128 *atomicUint,
+                            Types::Uint64         low,
+                            Types::Uint64         high);
+
+    static void getUint128(const AtomicTypes::Uint128 *atomicUint,
+                           Types::Uint64              *low,
+                           Types::Uint64              *high);
+
+    static bool testAndSwapUint128(AtomicTypes::Uint128 *atomicUint,
+                                   Types::Uint64        *compareLow,
+                                   Types::Uint64        *compareHigh,
+                                   Types::Uint64         swapLow,
+                                   Types::Uint64         swapHigh);
+#endif
 };
 
 // ===========================================================================
@@ -271,6 +333,48 @@ int AtomicOperations_ALL_ALL_GCCIntrinsics::
     return __atomic_add_fetch(&atomicInt->d_value, value, __ATOMIC_RELAXED);
 }
 
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchAndInt(AtomicTypes::Int *atomicInt, int value)
+{
+    return __atomic_fetch_and(&atomicInt->d_value, value, __ATOMIC_SEQ_CST);
+}
+
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchAndIntAcqRel(AtomicTypes::Int *atomicInt, int value)
+{
+    return __atomic_fetch_and(&atomicInt->d_value, value, __ATOMIC_ACQ_REL);
+}
+
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchAndIntRelaxed(AtomicTypes::Int *atomicInt, int value)
+{
+    return __atomic_fetch_and(&atomicInt->d_value, value, __ATOMIC_RELAXED);
+}
+
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchOrInt(AtomicTypes::Int *atomicInt, int value)
+{
+    return __atomic_fetch_or(&atomicInt->d_value, value, __ATOMIC_SEQ_CST);
+}
+
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchOrIntAcqRel(AtomicTypes::Int *atomicInt, int value)
+{
+    return __atomic_fetch_or(&atomicInt->d_value, value, __ATOMIC_ACQ_REL);
+}
+
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchOrIntRelaxed(AtomicTypes::Int *atomicInt, int value)
+{
+    return __atomic_fetch_or(&atomicInt->d_value, value, __ATOMIC_RELAXED);
+}
+
 inline
 void AtomicOperations_ALL_ALL_GCCIntrinsics::
     initInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 value)
@@ -379,6 +483,107 @@ Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
     return __atomic_add_fetch(&atomicInt->d_value, value, __ATOMIC_RELAXED);
 }
 
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchAndInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 value)
+{
+    return __atomic_fetch_and(&atomicInt->d_value, value, __ATOMIC_SEQ_CST);
+}
+
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchAndInt64AcqRel(AtomicTypes::Int64 *atomicInt, Types::Int64 value)
+{
+    return __atomic_fetch_and(&atomicInt->d_value, value, __ATOMIC_ACQ_REL);
+}
+
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchAndInt64Relaxed(AtomicTypes::Int64 *atomicInt, Types::Int64 value)
+{
+    return __atomic_fetch_and(&atomicInt->d_value, value, __ATOMIC_RELAXED);
+}
+
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchOrInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 value)
+{
+    return __atomic_fetch_or(&atomicInt->d_value, value, __ATOMIC_SEQ_CST);
+}
+
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchOrInt64AcqRel(AtomicTypes::Int64 *atomicInt, Types::Int64 value)
+{
+    return __atomic_fetch_or(&atomicInt->d_value, value, __ATOMIC_ACQ_REL);
+}
+
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchOrInt64Relaxed(AtomicTypes::Int64 *atomicInt, Types::Int64 value)
+{
+    return __atomic_fetch_or(&atomicInt->d_value, value, __ATOMIC_RELAXED);
+}
+
+#if defined(BSLS_ATOMICOPERATIONS_HAS_UINT128)
+inline
+void AtomicOperations_ALL_ALL_GCCIntrinsics::
+    initUint128(AtomicTypes::Uint128 *atomicUint,
+                Types::Uint64         low,
+                Types::Uint64         high)
+{
+    atomicUint->d_low  = low;
+    atomicUint->d_high = high;
+}
+
+inline
+void AtomicOperations_ALL_ALL_GCCIntrinsics::
+    getUint128(const AtomicTypes::Uint128 *atomicUint,
+               Types::Uint64              *low,
+               Types::Uint64              *high)
+{
+    // There is no 128-bit atomic load on x86_64, so compare the object with
+    // an arbitrary value, replacing it with the same value on a match; either
+    // way, 'cmpxchg16b' leaves the initial value of the object in 'rdx:rax'.
+
+    *low  = 0;
+    *high = 0;
+    testAndSwapUint128(const_cast<AtomicTypes::Uint128 *>(atomicUint),
+                       low,
+                       high,
+                       0,
+                       0);
+}
+
+inline
+bool AtomicOperations_ALL_ALL_GCCIntrinsics::
+    testAndSwapUint128(AtomicTypes::Uint128 *atomicUint,
+                       Types::Uint64        *compareLow,
+                       Types::Uint64        *compareHigh,
+                       Types::Uint64         swapLow,
+                       Types::Uint64         swapHigh)
+{
+    // The '__atomic' intrinsics implement 16-byte operations with
+    // 'cmpxchg16b' only when compiling with '-mcx16', and otherwise call
+    // 'libatomic', so issue the instruction directly.
+
+    bool result;
+
+    asm volatile (
+        "       lock cmpxchg16b %[obj]      \n\t"
+        "       sete %[res]                 \n\t"
+                : [obj] "+m" (*atomicUint),
+                  [res] "=q" (result),
+                  "+a" (*compareLow),
+                  "+d" (*compareHigh)
+                : "b" (swapLow),
+                  "c" (swapHigh)
+                : "memory", "cc");
+
+    return result;
+}
+#endif
+
 }  // close package namespace
 
 }  // close enterprise namespace
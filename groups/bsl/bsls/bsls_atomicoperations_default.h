@@ -375,6 +375,24 @@ struct AtomicOperations_DefaultInt
     static void decrementInt(typename AtomicTypes::Int *atomicInt);
 
     static void decrementIntAcqRel(typename AtomicTypes::Int *atomicInt);
+
+    static int fetchAndInt(typename AtomicTypes::Int *atomicInt,
+                           int value);
+
+    static int fetchAndIntAcqRel(typename AtomicTypes::Int *atomicInt,
+                                 int value);
+
+    static int fetchAndIntRelaxed(typename AtomicTypes::Int *atomicInt,
+                                  int value);
+
+    static int fetchOrInt(typename AtomicTypes::Int *atomicInt,
+                          int value);
+
+    static int fetchOrIntAcqRel(typename AtomicTypes::Int *atomicInt,
+                                int value);
+
+    static int fetchOrIntRelaxed(typename AtomicTypes::Int *atomicInt,
+                                 int value);
 };
 
                     // ====================================
@@ -478,6 +496,28 @@ struct AtomicOperations_DefaultInt64
 
     static Types::Int64 decrementInt64NvAcqRel(
                                        typename AtomicTypes::Int64 *atomicInt);
+
+    static Types::Int64 fetchAndInt64(typename AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64 value);
+
+    static Types::Int64 fetchAndInt64AcqRel(
+                                        typename AtomicTypes::Int64 *atomicInt,
+                                        Types::Int64 value);
+
+    static Types::Int64 fetchAndInt64Relaxed(
+                                        typename AtomicTypes::Int64 *atomicInt,
+                                        Types::Int64 value);
+
+    static Types::Int64 fetchOrInt64(typename AtomicTypes::Int64 *atomicInt,
+                                     Types::Int64 value);
+
+    static Types::Int64 fetchOrInt64AcqRel(
+                                        typename AtomicTypes::Int64 *atomicInt,
+                                        Types::Int64 value);
+
+    static Types::Int64 fetchOrInt64Relaxed(
+                                        typename AtomicTypes::Int64 *atomicInt,
+                                        Types::Int64 value);
 };
 
                   // ========================================
@@ -838,6 +878,74 @@ void AtomicOperations_DefaultInt<IMP>::
     IMP::addIntAcqRel(atomicInt, -1);
 }
 
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchAndInt(typename AtomicTypes::Int *atomicInt, int value)
+{
+    int initialValue = IMP::getIntRelaxed(atomicInt);
+    int expected;
+
+    do {
+        expected     = initialValue;
+        initialValue = IMP::testAndSwapInt(atomicInt,
+                                           expected,
+                                           expected & value);
+    } while (initialValue != expected);
+
+    return initialValue;
+}
+
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchAndIntAcqRel(typename AtomicTypes::Int *atomicInt, int value)
+{
+    return IMP::fetchAndInt(atomicInt, value);
+}
+
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchAndIntRelaxed(typename AtomicTypes::Int *atomicInt, int value)
+{
+    return IMP::fetchAndIntAcqRel(atomicInt, value);
+}
+
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchOrInt(typename AtomicTypes::Int *atomicInt, int value)
+{
+    int initialValue = IMP::getIntRelaxed(atomicInt);
+    int expected;
+
+    do {
+        expected     = initialValue;
+        initialValue = IMP::testAndSwapInt(atomicInt,
+                                           expected,
+                                           expected | value);
+    } while (initialValue != expected);
+
+    return initialValue;
+}
+
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchOrIntAcqRel(typename AtomicTypes::Int *atomicInt, int value)
+{
+    return IMP::fetchOrInt(atomicInt, value);
+}
+
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchOrIntRelaxed(typename AtomicTypes::Int *atomicInt, int value)
+{
+    return IMP::fetchOrIntAcqRel(atomicInt, value);
+}
+
                     // ------------------------------------
                     // struct AtomicOperations_DefaultInt64
                     // ------------------------------------
@@ -1014,6 +1122,80 @@ Types::Int64 AtomicOperations_DefaultInt64<IMP>::
     return IMP::addInt64NvAcqRel(atomicInt, -1);
 }
 
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchAndInt64(typename AtomicTypes::Int64 *atomicInt,
+                  Types::Int64 value)
+{
+    Types::Int64 initialValue = IMP::getInt64Relaxed(atomicInt);
+    Types::Int64 expected;
+
+    do {
+        expected     = initialValue;
+        initialValue = IMP::testAndSwapInt64(atomicInt,
+                                             expected,
+                                             expected & value);
+    } while (initialValue != expected);
+
+    return initialValue;
+}
+
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchAndInt64AcqRel(typename AtomicTypes::Int64 *atomicInt,
+                        Types::Int64 value)
+{
+    return IMP::fetchAndInt64(atomicInt, value);
+}
+
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchAndInt64Relaxed(typename AtomicTypes::Int64 *atomicInt,
+                         Types::Int64 value)
+{
+    return IMP::fetchAndInt64AcqRel(atomicInt, value);
+}
+
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchOrInt64(typename AtomicTypes::Int64 *atomicInt,
+                 Types::Int64 value)
+{
+    Types::Int64 initialValue = IMP::getInt64Relaxed(atomicInt);
+    Types::Int64 expected;
+
+    do {
+        expected     = initialValue;
+        initialValue = IMP::testAndSwapInt64(atomicInt,
+                                             expected,
+                                             expected | value);
+    } while (initialValue != expected);
+
+    return initialValue;
+}
+
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchOrInt64AcqRel(typename AtomicTypes::Int64 *atomicInt,
+                       Types::Int64 value)
+{
+    return IMP::fetchOrInt64(atomicInt, value);
+}
+
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchOrInt64Relaxed(typename AtomicTypes::Int64 *atomicInt,
+                        Types::Int64 value)
+{
+    return IMP::fetchOrInt64AcqRel(atomicInt, value);
+}
+
                   // ----------------------------------------
                   // struct AtomicOperations_DefaultPointer32
                   // ----------------------------------------
@@ -40,6 +40,10 @@ BSLS_IDENT("$Id: $")
 #if defined(BSLS_PLATFORM_CPU_X86_64) \
     && (defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG))
 
+#define BSLS_ATOMICOPERATIONS_HAS_UINT128 1
+    // This platform provides the 128-bit atomic operations ('getUint128',
+    // 'testAndSwapUint128', etc.).
+
 namespace BloombergLP {
 
 namespace bsls {
@@ -69,6 +73,12 @@ struct Atomic_TypeTraits<AtomicOperations_X64_ALL_GCC>
     {
         void * volatile d_value __attribute__((__aligned__(sizeof(void *))));
     };
+
+    struct Uint128
+    {
+        volatile Types::Uint64 d_low __attribute__((__aligned__(16)));
+        volatile Types::Uint64 d_high;
+    };
 };
 
                      // ===================================
@@ -96,6 +106,10 @@ struct AtomicOperations_X64_ALL_GCC
 
     static int addIntNv(AtomicTypes::Int *atomicInt, int value);
 
+    static int fetchAndInt(AtomicTypes::Int *atomicInt, int value);
+
+    static int fetchOrInt(AtomicTypes::Int *atomicInt, int value);
+
         // *** atomic functions for Int64 ***
 
     static Types::Int64 getInt64(const AtomicTypes::Int64 *atomicInt);
@@ -114,6 +128,28 @@ struct AtomicOperations_X64_ALL_GCC
 
     static Types::Int64 addInt64Nv(AtomicTypes::Int64 *atomicInt,
                                    Types::Int64 value);
+
+    static Types::Int64 fetchAndInt64(AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64 value);
+
+    static Types::Int64 fetchOrInt64(AtomicTypes::Int64 *atomicInt,
+                                     Types::Int64 value);
+
+        // *** atomic functions for Uint128 ***
+
+    static void initUint128(AtomicTypes::Uint128 *atomicUint,
+                            Types::Uint64         low,
+                            Types::Uint64         high);
+
+    static void getUint128(const AtomicTypes::Uint128 *atomicUint,
+                           Types::Uint64              *low,
+                           Types::Uint64              *high);
+
+    static bool testAndSwapUint128(AtomicTypes::Uint128 *atomicUint,
+                                   Types::Uint64        *compareLow,
+                                   Types::Uint64        *compareHigh,
+                                   Types::Uint64         swapLow,
+                                   Types::Uint64         swapHigh);
 };
 
 // ===========================================================================
@@ -198,6 +234,20 @@ int AtomicOperations_X64_ALL_GCC::
     return __sync_add_and_fetch(&atomicInt->d_value, value);
 }
 
+inline
+int AtomicOperations_X64_ALL_GCC::
+    fetchAndInt(AtomicTypes::Int *atomicInt, int value)
+{
+    return __sync_fetch_and_and(&atomicInt->d_value, value);
+}
+
+inline
+int AtomicOperations_X64_ALL_GCC::
+    fetchOrInt(AtomicTypes::Int *atomicInt, int value)
+{
+    return __sync_fetch_and_or(&atomicInt->d_value, value);
+}
+
 inline
 Types::Int64 AtomicOperations_X64_ALL_GCC::
     getInt64(const AtomicTypes::Int64 *atomicInt)
@@ -275,6 +325,75 @@ Types::Int64 AtomicOperations_X64_ALL_GCC::
     return __sync_add_and_fetch(&atomicInt->d_value, value);
 }
 
+inline
+Types::Int64 AtomicOperations_X64_ALL_GCC::
+    fetchAndInt64(AtomicTypes::Int64 *atomicInt,
+                  Types::Int64 value)
+{
+    return __sync_fetch_and_and(&atomicInt->d_value, value);
+}
+
+inline
+Types::Int64 AtomicOperations_X64_ALL_GCC::
+    fetchOrInt64(AtomicTypes::Int64 *atomicInt,
+                 Types::Int64 value)
+{
+    return __sync_fetch_and_or(&atomicInt->d_value, value);
+}
+
+inline
+void AtomicOperations_X64_ALL_GCC::
+    initUint128(AtomicTypes::Uint128 *atomicUint,
+                Types::Uint64         low,
+                Types::Uint64         high)
+{
+    atomicUint->d_low  = low;
+    atomicUint->d_high = high;
+}
+
+inline
+void AtomicOperations_X64_ALL_GCC::
+    getUint128(const AtomicTypes::Uint128 *atomicUint,
+               Types::Uint64              *low,
+               Types::Uint64              *high)
+{
+    // There is no 128-bit atomic load on x86_64, so compare the object with
+    // an arbitrary value, replacing it with the same value on a match; either
+    // way, 'cmpxchg16b' leaves the initial value of the object in 'rdx:rax'.
+
+    *low  = 0;
+    *high = 0;
+    testAndSwapUint128(const_cast<AtomicTypes::Uint128 *>(atomicUint),
+                       low,
+                       high,
+                       0,
+                       0);
+}
+
+inline
+bool AtomicOperations_X64_ALL_GCC::
+    testAndSwapUint128(AtomicTypes::Uint128 *atomicUint,
+                       Types::Uint64        *compareLow,
+                       Types::Uint64        *compareHigh,
+                       Types::Uint64         swapLow,
+                       Types::Uint64         swapHigh)
+{
+    bool result;
+
+    asm volatile (
+        "       lock cmpxchg16b %[obj]      \n\t"
+        "       sete %[res]                 \n\t"
+                : [obj] "+m" (*atomicUint),
+                  [res] "=q" (result),
+                  "+a" (*compareLow),
+                  "+d" (*compareHigh)
+                : "b" (swapLow),
+                  "c" (swapHigh)
+                : "memory", "cc");
+
+    return result;
+}
+
 }  // close package namespace
 
 }  // close enterprise namespace
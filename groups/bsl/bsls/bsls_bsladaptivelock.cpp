@@ -0,0 +1,239 @@
+// bsls_bsladaptivelock.cpp                                           -*-C++-*-
+#include <bsls_bsladaptivelock.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_atomic.h>         // for testing only
+#include <bsls_bsltestutil.h>    // for testing only
+#include <bsls_stopwatch.h>      // for testing only
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(BSLS_PLATFORM_OS_WINDOWS)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <stddef.h>  // 'size_t'
+
+namespace BloombergLP {
+namespace bsls {
+namespace {
+
+enum {
+    k_SPIN_COUNT = 100  // number of times that 'lock' polls a held lock
+                        // before blocking
+};
+
+#if !defined(BSLS_PLATFORM_OS_LINUX)
+
+// Where no futex is available, a blocked thread waits on the condition
+// variable of one of a fixed set of "parking" slots, chosen by the address of
+// the lock word, and protected by the mutex of the slot.  A thread releasing
+// a contended lock changes the lock word before locking the mutex of its
+// slot, and a waiting thread checks the lock word after locking that mutex,
+// so that no wake-up is lost.  Since several locks may share a slot, all the
+// threads waiting on a slot are woken, and each re-checks its lock word.
+
+enum {
+    k_NUM_PARKING_SLOTS = 64  // number of parking slots (a power of 2)
+};
+
+struct ParkingSlot {
+    // This 'struct' holds the mutex and condition variable on which threads
+    // blocked on the locks mapped to this slot wait.
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+    SRWLOCK            d_mutex;      // protects the wait
+    CONDITION_VARIABLE d_condition;  // signaled when a lock is released
+#else
+    pthread_mutex_t    d_mutex;      // protects the wait
+    pthread_cond_t     d_condition;  // signaled when a lock is released
+#endif
+};
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+#define BSLS_BSLADAPTIVELOCK_SLOT { SRWLOCK_INIT, CONDITION_VARIABLE_INIT }
+#else
+#define BSLS_BSLADAPTIVELOCK_SLOT { PTHREAD_MUTEX_INITIALIZER,                \
+                                    PTHREAD_COND_INITIALIZER }
+#endif
+
+#define BSLS_BSLADAPTIVELOCK_SLOTS8                                           \
+    BSLS_BSLADAPTIVELOCK_SLOT, BSLS_BSLADAPTIVELOCK_SLOT,                     \
+    BSLS_BSLADAPTIVELOCK_SLOT, BSLS_BSLADAPTIVELOCK_SLOT,                     \
+    BSLS_BSLADAPTIVELOCK_SLOT, BSLS_BSLADAPTIVELOCK_SLOT,                     \
+    BSLS_BSLADAPTIVELOCK_SLOT, BSLS_BSLADAPTIVELOCK_SLOT
+
+ParkingSlot s_parkingSlots[k_NUM_PARKING_SLOTS] = {
+    BSLS_BSLADAPTIVELOCK_SLOTS8, BSLS_BSLADAPTIVELOCK_SLOTS8,
+    BSLS_BSLADAPTIVELOCK_SLOTS8, BSLS_BSLADAPTIVELOCK_SLOTS8,
+    BSLS_BSLADAPTIVELOCK_SLOTS8, BSLS_BSLADAPTIVELOCK_SLOTS8,
+    BSLS_BSLADAPTIVELOCK_SLOTS8, BSLS_BSLADAPTIVELOCK_SLOTS8
+};
+
+#undef BSLS_BSLADAPTIVELOCK_SLOTS8
+#undef BSLS_BSLADAPTIVELOCK_SLOT
+
+inline
+ParkingSlot& parkingSlot(const AtomicOperations::AtomicTypes::Int *state)
+    // Return a reference providing modifiable access to the parking slot of
+    // the lock word at the specified 'state'.
+{
+    // Locks are at least a cache line apart, so the bits of the address below
+    // the size of a cache line do not distinguish them.
+
+    const size_t address = reinterpret_cast<size_t>(state);
+
+    return s_parkingSlots[(address >> 6) & (k_NUM_PARKING_SLOTS - 1)];
+}
+
+#endif
+
+inline
+void pauseProcessor()
+    // Hint to the processor that the calling thread is polling a memory
+    // location, so that the processor may yield resources to other hardware
+    // threads and avoid a memory-order violation when leaving the loop.
+{
+#if defined(BSLS_PLATFORM_CPU_X86) || defined(BSLS_PLATFORM_CPU_X86_64)
+#if defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+    __asm__ __volatile__("pause" ::: "memory");
+#elif defined(BSLS_PLATFORM_CMP_MSVC)
+    YieldProcessor();
+#endif
+#endif
+}
+
+inline
+void waitWhileEqual(AtomicOperations::AtomicTypes::Int *state, int value)
+    // Block the calling thread until the specified 'state' might no longer
+    // have the specified 'value', and return.  Note that this function may
+    // return spuriously.
+{
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    // 'AtomicTypes::Int' is a 'struct' whose only member is a (suitably
+    // aligned) 'int', which is the type on which a futex operates.
+
+    syscall(SYS_futex,
+            reinterpret_cast<int *>(state),
+            FUTEX_WAIT_PRIVATE,
+            value,
+            0,
+            0,
+            0);
+#else
+    ParkingSlot& slot = parkingSlot(state);
+
+# if defined(BSLS_PLATFORM_OS_WINDOWS)
+    AcquireSRWLockExclusive(&slot.d_mutex);
+    if (value == AtomicOperations::getIntAcquire(state)) {
+        SleepConditionVariableSRW(&slot.d_condition,
+                                  &slot.d_mutex,
+                                  INFINITE,
+                                  0);
+    }
+    ReleaseSRWLockExclusive(&slot.d_mutex);
+# else
+    pthread_mutex_lock(&slot.d_mutex);
+    if (value == AtomicOperations::getIntAcquire(state)) {
+        pthread_cond_wait(&slot.d_condition, &slot.d_mutex);
+    }
+    pthread_mutex_unlock(&slot.d_mutex);
+# endif
+#endif
+}
+
+inline
+void wakeOne(AtomicOperations::AtomicTypes::Int *state)
+    // Wake (at least) one of the threads blocked in 'waitWhileEqual' on the
+    // specified 'state', if any.
+{
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    syscall(SYS_futex,
+            reinterpret_cast<int *>(state),
+            FUTEX_WAKE_PRIVATE,
+            1,
+            0,
+            0,
+            0);
+#else
+    ParkingSlot& slot = parkingSlot(state);
+
+# if defined(BSLS_PLATFORM_OS_WINDOWS)
+    AcquireSRWLockExclusive(&slot.d_mutex);
+    WakeAllConditionVariable(&slot.d_condition);
+    ReleaseSRWLockExclusive(&slot.d_mutex);
+# else
+    pthread_mutex_lock(&slot.d_mutex);
+    pthread_cond_broadcast(&slot.d_condition);
+    pthread_mutex_unlock(&slot.d_mutex);
+# endif
+#endif
+}
+
+}  // close unnamed namespace
+
+                           // ---------------------
+                           // class BslAdaptiveLock
+                           // ---------------------
+
+// PRIVATE MANIPULATORS
+void BslAdaptiveLock::lockContended()
+{
+    AtomicOps::addInt64Relaxed(&d_numContendedLocks, 1);
+
+    // First, poll the lock for a bounded interval, in the expectation that the
+    // holder will release it shortly.  Reading the lock before attempting to
+    // acquire it avoids taking ownership of its cache line while it is held.
+
+    for (int i = 0; i < k_SPIN_COUNT; ++i) {
+        pauseProcessor();
+
+        if (k_UNLOCKED == AtomicOps::getIntRelaxed(&d_state)
+         && k_UNLOCKED == AtomicOps::testAndSwapIntAcqRel(&d_state,
+                                                          k_UNLOCKED,
+                                                          k_LOCKED)) {
+            return;                                                   // RETURN
+        }
+    }
+
+    // Then, block.  Marking the lock as contended obliges the thread that
+    // releases it to wake a waiter.  Note that a thread acquiring the lock
+    // here must mark it as contended, because other threads may still be
+    // waiting.
+
+    while (k_UNLOCKED != AtomicOps::swapIntAcqRel(&d_state,
+                                                  k_LOCKED_CONTENDED)) {
+        AtomicOps::addInt64Relaxed(&d_numWaits, 1);
+        waitWhileEqual(&d_state, k_LOCKED_CONTENDED);
+    }
+}
+
+void BslAdaptiveLock::wakeWaiter()
+{
+    wakeOne(&d_state);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,403 @@
+// bsls_bsladaptivelock.h                                             -*-C++-*-
+#ifndef INCLUDED_BSLS_BSLADAPTIVELOCK
+#define INCLUDED_BSLS_BSLADAPTIVELOCK
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a spin-then-block mutex for short critical sections.
+//
+//@CLASSES:
+//  bsls::BslAdaptiveLock: mutex that spins briefly before blocking
+//  bsls::BslAdaptiveLockGuard: RAII mechanism for a 'BslAdaptiveLock'
+//
+//@SEE_ALSO: bsls_bsllock, bslmt_mutex
+//
+//@DESCRIPTION: This component provides a mutually exclusive lock primitive
+// ("mutex"), 'bsls::BslAdaptiveLock', intended for the short critical
+// sections that guard shared state at the lowest levels of the library (e.g.,
+// the bookkeeping of 'bslma::TestAllocator').  Like 'bsls::BslLock',
+// 'bsls::BslAdaptiveLock' provides 'lock' and 'unlock' operations, is not
+// recursive, and is not intended for direct client use (see 'bslmt_mutex'
+// instead).  The two types are interchangeable: a component below 'bslmt'
+// chooses between them by the type of its lock data member, and uses the
+// guard type that corresponds to it.
+//
+// This component also provides the 'bsls::BslAdaptiveLockGuard' class, which
+// has the same interface and semantics as 'bsls::BslLockGuard', and follows
+// the RAII idiom for automatically acquiring and releasing the lock on an
+// associated 'bsls::BslAdaptiveLock' object.
+//
+///Choosing Between 'BslLock' and 'BslAdaptiveLock'
+///------------------------------------------------
+// 'bsls::BslLock' wraps the mutex of the operating system; on most platforms,
+// a thread that finds the lock held is suspended right away, so that a brief
+// collision between two threads costs a system call and two context switches.
+// 'bsls::BslAdaptiveLock' instead:
+//
+//: 1 acquires an unheld lock with a single atomic instruction (no function
+//:   call is made),
+//:
+//: 2 when the lock is held, spins for a bounded number of iterations, polling
+//:   the lock with an instruction that yields the processor's pipeline to
+//:   other hardware threads, and
+//:
+//: 3 only then blocks: on Linux, by waiting on a futex; on other platforms,
+//:   by waiting on a condition variable chosen (from a fixed set) by the
+//:   address of the lock.  In either case, a thread releasing a lock on
+//:   which no thread is blocked makes no system call.
+//
+// 'bsls::BslAdaptiveLock' is therefore appropriate when critical sections are
+// a few hundred instructions or fewer, and never block (e.g., they do not
+// perform I/O or acquire other locks).  Where a critical section may be long,
+// 'bsls::BslLock' should be preferred.
+//
+// Each 'bsls::BslAdaptiveLock' object is padded to the size of a cache line
+// (64 bytes), so that neither another lock of an array nor the data following
+// a lock shares the cache line of the lock word (false sharing).  Note that
+// the object is *not* aligned to a cache line, since this component cannot
+// portably align an object: the lock may straddle two cache lines, and the
+// lock word may share a cache line with data *preceding* the lock.  Placing
+// the lock as the first data member of a class, or after other
+// rarely-modified data, avoids the latter.
+//
+///Contention Statistics
+///---------------------
+// Each lock counts the calls to 'lock' that found the lock held
+// ('numContendedLocks') and the number of times that a thread blocked waiting
+// for the lock ('numWaits').  The counters are updated only on the slow
+// (contended) path, so they add no cost to the acquisition of an unheld lock.
+// They allow a developer to determine whether a given lock is a bottleneck,
+// and whether it is a suitable candidate for this component.
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Protecting a Counter Updated by Many Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we maintain statistics that many threads update, each under a
+// lock held for only a few instructions.  A 'bsls::BslAdaptiveLock' avoids
+// suspending the updating threads when they collide.
+//
+// First, we define the statistics class, placing the lock first:
+//..
+//  class my_Statistics {
+//      // This 'class' accumulates a count and a total, and is thread-safe.
+//
+//      // DATA
+//      mutable bsls::BslAdaptiveLock d_lock;   // guard 'd_count', 'd_total'
+//      int                           d_count;  // number of samples
+//      double                        d_total;  // sum of samples
+//
+//    public:
+//      // CREATORS
+//      my_Statistics() : d_count(0), d_total(0.0) {}
+//          // Create an object having no samples.
+//
+//      // MANIPULATORS
+//      void add(double sample)
+//          // Add the specified 'sample' to this object.
+//      {
+//          bsls::BslAdaptiveLockGuard guard(&d_lock);
+//
+//          ++d_count;
+//          d_total += sample;
+//      }
+//
+//      // ACCESSORS
+//      double mean() const
+//          // Return the mean of the samples added to this object, or 0 if
+//          // there are none.
+//      {
+//          bsls::BslAdaptiveLockGuard guard(&d_lock);
+//
+//          return d_count ? d_total / d_count : 0.0;
+//      }
+//
+//      bsls::Types::Int64 numContendedLocks() const
+//          // Return the number of times that a thread found the lock of this
+//          // object held.
+//      {
+//          return d_lock.numContendedLocks();
+//      }
+//  };
+//..
+// Then, we add some samples:
+//..
+//  my_Statistics stats;
+//
+//  stats.add(1.0);
+//  stats.add(2.0);
+//  stats.add(6.0);
+//..
+// Finally, we verify the mean, and that no thread found the lock held:
+//..
+//  assert(3.0 == stats.mean());
+//  assert(0   == stats.numContendedLocks());
+//..
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+                           // =====================
+                           // class BslAdaptiveLock
+                           // =====================
+
+class BslAdaptiveLock {
+    // This 'class' implements a light-weight mutex, for intra-process
+    // synchronization, that spins for a bounded interval before blocking.
+    // The mutex implemented by this class is *non*-recursive.  Note that
+    // 'BslAdaptiveLock' is *not* intended for direct use by client code; it is
+    // meant for internal use only.
+
+    // PRIVATE TYPES
+    typedef AtomicOperations              AtomicOps;
+    typedef AtomicOperations::AtomicTypes AtomicTypes;
+
+    enum {
+        k_UNLOCKED          = 0,  // lock is not held
+        k_LOCKED            = 1,  // lock is held, and no thread is blocked
+        k_LOCKED_CONTENDED  = 2,  // lock is held, and threads may be blocked
+
+        k_CACHE_LINE_SIZE   = 64  // assumed size of a cache line
+    };
+
+    // DATA
+    AtomicTypes::Int   d_state;              // 'k_UNLOCKED', 'k_LOCKED', or
+                                             // 'k_LOCKED_CONTENDED'
+
+    AtomicTypes::Int64 d_numContendedLocks;  // calls to 'lock' that found the
+                                             // lock held
+
+    AtomicTypes::Int64 d_numWaits;           // times a thread blocked
+
+    char               d_padding[k_CACHE_LINE_SIZE
+                                 - 3 * sizeof(AtomicTypes::Int64)];
+                                             // pad to a cache line ('d_state'
+                                             // and its alignment padding
+                                             // occupy at most the size of an
+                                             // 'Int64')
+
+  private:
+    // NOT IMPLEMENTED
+    BslAdaptiveLock(const BslAdaptiveLock&);             // = delete
+    BslAdaptiveLock& operator=(const BslAdaptiveLock&);  // = delete
+
+    // PRIVATE MANIPULATORS
+    void lockContended();
+        // Acquire the lock on this object, which was found to be held, first
+        // spinning for a bounded interval, and then blocking until the lock
+        // can be acquired.
+
+    void wakeWaiter();
+        // Wake one of the threads (if any) that are blocked waiting for the
+        // lock on this object.
+
+  public:
+    // CREATORS
+    BslAdaptiveLock();
+        // Create a lock object initialized to the unlocked state.
+
+    ~BslAdaptiveLock();
+        // Destroy this lock object.  The behavior is undefined unless this
+        // object is in the unlocked state.
+
+    // MANIPULATORS
+    void lock();
+        // Acquire the lock on this object.  If the lock on this object is
+        // currently held by another thread, then spin for a bounded interval,
+        // and then suspend execution of the calling thread, until the lock can
+        // be acquired.  The behavior is undefined unless the calling thread
+        // does not already hold the lock on this object.  Note that deadlock
+        // may result if this method is invoked while the calling thread holds
+        // the lock on the object.
+
+    void unlock();
+        // Release the lock on this object that was previously acquired
+        // through a call to 'lock', enabling another thread to acquire the
+        // lock.  The behavior is undefined unless the calling thread holds the
+        // lock on this object.
+
+    // ACCESSORS
+    Types::Int64 numContendedLocks() const;
+        // Return the number of calls to 'lock' on this object that found the
+        // lock held by another thread.
+
+    Types::Int64 numWaits() const;
+        // Return the number of times that a thread blocked waiting for the
+        // lock on this object.  Note that a single call to 'lock' may block
+        // more than once.
+};
+
+                         // ==========================
+                         // class BslAdaptiveLockGuard
+                         // ==========================
+
+class BslAdaptiveLockGuard {
+    // This 'class' implements a guard for automatically acquiring and
+    // releasing the lock on an associated 'bsls::BslAdaptiveLock' object.
+    // This mechanism follows the RAII idiom whereby the lock on the
+    // 'BslAdaptiveLock' associated with a guard object is acquired upon
+    // construction and released upon destruction.
+
+    // DATA
+    BslAdaptiveLock *d_lock_p;  // lock guarded by this object (held, not
+                                // owned)
+
+  private:
+    // NOT IMPLEMENTED
+    BslAdaptiveLockGuard(const BslAdaptiveLockGuard&);             // = delete
+    BslAdaptiveLockGuard& operator=(const BslAdaptiveLockGuard&);  // = delete
+
+  public:
+    // CREATORS
+    explicit BslAdaptiveLockGuard(BslAdaptiveLock *lock);
+        // Create a guard object that conditionally manages the specified
+        // 'lock', and acquires the lock on 'lock' by invoking its 'lock'
+        // method.  The behavior is undefined unless the calling thread does
+        // not already hold the lock on 'lock'.  Note that deadlock may result
+        // if a guard is created for 'lock' while the calling thread holds the
+        // lock on 'lock'.  Also note that 'lock' must remain valid throughout
+        // the lifetime of this guard, or until 'release' is called.
+
+    ~BslAdaptiveLockGuard();
+        // Destroy this guard object and release the lock on the object it
+        // manages (if any) by invoking the 'unlock' method of the object that
+        // was supplied at construction of this guard.  If no lock is currently
+        // being managed, this method has no effect.  Note that if this guard
+        // object currently manages a lock, this method assumes the behavior
+        // of 'BslAdaptiveLock::unlock'.
+
+    // MANIPULATORS
+    void release();
+        // Release from management, with no effect, the object currently
+        // managed by this guard, if any.  Note that 'unlock' is *not* called
+        // on the managed object upon its release.
+};
+
+// ============================================================================
+//                        INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                           // ---------------------
+                           // class BslAdaptiveLock
+                           // ---------------------
+
+// CREATORS
+inline
+BslAdaptiveLock::BslAdaptiveLock()
+{
+    AtomicOps::initInt(&d_state, k_UNLOCKED);
+    AtomicOps::initInt64(&d_numContendedLocks, 0);
+    AtomicOps::initInt64(&d_numWaits, 0);
+}
+
+inline
+BslAdaptiveLock::~BslAdaptiveLock()
+{
+    BSLS_ASSERT_SAFE(k_UNLOCKED == AtomicOps::getIntRelaxed(&d_state));
+}
+
+// MANIPULATORS
+inline
+void BslAdaptiveLock::lock()
+{
+    if (k_UNLOCKED != AtomicOps::testAndSwapIntAcqRel(&d_state,
+                                                      k_UNLOCKED,
+                                                      k_LOCKED)) {
+        lockContended();
+    }
+}
+
+inline
+void BslAdaptiveLock::unlock()
+{
+    BSLS_ASSERT_SAFE(k_UNLOCKED != AtomicOps::getIntRelaxed(&d_state));
+
+    if (k_LOCKED_CONTENDED == AtomicOps::swapIntAcqRel(&d_state,
+                                                       k_UNLOCKED)) {
+        wakeWaiter();
+    }
+}
+
+// ACCESSORS
+inline
+Types::Int64 BslAdaptiveLock::numContendedLocks() const
+{
+    return AtomicOps::getInt64Relaxed(&d_numContendedLocks);
+}
+
+inline
+Types::Int64 BslAdaptiveLock::numWaits() const
+{
+    return AtomicOps::getInt64Relaxed(&d_numWaits);
+}
+
+                         // --------------------------
+                         // class BslAdaptiveLockGuard
+                         // --------------------------
+
+// CREATORS
+inline
+BslAdaptiveLockGuard::BslAdaptiveLockGuard(BslAdaptiveLock *lock)
+: d_lock_p(lock)
+{
+    BSLS_ASSERT_SAFE(lock);
+
+    d_lock_p->lock();
+}
+
+inline
+BslAdaptiveLockGuard::~BslAdaptiveLockGuard()
+{
+    if (d_lock_p) {
+        d_lock_p->unlock();
+    }
+}
+
+// MANIPULATORS
+inline
+void BslAdaptiveLockGuard::release()
+{
+    d_lock_p = 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,745 @@
+// bsls_bsladaptivelock.t.cpp                                         -*-C++-*-
+#include <bsls_bsladaptivelock.h>
+
+#include <bsls_asserttest.h>     // for testing only
+#include <bsls_atomic.h>         // for testing only
+#include <bsls_bsllock.h>        // for testing only
+#include <bsls_bsltestutil.h>    // for testing only
+#include <bsls_stopwatch.h>      // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// We are testing a mutually exclusive locking primitive ("mutex") that spins
+// for a bounded interval before blocking, and a guard for that mutex type.
+// The operations on the mutex type, 'bsls::BslAdaptiveLock', are 'lock' and
+// 'unlock', and the lone operation on the guard is 'release'.  In the first
+// two tests we use two concurrent threads, verifying that the 'lock',
+// 'unlock', and 'release' methods invoked by the respective threads occur in
+// the expected order.  We then verify mutual exclusion, and the contention
+// statistics, with several threads repeatedly acquiring the lock.
+// ----------------------------------------------------------------------------
+// 'BslAdaptiveLock' class:
+// [ 1] BslAdaptiveLock::BslAdaptiveLock();
+// [ 1] BslAdaptiveLock::~BslAdaptiveLock();
+// [ 1] void BslAdaptiveLock::lock();
+// [ 1] void BslAdaptiveLock::unlock();
+// [ 3] Types::Int64 BslAdaptiveLock::numContendedLocks() const;
+// [ 3] Types::Int64 BslAdaptiveLock::numWaits() const;
+//
+// 'BslAdaptiveLockGuard' class:
+// [ 2] BslAdaptiveLockGuard::BslAdaptiveLockGuard(BslAdaptiveLock *lock);
+// [ 2] BslAdaptiveLockGuard::~BslAdaptiveLockGuard();
+// [ 2] void BslAdaptiveLockGuard::release();
+// ----------------------------------------------------------------------------
+// [ 1] BASIC TEST
+// [ 3] CONCERN: Mutual exclusion among many threads.
+// [ 4] USAGE EXAMPLE
+// [ 2] CONCERN: Precondition violations are detected when enabled.
+// [-1] PERFORMANCE: CONTENDED SHORT CRITICAL SECTIONS
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bsls::BslAdaptiveLock      Obj;
+typedef bsls::BslAdaptiveLockGuard Guard;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+void sleepSeconds(int seconds)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    Sleep(seconds * 1000);
+#else
+    sleep(seconds);
+#endif
+}
+
+enum { MAX_SLEEP_CYCLES = 2 };
+
+static
+void pause(bsls::AtomicInt *value)
+    // Pause the current thread until the specified '*value' is non-zero, or
+    // a sufficient number of sleep cycles have elapsed.
+{
+    for (int i = 0; 0 == *value && i < MAX_SLEEP_CYCLES; ++i) {
+        sleepSeconds(1);
+    }
+}
+
+                                // -----------
+                                // cases 1 & 2
+                                // -----------
+
+enum { NO_THREAD = 0, MAIN_THREAD = 1, CHILD_THREAD = 2 };
+
+struct ThreadInfo {
+    Obj             *d_lock;
+    bsls::AtomicInt  d_firstIn;
+    bsls::AtomicInt  d_threadDone;
+};
+
+extern "C" void *threadFunction(void *arg)
+{
+    ThreadInfo *info = (ThreadInfo *)arg;
+
+    info->d_lock->lock();                                             // LOCK
+    if (NO_THREAD == info->d_firstIn) {
+        info->d_firstIn = CHILD_THREAD;
+    }
+    info->d_lock->unlock();                                           // UNLOCK
+    info->d_threadDone = 1;
+
+    return arg;
+}
+
+                                // ----------
+                                // cases 3, -1
+                                // ----------
+
+enum { k_MAX_THREADS = 16 };
+
+template <class LOCK, class GUARD>
+struct CounterInfo {
+    LOCK            *d_lock_p;         // lock guarding 'd_counter'
+    int              d_counter;        // incremented under 'd_lock_p'
+    int              d_numIterations;  // increments per thread
+    bsls::AtomicInt  d_go;             // set to start all threads at once
+};
+
+template <class LOCK, class GUARD>
+void *counterFunction(void *arg)
+    // Wait until the 'd_go' member of the specified 'arg', which must be the
+    // address of a 'CounterInfo<LOCK, GUARD>' object, is set, and then
+    // increment its 'd_counter' member 'd_numIterations' times, each while
+    // holding the lock 'd_lock_p'.
+{
+    CounterInfo<LOCK, GUARD> *info =
+                                 static_cast<CounterInfo<LOCK, GUARD> *>(arg);
+
+    while (0 == info->d_go) {
+    }
+
+    for (int i = 0; i < info->d_numIterations; ++i) {
+        GUARD guard(info->d_lock_p);
+
+        ++info->d_counter;
+    }
+
+    return arg;
+}
+
+template <class LOCK, class GUARD>
+int runCounterThreads(LOCK *lock, int numThreads, int numIterations)
+    // Increment a counter, guarded by the specified 'lock', the specified
+    // 'numIterations' times in each of the specified 'numThreads' threads,
+    // and return the final value of the counter.  The behavior is undefined
+    // unless '0 < numThreads <= k_MAX_THREADS'.
+{
+    CounterInfo<LOCK, GUARD> info;
+    info.d_lock_p        = lock;
+    info.d_counter       = 0;
+    info.d_numIterations = numIterations;
+    info.d_go            = 0;
+
+    ThreadId ids[k_MAX_THREADS];
+    for (int i = 0; i < numThreads; ++i) {
+        ids[i] = createThread(&counterFunction<LOCK, GUARD>, &info);
+    }
+
+    info.d_go = 1;
+
+    for (int i = 0; i < numThreads; ++i) {
+        joinThread(ids[i]);
+    }
+
+    return info.d_counter;
+}
+
+// ============================================================================
+//                                USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Protecting a Counter Updated by Many Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we maintain statistics that many threads update, each under a
+// lock held for only a few instructions.  A 'bsls::BslAdaptiveLock' avoids
+// suspending the updating threads when they collide.
+//
+// First, we define the statistics class, placing the lock first:
+//..
+    class my_Statistics {
+        // This 'class' accumulates a count and a total, and is thread-safe.
+
+        // DATA
+        mutable bsls::BslAdaptiveLock d_lock;   // guard 'd_count', 'd_total'
+        int                           d_count;  // number of samples
+        double                        d_total;  // sum of samples
+
+      public:
+        // CREATORS
+        my_Statistics() : d_count(0), d_total(0.0) {}
+            // Create an object having no samples.
+
+        // MANIPULATORS
+        void add(double sample)
+            // Add the specified 'sample' to this object.
+        {
+            bsls::BslAdaptiveLockGuard guard(&d_lock);
+
+            ++d_count;
+            d_total += sample;
+        }
+
+        // ACCESSORS
+        double mean() const
+            // Return the mean of the samples added to this object, or 0 if
+            // there are none.
+        {
+            bsls::BslAdaptiveLockGuard guard(&d_lock);
+
+            return d_count ? d_total / d_count : 0.0;
+        }
+
+        bsls::Types::Int64 numContendedLocks() const
+            // Return the number of times that a thread found the lock of this
+            // object held.
+        {
+            return d_lock.numContendedLocks();
+        }
+    };
+//..
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we add some samples:
+//..
+    my_Statistics stats;
+
+    stats.add(1.0);
+    stats.add(2.0);
+    stats.add(6.0);
+//..
+// Finally, we verify the mean, and that no thread found the lock held:
+//..
+    ASSERT(3.0 == stats.mean());
+    ASSERT(0   == stats.numContendedLocks());
+//..
+
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONTENTION TEST
+        //   Ensure that 'BslAdaptiveLock' provides mutual exclusion when many
+        //   threads contend for it, and that it counts the contention.
+        //
+        // Concerns:
+        //: 1 At most one thread holds the lock at any time, whether the
+        //:   threads acquiring the lock spin or block.
+        //:
+        //: 2 A lock that is acquired by only one thread records no
+        //:   contention.
+        //:
+        //: 3 A thread blocked waiting for the lock is woken when the lock is
+        //:   released, even if the holder releases the lock after the waiter
+        //:   has stopped spinning.
+        //:
+        //: 4 'numContendedLocks' and 'numWaits' are consistent with each
+        //:   other and with the number of acquisitions.
+        //
+        // Plan:
+        //: 1 For several numbers of threads, have each thread increment a
+        //:   shared, non-atomic counter many times while holding the lock, and
+        //:   verify the final value of the counter.  (C-1)
+        //:
+        //: 2 Verify that the statistics are 0 after the single-threaded run,
+        //:   and otherwise that 'numContendedLocks' does not exceed the number
+        //:   of acquisitions.  (C-2, 4)
+        //:
+        //: 3 Hold the lock in the main thread while a child thread attempts to
+        //:   acquire it, for long enough that the child blocks, then release
+        //:   the lock and join the child.  Verify that the child blocked.
+        //:   (C-3..4)
+        //
+        // Testing:
+        //   Types::Int64 BslAdaptiveLock::numContendedLocks() const;
+        //   Types::Int64 BslAdaptiveLock::numWaits() const;
+        //   CONCERN: Mutual exclusion among many threads.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCONTENTION TEST"
+                            "\n===============\n");
+
+        // C-1..2, 4
+        {
+            const int NUM_ITERATIONS = 100000;
+
+            for (int numThreads = 1; numThreads <= 8; numThreads *= 2) {
+                Obj mX;  const Obj& X = mX;
+
+                const int COUNT = runCounterThreads<Obj, Guard>(
+                                                               &mX,
+                                                               numThreads,
+                                                               NUM_ITERATIONS);
+
+                const bsls::Types::Int64 CONTENDED = X.numContendedLocks();
+                const bsls::Types::Int64 WAITS     = X.numWaits();
+
+                if (veryVerbose) {
+                    P_(numThreads) P_(CONTENDED) P(WAITS)
+                }
+
+                ASSERTV(numThreads, COUNT,
+                        numThreads * NUM_ITERATIONS == COUNT);
+                ASSERTV(numThreads, CONTENDED,
+                        CONTENDED <= numThreads * NUM_ITERATIONS);
+                ASSERTV(numThreads, CONTENDED, WAITS, 0 == WAITS || CONTENDED);
+
+                if (1 == numThreads) {
+                    ASSERTV(CONTENDED, 0 == CONTENDED);
+                    ASSERTV(WAITS,     0 == WAITS);
+                }
+            }
+        }
+
+        // C-3..4
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ThreadInfo info;
+            info.d_lock       = &mX;
+            info.d_firstIn    = NO_THREAD;
+            info.d_threadDone = 0;
+
+            mX.lock();                                                // LOCK
+
+            ThreadId id = createThread(&threadFunction, &info);
+
+            pause(&info.d_threadDone);
+            ASSERT(0 == info.d_threadDone);
+
+            mX.unlock();                                              // UNLOCK
+
+            joinThread(id);
+
+            ASSERT(CHILD_THREAD == info.d_firstIn);
+            ASSERTV(X.numContendedLocks(), 1 == X.numContendedLocks());
+            ASSERTV(X.numWaits(),          1 <= X.numWaits());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // GUARD TEST
+        //   Ensure that 'BslAdaptiveLockGuard' works as expected.
+        //
+        // Concerns:
+        //: 1 Following construction, the associated lock is in the locked
+        //:   state.
+        //:
+        //: 2 Following destruction with no prior call to 'release', the
+        //:   associated lock is in the unlocked state.
+        //:
+        //: 3 'release' releases the associated lock from management and
+        //:   leaves the lock locked.
+        //:
+        //: 4 Destruction following a call to 'release' has no effect on the
+        //:   state of the associated lock.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create a lock, 'mX', in the main thread.  Then, within a nested
+        //:   block, create a guard for 'mX', 'mG', and create a child thread
+        //:   that has access to 'mX'.  The child thread, upon acquiring the
+        //:   lock on 'mX', atomically updates a shared "first in" variable if
+        //:   and only if it still has its initial value (0).  Allow the child
+        //:   thread to run for a brief time before letting 'mG' go out of
+        //:   scope.  Verify, at appropriate points, that the "first in"
+        //:   variable has the expected result.  (C-1..2)
+        //:
+        //: 2 Repeat P-1, except call 'release' on 'mG' before allowing it to
+        //:   go out of scope.  Verify that the child thread cannot update the
+        //:   "first in" variable until 'unlock' is called on 'mX' in the main
+        //:   thread.  (C-3..4)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered.  (C-5)
+        //
+        // Testing:
+        //   BslAdaptiveLockGuard::BslAdaptiveLockGuard(BslAdaptiveLock *lock);
+        //   BslAdaptiveLockGuard::~BslAdaptiveLockGuard();
+        //   void BslAdaptiveLockGuard::release();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nGUARD TEST"
+                            "\n==========\n");
+
+        // C-1..2
+        {
+            Obj mX;
+
+            ThreadInfo info;
+            info.d_lock       = &mX;
+            info.d_firstIn    = NO_THREAD;
+            info.d_threadDone = 0;
+
+            ThreadId id;
+
+            {
+                Guard mG(&mX);                                        // LOCK
+
+                id = createThread(&threadFunction, &info);
+
+                pause(&info.d_threadDone);
+                ASSERT(NO_THREAD == info.d_firstIn);
+            }                                                         // UNLOCK
+
+            joinThread(id);
+
+            ASSERT(CHILD_THREAD == info.d_firstIn);
+        }
+
+        // C-3..4
+        {
+            Obj mX;
+
+            ThreadInfo info;
+            info.d_lock       = &mX;
+            info.d_firstIn    = NO_THREAD;
+            info.d_threadDone = 0;
+
+            ThreadId id;
+
+            {
+                Guard mG(&mX);                                        // LOCK
+
+                id = createThread(&threadFunction, &info);
+
+                pause(&info.d_threadDone);
+                ASSERT(NO_THREAD == info.d_firstIn);
+
+                mG.release();
+            }
+
+            pause(&info.d_threadDone);
+            ASSERT(NO_THREAD == info.d_firstIn);
+
+            mX.unlock();                                              // UNLOCK
+
+            joinThread(id);
+
+            ASSERT(CHILD_THREAD == info.d_firstIn);
+        }
+
+        // C-5
+        if (verbose) printf("\nNegative Testing.\n");
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            {
+                Obj mX;
+
+                ASSERT_SAFE_PASS((Guard(&mX)));
+                ASSERT_SAFE_FAIL( Guard(  0));
+            }
+        }
+
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BASIC TEST
+        //   Ensure that 'BslAdaptiveLock' works as expected.
+        //
+        // Concerns:
+        //: 1 Following construction, the lock is in the unlocked state.
+        //:
+        //: 2 'lock' acquires the lock for exclusive access by the calling
+        //:    thread.
+        //:
+        //: 3 'unlock' releases the lock making it available to other threads.
+        //:
+        // Plan:
+        //: 1 Create a lock, 'mX', in the main thread, then create a child
+        //:   thread that has access to 'mX'.  Each of the threads, upon
+        //:   acquiring the lock on 'mX', atomically update a shared "first in"
+        //:   variable if and only if it still has its initial value (0); both
+        //:   threads use the 'lock' method.  Allow the child thread to run for
+        //:   a brief time before locking in the main thread.  After joining
+        //:   with the child thread, verify the "first in" variable has the
+        //:   expected result.  Repeat, except this time lock 'mX' in the main
+        //:   thread *before* creating the child thread.  (C-1..3)
+        //
+        // Testing:
+        //   BslAdaptiveLock::BslAdaptiveLock();
+        //   BslAdaptiveLock::~BslAdaptiveLock();
+        //   void BslAdaptiveLock::lock();
+        //   void BslAdaptiveLock::unlock();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBASIC TEST"
+                            "\n==========\n");
+
+        // C-1..3
+        {
+            Obj mX;
+
+            ThreadInfo info;
+            info.d_lock       = &mX;
+            info.d_firstIn    = NO_THREAD;
+            info.d_threadDone = 0;
+
+            ThreadId id = createThread(&threadFunction, &info);
+
+            pause(&info.d_threadDone);
+
+            mX.lock();                                                // LOCK
+            if (NO_THREAD == info.d_firstIn) {
+                info.d_firstIn = MAIN_THREAD;
+            }
+            mX.unlock();                                              // UNLOCK
+
+            joinThread(id);
+
+            ASSERT(CHILD_THREAD == info.d_firstIn);
+        }
+
+        {
+            Obj mX;
+            mX.lock();                                                // LOCK
+
+            ThreadInfo info;
+            info.d_lock       = &mX;
+            info.d_firstIn    = NO_THREAD;
+            info.d_threadDone = 0;
+
+            ThreadId id = createThread(&threadFunction, &info);
+
+            pause(&info.d_threadDone);
+
+            if (NO_THREAD == info.d_firstIn) {
+                info.d_firstIn = MAIN_THREAD;
+            }
+            mX.unlock();                                              // UNLOCK
+
+            joinThread(id);
+
+            ASSERT(MAIN_THREAD == info.d_firstIn);
+        }
+
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: CONTENDED SHORT CRITICAL SECTIONS
+        //
+        // Concerns:
+        //: 1 Provide a benchmark comparing 'BslAdaptiveLock' with 'BslLock'
+        //:   for threads that repeatedly hold the lock for a few
+        //:   instructions.
+        //
+        // Plan:
+        //: 1 Using 'bsls::Stopwatch', time the increment of a counter guarded
+        //:   by each type of lock, by 1, 2, 4, and 8 threads.  Report the wall
+        //:   time, and the CPU time consumed in the kernel.  The results are
+        //:   meant only for comparison.
+        //
+        // Testing:
+        //   PERFORMANCE: CONTENDED SHORT CRITICAL SECTIONS
+        // --------------------------------------------------------------------
+
+        printf("\nPERFORMANCE: CONTENDED SHORT CRITICAL SECTIONS"
+               "\n==============================================\n");
+
+        const int NUM_ITERATIONS = argc > 2 ? atoi(argv[2]) : 1000000;
+
+        for (int numThreads = 1; numThreads <= 8; numThreads *= 2) {
+            bsls::Stopwatch timer;
+            double          wall, system, user;
+
+            bsls::BslLock mutex;
+
+            timer.start(true);
+            runCounterThreads<bsls::BslLock, bsls::BslLockGuard>(
+                                                               &mutex,
+                                                               numThreads,
+                                                               NUM_ITERATIONS);
+            timer.stop();
+            timer.accumulatedTimes(&system, &user, &wall);
+
+            printf("threads %d: BslLock         wall %6.3fs  system %6.3fs\n",
+                   numThreads, wall, system);
+
+            Obj mX;
+
+            timer.reset();
+            timer.start(true);
+            runCounterThreads<Obj, Guard>(&mX, numThreads, NUM_ITERATIONS);
+            timer.stop();
+            timer.accumulatedTimes(&system, &user, &wall);
+
+            printf("threads %d: BslAdaptiveLock wall %6.3fs  system %6.3fs"
+                   "  (contended %lld, waits %lld)\n",
+                   numThreads, wall, system,
+                   mX.numContendedLocks(), mX.numWaits());
+        }
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -19,6 +19,16 @@ BSLS_IDENT("$Id: $")
 // implements a static bitset class that is suitable for use as an
 // implementation of the 'std::bitset' class template.
 //
+///Storage
+///-------
+// A 'bsl::bitset' of more than 32 bits holds its bits in an array of 64-bit
+// words, and a smaller 'bsl::bitset' in a single 32-bit word.  The bulk
+// operations -- 'count', 'any', the shifts, 'flip', and the bitwise operators
+// -- process a whole word per step, and 'count' uses the population-count
+// instruction of the platform where the compiler provides it.  The loops over
+// the words of two bitsets are simple enough that an optimizing compiler may
+// vectorize them for the target instruction set.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -159,6 +169,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslstl_string.h>
 #endif
 
+#ifndef INCLUDED_BSLMF_CONDITIONAL
+#include <bslmf_conditional.h>
+#endif
+
 #ifndef INCLUDED_BSLS_ASSERT
 #include <bsls_assert.h>
 #endif
@@ -175,6 +189,10 @@ BSL_OVERRIDES_STD mode"
 #include <bsls_platform.h>
 #endif
 
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
 #ifndef INCLUDED_ALGORITHM
 #include <algorithm>    // 'min'
 #define INCLUDED_ALGORITHM
@@ -225,15 +243,24 @@ class bitset {
     // 'bsl::basic_string', in addition to a 'std::basic_string'.
 
     // PRIVATE TYPES
+    typedef typename bsl::conditional<N <= 8 * sizeof(unsigned int),
+                                      unsigned int,
+                                      BloombergLP::bsls::Types::Uint64>::type
+                                                                      WordType;
+        // Type of the words holding the bits of this bitset.  A bitset of
+        // more than 32 bits is held in 64-bit words, so that the bulk
+        // operations ('count', the shifts, and the bitwise operators) process
+        // 64 bits per step; smaller bitsets retain their 32-bit footprint.
+
     enum {
-        BYTESPERINT = sizeof(int),
-        BITSPERINT  = 8 * sizeof(int),
-        BITSETSIZE  = N ? (N - 1) / BITSPERINT + 1 : 1
+        BYTESPERWORD = sizeof(WordType),
+        BITSPERWORD  = 8 * sizeof(WordType),
+        BITSETSIZE   = N ? (N - 1) / BITSPERWORD + 1 : 1
     };
 
     // DATA
-    unsigned int d_data[BITSETSIZE];  // storage for bitset, d_data[0] holds
-                                      // the least significant bit.
+    WordType d_data[BITSETSIZE];  // storage for bitset, d_data[0] holds the
+                                  // least significant bit.
 
     // FRIENDS
     friend class reference;
@@ -248,11 +275,11 @@ class bitset {
         friend class bitset;
 
         // DATA
-        unsigned int *d_int_p;   // pointer to the int inside the bitset.
-        unsigned int  d_offset;  // bit offset to 'd_int'.
+        WordType     *d_word_p;  // pointer to the word inside the bitset.
+        unsigned int  d_offset;  // bit offset to 'd_word_p'.
 
         // PRIVATE CREATORS
-        reference(unsigned int *i, unsigned int offset);
+        reference(WordType *word, unsigned int offset);
 
       public:
         // MANIPULATORS
@@ -294,15 +321,19 @@ class bitset {
 
     void clearUnusedBits();
         // Clear the bits unused by the bitset in 'd_data', namely, bits
-        // 'BITSETSIZE * BITSPERINT - 1' to N (where bit count starts at 0).
+        // 'BITSETSIZE * BITSPERWORD - 1' to N (where bit count starts at 0).
 
     void clearUnusedBits(bsl::false_type);
     void clearUnusedBits(bsl::true_type);
         // Implementations of 'clearUnusedBits', overloaded by whether there
         // are any unused bits.
 
+    // PRIVATE CLASS METHODS
+    static WordType bitMask(std::size_t offset);
+        // Return a word having only the bit at the specified 'offset' set.
+
     // PRIVATE ACCESSORS
-    std::size_t numOneSet(unsigned int src) const;
+    std::size_t numOneSet(WordType src) const;
         // Return the number of 1 bits in the specified 'src'.
 
   public:
@@ -508,11 +539,11 @@ operator<<(std::basic_ostream<CHAR_TYPE, TRAITS>& os, const bitset<N>& x);
 // PRIVATE CREATORS
 template <std::size_t N>
 inline
-bitset<N>::reference::reference(unsigned int *i, unsigned int offset)
-: d_int_p(i)
+bitset<N>::reference::reference(WordType *word, unsigned int offset)
+: d_word_p(word)
 , d_offset(offset)
 {
-    BSLS_ASSERT_SAFE(d_int_p);
+    BSLS_ASSERT_SAFE(d_word_p);
 }
 
 // MANIPULATORS
@@ -522,10 +553,10 @@ typename bitset<N>::reference&
 bitset<N>::reference::operator=(bool x)
 {
     if (x) {
-        *d_int_p |= (1 << d_offset);
+        *d_word_p |= bitMask(d_offset);
     }
     else {
-        *d_int_p &= ~(1 << d_offset);
+        *d_word_p &= ~bitMask(d_offset);
     }
     return *this;
 }
@@ -536,10 +567,10 @@ typename bitset<N>::reference&
 bitset<N>::reference::operator=(const reference& x)
 {
     if (x) {
-        *d_int_p |= (1 << d_offset);
+        *d_word_p |= bitMask(d_offset);
     }
     else {
-        *d_int_p &= ~(1 << d_offset);
+        *d_word_p &= ~bitMask(d_offset);
     }
     return *this;
 }
@@ -549,7 +580,7 @@ inline
 typename bitset<N>::reference&
 bitset<N>::reference::flip()
 {
-    *d_int_p ^= (1 << d_offset);
+    *d_word_p ^= bitMask(d_offset);
     return *this;
 }
 
@@ -558,14 +589,14 @@ template <std::size_t N>
 inline
 bitset<N>::reference::operator bool() const
 {
-    return ((*d_int_p & (1 << d_offset)) != 0);
+    return ((*d_word_p & bitMask(d_offset)) != 0);
 }
 
 template <std::size_t N>
 inline
 bool bitset<N>::reference::operator~() const
 {
-    return ((*d_int_p & (1 << d_offset)) == 0);
+    return ((*d_word_p & bitMask(d_offset)) == 0);
 }
 
                         // ------------
@@ -641,7 +672,7 @@ template <std::size_t N>
 inline
 void bitset<N>::clearUnusedBits()
 {
-    enum { VALUE = N % BITSPERINT ? 1 : 0 };
+    enum { VALUE = N % BITSPERWORD ? 1 : 0 };
 
     clearUnusedBits(bsl::integral_constant<bool, VALUE>());
 }
@@ -656,26 +687,48 @@ template <std::size_t N>
 inline
 void bitset<N>::clearUnusedBits(bsl::true_type)
 {
-    const unsigned int offset = N % BITSPERINT;  // never 0
+    const unsigned int offset = N % BITSPERWORD;  // never 0
 
-    d_data[BITSETSIZE - 1] &= ~(~((unsigned int)0) << offset);
+    d_data[BITSETSIZE - 1] &= ~(~static_cast<WordType>(0) << offset);
 }
 
+// PRIVATE CLASS METHODS
 template <std::size_t N>
-std::size_t bitset<N>::numOneSet(unsigned int src) const
+inline
+typename bitset<N>::WordType bitset<N>::bitMask(std::size_t offset)
 {
-    // The following code was taken from 'bdes_bitutil'.
-    unsigned input = src;
+    BSLS_ASSERT_SAFE(offset < BITSPERWORD);
+
+    return static_cast<WordType>(1) << offset;
+}
+
+// PRIVATE ACCESSORS
+template <std::size_t N>
+inline
+std::size_t bitset<N>::numOneSet(WordType src) const
+{
+#if defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+    return 4 == BYTESPERWORD
+           ? __builtin_popcount(static_cast<unsigned int>(src))
+           : __builtin_popcountll(src);
+#else
+    // The following code was taken from 'bdes_bitutil', and generalized to
+    // words of 32 and 64 bits.  The masks '0x5555...', '0x3333...', and
+    // '0x0f0f...' are computed by dividing the all-ones word by 3, 5, and 17,
+    // respectively.
+
+    const WordType ones  = ~static_cast<WordType>(0);
+    WordType       input = src;
 
     // First we use a tricky way of getting every 2-bit half-nibble to
     // represent the number of bits that were set in those two bits.
 
-    input -= (input >> 1) & 0x55555555;
+    input -= (input >> 1) & (ones / 3);
 
     // Henceforth, we just accumulate the sum down into lower and lower bits.
 
     {
-        const int mask = 0x33333333;
+        const WordType mask = ones / 5;
         input = ((input >> 2) & mask) + (input & mask);
     }
 
@@ -683,17 +736,19 @@ std::size_t bitset<N>::numOneSet(unsigned int src) const
     // do not have to mask both sides of the addition.  We must mask after the
     // addition, so 8-bit bytes are the sum of bits in those 8 bits.
 
-    input = ((input >> 4) + input) & 0x0f0f0f0f;
+    input = ((input >> 4) + input) & (ones / 17);
 
     // It is no longer necessary to mask the additions, because it is
     // impossible for any bit groups to add up to more than 256 and carry, thus
     // interfering with adjacent groups.  Each 8-bit byte is independent from
     // now on.
 
-    input = (input >>  8) + input;
-    input = (input >> 16) + input;
+    for (std::size_t shift = 8; shift < BITSPERWORD; shift *= 2) {
+        input = (input >> shift) + input;
+    }
 
-    return input & 0x000000ff;
+    return static_cast<std::size_t>(input & 0xff);
+#endif
 }
 
 // CREATORS
@@ -701,31 +756,34 @@ template <std::size_t N>
 inline
 bitset<N>::bitset()
 {
-    std::memset(d_data, 0, BITSETSIZE * BYTESPERINT);
+    std::memset(d_data, 0, BITSETSIZE * BYTESPERWORD);
 }
 
 template <std::size_t N>
 bitset<N>::bitset(unsigned long val)
 {
     enum {
-        BSLSTL_INTS_IN_LONG = sizeof(unsigned long) / sizeof(int)
+        BSLSTL_WORDS_IN_LONG = sizeof(unsigned long) > sizeof(WordType)
+                             ? sizeof(unsigned long) / sizeof(WordType)
+                             : 1
     };
 
-    std::memset(d_data, 0, BITSETSIZE * BYTESPERINT);
+    std::memset(d_data, 0, BITSETSIZE * BYTESPERWORD);
 
-    if (1 == BSLSTL_INTS_IN_LONG) {
-        d_data[0] = static_cast<unsigned int>(val);
+    if (1 == BSLSTL_WORDS_IN_LONG) {
+        d_data[0] = static_cast<WordType>(val);
     }
     else {
-        const unsigned int numInts = (unsigned int) BSLSTL_INTS_IN_LONG
+        const unsigned int numWords = (unsigned int) BSLSTL_WORDS_IN_LONG
                                                     < (unsigned int) BITSETSIZE
-                                     ? (unsigned int) BSLSTL_INTS_IN_LONG
-                                     : (unsigned int) BITSETSIZE;
+                                      ? (unsigned int) BSLSTL_WORDS_IN_LONG
+                                      : (unsigned int) BITSETSIZE;
 
-        for (unsigned int i = 0; i < numInts; ++i) {
-            d_data[i] = static_cast<unsigned int>(val >> (BITSPERINT * i));
+        for (unsigned int i = 0; i < numWords; ++i) {
+            d_data[i] = static_cast<WordType>(val >> (BITSPERWORD * i));
         }
     }
+    clearUnusedBits();
 }
 
 template <std::size_t N>
@@ -744,7 +802,7 @@ bitset(const    native_std::basic_string<CHAR_TYPE, TRAITS, ALLOCATOR>& str,
                                                "'pos > str.size()' for bitset "
                                                "constructor");
     }
-    std::memset(d_data, 0, BITSETSIZE * BYTESPERINT);
+    std::memset(d_data, 0, BITSETSIZE * BYTESPERWORD);
     copyString(str, pos, StringType::npos);
 }
 
@@ -764,7 +822,7 @@ bitset(const    native_std::basic_string<CHAR_TYPE, TRAITS, ALLOCATOR>& str,
                                                "'pos > str.size()' for bitset "
                                                "constructor");
     }
-    std::memset(d_data, 0, BITSETSIZE * BYTESPERINT);
+    std::memset(d_data, 0, BITSETSIZE * BYTESPERWORD);
     copyString(str, pos, n);
 }
 
@@ -784,7 +842,7 @@ bitset(const    bsl::basic_string<CHAR_TYPE, TRAITS, ALLOCATOR>& str,
                                                "'pos > str.size()' for bitset "
                                                "constructor");
     }
-    std::memset(d_data, 0, BITSETSIZE * BYTESPERINT);
+    std::memset(d_data, 0, BITSETSIZE * BYTESPERWORD);
     copyString(str, pos, StringType::npos);
 }
 
@@ -805,7 +863,7 @@ bitset(const    bsl::basic_string<CHAR_TYPE, TRAITS, ALLOCATOR>& str,
                                                "'pos > str.size()' for bitset "
                                                "constructor");
     }
-    std::memset(d_data, 0, BITSETSIZE * BYTESPERINT);
+    std::memset(d_data, 0, BITSETSIZE * BYTESPERWORD);
     copyString(str, pos, n);
 }
 
@@ -843,20 +901,20 @@ bitset<N>& bitset<N>::operator<<=(std::size_t pos)
     BSLS_ASSERT_SAFE(pos <= N);
 
     if (pos) {
-        const std::size_t shift  = pos / BITSPERINT;
-        const std::size_t offset = pos % BITSPERINT;
+        const std::size_t shift  = pos / BITSPERWORD;
+        const std::size_t offset = pos % BITSPERWORD;
 
         if (shift) {
             std::memmove(d_data + shift,
                          d_data,
-                         (BITSETSIZE - shift) * BYTESPERINT);
-            std::memset(d_data, 0, shift * BYTESPERINT);
+                         (BITSETSIZE - shift) * BYTESPERWORD);
+            std::memset(d_data, 0, shift * BYTESPERWORD);
         }
 
         if (offset) {
             for (std::size_t i = BITSETSIZE - 1; i > shift; --i) {
                 d_data[i] = (d_data[i] << offset) |
-                                        (d_data[i-1] >> (BITSPERINT - offset));
+                                       (d_data[i-1] >> (BITSPERWORD - offset));
             }
             d_data[shift] <<= offset;
         }
@@ -872,20 +930,20 @@ bitset<N>& bitset<N>::operator>>=(std::size_t pos)
     BSLS_ASSERT_SAFE(pos <= N);
 
     if (pos) {
-        const std::size_t shift  = pos / BITSPERINT;
-        const std::size_t offset = pos % BITSPERINT;
+        const std::size_t shift  = pos / BITSPERWORD;
+        const std::size_t offset = pos % BITSPERWORD;
 
         if (shift) {
             std::memmove(d_data,
                          d_data + shift,
-                         (BITSETSIZE - shift) * BYTESPERINT);
-            std::memset(d_data + BITSETSIZE - shift, 0, shift * BYTESPERINT);
+                         (BITSETSIZE - shift) * BYTESPERWORD);
+            std::memset(d_data + BITSETSIZE - shift, 0, shift * BYTESPERWORD);
         }
 
         if (offset) {
             for (std::size_t i = 0; i < BITSETSIZE - shift - 1; ++i) {
                 d_data[i] = (d_data[i] >> offset) |
-                                        (d_data[i+1] << (BITSPERINT - offset));
+                                       (d_data[i+1] << (BITSPERWORD - offset));
             }
             d_data[BITSETSIZE - shift - 1] >>= offset;
         }
@@ -911,9 +969,9 @@ bitset<N>& bitset<N>::flip(std::size_t pos)
 {
     BSLS_ASSERT_SAFE(pos < N);
 
-    const std::size_t shift  = pos / BITSPERINT;
-    const std::size_t offset = pos % BITSPERINT;
-    d_data[shift] ^= (1 << offset);
+    const std::size_t shift  = pos / BITSPERWORD;
+    const std::size_t offset = pos % BITSPERWORD;
+    d_data[shift] ^= bitMask(offset);
     return *this;
 }
 
@@ -921,7 +979,7 @@ template <std::size_t N>
 inline
 bitset<N>& bitset<N>::reset()
 {
-    std::memset(d_data, 0, BITSETSIZE * BYTESPERINT);
+    std::memset(d_data, 0, BITSETSIZE * BYTESPERWORD);
     return *this;
 }
 
@@ -931,9 +989,9 @@ bitset<N>& bitset<N>::reset(std::size_t pos)
 {
     BSLS_ASSERT_SAFE(pos < N);
 
-    const std::size_t shift  = pos / BITSPERINT;
-    const std::size_t offset = pos % BITSPERINT;
-    d_data[shift] &= ~(1 << offset);
+    const std::size_t shift  = pos / BITSPERWORD;
+    const std::size_t offset = pos % BITSPERWORD;
+    d_data[shift] &= ~bitMask(offset);
     return *this;
 }
 
@@ -941,7 +999,7 @@ template <std::size_t N>
 inline
 bitset<N>& bitset<N>::set()
 {
-    std::memset(d_data, 0xFF, BITSETSIZE * BYTESPERINT);
+    std::memset(d_data, 0xFF, BITSETSIZE * BYTESPERWORD);
     clearUnusedBits();
     return *this;
 }
@@ -951,13 +1009,13 @@ bitset<N>& bitset<N>::set(std::size_t pos, int val)
 {
     BSLS_ASSERT_SAFE(pos < N);
 
-    const std::size_t shift  = pos / BITSPERINT;
-    const std::size_t offset = pos % BITSPERINT;
+    const std::size_t shift  = pos / BITSPERWORD;
+    const std::size_t offset = pos % BITSPERWORD;
     if (val) {
-        d_data[shift] |= (1 << offset);
+        d_data[shift] |= bitMask(offset);
     }
     else {
-        d_data[shift] &= ~(1 << offset);
+        d_data[shift] &= ~bitMask(offset);
     }
     return *this;
 }
@@ -968,8 +1026,8 @@ typename bitset<N>::reference bitset<N>::operator[](std::size_t pos)
 {
     BSLS_ASSERT_SAFE(pos < N);
 
-    const std::size_t shift  = pos / BITSPERINT;
-    const std::size_t offset = pos % BITSPERINT;
+    const std::size_t shift  = pos / BITSPERWORD;
+    const std::size_t offset = pos % BITSPERWORD;
     return typename bitset<N>::reference(&d_data[shift],
                                          static_cast<unsigned int>(offset));
 }
@@ -1009,16 +1067,16 @@ bool bitset<N>::operator[](std::size_t pos) const
 {
     BSLS_ASSERT_SAFE(pos < N);
 
-    const std::size_t shift  = pos / BITSPERINT;
-    const std::size_t offset = pos % BITSPERINT;
-    return ((d_data[shift] & (1 << offset)) != 0);
+    const std::size_t shift  = pos / BITSPERWORD;
+    const std::size_t offset = pos % BITSPERWORD;
+    return ((d_data[shift] & bitMask(offset)) != 0);
 }
 
 template <std::size_t N>
 inline
 bool bitset<N>::operator==(const bitset& rhs) const
 {
-    return std::memcmp(d_data, rhs.d_data, BITSETSIZE * BYTESPERINT) == 0;
+    return std::memcmp(d_data, rhs.d_data, BITSETSIZE * BYTESPERWORD) == 0;
 }
 
 template <std::size_t N>
@@ -1093,10 +1151,24 @@ template <std::size_t N>
 unsigned long bitset<N>::to_ulong() const
 {
     enum {
-        BSLSTL_INTS_IN_LONG = sizeof(unsigned long) / sizeof(int)
+        BSLSTL_WORDS_IN_LONG = sizeof(unsigned long) > sizeof(WordType)
+                             ? sizeof(unsigned long) / sizeof(WordType)
+                             : 1
     };
 
-    for (std::size_t i = BSLSTL_INTS_IN_LONG; i < BITSETSIZE; ++i) {
+    // The bits of the first word that cannot be represented by an 'unsigned
+    // long' (none, unless a word is wider than an 'unsigned long').
+
+    const WordType highBits =
+                       ~static_cast<WordType>(~static_cast<unsigned long>(0));
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_data[0] & highBits)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        BloombergLP::bslstl::StdExceptUtil::throwOverflowError(
+                                        "overflow in bsl::bitset<>::to_ulong");
+    }
+
+    for (std::size_t i = BSLSTL_WORDS_IN_LONG; i < BITSETSIZE; ++i) {
         if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_data[i])) {
             BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
             BloombergLP::bslstl::StdExceptUtil::throwOverflowError(
@@ -1104,14 +1176,14 @@ unsigned long bitset<N>::to_ulong() const
         }
     }
 
-    unsigned long      value   = 0;
-    const unsigned int numInts = (unsigned int) BSLSTL_INTS_IN_LONG
+    unsigned long      value    = 0;
+    const unsigned int numWords = (unsigned int) BSLSTL_WORDS_IN_LONG
                                                     < (unsigned int) BITSETSIZE
-                               ? (unsigned int) BSLSTL_INTS_IN_LONG
-                               : (unsigned int) BITSETSIZE;
+                                ? (unsigned int) BSLSTL_WORDS_IN_LONG
+                                : (unsigned int) BITSETSIZE;
 
-    for (unsigned int i = 0; i < numInts; ++i) {
-        value |= (unsigned long) d_data[i] << (BITSPERINT * i);
+    for (unsigned int i = 0; i < numWords; ++i) {
+        value |= static_cast<unsigned long>(d_data[i]) << (BITSPERWORD * i);
     }
     return value;
 }
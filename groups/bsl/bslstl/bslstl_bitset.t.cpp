@@ -99,7 +99,8 @@ using namespace std;
 // [  ] operator<<(std::ostream &os, const bitset<N>& x)
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [12] USAGE EXAMPLE
+// [13] USAGE EXAMPLE
+// [12] CONCERN: Bulk operations are correct across word boundaries.
 //-----------------------------------------------------------------------------
 
 //==========================================================================
@@ -285,6 +286,110 @@ void testCase3(int verbose, int veryVerbose, int /* veryVeryVerbose */)
     }
 }
 
+bool patternBit(size_t index, unsigned int seed)
+    // Return the value of the bit at the specified 'index' of an irregular
+    // pattern of bits identified by the specified 'seed'.
+{
+    const unsigned int hash = static_cast<unsigned int>(index) * 2654435761u
+                            + seed * 40503u;
+    return (hash >> 13) & 1;
+}
+
+template <size_t TESTSIZE>
+void testCase12(int verbose, int veryVerbose, int /* veryVeryVerbose */)
+{
+    if (verbose) cout << "\tCheck bitset<" << TESTSIZE << ">" << endl;
+
+    typedef bsl::bitset<TESTSIZE> Obj;
+
+    for (unsigned int seedA = 0; seedA < 4; ++seedA) {
+    for (unsigned int seedB = 0; seedB < 4; ++seedB) {
+        if (veryVerbose) {
+            T_ P_(seedA) P(seedB);
+        }
+
+        Obj mA;  const Obj& A = mA;
+        Obj mB;  const Obj& B = mB;
+
+        size_t expectedCount = 0;
+        for (size_t i = 0; i < TESTSIZE; ++i) {
+            mA.set(i, patternBit(i, seedA));
+            mB.set(i, patternBit(i, seedB));
+            expectedCount += patternBit(i, seedA);
+        }
+
+        LOOP2_ASSERT(seedA, A.count(), expectedCount == A.count());
+        LOOP2_ASSERT(seedA, seedB, (0 != expectedCount) == A.any());
+
+        const Obj AND = A & B;
+        const Obj OR  = A | B;
+        const Obj XOR = A ^ B;
+        const Obj NOT = ~A;
+
+        size_t andCount = 0, orCount = 0, xorCount = 0;
+        for (size_t i = 0; i < TESTSIZE; ++i) {
+            const bool a = patternBit(i, seedA);
+            const bool b = patternBit(i, seedB);
+
+            LOOP3_ASSERT(seedA, seedB, i, (a && b) == AND[i]);
+            LOOP3_ASSERT(seedA, seedB, i, (a || b) == OR[i]);
+            LOOP3_ASSERT(seedA, seedB, i, (a != b) == XOR[i]);
+            LOOP3_ASSERT(seedA, seedB, i, !a       == NOT[i]);
+
+            andCount += a && b;
+            orCount  += a || b;
+            xorCount += a != b;
+        }
+
+        LOOP2_ASSERT(seedA, seedB, andCount == AND.count());
+        LOOP2_ASSERT(seedA, seedB, orCount  == OR.count());
+        LOOP2_ASSERT(seedA, seedB, xorCount == XOR.count());
+        LOOP2_ASSERT(seedA, seedB, TESTSIZE - expectedCount == NOT.count());
+
+        // Shift by every distance, and verify against the pattern.
+
+        for (size_t pos = 0; pos <= TESTSIZE; ++pos) {
+            const Obj L = A << pos;
+            const Obj R = A >> pos;
+
+            for (size_t i = 0; i < TESTSIZE; ++i) {
+                const bool lExp = i >= pos && patternBit(i - pos, seedA);
+                const bool rExp = i + pos < TESTSIZE
+                               && patternBit(i + pos, seedA);
+
+                LOOP3_ASSERT(seedA, pos, i, lExp == L[i]);
+                LOOP3_ASSERT(seedA, pos, i, rExp == R[i]);
+            }
+        }
+    }
+    }
+
+    // Verify that unused bits of the highest word never become set.
+
+    Obj mX;  const Obj& X = mX;
+    mX.set();
+    LOOP_ASSERT(X.count(), TESTSIZE == X.count());
+
+    mX <<= 1;
+    mX.flip();
+    LOOP_ASSERT(X.count(), 1 == X.count());
+
+    const size_t BITS_IN_LONG = sizeof(unsigned long) * CHAR_BIT;
+    const size_t NUM_BITS     = TESTSIZE < BITS_IN_LONG ? TESTSIZE
+                                                        : BITS_IN_LONG;
+
+    unsigned long expected = 0;
+    for (size_t i = 0; i < NUM_BITS; ++i) {
+        expected |= 1ul << i;
+    }
+
+    mX = Obj(~0ul);
+    LOOP_ASSERT(X.count(), NUM_BITS == X.count());
+    if (TESTSIZE <= BITS_IN_LONG) {
+        LOOP_ASSERT(X.to_ulong(), expected == X.to_ulong());
+    }
+}
+
 } // close unnamed namespace
 
 //=============================================================================
@@ -397,7 +502,7 @@ int main(int argc, char *argv[])
 
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
     switch (test) { case 0:  // zero is always the leading case
-    case 12: {
+    case 13: {
       // --------------------------------------------------------------------
       // USAGE EXAMPLE TEST
       //
@@ -425,6 +530,45 @@ int main(int argc, char *argv[])
       //..
     } break;
 
+    case 12: {
+      // --------------------------------------------------------------------
+      // BULK OPERATIONS TEST
+      //
+      // Concerns:
+      //   1. That 'count', the bitwise operators, 'flip', and the shifts are
+      //      correct for bitsets stored in one or more 32-bit or 64-bit
+      //      words, including bitsets whose size is not a multiple of the
+      //      word size.
+      //
+      //   2. That the bits of the highest word beyond the size of the bitset
+      //      are never set, so that 'count' and 'to_ulong' are correct.
+      //
+      // Plan:
+      //   For bitsets of sizes around each word boundary, load irregular
+      //   patterns of bits, and verify the result of each bulk operation
+      //   against the result of the same operation applied to each bit.
+      //   Shift by every distance from 0 to the size of the bitset.  Set and
+      //   flip all bits, and construct from '~0ul', and verify 'count'.
+      //
+      // Testing:
+      //   CONCERN: Bulk operations are correct across word boundaries.
+      // --------------------------------------------------------------------
+
+      if (verbose) cout << endl
+                        << "BULK OPERATIONS TEST" << endl
+                        << "====================" << endl;
+
+      testCase12<1>(verbose, veryVerbose, veryVeryVerbose);
+      testCase12<31>(verbose, veryVerbose, veryVeryVerbose);
+      testCase12<32>(verbose, veryVerbose, veryVeryVerbose);
+      testCase12<33>(verbose, veryVerbose, veryVeryVerbose);
+      testCase12<63>(verbose, veryVerbose, veryVeryVerbose);
+      testCase12<64>(verbose, veryVerbose, veryVeryVerbose);
+      testCase12<65>(verbose, veryVerbose, veryVeryVerbose);
+      testCase12<128>(verbose, veryVerbose, veryVeryVerbose);
+      testCase12<200>(verbose, veryVerbose, veryVeryVerbose);
+    } break;
+
     case 11: {
       // --------------------------------------------------------------------
       // SHIFT OPERATOR TEST
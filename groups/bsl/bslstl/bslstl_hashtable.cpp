@@ -42,10 +42,12 @@ bslalg::HashTableBucket *HashTable_ImpDetails::defaultBucketAddress()
     return &s_bucket;
 }
 
-size_t HashTable_ImpDetails::growBucketsForLoadFactor(size_t *capacity,
-                                                      size_t  minElements,
-                                                      size_t  requestedBuckets,
-                                                      double  maxLoadFactor)
+size_t HashTable_ImpDetails::growBucketsForLoadFactor(
+                  size_t                                     *capacity,
+                  size_t                                      minElements,
+                  size_t                                      requestedBuckets,
+                  double                                      maxLoadFactor,
+                  bslalg::HashTableAnchor::BucketIndexPolicy  policy)
 {
     BSLS_ASSERT_SAFE(  0 != capacity);
     BSLS_ASSERT_SAFE(  0  < minElements);
@@ -105,12 +107,17 @@ size_t HashTable_ImpDetails::growBucketsForLoadFactor(size_t *capacity,
        requestedBuckets,
        Impl::throwIfOverMax(static_cast<double>(minElements) / maxLoadFactor));
 
-    result = nextPrime(result);  // throws if too large
+    const bool isPowerOfTwo =
+                      bslalg::HashTableAnchor::e_MIXED_POWER_OF_TWO == policy;
+
+    result = isPowerOfTwo ? nextPowerOfTwo(result)    // throws if too large
+                          : nextPrime(result);        // throws if too large
 
     double newCapacity = static_cast<double>(result) * maxLoadFactor;
 
     while (minElements > newCapacity ) {
-        result  = nextPrime(2 * result);  // throws if too large
+        result  = isPowerOfTwo ? nextPowerOfTwo(2 * result)
+                               : nextPrime(2 * result);  // throws if too large
         newCapacity = static_cast<double>(result) * maxLoadFactor;
     }
 
@@ -161,6 +168,26 @@ size_t HashTable_ImpDetails::nextPrime(size_t n)
     return *result;
 }
 
+size_t HashTable_ImpDetails::nextPowerOfTwo(size_t n)
+{
+    // Note that 'n' is 0 if the doubling of the largest power of two in
+    // 'growBucketsForLoadFactor' wrapped around.
+
+    static const size_t k_MAX_POWER = ~(~static_cast<size_t>(0) >> 1);
+
+    if (0 == n || k_MAX_POWER < n) {
+        StdExceptUtil::throwLengthError(
+                                       "HashTable ran out of powers of two.");
+    }
+
+    size_t result = 2;
+    while (result < n) {
+        result <<= 1;
+    }
+
+    return result;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 // ----------------------------------------------------------------------------
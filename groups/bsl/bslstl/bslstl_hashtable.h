@@ -11,6 +11,7 @@ BSLS_IDENT("$Id: $")
 //
 //@CLASSES:
 //   bslstl::HashTable : hashed-table container for user-supplied object types
+//   bslstl::HashTableUsesPowerOfTwoBuckets: trait selecting a bucket policy
 //
 //@SEE_ALSO: bsl+stdhdrs
 //
@@ -124,6 +125,80 @@ BSLS_IDENT("$Id: $")
 // basic exception guarantee.  There are similar concerns for the 'COMPARATOR'
 // predicate.
 //
+///Bucket Index Policy
+///-------------------
+// By default, the number of buckets in a 'HashTable' is a prime number, and
+// the index of the bucket holding an element is its hash code modulo the
+// number of buckets (computed by multiplying by a reciprocal cached in the
+// anchor of the table, rather than by a division; see
+// 'bslalg_hashtableimputil').  A prime number of buckets disperses hash codes
+// having regular patterns (e.g., multiples of the alignment of an object)
+// across the buckets.
+//
+// If the trait 'bslstl::HashTableUsesPowerOfTwoBuckets' is 'true' for the
+// (template parameter) type 'HASHER', then the number of buckets is instead a
+// power of two, and the index of the bucket holding an element is computed
+// from the high-order bits of the product of its hash code and an odd
+// constant.  This multiplication is cheaper than the reduction modulo a
+// prime, and mixes the bits of weak hash codes, such as those produced by
+// 'bsl::hash' for integral types (the identity function), so that they are
+// well dispersed across the buckets.  The trait may be associated with a hash
+// functor using the 'BSLMF_NESTED_TRAIT_DECLARATION' macro:
+//..
+//  struct MyIdentityHash {
+//      // TRAITS
+//      BSLMF_NESTED_TRAIT_DECLARATION(MyIdentityHash,
+//                                     bslstl::HashTableUsesPowerOfTwoBuckets);
+//
+//      // ACCESSORS
+//      native_std::size_t operator()(int value) const { return value; }
+//  };
+//..
+// or, for a hash functor that cannot be modified (such as 'bsl::hash<int>'),
+// by specializing the trait in the 'BloombergLP::bslstl' namespace:
+//..
+//  namespace BloombergLP {
+//  namespace bslstl {
+//
+//  template <>
+//  struct HashTableUsesPowerOfTwoBuckets<bsl::hash<int> > : bsl::true_type {
+//  };
+//
+//  }  // close package namespace
+//  }  // close enterprise namespace
+//..
+// Note that the trait affects only the number of buckets, and the assignment
+// of elements to them; it does not affect the value or observable behavior of
+// a 'HashTable'.
+//
+///Incremental Growth
+///------------------
+// A 'HashTable' grows by re-indexing all of its elements into a larger bucket
+// array when an insertion would exceed its maximum load factor.  The cost of
+// that insertion is therefore proportional to the number of elements in the
+// table, which, for a large table, may be unacceptable to a latency-sensitive
+// client, even though the cost amortized over all insertions is constant.
+//
+// A 'HashTable' having a power-of-two number of buckets (see
+// {Bucket Index Policy}) of at least 'k_INCREMENTAL_GROWTH_MIN_BUCKETS'
+// instead grows incrementally.  Each bucket of a larger power-of-two bucket
+// array holds the elements of at most one bucket of the smaller array, so the
+// elements of the table can be indexed into the larger array one bucket at a
+// time, while the smaller array continues to index every element.  Once the
+// table holds half as many elements as would require it to grow, each
+// insertion first indexes a few buckets of the current array into a new array
+// (enough to finish before the table must grow), and the insertion that
+// indexes the last bucket replaces the current array with the new array.  The
+// cost of each insertion is therefore bounded by a small multiple of the cost
+// of indexing one bucket, rather than by the size of the table.
+//
+// Incremental growth is not observable, except by the timing of the change in
+// the number of buckets (which happens no later than it would otherwise), and
+// by the (unspecified) order of the elements of the table.  Operations that
+// explicitly change the number of buckets (e.g., 'rehashForNumBuckets' or
+// 'setMaxLoadFactor'), and 'removeAll', discard any incremental growth in
+// progress.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.  The
@@ -1511,6 +1586,14 @@ BSLS_IDENT("$Id: $")
 #include <bslmf_conditional.h>
 #endif
 
+#ifndef INCLUDED_BSLMF_DETECTNESTEDTRAIT
+#include <bslmf_detectnestedtrait.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_INTEGRALCONSTANT
+#include <bslmf_integralconstant.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
 #include <bslmf_isbitwisemoveable.h>
 #endif
@@ -1852,6 +1935,26 @@ void swap(HashTable_ComparatorWrapper<FUNCTOR> &lhs,
     // Swap the functor wrapped by the specified 'lhs' object with the functor
     // wrapped by the specified 'rhs' object.
 
+                  // =====================================
+                  // struct HashTableUsesPowerOfTwoBuckets
+                  // =====================================
+
+template <class HASHER>
+struct HashTableUsesPowerOfTwoBuckets
+    : bsl::integral_constant<bool,
+                             bslmf::DetectNestedTrait<
+                                  HASHER,
+                                  HashTableUsesPowerOfTwoBuckets>::value> {
+    // This trait 'struct' is a metafunction that determines whether a
+    // 'HashTable' using the (template parameter) type 'HASHER' as its hash
+    // functor has a power-of-two number of buckets, indexed by the mixed
+    // high-order bits of hash codes, rather than a prime number of buckets,
+    // indexed by hash codes modulo that number (see {Bucket Index Policy}).
+    // This trait is 'true' if 'HASHER' declares it using the
+    // 'BSLMF_NESTED_TRAIT_DECLARATION' macro, or if it is specialized for
+    // 'HASHER', and 'false' otherwise.
+};
+
                            // ===============
                            // class HashTable
                            // ===============
@@ -1931,8 +2034,71 @@ class HashTable {
                                          // 'd_maxLoadFactor')
     float               d_maxLoadFactor; // maximum permitted load factor
 
+    bslalg::HashTableAnchor
+                        d_growthAnchor;  // bucket array into which elements
+                                         // are being incrementally indexed,
+                                         // if any, or an anchor having no
+                                         // buckets otherwise
+
+    SizeType            d_growthCursor;  // number of buckets of 'd_anchor'
+                                         // indexed into 'd_growthAnchor'
+
+    SizeType            d_growthCapacity;
+                                         // value of 'd_capacity' once
+                                         // 'd_growthAnchor' replaces
+                                         // 'd_anchor'
+
+  public:
+    // CONSTANTS
+    enum {
+        k_INCREMENTAL_GROWTH_MIN_BUCKETS = 1024
+                        // minimum number of buckets of a table that grows
+                        // incrementally (see {Incremental Growth})
+    };
+
   private:
     // PRIVATE MANIPULATORS
+    void abandonGrowth();
+        // Discard any incremental growth of this object in progress,
+        // deallocating the bucket array into which elements were being
+        // indexed.  Note that the elements of this object remain indexed by
+        // its current bucket array.
+
+    void completeGrowth();
+        // Replace the bucket array of this object with the bucket array into
+        // which its elements have been incrementally indexed.  The behavior
+        // is undefined unless every bucket of this object has been indexed
+        // into the new bucket array.
+
+    void growIncrementally();
+        // If this object grows incrementally (see {Incremental Growth}), and
+        // holds at least half as many elements as would require it to grow,
+        // index enough of its buckets into a larger bucket array (allocated,
+        // if necessary) that the remaining buckets can be indexed, at the same
+        // rate, before an insertion exceeds the maximum load factor, and, if
+        // every bucket has been indexed, replace the bucket array of this
+        // object with the larger array.  If the hash functor throws an
+        // exception, the incremental growth is abandoned, and this object is
+        // unchanged, except for the (unspecified) order of its elements.  This
+        // method is intended to be called by each operation inserting an
+        // element, before the element is inserted.
+
+    void growthDidInsert(bslalg::BidirectionalLink *node,
+                         native_std::size_t         hashCode);
+        // Update the bucket array into which elements of this object are being
+        // incrementally indexed, if any, to account for the specified 'node',
+        // having the specified 'hashCode', having been inserted at the front
+        // of its bucket, or immediately before an element having an
+        // equivalent key.  Note that 'node' may be moved within its bucket.
+
+    void growthWillRemove(bslalg::BidirectionalLink *node,
+                          native_std::size_t         hashCode);
+        // Update the bucket array into which elements of this object are being
+        // incrementally indexed, if any, to account for the specified 'node',
+        // having the specified 'hashCode', being about to be removed from this
+        // object.
+
+
     void copyDataStructure(bslalg::BidirectionalLink *cursor);
         // Copy the sequence of elements from the list starting at the
         // specified 'cursor' and having 'size' elements.  Allocate a bucket
@@ -2011,6 +2177,11 @@ class HashTable {
         // behavior is undefined unless 'node' points to a list-node of type
         // 'bslalg::BidirectionalNode<KEY_CONFIG::ValueType>'.
 
+    // PRIVATE CLASS METHODS
+    static bslalg::HashTableAnchor::BucketIndexPolicy bucketIndexPolicy();
+        // Return the bucket index policy of hash tables of this type, as
+        // selected by the 'HashTableUsesPowerOfTwoBuckets' trait of 'HASHER'.
+
   public:
     // CREATORS
     explicit HashTable(const ALLOCATOR& basicAllocator = ALLOCATOR());
@@ -2495,17 +2666,24 @@ struct HashTable_ImpDetails {
         // Return the address of a statically initialized empty bucket that can
         // be shared as the (un-owned) bucket array by all empty hash tables.
 
-    static size_t growBucketsForLoadFactor(size_t *capacity,
-                                           size_t  minElements,
-                                           size_t  requestedBuckets,
-                                           double  maxLoadFactor);
+    static size_t growBucketsForLoadFactor(
+                  size_t                                     *capacity,
+                  size_t                                      minElements,
+                  size_t                                      requestedBuckets,
+                  double                                      maxLoadFactor,
+                  bslalg::HashTableAnchor::BucketIndexPolicy  policy =
+                                         bslalg::HashTableAnchor::e_MODULO);
         // Return the suggested number of buckets to index a linked list that
         // can hold as many as the specified 'minElements' without exceeding
         // the specified 'maxLoadFactor', and supporting at least the specified
         // number of 'requestedBuckets'.  Set the specified '*capacity' to the
         // maximum length of linked list that the returned number of buckets
-        // could index without exceeding the 'maxLoadFactor'.  The behavior is
-        // undefined unless '0 < maxLoadFactor', '0 < minElements' and
+        // could index without exceeding the 'maxLoadFactor'.  Optionally
+        // specify the bucket index 'policy' of the anchor that will hold the
+        // buckets.  If 'policy' is not specified, 'e_MODULO' is used.  The
+        // returned number is a prime (from the sequence of 'nextPrime') if
+        // 'policy' is 'e_MODULO', and a power of two otherwise.  The behavior
+        // is undefined unless '0 < maxLoadFactor', '0 < minElements' and
         // '0 < requestedBuckets'.
 
     static bslma::Allocator *incidentalAllocator();
@@ -2526,6 +2704,11 @@ struct HashTable_ImpDetails {
         // sequence have increasing values that reflect a growth factor (e.g.,
         // each value in the sequence may be, approximately, two times the
         // preceding value).
+
+    static size_t nextPowerOfTwo(size_t n);
+        // Return the least power of two greater-than or equal to the specified
+        // 'n', and no less than 2.  Throw a 'std::length_error' exception if
+        // there is no such power of two representable as a 'size_t'.
 };
 
                     // ====================
@@ -2553,14 +2736,21 @@ struct HashTable_Util {
         // a function is not a null pointer value.
 
     template<class ALLOCATOR>
-    static void initAnchor(bslalg::HashTableAnchor *anchor,
-                           native_std::size_t       bucketArraySize,
-                           const ALLOCATOR&         allocator);
+    static void initAnchor(
+                   bslalg::HashTableAnchor                    *anchor,
+                   native_std::size_t                          bucketArraySize,
+                   const ALLOCATOR&                            allocator,
+                   bslalg::HashTableAnchor::BucketIndexPolicy  policy =
+                                          bslalg::HashTableAnchor::e_MODULO);
         // Load into the specified 'anchor' a (contiguous) array of buckets of
         // the specified 'bucketArraySize' using memory supplied by the
-        // specified 'allocator'.  The behavior is undefined unless
-        // '0 < bucketArraySize' and '0 == anchor->bucketArraySize()'.  Note
-        // that this operation has no effect on 'anchor->listRootAddress()'.
+        // specified 'allocator'.  Optionally specify the bucket index 'policy'
+        // of 'anchor'.  If 'policy' is not specified, 'e_MODULO' is used.  The
+        // behavior is undefined unless '0 < bucketArraySize',
+        // '0 == anchor->bucketArraySize()' (or 'anchor' refers to the default
+        // bucket array), and 'bucketArraySize' is a power of two if 'policy'
+        // is 'e_MIXED_POWER_OF_TWO'.  Note that this operation has no effect
+        // on 'anchor->listRootAddress()'.
 
     template<class ALLOCATOR>
     static void destroyBucketArray(bslalg::HashTableBucket *data,
@@ -3038,9 +3228,11 @@ void HashTable_Util::assertNotNullPointer(TYPE * & ptr)
 
 template <class ALLOCATOR>
 inline
-void HashTable_Util::initAnchor(bslalg::HashTableAnchor *anchor,
-                                native_std::size_t       bucketArraySize,
-                                const ALLOCATOR&         allocator)
+void HashTable_Util::initAnchor(
+                   bslalg::HashTableAnchor                    *anchor,
+                   native_std::size_t                          bucketArraySize,
+                   const ALLOCATOR&                            allocator,
+                   bslalg::HashTableAnchor::BucketIndexPolicy  policy)
 {
     BSLS_ASSERT_SAFE(anchor);
     BSLS_ASSERT_SAFE(0 != bucketArraySize);
@@ -3080,6 +3272,7 @@ void HashTable_Util::initAnchor(bslalg::HashTableAnchor *anchor,
 
     native_std::fill_n(data, bucketArraySize, bslalg::HashTableBucket());
 
+    anchor->setBucketIndexPolicy(policy);
     anchor->setBucketArrayAddressAndSize(data, newArraySize);
 }
 
@@ -3285,6 +3478,9 @@ HashTable(const ALLOCATOR& basicAllocator)
 , d_size()
 , d_capacity()
 , d_maxLoadFactor(1.0)
+, d_growthAnchor(0, 0, 0)
+, d_growthCursor(0)
+, d_growthCapacity(0)
 {
     BSLMF_ASSERT(!bsl::is_pointer<HASHER>::value &&
                  !bsl::is_pointer<COMPARATOR>::value);
@@ -3303,6 +3499,9 @@ HashTable(const HASHER&     hash,
 , d_size()
 , d_capacity(0)
 , d_maxLoadFactor(initialMaxLoadFactor)
+, d_growthAnchor(0, 0, 0)
+, d_growthCursor(0)
+, d_growthCapacity(0)
 {
     BSLS_ASSERT(0.0f < initialMaxLoadFactor);
 
@@ -3319,8 +3518,12 @@ HashTable(const HASHER&     hash,
                                         &capacity,
                                         1,
                                         static_cast<size_t>(initialNumBuckets),
-                                        d_maxLoadFactor);
-        HashTable_Util::initAnchor(&d_anchor, numBuckets, basicAllocator);
+                                        d_maxLoadFactor,
+                                        bucketIndexPolicy());
+        HashTable_Util::initAnchor(&d_anchor,
+                                   numBuckets,
+                                   basicAllocator,
+                                   bucketIndexPolicy());
         d_capacity = static_cast<SizeType>(capacity);
     }
 }
@@ -3336,6 +3539,9 @@ HashTable(const HashTable& original)
 , d_size(original.d_size)
 , d_capacity(0)
 , d_maxLoadFactor(original.d_maxLoadFactor)
+, d_growthAnchor(0, 0, 0)
+, d_growthCursor(0)
+, d_growthCapacity(0)
 {
     if (0 < d_size) {
         d_parameters.nodeFactory().reserveNodes(original.d_size);
@@ -3352,6 +3558,9 @@ HashTable(const HashTable& original, const ALLOCATOR& allocator)
 , d_size(original.d_size)
 , d_capacity(0)
 , d_maxLoadFactor(original.d_maxLoadFactor)
+, d_growthAnchor(0, 0, 0)
+, d_growthCursor(0)
+, d_growthCapacity(0)
 {
     if (0 < d_size) {
         d_parameters.nodeFactory().reserveNodes(original.d_size);
@@ -3384,6 +3593,226 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::~HashTable()
 }
 
 // PRIVATE MANIPULATORS
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+inline
+void HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::abandonGrowth()
+{
+    if (d_growthAnchor.bucketArraySize()) {
+        HashTable_Util::destroyBucketArray(
+                                        d_growthAnchor.bucketArrayAddress(),
+                                        d_growthAnchor.bucketArraySize(),
+                                        this->allocator());
+
+        d_growthAnchor   = bslalg::HashTableAnchor(0, 0, 0);
+        d_growthCursor   = 0;
+        d_growthCapacity = 0;
+    }
+}
+
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+void HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::completeGrowth()
+{
+    BSLS_ASSERT_SAFE(d_growthAnchor.bucketArraySize());
+    BSLS_ASSERT_SAFE(d_growthCursor == this->numBuckets());
+
+    d_growthAnchor.setListRootAddress(d_anchor.listRootAddress());
+    d_anchor.swap(d_growthAnchor);
+    d_capacity = d_growthCapacity;
+
+    // 'd_growthAnchor' now refers to the original bucket array.
+
+    d_growthAnchor.setListRootAddress(0);
+    d_growthCursor = static_cast<SizeType>(d_growthAnchor.bucketArraySize());
+    this->abandonGrowth();
+}
+
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+void HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::growIncrementally()
+{
+    if (!HashTableUsesPowerOfTwoBuckets<HASHER>::value) {
+        return;                                                       // RETURN
+    }
+
+    const SizeType numBuckets = this->numBuckets();
+
+    if (!d_growthAnchor.bucketArraySize()) {
+        if (numBuckets < k_INCREMENTAL_GROWTH_MIN_BUCKETS
+         || d_size < d_capacity / 2) {
+            return;                                                   // RETURN
+        }
+
+        // Allocate the bucket array that 'rehashForNumBuckets' would select
+        // once this table is full.
+
+        size_t capacity;
+        size_t newNumBuckets = HashTable_ImpDetails::growBucketsForLoadFactor(
+                                          &capacity,
+                                          static_cast<size_t>(d_capacity) + 1,
+                                          static_cast<size_t>(numBuckets) * 2,
+                                          d_maxLoadFactor,
+                                          bucketIndexPolicy());
+
+        HashTable_Util::initAnchor(&d_growthAnchor,
+                                   newNumBuckets,
+                                   this->allocator(),
+                                   bucketIndexPolicy());
+        d_growthCursor   = 0;
+        d_growthCapacity = static_cast<SizeType>(capacity);
+    }
+
+    class Proctor {
+        // An object of this proctor class guarantees that, if an exception is
+        // thrown by a user-supplied hash functor, the incremental growth of
+        // the table is abandoned, as the bucket being indexed into the new
+        // bucket array is only partially indexed.  Note that the elements of
+        // the table remain correctly indexed by its current bucket array.
+
+      private:
+        HashTable *d_this;
+
+#if !defined(BSLS_PLATFORM_CMP_MSVC)
+        // Microsoft warns if these methods are declared private.
+
+      private:
+        // NOT IMPLEMENTED
+        Proctor(const Proctor&); // = delete;
+        Proctor& operator=(const Proctor&); // = delete;
+#endif
+
+      public:
+        // CREATORS
+        explicit Proctor(HashTable *table)
+        : d_this(table)
+        {
+            BSLS_ASSERT(table);
+        }
+
+        ~Proctor()
+        {
+            if (d_this) {
+                d_this->abandonGrowth();
+            }
+        }
+
+        // MANIPULATORS
+        void dismiss()
+        {
+            d_this = 0;
+        }
+    };
+
+    // Index enough buckets that, indexing as many buckets for each subsequent
+    // insertion, every bucket is indexed before the table is full.
+
+    const SizeType numRemaining  = numBuckets - d_growthCursor;
+    const SizeType numInsertions = d_size < d_capacity
+                                 ? d_capacity - d_size
+                                 : 1;
+    const SizeType numToIndex    = (numRemaining + numInsertions - 1)
+                                                               / numInsertions;
+
+    bslalg::HashTableBucket *buckets = d_anchor.bucketArrayAddress();
+
+    Proctor abandonIfUserHashThrows(this);
+
+    for (SizeType i = 0; i < numToIndex; ++i, ++d_growthCursor) {
+        bslalg::HashTableImpUtil::rehashBucket<KEY_CONFIG>(
+                                                   &d_growthAnchor,
+                                                   buckets + d_growthCursor,
+                                                   d_parameters.hasher());
+    }
+
+    abandonIfUserHashThrows.dismiss();
+
+    if (d_growthCursor == numBuckets) {
+        this->completeGrowth();
+    }
+}
+
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+void HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::growthDidInsert(
+                                           bslalg::BidirectionalLink *node,
+                                           native_std::size_t         hashCode)
+{
+    typedef bslalg::HashTableImpUtil ImpUtil;
+
+    if (!HashTableUsesPowerOfTwoBuckets<HASHER>::value
+     || !d_growthAnchor.bucketArraySize()) {
+        return;                                                       // RETURN
+    }
+
+    const native_std::size_t index = ImpUtil::computeBucketIndex(hashCode,
+                                                                 d_anchor);
+    if (index >= d_growthCursor) {
+        // The bucket of 'node' has not yet been indexed.
+
+        return;                                                       // RETURN
+    }
+
+    bslalg::HashTableBucket *bucket = d_anchor.bucketArrayAddress() + index;
+    bslalg::HashTableBucket *target = d_growthAnchor.bucketArrayAddress()
+                       + ImpUtil::computeBucketIndex(hashCode, d_growthAnchor);
+
+    if (!target->first()) {
+        target->setFirstAndLast(node, node);
+    }
+    else if (target->first() == node->nextLink()) {
+        target->setFirst(node);
+    }
+    else if (bucket->first() == node) {
+        // 'node' was inserted at the front of its bucket, which is not
+        // adjacent to the other elements of 'target'; move it after them.
+
+        bslalg::BidirectionalLink *next = node->nextLink();
+
+        bslalg::BidirectionalLinkListUtil::unlink(node);
+        if (d_anchor.listRootAddress() == node) {
+            d_anchor.setListRootAddress(next);
+        }
+        bucket->setFirst(next);
+
+        if (bucket->last() == target->last()) {
+            bucket->setLast(node);
+        }
+        bslalg::BidirectionalLinkListUtil::insertLinkAfterTarget(
+                                                               node,
+                                                               target->last());
+        target->setLast(node);
+    }
+
+    // Otherwise, 'node' was inserted before an element of 'target' (having an
+    // equivalent key) that is not its first element.
+}
+
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+void HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::growthWillRemove(
+                                           bslalg::BidirectionalLink *node,
+                                           native_std::size_t         hashCode)
+{
+    typedef bslalg::HashTableImpUtil ImpUtil;
+
+    if (!HashTableUsesPowerOfTwoBuckets<HASHER>::value
+     || !d_growthAnchor.bucketArraySize()
+     || ImpUtil::computeBucketIndex(hashCode, d_anchor) >= d_growthCursor) {
+        return;                                                       // RETURN
+    }
+
+    bslalg::HashTableBucket *target = d_growthAnchor.bucketArrayAddress()
+                       + ImpUtil::computeBucketIndex(hashCode, d_growthAnchor);
+
+    if (target->first() == node) {
+        if (target->last() == node) {
+            target->reset();
+        }
+        else {
+            target->setFirst(node->nextLink());
+        }
+    }
+    else if (target->last() == node) {
+        target->setLast(node->previousLink());
+    }
+}
+
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
 void
 HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::copyDataStructure(
@@ -3403,10 +3832,14 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::copyDataStructure(
                                                    &capacity,
                                                    static_cast<size_t>(d_size),
                                                    2,
-                                                   d_maxLoadFactor);
+                                                   d_maxLoadFactor,
+                                                   bucketIndexPolicy());
 
     d_anchor.setListRootAddress(0);
-    HashTable_Util::initAnchor(&d_anchor, numBuckets, this->allocator());
+    HashTable_Util::initAnchor(&d_anchor,
+                               numBuckets,
+                               this->allocator(),
+                               bucketIndexPolicy());
 
     // create a proctor for d_anchor's allocated array, and the list to follow.
 
@@ -3449,6 +3882,10 @@ quickSwapExchangeAllocators(HashTable *other)
     bslalg::SwapUtil::swap(&d_size,          &other->d_size);
     bslalg::SwapUtil::swap(&d_capacity,      &other->d_capacity);
     bslalg::SwapUtil::swap(&d_maxLoadFactor, &other->d_maxLoadFactor);
+
+    bslalg::SwapUtil::swap(&d_growthAnchor,   &other->d_growthAnchor);
+    bslalg::SwapUtil::swap(&d_growthCursor,   &other->d_growthCursor);
+    bslalg::SwapUtil::swap(&d_growthCapacity, &other->d_growthCapacity);
 }
 
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
@@ -3465,6 +3902,10 @@ quickSwapRetainAllocators(HashTable *other)
     bslalg::SwapUtil::swap(&d_size,          &other->d_size);
     bslalg::SwapUtil::swap(&d_capacity,      &other->d_capacity);
     bslalg::SwapUtil::swap(&d_maxLoadFactor, &other->d_maxLoadFactor);
+
+    bslalg::SwapUtil::swap(&d_growthAnchor,   &other->d_growthAnchor);
+    bslalg::SwapUtil::swap(&d_growthCursor,   &other->d_growthCursor);
+    bslalg::SwapUtil::swap(&d_growthCapacity, &other->d_growthCapacity);
 }
 
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
@@ -3543,10 +3984,13 @@ rehashIntoExactlyNumBuckets(SizeType newNumBuckets, SizeType capacity)
     // with a 'createArrayOfEmptyBuckets' function, and we use the result to
     // construct the 'newAnchor'?
 
+    this->abandonGrowth();
+
     bslalg::HashTableAnchor newAnchor(0, 0, 0);
     HashTable_Util::initAnchor(&newAnchor,
                                static_cast<size_t>(newNumBuckets),
-                               this->allocator());
+                               this->allocator(),
+                               bucketIndexPolicy());
 
     Proctor cleanUpIfUserHashThrows(this, &d_anchor, &newAnchor);
 
@@ -3568,6 +4012,7 @@ inline
 void
 HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::removeAllAndDeallocate()
 {
+    this->abandonGrowth();
     this->removeAllImp();
     HashTable_Util::destroyBucketArray(d_anchor.bucketArrayAddress(),
                                        d_anchor.bucketArraySize(),
@@ -3634,6 +4079,17 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::hashCodeForNode(
                        bslalg::HashTableImpUtil::extractKey<KEY_CONFIG>(node));
 }
 
+// PRIVATE CLASS METHODS
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+inline
+bslalg::HashTableAnchor::BucketIndexPolicy
+HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::bucketIndexPolicy()
+{
+    return HashTableUsesPowerOfTwoBuckets<HASHER>::value
+           ? bslalg::HashTableAnchor::e_MIXED_POWER_OF_TWO
+           : bslalg::HashTableAnchor::e_MODULO;
+}
+
 // MANIPULATORS
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
 inline
@@ -3666,6 +4122,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insert(
     // Rehash (if appropriate) first as it will reduce load factor and so
     // potentially improve the 'find' time.
 
+    this->growIncrementally();
     if (d_size >= d_capacity) {
         this->rehashForNumBuckets(numBuckets() * 2);
     }
@@ -3700,6 +4157,8 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insert(
     }
     nodeProctor.release();
 
+    this->growthDidInsert(newNode, hashCode);
+
     ++d_size;
 
     return newNode;
@@ -3719,6 +4178,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insert(
     // Rehash (if appropriate) first as it will reduce load factor and so
     // potentially improve the potential 'find' time later.
 
+    this->growIncrementally();
     if (d_size >= d_capacity) {
         this->rehashForNumBuckets(numBuckets() * 2);
     }
@@ -3752,6 +4212,8 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insert(
     }
     nodeProctor.release();
 
+    this->growthDidInsert(newNode, hashCode);
+
     ++d_size;
 
     return newNode;
@@ -3774,6 +4236,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insertIfMissing(
     *isInsertedFlag = (!position);
 
     if(!position) {
+        this->growIncrementally();
         if (d_size >= d_capacity) {
             this->rehashForNumBuckets(numBuckets() * 2);
         }
@@ -3782,6 +4245,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insertIfMissing(
         bslalg::HashTableImpUtil::insertAtFrontOfBucket(&d_anchor,
                                                         position,
                                                         hashCode);
+        this->growthDidInsert(position, hashCode);
         ++d_size;
     }
 
@@ -3802,6 +4266,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insertIfMissing(
     // Rehash (if appropriate) first as it will reduce load factor and so
     // potentially improve the potential 'find' time later.
 
+    this->growIncrementally();
     if (d_size >= d_capacity) {
         this->rehashForNumBuckets(numBuckets() * 2);
     }
@@ -3829,6 +4294,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insertIfMissing(
     *isInsertedFlag = (!position);
 
     if(!position) {
+        this->growIncrementally();
         if (d_size >= d_capacity) {
             this->rehashForNumBuckets(numBuckets() * 2);
         }
@@ -3836,6 +4302,8 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insertIfMissing(
         ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
         nodeProctor.release();
 
+        this->growthDidInsert(newNode, hashCode);
+
         ++d_size;
         position = newNode;
     }
@@ -3851,6 +4319,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insertIfMissing(
     size_t hashCode = this->d_parameters.hashCodeForKey(key);
     bslalg::BidirectionalLink *position = this->find(key, hashCode);
     if (!position) {
+        this->growIncrementally();
         if (d_size >= d_capacity) {
             this->rehashForNumBuckets(numBuckets() * 2);
         }
@@ -3862,6 +4331,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insertIfMissing(
         bslalg::HashTableImpUtil::insertAtFrontOfBucket(&d_anchor,
                                                         position,
                                                         hashCode);
+        this->growthDidInsert(position, hashCode);
         ++d_size;
     }
     return position;
@@ -3882,7 +4352,8 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::rehashForNumBuckets(
                                             &capacity,
                                             d_size + 1u,
                                             static_cast<size_t>(newNumBuckets),
-                                            d_maxLoadFactor));
+                                            d_maxLoadFactor,
+                                            bucketIndexPolicy()));
 
         this->rehashIntoExactlyNumBuckets(numBuckets,
                                           static_cast<SizeType>(capacity));
@@ -3900,9 +4371,10 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::remove(
 
     bslalg::BidirectionalLink *result = node->nextLink();
 
-    bslalg::HashTableImpUtil::remove(&d_anchor,
-                                     node,
-                                     hashCodeForNode(node));
+    size_t hashCode = hashCodeForNode(node);
+    this->growthWillRemove(node, hashCode);
+
+    bslalg::HashTableImpUtil::remove(&d_anchor, node, hashCode);
     --d_size;
 
     d_parameters.nodeFactory().deleteNode(static_cast<NodeType *>(node));
@@ -3914,6 +4386,7 @@ template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
 void
 HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::removeAll()
 {
+    this->abandonGrowth();
     this->removeAllImp();
     native_std::memset(
                  d_anchor.bucketArrayAddress(),
@@ -3944,7 +4417,8 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::reserveForNumElements(
                                        &capacity,
                                        numElements,
                                        static_cast<size_t>(this->numBuckets()),
-                                       d_maxLoadFactor));
+                                       d_maxLoadFactor,
+                                       bucketIndexPolicy()));
 
         this->rehashIntoExactlyNumBuckets(numBuckets,
                                           static_cast<SizeType>(capacity));
@@ -3964,7 +4438,8 @@ void HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::setMaxLoadFactor(
                                        &capacity,
                                        native_std::max<SizeType>(d_size, 1u),
                                        static_cast<size_t>(this->numBuckets()),
-                                       newMaxLoadFactor));
+                                       newMaxLoadFactor,
+                                       bucketIndexPolicy()));
 
     this->rehashIntoExactlyNumBuckets(numBuckets,
                                       static_cast<SizeType>(capacity));
@@ -4031,8 +4506,8 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::bucketIndexForKey(
 
     size_t hashCode = this->d_parameters.hashCodeForKey(key);
     return static_cast<SizeType>(bslalg::HashTableImpUtil::computeBucketIndex(
-                                                  hashCode,
-                                                  d_anchor.bucketArraySize()));
+                                                                    hashCode,
+                                                                    d_anchor));
 }
 
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
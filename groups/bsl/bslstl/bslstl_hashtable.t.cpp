@@ -13,6 +13,7 @@
 #include <bslma_default.h>
 #include <bslma_defaultallocatorguard.h>
 #include <bslma_exceptionguard.h>
+#include <bslma_newdeleteallocator.h>
 #include <bslma_rawdeleterguard.h>
 #include <bslma_testallocator.h>
 #include <bslma_testallocatormonitor.h>
@@ -27,6 +28,7 @@
 #include <bsls_asserttest.h>
 #include <bsls_bsltestutil.h>
 #include <bsls_platform.h>
+#include <bsls_stopwatch.h>
 
 #include <bsltf_convertiblevaluewrapper.h>
 #include <bsltf_degeneratefunctor.h>
@@ -246,13 +248,19 @@ using bslstl::CallableVariable;
 //
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [  ] USAGE EXAMPLE
+// [19] USAGE EXAMPLE
+// [17] CONCERN: 'HashTableUsesPowerOfTwoBuckets' selects the bucket policy.
+// [18] CONCERN: Power-of-two tables grow incrementally.
+// [-1] PERFORMANCE: lookup with prime and power-of-two bucket counts
+// [-2] PERFORMANCE: insertion latency with incremental growth
 //
 // class HashTable_ImpDetails
 // [  ] bslalg::HashTableBucket *defaultBucketAddress();
 // [  ] size_t growBucketsForLoadFactor(size_t *, size_t, size_t, double);
+// [17] size_t growBucketsForLoadFactor(size_t *, size_t, size_t, double, P);
 // [  ] bslma::Allocator *incidentalAllocator();
 // [  ] size_t nextPrime(size_t n);
+// [17] size_t nextPowerOfTwo(size_t n);
 //
 // class HashTable_Util
 // [  ] initAnchor<ALLOC>(bslalg::HashTableAnchor *, size_t, const ALLOC&)
@@ -9326,6 +9334,340 @@ void TestDriver<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::testCase16()
                                                       == objIsBitwiseMoveable);
 }
 
+//=============================================================================
+//                      BUCKET INDEX POLICY TEST SUPPORT
+//-----------------------------------------------------------------------------
+
+namespace {
+
+struct WeakIntHash {
+    // This 'struct' provides an identity hash functor for 'int' values, which
+    // has the same poor dispersal as 'bsl::hash<int>', and for which the
+    // 'bslstl::HashTableUsesPowerOfTwoBuckets' trait is not declared.
+
+    // ACCESSORS
+    size_t operator()(int value) const
+        // Return the specified 'value' converted to 'size_t'.
+    {
+        return static_cast<size_t>(value);
+    }
+};
+
+struct PowerOfTwoIntHash : WeakIntHash {
+    // This 'struct' provides an identity hash functor for 'int' values, for
+    // which the 'bslstl::HashTableUsesPowerOfTwoBuckets' trait is declared.
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(PowerOfTwoIntHash,
+                                   bslstl::HashTableUsesPowerOfTwoBuckets);
+};
+
+bool isPowerOfTwo(size_t value)
+    // Return 'true' if the specified 'value' is a power of two, and 'false'
+    // otherwise.
+{
+    return 0 != value && 0 == (value & (value - 1));
+}
+
+template <class HASHER>
+void testBucketIndexPolicy(bool expectPowerOfTwo)
+    // Verify that a 'HashTable' using the (template parameter) type 'HASHER'
+    // has a power-of-two number of buckets if the specified
+    // 'expectPowerOfTwo' is 'true', and a number of buckets that is not a
+    // power of two (other than 2) otherwise, as it grows by insertion, by
+    // rehashing, and by
+    // reserving space for elements, and that every element can be found, and
+    // is held in the bucket indicated by 'bucketIndexForKey', throughout.
+{
+    typedef bslstl::HashTable<BasicKeyConfig<int>,
+                              HASHER,
+                              ::bsl::equal_to<int>,
+                              ::bsl::allocator<int> > Obj;
+
+    typedef typename Obj::SizeType SizeType;
+
+    bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+    ASSERTV(expectPowerOfTwo,
+            expectPowerOfTwo ==
+                       bslstl::HashTableUsesPowerOfTwoBuckets<HASHER>::value);
+
+    const int NUM_VALUES = 1000;
+
+    Obj mX(HASHER(), ::bsl::equal_to<int>(), 0, 1.0f, &oa);
+    const Obj& X = mX;
+
+    for (int i = 0; i < NUM_VALUES; ++i) {
+        // Insert values spaced by a multiple of a large power of two, which
+        // are all congruent modulo every smaller power of two.
+
+        mX.insert(i << 10);
+
+        ASSERTV(expectPowerOfTwo, i, X.numBuckets(),
+                expectPowerOfTwo == isPowerOfTwo(X.numBuckets())
+             || 2 == X.numBuckets());
+    }
+
+    for (int i = 0; i < NUM_VALUES; ++i) {
+        const int KEY = i << 10;
+
+        bslalg::BidirectionalLink *link = X.find(KEY);
+        ASSERTV(expectPowerOfTwo, i, 0 != link);
+
+        const SizeType INDEX = X.bucketIndexForKey(KEY);
+        ASSERTV(expectPowerOfTwo, i, INDEX < X.numBuckets());
+
+        const bslalg::HashTableBucket& bucket = X.bucketAtIndex(INDEX);
+
+        bool found = false;
+        for (bslalg::BidirectionalLink *cursor = bucket.first();
+             cursor && !found;
+             cursor = cursor == bucket.last() ? 0 : cursor->nextLink()) {
+            found = cursor == link;
+        }
+        ASSERTV(expectPowerOfTwo, i, found);
+    }
+
+    // Note that the hash codes are all multiples of 1024, so that, unless
+    // they are mixed, they all fall into the same (few) buckets of a table
+    // having a power-of-two number of buckets.
+
+    SizeType maxBucketSize = 0;
+    for (SizeType i = 0; i < X.numBuckets(); ++i) {
+        maxBucketSize = native_std::max(maxBucketSize,
+                                        X.countElementsInBucket(i));
+    }
+    ASSERTV(expectPowerOfTwo, maxBucketSize, maxBucketSize < 16);
+
+    mX.rehashForNumBuckets(5000);
+    ASSERTV(expectPowerOfTwo, X.numBuckets(), 5000 <= X.numBuckets());
+    ASSERTV(expectPowerOfTwo, X.numBuckets(),
+            expectPowerOfTwo == isPowerOfTwo(X.numBuckets()));
+
+    mX.reserveForNumElements(20000);
+    ASSERTV(expectPowerOfTwo, X.numBuckets(), 20000 <= X.numBuckets());
+    ASSERTV(expectPowerOfTwo, X.numBuckets(),
+            expectPowerOfTwo == isPowerOfTwo(X.numBuckets()));
+
+    for (int i = 0; i < NUM_VALUES; ++i) {
+        ASSERTV(expectPowerOfTwo, i, 0 != X.find(i << 10));
+        ASSERTV(expectPowerOfTwo, i, 0 == X.find((i << 10) + 1));
+    }
+
+    const Obj Y(X, &oa);
+    ASSERTV(expectPowerOfTwo, X == Y);
+    ASSERTV(expectPowerOfTwo, Y.numBuckets(),
+            expectPowerOfTwo == isPowerOfTwo(Y.numBuckets()));
+
+    mX.removeAll();
+    ASSERTV(expectPowerOfTwo, 0 == X.size());
+}
+
+template <class HASHER>
+void benchmarkLookup(const char *label, int numValues, int numIterations)
+    // Print to 'stdout' the time, labeled with the specified 'label', to look
+    // up each of the specified 'numValues' keys (half of which are present),
+    // in a scrambled order, the specified 'numIterations' times in a
+    // 'HashTable' using the (template parameter) type 'HASHER'.  The
+    // behavior is undefined unless 'numValues' is a power of two.
+{
+    typedef bslstl::HashTable<BasicKeyConfig<int>,
+                              HASHER,
+                              ::bsl::equal_to<int>,
+                              ::bsl::allocator<int> > Obj;
+
+    bslma::NewDeleteAllocator *alloc_p =
+                                   &bslma::NewDeleteAllocator::singleton();
+
+    Obj mX(HASHER(), ::bsl::equal_to<int>(), 0, 1.0f, alloc_p);
+    const Obj& X = mX;
+
+    for (int i = 0; i < numValues; ++i) {
+        mX.insert(2 * i);
+    }
+
+    // Visit the keys in the order of an odd multiple of the index, modulo
+    // 'numValues', so that successive lookups do not visit adjacent buckets
+    // of a table whose hash functor is the identity.
+
+    const unsigned int mask = static_cast<unsigned int>(numValues - 1);
+
+    bsls::Stopwatch timer;
+    timer.start();
+
+    int numFound = 0;
+    for (int j = 0; j < numIterations; ++j) {
+        for (unsigned int i = 0; i <= mask; ++i) {
+            const int key = static_cast<int>((i * 2654435761u) & mask);
+            numFound += 0 != X.find(key);
+        }
+    }
+
+    timer.stop();
+
+    ASSERTV(label, numFound, numValues / 2 * numIterations == numFound);
+
+    printf("%-24s %8d values %8d buckets: %8.4f s\n",
+           label,
+           numValues,
+           static_cast<int>(X.numBuckets()),
+           timer.elapsedTime());
+}
+
+//=============================================================================
+//                      INCREMENTAL GROWTH TEST SUPPORT
+//-----------------------------------------------------------------------------
+
+int g_numHashCalls = 0;
+    // Number of calls of 'CountingPowerOfTwoIntHash::operator()'.
+
+int g_numHashCallsBeforeThrow = -1;
+    // Number of calls of 'CountingPowerOfTwoIntHash::operator()' that return
+    // normally before a call throws, or a negative value if no call throws.
+
+struct HashException {
+    // This 'struct' is the type of the exception thrown by
+    // 'CountingPowerOfTwoIntHash'.
+};
+
+struct CountingPowerOfTwoIntHash {
+    // This 'struct' provides an identity hash functor for 'int' values, for
+    // which the 'bslstl::HashTableUsesPowerOfTwoBuckets' trait is declared,
+    // that counts its calls in 'g_numHashCalls', and that throws a
+    // 'HashException' once 'g_numHashCallsBeforeThrow' calls have returned.
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(CountingPowerOfTwoIntHash,
+                                   bslstl::HashTableUsesPowerOfTwoBuckets);
+
+    // ACCESSORS
+    size_t operator()(int value) const
+        // Return the specified 'value' converted to 'size_t'.
+    {
+        ++g_numHashCalls;
+
+#if defined(BDE_BUILD_TARGET_EXC)
+        if (0 == g_numHashCallsBeforeThrow) {
+            g_numHashCallsBeforeThrow = -1;
+            throw HashException();
+        }
+#endif
+        if (0 < g_numHashCallsBeforeThrow) {
+            --g_numHashCallsBeforeThrow;
+        }
+
+        return static_cast<size_t>(value);
+    }
+};
+
+typedef bslstl::HashTable<BasicKeyConfig<int>,
+                          CountingPowerOfTwoIntHash,
+                          ::bsl::equal_to<int>,
+                          ::bsl::allocator<int> > GrowthObj;
+
+int growthKey(int index)
+    // Return the key having the specified 'index' in a sequence of distinct
+    // keys that do not occupy adjacent buckets.
+{
+    return static_cast<int>((static_cast<unsigned int>(index) * 2654435761u)
+                                                                 & 0x7fffffff);
+}
+
+bool verifyGrowthObj(const GrowthObj& X, const bool *isPresent, int numKeys)
+    // Return 'true' if the specified 'X' holds exactly the keys
+    // 'growthKey(i)' for each 'i' in the range '[0, numKeys)' for which the
+    // specified 'isPresent[i]' is 'true', each in the bucket indicated by
+    // 'bucketIndexForKey', and 'false' otherwise.
+{
+    typedef GrowthObj::SizeType SizeType;
+
+    SizeType numPresent = 0;
+    for (int i = 0; i < numKeys; ++i) {
+        const int                  KEY  = growthKey(i);
+        bslalg::BidirectionalLink *link = X.find(KEY);
+
+        if (isPresent[i] != (0 != link)) {
+            return false;                                             // RETURN
+        }
+        if (!link) {
+            continue;
+        }
+        ++numPresent;
+
+        const SizeType                 INDEX  = X.bucketIndexForKey(KEY);
+        const bslalg::HashTableBucket& bucket = X.bucketAtIndex(INDEX);
+
+        bool found = false;
+        for (bslalg::BidirectionalLink *cursor = bucket.first();
+             cursor && !found;
+             cursor = cursor == bucket.last() ? 0 : cursor->nextLink()) {
+            found = cursor == link;
+        }
+        if (!found) {
+            return false;                                             // RETURN
+        }
+    }
+
+    SizeType numInList = 0;
+    for (bslalg::BidirectionalLink *cursor = X.elementListRoot();
+         cursor;
+         cursor = cursor->nextLink()) {
+        ++numInList;
+    }
+
+    SizeType numInBuckets = 0;
+    for (SizeType i = 0; i < X.numBuckets(); ++i) {
+        numInBuckets += X.countElementsInBucket(i);
+    }
+
+    return numPresent == X.size()
+        && numInList == X.size()
+        && numInBuckets == X.size();
+}
+
+template <class HASHER>
+void benchmarkInsert(const char *label, int numValues)
+    // Print to 'stdout' the total time, and the longest time of a single
+    // insertion, labeled with the specified 'label', to insert the specified
+    // 'numValues' keys into a 'HashTable' using the (template parameter) type
+    // 'HASHER'.
+{
+    typedef bslstl::HashTable<BasicKeyConfig<int>,
+                              HASHER,
+                              ::bsl::equal_to<int>,
+                              ::bsl::allocator<int> > Obj;
+
+    bslma::NewDeleteAllocator *alloc_p =
+                                   &bslma::NewDeleteAllocator::singleton();
+
+    Obj mX(HASHER(), ::bsl::equal_to<int>(), 0, 1.0f, alloc_p);
+    const Obj& X = mX;
+
+    bsls::Stopwatch total;
+    bsls::Stopwatch timer;
+    double          maxTime = 0.0;
+
+    total.start();
+    for (int i = 0; i < numValues; ++i) {
+        timer.start(false);
+        mX.insert(growthKey(i));
+        timer.stop();
+
+        maxTime = native_std::max(maxTime, timer.elapsedTime());
+        timer.reset();
+    }
+    total.stop();
+
+    printf("%-24s %8d values %8d buckets: %8.4f s, worst insert %8.6f s\n",
+           label,
+           numValues,
+           static_cast<int>(X.numBuckets()),
+           total.elapsedTime(),
+           maxTime);
+}
+
+}  // close unnamed namespace
+
 //=============================================================================
 //                      TEST CASE DISPATCH FUNCTIONS
 //-----------------------------------------------------------------------------
@@ -11220,6 +11562,465 @@ void mainTestCase16()
     TestDriver_AwkwardMaplike::testCase16();
 }
 
+static
+void mainTestCase17()
+    // --------------------------------------------------------------------
+    // TESTING BUCKET INDEX POLICY
+    //
+    // Concerns:
+    //: 1 The 'HashTableUsesPowerOfTwoBuckets' trait is 'false' unless it is
+    //:   declared for a hash functor.
+    //:
+    //: 2 A hash table whose hash functor has the trait always has a
+    //:   power-of-two number of buckets, and a hash table whose hash functor
+    //:   does not have the trait never has a power-of-two number of buckets
+    //:   other than 2.
+    //:
+    //: 3 Every element of a hash table is held in the bucket indicated by
+    //:   'bucketIndexForKey' for either policy, after insertion, rehashing,
+    //:   and reserving space.
+    //:
+    //: 4 Hash codes differing only in their high-order bits are dispersed
+    //:   across the buckets of a table having a power-of-two number of
+    //:   buckets.
+    //:
+    //: 5 'nextPowerOfTwo' returns the least power of two not less than its
+    //:   argument (and not less than 2), and throws 'std::length_error' if
+    //:   there is no such power of two.
+    //
+    // Plan:
+    //: 1 Verify the value of the trait for hash functors with and without
+    //:   the trait.  (C-1)
+    //:
+    //: 2 Using identity hash functors with and without the trait, insert
+    //:   values that are multiples of 1024, and verify the number of buckets
+    //:   after each insertion, rehash, and reservation, that each value is
+    //:   found in the bucket indicated by 'bucketIndexForKey', and that no
+    //:   bucket holds many elements.  (C-2..4)
+    //:
+    //: 3 Call 'nextPowerOfTwo' and 'growBucketsForLoadFactor' for a table of
+    //:   arguments, and verify the results, and that an exception is thrown
+    //:   for values having no representable power of two.  (C-5)
+    //
+    // Testing:
+    //   size_t growBucketsForLoadFactor(size_t *, size_t, size_t, double, P);
+    //   size_t nextPowerOfTwo(size_t n);
+    //   CONCERN: 'HashTableUsesPowerOfTwoBuckets' selects the bucket policy.
+    // --------------------------------------------------------------------
+{
+    if (verbose) printf("\nTESTING BUCKET INDEX POLICY"
+                        "\n===========================\n");
+
+    if (verbose) printf("\nTesting the trait.\n");
+
+    typedef ::bsl::hash<int> IntHash;
+
+    ASSERT(!bslstl::HashTableUsesPowerOfTwoBuckets<IntHash>::value);
+    ASSERT(!bslstl::HashTableUsesPowerOfTwoBuckets<WeakIntHash>::value);
+    ASSERT( bslstl::HashTableUsesPowerOfTwoBuckets<PowerOfTwoIntHash>::value);
+
+    if (verbose) printf("\nTesting 'nextPowerOfTwo'.\n");
+    {
+        typedef bslstl::HashTable_ImpDetails ImpDetails;
+
+        static const struct {
+            int    d_line;      // source line number
+            size_t d_value;     // argument
+            size_t d_expected;  // expected result
+        } DATA[] = {
+            //LINE  VALUE    EXPECTED
+            //----  -------  --------
+            { L_,         1,        2 },
+            { L_,         2,        2 },
+            { L_,         3,        4 },
+            { L_,         4,        4 },
+            { L_,         5,        8 },
+            { L_,      1000,     1024 },
+            { L_,      1024,     1024 },
+            { L_,      1025,     2048 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int    LINE     = DATA[ti].d_line;
+            const size_t VALUE    = DATA[ti].d_value;
+            const size_t EXPECTED = DATA[ti].d_expected;
+
+            ASSERTV(LINE, EXPECTED == ImpDetails::nextPowerOfTwo(VALUE));
+
+            size_t capacity = 0;
+            const size_t NUM_BUCKETS = ImpDetails::growBucketsForLoadFactor(
+                                &capacity,
+                                VALUE,
+                                1,
+                                1.0,
+                                bslalg::HashTableAnchor::e_MIXED_POWER_OF_TWO);
+            ASSERTV(LINE, NUM_BUCKETS, EXPECTED == NUM_BUCKETS);
+            ASSERTV(LINE, capacity, NUM_BUCKETS == capacity);
+        }
+
+        const size_t MAX_POWER = ~(~static_cast<size_t>(0) >> 1);
+
+        ASSERT(MAX_POWER == ImpDetails::nextPowerOfTwo(MAX_POWER));
+        ASSERT(MAX_POWER == ImpDetails::nextPowerOfTwo(MAX_POWER - 1));
+
+#if defined(BDE_BUILD_TARGET_EXC)
+        bool caught = false;
+        try {
+            ImpDetails::nextPowerOfTwo(MAX_POWER + 1);
+        }
+        catch (const native_std::length_error&) {
+            caught = true;
+        }
+        ASSERT(caught);
+
+        caught = false;
+        try {
+            ImpDetails::nextPowerOfTwo(0);
+        }
+        catch (const native_std::length_error&) {
+            caught = true;
+        }
+        ASSERT(caught);
+#endif
+    }
+
+    if (verbose) printf("\nTesting a table with prime bucket counts.\n");
+    testBucketIndexPolicy<WeakIntHash>(false);
+
+    if (verbose) printf("\nTesting a table with power-of-two buckets.\n");
+    testBucketIndexPolicy<PowerOfTwoIntHash>(true);
+}
+
+static
+void mainTestCase18()
+    // --------------------------------------------------------------------
+    // TESTING INCREMENTAL GROWTH
+    //
+    // Concerns:
+    //: 1 A hash table having a power-of-two number of buckets, not fewer
+    //:   than 'k_INCREMENTAL_GROWTH_MIN_BUCKETS', grows without rehashing
+    //:   all of its elements during any single insertion.
+    //:
+    //: 2 Every element remains reachable by 'find', and is held in the
+    //:   bucket indicated by 'bucketIndexForKey', while the table grows, as
+    //:   elements are inserted and removed.
+    //:
+    //: 3 Elements having equivalent keys remain adjacent while the table
+    //:   grows.
+    //:
+    //: 4 An exception thrown by the hash functor while the table grows
+    //:   leaves the table valid, and the table continues to grow afterward.
+    //:
+    //: 5 Rehashing, copying, swapping, and clearing a table while it grows
+    //:   yields a valid table, and leaks no memory.
+    //
+    // Plan:
+    //: 1 Using a hash functor that counts its calls, insert distinct keys
+    //:   into a table having 'k_INCREMENTAL_GROWTH_MIN_BUCKETS' buckets,
+    //:   removing every third key shortly after its insertion, and verify
+    //:   that no insertion calls the hash functor more than a small number
+    //:   of times, and that the number of buckets grows.  Periodically
+    //:   verify that the table holds exactly the expected elements, each in
+    //:   its indicated bucket.  (C-1..2)
+    //:
+    //: 2 Insert a second element for each of a range of keys while the
+    //:   table grows, and verify that 'findRange' finds both elements of
+    //:   each key.  (C-3)
+    //:
+    //: 3 Configure the hash functor to throw while the table grows, and
+    //:   verify that the table is valid after the exception, and continues
+    //:   to grow.  (C-4)
+    //:
+    //: 4 Rehash, copy, swap, and clear tables while they grow, and verify
+    //:   the results.  Use a test allocator to verify that no memory is
+    //:   leaked.  (C-5)
+    //
+    // Testing:
+    //   CONCERN: Power-of-two tables grow incrementally.
+    // --------------------------------------------------------------------
+{
+    if (verbose) printf("\nTESTING INCREMENTAL GROWTH"
+                        "\n==========================\n");
+
+    typedef GrowthObj::SizeType SizeType;
+
+    const int      NUM_KEYS    = 20000;
+    const SizeType MIN_BUCKETS = GrowthObj::k_INCREMENTAL_GROWTH_MIN_BUCKETS;
+
+    bool *isPresent = new bool[NUM_KEYS];
+
+    if (verbose) printf("\nTesting insertion and removal.\n");
+    {
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        native_std::fill_n(isPresent, NUM_KEYS, false);
+
+        GrowthObj mX(CountingPowerOfTwoIntHash(),
+                     ::bsl::equal_to<int>(),
+                     MIN_BUCKETS,
+                     1.0f,
+                     &oa);
+        const GrowthObj& X = mX;
+
+        ASSERTV(X.numBuckets(), MIN_BUCKETS == X.numBuckets());
+
+        int maxHashCalls = 0;
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            g_numHashCalls = 0;
+            mX.insert(growthKey(i));
+            isPresent[i] = true;
+
+            maxHashCalls = native_std::max(maxHashCalls, g_numHashCalls);
+
+            if (0 == i % 3 && 8 <= i) {
+                bslalg::BidirectionalLink *link = mX.find(growthKey(i - 8));
+                ASSERTV(i, 0 != link);
+
+                mX.remove(link);
+                isPresent[i - 8] = false;
+            }
+
+            if (0 == i % 997) {
+                ASSERTV(i, verifyGrowthObj(X, isPresent, NUM_KEYS));
+            }
+        }
+
+        ASSERTV(maxHashCalls, maxHashCalls <= 16);
+        ASSERTV(X.numBuckets(), 8 * MIN_BUCKETS <= X.numBuckets());
+        ASSERTV(X.size(), X.size() <= X.numBuckets());
+        ASSERT(verifyGrowthObj(X, isPresent, NUM_KEYS));
+    }
+
+    if (verbose) printf("\nTesting equivalent keys.\n");
+    {
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        GrowthObj mX(CountingPowerOfTwoIntHash(),
+                     ::bsl::equal_to<int>(),
+                     MIN_BUCKETS,
+                     1.0f,
+                     &oa);
+        const GrowthObj& X = mX;
+
+        const int NUM_VALUES = static_cast<int>(2 * MIN_BUCKETS);
+
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            mX.insert(growthKey(i));
+            mX.insert(growthKey(i));
+        }
+
+        ASSERTV(X.size(), static_cast<SizeType>(2 * NUM_VALUES) == X.size());
+
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            bslalg::BidirectionalLink *first;
+            bslalg::BidirectionalLink *last;
+
+            X.findRange(&first, &last, growthKey(i));
+
+            ASSERTV(i, 0 != first);
+            if (first) {
+                ASSERTV(i, first->nextLink() != last);
+                ASSERTV(i, !first->nextLink()
+                         || first->nextLink()->nextLink() == last);
+            }
+        }
+    }
+
+#if defined(BDE_BUILD_TARGET_EXC)
+    if (verbose) printf("\nTesting exceptions thrown by the hash functor.\n");
+    {
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        native_std::fill_n(isPresent, NUM_KEYS, false);
+
+        GrowthObj mX(CountingPowerOfTwoIntHash(),
+                     ::bsl::equal_to<int>(),
+                     MIN_BUCKETS,
+                     1.0f,
+                     &oa);
+        const GrowthObj& X = mX;
+
+        int numThrown = 0;
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            if (0 == i % 101) {
+                g_numHashCallsBeforeThrow = 1 + i % 3;
+            }
+
+            try {
+                mX.insert(growthKey(i));
+                isPresent[i] = true;
+            }
+            catch (const HashException&) {
+                ++numThrown;
+
+                isPresent[i] = 0 != X.find(growthKey(i));
+                ASSERTV(i, verifyGrowthObj(X, isPresent, NUM_KEYS));
+            }
+        }
+        g_numHashCallsBeforeThrow = -1;
+
+        ASSERTV(numThrown, 0 < numThrown);
+        ASSERTV(X.numBuckets(), 8 * MIN_BUCKETS <= X.numBuckets());
+        ASSERT(verifyGrowthObj(X, isPresent, NUM_KEYS));
+    }
+#endif
+
+    if (verbose) printf("\nTesting operations on growing tables.\n");
+    {
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        const int NUM_VALUES = static_cast<int>(MIN_BUCKETS * 3 / 4);
+
+        native_std::fill_n(isPresent, NUM_KEYS, false);
+        native_std::fill_n(isPresent, NUM_VALUES, true);
+
+        for (int ti = 0; ti < 5; ++ti) {
+            GrowthObj mX(CountingPowerOfTwoIntHash(),
+                         ::bsl::equal_to<int>(),
+                         MIN_BUCKETS,
+                         1.0f,
+                         &oa);
+            const GrowthObj& X = mX;
+
+            GrowthObj mY(CountingPowerOfTwoIntHash(),
+                         ::bsl::equal_to<int>(),
+                         MIN_BUCKETS,
+                         1.0f,
+                         &oa);
+            const GrowthObj& Y = mY;
+
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                mX.insert(growthKey(i));
+            }
+
+            // 'X' is now growing, as it is more than half full.
+
+            ASSERTV(ti, MIN_BUCKETS == X.numBuckets());
+
+            switch (ti) {
+              case 0: {
+                mX.rehashForNumBuckets(4 * MIN_BUCKETS);
+                ASSERTV(X.numBuckets(), 4 * MIN_BUCKETS == X.numBuckets());
+              } break;
+              case 1: {
+                const GrowthObj Z(X, &oa);
+                ASSERTV(ti, X == Z);
+                ASSERTV(ti, verifyGrowthObj(Z, isPresent, NUM_KEYS));
+              } break;
+              case 2: {
+                mX.swap(mY);
+                ASSERTV(ti, verifyGrowthObj(Y, isPresent, NUM_VALUES));
+
+                mY.insert(growthKey(NUM_VALUES));
+                ASSERTV(ti, 0 != Y.find(growthKey(NUM_VALUES)));
+                mY.remove(Y.find(growthKey(NUM_VALUES)));
+
+                mX.swap(mY);
+              } break;
+              case 3: {
+                mX.setMaxLoadFactor(0.5f);
+                ASSERTV(X.numBuckets(), 2 * MIN_BUCKETS <= X.numBuckets());
+              } break;
+              case 4: {
+                mX.removeAll();
+                ASSERTV(X.size(), 0 == X.size());
+
+                for (int i = 0; i < NUM_VALUES; ++i) {
+                    mX.insert(growthKey(i));
+                }
+              } break;
+            }
+
+            ASSERTV(ti, verifyGrowthObj(X, isPresent, NUM_KEYS));
+
+            // Complete the growth of 'X'.
+
+            for (int i = NUM_VALUES; i < NUM_KEYS; ++i) {
+                mX.insert(growthKey(i));
+            }
+            for (int i = NUM_VALUES; i < NUM_KEYS; ++i) {
+                ASSERTV(ti, i, 0 != X.find(growthKey(i)));
+            }
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+    }
+
+    delete[] isPresent;
+}
+
+static
+void mainTestCaseMinus2()
+    // --------------------------------------------------------------------
+    // PERFORMANCE TEST: INSERTION LATENCY
+    //
+    // Concerns:
+    //: 1 Provide a benchmark of the total time, and the longest time of a
+    //:   single insertion, to grow hash tables having a prime number of
+    //:   buckets (rehashed all at once) and a power-of-two number of buckets
+    //:   (rehashed incrementally).
+    //
+    // Plan:
+    //: 1 Using 'bsls::Stopwatch', time each insertion of distinct 'int' keys
+    //:   into tables of several sizes, using identity hash functors with and
+    //:   without the 'HashTableUsesPowerOfTwoBuckets' trait.
+    //
+    // Testing:
+    //   PERFORMANCE: insertion latency with incremental growth
+    // --------------------------------------------------------------------
+{
+    printf("\nPERFORMANCE TEST: INSERTION LATENCY"
+           "\n===================================\n");
+
+    static const int SIZES[] = { 1 << 14, 1 << 20, 1 << 22 };
+    const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+    for (int ti = 0; ti < NUM_SIZES; ++ti) {
+        benchmarkInsert<WeakIntHash>("prime buckets", SIZES[ti]);
+        benchmarkInsert<PowerOfTwoIntHash>("power-of-two buckets", SIZES[ti]);
+    }
+}
+
+static
+void mainTestCaseMinus1()
+    // --------------------------------------------------------------------
+    // PERFORMANCE TEST: LOOKUP
+    //
+    // Concerns:
+    //: 1 Provide a benchmark of 'find' for hash tables having a prime number
+    //:   of buckets (indexed using a cached reciprocal) and a power-of-two
+    //:   number of buckets (indexed using a multiplicative mix).
+    //
+    // Plan:
+    //: 1 Using 'bsls::Stopwatch', time repeated successful and unsuccessful
+    //:   lookups of 'int' keys in tables of several sizes, using identity
+    //:   hash functors with and without the
+    //:   'HashTableUsesPowerOfTwoBuckets' trait.  The results are meant
+    //:   only for comparison across policies and versions.
+    //
+    // Testing:
+    //   PERFORMANCE: lookup with prime and power-of-two bucket counts
+    // --------------------------------------------------------------------
+{
+    printf("\nPERFORMANCE TEST: LOOKUP"
+           "\n========================\n");
+
+    static const int SIZES[] = { 1 << 7, 1 << 14, 1 << 20 };
+    const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+    for (int ti = 0; ti < NUM_SIZES; ++ti) {
+        const int NUM_VALUES     = SIZES[ti];
+        const int NUM_ITERATIONS = (1 << 24) / NUM_VALUES;
+
+        benchmarkLookup<WeakIntHash>("prime buckets",
+                                     NUM_VALUES,
+                                     NUM_ITERATIONS);
+        benchmarkLookup<PowerOfTwoIntHash>("power-of-two buckets",
+                                           NUM_VALUES,
+                                           NUM_ITERATIONS);
+    }
+}
+
 #if 0  // Planned test cases, not yet implemented
 static
 void mainTestCase16()
@@ -11458,9 +12259,9 @@ int main(int argc, char *argv[])
 #pragma bde_verify -TP05  // Test doc is in delegated functions
 #pragma bde_verify -TP17  // No test-banners in a delegating switch statement
     switch (test) { case 0:
-      case 17: mainTestCaseUsageExample(); break;
-//      case 18: mainTestCase18(); break;
-//      case 17: mainTestCase17(); break;
+      case 19: mainTestCaseUsageExample(); break;
+      case 18: mainTestCase18(); break;
+      case 17: mainTestCase17(); break;
       case 16: mainTestCase16(); break;
       case 15: mainTestCase15(); break;
       case 14: mainTestCase14(); break;
@@ -11477,6 +12278,8 @@ int main(int argc, char *argv[])
       case  3: mainTestCase3 (); break;
       case  2: mainTestCase2 (); break;
       case  1: mainTestCase1 (); break;
+      case -1: mainTestCaseMinus1(); break;
+      case -2: mainTestCaseMinus2(); break;
       default: {
         fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
         testStatus = -1;
@@ -24,8 +24,14 @@ BSLS_IDENT("$Id$ $CSID$")
 #define INCLUDED_BSLSTL_STRING_CPP
 
 #ifdef BSLS_COMPILERFEATURES_SUPPORT_EXTERN_TEMPLATE
-template class bsl::String_Imp<char, bsl::string::size_type>;
-template class bsl::String_Imp<wchar_t, bsl::wstring::size_type>;
+template class bsl::String_Imp<
+             char,
+             bsl::string::size_type,
+             bsl::String_ShortBufferMinBytes<bsl::allocator<char> >::VALUE>;
+template class bsl::String_Imp<
+             wchar_t,
+             bsl::wstring::size_type,
+             bsl::String_ShortBufferMinBytes<bsl::allocator<wchar_t> >::VALUE>;
 template class bsl::basic_string<char>;
 template class bsl::basic_string<wchar_t>;
 #endif
@@ -13,6 +13,7 @@ BSLS_IDENT("$Id: $")
 //  bsl::basic_string: C++ standard compliant 'basic_string' implementation
 //  bsl::string: 'typedef' for 'bsl::basic_string<char>'
 //  bsl::wstring: 'typedef' for 'bsl::basic_string<wchar_t>'
+//  bslstl::ShortStringAllocator: allocator selecting a larger short buffer
 //
 //@SEE_ALSO: ISO C++ Standard, Section 21 [strings]
 //
@@ -62,6 +63,37 @@ BSLS_IDENT("$Id: $")
 // use the default allocator installed at the time of the 'basic_string''s
 // construction (see 'bslma_default').
 //
+///Short String Optimization
+///--------------------------
+// A 'basic_string' stores a string that is short enough directly within its
+// own footprint, in a *short* *string* *buffer*, rather than in memory
+// obtained from its allocator.  By default, the short string buffer occupies
+// 20 bytes, rounded up to a multiple of 'sizeof(size_type)' (e.g., 23
+// 'char' values, plus the null terminator, on 64-bit platforms); a longer
+// string allocates.
+//
+// Clients whose strings are predominantly somewhat longer than that (e.g.,
+// identifiers of 20-40 characters) can select a larger short string buffer at
+// compile time by supplying 'bslstl::ShortStringAllocator<CHAR_TYPE, BYTES>'
+// as the 'ALLOCATOR' template parameter, where 'BYTES' is the minimum size of
+// the short string buffer.  'bslstl::ShortStringAllocator' behaves exactly as
+// 'bsl::allocator' (from which it derives), so such a string has the usual
+// 'bslma'-allocator semantics:
+//..
+//  typedef bsl::basic_string<char,
+//                            bsl::char_traits<char>,
+//                            bslstl::ShortStringAllocator<char, 48> >
+//                                                                  Identifier;
+//
+//  bslma::TestAllocator ta;
+//  Identifier id("NYSE:ABCDEFGH.PRIMARY.2015-06-30", &ta);
+//  assert(0 == ta.numBlocksTotal());
+//..
+// Note that the footprint of the string grows accordingly, and that such a
+// string is a different type from 'bsl::string' (with which it can be
+// compared, and from which it can be assigned, through the 'CHAR_TYPE'
+// pointer overloads, e.g., 'id == str.c_str()').
+//
 ///Lexicographical Comparisons
 ///---------------------------
 // Two 'basic_string's 'lhs' and 'rhs' are lexicographically compared by first
@@ -699,11 +731,88 @@ BSL_OVERRIDES_STD mode"
 #define INCLUDED_ALGORITHM
 #endif
 
+namespace BloombergLP {
+namespace bslstl {
+
+                        // ==========================
+                        // class ShortStringAllocator
+                        // ==========================
+
+template <class TYPE, int SHORT_BUFFER_BYTES>
+class ShortStringAllocator : public bsl::allocator<TYPE> {
+    // This class template is a 'bsl::allocator' that, when supplied as the
+    // 'ALLOCATOR' parameter of 'bsl::basic_string', also specifies the minimum
+    // size (in bytes) of the short string buffer of that string type.  Other
+    // than its type, it is identical to 'bsl::allocator'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(ShortStringAllocator,
+                                   bslmf::IsBitwiseMoveable);
+
+    // PUBLIC TYPES
+    template <class ANY_TYPE>
+    struct rebind {
+        // This nested 'struct' template, parameterized by 'ANY_TYPE', provides
+        // a namespace for an 'other' type alias, which is an allocator type
+        // following the same template as this one but that allocates elements
+        // of 'ANY_TYPE'.
+
+        typedef ShortStringAllocator<ANY_TYPE, SHORT_BUFFER_BYTES> other;
+    };
+
+    // CREATORS
+    ShortStringAllocator();
+        // Create an allocator that forwards allocation calls to the currently
+        // installed default allocator.
+
+    ShortStringAllocator(bslma::Allocator *mechanism);              // IMPLICIT
+        // Create an allocator that forwards allocation calls to the object
+        // pointed to by the specified 'mechanism'.  If 'mechanism' is 0, the
+        // currently installed default allocator is used instead.
+
+    template <class ANY_TYPE>
+    ShortStringAllocator(
+             const ShortStringAllocator<ANY_TYPE, SHORT_BUFFER_BYTES>& other);
+        // Create an allocator sharing the same mechanism object as the
+        // specified 'other' allocator.
+
+    //! ShortStringAllocator(const ShortStringAllocator& original) = default;
+    //! ~ShortStringAllocator() = default;
+    //! ShortStringAllocator& operator=(const ShortStringAllocator&) = default;
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
 namespace bsl {
 
 template <class CHAR_TYPE, class CHAR_TRAITS, class ALLOCATOR>
 class basic_string;
 
+                    // =================================
+                    // struct String_ShortBufferMinBytes
+                    // =================================
+
+template <class ALLOCATOR>
+struct String_ShortBufferMinBytes {
+    // This component-private meta-function provides, as 'VALUE', the minimum
+    // size (in bytes) of the short string buffer of a 'basic_string' using the
+    // (template parameter) 'ALLOCATOR'.
+
+    enum { VALUE = 20 };
+};
+
+template <class TYPE, int SHORT_BUFFER_BYTES>
+struct String_ShortBufferMinBytes<
+         BloombergLP::bslstl::ShortStringAllocator<TYPE, SHORT_BUFFER_BYTES> >
+{
+    // This partial specialization provides the size of the short string
+    // buffer selected by a 'bslstl::ShortStringAllocator'.
+
+    enum { VALUE = SHORT_BUFFER_BYTES };
+};
+
 #if defined(BSLS_PLATFORM_CMP_SUN) || defined(BSLS_PLATFORM_CMP_HP)
 template <class ORIGINAL_TRAITS>
 class String_Traits {
@@ -779,13 +888,14 @@ String_Traits<native_std::char_traits<char> >::find(const char  *s,
                         // class String_Imp
                         // ================
 
-template <class CHAR_TYPE, class SIZE_TYPE>
+template <class CHAR_TYPE, class SIZE_TYPE, int MIN_BYTES>
 class String_Imp {
     // This component private 'class' describes the basic data layout for a
     // string class and provides methods to help encapsulate internal string
-    // implementation details.  It is parameterized by 'CHAR_TYPE' and
-    // 'SIZE_TYPE' only, and implements the portion of 'basic_string' that does
-    // not need to know about its parameterized 'CHAR_TRAITS' or 'ALLOCATOR'.
+    // implementation details.  It is parameterized by 'CHAR_TYPE',
+    // 'SIZE_TYPE', and the minimum size of the short string buffer only, and
+    // implements the portion of 'basic_string' that does not need to know
+    // about its parameterized 'CHAR_TRAITS' or 'ALLOCATOR'.
     // It contains the following data fields: pointer to string, short string
     // buffer, length, and capacity.  The purpose of the short string buffer is
     // to implement a "short string optimization" such that strings with
@@ -808,7 +918,8 @@ class String_Imp {
         // value.  It defines the capacity of the short string buffer and also
         // the capacity of the default-constructed empty string object.
 
-        SHORT_BUFFER_MIN_BYTES  = 20, // minimum required size of the short
+        SHORT_BUFFER_MIN_BYTES  = MIN_BYTES,
+                                      // minimum required size of the short
                                       // string buffer in bytes
 
         SHORT_BUFFER_NEED_BYTES =
@@ -949,7 +1060,9 @@ template <class CHAR_TYPE,
           class CHAR_TRAITS = char_traits<CHAR_TYPE>,
           class ALLOCATOR = allocator<CHAR_TYPE> >
 class basic_string
-    : private String_Imp<CHAR_TYPE, typename ALLOCATOR::size_type>
+    : private String_Imp<CHAR_TYPE,
+                         typename ALLOCATOR::size_type,
+                         String_ShortBufferMinBytes<ALLOCATOR>::VALUE>
     , public BloombergLP::bslalg::ContainerBase<ALLOCATOR>
 {
     // This class template provides an STL-compliant 'string' that conforms to
@@ -1003,7 +1116,9 @@ class basic_string
 
   private:
     // PRIVATE TYPES
-    typedef String_Imp<CHAR_TYPE, typename ALLOCATOR::size_type> Imp;
+    typedef String_Imp<CHAR_TYPE,
+                       typename ALLOCATOR::size_type,
+                       String_ShortBufferMinBytes<ALLOCATOR>::VALUE> Imp;
 
     // PRIVATE MANIPULATORS
 
@@ -2411,17 +2526,53 @@ void hashAppend(
 // ============================================================================
 // See IMPLEMENTATION NOTES in the '.cpp' before modifying anything below.
 
+namespace BloombergLP {
+namespace bslstl {
+
+                        // --------------------------
+                        // class ShortStringAllocator
+                        // --------------------------
+
+// CREATORS
+template <class TYPE, int SHORT_BUFFER_BYTES>
+inline
+ShortStringAllocator<TYPE, SHORT_BUFFER_BYTES>::ShortStringAllocator()
+: bsl::allocator<TYPE>()
+{
+}
+
+template <class TYPE, int SHORT_BUFFER_BYTES>
+inline
+ShortStringAllocator<TYPE, SHORT_BUFFER_BYTES>::ShortStringAllocator(
+                                                  bslma::Allocator *mechanism)
+: bsl::allocator<TYPE>(mechanism)
+{
+}
+
+template <class TYPE, int SHORT_BUFFER_BYTES>
+template <class ANY_TYPE>
+inline
+ShortStringAllocator<TYPE, SHORT_BUFFER_BYTES>::ShortStringAllocator(
+              const ShortStringAllocator<ANY_TYPE, SHORT_BUFFER_BYTES>& other)
+: bsl::allocator<TYPE>(other.mechanism())
+{
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
 namespace bsl {
                           // ----------------
                           // class String_Imp
                           // ----------------
 
 // CLASS METHODS
-template <class CHAR_TYPE, class SIZE_TYPE>
+template <class CHAR_TYPE, class SIZE_TYPE, int MIN_BYTES>
 SIZE_TYPE
-String_Imp<CHAR_TYPE, SIZE_TYPE>::computeNewCapacity(SIZE_TYPE newLength,
-                                                     SIZE_TYPE oldCapacity,
-                                                     SIZE_TYPE maxSize)
+String_Imp<CHAR_TYPE, SIZE_TYPE, MIN_BYTES>::computeNewCapacity(
+                                                         SIZE_TYPE newLength,
+                                                         SIZE_TYPE oldCapacity,
+                                                         SIZE_TYPE maxSize)
 {
     BSLS_ASSERT_SAFE(newLength >= oldCapacity);
 
@@ -2448,19 +2599,19 @@ String_Imp<CHAR_TYPE, SIZE_TYPE>::computeNewCapacity(SIZE_TYPE newLength,
 }
 
 // CREATORS
-template <class CHAR_TYPE, class SIZE_TYPE>
+template <class CHAR_TYPE, class SIZE_TYPE, int MIN_BYTES>
 inline
-String_Imp<CHAR_TYPE, SIZE_TYPE>::String_Imp()
+String_Imp<CHAR_TYPE, SIZE_TYPE, MIN_BYTES>::String_Imp()
 : d_start_p(0)
 , d_length(0)
 , d_capacity(SHORT_BUFFER_CAPACITY)
 {
 }
 
-template <class CHAR_TYPE, class SIZE_TYPE>
+template <class CHAR_TYPE, class SIZE_TYPE, int MIN_BYTES>
 inline
-String_Imp<CHAR_TYPE, SIZE_TYPE>::String_Imp(SIZE_TYPE length,
-                                             SIZE_TYPE capacity)
+String_Imp<CHAR_TYPE, SIZE_TYPE, MIN_BYTES>::String_Imp(SIZE_TYPE length,
+                                                        SIZE_TYPE capacity)
 : d_start_p(0)
 , d_length(length)
 , d_capacity(capacity <= static_cast<SIZE_TYPE>(SHORT_BUFFER_CAPACITY)
@@ -2470,8 +2621,9 @@ String_Imp<CHAR_TYPE, SIZE_TYPE>::String_Imp(SIZE_TYPE length,
 }
 
 // MANIPULATORS
-template <class CHAR_TYPE, class SIZE_TYPE>
-void String_Imp<CHAR_TYPE, SIZE_TYPE>::swap(String_Imp& other)
+template <class CHAR_TYPE, class SIZE_TYPE, int MIN_BYTES>
+void
+String_Imp<CHAR_TYPE, SIZE_TYPE, MIN_BYTES>::swap(String_Imp& other)
 {
     if (!isShortString() && !other.isShortString()) {
         // If both strings are long, swap the individual fields.
@@ -2487,18 +2639,18 @@ void String_Imp<CHAR_TYPE, SIZE_TYPE>::swap(String_Imp& other)
 }
 
 // PRIVATE MANIPULATORS
-template <class CHAR_TYPE, class SIZE_TYPE>
+template <class CHAR_TYPE, class SIZE_TYPE, int MIN_BYTES>
 inline
-void String_Imp<CHAR_TYPE, SIZE_TYPE>::resetFields()
+void String_Imp<CHAR_TYPE, SIZE_TYPE, MIN_BYTES>::resetFields()
 {
     d_start_p  = 0;
     d_length   = 0;
     d_capacity = SHORT_BUFFER_CAPACITY;
 }
 
-template <class CHAR_TYPE, class SIZE_TYPE>
+template <class CHAR_TYPE, class SIZE_TYPE, int MIN_BYTES>
 inline
-CHAR_TYPE *String_Imp<CHAR_TYPE, SIZE_TYPE>::dataPtr()
+CHAR_TYPE *String_Imp<CHAR_TYPE, SIZE_TYPE, MIN_BYTES>::dataPtr()
 {
     return isShortString()
            ? reinterpret_cast<CHAR_TYPE *>((void *)d_short.buffer())
@@ -2506,16 +2658,17 @@ CHAR_TYPE *String_Imp<CHAR_TYPE, SIZE_TYPE>::dataPtr()
 }
 
 // PRIVATE ACCESSORS
-template <class CHAR_TYPE, class SIZE_TYPE>
+template <class CHAR_TYPE, class SIZE_TYPE, int MIN_BYTES>
 inline
-bool String_Imp<CHAR_TYPE, SIZE_TYPE>::isShortString() const
+bool String_Imp<CHAR_TYPE, SIZE_TYPE, MIN_BYTES>::isShortString() const
 {
     return d_capacity == SHORT_BUFFER_CAPACITY;
 }
 
-template <class CHAR_TYPE, class SIZE_TYPE>
+template <class CHAR_TYPE, class SIZE_TYPE, int MIN_BYTES>
 inline
-const CHAR_TYPE *String_Imp<CHAR_TYPE, SIZE_TYPE>::dataPtr() const
+const CHAR_TYPE *
+String_Imp<CHAR_TYPE, SIZE_TYPE, MIN_BYTES>::dataPtr() const
 {
     return isShortString()
           ? reinterpret_cast<const CHAR_TYPE *>((const void *)d_short.buffer())
@@ -5719,8 +5872,14 @@ struct UsesBslmaAllocator<bsl::basic_string<CHAR_TYPE, CHAR_TRAITS, ALLOC> >
 #undef BSLSTL_CHAR_TRAITS
 
 #ifdef BSLS_COMPILERFEATURES_SUPPORT_EXTERN_TEMPLATE
-extern template class bsl::String_Imp<char, bsl::string::size_type>;
-extern template class bsl::String_Imp<wchar_t, bsl::wstring::size_type>;
+extern template class bsl::String_Imp<
+             char,
+             bsl::string::size_type,
+             bsl::String_ShortBufferMinBytes<bsl::allocator<char> >::VALUE>;
+extern template class bsl::String_Imp<
+             wchar_t,
+             bsl::wstring::size_type,
+             bsl::String_ShortBufferMinBytes<bsl::allocator<wchar_t> >::VALUE>;
 extern template class bsl::basic_string<char>;
 extern template class bsl::basic_string<wchar_t>;
 #endif
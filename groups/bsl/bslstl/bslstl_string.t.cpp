@@ -250,10 +250,13 @@ using namespace std;
 //                                      const string& str);
 // [29] hashAppend(HASHALG& hashAlg, const basic_string& str);
 // [29] hashAppend(HASHALG& hashAlg, const native_std::basic_string& str);
+// [30] bslstl::ShortStringAllocator
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [11] ALLOCATOR-RELATED CONCERNS
 // [25] CONCERN: 'std::length_error' is used properly
+// [31] USAGE EXAMPLE
+// [-2] PERFORMANCE: SHORT STRING BUFFER SIZE
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 // [ 3] int ggg(string *object, const char *spec, int vF = 1);
@@ -361,7 +364,11 @@ typedef bsls::Types::Uint64     Uint64;
 // TEST OBJECT (unless o/w specified)
 typedef char                                             Element;
 typedef bsl::basic_string<char, bsl::char_traits<char> > Obj;
-typedef bsl::String_Imp<char, size_t>                    Imp;
+typedef bsl::String_Imp<
+              char,
+              size_t,
+              bsl::String_ShortBufferMinBytes<bsl::allocator<char> >::VALUE>
+                                                         Imp;
 
 // CONSTANTS
 const int MAX_ALIGN      = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
@@ -387,11 +394,21 @@ const int  LARGE_SIZE_VALUE = 2 * bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
     // Declare a large value for insertions into the string.  Note this value
     // will cause multiple resizes during insertion into the string.
 
-const size_t SHORT_STRING_BUFFER_BYTES
-                           = (20 + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
-    // The size of the short string buffer, according to our implementation (20
-    // bytes rounded to the word boundary - 1).  Appending one more than this
-    // number of characters to a default object causes a reallocation.
+template <class ALLOC>
+struct ShortStringBufferBytes {
+    // This meta-function provides, as 'VALUE', the size of the short string
+    // buffer of a string using the (template parameter) 'ALLOC', according to
+    // our implementation (20 bytes, or the size selected by a
+    // 'bslstl::ShortStringAllocator', rounded to the word boundary).  A
+    // default object holds one character fewer than fits in this buffer
+    // without allocating.
+
+    enum {
+        VALUE = (bsl::String_ShortBufferMinBytes<ALLOC>::VALUE
+                                                        + sizeof(size_t) - 1)
+              & ~(sizeof(size_t) - 1)
+    };
+};
 
 const size_t INITIAL_CAPACITY_FOR_NON_EMPTY_OBJECT = 1;
                                 // bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT - 1;
@@ -861,6 +878,8 @@ struct TestDriver {
 
     // CONSTANTS
     enum {
+        SHORT_STRING_BUFFER_BYTES = ShortStringBufferBytes<ALLOC>::VALUE,
+
         DEFAULT_CAPACITY = SHORT_STRING_BUFFER_BYTES / sizeof(TYPE) > 0
                                 ? SHORT_STRING_BUFFER_BYTES / sizeof(TYPE) - 1
                                 : 0
@@ -13716,6 +13735,37 @@ void TestDriver<TYPE,TRAITS,ALLOC>::testCaseM1(const int /* NITER */,
     // F3) FIND_FIRST_NOT_OF AND FIND_LAST_NOT_OF OPERATIONS
 }
 
+template <class STRING>
+double timeKeyCopies(int length, int numKeys)
+    // Return the time, in seconds, taken to create, copy, and destroy the
+    // specified 'numKeys' distinct strings of type (template parameter)
+    // 'STRING', each having the specified 'length'.  The behavior is undefined
+    // unless '0 < length < 64'.
+{
+    char key[64];
+    for (int i = 0; i < length; ++i) {
+        key[i] = static_cast<char>('A' + i % 26);
+    }
+
+    bsls::Stopwatch timer;
+    size_t          total = 0;
+
+    timer.start();
+    for (int i = 0; i < numKeys; ++i) {
+        key[i % length] = static_cast<char>('a' + i % 26);
+
+        STRING       original(key, length);
+        const STRING copy(original);
+
+        total += copy.length();
+    }
+    timer.stop();
+
+    ASSERT(static_cast<size_t>(length) * numKeys == total);
+
+    return timer.elapsedTime();
+}
+
 //=============================================================================
 //                                USAGE EXAMPLE
 //-----------------------------------------------------------------------------
@@ -14091,7 +14141,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 30: {
+      case 31: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -14303,6 +14353,118 @@ int main(int argc, char *argv[])
             }
         }
       } break;
+      case 30: {
+        // --------------------------------------------------------------------
+        // TESTING 'bslstl::ShortStringAllocator'
+        //
+        // Concerns:
+        //: 1 A string using 'bslstl::ShortStringAllocator<C, N>' has a short
+        //:   string buffer of (at least) 'N' bytes, and does not allocate
+        //:   until its length exceeds the capacity of that buffer.
+        //:
+        //: 2 Such a string behaves as one using 'bsl::allocator' in every
+        //:   other respect, including the use of the allocator supplied at
+        //:   construction (or the default allocator) to supply memory.
+        //:
+        //: 3 'bslstl::ShortStringAllocator' is convertible from
+        //:   'bslma::Allocator *', rebinds to itself, and compares equal to
+        //:   another allocator having the same mechanism.
+        //:
+        //: 4 The default short string buffer is unchanged.
+        //
+        // Plan:
+        //: 1 Instantiate the test driver with 'ShortStringAllocator' for
+        //:   several buffer sizes and character types, and rerun the test
+        //:   cases for the primary manipulators, copy construction,
+        //:   assignment, 'append', 'insert', 'replace', 'swap', and the short
+        //:   string optimization.  (C-1..2)
+        //:
+        //: 2 Directly verify the conversions, the nested 'rebind', the
+        //:   traits, and the capacity of default-constructed strings.
+        //:   (C-3..4)
+        //
+        // Testing:
+        //   bslstl::ShortStringAllocator
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'bslstl::ShortStringAllocator'"
+                            "\n======================================\n");
+
+        typedef bslstl::ShortStringAllocator<char, 48>    CharAlloc48;
+        typedef bslstl::ShortStringAllocator<char, 64>    CharAlloc64;
+        typedef bslstl::ShortStringAllocator<wchar_t, 64> WcharAlloc64;
+
+        if (verbose) printf("\n... with 'char' and 48 bytes.\n");
+        {
+            typedef TestDriver<char, bsl::char_traits<char>, CharAlloc48> TD;
+
+            TD::testCase2();
+            TD::testCase7();
+            TD::testCase9();
+            TD::testCase17();
+            TD::testCase18();
+            TD::testCase20();
+            TD::testCase21();
+            TD::testCase28();
+        }
+
+        if (verbose) printf("\n... with 'char' and 64 bytes.\n");
+        {
+            typedef TestDriver<char, bsl::char_traits<char>, CharAlloc64> TD;
+
+            TD::testCase2();
+            TD::testCase21();
+            TD::testCase28();
+        }
+
+        if (verbose) printf("\n... with 'wchar_t' and 64 bytes.\n");
+        {
+            typedef TestDriver<wchar_t,
+                               bsl::char_traits<wchar_t>,
+                               WcharAlloc64> TD;
+
+            TD::testCase2();
+            TD::testCase21();
+            TD::testCase28();
+        }
+
+        if (verbose) printf("\nAllocator conversions and traits.\n");
+        {
+            typedef bsl::basic_string<char,
+                                      bsl::char_traits<char>,
+                                      CharAlloc48> String48;
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            const CharAlloc48 A(&ta);
+            ASSERT(&ta == A.mechanism());
+            ASSERT(defaultAllocator_p == CharAlloc48().mechanism());
+
+            const bslstl::ShortStringAllocator<int, 48> B(A);
+            ASSERT(&ta == B.mechanism());
+            ASSERT(A == B);
+
+            ASSERT((bsl::is_same<
+                            CharAlloc48::rebind<int>::other,
+                            bslstl::ShortStringAllocator<int, 48> >::value));
+
+            ASSERT(bslma::UsesBslmaAllocator<String48>::value);
+            ASSERT(bslmf::IsBitwiseMoveable<String48>::value);
+
+            ASSERT(sizeof(bsl::string) < sizeof(String48));
+            ASSERT(23 <= bsl::string().capacity());
+            ASSERT(47 <= String48().capacity());
+
+            String48 mX(&ta);  const String48& X = mX;
+            ASSERT(&ta == X.get_allocator().mechanism());
+
+            mX.assign(47, 'x');
+            ASSERT(0 == ta.numBlocksTotal());
+            mX.push_back('y');
+            ASSERT(1 == ta.numBlocksInUse());
+            ASSERT(X == (bsl::string(47, 'x') + 'y').c_str());
+        }
+      } break;
       case 29: {
         // --------------------------------------------------------------------
         // TESTING 'hashAppend'
@@ -15355,6 +15517,57 @@ int main(int argc, char *argv[])
         TestDriver<char>::testCaseM1(NITER, RANDOM_SEED);
 
       } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: SHORT STRING BUFFER SIZE
+        //
+        // Concerns:
+        //: 1 Strings whose length exceeds the default short string buffer but
+        //:   fits in a larger one selected by 'bslstl::ShortStringAllocator'
+        //:   are created and copied faster with the larger buffer.
+        //
+        // Plan:
+        //: 1 For a set of typical key lengths, create and copy a number of
+        //:   keys (specified on the command line, default 1000000) using
+        //:   'bsl::string' and strings with 48 and 64 byte short string
+        //:   buffers, and report the elapsed times.
+        //
+        // Testing:
+        //   PERFORMANCE: SHORT STRING BUFFER SIZE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nPERFORMANCE: SHORT STRING BUFFER SIZE"
+                            "\n=====================================\n");
+
+        typedef bsl::basic_string<char,
+                                  bsl::char_traits<char>,
+                                  bslstl::ShortStringAllocator<char, 48> >
+                                                                    String48;
+        typedef bsl::basic_string<char,
+                                  bsl::char_traits<char>,
+                                  bslstl::ShortStringAllocator<char, 64> >
+                                                                    String64;
+
+        const int NUM_KEYS = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+        bslma::DefaultAllocatorGuard guard(
+                                      &bslma::NewDeleteAllocator::singleton());
+
+        static const int LENGTHS[] = { 8, 16, 20, 24, 32, 40, 48, 56 };
+        const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        printf("%8s %12s %12s %12s\n", "LENGTH", "string", "String48",
+                                                                  "String64");
+        for (int i = 0; i < NUM_LENGTHS; ++i) {
+            const int LENGTH = LENGTHS[i];
+
+            printf("%8d %12f %12f %12f\n",
+                   LENGTH,
+                   timeKeyCopies<bsl::string>(LENGTH, NUM_KEYS),
+                   timeKeyCopies<String48>(LENGTH, NUM_KEYS),
+                   timeKeyCopies<String64>(LENGTH, NUM_KEYS));
+        }
+      } break;
       default: {
         fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
         testStatus = -1;
@@ -19,6 +19,14 @@ BSLS_IDENT("$Id$ $CSID$")
 // Moreover, in the spirit of template hoisting (providing functionality to all
 // all templates in a non-templated utility class), the 'swap' methods is
 // implemented below since its definition does not care about the value type.
+// The same is true of 'reallocate', which lets a vector of bitwise-moveable
+// elements grow its storage in place (or by remapping pages rather than
+// copying elements) when its allocator implements the
+// 'bslma::ReallocatingAllocator' protocol.  Detecting that protocol requires
+// a 'dynamic_cast', whose cost is negligible compared to that of the
+// reallocation itself, and which is done only when the capacity grows.
+
+#include <bslma_reallocatingallocator.h>
 
 #include <bsls_assert.h>
 
@@ -70,6 +78,26 @@ std::size_t Vector_Util::computeNewCapacity(std::size_t newLength,
     return capacity > maxSize ? maxSize : capacity;
 }
 
+void *Vector_Util::reallocate(BloombergLP::bslma::Allocator *allocator,
+                              void                          *address,
+                              std::size_t                    oldSize,
+                              std::size_t                    newSize)
+{
+    BSLS_ASSERT_SAFE(allocator);
+    BSLS_ASSERT_SAFE(0 < newSize);
+
+    BloombergLP::bslma::ReallocatingAllocator *reallocator =
+          dynamic_cast<BloombergLP::bslma::ReallocatingAllocator *>(allocator);
+
+    return reallocator ? reallocator->reallocate(address, oldSize, newSize)
+                       : 0;
+}
+
+void *Vector_Util::reallocate(void *, void *, std::size_t, std::size_t)
+{
+    return 0;
+}
+
 void Vector_Util::swap(void *a, void *b)
 {
     Vector_Base& aVector = *(Vector_Base *)a;
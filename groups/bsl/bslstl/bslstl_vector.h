@@ -97,6 +97,16 @@ BSLS_IDENT("$Id: $")
 // of the (template parameter) type 'VALUE_TYPE', if it defines the
 // 'bslalg::TypeTraitUsesBslmaAllocator' trait.
 //
+// If the supplied 'bslma::Allocator' also implements the
+// 'bslma::ReallocatingAllocator' protocol (e.g., 'bslma::MallocFreeAllocator')
+// and 'VALUE_TYPE' is bitwise-moveable (see 'bslmf_isbitwisemoveable'), then
+// a vector that must grow its capacity when appending elements (e.g., via
+// 'push_back', 'resize', or 'insert' at 'end') or in 'reserve', does so by
+// calling 'reallocate' on its existing storage rather than by allocating new
+// storage and moving its elements.  Depending on the allocator, this may
+// extend the storage in place, or (for large vectors) move it without copying
+// its contents.
+//
 ///Operations
 ///----------
 // This section describes the run-time complexity of operations on instances
@@ -540,6 +550,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslmf_enableif.h>
 #endif
 
+#ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
+#include <bslmf_isbitwisemoveable.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ISFUNCTION
 #include <bslmf_isfunction.h>
 #endif
@@ -584,6 +598,10 @@ BSL_OVERRIDES_STD mode"
 #include <bsls_types.h>
 #endif
 
+#ifndef INCLUDED_BSLS_UTIL
+#include <bsls_util.h>
+#endif
+
 #ifndef INCLUDED_CSTDDEF
 #include <cstddef>
 #define INCLUDED_CSTDDEF
@@ -606,9 +624,11 @@ namespace bsl {
 
 struct Vector_Util {
     // This 'struct' provides a namespace to implement the 'swap' member
-    // function of 'Vector_Imp<VALUE_TYPE, ALLOCATOR>'.  This function can be
+    // function of 'Vector_Imp<VALUE_TYPE, ALLOCATOR>', and the reallocation of
+    // its storage through an allocator implementing the
+    // 'bslma::ReallocatingAllocator' protocol.  These functions can be
     // implemented irrespective of the 'VALUE_TYPE' or 'ALLOCATOR' template
-    // parameters which is why we implement it in this non-templated,
+    // parameters which is why we implement them in this non-templated,
     // non-inlined utility.
 
     // CLASS METHODS
@@ -621,6 +641,29 @@ struct Vector_Util {
         // and 'newLength <= maxSize'.  Note that the returned value is always
         // at most 'maxSize'.
 
+    static void *reallocate(BloombergLP::bslma::Allocator *allocator,
+                            void                          *address,
+                            std::size_t                    oldSize,
+                            std::size_t                    newSize);
+        // Resize the memory block at the specified 'address' having the
+        // specified 'oldSize' (in bytes) to the specified 'newSize' (in bytes)
+        // by calling 'reallocate' on the specified 'allocator', and return the
+        // address of the resulting block, if 'allocator' implements the
+        // 'bslma::ReallocatingAllocator' protocol; otherwise return 0 with no
+        // effect.  If an exception is thrown, the block at 'address' is
+        // unaffected.  The behavior is undefined unless 'address' was
+        // allocated from 'allocator' with the size 'oldSize', and
+        // '0 < newSize'.
+
+    static void *reallocate(void        *allocator,
+                            void        *address,
+                            std::size_t  oldSize,
+                            std::size_t  newSize);
+        // Return 0 with no effect.  Note that this overload is selected for
+        // vectors whose allocator is not based on 'bslma::Allocator', and the
+        // specified 'allocator', 'address', 'oldSize', and 'newSize' are
+        // ignored.
+
     static void swap(void *a, void *b);
         // Exchange the value of the specified 'a' vector with that of the
         // specified 'b' vector.
@@ -908,6 +951,19 @@ class Vector_Imp : public Vector_ImpBase<VALUE_TYPE>
         // duplicate copies after importing from an input iterator into a
         // temporary vector.
 
+    bool privateReallocate(size_type          newCapacity,
+                           const VALUE_TYPE **alias);
+        // Attempt to grow the storage of this vector to exactly the specified
+        // 'newCapacity' by reallocating it in place (see
+        // 'bslma_reallocatingallocator'), and return 'true' on success, or
+        // 'false' with no effect if the allocator of this vector does not
+        // support reallocation, if 'VALUE_TYPE' is not bitwise-moveable, or if
+        // this vector has no capacity.  If the specified 'alias' is not 0 and
+        // '*alias' refers to an element of this vector, '*alias' is updated
+        // to refer to the same element after the reallocation.  If an
+        // exception is thrown, this vector is unaffected.  The behavior is
+        // undefined unless 'capacity() < newCapacity <= max_size()'.
+
     void privateReserveEmpty(size_type numElements);
         // Reserve exactly the specified 'numElements'.  The behavior is
         // undefined unless this vector is empty and has no capacity.
@@ -2422,6 +2478,44 @@ void Vector_Imp<VALUE_TYPE, ALLOCATOR>::privateMoveInsert(
     }
 }
 
+template <class VALUE_TYPE, class ALLOCATOR>
+bool Vector_Imp<VALUE_TYPE, ALLOCATOR>::privateReallocate(
+                                                size_type          newCapacity,
+                                                const VALUE_TYPE **alias)
+{
+    BSLS_ASSERT_SAFE(this->d_capacity < newCapacity);
+
+    if (!BloombergLP::bslmf::IsBitwiseMoveable<VALUE_TYPE>::value
+     || 0 == this->d_capacity) {
+        return false;                                                 // RETURN
+    }
+
+    const size_type length = this->size();
+
+    std::ptrdiff_t aliasIndex = -1;
+    if (alias && this->d_dataBegin <= *alias && *alias < this->d_dataEnd) {
+        aliasIndex = *alias - this->d_dataBegin;
+    }
+
+    void *address = Vector_Util::reallocate(
+                                       this->bslmaAllocator(),
+                                       this->d_dataBegin,
+                                       this->d_capacity * sizeof(VALUE_TYPE),
+                                       newCapacity * sizeof(VALUE_TYPE));
+    if (!address) {
+        return false;                                                 // RETURN
+    }
+
+    this->d_dataBegin = static_cast<VALUE_TYPE *>(address);
+    this->d_dataEnd   = this->d_dataBegin + length;
+    this->d_capacity  = newCapacity;
+
+    if (0 <= aliasIndex) {
+        *alias = this->d_dataBegin + aliasIndex;
+    }
+    return true;
+}
+
 template <class VALUE_TYPE, class ALLOCATOR>
 inline
 void Vector_Imp<VALUE_TYPE, ALLOCATOR>::privateReserveEmpty(
@@ -2683,7 +2777,8 @@ void Vector_Imp<VALUE_TYPE, ALLOCATOR>::reserve(size_type newCapacity)
     if (0 == this->d_capacity && 0 != newCapacity) {
         privateReserveEmpty(newCapacity);
     }
-    else if (this->d_capacity < newCapacity) {
+    else if (this->d_capacity < newCapacity
+          && !privateReallocate(newCapacity, 0)) {
         Vector_Imp temp(this->get_allocator());
         temp.privateReserveEmpty(newCapacity);
 
@@ -3668,6 +3763,23 @@ void Vector_Imp<VALUE_TYPE, ALLOCATOR>::insert(const_iterator    position,
                                                               newSize,
                                                               this->d_capacity,
                                                               maxSize);
+
+        // When appending, the existing elements need not be moved relative to
+        // one another, so we first try to grow the storage in place (see
+        // 'privateReallocate'), which also covers 'push_back' and 'resize'.
+
+        const VALUE_TYPE *valuePtr = BSLS_UTIL_ADDRESSOF(value);
+        if (pos == this->d_dataEnd
+         && privateReallocate(newCapacity, &valuePtr)) {
+            BloombergLP::bslalg::ArrayPrimitives::uninitializedFillN(
+                                                       this->d_dataEnd,
+                                                       numElements,
+                                                       *valuePtr,
+                                                       this->bslmaAllocator());
+            this->d_dataEnd += numElements;
+            return;                                                   // RETURN
+        }
+
         Vector_Imp temp(this->get_allocator());
         temp.privateReserveEmpty(newCapacity);
 
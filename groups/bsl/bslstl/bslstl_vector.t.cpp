@@ -9,7 +9,9 @@
 #include <bslma_allocator.h>
 #include <bslma_default.h>
 #include <bslma_defaultallocatorguard.h>
+#include <bslma_mallocfreeallocator.h>
 #include <bslma_newdeleteallocator.h>
+#include <bslma_reallocatingallocator.h>
 #include <bslma_testallocator.h>
 #include <bslma_testallocatorexception.h>
 
@@ -18,6 +20,7 @@
 #include <bsls_alignmentutil.h>
 #include <bsls_assert.h>
 #include <bsls_asserttest.h>
+#include <bsls_bslexceptionutil.h>
 #include <bsls_bsltestutil.h>
 #include <bsls_exceptionutil.h>
 #include <bsls_objectbuffer.h>
@@ -35,6 +38,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
 
 
 using namespace BloombergLP;
@@ -153,10 +157,11 @@ using namespace bsl;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [11] ALLOCATOR-RELATED CONCERNS
-// [25] USAGE EXAMPLE
+// [28] USAGE EXAMPLE
 // [21] CONCERN: 'std::length_error' is used properly
 // [23] DRQS 31711031
 // [24] DRQS 34693876
+// [27] CONCERN: growth uses 'bslma::ReallocatingAllocator' when possible
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 // [ 3] int ggg(vector<T,A> *object, const char *spec, int vF = 1);
@@ -442,6 +447,92 @@ const Arg3  VA3(3);
 const Arg4  VA4(4);
 const Arg5  VA5(5);
 
+                     // ===============================
+                     // class ReallocatingTestAllocator
+                     // ===============================
+
+class ReallocatingTestAllocator : public bslma::ReallocatingAllocator {
+    // This class implements the 'bslma::ReallocatingAllocator' protocol using
+    // 'malloc' and 'free', and counts the number of successful calls to
+    // 'reallocate', and the number of blocks in use.  A successful call to
+    // 'reallocate' of a non-null block *always* moves the block and scribbles
+    // over its former contents before freeing it, so that any stale reference
+    // into the old block is detected.  'reallocate' can also be configured to
+    // fail by throwing 'std::bad_alloc'.
+
+    // DATA
+    int  d_numReallocations;  // number of successful calls to 'reallocate'
+    int  d_numBlocksInUse;    // number of blocks currently allocated
+    bool d_reallocateFails;   // if 'true', 'reallocate' throws
+
+  private:
+    // NOT IMPLEMENTED
+    ReallocatingTestAllocator(const ReallocatingTestAllocator&);
+    ReallocatingTestAllocator& operator=(const ReallocatingTestAllocator&);
+
+  public:
+    // CREATORS
+    ReallocatingTestAllocator()
+    : d_numReallocations(0)
+    , d_numBlocksInUse(0)
+    , d_reallocateFails(false)
+    {
+    }
+
+    virtual ~ReallocatingTestAllocator()
+    {
+        ASSERTV(d_numBlocksInUse, 0 == d_numBlocksInUse);
+    }
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size)
+    {
+        if (!size) {
+            return 0;                                                 // RETURN
+        }
+        ++d_numBlocksInUse;
+        return malloc(size);
+    }
+
+    virtual void deallocate(void *address)
+    {
+        if (address) {
+            --d_numBlocksInUse;
+            free(address);
+        }
+    }
+
+    virtual void *reallocate(void      *address,
+                             size_type  oldSize,
+                             size_type  newSize)
+    {
+        if (!address) {
+            return allocate(newSize);                                 // RETURN
+        }
+        if (!newSize) {
+            deallocate(address);
+            return 0;                                                 // RETURN
+        }
+        if (d_reallocateFails) {
+            bsls::BslExceptionUtil::throwBadAlloc();
+        }
+
+        void *result = malloc(newSize);
+        memcpy(result, address, oldSize < newSize ? oldSize : newSize);
+        memset(address, 0xa5, oldSize);
+        free(address);
+
+        ++d_numReallocations;
+        return result;
+    }
+
+    void setReallocateFails(bool value) { d_reallocateFails = value; }
+
+    // ACCESSORS
+    int numReallocations() const { return d_numReallocations; }
+    int numBlocksInUse() const { return d_numBlocksInUse; }
+};
+
                                // ==============
                                // class TestType
                                // ==============
@@ -1470,6 +1561,9 @@ struct TestDriver {
     static void testCaseM1();
         // Performance test.
 
+    static void testCase27();
+        // Test growth through a reallocating allocator.
+
     static void testCase22();
         // Test overloaded new/delete.
 
@@ -2318,6 +2412,232 @@ void TestDriver<TYPE,ALLOC>::testCaseM1()
     }
 }
 
+template <class TYPE, class ALLOC>
+void TestDriver<TYPE,ALLOC>::testCase27()
+{
+    // --------------------------------------------------------------------
+    // TESTING GROWTH THROUGH A REALLOCATING ALLOCATOR
+    //
+    // Concerns:
+    //: 1 When the allocator of a vector of bitwise-moveable elements
+    //:   implements the 'bslma::ReallocatingAllocator' protocol, appending
+    //:   beyond the capacity (via 'push_back', 'insert' at 'end', and
+    //:   'resize') and 'reserve' grow the existing storage by calling
+    //:   'reallocate' rather than allocating a new block.
+    //:
+    //: 2 Elements that are not bitwise-moveable are never reallocated.
+    //:
+    //: 3 The value of the vector is preserved by the reallocation.
+    //:
+    //: 4 Appending an element of the vector itself is correct even if the
+    //:   reallocation moves the storage.
+    //:
+    //: 5 Insertion other than at the end does not use 'reallocate'.
+    //:
+    //: 6 If 'reallocate' throws, the vector is unchanged.
+    //:
+    //: 7 No memory is leaked.
+    //
+    // Plan:
+    //: 1 Using a 'ReallocatingTestAllocator', which always moves a
+    //:   reallocated block and scribbles over its old contents, grow vectors
+    //:   of various lengths one element at a time, and verify after each
+    //:   capacity change that 'reallocate' was called if and only if 'TYPE'
+    //:   is bitwise-moveable and the capacity was not 0, and that the value
+    //:   of the vector is as expected.  (C-1..3)
+    //:
+    //: 2 For each vector filled to capacity, append copies of its own
+    //:   elements using 'push_back' and 'insert', and verify the result.
+    //:   (C-4)
+    //:
+    //: 3 Insert at the beginning of a full vector, and verify that
+    //:   'reallocate' is not called.  (C-5)
+    //:
+    //: 4 Configure 'reallocate' to throw, append to a full vector, and
+    //:   verify that the vector is unchanged.  (C-6)
+    //:
+    //: 5 Verify that the allocator has no blocks in use at the end of each
+    //:   scenario.  (C-7)
+    //
+    // Testing:
+    //   CONCERN: growth uses 'bslma::ReallocatingAllocator' when possible
+    // --------------------------------------------------------------------
+
+    const TYPE *VALUES;
+    const int   NUM_VALUES = getValues(&VALUES);
+
+    const bool IS_MOVEABLE = bslmf::IsBitwiseMoveable<TYPE>::value;
+
+    if (veryVerbose) { T_ P(IS_MOVEABLE) }
+
+    static const int LENGTHS[] = { 1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 100, 257 };
+    const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+    if (verbose) printf("\tTesting 'push_back' and 'reserve'.\n");
+
+    for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+        const int LENGTH = LENGTHS[ti];
+
+        ReallocatingTestAllocator ra;
+        {
+            Obj mX(&ra);  const Obj& X = mX;
+
+            int numCapacityChanges = 0;
+            for (int i = 0; i < LENGTH; ++i) {
+                const std::size_t CAPACITY = X.capacity();
+                mX.push_back(VALUES[i % NUM_VALUES]);
+                if (CAPACITY != X.capacity()) {
+                    ++numCapacityChanges;
+                }
+            }
+
+            ASSERTV(LENGTH, LENGTH == (int) X.size());
+            for (int i = 0; i < LENGTH; ++i) {
+                ASSERTV(LENGTH, i, VALUES[i % NUM_VALUES] == X[i]);
+            }
+
+            const int EXP_REALLOCATIONS = IS_MOVEABLE
+                                          ? numCapacityChanges - 1
+                                          : 0;
+            ASSERTV(LENGTH, EXP_REALLOCATIONS, ra.numReallocations(),
+                    EXP_REALLOCATIONS == ra.numReallocations());
+
+            const int NUM_REALLOCATIONS = ra.numReallocations();
+
+            mX.reserve(2 * X.capacity());
+
+            ASSERTV(LENGTH, NUM_REALLOCATIONS + IS_MOVEABLE ==
+                                                       ra.numReallocations());
+            for (int i = 0; i < LENGTH; ++i) {
+                ASSERTV(LENGTH, i, VALUES[i % NUM_VALUES] == X[i]);
+            }
+        }
+        ASSERTV(LENGTH, 0 == ra.numBlocksInUse());
+    }
+
+    if (verbose) printf("\tTesting aliasing.\n");
+
+    for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+        const int LENGTH = LENGTHS[ti];
+
+        for (int tj = 0; tj < LENGTH; tj += 1 + LENGTH / 4) {
+            const int INDEX = tj;
+
+            ReallocatingTestAllocator ra;
+            {
+                Obj mX(&ra);  const Obj& X = mX;
+
+                for (int i = 0; i < LENGTH; ++i) {
+                    mX.push_back(VALUES[i % NUM_VALUES]);
+                }
+                mX.shrink_to_fit();
+
+                const int NUM_REALLOCATIONS = ra.numReallocations();
+
+                mX.push_back(X[INDEX]);
+
+                ASSERTV(LENGTH, INDEX, LENGTH + 1 == (int) X.size());
+                ASSERTV(LENGTH, INDEX, VALUES[INDEX % NUM_VALUES] == X.back());
+                ASSERTV(LENGTH, INDEX, NUM_REALLOCATIONS + IS_MOVEABLE ==
+                                                       ra.numReallocations());
+
+                mX.shrink_to_fit();
+                mX.insert(X.end(), 3, X[INDEX]);
+
+                ASSERTV(LENGTH, INDEX, LENGTH + 4 == (int) X.size());
+                for (int i = LENGTH; i < LENGTH + 4; ++i) {
+                    ASSERTV(LENGTH, INDEX, i,
+                            VALUES[INDEX % NUM_VALUES] == X[i]);
+                }
+
+                mX.shrink_to_fit();
+                mX.resize(2 * X.size() + 1, X[INDEX]);
+
+                ASSERTV(LENGTH, INDEX, 2 * LENGTH + 9 == (int) X.size());
+                for (int i = 0; i < LENGTH; ++i) {
+                    ASSERTV(LENGTH, INDEX, i, VALUES[i % NUM_VALUES] == X[i]);
+                }
+                for (int i = LENGTH; i < (int) X.size(); ++i) {
+                    ASSERTV(LENGTH, INDEX, i,
+                            VALUES[INDEX % NUM_VALUES] == X[i]);
+                }
+            }
+            ASSERTV(LENGTH, INDEX, 0 == ra.numBlocksInUse());
+        }
+    }
+
+    if (verbose) printf("\tTesting insertion not at the end.\n");
+
+    for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+        const int LENGTH = LENGTHS[ti];
+
+        ReallocatingTestAllocator ra;
+        {
+            Obj mX(&ra);  const Obj& X = mX;
+
+            for (int i = 0; i < LENGTH; ++i) {
+                mX.push_back(VALUES[i % NUM_VALUES]);
+            }
+            mX.shrink_to_fit();
+
+            const int NUM_REALLOCATIONS = ra.numReallocations();
+
+            mX.insert(X.begin(), VALUES[NUM_VALUES - 1]);
+
+            ASSERTV(LENGTH, NUM_REALLOCATIONS == ra.numReallocations());
+            ASSERTV(LENGTH, VALUES[NUM_VALUES - 1] == X[0]);
+            for (int i = 0; i < LENGTH; ++i) {
+                ASSERTV(LENGTH, i, VALUES[i % NUM_VALUES] == X[i + 1]);
+            }
+        }
+        ASSERTV(LENGTH, 0 == ra.numBlocksInUse());
+    }
+
+#ifdef BDE_BUILD_TARGET_EXC
+    if (verbose) printf("\tTesting exception safety.\n");
+
+    for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+        const int LENGTH = LENGTHS[ti];
+
+        ReallocatingTestAllocator ra;
+        {
+            Obj mX(&ra);  const Obj& X = mX;
+
+            for (int i = 0; i < LENGTH; ++i) {
+                mX.push_back(VALUES[i % NUM_VALUES]);
+            }
+            mX.shrink_to_fit();
+
+            const TYPE        *DATA     = X.data();
+            const std::size_t  CAPACITY = X.capacity();
+
+            ra.setReallocateFails(true);
+
+            bool caught = false;
+            try {
+                mX.push_back(VALUES[0]);
+            }
+            catch (std::bad_alloc&) {
+                caught = true;
+            }
+
+            ra.setReallocateFails(false);
+
+            ASSERTV(LENGTH, IS_MOVEABLE == caught);
+            if (caught) {
+                ASSERTV(LENGTH, DATA     == X.data());
+                ASSERTV(LENGTH, CAPACITY == X.capacity());
+                ASSERTV(LENGTH, LENGTH   == (int) X.size());
+            }
+            for (int i = 0; i < LENGTH; ++i) {
+                ASSERTV(LENGTH, i, VALUES[i % NUM_VALUES] == X[i]);
+            }
+        }
+        ASSERTV(LENGTH, 0 == ra.numBlocksInUse());
+    }
+#endif
+}
+
 template <class TYPE, class ALLOC>
 void TestDriver<TYPE,ALLOC>::testCase22()
 {
@@ -9537,7 +9857,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 27: {
+      case 28: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -9581,6 +9901,42 @@ int main(int argc, char *argv[])
             ASSERT(4 == m1.theValue(1, 1));
         }
       } break;
+      case 27: {
+        // --------------------------------------------------------------------
+        // TESTING GROWTH THROUGH A REALLOCATING ALLOCATOR
+        //
+        // Concerns:
+        //   See 'TestDriver<TYPE>::testCase27'.
+        //
+        // Plan:
+        //   Run the test for element types that are, and are not,
+        //   bitwise-moveable, and that do, and do not, use 'bslma'
+        //   allocators.
+        //
+        // Testing:
+        //   CONCERN: growth uses 'bslma::ReallocatingAllocator' when possible
+        // --------------------------------------------------------------------
+
+        if (verbose) printf(
+                        "\nTESTING GROWTH THROUGH A REALLOCATING ALLOCATOR"
+                        "\n===============================================\n");
+
+        if (verbose) printf("\n... with 'char' type.\n");
+        TestDriver<char>::testCase27();
+
+        if (verbose) printf("\n... with 'TestType'.\n");
+        TestDriver<T>::testCase27();
+
+        if (verbose) printf("\n... with 'TestTypeNoAlloc'.\n");
+        TestDriver<TNA>::testCase27();
+
+        if (verbose) printf("\n... with 'BitwiseMoveableTestType'.\n");
+        TestDriver<BMT>::testCase27();
+
+        if (verbose) printf("\n... with 'BitwiseCopyableTestType'.\n");
+        TestDriver<BCT>::testCase27();
+
+      } break;
       case 26: {
         // --------------------------------------------------------------------
         // TESTING HYMAN'S TEST CASE 2
@@ -10943,6 +11299,70 @@ int main(int argc, char *argv[])
                             "and arbitrary random-access iterator.\n");
         TestDriver<BCT>::testCaseM1Range(CharArray<BCT>());
 
+      } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: GROWTH THROUGH A REALLOCATING ALLOCATOR
+        //
+        // Concerns:
+        //   Provide a benchmark of appending bitwise-moveable elements to a
+        //   vector whose allocator implements 'bslma::ReallocatingAllocator'
+        //   (and can thus grow the storage in place, or by remapping pages),
+        //   compared to one whose allocator does not.
+        //
+        // Plan:
+        //   Using 'bsls_stopwatch', time appending 'int' values one at a time
+        //   with 'push_back' to vectors of various final lengths using
+        //   'bslma::MallocFreeAllocator' (which reallocates using
+        //   'std::realloc') and 'bslma::NewDeleteAllocator' (which does not).
+        //   Repeat so that the total number of appended elements is the same
+        //   for each length.  These values should only be used as a
+        //   comparison between the two allocators.
+        //
+        // Testing:
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nPERFORMANCE TEST: REALLOCATING GROWTH"
+                            "\n=====================================\n");
+
+        const int TOTAL = 1 << 26;
+
+        static const int LENGTHS[] = { 1 << 4, 1 << 10, 1 << 16, 1 << 22,
+                                       1 << 26 };
+        const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        bslma::Allocator *ALLOCATORS[] = {
+            &bslma::NewDeleteAllocator::singleton(),
+            &bslma::MallocFreeAllocator::singleton()
+        };
+        const char *NAMES[] = { "NewDeleteAllocator ",
+                                "MallocFreeAllocator" };
+
+        for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+            const int LENGTH = LENGTHS[ti];
+            const int NUM_REPS = TOTAL / LENGTH;
+
+            for (int ai = 0; ai < 2; ++ai) {
+                bsls::Stopwatch timer;
+                timer.start();
+
+                for (int rep = 0; rep < NUM_REPS; ++rep) {
+                    vector<int> mX(ALLOCATORS[ai]);
+                    for (int i = 0; i < LENGTH; ++i) {
+                        mX.push_back(i);
+                    }
+                    ASSERT(LENGTH == (int) mX.size());
+                }
+
+                timer.stop();
+
+                printf("\tpush_back x %9d, %s: %1.6fs\n",
+                       LENGTH,
+                       NAMES[ai],
+                       timer.elapsedTime());
+            }
+        }
+
       } break;
       default: {
         fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
@@ -315,6 +315,131 @@ BSLS_IDENT("$Id: $")
 //                << "\n\tAge      : " << janeCopy.age() << bsl::endl;
 //  }
 //..
+//
+///Example 2: Adopting Variable-Length Integers in a New Version
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose a type whose integer fields usually hold small values has been
+// externalized with the fixed-width 'putInt32' method, and we want new data
+// to use the more compact variable-length encoding (see
+// 'bslx_marshallingutil') without breaking readers that expect the original
+// format.  Since the two encodings differ, the variable-length one is
+// introduced as a new BDEX version, and the 'versionSelector' of the output
+// stream decides which version is written.
+//
+// First, we define a 'MyPoint' class whose 'maxSupportedBdexVersion' maps
+// selectors on or after the (hypothetical) go-live date of version 2 to that
+// version, and whose BDEX methods use 'putVarInt32' and 'getVarInt32' for
+// version 2 only:
+//..
+//  class MyPoint {
+//      int d_x;
+//      int d_y;
+//
+//    public:
+//      // CLASS METHODS
+//      static int maxSupportedBdexVersion(int versionSelector)
+//          // Return the maximum valid BDEX format version, as indicated by
+//          // the specified 'versionSelector', to be passed to the
+//          // 'bdexStreamOut' method.
+//      {
+//          return versionSelector >= 20151201 ? 2 : 1;
+//      }
+//
+//      // CREATORS
+//      explicit MyPoint(int x = 0, int y = 0)
+//          // Create a point having the optionally specified 'x' and 'y'
+//          // coordinates.  If 'x' or 'y' is not specified, 0 is used.
+//      : d_x(x)
+//      , d_y(y)
+//      {
+//      }
+//
+//      // MANIPULATORS
+//      template <class STREAM>
+//      STREAM& bdexStreamIn(STREAM& stream, int version)
+//          // Assign to this object the value read from the specified input
+//          // 'stream' using the specified 'version' format, and return a
+//          // reference to 'stream'.
+//      {
+//          switch (version) {
+//            case 1: {
+//              stream.getInt32(d_x);
+//              stream.getInt32(d_y);
+//            } break;
+//            case 2: {
+//              stream.getVarInt32(d_x);
+//              stream.getVarInt32(d_y);
+//            } break;
+//            default: {
+//              stream.invalidate();
+//            }
+//          }
+//          return stream;
+//      }
+//
+//      // ACCESSORS
+//      template <class STREAM>
+//      STREAM& bdexStreamOut(STREAM& stream, int version) const
+//          // Write the value of this object, using the specified 'version'
+//          // format, to the specified output 'stream', and return a
+//          // reference to 'stream'.
+//      {
+//          switch (version) {
+//            case 1: {
+//              stream.putInt32(d_x);
+//              stream.putInt32(d_y);
+//            } break;
+//            case 2: {
+//              stream.putVarInt32(d_x);
+//              stream.putVarInt32(d_y);
+//            } break;
+//            default: {
+//              stream.invalidate();
+//            }
+//          }
+//          return stream;
+//      }
+//
+//      int x() const { return d_x; }
+//          // Return the x coordinate of this point.
+//
+//      int y() const { return d_y; }
+//          // Return the y coordinate of this point.
+//  };
+//..
+// Note that the variable-length methods are provided by
+// 'bslx::ByteOutStream', 'bslx::ByteInStream', and 'bslx::SegmentedOutStream'
+// only, so a type adopting them can be streamed with those streams.
+//
+// Then, we externalize a point through streams created with a selector
+// preceding, and a selector following, the go-live date.  The version is
+// written first (by 'operator<<'), followed by the coordinates:
+//..
+//  const MyPoint point(3, -7);
+//
+//  bslx::ByteOutStream oldOut(20150101);
+//  oldOut << point;
+//  assert(9 == oldOut.length());
+//
+//  bslx::ByteOutStream newOut(20160101);
+//  newOut << point;
+//  assert(3 == newOut.length());
+//..
+// Finally, we verify that each externalization is read back (by 'operator>>',
+// which dispatches on the version that was written) to the original value:
+//..
+//  MyPoint            fromOld;
+//  bslx::ByteInStream oldIn(oldOut.data(), oldOut.length());
+//  oldIn >> fromOld;
+//  assert(oldIn);
+//  assert(3 == fromOld.x());  assert(-7 == fromOld.y());
+//
+//  MyPoint            fromNew;
+//  bslx::ByteInStream newIn(newOut.data(), newOut.length());
+//  newIn >> fromNew;
+//  assert(newIn);
+//  assert(3 == fromNew.x());  assert(-7 == fromNew.y());
+//..
 
 #ifndef INCLUDED_BSLSCM_VERSION
 #include <bslscm_version.h>
@@ -895,6 +1020,95 @@ class ByteInStream {
         // undefined.  The behavior is undefined unless '0 <= numVariables' and
         // 'variables' has sufficient capacity.
 
+
+                      // *** variable-length integer values ***
+
+    ByteInStream& getVarInt64(bsls::Types::Int64& variable);
+        // Assign to the specified 'variable' the value whose zigzag
+        // transformation is variable-length encoded (see
+        // 'bslx_marshallingutil') in this stream at the current cursor
+        // location, update the cursor location, and return a reference to this
+        // stream.  If this stream is initially invalid, this operation has no
+        // effect.  If this function otherwise fails to extract a valid value
+        // (e.g., the encoding is truncated or does not fit in 64 bits), this
+        // stream is marked invalid and the value of 'variable' is undefined.
+
+    ByteInStream& getVarUint64(bsls::Types::Uint64& variable);
+        // Assign to the specified 'variable' the value variable-length encoded
+        // (see 'bslx_marshallingutil') in this stream at the current cursor
+        // location, update the cursor location, and return a reference to this
+        // stream.  If this stream is initially invalid, this operation has no
+        // effect.  If this function otherwise fails to extract a valid value
+        // (e.g., the encoding is truncated or does not fit in 64 bits), this
+        // stream is marked invalid and the value of 'variable' is undefined.
+
+    ByteInStream& getVarInt32(int& variable);
+        // Assign to the specified 'variable' the value whose zigzag
+        // transformation is variable-length encoded (see
+        // 'bslx_marshallingutil') in this stream at the current cursor
+        // location, update the cursor location, and return a reference to this
+        // stream.  If this stream is initially invalid, this operation has no
+        // effect.  If this function otherwise fails to extract a valid value
+        // (e.g., the encoding is truncated or does not fit in 32 bits), this
+        // stream is marked invalid and the value of 'variable' is undefined.
+
+    ByteInStream& getVarUint32(unsigned int& variable);
+        // Assign to the specified 'variable' the value variable-length encoded
+        // (see 'bslx_marshallingutil') in this stream at the current cursor
+        // location, update the cursor location, and return a reference to this
+        // stream.  If this stream is initially invalid, this operation has no
+        // effect.  If this function otherwise fails to extract a valid value
+        // (e.g., the encoding is truncated or does not fit in 32 bits), this
+        // stream is marked invalid and the value of 'variable' is undefined.
+
+                      // *** arrays of variable-length integer values ***
+
+    ByteInStream& getArrayVarInt64(bsls::Types::Int64 *variables,
+                                   int                 numVariables);
+        // Assign to the specified 'variables' the values whose zigzag
+        // transformations are the specified 'numVariables' consecutive
+        // variable-length encodings in this stream at the current cursor
+        // location, update the cursor location, and return a reference to this
+        // stream.  If this stream is initially invalid, this operation has no
+        // effect.  If this function otherwise fails to extract valid values,
+        // this stream is marked invalid and the value of 'variables' is
+        // undefined.  The behavior is undefined unless '0 <= numVariables' and
+        // 'variables' has sufficient capacity.
+
+    ByteInStream& getArrayVarUint64(bsls::Types::Uint64 *variables,
+                                    int                  numVariables);
+        // Assign to the specified 'variables' the values of the specified
+        // 'numVariables' consecutive variable-length encodings in this stream
+        // at the current cursor location, update the cursor location, and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.  If this function otherwise
+        // fails to extract valid values, this stream is marked invalid and the
+        // value of 'variables' is undefined.  The behavior is undefined unless
+        // '0 <= numVariables' and 'variables' has sufficient capacity.
+
+    ByteInStream& getArrayVarInt32(int *variables,
+                                   int  numVariables);
+        // Assign to the specified 'variables' the values whose zigzag
+        // transformations are the specified 'numVariables' consecutive
+        // variable-length encodings in this stream at the current cursor
+        // location, update the cursor location, and return a reference to this
+        // stream.  If this stream is initially invalid, this operation has no
+        // effect.  If this function otherwise fails to extract valid values,
+        // this stream is marked invalid and the value of 'variables' is
+        // undefined.  The behavior is undefined unless '0 <= numVariables' and
+        // 'variables' has sufficient capacity.
+
+    ByteInStream& getArrayVarUint32(unsigned int *variables,
+                                    int           numVariables);
+        // Assign to the specified 'variables' the values of the specified
+        // 'numVariables' consecutive variable-length encodings in this stream
+        // at the current cursor location, update the cursor location, and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.  If this function otherwise
+        // fails to extract valid values, this stream is marked invalid and the
+        // value of 'variables' is undefined.  The behavior is undefined unless
+        // '0 <= numVariables' and 'variables' has sufficient capacity.
+
     // ACCESSORS
     operator const void *() const;
         // Return a non-zero value if this stream is valid, and 0 otherwise.
@@ -1918,6 +2132,207 @@ ByteInStream& ByteInStream::getArrayFloat32(float *variables, int numVariables)
         invalidate();
     }
 
+    return *this;
+}
+
+                      // *** variable-length integer values ***
+
+inline
+ByteInStream& ByteInStream::getVarInt64(bsls::Types::Int64& variable)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    const int numBytes = MarshallingUtil::getVarInt64(&variable,
+                                                   d_buffer + cursor(),
+                                                   length() - cursor());
+    if (numBytes) {
+        d_cursor += numBytes;
+    }
+    else {
+        invalidate();
+    }
+
+    return *this;
+}
+
+inline
+ByteInStream& ByteInStream::getVarUint64(bsls::Types::Uint64& variable)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    const int numBytes = MarshallingUtil::getVarUint64(&variable,
+                                                   d_buffer + cursor(),
+                                                   length() - cursor());
+    if (numBytes) {
+        d_cursor += numBytes;
+    }
+    else {
+        invalidate();
+    }
+
+    return *this;
+}
+
+inline
+ByteInStream& ByteInStream::getVarInt32(int& variable)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    const int numBytes = MarshallingUtil::getVarInt32(&variable,
+                                                   d_buffer + cursor(),
+                                                   length() - cursor());
+    if (numBytes) {
+        d_cursor += numBytes;
+    }
+    else {
+        invalidate();
+    }
+
+    return *this;
+}
+
+inline
+ByteInStream& ByteInStream::getVarUint32(unsigned int& variable)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    const int numBytes = MarshallingUtil::getVarUint32(&variable,
+                                                   d_buffer + cursor(),
+                                                   length() - cursor());
+    if (numBytes) {
+        d_cursor += numBytes;
+    }
+    else {
+        invalidate();
+    }
+
+    return *this;
+}
+
+                      // *** arrays of variable-length integer values ***
+
+inline
+ByteInStream& ByteInStream::getArrayVarInt64(bsls::Types::Int64 *variables,
+                                             int                 numVariables)
+{
+    BSLS_ASSERT_SAFE(variables);
+    BSLS_ASSERT_SAFE(0 <= numVariables);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    bsl::size_t numBytes;
+    const int rc = MarshallingUtil::getArrayVarInt64(variables,
+                                                     &numBytes,
+                                                     d_buffer + cursor(),
+                                                     length() - cursor(),
+                                                     numVariables);
+    if (0 == rc) {
+        d_cursor += numBytes;
+    }
+    else {
+        invalidate();
+    }
+
+    return *this;
+}
+
+inline
+ByteInStream& ByteInStream::getArrayVarUint64(
+                                             bsls::Types::Uint64 *variables,
+                                             int                  numVariables)
+{
+    BSLS_ASSERT_SAFE(variables);
+    BSLS_ASSERT_SAFE(0 <= numVariables);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    bsl::size_t numBytes;
+    const int rc = MarshallingUtil::getArrayVarUint64(variables,
+                                                      &numBytes,
+                                                      d_buffer + cursor(),
+                                                      length() - cursor(),
+                                                      numVariables);
+    if (0 == rc) {
+        d_cursor += numBytes;
+    }
+    else {
+        invalidate();
+    }
+
+    return *this;
+}
+
+inline
+ByteInStream& ByteInStream::getArrayVarInt32(int *variables,
+                                             int  numVariables)
+{
+    BSLS_ASSERT_SAFE(variables);
+    BSLS_ASSERT_SAFE(0 <= numVariables);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    bsl::size_t numBytes;
+    const int rc = MarshallingUtil::getArrayVarInt32(variables,
+                                                     &numBytes,
+                                                     d_buffer + cursor(),
+                                                     length() - cursor(),
+                                                     numVariables);
+    if (0 == rc) {
+        d_cursor += numBytes;
+    }
+    else {
+        invalidate();
+    }
+
+    return *this;
+}
+
+inline
+ByteInStream& ByteInStream::getArrayVarUint32(unsigned int *variables,
+                                              int           numVariables)
+{
+    BSLS_ASSERT_SAFE(variables);
+    BSLS_ASSERT_SAFE(0 <= numVariables);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    bsl::size_t numBytes;
+    const int rc = MarshallingUtil::getArrayVarUint32(variables,
+                                                      &numBytes,
+                                                      d_buffer + cursor(),
+                                                      length() - cursor(),
+                                                      numVariables);
+    if (0 == rc) {
+        d_cursor += numBytes;
+    }
+    else {
+        invalidate();
+    }
+
     return *this;
 }
 
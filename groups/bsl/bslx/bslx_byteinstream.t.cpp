@@ -84,6 +84,14 @@ using namespace bslx;
 // [15] getArrayUint8(unsigned char *variables, int numVariables);
 // [24] getArrayFloat64(double *variables, int numVariables);
 // [23] getArrayFloat32(float *variables, int numVariables);
+// [30] getVarInt64(bsls::Types::Int64& variable);
+// [30] getVarUint64(bsls::Types::Uint64& variable);
+// [30] getVarInt32(int& variable);
+// [30] getVarUint32(unsigned int& variable);
+// [30] getArrayVarInt64(bsls::Types::Int64 *variables, int numVariables);
+// [30] getArrayVarUint64(bsls::Types::Uint64 *variables, int numVariables);
+// [30] getArrayVarInt32(int *variables, int numVariables);
+// [30] getArrayVarUint32(unsigned int *variables, int numVariables);
 // [ 2] void invalidate();
 // [27] void reset();
 // [27] void reset(const char *buffer, bsl::size_t numBytes);
@@ -100,7 +108,7 @@ using namespace bslx;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [29] THIRD-PARTY EXTERNALIZATION
-// [30] USAGE EXAMPLE
+// [31] USAGE EXAMPLE
 // ----------------------------------------------------------------------------
 
 // ============================================================================
@@ -517,6 +525,98 @@ int maxSupportedBdexVersion(const MyStruct::EnumValue *,
         return !(lhs == rhs);
     }
 
+///Example 2: Adopting Variable-Length Integers in a New Version
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose a type whose integer fields usually hold small values has been
+// externalized with the fixed-width 'putInt32' method, and we want new data
+// to use the more compact variable-length encoding (see
+// 'bslx_marshallingutil') without breaking readers that expect the original
+// format.  Since the two encodings differ, the variable-length one is
+// introduced as a new BDEX version, and the 'versionSelector' of the output
+// stream decides which version is written.
+//
+// First, we define a 'MyPoint' class whose 'maxSupportedBdexVersion' maps
+// selectors on or after the (hypothetical) go-live date of version 2 to that
+// version, and whose BDEX methods use 'putVarInt32' and 'getVarInt32' for
+// version 2 only:
+//..
+    class MyPoint {
+        int d_x;
+        int d_y;
+
+      public:
+        // CLASS METHODS
+        static int maxSupportedBdexVersion(int versionSelector)
+            // Return the maximum valid BDEX format version, as indicated by
+            // the specified 'versionSelector', to be passed to the
+            // 'bdexStreamOut' method.
+        {
+            return versionSelector >= 20151201 ? 2 : 1;
+        }
+
+        // CREATORS
+        explicit MyPoint(int x = 0, int y = 0)
+            // Create a point having the optionally specified 'x' and 'y'
+            // coordinates.  If 'x' or 'y' is not specified, 0 is used.
+        : d_x(x)
+        , d_y(y)
+        {
+        }
+
+        // MANIPULATORS
+        template <class STREAM>
+        STREAM& bdexStreamIn(STREAM& stream, int version)
+            // Assign to this object the value read from the specified input
+            // 'stream' using the specified 'version' format, and return a
+            // reference to 'stream'.
+        {
+            switch (version) {
+              case 1: {
+                stream.getInt32(d_x);
+                stream.getInt32(d_y);
+              } break;
+              case 2: {
+                stream.getVarInt32(d_x);
+                stream.getVarInt32(d_y);
+              } break;
+              default: {
+                stream.invalidate();
+              }
+            }
+            return stream;
+        }
+
+        // ACCESSORS
+        template <class STREAM>
+        STREAM& bdexStreamOut(STREAM& stream, int version) const
+            // Write the value of this object, using the specified 'version'
+            // format, to the specified output 'stream', and return a
+            // reference to 'stream'.
+        {
+            switch (version) {
+              case 1: {
+                stream.putInt32(d_x);
+                stream.putInt32(d_y);
+              } break;
+              case 2: {
+                stream.putVarInt32(d_x);
+                stream.putVarInt32(d_y);
+              } break;
+              default: {
+                stream.invalidate();
+              }
+            }
+            return stream;
+        }
+
+        int x() const { return d_x; }
+            // Return the x coordinate of this point.
+
+        int y() const { return d_y; }
+            // Return the y coordinate of this point.
+    };
+//..
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -530,7 +630,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
-      case 30: {
+      case 31: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -600,6 +700,418 @@ if (veryVerbose) {
 } // if (veryVerbose)
 //..
 
+// Note that the variable-length methods are provided by
+// 'bslx::ByteOutStream', 'bslx::ByteInStream', and 'bslx::SegmentedOutStream'
+// only, so a type adopting them can be streamed with those streams.
+//
+// Then, we externalize a point through streams created with a selector
+// preceding, and a selector following, the go-live date.  The version is
+// written first (by 'operator<<'), followed by the coordinates:
+//..
+    const MyPoint point(3, -7);
+
+    bslx::ByteOutStream oldOut(20150101);
+    oldOut << point;
+    ASSERT(9 == oldOut.length());
+
+    bslx::ByteOutStream newOut(20160101);
+    newOut << point;
+    ASSERT(3 == newOut.length());
+//..
+// Finally, we verify that each externalization is read back (by 'operator>>',
+// which dispatches on the version that was written) to the original value:
+//..
+    MyPoint            fromOld;
+    bslx::ByteInStream oldIn(oldOut.data(), oldOut.length());
+    oldIn >> fromOld;
+    ASSERT(oldIn);
+    ASSERT(3 == fromOld.x());  ASSERT(-7 == fromOld.y());
+
+    MyPoint            fromNew;
+    bslx::ByteInStream newIn(newOut.data(), newOut.length());
+    newIn >> fromNew;
+    ASSERT(newIn);
+    ASSERT(3 == fromNew.x());  ASSERT(-7 == fromNew.y());
+//..
+
+      } break;
+      case 30: {
+        // --------------------------------------------------------------------
+        // GET VARIABLE-LENGTH INTEGERS TEST
+        //   Verify these methods unexternalize the expected values.
+        //
+        // Concerns:
+        //: 1 Methods unexternalize the values written by the corresponding
+        //:   'ByteOutStream' methods, and advance the cursor by the number of
+        //:   bytes in the encoding.
+        //:
+        //: 2 Unexternalization position does not effect output.
+        //:
+        //: 3 A truncated or over-long encoding invalidates the stream.
+        //:
+        //: 4 Methods have no effect if the stream is invalid.
+        //:
+        //: 5 Methods return a reference to the stream.
+        //:
+        //: 6 QoI: asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using a table of values having encodings of every length,
+        //:   externalize each value (interleaved with marker bytes) with the
+        //:   corresponding 'ByteOutStream' method, unexternalize it, and
+        //:   verify the value, the marker, and the cursor.  Repeat for the
+        //:   array methods using the whole table.  (C-1, C-2)
+        //:
+        //: 2 Unexternalize hand-crafted truncated and over-long encodings and
+        //:   verify the stream is invalid.  (C-3)
+        //:
+        //: 3 Invalidate a stream, call each method, and verify the cursor and
+        //:   variables are unchanged.  (C-4)
+        //:
+        //: 4 Compare the address of the returned reference with the stream.
+        //:   (C-5)
+        //:
+        //: 5 Verify defensive checks are triggered for invalid values.  (C-6)
+        //
+        // Testing:
+        //   getVarInt64(bsls::Types::Int64& variable);
+        //   getVarUint64(bsls::Types::Uint64& variable);
+        //   getVarInt32(int& variable);
+        //   getVarUint32(unsigned int& variable);
+        //   getArrayVarInt64(bsls::Types::Int64 *variables, int numVariables);
+        //   getArrayVarUint64(bsls::Types::Uint64 *variables, int numVars);
+        //   getArrayVarInt32(int *variables, int numVariables);
+        //   getArrayVarUint32(unsigned int *variables, int numVariables);
+        // --------------------------------------------------------------------
+
+        if (verbose) {
+            cout << endl
+                 << "GET VARIABLE-LENGTH INTEGERS TEST" << endl
+                 << "=================================" << endl;
+        }
+
+        typedef bsls::Types::Int64  Int64;
+        typedef bsls::Types::Uint64 Uint64;
+
+        const Uint64 VALUES[] = {
+            0ULL,                    1ULL,                    63ULL,
+            64ULL,                   127ULL,                  128ULL,
+            16383ULL,                16384ULL,                0x1fffffULL,
+            0x200000ULL,             0xfffffffULL,            0x10000000ULL,
+            0x7fffffffULL,           0x80000000ULL,           0xffffffffULL,
+            0x100000000ULL,          0x7ffffffffffffffULL,    ~0ULL >> 1,
+            ~(~0ULL >> 1),           ~0ULL - 1,               ~0ULL
+        };
+        const int NUM_VALUES = static_cast<int>(sizeof VALUES
+                                                / sizeof *VALUES);
+
+        if (verbose) {
+            cout << "\nTesting scalar methods." << endl;
+        }
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            const Uint64       U64 = VALUES[i];
+            const Int64        I64 = static_cast<Int64>(U64);
+            const unsigned int U32 = static_cast<unsigned int>(U64);
+            const int          I32 = static_cast<int>(U32);
+
+            char      scratch[MarshallingUtil::k_MAX_SIZEOF_VARINT64];
+            const int LEN_I64 = MarshallingUtil::putVarInt64(scratch, I64);
+            const int LEN_U64 = MarshallingUtil::putVarUint64(scratch, U64);
+            const int LEN_I32 = MarshallingUtil::putVarInt32(scratch, I32);
+            const int LEN_U32 = MarshallingUtil::putVarUint32(scratch, U32);
+
+            if (veryVerbose) { T_ P_(i) P(U64) }
+
+            Out o(VERSION_SELECTOR);
+            o.putVarInt64(I64);                   o.putInt8(0xFF);
+            o.putVarUint64(U64);                  o.putInt8(0xFE);
+            o.putVarInt32(I32);                   o.putInt8(0xFD);
+            o.putVarUint32(U32);                  o.putInt8(0xFC);
+
+            Obj mX(o.data(), o.length());  const Obj& X = mX;
+
+            char         marker;
+            Int64        i64 = 0;
+            Uint64       u64 = 0;
+            int          i32 = 0;
+            unsigned int u32 = 0;
+
+            bsl::size_t expCursor = LEN_I64;
+            mX.getVarInt64(i64);           ASSERTV(i, I64 == i64);
+            ASSERTV(i, expCursor == X.cursor());
+            mX.getInt8(marker);            ASSERTV(i, '\xFF' == marker);
+
+            expCursor += 1 + LEN_U64;
+            mX.getVarUint64(u64);          ASSERTV(i, U64 == u64);
+            ASSERTV(i, expCursor == X.cursor());
+            mX.getInt8(marker);            ASSERTV(i, '\xFE' == marker);
+
+            expCursor += 1 + LEN_I32;
+            mX.getVarInt32(i32);           ASSERTV(i, I32 == i32);
+            ASSERTV(i, expCursor == X.cursor());
+            mX.getInt8(marker);            ASSERTV(i, '\xFD' == marker);
+
+            expCursor += 1 + LEN_U32;
+            mX.getVarUint32(u32);          ASSERTV(i, U32 == u32);
+            ASSERTV(i, expCursor == X.cursor());
+            mX.getInt8(marker);            ASSERTV(i, '\xFC' == marker);
+
+            ASSERTV(i, X);
+            ASSERTV(i, X.isEmpty());
+            ASSERTV(i, X.cursor() == X.length());
+        }
+
+        if (verbose) {
+            cout << "\nTesting array methods." << endl;
+        }
+        {
+            Int64        i64s[NUM_VALUES];
+            Uint64       u64s[NUM_VALUES];
+            int          i32s[NUM_VALUES];
+            unsigned int u32s[NUM_VALUES];
+
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                u64s[i] = VALUES[i];
+                i64s[i] = static_cast<Int64>(VALUES[i]);
+                u32s[i] = static_cast<unsigned int>(VALUES[i]);
+                i32s[i] = static_cast<int>(u32s[i]);
+            }
+
+            for (int n = 0; n <= NUM_VALUES; ++n) {
+                if (veryVerbose) { T_ P(n) }
+
+                Out o(VERSION_SELECTOR);
+                o.putArrayVarInt64(i64s, n);      o.putInt8(0xFF);
+                o.putArrayVarUint64(u64s, n);     o.putInt8(0xFE);
+                o.putArrayVarInt32(i32s, n);      o.putInt8(0xFD);
+                o.putArrayVarUint32(u32s, n);     o.putInt8(0xFC);
+
+                Obj mX(o.data(), o.length());  const Obj& X = mX;
+
+                char         marker;
+                Int64        ai64[NUM_VALUES];
+                Uint64       au64[NUM_VALUES];
+                int          ai32[NUM_VALUES];
+                unsigned int au32[NUM_VALUES];
+
+                mX.getArrayVarInt64(ai64, n);
+                mX.getInt8(marker);        ASSERTV(n, '\xFF' == marker);
+                mX.getArrayVarUint64(au64, n);
+                mX.getInt8(marker);        ASSERTV(n, '\xFE' == marker);
+                mX.getArrayVarInt32(ai32, n);
+                mX.getInt8(marker);        ASSERTV(n, '\xFD' == marker);
+                mX.getArrayVarUint32(au32, n);
+                mX.getInt8(marker);        ASSERTV(n, '\xFC' == marker);
+
+                for (int i = 0; i < n; ++i) {
+                    ASSERTV(n, i, i64s[i] == ai64[i]);
+                    ASSERTV(n, i, u64s[i] == au64[i]);
+                    ASSERTV(n, i, i32s[i] == ai32[i]);
+                    ASSERTV(n, i, u32s[i] == au32[i]);
+                }
+
+                ASSERTV(n, X);
+                ASSERTV(n, X.isEmpty());
+                ASSERTV(n, X.cursor() == X.length());
+            }
+        }
+
+        if (verbose) {
+            cout << "\nTesting malformed input." << endl;
+        }
+        {
+            static const struct {
+                int         d_line;       // source line number
+                const char *d_data_p;     // encoded bytes
+                int         d_length;     // number of bytes in 'd_data_p'
+                bool        d_valid64;    // valid as a 64-bit encoding
+                bool        d_valid32;    // valid as a 32-bit encoding
+            } DATA[] = {
+                //LINE  DATA                                    LEN  64  32
+                //----  --------------------------------------  ---  --  --
+                { L_,   "",                                       0,  0,  0 },
+                { L_,   "\x80",                                   1,  0,  0 },
+                { L_,   "\xff\xff",                               2,  0,  0 },
+                { L_,   "\x80\x00",                               2,  1,  1 },
+                { L_,   "\xff\xff\xff\xff\x0f",                   5,  1,  1 },
+                { L_,   "\xff\xff\xff\xff\x10",                   5,  1,  0 },
+                { L_,   "\x80\x80\x80\x80\x80\x01",               6,  1,  0 },
+                { L_,   "\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01",
+                                                                 10,  1,  0 },
+                { L_,   "\xff\xff\xff\xff\xff\xff\xff\xff\xff\x02",
+                                                                 10,  0,  0 },
+                { L_,   "\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x00",
+                                                                 11,  0,  0 },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int   LINE    = DATA[ti].d_line;
+                const char *BYTES   = DATA[ti].d_data_p;
+                const int   LEN     = DATA[ti].d_length;
+                const bool  VALID64 = DATA[ti].d_valid64;
+                const bool  VALID32 = DATA[ti].d_valid32;
+
+                {
+                    Obj mX(BYTES, LEN);  const Obj& X = mX;
+                    Int64 v;
+                    mX.getVarInt64(v);
+                    ASSERTV(LINE, VALID64 == X.isValid());
+                    ASSERTV(LINE, (VALID64 ? LEN : 0) ==
+                                               static_cast<int>(X.cursor()));
+                }
+                {
+                    Obj mX(BYTES, LEN);  const Obj& X = mX;
+                    Uint64 v;
+                    mX.getVarUint64(v);
+                    ASSERTV(LINE, VALID64 == X.isValid());
+                }
+                {
+                    Obj mX(BYTES, LEN);  const Obj& X = mX;
+                    int v;
+                    mX.getVarInt32(v);
+                    ASSERTV(LINE, VALID32 == X.isValid());
+                    ASSERTV(LINE, (VALID32 ? LEN : 0) ==
+                                               static_cast<int>(X.cursor()));
+                }
+                {
+                    Obj mX(BYTES, LEN);  const Obj& X = mX;
+                    unsigned int v;
+                    mX.getVarUint32(v);
+                    ASSERTV(LINE, VALID32 == X.isValid());
+                }
+                {
+                    // A malformed element invalidates an array extraction.
+
+                    Out o(VERSION_SELECTOR);
+                    o.putVarUint64(1);
+                    o.putArrayInt8(BYTES, LEN);
+
+                    Obj mX(o.data(), o.length());  const Obj& X = mX;
+                    Uint64 v[2];
+                    mX.getArrayVarUint64(v, 2);
+                    ASSERTV(LINE, VALID64 == X.isValid());
+
+                    Obj mY(o.data(), o.length());  const Obj& Y = mY;
+                    unsigned int w[2];
+                    mY.getArrayVarUint32(w, 2);
+                    ASSERTV(LINE, VALID32 == Y.isValid());
+                }
+            }
+        }
+
+        if (verbose) {
+            cout << "\nTesting invalid streams." << endl;
+        }
+        {
+            // Verify methods have no effect if the stream is invalid.
+
+            Out o(VERSION_SELECTOR);
+            for (int i = 0; i < 4; ++i) {
+                o.putVarUint32(7);
+            }
+
+            Obj mX(o.data(), o.length());  const Obj& X = mX;
+            mX.invalidate();
+
+            Int64        i64 = 0;
+            Uint64       u64 = 0;
+            int          i32 = 0;
+            unsigned int u32 = 0;
+
+            mX.getVarInt64(i64);           ASSERT(0 == i64);
+            mX.getVarUint64(u64);          ASSERT(0 == u64);
+            mX.getVarInt32(i32);           ASSERT(0 == i32);
+            mX.getVarUint32(u32);          ASSERT(0 == u32);
+
+            mX.getArrayVarInt64(&i64, 1);  ASSERT(0 == i64);
+            mX.getArrayVarUint64(&u64, 1); ASSERT(0 == u64);
+            mX.getArrayVarInt32(&i32, 1);  ASSERT(0 == i32);
+            mX.getArrayVarUint32(&u32, 1); ASSERT(0 == u32);
+
+            ASSERT(!X);
+            ASSERT(0 == X.cursor());
+        }
+
+        if (verbose) {
+            cout << "\nTesting return values." << endl;
+        }
+        {
+            Out o(VERSION_SELECTOR);
+            for (int i = 0; i < 8; ++i) {
+                o.putVarUint32(7);
+            }
+
+            Obj mX(o.data(), o.length());  const Obj& X = mX;
+
+            Int64        i64;
+            Uint64       u64;
+            int          i32;
+            unsigned int u32;
+
+            ASSERT(&mX == &mX.getVarInt64(i64));
+            ASSERT(&mX == &mX.getVarUint64(u64));
+            ASSERT(&mX == &mX.getVarInt32(i32));
+            ASSERT(&mX == &mX.getVarUint32(u32));
+            ASSERT(&mX == &mX.getArrayVarInt64(&i64, 1));
+            ASSERT(&mX == &mX.getArrayVarUint64(&u64, 1));
+            ASSERT(&mX == &mX.getArrayVarInt32(&i32, 1));
+            ASSERT(&mX == &mX.getArrayVarUint32(&u32, 1));
+            ASSERT(X);
+            ASSERT(X.isEmpty());
+        }
+
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            cout << "\nNegative Testing." << endl;
+        {
+            Out o(VERSION_SELECTOR);
+            for (int i = 0; i < 5; ++i) {
+                o.putVarUint32(1);
+            }
+
+            Int64        i64s[5];
+            Uint64       u64s[5];
+            int          i32s[5];
+            unsigned int u32s[5];
+
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            {
+                Obj mX(o.data(), o.length());
+                ASSERT_SAFE_FAIL(mX.getArrayVarInt64(static_cast<Int64 *>(0),
+                                                     0));
+                ASSERT_SAFE_FAIL(mX.getArrayVarInt64(i64s, -1));
+                ASSERT_SAFE_PASS(mX.getArrayVarInt64(i64s, 0));
+                ASSERT_SAFE_PASS(mX.getArrayVarInt64(i64s, 1));
+            }
+            {
+                Obj mX(o.data(), o.length());
+                ASSERT_SAFE_FAIL(mX.getArrayVarUint64(
+                                                 static_cast<Uint64 *>(0), 0));
+                ASSERT_SAFE_FAIL(mX.getArrayVarUint64(u64s, -1));
+                ASSERT_SAFE_PASS(mX.getArrayVarUint64(u64s, 0));
+                ASSERT_SAFE_PASS(mX.getArrayVarUint64(u64s, 1));
+            }
+            {
+                Obj mX(o.data(), o.length());
+                ASSERT_SAFE_FAIL(mX.getArrayVarInt32(static_cast<int *>(0),
+                                                     0));
+                ASSERT_SAFE_FAIL(mX.getArrayVarInt32(i32s, -1));
+                ASSERT_SAFE_PASS(mX.getArrayVarInt32(i32s, 0));
+                ASSERT_SAFE_PASS(mX.getArrayVarInt32(i32s, 1));
+            }
+            {
+                Obj mX(o.data(), o.length());
+                ASSERT_SAFE_FAIL(mX.getArrayVarUint32(
+                                           static_cast<unsigned int *>(0), 0));
+                ASSERT_SAFE_FAIL(mX.getArrayVarUint32(u32s, -1));
+                ASSERT_SAFE_PASS(mX.getArrayVarUint32(u32s, 0));
+                ASSERT_SAFE_PASS(mX.getArrayVarUint32(u32s, 1));
+            }
+        }
       } break;
       case 29: {
         // --------------------------------------------------------------------
@@ -593,6 +593,74 @@ class ByteOutStream {
         // unless '0 <= numValues' and 'values' has sufficient contents.  Note
         // that for non-conforming platforms, this operation may be lossy.
 
+
+                      // *** variable-length integer values ***
+
+    ByteOutStream& putVarInt64(bsls::Types::Int64 value);
+        // Write to this stream the variable-length encoding of the zigzag
+        // transformation of the specified 'value' (see
+        // 'bslx_marshallingutil'), and return a reference to this stream.  If
+        // this stream is initially invalid, this operation has no effect.
+        // Note that the encoding occupies between 1 and 10 bytes, with values
+        // of small magnitude having the shortest encodings, and can be read
+        // only by the corresponding 'getVarInt64' method.
+
+    ByteOutStream& putVarUint64(bsls::Types::Uint64 value);
+        // Write to this stream the variable-length encoding of the specified
+        // 'value' (see 'bslx_marshallingutil'), and return a reference to this
+        // stream.  If this stream is initially invalid, this operation has no
+        // effect.
+
+    ByteOutStream& putVarInt32(int value);
+        // Write to this stream the variable-length encoding of the zigzag
+        // transformation of the specified 'value' (see
+        // 'bslx_marshallingutil'), and return a reference to this stream.  If
+        // this stream is initially invalid, this operation has no effect.
+
+    ByteOutStream& putVarUint32(unsigned int value);
+        // Write to this stream the variable-length encoding of the specified
+        // 'value' (see 'bslx_marshallingutil'), and return a reference to this
+        // stream.  If this stream is initially invalid, this operation has no
+        // effect.
+
+                      // *** arrays of variable-length integer values ***
+
+    ByteOutStream& putArrayVarInt64(const bsls::Types::Int64 *values,
+                                    int                       numValues);
+        // Write to this stream the consecutive variable-length encodings of
+        // the zigzag transformations of each of the specified 'numValues'
+        // leading entries in the specified 'values', and return a reference to
+        // this stream.  If this stream is initially invalid, this operation
+        // has no effect.  The behavior is undefined unless '0 <= numValues'
+        // and 'values' has sufficient contents.
+
+    ByteOutStream& putArrayVarUint64(const bsls::Types::Uint64 *values,
+                                     int                        numValues);
+        // Write to this stream the consecutive variable-length encodings of
+        // each of the specified 'numValues' leading entries in the specified
+        // 'values', and return a reference to this stream.  If this stream is
+        // initially invalid, this operation has no effect.  The behavior is
+        // undefined unless '0 <= numValues' and 'values' has sufficient
+        // contents.
+
+    ByteOutStream& putArrayVarInt32(const int *values,
+                                    int        numValues);
+        // Write to this stream the consecutive variable-length encodings of
+        // the zigzag transformations of each of the specified 'numValues'
+        // leading entries in the specified 'values', and return a reference to
+        // this stream.  If this stream is initially invalid, this operation
+        // has no effect.  The behavior is undefined unless '0 <= numValues'
+        // and 'values' has sufficient contents.
+
+    ByteOutStream& putArrayVarUint32(const unsigned int *values,
+                                     int                 numValues);
+        // Write to this stream the consecutive variable-length encodings of
+        // each of the specified 'numValues' leading entries in the specified
+        // 'values', and return a reference to this stream.  If this stream is
+        // initially invalid, this operation has no effect.  The behavior is
+        // undefined unless '0 <= numValues' and 'values' has sufficient
+        // contents.
+
     // ACCESSORS
     operator const void *() const;
         // Return a non-zero value if this stream is valid, and 0 otherwise.
@@ -1538,6 +1606,220 @@ ByteOutStream& ByteOutStream::putArrayFloat32(const float *values,
 
     MarshallingUtil::putArrayFloat32(d_buffer.data() + n, values, numValues);
 
+    return *this;
+}
+
+                      // *** variable-length integer values ***
+
+inline
+ByteOutStream& ByteOutStream::putVarInt64(bsls::Types::Int64 value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    // Resize the buffer to have sufficient capacity for the longest encoding
+    // with care to ensure this stream is invalidated if an exception is
+    // thrown, and then trim the buffer to the encoding actually written.
+
+    const bsl::size_t n = d_buffer.size();
+    invalidate();
+    d_buffer.resize(n + MarshallingUtil::k_MAX_SIZEOF_VARINT64);
+    validate();
+
+    const int numBytes = MarshallingUtil::putVarInt64(d_buffer.data() + n,
+                                                      value);
+    d_buffer.resize(n + numBytes);
+
+    return *this;
+}
+
+inline
+ByteOutStream& ByteOutStream::putVarUint64(bsls::Types::Uint64 value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    // Resize the buffer to have sufficient capacity for the longest encoding
+    // with care to ensure this stream is invalidated if an exception is
+    // thrown, and then trim the buffer to the encoding actually written.
+
+    const bsl::size_t n = d_buffer.size();
+    invalidate();
+    d_buffer.resize(n + MarshallingUtil::k_MAX_SIZEOF_VARINT64);
+    validate();
+
+    const int numBytes = MarshallingUtil::putVarUint64(d_buffer.data() + n,
+                                                       value);
+    d_buffer.resize(n + numBytes);
+
+    return *this;
+}
+
+inline
+ByteOutStream& ByteOutStream::putVarInt32(int value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    // Resize the buffer to have sufficient capacity for the longest encoding
+    // with care to ensure this stream is invalidated if an exception is
+    // thrown, and then trim the buffer to the encoding actually written.
+
+    const bsl::size_t n = d_buffer.size();
+    invalidate();
+    d_buffer.resize(n + MarshallingUtil::k_MAX_SIZEOF_VARINT32);
+    validate();
+
+    const int numBytes = MarshallingUtil::putVarInt32(d_buffer.data() + n,
+                                                      value);
+    d_buffer.resize(n + numBytes);
+
+    return *this;
+}
+
+inline
+ByteOutStream& ByteOutStream::putVarUint32(unsigned int value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    // Resize the buffer to have sufficient capacity for the longest encoding
+    // with care to ensure this stream is invalidated if an exception is
+    // thrown, and then trim the buffer to the encoding actually written.
+
+    const bsl::size_t n = d_buffer.size();
+    invalidate();
+    d_buffer.resize(n + MarshallingUtil::k_MAX_SIZEOF_VARINT32);
+    validate();
+
+    const int numBytes = MarshallingUtil::putVarUint32(d_buffer.data() + n,
+                                                       value);
+    d_buffer.resize(n + numBytes);
+
+    return *this;
+}
+
+                      // *** arrays of variable-length integer values ***
+
+inline
+ByteOutStream& ByteOutStream::putArrayVarInt64(
+                                           const bsls::Types::Int64 *values,
+                                           int                       numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid() || 0 == numValues)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    // Resize the buffer to have sufficient capacity for the longest encodings
+    // with care to ensure this stream is invalidated if an exception is
+    // thrown, and then trim the buffer to the encodings actually written.
+
+    const bsl::size_t n = d_buffer.size();
+    invalidate();
+    d_buffer.resize(n + numValues * MarshallingUtil::k_MAX_SIZEOF_VARINT64);
+    validate();
+
+    d_buffer.resize(n + MarshallingUtil::putArrayVarInt64(d_buffer.data() + n,
+                                                       values,
+                                                       numValues));
+
+    return *this;
+}
+
+inline
+ByteOutStream& ByteOutStream::putArrayVarUint64(
+                                          const bsls::Types::Uint64 *values,
+                                          int                        numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid() || 0 == numValues)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    // Resize the buffer to have sufficient capacity for the longest encodings
+    // with care to ensure this stream is invalidated if an exception is
+    // thrown, and then trim the buffer to the encodings actually written.
+
+    const bsl::size_t n = d_buffer.size();
+    invalidate();
+    d_buffer.resize(n + numValues * MarshallingUtil::k_MAX_SIZEOF_VARINT64);
+    validate();
+
+    d_buffer.resize(n + MarshallingUtil::putArrayVarUint64(d_buffer.data() + n,
+                                                       values,
+                                                       numValues));
+
+    return *this;
+}
+
+inline
+ByteOutStream& ByteOutStream::putArrayVarInt32(const int *values,
+                                               int        numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid() || 0 == numValues)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    // Resize the buffer to have sufficient capacity for the longest encodings
+    // with care to ensure this stream is invalidated if an exception is
+    // thrown, and then trim the buffer to the encodings actually written.
+
+    const bsl::size_t n = d_buffer.size();
+    invalidate();
+    d_buffer.resize(n + numValues * MarshallingUtil::k_MAX_SIZEOF_VARINT32);
+    validate();
+
+    d_buffer.resize(n + MarshallingUtil::putArrayVarInt32(d_buffer.data() + n,
+                                                       values,
+                                                       numValues));
+
+    return *this;
+}
+
+inline
+ByteOutStream& ByteOutStream::putArrayVarUint32(const unsigned int *values,
+                                                int                 numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid() || 0 == numValues)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    // Resize the buffer to have sufficient capacity for the longest encodings
+    // with care to ensure this stream is invalidated if an exception is
+    // thrown, and then trim the buffer to the encodings actually written.
+
+    const bsl::size_t n = d_buffer.size();
+    invalidate();
+    d_buffer.resize(n + numValues * MarshallingUtil::k_MAX_SIZEOF_VARINT32);
+    validate();
+
+    d_buffer.resize(n + MarshallingUtil::putArrayVarUint32(d_buffer.data() + n,
+                                                       values,
+                                                       numValues));
+
     return *this;
 }
 
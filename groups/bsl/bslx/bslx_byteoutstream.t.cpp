@@ -84,6 +84,14 @@ using namespace bslx;
 // [15] putArrayUint8(const unsigned char *array, int count);
 // [24] putArrayFloat64(const double *array, int count);
 // [23] putArrayFloat32(const float *array, int count);
+// [28] putVarInt64(bsls::Types::Int64 value);
+// [28] putVarUint64(bsls::Types::Uint64 value);
+// [28] putVarInt32(int value);
+// [28] putVarUint32(unsigned int value);
+// [28] putArrayVarInt64(const bsls::Types::Int64 *array, int count);
+// [28] putArrayVarUint64(const bsls::Types::Uint64 *array, int count);
+// [28] putArrayVarInt32(const int *array, int count);
+// [28] putArrayVarUint32(const unsigned int *array, int count);
 // [ 4] operator const void *() const;
 // [ 3] int bdexVersionSelector() const;
 // [ 3] const char *data() const;
@@ -94,7 +102,7 @@ using namespace bslx;
 // [27] ByteOutStream& operator<<(ByteOutStream&, const TYPE& value);
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [28] USAGE EXAMPLE
+// [29] USAGE EXAMPLE
 // ----------------------------------------------------------------------------
 
 // ============================================================================
@@ -201,7 +209,7 @@ int main(int argc, char *argv[])
     bslma::TestAllocator ta(veryVeryVeryVerbose);
 
     switch (test) { case 0:
-      case 28: {
+      case 29: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -290,6 +298,192 @@ int main(int argc, char *argv[])
 // example of using 'bslx' streams.
 
       } break;
+      case 28: {
+        // --------------------------------------------------------------------
+        // PUT VARIABLE-LENGTH INTEGERS TEST
+        //   Verify the methods externalize the expected bytes.
+        //
+        // Concerns:
+        //: 1 The methods externalize the variable-length encodings produced
+        //:   by the corresponding 'MarshallingUtil' functions, and nothing
+        //:   else (i.e., the buffer is trimmed to the encoding written).
+        //:
+        //: 2 The methods have no effect on an invalid stream.
+        //:
+        //: 3 The methods return a reference to the stream.
+        //:
+        //: 4 QoI: asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Externalize representative values, and arrays of them,
+        //:   interleaved with one-byte markers, and verify the bytes.  (C-1)
+        //:
+        //: 2 Externalize a larger array of mixed magnitudes and compare with
+        //:   the output of 'MarshallingUtil'.  (C-1)
+        //:
+        //: 3 Invalidate the stream, externalize again, and verify the bytes
+        //:   are unchanged.  (C-2)
+        //:
+        //: 4 Verify the address of the return value.  (C-3)
+        //:
+        //: 5 Verify defensive checks are triggered for invalid values.  (C-4)
+        //
+        // Testing:
+        //   putVarInt64(bsls::Types::Int64 value);
+        //   putVarUint64(bsls::Types::Uint64 value);
+        //   putVarInt32(int value);
+        //   putVarUint32(unsigned int value);
+        //   putArrayVarInt64(const bsls::Types::Int64 *array, int count);
+        //   putArrayVarUint64(const bsls::Types::Uint64 *array, int count);
+        //   putArrayVarInt32(const int *array, int count);
+        //   putArrayVarUint32(const unsigned int *array, int count);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PUT VARIABLE-LENGTH INTEGERS TEST" << endl
+                          << "=================================" << endl;
+
+        typedef bsls::Types::Int64  Int64;
+        typedef bsls::Types::Uint64 Uint64;
+
+        if (verbose) cout << "\nTesting scalar methods." << endl;
+        {
+            Obj mX(VERSION_SELECTOR);  const Obj& X = mX;
+            mX.putVarInt64(-1);                  mX.putInt8(0xff);
+            mX.putVarUint64(300);                mX.putInt8(0xfe);
+            mX.putVarInt32(64);                  mX.putInt8(0xfd);
+            mX.putVarUint32(0xffffffff);         mX.putInt8(0xfc);
+            mX.putVarUint64(~static_cast<Uint64>(0));
+            if (veryVerbose) { P(X); }
+
+            const char *const EXP = "\x01"                 "\xff"
+                                    "\xac\x02"             "\xfe"
+                                    "\x80\x01"             "\xfd"
+                                    "\xff\xff\xff\xff\x0f" "\xfc"
+                                    "\xff\xff\xff\xff\xff"
+                                    "\xff\xff\xff\xff\x01";
+
+            const bsl::size_t NUM_BYTES = 4 * SIZEOF_INT8 + 1 + 2 + 2 + 5
+                                        + 10;
+            ASSERT(NUM_BYTES == X.length());
+            ASSERT(0 == memcmp(X.data(), EXP, NUM_BYTES));
+
+            // Verify the methods have no effect if the stream is invalid.
+            mX.invalidate();
+            mX.putVarInt64(-1);
+            mX.putVarUint64(300);
+            mX.putVarInt32(64);
+            mX.putVarUint32(0xffffffff);
+            ASSERT(NUM_BYTES == X.length());
+            ASSERT(0 == memcmp(X.data(), EXP, NUM_BYTES));
+
+            // Verify the return values.
+            mX.reset();
+            ASSERT(&mX == &mX.putVarInt64(1));
+            ASSERT(&mX == &mX.putVarUint64(1));
+            ASSERT(&mX == &mX.putVarInt32(1));
+            ASSERT(&mX == &mX.putVarUint32(1));
+        }
+
+        if (verbose) cout << "\nTesting array methods." << endl;
+        {
+            const Int64        I64[] = { 0, -1, 1000 };
+            const Uint64       U64[] = { 1, 128 };
+            const int          I32[] = { -64, 64 };
+            const unsigned int U32[] = { 16384 };
+
+            Obj mX(VERSION_SELECTOR);  const Obj& X = mX;
+            mX.putArrayVarInt64(I64, 0);         mX.putInt8(0xff);
+            mX.putArrayVarInt64(I64, 3);         mX.putInt8(0xfe);
+            mX.putArrayVarUint64(U64, 2);        mX.putInt8(0xfd);
+            mX.putArrayVarInt32(I32, 2);         mX.putInt8(0xfc);
+            mX.putArrayVarUint32(U32, 1);        mX.putInt8(0xfb);
+            if (veryVerbose) { P(X); }
+
+            const char *const EXP = ""                     "\xff"
+                                    "\x00\x01\xd0\x0f"     "\xfe"
+                                    "\x01\x80\x01"         "\xfd"
+                                    "\x7f\x80\x01"         "\xfc"
+                                    "\x80\x80\x01"         "\xfb";
+
+            const bsl::size_t NUM_BYTES = 5 * SIZEOF_INT8 + 4 + 3 + 3 + 3;
+            ASSERT(NUM_BYTES == X.length());
+            ASSERT(0 == memcmp(X.data(), EXP, NUM_BYTES));
+
+            // Verify the methods have no effect if the stream is invalid.
+            mX.invalidate();
+            mX.putArrayVarInt64(I64, 3);
+            mX.putArrayVarUint64(U64, 2);
+            mX.putArrayVarInt32(I32, 2);
+            mX.putArrayVarUint32(U32, 1);
+            ASSERT(NUM_BYTES == X.length());
+            ASSERT(0 == memcmp(X.data(), EXP, NUM_BYTES));
+
+            // Verify the return values.
+            mX.reset();
+            ASSERT(&mX == &mX.putArrayVarInt64(I64, 3));
+            ASSERT(&mX == &mX.putArrayVarUint64(U64, 2));
+            ASSERT(&mX == &mX.putArrayVarInt32(I32, 2));
+            ASSERT(&mX == &mX.putArrayVarUint32(U32, 1));
+        }
+
+        if (verbose) cout << "\nTesting a larger array." << endl;
+        {
+            enum { k_NUM_VALUES = 100 };
+
+            Int64 values[k_NUM_VALUES];
+            for (int i = 0; i < k_NUM_VALUES; ++i) {
+                values[i] = static_cast<Int64>(static_cast<Uint64>(i)
+                                                              << (i % 60));
+                if (0 == i % 7) {
+                    values[i] = ~values[i];
+                }
+            }
+
+            char              expected[k_NUM_VALUES * 10];
+            const bsl::size_t LENGTH = MarshallingUtil::putArrayVarInt64(
+                                                                 expected,
+                                                                 values,
+                                                                 k_NUM_VALUES);
+
+            Obj mX(VERSION_SELECTOR);  const Obj& X = mX;
+            mX.putArrayVarInt64(values, k_NUM_VALUES);
+            ASSERT(LENGTH == X.length());
+            ASSERT(0 == memcmp(X.data(), expected, LENGTH));
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            const Int64        I64[] = { 1 };
+            const Uint64       U64[] = { 1 };
+            const int          I32[] = { 1 };
+            const unsigned int U32[] = { 1 };
+
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            Obj mX(VERSION_SELECTOR);
+            ASSERT_SAFE_FAIL(mX.putArrayVarInt64(0, 0));
+            ASSERT_SAFE_FAIL(mX.putArrayVarInt64(I64, -1));
+            ASSERT_SAFE_PASS(mX.putArrayVarInt64(I64, 0));
+            ASSERT_SAFE_PASS(mX.putArrayVarInt64(I64, 1));
+
+            ASSERT_SAFE_FAIL(mX.putArrayVarUint64(0, 0));
+            ASSERT_SAFE_FAIL(mX.putArrayVarUint64(U64, -1));
+            ASSERT_SAFE_PASS(mX.putArrayVarUint64(U64, 0));
+            ASSERT_SAFE_PASS(mX.putArrayVarUint64(U64, 1));
+
+            ASSERT_SAFE_FAIL(mX.putArrayVarInt32(0, 0));
+            ASSERT_SAFE_FAIL(mX.putArrayVarInt32(I32, -1));
+            ASSERT_SAFE_PASS(mX.putArrayVarInt32(I32, 0));
+            ASSERT_SAFE_PASS(mX.putArrayVarInt32(I32, 1));
+
+            ASSERT_SAFE_FAIL(mX.putArrayVarUint32(0, 0));
+            ASSERT_SAFE_FAIL(mX.putArrayVarUint32(U32, -1));
+            ASSERT_SAFE_PASS(mX.putArrayVarUint32(U32, 0));
+            ASSERT_SAFE_PASS(mX.putArrayVarUint32(U32, 1));
+        }
+      } break;
       case 27: {
         // --------------------------------------------------------------------
         // EXTERNALIZATION FREE OPERATOR
@@ -0,0 +1,105 @@
+// bslx_indexedrecordreader.cpp                                       -*-C++-*-
+#include <bslx_indexedrecordreader.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bslx_indexedrecordreader_cpp,"$Id$ $CSID$")
+
+#include <bsl_climits.h>
+
+namespace BloombergLP {
+namespace bslx {
+
+                        // -------------------------
+                        // class IndexedRecordReader
+                        // -------------------------
+
+// MANIPULATORS
+int IndexedRecordReader::load(const char *buffer, bsl::size_t numBytes)
+{
+    BSLS_ASSERT(buffer || 0 == numBytes);
+
+    enum { k_ENTRY_SIZE = MarshallingUtil::k_SIZEOF_INT32 };
+
+    reset();
+
+    if (numBytes < k_ENTRY_SIZE) {
+        return -1;                                                    // RETURN
+    }
+
+    unsigned int numFields;
+    MarshallingUtil::getUint32(&numFields, buffer);
+
+    // The table of 'numFields' end offsets follows the count, so it fits
+    // only if 'numFields < numBytes / k_ENTRY_SIZE' (which also avoids
+    // overflow in computing its length).
+
+    if (numFields >= numBytes / k_ENTRY_SIZE) {
+        return -2;                                                    // RETURN
+    }
+
+    const bsl::size_t tableLength = k_ENTRY_SIZE * (numFields + 1);
+
+    unsigned int fieldsLength = 0;
+    if (numFields) {
+        MarshallingUtil::getUint32(&fieldsLength,
+                                   buffer + tableLength - k_ENTRY_SIZE);
+    }
+
+    if (fieldsLength > static_cast<unsigned int>(INT_MAX)
+     || fieldsLength > numBytes - tableLength) {
+        return -3;                                                    // RETURN
+    }
+
+    d_record_p     = buffer;
+    d_fields_p     = buffer + tableLength;
+    d_numFields    = static_cast<int>(numFields);
+    d_fieldsLength = fieldsLength;
+
+    return 0;
+}
+
+// ACCESSORS
+int IndexedRecordReader::getString(bslstl::StringRef *result, int index) const
+{
+    BSLS_ASSERT(result);
+    BSLS_ASSERT(0 <= index);
+    BSLS_ASSERT(index < numFields());
+
+    const char *begin;
+    int         length;
+    if (!locateField(&begin, &length, index)) {
+        return -1;                                                    // RETURN
+    }
+
+    ByteInStream stream(begin, length);
+    int          stringLength;
+    stream.getLength(stringLength);
+
+    if (!stream
+     || static_cast<bsl::size_t>(stringLength) !=
+                                       stream.length() - stream.cursor()) {
+        return -2;                                                    // RETURN
+    }
+
+    result->assign(begin + stream.cursor(), stringLength);
+    return 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,360 @@
+// bslx_indexedrecordreader.h                                         -*-C++-*-
+#ifndef INCLUDED_BSLX_INDEXEDRECORDREADER
+#define INCLUDED_BSLX_INDEXEDRECORDREADER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide zero-copy random access to the fields of an indexed record.
+//
+//@CLASSES:
+//  bslx::IndexedRecordReader: random-access reader of indexed BDEX records
+//
+//@SEE_ALSO: bslx_indexedrecordwriter, bslx_byteinstream
+//
+//@DESCRIPTION: This component provides a class, 'bslx::IndexedRecordReader',
+// that provides random access to the fields of an *indexed* *record* written
+// by 'bslx::IndexedRecordWriter' (see {'bslx_indexedrecordwriter'|Indexed
+// Record Format}).  Loading a record checks only the size of its offset
+// table, and each field is then located, in constant time, from the table;
+// no field is decoded until it is requested, and the fields that precede it
+// are never decoded.
+//
+// Like 'bslx::ByteInStream', the reader refers to a user-supplied buffer
+// directly, with no data copying or assumption of ownership, and allocates no
+// memory.  A field is returned either as a 'bslstl::StringRef' referring to
+// its bytes ('getField'), as a 'bslstl::StringRef' referring to the
+// characters of a 'bsl::string' written to it ('getString'), or as a value of
+// any BDEX-streamable type read from it with 'operator>>' ('getValue').  The
+// record as a whole (e.g., to forward it unmodified) is given by 'data' and
+// 'length'.
+//
+// Since the offset table is not checked when the record is loaded, a corrupt
+// table is detected only when an affected field is requested; each accessor
+// returns a non-zero value, and has no effect, if the requested field is not
+// well-formed.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Routing a Message Using Its Indexed Header
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a message is written as an indexed record of a routing key, a
+// priority, and a body, as shown in {'bslx_indexedrecordwriter'|Example 1}:
+//..
+//  bslx::IndexedRecordWriter writer(20160101);
+//
+//  const double prices[] = { 142.10, 142.15, 142.05 };
+//
+//  writer.appendField(bsl::string("EQ.US.IBM"));
+//  writer.appendField(7);
+//  writer.stream().putLength(3);
+//  writer.stream().putArrayFloat64(prices, 3);
+//  writer.closeField();
+//
+//  bslx::ByteOutStream out(20160101);
+//  writer.streamOut(out);
+//..
+// A router needs to examine the routing key and the priority of the message
+// and forward the message unchanged.
+//
+// First, we load the record into a reader:
+//..
+//  bslx::IndexedRecordReader reader;
+//
+//  int rc = reader.load(out.data(), out.length());
+//  assert(0 == rc);
+//  assert(3 == reader.numFields());
+//..
+// Then, we obtain the routing key as a reference into the buffer, and the
+// priority, without decoding the body:
+//..
+//  bslstl::StringRef routingKey;
+//  rc = reader.getString(&routingKey, 0);
+//  assert(0 == rc);
+//  assert("EQ.US.IBM" == routingKey);
+//
+//  int priority;
+//  rc = reader.getValue(&priority, 1);
+//  assert(0 == rc);
+//  assert(7 == priority);
+//..
+// Next, we forward the record, which is the whole of the output, unchanged:
+//..
+//  assert(out.data()   == reader.data());
+//  assert(out.length() == reader.length());
+//..
+// Finally, the consumer of the message decodes the body from its field:
+//..
+//  bslstl::StringRef body;
+//  rc = reader.getField(&body, 2);
+//  assert(0 == rc);
+//
+//  bslx::ByteInStream in(body);
+//  int                numPrices = 0;
+//  double             values[3];
+//  in.getLength(numPrices);
+//  assert(3 == numPrices);
+//  in.getArrayFloat64(values, numPrices);
+//  assert(in);
+//  assert(in.isEmpty());
+//  assert(142.15 == values[1]);
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLX_BYTEINSTREAM
+#include <bslx_byteinstream.h>
+#endif
+
+#ifndef INCLUDED_BSLX_MARSHALLINGUTIL
+#include <bslx_marshallingutil.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STRINGREF
+#include <bslstl_stringref.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+namespace BloombergLP {
+namespace bslx {
+
+                         // =========================
+                         // class IndexedRecordReader
+                         // =========================
+
+class IndexedRecordReader {
+    // This class provides constant-time, zero-copy access to the fields of an
+    // indexed record (see {'bslx_indexedrecordwriter'|Indexed Record
+    // Format}) held in a user-supplied buffer.  A default-constructed reader,
+    // or one whose last 'load' failed, refers to no record and has no fields.
+
+    // DATA
+    const char  *d_record_p;      // first byte of the record, or 0 if no
+                                  // record is loaded
+
+    const char  *d_fields_p;      // first field byte of the record
+
+    int          d_numFields;     // number of fields in the record
+
+    bsl::size_t  d_fieldsLength;  // combined length of the fields (in bytes)
+
+  private:
+    // PRIVATE ACCESSORS
+    bool locateField(const char **begin, int *length, int index) const;
+        // Load into the specified 'begin' and 'length' the address of the
+        // first byte and the number of bytes of the field at the specified
+        // 'index' in the record, and return 'true' if the offset table
+        // entries describing that field are consistent, and 'false' (with no
+        // effect on 'begin' or 'length') otherwise.  The behavior is
+        // undefined unless '0 <= index < numFields()'.
+
+  public:
+    // CREATORS
+    IndexedRecordReader();
+        // Create a reader that refers to no record.
+
+    //! IndexedRecordReader(const IndexedRecordReader& original) = default;
+    //! ~IndexedRecordReader() = default;
+
+    // MANIPULATORS
+    //! IndexedRecordReader& operator=(const IndexedRecordReader& rhs) =
+    //!                                                                default;
+
+    int load(const char *buffer, bsl::size_t numBytes);
+        // Refer this reader to the indexed record at the beginning of the
+        // specified 'buffer' of the specified 'numBytes'.  Return 0 on
+        // success, and a non-zero value (with this reader referring to no
+        // record) if 'numBytes' is too small to hold the offset table and the
+        // fields the table describes.  Note that 'numBytes' may exceed the
+        // length of the record, and that the contents of 'buffer' must remain
+        // unchanged for as long as this reader refers to it.
+
+    void reset();
+        // Make this reader refer to no record.
+
+    // ACCESSORS
+    const char *data() const;
+        // Return the address of the first byte of the record to which this
+        // reader refers, or 0 if this reader refers to no record.
+
+    int getField(bslstl::StringRef *result, int index) const;
+        // Load into the specified 'result' a reference to the bytes of the
+        // field at the specified 'index' in the record.  Return 0 on success,
+        // and a non-zero value (with no effect on 'result') if the offset
+        // table entries describing the field are inconsistent.  The behavior
+        // is undefined unless '0 <= index < numFields()'.
+
+    int getString(bslstl::StringRef *result, int index) const;
+        // Load into the specified 'result' a reference to the characters of
+        // the string written (e.g., by 'putString') as the field at the
+        // specified 'index' in the record.  Return 0 on success, and a
+        // non-zero value (with no effect on 'result') if the field does not
+        // consist of exactly one externalized string.  The behavior is
+        // undefined unless '0 <= index < numFields()'.
+
+    template <class TYPE>
+    int getValue(TYPE *result, int index) const;
+        // Assign to the specified 'result' the value read, as by 'operator>>'
+        // from a 'bslx::ByteInStream', from the field at the specified
+        // 'index' in the record.  Return 0 on success, and a non-zero value
+        // otherwise.  If the field does not consist of exactly one
+        // externalized 'TYPE' value, a non-zero value is returned and
+        // 'result' is left in a valid, but unspecified, state.  The behavior
+        // is undefined unless '0 <= index < numFields()'.
+
+    bsl::size_t length() const;
+        // Return the number of bytes in the record to which this reader
+        // refers, or 0 if this reader refers to no record.
+
+    int numFields() const;
+        // Return the number of fields in the record to which this reader
+        // refers, or 0 if this reader refers to no record.
+};
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                         // -------------------------
+                         // class IndexedRecordReader
+                         // -------------------------
+
+// PRIVATE ACCESSORS
+inline
+bool IndexedRecordReader::locateField(const char **begin,
+                                      int         *length,
+                                      int          index) const
+{
+    BSLS_ASSERT_SAFE(begin);
+    BSLS_ASSERT_SAFE(length);
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < d_numFields);
+
+    const char *entry = d_record_p + MarshallingUtil::k_SIZEOF_INT32 * index;
+
+    unsigned int first = 0;
+    unsigned int last;
+    if (index) {
+        MarshallingUtil::getUint32(&first, entry);
+    }
+    MarshallingUtil::getUint32(&last, entry + MarshallingUtil::k_SIZEOF_INT32);
+
+    if (first > last || last > d_fieldsLength) {
+        return false;                                                 // RETURN
+    }
+
+    *begin  = d_fields_p + first;
+    *length = static_cast<int>(last - first);
+    return true;
+}
+
+// CREATORS
+inline
+IndexedRecordReader::IndexedRecordReader()
+: d_record_p(0)
+, d_fields_p(0)
+, d_numFields(0)
+, d_fieldsLength(0)
+{
+}
+
+// MANIPULATORS
+inline
+void IndexedRecordReader::reset()
+{
+    d_record_p     = 0;
+    d_fields_p     = 0;
+    d_numFields    = 0;
+    d_fieldsLength = 0;
+}
+
+// ACCESSORS
+inline
+const char *IndexedRecordReader::data() const
+{
+    return d_record_p;
+}
+
+inline
+int IndexedRecordReader::getField(bslstl::StringRef *result, int index) const
+{
+    BSLS_ASSERT_SAFE(result);
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < numFields());
+
+    const char *begin;
+    int         length;
+    if (!locateField(&begin, &length, index)) {
+        return -1;                                                    // RETURN
+    }
+
+    result->assign(begin, length);
+    return 0;
+}
+
+template <class TYPE>
+int IndexedRecordReader::getValue(TYPE *result, int index) const
+{
+    BSLS_ASSERT_SAFE(result);
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < numFields());
+
+    const char *begin;
+    int         length;
+    if (!locateField(&begin, &length, index)) {
+        return -1;                                                    // RETURN
+    }
+
+    ByteInStream stream(begin, length);
+    stream >> *result;
+
+    return stream && stream.isEmpty() ? 0 : -2;
+}
+
+inline
+bsl::size_t IndexedRecordReader::length() const
+{
+    return d_record_p
+         ? (d_fields_p - d_record_p) + d_fieldsLength
+         : 0;
+}
+
+inline
+int IndexedRecordReader::numFields() const
+{
+    return d_numFields;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
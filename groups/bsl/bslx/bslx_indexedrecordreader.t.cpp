@@ -0,0 +1,972 @@
+// bslx_indexedrecordreader.t.cpp                                     -*-C++-*-
+
+#include <bslx_indexedrecordreader.h>
+
+#include <bslx_byteinstream.h>
+#include <bslx_byteoutstream.h>
+#include <bslx_indexedrecordwriter.h>
+
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+using namespace bslx;
+
+// ============================================================================
+//                              TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// An 'IndexedRecordReader' is an in-core value that refers to a record in a
+// user-supplied buffer; its accessors locate a field from two entries of the
+// offset table and decode it with 'bslx::ByteInStream'.  We are concerned
+// that 'load' accepts exactly the buffers that are large enough for the table
+// and the fields it describes, that each field is located correctly (whatever
+// the fields around it), and that a corrupt table, or a field that does not
+// hold exactly the requested value, is reported rather than read beyond.  We
+// build well-formed records with 'bslx::IndexedRecordWriter', and malformed
+// ones by hand with 'bslx::ByteOutStream'.
+// ----------------------------------------------------------------------------
+// [ 2] IndexedRecordReader();
+// [ 2] int load(const char *buffer, bsl::size_t numBytes);
+// [ 2] void reset();
+// [ 2] const char *data() const;
+// [ 3] int getField(bslstl::StringRef *result, int index) const;
+// [ 4] int getString(bslstl::StringRef *result, int index) const;
+// [ 5] int getValue(TYPE *result, int index) const;
+// [ 2] bsl::size_t length() const;
+// [ 2] int numFields() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: ONE FIELD VERSUS FULL UNEXTERNALIZATION
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACROS
+// ----------------------------------------------------------------------------
+
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                      STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef IndexedRecordReader Obj;
+
+const int VERSION_SELECTOR = 20131127;
+
+// ============================================================================
+//                      HELPER CLASSES AND FUNCTIONS
+// ----------------------------------------------------------------------------
+
+class VersionedInt {
+    // This class holds an 'int' that is externalized as a single byte, in
+    // BDEX version 3.
+
+    // DATA
+    int d_value;  // held value
+
+  public:
+    // CLASS METHODS
+    static int maxSupportedBdexVersion(int /* versionSelector */)
+        // Return the BDEX version, 3, of this class.
+    {
+        return 3;
+    }
+
+    // CREATORS
+    explicit VersionedInt(int value = 0)
+        // Create an object holding the optionally specified 'value'.  If
+        // 'value' is not specified, 0 is used.
+    : d_value(value)
+    {
+    }
+
+    // MANIPULATORS
+    template <class STREAM>
+    STREAM& bdexStreamIn(STREAM& stream, int version)
+        // Assign to this object the value read from the specified input
+        // 'stream' using the specified 'version' format, and return a
+        // reference to 'stream'.
+    {
+        if (3 == version) {
+            char value;
+            stream.getInt8(value);
+            if (stream) {
+                d_value = value;
+            }
+        }
+        else {
+            stream.invalidate();
+        }
+        return stream;
+    }
+
+    // ACCESSORS
+    template <class STREAM>
+    STREAM& bdexStreamOut(STREAM& stream, int version) const
+        // Write the value of this object, using the specified 'version'
+        // format, to the specified output 'stream', and return a reference to
+        // 'stream'.
+    {
+        if (3 == version) {
+            stream.putInt8(d_value);
+        }
+        else {
+            stream.invalidate();
+        }
+        return stream;
+    }
+
+    int value() const
+        // Return the value held by this object.
+    {
+        return d_value;
+    }
+};
+
+struct Message {
+    // This 'struct' is the in-core form of the messages used in the
+    // performance test: a routing key, a priority, and a body.
+
+    bsl::string         d_routingKey;
+    int                 d_priority;
+    bsl::vector<double> d_body;
+
+    template <class STREAM>
+    STREAM& bdexStreamIn(STREAM& stream)
+        // Read the fields of this object, in sequence, from the specified
+        // 'stream', and return a reference to 'stream'.
+    {
+        int length;
+        stream.getString(d_routingKey);
+        stream.getInt32(d_priority);
+        stream.getLength(length);
+        if (stream) {
+            d_body.resize(length);
+            stream.getArrayFloat64(d_body.data(), length);
+        }
+        return stream;
+    }
+};
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file must
+        //:   compile, link, and run as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, replace
+        //:   leading comment characters with spaces, and replace 'assert'
+        //:   with 'ASSERT'.  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Routing a Message Using Its Indexed Header
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a message is written as an indexed record of a routing key, a
+// priority, and a body, as shown in {'bslx_indexedrecordwriter'|Example 1}:
+//..
+    bslx::IndexedRecordWriter writer(20160101);
+
+    const double prices[] = { 142.10, 142.15, 142.05 };
+
+    writer.appendField(bsl::string("EQ.US.IBM"));
+    writer.appendField(7);
+    writer.stream().putLength(3);
+    writer.stream().putArrayFloat64(prices, 3);
+    writer.closeField();
+
+    bslx::ByteOutStream out(20160101);
+    writer.streamOut(out);
+//..
+// A router needs to examine the routing key and the priority of the message
+// and forward the message unchanged.
+//
+// First, we load the record into a reader:
+//..
+    bslx::IndexedRecordReader reader;
+
+    int rc = reader.load(out.data(), out.length());
+    ASSERT(0 == rc);
+    ASSERT(3 == reader.numFields());
+//..
+// Then, we obtain the routing key as a reference into the buffer, and the
+// priority, without decoding the body:
+//..
+    bslstl::StringRef routingKey;
+    rc = reader.getString(&routingKey, 0);
+    ASSERT(0 == rc);
+    ASSERT("EQ.US.IBM" == routingKey);
+
+    int priority;
+    rc = reader.getValue(&priority, 1);
+    ASSERT(0 == rc);
+    ASSERT(7 == priority);
+//..
+// Next, we forward the record, which is the whole of the output, unchanged:
+//..
+    ASSERT(out.data()   == reader.data());
+    ASSERT(out.length() == reader.length());
+//..
+// Finally, the consumer of the message decodes the body from its field:
+//..
+    bslstl::StringRef body;
+    rc = reader.getField(&body, 2);
+    ASSERT(0 == rc);
+
+    bslx::ByteInStream in(body);
+    int                numPrices = 0;
+    double             values[3];
+    in.getLength(numPrices);
+    ASSERT(3 == numPrices);
+    in.getArrayFloat64(values, numPrices);
+    ASSERT(in);
+    ASSERT(in.isEmpty());
+    ASSERT(142.15 == values[1]);
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'getValue'
+        //
+        // Concerns:
+        //: 1 'getValue' reads a value as 'operator>>' does, including the
+        //:   version of a versioned type.
+        //:
+        //: 2 A field holding fewer or more bytes than one value of the
+        //:   requested type, or an unsupported version, is reported.
+        //:
+        //: 3 A field whose table entries are inconsistent is reported.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Append values of various types with 'appendField', and read each
+        //:   back with 'getValue'.  (C-1)
+        //:
+        //: 2 Read fields with the wrong type, or holding extra bytes, or a
+        //:   bad version, and verify the return value.  (C-2)
+        //:
+        //: 3 Read a field from a hand-crafted record with a corrupt table.
+        //:   (C-3)
+        //:
+        //: 4 Verify that defensive checks are triggered for invalid
+        //:   arguments.  (C-4)
+        //
+        // Testing:
+        //   int getValue(TYPE *result, int index) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'getValue'" << endl
+                          << "==========" << endl;
+
+        IndexedRecordWriter writer(VERSION_SELECTOR, &ta);
+
+        bsl::vector<int> V(&ta);
+        V.push_back(1);  V.push_back(-2);  V.push_back(3);
+
+        writer.appendField(-12345);                              // 0
+        writer.appendField(2.5);                                 // 1
+        writer.appendField(bsl::string(200, 'q'));               // 2
+        writer.appendField(VersionedInt(-9));                    // 3
+        writer.appendField(V);                                   // 4
+        writer.stream().putInt32(1);
+        writer.stream().putInt8(2);
+        writer.closeField();                                     // 5
+        writer.stream().putVersion(4);
+        writer.stream().putInt8(2);
+        writer.closeField();                                     // 6
+
+        ByteOutStream out(VERSION_SELECTOR, &ta);
+        writer.streamOut(out);
+
+        Obj mX;  const Obj& X = mX;
+        ASSERT(0 == mX.load(out.data(), out.length()));
+        ASSERT(7 == X.numFields());
+
+        if (verbose) cout << "\nTesting well-formed fields." << endl;
+        {
+            int i;
+            ASSERT(0 == X.getValue(&i, 0));
+            ASSERT(-12345 == i);
+
+            double d;
+            ASSERT(0 == X.getValue(&d, 1));
+            ASSERT(2.5 == d);
+
+            bsl::string s(&ta);
+            ASSERT(0 == X.getValue(&s, 2));
+            ASSERT(bsl::string(200, 'q') == s);
+
+            VersionedInt vi;
+            ASSERT(0 == X.getValue(&vi, 3));
+            ASSERT(-9 == vi.value());
+
+            bsl::vector<int> v(&ta);
+            ASSERT(0 == X.getValue(&v, 4));
+            ASSERT(V == v);
+        }
+
+        if (verbose) cout << "\nTesting ill-formed fields." << endl;
+        {
+            int i;
+            ASSERT(0 != X.getValue(&i, 5));     // extra byte
+            ASSERT(0 != X.getValue(&i, 3));     // too short
+
+            bsls::Types::Int64 i64;
+            ASSERT(0 != X.getValue(&i64, 0));   // too short
+
+            short sh;
+            ASSERT(0 != X.getValue(&sh, 0));    // extra bytes
+
+            VersionedInt vi(17);
+            ASSERT(0 != X.getValue(&vi, 6));    // bad version
+        }
+        {
+            // Field 1 ends before it begins.
+
+            ByteOutStream bad(VERSION_SELECTOR, &ta);
+            bad.putUint32(2);
+            bad.putUint32(4);
+            bad.putUint32(2);
+            bad.putInt32(5);
+
+            Obj mY;  const Obj& Y = mY;
+            ASSERT(0 == mY.load(bad.data(), bad.length()));
+
+            int i = 3;
+            ASSERT(0 != Y.getValue(&i, 1));
+            ASSERT(3 == i);
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            int i;
+            ASSERT_SAFE_FAIL(X.getValue(static_cast<int *>(0), 0));
+            ASSERT_SAFE_FAIL(X.getValue(&i, -1));
+            ASSERT_SAFE_FAIL(X.getValue(&i, 7));
+            ASSERT_SAFE_PASS(X.getValue(&i, 0));
+            ASSERT_SAFE_PASS(X.getValue(&i, 6));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'getString'
+        //
+        // Concerns:
+        //: 1 'getString' refers to the characters of a string field in the
+        //:   buffer, for both the one-byte and the four-byte length encodings.
+        //:
+        //: 2 A field that does not hold exactly one string is reported, and
+        //:   'result' is unchanged.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Append strings of various lengths, read each back, and verify
+        //:   the address and length of the result.  (C-1)
+        //:
+        //: 2 Read fields holding truncated strings, trailing bytes, and no
+        //:   bytes, and verify the return value and 'result'.  (C-2)
+        //:
+        //: 3 Verify that defensive checks are triggered for invalid
+        //:   arguments.  (C-3)
+        //
+        // Testing:
+        //   int getString(bslstl::StringRef *result, int index) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'getString'" << endl
+                          << "===========" << endl;
+
+        static const int LENGTHS[] = { 0, 1, 127, 128, 1000 };
+        const int NUM_LENGTHS = static_cast<int>(sizeof LENGTHS
+                                                 / sizeof *LENGTHS);
+
+        IndexedRecordWriter writer(VERSION_SELECTOR, &ta);
+        for (int i = 0; i < NUM_LENGTHS; ++i) {
+            writer.appendField(bsl::string(LENGTHS[i], char('a' + i), &ta));
+        }
+        writer.stream().putString("abc");
+        writer.stream().putInt8(0);
+        writer.closeField();                                     // trailing
+        writer.stream().putLength(4);
+        writer.stream().putInt8('a');
+        writer.closeField();                                     // truncated
+        writer.closeField();                                     // empty
+        writer.stream().putInt8(static_cast<char>(0x80));
+        writer.closeField();                                     // bad length
+
+        ByteOutStream out(VERSION_SELECTOR, &ta);
+        writer.streamOut(out);
+
+        Obj mX;  const Obj& X = mX;
+        ASSERT(0 == mX.load(out.data(), out.length()));
+        ASSERT(NUM_LENGTHS + 4 == X.numFields());
+
+        for (int i = 0; i < NUM_LENGTHS; ++i) {
+            const int LENGTH = LENGTHS[i];
+
+            if (veryVerbose) { T_ P(LENGTH) }
+
+            bslstl::StringRef field;
+            bslstl::StringRef result;
+            ASSERTV(i, 0 == X.getField(&field, i));
+            ASSERTV(i, 0 == X.getString(&result, i));
+            ASSERTV(i, LENGTH == static_cast<int>(result.length()));
+            ASSERTV(i, field.end() == result.end());
+            ASSERTV(i, bsl::string(LENGTH, char('a' + i)) == result);
+        }
+
+        for (int i = NUM_LENGTHS; i < X.numFields(); ++i) {
+            const bslstl::StringRef SENTINEL("sentinel");
+
+            bslstl::StringRef result(SENTINEL);
+            ASSERTV(i, 0 != X.getString(&result, i));
+            ASSERTV(i, SENTINEL.data() == result.data());
+            ASSERTV(i, SENTINEL.length() == result.length());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            bslstl::StringRef result;
+            ASSERT_FAIL(X.getString(0, 0));
+            ASSERT_FAIL(X.getString(&result, -1));
+            ASSERT_FAIL(X.getString(&result, X.numFields()));
+            ASSERT_PASS(X.getString(&result, 0));
+            ASSERT_PASS(X.getString(&result, X.numFields() - 1));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'getField'
+        //
+        // Concerns:
+        //: 1 'getField' refers to exactly the bytes of the requested field,
+        //:   in the buffer, for every field of a record, including empty
+        //:   fields.
+        //:
+        //: 2 A field whose offset table entries are inconsistent (i.e., it
+        //:   ends before it begins, or beyond the last field) is reported,
+        //:   and 'result' is unchanged.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For records of 0 to 20 fields of varying lengths (including
+        //:   zero), verify the address and length of every field.  (C-1)
+        //:
+        //: 2 Corrupt the end offsets of a hand-crafted record and verify the
+        //:   fields affected.  (C-2)
+        //:
+        //: 3 Verify that defensive checks are triggered for invalid
+        //:   arguments.  (C-3)
+        //
+        // Testing:
+        //   int getField(bslstl::StringRef *result, int index) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'getField'" << endl
+                          << "==========" << endl;
+
+        if (verbose) cout << "\nTesting well-formed records." << endl;
+
+        for (int n = 0; n <= 20; ++n) {
+            IndexedRecordWriter writer(VERSION_SELECTOR, &ta);
+
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < (i * 7) % 5; ++j) {
+                    writer.stream().putInt8(i);
+                }
+                writer.closeField();
+            }
+
+            ByteOutStream out(VERSION_SELECTOR, &ta);
+            writer.streamOut(out);
+
+            Obj mX;  const Obj& X = mX;
+            ASSERTV(n, 0 == mX.load(out.data(), out.length()));
+            ASSERTV(n, n == X.numFields());
+
+            const char *expected = out.data() + 4 * (n + 1);
+            for (int i = 0; i < n; ++i) {
+                const int LENGTH = (i * 7) % 5;
+
+                bslstl::StringRef field;
+                ASSERTV(n, i, 0 == X.getField(&field, i));
+                ASSERTV(n, i, expected == field.data());
+                ASSERTV(n, i, LENGTH == static_cast<int>(field.length()));
+                for (int j = 0; j < LENGTH; ++j) {
+                    ASSERTV(n, i, j, i == field[j]);
+                }
+                expected += LENGTH;
+            }
+            ASSERTV(n, out.data() + out.length() == expected);
+        }
+
+        if (verbose) cout << "\nTesting inconsistent offsets." << endl;
+        {
+            static const struct {
+                int          d_line;      // source line number
+                unsigned int d_ends[4];   // end offsets of the fields
+                const char  *d_valid_p;   // expected validity of each field
+            } DATA[] = {
+                //LINE  ENDS                VALID
+                //----  ------------------  ------
+                { L_,   {  2,  4,  6,  8 }, "1111" },
+                { L_,   {  4,  2,  6,  8 }, "1011" },
+                { L_,   {  9,  4,  6,  8 }, "0011" },
+                { L_,   {  2,  9,  6,  8 }, "1001" },
+                { L_,   {  2,  4,  6,  5 }, "1100" },
+                { L_,   {  0,  0,  0,  8 }, "1111" },
+                { L_,   {  8,  8,  8,  8 }, "1111" },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int           LINE  = DATA[ti].d_line;
+                const unsigned int *ENDS  = DATA[ti].d_ends;
+                const char         *VALID = DATA[ti].d_valid_p;
+
+                ByteOutStream out(VERSION_SELECTOR, &ta);
+                out.putUint32(4);
+                out.putArrayUint32(ENDS, 4);
+                out.putArrayInt8("01234567", ENDS[3]);
+
+                Obj mX;  const Obj& X = mX;
+                ASSERTV(LINE, 0 == mX.load(out.data(), out.length()));
+
+                for (int i = 0; i < 4; ++i) {
+                    const bool EXP = '1' == VALID[i];
+
+                    bslstl::StringRef field("sentinel");
+                    const int         rc = X.getField(&field, i);
+
+                    ASSERTV(LINE, i, EXP == (0 == rc));
+                    if (EXP) {
+                        const unsigned int BEGIN = i ? ENDS[i - 1] : 0;
+
+                        ASSERTV(LINE, i, out.data() + 20 + BEGIN ==
+                                                                field.data());
+                        ASSERTV(LINE, i, ENDS[i] - BEGIN ==
+                                                              field.length());
+                    }
+                    else {
+                        ASSERTV(LINE, i, "sentinel" == field);
+                    }
+                }
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            IndexedRecordWriter writer(VERSION_SELECTOR, &ta);
+            writer.appendField(1);
+            writer.appendField(2);
+
+            ByteOutStream out(VERSION_SELECTOR, &ta);
+            writer.streamOut(out);
+
+            Obj mX;  const Obj& X = mX;
+            mX.load(out.data(), out.length());
+
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            bslstl::StringRef field;
+            ASSERT_SAFE_FAIL(X.getField(0, 0));
+            ASSERT_SAFE_FAIL(X.getField(&field, -1));
+            ASSERT_SAFE_FAIL(X.getField(&field, 2));
+            ASSERT_SAFE_PASS(X.getField(&field, 0));
+            ASSERT_SAFE_PASS(X.getField(&field, 1));
+
+            mX.reset();
+            ASSERT_SAFE_FAIL(X.getField(&field, 0));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // 'load', 'reset', AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A default-constructed reader refers to no record.
+        //:
+        //: 2 'load' succeeds if, and only if, the buffer holds the count, the
+        //:   offset table, and the fields the table describes, and the
+        //:   accessors then describe the record.
+        //:
+        //: 3 The buffer may extend beyond the record.
+        //:
+        //: 4 A failed 'load', or 'reset', leaves the reader referring to no
+        //:   record, whatever it referred to before.
+        //:
+        //: 5 A field count too large for the buffer is rejected without
+        //:   overflow.
+        //:
+        //: 6 The reader allocates no memory.
+        //:
+        //: 7 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Load each of a table of hand-crafted buffers, some truncated, and
+        //:   verify the return value and the accessors.  (C-1..6)
+        //:
+        //: 2 Verify that defensive checks are triggered for a null buffer of
+        //:   non-zero length.  (C-7)
+        //
+        // Testing:
+        //   IndexedRecordReader();
+        //   int load(const char *buffer, bsl::size_t numBytes);
+        //   void reset();
+        //   const char *data() const;
+        //   bsl::size_t length() const;
+        //   int numFields() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'load', 'reset', AND BASIC ACCESSORS" << endl
+                          << "====================================" << endl;
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(0 == X.data());
+            ASSERT(0 == X.length());
+            ASSERT(0 == X.numFields());
+        }
+
+        static const struct {
+            int          d_line;       // source line number
+            const char  *d_buffer_p;   // buffer to load
+            int          d_numBytes;   // length of 'd_buffer_p'
+            int          d_numFields;  // expected number of fields, or -1 if
+                                       // the load fails
+            int          d_length;     // expected length of the record
+        } DATA[] = {
+            //LINE  BUFFER                                    LEN   NF  RLEN
+            //----  ----------------------------------------  ---   --  ----
+            { L_,   "",                                         0,  -1,    0 },
+            { L_,   "\0\0\0",                                   3,  -1,    0 },
+            { L_,   "\0\0\0\0",                                 4,   0,    4 },
+            { L_,   "\0\0\0\0\x55",                             5,   0,    4 },
+            { L_,   "\0\0\0\x01",                               4,  -1,    0 },
+            { L_,   "\0\0\0\x01\0\0\0",                         7,  -1,    0 },
+            { L_,   "\0\0\0\x01\0\0\0\0",                       8,   1,    8 },
+            { L_,   "\0\0\0\x01\0\0\0\x02\x41",                 9,  -1,    0 },
+            { L_,   "\0\0\0\x01\0\0\0\x02\x41\x42",            10,   1,   10 },
+            { L_,   "\0\0\0\x01\0\0\0\x02\x41\x42\x43",        11,   1,   10 },
+            { L_,   "\0\0\0\x02\0\0\0\x01\0\0\0\x02\x41\x42",  14,   2,   14 },
+            { L_,   "\0\0\0\x02\0\0\0\x01\0\0\0\x03\x41\x42",  14,  -1,    0 },
+            { L_,   "\xff\xff\xff\xff\0\0\0\0\0\0\0\0",        12,  -1,    0 },
+            { L_,   "\x40\0\0\0\0\0\0\0\0\0\0\0",              12,  -1,    0 },
+            { L_,   "\0\0\0\x01\x80\0\0\0\0\0\0\0",            12,  -1,    0 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        const char *PREVIOUS = "\0\0\0\0";
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int   LINE       = DATA[ti].d_line;
+            const char *BUFFER     = DATA[ti].d_buffer_p;
+            const int   NUM_BYTES  = DATA[ti].d_numBytes;
+            const int   NUM_FIELDS = DATA[ti].d_numFields;
+            const int   LENGTH     = DATA[ti].d_length;
+
+            if (veryVerbose) { T_ P_(LINE) P(NUM_BYTES) }
+
+            Obj mX;  const Obj& X = mX;
+            ASSERTV(LINE, 0 == mX.load(PREVIOUS, 4));
+            ASSERTV(LINE, PREVIOUS == X.data());
+
+            const int rc = mX.load(NUM_BYTES ? BUFFER : 0, NUM_BYTES);
+
+            if (0 <= NUM_FIELDS) {
+                ASSERTV(LINE, rc, 0 == rc);
+                ASSERTV(LINE, BUFFER     == X.data());
+                ASSERTV(LINE, NUM_FIELDS == X.numFields());
+                ASSERTV(LINE, X.length(),
+                        static_cast<bsl::size_t>(LENGTH) == X.length());
+            }
+            else {
+                ASSERTV(LINE, 0 != rc);
+                ASSERTV(LINE, 0 == X.data());
+                ASSERTV(LINE, 0 == X.numFields());
+                ASSERTV(LINE, 0 == X.length());
+            }
+
+            mX.reset();
+            ASSERTV(LINE, 0 == X.data());
+            ASSERTV(LINE, 0 == X.numFields());
+            ASSERTV(LINE, 0 == X.length());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            Obj mX;
+
+            ASSERT_FAIL(mX.load(0, 4));
+            ASSERT_PASS(mX.load(0, 0));
+            ASSERT_PASS(mX.load("\0\0\0\0", 4));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Read the fields of a record written by 'IndexedRecordWriter'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        IndexedRecordWriter writer(VERSION_SELECTOR, &ta);
+        writer.appendField(bsl::string("key"));
+        writer.appendField(42);
+
+        ByteOutStream out(VERSION_SELECTOR, &ta);
+        writer.streamOut(out);
+
+        Obj mX;  const Obj& X = mX;
+        ASSERT(0 == mX.load(out.data(), out.length()));
+        ASSERT(2 == X.numFields());
+        ASSERT(out.length() == X.length());
+
+        bslstl::StringRef key;
+        ASSERT(0 == X.getString(&key, 0));
+        ASSERT("key" == key);
+
+        int value;
+        ASSERT(0 == X.getValue(&value, 1));
+        ASSERT(42 == value);
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: ONE FIELD VERSUS FULL UNEXTERNALIZATION
+        //
+        // Concerns:
+        //: 1 Reading one header field of a large message from an indexed
+        //:   record is substantially faster than unexternalizing the whole
+        //:   message.
+        //
+        // Plan:
+        //: 1 Write a message having a 64-byte routing key and a 4000-element
+        //:   body both sequentially and as an indexed record, and time
+        //:   reading the routing key and priority from each, many times.
+        //:   (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: ONE FIELD VERSUS FULL UNEXTERNALIZATION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                     << endl
+                     << "PERFORMANCE: ONE FIELD VERSUS FULL UNEXTERNALIZATION"
+                     << endl
+                     << "===================================================="
+                     << endl;
+
+        const int         NUM_ITERATIONS = argc > 2 ? atoi(argv[2]) : 100000;
+        const bsl::string KEY(64, 'k', &ta);
+
+        bsl::vector<double> body(4000, 1.5, &ta);
+
+        ByteOutStream sequential(VERSION_SELECTOR, &ta);
+        sequential.putString(KEY);
+        sequential.putInt32(7);
+        sequential.putLength(static_cast<int>(body.size()));
+        sequential.putArrayFloat64(body.data(), static_cast<int>(body.size()));
+
+        IndexedRecordWriter writer(VERSION_SELECTOR, &ta);
+        writer.appendField(KEY);
+        writer.appendField(7);
+        writer.stream().putLength(static_cast<int>(body.size()));
+        writer.stream().putArrayFloat64(body.data(),
+                                        static_cast<int>(body.size()));
+        writer.closeField();
+
+        ByteOutStream indexed(VERSION_SELECTOR, &ta);
+        writer.streamOut(indexed);
+
+        bsls::Types::Int64 checksum = 0;
+        bsls::Stopwatch    timer;
+
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            Message      message;
+            ByteInStream in(sequential.data(), sequential.length());
+            message.bdexStreamIn(in);
+            checksum += message.d_priority + message.d_routingKey.length();
+        }
+        timer.stop();
+        const double sequentialTime = timer.elapsedTime();
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            Obj               reader;
+            bslstl::StringRef key;
+            int               priority = 0;
+            reader.load(indexed.data(), indexed.length());
+            reader.getString(&key, 0);
+            reader.getValue(&priority, 1);
+            checksum -= priority + key.length();
+        }
+        timer.stop();
+        const double indexedTime = timer.elapsedTime();
+
+        ASSERTV(checksum, 0 == checksum);
+
+        cout << "Sequential: " << sequentialTime << "s, "
+             << "indexed: "    << indexedTime    << "s, "
+             << "for "         << NUM_ITERATIONS << " messages of "
+             << indexed.length() << " bytes" << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
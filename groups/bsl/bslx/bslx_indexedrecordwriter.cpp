@@ -0,0 +1,52 @@
+// bslx_indexedrecordwriter.cpp                                       -*-C++-*-
+#include <bslx_indexedrecordwriter.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bslx_indexedrecordwriter_cpp,"$Id$ $CSID$")
+
+#include <bsl_climits.h>
+
+namespace BloombergLP {
+namespace bslx {
+
+                        // -------------------------
+                        // class IndexedRecordWriter
+                        // -------------------------
+
+// MANIPULATORS
+void IndexedRecordWriter::closeField()
+{
+    const bsl::size_t length = d_stream.length();
+
+    if (length > static_cast<bsl::size_t>(INT_MAX)) {
+        d_stream.invalidate();
+        return;                                                       // RETURN
+    }
+
+    d_fieldEnds.push_back(static_cast<unsigned int>(length));
+}
+
+void IndexedRecordWriter::reset()
+{
+    d_stream.reset();
+    d_fieldEnds.clear();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
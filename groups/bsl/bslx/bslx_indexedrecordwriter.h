@@ -0,0 +1,334 @@
+// bslx_indexedrecordwriter.h                                         -*-C++-*-
+#ifndef INCLUDED_BSLX_INDEXEDRECORDWRITER
+#define INCLUDED_BSLX_INDEXEDRECORDWRITER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a writer of BDEX fields preceded by an offset table.
+//
+//@CLASSES:
+//  bslx::IndexedRecordWriter: writer of offset-indexed records of BDEX fields
+//
+//@SEE_ALSO: bslx_indexedrecordreader, bslx_byteoutstream
+//
+//@DESCRIPTION: This component provides a class, 'bslx::IndexedRecordWriter',
+// that externalizes a sequence of BDEX-encoded *fields* as an *indexed*
+// *record*: the fields are preceded by a table of their offsets, so that a
+// reader (see 'bslx_indexedrecordreader') can locate any one field in
+// constant time, and decode it directly from the buffer, without decoding the
+// fields that precede it.
+//
+// Each field is written, exactly as it would be written to a
+// 'bslx::ByteOutStream', to a stream owned by the writer, either in one step
+// by 'appendField' (which uses 'operator<<'), or by any number of calls on
+// 'stream' followed by 'closeField'.  Once all of the fields have been
+// written, 'streamOut' writes the complete record to any BDEX output stream.
+// Note that, since the size of the offset table is not known until the last
+// field is closed, the field bytes are copied once, by 'streamOut'.
+//
+///Indexed Record Format
+///---------------------
+// An indexed record having 'N' fields consists of the following, where each
+// 'Uint32' is written as by 'putUint32' (i.e., in network byte order):
+//..
+//  +-----------+----------+----------+-----+--------------+----------------+
+//  | N         | end[0]   | end[1]   | ... | end[N - 1]   | field bytes    |
+//  | (Uint32)  | (Uint32) | (Uint32) |     | (Uint32)     | (end[N - 1])   |
+//  +-----------+----------+----------+-----+--------------+----------------+
+//..
+// The bytes of field 'i' begin at offset 'i ? end[i - 1] : 0' and end at
+// offset 'end[i]', relative to the first field byte, and the record occupies
+// '4 * (N + 1) + (N ? end[N - 1] : 0)' bytes in total.  An empty field (i.e.,
+// one closed with no bytes written) is permitted.  The combined length of the
+// fields of a record must be less than 2^31 bytes.
+//
+// The format is distinct from the sequential BDEX encoding of the same
+// values, so a type adopting it for an existing type must do so in a new BDEX
+// version (see {'bslx_byteinstream'|Example 2}).
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Writing a Message With an Indexed Header
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that messages routed through our system have a routing key, a
+// priority, and a (possibly large) body, and that routers need to inspect
+// only the first two.  We write each message as an indexed record, so that
+// a router can read the routing key and priority without decoding the body
+// (see {'bslx_indexedrecordreader'|Example 1}).
+//
+// First, we create a writer and append the routing key and the priority as
+// single-value fields:
+//..
+//  bslx::IndexedRecordWriter writer(20160101);
+//
+//  writer.appendField(bsl::string("EQ.US.IBM"));
+//  writer.appendField(7);
+//..
+// Then, we write the body, which is made up of a count and an array of
+// prices, to the writer's 'stream', and close the field:
+//..
+//  const double prices[] = { 142.10, 142.15, 142.05 };
+//
+//  writer.stream().putLength(3);
+//  writer.stream().putArrayFloat64(prices, 3);
+//  writer.closeField();
+//
+//  assert(3 == writer.numFields());
+//..
+// Finally, we write the record to an output stream:
+//..
+//  bslx::ByteOutStream out(20160101);
+//  writer.streamOut(out);
+//
+//  assert(out);
+//  assert(writer.length() == out.length());
+//  assert(16 + 10 + 4 + 25 == out.length());
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLX_BYTEOUTSTREAM
+#include <bslx_byteoutstream.h>
+#endif
+
+#ifndef INCLUDED_BSLX_MARSHALLINGUTIL
+#include <bslx_marshallingutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_INTEGRALCONSTANT
+#include <bslmf_integralconstant.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bslx {
+
+                         // =========================
+                         // class IndexedRecordWriter
+                         // =========================
+
+class IndexedRecordWriter {
+    // This class provides a mechanism to build an indexed record (see
+    // {Indexed Record Format}) from a sequence of fields, each written as to
+    // a 'bslx::ByteOutStream', and to write the record to a BDEX output
+    // stream.  A writer is *valid* unless a field could not be written, or
+    // the combined length of the fields is 2^31 bytes or more; 'streamOut'
+    // invalidates its stream if this writer is invalid.
+
+    // DATA
+    ByteOutStream             d_stream;     // bytes of all fields written so
+                                            // far
+
+    bsl::vector<unsigned int> d_fieldEnds;  // offset, in 'd_stream', of the
+                                            // end of each closed field
+
+    // NOT IMPLEMENTED
+    IndexedRecordWriter(const IndexedRecordWriter&);
+    IndexedRecordWriter& operator=(const IndexedRecordWriter&);
+
+  public:
+    // CREATORS
+    explicit IndexedRecordWriter(int               versionSelector,
+                                 bslma::Allocator *basicAllocator = 0);
+        // Create a writer having no fields that will use the specified
+        // (*compile*-time-defined) 'versionSelector' when fields are appended
+        // with 'operator<<' semantics.  Optionally specify a 'basicAllocator'
+        // used to supply memory.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.  Note that the
+        // 'versionSelector' is expected to be formatted as "YYYYMMDD", a date
+        // representation.
+
+    ~IndexedRecordWriter();
+        // Destroy this object.
+
+    // MANIPULATORS
+    template <class TYPE>
+    IndexedRecordWriter& appendField(const TYPE& value);
+        // Write the specified 'value' to the stream of this writer as by
+        // 'operator<<' (i.e., preceded by its version, if 'TYPE' is
+        // versioned), close the field (see 'closeField'), and return a
+        // reference to this writer.  The behavior is undefined unless no
+        // bytes have been written to 'stream' since the last field was
+        // closed.
+
+    void closeField();
+        // Append a field consisting of the bytes written to 'stream' since
+        // the previous field was closed (or since this writer was created or
+        // reset).  If the combined length of the fields would be 2^31 bytes
+        // or more, invalidate this writer.
+
+    void reset();
+        // Remove all fields from this writer, discard any bytes written to
+        // 'stream' since the last field was closed, and validate this writer.
+
+    ByteOutStream& stream();
+        // Return a reference providing modifiable access to the stream to
+        // which the bytes of the current field are to be written.  The bytes
+        // written become a field when 'closeField' is called.  Note that the
+        // stream must not be reset or have its capacity adjusted directly.
+
+    // ACCESSORS
+    bool isValid() const;
+        // Return 'true' if this writer is valid, and 'false' otherwise.
+
+    bsl::size_t length() const;
+        // Return the number of bytes that 'streamOut' writes if this writer
+        // is valid.
+
+    int numFields() const;
+        // Return the number of fields that have been closed in this writer.
+
+    template <class STREAM>
+    STREAM& streamOut(STREAM& stream) const;
+        // Write to the specified output 'stream' the indexed record (see
+        // {Indexed Record Format}) of the closed fields of this writer, and
+        // return a reference to 'stream'.  If this writer is invalid,
+        // invalidate 'stream' instead.  If 'stream' is initially invalid,
+        // this operation has no effect.  Note that bytes written to 'stream'
+        // after the last field was closed are not part of the record.
+};
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                         // -------------------------
+                         // class IndexedRecordWriter
+                         // -------------------------
+
+// CREATORS
+inline
+IndexedRecordWriter::IndexedRecordWriter(int               versionSelector,
+                                         bslma::Allocator *basicAllocator)
+: d_stream(versionSelector, basicAllocator)
+, d_fieldEnds(basicAllocator)
+{
+}
+
+inline
+IndexedRecordWriter::~IndexedRecordWriter()
+{
+}
+
+// MANIPULATORS
+template <class TYPE>
+inline
+IndexedRecordWriter& IndexedRecordWriter::appendField(const TYPE& value)
+{
+    BSLS_ASSERT_SAFE(d_stream.length() ==
+                           (d_fieldEnds.empty() ? 0u : d_fieldEnds.back()));
+
+    d_stream << value;
+    closeField();
+
+    return *this;
+}
+
+inline
+ByteOutStream& IndexedRecordWriter::stream()
+{
+    return d_stream;
+}
+
+// ACCESSORS
+inline
+bool IndexedRecordWriter::isValid() const
+{
+    return d_stream.isValid();
+}
+
+inline
+bsl::size_t IndexedRecordWriter::length() const
+{
+    return MarshallingUtil::k_SIZEOF_INT32 * (d_fieldEnds.size() + 1)
+         + (d_fieldEnds.empty() ? 0 : d_fieldEnds.back());
+}
+
+inline
+int IndexedRecordWriter::numFields() const
+{
+    return static_cast<int>(d_fieldEnds.size());
+}
+
+template <class STREAM>
+STREAM& IndexedRecordWriter::streamOut(STREAM& stream) const
+{
+    if (!stream) {
+        return stream;                                                // RETURN
+    }
+
+    if (!isValid()) {
+        stream.invalidate();
+        return stream;                                                // RETURN
+    }
+
+    const int numEnds = static_cast<int>(d_fieldEnds.size());
+
+    stream.putUint32(numEnds);
+    if (numEnds) {
+        stream.putArrayUint32(d_fieldEnds.data(), numEnds);
+        if (d_fieldEnds.back()) {
+            stream.putArrayInt8(d_stream.data(),
+                                static_cast<int>(d_fieldEnds.back()));
+        }
+    }
+
+    return stream;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// TRAITS
+namespace BloombergLP {
+namespace bslma {
+
+template <>
+struct UsesBslmaAllocator<bslx::IndexedRecordWriter> : bsl::true_type {};
+
+}  // close 'bslma' namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,603 @@
+// bslx_indexedrecordwriter.t.cpp                                     -*-C++-*-
+
+#include <bslx_indexedrecordwriter.h>
+
+#include <bslx_byteoutstream.h>
+
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+using namespace bslx;
+
+// ============================================================================
+//                              TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// An 'IndexedRecordWriter' accumulates the bytes of its fields in a
+// 'bslx::ByteOutStream' and records the end offset of each field.  We are
+// concerned that the fields are delimited where 'closeField' (or
+// 'appendField') is called, that the record written by 'streamOut' matches
+// the documented format byte for byte, and that invalidity of the writer, or
+// of the target stream, is handled as documented.  We verify the output by
+// comparing it with records assembled by hand from a 'bslx::ByteOutStream'.
+// ----------------------------------------------------------------------------
+// [ 2] explicit IndexedRecordWriter(int sV, *ba = 0);
+// [ 2] ~IndexedRecordWriter();
+// [ 3] IndexedRecordWriter& appendField(const TYPE& value);
+// [ 2] void closeField();
+// [ 2] void reset();
+// [ 2] ByteOutStream& stream();
+// [ 2] bool isValid() const;
+// [ 2] bsl::size_t length() const;
+// [ 2] int numFields() const;
+// [ 4] STREAM& streamOut(STREAM& stream) const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACROS
+// ----------------------------------------------------------------------------
+
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                      STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef IndexedRecordWriter Obj;
+
+const int VERSION_SELECTOR = 20131127;
+
+// ============================================================================
+//                      HELPER CLASSES AND FUNCTIONS
+// ----------------------------------------------------------------------------
+
+class VersionedInt {
+    // This class holds an 'int' that is externalized as a single byte,
+    // preceded by the BDEX version 3 when streamed with 'operator<<'.
+
+    // DATA
+    int d_value;  // held value
+
+  public:
+    // CLASS METHODS
+    static int maxSupportedBdexVersion(int /* versionSelector */)
+        // Return the BDEX version, 3, of this class.
+    {
+        return 3;
+    }
+
+    // CREATORS
+    explicit VersionedInt(int value)
+        // Create an object holding the specified 'value'.
+    : d_value(value)
+    {
+    }
+
+    // ACCESSORS
+    template <class STREAM>
+    STREAM& bdexStreamOut(STREAM& stream, int version) const
+        // Write the value of this object, using the specified 'version'
+        // format, to the specified output 'stream', and return a reference to
+        // 'stream'.
+    {
+        if (3 == version) {
+            stream.putInt8(d_value);
+        }
+        else {
+            stream.invalidate();
+        }
+        return stream;
+    }
+};
+
+static bsl::string toString(const ByteOutStream& stream)
+    // Return the bytes written to the specified 'stream'.
+{
+    return bsl::string(stream.data(), stream.length());
+}
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVeryVerbose = argc > 5;
+
+    (void) veryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file must
+        //:   compile, link, and run as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, replace
+        //:   leading comment characters with spaces, and replace 'assert'
+        //:   with 'ASSERT'.  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Writing a Message With an Indexed Header
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that messages routed through our system have a routing key, a
+// priority, and a (possibly large) body, and that routers need to inspect
+// only the first two.  We write each message as an indexed record, so that
+// a router can read the routing key and priority without decoding the body
+// (see {'bslx_indexedrecordreader'|Example 1}).
+//
+// First, we create a writer and append the routing key and the priority as
+// single-value fields:
+//..
+    bslx::IndexedRecordWriter writer(20160101);
+
+    writer.appendField(bsl::string("EQ.US.IBM"));
+    writer.appendField(7);
+//..
+// Then, we write the body, which is made up of a count and an array of
+// prices, to the writer's 'stream', and close the field:
+//..
+    const double prices[] = { 142.10, 142.15, 142.05 };
+
+    writer.stream().putLength(3);
+    writer.stream().putArrayFloat64(prices, 3);
+    writer.closeField();
+
+    ASSERT(3 == writer.numFields());
+//..
+// Finally, we write the record to an output stream:
+//..
+    bslx::ByteOutStream out(20160101);
+    writer.streamOut(out);
+
+    ASSERT(out);
+    ASSERT(writer.length() == out.length());
+    ASSERT(16 + 10 + 4 + 25 == out.length());
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'streamOut'
+        //
+        // Concerns:
+        //: 1 'streamOut' writes the field count, the end offset of each
+        //:   field, and the field bytes, as documented.
+        //:
+        //: 2 Empty fields, and records having no fields, are written
+        //:   correctly.
+        //:
+        //: 3 Bytes written to 'stream' after the last field was closed are
+        //:   not written.
+        //:
+        //: 4 'streamOut' appends to the existing content of the target
+        //:   stream.
+        //:
+        //: 5 If the writer is invalid, the target stream is invalidated and
+        //:   nothing is written.
+        //:
+        //: 6 If the target stream is invalid, nothing is written.
+        //:
+        //: 7 'streamOut' returns a reference to the target stream.
+        //
+        // Plan:
+        //: 1 Write records having various fields and compare the output with
+        //:   the expected bytes, assembled with a 'bslx::ByteOutStream'.
+        //:   (C-1..4, 7)
+        //:
+        //: 2 Invalidate the writer, and then the target stream, and verify
+        //:   the output.  (C-5..6)
+        //
+        // Testing:
+        //   STREAM& streamOut(STREAM& stream) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'streamOut'" << endl
+                          << "===========" << endl;
+
+        if (verbose) cout << "\nTesting the record format." << endl;
+        {
+            Obj mX(VERSION_SELECTOR, &ta);  const Obj& X = mX;
+
+            ByteOutStream out(VERSION_SELECTOR, &ta);
+            ASSERT(&out == &X.streamOut(out));
+            ASSERT(bsl::string("\0\0\0\0", 4) == toString(out));
+            ASSERT(X.length() == out.length());
+
+            mX.appendField(0x01020304);
+            mX.closeField();
+            mX.appendField(bsl::string("abc"));
+            mX.stream().putInt8(9);                      // not closed
+
+            ByteOutStream exp(VERSION_SELECTOR, &ta);
+            exp.putUint32(3);
+            exp.putUint32(4);
+            exp.putUint32(4);
+            exp.putUint32(8);
+            exp.putInt32(0x01020304);
+            exp.putString("abc");
+
+            out.reset();
+            X.streamOut(out);
+            ASSERT(out);
+            ASSERT(toString(exp) == toString(out));
+            ASSERT(X.length() == out.length());
+
+            // 'streamOut' appends to the target stream.
+
+            out.reset();
+            out.putInt8(0x7f);
+            X.streamOut(out);
+            ASSERT(bsl::string("\x7f") + toString(exp) == toString(out));
+        }
+        {
+            // A field longer than 127 bytes, and fields closed with no bytes.
+
+            Obj mX(VERSION_SELECTOR, &ta);  const Obj& X = mX;
+
+            const bsl::string LONG(300, 'x', &ta);
+            mX.closeField();
+            mX.appendField(LONG);
+            mX.closeField();
+
+            ByteOutStream exp(VERSION_SELECTOR, &ta);
+            exp.putUint32(3);
+            exp.putUint32(0);
+            exp.putUint32(304);
+            exp.putUint32(304);
+            exp.putString(LONG);
+
+            ByteOutStream out(VERSION_SELECTOR, &ta);
+            X.streamOut(out);
+            ASSERT(toString(exp) == toString(out));
+            ASSERT(X.length() == out.length());
+        }
+
+        if (verbose) cout << "\nTesting invalid writers and streams." << endl;
+        {
+            Obj mX(VERSION_SELECTOR, &ta);  const Obj& X = mX;
+
+            mX.appendField(1);
+            mX.stream().invalidate();
+            ASSERT(!X.isValid());
+
+            ByteOutStream out(VERSION_SELECTOR, &ta);
+            out.putInt8(1);
+            ASSERT(&out == &X.streamOut(out));
+            ASSERT(!out);
+            ASSERT(1 == out.length());
+        }
+        {
+            Obj mX(VERSION_SELECTOR, &ta);  const Obj& X = mX;
+
+            mX.appendField(1);
+
+            ByteOutStream out(VERSION_SELECTOR, &ta);
+            out.invalidate();
+            ASSERT(&out == &X.streamOut(out));
+            ASSERT(!out);
+            ASSERT(0 == out.length());
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'appendField'
+        //
+        // Concerns:
+        //: 1 'appendField' writes the value as 'operator<<' does, including
+        //:   the version of a versioned type, and closes the field.
+        //:
+        //: 2 'appendField' returns a reference to the writer.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Append values of fundamental, string, and versioned types, and
+        //:   compare the bytes of 'stream' with those written by
+        //:   'operator<<' to a 'bslx::ByteOutStream'.  (C-1..2)
+        //:
+        //: 2 Verify that defensive checks are triggered when bytes have been
+        //:   written to 'stream' since the last field was closed.  (C-3)
+        //
+        // Testing:
+        //   IndexedRecordWriter& appendField(const TYPE& value);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'appendField'" << endl
+                          << "=============" << endl;
+
+        {
+            Obj mX(VERSION_SELECTOR, &ta);  const Obj& X = mX;
+
+            ByteOutStream exp(VERSION_SELECTOR, &ta);
+
+            ASSERT(&mX == &mX.appendField(7));
+            exp << 7;
+            ASSERT(1 == X.numFields());
+            ASSERT(toString(exp) == toString(mX.stream()));
+
+            ASSERT(&mX == &mX.appendField(2.5));
+            exp << 2.5;
+            ASSERT(2 == X.numFields());
+            ASSERT(toString(exp) == toString(mX.stream()));
+
+            ASSERT(&mX == &mX.appendField(bsl::string("hello")));
+            exp << bsl::string("hello");
+            ASSERT(3 == X.numFields());
+            ASSERT(toString(exp) == toString(mX.stream()));
+
+            ASSERT(&mX == &mX.appendField(VersionedInt(5)));
+            exp << VersionedInt(5);
+            ASSERT(4 == X.numFields());
+            ASSERT(toString(exp) == toString(mX.stream()));
+            ASSERT(bsl::string("\x03\x05") ==
+                              toString(mX.stream()).substr(exp.length() - 2));
+
+            ASSERT(X.isValid());
+            ASSERT(20 + 4 + 8 + 6 + 2 == X.length());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            Obj mX(VERSION_SELECTOR, &ta);
+
+            ASSERT_SAFE_PASS(mX.appendField(1));
+            mX.stream().putInt8(1);
+            ASSERT_SAFE_FAIL(mX.appendField(1));
+            mX.closeField();
+            ASSERT_SAFE_PASS(mX.appendField(1));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A newly created writer is valid, has no fields, and has the
+        //:   length of an empty record.
+        //:
+        //: 2 'stream' has the version selector supplied at construction, and
+        //:   uses the object allocator.
+        //:
+        //: 3 'closeField' delimits a field at the current length of 'stream',
+        //:   even if no bytes were written to it.
+        //:
+        //: 4 'length' accounts for the offset table and the closed fields
+        //:   only.
+        //:
+        //: 5 'isValid' reflects the validity of 'stream'.
+        //:
+        //: 6 'reset' removes all fields and discards unclosed bytes, and
+        //:   validates the writer.
+        //:
+        //: 7 No memory is allocated from the default allocator, and all
+        //:   memory is released on destruction.
+        //
+        // Plan:
+        //: 1 Write fields of various sizes, and verify the accessors after
+        //:   each step, while monitoring the allocators.  (C-1..7)
+        //
+        // Testing:
+        //   explicit IndexedRecordWriter(int sV, *ba = 0);
+        //   ~IndexedRecordWriter();
+        //   void closeField();
+        //   void reset();
+        //   ByteOutStream& stream();
+        //   bool isValid() const;
+        //   bsl::size_t length() const;
+        //   int numFields() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                         << endl
+                         << "PRIMARY MANIPULATORS AND BASIC ACCESSORS" << endl
+                         << "========================================" << endl;
+
+        {
+            Obj mX(VERSION_SELECTOR, &ta);  const Obj& X = mX;
+
+            ASSERT(X.isValid());
+            ASSERT(0 == X.numFields());
+            ASSERT(4 == X.length());
+            ASSERT(VERSION_SELECTOR == mX.stream().bdexVersionSelector());
+
+            mX.stream().putInt32(1);
+            ASSERT(0 == X.numFields());
+            ASSERT(4 == X.length());
+
+            mX.closeField();
+            ASSERT(1 == X.numFields());
+            ASSERT(8 + 4 == X.length());
+
+            mX.closeField();
+            ASSERT(2 == X.numFields());
+            ASSERT(12 + 4 == X.length());
+
+            mX.stream().putInt16(1);
+            mX.stream().putInt8(1);
+            mX.closeField();
+            ASSERT(3 == X.numFields());
+            ASSERT(16 + 7 == X.length());
+
+            ASSERT(0 <  ta.numBlocksInUse());
+            ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+            mX.stream().invalidate();
+            ASSERT(!X.isValid());
+
+            mX.stream().putInt8(1);
+            mX.reset();
+            ASSERT(X.isValid());
+            ASSERT(0 == X.numFields());
+            ASSERT(4 == X.length());
+            ASSERT(0 == mX.stream().length());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+        {
+            // The default allocator is used when none is supplied.
+
+            Obj mX(VERSION_SELECTOR);
+
+            mX.appendField(1);
+            ASSERT(0 < defaultAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Write a record having two fields and verify its bytes.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        Obj mX(VERSION_SELECTOR, &ta);  const Obj& X = mX;
+
+        mX.appendField(0x01020304);
+        mX.stream().putInt8(5);
+        mX.stream().putInt8(6);
+        mX.closeField();
+        ASSERT(2 == X.numFields());
+
+        ByteOutStream out(VERSION_SELECTOR, &ta);
+        X.streamOut(out);
+        ASSERT(out);
+        ASSERT(bsl::string("\0\0\0\x02\0\0\0\x04\0\0\0\x06"
+                           "\x01\x02\x03\x04\x05\x06", 18) == toString(out));
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -4,9 +4,284 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(bslx_marshallingutil_cpp,"$Id$ $CSID$")
 
+#include <bsls_byteorder.h>
+#include <bsls_performancehint.h>
+
 namespace BloombergLP {
 namespace bslx {
 
+namespace {
+
+typedef bsls::Types::Int64  Int64;
+typedef bsls::Types::Uint64 Uint64;
+
+const Uint64 k_CONTINUATION_BITS = 0x8080808080808080ULL;
+    // mask of the continuation bit of each byte of a 64-bit word
+
+const Uint64 k_LOW_BITS          = 0x0101010101010101ULL;
+    // mask of the least-significant bit of each byte of a 64-bit word
+
+inline
+Uint64 loadLittleEndianWord(const char *buffer)
+    // Return the eight bytes at the specified 'buffer' interpreted as a 64-bit
+    // unsigned integer in little-endian byte order.
+{
+    Uint64 word;
+    bsl::memcpy(&word, buffer, sizeof word);
+    return BSLS_BYTEORDER_LE_U64_TO_HOST(word);
+}
+
+int decodeVarUint64(Uint64 *variable, const char *buffer, bsl::size_t length)
+    // Load into the specified 'variable' the value variable-length encoded at
+    // the start of the specified 'buffer' having the specified 'length', and
+    // return the number of bytes consumed.  Return 0, with no effect on
+    // 'variable', if 'buffer' does not begin with a complete and valid
+    // encoding of a 64-bit value.
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(sizeof(Uint64) <= length)) {
+        const Uint64 word  = loadLittleEndianWord(buffer);
+        const Uint64 stops = ~word & k_CONTINUATION_BITS;
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(stops)) {
+            // The encoding ends within the loaded word.  Retain the payload
+            // bits of the bytes up to and including the lowest byte having a
+            // clear continuation bit, and then squeeze out the continuation
+            // bits by merging adjacent 7-, 14-, and 28-bit groups in turn.
+
+            const Uint64 lowest = stops & (0 - stops);
+            const Uint64 mask   = (lowest - 1) | lowest;
+
+            Uint64 x = word & mask & ~k_CONTINUATION_BITS;
+
+            x = (x & 0x007f007f007f007fULL)
+              | (x & 0x7f007f007f007f00ULL) >> 1;
+            x = (x & 0x00003fff00003fffULL)
+              | (x & 0x3fff00003fff0000ULL) >> 2;
+            x = (x & 0x000000000fffffffULL)
+              | (x & 0x0fffffff00000000ULL) >> 4;
+
+            // The number of bytes consumed is the number of bytes covered by
+            // 'mask'.
+
+            const int numBytes = static_cast<int>(
+                              ((mask >> 7) & k_LOW_BITS) * k_LOW_BITS >> 56);
+
+            *variable = x;
+            return numBytes;                                          // RETURN
+        }
+    }
+
+    // The encoding is either longer than eight bytes or near the end of
+    // 'buffer'; decode it one byte at a time.
+
+    bsl::size_t maxNumBytes = MarshallingUtil::k_MAX_SIZEOF_VARINT64;
+    if (length < maxNumBytes) {
+        maxNumBytes = length;
+    }
+
+    Uint64 value = 0;
+    for (bsl::size_t i = 0; i < maxNumBytes; ++i) {
+        const Uint64 byte = static_cast<unsigned char>(buffer[i]);
+
+        value |= (byte & 0x7f) << (7 * i);
+
+        if (!(byte & 0x80)) {
+            if (MarshallingUtil::k_MAX_SIZEOF_VARINT64 - 1 == i && 1 < byte) {
+                return 0;                                             // RETURN
+            }
+            *variable = value;
+            return static_cast<int>(i + 1);                           // RETURN
+        }
+    }
+
+    return 0;
+}
+
+int decodeVarUint32(unsigned int *variable,
+                    const char   *buffer,
+                    bsl::size_t   length)
+    // Load into the specified 'variable' the value variable-length encoded at
+    // the start of the specified 'buffer' having the specified 'length', and
+    // return the number of bytes consumed.  Return 0, with no effect on
+    // 'variable', if 'buffer' does not begin with a complete and valid
+    // encoding of a 32-bit value.
+{
+    Uint64    value;
+    const int numBytes = decodeVarUint64(&value, buffer, length);
+
+    if (0 == numBytes
+     || MarshallingUtil::k_MAX_SIZEOF_VARINT32 < numBytes
+     || 0xffffffffULL < value) {
+        return 0;                                                     // RETURN
+    }
+
+    *variable = static_cast<unsigned int>(value);
+    return numBytes;
+}
+
+                          // ===================
+                          // struct VarUint64Imp
+                          // ===================
+
+struct VarUint64Imp {
+    // This 'struct' provides the operations needed by 'getArrayVarImp' to
+    // decode variable-length unsigned 64-bit values.
+
+    typedef Uint64 ValueType;
+
+    static int decode(Uint64 *variable, const char *buffer, bsl::size_t length)
+        // Decode into the specified 'variable' the encoding at the specified
+        // 'buffer' having the specified 'length', and return the number of
+        // bytes consumed, or 0 on failure.
+    {
+        return decodeVarUint64(variable, buffer, length);
+    }
+
+    static Uint64 fromByte(unsigned char byte)
+        // Return the value whose encoding is the single specified 'byte'.
+    {
+        return byte;
+    }
+};
+
+                          // ==================
+                          // struct VarInt64Imp
+                          // ==================
+
+struct VarInt64Imp {
+    // This 'struct' provides the operations needed by 'getArrayVarImp' to
+    // decode zigzag-transformed variable-length signed 64-bit values.
+
+    typedef Int64 ValueType;
+
+    static int decode(Int64 *variable, const char *buffer, bsl::size_t length)
+        // Decode into the specified 'variable' the encoding at the specified
+        // 'buffer' having the specified 'length', and return the number of
+        // bytes consumed, or 0 on failure.
+    {
+        Uint64    bits;
+        const int numBytes = decodeVarUint64(&bits, buffer, length);
+        if (numBytes) {
+            *variable = static_cast<Int64>((bits >> 1) ^ (0 - (bits & 1)));
+        }
+        return numBytes;
+    }
+
+    static Int64 fromByte(unsigned char byte)
+        // Return the value whose encoding is the single specified 'byte'.
+    {
+        return (byte >> 1) ^ -(byte & 1);
+    }
+};
+
+                          // ===================
+                          // struct VarUint32Imp
+                          // ===================
+
+struct VarUint32Imp {
+    // This 'struct' provides the operations needed by 'getArrayVarImp' to
+    // decode variable-length unsigned 32-bit values.
+
+    typedef unsigned int ValueType;
+
+    static int decode(unsigned int *variable,
+                      const char   *buffer,
+                      bsl::size_t   length)
+        // Decode into the specified 'variable' the encoding at the specified
+        // 'buffer' having the specified 'length', and return the number of
+        // bytes consumed, or 0 on failure.
+    {
+        return decodeVarUint32(variable, buffer, length);
+    }
+
+    static unsigned int fromByte(unsigned char byte)
+        // Return the value whose encoding is the single specified 'byte'.
+    {
+        return byte;
+    }
+};
+
+                          // ==================
+                          // struct VarInt32Imp
+                          // ==================
+
+struct VarInt32Imp {
+    // This 'struct' provides the operations needed by 'getArrayVarImp' to
+    // decode zigzag-transformed variable-length signed 32-bit values.
+
+    typedef int ValueType;
+
+    static int decode(int *variable, const char *buffer, bsl::size_t length)
+        // Decode into the specified 'variable' the encoding at the specified
+        // 'buffer' having the specified 'length', and return the number of
+        // bytes consumed, or 0 on failure.
+    {
+        unsigned int bits;
+        const int    numBytes = decodeVarUint32(&bits, buffer, length);
+        if (numBytes) {
+            *variable = static_cast<int>((bits >> 1) ^ (0 - (bits & 1)));
+        }
+        return numBytes;
+    }
+
+    static int fromByte(unsigned char byte)
+        // Return the value whose encoding is the single specified 'byte'.
+    {
+        return (byte >> 1) ^ -(byte & 1);
+    }
+};
+
+template <class IMP>
+int getArrayVarImp(typename IMP::ValueType *variables,
+                   bsl::size_t             *numBytesConsumed,
+                   const char              *buffer,
+                   bsl::size_t              length,
+                   int                      numVariables)
+    // Load into the specified 'variables' the values of the specified
+    // 'numVariables' consecutive encodings, decoded using the (template
+    // parameter) 'IMP', at the start of the specified 'buffer' having the
+    // specified 'length', and load into the specified 'numBytesConsumed' the
+    // number of bytes consumed.  Return 0 on success, and a non-zero value
+    // otherwise.
+{
+    typedef typename IMP::ValueType ValueType;
+
+    const char      *cursor = buffer;
+    const char      *end    = buffer + length;
+    const ValueType *last   = variables + numVariables;
+
+    while (variables != last) {
+        if (8 <= last - variables
+         && 8 <= end - cursor
+         && 0 == (loadLittleEndianWord(cursor) & k_CONTINUATION_BITS)) {
+            // The next eight encodings are each a single byte, as is typical
+            // of small values, so decode them together.
+
+            const unsigned char *bytes =
+                               reinterpret_cast<const unsigned char *>(cursor);
+            for (int i = 0; i < 8; ++i) {
+                variables[i] = IMP::fromByte(bytes[i]);
+            }
+            variables += 8;
+            cursor    += 8;
+            continue;
+        }
+
+        const int numBytes = IMP::decode(variables, cursor, end - cursor);
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == numBytes)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+            return -1;                                                // RETURN
+        }
+        ++variables;
+        cursor += numBytes;
+    }
+
+    *numBytesConsumed = cursor - buffer;
+    return 0;
+}
+
+}  // close unnamed namespace
+
                         // ----------------------
                         // struct MarshallingUtil
                         // ----------------------
@@ -501,6 +776,195 @@ void MarshallingUtil::getArrayFloat32(float      *variables,
     }
 }
 
+
+                        // *** get variable-length integral values ***
+
+int MarshallingUtil::getVarInt64(bsls::Types::Int64 *variable,
+                                 const char         *buffer,
+                                 bsl::size_t         length)
+{
+    BSLS_ASSERT(variable);
+    BSLS_ASSERT(buffer || 0 == length);
+
+    return VarInt64Imp::decode(variable, buffer, length);
+}
+
+int MarshallingUtil::getVarUint64(bsls::Types::Uint64 *variable,
+                                  const char          *buffer,
+                                  bsl::size_t          length)
+{
+    BSLS_ASSERT(variable);
+    BSLS_ASSERT(buffer || 0 == length);
+
+    return VarUint64Imp::decode(variable, buffer, length);
+}
+
+int MarshallingUtil::getVarInt32(int         *variable,
+                                 const char  *buffer,
+                                 bsl::size_t  length)
+{
+    BSLS_ASSERT(variable);
+    BSLS_ASSERT(buffer || 0 == length);
+
+    return VarInt32Imp::decode(variable, buffer, length);
+}
+
+int MarshallingUtil::getVarUint32(unsigned int *variable,
+                                  const char   *buffer,
+                                  bsl::size_t   length)
+{
+    BSLS_ASSERT(variable);
+    BSLS_ASSERT(buffer || 0 == length);
+
+    return VarUint32Imp::decode(variable, buffer, length);
+}
+
+                        // *** put arrays of variable-length integers ***
+
+bsl::size_t MarshallingUtil::putArrayVarInt64(
+                                           char                     *buffer,
+                                           const bsls::Types::Int64 *values,
+                                           int                       numValues)
+{
+    BSLS_ASSERT(buffer);
+    BSLS_ASSERT(values);
+    BSLS_ASSERT(0 <= numValues);
+
+    char                     *cursor = buffer;
+    const bsls::Types::Int64 *end    = values + numValues;
+    for (; values != end; ++values) {
+        cursor += putVarInt64(cursor, *values);
+    }
+
+    return cursor - buffer;
+}
+
+bsl::size_t MarshallingUtil::putArrayVarUint64(
+                                          char                      *buffer,
+                                          const bsls::Types::Uint64 *values,
+                                          int                        numValues)
+{
+    BSLS_ASSERT(buffer);
+    BSLS_ASSERT(values);
+    BSLS_ASSERT(0 <= numValues);
+
+    char                      *cursor = buffer;
+    const bsls::Types::Uint64 *end    = values + numValues;
+    for (; values != end; ++values) {
+        cursor += putVarUint64(cursor, *values);
+    }
+
+    return cursor - buffer;
+}
+
+bsl::size_t MarshallingUtil::putArrayVarInt32(char      *buffer,
+                                              const int *values,
+                                              int        numValues)
+{
+    BSLS_ASSERT(buffer);
+    BSLS_ASSERT(values);
+    BSLS_ASSERT(0 <= numValues);
+
+    char      *cursor = buffer;
+    const int *end    = values + numValues;
+    for (; values != end; ++values) {
+        cursor += putVarInt32(cursor, *values);
+    }
+
+    return cursor - buffer;
+}
+
+bsl::size_t MarshallingUtil::putArrayVarUint32(char               *buffer,
+                                               const unsigned int *values,
+                                               int                 numValues)
+{
+    BSLS_ASSERT(buffer);
+    BSLS_ASSERT(values);
+    BSLS_ASSERT(0 <= numValues);
+
+    char               *cursor = buffer;
+    const unsigned int *end    = values + numValues;
+    for (; values != end; ++values) {
+        cursor += putVarUint32(cursor, *values);
+    }
+
+    return cursor - buffer;
+}
+
+                        // *** get arrays of variable-length integers ***
+
+int MarshallingUtil::getArrayVarInt64(bsls::Types::Int64 *variables,
+                                      bsl::size_t        *numBytesConsumed,
+                                      const char         *buffer,
+                                      bsl::size_t         length,
+                                      int                 numVariables)
+{
+    BSLS_ASSERT(variables);
+    BSLS_ASSERT(numBytesConsumed);
+    BSLS_ASSERT(buffer || 0 == length);
+    BSLS_ASSERT(0 <= numVariables);
+
+    return getArrayVarImp<VarInt64Imp>(variables,
+                                    numBytesConsumed,
+                                    buffer,
+                                    length,
+                                    numVariables);
+}
+
+int MarshallingUtil::getArrayVarUint64(bsls::Types::Uint64 *variables,
+                                       bsl::size_t         *numBytesConsumed,
+                                       const char          *buffer,
+                                       bsl::size_t          length,
+                                       int                  numVariables)
+{
+    BSLS_ASSERT(variables);
+    BSLS_ASSERT(numBytesConsumed);
+    BSLS_ASSERT(buffer || 0 == length);
+    BSLS_ASSERT(0 <= numVariables);
+
+    return getArrayVarImp<VarUint64Imp>(variables,
+                                    numBytesConsumed,
+                                    buffer,
+                                    length,
+                                    numVariables);
+}
+
+int MarshallingUtil::getArrayVarInt32(int         *variables,
+                                      bsl::size_t *numBytesConsumed,
+                                      const char  *buffer,
+                                      bsl::size_t  length,
+                                      int          numVariables)
+{
+    BSLS_ASSERT(variables);
+    BSLS_ASSERT(numBytesConsumed);
+    BSLS_ASSERT(buffer || 0 == length);
+    BSLS_ASSERT(0 <= numVariables);
+
+    return getArrayVarImp<VarInt32Imp>(variables,
+                                    numBytesConsumed,
+                                    buffer,
+                                    length,
+                                    numVariables);
+}
+
+int MarshallingUtil::getArrayVarUint32(unsigned int *variables,
+                                       bsl::size_t  *numBytesConsumed,
+                                       const char   *buffer,
+                                       bsl::size_t   length,
+                                       int           numVariables)
+{
+    BSLS_ASSERT(variables);
+    BSLS_ASSERT(numBytesConsumed);
+    BSLS_ASSERT(buffer || 0 == length);
+    BSLS_ASSERT(0 <= numVariables);
+
+    return getArrayVarImp<VarUint32Imp>(variables,
+                                    numBytesConsumed,
+                                    buffer,
+                                    length,
+                                    numVariables);
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
@@ -40,7 +40,10 @@ BSLS_IDENT("$Id: $")
 // streamed as 40-, 48-, 56-, or 64-bit values, and 32-bit values can be
 // streamed as 24- or 32-bit values.  Marshalled integers are written and
 // assumed to be in two's complement, big-endian format (i.e., network byte
-// order).  Floating-point formats are described below.
+// order).  Floating-point formats are described below.  Finally, 64- and
+// 32-bit integers can be marshalled in a variable-length format that uses
+// fewer bytes for values of small magnitude (see {Variable-Length Integer
+// Format}).
 //
 ///Note on Function Naming and Interface
 ///-------------------------------------
@@ -123,6 +126,33 @@ BSLS_IDENT("$Id: $")
 //                   values,        const float *                NN=32
 //                   numValues)
 //..
+// The variable-length functions report the number of bytes they write or
+// consume, since that number depends on the values marshalled.  The 'get...'
+// functions take the 'length' of the 'buffer' and fail, rather than read past
+// it, if the input is truncated or malformed:
+//..
+//   Name                           Type of 'variable'/'value'   Return
+//   ----                           --------------------------   ------
+//   putVarIntNN(buffer, value)     bsls::Types::Int64     NN=64 bytes written
+//   putVarUintNN(buffer, value)    bsls::Types::Uint64    NN=64
+//                                  int                    NN=32
+//                                  unsigned int           NN=32
+//
+//   getVarIntNN(variable,          bsls::Types::Int64 *   NN=64 bytes consumed
+//               buffer,            bsls::Types::Uint64 *  NN=64 (0 on error)
+//               length)            int *                  NN=32
+//   getVarUintNN(...)              unsigned int *         NN=32
+//
+//   putArrayVarIntNN(buffer,       (as for 'putVar...')         bytes written
+//                    values,
+//                    numValues)
+//
+//   getArrayVarIntNN(variables,    (as for 'getVar...')         0 on success
+//                    numBytesConsumed,
+//                    buffer,
+//                    length,
+//                    numVariables)
+//..
 ///IEEE 754 Double-Precision Format
 ///--------------------------------
 // A 'double' is assumed to be *at* *least* 64 bits in size.  The externalized
@@ -156,6 +186,48 @@ BSLS_IDENT("$Id: $")
 //    LSB                              MSB
 //..
 //
+///Variable-Length Integer Format
+///------------------------------
+// The variable-length format (often called "varint") stores an unsigned
+// integer seven bits at a time, least-significant group first.  Each byte
+// holds one group in its low seven bits; its high (continuation) bit is set
+// in every byte except the last.  Values less than 128 therefore occupy one
+// byte, values less than 16384 two bytes, and so on, up to 5 bytes
+// ('k_MAX_SIZEOF_VARINT32') for a 32-bit and 10 bytes
+// ('k_MAX_SIZEOF_VARINT64') for a 64-bit value:
+//..
+//  value 300 (binary 100101100)
+//
+//  +--------+--------+
+//  |10101100|00000010|
+//  +--------+--------+
+//   ^ 0101100 ^ 0000010
+//   |         |
+//   more      last
+//..
+// Signed integers are first mapped onto unsigned integers by the "zigzag"
+// transformation -- 0, -1, 1, -2, 2, ... map to 0, 1, 2, 3, 4, ... -- so that
+// values of small magnitude have short encodings regardless of sign.
+//
+// Decoding rejects (by returning an error status) encodings that are
+// truncated, that are longer than the maximum size, or whose value does not
+// fit in the requested type.  Overlong encodings of small values (e.g.,
+// '0x80 0x00' for 0) are accepted.
+//
+// The decoders examine eight input bytes at a time where the input allows:
+// the end of an encoding is located, and its payload bits are gathered, with
+// a few word-wide bitwise operations rather than a per-byte loop, and a run of
+// eight single-byte encodings (the common case for small values) is decoded
+// in one step by the array functions.  No processor-specific instructions are
+// used, so the encoding and its performance are the same on every platform.
+//
+// The variable-length format is a *different* externalized representation
+// from the fixed-width format.  A type that adopts it for its integer fields
+// must do so in a new BDEX version of its externalization, selected (as
+// usual) through the 'versionSelector' supplied to
+// 'maxSupportedBdexVersion', so that data streamed out for older readers
+// retains the fixed-width format (see {'bslx_byteinstream'|Example 2}).
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -194,6 +266,62 @@ BSLS_IDENT("$Id: $")
 //  assert(newValues[1] == values[1]);
 //  assert(newValues[2] == values[2]);
 //..
+//
+///Example 2: Variable-Length Marshalling
+///- - - - - - - - - - - - - - - - - - -
+// Integers that are usually small, such as counts, identifiers, or
+// differences between successive timestamps, can be marshalled more compactly
+// in the variable-length format.  In this example, we marshal a signed
+// 64-bit value and an array of 'unsigned int' values in that format and
+// observe the space saved.  First, declare the buffer and the data to be
+// marshalled:
+//..
+//  char                buffer2[64];
+//  bsls::Types::Int64  delta = -3;
+//  unsigned int        counts[] = { 1, 200, 3, 70000 };
+//..
+// Then, marshal the data into 'buffer2', keeping track of the number of bytes
+// written:
+//..
+//  bsl::size_t numBytes = bslx::MarshallingUtil::putVarInt64(buffer2, delta);
+//  numBytes += bslx::MarshallingUtil::putArrayVarUint32(buffer2 + numBytes,
+//                                                       counts,
+//                                                       4);
+//..
+// Notice that the eight bytes written -- 1 for 'delta' and 1, 2, 1, and 3 for
+// the elements of 'counts' -- compare with the 24 bytes that 'putInt64' and
+// 'putArrayInt32' would use:
+//..
+//  assert(8 == numBytes);
+//..
+// Finally, marshal the data back from 'buffer2', supplying the number of
+// bytes available so that malformed or truncated data is detected rather
+// than read past:
+//..
+//  bsls::Types::Int64 newDelta = 0;
+//  unsigned int       newCounts[4];
+//  bsl::size_t        numArrayBytes;
+//
+//  int n = bslx::MarshallingUtil::getVarInt64(&newDelta, buffer2, numBytes);
+//  assert(1  == n);
+//  assert(-3 == newDelta);
+//
+//  int rc = bslx::MarshallingUtil::getArrayVarUint32(newCounts,
+//                                                    &numArrayBytes,
+//                                                    buffer2 + n,
+//                                                    numBytes - n,
+//                                                    4);
+//  assert(0     == rc);
+//  assert(7     == numArrayBytes);
+//  assert(70000 == newCounts[3]);
+//
+//  rc = bslx::MarshallingUtil::getArrayVarUint32(newCounts,
+//                                                &numArrayBytes,
+//                                                buffer2 + n,
+//                                                numBytes - n - 1,
+//                                                4);
+//  assert(0 != rc);
+//..
 
 #ifndef INCLUDED_BSLSCM_VERSION
 #include <bslscm_version.h>
@@ -247,6 +375,15 @@ struct MarshallingUtil {
         k_SIZEOF_FLOAT32 = 4
     };
 
+    enum {
+        // Enumerate the maximum sizes (in bytes) of the variable-length
+        // encodings of 64-bit and 32-bit integral values (see
+        // {Variable-Length Integer Format}).
+
+        k_MAX_SIZEOF_VARINT64 = 10,
+        k_MAX_SIZEOF_VARINT32 = 5
+    };
+
     // CLASS METHODS
 
                         // *** put scalar integral values ***
@@ -786,6 +923,191 @@ struct MarshallingUtil {
         // behavior is undefined unless 'variables' has sufficient capacity,
         // 'buffer' has sufficient contents, and '0 <= numVariables'.
 
+                        // *** put variable-length integral values ***
+
+    static int putVarInt64(char *buffer, bsls::Types::Int64 value);
+        // Load into the specified 'buffer' the variable-length encoding of the
+        // zigzag transformation of the specified 'value' (see {Variable-Length
+        // Integer Format}), and return the number of bytes written.  The
+        // behavior is undefined unless 'buffer' has a capacity of at least
+        // 'k_MAX_SIZEOF_VARINT64' bytes.  Note that values of small magnitude,
+        // whether positive or negative, have short encodings.
+
+    static int putVarUint64(char *buffer, bsls::Types::Uint64 value);
+        // Load into the specified 'buffer' the variable-length encoding of the
+        // specified 'value' (see {Variable-Length Integer Format}), and return
+        // the number of bytes written.  The behavior is undefined unless
+        // 'buffer' has a capacity of at least 'k_MAX_SIZEOF_VARINT64' bytes.
+
+    static int putVarInt32(char *buffer, int value);
+        // Load into the specified 'buffer' the variable-length encoding of the
+        // zigzag transformation of the specified 'value' (see {Variable-Length
+        // Integer Format}), and return the number of bytes written.  The
+        // behavior is undefined unless 'buffer' has a capacity of at least
+        // 'k_MAX_SIZEOF_VARINT32' bytes.
+
+    static int putVarUint32(char *buffer, unsigned int value);
+        // Load into the specified 'buffer' the variable-length encoding of the
+        // specified 'value' (see {Variable-Length Integer Format}), and return
+        // the number of bytes written.  The behavior is undefined unless
+        // 'buffer' has a capacity of at least 'k_MAX_SIZEOF_VARINT32' bytes.
+
+                        // *** get variable-length integral values ***
+
+    static int getVarInt64(bsls::Types::Int64 *variable,
+                           const char         *buffer,
+                           bsl::size_t         length);
+        // Load into the specified 'variable' the value whose zigzag
+        // transformation is variable-length encoded at the start of the
+        // specified 'buffer' having the specified 'length' (in bytes), and
+        // return the number of bytes consumed.  Return 0, with no effect on
+        // 'variable', if 'buffer' does not begin with a complete and valid
+        // encoding of a 64-bit value.  The behavior is undefined unless
+        // 'buffer' has at least 'length' bytes of contents.
+
+    static int getVarUint64(bsls::Types::Uint64 *variable,
+                            const char          *buffer,
+                            bsl::size_t          length);
+        // Load into the specified 'variable' the value variable-length encoded
+        // at the start of the specified 'buffer' having the specified 'length'
+        // (in bytes), and return the number of bytes consumed.  Return 0, with
+        // no effect on 'variable', if 'buffer' does not begin with a complete
+        // and valid encoding of a 64-bit value.  The behavior is undefined
+        // unless 'buffer' has at least 'length' bytes of contents.
+
+    static int getVarInt32(int         *variable,
+                           const char  *buffer,
+                           bsl::size_t  length);
+        // Load into the specified 'variable' the value whose zigzag
+        // transformation is variable-length encoded at the start of the
+        // specified 'buffer' having the specified 'length' (in bytes), and
+        // return the number of bytes consumed.  Return 0, with no effect on
+        // 'variable', if 'buffer' does not begin with a complete and valid
+        // encoding of a 32-bit value.  The behavior is undefined unless
+        // 'buffer' has at least 'length' bytes of contents.
+
+    static int getVarUint32(unsigned int *variable,
+                            const char   *buffer,
+                            bsl::size_t   length);
+        // Load into the specified 'variable' the value variable-length encoded
+        // at the start of the specified 'buffer' having the specified 'length'
+        // (in bytes), and return the number of bytes consumed.  Return 0, with
+        // no effect on 'variable', if 'buffer' does not begin with a complete
+        // and valid encoding of a 32-bit value.  The behavior is undefined
+        // unless 'buffer' has at least 'length' bytes of contents.
+
+                        // *** put arrays of variable-length integers ***
+
+    static bsl::size_t putArrayVarInt64(char                     *buffer,
+                                        const bsls::Types::Int64 *values,
+                                        int                       numValues);
+        // Load into the specified 'buffer' the consecutive variable-length
+        // encodings of the zigzag transformations of each of the specified
+        // 'numValues' leading entries in the specified 'values', and return
+        // the number of bytes written.  The behavior is undefined unless
+        // 'buffer' has a capacity of at least
+        // 'numValues * k_MAX_SIZEOF_VARINT64' bytes, 'values' has sufficient
+        // contents, and '0 <= numValues'.
+
+    static bsl::size_t putArrayVarUint64(char                      *buffer,
+                                         const bsls::Types::Uint64 *values,
+                                         int                        numValues);
+        // Load into the specified 'buffer' the consecutive variable-length
+        // encodings of each of the specified 'numValues' leading entries in
+        // the specified 'values', and return the number of bytes written.  The
+        // behavior is undefined unless 'buffer' has a capacity of at least
+        // 'numValues * k_MAX_SIZEOF_VARINT64' bytes, 'values' has sufficient
+        // contents, and '0 <= numValues'.
+
+    static bsl::size_t putArrayVarInt32(char      *buffer,
+                                        const int *values,
+                                        int        numValues);
+        // Load into the specified 'buffer' the consecutive variable-length
+        // encodings of the zigzag transformations of each of the specified
+        // 'numValues' leading entries in the specified 'values', and return
+        // the number of bytes written.  The behavior is undefined unless
+        // 'buffer' has a capacity of at least
+        // 'numValues * k_MAX_SIZEOF_VARINT32' bytes, 'values' has sufficient
+        // contents, and '0 <= numValues'.
+
+    static bsl::size_t putArrayVarUint32(char               *buffer,
+                                         const unsigned int *values,
+                                         int                 numValues);
+        // Load into the specified 'buffer' the consecutive variable-length
+        // encodings of each of the specified 'numValues' leading entries in
+        // the specified 'values', and return the number of bytes written.  The
+        // behavior is undefined unless 'buffer' has a capacity of at least
+        // 'numValues * k_MAX_SIZEOF_VARINT32' bytes, 'values' has sufficient
+        // contents, and '0 <= numValues'.
+
+                        // *** get arrays of variable-length integers ***
+
+    static int getArrayVarInt64(bsls::Types::Int64 *variables,
+                                bsl::size_t        *numBytesConsumed,
+                                const char         *buffer,
+                                bsl::size_t         length,
+                                int                 numVariables);
+        // Load into the specified 'variables' the values whose zigzag
+        // transformations are the specified 'numVariables' consecutive
+        // variable-length encodings at the start of the specified 'buffer'
+        // having the specified 'length' (in bytes), and load into the
+        // specified 'numBytesConsumed' the number of bytes consumed.  Return 0
+        // on success, and a non-zero value (with the values of 'variables' and
+        // 'numBytesConsumed' unspecified) if 'buffer' does not begin with
+        // 'numVariables' complete and valid encodings of 64-bit values.  The
+        // behavior is undefined unless 'variables' has sufficient capacity,
+        // 'buffer' has at least 'length' bytes of contents, and
+        // '0 <= numVariables'.
+
+    static int getArrayVarUint64(bsls::Types::Uint64 *variables,
+                                 bsl::size_t         *numBytesConsumed,
+                                 const char          *buffer,
+                                 bsl::size_t          length,
+                                 int                  numVariables);
+        // Load into the specified 'variables' the values of the specified
+        // 'numVariables' consecutive variable-length encodings at the start of
+        // the specified 'buffer' having the specified 'length' (in bytes),
+        // and load into the specified 'numBytesConsumed' the number of bytes
+        // consumed.  Return 0 on success, and a non-zero value (with the
+        // values of 'variables' and 'numBytesConsumed' unspecified) if
+        // 'buffer' does not begin with 'numVariables' complete and valid
+        // encodings of 64-bit values.  The behavior is undefined unless
+        // 'variables' has sufficient capacity, 'buffer' has at least 'length'
+        // bytes of contents, and '0 <= numVariables'.
+
+    static int getArrayVarInt32(int         *variables,
+                                bsl::size_t *numBytesConsumed,
+                                const char  *buffer,
+                                bsl::size_t  length,
+                                int          numVariables);
+        // Load into the specified 'variables' the values whose zigzag
+        // transformations are the specified 'numVariables' consecutive
+        // variable-length encodings at the start of the specified 'buffer'
+        // having the specified 'length' (in bytes), and load into the
+        // specified 'numBytesConsumed' the number of bytes consumed.  Return 0
+        // on success, and a non-zero value (with the values of 'variables' and
+        // 'numBytesConsumed' unspecified) if 'buffer' does not begin with
+        // 'numVariables' complete and valid encodings of 32-bit values.  The
+        // behavior is undefined unless 'variables' has sufficient capacity,
+        // 'buffer' has at least 'length' bytes of contents, and
+        // '0 <= numVariables'.
+
+    static int getArrayVarUint32(unsigned int *variables,
+                                 bsl::size_t  *numBytesConsumed,
+                                 const char   *buffer,
+                                 bsl::size_t   length,
+                                 int           numVariables);
+        // Load into the specified 'variables' the values of the specified
+        // 'numVariables' consecutive variable-length encodings at the start of
+        // the specified 'buffer' having the specified 'length' (in bytes),
+        // and load into the specified 'numBytesConsumed' the number of bytes
+        // consumed.  Return 0 on success, and a non-zero value (with the
+        // values of 'variables' and 'numBytesConsumed' unspecified) if
+        // 'buffer' does not begin with 'numVariables' complete and valid
+        // encodings of 32-bit values.  The behavior is undefined unless
+        // 'variables' has sufficient capacity, 'buffer' has at least 'length'
+        // bytes of contents, and '0 <= numVariables'.
+
 };
 
 // ============================================================================
@@ -1472,6 +1794,59 @@ void MarshallingUtil::getArrayInt8(unsigned char *variables,
     getArrayInt8(reinterpret_cast<char *>(variables), buffer, numVariables);
 }
 
+
+                        // *** put variable-length integral values ***
+
+inline
+int MarshallingUtil::putVarInt64(char *buffer, bsls::Types::Int64 value)
+{
+    BSLS_ASSERT_SAFE(buffer);
+
+    const bsls::Types::Uint64 bits = static_cast<bsls::Types::Uint64>(value);
+
+    return putVarUint64(buffer, (bits << 1) ^ (0 - (bits >> 63)));
+}
+
+inline
+int MarshallingUtil::putVarUint64(char *buffer, bsls::Types::Uint64 value)
+{
+    BSLS_ASSERT_SAFE(buffer);
+
+    char *cursor = buffer;
+    while (0x80 <= value) {
+        *cursor++ = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    *cursor++ = static_cast<char>(value);
+
+    return static_cast<int>(cursor - buffer);
+}
+
+inline
+int MarshallingUtil::putVarInt32(char *buffer, int value)
+{
+    BSLS_ASSERT_SAFE(buffer);
+
+    const unsigned int bits = static_cast<unsigned int>(value);
+
+    return putVarUint32(buffer, (bits << 1) ^ (0 - (bits >> 31)));
+}
+
+inline
+int MarshallingUtil::putVarUint32(char *buffer, unsigned int value)
+{
+    BSLS_ASSERT_SAFE(buffer);
+
+    char *cursor = buffer;
+    while (0x80 <= value) {
+        *cursor++ = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    *cursor++ = static_cast<char>(value);
+
+    return static_cast<int>(cursor - buffer);
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
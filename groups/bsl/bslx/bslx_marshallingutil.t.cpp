@@ -12,6 +12,7 @@
 #include <bsl_iomanip.h>
 #include <bsl_ios.h>
 #include <bsl_iostream.h>
+#include <bsl_limits.h>
 
 using namespace BloombergLP;
 using namespace bsl;
@@ -109,13 +110,30 @@ using namespace bslx;
 // [21] getArrayInt8(unsigned char *var, const char *buf, int count);
 // [22] getArrayFloat64(double *var, const char *buf, int count);
 // [23] getArrayFloat32(float *var, const char *buf, int count);
+//
+// [25] int putVarInt64(char *buf, Int64 val);
+// [25] int putVarUint64(char *buf, Uint64 val);
+// [25] int putVarInt32(char *buf, int val);
+// [25] int putVarUint32(char *buf, unsigned int val);
+// [25] int getVarInt64(Int64 *var, const char *buf, size_t length);
+// [25] int getVarUint64(Uint64 *var, const char *buf, size_t length);
+// [25] int getVarInt32(int *var, const char *buf, size_t length);
+// [25] int getVarUint32(unsigned int *var, const char *buf, size_t len);
+// [26] putArrayVarInt64(char *buf, const Int64 *ary, int count);
+// [26] putArrayVarUint64(char *buf, const Uint64 *ary, int count);
+// [26] putArrayVarInt32(char *buf, const int *ary, int count);
+// [26] putArrayVarUint32(char *buf, const unsigned int *ary, int count);
+// [26] getArrayVarInt64(Int64 *var, size_t *n, const char *, size_t, int)
+// [26] getArrayVarUint64(Uint64 *, size_t *n, const char *, size_t, int)
+// [26] getArrayVarInt32(int *var, size_t *n, const char *, size_t, int)
+// [26] getArrayVarUint32(unsigned *, size_t *, const char *, size_t, int)
 // ----------------------------------------------------------------------------
 // [ 1] SWAP FUNCTION: static inline void swap(T *x, T *y)
 // [ 1] REVERSE FUNCTION: void reverse(T *array, int numElements)
 // [ 2] EXPLORE DOUBLE FORMAT -- make sure format is IEEE-COMPLIANT
 // [ 3] EXPLORE FLOAT FORMAT -- make sure format is IEEE-COMPLIANT
 // [24] STRESS TEST - Used to determine performance characteristics.
-// [25] USAGE EXAMPLE
+// [27] USAGE EXAMPLE
 // ----------------------------------------------------------------------------
 
 // ============================================================================
@@ -210,6 +228,383 @@ void reverse(TYPE *array, int numElements)
     }
 }
 
+// ============================================================================
+//                  VARIABLE-LENGTH INTEGER TEST APPARATUS
+// ----------------------------------------------------------------------------
+
+typedef bsls::Types::Int64  Int64;
+typedef bsls::Types::Uint64 Uint64;
+
+template <class TYPE>
+struct VarTraits;
+    // This 'struct' template provides, for each integral 'TYPE' having a
+    // variable-length encoding, uniform names for the corresponding
+    // 'MarshallingUtil' functions, the maximum size of an encoding, and a
+    // reference implementation of the (zigzag) mapping of 'TYPE' onto the
+    // unsigned value that is encoded.
+
+template <>
+struct VarTraits<Int64> {
+    enum { k_MAX_SIZE = MarshallingUtil::k_MAX_SIZEOF_VARINT64 };
+
+    static Uint64 encoded(Int64 value)
+    {
+        return value >= 0
+               ? 2 * static_cast<Uint64>(value)
+               : 2 * static_cast<Uint64>(-(value + 1)) + 1;
+    }
+
+    static int put(char *buffer, Int64 value)
+    {
+        return MarshallingUtil::putVarInt64(buffer, value);
+    }
+
+    static int get(Int64 *variable, const char *buffer, bsl::size_t length)
+    {
+        return MarshallingUtil::getVarInt64(variable, buffer, length);
+    }
+
+    static bsl::size_t putArray(char *buffer, const Int64 *values, int num)
+    {
+        return MarshallingUtil::putArrayVarInt64(buffer, values, num);
+    }
+
+    static int getArray(Int64       *variables,
+                        bsl::size_t *numBytes,
+                        const char  *buffer,
+                        bsl::size_t  length,
+                        int          num)
+    {
+        return MarshallingUtil::getArrayVarInt64(variables,
+                                                 numBytes,
+                                                 buffer,
+                                                 length,
+                                                 num);
+    }
+};
+
+template <>
+struct VarTraits<Uint64> {
+    enum { k_MAX_SIZE = MarshallingUtil::k_MAX_SIZEOF_VARINT64 };
+
+    static Uint64 encoded(Uint64 value)
+    {
+        return value;
+    }
+
+    static int put(char *buffer, Uint64 value)
+    {
+        return MarshallingUtil::putVarUint64(buffer, value);
+    }
+
+    static int get(Uint64 *variable, const char *buffer, bsl::size_t length)
+    {
+        return MarshallingUtil::getVarUint64(variable, buffer, length);
+    }
+
+    static bsl::size_t putArray(char *buffer, const Uint64 *values, int num)
+    {
+        return MarshallingUtil::putArrayVarUint64(buffer, values, num);
+    }
+
+    static int getArray(Uint64      *variables,
+                        bsl::size_t *numBytes,
+                        const char  *buffer,
+                        bsl::size_t  length,
+                        int          num)
+    {
+        return MarshallingUtil::getArrayVarUint64(variables,
+                                                  numBytes,
+                                                  buffer,
+                                                  length,
+                                                  num);
+    }
+};
+
+template <>
+struct VarTraits<int> {
+    enum { k_MAX_SIZE = MarshallingUtil::k_MAX_SIZEOF_VARINT32 };
+
+    static Uint64 encoded(int value)
+    {
+        return VarTraits<Int64>::encoded(value);
+    }
+
+    static int put(char *buffer, int value)
+    {
+        return MarshallingUtil::putVarInt32(buffer, value);
+    }
+
+    static int get(int *variable, const char *buffer, bsl::size_t length)
+    {
+        return MarshallingUtil::getVarInt32(variable, buffer, length);
+    }
+
+    static bsl::size_t putArray(char *buffer, const int *values, int num)
+    {
+        return MarshallingUtil::putArrayVarInt32(buffer, values, num);
+    }
+
+    static int getArray(int         *variables,
+                        bsl::size_t *numBytes,
+                        const char  *buffer,
+                        bsl::size_t  length,
+                        int          num)
+    {
+        return MarshallingUtil::getArrayVarInt32(variables,
+                                                 numBytes,
+                                                 buffer,
+                                                 length,
+                                                 num);
+    }
+};
+
+template <>
+struct VarTraits<unsigned int> {
+    enum { k_MAX_SIZE = MarshallingUtil::k_MAX_SIZEOF_VARINT32 };
+
+    static Uint64 encoded(unsigned int value)
+    {
+        return value;
+    }
+
+    static int put(char *buffer, unsigned int value)
+    {
+        return MarshallingUtil::putVarUint32(buffer, value);
+    }
+
+    static int get(unsigned int *variable,
+                   const char   *buffer,
+                   bsl::size_t   length)
+    {
+        return MarshallingUtil::getVarUint32(variable, buffer, length);
+    }
+
+    static bsl::size_t putArray(char               *buffer,
+                                const unsigned int *values,
+                                int                 num)
+    {
+        return MarshallingUtil::putArrayVarUint32(buffer, values, num);
+    }
+
+    static int getArray(unsigned int *variables,
+                        bsl::size_t  *numBytes,
+                        const char   *buffer,
+                        bsl::size_t   length,
+                        int           num)
+    {
+        return MarshallingUtil::getArrayVarUint32(variables,
+                                                  numBytes,
+                                                  buffer,
+                                                  length,
+                                                  num);
+    }
+};
+
+const char k_FILL = static_cast<char>(0xa5);
+    // Value used to fill buffers around encodings.  Note that its
+    // continuation bit is set, so a decoder reading past the end of an
+    // encoding would misinterpret it.
+
+template <class TYPE>
+void testVarRoundTrip(int line, TYPE value)
+    // Verify, reporting failures against the specified 'line', that the
+    // variable-length encoding of the specified 'value' has the expected
+    // length and payload, that it decodes to 'value' however much input
+    // follows it, and that every truncation of it is rejected.
+{
+    typedef VarTraits<TYPE> Traits;
+
+    enum { k_SIZE = 32 };
+
+    char buffer[k_SIZE];
+    bsl::memset(buffer, k_FILL, k_SIZE);
+
+    // Compute the expected length and check the payload of the encoding.
+
+    const Uint64 ENCODED = Traits::encoded(value);
+
+    int expectedLength = 1;
+    for (Uint64 v = ENCODED; 0x80 <= v; v >>= 7) {
+        ++expectedLength;
+    }
+
+    const int LEN = Traits::put(buffer, value);
+
+    ASSERTV(line, expectedLength, LEN, expectedLength == LEN);
+    ASSERTV(line, LEN, Traits::k_MAX_SIZE >= LEN);
+    ASSERTV(line, k_FILL == buffer[LEN]);
+
+    Uint64 payload = 0;
+    for (int i = 0; i < LEN; ++i) {
+        const unsigned char byte = static_cast<unsigned char>(buffer[i]);
+
+        ASSERTV(line, i, (i < LEN - 1) == !!(byte & 0x80));
+        payload |= static_cast<Uint64>(byte & 0x7f) << (7 * i);
+    }
+    ASSERTV(line, ENCODED == payload);
+
+    // Decode with every amount of input from the exact length up.
+
+    for (int length = LEN; length <= k_SIZE; ++length) {
+        TYPE variable = static_cast<TYPE>(~value);
+
+        const int numBytes = Traits::get(&variable, buffer, length);
+
+        ASSERTV(line, length, LEN == numBytes);
+        ASSERTV(line, length, value == variable);
+    }
+
+    // Decode every truncation.
+
+    for (int length = 0; length < LEN; ++length) {
+        const TYPE INITIAL  = static_cast<TYPE>(~value);
+        TYPE       variable = INITIAL;
+
+        ASSERTV(line, length, 0 == Traits::get(&variable, buffer, length));
+        ASSERTV(line, length, INITIAL == variable);
+    }
+}
+
+template <class TYPE>
+void testVarBoundaries()
+    // Call 'testVarRoundTrip' for the values of 'TYPE' on either side of
+    // every power of two and their negations, and the extreme values.
+{
+    const int NUM_BITS = static_cast<int>(sizeof(TYPE) * 8);
+
+    for (int bit = 0; bit < NUM_BITS; ++bit) {
+        const Uint64 POWER = static_cast<Uint64>(1) << bit;
+        const TYPE   VALUES[] = {
+            static_cast<TYPE>(POWER - 1),
+            static_cast<TYPE>(POWER),
+            static_cast<TYPE>(POWER + 1),
+            static_cast<TYPE>(0 - POWER + 1),
+            static_cast<TYPE>(0 - POWER),
+            static_cast<TYPE>(0 - POWER - 1)
+        };
+        const int NUM_VALUES = static_cast<int>(sizeof VALUES
+                                                / sizeof *VALUES);
+
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            testVarRoundTrip(bit * 100 + i, VALUES[i]);
+        }
+    }
+}
+
+template <class TYPE>
+void testVarArrays(bool verbose)
+    // Verify that the array functions for 'TYPE' match the corresponding
+    // scalar functions for pseudo-random arrays whose values have a mix of
+    // magnitudes (producing runs of single-byte encodings, among others), and
+    // that truncated and malformed input is rejected.  Optionally specify
+    // 'verbose' to report progress.
+{
+    typedef VarTraits<TYPE> Traits;
+
+    enum { k_MAX_NUM = 70 };
+
+    TYPE   values[k_MAX_NUM];
+    TYPE   results[k_MAX_NUM + 1];
+    char   expected[k_MAX_NUM * Traits::k_MAX_SIZE + 16];
+    char   buffer[k_MAX_NUM * Traits::k_MAX_SIZE + 16];
+    Uint64 state = 12345;
+
+    for (int num = 0; num <= k_MAX_NUM; ++num) {
+        for (int mix = 0; mix < 4; ++mix) {
+            // Generate values having at most 'MAX_BITS[mix]' significant
+            // bits, negating about half of them for signed 'TYPE'.
+
+            static const int MAX_BITS[] = { 6, 14, 40, 64 };
+
+            for (int i = 0; i < num; ++i) {
+                state = state * 6364136223846793005ULL
+                      + 1442695040888963407ULL;
+
+                const int bits = static_cast<int>((state >> 32)
+                                                  % (MAX_BITS[mix] + 1));
+
+                values[i] = static_cast<TYPE>(bits ? state >> (64 - bits)
+                                                   : 0);
+                if (bsl::numeric_limits<TYPE>::is_signed && (state & 1)) {
+                    values[i] = static_cast<TYPE>(~values[i]);
+                }
+            }
+
+            // Encode the array, and compare with the scalar encodings.
+
+            bsl::memset(buffer, k_FILL, sizeof buffer);
+
+            bsl::size_t expectedLength = 0;
+            for (int i = 0; i < num; ++i) {
+                expectedLength += Traits::put(expected + expectedLength,
+                                              values[i]);
+            }
+
+            const bsl::size_t LEN = Traits::putArray(buffer, values, num);
+
+            ASSERTV(num, mix, expectedLength == LEN);
+            ASSERTV(num, mix, 0 == bsl::memcmp(expected, buffer, LEN));
+            ASSERTV(num, mix, k_FILL == buffer[LEN]);
+
+            // Decode with exact and surplus input.
+
+            for (bsl::size_t length = LEN; length <= LEN + 9; ++length) {
+                bsl::size_t numBytes = 0;
+
+                results[num] = 0;
+                const int rc = Traits::getArray(results,
+                                                &numBytes,
+                                                buffer,
+                                                length,
+                                                num);
+                ASSERTV(num, mix, length, 0 == rc);
+                ASSERTV(num, mix, length, LEN == numBytes);
+                ASSERTV(num, mix, 0 == results[num]);  // not written past
+                for (int i = 0; i < num; ++i) {
+                    ASSERTV(num, mix, i, values[i] == results[i]);
+                }
+            }
+
+            // Decode truncated input.
+
+            for (bsl::size_t length = 0; length < LEN; ++length) {
+                bsl::size_t numBytes = 0;
+
+                ASSERTV(num, mix, length, 0 != Traits::getArray(results,
+                                                                &numBytes,
+                                                                buffer,
+                                                                length,
+                                                                num));
+            }
+
+            // Corrupt the last encoding so it is longer than the maximum.
+
+            if (num) {
+                const int lastLen = Traits::put(expected,
+                                                values[num - 1]);
+                char     *last    = buffer + LEN - lastLen;
+
+                bsl::memset(last, 0x80, Traits::k_MAX_SIZE);
+                last[Traits::k_MAX_SIZE] = 0;
+
+                bsl::size_t numBytes = 0;
+                ASSERTV(num, mix, 0 != Traits::getArray(results,
+                                                        &numBytes,
+                                                        buffer,
+                                                        sizeof buffer,
+                                                        num));
+            }
+        }
+        if (verbose && 0 == num % 10) {
+            cout << '.' << flush;
+        }
+    }
+    if (verbose) {
+        cout << endl;
+    }
+}
+
 // ============================================================================
 //                      FUNCTIONS TO MANIPULATE DOUBLES
 // ----------------------------------------------------------------------------
@@ -335,7 +730,7 @@ int main(int argc, char *argv[]) {
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
-      case 25: {
+      case 27: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -396,6 +791,450 @@ int main(int argc, char *argv[]) {
     ASSERT(newValues[2] == values[2]);
 //..
 
+//
+///Example 2: Variable-Length Marshalling
+///- - - - - - - - - - - - - - - - - - -
+// Integers that are usually small, such as counts, identifiers, or
+// differences between successive timestamps, can be marshalled more compactly
+// in the variable-length format.  In this example, we marshal a signed
+// 64-bit value and an array of 'unsigned int' values in that format and
+// observe the space saved.  First, declare the buffer and the data to be
+// marshalled:
+//..
+    char                buffer2[64];
+    bsls::Types::Int64  delta = -3;
+    unsigned int        counts[] = { 1, 200, 3, 70000 };
+//..
+// Then, marshal the data into 'buffer2', keeping track of the number of bytes
+// written:
+//..
+    bsl::size_t numBytes = bslx::MarshallingUtil::putVarInt64(buffer2, delta);
+    numBytes += bslx::MarshallingUtil::putArrayVarUint32(buffer2 + numBytes,
+                                                         counts,
+                                                         4);
+//..
+// Notice that the eight bytes written -- 1 for 'delta' and 1, 2, 1, and 3 for
+// the elements of 'counts' -- compare with the 24 bytes that 'putInt64' and
+// 'putArrayInt32' would use:
+//..
+    ASSERT(8 == numBytes);
+//..
+// Finally, marshal the data back from 'buffer2', supplying the number of
+// bytes available so that malformed or truncated data is detected rather
+// than read past:
+//..
+    bsls::Types::Int64 newDelta = 0;
+    unsigned int       newCounts[4];
+    bsl::size_t        numArrayBytes;
+
+    int n = bslx::MarshallingUtil::getVarInt64(&newDelta, buffer2, numBytes);
+    ASSERT(1  == n);
+    ASSERT(-3 == newDelta);
+
+    int rc = bslx::MarshallingUtil::getArrayVarUint32(newCounts,
+                                                      &numArrayBytes,
+                                                      buffer2 + n,
+                                                      numBytes - n,
+                                                      4);
+    ASSERT(0     == rc);
+    ASSERT(7     == numArrayBytes);
+    ASSERT(70000 == newCounts[3]);
+
+    rc = bslx::MarshallingUtil::getArrayVarUint32(newCounts,
+                                                  &numArrayBytes,
+                                                  buffer2 + n,
+                                                  numBytes - n - 1,
+                                                  4);
+    ASSERT(0 != rc);
+//..
+
+      } break;
+      case 26: {
+        // --------------------------------------------------------------------
+        // PUT/GET VARIABLE-LENGTH INTEGER ARRAYS
+        //   Verify put/get operations for arrays of variable-length integers.
+        //
+        // Concerns:
+        //: 1 'putArrayVar...' produces the concatenation of the encodings
+        //:   produced by the corresponding 'putVar...' function, and returns
+        //:   its length.
+        //:
+        //: 2 'getArrayVar...' inverts the 'put', reports the number of bytes
+        //:   consumed, and neither reads nor writes past the end of the
+        //:   requested values, including when runs of single-byte encodings
+        //:   are decoded together.
+        //:
+        //: 3 'getArrayVar...' fails for truncated and malformed input.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For arrays of every length up to 70, having values of four
+        //:   different magnitude mixes (from all single-byte to all
+        //:   multi-byte), compare the array encoding with the concatenated
+        //:   scalar encodings.  (C-1)
+        //:
+        //: 2 Decode each array with exactly enough input and with surplus
+        //:   input (filled with bytes having their continuation bit set), and
+        //:   verify the values, the number of bytes consumed, and that the
+        //:   element following the array is unmodified.  (C-2)
+        //:
+        //: 3 Decode each truncation of each array, and an array whose last
+        //:   encoding is made longer than the maximum, and verify failure.
+        //:   (C-3)
+        //:
+        //: 4 Verify defensive checks are triggered for invalid values.  (C-4)
+        //
+        // Testing:
+        //   putArrayVarInt64(char *buf, const Int64 *ary, int count);
+        //   putArrayVarUint64(char *buf, const Uint64 *ary, int count);
+        //   putArrayVarInt32(char *buf, const int *ary, int count);
+        //   putArrayVarUint32(char *buf, const unsigned int *ary, int count);
+        //   getArrayVarInt64(Int64 *var, size_t *n, const char *, size_t, int)
+        //   getArrayVarUint64(Uint64 *, size_t *n, const char *, size_t, int)
+        //   getArrayVarInt32(int *var, size_t *n, const char *, size_t, int)
+        //   getArrayVarUint32(unsigned *, size_t *, const char *, size_t, int)
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PUT/GET VARIABLE-LENGTH INTEGER ARRAYS" << endl
+                          << "======================================" << endl;
+
+        if (verbose) cout << "\nTesting 'Int64' arrays." << endl;
+        testVarArrays<Int64>(verbose);
+
+        if (verbose) cout << "\nTesting 'Uint64' arrays." << endl;
+        testVarArrays<Uint64>(verbose);
+
+        if (verbose) cout << "\nTesting 'int' arrays." << endl;
+        testVarArrays<int>(verbose);
+
+        if (verbose) cout << "\nTesting 'unsigned int' arrays." << endl;
+        testVarArrays<unsigned int>(verbose);
+
+        if (verbose) cout << "\nNegative testing." << endl;
+        {
+            char         BUFFER[64] = { 0 };
+            int          VALUES[3]  = { 0 };
+            char        *ZCHARPTR   = static_cast<char *>(0);
+            int         *ZTPTR      = static_cast<int *>(0);
+            bsl::size_t  numBytes;
+
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            // invalid 'buffer'
+            ASSERT_FAIL(MarshallingUtil::putArrayVarInt32(ZCHARPTR,
+                                                          VALUES,
+                                                          3));
+            ASSERT_FAIL(MarshallingUtil::getArrayVarInt32(VALUES,
+                                                          &numBytes,
+                                                          ZCHARPTR,
+                                                          3,
+                                                          3));
+            ASSERT_PASS(MarshallingUtil::getArrayVarInt32(VALUES,
+                                                          &numBytes,
+                                                          ZCHARPTR,
+                                                          0,
+                                                          0));
+
+            // invalid 'values' and 'numBytesConsumed'
+            ASSERT_FAIL(MarshallingUtil::putArrayVarInt32(BUFFER, ZTPTR, 3));
+            ASSERT_FAIL(MarshallingUtil::getArrayVarInt32(ZTPTR,
+                                                          &numBytes,
+                                                          BUFFER,
+                                                          3,
+                                                          3));
+            ASSERT_FAIL(MarshallingUtil::getArrayVarInt32(VALUES,
+                                                          0,
+                                                          BUFFER,
+                                                          3,
+                                                          3));
+
+            // valid and invalid 'numValues'
+            ASSERT_FAIL(MarshallingUtil::putArrayVarInt32(BUFFER, VALUES, -1));
+            ASSERT_PASS(MarshallingUtil::putArrayVarInt32(BUFFER, VALUES, 0));
+            ASSERT_FAIL(MarshallingUtil::getArrayVarInt32(VALUES,
+                                                          &numBytes,
+                                                          BUFFER,
+                                                          3,
+                                                          -1));
+            ASSERT_PASS(MarshallingUtil::getArrayVarInt32(VALUES,
+                                                          &numBytes,
+                                                          BUFFER,
+                                                          3,
+                                                          0));
+        }
+
+      } break;
+      case 25: {
+        // --------------------------------------------------------------------
+        // PUT/GET VARIABLE-LENGTH INTEGERS
+        //   Verify put/get operations for variable-length integers.
+        //
+        // Concerns:
+        //: 1 'put' produces the correct format: the minimal number of
+        //:   seven-bit groups, least-significant first, with the continuation
+        //:   bit set in all but the last byte, of the value (unsigned) or of
+        //:   its zigzag transformation (signed).
+        //:
+        //: 2 'put' returns the number of bytes written, and writes no more.
+        //:
+        //: 3 'get' inverts the 'put', returns the number of bytes consumed,
+        //:   and does not read past the end of the encoding, whether or not
+        //:   there are eight bytes of input available.
+        //:
+        //: 4 'get' returns 0, leaving the variable unmodified, for truncated
+        //:   input, for encodings longer than the maximum for the type, and
+        //:   for encodings whose value does not fit in the type.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, verify the encodings of a set
+        //:   of representative values.  (C-1)
+        //:
+        //: 2 For the values on either side of every power of two, their
+        //:   negations, and the extreme values of each type, compare the
+        //:   length and payload of the encoding with a reference computation,
+        //:   and decode with every amount of input from none to 32 bytes.
+        //:   (C-1..4)
+        //:
+        //: 3 Verify that a set of malformed encodings is rejected.  (C-4)
+        //:
+        //: 4 Verify defensive checks are triggered for invalid values.  (C-5)
+        //
+        // Testing:
+        //   int putVarInt64(char *buf, Int64 val);
+        //   int putVarUint64(char *buf, Uint64 val);
+        //   int putVarInt32(char *buf, int val);
+        //   int putVarUint32(char *buf, unsigned int val);
+        //   int getVarInt64(Int64 *var, const char *buf, size_t length);
+        //   int getVarUint64(Uint64 *var, const char *buf, size_t length);
+        //   int getVarInt32(int *var, const char *buf, size_t length);
+        //   int getVarUint32(unsigned int *var, const char *buf, size_t len);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PUT/GET VARIABLE-LENGTH INTEGERS" << endl
+                          << "================================" << endl;
+
+        if (verbose) cout << "\nTesting representative encodings." << endl;
+        {
+            const Int64 k_MAX_INT64 = bsl::numeric_limits<Int64>::max();
+            const Int64 k_MIN_INT64 = bsl::numeric_limits<Int64>::min();
+
+            static const struct {
+                int         d_line;       // source line number
+                Int64       d_value;      // value to encode
+                bool        d_isSigned;   // use zigzag transformation
+                int         d_len;        // length of encoding
+                const char *d_exp_p;      // expected encoding
+            } DATA[] = {
+                //LINE  VALUE           SIGNED  LEN  EXPECTED
+                //----  -----           ------  ---  --------
+                { L_,   0,              false,   1,  "\x00"                  },
+                { L_,   1,              false,   1,  "\x01"                  },
+                { L_,   127,            false,   1,  "\x7f"                  },
+                { L_,   128,            false,   2,  "\x80\x01"              },
+                { L_,   300,            false,   2,  "\xac\x02"              },
+                { L_,   16383,          false,   2,  "\xff\x7f"              },
+                { L_,   16384,          false,   3,  "\x80\x80\x01"          },
+                { L_,   0xffffffffLL,   false,   5,  "\xff\xff\xff\xff\x0f"  },
+                { L_,   -1,             false,  10,
+                                   "\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01"},
+
+                { L_,   0,              true,    1,  "\x00"                  },
+                { L_,   -1,             true,    1,  "\x01"                  },
+                { L_,   1,              true,    1,  "\x02"                  },
+                { L_,   -2,             true,    1,  "\x03"                  },
+                { L_,   63,             true,    1,  "\x7e"                  },
+                { L_,   -64,            true,    1,  "\x7f"                  },
+                { L_,   64,             true,    2,  "\x80\x01"              },
+                { L_,   -65,            true,    2,  "\x81\x01"              },
+                { L_,   k_MAX_INT64,    true,   10,
+                                   "\xfe\xff\xff\xff\xff\xff\xff\xff\xff\x01"},
+                { L_,   k_MIN_INT64,    true,   10,
+                                   "\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01"},
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int         LINE      = DATA[ti].d_line;
+                const Int64       VALUE     = DATA[ti].d_value;
+                const bool        IS_SIGNED = DATA[ti].d_isSigned;
+                const char *const EXP       = DATA[ti].d_exp_p;
+                const int         LEN       = DATA[ti].d_len;
+
+                char buffer[16];
+                int  len;
+
+                len = IS_SIGNED
+                      ? MarshallingUtil::putVarInt64(buffer, VALUE)
+                      : MarshallingUtil::putVarUint64(buffer,
+                                                  static_cast<Uint64>(VALUE));
+                if (veryVerbose) {
+                    P_(LINE) P_(VALUE) P(IS_SIGNED)
+                    pBytes(buffer, len) << endl;
+                }
+                LOOP_ASSERT(LINE, LEN == len);
+                LOOP_ASSERT(LINE, 0 == bsl::memcmp(EXP, buffer, LEN));
+
+                // The 32-bit functions must agree when the value fits.
+
+                if (IS_SIGNED && VALUE == static_cast<int>(VALUE)) {
+                    len = MarshallingUtil::putVarInt32(
+                                                    buffer,
+                                                    static_cast<int>(VALUE));
+                    LOOP_ASSERT(LINE, LEN == len);
+                    LOOP_ASSERT(LINE, 0 == bsl::memcmp(EXP, buffer, LEN));
+                }
+                if (!IS_SIGNED
+                 && static_cast<Uint64>(VALUE)
+                                      == static_cast<unsigned int>(VALUE)) {
+                    len = MarshallingUtil::putVarUint32(
+                                           buffer,
+                                           static_cast<unsigned int>(VALUE));
+                    LOOP_ASSERT(LINE, LEN == len);
+                    LOOP_ASSERT(LINE, 0 == bsl::memcmp(EXP, buffer, LEN));
+                }
+            }
+        }
+
+        if (verbose) cout << "\nTesting boundary values." << endl;
+        {
+            testVarBoundaries<Int64>();
+            testVarBoundaries<Uint64>();
+            testVarBoundaries<int>();
+            testVarBoundaries<unsigned int>();
+
+            testVarRoundTrip(L_, bsl::numeric_limits<Int64>::min());
+            testVarRoundTrip(L_, bsl::numeric_limits<Int64>::max());
+            testVarRoundTrip(L_, bsl::numeric_limits<Uint64>::max());
+            testVarRoundTrip(L_, bsl::numeric_limits<int>::min());
+            testVarRoundTrip(L_, bsl::numeric_limits<int>::max());
+            testVarRoundTrip(L_, bsl::numeric_limits<unsigned int>::max());
+        }
+
+        if (verbose) cout << "\nTesting malformed encodings." << endl;
+        {
+            static const struct {
+                int         d_line;       // source line number
+                int         d_len;        // number of input bytes
+                int         d_exp64;      // expected 64-bit result
+                int         d_exp32;      // expected 32-bit result
+                const char *d_input_p;    // input bytes
+            } DATA[] = {
+                //LINE  LEN  64  32  INPUT
+                //----  ---  --  --  -----
+
+                // overlong, but no longer than the maximum, is accepted
+                { L_,    2,   2,  2, "\x80\x00"                              },
+                { L_,    5,   5,  5, "\x80\x80\x80\x80\x00"                  },
+
+                // longer than the 32-bit maximum
+                { L_,    6,   6,  0, "\x80\x80\x80\x80\x80\x00"              },
+
+                // does not fit in 32 bits
+                { L_,    5,   5,  0, "\x80\x80\x80\x80\x10"                  },
+                { L_,    5,   5,  0, "\xff\xff\xff\xff\x1f"                  },
+
+                // longer than the 64-bit maximum
+                { L_,   11,   0,  0, "\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80"
+                                     "\x00"                                  },
+
+                // does not fit in 64 bits
+                { L_,   10,   0,  0, "\x80\x80\x80\x80\x80\x80\x80\x80\x80\x02"
+                                                                             },
+                { L_,   10,   0,  0, "\xff\xff\xff\xff\xff\xff\xff\xff\xff\x7f"
+                                                                             },
+
+                // no terminating byte
+                { L_,    8,   0,  0, "\xff\xff\xff\xff\xff\xff\xff\xff"      },
+                { L_,    1,   0,  0, "\x80"                                  },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int         LINE  = DATA[ti].d_line;
+                const char *const INPUT = DATA[ti].d_input_p;
+                const int         LEN   = DATA[ti].d_len;
+                const int         EXP64 = DATA[ti].d_exp64;
+                const int         EXP32 = DATA[ti].d_exp32;
+
+                if (veryVerbose) { P_(LINE) P_(EXP64) P(EXP32) }
+
+                // Decode with and without surplus input.
+
+                for (int extra = 0; extra <= 8; extra += 8) {
+                    char buffer[32];
+                    bsl::memset(buffer, k_FILL, sizeof buffer);
+                    bsl::memcpy(buffer, INPUT, LEN);
+
+                    const int LENGTH = LEN + extra;
+
+                    Int64        i64 = 99;
+                    Uint64       u64 = 99;
+                    int          i32 = 99;
+                    unsigned int u32 = 99;
+
+                    LOOP2_ASSERT(LINE, extra, EXP64 ==
+                              MarshallingUtil::getVarInt64(&i64,
+                                                           buffer,
+                                                           LENGTH));
+                    LOOP2_ASSERT(LINE, extra, EXP64 ==
+                              MarshallingUtil::getVarUint64(&u64,
+                                                            buffer,
+                                                            LENGTH));
+                    LOOP2_ASSERT(LINE, extra, EXP32 ==
+                              MarshallingUtil::getVarInt32(&i32,
+                                                           buffer,
+                                                           LENGTH));
+                    LOOP2_ASSERT(LINE, extra, EXP32 ==
+                              MarshallingUtil::getVarUint32(&u32,
+                                                            buffer,
+                                                            LENGTH));
+
+                    LOOP2_ASSERT(LINE, extra, !EXP64 == (99 == i64));
+                    LOOP2_ASSERT(LINE, extra, !EXP64 == (99 == u64));
+                    LOOP2_ASSERT(LINE, extra, !EXP32 == (99 == i32));
+                    LOOP2_ASSERT(LINE, extra, !EXP32 == (99 == u32));
+                }
+            }
+        }
+
+        if (verbose) cout << "\nNegative testing." << endl;
+        {
+            char         BUFFER[16] = { 0 };
+            char        *ZCHARPTR   = static_cast<char *>(0);
+            Int64        i64;
+            Uint64       u64;
+            int          i32;
+            unsigned int u32;
+
+            bsls::AssertFailureHandlerGuard
+                                          hG(bsls::AssertTest::failTestDriver);
+
+            // invalid 'buffer'
+            ASSERT_SAFE_FAIL(MarshallingUtil::putVarInt64(ZCHARPTR, 1));
+            ASSERT_SAFE_FAIL(MarshallingUtil::putVarUint64(ZCHARPTR, 1));
+            ASSERT_SAFE_FAIL(MarshallingUtil::putVarInt32(ZCHARPTR, 1));
+            ASSERT_SAFE_FAIL(MarshallingUtil::putVarUint32(ZCHARPTR, 1));
+
+            ASSERT_FAIL(MarshallingUtil::getVarInt64(&i64, ZCHARPTR, 1));
+            ASSERT_FAIL(MarshallingUtil::getVarUint64(&u64, ZCHARPTR, 1));
+            ASSERT_FAIL(MarshallingUtil::getVarInt32(&i32, ZCHARPTR, 1));
+            ASSERT_FAIL(MarshallingUtil::getVarUint32(&u32, ZCHARPTR, 1));
+            ASSERT_PASS(MarshallingUtil::getVarInt64(&i64, ZCHARPTR, 0));
+
+            // invalid 'variable'
+            ASSERT_FAIL(MarshallingUtil::getVarInt64(0, BUFFER, 1));
+            ASSERT_FAIL(MarshallingUtil::getVarUint64(0, BUFFER, 1));
+            ASSERT_FAIL(MarshallingUtil::getVarInt32(0, BUFFER, 1));
+            ASSERT_FAIL(MarshallingUtil::getVarUint32(0, BUFFER, 1));
+            ASSERT_PASS(MarshallingUtil::getVarUint32(&u32, BUFFER, 1));
+        }
+
       } break;
       case 24: {
         // --------------------------------------------------------------------
@@ -0,0 +1,218 @@
+// bslx_segmentedoutstream.cpp                                        -*-C++-*-
+#include <bslx_segmentedoutstream.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bslx_segmentedoutstream_cpp,"$Id$ $CSID$")
+
+#include <bslma_deallocatorproctor.h>
+
+#include <bsl_cstring.h>
+
+namespace BloombergLP {
+namespace bslx {
+
+                        // ------------------------
+                        // class SegmentedOutStream
+                        // ------------------------
+
+// PRIVATE MANIPULATORS
+char *SegmentedOutStream::allocateBlock()
+{
+    char *block = static_cast<char *>(d_allocator_p->allocate(d_blockSize));
+
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(block, d_allocator_p);
+    d_blocks.push_back(block);
+    proctor.release();
+
+    return block;
+}
+
+void SegmentedOutStream::appendSlow(const char *bytes, int numBytes)
+{
+    BSLS_ASSERT(bytes || 0 == numBytes);
+    BSLS_ASSERT(0 <= numBytes);
+
+    // Invalidate this stream while obtaining blocks, in case an exception is
+    // thrown.
+
+    invalidate();
+
+    while (0 < numBytes) {
+        if (d_cursor_p == d_end_p) {
+            // Complete the current segment before moving to the next block,
+            // so that this stream remains consistent if obtaining the block
+            // throws.
+
+            closeSegment();
+
+            char *block = d_numBlocksInUse < d_blocks.size()
+                          ? d_blocks[d_numBlocksInUse]
+                          : allocateBlock();
+            ++d_numBlocksInUse;
+
+            d_segmentBegin_p = block;
+            d_cursor_p       = block;
+            d_end_p          = block + d_blockSize;
+        }
+
+        const int available = static_cast<int>(d_end_p - d_cursor_p);
+        const int n         = numBytes < available ? numBytes : available;
+
+        bsl::memcpy(d_cursor_p, bytes, n);
+        d_cursor_p += n;
+        bytes      += n;
+        numBytes   -= n;
+    }
+
+    validate();
+}
+
+void SegmentedOutStream::closeSegment()
+{
+    if (d_cursor_p != d_segmentBegin_p) {
+        d_segments.push_back(bslstl::StringRef(d_segmentBegin_p,
+                                               d_cursor_p));
+        d_length         += d_cursor_p - d_segmentBegin_p;
+        d_segmentBegin_p  = d_cursor_p;
+    }
+}
+
+// CREATORS
+SegmentedOutStream::~SegmentedOutStream()
+{
+    for (bsl::size_t i = 0; i < d_blocks.size(); ++i) {
+        d_allocator_p->deallocate(d_blocks[i]);
+    }
+}
+
+// MANIPULATORS
+void SegmentedOutStream::reserveCapacity(bsl::size_t newCapacity)
+{
+    while (d_blocks.size() * d_blockSize < newCapacity) {
+        allocateBlock();
+    }
+
+    // Filling the blocks completes (at most) one segment per block.
+
+    d_segments.reserve(d_blocks.size());
+}
+
+void SegmentedOutStream::reset()
+{
+    d_segments.clear();
+    d_numBlocksInUse = 0;
+    d_length         = 0;
+    d_segmentBegin_p = 0;
+    d_cursor_p       = 0;
+    d_end_p          = 0;
+    validate();
+}
+
+SegmentedOutStream& SegmentedOutStream::spliceBuffer(const char  *buffer,
+                                                     bsl::size_t  length)
+{
+    BSLS_ASSERT(buffer || 0 == length);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid() || 0 == length)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    // Invalidate this stream while appending the segments, in case an
+    // exception is thrown.
+
+    invalidate();
+
+    closeSegment();
+    d_segments.push_back(bslstl::StringRef(buffer, buffer + length));
+    d_length += length;
+
+    validate();
+    return *this;
+}
+
+                      // *** string values ***
+
+SegmentedOutStream& SegmentedOutStream::putString(const bsl::string& value)
+{
+    const int length = static_cast<int>(value.length());
+
+    putLength(length);
+    return putArrayUint8(value.data(), length);
+}
+
+                      // *** arrays of variable-length integer values ***
+
+SegmentedOutStream& SegmentedOutStream::putArrayVarInt64(
+                                           const bsls::Types::Int64 *values,
+                                           int                       numValues)
+{
+    BSLS_ASSERT(values);
+    BSLS_ASSERT(0 <= numValues);
+
+    const bsls::Types::Int64 *end = values + numValues;
+    for (; values != end; ++values) {
+        putVarInt64(*values);
+    }
+    return *this;
+}
+
+SegmentedOutStream& SegmentedOutStream::putArrayVarUint64(
+                                          const bsls::Types::Uint64 *values,
+                                          int                        numValues)
+{
+    BSLS_ASSERT(values);
+    BSLS_ASSERT(0 <= numValues);
+
+    const bsls::Types::Uint64 *end = values + numValues;
+    for (; values != end; ++values) {
+        putVarUint64(*values);
+    }
+    return *this;
+}
+
+SegmentedOutStream& SegmentedOutStream::putArrayVarInt32(const int *values,
+                                                         int        numValues)
+{
+    BSLS_ASSERT(values);
+    BSLS_ASSERT(0 <= numValues);
+
+    const int *end = values + numValues;
+    for (; values != end; ++values) {
+        putVarInt32(*values);
+    }
+    return *this;
+}
+
+SegmentedOutStream& SegmentedOutStream::putArrayVarUint32(
+                                                 const unsigned int *values,
+                                                 int                 numValues)
+{
+    BSLS_ASSERT(values);
+    BSLS_ASSERT(0 <= numValues);
+
+    const unsigned int *end = values + numValues;
+    for (; values != end; ++values) {
+        putVarUint32(*values);
+    }
+    return *this;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1820 @@
+// bslx_segmentedoutstream.h                                          -*-C++-*-
+#ifndef INCLUDED_BSLX_SEGMENTEDOUTSTREAM
+#define INCLUDED_BSLX_SEGMENTEDOUTSTREAM
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an output stream writing to a chain of fixed-size blocks.
+//
+//@CLASSES:
+//  bslx::SegmentedOutStream: block-chain-based output stream for BDEX
+//
+//@SEE_ALSO: bslx_byteoutstream, bslx_byteinstream
+//
+//@DESCRIPTION: This component implements an output stream class,
+// 'bslx::SegmentedOutStream', that provides the same platform-independent
+// output methods ("externalization") as 'bslx::ByteOutStream', and writes
+// exactly the same bytes, but stores them in a chain of fixed-size blocks
+// rather than in a single contiguous buffer.  The output of a
+// 'bslx::SegmentedOutStream' can therefore be read by a 'bslx::ByteInStream'
+// once it is gathered into contiguous memory.
+//
+// A 'bslx::ByteOutStream' holds its output in a 'bsl::vector<char>', which is
+// reallocated, and its contents copied, every time it grows.  For large
+// outputs, this copying (and the transient need for twice the memory) can
+// dominate the cost of externalization.  A 'bslx::SegmentedOutStream' never
+// moves bytes once they are written: when the current block is full, writing
+// continues in a new block, and a value that does not fit in the remaining
+// space of a block is split between two blocks.
+//
+// The output of a stream is exposed as a sequence of contiguous *segments*,
+// accessible via 'numSegments' and 'segment', or (for scatter-gather output
+// with, e.g., 'writev' on POSIX platforms) loaded into an array of 'iovec'
+// structures by 'loadSegments'.  In addition, a caller-owned buffer can be
+// *spliced* into the output by reference, using 'spliceBuffer', so that large
+// payloads that already exist in memory need not be copied at all.  The
+// caller must keep a spliced buffer valid, and unmodified, until the stream
+// is reset or destroyed.
+//
+// The supported types and required content are listed in the 'bslx'
+// package-level documentation under "Supported Types".
+//
+// Note that the values are stored in big-endian (i.e., network byte order)
+// format.
+//
+// Note that output streams can be *invalidated* explicitly and queried for
+// *validity*.  Writing to an initially invalid stream has no effect.  Whenever
+// an output operation fails, the stream should be invalidated explicitly.
+//
+///Blocks
+///------
+// All blocks have the same size, supplied at construction, and are obtained
+// from the allocator supplied at construction, so that a pool of blocks of
+// that size is a suitable allocator.  Blocks are allocated as needed (or in
+// advance, by 'reserveCapacity'), and are retained by 'reset' for reuse; they
+// are deallocated only when the stream is destroyed.  Splicing a buffer
+// closes the current segment, but not the current block: subsequent output
+// starts a new segment in the remaining space of the current block.  Note
+// that splicing many small buffers produces many small segments; buffers
+// shorter than a few hundred bytes are better copied, e.g., by
+// 'putArrayUint8'.
+//
+///Versioning
+///----------
+// See the 'bslx_byteoutstream' component-level documentation, and the 'bslx'
+// package-level documentation, for a description of 'versionSelector'.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Writing a Snapshot with 'writev'
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose we write snapshots, each consisting of a small BDEX-encoded header
+// followed by a large payload that is already held in memory, to a file
+// descriptor.  Using a 'bslx::ByteOutStream', both the header and a copy of
+// the payload would be accumulated in one contiguous buffer, which is
+// repeatedly reallocated as it grows.  Instead, we use a
+// 'bslx::SegmentedOutStream', splicing the payload into the output without
+// copying it.
+//
+// On POSIX platforms, 'writev' accepts an array of 'struct iovec' (from
+// '<sys/uio.h>').  For the purposes of this example, we define a structure
+// having the same members:
+//..
+//  struct IoVec {
+//      void        *iov_base;  // address of the segment
+//      bsl::size_t  iov_len;   // length of the segment
+//  };
+//..
+// First, we create a payload, and a stream using small blocks, with an
+// arbitrary value for its 'versionSelector':
+//..
+//  const bsl::string payload(10000, 'x');
+//
+//  bslx::SegmentedOutStream outStream(20131127, 256);
+//..
+// Then, we externalize the header, which ends with the length of the payload,
+// splice in the payload, and externalize a trailing checksum:
+//..
+//  outStream.putInt32(1);                       // snapshot format
+//  outStream.putString(bsl::string("orders"));  // snapshot name
+//  outStream.putLength(static_cast<int>(payload.length()));
+//  outStream.spliceBuffer(payload.data(), payload.length());
+//  outStream.putUint32(0xCAFEBABE);             // checksum
+//  assert(outStream);
+//
+//  assert(4 + 7 + 4 + 10000 + 4 == outStream.length());
+//  assert(3                     == outStream.numSegments());
+//  assert(payload.data()        == outStream.segment(1).data());
+//..
+// Next, we describe the segments of the stream with an array of 'IoVec':
+//..
+//  IoVec     iov[16];
+//  const int numIov = outStream.loadSegments(iov, 16);
+//  assert(3 == numIov);
+//..
+// Now, on a POSIX platform, we would pass 'iov' to 'writev' (e.g.,
+// '::writev(fd, (struct iovec *)iov, numIov)'); here, we simply gather the
+// segments:
+//..
+//  bsl::string gathered;
+//  for (int i = 0; i < numIov; ++i) {
+//      gathered.append(static_cast<const char *>(iov[i].iov_base),
+//                      iov[i].iov_len);
+//  }
+//  assert(outStream.length() == gathered.length());
+//..
+// Finally, we verify that the gathered output is readable by a
+// 'bslx::ByteInStream':
+//..
+//  bslx::ByteInStream inStream(gathered.data(), gathered.length());
+//
+//  int          format;
+//  bsl::string  name;
+//  int          length;
+//  unsigned int checksum;
+//
+//  inStream.getInt32(format);
+//  inStream.getString(name);
+//  inStream.getLength(length);
+//  assert(inStream);
+//  assert(1        == format);
+//  assert("orders" == name);
+//  assert(10000    == length);
+//
+//  bsl::string received(length, '\0');
+//  inStream.getArrayUint8(&received[0], length);
+//  inStream.getUint32(checksum);
+//  assert(inStream);
+//  assert(payload    == received);
+//  assert(0xCAFEBABE == checksum);
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLX_MARSHALLINGUTIL
+#include <bslx_marshallingutil.h>
+#endif
+
+#ifndef INCLUDED_BSLX_OUTSTREAMFUNCTIONS
+#include <bslx_outstreamfunctions.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STRINGREF
+#include <bslstl_stringref.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_STRING
+#include <bsl_string.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bslx {
+
+                         // ========================
+                         // class SegmentedOutStream
+                         // ========================
+
+class SegmentedOutStream {
+    // This class provides output methods to externalize values, and C-style
+    // arrays of values, of the fundamental integral and floating-point types,
+    // as well as 'bsl::string' values, writing exactly the bytes that
+    // 'bslx::ByteOutStream' writes, but storing them in a chain of fixed-size
+    // blocks, and allowing caller-owned buffers to be spliced into the output
+    // by reference.  See the 'bslx' package-level documentation for the
+    // definition of the BDEX 'OutStream' protocol.
+
+    // DATA
+    bsl::vector<char *>            d_blocks;           // blocks owned by this
+                                                       // stream, in order of
+                                                       // use
+
+    bsl::size_t                    d_numBlocksInUse;   // number of leading
+                                                       // 'd_blocks' holding
+                                                       // output
+
+    bsl::vector<bslstl::StringRef> d_segments;         // completed segments,
+                                                       // in order, excluding
+                                                       // the current segment
+
+    bsl::size_t                    d_length;           // total length of
+                                                       // 'd_segments'
+
+    char                          *d_segmentBegin_p;   // start of the current
+                                                       // segment
+
+    char                          *d_cursor_p;         // next byte to write
+                                                       // (end of the current
+                                                       // segment)
+
+    char                          *d_end_p;            // end of the current
+                                                       // block
+
+    int                            d_blockSize;        // size of each block
+
+    int                            d_versionSelector;  // 'versionSelector' to
+                                                       // use with 'operator<<'
+                                                       // as per the 'bslx'
+                                                       // package-level
+                                                       // documentation
+
+    int                            d_validFlag;        // stream validity flag
+
+    bslma::Allocator              *d_allocator_p;      // memory allocator
+                                                       // (held, not owned)
+
+    // NOT IMPLEMENTED
+    SegmentedOutStream(const SegmentedOutStream&);
+    SegmentedOutStream& operator=(const SegmentedOutStream&);
+
+  private:
+    // PRIVATE MANIPULATORS
+    char *allocateBlock();
+        // Allocate a block, append it to 'd_blocks', and return its address.
+
+    void appendSlow(const char *bytes, int numBytes);
+        // Append the specified 'numBytes' bytes from the specified 'bytes' to
+        // this stream, moving to a new block as needed.  If an exception is
+        // thrown, this stream is invalidated.  The behavior is undefined
+        // unless '0 <= numBytes'.
+
+    void closeSegment();
+        // Append the current segment, if it is not empty, to the completed
+        // segments, and start a new (empty) current segment at 'd_cursor_p'.
+
+    template <class TYPE>
+    void putArrayImp(const TYPE  *values,
+                     int          numValues,
+                     int          valueSize,
+                     void       (*putArray)(char *, const TYPE *, int));
+        // Write to this stream the specified 'numValues' leading entries in
+        // the specified 'values', each of which is marshalled into the
+        // specified 'valueSize' bytes by the specified 'putArray' function.
+        // Values that fit in the current block are marshalled in place; a
+        // value that does not is split between blocks.  The behavior is
+        // undefined unless 'this->isValid()', '0 <= numValues', and
+        // '0 < valueSize <= MarshallingUtil::k_SIZEOF_INT64'.
+
+    void validate();
+        // Put this output stream into a valid state.  This function has no
+        // effect if this stream is already valid.
+
+  public:
+    // TYPES
+    enum {
+        k_DEFAULT_BLOCK_SIZE = 4096  // block size used when none is supplied
+    };
+
+    // CREATORS
+    explicit SegmentedOutStream(int               versionSelector,
+                                bslma::Allocator *basicAllocator = 0);
+        // Create an empty output stream, using blocks of
+        // 'k_DEFAULT_BLOCK_SIZE' bytes, that will use the specified
+        // (*compile*-time-defined) 'versionSelector' as needed (see
+        // {Versioning}).  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  Note that the 'versionSelector' is expected to
+        // be formatted as "YYYYMMDD", a date representation.
+
+    SegmentedOutStream(int               versionSelector,
+                       int               blockSize,
+                       bslma::Allocator *basicAllocator = 0);
+        // Create an empty output stream, using blocks of the specified
+        // 'blockSize' bytes, that will use the specified
+        // (*compile*-time-defined) 'versionSelector' as needed (see
+        // {Versioning}).  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless
+        // '0 < blockSize'.  Note that the 'versionSelector' is expected to be
+        // formatted as "YYYYMMDD", a date representation.
+
+    ~SegmentedOutStream();
+        // Destroy this object, deallocating all of its blocks.
+
+    // MANIPULATORS
+    void invalidate();
+        // Put this output stream in an invalid state.  This function has no
+        // effect if this stream is already invalid.
+
+    SegmentedOutStream& putLength(int length);
+        // If the specified 'length' is less than 128, write to this stream the
+        // one-byte integer comprised of the least-significant one byte of the
+        // 'length'; otherwise, write to this stream the four-byte, two's
+        // complement integer (in network byte order) comprised of the
+        // least-significant four bytes of the 'length' (in host byte order)
+        // with the most-significant bit set.  Return a reference to this
+        // stream.  If this stream is initially invalid, this operation has no
+        // effect.  The behavior is undefined unless '0 <= length'.
+
+    SegmentedOutStream& putVersion(int version);
+        // Write to this stream the one-byte, two's complement unsigned integer
+        // comprised of the least-significant one byte of the specified
+        // 'version', and return a reference to this stream.  If this stream is
+        // initially invalid, this operation has no effect.
+
+    void reserveCapacity(bsl::size_t newCapacity);
+        // Allocate blocks, if needed, so that the blocks owned by this stream
+        // have a total size of at least the specified 'newCapacity' (in
+        // bytes), and reserve space to describe their segments, so that
+        // writing that many bytes to an empty stream, without splicing
+        // buffers, does not allocate memory.
+
+    void reset();
+        // Remove all content in this stream, retaining its blocks for reuse,
+        // and validate this stream if it is currently invalid.
+
+    SegmentedOutStream& spliceBuffer(const char *buffer, bsl::size_t length);
+        // Append to this stream, by reference, the specified 'length' bytes
+        // at the specified 'buffer', and return a reference to this stream.
+        // If this stream is initially invalid, this operation has no effect.
+        // The behavior is undefined unless 'buffer' remains valid, and its
+        // first 'length' bytes unmodified, until this stream is reset or
+        // destroyed.  Note that no length is written; a BDEX-compatible
+        // representation of an array of bytes can be produced by first
+        // writing its length with 'putLength'.
+
+                      // *** scalar integer values ***
+
+    SegmentedOutStream& putInt64(bsls::Types::Int64 value);
+        // Write to this stream the eight-byte, two's complement integer (in
+        // network byte order) comprised of the least-significant eight bytes
+        // of the specified 'value' (in host byte order), and return a
+        // reference to this stream.  If this stream is initially invalid, this
+        // operation has no effect.
+
+    SegmentedOutStream& putUint64(bsls::Types::Uint64 value);
+        // Write to this stream the eight-byte, two's complement unsigned
+        // integer (in network byte order) comprised of the least-significant
+        // eight bytes of the specified 'value' (in host byte order), and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.
+
+    SegmentedOutStream& putInt56(bsls::Types::Int64 value);
+        // Write to this stream the seven-byte, two's complement integer (in
+        // network byte order) comprised of the least-significant seven bytes
+        // of the specified 'value' (in host byte order), and return a
+        // reference to this stream.  If this stream is initially invalid, this
+        // operation has no effect.
+
+    SegmentedOutStream& putUint56(bsls::Types::Uint64 value);
+        // Write to this stream the seven-byte, two's complement unsigned
+        // integer (in network byte order) comprised of the least-significant
+        // seven bytes of the specified 'value' (in host byte order), and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.
+
+    SegmentedOutStream& putInt48(bsls::Types::Int64 value);
+        // Write to this stream the six-byte, two's complement integer (in
+        // network byte order) comprised of the least-significant six bytes of
+        // the specified 'value' (in host byte order), and return a reference
+        // to this stream.  If this stream is initially invalid, this operation
+        // has no effect.
+
+    SegmentedOutStream& putUint48(bsls::Types::Uint64 value);
+        // Write to this stream the six-byte, two's complement unsigned integer
+        // (in network byte order) comprised of the least-significant six bytes
+        // of the specified 'value' (in host byte order), and return a
+        // reference to this stream.  If this stream is initially invalid, this
+        // operation has no effect.
+
+    SegmentedOutStream& putInt40(bsls::Types::Int64 value);
+        // Write to this stream the five-byte, two's complement integer (in
+        // network byte order) comprised of the least-significant five bytes of
+        // the specified 'value' (in host byte order), and return a reference
+        // to this stream.  If this stream is initially invalid, this operation
+        // has no effect.
+
+    SegmentedOutStream& putUint40(bsls::Types::Uint64 value);
+        // Write to this stream the five-byte, two's complement unsigned
+        // integer (in network byte order) comprised of the least-significant
+        // five bytes of the specified 'value' (in host byte order), and return
+        // a reference to this stream.  If this stream is initially invalid,
+        // this operation has no effect.
+
+    SegmentedOutStream& putInt32(int value);
+        // Write to this stream the four-byte, two's complement integer (in
+        // network byte order) comprised of the least-significant four bytes of
+        // the specified 'value' (in host byte order), and return a reference
+        // to this stream.  If this stream is initially invalid, this operation
+        // has no effect.
+
+    SegmentedOutStream& putUint32(unsigned int value);
+        // Write to this stream the four-byte, two's complement unsigned
+        // integer (in network byte order) comprised of the least-significant
+        // four bytes of the specified 'value' (in host byte order), and return
+        // a reference to this stream.  If this stream is initially invalid,
+        // this operation has no effect.
+
+    SegmentedOutStream& putInt24(int value);
+        // Write to this stream the three-byte, two's complement integer (in
+        // network byte order) comprised of the least-significant three bytes
+        // of the specified 'value' (in host byte order), and return a
+        // reference to this stream.  If this stream is initially invalid, this
+        // operation has no effect.
+
+    SegmentedOutStream& putUint24(unsigned int value);
+        // Write to this stream the three-byte, two's complement unsigned
+        // integer (in network byte order) comprised of the least-significant
+        // three bytes of the specified 'value' (in host byte order), and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.
+
+    SegmentedOutStream& putInt16(int value);
+        // Write to this stream the two-byte, two's complement integer (in
+        // network byte order) comprised of the least-significant two bytes of
+        // the specified 'value' (in host byte order), and return a reference
+        // to this stream.  If this stream is initially invalid, this operation
+        // has no effect.
+
+    SegmentedOutStream& putUint16(unsigned int value);
+        // Write to this stream the two-byte, two's complement unsigned integer
+        // (in network byte order) comprised of the least-significant two bytes
+        // of the specified 'value' (in host byte order), and return a
+        // reference to this stream.  If this stream is initially invalid, this
+        // operation has no effect.
+
+    SegmentedOutStream& putInt8(int value);
+        // Write to this stream the one-byte, two's complement integer
+        // comprised of the least-significant one byte of the specified
+        // 'value', and return a reference to this stream.  If this stream is
+        // initially invalid, this operation has no effect.
+
+    SegmentedOutStream& putUint8(unsigned int value);
+        // Write to this stream the one-byte, two's complement unsigned integer
+        // comprised of the least-significant one byte of the specified
+        // 'value', and return a reference to this stream.  If this stream is
+        // initially invalid, this operation has no effect.
+
+                      // *** scalar floating-point values ***
+
+    SegmentedOutStream& putFloat64(double value);
+        // Write to this stream the eight-byte IEEE double-precision
+        // floating-point number (in network byte order) comprised of the
+        // most-significant eight bytes of the specified 'value' (in host byte
+        // order), and return a reference to this stream.  If this stream is
+        // initially invalid, this operation has no effect.  Note that for
+        // non-conforming platforms, this operation may be lossy.
+
+    SegmentedOutStream& putFloat32(float value);
+        // Write to this stream the four-byte IEEE single-precision
+        // floating-point number (in network byte order) comprised of the
+        // most-significant four bytes of the specified 'value' (in host byte
+        // order), and return a reference to this stream.  If this stream is
+        // initially invalid, this operation has no effect.  Note that for
+        // non-conforming platforms, this operation may be lossy.
+
+                      // *** string values ***
+
+    SegmentedOutStream& putString(const bsl::string& value);
+        // Write to this stream the length of the specified 'value' (see
+        // 'putLength') and an array of one-byte, two's complement unsigned
+        // integers comprised of the least-significant one byte of each
+        // character in the 'value', and return a reference to this stream.  If
+        // this stream is initially invalid, this operation has no effect.
+
+                      // *** arrays of integer values ***
+
+    SegmentedOutStream& putArrayInt64(const bsls::Types::Int64 *values,
+                                      int                       numValues);
+        // Write to this stream the consecutive eight-byte, two's complement
+        // integers (in network byte order) comprised of the least-significant
+        // eight bytes of each of the specified 'numValues' leading entries in
+        // the specified 'values' (in host byte order), and return a reference
+        // to this stream.  If this stream is initially invalid, this operation
+        // has no effect.  The behavior is undefined unless '0 <= numValues'
+        // and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayUint64(const bsls::Types::Uint64 *values,
+                                       int                        numValues);
+        // Write to this stream the consecutive eight-byte, two's complement
+        // unsigned integers (in network byte order) comprised of the
+        // least-significant eight bytes of each of the specified 'numValues'
+        // leading entries in the specified 'values' (in host byte order), and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.  The behavior is undefined
+        // unless '0 <= numValues' and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayInt56(const bsls::Types::Int64 *values,
+                                      int                       numValues);
+        // Write to this stream the consecutive seven-byte, two's complement
+        // integers (in network byte order) comprised of the least-significant
+        // seven bytes of each of the specified 'numValues' leading entries in
+        // the specified 'values' (in host byte order), and return a reference
+        // to this stream.  If this stream is initially invalid, this operation
+        // has no effect.  The behavior is undefined unless '0 <= numValues'
+        // and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayUint56(const bsls::Types::Uint64 *values,
+                                       int                        numValues);
+        // Write to this stream the consecutive seven-byte, two's complement
+        // unsigned integers (in network byte order) comprised of the
+        // least-significant seven bytes of each of the specified 'numValues'
+        // leading entries in the specified 'values' (in host byte order), and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.  The behavior is undefined
+        // unless '0 <= numValues' and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayInt48(const bsls::Types::Int64 *values,
+                                      int                       numValues);
+        // Write to this stream the consecutive six-byte, two's complement
+        // integers (in network byte order) comprised of the least-significant
+        // six bytes of each of the specified 'numValues' leading entries in
+        // the specified 'values' (in host byte order), and return a reference
+        // to this stream.  If this stream is initially invalid, this operation
+        // has no effect.  The behavior is undefined unless '0 <= numValues'
+        // and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayUint48(const bsls::Types::Uint64 *values,
+                                       int                        numValues);
+        // Write to this stream the consecutive six-byte, two's complement
+        // unsigned integers (in network byte order) comprised of the
+        // least-significant six bytes of each of the specified 'numValues'
+        // leading entries in the specified 'values' (in host byte order), and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.  The behavior is undefined
+        // unless '0 <= numValues' and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayInt40(const bsls::Types::Int64 *values,
+                                      int                       numValues);
+        // Write to this stream the consecutive five-byte, two's complement
+        // integers (in network byte order) comprised of the least-significant
+        // five bytes of each of the specified 'numValues' leading entries in
+        // the specified 'values' (in host byte order), and return a reference
+        // to this stream.  If this stream is initially invalid, this operation
+        // has no effect.  The behavior is undefined unless '0 <= numValues'
+        // and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayUint40(const bsls::Types::Uint64 *values,
+                                       int                        numValues);
+        // Write to this stream the consecutive five-byte, two's complement
+        // unsigned integers (in network byte order) comprised of the
+        // least-significant five bytes of each of the specified 'numValues'
+        // leading entries in the specified 'values' (in host byte order), and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.  The behavior is undefined
+        // unless '0 <= numValues' and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayInt32(const int *values, int numValues);
+        // Write to this stream the consecutive four-byte, two's complement
+        // integers (in network byte order) comprised of the least-significant
+        // four bytes of each of the specified 'numValues' leading entries in
+        // the specified 'values' (in host byte order), and return a reference
+        // to this stream.  If this stream is initially invalid, this operation
+        // has no effect.  The behavior is undefined unless '0 <= numValues'
+        // and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayUint32(const unsigned int *values,
+                                       int                 numValues);
+        // Write to this stream the consecutive four-byte, two's complement
+        // unsigned integers (in network byte order) comprised of the
+        // least-significant four bytes of each of the specified 'numValues'
+        // leading entries in the specified 'values' (in host byte order), and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.  The behavior is undefined
+        // unless '0 <= numValues' and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayInt24(const int *values, int numValues);
+        // Write to this stream the consecutive three-byte, two's complement
+        // integers (in network byte order) comprised of the least-significant
+        // three bytes of each of the specified 'numValues' leading entries in
+        // the specified 'values' (in host byte order), and return a reference
+        // to this stream.  If this stream is initially invalid, this operation
+        // has no effect.  The behavior is undefined unless '0 <= numValues'
+        // and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayUint24(const unsigned int *values,
+                                       int                 numValues);
+        // Write to this stream the consecutive three-byte, two's complement
+        // unsigned integers (in network byte order) comprised of the
+        // least-significant three bytes of each of the specified 'numValues'
+        // leading entries in the specified 'values' (in host byte order), and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.  The behavior is undefined
+        // unless '0 <= numValues' and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayInt16(const short *values, int numValues);
+        // Write to this stream the consecutive two-byte, two's complement
+        // integers (in network byte order) comprised of the least-significant
+        // two bytes of each of the specified 'numValues' leading entries in
+        // the specified 'values' (in host byte order), and return a reference
+        // to this stream.  If this stream is initially invalid, this operation
+        // has no effect.  The behavior is undefined unless '0 <= numValues'
+        // and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayUint16(const unsigned short *values,
+                                       int                   numValues);
+        // Write to this stream the consecutive two-byte, two's complement
+        // unsigned integers (in network byte order) comprised of the
+        // least-significant two bytes of each of the specified 'numValues'
+        // leading entries in the specified 'values' (in host byte order), and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.  The behavior is undefined
+        // unless '0 <= numValues' and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayInt8(const char        *values, int numValues);
+    SegmentedOutStream& putArrayInt8(const signed char *values, int numValues);
+        // Write to this stream the consecutive one-byte, two's complement
+        // integers comprised of the least-significant one byte of each of the
+        // specified 'numValues' leading entries in the specified 'values', and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.  The behavior is undefined
+        // unless '0 <= numValues' and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayUint8(const char          *values,
+                                      int                  numValues);
+    SegmentedOutStream& putArrayUint8(const unsigned char *values,
+                                      int                  numValues);
+        // Write to this stream the consecutive one-byte, two's complement
+        // unsigned integers comprised of the least-significant one byte of
+        // each of the specified 'numValues' leading entries in the specified
+        // 'values', and return a reference to this stream.  If this stream is
+        // initially invalid, this operation has no effect.  The behavior is
+        // undefined unless '0 <= numValues' and 'values' has sufficient
+        // contents.
+
+                      // *** arrays of floating-point values ***
+
+    SegmentedOutStream& putArrayFloat64(const double *values, int numValues);
+        // Write to this stream the consecutive eight-byte IEEE
+        // double-precision floating-point numbers (in network byte order)
+        // comprised of the most-significant eight bytes of each of the
+        // specified 'numValues' leading entries in the specified 'values' (in
+        // host byte order), and return a reference to this stream.  If this
+        // stream is initially invalid, this operation has no effect.  The
+        // behavior is undefined unless '0 <= numValues' and 'values' has
+        // sufficient contents.  Note that for non-conforming platforms, this
+        // operation may be lossy.
+
+    SegmentedOutStream& putArrayFloat32(const float *values, int numValues);
+        // Write to this stream the consecutive four-byte IEEE single-precision
+        // floating-point numbers (in network byte order) comprised of the
+        // most-significant four bytes of each of the specified 'numValues'
+        // leading entries in the specified 'values' (in host byte order), and
+        // return a reference to this stream.  If this stream is initially
+        // invalid, this operation has no effect.  The behavior is undefined
+        // unless '0 <= numValues' and 'values' has sufficient contents.  Note
+        // that for non-conforming platforms, this operation may be lossy.
+
+                      // *** variable-length integer values ***
+
+    SegmentedOutStream& putVarInt64(bsls::Types::Int64 value);
+        // Write to this stream the variable-length encoding of the zigzag
+        // transformation of the specified 'value' (see
+        // 'bslx_marshallingutil'), and return a reference to this stream.  If
+        // this stream is initially invalid, this operation has no effect.
+
+    SegmentedOutStream& putVarUint64(bsls::Types::Uint64 value);
+        // Write to this stream the variable-length encoding of the specified
+        // 'value' (see 'bslx_marshallingutil'), and return a reference to this
+        // stream.  If this stream is initially invalid, this operation has no
+        // effect.
+
+    SegmentedOutStream& putVarInt32(int value);
+        // Write to this stream the variable-length encoding of the zigzag
+        // transformation of the specified 'value' (see
+        // 'bslx_marshallingutil'), and return a reference to this stream.  If
+        // this stream is initially invalid, this operation has no effect.
+
+    SegmentedOutStream& putVarUint32(unsigned int value);
+        // Write to this stream the variable-length encoding of the specified
+        // 'value' (see 'bslx_marshallingutil'), and return a reference to this
+        // stream.  If this stream is initially invalid, this operation has no
+        // effect.
+
+                      // *** arrays of variable-length integer values ***
+
+    SegmentedOutStream& putArrayVarInt64(const bsls::Types::Int64 *values,
+                                         int                       numValues);
+        // Write to this stream the consecutive variable-length encodings of
+        // the zigzag transformations of each of the specified 'numValues'
+        // leading entries in the specified 'values', and return a reference to
+        // this stream.  If this stream is initially invalid, this operation
+        // has no effect.  The behavior is undefined unless '0 <= numValues'
+        // and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayVarUint64(
+                                     const bsls::Types::Uint64 *values,
+                                     int                        numValues);
+        // Write to this stream the consecutive variable-length encodings of
+        // each of the specified 'numValues' leading entries in the specified
+        // 'values', and return a reference to this stream.  If this stream is
+        // initially invalid, this operation has no effect.  The behavior is
+        // undefined unless '0 <= numValues' and 'values' has sufficient
+        // contents.
+
+    SegmentedOutStream& putArrayVarInt32(const int *values,
+                                         int        numValues);
+        // Write to this stream the consecutive variable-length encodings of
+        // the zigzag transformations of each of the specified 'numValues'
+        // leading entries in the specified 'values', and return a reference to
+        // this stream.  If this stream is initially invalid, this operation
+        // has no effect.  The behavior is undefined unless '0 <= numValues'
+        // and 'values' has sufficient contents.
+
+    SegmentedOutStream& putArrayVarUint32(const unsigned int *values,
+                                          int                 numValues);
+        // Write to this stream the consecutive variable-length encodings of
+        // each of the specified 'numValues' leading entries in the specified
+        // 'values', and return a reference to this stream.  If this stream is
+        // initially invalid, this operation has no effect.  The behavior is
+        // undefined unless '0 <= numValues' and 'values' has sufficient
+        // contents.
+
+    // ACCESSORS
+    operator const void *() const;
+        // Return a non-zero value if this stream is valid, and 0 otherwise.
+        // An invalid stream is a stream for which an output operation was
+        // detected to have failed or 'invalidate' was called.
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this stream to supply memory.
+
+    int bdexVersionSelector() const;
+        // Return the 'versionSelector' to be used with 'operator<<' for BDEX
+        // streaming as per the 'bslx' package-level documentation.
+
+    int blockSize() const;
+        // Return the size (in bytes) of the blocks of this stream.
+
+    bool isValid() const;
+        // Return 'true' if this stream is valid, and 'false' otherwise.  An
+        // invalid stream is a stream for which an output operation was
+        // detected to have failed or 'invalidate' was called.
+
+    bsl::size_t length() const;
+        // Return the number of bytes in this stream, including those of
+        // spliced buffers.
+
+    template <class IOVEC>
+    int loadSegments(IOVEC *segments,
+                     int    maxNumSegments,
+                     int    firstIndex = 0) const;
+        // Load into consecutive elements of the specified 'segments' array
+        // the addresses and lengths of at most the specified
+        // 'maxNumSegments' consecutive segments of this stream, starting with
+        // the segment at the optionally specified 'firstIndex' (0 by
+        // default), and return the number of segments loaded.  'IOVEC' must
+        // have a modifiable data member 'iov_base' to which a 'void *' can be
+        // assigned, and a modifiable data member 'iov_len' to which a
+        // 'bsl::size_t' can be assigned, as does 'struct iovec' on POSIX
+        // platforms.  The behavior is undefined unless '0 <= maxNumSegments',
+        // 'segments' has at least 'maxNumSegments' elements, and
+        // '0 <= firstIndex <= numSegments()'.  Note that 'maxNumSegments'
+        // allows the segments to be written in batches limited by, e.g.,
+        // 'IOV_MAX'.
+
+    int numSegments() const;
+        // Return the number of contiguous segments that, taken in order, hold
+        // the bytes of this stream.  Note that no segment is empty, so this
+        // method returns 0 if and only if 'length()' is 0.
+
+    bslstl::StringRef segment(int index) const;
+        // Return a reference to the segment at the specified 'index'.  The
+        // returned reference remains valid until this stream is reset or
+        // destroyed, but the segment at 'numSegments() - 1' may be extended
+        // by subsequent output (which is not reflected in the returned
+        // reference).  The behavior is undefined unless
+        // '0 <= index < numSegments()'.
+};
+
+// FREE OPERATORS
+template <class TYPE>
+SegmentedOutStream& operator<<(SegmentedOutStream& stream, const TYPE& value);
+    // Write the specified 'value' to the specified output 'stream' following
+    // the requirements of the BDEX protocol (see the 'bslx' package-level
+    // documentation), and return a reference to 'stream'.  The behavior is
+    // undefined unless 'TYPE' is BDEX-compliant.
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                         // ------------------------
+                         // class SegmentedOutStream
+                         // ------------------------
+
+// PRIVATE MANIPULATORS
+template <class TYPE>
+inline
+void SegmentedOutStream::putArrayImp(
+                            const TYPE  *values,
+                            int          numValues,
+                            int          valueSize,
+                            void       (*putArray)(char *, const TYPE *, int))
+{
+    BSLS_ASSERT_SAFE(isValid());
+    BSLS_ASSERT_SAFE(0 <= numValues);
+    BSLS_ASSERT_SAFE(0 < valueSize);
+    BSLS_ASSERT_SAFE(valueSize <= MarshallingUtil::k_SIZEOF_INT64);
+
+    while (0 < numValues) {
+        const int numFit = static_cast<int>((d_end_p - d_cursor_p)
+                                                                 / valueSize);
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(0 < numFit)) {
+            const int n = numFit < numValues ? numFit : numValues;
+
+            putArray(d_cursor_p, values, n);
+            d_cursor_p += n * valueSize;
+            values     += n;
+            numValues  -= n;
+        }
+        else {
+            // The next value does not fit in the current block: marshal it
+            // separately, and split it between blocks.
+
+            char bytes[MarshallingUtil::k_SIZEOF_INT64];
+            putArray(bytes, values, 1);
+            appendSlow(bytes, valueSize);
+            ++values;
+            --numValues;
+        }
+    }
+}
+
+inline
+void SegmentedOutStream::validate()
+{
+    d_validFlag = true;
+}
+
+// CREATORS
+inline
+SegmentedOutStream::SegmentedOutStream(int               versionSelector,
+                                       bslma::Allocator *basicAllocator)
+: d_blocks(basicAllocator)
+, d_numBlocksInUse(0)
+, d_segments(basicAllocator)
+, d_length(0)
+, d_segmentBegin_p(0)
+, d_cursor_p(0)
+, d_end_p(0)
+, d_blockSize(k_DEFAULT_BLOCK_SIZE)
+, d_versionSelector(versionSelector)
+, d_validFlag(true)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+inline
+SegmentedOutStream::SegmentedOutStream(int               versionSelector,
+                                       int               blockSize,
+                                       bslma::Allocator *basicAllocator)
+: d_blocks(basicAllocator)
+, d_numBlocksInUse(0)
+, d_segments(basicAllocator)
+, d_length(0)
+, d_segmentBegin_p(0)
+, d_cursor_p(0)
+, d_end_p(0)
+, d_blockSize(blockSize)
+, d_versionSelector(versionSelector)
+, d_validFlag(true)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT_SAFE(0 < blockSize);
+}
+
+// MANIPULATORS
+inline
+void SegmentedOutStream::invalidate()
+{
+    d_validFlag = false;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putLength(int length)
+{
+    BSLS_ASSERT_SAFE(0 <= length);
+
+    if (length > 127) {
+        putInt32(length | (1 << 31));
+    } else {
+        putInt8(length);
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putVersion(int version)
+{
+    return putUint8(version);
+}
+
+                      // *** scalar integer values ***
+
+inline
+SegmentedOutStream& SegmentedOutStream::putInt64(bsls::Types::Int64 value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(MarshallingUtil::k_SIZEOF_INT64
+                                            <= d_end_p - d_cursor_p)) {
+        MarshallingUtil::putInt64(d_cursor_p, value);
+        d_cursor_p += MarshallingUtil::k_SIZEOF_INT64;
+    }
+    else {
+        char bytes[MarshallingUtil::k_SIZEOF_INT64];
+        MarshallingUtil::putInt64(bytes, value);
+        appendSlow(bytes, MarshallingUtil::k_SIZEOF_INT64);
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putUint64(bsls::Types::Uint64 value)
+{
+    return putInt64(static_cast<bsls::Types::Int64>(value));
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putInt56(bsls::Types::Int64 value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(MarshallingUtil::k_SIZEOF_INT56
+                                            <= d_end_p - d_cursor_p)) {
+        MarshallingUtil::putInt56(d_cursor_p, value);
+        d_cursor_p += MarshallingUtil::k_SIZEOF_INT56;
+    }
+    else {
+        char bytes[MarshallingUtil::k_SIZEOF_INT56];
+        MarshallingUtil::putInt56(bytes, value);
+        appendSlow(bytes, MarshallingUtil::k_SIZEOF_INT56);
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putUint56(bsls::Types::Uint64 value)
+{
+    return putInt56(static_cast<bsls::Types::Int64>(value));
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putInt48(bsls::Types::Int64 value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(MarshallingUtil::k_SIZEOF_INT48
+                                            <= d_end_p - d_cursor_p)) {
+        MarshallingUtil::putInt48(d_cursor_p, value);
+        d_cursor_p += MarshallingUtil::k_SIZEOF_INT48;
+    }
+    else {
+        char bytes[MarshallingUtil::k_SIZEOF_INT48];
+        MarshallingUtil::putInt48(bytes, value);
+        appendSlow(bytes, MarshallingUtil::k_SIZEOF_INT48);
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putUint48(bsls::Types::Uint64 value)
+{
+    return putInt48(static_cast<bsls::Types::Int64>(value));
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putInt40(bsls::Types::Int64 value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(MarshallingUtil::k_SIZEOF_INT40
+                                            <= d_end_p - d_cursor_p)) {
+        MarshallingUtil::putInt40(d_cursor_p, value);
+        d_cursor_p += MarshallingUtil::k_SIZEOF_INT40;
+    }
+    else {
+        char bytes[MarshallingUtil::k_SIZEOF_INT40];
+        MarshallingUtil::putInt40(bytes, value);
+        appendSlow(bytes, MarshallingUtil::k_SIZEOF_INT40);
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putUint40(bsls::Types::Uint64 value)
+{
+    return putInt40(static_cast<bsls::Types::Int64>(value));
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putInt32(int value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(MarshallingUtil::k_SIZEOF_INT32
+                                            <= d_end_p - d_cursor_p)) {
+        MarshallingUtil::putInt32(d_cursor_p, value);
+        d_cursor_p += MarshallingUtil::k_SIZEOF_INT32;
+    }
+    else {
+        char bytes[MarshallingUtil::k_SIZEOF_INT32];
+        MarshallingUtil::putInt32(bytes, value);
+        appendSlow(bytes, MarshallingUtil::k_SIZEOF_INT32);
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putUint32(unsigned int value)
+{
+    return putInt32(static_cast<int>(value));
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putInt24(int value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(MarshallingUtil::k_SIZEOF_INT24
+                                            <= d_end_p - d_cursor_p)) {
+        MarshallingUtil::putInt24(d_cursor_p, value);
+        d_cursor_p += MarshallingUtil::k_SIZEOF_INT24;
+    }
+    else {
+        char bytes[MarshallingUtil::k_SIZEOF_INT24];
+        MarshallingUtil::putInt24(bytes, value);
+        appendSlow(bytes, MarshallingUtil::k_SIZEOF_INT24);
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putUint24(unsigned int value)
+{
+    return putInt24(static_cast<int>(value));
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putInt16(int value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(MarshallingUtil::k_SIZEOF_INT16
+                                            <= d_end_p - d_cursor_p)) {
+        MarshallingUtil::putInt16(d_cursor_p, value);
+        d_cursor_p += MarshallingUtil::k_SIZEOF_INT16;
+    }
+    else {
+        char bytes[MarshallingUtil::k_SIZEOF_INT16];
+        MarshallingUtil::putInt16(bytes, value);
+        appendSlow(bytes, MarshallingUtil::k_SIZEOF_INT16);
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putUint16(unsigned int value)
+{
+    return putInt16(static_cast<int>(value));
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putInt8(int value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(MarshallingUtil::k_SIZEOF_INT8
+                                            <= d_end_p - d_cursor_p)) {
+        MarshallingUtil::putInt8(d_cursor_p, value);
+        d_cursor_p += MarshallingUtil::k_SIZEOF_INT8;
+    }
+    else {
+        char bytes[MarshallingUtil::k_SIZEOF_INT8];
+        MarshallingUtil::putInt8(bytes, value);
+        appendSlow(bytes, MarshallingUtil::k_SIZEOF_INT8);
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putUint8(unsigned int value)
+{
+    return putInt8(static_cast<int>(value));
+}
+
+                      // *** scalar floating-point values ***
+
+inline
+SegmentedOutStream& SegmentedOutStream::putFloat64(double value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(MarshallingUtil::k_SIZEOF_FLOAT64
+                                            <= d_end_p - d_cursor_p)) {
+        MarshallingUtil::putFloat64(d_cursor_p, value);
+        d_cursor_p += MarshallingUtil::k_SIZEOF_FLOAT64;
+    }
+    else {
+        char bytes[MarshallingUtil::k_SIZEOF_FLOAT64];
+        MarshallingUtil::putFloat64(bytes, value);
+        appendSlow(bytes, MarshallingUtil::k_SIZEOF_FLOAT64);
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putFloat32(float value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(MarshallingUtil::k_SIZEOF_FLOAT32
+                                            <= d_end_p - d_cursor_p)) {
+        MarshallingUtil::putFloat32(d_cursor_p, value);
+        d_cursor_p += MarshallingUtil::k_SIZEOF_FLOAT32;
+    }
+    else {
+        char bytes[MarshallingUtil::k_SIZEOF_FLOAT32];
+        MarshallingUtil::putFloat32(bytes, value);
+        appendSlow(bytes, MarshallingUtil::k_SIZEOF_FLOAT32);
+    }
+    return *this;
+}
+
+                      // *** arrays of integer values ***
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayInt64(
+                                           const bsls::Types::Int64 *values,
+                                           int                       numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT64,
+                &MarshallingUtil::putArrayInt64);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayUint64(
+                                          const bsls::Types::Uint64 *values,
+                                          int                        numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT64,
+                &MarshallingUtil::putArrayInt64);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayInt56(
+                                           const bsls::Types::Int64 *values,
+                                           int                       numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT56,
+                &MarshallingUtil::putArrayInt56);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayUint56(
+                                          const bsls::Types::Uint64 *values,
+                                          int                        numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT56,
+                &MarshallingUtil::putArrayInt56);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayInt48(
+                                           const bsls::Types::Int64 *values,
+                                           int                       numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT48,
+                &MarshallingUtil::putArrayInt48);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayUint48(
+                                          const bsls::Types::Uint64 *values,
+                                          int                        numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT48,
+                &MarshallingUtil::putArrayInt48);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayInt40(
+                                           const bsls::Types::Int64 *values,
+                                           int                       numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT40,
+                &MarshallingUtil::putArrayInt40);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayUint40(
+                                          const bsls::Types::Uint64 *values,
+                                          int                        numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT40,
+                &MarshallingUtil::putArrayInt40);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayInt32(const int *values,
+                                                      int        numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT32,
+                &MarshallingUtil::putArrayInt32);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayUint32(
+                                                 const unsigned int *values,
+                                                 int                 numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT32,
+                &MarshallingUtil::putArrayInt32);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayInt24(const int *values,
+                                                      int        numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT24,
+                &MarshallingUtil::putArrayInt24);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayUint24(
+                                                 const unsigned int *values,
+                                                 int                 numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT24,
+                &MarshallingUtil::putArrayInt24);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayInt16(const short *values,
+                                                      int          numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT16,
+                &MarshallingUtil::putArrayInt16);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayUint16(
+                                               const unsigned short *values,
+                                               int                   numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT16,
+                &MarshallingUtil::putArrayInt16);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayInt8(const char *values,
+                                                     int         numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT8,
+                &MarshallingUtil::putArrayInt8);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayInt8(
+                                                  const signed char *values,
+                                                  int                numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT8,
+                &MarshallingUtil::putArrayInt8);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayUint8(const char *values,
+                                                      int         numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT8,
+                &MarshallingUtil::putArrayInt8);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayUint8(
+                                                const unsigned char *values,
+                                                int                  numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_INT8,
+                &MarshallingUtil::putArrayInt8);
+
+    return *this;
+}
+
+                      // *** arrays of floating-point values ***
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayFloat64(
+                                                       const double *values,
+                                                       int           numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_FLOAT64,
+                &MarshallingUtil::putArrayFloat64);
+
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putArrayFloat32(const float *values,
+                                                        int          numValues)
+{
+    BSLS_ASSERT_SAFE(values);
+    BSLS_ASSERT_SAFE(0 <= numValues);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    putArrayImp(values,
+                numValues,
+                MarshallingUtil::k_SIZEOF_FLOAT32,
+                &MarshallingUtil::putArrayFloat32);
+
+    return *this;
+}
+
+                      // *** variable-length integer values ***
+
+inline
+SegmentedOutStream& SegmentedOutStream::putVarInt64(bsls::Types::Int64 value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                                       MarshallingUtil::k_MAX_SIZEOF_VARINT64
+                                       <= d_end_p - d_cursor_p)) {
+        d_cursor_p += MarshallingUtil::putVarInt64(d_cursor_p, value);
+    }
+    else {
+        char bytes[MarshallingUtil::k_MAX_SIZEOF_VARINT64];
+        appendSlow(bytes, MarshallingUtil::putVarInt64(bytes, value));
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putVarUint64(bsls::Types::Uint64 value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                                       MarshallingUtil::k_MAX_SIZEOF_VARINT64
+                                       <= d_end_p - d_cursor_p)) {
+        d_cursor_p += MarshallingUtil::putVarUint64(d_cursor_p, value);
+    }
+    else {
+        char bytes[MarshallingUtil::k_MAX_SIZEOF_VARINT64];
+        appendSlow(bytes, MarshallingUtil::putVarUint64(bytes, value));
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putVarInt32(int value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                                       MarshallingUtil::k_MAX_SIZEOF_VARINT32
+                                       <= d_end_p - d_cursor_p)) {
+        d_cursor_p += MarshallingUtil::putVarInt32(d_cursor_p, value);
+    }
+    else {
+        char bytes[MarshallingUtil::k_MAX_SIZEOF_VARINT32];
+        appendSlow(bytes, MarshallingUtil::putVarInt32(bytes, value));
+    }
+    return *this;
+}
+
+inline
+SegmentedOutStream& SegmentedOutStream::putVarUint32(unsigned int value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return *this;                                                 // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                                       MarshallingUtil::k_MAX_SIZEOF_VARINT32
+                                       <= d_end_p - d_cursor_p)) {
+        d_cursor_p += MarshallingUtil::putVarUint32(d_cursor_p, value);
+    }
+    else {
+        char bytes[MarshallingUtil::k_MAX_SIZEOF_VARINT32];
+        appendSlow(bytes, MarshallingUtil::putVarUint32(bytes, value));
+    }
+    return *this;
+}
+
+// ACCESSORS
+inline
+SegmentedOutStream::operator const void *() const
+{
+    return isValid() ? this : 0;
+}
+
+inline
+bslma::Allocator *SegmentedOutStream::allocator() const
+{
+    return d_allocator_p;
+}
+
+inline
+int SegmentedOutStream::bdexVersionSelector() const
+{
+    return d_versionSelector;
+}
+
+inline
+int SegmentedOutStream::blockSize() const
+{
+    return d_blockSize;
+}
+
+inline
+bool SegmentedOutStream::isValid() const
+{
+    return d_validFlag;
+}
+
+inline
+bsl::size_t SegmentedOutStream::length() const
+{
+    return d_length + (d_cursor_p - d_segmentBegin_p);
+}
+
+template <class IOVEC>
+int SegmentedOutStream::loadSegments(IOVEC *segments,
+                                     int    maxNumSegments,
+                                     int    firstIndex) const
+{
+    BSLS_ASSERT_SAFE(segments || 0 == maxNumSegments);
+    BSLS_ASSERT_SAFE(0 <= maxNumSegments);
+    BSLS_ASSERT_SAFE(0 <= firstIndex);
+    BSLS_ASSERT_SAFE(firstIndex <= numSegments());
+
+    const int available = numSegments() - firstIndex;
+    const int count     = available < maxNumSegments
+                          ? available
+                          : maxNumSegments;
+
+    for (int i = 0; i < count; ++i) {
+        const bslstl::StringRef s = segment(firstIndex + i);
+
+        segments[i].iov_base = const_cast<char *>(s.data());
+        segments[i].iov_len  = s.length();
+    }
+    return count;
+}
+
+inline
+int SegmentedOutStream::numSegments() const
+{
+    return static_cast<int>(d_segments.size())
+                                           + (d_cursor_p != d_segmentBegin_p);
+}
+
+inline
+bslstl::StringRef SegmentedOutStream::segment(int index) const
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < numSegments());
+
+    return static_cast<bsl::size_t>(index) < d_segments.size()
+           ? d_segments[index]
+           : bslstl::StringRef(d_segmentBegin_p, d_cursor_p);
+}
+
+// FREE OPERATORS
+template <class TYPE>
+inline
+SegmentedOutStream& operator<<(SegmentedOutStream& stream, const TYPE& value)
+{
+    return OutStreamFunctions::bdexStreamOut(stream, value);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// TRAITS
+namespace BloombergLP {
+namespace bslma {
+
+template <>
+struct UsesBslmaAllocator<bslx::SegmentedOutStream> : bsl::true_type {};
+
+}  // close 'bslma' namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1119 @@
+// bslx_segmentedoutstream.t.cpp                                      -*-C++-*-
+
+#include <bslx_segmentedoutstream.h>
+
+#include <bslx_byteinstream.h>
+#include <bslx_byteoutstream.h>
+
+#include <bslma_default.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+using namespace bslx;
+
+// ============================================================================
+//                              TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// For all output methods in 'SegmentedOutStream', the formatting of the input
+// value to its correct byte representation is delegated to
+// 'bslx::MarshallingUtil', and the stream is required to write exactly the
+// bytes written by 'bslx::ByteOutStream'.  Therefore, we are concerned with
+// the placement of bytes in the chain of blocks, in particular for values and
+// arrays that straddle the boundaries between blocks, and with the segments
+// exposed by the stream, in particular around spliced buffers.  We verify the
+// output by gathering the segments and comparing them with the output of a
+// 'bslx::ByteOutStream' to which the same values are written, for block sizes
+// that are both smaller and larger than the values.
+// ----------------------------------------------------------------------------
+// [ 2] SegmentedOutStream(int sV, *ba = 0);
+// [ 2] SegmentedOutStream(int sV, int blockSize, *ba = 0);
+// [ 2] ~SegmentedOutStream();
+// [ 6] void invalidate();
+// [ 5] putLength(int length);
+// [ 5] putVersion(int version);
+// [ 2] reserveCapacity(bsl::size_t newCapacity);
+// [ 2] reset();
+// [ 4] spliceBuffer(const char *buffer, bsl::size_t length);
+// [ 3] putInt64(bsls::Types::Int64 value);
+// [ 3] putUint64(bsls::Types::Uint64 value);
+// [ 3] putInt56(bsls::Types::Int64 value);
+// [ 3] putUint56(bsls::Types::Uint64 value);
+// [ 3] putInt48(bsls::Types::Int64 value);
+// [ 3] putUint48(bsls::Types::Uint64 value);
+// [ 3] putInt40(bsls::Types::Int64 value);
+// [ 3] putUint40(bsls::Types::Uint64 value);
+// [ 3] putInt32(int value);
+// [ 3] putUint32(unsigned int value);
+// [ 3] putInt24(int value);
+// [ 3] putUint24(unsigned int value);
+// [ 3] putInt16(int value);
+// [ 3] putUint16(unsigned int value);
+// [ 3] putInt8(int value);
+// [ 3] putUint8(unsigned int value);
+// [ 3] putFloat64(double value);
+// [ 3] putFloat32(float value);
+// [ 5] putString(const bsl::string& value);
+// [ 3] putArrayInt64(const bsls::Types::Int64 *array, int count);
+// [ 3] putArrayUint64(const bsls::Types::Uint64 *array, int count);
+// [ 3] putArrayInt56(const bsls::Types::Int64 *array, int count);
+// [ 3] putArrayUint56(const bsls::Types::Uint64 *array, int count);
+// [ 3] putArrayInt48(const bsls::Types::Int64 *array, int count);
+// [ 3] putArrayUint48(const bsls::Types::Uint64 *array, int count);
+// [ 3] putArrayInt40(const bsls::Types::Int64 *array, int count);
+// [ 3] putArrayUint40(const bsls::Types::Uint64 *array, int count);
+// [ 3] putArrayInt32(const int *array, int count);
+// [ 3] putArrayUint32(const unsigned int *array, int count);
+// [ 3] putArrayInt24(const int *array, int count);
+// [ 3] putArrayUint24(const unsigned int *array, int count);
+// [ 3] putArrayInt16(const short *array, int count);
+// [ 3] putArrayUint16(const unsigned short *array, int count);
+// [ 3] putArrayInt8(const char *array, int count);
+// [ 3] putArrayInt8(const signed char *array, int count);
+// [ 3] putArrayUint8(const char *array, int count);
+// [ 3] putArrayUint8(const unsigned char *array, int count);
+// [ 3] putArrayFloat64(const double *array, int count);
+// [ 3] putArrayFloat32(const float *array, int count);
+// [ 3] putVarInt64(bsls::Types::Int64 value);
+// [ 3] putVarUint64(bsls::Types::Uint64 value);
+// [ 3] putVarInt32(int value);
+// [ 3] putVarUint32(unsigned int value);
+// [ 3] putArrayVarInt64(const bsls::Types::Int64 *array, int count);
+// [ 3] putArrayVarUint64(const bsls::Types::Uint64 *array, int count);
+// [ 3] putArrayVarInt32(const int *array, int count);
+// [ 3] putArrayVarUint32(const unsigned int *array, int count);
+// [ 6] operator const void *() const;
+// [ 2] bslma::Allocator *allocator() const;
+// [ 2] int bdexVersionSelector() const;
+// [ 2] int blockSize() const;
+// [ 6] bool isValid() const;
+// [ 3] bsl::size_t length() const;
+// [ 4] int loadSegments(IOVEC *segments, int max, int first = 0) const;
+// [ 3] int numSegments() const;
+// [ 3] bslstl::StringRef segment(int index) const;
+//
+// [ 5] SegmentedOutStream& operator<<(SegmentedOutStream&, const TYPE&);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] USAGE EXAMPLE
+// [-1] PERFORMANCE: COMPARISON WITH 'ByteOutStream'
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACROS
+// ----------------------------------------------------------------------------
+
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                      STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef SegmentedOutStream Obj;
+
+const int VERSION_SELECTOR = 20131127;
+
+// ============================================================================
+//                      HELPER CLASSES AND FUNCTIONS
+// ----------------------------------------------------------------------------
+
+struct IoVec {
+    // This 'struct' has the same members as the POSIX 'struct iovec'.
+
+    void        *iov_base;  // address of the segment
+    bsl::size_t  iov_len;   // length of the segment
+};
+
+static bsl::string gather(const Obj& stream)
+    // Return the concatenation of the segments of the specified 'stream',
+    // after verifying that no segment is empty and that their total length
+    // is 'stream.length()'.
+{
+    bsl::string result;
+    for (int i = 0; i < stream.numSegments(); ++i) {
+        const bslstl::StringRef segment = stream.segment(i);
+
+        ASSERTV(i, 0 < segment.length());
+        result.append(segment.data(), segment.length());
+    }
+    ASSERTV(stream.length(), result.length(),
+            stream.length() == result.length());
+    return result;
+}
+
+static bsls::Types::Uint64 nextRandom(bsls::Types::Uint64 *state)
+    // Return the next value of the 64-bit linear congruential sequence whose
+    // state is held by the specified 'state'.
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state >> 11;
+}
+
+template <class STREAM>
+void putRandomValues(STREAM *stream, bsls::Types::Uint64 seed, int numOps)
+    // Write to the specified 'stream' the specified 'numOps' pseudo-random
+    // values, or arrays of values, chosen using the specified 'seed', using
+    // every output method of the BDEX 'OutStream' protocol.  The values
+    // written are a function of 'seed' and 'numOps' only.
+{
+    typedef bsls::Types::Int64  Int64;
+    typedef bsls::Types::Uint64 Uint64;
+
+    enum { k_MAX_ARRAY = 40 };
+
+    Int64          i64[k_MAX_ARRAY];
+    Uint64         u64[k_MAX_ARRAY];
+    int            i32[k_MAX_ARRAY];
+    unsigned int   u32[k_MAX_ARRAY];
+    short          i16[k_MAX_ARRAY];
+    unsigned short u16[k_MAX_ARRAY];
+    char           c8[k_MAX_ARRAY];
+    signed char    i8[k_MAX_ARRAY];
+    unsigned char  u8[k_MAX_ARRAY];
+    double         f64[k_MAX_ARRAY];
+    float          f32[k_MAX_ARRAY];
+
+    Uint64 state = seed;
+
+    for (int op = 0; op < numOps; ++op) {
+        const int    which = static_cast<int>(nextRandom(&state) % 52);
+        const int    n     = static_cast<int>(nextRandom(&state)
+                                                             % k_MAX_ARRAY);
+        const Uint64 v     = nextRandom(&state) * 2654435761ULL;
+        const Uint64 w     = v >> (v & 63);  // for variable-length values
+
+        for (int i = 0; i < n; ++i) {
+            const Uint64 r = nextRandom(&state) * 40503ULL;
+
+            i64[i] = static_cast<Int64>(r);
+            u64[i] = r;
+            i32[i] = static_cast<int>(r);
+            u32[i] = static_cast<unsigned int>(r);
+            i16[i] = static_cast<short>(r);
+            u16[i] = static_cast<unsigned short>(r);
+            c8[i]  = static_cast<char>(r);
+            i8[i]  = static_cast<signed char>(r);
+            u8[i]  = static_cast<unsigned char>(r);
+            f64[i] = static_cast<double>(static_cast<Int64>(r)) / 7.0;
+            f32[i] = static_cast<float>(static_cast<int>(r)) / 3.0f;
+        }
+
+        switch (which) {
+          case  0: stream->putInt64(static_cast<Int64>(v));           break;
+          case  1: stream->putUint64(v);                              break;
+          case  2: stream->putInt56(static_cast<Int64>(v));           break;
+          case  3: stream->putUint56(v);                              break;
+          case  4: stream->putInt48(static_cast<Int64>(v));           break;
+          case  5: stream->putUint48(v);                              break;
+          case  6: stream->putInt40(static_cast<Int64>(v));           break;
+          case  7: stream->putUint40(v);                              break;
+          case  8: stream->putInt32(static_cast<int>(v));             break;
+          case  9: stream->putUint32(static_cast<unsigned int>(v));   break;
+          case 10: stream->putInt24(static_cast<int>(v));             break;
+          case 11: stream->putUint24(static_cast<unsigned int>(v));   break;
+          case 12: stream->putInt16(static_cast<int>(v));             break;
+          case 13: stream->putUint16(static_cast<unsigned int>(v));   break;
+          case 14: stream->putInt8(static_cast<int>(v));              break;
+          case 15: stream->putUint8(static_cast<unsigned int>(v));    break;
+          case 16: stream->putFloat64(static_cast<double>(v) / 3.0);  break;
+          case 17: stream->putFloat32(static_cast<float>(v) / 3.0f);  break;
+          case 18: stream->putLength(static_cast<int>(v % 100000));   break;
+          case 19: stream->putVersion(static_cast<int>(v % 256));     break;
+          case 20: stream->putString(bsl::string(c8, n));             break;
+          case 21: stream->putArrayInt64(i64, n);                     break;
+          case 22: stream->putArrayUint64(u64, n);                    break;
+          case 23: stream->putArrayInt56(i64, n);                     break;
+          case 24: stream->putArrayUint56(u64, n);                    break;
+          case 25: stream->putArrayInt48(i64, n);                     break;
+          case 26: stream->putArrayUint48(u64, n);                    break;
+          case 27: stream->putArrayInt40(i64, n);                     break;
+          case 28: stream->putArrayUint40(u64, n);                    break;
+          case 29: stream->putArrayInt32(i32, n);                     break;
+          case 30: stream->putArrayUint32(u32, n);                    break;
+          case 31: stream->putArrayInt24(i32, n);                     break;
+          case 32: stream->putArrayUint24(u32, n);                    break;
+          case 33: stream->putArrayInt16(i16, n);                     break;
+          case 34: stream->putArrayUint16(u16, n);                    break;
+          case 35: stream->putArrayInt8(c8, n);                       break;
+          case 36: stream->putArrayInt8(i8, n);                       break;
+          case 37: stream->putArrayUint8(c8, n);                      break;
+          case 38: stream->putArrayUint8(u8, n);                      break;
+          case 39: stream->putArrayFloat64(f64, n);                   break;
+          case 40: stream->putArrayFloat32(f32, n);                   break;
+          case 41: *stream << static_cast<int>(v);                    break;
+          case 42: *stream << bsl::vector<int>(i32, i32 + n);         break;
+          case 43: stream->putVarInt64(static_cast<Int64>(w));        break;
+          case 44: stream->putVarUint64(w);                           break;
+          case 45: stream->putVarInt32(static_cast<int>(w));          break;
+          case 46: stream->putVarUint32(static_cast<unsigned int>(w)); break;
+          case 47: stream->putArrayVarInt64(i64, n);                  break;
+          case 48: stream->putArrayVarUint64(u64, n);                 break;
+          case 49: stream->putArrayVarInt32(i32, n);                  break;
+          case 50: stream->putArrayVarUint32(u32, n);                 break;
+          default: *stream << bsl::string(c8, n);                     break;
+        }
+    }
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file must
+        //:   compile, link, and run as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, replace
+        //:   leading comment characters with spaces, and replace 'assert'
+        //:   with 'ASSERT'.  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "USAGE EXAMPLE" << endl
+                                  << "=============" << endl;
+
+///Example 1: Writing a Snapshot with 'writev'
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose we write snapshots, each consisting of a small BDEX-encoded header
+// followed by a large payload that is already held in memory, to a file
+// descriptor.  Using a 'bslx::ByteOutStream', both the header and a copy of
+// the payload would be accumulated in one contiguous buffer, which is
+// repeatedly reallocated as it grows.  Instead, we use a
+// 'bslx::SegmentedOutStream', splicing the payload into the output without
+// copying it.
+//
+// On POSIX platforms, 'writev' accepts an array of 'struct iovec' (from
+// '<sys/uio.h>').  For the purposes of this example, we define a structure
+// having the same members (see 'IoVec' above).
+//
+// First, we create a payload, and a stream using small blocks, with an
+// arbitrary value for its 'versionSelector':
+//..
+    const bsl::string payload(10000, 'x');
+
+    bslx::SegmentedOutStream outStream(20131127, 256);
+//..
+// Then, we externalize the header, which ends with the length of the payload,
+// splice in the payload, and externalize a trailing checksum:
+//..
+    outStream.putInt32(1);                       // snapshot format
+    outStream.putString(bsl::string("orders"));  // snapshot name
+    outStream.putLength(static_cast<int>(payload.length()));
+    outStream.spliceBuffer(payload.data(), payload.length());
+    outStream.putUint32(0xCAFEBABE);             // checksum
+    ASSERT(outStream);
+
+    ASSERT(4 + 7 + 4 + 10000 + 4 == outStream.length());
+    ASSERT(3                     == outStream.numSegments());
+    ASSERT(payload.data()        == outStream.segment(1).data());
+//..
+// Next, we describe the segments of the stream with an array of 'IoVec':
+//..
+    IoVec     iov[16];
+    const int numIov = outStream.loadSegments(iov, 16);
+    ASSERT(3 == numIov);
+//..
+// Now, on a POSIX platform, we would pass 'iov' to 'writev' (e.g.,
+// '::writev(fd, (struct iovec *)iov, numIov)'); here, we simply gather the
+// segments:
+//..
+    bsl::string gathered;
+    for (int i = 0; i < numIov; ++i) {
+        gathered.append(static_cast<const char *>(iov[i].iov_base),
+                        iov[i].iov_len);
+    }
+    ASSERT(outStream.length() == gathered.length());
+//..
+// Finally, we verify that the gathered output is readable by a
+// 'bslx::ByteInStream':
+//..
+    bslx::ByteInStream inStream(gathered.data(), gathered.length());
+
+    int          format;
+    bsl::string  name;
+    int          length;
+    unsigned int checksum;
+
+    inStream.getInt32(format);
+    inStream.getString(name);
+    inStream.getLength(length);
+    ASSERT(inStream);
+    ASSERT(1        == format);
+    ASSERT("orders" == name);
+    ASSERT(10000    == length);
+
+    bsl::string received(length, '\0');
+    inStream.getArrayUint8(&received[0], length);
+    inStream.getUint32(checksum);
+    ASSERT(inStream);
+    ASSERT(payload    == received);
+    ASSERT(0xCAFEBABE == checksum);
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // VALIDITY AND EXCEPTION SAFETY
+        //
+        // Concerns:
+        //: 1 A stream is valid on construction and after 'reset', and
+        //:   invalid after 'invalidate'.
+        //:
+        //: 2 Output to an invalid stream has no effect.
+        //:
+        //: 3 If an allocation fails during output, the exception propagates,
+        //:   the stream is invalidated, the segments remain consistent, and
+        //:   no memory is leaked.
+        //
+        // Plan:
+        //: 1 Invalidate streams, and verify that output (of each kind) has no
+        //:   effect.  (C-1..2)
+        //:
+        //: 2 Write values, and splice buffers, using a test allocator that
+        //:   throws after each possible number of allocations, and verify the
+        //:   state of the stream when an exception is thrown.  (C-3)
+        //
+        // Testing:
+        //   void invalidate();
+        //   operator const void *() const;
+        //   bool isValid() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "VALIDITY AND EXCEPTION SAFETY" << endl
+                          << "=============================" << endl;
+
+        {
+            Obj mX(VERSION_SELECTOR, 8, &ta);  const Obj& X = mX;
+            ASSERT(X.isValid());
+            ASSERT(X);
+
+            mX.putInt32(1);
+            mX.invalidate();
+            ASSERT(!X.isValid());
+            ASSERT(!X);
+
+            const int  ARRAY[] = { 1, 2, 3, 4, 5 };
+            const char BUFFER[] = "buffer";
+
+            mX.putInt64(1);
+            mX.putInt8(1);
+            mX.putFloat32(1.0f);
+            mX.putArrayInt32(ARRAY, 5);
+            mX.putString(bsl::string("string"));
+            mX.spliceBuffer(BUFFER, 6);
+            mX << 5;
+            ASSERT(4 == X.length());
+            ASSERT(1 == X.numSegments());
+            ASSERT(!X.isValid());
+
+            mX.reset();
+            ASSERT(X.isValid());
+            ASSERT(0 == X.length());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting exception safety." << endl;
+
+#ifdef BDE_BUILD_TARGET_EXC
+        for (int limit = 0; limit < 20; ++limit) {
+            bslma::TestAllocator sa(veryVeryVeryVerbose);
+            {
+                Obj mX(VERSION_SELECTOR, 8, &sa);  const Obj& X = mX;
+
+                const char BUFFER[] = "spliced";
+
+                sa.setAllocationLimit(limit);
+                bool caught = false;
+                try {
+                    for (int i = 0; i < 10; ++i) {
+                        mX.putInt40(i);
+                        mX.spliceBuffer(BUFFER, 7);
+                    }
+                }
+                catch (const bslma::TestAllocatorException&) {
+                    caught = true;
+                }
+                sa.setAllocationLimit(-1);
+
+                ASSERTV(limit, caught == !X.isValid());
+
+                // The segments written before the exception remain
+                // consistent.
+
+                const bsl::string output = gather(X);
+
+                if (!caught) {
+                    ASSERTV(limit, 10 * (5 + 7) == output.length());
+                }
+
+                mX.reset();
+                mX.putInt64(7);
+                ASSERTV(limit, X.isValid());
+                ASSERTV(limit, 8 == gather(X).length());
+            }
+            ASSERTV(limit, 0 == sa.numBlocksInUse());
+        }
+#endif
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // STRINGS, LENGTHS, VERSIONS, AND 'operator<<'
+        //
+        // Concerns:
+        //: 1 'putString', 'putLength', and 'putVersion' write the same bytes
+        //:   as the corresponding methods of 'ByteOutStream', for lengths on
+        //:   both sides of the one-byte limit.
+        //:
+        //: 2 'operator<<' externalizes BDEX-compliant types.
+        //:
+        //: 3 The output can be read by a 'ByteInStream'.
+        //
+        // Plan:
+        //: 1 Write strings of various lengths, and other values, to a
+        //:   'SegmentedOutStream' with small blocks, and to a
+        //:   'ByteOutStream', compare the output, and read it back.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   putLength(int length);
+        //   putVersion(int version);
+        //   putString(const bsl::string& value);
+        //   SegmentedOutStream& operator<<(SegmentedOutStream&, const TYPE&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                  << "STRINGS, LENGTHS, VERSIONS, AND 'operator<<'" << endl
+                  << "============================================" << endl;
+
+        const int LENGTHS[] = { 0, 1, 2, 127, 128, 129, 1000 };
+        const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+            const int         LENGTH = LENGTHS[ti];
+            const bsl::string VALUE(LENGTH, static_cast<char>('a' + ti));
+
+            if (veryVerbose) { T_ P(LENGTH) }
+
+            Obj           mX(VERSION_SELECTOR, 5, &ta);  const Obj& X = mX;
+            ByteOutStream mY(VERSION_SELECTOR, &ta);
+
+            mX.putString(VALUE).putVersion(3).putLength(LENGTH);
+            mY.putString(VALUE).putVersion(3).putLength(LENGTH);
+
+            bsl::vector<bsl::string> strings(3, VALUE);
+            mX << strings << LENGTH;
+            mY << strings << LENGTH;
+
+            const bsl::string output = gather(X);
+            ASSERTV(LENGTH, mY.length() == output.length());
+            ASSERTV(LENGTH, 0 == bsl::memcmp(mY.data(),
+                                             output.data(),
+                                             output.length()));
+
+            ByteInStream             in(output.data(), output.length());
+            bsl::string              s;
+            int                      version;
+            int                      length;
+            bsl::vector<bsl::string> v;
+            int                      i;
+
+            in.getString(s).getVersion(version).getLength(length);
+            in >> v >> i;
+
+            ASSERTV(LENGTH, in);
+            ASSERTV(LENGTH, in.isEmpty());
+            ASSERTV(LENGTH, VALUE   == s);
+            ASSERTV(LENGTH, 3       == version);
+            ASSERTV(LENGTH, LENGTH  == length);
+            ASSERTV(LENGTH, strings == v);
+            ASSERTV(LENGTH, LENGTH  == i);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // SPLICING AND SCATTER-GATHER OUTPUT
+        //
+        // Concerns:
+        //: 1 A spliced buffer becomes a segment referring to the caller's
+        //:   memory, between the segments holding the output written before
+        //:   and after it.
+        //:
+        //: 2 Output after a splice continues in the remaining space of the
+        //:   current block.
+        //:
+        //: 3 Consecutive splices, and splices at the start of the stream, do
+        //:   not produce empty segments, and splicing an empty buffer has no
+        //:   effect.
+        //:
+        //: 4 'loadSegments' loads the segments in batches, honoring
+        //:   'maxNumSegments' and 'firstIndex'.
+        //
+        // Plan:
+        //: 1 Interleave output and splices, and verify the segments.
+        //:   (C-1..3)
+        //:
+        //: 2 Load the segments into arrays of 'IoVec' in batches of every
+        //:   size, and verify the result.  (C-4)
+        //
+        // Testing:
+        //   spliceBuffer(const char *buffer, bsl::size_t length);
+        //   int loadSegments(IOVEC *segments, int max, int first = 0) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SPLICING AND SCATTER-GATHER OUTPUT" << endl
+                          << "==================================" << endl;
+
+        const char A[] = "first spliced buffer";
+        const char B[] = "second";
+
+        {
+            Obj mX(VERSION_SELECTOR, 16, &ta);  const Obj& X = mX;
+
+            mX.spliceBuffer(A, 0);
+            ASSERT(0 == X.numSegments());
+
+            mX.spliceBuffer(A, sizeof A - 1);
+            ASSERT(1 == X.numSegments());
+            ASSERT(A == X.segment(0).data());
+
+            mX.spliceBuffer(B, sizeof B - 1);
+            ASSERT(2 == X.numSegments());
+            ASSERT(B == X.segment(1).data());
+
+            mX.putInt32(0x01020304);
+            ASSERT(3 == X.numSegments());
+            ASSERT(4 == X.segment(2).length());
+
+            const char *block = X.segment(2).data();
+
+            mX.spliceBuffer(A, 5);
+            mX.putInt32(0x05060708);
+            ASSERT(5 == X.numSegments());
+            ASSERT(A         == X.segment(3).data());
+            ASSERT(block + 4 == X.segment(4).data());  // same block
+
+            mX.putArrayUint8(A, 12);                   // crosses a block
+            ASSERT(6 == X.numSegments());
+            ASSERT(block + 4 == X.segment(4).data());
+            ASSERT(12        == X.segment(4).length());
+
+            const bsl::string EXPECTED = bsl::string(A) + B
+                                       + "\x01\x02\x03\x04"
+                                       + bsl::string(A, 5)
+                                       + "\x05\x06\x07\x08"
+                                       + bsl::string(A, 12);
+            ASSERT(EXPECTED == gather(X));
+
+            if (verbose) cout << "\tTesting 'loadSegments'." << endl;
+
+            const int NUM_SEGMENTS = X.numSegments();
+
+            for (int batch = 1; batch <= NUM_SEGMENTS + 1; ++batch) {
+                bsl::string result;
+                int         first = 0;
+                int         numCalls = 0;
+
+                while (first < NUM_SEGMENTS) {
+                    IoVec     iov[8];
+                    const int n = X.loadSegments(iov, batch, first);
+
+                    ASSERTV(batch, first, 0 < n);
+                    ASSERTV(batch, first, n <= batch);
+                    for (int i = 0; i < n; ++i) {
+                        result.append(
+                                    static_cast<const char *>(iov[i].iov_base),
+                                    iov[i].iov_len);
+                    }
+                    first += n;
+                    ++numCalls;
+                }
+                ASSERTV(batch, EXPECTED == result);
+                ASSERTV(batch, (NUM_SEGMENTS + batch - 1) / batch == numCalls);
+
+                IoVec iov[1];
+                ASSERTV(batch, 0 == X.loadSegments(iov, batch, first));
+                ASSERTV(batch, 0 == X.loadSegments(iov, 0));
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(VERSION_SELECTOR, 16, &ta);  const Obj& X = mX;
+            mX.putInt8(1);
+
+            IoVec iov[2];
+            ASSERT_SAFE_PASS(X.loadSegments(iov, 2, 1));
+            ASSERT_SAFE_FAIL(X.loadSegments(iov, 2, 2));
+            ASSERT_SAFE_FAIL(X.loadSegments(iov, 2, -1));
+            ASSERT_SAFE_FAIL(X.loadSegments(iov, -1));
+
+            ASSERT_SAFE_PASS(X.segment(0));
+            ASSERT_SAFE_FAIL(X.segment(1));
+            ASSERT_SAFE_FAIL(X.segment(-1));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // OUTPUT OF VALUES AND ARRAYS
+        //
+        // Concerns:
+        //: 1 Every output method writes the same bytes as the corresponding
+        //:   method of 'ByteOutStream', whether the value or array fits in the
+        //:   current block, straddles two blocks, or spans many.
+        //:
+        //: 2 'length', 'numSegments', and 'segment' describe the output, and
+        //:   segments are broken only at block boundaries.
+        //
+        // Plan:
+        //: 1 For block sizes from 1 to beyond the size of the largest value,
+        //:   write the same pseudo-random sequence of values and arrays to a
+        //:   'SegmentedOutStream' and a 'ByteOutStream', and compare the
+        //:   gathered segments with the output of the 'ByteOutStream'.
+        //:   (C-1..2)
+        //
+        // Testing:
+        //   putInt64(bsls::Types::Int64 value);
+        //   putUint64(bsls::Types::Uint64 value);
+        //   putInt56(bsls::Types::Int64 value);
+        //   putUint56(bsls::Types::Uint64 value);
+        //   putInt48(bsls::Types::Int64 value);
+        //   putUint48(bsls::Types::Uint64 value);
+        //   putInt40(bsls::Types::Int64 value);
+        //   putUint40(bsls::Types::Uint64 value);
+        //   putInt32(int value);
+        //   putUint32(unsigned int value);
+        //   putInt24(int value);
+        //   putUint24(unsigned int value);
+        //   putInt16(int value);
+        //   putUint16(unsigned int value);
+        //   putInt8(int value);
+        //   putUint8(unsigned int value);
+        //   putFloat64(double value);
+        //   putFloat32(float value);
+        //   putArrayInt64(const bsls::Types::Int64 *array, int count);
+        //   putArrayUint64(const bsls::Types::Uint64 *array, int count);
+        //   putArrayInt56(const bsls::Types::Int64 *array, int count);
+        //   putArrayUint56(const bsls::Types::Uint64 *array, int count);
+        //   putArrayInt48(const bsls::Types::Int64 *array, int count);
+        //   putArrayUint48(const bsls::Types::Uint64 *array, int count);
+        //   putArrayInt40(const bsls::Types::Int64 *array, int count);
+        //   putArrayUint40(const bsls::Types::Uint64 *array, int count);
+        //   putArrayInt32(const int *array, int count);
+        //   putArrayUint32(const unsigned int *array, int count);
+        //   putArrayInt24(const int *array, int count);
+        //   putArrayUint24(const unsigned int *array, int count);
+        //   putArrayInt16(const short *array, int count);
+        //   putArrayUint16(const unsigned short *array, int count);
+        //   putArrayInt8(const char *array, int count);
+        //   putArrayInt8(const signed char *array, int count);
+        //   putArrayUint8(const char *array, int count);
+        //   putArrayUint8(const unsigned char *array, int count);
+        //   putArrayFloat64(const double *array, int count);
+        //   putArrayFloat32(const float *array, int count);
+        //   bsl::size_t length() const;
+        //   int numSegments() const;
+        //   bslstl::StringRef segment(int index) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "OUTPUT OF VALUES AND ARRAYS" << endl
+                          << "===========================" << endl;
+
+        for (int blockSize = 1; blockSize <= 70; ++blockSize) {
+            if (veryVerbose) { T_ P(blockSize) }
+
+            for (int seed = 1; seed <= 8; ++seed) {
+                Obj           mX(VERSION_SELECTOR, blockSize, &ta);
+                const Obj&    X = mX;
+                ByteOutStream mY(VERSION_SELECTOR, &ta);
+
+                putRandomValues(&mX, seed, 200);
+                putRandomValues(&mY, seed, 200);
+
+                ASSERTV(blockSize, seed, X.isValid());
+
+                const bsl::string output = gather(X);
+
+                ASSERTV(blockSize, seed, mY.length() == X.length());
+                ASSERTV(blockSize, seed, 0 == bsl::memcmp(mY.data(),
+                                                          output.data(),
+                                                          output.length()));
+
+                // Without splices, each segment but the last fills a block.
+
+                for (int i = 0; i + 1 < X.numSegments(); ++i) {
+                    ASSERTV(blockSize, seed, i,
+                            static_cast<bsl::size_t>(blockSize)
+                                                     == X.segment(i).length());
+                }
+                ASSERTV(blockSize, seed,
+                        (X.length() + blockSize - 1) / blockSize
+                               == static_cast<bsl::size_t>(X.numSegments()));
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS, 'reset', AND 'reserveCapacity'
+        //
+        // Concerns:
+        //: 1 The constructors create an empty, valid stream having the
+        //:   specified version selector, block size (or the default), and
+        //:   allocator (or the default allocator).
+        //:
+        //: 2 Blocks are allocated from the object allocator only as needed,
+        //:   and each has the block size.
+        //:
+        //: 3 'reset' empties and validates the stream, and its blocks are
+        //:   reused.
+        //:
+        //: 4 'reserveCapacity' allocates blocks in advance.
+        //:
+        //: 5 The destructor deallocates all blocks.
+        //:
+        //: 6 The constructor asserts that the block size is positive.
+        //
+        // Plan:
+        //: 1 Create streams with and without the optional arguments, write to
+        //:   them, and monitor the allocators.  (C-1..5)
+        //:
+        //: 2 Verify that defensive checks are triggered for a non-positive
+        //:   block size.  (C-6)
+        //
+        // Testing:
+        //   SegmentedOutStream(int sV, *ba = 0);
+        //   SegmentedOutStream(int sV, int blockSize, *ba = 0);
+        //   ~SegmentedOutStream();
+        //   reserveCapacity(bsl::size_t newCapacity);
+        //   reset();
+        //   bslma::Allocator *allocator() const;
+        //   int bdexVersionSelector() const;
+        //   int blockSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                         << endl
+                         << "CREATORS, 'reset', AND 'reserveCapacity'" << endl
+                         << "========================================" << endl;
+
+        {
+            Obj mX(VERSION_SELECTOR);  const Obj& X = mX;
+
+            ASSERT(VERSION_SELECTOR          == X.bdexVersionSelector());
+            ASSERT(Obj::k_DEFAULT_BLOCK_SIZE == X.blockSize());
+            ASSERT(&defaultAllocator         == X.allocator());
+            ASSERT(X.isValid());
+            ASSERT(0 == X.length());
+            ASSERT(0 == X.numSegments());
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+            mX.putInt32(1);
+            ASSERT(0 < defaultAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        {
+            Obj mX(VERSION_SELECTOR + 1, 100, &ta);  const Obj& X = mX;
+
+            ASSERT(VERSION_SELECTOR + 1 == X.bdexVersionSelector());
+            ASSERT(100                  == X.blockSize());
+            ASSERT(&ta                  == X.allocator());
+            ASSERT(0 == ta.numBlocksInUse());
+
+            const char BYTES[250] = { 0 };
+
+            mX.putArrayInt8(BYTES, 250);
+            ASSERT(250 == X.length());
+            ASSERT(3   == X.numSegments());
+
+            const bsls::Types::Int64 NUM_BLOCKS = ta.numBlocksInUse();
+            ASSERT(3 <= NUM_BLOCKS);
+
+            if (verbose) cout << "\tTesting 'reset'." << endl;
+
+            const char *FIRST = X.segment(0).data();
+
+            mX.invalidate();
+            mX.reset();
+            ASSERT(X.isValid());
+            ASSERT(0 == X.length());
+            ASSERT(0 == X.numSegments());
+
+            const bsls::Types::Int64 NUM_ALLOCS = ta.numAllocations();
+            mX.putArrayInt8(BYTES, 250);
+            ASSERT(NUM_ALLOCS == ta.numAllocations());
+            ASSERT(FIRST      == X.segment(0).data());
+            ASSERT(250        == X.length());
+
+            if (verbose) cout << "\tTesting 'reserveCapacity'." << endl;
+
+            mX.reserveCapacity(1000);
+            ASSERT(NUM_ALLOCS + 7 <= ta.numAllocations());
+
+            const bsls::Types::Int64 NUM_ALLOCS2 = ta.numAllocations();
+            mX.putArrayInt8(BYTES, 250);
+            mX.putArrayInt8(BYTES, 250);
+            mX.putArrayInt8(BYTES, 250);
+            ASSERT(NUM_ALLOCS2 == ta.numAllocations());
+            ASSERT(1000        == X.length());
+
+            mX.reserveCapacity(10);
+            ASSERT(NUM_ALLOCS2 == ta.numAllocations());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_SAFE_FAIL(Obj(VERSION_SELECTOR, 0, &ta));
+            ASSERT_SAFE_FAIL(Obj(VERSION_SELECTOR, -1, &ta));
+            ASSERT_SAFE_PASS(Obj(VERSION_SELECTOR, 1, &ta));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Write values spanning several blocks, splice a buffer, and
+        //:   verify the segments.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        Obj mX(VERSION_SELECTOR, 4, &ta);  const Obj& X = mX;
+
+        mX.putInt32(0x01020304);
+        mX.putInt16(0x0506);
+        mX.putInt64(0x0708090a0b0c0d0eLL);
+        ASSERT(14 == X.length());
+        ASSERT(4  == X.numSegments());
+
+        mX.spliceBuffer("hello", 5);
+        mX.putInt8(0x0f);
+        ASSERT(20 == X.length());
+        ASSERT(6  == X.numSegments());
+
+        ASSERT(gather(X) == bsl::string("\x01\x02\x03\x04\x05\x06\x07\x08"
+                                        "\x09\x0a\x0b\x0c\x0d\x0e"
+                                        "hello\x0f"));
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COMPARISON WITH 'ByteOutStream'
+        //
+        // Concerns:
+        //: 1 Writing a large output to a 'SegmentedOutStream' is faster than
+        //:   writing it to a 'ByteOutStream', which repeatedly reallocates
+        //:   and copies its buffer, and splicing a large payload is faster
+        //:   still.
+        //
+        // Plan:
+        //: 1 Externalize a large number of records, each having a few scalar
+        //:   fields and a payload, to both kinds of stream, and report the
+        //:   elapsed times.  Optionally specify the number of records and the
+        //:   payload size as the second and third arguments.
+        //
+        // Testing:
+        //   PERFORMANCE: COMPARISON WITH 'ByteOutStream'
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: COMPARISON WITH 'ByteOutStream'" << endl
+             << "============================================" << endl;
+
+        const int NUM_RECORDS  = argc > 2 ? atoi(argv[2]) : 200000;
+        const int PAYLOAD_SIZE = argc > 3 ? atoi(argv[3]) : 1000;
+
+        P_(NUM_RECORDS) P(PAYLOAD_SIZE)
+
+        bslma::Allocator *malloc = &bslma::NewDeleteAllocator::singleton();
+
+        const bsl::string payload(PAYLOAD_SIZE, 'p', malloc);
+
+        bsls::Stopwatch timer;
+        bsl::size_t     lengths[3];
+
+        timer.start();
+        {
+            ByteOutStream stream(VERSION_SELECTOR, malloc);
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                stream.putInt64(i).putInt32(i).putFloat64(i);
+                stream.putLength(PAYLOAD_SIZE);
+                stream.putArrayUint8(payload.data(), PAYLOAD_SIZE);
+            }
+            lengths[0] = stream.length();
+        }
+        timer.stop();
+        cout << "ByteOutStream:                  "
+             << timer.elapsedTime() << "s" << endl;
+
+        timer.reset();
+        timer.start();
+        {
+            Obj stream(VERSION_SELECTOR, 65536, malloc);
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                stream.putInt64(i).putInt32(i).putFloat64(i);
+                stream.putLength(PAYLOAD_SIZE);
+                stream.putArrayUint8(payload.data(), PAYLOAD_SIZE);
+            }
+            lengths[1] = stream.length();
+        }
+        timer.stop();
+        cout << "SegmentedOutStream (copying):   "
+             << timer.elapsedTime() << "s" << endl;
+
+        timer.reset();
+        timer.start();
+        {
+            Obj stream(VERSION_SELECTOR, 65536, malloc);
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                stream.putInt64(i).putInt32(i).putFloat64(i);
+                stream.putLength(PAYLOAD_SIZE);
+                stream.spliceBuffer(payload.data(), PAYLOAD_SIZE);
+            }
+            lengths[2] = stream.length();
+        }
+        timer.stop();
+        cout << "SegmentedOutStream (splicing):  "
+             << timer.elapsedTime() << "s" << endl;
+
+        ASSERT(lengths[0] == lengths[1]);
+        ASSERT(lengths[0] == lengths[2]);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------